@@ -4,11 +4,17 @@
 
 #include "flutter/assets/asset_manager.h"
 
+#include <utility>
+
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
 
+// The number of lookups that are cached, which bounds the memory used by the
+// cache if the names of missing assets are made up at runtime.
+static constexpr size_t kMaxCachedLookups = 1024;
+
 AssetManager::AssetManager() = default;
 
 AssetManager::~AssetManager() = default;
@@ -19,6 +25,7 @@ void AssetManager::PushFront(std::unique_ptr<AssetResolver> resolver) {
   }
 
   resolvers_.push_front(std::move(resolver));
+  ClearLookupCache();
 }
 
 void AssetManager::PushBack(std::unique_ptr<AssetResolver> resolver) {
@@ -27,6 +34,7 @@ void AssetManager::PushBack(std::unique_ptr<AssetResolver> resolver) {
   }
 
   resolvers_.push_back(std::move(resolver));
+  ClearLookupCache();
 }
 
 void AssetManager::UpdateResolverByType(
@@ -51,12 +59,65 @@ void AssetManager::UpdateResolverByType(
     new_resolvers.push_back(std::move(updated_asset_resolver));
   }
   resolvers_.swap(new_resolvers);
+  ClearLookupCache();
 }
 
 std::deque<std::unique_ptr<AssetResolver>> AssetManager::TakeResolvers() {
+  ClearLookupCache();
   return std::move(resolvers_);
 }
 
+bool AssetManager::GetCachedResolver(const std::string& asset_name,
+                                     AssetResolver** resolver,
+                                     size_t* generation) const {
+  std::scoped_lock lock(lookup_cache_mutex_);
+  *generation = resolvers_generation_;
+  auto cached = lookup_cache_.find(asset_name);
+  if (cached == lookup_cache_.end()) {
+    return false;
+  }
+  *resolver = cached->second;
+  return true;
+}
+
+void AssetManager::CacheResolver(const std::string& asset_name,
+                                 AssetResolver* resolver,
+                                 size_t generation) const {
+  std::scoped_lock lock(lookup_cache_mutex_);
+  if (generation != resolvers_generation_) {
+    return;
+  }
+  if (lookup_cache_.size() >= kMaxCachedLookups) {
+    lookup_cache_.clear();
+  }
+  lookup_cache_.insert_or_assign(asset_name, resolver);
+}
+
+void AssetManager::RecordAsset(const std::string& asset_name) const {
+  std::scoped_lock lock(lookup_cache_mutex_);
+  if (is_recording_assets_ && recorded_asset_set_.insert(asset_name).second) {
+    recorded_assets_.push_back(asset_name);
+  }
+}
+
+void AssetManager::StartRecordingAssets() {
+  std::scoped_lock lock(lookup_cache_mutex_);
+  is_recording_assets_ = true;
+}
+
+std::vector<std::string> AssetManager::StopRecordingAssets() {
+  std::scoped_lock lock(lookup_cache_mutex_);
+  is_recording_assets_ = false;
+  recorded_asset_set_.clear();
+  return std::exchange(recorded_assets_, {});
+}
+
+void AssetManager::ClearLookupCache() {
+  std::scoped_lock lock(lookup_cache_mutex_);
+  lookup_cache_.clear();
+  resolvers_generation_++;
+}
+
 // |AssetResolver|
 std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
     const std::string& asset_name) const {
@@ -65,12 +126,28 @@ std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
   }
   TRACE_EVENT1("flutter", "AssetManager::GetAsMapping", "name",
                asset_name.c_str());
+  AssetResolver* cached_resolver = nullptr;
+  size_t generation;
+  if (GetCachedResolver(asset_name, &cached_resolver, &generation)) {
+    if (cached_resolver == nullptr) {
+      FML_DLOG(WARNING) << "Could not find asset: " << asset_name;
+      return nullptr;
+    }
+    auto mapping = cached_resolver->GetAsMapping(asset_name);
+    if (mapping != nullptr) {
+      RecordAsset(asset_name);
+      return mapping;
+    }
+  }
   for (const auto& resolver : resolvers_) {
     auto mapping = resolver->GetAsMapping(asset_name);
     if (mapping != nullptr) {
+      CacheResolver(asset_name, resolver.get(), generation);
+      RecordAsset(asset_name);
       return mapping;
     }
   }
+  CacheResolver(asset_name, nullptr, generation);
   FML_DLOG(WARNING) << "Could not find asset: " << asset_name;
   return nullptr;
 }
@@ -94,6 +171,27 @@ std::vector<std::unique_ptr<fml::Mapping>> AssetManager::GetAsMappings(
   return mappings;
 }
 
+// |AssetResolver|
+bool AssetManager::Prefetch(const std::string& asset_name) const {
+  if (asset_name.size() == 0) {
+    return false;
+  }
+  AssetResolver* cached_resolver = nullptr;
+  size_t generation;
+  if (GetCachedResolver(asset_name, &cached_resolver, &generation)) {
+    return cached_resolver != nullptr && cached_resolver->Prefetch(asset_name);
+  }
+  // Not every resolver can prefetch the assets it has, so only the resolver
+  // that prefetched the asset is cached, and a miss is not.
+  for (const auto& resolver : resolvers_) {
+    if (resolver->Prefetch(asset_name)) {
+      CacheResolver(asset_name, resolver.get(), generation);
+      return true;
+    }
+  }
+  return false;
+}
+
 // |AssetResolver|
 bool AssetManager::IsValid() const {
   return resolvers_.size() > 0;
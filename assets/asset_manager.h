@@ -7,7 +7,11 @@
 
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <optional>
 #include "flutter/assets/asset_resolver.h"
@@ -56,6 +60,20 @@ class AssetManager final : public AssetResolver {
 
   std::deque<std::unique_ptr<AssetResolver>> TakeResolvers();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Starts to record the names of the assets that are found by
+  ///             |GetAsMapping|.
+  ///
+  void StartRecordingAssets();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stops the recording started by |StartRecordingAssets|.
+  ///
+  /// @return     The names of the assets that were found since the recording
+  ///             started, in the order they were first found.
+  ///
+  std::vector<std::string> StopRecordingAssets();
+
   // |AssetResolver|
   bool IsValid() const override;
 
@@ -74,8 +92,46 @@ class AssetManager final : public AssetResolver {
       const std::string& asset_pattern,
       const std::optional<std::string>& subdir) const override;
 
+  // |AssetResolver|
+  bool Prefetch(const std::string& asset_name) const override;
+
  private:
   std::deque<std::unique_ptr<AssetResolver>> resolvers_;
+  // The resolver that has each asset that was looked up, or null for the
+  // assets that none of the resolvers has, so that repeated lookups do not
+  // probe every resolver again. Cleared whenever the resolvers change.
+  mutable std::mutex lookup_cache_mutex_;
+  mutable std::unordered_map<std::string, AssetResolver*> lookup_cache_;
+  // Counts the changes to the resolvers, so that a lookup that raced with a
+  // change is not cached.
+  size_t resolvers_generation_ = 0;
+  // The assets found since |StartRecordingAssets|, which are also guarded by
+  // |lookup_cache_mutex_|.
+  bool is_recording_assets_ = false;
+  mutable std::vector<std::string> recorded_assets_;
+  mutable std::unordered_set<std::string> recorded_asset_set_;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Gets the cached result of looking up an asset.
+  ///
+  /// @param[out] resolver    The resolver that has the asset, or null if none
+  ///                         of them has it.
+  /// @param[out] generation  The generation of the resolvers, to pass to
+  ///                         |CacheResolver| after a lookup.
+  ///
+  /// @return     Whether the result of looking up the asset is cached.
+  ///
+  bool GetCachedResolver(const std::string& asset_name,
+                         AssetResolver** resolver,
+                         size_t* generation) const;
+
+  void CacheResolver(const std::string& asset_name,
+                     AssetResolver* resolver,
+                     size_t generation) const;
+
+  void ClearLookupCache();
+
+  void RecordAsset(const std::string& asset_name) const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManager);
 };
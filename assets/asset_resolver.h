@@ -26,7 +26,8 @@ class AssetResolver {
   enum AssetResolverType {
     kAssetManager,
     kApkAssetProvider,
-    kDirectoryAssetBundle
+    kDirectoryAssetBundle,
+    kPackedAssetBundle
   };
 
   virtual bool IsValid() const = 0;
@@ -81,6 +82,18 @@ class AssetResolver {
     return {};
   };
 
+  //--------------------------------------------------------------------------
+  /// @brief      Asks the OS to start reading the asset into memory in the
+  ///             background, so that a later call to `GetAsMapping` for it
+  ///             does not stall on the disk. This does not wait for the reads.
+  ///
+  /// @param[in]  asset_name  The name of the asset that will be needed next.
+  ///
+  /// @return     Returns whether this resolver has the asset and started to
+  ///             read it. Resolvers that cannot read ahead return false.
+  ///
+  virtual bool Prefetch(const std::string& asset_name) const { return false; }
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(AssetResolver);
 };
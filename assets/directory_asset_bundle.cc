@@ -110,4 +110,12 @@ std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
   return mappings;
 }
 
+// |AssetResolver|
+bool DirectoryAssetBundle::Prefetch(const std::string& asset_name) const {
+  if (!is_valid_) {
+    return false;
+  }
+  return fml::PrefetchFile(descriptor_, asset_name.c_str());
+}
+
 }  // namespace flutter
@@ -0,0 +1,394 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/packed_asset_bundle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <regex>
+#include <unordered_set>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "third_party/zlib/zlib.h"
+
+namespace flutter {
+
+// The archive is laid out as follows, with all integers in little endian:
+//
+//  * A |Header|.
+//  * The seeds of the perfect hash, one uint32_t per bucket, padded to a
+//    multiple of eight bytes.
+//  * The |Entry| of each asset, at the slot its name hashes to.
+//  * The names of the assets.
+//  * The data of the assets.
+struct PackedAssetBundle::Entry {
+  uint64_t name_offset;
+  uint64_t data_offset;
+  // The size of the data as stored in the archive.
+  uint64_t data_size;
+  // The size of the asset, which is larger than |data_size| if it is
+  // deflated.
+  uint64_t size;
+  uint32_t name_size;
+  uint32_t compression;
+};
+
+namespace {
+
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t entry_count;
+  uint32_t bucket_count;
+};
+
+static_assert(sizeof(Header) == 16);
+
+constexpr uint32_t kMagic = 0x4b415046;  // "FPAK"
+constexpr uint32_t kVersion = 1;
+
+constexpr uint32_t kCompressionNone = 0;
+constexpr uint32_t kCompressionDeflate = 1;
+
+// The average number of assets in a bucket of the perfect hash, which trades
+// the size of the index against the time it takes to write the archive.
+constexpr uint32_t kBucketSize = 4;
+
+// The alignment of the assets that are stored as they are, so that they do
+// not share pages with other assets.
+constexpr uint64_t kPageSize = 4096;
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+uint64_t GetEntriesOffset(uint32_t bucket_count) {
+  return AlignUp(sizeof(Header) + sizeof(uint32_t) * bucket_count, 8);
+}
+
+bool IsInBounds(uint64_t offset, uint64_t size, uint64_t archive_size) {
+  return offset <= archive_size && size <= archive_size - offset;
+}
+
+// FNV-1a with the seed mixed into its basis, followed by the finalizer of
+// MurmurHash3 so that each seed gives an independent hash.
+uint64_t HashName(std::string_view name, uint32_t seed) {
+  uint64_t hash = 0xcbf29ce484222325ull ^ (seed * 0x9e3779b97f4a7c15ull);
+  for (char c : name) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001b3ull;
+  }
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdull;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ull;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+bool Deflate(const std::vector<uint8_t>& data, std::vector<uint8_t>* deflated) {
+  if (data.size() > std::numeric_limits<uLong>::max()) {
+    return false;
+  }
+  uLongf deflated_size = compressBound(data.size());
+  deflated->resize(deflated_size);
+  if (compress2(deflated->data(), &deflated_size, data.data(), data.size(),
+                Z_BEST_COMPRESSION) != Z_OK) {
+    return false;
+  }
+  deflated->resize(deflated_size);
+  return true;
+}
+
+}  // namespace
+
+std::vector<uint8_t> PackedAssetBundle::Pack(const std::vector<Asset>& assets) {
+  static_assert(sizeof(Entry) == 40);
+
+  std::unordered_set<std::string_view> names;
+  for (const auto& asset : assets) {
+    if (!names.insert(asset.name).second) {
+      FML_LOG(ERROR) << "Asset " << asset.name << " was packed twice.";
+      return {};
+    }
+  }
+
+  // Build a minimal perfect hash by hashing and displacing: the names are
+  // split into buckets by one hash, and then each bucket, from the largest
+  // down, looks for a seed that hashes all of its names to slots that are
+  // still free.
+  const uint32_t entry_count = assets.size();
+  const uint32_t bucket_count =
+      std::max<uint32_t>(1, (entry_count + kBucketSize - 1) / kBucketSize);
+  std::vector<std::vector<uint32_t>> buckets(bucket_count);
+  for (uint32_t i = 0; i < entry_count; i++) {
+    buckets[HashName(assets[i].name, 0) % bucket_count].push_back(i);
+  }
+  std::vector<uint32_t> bucket_order(bucket_count);
+  std::iota(bucket_order.begin(), bucket_order.end(), 0);
+  std::stable_sort(bucket_order.begin(), bucket_order.end(),
+                   [&buckets](uint32_t a, uint32_t b) {
+                     return buckets[a].size() > buckets[b].size();
+                   });
+
+  std::vector<uint32_t> seeds(bucket_count, 0);
+  std::vector<uint32_t> asset_slots(entry_count);
+  std::vector<bool> taken_slots(entry_count, false);
+  std::vector<uint32_t> bucket_slots;
+  for (uint32_t bucket : bucket_order) {
+    if (buckets[bucket].empty()) {
+      break;
+    }
+    // A seed of zero marks an empty bucket.
+    for (uint32_t seed = 1; seeds[bucket] == 0; seed++) {
+      FML_CHECK(seed != 0);
+      bucket_slots.clear();
+      for (uint32_t asset : buckets[bucket]) {
+        uint32_t slot = HashName(assets[asset].name, seed) % entry_count;
+        if (taken_slots[slot] ||
+            std::find(bucket_slots.begin(), bucket_slots.end(), slot) !=
+                bucket_slots.end()) {
+          break;
+        }
+        bucket_slots.push_back(slot);
+      }
+      if (bucket_slots.size() != buckets[bucket].size()) {
+        continue;
+      }
+      for (size_t i = 0; i < bucket_slots.size(); i++) {
+        taken_slots[bucket_slots[i]] = true;
+        asset_slots[buckets[bucket][i]] = bucket_slots[i];
+      }
+      seeds[bucket] = seed;
+    }
+  }
+
+  const uint64_t entries_offset = GetEntriesOffset(bucket_count);
+  std::vector<Entry> entries(entry_count);
+  std::vector<uint8_t> archive(entries_offset + sizeof(Entry) * entry_count);
+  for (uint32_t i = 0; i < entry_count; i++) {
+    Entry& entry = entries[asset_slots[i]];
+    entry.name_offset = archive.size();
+    entry.name_size = assets[i].name.size();
+    archive.insert(archive.end(), assets[i].name.begin(),
+                   assets[i].name.end());
+  }
+  std::vector<uint8_t> deflated;
+  for (uint32_t i = 0; i < entry_count; i++) {
+    const Asset& asset = assets[i];
+    Entry& entry = entries[asset_slots[i]];
+    entry.size = asset.data.size();
+    if (asset.compress && Deflate(asset.data, &deflated) &&
+        deflated.size() < asset.data.size()) {
+      entry.compression = kCompressionDeflate;
+      entry.data_offset = archive.size();
+      entry.data_size = deflated.size();
+      archive.insert(archive.end(), deflated.begin(), deflated.end());
+    } else {
+      entry.compression = kCompressionNone;
+      archive.resize(AlignUp(archive.size(), kPageSize));
+      entry.data_offset = archive.size();
+      entry.data_size = asset.data.size();
+      archive.insert(archive.end(), asset.data.begin(), asset.data.end());
+    }
+  }
+
+  Header header = {kMagic, kVersion, entry_count, bucket_count};
+  std::memcpy(archive.data(), &header, sizeof(header));
+  std::memcpy(archive.data() + sizeof(header), seeds.data(),
+              sizeof(uint32_t) * bucket_count);
+  std::memcpy(archive.data() + entries_offset, entries.data(),
+              sizeof(Entry) * entry_count);
+  return archive;
+}
+
+PackedAssetBundle::PackedAssetBundle(std::unique_ptr<fml::Mapping> archive,
+                                     bool is_valid_after_asset_manager_change)
+    : archive_(std::move(archive)) {
+  if (!archive_) {
+    return;
+  }
+  const uint64_t archive_size = archive_->GetSize();
+  Header header;
+  if (archive_size < sizeof(header)) {
+    FML_LOG(ERROR) << "Asset archive is truncated.";
+    return;
+  }
+  std::memcpy(&header, archive_->GetMapping(), sizeof(header));
+  if (header.magic != kMagic || header.version != kVersion) {
+    FML_LOG(ERROR) << "Asset archive has an unsupported format.";
+    return;
+  }
+  if (header.bucket_count == 0 ||
+      !IsInBounds(GetEntriesOffset(header.bucket_count),
+                  sizeof(Entry) * static_cast<uint64_t>(header.entry_count),
+                  archive_size)) {
+    FML_LOG(ERROR) << "Asset archive is truncated.";
+    return;
+  }
+  entry_count_ = header.entry_count;
+  bucket_count_ = header.bucket_count;
+
+  // Check every entry once, so that looking up an asset does not have to.
+  for (uint32_t slot = 0; slot < entry_count_; slot++) {
+    Entry entry = *GetEntry(slot);
+    bool is_valid_entry;
+    switch (entry.compression) {
+      case kCompressionNone:
+        is_valid_entry = entry.data_size == entry.size;
+        break;
+      case kCompressionDeflate:
+        is_valid_entry = entry.size <= std::numeric_limits<uLong>::max();
+        break;
+      default:
+        is_valid_entry = false;
+        break;
+    }
+    if (!is_valid_entry ||
+        !IsInBounds(entry.name_offset, entry.name_size, archive_size) ||
+        !IsInBounds(entry.data_offset, entry.data_size, archive_size)) {
+      FML_LOG(ERROR) << "Asset archive has an invalid entry.";
+      return;
+    }
+  }
+
+  is_valid_after_asset_manager_change_ = is_valid_after_asset_manager_change;
+  is_valid_ = true;
+}
+
+PackedAssetBundle::~PackedAssetBundle() = default;
+
+std::optional<PackedAssetBundle::Entry> PackedAssetBundle::GetEntry(
+    uint32_t slot) const {
+  if (slot >= entry_count_) {
+    return std::nullopt;
+  }
+  Entry entry;
+  std::memcpy(&entry,
+              archive_->GetMapping() + GetEntriesOffset(bucket_count_) +
+                  sizeof(Entry) * slot,
+              sizeof(entry));
+  return entry;
+}
+
+std::optional<PackedAssetBundle::Entry> PackedAssetBundle::FindEntry(
+    std::string_view name) const {
+  if (entry_count_ == 0) {
+    return std::nullopt;
+  }
+  uint32_t seed;
+  std::memcpy(&seed,
+              archive_->GetMapping() + sizeof(Header) +
+                  sizeof(uint32_t) * (HashName(name, 0) % bucket_count_),
+              sizeof(seed));
+  if (seed == 0) {
+    return std::nullopt;
+  }
+  // Any name hashes to some entry, which is the asset only if the names match.
+  std::optional<Entry> entry = GetEntry(HashName(name, seed) % entry_count_);
+  if (!entry || GetName(*entry) != name) {
+    return std::nullopt;
+  }
+  return entry;
+}
+
+std::string_view PackedAssetBundle::GetName(const Entry& entry) const {
+  return std::string_view(
+      reinterpret_cast<const char*>(archive_->GetMapping() + entry.name_offset),
+      entry.name_size);
+}
+
+std::unique_ptr<fml::Mapping> PackedAssetBundle::GetEntryMapping(
+    const Entry& entry) const {
+  const uint8_t* data = archive_->GetMapping() + entry.data_offset;
+  if (entry.compression == kCompressionDeflate) {
+    std::vector<uint8_t> inflated(entry.size);
+    uLongf inflated_size = entry.size;
+    if (uncompress(inflated.data(), &inflated_size, data, entry.data_size) !=
+            Z_OK ||
+        inflated_size != entry.size) {
+      FML_LOG(ERROR) << "Could not inflate asset " << GetName(entry);
+      return nullptr;
+    }
+    return std::make_unique<fml::DataMapping>(std::move(inflated));
+  }
+  // The mapping holds on to the archive, which may outlive the resolver.
+  return std::make_unique<fml::NonOwnedMapping>(
+      data, entry.size, [archive = archive_](const uint8_t*, size_t) {},
+      archive_->IsDontNeedSafe());
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValid() const {
+  return is_valid_;
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValidAfterAssetManagerChange() const {
+  return is_valid_after_asset_manager_change_;
+}
+
+// |AssetResolver|
+AssetResolver::AssetResolverType PackedAssetBundle::GetType() const {
+  return AssetResolver::AssetResolverType::kPackedAssetBundle;
+}
+
+// |AssetResolver|
+std::unique_ptr<fml::Mapping> PackedAssetBundle::GetAsMapping(
+    const std::string& asset_name) const {
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return nullptr;
+  }
+
+  std::optional<Entry> entry = FindEntry(asset_name);
+  if (!entry) {
+    return nullptr;
+  }
+  return GetEntryMapping(*entry);
+}
+
+// |AssetResolver|
+std::vector<std::unique_ptr<fml::Mapping>> PackedAssetBundle::GetAsMappings(
+    const std::string& asset_pattern,
+    const std::optional<std::string>& subdir) const {
+  std::vector<std::unique_ptr<fml::Mapping>> mappings;
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return mappings;
+  }
+
+  // Like |DirectoryAssetBundle|, match the pattern against the file names of
+  // all assets, or of the assets directly in the subdirectory if there is one.
+  std::regex asset_regex(asset_pattern);
+  std::string prefix = subdir ? subdir.value() + "/" : "";
+  for (uint32_t slot = 0; slot < entry_count_; slot++) {
+    Entry entry = *GetEntry(slot);
+    std::string_view name = GetName(entry);
+    if (subdir) {
+      if (name.substr(0, prefix.size()) != prefix) {
+        continue;
+      }
+      name.remove_prefix(prefix.size());
+      if (name.find('/') != std::string_view::npos) {
+        continue;
+      }
+    } else {
+      name.remove_prefix(name.rfind('/') + 1);
+    }
+    if (!std::regex_match(name.begin(), name.end(), asset_regex)) {
+      continue;
+    }
+    auto mapping = GetEntryMapping(entry);
+    if (mapping) {
+      mappings.push_back(std::move(mapping));
+    }
+  }
+  return mappings;
+}
+
+}  // namespace flutter
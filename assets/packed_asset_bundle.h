@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+#define FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flutter/assets/asset_resolver.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Resolves assets from a single archive that packs all of them,
+///             so that looking up an asset needs neither a file system lookup
+///             nor a system call.
+///
+///             The archive starts with an index of its assets that is keyed
+///             by a minimal perfect hash of their names, so that any asset is
+///             found by hashing its name twice and comparing it with the name
+///             of a single entry. Assets that are stored as they are start at
+///             a page boundary and are returned as views into the mapping of
+///             the archive. Assets that compress well, which are generally
+///             the ones that are not already compressed images, may be stored
+///             deflated instead and are inflated into memory when they are
+///             read.
+///
+///             The archive is kept mapped for as long as the resolver or any
+///             mapping it returned is alive.
+///
+class PackedAssetBundle : public AssetResolver {
+ public:
+  /// The name of the archive in the assets directory, which the tooling
+  /// writes for builds that do not update their assets while they run.
+  static constexpr char kArchiveName[] = "assets.pack";
+
+  /// An asset to write into an archive.
+  struct Asset {
+    /// The name of the asset, relative to the assets directory.
+    std::string name;
+    std::vector<uint8_t> data;
+    /// Whether the asset is stored deflated if that makes it smaller.
+    bool compress = false;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes an archive of the given assets.
+  ///
+  /// @return     The contents of the archive, or an empty vector if two of the
+  ///             assets have the same name.
+  ///
+  static std::vector<uint8_t> Pack(const std::vector<Asset>& assets);
+
+  PackedAssetBundle(std::unique_ptr<fml::Mapping> archive,
+                    bool is_valid_after_asset_manager_change);
+
+  ~PackedAssetBundle() override;
+
+ private:
+  struct Entry;
+
+  std::shared_ptr<fml::Mapping> archive_;
+  uint32_t entry_count_ = 0;
+  uint32_t bucket_count_ = 0;
+  bool is_valid_ = false;
+  bool is_valid_after_asset_manager_change_ = false;
+
+  std::optional<Entry> GetEntry(uint32_t slot) const;
+
+  std::optional<Entry> FindEntry(std::string_view name) const;
+
+  std::string_view GetName(const Entry& entry) const;
+
+  std::unique_ptr<fml::Mapping> GetEntryMapping(const Entry& entry) const;
+
+  // |AssetResolver|
+  bool IsValid() const override;
+
+  // |AssetResolver|
+  bool IsValidAfterAssetManagerChange() const override;
+
+  // |AssetResolver|
+  AssetResolver::AssetResolverType GetType() const override;
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override;
+
+  // |AssetResolver|
+  std::vector<std::unique_ptr<fml::Mapping>> GetAsMappings(
+      const std::string& asset_pattern,
+      const std::optional<std::string>& subdir) const override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedAssetBundle);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
@@ -4,6 +4,8 @@
 
 #include "flutter/common/graphics/persistent_cache.h"
 
+#include <algorithm>
+#include <cstring>
 #include <future>
 #include <memory>
 #include <string>
@@ -16,10 +18,13 @@
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/paths.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/shell/version/version.h"
 #include "openssl/sha.h"
 #include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/skia/include/utils/SkBase64.h"
 
@@ -45,10 +50,20 @@ std::string PersistentCache::SkKeyToFilePath(const SkData& key) {
   return fml::HexEncode(view);
 }
 
+bool PersistentCache::IsVkPipelineCacheKey(const SkData& key) {
+  // Skia stores the Vulkan pipeline cache under a key holding only
+  // GrVkGpu::kPipelineCache_PersistentCacheKeyType.
+  static constexpr uint32_t kVkPipelineCacheKeyType = 1;
+  return key.size() == sizeof(uint32_t) &&
+         memcmp(key.data(), &kVkPipelineCacheKeyType, sizeof(uint32_t)) == 0;
+}
+
 bool PersistentCache::gIsReadOnly = false;
 
 std::atomic<bool> PersistentCache::cache_sksl_ = false;
 std::atomic<bool> PersistentCache::strategy_set_ = false;
+std::atomic<bool> PersistentCache::prioritize_sksl_precompilation_ = false;
+std::atomic<bool> PersistentCache::use_pack_files_ = false;
 
 void PersistentCache::SetCacheSkSL(bool value) {
   if (strategy_set_ && value != cache_sksl_) {
@@ -102,7 +117,13 @@ bool PersistentCache::Purge() {
       removed.set_value(false);
     }
   });
-  return removed.get_future().get();
+  bool purged = removed.get_future().get();
+
+  // The pack files are opened again, empty, on their next use.
+  std::scoped_lock lock(packs_mutex_);
+  shader_pack_.reset();
+  sksl_pack_.reset();
+  return purged;
 }
 
 namespace {
@@ -131,7 +152,7 @@ static void FreeOldCacheDirectory(const fml::UniqueFD& cache_base_dir) {
 static std::shared_ptr<fml::UniqueFD> MakeCacheDirectory(
     const std::string& global_cache_base_path,
     bool read_only,
-    bool cache_sksl) {
+    const char* subdir_name) {
   fml::UniqueFD cache_base_dir;
   if (global_cache_base_path.length()) {
     cache_base_dir = fml::OpenDirectory(global_cache_base_path.c_str(), false,
@@ -144,8 +165,8 @@ static std::shared_ptr<fml::UniqueFD> MakeCacheDirectory(
     FreeOldCacheDirectory(cache_base_dir);
     std::vector<std::string> components = {
         kEngineComponent, GetFlutterEngineVersion(), "skia", GetSkiaVersion()};
-    if (cache_sksl) {
-      components.push_back(PersistentCache::kSkSLSubdirName);
+    if (subdir_name) {
+      components.push_back(subdir_name);
     }
     return std::make_shared<fml::UniqueFD>(
         CreateDirectory(cache_base_dir, components,
@@ -191,10 +212,11 @@ sk_sp<SkData> ParseBase64(const std::string& input) {
 }
 
 size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) const {
+  const bool prioritize = prioritize_sksl_precompilation_;
   // clang-tidy has trouble reasoning about some of the complicated array and
   // pointer-arithmetic code in rapidjson.
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.PlacementNew)
-  auto known_sksls = LoadSkSLs();
+  auto known_sksls = prioritize ? LoadSkSLsByUsage() : LoadSkSLs();
   // A trace must be present even if no precompilations have been completed.
   FML_TRACE_EVENT("flutter", "PersistentCache::PrecompileKnownSkSLs", "count",
                   known_sksls.size());
@@ -203,6 +225,21 @@ size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) const {
     return 0;
   }
 
+  if (prioritize) {
+    std::vector<SkSLCache> pending;
+    if (known_sksls.size() > kPrioritizedSkSLCount) {
+      pending.assign(known_sksls.rbegin(),
+                     known_sksls.rend() - kPrioritizedSkSLCount);
+      known_sksls.resize(kPrioritizedSkSLCount);
+    }
+    std::scoped_lock lock(pending_sksls_mutex_);
+    if (pending.empty()) {
+      pending_sksls_.erase(context);
+    } else {
+      pending_sksls_[context] = std::move(pending);
+    }
+  }
+
   size_t precompiled_count = 0;
   for (const auto& sksl : known_sksls) {
     TRACE_EVENT0("flutter", "PrecompilingSkSL");
@@ -217,6 +254,113 @@ size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) const {
   return precompiled_count;
 }
 
+bool PersistentCache::PrecompilePendingSkSLs(GrDirectContext* context,
+                                             fml::TimeDelta budget) const {
+  TRACE_EVENT0("flutter", "PersistentCache::PrecompilePendingSkSLs");
+  const fml::TimePoint deadline = fml::TimePoint::Now() + budget;
+  do {
+    SkSLCache sksl;
+    {
+      std::scoped_lock lock(pending_sksls_mutex_);
+      auto found = pending_sksls_.find(context);
+      if (found == pending_sksls_.end()) {
+        return false;
+      }
+      sksl = std::move(found->second.back());
+      found->second.pop_back();
+      if (found->second.empty()) {
+        pending_sksls_.erase(found);
+      }
+    }
+    TRACE_EVENT0("flutter", "PrecompilingSkSL");
+    context->precompileShader(*sksl.key, *sksl.value);
+  } while (fml::TimePoint::Now() < deadline);
+
+  std::scoped_lock lock(pending_sksls_mutex_);
+  return pending_sksls_.find(context) != pending_sksls_.end();
+}
+
+void PersistentCache::DiscardPendingSkSLs(GrDirectContext* context) const {
+  std::scoped_lock lock(pending_sksls_mutex_);
+  pending_sksls_.erase(context);
+}
+
+size_t PersistentCache::GetPendingSkSLBytesLocked() const {
+  size_t bytes = 0;
+  for (const auto& [context, sksls] : pending_sksls_) {
+    for (const SkSLCache& sksl : sksls) {
+      bytes += sksl.key->size() + sksl.value->size();
+    }
+  }
+  return bytes;
+}
+
+size_t PersistentCache::GetPendingSkSLBytes() const {
+  std::scoped_lock lock(pending_sksls_mutex_);
+  return GetPendingSkSLBytesLocked();
+}
+
+size_t PersistentCache::ReleasePendingSkSLs() const {
+  std::scoped_lock lock(pending_sksls_mutex_);
+  size_t bytes = GetPendingSkSLBytesLocked();
+  pending_sksls_.clear();
+  return bytes;
+}
+
+std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLsByUsage()
+    const {
+  std::vector<SkSLCache> sksls = LoadSkSLs();
+  std::vector<std::pair<uint32_t, size_t>> order;
+  {
+    std::scoped_lock lock(sksl_usage_mutex_);
+    LoadSkSLUsageCountsLocked();
+    for (size_t i = 0; i < sksls.size(); i++) {
+      auto found = sksl_usage_counts_.find(SkKeyToFilePath(*sksls[i].key));
+      uint32_t count = found == sksl_usage_counts_.end() ? 0 : found->second;
+      order.push_back({count, i});
+    }
+  }
+  std::stable_sort(
+      order.begin(), order.end(),
+      [](const auto& a, const auto& b) { return a.first > b.first; });
+  std::vector<SkSLCache> result;
+  result.reserve(sksls.size());
+  for (const auto& item : order) {
+    result.push_back(std::move(sksls[item.second]));
+  }
+  return result;
+}
+
+void PersistentCache::LoadSkSLUsageCountsLocked() const {
+  if (sksl_usage_loaded_) {
+    return;
+  }
+  sksl_usage_loaded_ = true;
+  if (!IsValid()) {
+    return;
+  }
+  auto file = fml::OpenFileReadOnly(*cache_directory_, kSkSLUsageFileName);
+  if (!file.is_valid()) {
+    return;
+  }
+  fml::FileMapping mapping(file);
+  if (mapping.GetSize() == 0) {
+    return;
+  }
+  rapidjson::Document json_doc;
+  json_doc.Parse(reinterpret_cast<const char*>(mapping.GetMapping()),
+                 mapping.GetSize());
+  if (json_doc.HasParseError() || !json_doc.IsObject()) {
+    FML_LOG(ERROR) << "Failed to parse json file: " << kSkSLUsageFileName;
+    return;
+  }
+  for (auto& item : json_doc.GetObject()) {
+    if (item.value.IsUint()) {
+      sksl_usage_counts_[item.name.GetString()] = item.value.GetUint();
+    }
+  }
+}
+
 std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
   TRACE_EVENT0("flutter", "PersistentCache::LoadSkSLs");
   std::vector<PersistentCache::SkSLCache> result;
@@ -234,7 +378,11 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
   // Only visit sksl_cache_directory_ if this persistent cache is valid.
   // However, we'd like to continue visit the asset dir even if this persistent
   // cache is invalid.
-  if (IsValid()) {
+  if (IsValid() && use_pack_files_) {
+    for (PersistentCachePack::Entry& entry : GetPack(true)->LoadAll()) {
+      result.push_back({std::move(entry.key), std::move(entry.value)});
+    }
+  } else if (IsValid()) {
     // In case `rewinddir` doesn't work reliably, load SkSLs from a freshly
     // opened directory (https://github.com/flutter/flutter/issues/65258).
     fml::UniqueFD fresh_dir =
@@ -274,11 +422,36 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
   return result;
 }
 
+void PersistentCache::PrefetchSkSLs() const {
+  TRACE_EVENT0("flutter", "PersistentCache::PrefetchSkSLs");
+  if (!IsValid()) {
+    return;
+  }
+  if (use_pack_files_) {
+    fml::PrefetchFile(*cache_directory_, kSkSLPackFileName);
+    return;
+  }
+  fml::UniqueFD directory =
+      fml::OpenDirectoryReadOnly(*cache_directory_, kSkSLSubdirName);
+  if (!directory.is_valid()) {
+    return;
+  }
+  fml::VisitFiles(directory, [](const fml::UniqueFD& directory,
+                                const std::string& filename) {
+    fml::PrefetchFile(directory, filename.c_str());
+    return true;
+  });
+}
+
 PersistentCache::PersistentCache(bool read_only)
     : is_read_only_(read_only),
-      cache_directory_(MakeCacheDirectory(cache_base_path_, read_only, false)),
+      cache_directory_(
+          MakeCacheDirectory(cache_base_path_, read_only, nullptr)),
       sksl_cache_directory_(
-          MakeCacheDirectory(cache_base_path_, read_only, true)) {
+          MakeCacheDirectory(cache_base_path_, read_only, kSkSLSubdirName)),
+      raster_cache_directory_(MakeCacheDirectory(cache_base_path_,
+                                                 read_only,
+                                                 kRasterCacheSubdirName)) {
   if (!IsValid()) {
     FML_LOG(WARNING) << "Could not acquire the persistent cache directory. "
                         "Caching of GPU resources on disk is disabled.";
@@ -291,6 +464,17 @@ bool PersistentCache::IsValid() const {
   return cache_directory_ && cache_directory_->is_valid();
 }
 
+std::shared_ptr<PersistentCachePack> PersistentCache::GetPack(
+    bool sksl) const {
+  std::scoped_lock lock(packs_mutex_);
+  std::shared_ptr<PersistentCachePack>& pack = sksl ? sksl_pack_ : shader_pack_;
+  if (!pack) {
+    pack = std::make_shared<PersistentCachePack>(
+        cache_directory_, sksl ? kSkSLPackFileName : kShaderPackFileName);
+  }
+  return pack;
+}
+
 PersistentCache::SkSLCache PersistentCache::LoadFile(
     const fml::UniqueFD& dir,
     const std::string& file_name,
@@ -331,6 +515,13 @@ sk_sp<SkData> PersistentCache::load(const SkData& key) {
   if (!IsValid()) {
     return nullptr;
   }
+  if (use_pack_files_) {
+    auto result = GetPack(false)->Load(key);
+    if (result != nullptr) {
+      TRACE_EVENT0("flutter", "PersistentCacheLoadHit");
+    }
+    return result;
+  }
   auto file_name = SkKeyToFilePath(key);
   if (file_name.size() == 0) {
     return nullptr;
@@ -371,6 +562,95 @@ static void PersistentCacheStore(fml::RefPtr<fml::TaskRunner> worker,
   }
 }
 
+void PersistentCache::RecordSkSLUsage(const std::string& file_name) {
+  rapidjson::StringBuffer buffer;
+  {
+    std::scoped_lock lock(sksl_usage_mutex_);
+    LoadSkSLUsageCountsLocked();
+    sksl_usage_counts_[file_name]++;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    for (const auto& item : sksl_usage_counts_) {
+      writer.Key(item.first.c_str());
+      writer.Uint(item.second);
+    }
+    writer.EndObject();
+  }
+  auto mapping = std::make_unique<fml::DataMapping>(std::vector<uint8_t>(
+      buffer.GetString(), buffer.GetString() + buffer.GetSize()));
+  PersistentCacheStore(GetWorkerTaskRunner(), cache_directory_,
+                       kSkSLUsageFileName, std::move(mapping));
+}
+
+std::unique_ptr<fml::Mapping> PersistentCache::LoadFontFallbackMatches()
+    const {
+  TRACE_EVENT0("flutter", "PersistentCache::LoadFontFallbackMatches");
+  if (!IsValid()) {
+    return nullptr;
+  }
+  auto file = fml::OpenFileReadOnly(*cache_directory_, kFontFallbacksFileName);
+  if (!file.is_valid()) {
+    return nullptr;
+  }
+  auto mapping = std::make_unique<fml::FileMapping>(file);
+  if (mapping->GetSize() == 0) {
+    return nullptr;
+  }
+  return mapping;
+}
+
+void PersistentCache::StoreFontFallbackMatches(const std::string& data) {
+  if (is_read_only_ || !IsValid() || data.empty()) {
+    return;
+  }
+  auto mapping = std::make_unique<fml::DataMapping>(
+      std::vector<uint8_t>(data.begin(), data.end()));
+  PersistentCacheStore(GetWorkerTaskRunner(), cache_directory_,
+                       kFontFallbacksFileName, std::move(mapping));
+}
+
+std::vector<std::string> PersistentCache::LoadStartupAssets() const {
+  TRACE_EVENT0("flutter", "PersistentCache::LoadStartupAssets");
+  std::vector<std::string> asset_names;
+  if (!IsValid()) {
+    return asset_names;
+  }
+  auto file = fml::OpenFileReadOnly(*cache_directory_, kStartupAssetsFileName);
+  if (!file.is_valid()) {
+    return asset_names;
+  }
+  fml::FileMapping mapping(file);
+  std::string_view data(reinterpret_cast<const char*>(mapping.GetMapping()),
+                        mapping.GetSize());
+  while (!data.empty()) {
+    size_t end = std::min(data.find('\n'), data.size());
+    if (end > 0) {
+      asset_names.emplace_back(data.substr(0, end));
+    }
+    data.remove_prefix(std::min(end + 1, data.size()));
+  }
+  return asset_names;
+}
+
+void PersistentCache::StoreStartupAssets(
+    const std::vector<std::string>& asset_names) {
+  if (is_read_only_ || !IsValid() || asset_names.empty()) {
+    return;
+  }
+  // One name per line. Names with line breaks are not worth escaping.
+  std::vector<uint8_t> data;
+  for (const auto& name : asset_names) {
+    if (name.find('\n') != std::string::npos) {
+      continue;
+    }
+    data.insert(data.end(), name.begin(), name.end());
+    data.push_back('\n');
+  }
+  PersistentCacheStore(GetWorkerTaskRunner(), cache_directory_,
+                       kStartupAssetsFileName,
+                       std::make_unique<fml::DataMapping>(std::move(data)));
+}
+
 std::unique_ptr<fml::MallocMapping> PersistentCache::BuildCacheObject(
     const SkData& key,
     const SkData& data) {
@@ -409,16 +689,98 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
     return;
   }
 
+  // The Vulkan pipeline cache is not SkSL, and is always loaded from the
+  // shader cache, even when SkSL is being cached.
+  bool sksl = cache_sksl_ && !IsVkPipelineCacheKey(key);
+
+  if (sksl && prioritize_sksl_precompilation_) {
+    RecordSkSLUsage(file_name);
+  }
+
+  if (use_pack_files_) {
+    GetPack(sksl)->Store(key, data, GetWorkerTaskRunner());
+    return;
+  }
+
   std::unique_ptr<fml::MallocMapping> mapping = BuildCacheObject(key, data);
   if (!mapping) {
     return;
   }
 
   PersistentCacheStore(GetWorkerTaskRunner(),
-                       cache_sksl_ ? sksl_cache_directory_ : cache_directory_,
+                       sksl ? sksl_cache_directory_ : cache_directory_,
+                       std::move(file_name), std::move(mapping));
+}
+
+std::vector<PersistentCache::SkSLCache> PersistentCache::LoadRasterCacheImages()
+    const {
+  TRACE_EVENT0("flutter", "PersistentCache::LoadRasterCacheImages");
+  std::vector<PersistentCache::SkSLCache> result;
+  if (!raster_cache_directory_ || !raster_cache_directory_->is_valid()) {
+    return result;
+  }
+  fml::FileVisitor visitor = [&result](const fml::UniqueFD& directory,
+                                       const std::string& filename) {
+    SkSLCache cache = LoadFile(directory, filename, true);
+    if (cache.key != nullptr && cache.value != nullptr) {
+      result.push_back(cache);
+    } else {
+      FML_LOG(ERROR) << "Failed to load: " << filename;
+    }
+    return true;
+  };
+  // Load from a freshly opened directory for the same reason as LoadSkSLs.
+  fml::UniqueFD fresh_dir =
+      fml::OpenDirectoryReadOnly(*cache_directory_, kRasterCacheSubdirName);
+  if (fresh_dir.is_valid()) {
+    fml::VisitFiles(fresh_dir, visitor);
+  }
+  return result;
+}
+
+void PersistentCache::StoreRasterCacheImage(const SkData& key,
+                                            const SkData& data) {
+  if (is_read_only_ || !raster_cache_directory_ ||
+      !raster_cache_directory_->is_valid()) {
+    return;
+  }
+
+  auto file_name = SkKeyToFilePath(key);
+  if (file_name.size() == 0) {
+    return;
+  }
+
+  std::unique_ptr<fml::MallocMapping> mapping = BuildCacheObject(key, data);
+  if (!mapping) {
+    return;
+  }
+
+  PersistentCacheStore(GetWorkerTaskRunner(), raster_cache_directory_,
                        std::move(file_name), std::move(mapping));
 }
 
+void PersistentCache::RemoveRasterCacheImage(const SkData& key) {
+  if (is_read_only_ || !raster_cache_directory_ ||
+      !raster_cache_directory_->is_valid()) {
+    return;
+  }
+
+  auto file_name = SkKeyToFilePath(key);
+  if (file_name.size() == 0) {
+    return;
+  }
+
+  auto task = [cache_directory = raster_cache_directory_,
+               file_name = std::move(file_name)]() {
+    fml::UnlinkFile(*cache_directory, file_name.c_str());
+  };
+  if (auto worker = GetWorkerTaskRunner()) {
+    worker->PostTask(std::move(task));
+  } else {
+    task();
+  }
+}
+
 void PersistentCache::DumpSkp(const SkData& data) {
   if (is_read_only_ || !IsValid()) {
     FML_LOG(ERROR) << "Could not dump SKP from read-only or invalid persistent "
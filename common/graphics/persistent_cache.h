@@ -8,10 +8,15 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "flutter/assets/asset_manager.h"
+#include "flutter/common/graphics/persistent_cache_pack.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/unique_fd.h"
 #include "third_party/skia/include/gpu/GrContextOptions.h"
 
@@ -47,6 +52,14 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   // json keys.
   static std::string SkKeyToFilePath(const SkData& key);
 
+  // Whether the key is the one Skia stores the Vulkan pipeline cache under.
+  //
+  // The pipeline cache data begins with the vendor ID, device ID, and pipeline
+  // cache UUID of the device that created it, which Skia checks before using
+  // it. As the UUID changes with the driver version, data written by another
+  // device or driver is ignored and replaced with the next store.
+  static bool IsVkPipelineCacheKey(const SkData& key);
+
   // Allocate a MallocMapping containing the given key and value in the file
   // format used by the cache.
   static std::unique_ptr<fml::MallocMapping> BuildCacheObject(
@@ -111,6 +124,69 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   ///
   size_t PrecompileKnownSkSLs(GrDirectContext* context) const;
 
+  /// Load all the SkSL shader caches like |LoadSkSLs|, ordered by how many
+  /// times they had to be compiled during the frames of previous runs, most
+  /// often first.
+  std::vector<SkSLCache> LoadSkSLsByUsage() const;
+
+  /// Asks the system to read the files of the SkSLs cached in previous runs
+  /// ahead, so that |LoadSkSLs| does not wait for the storage when the first
+  /// surface precompiles them.
+  void PrefetchSkSLs() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Precompile the SkSLs that |PrecompileKnownSkSLs| left pending
+  ///             for the given context, for up to |budget|. At least one SkSL
+  ///             is precompiled if any is pending.
+  ///
+  /// @param      context  The rendering context given to
+  ///                      |PrecompileKnownSkSLs|, which must be current.
+  /// @param      budget   The time after which no more SkSLs are precompiled.
+  ///
+  /// @return     Whether SkSLs are still pending for the context.
+  ///
+  bool PrecompilePendingSkSLs(GrDirectContext* context,
+                              fml::TimeDelta budget) const;
+
+  /// Forget the SkSLs pending for |context|, which is being destroyed.
+  void DiscardPendingSkSLs(GrDirectContext* context) const;
+
+  /// The memory of the SkSLs that are loaded and pending for all of the
+  /// contexts.
+  size_t GetPendingSkSLBytes() const;
+
+  /// Forget the SkSLs pending for all of the contexts, for example under
+  /// memory pressure, so that they are compiled when a frame needs them
+  /// instead. Returns the memory they used.
+  size_t ReleasePendingSkSLs() const;
+
+  /// Load all the raster cache images stored by |StoreRasterCacheImage|.
+  std::vector<SkSLCache> LoadRasterCacheImages() const;
+
+  /// Store the encoded image of a raster cache entry under |key|, on a
+  /// worker thread if one is available.
+  void StoreRasterCacheImage(const SkData& key, const SkData& data);
+
+  /// Remove the raster cache image stored under |key|.
+  void RemoveRasterCacheImage(const SkData& key);
+
+  /// Load the font fallback matches stored by |StoreFontFallbackMatches|, or
+  /// null if there are none. This reads a file, so it should not be called on
+  /// the UI thread.
+  std::unique_ptr<fml::Mapping> LoadFontFallbackMatches() const;
+
+  /// Store the font fallback matches encoded by the font collection, on a
+  /// worker thread if one is available.
+  void StoreFontFallbackMatches(const std::string& data);
+
+  /// Load the names of the assets stored by |StoreStartupAssets|. This reads a
+  /// file, so it should not be called on the UI thread.
+  std::vector<std::string> LoadStartupAssets() const;
+
+  /// Store the names of the assets that were read before the first frame, on
+  /// a worker thread if one is available.
+  void StoreStartupAssets(const std::vector<std::string>& asset_names);
+
   // Return mappings for all skp's accessible through the AssetManager
   std::vector<std::unique_ptr<fml::Mapping>> GetSkpsFromAssetManager() const;
 
@@ -127,8 +203,38 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   static void MarkStrategySet() { strategy_set_ = true; }
 
+  static bool use_pack_files() { return use_pack_files_; }
+
+  // If true, the shaders are stored into and loaded from the
+  // |kShaderPackFileName| and |kSkSLPackFileName| pack files, instead of
+  // from one file per shader. This must be set before any shader is stored
+  // or loaded.
+  static void SetUsePackFiles(bool value) { use_pack_files_ = value; }
+
+  static bool prioritize_sksl_precompilation() {
+    return prioritize_sksl_precompilation_;
+  }
+
+  // If true, |PrecompileKnownSkSLs| only precompiles the
+  // |kPrioritizedSkSLCount| most used SkSLs and leaves the rest to
+  // |PrecompilePendingSkSLs|, and the SkSLs compiled during frames are
+  // counted for the next runs.
+  static void SetPrioritizeSkSLPrecompilation(bool value) {
+    prioritize_sksl_precompilation_ = value;
+  }
+
+  // The number of SkSLs that are precompiled before the first frame when
+  // the precompilation is prioritized.
+  static constexpr size_t kPrioritizedSkSLCount = 16;
+
   static constexpr char kSkSLSubdirName[] = "sksl";
+  static constexpr char kRasterCacheSubdirName[] = "raster_cache";
   static constexpr char kAssetFileName[] = "io.flutter.shaders.json";
+  static constexpr char kSkSLUsageFileName[] = "sksl_usage.json";
+  static constexpr char kShaderPackFileName[] = "shaders.pack";
+  static constexpr char kSkSLPackFileName[] = "sksl.pack";
+  static constexpr char kFontFallbacksFileName[] = "font_fallbacks";
+  static constexpr char kStartupAssetsFileName[] = "startup_assets";
 
  private:
   static std::string cache_base_path_;
@@ -148,21 +254,56 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   // strategy_set_ becomes true.
   static std::atomic<bool> strategy_set_;
 
+  static std::atomic<bool> prioritize_sksl_precompilation_;
+
+  static std::atomic<bool> use_pack_files_;
+
   const bool is_read_only_;
   const std::shared_ptr<fml::UniqueFD> cache_directory_;
   const std::shared_ptr<fml::UniqueFD> sksl_cache_directory_;
+  const std::shared_ptr<fml::UniqueFD> raster_cache_directory_;
   mutable std::mutex worker_task_runners_mutex_;
   std::multiset<fml::RefPtr<fml::TaskRunner>> worker_task_runners_;
 
   bool stored_new_shaders_ = false;
   bool is_dumping_skp_ = false;
 
+  // The number of times each SkSL, by file name, has been compiled during
+  // frames, loaded from |kSkSLUsageFileName| on first use.
+  mutable std::mutex sksl_usage_mutex_;
+  mutable bool sksl_usage_loaded_ = false;
+  mutable std::unordered_map<std::string, uint32_t> sksl_usage_counts_;
+
+  // The pack files of the shaders and of the SkSLs, which are opened on
+  // first use.
+  mutable std::mutex packs_mutex_;
+  mutable std::shared_ptr<PersistentCachePack> shader_pack_;
+  mutable std::shared_ptr<PersistentCachePack> sksl_pack_;
+
+  // The SkSLs still to be precompiled by |PrecompilePendingSkSLs| for each
+  // rendering context, in reverse order.
+  mutable std::mutex pending_sksls_mutex_;
+  mutable std::unordered_map<GrDirectContext*, std::vector<SkSLCache>>
+      pending_sksls_;
+
   static SkSLCache LoadFile(const fml::UniqueFD& dir,
                             const std::string& file_name,
                             bool need_key);
 
   bool IsValid() const;
 
+  // Returns the pack file of the SkSLs if |sksl| is true, or of the other
+  // shaders.
+  std::shared_ptr<PersistentCachePack> GetPack(bool sksl) const;
+
+  // Must be called with |sksl_usage_mutex_| held.
+  void LoadSkSLUsageCountsLocked() const;
+
+  // Must be called with |pending_sksls_mutex_| held.
+  size_t GetPendingSkSLBytesLocked() const;
+
+  void RecordSkSLUsage(const std::string& file_name);
+
   explicit PersistentCache(bool read_only = false);
 
   // |GrContextOptions::PersistentCache|
@@ -0,0 +1,269 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/graphics/persistent_cache_pack.h"
+
+#include <cstring>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+PersistentCachePack::PersistentCachePack(
+    std::shared_ptr<fml::UniqueFD> directory,
+    std::string file_name)
+    : directory_(std::move(directory)), file_name_(std::move(file_name)) {
+  TRACE_EVENT0("flutter", "PersistentCachePack::Open");
+  if (!directory_ || !directory_->is_valid()) {
+    return;
+  }
+  auto file = fml::OpenFileReadOnly(*directory_, file_name_.c_str());
+  if (!file.is_valid()) {
+    return;
+  }
+  auto mapping = std::make_unique<fml::FileMapping>(file);
+  const uint8_t* bytes = mapping->GetMapping();
+  const size_t size = mapping->GetSize();
+
+  FileHeader header;
+  header.signature = 0;
+  if (bytes != nullptr && size >= sizeof(FileHeader)) {
+    memcpy(&header, bytes, sizeof(FileHeader));
+  }
+  if (header.signature != FileHeader::kSignature ||
+      header.version != FileHeader::kVersion1) {
+    FML_LOG(INFO) << "Persistent cache pack header is corrupt: " << file_name_;
+    needs_compaction_ = true;
+    return;
+  }
+
+  size_t offset = sizeof(FileHeader);
+  while (size - offset >= sizeof(RecordHeader)) {
+    RecordHeader record;
+    memcpy(&record, bytes + offset, sizeof(RecordHeader));
+    const size_t key_offset = offset + sizeof(RecordHeader);
+    if (record.signature != RecordHeader::kSignature || record.key_size == 0 ||
+        size - key_offset <
+            static_cast<size_t>(record.key_size) + record.value_size) {
+      break;
+    }
+    const size_t record_size =
+        sizeof(RecordHeader) + record.key_size + record.value_size;
+    IndexEntry& entry = index_[std::string(
+        reinterpret_cast<const char*>(bytes + key_offset), record.key_size)];
+    if (entry.record_size != 0) {
+      dead_bytes_ += entry.record_size;
+      live_bytes_ -= entry.record_size;
+    }
+    entry.value_offset = key_offset + record.key_size;
+    entry.value_size = record.value_size;
+    entry.record_size = record_size;
+    live_bytes_ += record_size;
+    offset += record_size;
+  }
+  if (offset != size) {
+    FML_LOG(INFO) << "Persistent cache pack ends with a partial record: "
+                  << file_name_;
+    needs_compaction_ = true;
+  }
+  file_size_ = offset;
+  mapping_ = std::move(mapping);
+}
+
+PersistentCachePack::~PersistentCachePack() = default;
+
+sk_sp<SkData> PersistentCachePack::GetValueLocked(
+    const IndexEntry& entry) const {
+  if (entry.value) {
+    return entry.value;
+  }
+  return SkData::MakeWithCopy(mapping_->GetMapping() + entry.value_offset,
+                              entry.value_size);
+}
+
+sk_sp<SkData> PersistentCachePack::Load(const SkData& key) const {
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(
+      std::string(static_cast<const char*>(key.data()), key.size()));
+  if (found == index_.end()) {
+    return nullptr;
+  }
+  return GetValueLocked(found->second);
+}
+
+std::vector<PersistentCachePack::Entry> PersistentCachePack::LoadAll() const {
+  TRACE_EVENT0("flutter", "PersistentCachePack::LoadAll");
+  std::vector<Entry> result;
+  std::scoped_lock lock(mutex_);
+  result.reserve(index_.size());
+  for (const auto& item : index_) {
+    result.push_back(
+        {SkData::MakeWithCopy(item.first.data(), item.first.size()),
+         GetValueLocked(item.second)});
+  }
+  return result;
+}
+
+size_t PersistentCachePack::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return index_.size();
+}
+
+void PersistentCachePack::Store(const SkData& key,
+                                const SkData& value,
+                                fml::RefPtr<fml::TaskRunner> worker) {
+  if (key.size() == 0) {
+    return;
+  }
+  std::string key_string(static_cast<const char*>(key.data()), key.size());
+  sk_sp<SkData> value_copy = SkData::MakeWithCopy(value.data(), value.size());
+  {
+    std::scoped_lock lock(mutex_);
+    IndexEntry& entry = index_[key_string];
+    if (entry.record_size != 0) {
+      dead_bytes_ += entry.record_size;
+      live_bytes_ -= entry.record_size;
+    }
+    entry.value = value_copy;
+    entry.record_size = sizeof(RecordHeader) + key.size() + value.size();
+    live_bytes_ += entry.record_size;
+  }
+
+  auto task = [pack = shared_from_this(), key = std::move(key_string),
+               value = std::move(value_copy)]() {
+    pack->Write(key, value);
+  };
+  if (worker) {
+    worker->PostTask(std::move(task));
+  } else {
+    task();
+  }
+}
+
+void PersistentCachePack::Write(const std::string& key, sk_sp<SkData> value) {
+  TRACE_EVENT0("flutter", "PersistentCachePack::Write");
+  if (!directory_ || !directory_->is_valid()) {
+    return;
+  }
+  std::scoped_lock write_lock(write_mutex_);
+  bool compact = needs_compaction_;
+  {
+    std::scoped_lock lock(mutex_);
+    compact = compact || (dead_bytes_ > live_bytes_ &&
+                          dead_bytes_ >= kMinCompactionBytes);
+  }
+  if (compact) {
+    // The compacted file already holds the new value.
+    if (!CompactLocked()) {
+      FML_LOG(WARNING) << "Could not compact the persistent cache pack.";
+    }
+    return;
+  }
+  if (!AppendLocked(key, *value)) {
+    FML_LOG(WARNING) << "Could not append to the persistent cache pack.";
+  }
+}
+
+bool PersistentCachePack::AppendLocked(const std::string& key,
+                                       const SkData& value) {
+  auto file = fml::OpenFile(*directory_, file_name_.c_str(), true,
+                            fml::FilePermission::kReadWrite);
+  if (!file.is_valid()) {
+    return false;
+  }
+  const size_t header_size = file_size_ == 0 ? sizeof(FileHeader) : 0;
+  const size_t record_size = sizeof(RecordHeader) + key.size() + value.size();
+  const size_t new_size = file_size_ + header_size + record_size;
+  if (!fml::TruncateFile(file, new_size)) {
+    return false;
+  }
+  fml::FileMapping mapping(file, {fml::FileMapping::Protection::kRead,
+                                  fml::FileMapping::Protection::kWrite});
+  uint8_t* bytes = mapping.GetMutableMapping();
+  if (bytes == nullptr || mapping.GetSize() != new_size) {
+    return false;
+  }
+  bytes += file_size_;
+  if (header_size != 0) {
+    FileHeader header;
+    memcpy(bytes, &header, sizeof(FileHeader));
+    bytes += sizeof(FileHeader);
+  }
+  RecordHeader record;
+  record.key_size = key.size();
+  record.value_size = value.size();
+  memcpy(bytes, &record, sizeof(RecordHeader));
+  memcpy(bytes + sizeof(RecordHeader), key.data(), key.size());
+  memcpy(bytes + sizeof(RecordHeader) + key.size(), value.data(),
+         value.size());
+  file_size_ = new_size;
+  return true;
+}
+
+bool PersistentCachePack::CompactLocked() {
+  TRACE_EVENT0("flutter", "PersistentCachePack::Compact");
+  std::vector<std::pair<std::string, sk_sp<SkData>>> entries;
+  size_t size = sizeof(FileHeader);
+  {
+    std::scoped_lock lock(mutex_);
+    entries.reserve(index_.size());
+    for (const auto& item : index_) {
+      entries.push_back({item.first, GetValueLocked(item.second)});
+      size += item.second.record_size;
+    }
+  }
+
+  std::vector<uint8_t> buffer(size);
+  uint8_t* bytes = buffer.data();
+  FileHeader header;
+  memcpy(bytes, &header, sizeof(FileHeader));
+  size_t offset = sizeof(FileHeader);
+  std::vector<size_t> value_offsets;
+  value_offsets.reserve(entries.size());
+  for (const auto& [key, value] : entries) {
+    RecordHeader record;
+    record.key_size = key.size();
+    record.value_size = value->size();
+    memcpy(bytes + offset, &record, sizeof(RecordHeader));
+    offset += sizeof(RecordHeader);
+    memcpy(bytes + offset, key.data(), key.size());
+    offset += key.size();
+    value_offsets.push_back(offset);
+    memcpy(bytes + offset, value->data(), value->size());
+    offset += value->size();
+  }
+
+  fml::DataMapping data(std::move(buffer));
+  if (!fml::WriteAtomically(*directory_, file_name_.c_str(), data)) {
+    return false;
+  }
+  auto file = fml::OpenFileReadOnly(*directory_, file_name_.c_str());
+  auto mapping = file.is_valid() ? std::make_unique<fml::FileMapping>(file)
+                                 : nullptr;
+  if (!mapping || mapping->GetSize() != size) {
+    return false;
+  }
+  file_size_ = size;
+  needs_compaction_ = false;
+
+  // Point the entries that were not stored again meanwhile at the new file.
+  std::scoped_lock lock(mutex_);
+  for (size_t i = 0; i < entries.size(); i++) {
+    auto found = index_.find(entries[i].first);
+    if (found == index_.end() ||
+        (found->second.value && found->second.value != entries[i].second)) {
+      continue;
+    }
+    found->second.value = nullptr;
+    found->second.value_offset = value_offsets[i];
+    found->second.value_size = entries[i].second->size();
+  }
+  mapping_ = std::move(mapping);
+  dead_bytes_ = 0;
+  return true;
+}
+
+}  // namespace flutter
@@ -0,0 +1,126 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_PACK_H_
+#define FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_PACK_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/skia/include/core/SkData.h"
+
+namespace flutter {
+
+/// A single file that holds the entries of a |PersistentCache|, so that
+/// loading thousands of shaders at startup costs one file mapping rather
+/// than an open and a read of one file per shader.
+///
+/// The file is a |FileHeader| followed by one record per stored entry: a
+/// |RecordHeader|, the key, and then the value. Stored entries are
+/// appended to the end of the file, and a key that is stored again is
+/// superseded by its latest record. The next write rewrites the file with
+/// only the live entries, which compacts it, in two cases: when superseded
+/// records take more room than the live ones, or when the file ends with a
+/// partially written record.
+///
+/// It is thread-safe. The file is only written by the tasks posted to the
+/// worker task runner given to |Store|.
+class PersistentCachePack
+    : public std::enable_shared_from_this<PersistentCachePack> {
+ public:
+  struct Entry {
+    sk_sp<SkData> key;
+    sk_sp<SkData> value;
+  };
+
+  // The superseded bytes below which the file is never compacted.
+  static constexpr size_t kMinCompactionBytes = 64 * 1024;
+
+  /// Maps and indexes the pack file named |file_name| in |directory|, if
+  /// there is one.
+  PersistentCachePack(std::shared_ptr<fml::UniqueFD> directory,
+                      std::string file_name);
+
+  ~PersistentCachePack();
+
+  /// Returns the value stored under |key|, or nullptr.
+  sk_sp<SkData> Load(const SkData& key) const;
+
+  /// Returns all of the stored entries.
+  std::vector<Entry> LoadAll() const;
+
+  /// Stores |value| under |key|. It is available to |Load| right away, and
+  /// is written to the file on |worker|, or on the calling thread if
+  /// |worker| is null.
+  void Store(const SkData& key,
+             const SkData& value,
+             fml::RefPtr<fml::TaskRunner> worker);
+
+  size_t GetEntryCount() const;
+
+ private:
+  struct FileHeader {
+    static constexpr uint32_t kSignature = 0x4B434150;  // "PACK"
+    static constexpr uint32_t kVersion1 = 1;
+
+    uint32_t signature = kSignature;
+    uint32_t version = kVersion1;
+  };
+
+  struct RecordHeader {
+    static constexpr uint32_t kSignature = 0x44524352;  // "RCRD"
+
+    uint32_t signature = kSignature;
+    uint32_t key_size = 0;
+    uint32_t value_size = 0;
+  };
+
+  struct IndexEntry {
+    // Where the value is in |mapping_|, unless it is held in |value|.
+    size_t value_offset = 0;
+    size_t value_size = 0;
+    size_t record_size = 0;
+    // Set for the values stored since the file was last mapped.
+    sk_sp<SkData> value;
+  };
+
+  // Must be called with |mutex_| held.
+  sk_sp<SkData> GetValueLocked(const IndexEntry& entry) const;
+
+  void Write(const std::string& key, sk_sp<SkData> value);
+
+  // Must be called with |write_mutex_| held.
+  bool AppendLocked(const std::string& key, const SkData& value);
+
+  // Must be called with |write_mutex_| held.
+  bool CompactLocked();
+
+  const std::shared_ptr<fml::UniqueFD> directory_;
+  const std::string file_name_;
+
+  mutable std::mutex mutex_;
+  std::unique_ptr<fml::FileMapping> mapping_;
+  std::unordered_map<std::string, IndexEntry> index_;
+  size_t live_bytes_ = 0;
+  size_t dead_bytes_ = 0;
+
+  // Serializes the writes to the file.
+  std::mutex write_mutex_;
+  // The size of the valid part of the file, where records are appended.
+  size_t file_size_ = 0;
+  bool needs_compaction_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PersistentCachePack);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_PACK_H_
@@ -10,6 +10,93 @@ Texture::Texture(int64_t id) : id_(id) {}
 
 Texture::~Texture() = default;
 
+size_t Texture::GetMemoryBytes() const {
+  return 0;
+}
+
+BufferedTextureFrame::BufferedTextureFrame() = default;
+
+BufferedTextureFrame::~BufferedTextureFrame() = default;
+
+BufferedTexture::BufferedTexture(int64_t id) : Texture(id) {}
+
+BufferedTexture::~BufferedTexture() = default;
+
+void BufferedTexture::PushFrame(std::unique_ptr<BufferedTextureFrame> frame) {
+  if (!frame) {
+    return;
+  }
+  // Released outside of the lock since releasing a frame calls back into its
+  // producer.
+  std::unique_ptr<BufferedTextureFrame> dropped_frame;
+  std::scoped_lock lock(mutex_);
+  if (pending_frames_.size() == kMaxPendingFrames) {
+    dropped_frame = std::move(pending_frames_.front());
+    pending_frames_.pop_front();
+  }
+  pending_frames_.push_back(std::move(frame));
+}
+
+size_t BufferedTexture::GetPendingFrameCount() {
+  std::scoped_lock lock(mutex_);
+  return pending_frames_.size();
+}
+
+void BufferedTexture::Paint(SkCanvas& canvas,
+                            const SkRect& bounds,
+                            bool freeze,
+                            GrDirectContext* context,
+                            const SkSamplingOptions& sampling,
+                            const SkPaint* paint) {
+  if (!freeze) {
+    std::deque<std::unique_ptr<BufferedTextureFrame>> frames;
+    {
+      std::scoped_lock lock(mutex_);
+      frames.swap(pending_frames_);
+    }
+    // The older frames are dropped without ever being painted.
+    if (!frames.empty()) {
+      sk_sp<SkImage> image = frames.back()->MakeImage(context);
+      if (image) {
+        image_ = std::move(image);
+      }
+    }
+  }
+
+  if (!image_) {
+    return;
+  }
+  if (bounds != SkRect::Make(image_->bounds())) {
+    canvas.drawImageRect(image_, bounds, sampling, paint);
+  } else {
+    canvas.drawImage(image_, bounds.x(), bounds.y(), sampling, paint);
+  }
+}
+
+void BufferedTexture::OnGrContextCreated() {}
+
+void BufferedTexture::OnGrContextDestroyed() {
+  image_ = nullptr;
+}
+
+void BufferedTexture::MarkNewFrameAvailable() {
+  // The new frame was pushed before the texture was marked.
+}
+
+void BufferedTexture::OnTextureUnregistered() {
+  std::deque<std::unique_ptr<BufferedTextureFrame>> frames;
+  {
+    std::scoped_lock lock(mutex_);
+    frames.swap(pending_frames_);
+  }
+  image_ = nullptr;
+}
+
+size_t BufferedTexture::GetMemoryBytes() const {
+  // The pending frames are owned by their producer until they are painted.
+  return image_ ? image_->imageInfo().computeMinByteSize() : 0;
+}
+
 TextureRegistry::TextureRegistry() = default;
 
 void TextureRegistry::RegisterTexture(std::shared_ptr<Texture> texture) {
@@ -40,6 +127,14 @@ void TextureRegistry::OnGrContextDestroyed() {
   }
 }
 
+size_t TextureRegistry::GetMemoryBytes() const {
+  size_t bytes = 0;
+  for (const auto& it : mapping_) {
+    bytes += it.second->GetMemoryBytes();
+  }
+  return bytes;
+}
+
 std::shared_ptr<Texture> TextureRegistry::GetTexture(int64_t id) {
   auto it = mapping_.find(id);
   return it != mapping_.end() ? it->second : nullptr;
@@ -5,11 +5,15 @@
 #ifndef FLUTTER_COMMON_GRAPHICS_TEXTURE_H_
 #define FLUTTER_COMMON_GRAPHICS_TEXTURE_H_
 
+#include <deque>
 #include <map>
+#include <memory>
+#include <mutex>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkSamplingOptions.h"
 
 class GrDirectContext;
@@ -41,6 +45,10 @@ class Texture {
   // Called on raster thread.
   virtual void OnTextureUnregistered() = 0;
 
+  // Called on raster thread. The estimated memory held by the texture for
+  // its frames, or 0 if the texture does not know it.
+  virtual size_t GetMemoryBytes() const;
+
   int64_t Id() { return id_; }
 
  private:
@@ -49,6 +57,78 @@ class Texture {
   FML_DISALLOW_COPY_AND_ASSIGN(Texture);
 };
 
+// A frame of a |BufferedTexture|, produced away from the raster thread.
+class BufferedTextureFrame {
+ public:
+  BufferedTextureFrame();
+
+  // Called from any thread. Releases the buffers of the frame unless they
+  // were handed over to an image by |MakeImage|.
+  virtual ~BufferedTextureFrame();
+
+  // Called from raster thread. Wraps the buffers of the frame in an image
+  // without copying them, and hands them over to the image. This must not
+  // block on the producer of the frame: if the producer may still be writing
+  // to the buffers, the GPU rather than the raster thread must wait for it.
+  virtual sk_sp<SkImage> MakeImage(GrDirectContext* context) = 0;
+
+ private:
+  FML_DISALLOW_COPY_AND_ASSIGN(BufferedTextureFrame);
+};
+
+// A |Texture| whose frames are pushed by their producer, from any thread,
+// rather than pulled from it on the raster thread when a new frame is
+// available. Each paint takes the newest pushed frame, so the raster thread
+// never waits for the producer and the producer never waits for the raster
+// thread.
+class BufferedTexture : public Texture {
+ public:
+  // The number of pushed frames that may be waiting to be painted. When a
+  // frame is pushed onto a full queue, the oldest waiting frame is dropped.
+  static constexpr size_t kMaxPendingFrames = 3;
+
+  explicit BufferedTexture(int64_t id);  // Called from any thread.
+
+  ~BufferedTexture() override;  // Called from raster thread.
+
+  // Called from any thread.
+  void PushFrame(std::unique_ptr<BufferedTextureFrame> frame);
+
+  // Called from any thread.
+  size_t GetPendingFrameCount();
+
+  // |Texture|
+  void Paint(SkCanvas& canvas,
+             const SkRect& bounds,
+             bool freeze,
+             GrDirectContext* context,
+             const SkSamplingOptions& sampling,
+             const SkPaint* paint = nullptr) override;
+
+  // |Texture|
+  void OnGrContextCreated() override;
+
+  // |Texture|
+  void OnGrContextDestroyed() override;
+
+  // |Texture|
+  void MarkNewFrameAvailable() override;
+
+  // |Texture|
+  void OnTextureUnregistered() override;
+
+  // |Texture|
+  size_t GetMemoryBytes() const override;
+
+ private:
+  std::mutex mutex_;
+  std::deque<std::unique_ptr<BufferedTextureFrame>> pending_frames_;
+  // The image of the last painted frame. Only used on the raster thread.
+  sk_sp<SkImage> image_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(BufferedTexture);
+};
+
 class TextureRegistry {
  public:
   TextureRegistry();
@@ -68,6 +148,10 @@ class TextureRegistry {
   // Called from raster thread.
   void OnGrContextDestroyed();
 
+  // Called from raster thread. The estimated memory held by all of the
+  // registered textures.
+  size_t GetMemoryBytes() const;
+
  private:
   std::map<int64_t, std::shared_ptr<Texture>> mapping_;
 
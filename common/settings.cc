@@ -63,6 +63,7 @@ std::string Settings::ToString() const {
   stream << "frame_rasterized_callback set: " << !!frame_rasterized_callback
          << std::endl;
   stream << "old_gen_heap_size: " << old_gen_heap_size << std::endl;
+  stream << "raster_cache_max_bytes: " << raster_cache_max_bytes << std::endl;
   return stream.str();
 }
 
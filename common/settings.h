@@ -59,6 +59,29 @@ class FrameTiming {
     picture_cache_count_ = picture_cache_count;
     picture_cache_bytes_ = picture_cache_bytes;
   }
+  // The allocations of the build and raster phases are only counted in builds
+  // that track allocations, and are zero otherwise.
+  uint64_t GetBuildAllocationCount() const { return build_allocation_count_; }
+  uint64_t GetBuildAllocationBytes() const { return build_allocation_bytes_; }
+  uint64_t GetRasterAllocationCount() const {
+    return raster_allocation_count_;
+  }
+  uint64_t GetRasterAllocationBytes() const {
+    return raster_allocation_bytes_;
+  }
+  void SetAllocationStatistics(uint64_t build_allocation_count,
+                               uint64_t build_allocation_bytes,
+                               uint64_t raster_allocation_count,
+                               uint64_t raster_allocation_bytes) {
+    build_allocation_count_ = build_allocation_count;
+    build_allocation_bytes_ = build_allocation_bytes;
+    raster_allocation_count_ = raster_allocation_count;
+    raster_allocation_bytes_ = raster_allocation_bytes;
+  }
+  // Whether the frame was identical to the previous one, in which case the
+  // rasterizer neither painted nor presented it.
+  bool IsSkipped() const { return skipped_; }
+  void SetSkipped(bool skipped) { skipped_ = skipped; }
 
  private:
   fml::TimePoint data_[kCount];
@@ -67,6 +90,11 @@ class FrameTiming {
   size_t layer_cache_bytes_;
   size_t picture_cache_count_;
   size_t picture_cache_bytes_;
+  uint64_t build_allocation_count_ = 0;
+  uint64_t build_allocation_bytes_ = 0;
+  uint64_t raster_allocation_count_ = 0;
+  uint64_t raster_allocation_bytes_ = 0;
+  bool skipped_ = false;
 };
 
 using TaskObserverAdd =
@@ -134,6 +162,22 @@ struct Settings {
   std::optional<std::vector<std::string>> trace_skia_allowlist;
   bool trace_startup = false;
   bool trace_systrace = false;
+  // Records the trace events of all threads into in-process ring buffers that
+  // can be dumped through the service protocol or the embedder API, without a
+  // tracing session. It is available in the builds in which the timeline is,
+  // which include the release builds on Android.
+  bool enable_trace_ring_buffer = false;
+  // Moves the UI and raster threads to the performance cores while frames are
+  // being produced, and lets them run on any core again once the animator is
+  // idle.
+  bool prefer_performance_cores_when_animating = false;
+  // Decodes the images that are drawn at their full size into YUV planes when
+  // their codecs support it, and converts them to RGBA on the GPU when they are
+  // first drawn, which uploads less than half of the data.
+  bool decode_images_to_yuv_planes = false;
+  // Resizes the large decoded images that their codecs cannot decode at their
+  // target size on the GPU from the IO thread, instead of on the CPU.
+  bool resize_images_on_gpu = false;
   bool dump_skp_on_shader_compilation = false;
   bool cache_sksl = false;
   bool purge_persistent_cache = false;
@@ -180,6 +224,13 @@ struct Settings {
   // after failing to bind to a specified port.
   bool enable_service_port_fallback = false;
 
+  // Whether the launch of the service isolate waits until the first frame is
+  // rasterized, so that the startup of profile builds is measured without
+  // it. The timeline events of the startup are kept in the buffer of the VM
+  // and can be read once the service isolate runs. This has no effect when
+  // the application starts paused, since it waits for the debugger then.
+  bool defer_service_isolate_launch = false;
+
   // Font settings
   bool use_test_fonts = false;
 
@@ -193,6 +244,87 @@ struct Settings {
   // Selects the DisplayList for storage of rendering operations.
   bool enable_display_list = true;
 
+  // Prepares the resources used by the DisplayLists of each frame on the
+  // concurrent worker threads before the frame is rasterized.
+  bool enable_display_list_prewarm = false;
+
+  // Rasterizes the raster cache images of pictures and display lists with
+  // the resource context on the IO thread instead of during the frame.
+  bool enable_async_raster_cache = false;
+
+  // Stores the raster cache images of the display lists drawn during the
+  // first frames in the persistent cache and reuses them in later launches.
+  bool enable_persistent_raster_cache = false;
+
+  // Prerolls the independent subtrees of wide container layers on the
+  // concurrent worker threads.
+  bool enable_concurrent_preroll = false;
+
+  // Defers the text drawn by the layers past the draws that do not overlap
+  // it, so that the text of neighbouring layers reaches the GPU backend as
+  // consecutive draws that it batches.
+  bool enable_text_draw_batching = false;
+
+  // Records the new raster cache images of pictures and display lists on the
+  // concurrent worker threads during the Preroll, and draws the recordings
+  // on the raster thread before the frame is painted.
+  bool enable_concurrent_raster_cache_recording = false;
+
+  // Adapts the depth of the layer tree pipeline to the durations of the
+  // frames: deeper when the rasterization of the frames takes longer than a
+  // vsync interval, and shallower when both the UI and the raster threads are
+  // mostly idle.
+  bool enable_adaptive_pipeline_depth = false;
+
+  // Delays building each frame after its vsync for as long as the timings of
+  // the last frames predict that it still makes its target time, so that it
+  // includes more recent input events.
+  bool enable_predictive_frame_scheduling = false;
+
+  // Begins each frame as soon as it is requested instead of at the next vsync
+  // of the platform, and keeps the layer tree pipeline at its deepest. Meant
+  // for headless embedders that render as many frames as they can.
+  bool render_without_vsync = false;
+
+  // Coalesces the moves and hovers of each pointer into a single event per
+  // frame, resampled to the time of the vsync, instead of the dispatcher of
+  // the platform view.
+  bool enable_pointer_coalescing = false;
+
+  // Only precompiles the most used SkSLs before the first frame, and the rest
+  // on the raster thread between frames.
+  bool enable_prioritized_sksl_precompilation = false;
+
+  // Stores the shaders of the persistent cache in one pack file rather than
+  // in one file per shader, which makes loading them at startup one mapping.
+  bool enable_persistent_cache_pack_files = false;
+
+  // Shares a single path between the structurally identical paths that the
+  // framework rebuilds in consecutive frames, so that they hit the same path
+  // caches of Skia.
+  bool enable_path_deduplication = false;
+
+  // Delivers the platform messages that arrive before the UI thread gets to
+  // them to the isolate in a single call. The messages keep their order, but
+  // may be delivered before the other events that were sent in between them.
+  bool enable_platform_message_batching = false;
+
+  // Saves the fallback fonts that the platform matched for the characters in
+  // the persistent cache, and loads them on the next launches, so that the
+  // text of the first frames does not wait for the same slow font queries.
+  bool enable_persistent_font_fallback_cache = false;
+
+  // Runs the startup steps that do not depend on the Dart VM, such as the
+  // initialization of ICU, the warm up of the default font manager and the
+  // read ahead of the cached SkSLs, on the IO and raster threads while the
+  // platform thread creates the VM.
+  bool enable_concurrent_startup = false;
+
+  // Records the assets that are read before the first frame in the persistent
+  // cache, and reads them ahead on the IO thread on the next launches while
+  // the root isolate starts.
+  bool enable_startup_asset_prefetch = false;
+
   // Data set by platform-specific embedders for use in font initialization.
   uint32_t font_initialization_data = 0;
 
@@ -252,6 +384,15 @@ struct Settings {
   // calls in this callback will cause applications to jank.
   LogMessageCallback log_message_callback;
   bool enable_software_rendering = false;
+  // Render with Vulkan on the platforms where it's optional, when the device
+  // supports it.
+  bool enable_vulkan_rendering = false;
+  // Latch only the newest frame of the Android surface textures when they
+  // produce frames faster than they are drawn.
+  bool drop_stale_texture_frames = false;
+  // Keep rasterizing on the raster thread while Android platform views are
+  // displayed, and only position the views on the platform thread.
+  bool unmerged_platform_views = false;
   bool skia_deterministic_rendering_on_cpu = false;
   bool verbose_logging = false;
   std::string log_tag = "flutter";
@@ -288,6 +429,40 @@ struct Settings {
   /// https://github.com/dart-lang/sdk/blob/ca64509108b3e7219c50d6c52877c85ab6a35ff2/runtime/vm/flag_list.h#L150
   int64_t old_gen_heap_size = -1;
 
+  /// The most memory in bytes that the images of the raster cache may use,
+  /// or 0 for no limit.
+  size_t raster_cache_max_bytes = 0;
+
+  /// The most memory in bytes that the images decoded by the engine and their
+  /// encoded bytes may use in the cache that gives them back when the same
+  /// bytes are decoded at the same size again, or 0 to turn the cache off.
+  size_t decoded_image_cache_max_bytes = 0;
+
+  /// The memory in bytes that the caches of a shell may keep in total when
+  /// the platform reports moderate memory pressure, or 0 to free half of what
+  /// they hold. Critical memory pressure empties the caches regardless.
+  size_t memory_pressure_target_bytes = 0;
+
+  /// The number of frames of animated images that are decoded on the
+  /// concurrent worker pool ahead of the frame that is asked for, or 0 to
+  /// decode each frame on the IO thread when it is asked for.
+  int animated_image_prefetch_frame_count = 0;
+
+  /// The most memory in bytes that all of the frames of an animated image may
+  /// use for its codec to keep them after the first loop instead of decoding
+  /// them again, or 0 to keep none.
+  size_t animated_image_frame_cache_max_bytes = 0;
+
+  /// The most memory in bytes that the shaped words of the laid out text may
+  /// use in the cache that is shared by all of the engines of the process, or
+  /// 0 for the default limit on the number of words.
+  size_t text_layout_cache_max_bytes = 0;
+
+  /// The most tasks of the Skia background work, such as the compilation of
+  /// shaders, that the concurrent worker pool runs at once, or 0 for half of
+  /// its workers, so that the others stay free for the decodes of images.
+  size_t skia_executor_max_concurrency = 0;
+
   /// A timestamp representing when the engine started. The value is based
   /// on the clock used by the Dart timeline APIs. This timestamp is used
   /// to log a timeline event that tracks the latency of engine startup.
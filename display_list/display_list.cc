@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <type_traits>
 
 #include "flutter/display_list/display_list.h"
@@ -24,6 +25,15 @@ const SkSamplingOptions DisplayList::MipmapSampling =
 const SkSamplingOptions DisplayList::CubicSampling =
     SkSamplingOptions(SkCubicResampler{1 / 3.0f, 1 / 3.0f});
 
+static uint32_t NextUniqueId() {
+  static std::atomic<uint32_t> nextID{1};
+  uint32_t id;
+  do {
+    id = nextID.fetch_add(+1, std::memory_order_relaxed);
+  } while (id == 0);
+  return id;
+}
+
 DisplayList::DisplayList()
     : byte_count_(0),
       op_count_(0),
@@ -32,7 +42,9 @@ DisplayList::DisplayList()
       unique_id_(0),
       bounds_({0, 0, 0, 0}),
       bounds_cull_({0, 0, 0, 0}),
-      can_apply_group_opacity_(true) {}
+      can_apply_group_opacity_(true) {
+  ComputeContentHash();
+}
 
 DisplayList::DisplayList(uint8_t* ptr,
                          size_t byte_count,
@@ -49,15 +61,35 @@ DisplayList::DisplayList(uint8_t* ptr,
       bounds_({0, 0, -1, -1}),
       bounds_cull_(cull_rect),
       can_apply_group_opacity_(can_apply_group_opacity) {
-  static std::atomic<uint32_t> nextID{1};
-  do {
-    unique_id_ = nextID.fetch_add(+1, std::memory_order_relaxed);
-  } while (unique_id_ == 0);
+  unique_id_ = NextUniqueId();
+  ComputeContentHash();
+}
+
+DisplayList::DisplayList(std::shared_ptr<const fml::Mapping> mapping,
+                         const uint8_t* ops,
+                         size_t byte_count,
+                         unsigned int op_count,
+                         const SkRect& cull_rect,
+                         bool can_apply_group_opacity)
+    : mapping_(std::move(mapping)),
+      mapped_ops_(ops),
+      byte_count_(byte_count),
+      op_count_(op_count),
+      nested_byte_count_(0),
+      nested_op_count_(0),
+      bounds_({0, 0, -1, -1}),
+      bounds_cull_(cull_rect),
+      can_apply_group_opacity_(can_apply_group_opacity) {
+  unique_id_ = NextUniqueId();
+  ComputeContentHash();
 }
 
 DisplayList::~DisplayList() {
+  // Mapped ops are all flat records which need no disposal.
   uint8_t* ptr = storage_.get();
-  DisposeOps(ptr, ptr + byte_count_);
+  if (ptr) {
+    DisposeOps(ptr, ptr + byte_count_);
+  }
 }
 
 void DisplayList::ComputeBounds() {
@@ -66,9 +98,304 @@ void DisplayList::ComputeBounds() {
   bounds_ = calculator.bounds();
 }
 
+void DisplayList::ComputeContentHash() {
+  DisplayListHasher hasher;
+  const uint8_t* ptr = ops_start();
+  const uint8_t* end = ptr + byte_count_;
+  // Runs of ops that are hashed as raw bytes are mixed in all at once.
+  const uint8_t* bulk_start = ptr;
+  while (ptr < end) {
+    auto op = reinterpret_cast<const DLOp*>(ptr);
+    const uint8_t* op_start = ptr;
+    ptr += op->size;
+    FML_DCHECK(ptr <= end);
+    bool hashed;
+    switch (op->type) {
+#define DL_OP_HASH(name)                                     \
+  case DisplayListOpType::k##name:                           \
+    hashed = static_cast<const name##Op*>(op)->hash(hasher); \
+    break;
+
+      FOR_EACH_DISPLAY_LIST_OP(DL_OP_HASH)
+
+#undef DL_OP_HASH
+
+      default:
+        FML_DCHECK(false);
+        hashed = false;
+        break;
+    }
+    if (hashed) {
+      // The op has mixed in its own values, but the bytes preceding it
+      // and its own header still need to be hashed.
+      hasher.mix_bytes(bulk_start, op_start - bulk_start);
+      hasher.mix(static_cast<uint32_t>(op->type));
+      hasher.mix(static_cast<uint32_t>(op->size));
+      bulk_start = ptr;
+    }
+  }
+  hasher.mix_bytes(bulk_start, ptr - bulk_start);
+  hasher.mix(static_cast<uint32_t>(op_count_));
+  content_hash_ = hasher.finish();
+}
+
+// Attribute ops only modify the rendering attributes used by later ops.
+// They are never scoped by save/restore and so must always be dispatched,
+// even when the ops around them are culled.
+static bool IsAttributeOp(DisplayListOpType type) {
+  return type <= DisplayListOpType::kSetMaskBlurFilterInner;
+}
+
+// Rendering ops are the only ops that touch any pixels on their own.
+static bool IsRenderingOp(DisplayListOpType type) {
+  return type >= DisplayListOpType::kDrawPaint;
+}
+
+// The bounds recorded in the RTree for ops that flood an unclipped area.
+static constexpr SkRect kUnboundedOpRect =
+    SkRect::MakeLTRB(-1E9F, -1E9F, 1E9F, 1E9F);
+
+void DisplayList::ComputeRTree() {
+  DisplayListBoundsCalculator calculator(&bounds_cull_);
+  std::vector<SkRect> rects;
+  std::vector<RTreeRange> ranges;
+  const uint8_t* start = ops_start();
+  const uint8_t* ptr = start;
+  const uint8_t* end = ptr + byte_count_;
+  // The nesting depth of save and saveLayer calls and the depth at which
+  // the outermost saveLayer currently being accumulated was opened.
+  int depth = 0;
+  int layer_depth = -1;
+  size_t layer_begin = 0;
+  BoundsAccumulator layer_bounds;
+  bool layer_is_unbounded = false;
+  while (ptr < end) {
+    auto op = reinterpret_cast<const DLOp*>(ptr);
+    const uint8_t* op_end = ptr + op->size;
+    calculator.reset_op_bounds();
+    Dispatch(calculator, ptr, op_end);
+    switch (op->type) {
+      case DisplayListOpType::kSave:
+        depth++;
+        break;
+      case DisplayListOpType::kSaveLayer:
+      case DisplayListOpType::kSaveLayerBounds:
+        if (layer_depth < 0) {
+          layer_depth = depth;
+          layer_begin = ptr - start;
+          layer_bounds = BoundsAccumulator();
+          layer_is_unbounded = false;
+        }
+        // A saveLayer with attributes may flood the surrounding layer.
+        layer_bounds.accumulate(calculator.op_bounds());
+        layer_is_unbounded |= calculator.op_is_unbounded();
+        depth++;
+        break;
+      case DisplayListOpType::kRestore:
+        depth--;
+        if (depth == layer_depth) {
+          // The restore reports the bounds of the entire layer, after
+          // any filter on the layer has been applied.
+          layer_bounds.accumulate(calculator.op_bounds());
+          layer_is_unbounded |= calculator.op_is_unbounded();
+          rects.push_back(layer_is_unbounded ? kUnboundedOpRect
+                                             : layer_bounds.bounds());
+          ranges.push_back({layer_begin, static_cast<size_t>(op_end - start)});
+          layer_depth = -1;
+        }
+        break;
+      default:
+        if (layer_depth < 0 && IsRenderingOp(op->type)) {
+          rects.push_back(calculator.op_is_unbounded()
+                              ? kUnboundedOpRect
+                              : calculator.op_bounds());
+          ranges.push_back({static_cast<size_t>(ptr - start),
+                            static_cast<size_t>(op_end - start)});
+        }
+        break;
+    }
+    ptr = op_end;
+  }
+  // The builder always balances its saveLayer calls.
+  FML_DCHECK(layer_depth < 0);
+  rtree_ = SkRTreeFactory()();
+  rtree_->insert(rects.data(), rects.size());
+  rtree_ranges_ = std::move(ranges);
+}
+
+// The most ops within a single layer that are checked against each other
+// for overlap, which bounds the quadratic cost of the check.
+static constexpr size_t kMaxGroupOpacityOps = 64;
+
+// Unlike SkRect::Intersects, ops that only share an edge also overlap
+// since antialiasing may blend both of them into the pixels on the edge.
+static bool OpBoundsOverlap(const SkRect& a, const SkRect& b) {
+  return a.fLeft <= b.fRight && b.fLeft <= a.fRight &&  //
+         a.fTop <= b.fBottom && b.fTop <= a.fBottom;
+}
+
+const char* DisplayList::ComputeGroupOpacity(
+    const std::vector<size_t>& layer_offsets,
+    bool check_root) {
+  // The bounds are those of the whole list rather than those of each
+  // layer, which does not change whether the ops in a layer overlap
+  // since all of them are transformed by the same matrix.
+  struct OpacityLayer {
+    explicit OpacityLayer(bool check, size_t offset = 0)
+        : check(check), offset(offset) {}
+
+    bool check;
+    size_t offset;
+    const char* rejection = nullptr;
+    std::vector<SkRect> op_bounds;
+    // The bounds of a saveLayer, which is a single op in its parent.
+    BoundsAccumulator layer_bounds;
+    bool layer_is_unbounded = false;
+
+    void AddOp(const SkRect& bounds, bool is_unbounded) {
+      if (!check || rejection != nullptr) {
+        return;
+      }
+      if (is_unbounded) {
+        rejection = "unbounded op";
+        return;
+      }
+      if (bounds.isEmpty()) {
+        return;
+      }
+      if (op_bounds.size() >= kMaxGroupOpacityOps) {
+        rejection = "too many ops";
+        return;
+      }
+      for (const SkRect& other : op_bounds) {
+        if (OpBoundsOverlap(bounds, other)) {
+          rejection = "overlapping ops";
+          return;
+        }
+      }
+      op_bounds.push_back(bounds);
+    }
+  };
+
+  DisplayListBoundsCalculator calculator(&bounds_cull_);
+  std::vector<OpacityLayer> layers;
+  layers.emplace_back(check_root);
+  // Whether each currently open save is a saveLayer.
+  std::vector<bool> save_is_layer;
+  bool modified = false;
+  uint8_t* start = storage_.get();
+  uint8_t* ptr = start;
+  uint8_t* end = ptr + byte_count_;
+  while (ptr < end) {
+    auto op = reinterpret_cast<const DLOp*>(ptr);
+    uint8_t* op_end = ptr + op->size;
+    calculator.reset_op_bounds();
+    Dispatch(calculator, ptr, op_end);
+    switch (op->type) {
+      case DisplayListOpType::kSave:
+        save_is_layer.push_back(false);
+        break;
+      case DisplayListOpType::kSaveLayer:
+      case DisplayListOpType::kSaveLayerBounds: {
+        size_t offset = ptr - start;
+        save_is_layer.push_back(true);
+        layers.emplace_back(std::binary_search(layer_offsets.begin(),
+                                               layer_offsets.end(), offset),
+                            offset);
+        // A saveLayer with attributes may flood the surrounding layer.
+        layers.back().layer_bounds.accumulate(calculator.op_bounds());
+        layers.back().layer_is_unbounded = calculator.op_is_unbounded();
+        break;
+      }
+      case DisplayListOpType::kRestore:
+        FML_DCHECK(!save_is_layer.empty());
+        if (save_is_layer.back()) {
+          OpacityLayer& layer = layers.back();
+          if (layer.check && layer.rejection == nullptr) {
+            // Both saveLayer records start with the same options field.
+            SaveLayerOp* save_op =
+                reinterpret_cast<SaveLayerOp*>(start + layer.offset);
+            save_op->options = save_op->options.with_can_distribute_opacity();
+            modified = true;
+          }
+          // The restore reports the bounds of the entire layer, after
+          // any filter on the layer has been applied.
+          layer.layer_bounds.accumulate(calculator.op_bounds());
+          bool is_unbounded =
+              layer.layer_is_unbounded || calculator.op_is_unbounded();
+          SkRect bounds = layer.layer_bounds.bounds();
+          layers.pop_back();
+          layers.back().AddOp(bounds, is_unbounded);
+        }
+        save_is_layer.pop_back();
+        break;
+      default:
+        if (IsRenderingOp(op->type)) {
+          layers.back().AddOp(calculator.op_bounds(),
+                              calculator.op_is_unbounded());
+        }
+        break;
+    }
+    ptr = op_end;
+  }
+  // The builder always balances its saveLayer calls.
+  FML_DCHECK(layers.size() == 1);
+  if (check_root) {
+    can_apply_group_opacity_ = layers.front().rejection == nullptr;
+  }
+  if (modified) {
+    // The options of the saveLayer records are part of the content.
+    ComputeContentHash();
+  }
+  return check_root ? layers.front().rejection : nullptr;
+}
+
+void DisplayList::Dispatch(Dispatcher& ctx, const SkRect& cull_rect) const {
+  if (!rtree_) {
+    Dispatch(ctx);
+    return;
+  }
+  std::vector<int> visible;
+  rtree_->search(cull_rect, &visible);
+  if (visible.size() == rtree_ranges_.size()) {
+    Dispatch(ctx);
+    return;
+  }
+  // The RTree returns its results in tree order.
+  std::sort(visible.begin(), visible.end());
+  auto next_visible = visible.begin();
+  const uint8_t* start = ops_start();
+  const uint8_t* ptr = start;
+  for (size_t i = 0; i < rtree_ranges_.size(); i++) {
+    const uint8_t* range_begin = start + rtree_ranges_[i].begin;
+    const uint8_t* range_end = start + rtree_ranges_[i].end;
+    // The ops between the ranges are all state ops that the ops in
+    // the following ranges may depend on.
+    Dispatch(ctx, ptr, range_begin);
+    if (next_visible != visible.end() &&
+        *next_visible == static_cast<int>(i)) {
+      Dispatch(ctx, range_begin, range_end);
+      ++next_visible;
+    } else {
+      // Only the attribute ops within a culled range can have any
+      // effect on the ops that follow it.
+      const uint8_t* op_ptr = range_begin;
+      while (op_ptr < range_end) {
+        auto op = reinterpret_cast<const DLOp*>(op_ptr);
+        if (IsAttributeOp(op->type)) {
+          Dispatch(ctx, op_ptr, op_ptr + op->size);
+        }
+        op_ptr += op->size;
+      }
+    }
+    ptr = range_end;
+  }
+  Dispatch(ctx, ptr, start + byte_count_);
+}
+
 void DisplayList::Dispatch(Dispatcher& dispatcher,
-                           uint8_t* ptr,
-                           uint8_t* end) const {
+                           const uint8_t* ptr,
+                           const uint8_t* end) const {
   while (ptr < end) {
     auto op = reinterpret_cast<const DLOp*>(ptr);
     ptr += op->size;
@@ -114,15 +441,15 @@ void DisplayList::DisposeOps(uint8_t* ptr, uint8_t* end) {
   }
 }
 
-static bool CompareOps(uint8_t* ptrA,
-                       uint8_t* endA,
-                       uint8_t* ptrB,
-                       uint8_t* endB) {
+static bool CompareOps(const uint8_t* ptrA,
+                       const uint8_t* endA,
+                       const uint8_t* ptrB,
+                       const uint8_t* endB) {
   // These conditions are checked by the caller...
   FML_DCHECK((endA - ptrA) == (endB - ptrB));
   FML_DCHECK(ptrA != ptrB);
-  uint8_t* bulkStartA = ptrA;
-  uint8_t* bulkStartB = ptrB;
+  const uint8_t* bulkStartA = ptrA;
+  const uint8_t* bulkStartB = ptrB;
   while (ptrA < endA && ptrB < endB) {
     auto opA = reinterpret_cast<const DLOp*>(ptrA);
     auto opB = reinterpret_cast<const DLOp*>(ptrB);
@@ -182,19 +509,183 @@ static bool CompareOps(uint8_t* ptrA,
 
 void DisplayList::RenderTo(SkCanvas* canvas, SkScalar opacity) const {
   DisplayListCanvasDispatcher dispatcher(canvas, opacity);
-  Dispatch(dispatcher);
+  if (rtree_) {
+    Dispatch(dispatcher, canvas->getLocalClipBounds());
+  } else {
+    Dispatch(dispatcher);
+  }
 }
 
 bool DisplayList::Equals(const DisplayList& other) const {
-  if (byte_count_ != other.byte_count_ || op_count_ != other.op_count_) {
+  if (byte_count_ != other.byte_count_ || op_count_ != other.op_count_ ||
+      content_hash_ != other.content_hash_) {
     return false;
   }
-  uint8_t* ptr = storage_.get();
-  uint8_t* o_ptr = other.storage_.get();
+  const uint8_t* ptr = ops_start();
+  const uint8_t* o_ptr = other.ops_start();
   if (ptr == o_ptr) {
     return true;
   }
   return CompareOps(ptr, ptr + byte_count_, o_ptr, o_ptr + other.byte_count_);
 }
 
+// The header written in front of the op records by |Serialize|. Its size
+// is a multiple of the pointer size so that the op records which follow
+// it in a page aligned mapping keep the alignment they had in the builder.
+struct SerializedDisplayListHeader {
+  static constexpr uint32_t kMagic = 0x544c4c44;  // "DLLT"
+  static constexpr uint16_t kEndianMarker = 0x0102;
+
+  uint32_t magic;
+  uint32_t version;
+  // The op records are written in the native layout of the engine that
+  // recorded them, so the reader must agree on these properties.
+  uint16_t pointer_size;
+  uint16_t endian_marker;
+  uint32_t op_count;
+  uint64_t byte_count;
+  SkRect cull_rect;
+  uint32_t can_apply_group_opacity;
+  uint32_t reserved;
+};
+static_assert(sizeof(SerializedDisplayListHeader) % sizeof(void*) == 0,
+              "Serialized op records must remain pointer aligned");
+
+// An op is flat if it holds no references to other objects, which for the
+// set of DisplayList ops is exactly the set of trivially destructible ops.
+static bool IsFlatOp(const DLOp* op) {
+  switch (op->type) {
+#define DL_OP_IS_FLAT(name)       \
+  case DisplayListOpType::k##name: \
+    return std::is_trivially_destructible_v<name##Op>;
+
+    FOR_EACH_DISPLAY_LIST_OP(DL_OP_IS_FLAT)
+
+#undef DL_OP_IS_FLAT
+
+    default:
+      return false;
+  }
+}
+
+// Validates an op record read from an untrusted stream with |available|
+// bytes remaining, including any array data trailing the fixed record.
+static bool IsValidFlatOp(const DLOp* op, size_t available) {
+  if (available < sizeof(DLOp) || op->size < sizeof(DLOp) ||
+      op->size > available || SkAlignPtr(op->size) != op->size) {
+    return false;
+  }
+  switch (op->type) {
+#define DL_OP_VALIDATE(name)                               \
+  case DisplayListOpType::k##name:                         \
+    if (!std::is_trivially_destructible_v<name##Op> ||     \
+        op->size < sizeof(name##Op)) {                     \
+      return false;                                        \
+    }                                                      \
+    break;
+
+    FOR_EACH_DISPLAY_LIST_OP(DL_OP_VALIDATE)
+
+#undef DL_OP_VALIDATE
+
+    default:
+      return false;
+  }
+  switch (op->type) {
+    case DisplayListOpType::kDrawPoints:
+    case DisplayListOpType::kDrawLines:
+    case DisplayListOpType::kDrawPolygon: {
+      // The 3 point ops share the same layout.
+      uint32_t count = static_cast<const DrawPointsOp*>(op)->count;
+      return count <= (op->size - sizeof(DrawPointsOp)) / sizeof(SkPoint);
+    }
+    default:
+      return true;
+  }
+}
+
+bool DisplayList::CanSerialize() const {
+  const uint8_t* ptr = ops_start();
+  const uint8_t* end = ptr + byte_count_;
+  while (ptr < end) {
+    auto op = reinterpret_cast<const DLOp*>(ptr);
+    if (!IsFlatOp(op)) {
+      return false;
+    }
+    ptr += op->size;
+  }
+  return true;
+}
+
+std::unique_ptr<fml::Mapping> DisplayList::Serialize() const {
+  if (!CanSerialize()) {
+    return nullptr;
+  }
+  // Flat lists never contain nested pictures or display lists.
+  FML_DCHECK(nested_byte_count_ == 0 && nested_op_count_ == 0);
+  SerializedDisplayListHeader header;
+  header.magic = SerializedDisplayListHeader::kMagic;
+  header.version = kSerializationVersion;
+  header.pointer_size = sizeof(void*);
+  header.endian_marker = SerializedDisplayListHeader::kEndianMarker;
+  header.op_count = op_count_;
+  header.byte_count = byte_count_;
+  header.cull_rect = bounds_cull_;
+  header.can_apply_group_opacity = can_apply_group_opacity_ ? 1 : 0;
+  header.reserved = 0;
+  size_t size = sizeof(header) + byte_count_;
+  uint8_t* data = static_cast<uint8_t*>(malloc(size));
+  if (data == nullptr) {
+    return nullptr;
+  }
+  memcpy(data, &header, sizeof(header));
+  if (byte_count_ > 0) {
+    memcpy(data + sizeof(header), ops_start(), byte_count_);
+  }
+  return std::make_unique<fml::MallocMapping>(data, size);
+}
+
+sk_sp<DisplayList> DisplayList::MakeFromMapping(
+    std::shared_ptr<const fml::Mapping> mapping) {
+  if (!mapping || mapping->GetMapping() == nullptr ||
+      mapping->GetSize() < sizeof(SerializedDisplayListHeader)) {
+    return nullptr;
+  }
+  // The header is copied out since the mapping is not required to be
+  // aligned for it.
+  SerializedDisplayListHeader header;
+  memcpy(&header, mapping->GetMapping(), sizeof(header));
+  if (header.magic != SerializedDisplayListHeader::kMagic ||
+      header.version != kSerializationVersion ||
+      header.pointer_size != sizeof(void*) ||
+      header.endian_marker != SerializedDisplayListHeader::kEndianMarker ||
+      header.byte_count != mapping->GetSize() - sizeof(header)) {
+    return nullptr;
+  }
+  size_t byte_count = header.byte_count;
+  const uint8_t* ops = mapping->GetMapping() + sizeof(header);
+  if (byte_count > 0 &&
+      SkAlignPtr(reinterpret_cast<uintptr_t>(ops)) !=
+          reinterpret_cast<uintptr_t>(ops)) {
+    // The records are only read in place if they are aligned as they
+    // were in the builder, otherwise we fall back to a single copy.
+    mapping = std::make_shared<fml::MallocMapping>(
+        fml::MallocMapping::Copy(ops, byte_count));
+    ops = mapping->GetMapping();
+  }
+  const uint8_t* ptr = ops;
+  const uint8_t* end = ops + byte_count;
+  while (ptr < end) {
+    auto op = reinterpret_cast<const DLOp*>(ptr);
+    if (!IsValidFlatOp(op, end - ptr)) {
+      return nullptr;
+    }
+    ptr += op->size;
+  }
+  return sk_sp<DisplayList>(
+      new DisplayList(std::move(mapping), byte_count > 0 ? ops : nullptr,
+                      byte_count, header.op_count, header.cull_rect,
+                      header.can_apply_group_opacity != 0));
+}
+
 }  // namespace flutter
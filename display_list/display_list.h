@@ -6,9 +6,12 @@
 #define FLUTTER_FLOW_DISPLAY_LIST_H_
 
 #include <optional>
+#include <vector>
 
 #include "flutter/display_list/types.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "third_party/skia/include/core/SkBBHFactory.h"
 
 // The Flutter DisplayList mechanism encapsulates a persistent sequence of
 // rendering operations.
@@ -211,10 +214,22 @@ class DisplayList : public SkRefCnt {
   ~DisplayList();
 
   void Dispatch(Dispatcher& ctx) const {
-    uint8_t* ptr = storage_.get();
+    const uint8_t* ptr = ops_start();
     Dispatch(ctx, ptr, ptr + byte_count_);
   }
 
+  // Dispatches only those rendering ops whose bounds intersect the
+  // |cull_rect| along with all of the attribute, transform, clip and
+  // save/restore ops that are needed to render them. An outermost
+  // saveLayer is culled as a unit along with all of its contents.
+  //
+  // Culling requires the spatial index that a DisplayListBuilder will
+  // compute when it is constructed with |prepare_rtree| set. Without it
+  // this method dispatches the entire list.
+  void Dispatch(Dispatcher& ctx, const SkRect& cull_rect) const;
+
+  // Renders the list to the canvas, culling the ops against the canvas
+  // clip if the list has an RTree.
   void RenderTo(SkCanvas* canvas, SkScalar opacity = SK_Scalar1) const;
 
   // SkPicture always includes nested bytes, but nested ops are
@@ -240,12 +255,55 @@ class DisplayList : public SkRefCnt {
     return bounds_;
   }
 
+  // A 64-bit hash of the op records which is computed when the list is
+  // created. Lists that are |Equals| always have the same hash, even if
+  // they were recorded separately, so it can be used to recognize the
+  // same content across frames when the |unique_id| changes.
+  uint64_t content_hash() const { return content_hash_; }
+
+  // The cull rect that the list was recorded with, which determines the
+  // bounds of any drawPaint() or drawColor() ops that it contains.
+  const SkRect& cull_rect() const { return bounds_cull_; }
+
+  // Lists with different content hashes are rejected without inspecting
+  // their op records.
   bool Equals(const DisplayList& other) const;
 
+  bool has_rtree() const { return rtree_ != nullptr; }
+
   bool can_apply_group_opacity() { return can_apply_group_opacity_; }
 
   static void DisposeOps(uint8_t* ptr, uint8_t* end);
 
+  // The version of the byte stream produced by |Serialize| and accepted
+  // by |MakeFromMapping|. It must be bumped whenever the layout of any
+  // flat op record or of the stream header changes.
+  static constexpr uint32_t kSerializationVersion = 1;
+
+  // Returns true if every op in the list is a "flat" record, i.e. one that
+  // holds no references to other objects (images, shaders, paths, nested
+  // pictures and so on) and can therefore be written out as raw bytes.
+  bool CanSerialize() const;
+
+  // Writes the ops of this DisplayList into a versioned byte stream which
+  // is a small header followed by a verbatim copy of the op records. The
+  // stream is position independent and can be written to a file or sent
+  // to another process built from the same engine version.
+  //
+  // Returns nullptr if the list contains any op that |CanSerialize| would
+  // reject.
+  std::unique_ptr<fml::Mapping> Serialize() const;
+
+  // Creates a DisplayList that dispatches its ops in place from the bytes
+  // of a stream written by |Serialize|, typically an fml::FileMapping. The
+  // mapping is retained for the lifetime of the returned list and is not
+  // copied unless it is not suitably aligned for the op records.
+  //
+  // Returns nullptr if the stream has the wrong version or was written
+  // by an incompatible build, or if any of its op records fail validation.
+  static sk_sp<DisplayList> MakeFromMapping(
+      std::shared_ptr<const fml::Mapping> mapping);
+
  private:
   DisplayList(uint8_t* ptr,
               size_t byte_count,
@@ -255,7 +313,18 @@ class DisplayList : public SkRefCnt {
               const SkRect& cull_rect,
               bool can_apply_group_opacity);
 
+  DisplayList(std::shared_ptr<const fml::Mapping> mapping,
+              const uint8_t* ops,
+              size_t byte_count,
+              unsigned int op_count,
+              const SkRect& cull_rect,
+              bool can_apply_group_opacity);
+
   std::unique_ptr<uint8_t, SkFunctionWrapper<void(void*), sk_free>> storage_;
+  // Only set for lists created by |MakeFromMapping|, in which case the op
+  // records live inside of |mapping_| rather than in |storage_|.
+  std::shared_ptr<const fml::Mapping> mapping_;
+  const uint8_t* mapped_ops_ = nullptr;
   size_t byte_count_;
   unsigned int op_count_;
 
@@ -263,6 +332,7 @@ class DisplayList : public SkRefCnt {
   unsigned int nested_op_count_;
 
   uint32_t unique_id_;
+  uint64_t content_hash_;
   SkRect bounds_;
 
   // Only used for drawPaint() and drawColor()
@@ -270,8 +340,43 @@ class DisplayList : public SkRefCnt {
 
   bool can_apply_group_opacity_;
 
+  // A contiguous range of op records that is culled as a unit by the
+  // culled |Dispatch|, described by offsets relative to |ops_start|.
+  // Most ranges contain a single rendering op, but an outermost
+  // saveLayer, its matching restore and everything between them
+  // form a single range with the bounds of the whole layer.
+  struct RTreeRange {
+    size_t begin;
+    size_t end;
+  };
+
+  // The spatial index of |rtree_ranges_|, only computed on request.
+  sk_sp<SkBBoxHierarchy> rtree_;
+  std::vector<RTreeRange> rtree_ranges_;
+
+  const uint8_t* ops_start() const {
+    return mapped_ops_ ? mapped_ops_ : storage_.get();
+  }
+
   void ComputeBounds();
-  void Dispatch(Dispatcher& ctx, uint8_t* ptr, uint8_t* end) const;
+  void ComputeContentHash();
+  void ComputeRTree();
+
+  // Determines which of the saveLayer records at |layer_offsets|, and the
+  // list itself if |check_root| is true, contain only ops that do not
+  // overlap each other and can therefore have an opacity distributed to
+  // them. Those layers are marked with |can_distribute_opacity| and the
+  // list is marked with |can_apply_group_opacity_|. The offsets must be
+  // sorted and every op in those layers must already be known to be
+  // compatible with an inherited opacity on its own.
+  //
+  // Returns the reason that the list itself could not apply a group
+  // opacity, or nullptr.
+  const char* ComputeGroupOpacity(const std::vector<size_t>& layer_offsets,
+                                  bool check_root);
+  void Dispatch(Dispatcher& ctx,
+                const uint8_t* ptr,
+                const uint8_t* end) const;
 
   friend class DisplayListBuilder;
 };
@@ -4,6 +4,7 @@
 
 #include "flutter/display_list/display_list_benchmarks.h"
 #include "flutter/display_list/display_list_builder.h"
+#include "flutter/display_list/display_list_complexity.h"
 #include "flutter/display_list/display_list_flags.h"
 
 #include "third_party/skia/include/core/SkPoint.h"
@@ -74,6 +75,34 @@ void AnnotateAttributes(unsigned attributes,
   }
 }
 
+// Reports the score that the complexity calculator for the backend assigns
+// to the benchmarked DisplayList, along with the rate at which that score
+// is rendered. The ComplexityWeights for a backend are well calibrated when
+// the ComplexityRate is roughly the same across all of its benchmarks, and
+// an outlier indicates an op whose weight is too high or too low.
+void AnnotateComplexity(BackendType backend_type,
+                        DisplayList* display_list,
+                        benchmark::State& state) {
+  DisplayListComplexityCalculator* calculator;
+  switch (backend_type) {
+    case kOpenGL_Backend:
+      calculator =
+          DisplayListComplexityCalculator::GetForBackend(GrBackendApi::kOpenGL);
+      break;
+    case kMetal_Backend:
+      calculator =
+          DisplayListComplexityCalculator::GetForBackend(GrBackendApi::kMetal);
+      break;
+    default:
+      calculator = DisplayListComplexityCalculator::GetForSoftware();
+      break;
+  }
+  unsigned int score = calculator->compute(display_list);
+  state.counters["ComplexityScore"] = score;
+  state.counters["ComplexityRate"] = benchmark::Counter(
+      score, benchmark::Counter::kIsIterationInvariantRate);
+}
+
 // Constants chosen to produce benchmark results in the region of 1-50ms
 constexpr size_t kLinesToDraw = 10000;
 constexpr size_t kRectsToDraw = 5000;
@@ -112,6 +141,7 @@ void BM_DrawLine(benchmark::State& state,
   }
 
   auto display_list = builder.Build();
+  AnnotateComplexity(backend_type, display_list.get(), state);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -160,6 +190,7 @@ void BM_DrawRect(benchmark::State& state,
   }
 
   auto display_list = builder.Build();
+  AnnotateComplexity(backend_type, display_list.get(), state);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -205,6 +236,7 @@ void BM_DrawOval(benchmark::State& state,
     }
   }
   auto display_list = builder.Build();
+  AnnotateComplexity(backend_type, display_list.get(), state);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -252,6 +284,7 @@ void BM_DrawCircle(benchmark::State& state,
     }
   }
   auto display_list = builder.Build();
+  AnnotateComplexity(backend_type, display_list.get(), state);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -329,6 +362,7 @@ void BM_DrawRRect(benchmark::State& state,
     }
   }
   auto display_list = builder.Build();
+  AnnotateComplexity(backend_type, display_list.get(), state);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -410,6 +444,7 @@ void BM_DrawDRRect(benchmark::State& state,
     }
   }
   auto display_list = builder.Build();
+  AnnotateComplexity(backend_type, display_list.get(), state);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -462,6 +497,7 @@ void BM_DrawArc(benchmark::State& state,
   }
 
   auto display_list = builder.Build();
+  AnnotateComplexity(backend_type, display_list.get(), state);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -664,6 +700,7 @@ void BM_DrawPath(benchmark::State& state,
 
   builder.drawPath(path);
   auto display_list = builder.Build();
+  AnnotateComplexity(backend_type, display_list.get(), state);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -809,6 +846,7 @@ void BM_DrawVertices(benchmark::State& state,
   state.SetComplexityN(total_vertex_count);
 
   auto display_list = builder.Build();
+  AnnotateComplexity(backend_type, display_list.get(), state);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -913,6 +951,7 @@ void BM_DrawPoints(benchmark::State& state,
   builder.drawPoints(mode, points.size(), points.data());
 
   auto display_list = builder.Build();
+  AnnotateComplexity(backend_type, display_list.get(), state);
 
   for ([[maybe_unused]] auto _ : state) {
     display_list->RenderTo(canvas);
@@ -987,6 +1026,7 @@ void BM_DrawImage(benchmark::State& state,
   }
 
   auto display_list = builder.Build();
+  AnnotateComplexity(backend_type, display_list.get(), state);
 
   for ([[maybe_unused]] auto _ : state) {
     display_list->RenderTo(canvas);
@@ -1069,6 +1109,7 @@ void BM_DrawImageRect(benchmark::State& state,
   }
 
   auto display_list = builder.Build();
+  AnnotateComplexity(backend_type, display_list.get(), state);
 
   for ([[maybe_unused]] auto _ : state) {
     display_list->RenderTo(canvas);
@@ -1153,6 +1194,7 @@ void BM_DrawImageNine(benchmark::State& state,
   }
 
   auto display_list = builder.Build();
+  AnnotateComplexity(backend_type, display_list.get(), state);
 
   for ([[maybe_unused]] auto _ : state) {
     display_list->RenderTo(canvas);
@@ -1226,6 +1268,7 @@ void BM_DrawTextBlob(benchmark::State& state,
   builder.drawTextBlob(blob, 0.0f, 0.0f);
 
   auto display_list = builder.Build();
+  AnnotateComplexity(backend_type, display_list.get(), state);
 
   for ([[maybe_unused]] auto _ : state) {
     display_list->RenderTo(canvas);
@@ -1289,6 +1332,7 @@ void BM_DrawShadow(benchmark::State& state,
   // ever used in conjunction with elevation.
   builder.drawShadow(path, SK_ColorBLUE, elevation, transparent_occluder, 1.0f);
   auto display_list = builder.Build();
+  AnnotateComplexity(backend_type, display_list.get(), state);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -1342,6 +1386,7 @@ void BM_SaveLayer(benchmark::State& state,
     }
   }
   auto display_list = builder.Build();
+  AnnotateComplexity(backend_type, display_list.get(), state);
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -1355,5 +1400,36 @@ void BM_SaveLayer(benchmark::State& state,
   canvas_provider->Snapshot(filename);
 }
 
+// Measures the throughput of recording a DisplayList, independent of any
+// rendering backend. Each iteration records a fresh list of the requested
+// number of ops with a mix of attribute changes, transforms, clips and draw
+// calls, similar to the content of a typical framework picture.
+void BM_DisplayListRecording(benchmark::State& state) {
+  size_t op_count = state.range(0);
+  size_t bytes = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    DisplayListBuilder builder;
+    for (size_t i = 0; i < op_count; i++) {
+      builder.save();
+      builder.translate(i % kFixedCanvasSize, i / kFixedCanvasSize);
+      builder.clipRect(SkRect::MakeWH(50, 50), SkClipOp::kIntersect, false);
+      builder.setColor(SkColorSetARGB(255, i & 0xff, 0, 0));
+      builder.drawRect(SkRect::MakeWH(40, 40));
+      builder.restore();
+    }
+    auto display_list = builder.Build();
+    bytes += display_list->bytes();
+    benchmark::DoNotOptimize(display_list);
+  }
+  state.counters["DrawCallCount"] = op_count;
+  state.SetBytesProcessed(bytes);
+  state.SetItemsProcessed(state.iterations() * op_count);
+}
+
+BENCHMARK(BM_DisplayListRecording)
+    ->RangeMultiplier(4)
+    ->Range(16, 16384)
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace testing
 }  // namespace flutter
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FLOW_DISPLAY_LIST_BENCHMARKS_H_
 #define FLUTTER_FLOW_DISPLAY_LIST_BENCHMARKS_H_
 
+#include "flutter/display_list/display_list.h"
 #include "flutter/display_list/display_list_benchmarks_canvas_provider.h"
 
 #include "third_party/benchmark/include/benchmark/benchmark.h"
@@ -38,6 +39,9 @@ enum BenchmarkAttributes {
 
 std::unique_ptr<CanvasProvider> CreateCanvasProvider(BackendType backend_type);
 SkPaint GetPaintForRun(unsigned attributes);
+void AnnotateComplexity(BackendType backend_type,
+                        DisplayList* display_list,
+                        benchmark::State& state);
 
 // Benchmarks
 
@@ -104,6 +108,7 @@ void BM_SaveLayer(benchmark::State& state,
                   BackendType backend_type,
                   unsigned attributes,
                   size_t save_depth);
+void BM_DisplayListRecording(benchmark::State& state);
 // clang-format off
 
 // DrawLine
@@ -0,0 +1,476 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "flutter/display_list/display_list_benchmarks.h"
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/display_list/display_list_canvas_dispatcher.h"
+#include "flutter/display_list/display_list_canvas_recorder.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/time/time_point.h"
+
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkPicture.h"
+
+// Benchmarks that replay DisplayLists recorded from real applications.
+//
+// The traces are read from the directory named by the environment variable
+// FLUTTER_DISPLAY_LIST_TRACES or, if it is not set, from the "traces"
+// subdirectory of the fixtures. Both the byte streams written by
+// DisplayList::Serialize (*.dl) and SkPictures (*.skp), such as those
+// captured with --trace-skia or by the screenshot service, are accepted.
+//
+// For every trace the following benchmarks are registered:
+//
+//   TraceBuild/<trace>                  re-recording the trace into a
+//                                       DisplayListBuilder
+//   TraceDispatch/<backend>/<trace>     dispatching the trace to an SkCanvas
+//                                       without waiting for the GPU
+//   TraceRaster/<backend>/<trace>       rendering the trace and flushing
+//   TraceOpBreakdown/<backend>/<trace>  rendering the trace while timing
+//                                       each type of op individually
+//
+// The breakdown reports the count and average time per iteration of each
+// type of op as "<Op>.Count" and "<Op>.Time" counters. On the GPU backends
+// the times only measure the recording of the work on the CPU while the
+// cost of executing it on the GPU is only visible in the total time.
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr char kTracesEnvironmentVariable[] = "FLUTTER_DISPLAY_LIST_TRACES";
+constexpr char kTracesFixturesDirectory[] = "traces";
+constexpr char kSerializedExtension[] = ".dl";
+constexpr char kPictureExtension[] = ".skp";
+constexpr int kMaxTraceSurfaceSize = 4096;
+
+// The op types reported by TraceOpBreakdown.
+enum class TraceOp {
+  kSaveLayer,
+  kRestore,
+  kDrawPaint,
+  kDrawColor,
+  kDrawLine,
+  kDrawRect,
+  kDrawOval,
+  kDrawCircle,
+  kDrawRRect,
+  kDrawDRRect,
+  kDrawPath,
+  kDrawArc,
+  kDrawPoints,
+  kDrawVertices,
+  kDrawImage,
+  kDrawImageRect,
+  kDrawImageNine,
+  kDrawImageLattice,
+  kDrawAtlas,
+  kDrawPicture,
+  kDrawDisplayList,
+  kDrawTextBlob,
+  kDrawShadow,
+  kCount,
+};
+
+constexpr const char* kTraceOpNames[] = {
+    "SaveLayer",       "Restore",      "DrawPaint",     "DrawColor",
+    "DrawLine",        "DrawRect",     "DrawOval",      "DrawCircle",
+    "DrawRRect",       "DrawDRRect",   "DrawPath",      "DrawArc",
+    "DrawPoints",      "DrawVertices", "DrawImage",     "DrawImageRect",
+    "DrawImageNine",   "DrawImageLattice", "DrawAtlas", "DrawPicture",
+    "DrawDisplayList", "DrawTextBlob", "DrawShadow",
+};
+static_assert(sizeof(kTraceOpNames) / sizeof(kTraceOpNames[0]) ==
+                  static_cast<size_t>(TraceOp::kCount),
+              "Every TraceOp needs a name");
+
+struct TraceOpTimings {
+  uint64_t counts[static_cast<size_t>(TraceOp::kCount)] = {};
+  fml::TimeDelta times[static_cast<size_t>(TraceOp::kCount)] = {};
+};
+
+class ScopedTraceOpTimer {
+ public:
+  ScopedTraceOpTimer(TraceOpTimings& timings, TraceOp op)
+      : timings_(timings),
+        index_(static_cast<size_t>(op)),
+        start_(fml::TimePoint::Now()) {}
+
+  ~ScopedTraceOpTimer() {
+    timings_.times[index_] =
+        timings_.times[index_] + (fml::TimePoint::Now() - start_);
+    timings_.counts[index_]++;
+  }
+
+ private:
+  TraceOpTimings& timings_;
+  const size_t index_;
+  const fml::TimePoint start_;
+};
+
+#define TIME_TRACE_OP(OP) ScopedTraceOpTimer timer(timings_, TraceOp::k##OP)
+
+// A DisplayListCanvasDispatcher that accumulates the time spent in each
+// of the ops that render. Nested DisplayLists are timed as a whole.
+class TimingCanvasDispatcher final : public DisplayListCanvasDispatcher {
+ public:
+  TimingCanvasDispatcher(SkCanvas* canvas, TraceOpTimings& timings)
+      : DisplayListCanvasDispatcher(canvas), timings_(timings) {}
+
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options) override {
+    TIME_TRACE_OP(SaveLayer);
+    DisplayListCanvasDispatcher::saveLayer(bounds, options);
+  }
+  void restore() override {
+    TIME_TRACE_OP(Restore);
+    DisplayListCanvasDispatcher::restore();
+  }
+
+  void drawPaint() override {
+    TIME_TRACE_OP(DrawPaint);
+    DisplayListCanvasDispatcher::drawPaint();
+  }
+  void drawColor(SkColor color, SkBlendMode mode) override {
+    TIME_TRACE_OP(DrawColor);
+    DisplayListCanvasDispatcher::drawColor(color, mode);
+  }
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override {
+    TIME_TRACE_OP(DrawLine);
+    DisplayListCanvasDispatcher::drawLine(p0, p1);
+  }
+  void drawRect(const SkRect& rect) override {
+    TIME_TRACE_OP(DrawRect);
+    DisplayListCanvasDispatcher::drawRect(rect);
+  }
+  void drawOval(const SkRect& bounds) override {
+    TIME_TRACE_OP(DrawOval);
+    DisplayListCanvasDispatcher::drawOval(bounds);
+  }
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    TIME_TRACE_OP(DrawCircle);
+    DisplayListCanvasDispatcher::drawCircle(center, radius);
+  }
+  void drawRRect(const SkRRect& rrect) override {
+    TIME_TRACE_OP(DrawRRect);
+    DisplayListCanvasDispatcher::drawRRect(rrect);
+  }
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    TIME_TRACE_OP(DrawDRRect);
+    DisplayListCanvasDispatcher::drawDRRect(outer, inner);
+  }
+  void drawPath(const SkPath& path) override {
+    TIME_TRACE_OP(DrawPath);
+    DisplayListCanvasDispatcher::drawPath(path);
+  }
+  void drawArc(const SkRect& bounds,
+               SkScalar start,
+               SkScalar sweep,
+               bool use_center) override {
+    TIME_TRACE_OP(DrawArc);
+    DisplayListCanvasDispatcher::drawArc(bounds, start, sweep, use_center);
+  }
+  void drawPoints(SkCanvas::PointMode mode,
+                  uint32_t count,
+                  const SkPoint pts[]) override {
+    TIME_TRACE_OP(DrawPoints);
+    DisplayListCanvasDispatcher::drawPoints(mode, count, pts);
+  }
+  void drawVertices(const sk_sp<SkVertices> vertices,
+                    SkBlendMode mode) override {
+    TIME_TRACE_OP(DrawVertices);
+    DisplayListCanvasDispatcher::drawVertices(vertices, mode);
+  }
+  void drawImage(const sk_sp<SkImage> image,
+                 const SkPoint point,
+                 const SkSamplingOptions& sampling,
+                 bool render_with_attributes) override {
+    TIME_TRACE_OP(DrawImage);
+    DisplayListCanvasDispatcher::drawImage(image, point, sampling,
+                                           render_with_attributes);
+  }
+  void drawImageRect(const sk_sp<SkImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     const SkSamplingOptions& sampling,
+                     bool render_with_attributes,
+                     SkCanvas::SrcRectConstraint constraint) override {
+    TIME_TRACE_OP(DrawImageRect);
+    DisplayListCanvasDispatcher::drawImageRect(
+        image, src, dst, sampling, render_with_attributes, constraint);
+  }
+  void drawImageNine(const sk_sp<SkImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     SkFilterMode filter,
+                     bool render_with_attributes) override {
+    TIME_TRACE_OP(DrawImageNine);
+    DisplayListCanvasDispatcher::drawImageNine(image, center, dst, filter,
+                                               render_with_attributes);
+  }
+  void drawImageLattice(const sk_sp<SkImage> image,
+                        const SkCanvas::Lattice& lattice,
+                        const SkRect& dst,
+                        SkFilterMode filter,
+                        bool render_with_attributes) override {
+    TIME_TRACE_OP(DrawImageLattice);
+    DisplayListCanvasDispatcher::drawImageLattice(image, lattice, dst, filter,
+                                                  render_with_attributes);
+  }
+  void drawAtlas(const sk_sp<SkImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const SkColor colors[],
+                 int count,
+                 SkBlendMode mode,
+                 const SkSamplingOptions& sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    TIME_TRACE_OP(DrawAtlas);
+    DisplayListCanvasDispatcher::drawAtlas(atlas, xform, tex, colors, count,
+                                           mode, sampling, cull_rect,
+                                           render_with_attributes);
+  }
+  void drawPicture(const sk_sp<SkPicture> picture,
+                   const SkMatrix* matrix,
+                   bool render_with_attributes) override {
+    TIME_TRACE_OP(DrawPicture);
+    DisplayListCanvasDispatcher::drawPicture(picture, matrix,
+                                             render_with_attributes);
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list) override {
+    TIME_TRACE_OP(DrawDisplayList);
+    DisplayListCanvasDispatcher::drawDisplayList(display_list);
+  }
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    TIME_TRACE_OP(DrawTextBlob);
+    DisplayListCanvasDispatcher::drawTextBlob(blob, x, y);
+  }
+  void drawShadow(const SkPath& path,
+                  const SkColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    TIME_TRACE_OP(DrawShadow);
+    DisplayListCanvasDispatcher::drawShadow(path, color, elevation,
+                                            transparent_occluder, dpr);
+  }
+
+ private:
+  TraceOpTimings& timings_;
+};
+
+#undef TIME_TRACE_OP
+
+bool HasExtension(const std::string& filename, const char* extension) {
+  size_t length = strlen(extension);
+  return filename.size() > length &&
+         filename.compare(filename.size() - length, length, extension) == 0;
+}
+
+sk_sp<DisplayList> LoadTrace(const fml::UniqueFD& directory,
+                             const std::string& filename) {
+  std::shared_ptr<fml::FileMapping> mapping =
+      fml::FileMapping::CreateReadOnly(directory, filename);
+  if (!mapping || mapping->GetSize() == 0) {
+    return nullptr;
+  }
+  if (HasExtension(filename, kSerializedExtension)) {
+    return DisplayList::MakeFromMapping(mapping);
+  }
+  sk_sp<SkPicture> picture = SkPicture::MakeFromData(
+      SkData::MakeWithoutCopy(mapping->GetMapping(), mapping->GetSize())
+          .get());
+  if (!picture) {
+    return nullptr;
+  }
+  DisplayListCanvasRecorder recorder(picture->cullRect());
+  picture->playback(&recorder);
+  return recorder.Build();
+}
+
+SkISize GetTraceSurfaceSize(DisplayList& display_list) {
+  SkIRect bounds = display_list.bounds().roundOut();
+  return SkISize::Make(
+      std::clamp(bounds.right(), 1, kMaxTraceSurfaceSize),
+      std::clamp(bounds.bottom(), 1, kMaxTraceSurfaceSize));
+}
+
+void AnnotateTrace(const DisplayList& display_list, benchmark::State& state) {
+  state.counters["OpCount"] = display_list.op_count(true);
+  state.counters["Bytes"] = display_list.bytes(true);
+}
+
+void BM_TraceBuild(benchmark::State& state, sk_sp<DisplayList> display_list) {
+  AnnotateTrace(*display_list, state);
+  for ([[maybe_unused]] auto _ : state) {
+    DisplayListBuilder builder(display_list->bounds());
+    display_list->Dispatch(builder);
+    benchmark::DoNotOptimize(builder.Build());
+  }
+  state.SetItemsProcessed(state.iterations() * display_list->op_count(true));
+}
+
+void BM_TraceDispatch(benchmark::State& state,
+                      BackendType backend_type,
+                      sk_sp<DisplayList> display_list) {
+  auto canvas_provider = CreateCanvasProvider(backend_type);
+  SkISize size = GetTraceSurfaceSize(*display_list);
+  canvas_provider->InitializeSurface(size.width(), size.height());
+  auto surface = canvas_provider->GetSurface();
+  auto canvas = surface->getCanvas();
+  AnnotateTrace(*display_list, state);
+  AnnotateComplexity(backend_type, display_list.get(), state);
+
+  for ([[maybe_unused]] auto _ : state) {
+    display_list->RenderTo(canvas);
+    // The GPU work is flushed outside of the measured time so that it
+    // does not pile up across the iterations.
+    state.PauseTiming();
+    surface->flushAndSubmit(true);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * display_list->op_count(true));
+}
+
+void BM_TraceRaster(benchmark::State& state,
+                    BackendType backend_type,
+                    sk_sp<DisplayList> display_list,
+                    std::string trace_name) {
+  auto canvas_provider = CreateCanvasProvider(backend_type);
+  SkISize size = GetTraceSurfaceSize(*display_list);
+  canvas_provider->InitializeSurface(size.width(), size.height());
+  auto surface = canvas_provider->GetSurface();
+  auto canvas = surface->getCanvas();
+  AnnotateTrace(*display_list, state);
+  AnnotateComplexity(backend_type, display_list.get(), state);
+
+  for ([[maybe_unused]] auto _ : state) {
+    display_list->RenderTo(canvas);
+    surface->flushAndSubmit(true);
+  }
+  state.SetItemsProcessed(state.iterations() * display_list->op_count(true));
+
+  canvas_provider->Snapshot(canvas_provider->BackendName() + "-Trace-" +
+                            trace_name + ".png");
+}
+
+void BM_TraceOpBreakdown(benchmark::State& state,
+                         BackendType backend_type,
+                         sk_sp<DisplayList> display_list) {
+  auto canvas_provider = CreateCanvasProvider(backend_type);
+  SkISize size = GetTraceSurfaceSize(*display_list);
+  canvas_provider->InitializeSurface(size.width(), size.height());
+  auto surface = canvas_provider->GetSurface();
+  auto canvas = surface->getCanvas();
+  AnnotateTrace(*display_list, state);
+
+  TraceOpTimings timings;
+  for ([[maybe_unused]] auto _ : state) {
+    int save_count = canvas->getSaveCount();
+    TimingCanvasDispatcher dispatcher(canvas, timings);
+    display_list->Dispatch(dispatcher);
+    canvas->restoreToCount(save_count);
+    surface->flushAndSubmit(true);
+  }
+
+  for (size_t i = 0; i < static_cast<size_t>(TraceOp::kCount); i++) {
+    if (timings.counts[i] == 0) {
+      continue;
+    }
+    std::string name = kTraceOpNames[i];
+    state.counters[name + ".Count"] = benchmark::Counter(
+        timings.counts[i], benchmark::Counter::kAvgIterations);
+    state.counters[name + ".Time"] =
+        benchmark::Counter(timings.times[i].ToNanosecondsF() * 1e-9,
+                           benchmark::Counter::kAvgIterations);
+  }
+}
+
+struct TraceBackend {
+  BackendType type;
+  const char* name;
+};
+
+std::vector<TraceBackend> GetTraceBackends() {
+  std::vector<TraceBackend> backends;
+#ifdef ENABLE_SOFTWARE_BENCHMARKS
+  backends.push_back({kSoftware_Backend, "Software"});
+#endif
+#ifdef ENABLE_OPENGL_BENCHMARKS
+  backends.push_back({kOpenGL_Backend, "OpenGL"});
+#endif
+#ifdef ENABLE_METAL_BENCHMARKS
+  backends.push_back({kMetal_Backend, "Metal"});
+#endif
+  return backends;
+}
+
+fml::UniqueFD OpenTracesDirectory() {
+  const char* path = std::getenv(kTracesEnvironmentVariable);
+  if (path != nullptr) {
+    return fml::OpenDirectory(path, false, fml::FilePermission::kRead);
+  }
+  return fml::OpenDirectoryReadOnly(OpenFixturesDirectory(),
+                                    kTracesFixturesDirectory);
+}
+
+bool RegisterTraceBenchmarks() {
+  fml::UniqueFD directory = OpenTracesDirectory();
+  if (!directory.is_valid()) {
+    return false;
+  }
+  std::vector<TraceBackend> backends = GetTraceBackends();
+  fml::VisitFiles(directory, [&backends](const fml::UniqueFD& directory,
+                                         const std::string& filename) {
+    if (!HasExtension(filename, kSerializedExtension) &&
+        !HasExtension(filename, kPictureExtension)) {
+      return true;
+    }
+    sk_sp<DisplayList> display_list = LoadTrace(directory, filename);
+    if (!display_list) {
+      FML_LOG(ERROR) << "Could not load DisplayList trace " << filename;
+      return true;
+    }
+    benchmark::RegisterBenchmark(("TraceBuild/" + filename).c_str(),
+                                 BM_TraceBuild, display_list)
+        ->Unit(benchmark::kMicrosecond);
+    for (const TraceBackend& backend : backends) {
+      std::string suffix = std::string(backend.name) + "/" + filename;
+      benchmark::RegisterBenchmark(("TraceDispatch/" + suffix).c_str(),
+                                   BM_TraceDispatch, backend.type,
+                                   display_list)
+          ->Unit(benchmark::kMillisecond);
+      benchmark::RegisterBenchmark(("TraceRaster/" + suffix).c_str(),
+                                   BM_TraceRaster, backend.type, display_list,
+                                   filename)
+          ->Unit(benchmark::kMillisecond);
+      benchmark::RegisterBenchmark(("TraceOpBreakdown/" + suffix).c_str(),
+                                   BM_TraceOpBreakdown, backend.type,
+                                   display_list)
+          ->Unit(benchmark::kMillisecond);
+    }
+    return true;
+  });
+  return true;
+}
+
+[[maybe_unused]] const bool kTraceBenchmarksRegistered =
+    RegisterTraceBenchmarks();
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace flutter
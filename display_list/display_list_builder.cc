@@ -4,7 +4,10 @@
 
 #include "flutter/display_list/display_list_builder.h"
 
+#include <algorithm>
+
 #include "flutter/display_list/display_list_ops.h"
+#include "flutter/fml/trace_event.h"
 
 namespace flutter {
 
@@ -29,41 +32,104 @@ void* DisplayListBuilder::Push(size_t pod, int op_inc, Args&&... args) {
   if (used_ + size > allocated_) {
     static_assert(SkIsPow2(DL_BUILDER_PAGE),
                   "This math needs updating for non-pow2.");
-    // Next greater multiple of DL_BUILDER_PAGE.
-    allocated_ = (used_ + size + DL_BUILDER_PAGE) & ~(DL_BUILDER_PAGE - 1);
+    // Grow the storage geometrically so that recording a large list only
+    // takes a logarithmic number of reallocations (and copies of the ops
+    // recorded so far), rounded up to a multiple of DL_BUILDER_PAGE.
+    size_t needed = std::max(used_ + size, allocated_ + (allocated_ >> 1));
+    allocated_ = (needed + DL_BUILDER_PAGE - 1) & ~(DL_BUILDER_PAGE - 1);
     storage_.realloc(allocated_);
     FML_DCHECK(storage_.get());
     memset(storage_.get() + used_, 0, allocated_ - used_);
   }
   FML_DCHECK(used_ + size <= allocated_);
   auto op = reinterpret_cast<T*>(storage_.get() + used_);
+  last_op_offset_ = used_;
   used_ += size;
   new (op) T{std::forward<Args>(args)...};
   op->type = T::kType;
   op->size = size;
   op_count_ += op_inc;
+  if (T::kType <= DisplayListOpType::kSetMaskBlurFilterInner ||
+      T::kType >= DisplayListOpType::kDrawPaint) {
+    content_op_count_++;
+  }
   return op + 1;
 }
 
+void DisplayListBuilder::TruncateOps(size_t offset, int op_count) {
+  FML_DCHECK(offset <= used_);
+  uint8_t* ptr = storage_.get();
+  if (offset < used_) {
+    DisplayList::DisposeOps(ptr + offset, ptr + used_);
+    // The bulk comparisons in |DisplayList::Equals| rely on the padding
+    // in every record being zero, as it is in freshly grown storage.
+    memset(ptr + offset, 0, used_ - offset);
+  }
+  used_ = offset;
+  op_count_ = op_count;
+  last_op_offset_ = kNoLastOp;
+  while (!pending_opacity_layers_.empty() &&
+         pending_opacity_layers_.back() >= offset) {
+    pending_opacity_layers_.pop_back();
+  }
+}
+
+template <typename T>
+const T* DisplayListBuilder::LastOpIf() const {
+  if (!optimize_state_ops_ || last_op_offset_ == kNoLastOp) {
+    return nullptr;
+  }
+  auto op = reinterpret_cast<const DLOp*>(storage_.get() + last_op_offset_);
+  return op->type == T::kType ? static_cast<const T*>(op) : nullptr;
+}
+
 sk_sp<DisplayList> DisplayListBuilder::Build() {
   while (layer_stack_.size() > 1) {
     restore();
   }
   size_t bytes = used_;
+  size_t unused = allocated_ - used_;
   int count = op_count_;
   size_t nested_bytes = nested_bytes_;
   int nested_count = nested_op_count_;
   used_ = allocated_ = op_count_ = 0;
   nested_bytes_ = nested_op_count_ = 0;
-  storage_.realloc(bytes);
-  bool compatible = layer_stack_.back().is_group_opacity_compatible();
-  return sk_sp<DisplayList>(new DisplayList(storage_.release(), bytes, count,
-                                            nested_bytes, nested_count,
-                                            cull_rect_, compatible));
+  content_op_count_ = 0;
+  last_op_offset_ = kNoLastOp;
+  // The storage is handed to the DisplayList as is unless a significant
+  // part of it is unused, since shrinking it may move (copy) all of the
+  // recorded ops.
+  if (unused > std::max<size_t>(DL_BUILDER_PAGE, bytes / 4)) {
+    storage_.realloc(bytes);
+  }
+  const LayerInfo& root_layer = layer_stack_.back();
+  const char* opacity_rejection = root_layer.opacity_rejection;
+  bool check_root_overlap = root_layer.is_group_opacity_compatible() &&
+                            root_layer.has_multiple_compatible_ops;
+  bool compatible =
+      root_layer.is_group_opacity_compatible() && !check_root_overlap;
+  sk_sp<DisplayList> display_list(
+      new DisplayList(storage_.release(), bytes, count, nested_bytes,
+                      nested_count, cull_rect_, compatible));
+  if (check_root_overlap || !pending_opacity_layers_.empty()) {
+    std::sort(pending_opacity_layers_.begin(), pending_opacity_layers_.end());
+    opacity_rejection = display_list->ComputeGroupOpacity(
+        pending_opacity_layers_, check_root_overlap);
+    pending_opacity_layers_.clear();
+  }
+  if (!display_list->can_apply_group_opacity()) {
+    TRACE_EVENT_INSTANT1("flutter", "DisplayList group opacity rejected",
+                         "reason", opacity_rejection);
+  }
+  if (prepare_rtree_) {
+    display_list->ComputeRTree();
+  }
+  return display_list;
 }
 
-DisplayListBuilder::DisplayListBuilder(const SkRect& cull_rect)
-    : cull_rect_(cull_rect) {
+DisplayListBuilder::DisplayListBuilder(const SkRect& cull_rect,
+                                       bool prepare_rtree)
+    : cull_rect_(cull_rect), prepare_rtree_(prepare_rtree) {
   layer_stack_.emplace_back();
   current_layer_ = &layer_stack_.back();
 }
@@ -225,9 +291,14 @@ void DisplayListBuilder::setAttributesFromPaint(
 }
 
 void DisplayListBuilder::save() {
+  size_t save_offset = used_;
+  int save_op_count = op_count_;
+  int save_content_op_count = content_op_count_;
   Push<SaveOp>(0, 1);
-  layer_stack_.emplace_back();
+  layer_stack_.emplace_back(save_offset, false);
   current_layer_ = &layer_stack_.back();
+  current_layer_->save_op_count = save_op_count;
+  current_layer_->save_content_op_count = save_content_op_count;
 }
 void DisplayListBuilder::restore() {
   if (layer_stack_.size() > 1) {
@@ -236,9 +307,34 @@ void DisplayListBuilder::restore() {
     LayerInfo layer_info = layer_stack_.back();
     layer_stack_.pop_back();
     current_layer_ = &layer_stack_.back();
+    if (optimize_state_ops_ &&
+        layer_info.save_content_op_count == content_op_count_ &&
+        layer_info.can_drop_if_empty) {
+      // Nothing was rendered and no attributes were changed since the
+      // save so the save, the restore and any transforms and clips in
+      // between have no effect.
+      TruncateOps(layer_info.save_layer_offset, layer_info.save_op_count);
+      if (layer_info.has_layer) {
+        current_layer_->cannot_inherit_opacity =
+            layer_info.outer_cannot_inherit_opacity;
+        current_layer_->has_compatible_op = layer_info.outer_has_compatible_op;
+        current_layer_->has_multiple_compatible_ops =
+            layer_info.outer_has_multiple_compatible_ops;
+        current_layer_->opacity_rejection = layer_info.outer_opacity_rejection;
+      }
+      return;
+    }
     Push<RestoreOp>(0, 1);
     if (layer_info.has_layer) {
-      if (layer_info.is_group_opacity_compatible()) {
+      // A remaining saveLayer must itself survive the elimination of
+      // any empty save that surrounds it.
+      content_op_count_++;
+      if (layer_info.is_group_opacity_compatible() &&
+          layer_info.has_multiple_compatible_ops) {
+        // Whether the ops overlap can only be determined from their
+        // bounds, which are computed once the list is built.
+        pending_opacity_layers_.push_back(layer_info.save_layer_offset);
+      } else if (layer_info.is_group_opacity_compatible()) {
         // We are now going to go back and modify the matching saveLayer
         // call to add the option indicating it can distribute an opacity
         // value to its children.
@@ -259,9 +355,12 @@ void DisplayListBuilder::restore() {
       // For regular save() ops there was no protecting layer so we have to
       // accumulate the values into the enclosing layer.
       if (layer_info.cannot_inherit_opacity) {
-        current_layer_->mark_incompatible();
+        current_layer_->mark_incompatible(layer_info.opacity_rejection);
       } else if (layer_info.has_compatible_op) {
         current_layer_->add_compatible_op();
+        if (layer_info.has_multiple_compatible_ops) {
+          current_layer_->add_compatible_op();
+        }
       }
     }
   }
@@ -270,19 +369,39 @@ void DisplayListBuilder::saveLayer(const SkRect* bounds,
                                    const SaveLayerOptions in_options) {
   SaveLayerOptions options = in_options.without_optimizations();
   size_t save_layer_offset = used_;
+  int save_op_count = op_count_;
+  int save_content_op_count = content_op_count_;
+  bool outer_cannot_inherit_opacity = current_layer_->cannot_inherit_opacity;
+  bool outer_has_compatible_op = current_layer_->has_compatible_op;
+  bool outer_has_multiple_compatible_ops =
+      current_layer_->has_multiple_compatible_ops;
+  const char* outer_opacity_rejection = current_layer_->opacity_rejection;
+  // An empty layer only has no effect if compositing it does not modify
+  // the transparent black it contains.
+  bool can_drop_if_empty =
+      !options.renders_with_attributes() ||
+      (current_opacity_compatibility_ && current_image_filter_ == nullptr);
   bounds  //
       ? Push<SaveLayerBoundsOp>(0, 1, *bounds, options)
       : Push<SaveLayerOp>(0, 1, options);
   CheckLayerOpacityCompatibility(options.renders_with_attributes());
   layer_stack_.emplace_back(save_layer_offset, true);
   current_layer_ = &layer_stack_.back();
+  current_layer_->save_op_count = save_op_count;
+  current_layer_->save_content_op_count = save_content_op_count;
+  current_layer_->can_drop_if_empty = can_drop_if_empty;
+  current_layer_->outer_cannot_inherit_opacity = outer_cannot_inherit_opacity;
+  current_layer_->outer_has_compatible_op = outer_has_compatible_op;
+  current_layer_->outer_has_multiple_compatible_ops =
+      outer_has_multiple_compatible_ops;
+  current_layer_->outer_opacity_rejection = outer_opacity_rejection;
   if (options.renders_with_attributes()) {
     // |current_opacity_compatibility_| does not take an ImageFilter into
     // account because an individual primitive with an ImageFilter can apply
     // opacity on top of it. But, if the layer is applying the ImageFilter
     // then it cannot pass the opacity on.
     if (!current_opacity_compatibility_ || current_image_filter_ != nullptr) {
-      UpdateLayerOpacityCompatibility(false);
+      current_layer_->mark_incompatible("saveLayer attributes");
     }
   }
 }
@@ -290,12 +409,26 @@ void DisplayListBuilder::saveLayer(const SkRect* bounds,
 void DisplayListBuilder::translate(SkScalar tx, SkScalar ty) {
   if (SkScalarIsFinite(tx) && SkScalarIsFinite(ty) &&
       (tx != 0.0 || ty != 0.0)) {
+    if (const TranslateOp* last = LastOpIf<TranslateOp>()) {
+      tx += last->tx;
+      ty += last->ty;
+      TruncateOps(last_op_offset_, op_count_ - 1);
+      translate(tx, ty);
+      return;
+    }
     Push<TranslateOp>(0, 1, tx, ty);
   }
 }
 void DisplayListBuilder::scale(SkScalar sx, SkScalar sy) {
   if (SkScalarIsFinite(sx) && SkScalarIsFinite(sy) &&
       (sx != 1.0 || sy != 1.0)) {
+    if (const ScaleOp* last = LastOpIf<ScaleOp>()) {
+      sx *= last->sx;
+      sy *= last->sy;
+      TruncateOps(last_op_offset_, op_count_ - 1);
+      scale(sx, sy);
+      return;
+    }
     Push<ScaleOp>(0, 1, sx, sy);
   }
 }
@@ -322,6 +455,19 @@ void DisplayListBuilder::transform2DAffine(
       SkScalarsAreFinite(mxt, myt) &&
       !(mxx == 1 && mxy == 0 && mxt == 0 &&
         myx == 0 && myy == 1 && myt == 0)) {
+    if (const Transform2DAffineOp* last = LastOpIf<Transform2DAffineOp>()) {
+      // The new transform is concatenated after (inside of) the last one.
+      SkScalar cxx = last->mxx * mxx + last->mxy * myx;
+      SkScalar cxy = last->mxx * mxy + last->mxy * myy;
+      SkScalar cxt = last->mxx * mxt + last->mxy * myt + last->mxt;
+      SkScalar cyx = last->myx * mxx + last->myy * myx;
+      SkScalar cyy = last->myx * mxy + last->myy * myy;
+      SkScalar cyt = last->myx * mxt + last->myy * myt + last->myt;
+      TruncateOps(last_op_offset_, op_count_ - 1);
+      transform2DAffine(cxx, cxy, cxt,
+                        cyx, cyy, cyt);
+      return;
+    }
     Push<Transform2DAffineOp>(0, 1,
                               mxx, mxy, mxt,
                               myx, myy, myt);
@@ -477,7 +623,7 @@ void DisplayListBuilder::drawPoints(SkCanvas::PointMode mode,
   // distribution of group opacity without analyzing the mode and the
   // bounds of every sub-primitive.
   // See: https://fiddle.skia.org/c/228459001d2de8db117ce25ef5cedb0c
-  UpdateLayerOpacityCompatibility(false);
+  current_layer_->mark_incompatible("drawPoints");
 }
 void DisplayListBuilder::drawVertices(const sk_sp<SkVertices> vertices,
                                       SkBlendMode mode) {
@@ -486,7 +632,7 @@ void DisplayListBuilder::drawVertices(const sk_sp<SkVertices> vertices,
   // of controlling opacity using the current paint attributes.
   // Although, examination of the |mode| might find some predictable
   // cases.
-  UpdateLayerOpacityCompatibility(false);
+  current_layer_->mark_incompatible("drawVertices");
 }
 
 void DisplayListBuilder::drawImage(const sk_sp<SkImage> image,
@@ -577,7 +723,7 @@ void DisplayListBuilder::drawAtlas(const sk_sp<SkImage> atlas,
   // drawAtlas treats each image as a separate operation so we cannot rely
   // on it to distribute the opacity without overlap without checking all
   // of the transforms and texture rectangles.
-  UpdateLayerOpacityCompatibility(false);
+  current_layer_->mark_incompatible("drawAtlas");
 }
 
 void DisplayListBuilder::drawPicture(const sk_sp<SkPicture> picture,
@@ -608,7 +754,8 @@ void DisplayListBuilder::drawDisplayList(
   // This behavior is identical to the way SkPicture computes nested op counts.
   nested_op_count_ += display_list->op_count(true) - 1;
   nested_bytes_ += display_list->bytes(true);
-  UpdateLayerOpacityCompatibility(display_list->can_apply_group_opacity());
+  UpdateLayerOpacityCompatibility(display_list->can_apply_group_opacity(),
+                                  "nested DisplayList");
 }
 void DisplayListBuilder::drawTextBlob(const sk_sp<SkTextBlob> blob,
                                       SkScalar x,
@@ -624,7 +771,7 @@ void DisplayListBuilder::drawShadow(const SkPath& path,
   transparent_occluder  //
       ? Push<DrawShadowTransparentOccluderOp>(0, 1, path, color, elevation, dpr)
       : Push<DrawShadowOp>(0, 1, path, color, elevation, dpr);
-  UpdateLayerOpacityCompatibility(false);
+  current_layer_->mark_incompatible("drawShadow");
 }
 
 // clang-format off
@@ -22,10 +22,25 @@ class DisplayListBuilder final : public virtual Dispatcher,
                                  public SkRefCnt,
                                  DisplayListOpFlags {
  public:
-  explicit DisplayListBuilder(const SkRect& cull_rect = kMaxCullRect_);
+  // If |prepare_rtree| is true then the DisplayLists produced by |Build|
+  // will carry a spatial index of their rendering ops that allows them
+  // to be dispatched with culling. See |DisplayList::Dispatch|.
+  explicit DisplayListBuilder(const SkRect& cull_rect = kMaxCullRect_,
+                              bool prepare_rtree = false);
 
   ~DisplayListBuilder();
 
+  // Enables an optimizing recording mode that eliminates state ops which
+  // can have no effect on the rendering:
+  // - save/restore pairs that contain only transforms and clips
+  // - saveLayer/restore pairs with no contents, if the layer would not
+  //   modify the destination when composited while empty
+  // - consecutive translate, scale or 2D affine transform calls, which
+  //   are folded into a single op of the same type
+  // Redundant attribute sets are always eliminated. This mode should be
+  // enabled before any ops are recorded.
+  void set_optimize_state_ops(bool optimize) { optimize_state_ops_ = optimize; }
+
   void setAntiAlias(bool aa) override {
     if (current_anti_alias_ != aa) {
       onSetAntiAlias(aa);
@@ -268,12 +283,33 @@ class DisplayListBuilder final : public virtual Dispatcher,
   int nested_op_count_ = 0;
 
   SkRect cull_rect_;
+  const bool prepare_rtree_;
+  bool optimize_state_ops_ = false;
+
+  // The number of attribute and rendering ops (and non-empty saveLayers)
+  // recorded so far. These are the ops that must survive the elimination
+  // of empty save/restore pairs in |optimize_state_ops_| mode.
+  int content_op_count_ = 0;
+
+  // The offset of the most recently pushed op, or |kNoLastOp| if that op
+  // was removed by |TruncateOps|.
+  static constexpr size_t kNoLastOp = ~static_cast<size_t>(0);
+  size_t last_op_offset_ = kNoLastOp;
   static constexpr SkRect kMaxCullRect_ =
       SkRect::MakeLTRB(-1E9F, -1E9F, 1E9F, 1E9F);
 
   template <typename T, typename... Args>
   void* Push(size_t extra, int op_inc, Args&&... args);
 
+  // Removes all ops recorded at or after |offset| and resets the op count
+  // to the value it had when that offset was the end of the storage.
+  void TruncateOps(size_t offset, int op_count);
+
+  // Returns the most recently pushed op if |optimize_state_ops_| mode is
+  // enabled and that op is of type T, otherwise nullptr.
+  template <typename T>
+  const T* LastOpIf() const;
+
   // kInvalidSigma is used to indicate that no MaskBlur is currently set.
   static constexpr SkScalar kInvalidSigma = 0.0;
   static bool mask_sigma_valid(SkScalar sigma) {
@@ -285,33 +321,61 @@ class DisplayListBuilder final : public virtual Dispatcher,
         : save_layer_offset(save_layer_offset),
           has_layer(has_layer),
           cannot_inherit_opacity(false),
-          has_compatible_op(false) {}
-
-    // The offset into the memory buffer where the saveLayer DLOp record
-    // for this saveLayer() call is placed. This may be needed if the
-    // eventual restore() call has discovered important information about
-    // the records inside the saveLayer that may impact how the saveLayer
-    // is handled (e.g., |cannot_inherit_opacity| == false).
-    // This offset is only valid if |has_layer| is true.
+          has_compatible_op(false),
+          has_multiple_compatible_ops(false),
+          opacity_rejection(nullptr) {}
+
+    // The offset into the memory buffer where the save or saveLayer DLOp
+    // record for this save() or saveLayer() call is placed. This may be
+    // needed if the eventual restore() call has discovered important
+    // information about the records inside the saveLayer that may impact
+    // how the saveLayer is handled (e.g., |cannot_inherit_opacity| ==
+    // false), or if the restore() call eliminates the entire save.
     size_t save_layer_offset;
 
     bool has_layer;
     bool cannot_inherit_opacity;
     bool has_compatible_op;
 
+    // Set when more than one compatible op was recorded into the layer,
+    // in which case the layer can only inherit an opacity if none of
+    // those ops overlap. The overlap check needs the bounds of the ops
+    // and is deferred to |DisplayList::ComputeGroupOpacity| in |Build|.
+    bool has_multiple_compatible_ops;
+
+    // A short description of the first op or attribute that prevented
+    // the layer from inheriting an opacity, reported in the trace.
+    const char* opacity_rejection;
+
+    // The information needed to eliminate an empty save or saveLayer in
+    // |optimize_state_ops_| mode. The op counts are the values of the
+    // builder's counters just before the save record was pushed and the
+    // outer opacity flags are those of the enclosing layer at that time.
+    int save_op_count = 0;
+    int save_content_op_count = 0;
+    bool can_drop_if_empty = true;
+    bool outer_cannot_inherit_opacity = false;
+    bool outer_has_compatible_op = false;
+    bool outer_has_multiple_compatible_ops = false;
+    const char* outer_opacity_rejection = nullptr;
+
     bool is_group_opacity_compatible() const { return !cannot_inherit_opacity; }
 
-    void mark_incompatible() { cannot_inherit_opacity = true; }
+    void mark_incompatible(const char* reason) {
+      if (!cannot_inherit_opacity) {
+        cannot_inherit_opacity = true;
+        opacity_rejection = reason;
+      }
+    }
 
-    // For now this only allows a single compatible op to mark the
-    // layer as being compatible with group opacity. If we start
-    // computing bounds of ops in the Builder methods then we
-    // can upgrade this to checking for overlapping ops.
+    // A single compatible op can always inherit the opacity of the layer.
+    // Additional compatible ops are only recorded here and checked for
+    // overlap once the bounds of all of the ops are known.
     // See https://github.com/flutter/flutter/issues/93899
     void add_compatible_op() {
       if (!cannot_inherit_opacity) {
         if (has_compatible_op) {
-          cannot_inherit_opacity = true;
+          has_multiple_compatible_ops = true;
         } else {
           has_compatible_op = true;
         }
@@ -322,10 +386,18 @@ class DisplayListBuilder final : public virtual Dispatcher,
   std::vector<LayerInfo> layer_stack_;
   LayerInfo* current_layer_;
 
+  // The offsets of the saveLayer records whose layers were compatible
+  // with group opacity except for the overlap check of their multiple
+  // compatible ops, which is performed in |Build|.
+  std::vector<size_t> pending_opacity_layers_;
+
   // This flag indicates whether or not the current rendering attributes
   // are compatible with rendering ops applying an inherited opacity.
   bool current_opacity_compatibility_ = true;
 
+  static constexpr char kIncompatibleAttributesRejection[] =
+      "blend mode, color filter or invert colors attribute";
+
   // Returns the compatibility of a given blend mode for applying an
   // inherited opacity value to modulate the visibility of the op.
   // For now we only accept SrcOver blend modes but this could be expanded
@@ -346,11 +418,11 @@ class DisplayListBuilder final : public virtual Dispatcher,
 
   // Update the opacity compatibility flags of the current layer for an op
   // that has determined its compatibility as indicated by |compatible|.
-  void UpdateLayerOpacityCompatibility(bool compatible) {
+  void UpdateLayerOpacityCompatibility(bool compatible, const char* reason) {
     if (compatible) {
       current_layer_->add_compatible_op();
     } else {
-      current_layer_->mark_incompatible();
+      current_layer_->mark_incompatible(reason);
     }
   }
 
@@ -360,21 +432,27 @@ class DisplayListBuilder final : public virtual Dispatcher,
   // a default Paint object with the opacity applied using the default SrcOver
   // blend mode which is always compatible with applying an inherited opacity.
   void CheckLayerOpacityCompatibility(bool uses_blend_attribute = true) {
-    UpdateLayerOpacityCompatibility(!uses_blend_attribute ||
-                                    current_opacity_compatibility_);
+    UpdateLayerOpacityCompatibility(
+        !uses_blend_attribute || current_opacity_compatibility_,
+        kIncompatibleAttributesRejection);
   }
 
   void CheckLayerOpacityHairlineCompatibility() {
+    if (!current_opacity_compatibility_) {
+      current_layer_->mark_incompatible(kIncompatibleAttributesRejection);
+      return;
+    }
     UpdateLayerOpacityCompatibility(
-        current_opacity_compatibility_ &&
-        (current_style_ == SkPaint::kFill_Style || current_stroke_width_ > 0));
+        current_style_ == SkPaint::kFill_Style || current_stroke_width_ > 0,
+        "hairline path");
   }
 
   // Check for opacity compatibility for an op that ignores the current
   // attributes and uses the indicated blend |mode| to render to the layer.
   // This is only used by |drawColor| currently.
   void CheckLayerOpacityCompatibility(SkBlendMode mode) {
-    UpdateLayerOpacityCompatibility(IsOpacityCompatible(mode));
+    UpdateLayerOpacityCompatibility(IsOpacityCompatible(mode),
+                                    "drawColor blend mode");
   }
 
   void onSetAntiAlias(bool aa);
@@ -28,7 +28,7 @@ class DisplayListCanvasRecorder
  public:
   explicit DisplayListCanvasRecorder(const SkRect& bounds);
 
-  const sk_sp<DisplayListBuilder> builder() { return builder_; }
+  const sk_sp<DisplayListBuilder>& builder() { return builder_; }
 
   sk_sp<DisplayList> Build();
 
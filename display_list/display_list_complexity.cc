@@ -4,6 +4,8 @@
 
 #include "flutter/display_list/display_list_complexity.h"
 #include "flutter/display_list/display_list.h"
+#include "flutter/display_list/display_list_complexity_gl.h"
+#include "flutter/display_list/display_list_complexity_metal.h"
 
 namespace flutter {
 
@@ -21,6 +23,10 @@ DisplayListNaiveComplexityCalculator::GetInstance() {
 DisplayListComplexityCalculator* DisplayListComplexityCalculator::GetForBackend(
     GrBackendApi backend) {
   switch (backend) {
+    case GrBackendApi::kOpenGL:
+      return DisplayListGLComplexityCalculator::GetInstance();
+    case GrBackendApi::kMetal:
+      return DisplayListMetalComplexityCalculator::GetInstance();
     default:
       return DisplayListNaiveComplexityCalculator::GetInstance();
   }
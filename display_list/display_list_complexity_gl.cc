@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list_complexity_gl.h"
+
+namespace flutter {
+
+// Skia's OpenGL backend renders rects, ovals and simple rrects with
+// analytic coverage shaders, so antialiasing them is cheap. Paths that
+// are not convex are tessellated or rendered through the stencil buffer
+// at a cost roughly proportional to their verb count, and every offscreen
+// layer requires a framebuffer switch and a resolve.
+const ComplexityWeights DisplayListGLComplexityCalculator::kWeights = {
+    150,   // draw_paint
+    100,   // draw_line
+    100,   // draw_rect
+    200,   // draw_oval
+    180,   // draw_rrect
+    350,   // draw_drrect
+    300,   // draw_arc
+    250,   // draw_path
+    250,   // draw_image
+    900,   // draw_image_nine
+    150,   // draw_text_blob
+    2500,  // draw_shadow
+
+    20,  // path_line_verb
+    40,  // path_quad_verb
+    50,  // path_conic_verb
+    60,  // path_cubic_verb
+    8,   // point
+    3,   // vertex
+    40,  // atlas_sprite
+    15,  // glyph
+
+    1200,  // save_layer
+
+    3000,  // image_filter
+    1500,  // mask_filter
+    400,   // path_effect
+
+    150,  // anti_alias_percent
+    80,   // hairline_percent
+    140,  // stroke_percent
+    2,    // stroke_width_percent
+
+    1000,  // cache_threshold
+};
+
+DisplayListGLComplexityCalculator*
+    DisplayListGLComplexityCalculator::instance_ = nullptr;
+
+DisplayListComplexityCalculator*
+DisplayListGLComplexityCalculator::GetInstance() {
+  if (instance_ == nullptr) {
+    instance_ = new DisplayListGLComplexityCalculator();
+  }
+  return instance_;
+}
+
+unsigned int DisplayListGLComplexityCalculator::compute(
+    DisplayList* display_list) {
+  return ComplexityCalculatorHelper::Compute(kWeights, display_list);
+}
+
+bool DisplayListGLComplexityCalculator::should_be_cached(
+    unsigned int complexity_score) {
+  return complexity_score > kWeights.cache_threshold;
+}
+
+}  // namespace flutter
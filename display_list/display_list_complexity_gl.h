@@ -0,0 +1,31 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_DISPLAY_LIST_COMPLEXITY_GL_H_
+#define FLUTTER_FLOW_DISPLAY_LIST_COMPLEXITY_GL_H_
+
+#include "flutter/display_list/display_list_complexity_helper.h"
+
+namespace flutter {
+
+class DisplayListGLComplexityCalculator
+    : public DisplayListComplexityCalculator {
+ public:
+  static DisplayListComplexityCalculator* GetInstance();
+
+  unsigned int compute(DisplayList* display_list) override;
+
+  bool should_be_cached(unsigned int complexity_score) override;
+
+  // The weights used by this calculator, as measured on OpenGL.
+  static const ComplexityWeights kWeights;
+
+ private:
+  DisplayListGLComplexityCalculator() {}
+  static DisplayListGLComplexityCalculator* instance_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_DISPLAY_LIST_COMPLEXITY_GL_H_
@@ -0,0 +1,315 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list_complexity_helper.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/core/SkVertices.h"
+
+namespace flutter {
+
+unsigned int ComplexityCalculatorHelper::Compute(
+    const ComplexityWeights& weights,
+    DisplayList* display_list) {
+  ComplexityCalculatorHelper helper(weights,
+                                    std::numeric_limits<unsigned int>::max());
+  display_list->Dispatch(helper);
+  return helper.ComplexityScore();
+}
+
+void ComplexityCalculatorHelper::AccumulateComplexity(uint64_t complexity) {
+  if (ceiling_ - complexity_score_ < complexity) {
+    is_complex_ = true;
+    return;
+  }
+  complexity_score_ += complexity;
+}
+
+void ComplexityCalculatorHelper::AccumulateGeometry(uint64_t base) {
+  if (is_complex_) {
+    return;
+  }
+  // Computed in 64 bits so that the multipliers cannot overflow, the
+  // result saturates in AccumulateComplexity.
+  uint64_t complexity = base;
+  if (style_ != SkPaint::Style::kFill_Style) {
+    uint64_t stroke;
+    if (stroke_width_ == 0.0f) {
+      stroke = complexity * weights_.hairline_percent / 100;
+    } else {
+      stroke = complexity * weights_.stroke_percent / 100;
+      SkScalar extra_width = std::min(stroke_width_, 64.0f) - 1.0f;
+      if (extra_width > 0.0f) {
+        stroke += static_cast<uint64_t>(stroke * extra_width *
+                                        weights_.stroke_width_percent / 100);
+      }
+    }
+    complexity = style_ == SkPaint::Style::kStrokeAndFill_Style
+                     ? complexity + stroke
+                     : stroke;
+  }
+  if (anti_alias_) {
+    complexity = complexity * weights_.anti_alias_percent / 100;
+  }
+  if (has_path_effect_) {
+    complexity += weights_.path_effect;
+  }
+  if (has_mask_filter_) {
+    complexity += weights_.mask_filter;
+  }
+  if (has_image_filter_) {
+    complexity += weights_.image_filter;
+  }
+  AccumulateComplexity(complexity);
+}
+
+void ComplexityCalculatorHelper::AccumulateImage(uint64_t base,
+                                                 bool render_with_attributes) {
+  if (is_complex_) {
+    return;
+  }
+  uint64_t complexity = base;
+  if (render_with_attributes) {
+    if (has_mask_filter_) {
+      complexity += weights_.mask_filter;
+    }
+    if (has_image_filter_) {
+      complexity += weights_.image_filter;
+    }
+  }
+  AccumulateComplexity(complexity);
+}
+
+uint64_t ComplexityCalculatorHelper::PathComplexity(const SkPath& path) const {
+  int verb_count = path.countVerbs();
+  std::vector<uint8_t> verbs(verb_count);
+  path.getVerbs(verbs.data(), verb_count);
+
+  uint64_t complexity = weights_.draw_path;
+  for (int i = 0; i < verb_count; i++) {
+    switch (verbs[i]) {
+      case SkPath::Verb::kLine_Verb:
+        complexity += weights_.path_line_verb;
+        break;
+      case SkPath::Verb::kQuad_Verb:
+        complexity += weights_.path_quad_verb;
+        break;
+      case SkPath::Verb::kConic_Verb:
+        complexity += weights_.path_conic_verb;
+        break;
+      case SkPath::Verb::kCubic_Verb:
+        complexity += weights_.path_cubic_verb;
+        break;
+      default:
+        break;
+    }
+  }
+  return complexity;
+}
+
+void ComplexityCalculatorHelper::saveLayer(const SkRect* bounds,
+                                           const SaveLayerOptions options) {
+  if (is_complex_) {
+    return;
+  }
+  // Only the image filter is expensive enough to be worth accounting for
+  // among the attributes applied when the layer is composited.
+  unsigned int complexity = weights_.save_layer;
+  if (options.renders_with_attributes() && has_image_filter_) {
+    complexity += weights_.image_filter;
+  }
+  AccumulateComplexity(complexity);
+}
+
+void ComplexityCalculatorHelper::drawColor(SkColor color, SkBlendMode mode) {
+  AccumulateComplexity(weights_.draw_paint);
+}
+
+void ComplexityCalculatorHelper::drawPaint() {
+  AccumulateImage(weights_.draw_paint, true);
+}
+
+void ComplexityCalculatorHelper::drawLine(const SkPoint& p0,
+                                          const SkPoint& p1) {
+  // Lines are always stroked, regardless of the style attribute.
+  SkPaint::Style style = style_;
+  style_ = SkPaint::Style::kStroke_Style;
+  AccumulateGeometry(weights_.draw_line);
+  style_ = style;
+}
+
+void ComplexityCalculatorHelper::drawRect(const SkRect& rect) {
+  AccumulateGeometry(weights_.draw_rect);
+}
+
+void ComplexityCalculatorHelper::drawOval(const SkRect& bounds) {
+  AccumulateGeometry(weights_.draw_oval);
+}
+
+void ComplexityCalculatorHelper::drawCircle(const SkPoint& center,
+                                            SkScalar radius) {
+  AccumulateGeometry(weights_.draw_oval);
+}
+
+void ComplexityCalculatorHelper::drawRRect(const SkRRect& rrect) {
+  if (rrect.isRect()) {
+    AccumulateGeometry(weights_.draw_rect);
+  } else if (rrect.isOval()) {
+    AccumulateGeometry(weights_.draw_oval);
+  } else {
+    AccumulateGeometry(weights_.draw_rrect);
+  }
+}
+
+void ComplexityCalculatorHelper::drawDRRect(const SkRRect& outer,
+                                            const SkRRect& inner) {
+  AccumulateGeometry(weights_.draw_drrect);
+}
+
+void ComplexityCalculatorHelper::drawPath(const SkPath& path) {
+  if (is_complex_) {
+    return;
+  }
+  AccumulateGeometry(PathComplexity(path));
+}
+
+void ComplexityCalculatorHelper::drawArc(const SkRect& oval_bounds,
+                                         SkScalar start_degrees,
+                                         SkScalar sweep_degrees,
+                                         bool use_center) {
+  AccumulateGeometry(weights_.draw_arc);
+}
+
+void ComplexityCalculatorHelper::drawPoints(SkCanvas::PointMode mode,
+                                            uint32_t count,
+                                            const SkPoint points[]) {
+  // Points are always stroked, regardless of the style attribute.
+  SkPaint::Style style = style_;
+  style_ = SkPaint::Style::kStroke_Style;
+  uint64_t complexity = static_cast<uint64_t>(weights_.point) * count;
+  AccumulateGeometry(complexity);
+  style_ = style;
+}
+
+void ComplexityCalculatorHelper::drawVertices(const sk_sp<SkVertices> vertices,
+                                              SkBlendMode mode) {
+  // The vertex count is not public, but the size of the vertex data is
+  // dominated by the positions and is a good enough approximation.
+  uint64_t vertex_count = vertices->approximateSize() / sizeof(SkPoint);
+  uint64_t complexity = weights_.draw_path + weights_.vertex * vertex_count;
+  AccumulateImage(complexity, true);
+}
+
+void ComplexityCalculatorHelper::drawImage(const sk_sp<SkImage> image,
+                                           const SkPoint point,
+                                           const SkSamplingOptions& sampling,
+                                           bool render_with_attributes) {
+  AccumulateImage(weights_.draw_image, render_with_attributes);
+}
+
+void ComplexityCalculatorHelper::drawImageRect(
+    const sk_sp<SkImage> image,
+    const SkRect& src,
+    const SkRect& dst,
+    const SkSamplingOptions& sampling,
+    bool render_with_attributes,
+    SkCanvas::SrcRectConstraint constraint) {
+  AccumulateImage(weights_.draw_image, render_with_attributes);
+}
+
+void ComplexityCalculatorHelper::drawImageNine(const sk_sp<SkImage> image,
+                                               const SkIRect& center,
+                                               const SkRect& dst,
+                                               SkFilterMode filter,
+                                               bool render_with_attributes) {
+  AccumulateImage(weights_.draw_image_nine, render_with_attributes);
+}
+
+void ComplexityCalculatorHelper::drawImageLattice(
+    const sk_sp<SkImage> image,
+    const SkCanvas::Lattice& lattice,
+    const SkRect& dst,
+    SkFilterMode filter,
+    bool render_with_attributes) {
+  AccumulateImage(weights_.draw_image_nine, render_with_attributes);
+}
+
+void ComplexityCalculatorHelper::drawAtlas(const sk_sp<SkImage> atlas,
+                                           const SkRSXform xform[],
+                                           const SkRect tex[],
+                                           const SkColor colors[],
+                                           int count,
+                                           SkBlendMode mode,
+                                           const SkSamplingOptions& sampling,
+                                           const SkRect* cull_rect,
+                                           bool render_with_attributes) {
+  uint64_t complexity = weights_.draw_image +
+                        static_cast<uint64_t>(weights_.atlas_sprite) * count;
+  AccumulateImage(complexity, render_with_attributes);
+}
+
+void ComplexityCalculatorHelper::drawPicture(const sk_sp<SkPicture> picture,
+                                             const SkMatrix* matrix,
+                                             bool render_with_attributes) {
+  // The contents of the picture cannot be inspected, so assume that each
+  // of its ops is a simple rect.
+  uint64_t complexity = static_cast<uint64_t>(weights_.draw_rect) *
+                        picture->approximateOpCount(true);
+  if (render_with_attributes) {
+    complexity += weights_.save_layer;
+  }
+  AccumulateImage(complexity, render_with_attributes);
+}
+
+void ComplexityCalculatorHelper::drawDisplayList(
+    const sk_sp<DisplayList> display_list) {
+  if (is_complex_) {
+    return;
+  }
+  // The nested list starts out with the default attributes.
+  ComplexityCalculatorHelper helper(weights_, ceiling_ - complexity_score_);
+  display_list->Dispatch(helper);
+  AccumulateComplexity(helper.ComplexityScore());
+}
+
+void ComplexityCalculatorHelper::drawTextBlob(const sk_sp<SkTextBlob> blob,
+                                              SkScalar x,
+                                              SkScalar y) {
+  if (is_complex_) {
+    return;
+  }
+  uint64_t glyph_count = 0;
+  SkTextBlob::Iter iter(*blob);
+  SkTextBlob::Iter::Run run;
+  while (iter.next(&run)) {
+    glyph_count += run.fGlyphCount;
+  }
+  uint64_t complexity = weights_.draw_text_blob + weights_.glyph * glyph_count;
+  AccumulateImage(complexity, true);
+}
+
+void ComplexityCalculatorHelper::drawShadow(const SkPath& path,
+                                            const SkColor color,
+                                            const SkScalar elevation,
+                                            bool transparent_occluder,
+                                            SkScalar dpr) {
+  if (is_complex_) {
+    return;
+  }
+  // A shadow is a blurred rendering of the path, and a transparent
+  // occluder requires the shadow to be rendered underneath it as well.
+  uint64_t complexity =
+      static_cast<uint64_t>(weights_.draw_shadow) + PathComplexity(path);
+  if (transparent_occluder) {
+    complexity += weights_.draw_shadow / 2;
+  }
+  AccumulateComplexity(complexity);
+}
+
+}  // namespace flutter
@@ -0,0 +1,212 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_DISPLAY_LIST_COMPLEXITY_HELPER_H_
+#define FLUTTER_FLOW_DISPLAY_LIST_COMPLEXITY_HELPER_H_
+
+#include "flutter/display_list/display_list_complexity.h"
+#include "flutter/display_list/display_list_dispatcher.h"
+#include "flutter/display_list/display_list_utils.h"
+
+namespace flutter {
+
+// The relative costs of the rendering ops on a particular backend.
+//
+// The unit is the cost of a single non-antialiased filled drawRect which
+// is given the nominal weight of 100. The values for each backend should
+// track the relative per-op timings reported by display_list_benchmarks.
+// Each benchmark also reports the "ComplexityScore" that the calculator
+// for its backend assigns to the benchmarked DisplayList, so the weights
+// are well calibrated when the time per unit of score is roughly the same
+// across all of the benchmarks for a backend.
+struct ComplexityWeights {
+  // The base cost of each rendering op when filled without antialiasing.
+  unsigned int draw_paint;
+  unsigned int draw_line;
+  unsigned int draw_rect;
+  unsigned int draw_oval;
+  unsigned int draw_rrect;
+  unsigned int draw_drrect;
+  unsigned int draw_arc;
+  unsigned int draw_path;
+  unsigned int draw_image;
+  unsigned int draw_image_nine;
+  unsigned int draw_text_blob;
+  unsigned int draw_shadow;
+
+  // The additional cost of each element of a multi-element op.
+  unsigned int path_line_verb;
+  unsigned int path_quad_verb;
+  unsigned int path_conic_verb;
+  unsigned int path_cubic_verb;
+  unsigned int point;
+  unsigned int vertex;
+  unsigned int atlas_sprite;
+  unsigned int glyph;
+
+  // The cost of creating and compositing an offscreen layer.
+  unsigned int save_layer;
+
+  // The additional costs of the attributes that cause an op to be
+  // rendered indirectly.
+  unsigned int image_filter;
+  unsigned int mask_filter;
+  unsigned int path_effect;
+
+  // Multipliers, expressed as a percentage, applied to the base cost of
+  // a geometric op based on the current stroke and antialias attributes.
+  unsigned int anti_alias_percent;
+  unsigned int hairline_percent;
+  unsigned int stroke_percent;
+  // Applied once for every unit of stroke width above 1, up to 64.
+  unsigned int stroke_width_percent;
+
+  // The score above which a DisplayList is worth caching.
+  unsigned int cache_threshold;
+};
+
+// A Dispatcher that accumulates the cost of each rendering op in a
+// DisplayList according to a table of |ComplexityWeights|.
+//
+// Transforms and clips are assumed to be free as their cost is dominated
+// by that of the rendering ops that they apply to. The score saturates at
+// |ceiling| so that an extremely complex list is never mistaken for a
+// trivial one due to overflow.
+class ComplexityCalculatorHelper final
+    : public virtual Dispatcher,
+      public virtual IgnoreClipDispatchHelper,
+      public virtual IgnoreTransformDispatchHelper {
+ public:
+  ComplexityCalculatorHelper(const ComplexityWeights& weights,
+                             unsigned int ceiling)
+      : weights_(weights), ceiling_(ceiling) {}
+
+  static unsigned int Compute(const ComplexityWeights& weights,
+                              DisplayList* display_list);
+
+  void setDither(bool dither) override {}
+  void setInvertColors(bool invert) override {}
+  void setStrokeCap(SkPaint::Cap cap) override {}
+  void setStrokeJoin(SkPaint::Join join) override {}
+  void setStrokeMiter(SkScalar limit) override {}
+  void setColor(SkColor color) override {}
+  void setBlendMode(SkBlendMode mode) override {}
+  void setBlender(sk_sp<SkBlender> blender) override {}
+  void setShader(sk_sp<SkShader> shader) override {}
+  void setColorFilter(sk_sp<SkColorFilter> filter) override {}
+
+  void setAntiAlias(bool aa) override { anti_alias_ = aa; }
+  void setStyle(SkPaint::Style style) override { style_ = style; }
+  void setStrokeWidth(SkScalar width) override { stroke_width_ = width; }
+  void setPathEffect(sk_sp<SkPathEffect> effect) override {
+    has_path_effect_ = effect != nullptr;
+  }
+  void setMaskFilter(sk_sp<SkMaskFilter> filter) override {
+    has_mask_filter_ = filter != nullptr;
+  }
+  void setMaskBlurFilter(SkBlurStyle style, SkScalar sigma) override {
+    has_mask_filter_ = true;
+  }
+  void setImageFilter(sk_sp<SkImageFilter> filter) override {
+    has_image_filter_ = filter != nullptr;
+  }
+
+  void save() override {}
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options) override;
+  void restore() override {}
+
+  void drawColor(SkColor color, SkBlendMode mode) override;
+  void drawPaint() override;
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override;
+  void drawRect(const SkRect& rect) override;
+  void drawOval(const SkRect& bounds) override;
+  void drawCircle(const SkPoint& center, SkScalar radius) override;
+  void drawRRect(const SkRRect& rrect) override;
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override;
+  void drawPath(const SkPath& path) override;
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override;
+  void drawPoints(SkCanvas::PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override;
+  void drawVertices(const sk_sp<SkVertices> vertices,
+                    SkBlendMode mode) override;
+  void drawImage(const sk_sp<SkImage> image,
+                 const SkPoint point,
+                 const SkSamplingOptions& sampling,
+                 bool render_with_attributes) override;
+  void drawImageRect(const sk_sp<SkImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     const SkSamplingOptions& sampling,
+                     bool render_with_attributes,
+                     SkCanvas::SrcRectConstraint constraint) override;
+  void drawImageNine(const sk_sp<SkImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     SkFilterMode filter,
+                     bool render_with_attributes) override;
+  void drawImageLattice(const sk_sp<SkImage> image,
+                        const SkCanvas::Lattice& lattice,
+                        const SkRect& dst,
+                        SkFilterMode filter,
+                        bool render_with_attributes) override;
+  void drawAtlas(const sk_sp<SkImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const SkColor colors[],
+                 int count,
+                 SkBlendMode mode,
+                 const SkSamplingOptions& sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override;
+  void drawPicture(const sk_sp<SkPicture> picture,
+                   const SkMatrix* matrix,
+                   bool render_with_attributes) override;
+  void drawDisplayList(const sk_sp<DisplayList> display_list) override;
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override;
+  void drawShadow(const SkPath& path,
+                  const SkColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override;
+
+  unsigned int ComplexityScore() const {
+    return is_complex_ ? ceiling_ : complexity_score_;
+  }
+
+ private:
+  const ComplexityWeights& weights_;
+  const unsigned int ceiling_;
+  bool is_complex_ = false;
+  unsigned int complexity_score_ = 0;
+
+  bool anti_alias_ = false;
+  SkPaint::Style style_ = SkPaint::Style::kFill_Style;
+  SkScalar stroke_width_ = 0.0f;
+  bool has_path_effect_ = false;
+  bool has_mask_filter_ = false;
+  bool has_image_filter_ = false;
+
+  void AccumulateComplexity(uint64_t complexity);
+
+  // Accumulates the cost of a geometric op, scaling |base| by the stroke
+  // and antialias attributes and adding the cost of any filters.
+  void AccumulateGeometry(uint64_t base);
+
+  // Accumulates the cost of an op that only honors the attributes which
+  // apply to images, or none at all.
+  void AccumulateImage(uint64_t base, bool render_with_attributes);
+
+  uint64_t PathComplexity(const SkPath& path) const;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_DISPLAY_LIST_COMPLEXITY_HELPER_H_
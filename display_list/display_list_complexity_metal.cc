@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list_complexity_metal.h"
+
+namespace flutter {
+
+// Skia's Metal backend shares the analytic shape shaders of the OpenGL
+// backend, but its stencil and tessellation paths for complex paths are
+// faster. Ending and beginning a render pass for an offscreen layer is
+// more expensive than the equivalent framebuffer switch on OpenGL, and
+// blurs are relatively cheaper thanks to its compute friendly shaders.
+const ComplexityWeights DisplayListMetalComplexityCalculator::kWeights = {
+    150,   // draw_paint
+    100,   // draw_line
+    100,   // draw_rect
+    160,   // draw_oval
+    150,   // draw_rrect
+    300,   // draw_drrect
+    250,   // draw_arc
+    200,   // draw_path
+    200,   // draw_image
+    700,   // draw_image_nine
+    150,   // draw_text_blob
+    2000,  // draw_shadow
+
+    12,  // path_line_verb
+    25,  // path_quad_verb
+    30,  // path_conic_verb
+    35,  // path_cubic_verb
+    6,   // point
+    2,   // vertex
+    30,  // atlas_sprite
+    12,  // glyph
+
+    1600,  // save_layer
+
+    2500,  // image_filter
+    1200,  // mask_filter
+    400,   // path_effect
+
+    130,  // anti_alias_percent
+    80,   // hairline_percent
+    130,  // stroke_percent
+    2,    // stroke_width_percent
+
+    1000,  // cache_threshold
+};
+
+DisplayListMetalComplexityCalculator*
+    DisplayListMetalComplexityCalculator::instance_ = nullptr;
+
+DisplayListComplexityCalculator*
+DisplayListMetalComplexityCalculator::GetInstance() {
+  if (instance_ == nullptr) {
+    instance_ = new DisplayListMetalComplexityCalculator();
+  }
+  return instance_;
+}
+
+unsigned int DisplayListMetalComplexityCalculator::compute(
+    DisplayList* display_list) {
+  return ComplexityCalculatorHelper::Compute(kWeights, display_list);
+}
+
+bool DisplayListMetalComplexityCalculator::should_be_cached(
+    unsigned int complexity_score) {
+  return complexity_score > kWeights.cache_threshold;
+}
+
+}  // namespace flutter
@@ -0,0 +1,31 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_DISPLAY_LIST_COMPLEXITY_METAL_H_
+#define FLUTTER_FLOW_DISPLAY_LIST_COMPLEXITY_METAL_H_
+
+#include "flutter/display_list/display_list_complexity_helper.h"
+
+namespace flutter {
+
+class DisplayListMetalComplexityCalculator
+    : public DisplayListComplexityCalculator {
+ public:
+  static DisplayListComplexityCalculator* GetInstance();
+
+  unsigned int compute(DisplayList* display_list) override;
+
+  bool should_be_cached(unsigned int complexity_score) override;
+
+  // The weights used by this calculator, as measured on Metal.
+  static const ComplexityWeights kWeights;
+
+ private:
+  DisplayListMetalComplexityCalculator() {}
+  static DisplayListMetalComplexityCalculator* instance_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_DISPLAY_LIST_COMPLEXITY_METAL_H_
@@ -0,0 +1,155 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/display_list/display_list_complexity.h"
+#include "flutter/display_list/display_list_complexity_gl.h"
+#include "flutter/display_list/display_list_complexity_metal.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/effects/SkImageFilters.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+std::vector<DisplayListComplexityCalculator*> BackendCalculators() {
+  return {DisplayListGLComplexityCalculator::GetInstance(),
+          DisplayListMetalComplexityCalculator::GetInstance()};
+}
+
+SkPath GetTestPath(int verb_count) {
+  SkPath path;
+  path.moveTo(0, 0);
+  for (int i = 0; i < verb_count; i++) {
+    path.cubicTo(i, 0, i + 1, 10, i + 2, 5);
+  }
+  return path;
+}
+
+}  // namespace
+
+TEST(DisplayListComplexity, GetForBackend) {
+  ASSERT_EQ(
+      DisplayListComplexityCalculator::GetForBackend(GrBackendApi::kOpenGL),
+      DisplayListGLComplexityCalculator::GetInstance());
+  ASSERT_EQ(
+      DisplayListComplexityCalculator::GetForBackend(GrBackendApi::kMetal),
+      DisplayListMetalComplexityCalculator::GetInstance());
+  ASSERT_EQ(DisplayListComplexityCalculator::GetForSoftware(),
+            DisplayListNaiveComplexityCalculator::GetInstance());
+}
+
+TEST(DisplayListComplexity, EmptyDisplayList) {
+  DisplayListBuilder builder;
+  auto display_list = builder.Build();
+  for (auto calculator : BackendCalculators()) {
+    ASSERT_EQ(calculator->compute(display_list.get()), 0u);
+    ASSERT_FALSE(calculator->should_be_cached(0u));
+  }
+}
+
+TEST(DisplayListComplexity, SimpleRectIsNotCached) {
+  DisplayListBuilder builder;
+  builder.drawRect(SkRect::MakeWH(100, 100));
+  auto display_list = builder.Build();
+  for (auto calculator : BackendCalculators()) {
+    unsigned int score = calculator->compute(display_list.get());
+    ASSERT_GT(score, 0u);
+    ASSERT_FALSE(calculator->should_be_cached(score));
+  }
+}
+
+TEST(DisplayListComplexity, BlurredSaveLayerIsCached) {
+  DisplayListBuilder builder;
+  builder.setImageFilter(
+      SkImageFilters::Blur(5.0, 5.0, SkTileMode::kDecal, nullptr, nullptr));
+  builder.saveLayer(nullptr, true);
+  builder.setImageFilter(nullptr);
+  builder.drawRect(SkRect::MakeWH(100, 100));
+  builder.restore();
+  auto blurred = builder.Build();
+
+  DisplayListBuilder plain_builder;
+  plain_builder.saveLayer(nullptr, false);
+  plain_builder.drawRect(SkRect::MakeWH(100, 100));
+  plain_builder.restore();
+  auto plain = plain_builder.Build();
+
+  for (auto calculator : BackendCalculators()) {
+    unsigned int blurred_score = calculator->compute(blurred.get());
+    ASSERT_GT(blurred_score, calculator->compute(plain.get()));
+    ASSERT_TRUE(calculator->should_be_cached(blurred_score));
+  }
+}
+
+TEST(DisplayListComplexity, AntiAliasingAndStrokesAddComplexity) {
+  auto build_oval = [](bool aa, SkPaint::Style style, SkScalar width) {
+    DisplayListBuilder builder;
+    builder.setAntiAlias(aa);
+    builder.setStyle(style);
+    builder.setStrokeWidth(width);
+    builder.drawOval(SkRect::MakeWH(100, 100));
+    return builder.Build();
+  };
+  auto fill = build_oval(false, SkPaint::Style::kFill_Style, 0.0f);
+  auto aa_fill = build_oval(true, SkPaint::Style::kFill_Style, 0.0f);
+  auto aa_stroke = build_oval(true, SkPaint::Style::kStroke_Style, 1.0f);
+  auto aa_wide_stroke = build_oval(true, SkPaint::Style::kStroke_Style, 20.0f);
+
+  for (auto calculator : BackendCalculators()) {
+    unsigned int fill_score = calculator->compute(fill.get());
+    unsigned int aa_fill_score = calculator->compute(aa_fill.get());
+    unsigned int aa_stroke_score = calculator->compute(aa_stroke.get());
+    unsigned int aa_wide_stroke_score =
+        calculator->compute(aa_wide_stroke.get());
+    ASSERT_GT(aa_fill_score, fill_score);
+    ASSERT_GT(aa_stroke_score, aa_fill_score);
+    ASSERT_GT(aa_wide_stroke_score, aa_stroke_score);
+  }
+}
+
+TEST(DisplayListComplexity, PathComplexityScalesWithVerbs) {
+  DisplayListBuilder simple_builder;
+  simple_builder.drawPath(GetTestPath(10));
+  auto simple = simple_builder.Build();
+
+  DisplayListBuilder complex_builder;
+  complex_builder.drawPath(GetTestPath(100));
+  auto complex = complex_builder.Build();
+
+  for (auto calculator : BackendCalculators()) {
+    unsigned int simple_score = calculator->compute(simple.get());
+    unsigned int complex_score = calculator->compute(complex.get());
+    ASSERT_GT(complex_score, simple_score);
+    ASSERT_FALSE(calculator->should_be_cached(simple_score));
+    ASSERT_TRUE(calculator->should_be_cached(complex_score));
+  }
+}
+
+TEST(DisplayListComplexity, NestedDisplayListIsIncluded) {
+  DisplayListBuilder nested_builder;
+  nested_builder.setAntiAlias(true);
+  nested_builder.drawPath(GetTestPath(50));
+  auto nested = nested_builder.Build();
+
+  DisplayListBuilder rect_builder;
+  rect_builder.drawRect(SkRect::MakeWH(100, 100));
+  auto rect = rect_builder.Build();
+
+  DisplayListBuilder outer_builder;
+  outer_builder.drawRect(SkRect::MakeWH(100, 100));
+  outer_builder.drawDisplayList(nested);
+  auto outer = outer_builder.Build();
+
+  for (auto calculator : BackendCalculators()) {
+    ASSERT_EQ(calculator->compute(outer.get()),
+              calculator->compute(rect.get()) +
+                  calculator->compute(nested.get()));
+  }
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -34,6 +34,66 @@ enum class DisplayListCompare {
   kEqual,
 };
 
+// Accumulates the 64-bit content hash of a DisplayList.
+//
+// The hash must agree with DisplayList::Equals(), so most Ops are simply
+// hashed as raw bytes the same way that they are bulk compared. An Op
+// that overrides DLOp::equals() to do a deep compare must also override
+// DLOp::hash() to mix in only the values which that deep compare examines.
+class DisplayListHasher {
+ public:
+  void mix(uint32_t value) { hash_ = (hash_ ^ value) * kPrime; }
+
+  void mix(SkScalar value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    mix(bits);
+  }
+
+  // All Op records are padded to a multiple of 4 bytes and their unused
+  // bytes are zeroed by the DisplayListBuilder.
+  void mix_bytes(const void* data, size_t bytes) {
+    FML_DCHECK((bytes & 3) == 0);
+    const uint8_t* ptr = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < bytes; i += 4) {
+      uint32_t word;
+      memcpy(&word, ptr + i, sizeof(word));
+      mix(word);
+    }
+  }
+
+  // Mixes in the values that SkPath::operator== compares, other than the
+  // conic weights which only matter when the points and verbs also match.
+  void mix(const SkPath& path) {
+    mix(static_cast<uint32_t>(path.getFillType()));
+    mix(static_cast<uint32_t>(path.countVerbs()));
+    int count = path.countPoints();
+    mix(static_cast<uint32_t>(count));
+    for (int i = 0; i < count; i++) {
+      SkPoint point = path.getPoint(i);
+      mix(point.fX);
+      mix(point.fY);
+    }
+  }
+
+  // Returns the hash with a final avalanche step so that every bit of
+  // the result depends on every bit that was mixed in.
+  uint64_t finish() const {
+    uint64_t hash = hash_;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+  }
+
+ private:
+  static constexpr uint64_t kPrime = 0x100000001b3ULL;
+
+  uint64_t hash_ = 0xcbf29ce484222325ULL;
+};
+
 // "DLOpPackLabel" is just a label for the pack pragma so it can be popped
 // later.
 #pragma pack(push, DLOpPackLabel, 8)
@@ -55,6 +115,10 @@ struct DLOp {
   DisplayListCompare equals(const DLOp* other) const {
     return DisplayListCompare::kUseBulkCompare;
   }
+
+  // Returns false if the Op should be hashed as raw bytes, which is
+  // correct for any Op that uses the bulk compare.
+  bool hash(DisplayListHasher& hasher) const { return false; }
 };
 
 // 4 byte header + 4 byte payload packs into minimum 8 bytes
@@ -389,6 +453,12 @@ DEFINE_CLIP_SHAPE_OP(RRect, Difference)
       return is_aa == other->is_aa && path == other->path                \
                  ? DisplayListCompare::kEqual                            \
                  : DisplayListCompare::kNotEqual;                        \
+    }                                                                    \
+                                                                         \
+    bool hash(DisplayListHasher& hasher) const {                         \
+      hasher.mix(static_cast<uint32_t>(is_aa));                          \
+      hasher.mix(path);                                                  \
+      return true;                                                       \
     }                                                                    \
   };
 DEFINE_CLIP_PATH_OP(Intersect)
@@ -455,6 +525,11 @@ struct DrawPathOp final : DLOp {
     return path == other->path ? DisplayListCompare::kEqual
                                : DisplayListCompare::kNotEqual;
   }
+
+  bool hash(DisplayListHasher& hasher) const {
+    hasher.mix(path);
+    return true;
+  }
 };
 
 // The common data is a 4 byte header with an unused 4 bytes
@@ -0,0 +1,117 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list_prewarmer.h"
+
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkShader.h"
+
+namespace flutter {
+
+void DisplayListPrewarmer::Prewarm(const DisplayList* display_list) {
+  if (display_list == nullptr) {
+    return;
+  }
+  DisplayListPrewarmer prewarmer;
+  prewarmer.display_list_ids_.insert(display_list->unique_id());
+  display_list->Dispatch(prewarmer);
+}
+
+void DisplayListPrewarmer::PrewarmPath(const SkPath& path) {
+  // The convexity is cached in the path (atomically) once computed.
+  path.isConvex();
+}
+
+void DisplayListPrewarmer::PrewarmImage(const SkImage* image) {
+  if (image == nullptr || !image->isLazyGenerated()) {
+    return;
+  }
+  if (!image_ids_.insert(image->uniqueID()).second) {
+    return;
+  }
+  // Reading any pixel of a lazy image decodes the entire image into the
+  // resource cache, which is where the GPU backends look for the pixels
+  // to upload when the image is first drawn.
+  SkImageInfo info = SkImageInfo::MakeN32Premul(1, 1);
+  uint32_t pixel;
+  image->readPixels(nullptr, info, &pixel, sizeof(pixel), 0, 0);
+}
+
+void DisplayListPrewarmer::setShader(sk_sp<SkShader> shader) {
+  if (shader) {
+    PrewarmImage(shader->isAImage(nullptr, nullptr));
+  }
+}
+
+void DisplayListPrewarmer::clipPath(const SkPath& path,
+                                    SkClipOp clip_op,
+                                    bool is_aa) {
+  PrewarmPath(path);
+}
+
+void DisplayListPrewarmer::drawPath(const SkPath& path) {
+  PrewarmPath(path);
+}
+
+void DisplayListPrewarmer::drawImage(const sk_sp<SkImage> image,
+                                     const SkPoint point,
+                                     const SkSamplingOptions& sampling,
+                                     bool render_with_attributes) {
+  PrewarmImage(image.get());
+}
+
+void DisplayListPrewarmer::drawImageRect(
+    const sk_sp<SkImage> image,
+    const SkRect& src,
+    const SkRect& dst,
+    const SkSamplingOptions& sampling,
+    bool render_with_attributes,
+    SkCanvas::SrcRectConstraint constraint) {
+  PrewarmImage(image.get());
+}
+
+void DisplayListPrewarmer::drawImageNine(const sk_sp<SkImage> image,
+                                         const SkIRect& center,
+                                         const SkRect& dst,
+                                         SkFilterMode filter,
+                                         bool render_with_attributes) {
+  PrewarmImage(image.get());
+}
+
+void DisplayListPrewarmer::drawImageLattice(const sk_sp<SkImage> image,
+                                            const SkCanvas::Lattice& lattice,
+                                            const SkRect& dst,
+                                            SkFilterMode filter,
+                                            bool render_with_attributes) {
+  PrewarmImage(image.get());
+}
+
+void DisplayListPrewarmer::drawAtlas(const sk_sp<SkImage> atlas,
+                                     const SkRSXform xform[],
+                                     const SkRect tex[],
+                                     const SkColor colors[],
+                                     int count,
+                                     SkBlendMode mode,
+                                     const SkSamplingOptions& sampling,
+                                     const SkRect* cull_rect,
+                                     bool render_with_attributes) {
+  PrewarmImage(atlas.get());
+}
+
+void DisplayListPrewarmer::drawDisplayList(
+    const sk_sp<DisplayList> display_list) {
+  if (display_list_ids_.insert(display_list->unique_id()).second) {
+    display_list->Dispatch(*this);
+  }
+}
+
+void DisplayListPrewarmer::drawShadow(const SkPath& path,
+                                      const SkColor color,
+                                      const SkScalar elevation,
+                                      bool transparent_occluder,
+                                      SkScalar dpr) {
+  PrewarmPath(path);
+}
+
+}  // namespace flutter
@@ -0,0 +1,98 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_PREWARMER_H_
+#define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_PREWARMER_H_
+
+#include <unordered_set>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/display_list_dispatcher.h"
+#include "flutter/display_list/display_list_utils.h"
+
+namespace flutter {
+
+// A Dispatcher that performs the parts of the preparation for rendering
+// a DisplayList which do not need the GPU context of the raster thread,
+// so that they can be moved onto a worker thread. It walks the list, and
+// any lists nested inside of it, and:
+//
+//   - computes and caches the convexity of every path, which Skia's GPU
+//     backends inspect to choose between drawing a path directly and
+//     tessellating it or rendering it through the stencil buffer.
+//   - decodes any lazily generated images, including those used by image
+//     shaders, into Skia's resource cache from which the raster thread
+//     will upload them.
+//
+// Glyph rasterization into the text atlases and texture uploads both
+// require the GrDirectContext and are left to the raster thread.
+//
+// The lists are only read, so it is safe to prewarm a list while it is
+// being rendered on another thread.
+class DisplayListPrewarmer final
+    : public virtual Dispatcher,
+      public virtual IgnoreAttributeDispatchHelper,
+      public virtual IgnoreTransformDispatchHelper,
+      public virtual IgnoreDrawDispatchHelper {
+ public:
+  static void Prewarm(const DisplayList* display_list);
+
+  void setShader(sk_sp<SkShader> shader) override;
+
+  void clipRect(const SkRect& rect, SkClipOp clip_op, bool is_aa) override {}
+  void clipRRect(const SkRRect& rrect, SkClipOp clip_op, bool is_aa) override {}
+  void clipPath(const SkPath& path, SkClipOp clip_op, bool is_aa) override;
+
+  void drawPath(const SkPath& path) override;
+  void drawImage(const sk_sp<SkImage> image,
+                 const SkPoint point,
+                 const SkSamplingOptions& sampling,
+                 bool render_with_attributes) override;
+  void drawImageRect(const sk_sp<SkImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     const SkSamplingOptions& sampling,
+                     bool render_with_attributes,
+                     SkCanvas::SrcRectConstraint constraint) override;
+  void drawImageNine(const sk_sp<SkImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     SkFilterMode filter,
+                     bool render_with_attributes) override;
+  void drawImageLattice(const sk_sp<SkImage> image,
+                        const SkCanvas::Lattice& lattice,
+                        const SkRect& dst,
+                        SkFilterMode filter,
+                        bool render_with_attributes) override;
+  void drawAtlas(const sk_sp<SkImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const SkColor colors[],
+                 int count,
+                 SkBlendMode mode,
+                 const SkSamplingOptions& sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override;
+  void drawDisplayList(const sk_sp<DisplayList> display_list) override;
+  void drawShadow(const SkPath& path,
+                  const SkColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override;
+
+ private:
+  DisplayListPrewarmer() = default;
+
+  // The ids of the images and nested lists that have been prewarmed so
+  // that those which are used many times are only visited once.
+  std::unordered_set<uint32_t> image_ids_;
+  std::unordered_set<uint32_t> display_list_ids_;
+
+  void PrewarmPath(const SkPath& path);
+  void PrewarmImage(const SkImage* image);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DISPLAY_LIST_PREWARMER_H_
@@ -5,9 +5,11 @@
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/display_list_builder.h"
 #include "flutter/display_list/display_list_canvas_recorder.h"
+#include "flutter/display_list/display_list_prewarmer.h"
 #include "flutter/display_list/display_list_utils.h"
 #include "flutter/fml/math.h"
 #include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkImageGenerator.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/effects/SkBlenders.h"
@@ -877,11 +879,13 @@ TEST(DisplayList, SingleOpDisplayListsCompareToEachOther) {
           ASSERT_EQ(listA->op_count(true), listB->op_count(true)) << desc;
           ASSERT_EQ(listA->bytes(true), listB->bytes(true)) << desc;
           ASSERT_EQ(listA->bounds(), listB->bounds()) << desc;
+          ASSERT_EQ(listA->content_hash(), listB->content_hash()) << desc;
           ASSERT_TRUE(listA->Equals(*listB)) << desc;
           ASSERT_TRUE(listB->Equals(*listA)) << desc;
         } else {
           // No assertion on op/byte counts or bounds
           // they may or may not be equal between variants
+          ASSERT_NE(listA->content_hash(), listB->content_hash()) << desc;
           ASSERT_FALSE(listA->Equals(*listB)) << desc;
           ASSERT_FALSE(listB->Equals(*listA)) << desc;
         }
@@ -890,6 +894,340 @@ TEST(DisplayList, SingleOpDisplayListsCompareToEachOther) {
   }
 }
 
+TEST(DisplayList, ContentHashMatchesDeepComparedPaths) {
+  // Two separately constructed but equal paths do not share a path ref,
+  // so their op records are not bytewise equal.
+  SkPath path1 = SkPath::Polygon({{0, 0}, {10, 10}, {10, 0}}, true);
+  SkPath path2 = SkPath::Polygon({{0, 0}, {10, 10}, {10, 0}}, true);
+  auto build = [](const SkPath& path) {
+    DisplayListBuilder builder;
+    builder.clipPath(path, SkClipOp::kIntersect, true);
+    builder.drawPath(path);
+    builder.drawRect({0, 0, 10, 10});
+    return builder.Build();
+  };
+  sk_sp<DisplayList> dl1 = build(path1);
+  sk_sp<DisplayList> dl2 = build(path2);
+  ASSERT_NE(dl1->unique_id(), dl2->unique_id());
+  ASSERT_EQ(dl1->content_hash(), dl2->content_hash());
+  ASSERT_TRUE(dl1->Equals(*dl2));
+
+  SkPath path3 = SkPath::Polygon({{0, 0}, {10, 10}, {0, 10}}, true);
+  sk_sp<DisplayList> dl3 = build(path3);
+  ASSERT_NE(dl1->content_hash(), dl3->content_hash());
+  ASSERT_FALSE(dl1->Equals(*dl3));
+}
+
+TEST(DisplayList, SerializedDisplayListKeepsContentHash) {
+  DisplayListBuilder builder;
+  builder.setColor(SK_ColorBLUE);
+  builder.drawRect({10, 10, 20, 20});
+  sk_sp<DisplayList> dl = builder.Build();
+  sk_sp<DisplayList> copy = DisplayList::MakeFromMapping(dl->Serialize());
+  ASSERT_TRUE(copy);
+  ASSERT_EQ(copy->content_hash(), dl->content_hash());
+}
+
+TEST(DisplayList, SingleOpDisplayListsSerializeIfFlat) {
+  for (auto& group : allGroups) {
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      sk_sp<DisplayList> dl = group.variants[i].Build();
+      auto desc = group.op_name + "(variant " + std::to_string(i + 1) + ")";
+      std::shared_ptr<fml::Mapping> data = dl->Serialize();
+      if (!dl->CanSerialize()) {
+        ASSERT_FALSE(data) << desc;
+        continue;
+      }
+      ASSERT_TRUE(data) << desc;
+      sk_sp<DisplayList> copy = DisplayList::MakeFromMapping(data);
+      ASSERT_TRUE(copy) << desc;
+      ASSERT_EQ(copy->op_count(false), dl->op_count(false)) << desc;
+      ASSERT_EQ(copy->bytes(false), dl->bytes(false)) << desc;
+      ASSERT_EQ(copy->op_count(true), dl->op_count(true)) << desc;
+      ASSERT_EQ(copy->bytes(true), dl->bytes(true)) << desc;
+      ASSERT_EQ(copy->bounds(), dl->bounds()) << desc;
+      ASSERT_EQ(copy->can_apply_group_opacity(), dl->can_apply_group_opacity())
+          << desc;
+      ASSERT_TRUE(copy->Equals(*dl)) << desc;
+      ASSERT_TRUE(dl->Equals(*copy)) << desc;
+    }
+  }
+}
+
+TEST(DisplayList, SerializedDisplayListDispatchesInPlace) {
+  DisplayListBuilder builder;
+  builder.setColor(SK_ColorBLUE);
+  builder.drawRect({10, 10, 20, 20});
+  builder.save();
+  builder.translate(5, 5);
+  builder.drawPoints(SkCanvas::kPolygon_PointMode, TestPointCount, TestPoints);
+  builder.restore();
+  sk_sp<DisplayList> dl = builder.Build();
+  ASSERT_TRUE(dl->CanSerialize());
+
+  std::shared_ptr<fml::Mapping> data = dl->Serialize();
+  ASSERT_TRUE(data);
+  sk_sp<DisplayList> copy = DisplayList::MakeFromMapping(data);
+  ASSERT_TRUE(copy);
+  ASSERT_TRUE(copy->Equals(*dl));
+
+  // A list with the same ops re-recorded from the mapped list must match.
+  DisplayListBuilder re_builder;
+  copy->Dispatch(re_builder);
+  ASSERT_TRUE(re_builder.Build()->Equals(*dl));
+
+  // And the mapped list can itself be serialized again.
+  std::shared_ptr<fml::Mapping> data2 = copy->Serialize();
+  ASSERT_TRUE(data2);
+  ASSERT_EQ(data2->GetSize(), data->GetSize());
+  ASSERT_EQ(
+      memcmp(data2->GetMapping(), data->GetMapping(), data->GetSize()), 0);
+}
+
+TEST(DisplayList, NonFlatDisplayListsDoNotSerialize) {
+  DisplayListBuilder builder;
+  builder.drawRect({10, 10, 20, 20});
+  builder.drawPath(TestPath1);
+  sk_sp<DisplayList> dl = builder.Build();
+  ASSERT_FALSE(dl->CanSerialize());
+  ASSERT_FALSE(dl->Serialize());
+}
+
+TEST(DisplayList, MalformedSerializedDisplayListsAreRejected) {
+  DisplayListBuilder builder;
+  builder.drawRect({10, 10, 20, 20});
+  builder.drawCircle({30, 30}, 5);
+  sk_sp<DisplayList> dl = builder.Build();
+  std::unique_ptr<fml::Mapping> data = dl->Serialize();
+  ASSERT_TRUE(data);
+  const uint8_t* bytes = data->GetMapping();
+  size_t size = data->GetSize();
+  ASSERT_TRUE(DisplayList::MakeFromMapping(
+      std::make_shared<fml::DataMapping>(std::vector(bytes, bytes + size))));
+
+  // Truncated stream
+  ASSERT_FALSE(DisplayList::MakeFromMapping(std::make_shared<fml::DataMapping>(
+      std::vector(bytes, bytes + size - 8))));
+
+  // Wrong version
+  std::vector<uint8_t> bad_version(bytes, bytes + size);
+  bad_version[4]++;
+  ASSERT_FALSE(DisplayList::MakeFromMapping(
+      std::make_shared<fml::DataMapping>(std::move(bad_version))));
+
+  // Corrupted op type in the first record that follows the header
+  std::vector<uint8_t> bad_op(bytes, bytes + size);
+  size_t header_size = size - (dl->bytes(false) - sizeof(DisplayList));
+  bad_op[header_size] = 0xff;
+  ASSERT_FALSE(DisplayList::MakeFromMapping(
+      std::make_shared<fml::DataMapping>(std::move(bad_op))));
+}
+
+TEST(DisplayList, CulledDispatchSkipsOnlyInvisibleRenderingOps) {
+  DisplayListBuilder builder(SkRect::MakeLTRB(0, 0, 500, 500), true);
+  builder.setColor(SK_ColorRED);
+  builder.drawRect({0, 0, 10, 10});
+  builder.setColor(SK_ColorBLUE);
+  builder.drawRect({100, 100, 110, 110});
+  builder.save();
+  builder.translate(200, 0);
+  builder.drawRect({0, 0, 10, 10});
+  builder.restore();
+  builder.saveLayer(nullptr, false);
+  builder.setColor(SK_ColorGREEN);
+  builder.drawRect({300, 300, 310, 310});
+  builder.restore();
+  sk_sp<DisplayList> dl = builder.Build();
+  ASSERT_TRUE(dl->has_rtree());
+
+  DisplayListBuilder expected_builder;
+  expected_builder.setColor(SK_ColorRED);
+  expected_builder.setColor(SK_ColorBLUE);
+  expected_builder.drawRect({100, 100, 110, 110});
+  expected_builder.save();
+  expected_builder.translate(200, 0);
+  expected_builder.restore();
+  expected_builder.setColor(SK_ColorGREEN);
+  sk_sp<DisplayList> expected = expected_builder.Build();
+
+  DisplayListBuilder culled_builder;
+  dl->Dispatch(culled_builder, SkRect::MakeLTRB(95, 95, 115, 115));
+  sk_sp<DisplayList> culled = culled_builder.Build();
+  EXPECT_TRUE(culled->Equals(*expected));
+
+  DisplayListBuilder layer_builder;
+  layer_builder.setColor(SK_ColorRED);
+  layer_builder.setColor(SK_ColorBLUE);
+  layer_builder.save();
+  layer_builder.translate(200, 0);
+  layer_builder.restore();
+  layer_builder.saveLayer(nullptr, false);
+  layer_builder.setColor(SK_ColorGREEN);
+  layer_builder.drawRect({300, 300, 310, 310});
+  layer_builder.restore();
+  sk_sp<DisplayList> expected_layer = layer_builder.Build();
+
+  DisplayListBuilder culled_layer_builder;
+  dl->Dispatch(culled_layer_builder, SkRect::MakeLTRB(295, 295, 305, 305));
+  EXPECT_TRUE(culled_layer_builder.Build()->Equals(*expected_layer));
+}
+
+TEST(DisplayList, CulledDispatchOfVisibleListIsComplete) {
+  DisplayListBuilder builder(SkRect::MakeLTRB(0, 0, 500, 500), true);
+  builder.drawRect({0, 0, 10, 10});
+  builder.drawRect({100, 100, 110, 110});
+  sk_sp<DisplayList> dl = builder.Build();
+
+  DisplayListBuilder copy_builder;
+  dl->Dispatch(copy_builder, SkRect::MakeLTRB(0, 0, 500, 500));
+  EXPECT_TRUE(copy_builder.Build()->Equals(*dl));
+}
+
+TEST(DisplayList, CulledDispatchWithoutRTreeIsComplete) {
+  DisplayListBuilder builder;
+  builder.drawRect({0, 0, 10, 10});
+  builder.drawRect({100, 100, 110, 110});
+  sk_sp<DisplayList> dl = builder.Build();
+  ASSERT_FALSE(dl->has_rtree());
+
+  DisplayListBuilder copy_builder;
+  dl->Dispatch(copy_builder, SkRect::MakeLTRB(95, 95, 115, 115));
+  EXPECT_TRUE(copy_builder.Build()->Equals(*dl));
+}
+
+TEST(DisplayList, OptimizedBuilderEliminatesEmptySaves) {
+  DisplayListBuilder builder;
+  builder.set_optimize_state_ops(true);
+  builder.save();
+  builder.translate(10, 10);
+  builder.clipRect({0, 0, 10, 10}, SkClipOp::kIntersect, false);
+  builder.save();
+  builder.scale(2, 2);
+  builder.restore();
+  builder.restore();
+  builder.saveLayer(nullptr, false);
+  builder.restore();
+  sk_sp<DisplayList> dl = builder.Build();
+  EXPECT_EQ(dl->op_count(), 0u);
+  EXPECT_EQ(dl->bytes(false), sizeof(DisplayList));
+  EXPECT_TRUE(dl->Equals(*DisplayListBuilder().Build()));
+}
+
+TEST(DisplayList, OptimizedBuilderKeepsSavesWithContent) {
+  DisplayListBuilder builder;
+  builder.set_optimize_state_ops(true);
+  builder.save();
+  builder.translate(10, 10);
+  builder.drawRect({0, 0, 10, 10});
+  builder.restore();
+  // An attribute set inside an otherwise empty save must survive
+  builder.save();
+  builder.setColor(SK_ColorBLUE);
+  builder.restore();
+  sk_sp<DisplayList> dl = builder.Build();
+
+  DisplayListBuilder expected;
+  expected.save();
+  expected.translate(10, 10);
+  expected.drawRect({0, 0, 10, 10});
+  expected.restore();
+  expected.save();
+  expected.setColor(SK_ColorBLUE);
+  expected.restore();
+  EXPECT_TRUE(dl->Equals(*expected.Build()));
+}
+
+TEST(DisplayList, OptimizedBuilderKeepsEmptyLayersThatModifyTheDestination) {
+  DisplayListBuilder builder;
+  builder.set_optimize_state_ops(true);
+  builder.setBlendMode(SkBlendMode::kClear);
+  builder.saveLayer(nullptr, true);
+  builder.restore();
+  sk_sp<DisplayList> dl = builder.Build();
+  // saveLayer and restore (attribute ops are not counted)
+  EXPECT_EQ(dl->op_count(), 2u);
+}
+
+TEST(DisplayList, OptimizedBuilderEmptyLayerDoesNotAffectGroupOpacity) {
+  DisplayListBuilder builder;
+  builder.set_optimize_state_ops(true);
+  builder.drawRect({0, 0, 10, 10});
+  builder.saveLayer(nullptr, true);
+  builder.restore();
+  sk_sp<DisplayList> dl = builder.Build();
+  EXPECT_EQ(dl->op_count(), 1u);
+  EXPECT_TRUE(dl->can_apply_group_opacity());
+}
+
+TEST(DisplayList, OptimizedBuilderFoldsConsecutiveTransforms) {
+  DisplayListBuilder builder;
+  builder.set_optimize_state_ops(true);
+  builder.translate(10, 10);
+  builder.translate(5, -5);
+  builder.scale(2, 2);
+  builder.scale(3, 0.5);
+  builder.transform2DAffine(2, 0, 10,  //
+                            0, 2, 20);
+  builder.transform2DAffine(0.5, 0, -5,  //
+                            0, 0.5, -10);
+  builder.translate(1, 1);
+  builder.translate(-1, -1);
+  builder.drawRect({0, 0, 10, 10});
+  sk_sp<DisplayList> dl = builder.Build();
+
+  DisplayListBuilder expected;
+  expected.translate(15, 5);
+  expected.scale(6, 1);
+  expected.drawRect({0, 0, 10, 10});
+  EXPECT_TRUE(dl->Equals(*expected.Build()));
+}
+
+class CountingImageGenerator : public SkImageGenerator {
+ public:
+  CountingImageGenerator(int* decode_count)
+      : SkImageGenerator(SkImageInfo::MakeN32Premul(10, 10)),
+        decode_count_(decode_count) {}
+
+ protected:
+  bool onGetPixels(const SkImageInfo& info,
+                   void* pixels,
+                   size_t row_bytes,
+                   const Options& options) override {
+    (*decode_count_)++;
+    for (int y = 0; y < info.height(); y++) {
+      memset(static_cast<uint8_t*>(pixels) + y * row_bytes, 0xff,
+             info.minRowBytes());
+    }
+    return true;
+  }
+
+ private:
+  int* decode_count_;
+};
+
+TEST(DisplayList, PrewarmerDecodesLazyImagesInNestedLists) {
+  int decode_count = 0;
+  sk_sp<SkImage> image = SkImage::MakeFromGenerator(
+      std::make_unique<CountingImageGenerator>(&decode_count));
+  ASSERT_TRUE(image->isLazyGenerated());
+
+  DisplayListBuilder nested_builder;
+  nested_builder.drawImage(image, {0, 0}, DisplayList::NearestSampling, false);
+  nested_builder.drawImage(image, {20, 0}, DisplayList::NearestSampling,
+                           false);
+  DisplayListBuilder builder;
+  builder.drawDisplayList(nested_builder.Build());
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  DisplayListPrewarmer::Prewarm(display_list.get());
+  ASSERT_EQ(decode_count, 1);
+
+  // Rendering the list uses the pixels decoded by the prewarmer.
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(40, 10);
+  display_list->RenderTo(surface->getCanvas());
+  ASSERT_EQ(decode_count, 1);
+}
+
 TEST(DisplayList, FullRotationsAreNop) {
   DisplayListBuilder builder;
   builder.rotate(0);
@@ -1549,6 +1887,66 @@ TEST(DisplayList, OverlappingOpsDoNotSupportGroupOpacity) {
   EXPECT_FALSE(display_list->can_apply_group_opacity());
 }
 
+TEST(DisplayList, NonOverlappingOpsSupportGroupOpacity) {
+  DisplayListBuilder builder;
+  for (int i = 0; i < 10; i++) {
+    builder.drawRect(SkRect::MakeXYWH(i * 40, 0, 30, 30));
+  }
+  auto display_list = builder.Build();
+  EXPECT_TRUE(display_list->can_apply_group_opacity());
+}
+
+TEST(DisplayList, AdjacentOpsDoNotSupportGroupOpacity) {
+  DisplayListBuilder builder;
+  builder.drawRect(SkRect::MakeXYWH(0, 0, 30, 30));
+  builder.drawRect(SkRect::MakeXYWH(30, 0, 30, 30));
+  auto display_list = builder.Build();
+  EXPECT_FALSE(display_list->can_apply_group_opacity());
+}
+
+TEST(DisplayList, NonOverlappingTransformedOpsSupportGroupOpacity) {
+  DisplayListBuilder builder;
+  for (int i = 0; i < 10; i++) {
+    builder.save();
+    builder.translate(i * 40, 0);
+    builder.drawRect(SkRect::MakeWH(30, 30));
+    builder.restore();
+  }
+  auto display_list = builder.Build();
+  EXPECT_TRUE(display_list->can_apply_group_opacity());
+}
+
+TEST(DisplayList, NonOverlappingNestedDisplayListsSupportGroupOpacity) {
+  DisplayListBuilder nested_builder;
+  nested_builder.drawRect(SkRect::MakeWH(30, 30));
+  nested_builder.drawOval(SkRect::MakeXYWH(40, 0, 30, 30));
+  auto nested = nested_builder.Build();
+  EXPECT_TRUE(nested->can_apply_group_opacity());
+
+  DisplayListBuilder builder;
+  builder.drawDisplayList(nested);
+  builder.translate(0, 40);
+  builder.drawDisplayList(nested);
+  auto display_list = builder.Build();
+  EXPECT_TRUE(display_list->can_apply_group_opacity());
+
+  DisplayListBuilder overlapping_builder;
+  overlapping_builder.drawDisplayList(nested);
+  overlapping_builder.translate(20, 20);
+  overlapping_builder.drawDisplayList(nested);
+  auto overlapping = overlapping_builder.Build();
+  EXPECT_FALSE(overlapping->can_apply_group_opacity());
+}
+
+TEST(DisplayList, TooManyNonOverlappingOpsDoNotSupportGroupOpacity) {
+  DisplayListBuilder builder;
+  for (int i = 0; i < 100; i++) {
+    builder.drawRect(SkRect::MakeXYWH(i * 40, 0, 30, 30));
+  }
+  auto display_list = builder.Build();
+  EXPECT_FALSE(display_list->can_apply_group_opacity());
+}
+
 TEST(DisplayList, SaveLayerFalseSupportsGroupOpacityWithOverlappingChidren) {
   DisplayListBuilder builder;
   builder.saveLayer(nullptr, false);
@@ -1692,6 +2090,44 @@ TEST(DisplayList, SaveLayerTwoOverlappingOpsPreventsOpacityOptimization) {
   EXPECT_EQ(expector.save_layer_count(), 1);
 }
 
+TEST(DisplayList, SaveLayerTwoNonOverlappingOpsSupportsOpacityOptimization) {
+  SaveLayerOptions expected =
+      SaveLayerOptions::kWithAttributes.with_can_distribute_opacity();
+  SaveLayerOptionsExpector expector(expected);
+
+  DisplayListBuilder builder;
+  builder.setColor(SkColorSetARGB(127, 255, 255, 255));
+  builder.saveLayer(nullptr, true);
+  builder.drawRect({10, 10, 20, 20});
+  builder.drawRect({25, 25, 35, 35});
+  builder.restore();
+
+  auto display_list = builder.Build();
+  display_list->Dispatch(expector);
+  EXPECT_EQ(expector.save_layer_count(), 1);
+  EXPECT_TRUE(display_list->can_apply_group_opacity());
+}
+
+TEST(DisplayList, NonOverlappingSaveLayerContentHashIncludesOptions) {
+  DisplayListBuilder builder;
+  builder.saveLayer(nullptr, false);
+  builder.drawRect({10, 10, 20, 20});
+  builder.drawRect({25, 25, 35, 35});
+  builder.restore();
+  builder.drawRect({50, 50, 60, 60});
+  auto display_list = builder.Build();
+  EXPECT_TRUE(display_list->can_apply_group_opacity());
+
+  // The loaded copy hashes the final bytes of the records, including the
+  // options set on the saveLayer after it was recorded.
+  std::shared_ptr<fml::Mapping> serialized = display_list->Serialize();
+  ASSERT_NE(serialized, nullptr);
+  auto copy = DisplayList::MakeFromMapping(serialized);
+  ASSERT_NE(copy, nullptr);
+  EXPECT_EQ(copy->content_hash(), display_list->content_hash());
+  EXPECT_TRUE(copy->Equals(*display_list));
+}
+
 TEST(DisplayList, NestedSaveLayersMightSupportOpacityOptimization) {
   SaveLayerOptions expected1 =
       SaveLayerOptions::kWithAttributes.with_can_distribute_opacity();
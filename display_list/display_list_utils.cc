@@ -367,6 +367,7 @@ void DisplayListBoundsCalculator::restore() {
     // through any transforms or clips to accuulate them into this
     // layer.
     accumulator_->accumulate(layer_bounds);
+    op_accumulator_.accumulate(layer_bounds);
     if (is_unbounded) {
       AccumulateUnbounded();
     }
@@ -623,8 +624,10 @@ bool DisplayListBoundsCalculator::AdjustBoundsForPaint(
 void DisplayListBoundsCalculator::AccumulateUnbounded() {
   if (has_clip()) {
     accumulator_->accumulate(clip_bounds());
+    op_accumulator_.accumulate(clip_bounds());
   } else {
     layer_infos_.back()->set_unbounded();
+    op_is_unbounded_ = true;
   }
 }
 void DisplayListBoundsCalculator::AccumulateOpBounds(
@@ -640,6 +643,7 @@ void DisplayListBoundsCalculator::AccumulateBounds(SkRect& bounds) {
   matrix().mapRect(&bounds);
   if (!has_clip() || bounds.intersect(clip_bounds())) {
     accumulator_->accumulate(bounds);
+    op_accumulator_.accumulate(bounds);
   }
 }
 
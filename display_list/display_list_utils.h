@@ -491,10 +491,31 @@ class DisplayListBoundsCalculator final
     return accumulator_->bounds();
   }
 
+  // Support for computing the bounds of individual ops, such as when
+  // building a spatial index of a DisplayList.
+  //
+  // Every bounds accumulated into any layer is also accumulated into a
+  // separate "op" accumulator which can be reset before dispatching an
+  // op and then queried afterwards to determine how much area, in the
+  // coordinates of the DisplayList, that op touched. The |restore| call
+  // matching a |saveLayer| reports the (possibly filtered) bounds of the
+  // entire layer.
+  void reset_op_bounds() {
+    op_accumulator_ = BoundsAccumulator();
+    op_is_unbounded_ = false;
+  }
+  SkRect op_bounds() const { return op_accumulator_.bounds(); }
+  // True if the ops dispatched since the last |reset_op_bounds| flooded
+  // an area that was not restricted by any clip or cull rect.
+  bool op_is_unbounded() const { return op_is_unbounded_; }
+
  private:
   // current accumulator based on saveLayer history
   BoundsAccumulator* accumulator_;
 
+  BoundsAccumulator op_accumulator_;
+  bool op_is_unbounded_ = false;
+
   // A class that remembers the information kept for a single
   // |save| or |saveLayer|.
   // Each save or saveLayer will maintain its own bounds accumulator
@@ -0,0 +1,74 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/backdrop_filter_cache.h"
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+BackdropFilterCache::BackdropFilterCache() = default;
+
+BackdropFilterCache::~BackdropFilterCache() = default;
+
+void BackdropFilterCache::PrepareNewFrame(
+    const std::vector<uint64_t>& unchanged_layer_ids) {
+  unchanged_layer_ids_.clear();
+  unchanged_layer_ids_.insert(unchanged_layer_ids.begin(),
+                              unchanged_layer_ids.end());
+  in_frame_ = true;
+}
+
+void BackdropFilterCache::CleanupAfterFrame() {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.used_this_frame) {
+      it->second.used_this_frame = false;
+      ++it;
+    } else {
+      it = entries_.erase(it);
+    }
+  }
+  unchanged_layer_ids_.clear();
+  in_frame_ = false;
+}
+
+sk_sp<SkImage> BackdropFilterCache::Get(uint64_t layer_id,
+                                        const SkIRect& device_bounds,
+                                        const SkMatrix& matrix,
+                                        SkIPoint* origin) {
+  if (unchanged_layer_ids_.find(layer_id) == unchanged_layer_ids_.end()) {
+    return nullptr;
+  }
+  auto it = entries_.find(layer_id);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  Entry& entry = it->second;
+  if (entry.device_bounds != device_bounds || entry.matrix != matrix) {
+    return nullptr;
+  }
+  TRACE_EVENT_INSTANT0("flutter", "backdrop filter cache hit");
+  entry.used_this_frame = true;
+  *origin = entry.origin;
+  return entry.image;
+}
+
+void BackdropFilterCache::Put(uint64_t layer_id,
+                              const SkIRect& device_bounds,
+                              const SkMatrix& matrix,
+                              sk_sp<SkImage> image,
+                              const SkIPoint& origin) {
+  Entry& entry = entries_[layer_id];
+  entry.device_bounds = device_bounds;
+  entry.matrix = matrix;
+  entry.image = std::move(image);
+  entry.origin = origin;
+  entry.used_this_frame = true;
+}
+
+void BackdropFilterCache::Clear() {
+  entries_.clear();
+}
+
+}  // namespace flutter
@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_BACKDROP_FILTER_CACHE_H_
+#define FLUTTER_FLOW_BACKDROP_FILTER_CACHE_H_
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace flutter {
+
+// Keeps the filtered backdrops painted by the BackdropFilterLayers of the
+// last frame so that the layers whose backdrop has not changed since then
+// can draw them instead of filtering the backdrop again.
+//
+// Whether a backdrop has changed is only known when the frame is diffed
+// with the previous one, that is when partial repaint is in use. The
+// layers are identified by their original layer id, which is kept by the
+// layers that replace them in the following frames.
+//
+// All of the methods are called on the raster thread.
+class BackdropFilterCache {
+ public:
+  BackdropFilterCache();
+
+  ~BackdropFilterCache();
+
+  // Starts a frame in which the filtered backdrops of the layers with
+  // |unchanged_layer_ids| may be reused.
+  void PrepareNewFrame(const std::vector<uint64_t>& unchanged_layer_ids);
+
+  // Ends the frame and evicts the filtered backdrops that were neither
+  // reused nor stored during it.
+  void CleanupAfterFrame();
+
+  // Whether the cache is used in the current frame. Outside of the frames
+  // started by |PrepareNewFrame| the layers filter their backdrop as usual.
+  bool is_in_frame() const { return in_frame_; }
+
+  // Returns the filtered backdrop stored for the layer with |layer_id| if
+  // its backdrop is unchanged in this frame and it was stored for the same
+  // |device_bounds| and |matrix|, or nullptr. The device position of the
+  // top left corner of the image is returned in |origin|.
+  sk_sp<SkImage> Get(uint64_t layer_id,
+                     const SkIRect& device_bounds,
+                     const SkMatrix& matrix,
+                     SkIPoint* origin);
+
+  // Stores the filtered backdrop of the layer with |layer_id| painted over
+  // |device_bounds| with |matrix|, |image| being drawn at |origin|.
+  void Put(uint64_t layer_id,
+           const SkIRect& device_bounds,
+           const SkMatrix& matrix,
+           sk_sp<SkImage> image,
+           const SkIPoint& origin);
+
+  void Clear();
+
+  size_t GetCachedEntriesCount() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    SkIRect device_bounds;
+    SkMatrix matrix;
+    sk_sp<SkImage> image;
+    SkIPoint origin;
+    bool used_this_frame = false;
+  };
+
+  bool in_frame_ = false;
+  std::unordered_set<uint64_t> unchanged_layer_ids_;
+  std::unordered_map<uint64_t, Entry> entries_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(BackdropFilterCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_BACKDROP_FILTER_CACHE_H_
@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/backdrop_filter_cache.h"
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+static sk_sp<SkImage> MakeImage() {
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(10, 10);
+  surface->getCanvas()->clear(SK_ColorBLUE);
+  return surface->makeImageSnapshot();
+}
+
+TEST(BackdropFilterCache, UnchangedBackdropIsReused) {
+  BackdropFilterCache cache;
+  sk_sp<SkImage> image = MakeImage();
+  SkIRect bounds = SkIRect::MakeWH(10, 10);
+  SkIPoint origin;
+
+  cache.PrepareNewFrame({});
+  EXPECT_TRUE(cache.is_in_frame());
+  EXPECT_EQ(cache.Get(1, bounds, SkMatrix::I(), &origin), nullptr);
+  cache.Put(1, bounds, SkMatrix::I(), image, SkIPoint::Make(-5, -5));
+  cache.CleanupAfterFrame();
+  EXPECT_FALSE(cache.is_in_frame());
+
+  cache.PrepareNewFrame({1});
+  EXPECT_EQ(cache.Get(1, bounds, SkMatrix::I(), &origin), image);
+  EXPECT_EQ(origin, SkIPoint::Make(-5, -5));
+  cache.CleanupAfterFrame();
+  EXPECT_EQ(cache.GetCachedEntriesCount(), 1u);
+}
+
+TEST(BackdropFilterCache, ChangedBackdropIsNotReused) {
+  BackdropFilterCache cache;
+  SkIRect bounds = SkIRect::MakeWH(10, 10);
+  SkIPoint origin;
+
+  cache.PrepareNewFrame({});
+  cache.Put(1, bounds, SkMatrix::I(), MakeImage(), SkIPoint::Make(0, 0));
+  cache.CleanupAfterFrame();
+
+  cache.PrepareNewFrame({2});
+  EXPECT_EQ(cache.Get(1, bounds, SkMatrix::I(), &origin), nullptr);
+}
+
+TEST(BackdropFilterCache, BackdropOfDifferentBoundsOrMatrixIsNotReused) {
+  BackdropFilterCache cache;
+  SkIRect bounds = SkIRect::MakeWH(10, 10);
+  SkIPoint origin;
+
+  cache.PrepareNewFrame({});
+  cache.Put(1, bounds, SkMatrix::I(), MakeImage(), SkIPoint::Make(0, 0));
+  cache.CleanupAfterFrame();
+
+  cache.PrepareNewFrame({1});
+  EXPECT_EQ(cache.Get(1, SkIRect::MakeWH(20, 10), SkMatrix::I(), &origin),
+            nullptr);
+  EXPECT_EQ(cache.Get(1, bounds, SkMatrix::Scale(2, 2), &origin), nullptr);
+}
+
+TEST(BackdropFilterCache, UnusedBackdropIsEvicted) {
+  BackdropFilterCache cache;
+  SkIRect bounds = SkIRect::MakeWH(10, 10);
+  SkIPoint origin;
+
+  cache.PrepareNewFrame({});
+  cache.Put(1, bounds, SkMatrix::I(), MakeImage(), SkIPoint::Make(0, 0));
+  cache.Put(2, bounds, SkMatrix::I(), MakeImage(), SkIPoint::Make(0, 0));
+  cache.CleanupAfterFrame();
+  EXPECT_EQ(cache.GetCachedEntriesCount(), 2u);
+
+  cache.PrepareNewFrame({1, 2});
+  EXPECT_NE(cache.Get(2, bounds, SkMatrix::I(), &origin), nullptr);
+  cache.CleanupAfterFrame();
+  EXPECT_EQ(cache.GetCachedEntriesCount(), 1u);
+
+  cache.PrepareNewFrame({1, 2});
+  EXPECT_EQ(cache.Get(1, bounds, SkMatrix::I(), &origin), nullptr);
+  EXPECT_NE(cache.Get(2, bounds, SkMatrix::I(), &origin), nullptr);
+}
+
+TEST(BackdropFilterCache, ClearEvictsEveryBackdrop) {
+  BackdropFilterCache cache;
+
+  cache.PrepareNewFrame({});
+  cache.Put(1, SkIRect::MakeWH(10, 10), SkMatrix::I(), MakeImage(),
+            SkIPoint::Make(0, 0));
+  cache.Clear();
+
+  EXPECT_EQ(cache.GetCachedEntriesCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
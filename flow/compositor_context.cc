@@ -6,6 +6,8 @@
 
 #include <optional>
 #include "flutter/flow/layers/layer_tree.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 
 namespace flutter {
@@ -13,6 +15,7 @@ namespace flutter {
 std::optional<SkRect> FrameDamage::ComputeClipRect(
     flutter::LayerTree& layer_tree) {
   if (layer_tree.root_layer()) {
+    fml::TimePoint start = fml::TimePoint::Now();
     PaintRegionMap empty_paint_region_map;
     DiffContext context(layer_tree.frame_size(),
                         layer_tree.device_pixel_ratio(),
@@ -37,6 +40,26 @@ std::optional<SkRect> FrameDamage::ComputeClipRect(
     }
 
     damage_ = context.ComputeDamage(additional_damage_);
+
+    const SkIRect& frame_damage = damage_->frame_damage;
+    const SkISize& frame_size = layer_tree.frame_size();
+    DamageStatistics statistics;
+    statistics.damage_area =
+        static_cast<int64_t>(frame_damage.width()) * frame_damage.height();
+    statistics.frame_area =
+        static_cast<int64_t>(frame_size.width()) * frame_size.height();
+    statistics.diffed_layers = context.statistics().diffed_layers();
+    statistics.retained_layers = context.statistics().retained_layers();
+    statistics.compute_damage_time = fml::TimePoint::Now() - start;
+    statistics_ = statistics;
+    context.statistics().LogStatistics();
+#if !FLUTTER_RELEASE
+    int64_t repainted_percent = statistics.repainted_fraction() * 100;
+    FML_TRACE_COUNTER("flutter", "FrameDamage", reinterpret_cast<int64_t>(this),
+                      "DamageArea", statistics.damage_area, "RepaintedPercent",
+                      repainted_percent, "ComputeDamageMicros",
+                      statistics.compute_damage_time.ToMicroseconds());
+#endif  // !FLUTTER_RELEASE
     return SkRect::Make(damage_->buffer_damage);
   } else {
     return std::nullopt;
@@ -45,13 +68,23 @@ std::optional<SkRect> FrameDamage::ComputeClipRect(
 
 CompositorContext::CompositorContext()
     : raster_time_(fixed_refresh_rate_updater_),
-      ui_time_(fixed_refresh_rate_updater_) {}
+      ui_time_(fixed_refresh_rate_updater_),
+      gpu_time_(fixed_refresh_rate_updater_) {}
 
 CompositorContext::CompositorContext(Stopwatch::RefreshRateUpdater& updater)
-    : raster_time_(updater), ui_time_(updater) {}
+    : raster_time_(updater), ui_time_(updater), gpu_time_(updater) {}
 
 CompositorContext::~CompositorContext() = default;
 
+void CompositorContext::RecordGpuTime(fml::TimeDelta gpu_time) {
+  gpu_time_.SetLapTime(gpu_time);
+  has_gpu_time_ = true;
+#if !FLUTTER_RELEASE
+  FML_TRACE_COUNTER("flutter", "GPUTime", reinterpret_cast<int64_t>(this),
+                    "GPUTimeMicros", gpu_time.ToMicroseconds());
+#endif  // !FLUTTER_RELEASE
+}
+
 void CompositorContext::BeginFrame(ScopedFrame& frame,
                                    bool enable_instrumentation) {
   if (enable_instrumentation) {
@@ -146,7 +179,16 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
     }
     canvas()->clear(SK_ColorTRANSPARENT);
   }
+  // The backdrops are read from the surface, which does not hold what is
+  // painted into the root save layer.
+  BackdropFilterCache& backdrop_filter_cache = context_.backdrop_filter_cache();
+  if (frame_damage && !needs_save_layer) {
+    backdrop_filter_cache.PrepareNewFrame(
+        frame_damage->GetUnchangedBackdrops());
+  }
   layer_tree.Paint(*this, ignore_raster_cache);
+  backdrop_filter_cache.CleanupAfterFrame();
+  context_.image_filter_cache().CleanupAfterFrame();
   if (canvas() && needs_save_layer) {
     canvas()->restore();
   }
@@ -156,11 +198,15 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
 void CompositorContext::OnGrContextCreated() {
   texture_registry_.OnGrContextCreated();
   raster_cache_.Clear();
+  backdrop_filter_cache_.Clear();
+  image_filter_cache_.Clear();
 }
 
 void CompositorContext::OnGrContextDestroyed() {
   texture_registry_.OnGrContextDestroyed();
   raster_cache_.Clear();
+  backdrop_filter_cache_.Clear();
+  image_filter_cache_.Clear();
 }
 
 }  // namespace flutter
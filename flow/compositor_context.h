@@ -7,12 +7,16 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "flutter/common/graphics/texture.h"
+#include "flutter/flow/backdrop_filter_cache.h"
 #include "flutter/flow/diff_context.h"
 #include "flutter/flow/embedded_views.h"
+#include "flutter/flow/image_filter_cache.h"
 #include "flutter/flow/instrumentation.h"
 #include "flutter/flow/raster_cache.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/raster_thread_merger.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -86,10 +90,21 @@ class FrameDamage {
     return damage_ ? std::make_optional(damage_->buffer_damage) : std::nullopt;
   }
 
+  // The statistics of the damage computed by |ComputeClipRect|, which are
+  // also logged to the timeline.
+  std::optional<DamageStatistics> GetStatistics() const { return statistics_; }
+
+  // See Damage::unchanged_backdrops. Empty until the clip rect is computed.
+  const std::vector<uint64_t>& GetUnchangedBackdrops() const {
+    return damage_ ? damage_->unchanged_backdrops : no_unchanged_backdrops_;
+  }
+
  private:
   SkIRect additional_damage_ = SkIRect::MakeEmpty();
   std::optional<Damage> damage_;
+  std::optional<DamageStatistics> statistics_;
   const LayerTree* prev_layer_tree_ = nullptr;
+  const std::vector<uint64_t> no_unchanged_backdrops_;
 };
 
 class CompositorContext {
@@ -159,17 +174,58 @@ class CompositorContext {
 
   RasterCache& raster_cache() { return raster_cache_; }
 
+  BackdropFilterCache& backdrop_filter_cache() {
+    return backdrop_filter_cache_;
+  }
+
+  ImageFilterCache& image_filter_cache() { return image_filter_cache_; }
+
   TextureRegistry& texture_registry() { return texture_registry_; }
 
   const Stopwatch& raster_time() const { return raster_time_; }
 
   Stopwatch& ui_time() { return ui_time_; }
 
+  const Stopwatch& gpu_time() const { return gpu_time_; }
+
+  // Whether the GPU time of any frame has been recorded.
+  bool has_gpu_time() const { return has_gpu_time_; }
+
+  // Records the time the GPU took to execute a frame, which the surface
+  // reports a few frames after the frame was submitted.
+  void RecordGpuTime(fml::TimeDelta gpu_time);
+
+  // Sets the task runner on which the independent subtrees of the layer
+  // trees are prerolled concurrently, or null to preroll them serially.
+  void SetConcurrentPrerollTaskRunner(
+      std::shared_ptr<fml::ConcurrentTaskRunner> task_runner) {
+    concurrent_preroll_task_runner_ = std::move(task_runner);
+  }
+
+  fml::ConcurrentTaskRunner* concurrent_preroll_task_runner() const {
+    return concurrent_preroll_task_runner_.get();
+  }
+
+  // Whether the text drawn by the layers is deferred past the draws that
+  // do not overlap it, so that the text of neighbouring layers is batched.
+  // See TextBatchingCanvas.
+  void set_batch_text_draws(bool batch_text_draws) {
+    batch_text_draws_ = batch_text_draws;
+  }
+
+  bool batch_text_draws() const { return batch_text_draws_; }
+
  private:
   RasterCache raster_cache_;
+  BackdropFilterCache backdrop_filter_cache_;
+  ImageFilterCache image_filter_cache_;
   TextureRegistry texture_registry_;
   Stopwatch raster_time_;
   Stopwatch ui_time_;
+  Stopwatch gpu_time_;
+  bool has_gpu_time_ = false;
+  std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_preroll_task_runner_;
+  bool batch_text_draws_ = false;
 
   /// Only used by default constructor of `CompositorContext`.
   FixedRefreshRateUpdater fixed_refresh_rate_updater_;
@@ -11,11 +11,25 @@ DiffContext::DiffContext(SkISize frame_size,
                          double frame_device_pixel_ratio,
                          PaintRegionMap& this_frame_paint_region_map,
                          const PaintRegionMap& last_frame_paint_region_map)
-    : rects_(std::make_shared<std::vector<SkRect>>()),
-      frame_size_(frame_size),
+    : frame_size_(frame_size),
       frame_device_pixel_ratio_(frame_device_pixel_ratio),
       this_frame_paint_region_map_(this_frame_paint_region_map),
-      last_frame_paint_region_map_(last_frame_paint_region_map) {}
+      last_frame_paint_region_map_(last_frame_paint_region_map) {
+  // Share the pool of the last frame, so that the rects and the map of this
+  // frame reuse the storage of the frames before it.
+  std::shared_ptr<PaintRegionPool> pool = last_frame_paint_region_map.pool();
+  if (!pool) {
+    pool = this_frame_paint_region_map.pool();
+  }
+  if (!pool) {
+    pool = std::make_shared<PaintRegionPool>();
+  }
+  if (!this_frame_paint_region_map.pool()) {
+    this_frame_paint_region_map.set_pool(pool);
+  }
+  this_frame_paint_region_map.Reserve(last_frame_paint_region_map.size());
+  rects_ = pool->AcquireRects();
+}
 
 void DiffContext::BeginSubtree() {
   state_stack_.push_back(state_);
@@ -90,6 +104,7 @@ Damage DiffContext::ComputeDamage(
   SkIRect frame_clip = SkIRect::MakeSize(frame_size_);
   res.buffer_damage.intersect(frame_clip);
   res.frame_damage.intersect(frame_clip);
+  res.unchanged_backdrops = unchanged_backdrops_;
   return res;
 }
 
@@ -170,6 +185,21 @@ void DiffContext::AddReadbackRegion(const SkIRect& rect) {
   readbacks_.push_back(std::move(readback));
 }
 
+bool DiffContext::IsDamaged(const SkRect& rect) const {
+  SkRect damage(damage_);
+  for (const auto& r : readbacks_) {
+    SkRect readback = SkRect::Make(r.rect);
+    if (readback.intersects(damage)) {
+      damage.join(readback);
+    }
+  }
+  return rect.intersects(damage);
+}
+
+void DiffContext::MarkBackdropUnchanged(const Layer* layer) {
+  unchanged_backdrops_.push_back(layer->original_layer_id());
+}
+
 PaintRegion DiffContext::CurrentSubtreeRegion() const {
   bool has_readback = std::any_of(
       readbacks_.begin(), readbacks_.end(),
@@ -191,18 +221,13 @@ void DiffContext::AddDamage(const SkRect& rect) {
 
 void DiffContext::SetLayerPaintRegion(const Layer* layer,
                                       const PaintRegion& region) {
-  this_frame_paint_region_map_[layer->unique_id()] = region;
+  this_frame_paint_region_map_.Set(layer->unique_id(), region);
 }
 
 PaintRegion DiffContext::GetOldLayerPaintRegion(const Layer* layer) const {
-  auto i = last_frame_paint_region_map_.find(layer->unique_id());
-  if (i != last_frame_paint_region_map_.end()) {
-    return i->second;
-  } else {
-    // This is valid when Layer::PreservePaintRegion is called for retained
-    // layer with zero sized parent clip (these layers are not diffed)
-    return PaintRegion();
-  }
+  // The region is invalid when Layer::PreservePaintRegion is called for
+  // retained layer with zero sized parent clip (these layers are not diffed)
+  return last_frame_paint_region_map_.Get(layer->unique_id());
 }
 
 void DiffContext::Statistics::LogStatistics() {
@@ -214,6 +239,9 @@ void DiffContext::Statistics::LogStatistics() {
                     same_instance_pictures_,
                     "DifferentInstanceButEqualPictures",
                     different_instance_but_equal_pictures_);
+  FML_TRACE_COUNTER("flutter", "DiffContextLayers",
+                    reinterpret_cast<int64_t>(this), "DiffedLayers",
+                    diffed_layers_, "RetainedLayers", retained_layers_);
 #endif  // !FLUTTER_RELEASE
 }
 
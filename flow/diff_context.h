@@ -6,12 +6,12 @@
 #define FLUTTER_FLOW_DIFF_CONTEXT_H_
 
 #include <functional>
-#include <map>
 #include <optional>
 #include <vector>
 #include "flutter/flow/paint_region.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
 #include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkRect.h"
 
@@ -34,10 +34,34 @@ struct Damage {
   // upfront may be useful for tile based GPUs.
   // Corresponds to "buffer damage" from EGL_KHR_partial_update.
   SkIRect buffer_damage;
+
+  // The original layer ids of the BackdropFilterLayers whose filtered
+  // backdrop is the same as in the previous frame. See
+  // DiffContext::MarkBackdropUnchanged.
+  std::vector<uint64_t> unchanged_backdrops;
 };
 
-// Layer Unique Id to PaintRegion
-using PaintRegionMap = std::map<uint64_t, PaintRegion>;
+// Summarizes the damage of a frame and the work done to compute it.
+struct DamageStatistics {
+  // The number of pixels of Damage::frame_damage and of the whole frame.
+  int64_t damage_area = 0;
+  int64_t frame_area = 0;
+
+  // The layers that were diffed against the previous frame, and the
+  // retained layers whose previous paint region was reused without diffing
+  // them.
+  int diffed_layers = 0;
+  int retained_layers = 0;
+
+  // The time spent diffing the layer tree and computing the damage.
+  fml::TimeDelta compute_damage_time;
+
+  // The fraction of the frame that is repainted; 1 for an empty frame.
+  double repainted_fraction() const {
+    return frame_area > 0 ? static_cast<double>(damage_area) / frame_area
+                          : 1.0;
+  }
+};
 
 // Tracks state during tree diffing process and computes resulting damage
 class DiffContext {
@@ -123,6 +147,16 @@ class DiffContext {
   // Readback rect is in screen coordinates.
   void AddReadbackRegion(const SkIRect& rect);
 
+  // Returns whether any part of rect, in screen coordinates, is damaged by
+  // the layers diffed so far, which are the layers painted before the
+  // current one. This includes the readback regions added so far that are
+  // damaged, since the layers reading them back paint something new.
+  bool IsDamaged(const SkRect& rect) const;
+
+  // Records that the backdrop read back by the BackdropFilterLayer, and
+  // hence its filtered result, is the same as in the previous frame.
+  void MarkBackdropUnchanged(const Layer* layer);
+
   // Returns the paint region for current subtree; Each rect in paint region is
   // in screen coordinates; Once a layer accumulates the paint regions of its
   // children, this PaintRegion value can be associated with the current layer
@@ -172,6 +206,15 @@ class DiffContext {
       ++different_instance_but_equal_pictures_;
     };
 
+    // Layer diffed against the layer it replaces, or diffed as new
+    void AddDiffedLayer() { ++diffed_layers_; }
+
+    // Retained layer whose paint region was reused without diffing it
+    void AddRetainedLayer() { ++retained_layers_; }
+
+    int diffed_layers() const { return diffed_layers_; }
+    int retained_layers() const { return retained_layers_; }
+
     // Logs the statistics to trace counter
     void LogStatistics();
 
@@ -181,6 +224,8 @@ class DiffContext {
     int same_instance_pictures_ = 0;
     int deep_compare_pictures_ = 0;
     int different_instance_but_equal_pictures_ = 0;
+    int diffed_layers_ = 0;
+    int retained_layers_ = 0;
   };
 
   Statistics& statistics() { return statistics_; }
@@ -240,6 +285,7 @@ class DiffContext {
   };
 
   std::vector<Readback> readbacks_;
+  std::vector<uint64_t> unchanged_backdrops_;
   Statistics statistics_;
 };
 
@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/display_list_picture_cache.h"
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+
+namespace flutter {
+
+sk_sp<SkPicture> DisplayListPictureCache::Convert(
+    const DisplayList& display_list,
+    const SkRect& bounds) {
+  SkPictureRecorder recorder;
+  display_list.RenderTo(recorder.beginRecording(bounds));
+  return recorder.finishRecordingAsPicture();
+}
+
+void DisplayListPictureCache::Prepare(
+    const std::vector<DisplayList*>& display_lists,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& task_runner) {
+  TRACE_EVENT0("flutter", "DisplayListPictureCache::Prepare");
+
+  std::unordered_map<uint32_t, sk_sp<SkPicture>> pictures;
+  struct Conversion {
+    const DisplayList* display_list;
+    SkRect bounds;
+    sk_sp<SkPicture> picture;
+  };
+  std::vector<Conversion> conversions;
+  for (DisplayList* display_list : display_lists) {
+    uint32_t id = display_list->unique_id();
+    if (pictures.count(id) > 0) {
+      continue;
+    }
+    auto cached = pictures_.find(id);
+    if (cached != pictures_.end()) {
+      pictures[id] = std::move(cached->second);
+      continue;
+    }
+    // Placeholder so that a list which appears several times in the tree
+    // is only converted once.
+    pictures[id] = nullptr;
+    // The bounds are computed lazily and so must be computed here rather
+    // than by the workers, which only read the lists.
+    conversions.push_back({display_list, display_list->bounds(), nullptr});
+  }
+
+  if (task_runner && conversions.size() > 1) {
+    fml::CountDownLatch latch(conversions.size());
+    for (Conversion& conversion : conversions) {
+      task_runner->PostTask([&conversion, &latch]() {
+        TRACE_EVENT0("flutter", "DisplayListPictureCache::Convert");
+        conversion.picture =
+            Convert(*conversion.display_list, conversion.bounds);
+        latch.CountDown();
+      });
+    }
+    latch.Wait();
+  } else {
+    for (Conversion& conversion : conversions) {
+      conversion.picture = Convert(*conversion.display_list, conversion.bounds);
+    }
+  }
+
+  for (Conversion& conversion : conversions) {
+    pictures[conversion.display_list->unique_id()] =
+        std::move(conversion.picture);
+  }
+  pictures_ = std::move(pictures);
+}
+
+sk_sp<SkPicture> DisplayListPictureCache::Get(
+    const DisplayList& display_list) const {
+  auto it = pictures_.find(display_list.unique_id());
+  return it == pictures_.end() ? nullptr : it->second;
+}
+
+}  // namespace flutter
@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_DISPLAY_LIST_PICTURE_CACHE_H_
+#define FLUTTER_FLOW_DISPLAY_LIST_PICTURE_CACHE_H_
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkPicture.h"
+
+namespace flutter {
+
+// A cache of the SkPictures recorded from the DisplayLists of a layer tree
+// for the consumers that still need pictures, such as |LayerTree::Flatten|
+// and the screenshots and SKP dumps taken by the rasterizer.
+//
+// The pictures are keyed by the |DisplayList::unique_id| of their lists,
+// so a list that appears in several consecutive screenshots of the same
+// tree, or of trees that reuse its layers, is only converted once.
+//
+// The cache is not thread safe and must only be used on one thread at a
+// time. Only the conversion itself runs on other threads.
+class DisplayListPictureCache {
+ public:
+  DisplayListPictureCache() = default;
+
+  // Records a picture for every list in |display_lists| that is not yet
+  // cached, one list per task posted to |task_runner|, and waits for all
+  // of them to finish. The lists are converted on the calling thread if
+  // |task_runner| is null.
+  //
+  // The pictures of any lists that are not in |display_lists| are evicted
+  // so that the cache only holds the pictures of the most recent tree.
+  void Prepare(const std::vector<DisplayList*>& display_lists,
+               const std::shared_ptr<fml::ConcurrentTaskRunner>& task_runner);
+
+  // Returns the picture prepared for |display_list|, or nullptr if it has
+  // not been prepared.
+  sk_sp<SkPicture> Get(const DisplayList& display_list) const;
+
+  size_t size() const { return pictures_.size(); }
+
+  // Records |display_list| into a new picture with the given |bounds|,
+  // which are normally those of the list.
+  static sk_sp<SkPicture> Convert(const DisplayList& display_list,
+                                  const SkRect& bounds);
+
+ private:
+  std::unordered_map<uint32_t, sk_sp<SkPicture>> pictures_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListPictureCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_DISPLAY_LIST_PICTURE_CACHE_H_
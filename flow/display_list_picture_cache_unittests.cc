@@ -0,0 +1,99 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/display_list_picture_cache.h"
+
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static sk_sp<DisplayList> MakeDisplayList(const SkRect& rect) {
+  DisplayListBuilder builder;
+  builder.drawRect(rect);
+  return builder.Build();
+}
+
+TEST(DisplayListPictureCache, PrepareConvertsEveryList) {
+  auto list1 = MakeDisplayList(SkRect::MakeLTRB(0, 0, 10, 10));
+  auto list2 = MakeDisplayList(SkRect::MakeLTRB(10, 10, 20, 20));
+  DisplayListPictureCache cache;
+
+  cache.Prepare({list1.get(), list2.get()}, nullptr);
+
+  ASSERT_EQ(cache.size(), 2u);
+  sk_sp<SkPicture> picture1 = cache.Get(*list1);
+  sk_sp<SkPicture> picture2 = cache.Get(*list2);
+  ASSERT_NE(picture1, nullptr);
+  ASSERT_NE(picture2, nullptr);
+  EXPECT_EQ(picture1->cullRect(), list1->bounds());
+  EXPECT_EQ(picture2->cullRect(), list2->bounds());
+}
+
+TEST(DisplayListPictureCache, PrepareConvertsListsConcurrently) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  std::vector<sk_sp<DisplayList>> lists;
+  std::vector<DisplayList*> pointers;
+  for (int i = 0; i < 16; i++) {
+    lists.push_back(MakeDisplayList(SkRect::MakeXYWH(i * 10, 0, 10, 10)));
+    pointers.push_back(lists.back().get());
+  }
+  DisplayListPictureCache cache;
+
+  cache.Prepare(pointers, loop->GetTaskRunner());
+
+  ASSERT_EQ(cache.size(), lists.size());
+  for (auto& list : lists) {
+    sk_sp<SkPicture> picture = cache.Get(*list);
+    ASSERT_NE(picture, nullptr);
+    EXPECT_EQ(picture->cullRect(), list->bounds());
+  }
+}
+
+TEST(DisplayListPictureCache, RepeatedListIsConvertedOnce) {
+  auto list = MakeDisplayList(SkRect::MakeLTRB(0, 0, 10, 10));
+  DisplayListPictureCache cache;
+
+  cache.Prepare({list.get(), list.get()}, nullptr);
+
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_NE(cache.Get(*list), nullptr);
+}
+
+TEST(DisplayListPictureCache, PrepareReusesCachedPictures) {
+  auto list = MakeDisplayList(SkRect::MakeLTRB(0, 0, 10, 10));
+  DisplayListPictureCache cache;
+
+  cache.Prepare({list.get()}, nullptr);
+  sk_sp<SkPicture> picture = cache.Get(*list);
+  cache.Prepare({list.get()}, nullptr);
+
+  ASSERT_NE(picture, nullptr);
+  EXPECT_EQ(cache.Get(*list), picture);
+}
+
+TEST(DisplayListPictureCache, PrepareEvictsListsNotInTheTree) {
+  auto list1 = MakeDisplayList(SkRect::MakeLTRB(0, 0, 10, 10));
+  auto list2 = MakeDisplayList(SkRect::MakeLTRB(10, 10, 20, 20));
+  DisplayListPictureCache cache;
+
+  cache.Prepare({list1.get(), list2.get()}, nullptr);
+  cache.Prepare({list2.get()}, nullptr);
+
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.Get(*list1), nullptr);
+  EXPECT_NE(cache.Get(*list2), nullptr);
+}
+
+TEST(DisplayListPictureCache, GetReturnsNullForUnpreparedList) {
+  auto list = MakeDisplayList(SkRect::MakeLTRB(0, 0, 10, 10));
+  DisplayListPictureCache cache;
+
+  EXPECT_EQ(cache.Get(*list), nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
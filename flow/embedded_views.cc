@@ -64,6 +64,18 @@ bool ExternalViewEmbedder::SupportsDynamicThreadMerging() {
   return false;
 }
 
+bool ExternalViewEmbedder::UsesFrameDamage() const {
+  return false;
+}
+
+size_t ExternalViewEmbedder::GetOverlaySurfaceBytes() const {
+  return 0;
+}
+
+size_t ExternalViewEmbedder::DestroySpareOverlaySurfaces() {
+  return 0;
+}
+
 void ExternalViewEmbedder::Teardown() {}
 
 }  // namespace flutter
@@ -330,6 +330,20 @@ class ExternalViewEmbedder {
   // |RasterThreadMerger| instance.
   virtual bool SupportsDynamicThreadMerging();
 
+  // Whether the damage of each frame, relative to the last frame, should be
+  // set on the |SurfaceFrame| passed to |SubmitFrame| even though the frame
+  // is repainted in full, so that the embedder may present only what changed.
+  virtual bool UsesFrameDamage() const;
+
+  // The estimated memory of the overlay surfaces that the embedder keeps for
+  // the platform views, including the spare ones of its pools.
+  virtual size_t GetOverlaySurfaceBytes() const;
+
+  // Destroys the overlay surfaces that the embedder keeps beyond the ones
+  // used by the last frame, for example under memory pressure. Called on the
+  // raster thread between frames. Returns their estimated memory.
+  virtual size_t DestroySpareOverlaySurfaces();
+
   // Called when the rasterizer is being torn down.
   // This method provides a way to release resources associated with the current
   // embedder.
@@ -0,0 +1,111 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_timing_histograms.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+DurationHistogram::DurationHistogram()
+    : buckets_(GetBucketIndex(kMaxDuration.ToMicroseconds()) + 1) {}
+
+size_t DurationHistogram::GetBucketIndex(int64_t micros) {
+  // The durations below 2 * kSubBucketCount have a bucket each. Above that,
+  // the durations in [2^n, 2^(n+1)) have the kSubBucketCount buckets that
+  // follow those of [2^(n-1), 2^n).
+  if (micros < 2 * kSubBucketCount) {
+    return micros;
+  }
+  int top_bit = 0;
+  while (micros >> (top_bit + 1)) {
+    top_bit++;
+  }
+  int shift = top_bit - kSubBucketBits;
+  return shift * kSubBucketCount + (micros >> shift);
+}
+
+int64_t DurationHistogram::GetBucketUpperBound(size_t index) {
+  if (index < 2 * kSubBucketCount) {
+    return index;
+  }
+  int shift = index / kSubBucketCount - 1;
+  int64_t sub_bucket = index - shift * kSubBucketCount;
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+void DurationHistogram::Record(fml::TimeDelta duration) {
+  int64_t micros = std::clamp<int64_t>(duration.ToMicroseconds(), 0,
+                                       kMaxDuration.ToMicroseconds());
+  buckets_[GetBucketIndex(micros)]++;
+  count_++;
+  max_ = std::max(max_, micros);
+}
+
+fml::TimeDelta DurationHistogram::GetPercentile(double percentile) const {
+  FML_DCHECK(percentile >= 0 && percentile <= 100);
+  if (count_ == 0) {
+    return fml::TimeDelta::Zero();
+  }
+  uint64_t rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(std::ceil(percentile / 100 * count_)));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < buckets_.size(); i++) {
+    seen += buckets_[i];
+    if (seen >= rank) {
+      return fml::TimeDelta::FromMicroseconds(
+          std::min(GetBucketUpperBound(i), max_));
+    }
+  }
+  return max();
+}
+
+void DurationHistogram::Reset() {
+  std::fill(buckets_.begin(), buckets_.end(), 0);
+  count_ = 0;
+  max_ = 0;
+}
+
+FrameTimingHistograms::FrameTimingHistograms() = default;
+
+void FrameTimingHistograms::Record(const FrameTiming& timing) {
+  fml::TimePoint vsync_start = timing.Get(FrameTiming::kVsyncStart);
+  fml::TimePoint build_start = timing.Get(FrameTiming::kBuildStart);
+  std::scoped_lock lock(mutex_);
+  histograms_[kBuild].Record(timing.Get(FrameTiming::kBuildFinish) -
+                             build_start);
+  histograms_[kRaster].Record(timing.Get(FrameTiming::kRasterFinish) -
+                              timing.Get(FrameTiming::kRasterStart));
+  histograms_[kVsyncOverhead].Record(build_start - vsync_start);
+  histograms_[kTotalSpan].Record(timing.Get(FrameTiming::kRasterFinish) -
+                                 vsync_start);
+}
+
+fml::TimeDelta FrameTimingHistograms::GetPercentile(Phase phase,
+                                                    double percentile) const {
+  std::scoped_lock lock(mutex_);
+  return histograms_[phase].GetPercentile(percentile);
+}
+
+fml::TimeDelta FrameTimingHistograms::GetMax(Phase phase) const {
+  std::scoped_lock lock(mutex_);
+  return histograms_[phase].max();
+}
+
+uint64_t FrameTimingHistograms::GetFrameCount() const {
+  std::scoped_lock lock(mutex_);
+  return histograms_[kTotalSpan].count();
+}
+
+void FrameTimingHistograms::Reset() {
+  std::scoped_lock lock(mutex_);
+  for (DurationHistogram& histogram : histograms_) {
+    histogram.Reset();
+  }
+}
+
+}  // namespace flutter
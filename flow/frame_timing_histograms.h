@@ -0,0 +1,98 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_FRAME_TIMING_HISTOGRAMS_H_
+#define FLUTTER_FLOW_FRAME_TIMING_HISTOGRAMS_H_
+
+#include <mutex>
+#include <vector>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+// A streaming histogram of durations in the style of an HDR histogram.
+//
+// The durations are counted in buckets whose width is proportional to the
+// durations they hold: every range of durations between two powers of two
+// microseconds is split into |kSubBucketCount| buckets. So recording a
+// duration is an increment in a fixed array, and any percentile is known
+// to within 1 / |kSubBucketCount| of its value however many durations are
+// recorded.
+class DurationHistogram {
+ public:
+  static constexpr int kSubBucketBits = 6;
+  static constexpr int64_t kSubBucketCount = 1 << kSubBucketBits;
+
+  // Longer durations are recorded as this duration.
+  static constexpr fml::TimeDelta kMaxDuration =
+      fml::TimeDelta::FromSeconds(60);
+
+  DurationHistogram();
+
+  void Record(fml::TimeDelta duration);
+
+  // Returns the duration that |percentile| percent of the recorded
+  // durations do not exceed, rounded up to the end of its bucket, or zero
+  // if no durations were recorded.
+  fml::TimeDelta GetPercentile(double percentile) const;
+
+  fml::TimeDelta max() const { return fml::TimeDelta::FromMicroseconds(max_); }
+
+  uint64_t count() const { return count_; }
+
+  void Reset();
+
+ private:
+  static size_t GetBucketIndex(int64_t micros);
+  static int64_t GetBucketUpperBound(size_t index);
+
+  std::vector<uint64_t> buckets_;
+  uint64_t count_ = 0;
+  int64_t max_ = 0;
+};
+
+// The histograms of the durations of the phases of the rasterized frames.
+//
+// The frames are recorded on the raster thread, but the histograms may be
+// queried from any thread.
+class FrameTimingHistograms {
+ public:
+  enum Phase {
+    // From the start to the end of the build.
+    kBuild,
+    // From the start to the end of the rasterization.
+    kRaster,
+    // From the vsync to the start of the build.
+    kVsyncOverhead,
+    // From the vsync to the end of the rasterization.
+    kTotalSpan,
+    kCount
+  };
+
+  FrameTimingHistograms();
+
+  void Record(const FrameTiming& timing);
+
+  // See |DurationHistogram::GetPercentile|.
+  fml::TimeDelta GetPercentile(Phase phase, double percentile) const;
+
+  fml::TimeDelta GetMax(Phase phase) const;
+
+  uint64_t GetFrameCount() const;
+
+  void Reset();
+
+ private:
+  mutable std::mutex mutex_;
+  DurationHistogram histograms_[kCount];
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameTimingHistograms);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_FRAME_TIMING_HISTOGRAMS_H_
@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_timing_histograms.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static fml::TimeDelta Micros(int64_t micros) {
+  return fml::TimeDelta::FromMicroseconds(micros);
+}
+
+TEST(DurationHistogram, EmptyHistogramHasNoPercentiles) {
+  DurationHistogram histogram;
+
+  EXPECT_EQ(histogram.count(), 0u);
+  EXPECT_EQ(histogram.GetPercentile(50), fml::TimeDelta::Zero());
+  EXPECT_EQ(histogram.max(), fml::TimeDelta::Zero());
+}
+
+TEST(DurationHistogram, ShortDurationsAreExact) {
+  DurationHistogram histogram;
+  for (int i = 1; i <= 100; i++) {
+    histogram.Record(Micros(i));
+  }
+
+  EXPECT_EQ(histogram.count(), 100u);
+  EXPECT_EQ(histogram.GetPercentile(0), Micros(1));
+  EXPECT_EQ(histogram.GetPercentile(50), Micros(50));
+  EXPECT_EQ(histogram.GetPercentile(99), Micros(99));
+  EXPECT_EQ(histogram.GetPercentile(100), Micros(100));
+}
+
+TEST(DurationHistogram, LongDurationsAreWithinBucketPrecision) {
+  DurationHistogram histogram;
+  for (int i = 1; i <= 1000; i++) {
+    histogram.Record(fml::TimeDelta::FromMilliseconds(i));
+  }
+
+  for (double percentile : {50.0, 90.0, 99.0}) {
+    int64_t expected = percentile * 10 * 1000;
+    int64_t actual = histogram.GetPercentile(percentile).ToMicroseconds();
+    EXPECT_GE(actual, expected);
+    EXPECT_LE(actual, expected + expected / DurationHistogram::kSubBucketCount);
+  }
+  EXPECT_EQ(histogram.GetPercentile(100), fml::TimeDelta::FromSeconds(1));
+  EXPECT_EQ(histogram.max(), fml::TimeDelta::FromSeconds(1));
+}
+
+TEST(DurationHistogram, OutOfRangeDurationsAreClamped) {
+  DurationHistogram histogram;
+  histogram.Record(Micros(-5));
+  histogram.Record(fml::TimeDelta::FromSeconds(3600));
+
+  EXPECT_EQ(histogram.GetPercentile(50), fml::TimeDelta::Zero());
+  EXPECT_EQ(histogram.GetPercentile(100), DurationHistogram::kMaxDuration);
+}
+
+TEST(DurationHistogram, ResetForgetsDurations) {
+  DurationHistogram histogram;
+  histogram.Record(Micros(10));
+  histogram.Reset();
+
+  EXPECT_EQ(histogram.count(), 0u);
+  EXPECT_EQ(histogram.GetPercentile(100), fml::TimeDelta::Zero());
+}
+
+TEST(FrameTimingHistograms, RecordsEveryPhase) {
+  fml::TimePoint vsync = fml::TimePoint::FromEpochDelta(Micros(1000));
+  FrameTiming timing;
+  timing.Set(FrameTiming::kVsyncStart, vsync);
+  timing.Set(FrameTiming::kBuildStart, vsync + Micros(10));
+  timing.Set(FrameTiming::kBuildFinish, vsync + Micros(50));
+  timing.Set(FrameTiming::kRasterStart, vsync + Micros(60));
+  timing.Set(FrameTiming::kRasterFinish, vsync + Micros(120));
+  FrameTimingHistograms histograms;
+
+  histograms.Record(timing);
+
+  EXPECT_EQ(histograms.GetFrameCount(), 1u);
+  EXPECT_EQ(histograms.GetPercentile(FrameTimingHistograms::kBuild, 50),
+            Micros(40));
+  EXPECT_EQ(histograms.GetPercentile(FrameTimingHistograms::kRaster, 50),
+            Micros(60));
+  EXPECT_EQ(
+      histograms.GetPercentile(FrameTimingHistograms::kVsyncOverhead, 50),
+      Micros(10));
+  EXPECT_EQ(histograms.GetPercentile(FrameTimingHistograms::kTotalSpan, 50),
+            Micros(120));
+  EXPECT_EQ(histograms.GetMax(FrameTimingHistograms::kTotalSpan), Micros(120));
+}
+
+}  // namespace testing
+}  // namespace flutter
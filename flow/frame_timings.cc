@@ -107,6 +107,13 @@ size_t FrameTimingsRecorder::GetPictureCacheBytes() const {
   return picture_cache_bytes_;
 }
 
+std::optional<DamageStatistics> FrameTimingsRecorder::GetDamageStatistics()
+    const {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ >= State::kRasterEnd);
+  return damage_statistics_;
+}
+
 void FrameTimingsRecorder::RecordVsync(fml::TimePoint vsync_start,
                                        fml::TimePoint vsync_target) {
   std::scoped_lock state_lock(state_mutex_);
@@ -121,6 +128,7 @@ void FrameTimingsRecorder::RecordBuildStart(fml::TimePoint build_start) {
   FML_DCHECK(state_ == State::kVsync);
   state_ = State::kBuildStart;
   build_start_ = build_start;
+  build_allocations_ = fml::tracing::GetThreadAllocationCounts();
 }
 
 void FrameTimingsRecorder::RecordBuildEnd(fml::TimePoint build_end) {
@@ -128,6 +136,8 @@ void FrameTimingsRecorder::RecordBuildEnd(fml::TimePoint build_end) {
   FML_DCHECK(state_ == State::kBuildStart);
   state_ = State::kBuildEnd;
   build_end_ = build_end;
+  build_allocations_ =
+      fml::tracing::GetThreadAllocationCounts() - build_allocations_;
 }
 
 void FrameTimingsRecorder::RecordRasterStart(fml::TimePoint raster_start) {
@@ -135,6 +145,20 @@ void FrameTimingsRecorder::RecordRasterStart(fml::TimePoint raster_start) {
   FML_DCHECK(state_ == State::kBuildEnd);
   state_ = State::kRasterStart;
   raster_start_ = raster_start;
+  raster_allocations_ = fml::tracing::GetThreadAllocationCounts();
+}
+
+void FrameTimingsRecorder::RecordDamageStatistics(
+    const DamageStatistics& statistics) {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ == State::kRasterStart);
+  damage_statistics_ = statistics;
+}
+
+void FrameTimingsRecorder::RecordRasterSkipped() {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ == State::kRasterStart);
+  raster_skipped_ = true;
 }
 
 FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
@@ -143,6 +167,8 @@ FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
   state_ = State::kRasterEnd;
   raster_end_ = fml::TimePoint::Now();
   raster_end_wall_time_ = fml::TimePoint::CurrentWallTime();
+  raster_allocations_ =
+      fml::tracing::GetThreadAllocationCounts() - raster_allocations_;
   if (cache) {
     const RasterCacheMetrics& layer_metrics = cache->layer_metrics();
     const RasterCacheMetrics& picture_metrics = cache->picture_metrics();
@@ -163,6 +189,10 @@ FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
   timing_.SetFrameNumber(GetFrameNumber());
   timing_.SetRasterCacheStatistics(layer_cache_count_, layer_cache_bytes_,
                                    picture_cache_count_, picture_cache_bytes_);
+  timing_.SetAllocationStatistics(
+      build_allocations_.count, build_allocations_.bytes,
+      raster_allocations_.count, raster_allocations_.bytes);
+  timing_.SetSkipped(raster_skipped_);
   return timing_;
 }
 
@@ -187,6 +217,7 @@ std::unique_ptr<FrameTimingsRecorder> FrameTimingsRecorder::CloneUntil(
 
   if (state >= State::kBuildStart) {
     recorder->build_start_ = build_start_;
+    recorder->build_allocations_ = build_allocations_;
   }
 
   if (state >= State::kBuildEnd) {
@@ -195,6 +226,7 @@ std::unique_ptr<FrameTimingsRecorder> FrameTimingsRecorder::CloneUntil(
 
   if (state >= State::kRasterStart) {
     recorder->raster_start_ = raster_start_;
+    recorder->raster_allocations_ = raster_allocations_;
   }
 
   if (state >= State::kRasterEnd) {
@@ -204,6 +236,8 @@ std::unique_ptr<FrameTimingsRecorder> FrameTimingsRecorder::CloneUntil(
     recorder->layer_cache_bytes_ = layer_cache_bytes_;
     recorder->picture_cache_count_ = picture_cache_count_;
     recorder->picture_cache_bytes_ = picture_cache_bytes_;
+    recorder->damage_statistics_ = damage_statistics_;
+    recorder->raster_skipped_ = raster_skipped_;
   }
 
   return recorder;
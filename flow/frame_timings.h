@@ -6,9 +6,12 @@
 #define FLUTTER_FLOW_FRAME_TIMINGS_H_
 
 #include <mutex>
+#include <optional>
 
 #include "flutter/common/settings.h"
+#include "flutter/flow/diff_context.h"
 #include "flutter/flow/raster_cache.h"
+#include "flutter/fml/allocation_tracker.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
@@ -83,18 +86,36 @@ class FrameTimingsRecorder {
   /// Total Bytes in all picture cache entries
   size_t GetPictureCacheBytes() const;
 
+  /// Statistics of the damage of the frame, if it was rasterized with partial
+  /// repaint.
+  std::optional<DamageStatistics> GetDamageStatistics() const;
+
   /// Records a vsync event.
   void RecordVsync(fml::TimePoint vsync_start, fml::TimePoint vsync_target);
 
   /// Records a build start event.
+  ///
+  /// The allocations that the calling thread makes until |RecordBuildEnd| is
+  /// called on it are the allocations of the build.
   void RecordBuildStart(fml::TimePoint build_start);
 
   /// Records a build end event.
   void RecordBuildEnd(fml::TimePoint build_end);
 
   /// Records a raster start event.
+  ///
+  /// The allocations that the calling thread makes until |RecordRasterEnd| is
+  /// called on it are the allocations of the rasterization.
   void RecordRasterStart(fml::TimePoint raster_start);
 
+  /// Records the statistics of the damage computed while rasterizing the
+  /// frame.
+  void RecordDamageStatistics(const DamageStatistics& statistics);
+
+  /// Records that the frame was identical to the previous one, and was
+  /// neither painted nor presented.
+  void RecordRasterSkipped();
+
   /// Clones the recorder until (and including) the specified state.
   std::unique_ptr<FrameTimingsRecorder> CloneUntil(State state);
 
@@ -134,6 +155,13 @@ class FrameTimingsRecorder {
   size_t layer_cache_bytes_;
   size_t picture_cache_count_;
   size_t picture_cache_bytes_;
+  std::optional<DamageStatistics> damage_statistics_;
+  bool raster_skipped_ = false;
+
+  // The counts of the thread at the start of the phase until the phase ends,
+  // and then the allocations of the phase.
+  fml::tracing::AllocationCounts build_allocations_;
+  fml::tracing::AllocationCounts raster_allocations_;
 
   // Set when `RecordRasterEnd` is called. Cannot be reset once set.
   FrameTiming timing_;
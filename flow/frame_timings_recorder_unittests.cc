@@ -8,6 +8,7 @@
 #include "flutter/flow/testing/mock_raster_cache.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
 
+#include <array>
 #include <thread>
 
 #include "flutter/fml/time/time_delta.h"
@@ -285,6 +286,104 @@ TEST(FrameTimingsRecorderTest, ClonedHasSameRasterEndWithCache) {
   ASSERT_EQ(recorder->GetPictureCacheBytes(), cloned->GetPictureCacheBytes());
 }
 
+TEST(FrameTimingsRecorderTest, RecordDamageStatistics) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto now = fml::TimePoint::Now();
+  recorder->RecordVsync(now, now + fml::TimeDelta::FromMilliseconds(16));
+  recorder->RecordBuildStart(fml::TimePoint::Now());
+  recorder->RecordBuildEnd(fml::TimePoint::Now());
+  recorder->RecordRasterStart(fml::TimePoint::Now());
+
+  DamageStatistics statistics;
+  statistics.damage_area = 2500;
+  statistics.frame_area = 10000;
+  statistics.diffed_layers = 3;
+  statistics.retained_layers = 7;
+  statistics.compute_damage_time = fml::TimeDelta::FromMicroseconds(150);
+  recorder->RecordDamageStatistics(statistics);
+  recorder->RecordRasterEnd();
+
+  auto recorded = recorder->GetDamageStatistics();
+  ASSERT_TRUE(recorded.has_value());
+  ASSERT_EQ(recorded->damage_area, 2500);
+  ASSERT_EQ(recorded->frame_area, 10000);
+  ASSERT_EQ(recorded->repainted_fraction(), 0.25);
+  ASSERT_EQ(recorded->diffed_layers, 3);
+  ASSERT_EQ(recorded->retained_layers, 7);
+  ASSERT_EQ(recorded->compute_damage_time,
+            fml::TimeDelta::FromMicroseconds(150));
+
+  auto cloned = recorder->CloneUntil(FrameTimingsRecorder::State::kRasterEnd);
+  ASSERT_TRUE(cloned->GetDamageStatistics().has_value());
+  ASSERT_EQ(cloned->GetDamageStatistics()->damage_area, 2500);
+}
+
+TEST(FrameTimingsRecorderTest, RecordRasterSkipped) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto now = fml::TimePoint::Now();
+  recorder->RecordVsync(now, now + fml::TimeDelta::FromMilliseconds(16));
+  recorder->RecordBuildStart(fml::TimePoint::Now());
+  recorder->RecordBuildEnd(fml::TimePoint::Now());
+  recorder->RecordRasterStart(fml::TimePoint::Now());
+  recorder->RecordRasterSkipped();
+  FrameTiming timing = recorder->RecordRasterEnd();
+
+  ASSERT_TRUE(timing.IsSkipped());
+  ASSERT_TRUE(recorder->GetRecordedTime().IsSkipped());
+}
+
+TEST(FrameTimingsRecorderTest, RasterNotSkippedByDefault) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto now = fml::TimePoint::Now();
+  recorder->RecordVsync(now, now + fml::TimeDelta::FromMilliseconds(16));
+  recorder->RecordBuildStart(fml::TimePoint::Now());
+  recorder->RecordBuildEnd(fml::TimePoint::Now());
+  recorder->RecordRasterStart(fml::TimePoint::Now());
+  FrameTiming timing = recorder->RecordRasterEnd();
+
+  ASSERT_FALSE(timing.IsSkipped());
+}
+
+TEST(FrameTimingsRecorderTest, NoDamageStatisticsWithoutPartialRepaint) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto now = fml::TimePoint::Now();
+  recorder->RecordVsync(now, now + fml::TimeDelta::FromMilliseconds(16));
+  recorder->RecordBuildStart(fml::TimePoint::Now());
+  recorder->RecordBuildEnd(fml::TimePoint::Now());
+  recorder->RecordRasterStart(fml::TimePoint::Now());
+  recorder->RecordRasterEnd();
+
+  ASSERT_FALSE(recorder->GetDamageStatistics().has_value());
+}
+
+TEST(FrameTimingsRecorderTest, RecordAllocationsOfPhases) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto st = fml::TimePoint::Now();
+  const auto en = st + fml::TimeDelta::FromMillisecondsF(16);
+  recorder->RecordVsync(st, en);
+
+  recorder->RecordBuildStart(fml::TimePoint::Now());
+  auto allocation = std::make_unique<std::array<uint8_t, 64>>();
+  recorder->RecordBuildEnd(fml::TimePoint::Now());
+  recorder->RecordRasterStart(fml::TimePoint::Now());
+  const auto timing = recorder->RecordRasterEnd();
+
+  if (fml::tracing::IsAllocationTrackingEnabled()) {
+    ASSERT_GE(timing.GetBuildAllocationCount(), 1u);
+    ASSERT_GE(timing.GetBuildAllocationBytes(), sizeof(*allocation));
+  } else {
+    ASSERT_EQ(timing.GetBuildAllocationCount(), 0u);
+    ASSERT_EQ(timing.GetBuildAllocationBytes(), 0u);
+  }
+  ASSERT_EQ(timing.GetRasterAllocationCount(), 0u);
+  ASSERT_EQ(timing.GetRasterAllocationBytes(), 0u);
+}
+
 TEST(FrameTimingsRecorderTest, FrameNumberTraceArgIsValid) {
   auto recorder = std::make_unique<FrameTimingsRecorder>();
 
@@ -0,0 +1,169 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/image_filter_cache.h"
+
+#include "flutter/flow/raster_cache.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+// Returns in |changed_bounds| the union of the paint bounds of the children
+// that were replaced, or false if the children can not be matched up.
+static bool GetChangedBounds(const std::vector<ImageFilterCache::Child>& old,
+                             const std::vector<ImageFilterCache::Child>& now,
+                             SkRect* changed_bounds) {
+  if (old.size() != now.size()) {
+    return false;
+  }
+  *changed_bounds = SkRect::MakeEmpty();
+  for (size_t i = 0; i < now.size(); i++) {
+    if (old[i].unique_id != now[i].unique_id) {
+      changed_bounds->join(old[i].paint_bounds);
+      changed_bounds->join(now[i].paint_bounds);
+    }
+  }
+  return true;
+}
+
+static sk_sp<SkSurface> MakeSurface(GrDirectContext* gr_context,
+                                    const SkIRect& bounds,
+                                    SkColorSpace* color_space) {
+  const SkImageInfo image_info = SkImageInfo::MakeN32Premul(
+      bounds.width(), bounds.height(), sk_ref_sp(color_space));
+  if (gr_context) {
+    return SkSurface::MakeRenderTarget(gr_context, SkBudgeted::kYes,
+                                       image_info);
+  }
+  return SkSurface::MakeRaster(image_info);
+}
+
+ImageFilterCache::ImageFilterCache() = default;
+
+ImageFilterCache::~ImageFilterCache() = default;
+
+bool ImageFilterCache::Draw(
+    uint64_t layer_id,
+    const sk_sp<SkImageFilter>& filter,
+    const SkRect& children_bounds,
+    std::vector<Child> children,
+    const std::function<void(SkCanvas*)>& paint_children,
+    GrDirectContext* gr_context,
+    SkCanvas& canvas) {
+  SkMatrix matrix =
+      RasterCache::GetSubpixelBucketCTM(canvas.getTotalMatrix());
+  if (!filter || !matrix.isScaleTranslate() || !matrix.invert(nullptr)) {
+    return false;
+  }
+  auto it = entries_.find(layer_id);
+  if (it == entries_.end()) {
+    entries_[layer_id].used_this_frame = true;
+    return false;
+  }
+  Entry& entry = it->second;
+  entry.used_this_frame = true;
+
+  SkScalar translate_x = SkScalarFloorToScalar(matrix.getTranslateX());
+  SkScalar translate_y = SkScalarFloorToScalar(matrix.getTranslateY());
+  SkMatrix local_matrix = matrix;
+  local_matrix.postTranslate(-translate_x, -translate_y);
+  sk_sp<SkImageFilter> local_filter = filter->makeWithLocalMatrix(local_matrix);
+  if (!local_filter) {
+    return false;
+  }
+  SkIRect bounds = local_filter->filterBounds(
+      RasterCache::GetDeviceBounds(children_bounds, local_matrix),
+      SkMatrix::I(), SkImageFilter::kForward_MapDirection);
+  if (bounds.isEmpty()) {
+    return false;
+  }
+
+  SkIRect dirty_bounds = bounds;
+  SkRect changed_bounds;
+  if (entry.surface && entry.bounds == bounds &&
+      entry.matrix == local_matrix && entry.filter == filter &&
+      GetChangedBounds(entry.children, children, &changed_bounds)) {
+    if (changed_bounds.isEmpty()) {
+      dirty_bounds.setEmpty();
+    } else {
+      // The filter spreads the replaced children over the pixels around
+      // them.
+      dirty_bounds = local_filter->filterBounds(
+          RasterCache::GetDeviceBounds(changed_bounds, local_matrix),
+          SkMatrix::I(), SkImageFilter::kForward_MapDirection);
+      if (!dirty_bounds.intersect(bounds)) {
+        dirty_bounds.setEmpty();
+      }
+    }
+  }
+
+  if (!dirty_bounds.isEmpty()) {
+    TRACE_EVENT0("flutter", "ImageFilterCache::FilterChildren");
+    if (!entry.surface || entry.surface->width() != bounds.width() ||
+        entry.surface->height() != bounds.height()) {
+      entry.surface =
+          MakeSurface(gr_context, bounds, canvas.imageInfo().colorSpace());
+      if (!entry.surface) {
+        entries_.erase(it);
+        return false;
+      }
+    }
+    SkCanvas* cache_canvas = entry.surface->getCanvas();
+    SkAutoCanvasRestore auto_restore(cache_canvas, true);
+    cache_canvas->translate(-bounds.left(), -bounds.top());
+    cache_canvas->clipRect(SkRect::Make(dirty_bounds));
+    cache_canvas->clear(SK_ColorTRANSPARENT);
+    cache_canvas->concat(local_matrix);
+    // As when the layer paints its children itself, the filter is applied
+    // by a save layer, which reads the children around the dirty bounds
+    // that the filter spreads into them.
+    SkPaint paint;
+    paint.setImageFilter(filter);
+    cache_canvas->saveLayer(&children_bounds, &paint);
+    paint_children(cache_canvas);
+    cache_canvas->restore();
+    filtered_pixel_count_ +=
+        static_cast<int64_t>(dirty_bounds.width()) * dirty_bounds.height();
+
+    entry.matrix = local_matrix;
+    entry.filter = filter;
+    entry.bounds = bounds;
+  } else {
+    TRACE_EVENT_INSTANT0("flutter", "image filter cache hit");
+  }
+  entry.children = std::move(children);
+
+  SkAutoCanvasRestore auto_restore(&canvas, true);
+  canvas.resetMatrix();
+  canvas.drawImage(entry.surface->makeImageSnapshot(),
+                   translate_x + bounds.left(), translate_y + bounds.top());
+  return true;
+}
+
+void ImageFilterCache::CleanupAfterFrame() {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.used_this_frame) {
+      it->second.used_this_frame = false;
+      ++it;
+    } else {
+      it = entries_.erase(it);
+    }
+  }
+}
+
+void ImageFilterCache::Clear() {
+  entries_.clear();
+}
+
+size_t ImageFilterCache::EstimateByteSize() const {
+  size_t bytes = 0;
+  for (const auto& item : entries_) {
+    if (item.second.surface) {
+      bytes += item.second.surface->imageInfo().computeMinByteSize();
+    }
+  }
+  return bytes;
+}
+
+}  // namespace flutter
@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_IMAGE_FILTER_CACHE_H_
+#define FLUTTER_FLOW_IMAGE_FILTER_CACHE_H_
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkImageFilter.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+
+namespace flutter {
+
+// Keeps the filtered children painted by the ImageFilterLayers of the last
+// frame so that the layers can draw them again instead of filtering their
+// children in every frame.
+//
+// The filtered children are kept without the integral part of the
+// translation of the layer, so that they are reused while the layer moves.
+// The layers are identified by their original layer id, which is kept by
+// the layers that replace them in the following frames, and their children
+// by their unique id. Since the layers are immutable, the children that are
+// the same layers as in the last frame paint the same content. When only
+// some of them were replaced, only the part of the filtered children that
+// the replaced ones cover is filtered again.
+//
+// All of the methods are called on the raster thread.
+class ImageFilterCache {
+ public:
+  // A child of an ImageFilterLayer, with its paint bounds in the
+  // coordinates of the layer.
+  struct Child {
+    uint64_t unique_id;
+    SkRect paint_bounds;
+  };
+
+  ImageFilterCache();
+
+  ~ImageFilterCache();
+
+  // Draws the children of the layer with |layer_id| filtered with |filter|
+  // into |canvas| at its current matrix, filtering them again only where
+  // they changed since the last frame.
+  //
+  // |children_bounds| is the union of the paint bounds of |children|, and
+  // |paint_children| paints them into the canvas it is given.
+  //
+  // Returns false, in which case the layer paints its children itself,
+  // during the first frame in which the layer is painted, so that the
+  // layers that are painted in a single frame are not filtered twice, and
+  // when the filtered children can not be kept.
+  bool Draw(uint64_t layer_id,
+            const sk_sp<SkImageFilter>& filter,
+            const SkRect& children_bounds,
+            std::vector<Child> children,
+            const std::function<void(SkCanvas*)>& paint_children,
+            GrDirectContext* gr_context,
+            SkCanvas& canvas);
+
+  // Evicts the filtered children of the layers that were not painted since
+  // the last call.
+  void CleanupAfterFrame();
+
+  void Clear();
+
+  size_t GetCachedEntriesCount() const { return entries_.size(); }
+
+  // The memory used by the filtered children, in bytes.
+  size_t EstimateByteSize() const;
+
+  // The number of device pixels filtered again by |Draw| since the cache
+  // was created, for tests.
+  int64_t filtered_pixel_count() const { return filtered_pixel_count_; }
+
+ private:
+  struct Entry {
+    // The matrix the children were filtered with, the integral part of its
+    // translation removed.
+    SkMatrix matrix;
+    sk_sp<SkImageFilter> filter;
+    std::vector<Child> children;
+    // The filtered children, whose top left corner is at |bounds| under
+    // |matrix|. Null until the second frame in which the layer is painted.
+    sk_sp<SkSurface> surface;
+    SkIRect bounds;
+    bool used_this_frame = false;
+  };
+
+  std::unordered_map<uint64_t, Entry> entries_;
+  int64_t filtered_pixel_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ImageFilterCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_IMAGE_FILTER_CACHE_H_
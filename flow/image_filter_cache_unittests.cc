@@ -0,0 +1,158 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/image_filter_cache.h"
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/effects/SkImageFilters.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Two children that paint the rects of their paint bounds.
+class Children {
+ public:
+  Children() : children_({{1, SkRect::MakeLTRB(0, 0, 10, 10)},
+                          {2, SkRect::MakeLTRB(40, 0, 50, 10)}}) {}
+
+  void Replace(size_t index, uint64_t unique_id) {
+    children_[index].unique_id = unique_id;
+  }
+
+  SkRect bounds() const {
+    SkRect bounds = SkRect::MakeEmpty();
+    for (const auto& child : children_) {
+      bounds.join(child.paint_bounds);
+    }
+    return bounds;
+  }
+
+  bool Draw(ImageFilterCache& cache,
+            const sk_sp<SkImageFilter>& filter,
+            SkCanvas& canvas) {
+    return cache.Draw(
+        1, filter, bounds(), children_,
+        [this](SkCanvas* canvas) {
+          paint_count_++;
+          for (const auto& child : children_) {
+            canvas->drawRect(child.paint_bounds, SkPaint());
+          }
+        },
+        nullptr, canvas);
+  }
+
+  int paint_count() const { return paint_count_; }
+
+ private:
+  std::vector<ImageFilterCache::Child> children_;
+  int paint_count_ = 0;
+};
+
+}  // namespace
+
+TEST(ImageFilterCache, FirstFrameIsNotCached) {
+  ImageFilterCache cache;
+  Children children;
+  sk_sp<SkImageFilter> filter = SkImageFilters::Blur(2, 2, nullptr);
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(100, 100);
+
+  EXPECT_FALSE(children.Draw(cache, filter, *surface->getCanvas()));
+  EXPECT_EQ(children.paint_count(), 0);
+  cache.CleanupAfterFrame();
+  EXPECT_EQ(cache.GetCachedEntriesCount(), 1u);
+  EXPECT_EQ(cache.EstimateByteSize(), 0u);
+
+  EXPECT_TRUE(children.Draw(cache, filter, *surface->getCanvas()));
+  EXPECT_EQ(children.paint_count(), 1);
+  EXPECT_GT(cache.EstimateByteSize(), 0u);
+}
+
+TEST(ImageFilterCache, FilteredChildrenAreReusedUnderTranslation) {
+  ImageFilterCache cache;
+  Children children;
+  sk_sp<SkImageFilter> filter = SkImageFilters::Blur(2, 2, nullptr);
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(100, 100);
+  SkCanvas* canvas = surface->getCanvas();
+
+  EXPECT_FALSE(children.Draw(cache, filter, *canvas));
+  cache.CleanupAfterFrame();
+  EXPECT_TRUE(children.Draw(cache, filter, *canvas));
+  cache.CleanupAfterFrame();
+  int64_t filtered_pixel_count = cache.filtered_pixel_count();
+  EXPECT_GT(filtered_pixel_count, 0);
+
+  canvas->clear(SK_ColorTRANSPARENT);
+  canvas->translate(20, 30);
+  EXPECT_TRUE(children.Draw(cache, filter, *canvas));
+  cache.CleanupAfterFrame();
+  EXPECT_EQ(children.paint_count(), 1);
+  EXPECT_EQ(cache.filtered_pixel_count(), filtered_pixel_count);
+
+  // The center of the first child, which the blur leaves nearly opaque.
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(1, 1);
+  ASSERT_TRUE(surface->readPixels(bitmap, 25, 35));
+  EXPECT_GT(SkColorGetA(bitmap.getColor(0, 0)), 0xF0u);
+  ASSERT_TRUE(surface->readPixels(bitmap, 5, 5));
+  EXPECT_EQ(SkColorGetA(bitmap.getColor(0, 0)), 0u);
+}
+
+TEST(ImageFilterCache, OnlyReplacedChildrenAreFilteredAgain) {
+  ImageFilterCache cache;
+  Children children;
+  sk_sp<SkImageFilter> filter = SkImageFilters::Blur(2, 2, nullptr);
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(100, 100);
+
+  EXPECT_FALSE(children.Draw(cache, filter, *surface->getCanvas()));
+  cache.CleanupAfterFrame();
+  EXPECT_TRUE(children.Draw(cache, filter, *surface->getCanvas()));
+  cache.CleanupAfterFrame();
+  int64_t filtered_pixel_count = cache.filtered_pixel_count();
+
+  children.Replace(1, 3);
+  EXPECT_TRUE(children.Draw(cache, filter, *surface->getCanvas()));
+  EXPECT_EQ(children.paint_count(), 2);
+  int64_t refiltered_pixel_count =
+      cache.filtered_pixel_count() - filtered_pixel_count;
+  EXPECT_GT(refiltered_pixel_count, 0);
+  EXPECT_LT(refiltered_pixel_count, filtered_pixel_count / 2);
+}
+
+TEST(ImageFilterCache, ChangedFilterFiltersEverything) {
+  ImageFilterCache cache;
+  Children children;
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(100, 100);
+
+  EXPECT_FALSE(children.Draw(cache, SkImageFilters::Blur(2, 2, nullptr),
+                             *surface->getCanvas()));
+  cache.CleanupAfterFrame();
+  EXPECT_TRUE(children.Draw(cache, SkImageFilters::Blur(2, 2, nullptr),
+                            *surface->getCanvas()));
+  cache.CleanupAfterFrame();
+  int64_t filtered_pixel_count = cache.filtered_pixel_count();
+
+  EXPECT_TRUE(children.Draw(cache, SkImageFilters::Blur(2, 2, nullptr),
+                            *surface->getCanvas()));
+  EXPECT_EQ(children.paint_count(), 2);
+  EXPECT_EQ(cache.filtered_pixel_count(), 2 * filtered_pixel_count);
+}
+
+TEST(ImageFilterCache, UnpaintedLayersAreEvicted) {
+  ImageFilterCache cache;
+  Children children;
+  sk_sp<SkImageFilter> filter = SkImageFilters::Blur(2, 2, nullptr);
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(100, 100);
+
+  EXPECT_FALSE(children.Draw(cache, filter, *surface->getCanvas()));
+  cache.CleanupAfterFrame();
+  EXPECT_EQ(cache.GetCachedEntriesCount(), 1u);
+  cache.CleanupAfterFrame();
+  EXPECT_EQ(cache.GetCachedEntriesCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
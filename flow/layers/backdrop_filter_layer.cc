@@ -4,6 +4,10 @@
 
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 
+#include "flutter/flow/backdrop_filter_cache.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+
 namespace flutter {
 
 BackdropFilterLayer::BackdropFilterLayer(sk_sp<SkImageFilter> filter,
@@ -30,6 +34,12 @@ void BackdropFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
     auto filter_bounds =  // in screen coordinates
         filter_->filterBounds(input_filter_bounds, context->GetTransform(),
                               SkImageFilter::kReverse_MapDirection);
+    // The backdrop of this frame is the result of painting the layers
+    // diffed so far.
+    if (prev && !context->IsSubtreeDirty() &&
+        !context->IsDamaged(SkRect::Make(filter_bounds))) {
+      context->MarkBackdropUnchanged(this);
+    }
     context->AddReadbackRegion(filter_bounds);
   }
 
@@ -40,10 +50,14 @@ void BackdropFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
 
 void BackdropFilterLayer::Preroll(PrerollContext* context,
                                   const SkMatrix& matrix) {
+  paints_onto_surface_ = !context->in_save_layer;
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context, true, bool(filter_));
   SkRect child_paint_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, matrix, &child_paint_bounds);
+  // The children are drawn in a saveLayer, whose content is not known to
+  // stay opaque when it is composited.
+  set_opaque_device_bounds(SkIRect::MakeEmpty());
   child_paint_bounds.join(context->cull_rect);
   set_paint_bounds(child_paint_bounds);
 }
@@ -52,6 +66,10 @@ void BackdropFilterLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "BackdropFilterLayer::Paint");
   FML_DCHECK(needs_painting(context));
 
+  if (PaintCachedBackdrop(context)) {
+    return;
+  }
+
   SkPaint paint;
   paint.setBlendMode(blend_mode_);
   Layer::AutoSaveLayer save = Layer::AutoSaveLayer::Create(
@@ -63,4 +81,68 @@ void BackdropFilterLayer::Paint(PaintContext& context) const {
   PaintChildren(context);
 }
 
+bool BackdropFilterLayer::PaintCachedBackdrop(PaintContext& context) const {
+  if (!context.backdrop_filter_cache || !filter_ || !paints_onto_surface_) {
+    return false;
+  }
+  SkCanvas* canvas = context.leaf_nodes_canvas;
+  SkSurface* surface = canvas->getSurface();
+  SkMatrix matrix = canvas->getTotalMatrix();
+  if (!surface || !matrix.isScaleTranslate()) {
+    return false;
+  }
+
+  SkIRect device_bounds = matrix.mapRect(paint_bounds()).roundOut();
+  SkIPoint origin;
+  sk_sp<SkImage> image = context.backdrop_filter_cache->Get(
+      original_layer_id(), device_bounds, matrix, &origin);
+  if (!image) {
+    TRACE_EVENT0("flutter", "BackdropFilterLayer::FilterBackdrop");
+    SkIRect input_bounds = filter_->filterBounds(
+        device_bounds, matrix, SkImageFilter::kReverse_MapDirection);
+    if (!input_bounds.intersect(
+            SkIRect::MakeWH(surface->width(), surface->height()))) {
+      return false;
+    }
+    sk_sp<SkImage> backdrop = surface->makeImageSnapshot(input_bounds);
+    if (!backdrop) {
+      return false;
+    }
+    // The filter is applied in the device space of the snapshot, whose
+    // origin is the top left corner of |input_bounds|.
+    SkMatrix filter_matrix = SkMatrix::Concat(
+        SkMatrix::Translate(-input_bounds.x(), -input_bounds.y()), matrix);
+    sk_sp<SkImageFilter> filter = filter_->makeWithLocalMatrix(filter_matrix);
+    SkIRect clip_bounds =
+        device_bounds.makeOffset(-input_bounds.x(), -input_bounds.y());
+    SkIRect out_subset;
+    SkIPoint offset;
+    image = backdrop->makeWithFilter(context.gr_context, filter.get(),
+                                     backdrop->bounds(), clip_bounds,
+                                     &out_subset, &offset);
+    if (image) {
+      image = image->makeSubset(out_subset, context.gr_context);
+    }
+    if (!image) {
+      return false;
+    }
+    origin = SkIPoint::Make(input_bounds.x() + offset.x(),
+                            input_bounds.y() + offset.y());
+    context.backdrop_filter_cache->Put(original_layer_id(), device_bounds,
+                                       matrix, image, origin);
+  }
+
+  SkPaint paint;
+  paint.setBlendMode(blend_mode_);
+  Layer::AutoSaveLayer save = Layer::AutoSaveLayer::Create(
+      context, paint_bounds(), &paint,
+      AutoSaveLayer::SaveMode::kLeafNodesCanvas);
+  canvas->save();
+  canvas->resetMatrix();
+  canvas->drawImage(image, origin.x(), origin.y());
+  canvas->restore();
+  PaintChildren(context);
+  return true;
+}
+
 }  // namespace flutter
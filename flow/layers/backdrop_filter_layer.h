@@ -21,8 +21,16 @@ class BackdropFilterLayer : public ContainerLayer {
   void Paint(PaintContext& context) const override;
 
  private:
+  // Draws the filtered backdrop from the cache of the context, filtering
+  // the backdrop and storing the result first if it is not cached. Returns
+  // false, having drawn nothing, if the backdrop cannot be cached.
+  bool PaintCachedBackdrop(PaintContext& context) const;
+
   sk_sp<SkImageFilter> filter_;
   SkBlendMode blend_mode_;
+  // Whether the layer is painted directly onto the surface of the frame,
+  // from which its backdrop can be snapshotted.
+  bool paints_onto_surface_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(BackdropFilterLayer);
 };
@@ -327,6 +327,44 @@ TEST_F(BackdropLayerDiffTest, BackdropLayer) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 190, 190));
 }
 
+TEST_F(BackdropLayerDiffTest, UnchangedBackdropIsReported) {
+  auto filter = SkImageFilters::Blur(10, 10, SkTileMode::kClamp, nullptr);
+  auto below = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeLTRB(0, 0, 10, 10)));
+  auto backdrop =
+      std::make_shared<BackdropFilterLayer>(filter, SkBlendMode::kSrcOver);
+  auto clip = std::make_shared<ClipRectLayer>(SkRect::MakeLTRB(20, 20, 60, 60),
+                                              Clip::hardEdge);
+  clip->Add(backdrop);
+
+  MockLayerTree l1(SkISize::Make(100, 100));
+  l1.root()->Add(below);
+  l1.root()->Add(clip);
+  auto damage = DiffLayerTree(l1, MockLayerTree(SkISize::Make(100, 100)));
+  EXPECT_TRUE(damage.unchanged_backdrops.empty());
+
+  // a layer painted above the backdrop still forces it to be repainted, but
+  // does not change what is filtered
+  MockLayerTree l2(SkISize::Make(100, 100));
+  l2.root()->Add(below);
+  l2.root()->Add(clip);
+  l2.root()->Add(std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeLTRB(50, 50, 70, 70))));
+  damage = DiffLayerTree(l2, l1);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 90, 90));
+  EXPECT_EQ(damage.unchanged_backdrops,
+            std::vector<uint64_t>{backdrop->original_layer_id()});
+
+  // a changed layer below the backdrop changes what is filtered
+  MockLayerTree l3(SkISize::Make(100, 100));
+  l3.root()->Add(std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeLTRB(0, 0, 10, 20))));
+  l3.root()->Add(clip);
+  damage = DiffLayerTree(l3, l2);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 90, 90));
+  EXPECT_TRUE(damage.unchanged_backdrops.empty());
+}
+
 TEST_F(BackdropLayerDiffTest, BackdropLayerInvalidTransform) {
   auto filter = SkImageFilters::Blur(10, 10, SkTileMode::kClamp, nullptr);
 
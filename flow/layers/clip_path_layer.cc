@@ -46,6 +46,17 @@ void ClipPathLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   if (child_paint_bounds.intersect(clip_path_bounds)) {
     set_paint_bounds(child_paint_bounds);
   }
+  // The children are only opaque inside of the clip, which is only tracked
+  // if it is a rect, and not once they are composited from a saveLayer, in
+  // which their blend modes may have made their opaque content transparent.
+  SkIRect opaque_bounds = opaque_device_bounds();
+  SkRect clip_rect;
+  if (UsesSaveLayer() || clip_path_.isInverseFillType() ||
+      !clip_path_.isRect(&clip_rect) ||
+      !opaque_bounds.intersect(OpaqueDeviceBounds(clip_rect, matrix))) {
+    opaque_bounds.setEmpty();
+  }
+  set_opaque_device_bounds(opaque_bounds);
 
   context->mutators_stack.Pop();
   context->cull_rect = previous_cull_rect;
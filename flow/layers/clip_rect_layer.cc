@@ -8,7 +8,9 @@
 namespace flutter {
 
 ClipRectLayer::ClipRectLayer(const SkRect& clip_rect, Clip clip_behavior)
-    : clip_rect_(clip_rect), clip_behavior_(clip_behavior) {
+    : clip_rect_(clip_rect),
+      clip_behavior_(clip_behavior),
+      paint_clip_rect_(clip_rect) {
   FML_DCHECK(clip_behavior != Clip::none);
   set_layer_can_inherit_opacity(true);
 }
@@ -39,24 +41,74 @@ void ClipRectLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context, UsesSaveLayer());
   context->mutators_stack.PushClipRect(clip_rect_);
+  clip_merged_into_parent_ = false;
 
   SkRect child_paint_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, matrix, &child_paint_bounds);
   if (child_paint_bounds.intersect(clip_rect_)) {
     set_paint_bounds(child_paint_bounds);
   }
+  // The children are only opaque inside of the clip, and not once they are
+  // composited from a saveLayer, in which their blend modes may have made
+  // their opaque content transparent.
+  SkIRect opaque_bounds = opaque_device_bounds();
+  if (UsesSaveLayer() ||
+      !opaque_bounds.intersect(OpaqueDeviceBounds(clip_rect_, matrix))) {
+    opaque_bounds.setEmpty();
+  }
+  set_opaque_device_bounds(opaque_bounds);
+
+  MergeChildClip();
+  preroll_matrix_ = matrix;
+  paint_clip_is_pixel_aligned_ = clip_behavior_ != Clip::hardEdge &&
+                                 IsPixelAligned(paint_clip_rect_, matrix);
+  if (paint_clip_is_pixel_aligned_) {
+    TRACE_EVENT_INSTANT0("flutter", "pixel aligned clip rect");
+  }
 
   context->mutators_stack.Pop();
   context->cull_rect = previous_cull_rect;
 }
 
+void ClipRectLayer::MergeChildClip() {
+  paint_clip_rect_ = clip_rect_;
+  // The embedder clips platform views with the mutators of each layer.
+  if (layers().size() != 1 || UsesSaveLayer() ||
+      subtree_has_platform_view()) {
+    return;
+  }
+  Layer* child_layer = layers().front().get();
+  if (!child_layer->as_clip_rect_layer()) {
+    return;
+  }
+  auto* child = static_cast<ClipRectLayer*>(child_layer);
+  if (child->clip_behavior_ != clip_behavior_) {
+    return;
+  }
+  TRACE_EVENT_INSTANT0("flutter", "merged child clip rect");
+  if (!paint_clip_rect_.intersect(child->paint_clip_rect_)) {
+    paint_clip_rect_.setEmpty();
+  }
+  child->clip_merged_into_parent_ = true;
+}
+
 void ClipRectLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "ClipRectLayer::Paint");
   FML_DCHECK(needs_painting(context));
 
+  if (clip_merged_into_parent_) {
+    PaintChildren(context);
+    return;
+  }
+
   SkAutoCanvasRestore save(context.internal_nodes_canvas, true);
-  context.internal_nodes_canvas->clipRect(clip_rect_,
-                                          clip_behavior_ != Clip::hardEdge);
+  // The canvas has another matrix when the layer is painted into the raster
+  // cache of a parent.
+  bool anti_alias = clip_behavior_ != Clip::hardEdge &&
+                    !(paint_clip_is_pixel_aligned_ &&
+                      context.internal_nodes_canvas->getTotalMatrix() ==
+                          preroll_matrix_);
+  context.internal_nodes_canvas->clipRect(paint_clip_rect_, anti_alias);
 
   if (!UsesSaveLayer()) {
     PaintChildren(context);
@@ -22,9 +22,26 @@ class ClipRectLayer : public ContainerLayer {
     return clip_behavior_ == Clip::antiAliasWithSaveLayer;
   }
 
+  const ClipRectLayer* as_clip_rect_layer() const override { return this; }
+
  private:
+  // Merges the clip of the only child into the clip of this layer, if the
+  // child is a ClipRectLayer with the same clip behavior.
+  void MergeChildClip();
+
   SkRect clip_rect_;
   Clip clip_behavior_;
+  // The rect that Paint clips to, which includes the clips of the children
+  // merged into this layer.
+  SkRect paint_clip_rect_;
+  // Whether the parent clips to the clip of this layer, in which case Paint
+  // does not clip again.
+  bool clip_merged_into_parent_ = false;
+  // Whether |paint_clip_rect_| is pixel aligned with the matrix that the
+  // layer was prerolled with, in which case the clip is painted without
+  // anti-aliasing when the canvas has that matrix.
+  bool paint_clip_is_pixel_aligned_ = false;
+  SkMatrix preroll_matrix_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ClipRectLayer);
 };
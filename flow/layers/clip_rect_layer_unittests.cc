@@ -195,6 +195,65 @@ TEST_F(ClipRectLayerTest, PartiallyContainedChild) {
            MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
 }
 
+TEST_F(ClipRectLayerTest, PixelAlignedClipIsHardEdge) {
+  const SkRect child_bounds = SkRect::MakeXYWH(2.0, 2.0, 2.0, 2.0);
+  const SkPath child_path = SkPath().addRect(child_bounds);
+  auto clip_edge_style = [this, &child_path](const SkRect& clip_rect,
+                                             const SkMatrix& matrix) {
+    auto layer = std::make_shared<ClipRectLayer>(clip_rect, Clip::antiAlias);
+    layer->Add(std::make_shared<MockLayer>(child_path));
+    layer->Preroll(preroll_context(), matrix);
+    MockCanvas canvas;
+    PaintContext context = paint_context();
+    context.internal_nodes_canvas = &canvas;
+    context.leaf_nodes_canvas = &canvas;
+    layer->Paint(context);
+    return std::get<MockCanvas::ClipRectData>(canvas.draw_calls()[1].data)
+        .style;
+  };
+
+  EXPECT_EQ(clip_edge_style(SkRect::MakeXYWH(1.0, 1.0, 5.0, 6.0), SkMatrix()),
+            MockCanvas::kHard_ClipEdgeStyle);
+  EXPECT_EQ(clip_edge_style(SkRect::MakeXYWH(1.5, 1.0, 5.0, 6.0), SkMatrix()),
+            MockCanvas::kSoft_ClipEdgeStyle);
+  // The clip is only pixel aligned with the matrix it was prerolled with.
+  EXPECT_EQ(clip_edge_style(SkRect::MakeXYWH(1.5, 1.0, 5.0, 6.0),
+                            SkMatrix::Translate(0.5f, 0.0f)),
+            MockCanvas::kSoft_ClipEdgeStyle);
+}
+
+TEST_F(ClipRectLayerTest, NestedClipsAreMerged) {
+  const SkRect child_bounds = SkRect::MakeXYWH(6.0, 6.0, 4.0, 4.0);
+  const SkRect parent_clip = SkRect::MakeLTRB(0.0, 0.0, 20.0, 20.0);
+  const SkRect child_clip = SkRect::MakeLTRB(5.0, 5.0, 30.0, 30.0);
+  const SkPath child_path = SkPath().addRect(child_bounds);
+  const SkPaint child_paint = SkPaint(SkColors::kYellow);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  auto child_clip_layer =
+      std::make_shared<ClipRectLayer>(child_clip, Clip::antiAlias);
+  auto parent_clip_layer =
+      std::make_shared<ClipRectLayer>(parent_clip, Clip::antiAlias);
+  parent_clip_layer->Add(child_clip_layer);
+  child_clip_layer->Add(mock_layer);
+
+  parent_clip_layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(mock_layer->parent_mutators(),
+            std::vector({Mutator(parent_clip), Mutator(child_clip)}));
+
+  parent_clip_layer->Paint(paint_context());
+  EXPECT_EQ(mock_canvas().draw_calls(),
+            std::vector({MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+                         MockCanvas::DrawCall{
+                             1, MockCanvas::ClipRectData{
+                                    SkRect::MakeLTRB(5.0, 5.0, 20.0, 20.0),
+                                    SkClipOp::kIntersect,
+                                    MockCanvas::kHard_ClipEdgeStyle}},
+                         MockCanvas::DrawCall{
+                             1, MockCanvas::DrawPathData{child_path,
+                                                         child_paint}},
+                         MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
+}
+
 static bool ReadbackResult(PrerollContext* context,
                            Clip clip_behavior,
                            std::shared_ptr<Layer> child,
@@ -46,6 +46,24 @@ void ClipRRectLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   if (child_paint_bounds.intersect(clip_rrect_bounds)) {
     set_paint_bounds(child_paint_bounds);
   }
+  // The children are only opaque inside of the clip, which is only tracked
+  // if it is a rect, and not once they are composited from a saveLayer, in
+  // which their blend modes may have made their opaque content transparent.
+  SkIRect opaque_bounds = opaque_device_bounds();
+  if (UsesSaveLayer() || !clip_rrect_.isRect() ||
+      !opaque_bounds.intersect(
+          OpaqueDeviceBounds(clip_rrect_.rect(), matrix))) {
+    opaque_bounds.setEmpty();
+  }
+  set_opaque_device_bounds(opaque_bounds);
+
+  preroll_matrix_ = matrix;
+  clip_is_pixel_aligned_ = clip_behavior_ != Clip::hardEdge &&
+                           clip_rrect_.isRect() &&
+                           IsPixelAligned(clip_rrect_.rect(), matrix);
+  if (clip_is_pixel_aligned_) {
+    TRACE_EVENT_INSTANT0("flutter", "pixel aligned clip rrect");
+  }
 
   context->mutators_stack.Pop();
   context->cull_rect = previous_cull_rect;
@@ -56,8 +74,13 @@ void ClipRRectLayer::Paint(PaintContext& context) const {
   FML_DCHECK(needs_painting(context));
 
   SkAutoCanvasRestore save(context.internal_nodes_canvas, true);
-  context.internal_nodes_canvas->clipRRect(clip_rrect_,
-                                           clip_behavior_ != Clip::hardEdge);
+  // The canvas has another matrix when the layer is painted into the raster
+  // cache of a parent.
+  bool anti_alias = clip_behavior_ != Clip::hardEdge &&
+                    !(clip_is_pixel_aligned_ &&
+                      context.internal_nodes_canvas->getTotalMatrix() ==
+                          preroll_matrix_);
+  context.internal_nodes_canvas->clipRRect(clip_rrect_, anti_alias);
 
   if (!UsesSaveLayer()) {
     PaintChildren(context);
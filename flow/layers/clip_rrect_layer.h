@@ -26,6 +26,11 @@ class ClipRRectLayer : public ContainerLayer {
  private:
   SkRRect clip_rrect_;
   Clip clip_behavior_;
+  // Whether the clip is a rect that is pixel aligned with the matrix that
+  // the layer was prerolled with, in which case the clip is painted without
+  // anti-aliasing when the canvas has that matrix.
+  bool clip_is_pixel_aligned_ = false;
+  SkMatrix preroll_matrix_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ClipRRectLayer);
 };
@@ -199,6 +199,30 @@ TEST_F(ClipRRectLayerTest, PartiallyContainedChild) {
            MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
 }
 
+TEST_F(ClipRRectLayerTest, PixelAlignedRectClipIsHardEdge) {
+  const SkRect child_bounds = SkRect::MakeXYWH(2.0, 2.0, 2.0, 2.0);
+  const SkPath child_path = SkPath().addRect(child_bounds);
+  auto clip_edge_style = [this, &child_path](const SkRRect& clip_rrect) {
+    auto layer = std::make_shared<ClipRRectLayer>(clip_rrect, Clip::antiAlias);
+    layer->Add(std::make_shared<MockLayer>(child_path));
+    layer->Preroll(preroll_context(), SkMatrix());
+    MockCanvas canvas;
+    PaintContext context = paint_context();
+    context.internal_nodes_canvas = &canvas;
+    context.leaf_nodes_canvas = &canvas;
+    layer->Paint(context);
+    return std::get<MockCanvas::ClipRRectData>(canvas.draw_calls()[1].data)
+        .style;
+  };
+
+  const SkRect clip_rect = SkRect::MakeXYWH(1.0, 1.0, 5.0, 6.0);
+  EXPECT_EQ(clip_edge_style(SkRRect::MakeRect(clip_rect)),
+            MockCanvas::kHard_ClipEdgeStyle);
+  // The rounded corners are anti-aliased.
+  EXPECT_EQ(clip_edge_style(SkRRect::MakeRectXY(clip_rect, 1.0, 1.0)),
+            MockCanvas::kSoft_ClipEdgeStyle);
+}
+
 static bool ReadbackResult(PrerollContext* context,
                            Clip clip_behavior,
                            std::shared_ptr<Layer> child,
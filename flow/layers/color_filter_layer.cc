@@ -29,6 +29,8 @@ void ColorFilterLayer::Preroll(PrerollContext* context,
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context);
   ContainerLayer::Preroll(context, matrix);
+  // The filter may change the alpha of the children.
+  set_opaque_device_bounds(SkIRect::MakeEmpty());
 }
 
 void ColorFilterLayer::Paint(PaintContext& context) const {
@@ -6,6 +6,8 @@
 
 #include <optional>
 
+#include "flutter/fml/synchronization/count_down_latch.h"
+
 namespace flutter {
 
 ContainerLayer::ContainerLayer() {}
@@ -28,6 +30,7 @@ void ContainerLayer::DiffChildren(DiffContext* context,
                                   const ContainerLayer* old_layer) {
   if (context->IsSubtreeDirty()) {
     for (auto& layer : layers_) {
+      context->statistics().AddDiffedLayer();
       layer->Diff(context, nullptr);
     }
     return;
@@ -91,13 +94,16 @@ void ContainerLayer::DiffChildren(DiffContext* context,
         // associate their paint region with current layer tree so that we can
         // retrieve it in next frame diff
         layer->PreservePaintRegion(context);
+        context->statistics().AddRetainedLayer();
       } else {
+        context->statistics().AddDiffedLayer();
         layer->Diff(context, prev_layer.get());
       }
     } else {
       DiffContext::AutoSubtreeRestore subtree(context);
       context->MarkSubtreeDirty();
       auto layer = layers_[i];
+      context->statistics().AddDiffedLayer();
       layer->Diff(context, nullptr);
     }
   }
@@ -134,11 +140,20 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   // Platform views have no children, so context->has_platform_view should
   // always be false.
   FML_DCHECK(!context->has_platform_view);
+  if (context->concurrent_task_runner &&
+      layers_.size() >= kMinConcurrentPrerollChildren &&
+      PrepareForConcurrentPreroll()) {
+    PrerollChildrenConcurrently(context, child_matrix, child_paint_bounds);
+    return;
+  }
   bool child_has_platform_view = false;
   bool child_has_texture_layer = false;
   bool subtree_can_inherit_opacity = layer_can_inherit_opacity();
+  bool surface_needs_readback = context->surface_needs_readback;
+  std::vector<size_t> surface_reading_children;
 
-  for (auto& layer : layers_) {
+  for (size_t i = 0; i < layers_.size(); i++) {
+    Layer* layer = layers_[i].get();
     // Reset context->has_platform_view to false so that layers aren't treated
     // as if they have a platform view based on one being previously found in a
     // sibling tree.
@@ -146,9 +161,17 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     // Initialize the "inherit opacity" flag to the value recorded in the layer
     // and allow it to override the answer during its |Preroll|
     context->subtree_can_inherit_opacity = layer->layer_can_inherit_opacity();
+    // Reset context->surface_needs_readback to find out which children
+    // read back the surface, which the culling of occluded children needs.
+    context->surface_needs_readback = false;
 
     layer->Preroll(context, child_matrix);
 
+    if (context->surface_needs_readback) {
+      surface_reading_children.push_back(i);
+      surface_needs_readback = true;
+    }
+
     subtree_can_inherit_opacity =
         subtree_can_inherit_opacity && context->subtree_can_inherit_opacity;
     if (subtree_can_inherit_opacity &&
@@ -169,7 +192,180 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   context->has_platform_view = child_has_platform_view;
   context->has_texture_layer = child_has_texture_layer;
   context->subtree_can_inherit_opacity = subtree_can_inherit_opacity;
+  context->surface_needs_readback = surface_needs_readback;
   set_subtree_has_platform_view(child_has_platform_view);
+  CullOccludedChildren(child_matrix, surface_reading_children,
+                       child_has_platform_view);
+}
+
+static int64_t Area(const SkIRect& rect) {
+  return rect.isEmpty() ? 0
+                         : static_cast<int64_t>(rect.width()) * rect.height();
+}
+
+void ContainerLayer::CullOccludedChildren(
+    const SkMatrix& child_matrix,
+    const std::vector<size_t>& surface_reading_children,
+    bool child_has_platform_view) {
+  // The opaque content of the children is accumulated from the top child
+  // down. Only the largest opaque rect is kept since the union of two rects
+  // is usually not a rect, which is enough for the full screen routes that
+  // hide the ones below them.
+  SkIRect occluder = SkIRect::MakeEmpty();
+  auto reading_child = surface_reading_children.rbegin();
+  for (size_t i = layers_.size(); i-- > 0;) {
+    Layer* layer = layers_[i].get();
+    SkIRect device_bounds =
+        child_matrix.mapRect(layer->paint_bounds()).roundOut();
+    bool occluded = !occluder.isEmpty() && !layer->is_empty() &&
+                    occluder.contains(device_bounds);
+    layer->set_occluded(occluded);
+    if (occluded) {
+      continue;
+    }
+    if (reading_child != surface_reading_children.rend() &&
+        *reading_child == i) {
+      // The content below a child that reads back the surface, such as a
+      // backdrop filter, shows through it.
+      occluder.setEmpty();
+      reading_child++;
+    }
+    // The embedders composite the platform views and the content above and
+    // below them on separate surfaces.
+    if (!child_has_platform_view &&
+        Area(layer->opaque_device_bounds()) > Area(occluder)) {
+      occluder = layer->opaque_device_bounds();
+    }
+  }
+  set_opaque_device_bounds(occluder);
+}
+
+SkIRect ContainerLayer::OpaqueDeviceBounds(const SkRect& rect,
+                                           const SkMatrix& matrix) {
+  if (!matrix.rectStaysRect()) {
+    return SkIRect::MakeEmpty();
+  }
+  // The anti-aliased edges of the rect are not opaque, and the content may
+  // be drawn up to a pixel away from where it was prerolled once the raster
+  // cache snaps its matrix to integral translations.
+  SkIRect bounds = matrix.mapRect(rect).makeInset(1, 1).roundIn();
+  return bounds.isEmpty() ? SkIRect::MakeEmpty() : bounds;
+}
+
+bool ContainerLayer::IsPixelAligned(const SkRect& rect,
+                                    const SkMatrix& matrix) {
+  // Edges closer than this to a pixel boundary leave less than one level of
+  // coverage to anti-aliasing.
+  constexpr SkScalar kPixelAlignmentTolerance = 1.0f / 256;
+  if (!matrix.isScaleTranslate()) {
+    return false;
+  }
+  SkRect device_rect = matrix.mapRect(rect);
+  for (SkScalar edge : {device_rect.fLeft, device_rect.fTop,
+                        device_rect.fRight, device_rect.fBottom}) {
+    if (!SkScalarNearlyEqual(edge, SkScalarRoundToScalar(edge),
+                             kPixelAlignmentTolerance)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ContainerLayer::PrepareForConcurrentPreroll() {
+  for (auto& layer : layers_) {
+    if (!layer->PrepareForConcurrentPreroll()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+namespace {
+
+// The state that the Preroll of a child accumulates on a worker thread.
+struct ConcurrentChildPreroll {
+  MutatorsStack mutators_stack;
+  std::vector<RasterCache::DeferredCall> raster_cache_calls;
+  bool surface_needs_readback = false;
+  bool subtree_can_inherit_opacity = false;
+};
+
+}  // namespace
+
+void ContainerLayer::PrerollChildrenConcurrently(PrerollContext* context,
+                                                 const SkMatrix& child_matrix,
+                                                 SkRect* child_paint_bounds) {
+  TRACE_EVENT0("flutter", "ContainerLayer::PrerollChildrenConcurrently");
+  std::vector<ConcurrentChildPreroll> prerolls(layers_.size());
+  auto preroll_child = [this, context, &child_matrix, &prerolls](size_t i) {
+    ConcurrentChildPreroll& preroll = prerolls[i];
+    // The mutators and the view embedder are only used by platform views,
+    // which are never prerolled concurrently.
+    PrerollContext child_context = {
+        context->raster_cache,
+        context->gr_context,
+        nullptr,
+        preroll.mutators_stack,
+        context->dst_color_space,
+        context->cull_rect,
+        false,
+        context->raster_time,
+        context->ui_time,
+        context->texture_registry,
+        context->checkerboard_offscreen_layers,
+        context->frame_device_pixel_ratio};
+    child_context.has_texture_layer = context->has_texture_layer;
+    child_context.in_save_layer = context->in_save_layer;
+    child_context.subtree_can_inherit_opacity =
+        layers_[i]->layer_can_inherit_opacity();
+    child_context.deferred_raster_cache_calls = &preroll.raster_cache_calls;
+    layers_[i]->Preroll(&child_context, child_matrix);
+    preroll.surface_needs_readback = child_context.surface_needs_readback;
+    preroll.subtree_can_inherit_opacity =
+        child_context.subtree_can_inherit_opacity;
+  };
+  // The first child is prerolled by this thread while it would otherwise
+  // wait for the others.
+  fml::CountDownLatch latch(layers_.size() - 1);
+  for (size_t i = 1; i < layers_.size(); i++) {
+    context->concurrent_task_runner->PostTask([&preroll_child, &latch, i]() {
+      preroll_child(i);
+      latch.CountDown();
+    });
+  }
+  preroll_child(0);
+  latch.Wait();
+
+  // Merge the results in the order of the children so that the outcome
+  // does not depend on the order in which the tasks finished.
+  bool subtree_can_inherit_opacity = layer_can_inherit_opacity();
+  std::vector<size_t> surface_reading_children;
+  for (size_t i = 0; i < layers_.size(); i++) {
+    const Layer* layer = layers_[i].get();
+    ConcurrentChildPreroll& preroll = prerolls[i];
+    if (preroll.surface_needs_readback) {
+      surface_reading_children.push_back(i);
+    }
+    subtree_can_inherit_opacity =
+        subtree_can_inherit_opacity && preroll.subtree_can_inherit_opacity;
+    if (subtree_can_inherit_opacity &&
+        safe_intersection_test(child_paint_bounds, layer->paint_bounds())) {
+      subtree_can_inherit_opacity = false;
+    }
+    child_paint_bounds->join(layer->paint_bounds());
+    context->surface_needs_readback =
+        context->surface_needs_readback || preroll.surface_needs_readback;
+    // A concurrent subtree has no platform views, as checked by
+    // |PrepareForConcurrentPreroll|.
+    for (RasterCache::DeferredCall& call : preroll.raster_cache_calls) {
+      call(context);
+    }
+  }
+
+  context->has_platform_view = false;
+  context->subtree_can_inherit_opacity = subtree_can_inherit_opacity;
+  set_subtree_has_platform_view(false);
+  CullOccludedChildren(child_matrix, surface_reading_children, false);
 }
 
 void ContainerLayer::PaintChildren(PaintContext& context) const {
@@ -197,7 +393,7 @@ void ContainerLayer::TryToPrepareRasterCache(PrerollContext* context,
     context->raster_cache->Prepare(context, layer, matrix);
   } else if (context->raster_cache) {
     // Don't evict raster cache entry during partial repaint
-    context->raster_cache->Touch(layer, matrix);
+    context->raster_cache->Touch(context, layer, matrix);
   }
 }
 
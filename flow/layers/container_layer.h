@@ -23,8 +23,17 @@ class ContainerLayer : public Layer {
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) const override;
 
+  bool PrepareForConcurrentPreroll() override;
+
+  // The number of children from which |PrerollChildren| prerolls the
+  // children concurrently, if the |PrerollContext| has a
+  // |concurrent_task_runner|.
+  static constexpr size_t kMinConcurrentPrerollChildren = 4;
+
   const std::vector<std::shared_ptr<Layer>>& layers() const { return layers_; }
 
+  const ContainerLayer* as_container_layer() const override { return this; }
+
   virtual void DiffChildren(DiffContext* context,
                             const ContainerLayer* old_layer);
 
@@ -34,6 +43,16 @@ class ContainerLayer : public Layer {
                        SkRect* child_paint_bounds);
   void PaintChildren(PaintContext& context) const;
 
+  // Returns the device space bounds of the pixels that |rect| is sure to
+  // cover when it is filled with |matrix|, for the layers that fill a rect
+  // with opaque content. See |Layer::opaque_device_bounds|.
+  static SkIRect OpaqueDeviceBounds(const SkRect& rect, const SkMatrix& matrix);
+
+  // Returns whether the edges of |rect| fall on pixel boundaries once
+  // mapped with |matrix|, so that clipping to it with anti-aliasing or
+  // without covers the same pixels.
+  static bool IsPixelAligned(const SkRect& rect, const SkMatrix& matrix);
+
   // Try to prepare the raster cache for a given layer.
   //
   // The raster cache would fail if either of the followings is true:
@@ -49,6 +68,24 @@ class ContainerLayer : public Layer {
                                       const SkMatrix& matrix);
 
  private:
+  // Prerolls each child on the |concurrent_task_runner| of the |context|,
+  // with a task local PrerollContext, and then merges their results in
+  // the order of the children, as the serial |PrerollChildren| does.
+  void PrerollChildrenConcurrently(PrerollContext* context,
+                                   const SkMatrix& child_matrix,
+                                   SkRect* child_paint_bounds);
+
+  // Marks the children that are hidden behind the opaque content of the
+  // children above them as occluded, and sets the opaque device bounds of
+  // this layer to those of its children. The children at the indices in
+  // |surface_reading_children| read back the surface, so the content below
+  // them stays visible. Called at the end of |PrerollChildren|, after which
+  // the layers that do not paint their children as they are, such as with
+  // a filter or a saveLayer, set the opaque device bounds of their own.
+  void CullOccludedChildren(const SkMatrix& child_matrix,
+                            const std::vector<size_t>& surface_reading_children,
+                            bool child_has_platform_view);
+
   std::vector<std::shared_ptr<Layer>> layers_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
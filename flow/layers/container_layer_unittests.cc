@@ -4,9 +4,11 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include "flutter/flow/layers/physical_shape_layer.h"
 #include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/mock_canvas.h"
 
@@ -251,6 +253,133 @@ TEST_F(ContainerLayerTest, MergedMultipleChildren) {
                                                child_path2, child_paint2}}}));
 }
 
+TEST_F(ContainerLayerTest, ConcurrentPrerollMergesChildren) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  SkMatrix initial_transform = SkMatrix::Translate(-0.5f, -0.5f);
+  auto layer = std::make_shared<ContainerLayer>();
+  std::vector<std::shared_ptr<MockLayer>> mock_layers;
+  SkRect expected_paint_bounds = SkRect::MakeEmpty();
+  for (int i = 0; i < 8; i++) {
+    SkPath child_path;
+    child_path.addRect(i * 10.0f, 0.0f, i * 10.0f + 5.0f, 5.0f);
+    expected_paint_bounds.join(child_path.getBounds());
+    auto mock_layer = std::make_shared<MockLayer>(
+        child_path, SkPaint(), false, /*fake_reads_surface=*/i == 5);
+    layer->Add(mock_layer);
+    mock_layers.push_back(mock_layer);
+  }
+  preroll_context()->concurrent_task_runner = loop->GetTaskRunner().get();
+
+  layer->Preroll(preroll_context(), initial_transform);
+  EXPECT_FALSE(preroll_context()->has_platform_view);
+  EXPECT_TRUE(preroll_context()->surface_needs_readback);
+  EXPECT_FALSE(layer->subtree_has_platform_view());
+  EXPECT_EQ(layer->paint_bounds(), expected_paint_bounds);
+  for (auto& mock_layer : mock_layers) {
+    EXPECT_EQ(mock_layer->parent_matrix(), initial_transform);
+    EXPECT_EQ(mock_layer->parent_cull_rect(), kGiantRect);
+  }
+}
+
+TEST_F(ContainerLayerTest, PlatformViewSubtreeIsPrerolledSerially) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  auto layer = std::make_shared<ContainerLayer>();
+  std::vector<std::shared_ptr<MockLayer>> mock_layers;
+  for (int i = 0; i < 8; i++) {
+    SkPath child_path;
+    child_path.addRect(i * 10.0f, 0.0f, i * 10.0f + 5.0f, 5.0f);
+    auto mock_layer = std::make_shared<MockLayer>(
+        child_path, SkPaint(), /*fake_has_platform_view=*/i == 2);
+    layer->Add(mock_layer);
+    mock_layers.push_back(mock_layer);
+  }
+  preroll_context()->concurrent_task_runner = loop->GetTaskRunner().get();
+  preroll_context()->mutators_stack.PushOpacity(128);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(preroll_context()->has_platform_view);
+  EXPECT_TRUE(layer->subtree_has_platform_view());
+  // The serial Preroll hands the mutators of the frame to every child.
+  for (auto& mock_layer : mock_layers) {
+    EXPECT_EQ(mock_layer->parent_mutators(), preroll_context()->mutators_stack);
+  }
+}
+
+TEST_F(ContainerLayerTest, OpaqueChildOccludesChildrenBelowIt) {
+  SkPath covered_path = SkPath().addRect(5.0f, 5.0f, 20.5f, 20.5f);
+  SkPath visible_path = SkPath().addRect(30.0f, 30.0f, 60.0f, 60.0f);
+  SkPath opaque_path = SkPath().addRect(0.0f, 0.0f, 40.0f, 40.0f);
+  auto covered_layer = std::make_shared<MockLayer>(covered_path);
+  auto visible_layer = std::make_shared<MockLayer>(visible_path);
+  auto opaque_layer = std::make_shared<PhysicalShapeLayer>(
+      SK_ColorBLUE, SK_ColorBLACK, 0.0f, opaque_path, Clip::none);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(covered_layer);
+  layer->Add(visible_layer);
+  layer->Add(opaque_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix::Scale(2.0f, 2.0f));
+  EXPECT_TRUE(covered_layer->occluded());
+  EXPECT_FALSE(visible_layer->occluded());
+  EXPECT_FALSE(opaque_layer->occluded());
+  EXPECT_EQ(layer->opaque_device_bounds(), SkIRect::MakeLTRB(1, 1, 79, 79));
+  EXPECT_FALSE(covered_layer->needs_painting(paint_context()));
+  EXPECT_TRUE(visible_layer->needs_painting(paint_context()));
+
+  // The layer is no longer occluded once the opaque layer is translucent.
+  auto translucent_layer = std::make_shared<PhysicalShapeLayer>(
+      SkColorSetA(SK_ColorBLUE, 0x80), SK_ColorBLACK, 0.0f, opaque_path,
+      Clip::none);
+  auto layer2 = std::make_shared<ContainerLayer>();
+  layer2->Add(covered_layer);
+  layer2->Add(translucent_layer);
+
+  layer2->Preroll(preroll_context(), SkMatrix::Scale(2.0f, 2.0f));
+  EXPECT_FALSE(covered_layer->occluded());
+  EXPECT_TRUE(layer2->opaque_device_bounds().isEmpty());
+  EXPECT_TRUE(covered_layer->needs_painting(paint_context()));
+}
+
+TEST_F(ContainerLayerTest, SurfaceReadingChildKeepsChildrenBelowItVisible) {
+  SkPath covered_path = SkPath().addRect(5.0f, 5.0f, 20.5f, 20.5f);
+  SkPath reading_path = SkPath().addRect(50.0f, 50.0f, 60.0f, 60.0f);
+  SkPath opaque_path = SkPath().addRect(0.0f, 0.0f, 40.0f, 40.0f);
+  auto covered_layer = std::make_shared<MockLayer>(covered_path);
+  auto reading_layer = std::make_shared<MockLayer>(
+      reading_path, SkPaint(), false, /*fake_reads_surface=*/true);
+  auto opaque_layer = std::make_shared<PhysicalShapeLayer>(
+      SK_ColorBLUE, SK_ColorBLACK, 0.0f, opaque_path, Clip::none);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(covered_layer);
+  layer->Add(reading_layer);
+  layer->Add(opaque_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(preroll_context()->surface_needs_readback);
+  EXPECT_FALSE(covered_layer->occluded());
+  EXPECT_FALSE(reading_layer->occluded());
+  EXPECT_TRUE(layer->opaque_device_bounds().isEmpty());
+}
+
+TEST_F(ContainerLayerTest, PlatformViewSiblingDisablesOcclusion) {
+  SkPath covered_path = SkPath().addRect(5.0f, 5.0f, 20.5f, 20.5f);
+  SkPath platform_view_path = SkPath().addRect(50.0f, 50.0f, 60.0f, 60.0f);
+  SkPath opaque_path = SkPath().addRect(0.0f, 0.0f, 40.0f, 40.0f);
+  auto covered_layer = std::make_shared<MockLayer>(covered_path);
+  auto platform_view_layer = std::make_shared<MockLayer>(
+      platform_view_path, SkPaint(), /*fake_has_platform_view=*/true);
+  auto opaque_layer = std::make_shared<PhysicalShapeLayer>(
+      SK_ColorBLUE, SK_ColorBLACK, 0.0f, opaque_path, Clip::none);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(covered_layer);
+  layer->Add(platform_view_layer);
+  layer->Add(opaque_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_FALSE(covered_layer->occluded());
+  EXPECT_TRUE(layer->opaque_device_bounds().isEmpty());
+}
+
 using ContainerLayerDiffTest = DiffContextTest;
 
 // Insert PictureLayer amongst container layers
@@ -5,9 +5,80 @@
 #include "flutter/flow/layers/display_list_layer.h"
 
 #include "flutter/display_list/display_list_builder.h"
+#include "flutter/display_list/display_list_canvas_dispatcher.h"
+#include "flutter/display_list/display_list_utils.h"
+#include "flutter/flow/display_list_picture_cache.h"
 
 namespace flutter {
 
+namespace {
+
+// Calls |callback| with each of the display lists drawn directly inside of
+// a display list and the matrix that it is drawn with, relative to the
+// matrix of the list. The lists drawn with a perspective are skipped,
+// because the raster cache does not hold them.
+class NestedDisplayListCollector final
+    : public virtual Dispatcher,
+      public virtual IgnoreAttributeDispatchHelper,
+      public virtual IgnoreClipDispatchHelper,
+      public virtual IgnoreDrawDispatchHelper,
+      public virtual SkMatrixDispatchHelper {
+ public:
+  using Callback = std::function<void(DisplayList*, const SkMatrix&)>;
+
+  explicit NestedDisplayListCollector(Callback callback)
+      : callback_(std::move(callback)) {}
+
+  void save() override { SkMatrixDispatchHelper::save(); }
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options) override {
+    SkMatrixDispatchHelper::save();
+  }
+  void restore() override { SkMatrixDispatchHelper::restore(); }
+
+  void drawDisplayList(const sk_sp<DisplayList> display_list) override {
+    if (!matrix().hasPerspective()) {
+      callback_(display_list.get(), matrix());
+    }
+  }
+
+ private:
+  Callback callback_;
+};
+
+// Draws the display lists nested inside of a display list from the raster
+// cache when they are cached, and everything else as |RenderTo| does.
+class RasterCacheDispatcher final : public DisplayListCanvasDispatcher {
+ public:
+  RasterCacheDispatcher(SkCanvas* canvas,
+                        SkScalar opacity,
+                        const RasterCache* raster_cache)
+      : DisplayListCanvasDispatcher(canvas, opacity),
+        canvas_(canvas),
+        raster_cache_(raster_cache) {}
+
+  void drawDisplayList(const sk_sp<DisplayList> display_list) override {
+    SkPaint paint;
+    paint.setAlphaf(opacity());
+    if (raster_cache_->Draw(*display_list, *canvas_,
+                            has_opacity() ? &paint : nullptr)) {
+      return;
+    }
+    DisplayListCanvasDispatcher::drawDisplayList(display_list);
+  }
+
+ private:
+  SkCanvas* canvas_;
+  const RasterCache* raster_cache_;
+};
+
+// Whether the list draws other lists, or pictures, of more than one op.
+bool HasNestedOps(const DisplayList* display_list) {
+  return display_list->op_count(true) > display_list->op_count(false);
+}
+
+}  // namespace
+
 DisplayListLayer::DisplayListLayer(const SkPoint& offset,
                                    SkiaGPUObject<DisplayList> display_list,
                                    bool is_complex,
@@ -72,6 +143,11 @@ bool DisplayListLayer::Compare(DiffContext::Statistics& statistics,
     return false;
   }
 
+  if (dl1->content_hash() != dl2->content_hash()) {
+    statistics.AddNewPicture();
+    return false;
+  }
+
   if (op_bytes_1 > kMaxBytesToCompare) {
     statistics.AddPictureTooComplexToCompare();
     return false;
@@ -102,10 +178,23 @@ void DisplayListLayer::Preroll(PrerollContext* context,
       if (cache->Prepare(context, disp_list, is_complex_, will_change_, matrix,
                          offset_)) {
         context->subtree_can_inherit_opacity = true;
+      } else if (HasNestedOps(disp_list)) {
+        // The lists that are recorded once and drawn into the list each
+        // time that it is recorded again keep their contents, so they are
+        // cached on their own when the list as a whole is not.
+        SkMatrix layer_matrix = matrix;
+        layer_matrix.preTranslate(offset_.x(), offset_.y());
+        NestedDisplayListCollector collector(
+            [cache, context, &layer_matrix](DisplayList* nested,
+                                            const SkMatrix& nested_matrix) {
+              cache->Prepare(context, nested, false, false,
+                             SkMatrix::Concat(layer_matrix, nested_matrix));
+            });
+        disp_list->Dispatch(collector);
       }
     } else {
       // Don't evict raster cache entry during partial repaint
-      cache->Touch(disp_list, matrix);
+      cache->Touch(context, disp_list, matrix);
     }
   }
   set_paint_bounds(bounds);
@@ -132,6 +221,30 @@ void DisplayListLayer::Paint(PaintContext& context) const {
     }
   }
 
+  if (context.display_list_picture_cache) {
+    sk_sp<SkPicture> picture =
+        context.display_list_picture_cache->Get(*display_list());
+    if (picture) {
+      AutoCachePaint cache_paint(context);
+      context.leaf_nodes_canvas->drawPicture(picture, nullptr,
+                                             cache_paint.paint());
+      return;
+    }
+  }
+
+  if (context.raster_cache && HasNestedOps(display_list())) {
+    RasterCacheDispatcher dispatcher(context.leaf_nodes_canvas,
+                                     context.inherited_opacity,
+                                     context.raster_cache);
+    if (display_list()->has_rtree()) {
+      display_list()->Dispatch(
+          dispatcher, context.leaf_nodes_canvas->getLocalClipBounds());
+    } else {
+      display_list()->Dispatch(dispatcher);
+    }
+    return;
+  }
+
   display_list()->RenderTo(context.leaf_nodes_canvas,
                            context.inherited_opacity);
 }
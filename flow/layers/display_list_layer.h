@@ -34,6 +34,13 @@ class DisplayListLayer : public Layer {
 
   void Preroll(PrerollContext* frame, const SkMatrix& matrix) override;
 
+  bool PrepareForConcurrentPreroll() override {
+    // The bounds are computed lazily and the list may be shared by other
+    // layers.
+    display_list()->bounds();
+    return true;
+  }
+
   void Paint(PaintContext& context) const override;
 
  private:
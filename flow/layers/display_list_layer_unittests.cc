@@ -107,6 +107,46 @@ TEST_F(DisplayListLayerTest, SimpleDisplayList) {
   EXPECT_EQ(mock_canvas().draw_calls(), expected_draw_calls);
 }
 
+TEST_F(DisplayListLayerTest, NestedDisplayListIsCachedWhenTheListChanges) {
+  use_mock_raster_cache();
+  DisplayListBuilder fragment_builder;
+  for (int i = 0; i < 20; i++) {
+    fragment_builder.drawRect(SkRect::MakeXYWH(i * 5, 0, 4, 4));
+  }
+  auto fragment = fragment_builder.Build();
+
+  // The list is recorded again in each frame, with the same fragment.
+  const int frame_count = raster_cache()->access_threshold() + 1;
+  size_t last_frame_first_call = 0;
+  for (int frame = 0; frame < frame_count; frame++) {
+    DisplayListBuilder builder;
+    builder.translate(10, 20);
+    builder.drawDisplayList(fragment);
+    builder.drawRect(SkRect::MakeXYWH(frame, 50, 10, 10));
+    auto layer = std::make_shared<DisplayListLayer>(
+        SkPoint::Make(0, 0), SkiaGPUObject(builder.Build(), unref_queue()),
+        false, true);
+
+    last_frame_first_call = mock_canvas().draw_calls().size();
+    raster_cache()->PrepareNewFrame();
+    layer->Preroll(preroll_context(), SkMatrix());
+    layer->Paint(paint_context());
+    raster_cache()->CleanupAfterFrame();
+  }
+
+  // Only the fragment is cached, so the last frame only draws the rect that
+  // is outside of it.
+  EXPECT_EQ(raster_cache()->GetCachedEntriesCount(), 1u);
+  const auto& draw_calls = mock_canvas().draw_calls();
+  int rect_count = 0;
+  for (size_t i = last_frame_first_call; i < draw_calls.size(); i++) {
+    if (std::holds_alternative<MockCanvas::DrawRectData>(draw_calls[i].data)) {
+      rect_count++;
+    }
+  }
+  EXPECT_EQ(rect_count, 1);
+}
+
 using DisplayListLayerDiffTest = DiffContextTest;
 
 TEST_F(DisplayListLayerDiffTest, SimpleDisplayList) {
@@ -4,6 +4,9 @@
 
 #include "flutter/flow/layers/image_filter_layer.h"
 
+#include "flutter/flow/image_filter_cache.h"
+#include "third_party/skia/include/utils/SkNWayCanvas.h"
+
 namespace flutter {
 
 ImageFilterLayer::ImageFilterLayer(sk_sp<SkImageFilter> filter)
@@ -44,6 +47,11 @@ void ImageFilterLayer::Preroll(PrerollContext* context,
 
   SkRect child_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, matrix, &child_bounds);
+  // Textures and platform views change without their layers changing.
+  can_cache_filter_output_ =
+      !context->has_platform_view && !context->has_texture_layer;
+  // The filter may move the children or change their alpha.
+  set_opaque_device_bounds(SkIRect::MakeEmpty());
 
   if (!filter_) {
     set_paint_bounds(child_bounds);
@@ -93,18 +101,20 @@ void ImageFilterLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "ImageFilterLayer::Paint");
   FML_DCHECK(needs_painting(context));
 
-  if (context.raster_cache) {
-    if (context.raster_cache->Draw(this, *context.leaf_nodes_canvas)) {
-      return;
-    }
-    if (transformed_filter_) {
-      SkPaint paint;
-      paint.setImageFilter(transformed_filter_);
+  if (context.raster_cache &&
+      context.raster_cache->Draw(this, *context.leaf_nodes_canvas)) {
+    return;
+  }
+  if (PaintCachedFilterOutput(context)) {
+    return;
+  }
+  if (context.raster_cache && transformed_filter_) {
+    SkPaint paint;
+    paint.setImageFilter(transformed_filter_);
 
-      if (context.raster_cache->Draw(GetCacheableChild(),
-                                     *context.leaf_nodes_canvas, &paint)) {
-        return;
-      }
+    if (context.raster_cache->Draw(GetCacheableChild(),
+                                   *context.leaf_nodes_canvas, &paint)) {
+      return;
     }
   }
 
@@ -120,4 +130,41 @@ void ImageFilterLayer::Paint(PaintContext& context) const {
   PaintChildren(context);
 }
 
+bool ImageFilterLayer::PaintCachedFilterOutput(PaintContext& context) const {
+  if (!context.image_filter_cache || !filter_ || !can_cache_filter_output_) {
+    return false;
+  }
+  const ContainerLayer* container = GetChildContainer();
+  std::vector<ImageFilterCache::Child> children;
+  children.reserve(container->layers().size());
+  for (auto& layer : container->layers()) {
+    children.push_back({layer->unique_id(), layer->paint_bounds()});
+  }
+  return context.image_filter_cache->Draw(
+      original_layer_id(), filter_, container->paint_bounds(),
+      std::move(children),
+      [this, &context](SkCanvas* canvas) {
+        SkISize canvas_size = canvas->getBaseLayerSize();
+        SkNWayCanvas internal_nodes_canvas(canvas_size.width(),
+                                           canvas_size.height());
+        internal_nodes_canvas.setMatrix(canvas->getTotalMatrix());
+        internal_nodes_canvas.addCanvas(canvas);
+        PaintContext paint_context = {
+            /* internal_nodes_canvas= */ &internal_nodes_canvas,
+            /* leaf_nodes_canvas= */ canvas,
+            /* gr_context= */ context.gr_context,
+            /* view_embedder= */ nullptr,
+            context.raster_time,
+            context.ui_time,
+            context.texture_registry,
+            context.raster_cache,
+            context.checkerboard_offscreen_layers,
+            context.frame_device_pixel_ratio};
+        paint_context.display_list_picture_cache =
+            context.display_list_picture_cache;
+        PaintChildren(paint_context);
+      },
+      context.gr_context, *context.leaf_nodes_canvas);
+}
+
 }  // namespace flutter
@@ -21,6 +21,10 @@ class ImageFilterLayer : public MergedContainerLayer {
   void Paint(PaintContext& context) const override;
 
  private:
+  // Draws the filtered children from the image filter cache of the context,
+  // which filters them again only where they changed since the last frame.
+  bool PaintCachedFilterOutput(PaintContext& context) const;
+
   // The ImageFilterLayer might cache the filtered output of this layer
   // if the layer remains stable (if it is not animating for instance).
   // If the ImageFilterLayer is not the same between rendered frames,
@@ -40,6 +44,9 @@ class ImageFilterLayer : public MergedContainerLayer {
   sk_sp<SkImageFilter> filter_;
   sk_sp<SkImageFilter> transformed_filter_;
   int render_count_;
+  // Whether the children paint nothing but their own content, which the
+  // image filter cache can then keep across frames.
+  bool can_cache_filter_output_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ImageFilterLayer);
 };
@@ -11,10 +11,12 @@ namespace flutter {
 
 Layer::Layer()
     : paint_bounds_(SkRect::MakeEmpty()),
+      opaque_device_bounds_(SkIRect::MakeEmpty()),
       unique_id_(NextUniqueID()),
       original_layer_id_(unique_id_),
       subtree_has_platform_view_(false),
-      layer_can_inherit_opacity_(false) {}
+      layer_can_inherit_opacity_(false),
+      occluded_(false) {}
 
 Layer::~Layer() = default;
 
@@ -38,7 +40,9 @@ Layer::AutoPrerollSaveLayerState::AutoPrerollSaveLayerState(
       layer_itself_performs_readback_(layer_itself_performs_readback) {
   if (save_layer_is_active_) {
     prev_surface_needs_readback_ = preroll_context_->surface_needs_readback;
+    prev_in_save_layer_ = preroll_context_->in_save_layer;
     preroll_context_->surface_needs_readback = false;
+    preroll_context_->in_save_layer = true;
   }
 }
 
@@ -54,6 +58,7 @@ Layer::AutoPrerollSaveLayerState::~AutoPrerollSaveLayerState() {
   if (save_layer_is_active_) {
     preroll_context_->surface_needs_readback =
         (prev_surface_needs_readback_ || layer_itself_performs_readback_);
+    preroll_context_->in_save_layer = prev_in_save_layer_;
   }
 }
 
@@ -15,6 +15,7 @@
 #include "flutter/flow/raster_cache.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/compiler_specific.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/trace_event.h"
@@ -34,6 +35,10 @@ namespace testing {
 class MockLayer;
 }  // namespace testing
 
+class BackdropFilterCache;
+class DisplayListPictureCache;
+class ImageFilterCache;
+
 static constexpr SkRect kGiantRect = SkRect::MakeLTRB(-1E9F, -1E9F, 1E9F, 1E9F);
 
 // This should be an exact copy of the Clip enum in painting.dart.
@@ -80,8 +85,24 @@ struct PrerollContext {
   // than to remember the value so that it can choose the right strategy
   // for its |Paint| method.
   bool subtree_can_inherit_opacity = false;
+
+  // The task runner on which the independent subtrees of wide containers
+  // are prerolled concurrently, or null to preroll every layer on the
+  // raster thread. See |ContainerLayer::PrerollChildren|.
+  fml::ConcurrentTaskRunner* concurrent_task_runner = nullptr;
+
+  // Set while a subtree is prerolled on a worker thread. The raster cache
+  // may only be used on the raster thread, so its |Prepare| and |Touch|
+  // calls are collected here and made in order once the subtree is done.
+  std::vector<RasterCache::DeferredCall>* deferred_raster_cache_calls = nullptr;
+
+  // Whether the layers being prerolled are painted into a saveLayer, and
+  // hence not onto the surface of the frame until the layer is restored.
+  bool in_save_layer = false;
 };
 
+class ClipRectLayer;
+class ContainerLayer;
 class PictureLayer;
 class DisplayListLayer;
 class PerformanceOverlayLayer;
@@ -119,6 +140,13 @@ class Layer {
 
   virtual void Preroll(PrerollContext* context, const SkMatrix& matrix);
 
+  // Returns whether the Preroll of this layer and its subtree may run on a
+  // worker thread, which is not the case for layers that use the view
+  // embedder or whose Preroll affects the Preroll of their siblings. Any
+  // state that Preroll computes lazily and that may be shared with other
+  // subtrees is computed here, on the raster thread.
+  virtual bool PrepareForConcurrentPreroll() { return true; }
+
   // Used during Preroll by layers that employ a saveLayer to manage the
   // PrerollContext settings with values affected by the saveLayer mechanism.
   // This object must be created before calling Preroll on the children to
@@ -143,6 +171,7 @@ class Layer {
     bool layer_itself_performs_readback_;
 
     bool prev_surface_needs_readback_;
+    bool prev_in_save_layer_;
   };
 
   struct PaintContext {
@@ -174,6 +203,22 @@ class Layer {
     // |saveLayer| with an |SkPaint| initialized to this alphaf value and
     // a |kSrcOver| blend mode.
     SkScalar inherited_opacity = SK_Scalar1;
+
+    // If set, the DisplayListLayers draw the pictures prepared for their
+    // lists in this cache rather than replaying the lists.
+    const DisplayListPictureCache* display_list_picture_cache = nullptr;
+
+    // If set, the BackdropFilterLayers reuse the filtered backdrops from
+    // this cache when their backdrop has not changed since the last frame.
+    BackdropFilterCache* backdrop_filter_cache = nullptr;
+
+    // If set, the ImageFilterLayers keep their filtered children in this
+    // cache across frames.
+    ImageFilterCache* image_filter_cache = nullptr;
+
+    // The time the GPU took to execute the recent frames, if the surface
+    // measures it.
+    const Stopwatch* gpu_time = nullptr;
   };
 
   class AutoCachePaint {
@@ -299,6 +344,21 @@ class Layer {
   // Determines if the layer has any content.
   bool is_empty() const { return paint_bounds_.isEmpty(); }
 
+  // Returns the bounds, in device space, of the pixels that the layer and
+  // its subtree are sure to fill with opaque content as determined during
+  // Preroll(), or an empty rect. The siblings below the layer whose paint
+  // bounds are within these bounds are occluded by it.
+  const SkIRect& opaque_device_bounds() const { return opaque_device_bounds_; }
+  void set_opaque_device_bounds(const SkIRect& opaque_device_bounds) {
+    opaque_device_bounds_ = opaque_device_bounds;
+  }
+
+  // Determines if the layer is hidden behind the opaque content of the
+  // siblings above it, in which case it does not need to be painted. This
+  // is set by the Preroll() of its parent.
+  bool occluded() const { return occluded_; }
+  void set_occluded(bool occluded) { occluded_ = occluded; }
+
   // Determines if the Paint() method is necessary based on the properties
   // of the indicated PaintContext object.
   bool needs_painting(PaintContext& context) const {
@@ -312,6 +372,9 @@ class Layer {
       // See https://github.com/flutter/flutter/issues/81419
       return true;
     }
+    if (occluded_) {
+      return false;
+    }
     if (context.inherited_opacity == 0) {
       return false;
     }
@@ -329,6 +392,8 @@ class Layer {
 
   uint64_t unique_id() const { return unique_id_; }
 
+  virtual const ContainerLayer* as_container_layer() const { return nullptr; }
+  virtual const ClipRectLayer* as_clip_rect_layer() const { return nullptr; }
   virtual const PictureLayer* as_picture_layer() const { return nullptr; }
   virtual const DisplayListLayer* as_display_list_layer() const {
     return nullptr;
@@ -341,10 +406,12 @@ class Layer {
 
  private:
   SkRect paint_bounds_;
+  SkIRect opaque_device_bounds_;
   uint64_t unique_id_;
   uint64_t original_layer_id_;
   bool subtree_has_platform_view_;
   bool layer_can_inherit_opacity_;
+  bool occluded_;
 
   static uint64_t NextUniqueID();
 
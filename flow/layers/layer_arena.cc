@@ -0,0 +1,36 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_arena.h"
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+LayerArena::LayerArena() = default;
+
+LayerArena::~LayerArena() = default;
+
+void* LayerArena::Allocate(size_t size, size_t alignment) {
+  FML_DCHECK(alignment <= alignof(std::max_align_t));
+  uintptr_t next = reinterpret_cast<uintptr_t>(next_);
+  uintptr_t aligned = (next + alignment - 1) & ~(alignment - 1);
+  if (next_ && aligned + size <= reinterpret_cast<uintptr_t>(end_)) {
+    next_ = reinterpret_cast<uint8_t*>(aligned + size);
+    return reinterpret_cast<void*>(aligned);
+  }
+  if (size > kChunkSize / 4) {
+    // Keep using the current chunk for the allocations that follow.
+    chunks_.emplace_back(new uint8_t[size]);
+    chunk_bytes_ += size;
+    return chunks_.back().get();
+  }
+  chunks_.emplace_back(new uint8_t[kChunkSize]);
+  chunk_bytes_ += kChunkSize;
+  next_ = chunks_.back().get() + size;
+  end_ = chunks_.back().get() + kChunkSize;
+  return chunks_.back().get();
+}
+
+}  // namespace flutter
@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
+#define FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/ref_counted.h"
+
+namespace flutter {
+
+// An arena from which the |SceneBuilder| allocates the layers of one
+// frame, so that building a tree of thousands of layers does not make as
+// many calls to malloc and free.
+//
+// The layers are still owned through std::shared_ptr, as every layer is,
+// but each one is allocated along with its control block by bumping a
+// pointer into large chunks of memory. The chunks are freed only when all
+// of the layers allocated from the arena have been destroyed and the
+// arena itself has been released, so a layer that is retained by an
+// |EngineLayer| and added to a later frame keeps the chunks of the frame
+// that built it alive.
+//
+// The layers must be made on a single thread but may be destroyed on any
+// thread.
+class LayerArena : public fml::RefCountedThreadSafe<LayerArena> {
+ public:
+  // The size of the chunks of memory that the layers are allocated from.
+  // Larger allocations get a chunk of their own.
+  static constexpr size_t kChunkSize = 16 * 1024;
+
+  // Makes a |T| constructed with |args| in the arena.
+  template <typename T, typename... Args>
+  std::shared_ptr<T> Make(Args&&... args) {
+    return std::allocate_shared<T>(Allocator<T>(this),
+                                   std::forward<Args>(args)...);
+  }
+
+  // The number of bytes of the chunks that have been allocated.
+  size_t chunk_bytes() const { return chunk_bytes_; }
+
+ private:
+  // The allocator of the control blocks and objects of |Make|. Each
+  // allocation holds a reference to the arena, which is released when the
+  // allocation is freed.
+  template <typename T>
+  class Allocator {
+   public:
+    using value_type = T;
+
+    explicit Allocator(LayerArena* arena) : arena_(arena) {}
+
+    template <typename U>
+    Allocator(const Allocator<U>& other)  // NOLINT(google-explicit-constructor)
+        : arena_(other.arena_) {}
+
+    T* allocate(size_t n) {
+      arena_->AddRef();
+      return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n) { arena_->Release(); }
+
+    bool operator==(const Allocator& other) const {
+      return arena_ == other.arena_;
+    }
+    bool operator!=(const Allocator& other) const {
+      return arena_ != other.arena_;
+    }
+
+   private:
+    template <typename U>
+    friend class Allocator;
+
+    LayerArena* arena_;
+  };
+
+  LayerArena();
+
+  ~LayerArena();
+
+  void* Allocate(size_t size, size_t alignment);
+
+  std::vector<std::unique_ptr<uint8_t[]>> chunks_;
+  uint8_t* next_ = nullptr;
+  uint8_t* end_ = nullptr;
+  size_t chunk_bytes_ = 0;
+
+  FML_FRIEND_REF_COUNTED_THREAD_SAFE(LayerArena);
+  FML_FRIEND_MAKE_REF_COUNTED(LayerArena);
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerArena);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
@@ -0,0 +1,64 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_arena.h"
+
+#include <array>
+
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(LayerArena, LayersShareChunks) {
+  auto arena = fml::MakeRefCounted<LayerArena>();
+  auto root = arena->Make<ContainerLayer>();
+  for (int i = 0; i < 32; i++) {
+    auto layer = arena->Make<TransformLayer>(SkMatrix::Translate(i, 0));
+    layer->set_paint_bounds(SkRect::MakeXYWH(i, 0, 1, 1));
+    root->Add(layer);
+  }
+
+  ASSERT_EQ(root->layers().size(), 32u);
+  EXPECT_LE(arena->chunk_bytes(), 2 * LayerArena::kChunkSize);
+  for (int i = 0; i < 32; i++) {
+    EXPECT_EQ(root->layers()[i]->paint_bounds(), SkRect::MakeXYWH(i, 0, 1, 1));
+  }
+}
+
+TEST(LayerArena, LayersOutliveTheReleasedArena) {
+  auto arena = fml::MakeRefCounted<LayerArena>();
+  std::shared_ptr<ContainerLayer> retained = arena->Make<ContainerLayer>();
+  auto root = arena->Make<ContainerLayer>();
+  root->Add(retained);
+  arena = nullptr;
+  root = nullptr;
+
+  // The layer retained from the frame is still usable, for example by an
+  // EngineLayer that is added to a later frame.
+  auto next_arena = fml::MakeRefCounted<LayerArena>();
+  auto next_root = next_arena->Make<ContainerLayer>();
+  next_root->Add(retained);
+  retained = nullptr;
+  ASSERT_EQ(next_root->layers().size(), 1u);
+  EXPECT_TRUE(next_root->layers()[0]->paint_bounds().isEmpty());
+}
+
+TEST(LayerArena, LargeObjectsGetChunksOfTheirOwn) {
+  auto arena = fml::MakeRefCounted<LayerArena>();
+  auto small = arena->Make<ContainerLayer>();
+  size_t chunk_bytes = arena->chunk_bytes();
+  auto large = arena->Make<std::array<uint8_t, LayerArena::kChunkSize>>();
+
+  EXPECT_GT(arena->chunk_bytes(), chunk_bytes + LayerArena::kChunkSize - 1);
+  // The next small object still fits in the chunk of the first one.
+  size_t large_chunk_bytes = arena->chunk_bytes();
+  auto small2 = arena->Make<ContainerLayer>();
+  EXPECT_EQ(arena->chunk_bytes(), large_chunk_bytes);
+}
+
+}  // namespace testing
+}  // namespace flutter
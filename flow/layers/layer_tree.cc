@@ -4,8 +4,12 @@
 
 #include "flutter/flow/layers/layer_tree.h"
 
+#include "flutter/display_list/display_list_prewarmer.h"
 #include "flutter/flow/frame_timings.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
 #include "flutter/flow/layers/layer.h"
+#include "flutter/flow/text_batching_canvas.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
@@ -18,10 +22,54 @@ LayerTree::LayerTree(const SkISize& frame_size, float device_pixel_ratio)
       device_pixel_ratio_(device_pixel_ratio),
       rasterizer_tracing_threshold_(0),
       checkerboard_raster_cache_images_(false),
-      checkerboard_offscreen_layers_(false) {
+      checkerboard_offscreen_layers_(false),
+      has_platform_view_(false) {
   FML_CHECK(device_pixel_ratio_ != 0.0f);
 }
 
+LayerTree::~LayerTree() {
+  if (prewarm_state_) {
+    std::scoped_lock lock(prewarm_state_->mutex);
+    prewarm_state_->cancelled = true;
+  }
+}
+
+static void CollectDisplayLists(const Layer* layer,
+                                std::vector<DisplayList*>& lists) {
+  if (auto display_list_layer = layer->as_display_list_layer()) {
+    if (display_list_layer->display_list()) {
+      lists.push_back(display_list_layer->display_list());
+    }
+  } else if (auto container_layer = layer->as_container_layer()) {
+    for (auto& child : container_layer->layers()) {
+      CollectDisplayLists(child.get(), lists);
+    }
+  }
+}
+
+void LayerTree::PrewarmDisplayLists(
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& task_runner) {
+  if (!root_layer_ || !task_runner || prewarm_state_) {
+    return;
+  }
+  std::vector<DisplayList*> lists;
+  CollectDisplayLists(root_layer_.get(), lists);
+  if (lists.empty()) {
+    return;
+  }
+  prewarm_state_ = std::make_shared<PrewarmState>();
+  task_runner->PostTask([state = prewarm_state_, lists = std::move(lists)]() {
+    std::scoped_lock lock(state->mutex);
+    if (state->cancelled) {
+      return;
+    }
+    TRACE_EVENT0("flutter", "LayerTree::PrewarmDisplayLists");
+    for (const DisplayList* display_list : lists) {
+      DisplayListPrewarmer::Prewarm(display_list);
+    }
+  });
+}
+
 bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
                         bool ignore_raster_cache,
                         SkRect cull_rect) {
@@ -50,8 +98,13 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       frame.context().texture_registry(),
       checkerboard_offscreen_layers_,
       device_pixel_ratio_};
+  context.concurrent_task_runner =
+      frame.context().concurrent_preroll_task_runner();
 
   root_layer_->Preroll(&context, frame.root_surface_transformation());
+  if (context.raster_cache) {
+    context.raster_cache->DrawRecordedImages();
+  }
   return context.surface_needs_readback;
 }
 
@@ -64,9 +117,17 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
     return;
   }
 
+  SkCanvas* leaf_nodes_canvas = frame.canvas();
+  std::unique_ptr<TextBatchingCanvas> text_batching_canvas;
+  if (frame.context().batch_text_draws()) {
+    text_batching_canvas =
+        std::make_unique<TextBatchingCanvas>(leaf_nodes_canvas);
+    leaf_nodes_canvas = text_batching_canvas.get();
+  }
+
   SkISize canvas_size = frame.canvas()->getBaseLayerSize();
   SkNWayCanvas internal_nodes_canvas(canvas_size.width(), canvas_size.height());
-  internal_nodes_canvas.addCanvas(frame.canvas());
+  internal_nodes_canvas.addCanvas(leaf_nodes_canvas);
   if (frame.view_embedder() != nullptr) {
     auto overlay_canvases = frame.view_embedder()->GetCurrentCanvases();
     for (size_t i = 0; i < overlay_canvases.size(); i++) {
@@ -76,7 +137,7 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
 
   Layer::PaintContext context = {
       static_cast<SkCanvas*>(&internal_nodes_canvas),
-      frame.canvas(),
+      leaf_nodes_canvas,
       frame.gr_context(),
       frame.view_embedder(),
       frame.context().raster_time(),
@@ -85,15 +146,40 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
       ignore_raster_cache ? nullptr : &frame.context().raster_cache(),
       checkerboard_offscreen_layers_,
       device_pixel_ratio_};
+  BackdropFilterCache& backdrop_filter_cache =
+      frame.context().backdrop_filter_cache();
+  if (backdrop_filter_cache.is_in_frame()) {
+    context.backdrop_filter_cache = &backdrop_filter_cache;
+  }
+  if (!ignore_raster_cache) {
+    context.image_filter_cache = &frame.context().image_filter_cache();
+  }
+  if (frame.context().has_gpu_time()) {
+    context.gpu_time = &frame.context().gpu_time();
+  }
 
   if (root_layer_->needs_painting(context)) {
     root_layer_->Paint(context);
   }
+  if (text_batching_canvas) {
+    text_batching_canvas->FlushText();
+  }
 }
 
-sk_sp<SkPicture> LayerTree::Flatten(const SkRect& bounds) {
+sk_sp<SkPicture> LayerTree::Flatten(
+    const SkRect& bounds,
+    DisplayListPictureCache* picture_cache,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& task_runner) {
   TRACE_EVENT0("flutter", "LayerTree::Flatten");
 
+  if (picture_cache) {
+    std::vector<DisplayList*> lists;
+    if (root_layer_) {
+      CollectDisplayLists(root_layer_.get(), lists);
+    }
+    picture_cache->Prepare(lists, task_runner);
+  }
+
   SkPictureRecorder recorder;
   auto* canvas = recorder.beginRecording(bounds);
 
@@ -140,6 +226,8 @@ sk_sp<SkPicture> LayerTree::Flatten(const SkRect& bounds) {
       device_pixel_ratio_       // ratio between logical and physical
   };
 
+  paint_context.display_list_picture_cache = picture_cache;
+
   // Even if we don't have a root layer, we still need to create an empty
   // picture.
   if (root_layer_) {
@@ -7,9 +7,12 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
 
 #include "flutter/flow/compositor_context.h"
+#include "flutter/flow/display_list_picture_cache.h"
 #include "flutter/flow/layers/layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_delta.h"
 #include "third_party/skia/include/core/SkPicture.h"
@@ -21,6 +24,19 @@ class LayerTree {
  public:
   LayerTree(const SkISize& frame_size, float device_pixel_ratio);
 
+  ~LayerTree();
+
+  // Prepares the resources used by the DisplayLists in the tree on a
+  // worker of |task_runner|, ahead of their rasterization, as described by
+  // |DisplayListPrewarmer|. The preparation runs concurrently with the rest
+  // of the frame pipeline and does not delay it.
+  //
+  // The tree must not be modified once this has been called. If the tree
+  // is destroyed while its lists are still being walked then it waits for
+  // the walk to finish, so that the lists are never released on a worker.
+  void PrewarmDisplayLists(
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& task_runner);
+
   // Perform a preroll pass on the tree and return information about
   // the tree that affects rendering this frame.
   //
@@ -35,7 +51,16 @@ class LayerTree {
   void Paint(CompositorContext::ScopedFrame& frame,
              bool ignore_raster_cache = false) const;
 
-  sk_sp<SkPicture> Flatten(const SkRect& bounds);
+  // Records the tree into a picture.
+  //
+  // If a |picture_cache| is supplied then the DisplayLists in the tree are
+  // first converted into pictures concurrently on |task_runner|, reusing
+  // any pictures already in the cache, and the picture of each list is
+  // then drawn into the result in place of replaying the list.
+  sk_sp<SkPicture> Flatten(
+      const SkRect& bounds,
+      DisplayListPictureCache* picture_cache = nullptr,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& task_runner = nullptr);
 
   Layer* root_layer() const { return root_layer_.get(); }
 
@@ -68,6 +93,17 @@ class LayerTree {
     checkerboard_offscreen_layers_ = checkerboard;
   }
 
+  // Whether the scene builder added a platform view to the tree. This is
+  // known before the tree is prerolled, so the rasterizer can merge the
+  // raster and platform threads ahead of the frame. Platform views that are
+  // only part of retained layers are not counted, and are still found by
+  // the preroll.
+  void set_has_platform_view(bool has_platform_view) {
+    has_platform_view_ = has_platform_view;
+  }
+
+  bool has_platform_view() const { return has_platform_view_; }
+
  private:
   std::shared_ptr<Layer> root_layer_;
   SkISize frame_size_ = SkISize::MakeEmpty();  // Physical pixels.
@@ -75,9 +111,19 @@ class LayerTree {
   uint32_t rasterizer_tracing_threshold_;
   bool checkerboard_raster_cache_images_;
   bool checkerboard_offscreen_layers_;
+  bool has_platform_view_;
 
   PaintRegionMap paint_region_map_;
 
+  // Shared with the worker task started by |PrewarmDisplayLists|. The
+  // worker holds the mutex while it walks the lists and skips the walk if
+  // the tree has already been destroyed by the time it runs.
+  struct PrewarmState {
+    std::mutex mutex;
+    bool cancelled = false;
+  };
+  std::shared_ptr<PrewarmState> prewarm_state_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(LayerTree);
 };
 
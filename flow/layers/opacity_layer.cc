@@ -54,6 +54,8 @@ void OpacityLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   ContainerLayer::Preroll(context, child_matrix);
   context->mutators_stack.Pop();
   context->mutators_stack.Pop();
+  // The children are blended with the alpha of this layer.
+  set_opaque_device_bounds(SkIRect::MakeEmpty());
 
   set_children_can_accept_opacity(context->subtree_can_inherit_opacity);
 
@@ -105,6 +105,18 @@ void PerformanceOverlayLayer::Paint(PaintContext& context) const {
       height - padding, options_ & kVisualizeRasterizerStatistics,
       options_ & kDisplayRasterizerStatistics, "Raster", font_path_);
 
+  // The GPU time is shown above the raster statistics, as it is the time the
+  // GPU took to execute the frames that the raster thread submitted.
+  if (context.gpu_time && (options_ & kDisplayRasterizerStatistics)) {
+    const int gpu_label_x = 8;    // distance from x
+    const int gpu_label_y = -28;  // distance from y+height
+    auto text = MakeStatisticsText(*context.gpu_time, "GPU", font_path_);
+    SkPaint paint;
+    paint.setColor(SK_ColorGRAY);
+    context.leaf_nodes_canvas->drawTextBlob(
+        text, x + gpu_label_x, y + height - padding + gpu_label_y, paint);
+  }
+
   VisualizeStopWatch(context.leaf_nodes_canvas, context.ui_time, x, y + height,
                      width, height - padding,
                      options_ & kVisualizeEngineStatistics,
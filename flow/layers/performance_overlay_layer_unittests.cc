@@ -179,6 +179,40 @@ TEST_F(PerformanceOverlayLayerTest, SimpleRasterizerStatistics) {
                                             text_position}}}));
 }
 
+TEST_F(PerformanceOverlayLayerTest, GpuStatisticsAreShownAboveRasterStatistics) {
+  const SkRect layer_bounds = SkRect::MakeLTRB(0.0f, 0.0f, 64.0f, 64.0f);
+  const uint64_t overlay_opts = kDisplayRasterizerStatistics;
+  auto layer = std::make_shared<PerformanceOverlayLayer>(overlay_opts);
+  layer->set_paint_bounds(layer_bounds);
+
+  FixedRefreshRateStopwatch gpu_time;
+  gpu_time.SetLapTime(fml::TimeDelta::FromMilliseconds(4));
+  paint_context().gpu_time = &gpu_time;
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  layer->Paint(paint_context());
+  auto raster_text = PerformanceOverlayLayer::MakeStatisticsText(
+      paint_context().raster_time, "Raster", "");
+  auto gpu_text =
+      PerformanceOverlayLayer::MakeStatisticsText(gpu_time, "GPU", "");
+  SkPaint text_paint;
+  text_paint.setColor(SK_ColorGRAY);
+
+#if defined(OS_FUCHSIA)
+  GTEST_SKIP() << "Expectation requires a valid default font manager";
+#endif  // OS_FUCHSIA
+  EXPECT_EQ(
+      mock_canvas().draw_calls(),
+      std::vector({MockCanvas::DrawCall{
+                       0, MockCanvas::DrawTextData{
+                              raster_text->serialize(SkSerialProcs{}),
+                              text_paint, SkPoint::Make(16.0f, 22.0f)}},
+                   MockCanvas::DrawCall{
+                       0, MockCanvas::DrawTextData{
+                              gpu_text->serialize(SkSerialProcs{}), text_paint,
+                              SkPoint::Make(16.0f, 4.0f)}}}));
+}
+
 TEST(PerformanceOverlayLayerDefault, Gold) {
   TestPerformanceOverlayLayerGold(60);
 }
@@ -67,7 +67,35 @@ void PhysicalShapeLayer::Preroll(PrerollContext* context,
     // children to it so we don't need to join the child paint bounds.
     set_paint_bounds(DisplayListCanvasDispatcher::ComputeShadowBounds(
         path_, elevation_, context->frame_device_pixel_ratio, matrix));
+    if (context->raster_cache) {
+      context->raster_cache->PrepareShadow(
+          context, path_, shadow_color_, elevation_,
+          SkColorGetA(color_) != 0xff, context->frame_device_pixel_ratio,
+          matrix);
+    }
+  }
+
+  // The shape is filled below the children, which are only opaque inside
+  // of the shape if they are clipped to it. Both are only tracked if the
+  // shape is a rect, and neither is opaque once composited from the
+  // saveLayer, in which the blend modes of the children may have made the
+  // content transparent.
+  SkRect shape_rect;
+  SkIRect shape_bounds = SkIRect::MakeEmpty();
+  if (!path_.isInverseFillType() && path_.isRect(&shape_rect)) {
+    shape_bounds = OpaqueDeviceBounds(shape_rect, matrix);
+  }
+  SkIRect opaque_bounds = opaque_device_bounds();
+  if (clip_behavior_ != Clip::none && !opaque_bounds.intersect(shape_bounds)) {
+    opaque_bounds.setEmpty();
   }
+  if (SkColorGetA(color_) == 0xff && !shape_bounds.isEmpty()) {
+    opaque_bounds = shape_bounds;
+  }
+  if (UsesSaveLayer()) {
+    opaque_bounds.setEmpty();
+  }
+  set_opaque_device_bounds(opaque_bounds);
 }
 
 void PhysicalShapeLayer::Paint(PaintContext& context) const {
@@ -75,9 +103,15 @@ void PhysicalShapeLayer::Paint(PaintContext& context) const {
   FML_DCHECK(needs_painting(context));
 
   if (elevation_ != 0) {
-    DisplayListCanvasDispatcher::DrawShadow(
-        context.leaf_nodes_canvas, path_, shadow_color_, elevation_,
-        SkColorGetA(color_) != 0xff, context.frame_device_pixel_ratio);
+    bool transparent_occluder = SkColorGetA(color_) != 0xff;
+    if (!context.raster_cache ||
+        !context.raster_cache->DrawShadow(
+            path_, shadow_color_, elevation_, transparent_occluder,
+            context.frame_device_pixel_ratio, *context.leaf_nodes_canvas)) {
+      DisplayListCanvasDispatcher::DrawShadow(
+          context.leaf_nodes_canvas, path_, shadow_color_, elevation_,
+          transparent_occluder, context.frame_device_pixel_ratio);
+    }
   }
 
   // Call drawPath without clip if possible for better performance.
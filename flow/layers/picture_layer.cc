@@ -123,7 +123,7 @@ void PictureLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
       }
     } else {
       // Don't evict raster cache entry during partial repaint
-      cache->Touch(sk_picture, matrix);
+      cache->Touch(context, sk_picture, matrix);
     }
   }
 
@@ -16,6 +16,9 @@ class PlatformViewLayer : public Layer {
   PlatformViewLayer(const SkPoint& offset, const SkSize& size, int64_t view_id);
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
+
+  // The view embedder must only be used on the raster thread.
+  bool PrepareForConcurrentPreroll() override { return false; }
   void Paint(PaintContext& context) const override;
 
  private:
@@ -33,6 +33,8 @@ void ShaderMaskLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context);
   ContainerLayer::Preroll(context, matrix);
+  // The mask changes the alpha of the children.
+  set_opaque_device_bounds(SkIRect::MakeEmpty());
 }
 
 void ShaderMaskLayer::Paint(PaintContext& context) const {
@@ -28,6 +28,9 @@ class TextureLayer : public Layer {
   const TextureLayer* as_texture_layer() const override { return this; }
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
+
+  // The texture layer is seen by the Preroll of the siblings that follow it.
+  bool PrepareForConcurrentPreroll() override { return false; }
   void Paint(PaintContext& context) const override;
 
  private:
@@ -4,6 +4,8 @@
 
 #include "flutter/flow/paint_region.h"
 
+#include <algorithm>
+
 namespace flutter {
 
 SkRect PaintRegion::ComputeBounds() const {
@@ -14,4 +16,182 @@ SkRect PaintRegion::ComputeBounds() const {
   return res;
 }
 
+// The smallest table a map allocates.
+static constexpr size_t kMinTableCapacity = 16;
+
+// Layer unique ids are sequential, spread them over the table.
+static size_t HashLayerId(uint64_t layer_id) {
+  uint64_t hash = layer_id * 0x9E3779B97F4A7C15ull;
+  return static_cast<size_t>(hash ^ (hash >> 32));
+}
+
+PaintRegionMap::PaintRegionMap() = default;
+
+PaintRegionMap::~PaintRegionMap() {
+  if (pool_ && !entries_.empty()) {
+    pool_->ReleaseEntries(std::move(entries_));
+  }
+}
+
+void PaintRegionMap::set_pool(std::shared_ptr<PaintRegionPool> pool) {
+  FML_DCHECK(entries_.empty());
+  pool_ = std::move(pool);
+}
+
+void PaintRegionMap::Set(uint64_t layer_id, const PaintRegion& region) {
+  FML_DCHECK(layer_id != 0);
+  // Keep the table at most three quarters full.
+  if ((size_ + 1) * 4 > entries_.size() * 3) {
+    Rehash(std::max(kMinTableCapacity, entries_.size() * 2));
+  }
+  size_t mask = entries_.size() - 1;
+  for (size_t i = HashLayerId(layer_id) & mask;; i = (i + 1) & mask) {
+    Entry& entry = entries_[i];
+    if (entry.layer_id == layer_id) {
+      entry.region = region;
+      return;
+    }
+    if (entry.layer_id == 0) {
+      entry.layer_id = layer_id;
+      entry.region = region;
+      size_++;
+      return;
+    }
+  }
+}
+
+PaintRegion PaintRegionMap::Get(uint64_t layer_id) const {
+  if (entries_.empty()) {
+    return PaintRegion();
+  }
+  size_t mask = entries_.size() - 1;
+  for (size_t i = HashLayerId(layer_id) & mask;; i = (i + 1) & mask) {
+    const Entry& entry = entries_[i];
+    if (entry.layer_id == layer_id) {
+      return entry.region;
+    }
+    if (entry.layer_id == 0) {
+      return PaintRegion();
+    }
+  }
+}
+
+void PaintRegionMap::Reserve(size_t count) {
+  size_t capacity = kMinTableCapacity;
+  while (count * 4 > capacity * 3) {
+    capacity *= 2;
+  }
+  if (capacity > entries_.size()) {
+    Rehash(capacity);
+  }
+}
+
+void PaintRegionMap::Rehash(size_t capacity) {
+  FML_DCHECK((capacity & (capacity - 1)) == 0);
+  if (!pool_) {
+    pool_ = std::make_shared<PaintRegionPool>();
+  }
+  std::vector<Entry> old_entries = std::move(entries_);
+  entries_ = pool_->AcquireEntries(capacity);
+  size_t mask = capacity - 1;
+  for (Entry& old_entry : old_entries) {
+    if (old_entry.layer_id == 0) {
+      continue;
+    }
+    size_t i = HashLayerId(old_entry.layer_id) & mask;
+    while (entries_[i].layer_id != 0) {
+      i = (i + 1) & mask;
+    }
+    entries_[i] = std::move(old_entry);
+  }
+  if (!old_entries.empty()) {
+    pool_->ReleaseEntries(std::move(old_entries));
+  }
+}
+
+PaintRegionPool::PaintRegionPool() = default;
+
+PaintRegionPool::~PaintRegionPool() = default;
+
+std::shared_ptr<std::vector<SkRect>> PaintRegionPool::AcquireRects() {
+  std::unique_ptr<std::vector<SkRect>> rects;
+  {
+    std::scoped_lock lock(mutex_);
+    if (!rects_.empty()) {
+      rects = std::move(rects_.back());
+      rects_.pop_back();
+    }
+  }
+  if (!rects) {
+    rects = std::make_unique<std::vector<SkRect>>();
+  }
+  // The regions referring to the rects may outlive the pool.
+  std::weak_ptr<PaintRegionPool> weak_pool = weak_from_this();
+  return std::shared_ptr<std::vector<SkRect>>(
+      rects.release(), [weak_pool](std::vector<SkRect>* rects) {
+        if (auto pool = weak_pool.lock()) {
+          pool->ReleaseRects(rects);
+        } else {
+          delete rects;
+        }
+      });
+}
+
+void PaintRegionPool::ReleaseRects(std::vector<SkRect>* rects) {
+  std::unique_ptr<std::vector<SkRect>> owned_rects(rects);
+  owned_rects->clear();
+  std::scoped_lock lock(mutex_);
+  if (rects_.size() < kMaxPooledCount) {
+    rects_.push_back(std::move(owned_rects));
+  }
+}
+
+std::vector<PaintRegionMap::Entry> PaintRegionPool::AcquireEntries(
+    size_t count) {
+  std::vector<PaintRegionMap::Entry> entries;
+  {
+    std::scoped_lock lock(mutex_);
+    auto it = std::find_if(entries_.begin(), entries_.end(),
+                           [count](const auto& pooled_entries) {
+                             return pooled_entries.capacity() >= count;
+                           });
+    if (it != entries_.end()) {
+      entries = std::move(*it);
+      entries_.erase(it);
+    }
+  }
+  entries.resize(count);
+  return entries;
+}
+
+void PaintRegionPool::ReleaseEntries(
+    std::vector<PaintRegionMap::Entry> entries) {
+  // Dropping the regions may release rects into the pool, so this is done
+  // before taking the lock.
+  entries.clear();
+  std::scoped_lock lock(mutex_);
+  if (entries_.size() < kMaxPooledCount) {
+    entries_.push_back(std::move(entries));
+    return;
+  }
+  // Keep the largest tables.
+  auto smallest = std::min_element(
+      entries_.begin(), entries_.end(), [](const auto& a, const auto& b) {
+        return a.capacity() < b.capacity();
+      });
+  if (smallest->capacity() < entries.capacity()) {
+    *smallest = std::move(entries);
+  }
+}
+
+size_t PaintRegionPool::pooled_rects_count() const {
+  std::scoped_lock lock(mutex_);
+  return rects_.size();
+}
+
+size_t PaintRegionPool::pooled_entries_count() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
 }  // namespace flutter
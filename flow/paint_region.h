@@ -2,8 +2,14 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#ifndef FLUTTER_FLOW_PAINT_REGION_H_
+#define FLUTTER_FLOW_PAINT_REGION_H_
+
+#include <memory>
+#include <mutex>
 #include <vector>
 #include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkRect.h"
 
 namespace flutter {
@@ -64,4 +70,95 @@ class PaintRegion {
   bool has_texture_ = false;
 };
 
+class PaintRegionPool;
+
+// Layer unique id to the PaintRegion of the layer.
+//
+// The map is an open addressing hash table. Its storage comes from a
+// PaintRegionPool and returns to the pool when the map is destroyed, so
+// that the maps of consecutive frames reuse the same storage.
+class PaintRegionMap {
+ public:
+  struct Entry {
+    // Layer unique ids start at 1, 0 marks an empty entry.
+    uint64_t layer_id = 0;
+    PaintRegion region;
+  };
+
+  PaintRegionMap();
+
+  ~PaintRegionMap();
+
+  // Sets the paint region of the layer with |layer_id|.
+  void Set(uint64_t layer_id, const PaintRegion& region);
+
+  // Returns the paint region of the layer with |layer_id|, or an invalid
+  // region if the map has none.
+  PaintRegion Get(uint64_t layer_id) const;
+
+  // Makes room for |count| regions.
+  void Reserve(size_t count);
+
+  size_t size() const { return size_; }
+
+  // The pool that the storage of the map comes from, or nullptr if the map
+  // has not needed any storage yet.
+  const std::shared_ptr<PaintRegionPool>& pool() const { return pool_; }
+
+  // Sets the pool that the storage of the map comes from. Must be called
+  // before the map needs storage.
+  void set_pool(std::shared_ptr<PaintRegionPool> pool);
+
+ private:
+  // Resizes the table to |capacity| entries, a power of two.
+  void Rehash(size_t capacity);
+
+  std::shared_ptr<PaintRegionPool> pool_;
+  std::vector<Entry> entries_;
+  size_t size_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PaintRegionMap);
+};
+
+// Recycles the rect vectors of the paint regions and the tables of the
+// paint region maps of past frames.
+//
+// Diffing a frame fills one rect vector and one map, which stay alive
+// while the layer tree of the frame is the last one. A pool shared between
+// consecutive frames keeps the released ones, so that diffing a tree of the
+// size of the previous ones does not allocate them again.
+class PaintRegionPool : public std::enable_shared_from_this<PaintRegionPool> {
+ public:
+  // The number of released rect vectors and tables the pool keeps.
+  static constexpr size_t kMaxPooledCount = 4;
+
+  PaintRegionPool();
+
+  ~PaintRegionPool();
+
+  // Returns an empty rect vector, which returns to the pool once the last
+  // paint region referring to it is gone.
+  std::shared_ptr<std::vector<SkRect>> AcquireRects();
+
+  // Returns a table of |count| empty entries.
+  std::vector<PaintRegionMap::Entry> AcquireEntries(size_t count);
+
+  // Returns |entries| to the pool.
+  void ReleaseEntries(std::vector<PaintRegionMap::Entry> entries);
+
+  size_t pooled_rects_count() const;
+  size_t pooled_entries_count() const;
+
+ private:
+  void ReleaseRects(std::vector<SkRect>* rects);
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<std::vector<SkRect>>> rects_;
+  std::vector<std::vector<PaintRegionMap::Entry>> entries_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PaintRegionPool);
+};
+
 }  // namespace flutter
+
+#endif  // FLUTTER_FLOW_PAINT_REGION_H_
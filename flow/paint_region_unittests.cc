@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/paint_region.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(PaintRegionMap, SetsAndGetsRegions) {
+  PaintRegionMap map;
+  auto rects = std::make_shared<std::vector<SkRect>>();
+  for (uint64_t id = 1; id <= 1000; id++) {
+    rects->push_back(SkRect::MakeWH(id, id));
+    map.Set(id, PaintRegion(rects, id - 1, id, false, false));
+  }
+  map.Set(10, PaintRegion(rects, 0, 2, true, false));
+  EXPECT_EQ(map.size(), 1000u);
+
+  EXPECT_EQ(map.Get(500).ComputeBounds(), SkRect::MakeWH(500, 500));
+  EXPECT_EQ(map.Get(10).ComputeBounds(), SkRect::MakeWH(2, 2));
+  EXPECT_TRUE(map.Get(10).has_readback());
+  EXPECT_FALSE(map.Get(1001).is_valid());
+  EXPECT_FALSE(PaintRegionMap().Get(1).is_valid());
+}
+
+TEST(PaintRegionPool, ReleasedRectsAreReused) {
+  auto pool = std::make_shared<PaintRegionPool>();
+  auto rects = pool->AcquireRects();
+  rects->resize(100);
+  const SkRect* data = rects->data();
+  PaintRegion region(rects, 0, 100, false, false);
+  rects.reset();
+  EXPECT_EQ(pool->pooled_rects_count(), 0u);
+
+  // The rects return to the pool with the last region referring to them.
+  region = PaintRegion();
+  EXPECT_EQ(pool->pooled_rects_count(), 1u);
+  rects = pool->AcquireRects();
+  EXPECT_TRUE(rects->empty());
+  EXPECT_EQ(rects->data(), data);
+  EXPECT_EQ(pool->pooled_rects_count(), 0u);
+}
+
+TEST(PaintRegionPool, RectsMayOutliveThePool) {
+  auto pool = std::make_shared<PaintRegionPool>();
+  auto rects = pool->AcquireRects();
+  pool.reset();
+  rects->push_back(SkRect::MakeWH(1, 1));
+  rects.reset();
+}
+
+TEST(PaintRegionPool, MapsOfConsecutiveFramesShareStorage) {
+  auto pool = std::make_shared<PaintRegionPool>();
+  auto last_frame_map = std::make_unique<PaintRegionMap>();
+  last_frame_map->set_pool(pool);
+  last_frame_map->Reserve(100);
+  {
+    auto rects = pool->AcquireRects();
+    rects->push_back(SkRect::MakeWH(1, 1));
+    for (uint64_t id = 1; id <= 100; id++) {
+      last_frame_map->Set(id, PaintRegion(rects, 0, 1, false, false));
+    }
+  }
+
+  // The next frame preserves the regions of the last one.
+  PaintRegionMap map;
+  map.set_pool(pool);
+  map.Reserve(last_frame_map->size());
+  for (uint64_t id = 1; id <= 100; id++) {
+    map.Set(id, last_frame_map->Get(id));
+  }
+  last_frame_map.reset();
+  EXPECT_EQ(pool->pooled_entries_count(), 1u);
+  EXPECT_EQ(pool->pooled_rects_count(), 0u);
+
+  PaintRegionMap next_frame_map;
+  next_frame_map.set_pool(pool);
+  next_frame_map.Reserve(map.size());
+  EXPECT_EQ(pool->pooled_entries_count(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
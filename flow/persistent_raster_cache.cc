@@ -0,0 +1,224 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/persistent_raster_cache.h"
+
+#include <cstring>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+
+namespace flutter {
+
+namespace {
+
+// Bump when the format of the keys or of the encoded images changes.
+constexpr uint32_t kPersistentRasterCacheVersion = 1;
+
+struct KeyHeader {
+  uint32_t version;
+  int32_t backend;
+  uint64_t id;
+  SkScalar matrix[9];
+  // Hashes rather than the serialized color space keep the file names
+  // short.
+  uint32_t color_space_xyz_hash;
+  uint32_t color_space_transfer_fn_hash;
+  // Fills the tail padding so that every byte of the key is initialized.
+  uint32_t reserved;
+};
+
+struct ImageHeader {
+  uint32_t version;
+  uint32_t width;
+  uint32_t height;
+  uint32_t color_space_size;
+};
+
+}  // namespace
+
+PersistentRasterCache::PersistentRasterCache(PersistentCache* persistent_cache)
+    : persistent_cache_(persistent_cache) {}
+
+sk_sp<SkData> PersistentRasterCache::MakeKey(uint64_t id,
+                                             const SkMatrix& matrix,
+                                             GrDirectContext* context,
+                                             SkColorSpace* color_space) {
+  KeyHeader header = {};
+  header.version = kPersistentRasterCacheVersion;
+  header.backend = context ? static_cast<int32_t>(context->backend()) : -1;
+  header.id = id;
+  matrix.get9(header.matrix);
+  if (color_space) {
+    header.color_space_xyz_hash = color_space->toXYZD50Hash();
+    header.color_space_transfer_fn_hash = color_space->transferFnHash();
+  }
+  return SkData::MakeWithCopy(&header, sizeof(header));
+}
+
+sk_sp<SkData> PersistentRasterCache::EncodeImage(const SkImage& image,
+                                                 GrDirectContext* context) {
+  SkImageInfo info = SkImageInfo::MakeN32Premul(image.width(), image.height(),
+                                                image.refColorSpace());
+  sk_sp<SkData> color_space_data =
+      info.colorSpace() ? info.colorSpace()->serialize() : nullptr;
+
+  ImageHeader header = {};
+  header.version = kPersistentRasterCacheVersion;
+  header.width = image.width();
+  header.height = image.height();
+  header.color_space_size = color_space_data ? color_space_data->size() : 0;
+  size_t pixels_offset = sizeof(ImageHeader) + header.color_space_size;
+
+  sk_sp<SkData> data =
+      SkData::MakeUninitialized(pixels_offset + info.computeMinByteSize());
+  uint8_t* bytes = static_cast<uint8_t*>(data->writable_data());
+  memcpy(bytes, &header, sizeof(ImageHeader));
+  if (color_space_data) {
+    memcpy(bytes + sizeof(ImageHeader), color_space_data->data(),
+           header.color_space_size);
+  }
+  uint8_t* pixels = bytes + pixels_offset;
+  if (!image.readPixels(context, info, pixels, info.minRowBytes(), 0, 0)) {
+    return nullptr;
+  }
+  return data;
+}
+
+sk_sp<SkImage> PersistentRasterCache::DecodeImage(const SkData& data) {
+  if (data.size() < sizeof(ImageHeader)) {
+    return nullptr;
+  }
+  ImageHeader header;
+  memcpy(&header, data.data(), sizeof(ImageHeader));
+  if (header.version != kPersistentRasterCacheVersion) {
+    return nullptr;
+  }
+  size_t pixels_offset = sizeof(ImageHeader) + header.color_space_size;
+  if (data.size() < pixels_offset) {
+    return nullptr;
+  }
+
+  sk_sp<SkColorSpace> color_space;
+  if (header.color_space_size > 0) {
+    color_space = SkColorSpace::Deserialize(data.bytes() + sizeof(ImageHeader),
+                                            header.color_space_size);
+    if (!color_space) {
+      return nullptr;
+    }
+  }
+  SkImageInfo info = SkImageInfo::MakeN32Premul(header.width, header.height,
+                                                std::move(color_space));
+  if (info.isEmpty() ||
+      data.size() - pixels_offset != info.computeMinByteSize()) {
+    return nullptr;
+  }
+  return SkImage::MakeRasterData(
+      info,
+      SkData::MakeWithCopy(data.bytes() + pixels_offset,
+                           info.computeMinByteSize()),
+      info.minRowBytes());
+}
+
+void PersistentRasterCache::Load(
+    const std::vector<PersistentCache::SkSLCache>& stored,
+    GrDirectContext* resource_context,
+    fml::RefPtr<SkiaUnrefQueue> unref_queue) {
+  TRACE_EVENT0("flutter", "PersistentRasterCache::Load");
+  std::unordered_map<std::string, LoadedImage> images;
+  for (const PersistentCache::SkSLCache& entry : stored) {
+    sk_sp<SkImage> image = DecodeImage(*entry.value);
+    if (!image) {
+      FML_LOG(INFO) << "Discarding a corrupt persistent raster cache image.";
+      if (persistent_cache_) {
+        persistent_cache_->RemoveRasterCacheImage(*entry.key);
+      }
+      continue;
+    }
+    LoadedImage& loaded = images[std::string(
+        static_cast<const char*>(entry.key->data()), entry.key->size())];
+    loaded.key = entry.key;
+    if (resource_context) {
+      image = image->makeTextureImage(resource_context);
+      if (image) {
+        loaded.texture_image =
+            SkiaGPUObject<SkImage>(std::move(image), unref_queue);
+      }
+    } else {
+      loaded.raster_image = std::move(image);
+    }
+  }
+  if (resource_context) {
+    // The raster thread cannot wait for the uploads of this context.
+    resource_context->flushAndSubmit(true);
+  }
+
+  std::scoped_lock lock(mutex_);
+  images_ = std::move(images);
+  loaded_ = true;
+}
+
+std::unique_ptr<RasterCacheResult> PersistentRasterCache::Take(
+    const SkData& key,
+    const SkRect& logical_rect,
+    const SkMatrix& matrix) {
+  LoadedImage loaded;
+  {
+    std::scoped_lock lock(mutex_);
+    auto it = images_.find(
+        std::string(static_cast<const char*>(key.data()), key.size()));
+    if (it == images_.end()) {
+      return nullptr;
+    }
+    loaded = std::move(it->second);
+    images_.erase(it);
+  }
+  sk_sp<SkImage> image = loaded.raster_image
+                             ? loaded.raster_image
+                             : loaded.texture_image.skia_object();
+  SkIRect bounds = RasterCache::GetDeviceBounds(logical_rect, matrix);
+  if (!image || image->dimensions() != bounds.size()) {
+    return nullptr;
+  }
+  TRACE_EVENT_INSTANT0("flutter", "persistent raster cache hit");
+  if (loaded.raster_image) {
+    return std::make_unique<RasterCacheResult>(
+        std::move(image), logical_rect, "RasterCacheFlow::DisplayList");
+  }
+  return std::make_unique<ResourceContextRasterCacheResult>(
+      std::move(loaded.texture_image), logical_rect,
+      "RasterCacheFlow::DisplayList");
+}
+
+void PersistentRasterCache::Store(const SkData& key,
+                                  const SkImage& image,
+                                  GrDirectContext* context) {
+  if (!persistent_cache_) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "PersistentRasterCache::Store");
+  sk_sp<SkData> data = EncodeImage(image, context);
+  if (data) {
+    persistent_cache_->StoreRasterCacheImage(key, *data);
+  }
+}
+
+void PersistentRasterCache::RemoveUnusedImages() {
+  std::scoped_lock lock(mutex_);
+  if (!loaded_) {
+    // The images that are still being loaded may yet be used by a later
+    // launch that gets to them in time.
+    return;
+  }
+  if (persistent_cache_) {
+    for (const auto& item : images_) {
+      persistent_cache_->RemoveRasterCacheImage(*item.second.key);
+    }
+  }
+  images_.clear();
+}
+
+}  // namespace flutter
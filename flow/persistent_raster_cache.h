@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_PERSISTENT_RASTER_CACHE_H_
+#define FLUTTER_FLOW_PERSISTENT_RASTER_CACHE_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/flow/raster_cache.h"
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
+
+namespace flutter {
+
+// A tier of the |RasterCache| that keeps the images of DisplayList entries
+// on disk, in the |PersistentCache| directory, so that the static content
+// of the first frames after a cold start does not have to be rasterized
+// again.
+//
+// The images are keyed by the content of the DisplayList, the matrix that
+// it is drawn with and the backend and color space of the frames, and are
+// stored as raw pixels so that loading them only costs a copy and an
+// upload. Only the images that are rasterized during the first
+// |kStartupFrameCount| frames are stored, and any stored image that is not
+// used during those frames is removed once they are over.
+//
+// |Load| is called on the IO thread, ideally before the first frame, and
+// the other methods on the raster thread.
+class PersistentRasterCache {
+ public:
+  // The number of frames, about a second, during which new images are
+  // stored and after which the unused stored images are removed.
+  static constexpr size_t kStartupFrameCount = 60;
+
+  // The images are stored to and removed from |persistent_cache|, which
+  // may be null to only use the images given to |Load|.
+  explicit PersistentRasterCache(PersistentCache* persistent_cache);
+
+  // Decodes the |stored| images, as returned by
+  // |PersistentCache::LoadRasterCacheImages|, and uploads them with the
+  // |resource_context| if there is one. Those images are released through
+  // |unref_queue|.
+  void Load(const std::vector<PersistentCache::SkSLCache>& stored,
+            GrDirectContext* resource_context,
+            fml::RefPtr<SkiaUnrefQueue> unref_queue);
+
+  // Returns the loaded image for |key| if it has the size of the image of
+  // |logical_rect| drawn with |matrix|, or nullptr. An image is only
+  // returned once.
+  std::unique_ptr<RasterCacheResult> Take(const SkData& key,
+                                          const SkRect& logical_rect,
+                                          const SkMatrix& matrix);
+
+  // Stores |image| under |key|, reading its pixels back with |context|,
+  // which must be the context of the image or null for a raster image.
+  void Store(const SkData& key, const SkImage& image, GrDirectContext* context);
+
+  // Removes the stored images that have been loaded but never taken.
+  void RemoveUnusedImages();
+
+  // Returns the key of the image of the DisplayList entry with |id| drawn
+  // with |matrix| into frames rendered with |context| and |color_space|.
+  static sk_sp<SkData> MakeKey(uint64_t id,
+                               const SkMatrix& matrix,
+                               GrDirectContext* context,
+                               SkColorSpace* color_space);
+
+  static sk_sp<SkData> EncodeImage(const SkImage& image,
+                                   GrDirectContext* context);
+
+  // Returns a raster image with the pixels of an image encoded by
+  // |EncodeImage|, or nullptr if |data| is not such an image.
+  static sk_sp<SkImage> DecodeImage(const SkData& data);
+
+ private:
+  struct LoadedImage {
+    sk_sp<SkData> key;
+    // Set if the image was loaded without a resource context.
+    sk_sp<SkImage> raster_image;
+    // Set if the image was uploaded with a resource context.
+    SkiaGPUObject<SkImage> texture_image;
+  };
+
+  PersistentCache* const persistent_cache_;
+  std::mutex mutex_;
+  bool loaded_ = false;
+  // The loaded images by the bytes of their keys.
+  std::unordered_map<std::string, LoadedImage> images_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PersistentRasterCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_PERSISTENT_RASTER_CACHE_H_
@@ -0,0 +1,145 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/persistent_raster_cache.h"
+
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/flow/testing/mock_raster_cache.h"
+#include "flutter/fml/file.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+sk_sp<SkImage> MakeImage(int width, int height) {
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(width, height);
+  surface->getCanvas()->clear(SK_ColorBLUE);
+  SkPaint paint;
+  paint.setColor(SK_ColorRED);
+  surface->getCanvas()->drawRect(SkRect::MakeWH(width / 2, height), paint);
+  return surface->makeImageSnapshot();
+}
+
+sk_sp<SkData> MakeKey(uint64_t id) {
+  return PersistentRasterCache::MakeKey(id, SkMatrix::I(), nullptr, nullptr);
+}
+
+}  // namespace
+
+TEST(PersistentRasterCache, EncodedImageIsDecodedWithSamePixels) {
+  sk_sp<SkImage> image = MakeImage(20, 10);
+
+  sk_sp<SkData> data = PersistentRasterCache::EncodeImage(*image, nullptr);
+  ASSERT_NE(data, nullptr);
+  sk_sp<SkImage> decoded = PersistentRasterCache::DecodeImage(*data);
+
+  ASSERT_NE(decoded, nullptr);
+  ASSERT_EQ(decoded->dimensions(), image->dimensions());
+  SkBitmap expected;
+  SkBitmap actual;
+  ASSERT_TRUE(image->asLegacyBitmap(&expected));
+  ASSERT_TRUE(decoded->asLegacyBitmap(&actual));
+  EXPECT_EQ(actual.getColor(0, 0), expected.getColor(0, 0));
+  EXPECT_EQ(actual.getColor(15, 5), expected.getColor(15, 5));
+}
+
+TEST(PersistentRasterCache, CorruptDataIsNotDecoded) {
+  sk_sp<SkData> data =
+      PersistentRasterCache::EncodeImage(*MakeImage(20, 10), nullptr);
+  ASSERT_NE(data, nullptr);
+
+  sk_sp<SkData> truncated = SkData::MakeSubset(data.get(), 0, data->size() - 1);
+  EXPECT_EQ(PersistentRasterCache::DecodeImage(*truncated), nullptr);
+  sk_sp<SkData> header = SkData::MakeSubset(data.get(), 0, 8);
+  EXPECT_EQ(PersistentRasterCache::DecodeImage(*header), nullptr);
+  EXPECT_EQ(PersistentRasterCache::DecodeImage(*SkData::MakeEmpty()), nullptr);
+}
+
+TEST(PersistentRasterCache, KeyDependsOnIdAndMatrix) {
+  SkMatrix scale = SkMatrix::Scale(2, 2);
+
+  EXPECT_TRUE(MakeKey(1)->equals(MakeKey(1).get()));
+  EXPECT_FALSE(MakeKey(1)->equals(MakeKey(2).get()));
+  EXPECT_FALSE(MakeKey(1)->equals(
+      PersistentRasterCache::MakeKey(1, scale, nullptr, nullptr).get()));
+}
+
+TEST(PersistentRasterCache, LoadedImageIsTakenOnce) {
+  PersistentRasterCache cache(nullptr);
+  sk_sp<SkData> key = MakeKey(1);
+  cache.Load({{key, PersistentRasterCache::EncodeImage(*MakeImage(20, 10),
+                                                       nullptr)}},
+             nullptr, nullptr);
+  SkRect logical_rect = SkRect::MakeWH(20, 10);
+
+  EXPECT_EQ(cache.Take(*MakeKey(2), logical_rect, SkMatrix::I()), nullptr);
+  std::unique_ptr<RasterCacheResult> result =
+      cache.Take(*key, logical_rect, SkMatrix::I());
+  ASSERT_NE(result, nullptr);
+  EXPECT_EQ(result->image_dimensions(), SkISize::Make(20, 10));
+  EXPECT_EQ(cache.Take(*key, logical_rect, SkMatrix::I()), nullptr);
+}
+
+TEST(PersistentRasterCache, ImageOfDifferentSizeIsNotTaken) {
+  PersistentRasterCache cache(nullptr);
+  sk_sp<SkData> key = MakeKey(1);
+  cache.Load({{key, PersistentRasterCache::EncodeImage(*MakeImage(20, 10),
+                                                       nullptr)}},
+             nullptr, nullptr);
+
+  EXPECT_EQ(cache.Take(*key, SkRect::MakeWH(20, 20), SkMatrix::I()), nullptr);
+}
+
+TEST(PersistentRasterCache, StoredImageIsUsedOnFirstFrameOfNextLaunch) {
+  fml::ScopedTemporaryDirectory dir;
+  PersistentCache::SetCacheDirectoryPath(dir.path());
+  PersistentCache::ResetCacheForProcess();
+
+  DisplayListBuilder builder(SkRect::MakeWH(150, 100));
+  builder.setColor(SK_ColorRED);
+  builder.drawRect(SkRect::MakeXYWH(10, 10, 80, 80));
+  sk_sp<DisplayList> display_list = builder.Build();
+  SkMatrix matrix = SkMatrix::I();
+  SkCanvas dummy_canvas;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  {
+    RasterCache cache(1);
+    cache.SetPersistentRasterCache(std::make_shared<PersistentRasterCache>(
+        PersistentCache::GetCacheForProcess()));
+    for (int i = 0; i < 2; i++) {
+      cache.PrepareNewFrame();
+      cache.Prepare(&preroll_context_holder.preroll_context,
+                    display_list.get(), true, false, matrix);
+      cache.Draw(*display_list, dummy_canvas);
+      cache.CleanupAfterFrame();
+    }
+  }
+
+  std::vector<PersistentCache::SkSLCache> stored =
+      PersistentCache::GetCacheForProcess()->LoadRasterCacheImages();
+  ASSERT_EQ(stored.size(), 1u);
+
+  RasterCache cache(3);
+  auto persistent_cache = std::make_shared<PersistentRasterCache>(
+      PersistentCache::GetCacheForProcess());
+  persistent_cache->Load(stored, nullptr, nullptr);
+  cache.SetPersistentRasterCache(persistent_cache);
+  cache.PrepareNewFrame();
+
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            display_list.get(), true, false, matrix));
+  ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
+
+  PersistentCache::SetCacheDirectoryPath("");
+  PersistentCache::ResetCacheForProcess();
+}
+
+}  // namespace testing
+}  // namespace flutter
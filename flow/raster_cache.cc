@@ -4,17 +4,25 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #include <vector>
 
 #include "flutter/common/constants.h"
+#include "flutter/display_list/display_list_canvas_dispatcher.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
+#include "flutter/flow/persistent_raster_cache.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkDeferredDisplayListRecorder.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/core/SkSurfaceCharacterization.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
 namespace flutter {
@@ -27,8 +35,9 @@ RasterCacheResult::RasterCacheResult(sk_sp<SkImage> image,
 void RasterCacheResult::draw(SkCanvas& canvas, const SkPaint* paint) const {
   TRACE_EVENT0("flutter", "RasterCacheResult::draw");
   SkAutoCanvasRestore auto_restore(&canvas, true);
-  SkIRect bounds =
-      RasterCache::GetDeviceBounds(logical_rect_, canvas.getTotalMatrix());
+  SkIRect bounds = RasterCache::GetDeviceBounds(
+      logical_rect_,
+      RasterCache::GetSubpixelBucketCTM(canvas.getTotalMatrix()));
   FML_DCHECK(
       std::abs(bounds.size().width() - image_->dimensions().width()) <= 1 &&
       std::abs(bounds.size().height() - image_->dimensions().height()) <= 1);
@@ -38,6 +47,21 @@ void RasterCacheResult::draw(SkCanvas& canvas, const SkPaint* paint) const {
                    paint);
 }
 
+size_t RasterCacheBudget::GetBytesUsedByOthers(const RasterCache* cache) const {
+  size_t bytes = 0;
+  for (const RasterCache* other : caches_) {
+    if (other != cache) {
+      bytes += other->GetUsedBytes();
+    }
+  }
+  return bytes;
+}
+
+void RasterCacheBudget::RemoveCache(const RasterCache* cache) {
+  caches_.erase(std::remove(caches_.begin(), caches_.end(), cache),
+                caches_.end());
+}
+
 RasterCache::RasterCache(size_t access_threshold,
                          size_t picture_and_display_list_cache_limit_per_frame)
     : access_threshold_(access_threshold),
@@ -45,6 +69,22 @@ RasterCache::RasterCache(size_t access_threshold,
           picture_and_display_list_cache_limit_per_frame),
       checkerboard_images_(false) {}
 
+RasterCache::~RasterCache() {
+  if (budget_) {
+    budget_->RemoveCache(this);
+  }
+}
+
+void RasterCache::SetSharedBudget(std::shared_ptr<RasterCacheBudget> budget) {
+  if (budget_) {
+    budget_->RemoveCache(this);
+  }
+  budget_ = std::move(budget);
+  if (budget_) {
+    budget_->AddCache(this);
+  }
+}
+
 static bool CanRasterizeRect(const SkRect& cull_rect) {
   if (cull_rect.isEmpty()) {
     // No point in ever rasterizing an empty display list.
@@ -115,42 +155,272 @@ static bool IsDisplayListWorthRasterizing(
   return complexity_calculator->should_be_cached(complexity_score);
 }
 
+// The number of bytes used by the image that |Rasterize| would produce for
+// |logical_rect| drawn with |ctm|.
+static size_t EstimateImageBytes(const SkRect& logical_rect,
+                                 const SkMatrix& ctm) {
+  SkIRect cache_rect = RasterCache::GetDeviceBounds(logical_rect, ctm);
+  return SkImageInfo::MakeN32Premul(cache_rect.width(), cache_rect.height())
+      .computeMinByteSize();
+}
+
+// Draws the contents of the image of |logical_rect| drawn with |ctm| into
+// |canvas|, whose origin is at the top left of |cache_rect|.
+static void DrawImageContents(
+    SkCanvas* canvas,
+    const SkIRect& cache_rect,
+    const SkMatrix& ctm,
+    bool checkerboard,
+    const SkRect& logical_rect,
+    const std::function<void(SkCanvas*)>& draw_function) {
+  canvas->clear(SK_ColorTRANSPARENT);
+  canvas->translate(-cache_rect.left(), -cache_rect.top());
+  canvas->concat(ctm);
+  draw_function(canvas);
+
+  if (checkerboard) {
+    DrawCheckerboard(canvas, logical_rect);
+  }
+}
+
+static sk_sp<SkSurface> MakeImageSurface(GrDirectContext* context,
+                                         const SkIRect& cache_rect,
+                                         SkColorSpace* dst_color_space) {
+  const SkImageInfo image_info = SkImageInfo::MakeN32Premul(
+      cache_rect.width(), cache_rect.height(), sk_ref_sp(dst_color_space));
+
+  if (context) {
+    return SkSurface::MakeRenderTarget(context, SkBudgeted::kYes, image_info);
+  }
+  return SkSurface::MakeRaster(image_info);
+}
+
 /// @note Procedure doesn't copy all closures.
-static std::unique_ptr<RasterCacheResult> Rasterize(
+static sk_sp<SkImage> RasterizeImage(
     GrDirectContext* context,
     const SkMatrix& ctm,
     SkColorSpace* dst_color_space,
     bool checkerboard,
     const SkRect& logical_rect,
-    const char* type,
     const std::function<void(SkCanvas*)>& draw_function) {
   TRACE_EVENT0("flutter", "RasterCachePopulate");
   SkIRect cache_rect = RasterCache::GetDeviceBounds(logical_rect, ctm);
 
-  const SkImageInfo image_info = SkImageInfo::MakeN32Premul(
-      cache_rect.width(), cache_rect.height(), sk_ref_sp(dst_color_space));
-
   sk_sp<SkSurface> surface =
-      context
-          ? SkSurface::MakeRenderTarget(context, SkBudgeted::kYes, image_info)
-          : SkSurface::MakeRaster(image_info);
+      MakeImageSurface(context, cache_rect, dst_color_space);
 
   if (!surface) {
     return nullptr;
   }
 
-  SkCanvas* canvas = surface->getCanvas();
-  canvas->clear(SK_ColorTRANSPARENT);
-  canvas->translate(-cache_rect.left(), -cache_rect.top());
-  canvas->concat(ctm);
-  draw_function(canvas);
+  DrawImageContents(surface->getCanvas(), cache_rect, ctm, checkerboard,
+                    logical_rect, draw_function);
 
-  if (checkerboard) {
-    DrawCheckerboard(canvas, logical_rect);
+  return surface->makeImageSnapshot();
+}
+
+/// @note Procedure doesn't copy all closures.
+static std::unique_ptr<RasterCacheResult> Rasterize(
+    GrDirectContext* context,
+    const SkMatrix& ctm,
+    SkColorSpace* dst_color_space,
+    bool checkerboard,
+    const SkRect& logical_rect,
+    const char* type,
+    const std::function<void(SkCanvas*)>& draw_function) {
+  sk_sp<SkImage> image = RasterizeImage(context, ctm, dst_color_space,
+                                        checkerboard, logical_rect,
+                                        draw_function);
+  if (!image) {
+    return nullptr;
   }
+  return std::make_unique<RasterCacheResult>(std::move(image), logical_rect,
+                                             type);
+}
 
-  return std::make_unique<RasterCacheResult>(surface->makeImageSnapshot(),
-                                             logical_rect, type);
+template <class Key>
+void RasterCache::RasterizeAsync(
+    Entry& entry,
+    const Key& key,
+    size_t reserved_bytes,
+    PrerollContext* context,
+    const SkMatrix& ctm,
+    const SkRect& logical_rect,
+    const char* type,
+    std::function<void(SkCanvas*)> draw_function,
+    std::vector<AsyncResult<Key>> AsyncResults::*results_member,
+    sk_sp<SkData> persistent_key) {
+  entry.async_pending = true;
+  pending_bytes_ += reserved_bytes;
+  resource_context_task_runner_(
+      [results = async_results_, results_member, key, reserved_bytes,
+       needs_resource_context = context->gr_context != nullptr, ctm,
+       dst_color_space = sk_ref_sp(context->dst_color_space),
+       checkerboard = checkerboard_images_, logical_rect, type,
+       draw_function = std::move(draw_function), unref_queue = unref_queue_,
+       persistent_cache = persistent_key ? persistent_cache_ : nullptr,
+       persistent_key](GrDirectContext* resource_context) {
+        std::unique_ptr<RasterCacheResult> image;
+        if (resource_context) {
+          sk_sp<SkImage> snapshot =
+              RasterizeImage(resource_context, ctm, dst_color_space.get(),
+                             checkerboard, logical_rect, draw_function);
+          if (snapshot) {
+            // The raster thread cannot wait for the work of this context,
+            // so it must be finished before the image is handed over.
+            resource_context->flushAndSubmit(true);
+            if (persistent_cache) {
+              persistent_cache->Store(*persistent_key, *snapshot,
+                                      resource_context);
+            }
+            image = std::make_unique<ResourceContextRasterCacheResult>(
+                SkiaGPUObject<SkImage>(std::move(snapshot), unref_queue),
+                logical_rect, type);
+          }
+        } else if (!needs_resource_context) {
+          image = Rasterize(nullptr, ctm, dst_color_space.get(), checkerboard,
+                            logical_rect, type, draw_function);
+          if (image && persistent_cache) {
+            persistent_cache->Store(*persistent_key, *image->image(), nullptr);
+          }
+        }
+        std::scoped_lock lock(results->mutex);
+        ((*results).*results_member)
+            .push_back({key, reserved_bytes, std::move(image)});
+      });
+}
+
+template <class Cache, class Key>
+void RasterCache::PromoteAsyncResults(Cache& cache,
+                                      std::vector<AsyncResult<Key>>& results) {
+  for (AsyncResult<Key>& result : results) {
+    pending_bytes_ -= result.reserved_bytes;
+    auto it = cache.find(result.key);
+    if (it == cache.end() || !it->second.async_pending) {
+      // The entry was swept while its image was being rasterized.
+      continue;
+    }
+    Entry& entry = it->second;
+    entry.async_pending = false;
+    if (result.image) {
+      entry.image = std::move(result.image);
+    } else {
+      entry.async_failed = true;
+    }
+  }
+}
+
+bool RasterCache::ShouldRecordConcurrently(const PrerollContext* context,
+                                           const Entry& entry) const {
+  return recording_task_runner_ && context->gr_context && !entry.async_failed;
+}
+
+bool RasterCache::RecordConcurrently(
+    Entry& entry,
+    size_t reserved_bytes,
+    PrerollContext* context,
+    const SkMatrix& ctm,
+    const SkRect& logical_rect,
+    const char* type,
+    std::function<void(SkCanvas*)> draw_function,
+    sk_sp<SkData> persistent_key) {
+  SkIRect cache_rect = GetDeviceBounds(logical_rect, ctm);
+  sk_sp<SkSurface> surface = MakeImageSurface(context->gr_context, cache_rect,
+                                              context->dst_color_space);
+  SkSurfaceCharacterization characterization;
+  if (!surface || !surface->characterize(&characterization)) {
+    return false;
+  }
+
+  auto promise =
+      std::make_shared<std::promise<sk_sp<SkDeferredDisplayList>>>();
+  recordings_.push_back({&entry, reserved_bytes, context->gr_context,
+                         std::move(surface), promise->get_future(),
+                         logical_rect, type, std::move(persistent_key)});
+  entry.async_pending = true;
+  pending_bytes_ += reserved_bytes;
+  recording_task_runner_->PostTask(
+      [promise, characterization, cache_rect, ctm,
+       checkerboard = checkerboard_images_, logical_rect,
+       draw_function = std::move(draw_function)]() {
+        TRACE_EVENT0("flutter", "RasterCacheRecord");
+        SkDeferredDisplayListRecorder recorder(characterization);
+        DrawImageContents(recorder.getCanvas(), cache_rect, ctm, checkerboard,
+                          logical_rect, draw_function);
+        promise->set_value(recorder.detach());
+      });
+  return true;
+}
+
+void RasterCache::DrawRecordedImages() {
+  if (recordings_.empty()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "RasterCache::DrawRecordedImages");
+  for (Recording& recording : recordings_) {
+    sk_sp<SkDeferredDisplayList> display_list = recording.display_list.get();
+    Entry& entry = *recording.entry;
+    pending_bytes_ -= recording.reserved_bytes;
+    entry.async_pending = false;
+    sk_sp<SkImage> image;
+    if (display_list && recording.surface->draw(display_list)) {
+      image = recording.surface->makeImageSnapshot();
+    }
+    if (!image) {
+      // Rasterize the image during a later Prepare instead.
+      entry.async_failed = true;
+      continue;
+    }
+    if (recording.persistent_key) {
+      persistent_cache_->Store(*recording.persistent_key, *image,
+                               recording.context);
+    }
+    entry.image = std::make_unique<RasterCacheResult>(
+        std::move(image), recording.logical_rect, recording.type);
+  }
+  recordings_.clear();
+}
+
+void RasterCache::SetConcurrentRecordingTaskRunner(
+    std::shared_ptr<fml::ConcurrentTaskRunner> task_runner) {
+  Clear();
+  recording_task_runner_ = std::move(task_runner);
+}
+
+void RasterCache::SetResourceContextTaskRunner(
+    ResourceContextTaskRunner task_runner,
+    fml::RefPtr<SkiaUnrefQueue> unref_queue) {
+  Clear();
+  resource_context_task_runner_ = std::move(task_runner);
+  unref_queue_ = std::move(unref_queue);
+  async_results_ = resource_context_task_runner_
+                       ? std::make_shared<AsyncResults>()
+                       : nullptr;
+}
+
+void RasterCache::SetPersistentRasterCache(
+    std::shared_ptr<PersistentRasterCache> persistent_cache) {
+  persistent_cache_ = std::move(persistent_cache);
+  persistent_frame_count_ = 0;
+}
+
+sk_sp<SkData> RasterCache::GetPersistentKey(
+    PrerollContext* context,
+    const DisplayList& display_list,
+    const DisplayListRasterCacheKey& key) const {
+  if (!persistent_cache_ || checkerboard_images_ ||
+      persistent_frame_count_ >= PersistentRasterCache::kStartupFrameCount) {
+    return nullptr;
+  }
+  // The content hash of a list that references other objects mixes in
+  // their addresses, which do not identify the same content in another
+  // launch.
+  if (!display_list.CanSerialize()) {
+    return nullptr;
+  }
+  return PersistentRasterCache::MakeKey(key.id(), key.matrix(),
+                                        context->gr_context,
+                                        context->dst_color_space);
 }
 
 std::unique_ptr<RasterCacheResult> RasterCache::RasterizePicture(
@@ -178,12 +448,24 @@ std::unique_ptr<RasterCacheResult> RasterCache::RasterizeDisplayList(
 void RasterCache::Prepare(PrerollContext* context,
                           Layer* layer,
                           const SkMatrix& ctm) {
+  if (auto* deferred_calls = context->deferred_raster_cache_calls) {
+    deferred_calls->push_back([this, layer, ctm](PrerollContext* context) {
+      Prepare(context, layer, ctm);
+    });
+    return;
+  }
   LayerRasterCacheKey cache_key(layer->unique_id(), ctm);
   Entry& entry = layer_cache_[cache_key];
-  entry.access_count++;
-  entry.used_this_frame = true;
+  MarkUsed(entry);
   if (!entry.image) {
-    entry.image = RasterizeLayer(context, layer, ctm, checkerboard_images_);
+    // The layers snap their matrices to whole pixels themselves unless
+    // fractional translations are supported.
+    SkMatrix raster_matrix = GetSubpixelBucketCTM(ctm);
+    size_t bytes = EstimateImageBytes(layer->paint_bounds(), raster_matrix);
+    if (ReserveBytes(bytes)) {
+      entry.image =
+          RasterizeLayer(context, layer, raster_matrix, checkerboard_images_);
+    }
   }
 }
 
@@ -219,12 +501,170 @@ std::unique_ptr<RasterCacheResult> RasterCache::RasterizeLayer(
       });
 }
 
+static ShadowRasterCacheId ShadowCacheId(const SkPath& path,
+                                         SkColor color,
+                                         SkScalar elevation,
+                                         bool transparent_occluder,
+                                         SkScalar dpr) {
+  return {path.getGenerationID(), color, elevation, transparent_occluder, dpr};
+}
+
+bool RasterCache::PrepareShadow(PrerollContext* context,
+                                const SkPath& path,
+                                SkColor color,
+                                SkScalar elevation,
+                                bool transparent_occluder,
+                                SkScalar dpr,
+                                const SkMatrix& ctm) {
+  if (auto* deferred_calls = context->deferred_raster_cache_calls) {
+    deferred_calls->push_back([this, path, color, elevation,
+                               transparent_occluder, dpr,
+                               ctm](PrerollContext* context) {
+      PrepareShadow(context, path, color, elevation, transparent_occluder, dpr,
+                    ctm);
+    });
+    return false;
+  }
+  // Disabling caching when access_threshold is zero is historic behavior.
+  if (access_threshold_ == 0 || path.isVolatile() || !ctm.invert(nullptr)) {
+    return false;
+  }
+
+  ShadowRasterCacheKey cache_key(
+      ShadowCacheId(path, color, elevation, transparent_occluder, dpr), ctm);
+  // Creates an entry, if not present prior.
+  Entry& entry = shadow_cache_[cache_key];
+  if (entry.access_count < access_threshold_) {
+    // Frame threshold has not yet been reached.
+    return false;
+  }
+
+  if (!entry.image) {
+    if (shadow_cached_this_frame_ >=
+        picture_and_display_list_cache_limit_per_frame_) {
+      return false;
+    }
+    SkMatrix raster_matrix = GetSubpixelBucketCTM(ctm);
+    SkRect logical_rect = DisplayListCanvasDispatcher::ComputeShadowBounds(
+        path, elevation, dpr, raster_matrix);
+    size_t bytes = EstimateImageBytes(logical_rect, raster_matrix);
+    if (!ReserveBytes(bytes)) {
+      return false;
+    }
+    entry.image = Rasterize(
+        context->gr_context, raster_matrix, context->dst_color_space,
+        checkerboard_images_, logical_rect, "RasterCacheFlow::Shadow",
+        [&](SkCanvas* canvas) {
+          DisplayListCanvasDispatcher::DrawShadow(
+              canvas, path, color, elevation, transparent_occluder, dpr);
+        });
+    shadow_cached_this_frame_++;
+  }
+  // Keep the entry from being evicted for the budget before it is drawn.
+  entry.last_access = ++access_clock_;
+  return entry.image != nullptr;
+}
+
+// Identifies a rasterization candidate by the ID of its entry and the scale
+// and skew of its matrix, which determine the contents of its image.
+static uint64_t RasterizationCandidateId(uint64_t id,
+                                         bool is_picture,
+                                         const SkMatrix& matrix) {
+  uint64_t candidate_id = is_picture ? ~id : id;
+  for (int index : {SkMatrix::kMScaleX, SkMatrix::kMSkewX, SkMatrix::kMSkewY,
+                    SkMatrix::kMScaleY}) {
+    const SkScalar value = matrix[index];
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    candidate_id = (candidate_id ^ bits) * 0x100000001b3ULL;
+  }
+  return candidate_id;
+}
+
+// The number of device pixels covered by the image of |logical_rect| drawn
+// with |ctm|.
+static int64_t GetDeviceArea(const SkRect& logical_rect, const SkMatrix& ctm) {
+  const SkIRect bounds = RasterCache::GetDeviceBounds(logical_rect, ctm);
+  return static_cast<int64_t>(bounds.width()) * bounds.height();
+}
+
+void RasterCache::RasterizationCostEstimator::AddSample(unsigned int complexity,
+                                                        fml::TimeDelta time) {
+  if (complexity == 0) {
+    return;
+  }
+  const double sample = time.ToNanosecondsF() / complexity;
+  // The recent samples weigh more, since the clocks of the device and the
+  // kind of contents change over time.
+  nanos_per_unit_ =
+      nanos_per_unit_ == 0 ? sample : nanos_per_unit_ * 0.75 + sample * 0.25;
+}
+
+bool RasterCache::FitsRasterizationBudget(uint64_t candidate_id,
+                                          int64_t area,
+                                          fml::TimeDelta cost) {
+  auto reserved = reserved_candidates_.find(candidate_id);
+  if (reserved != reserved_candidates_.end()) {
+    reserved_rasterization_cost_ =
+        reserved_rasterization_cost_ - reserved->second;
+    reserved_candidates_.erase(reserved);
+    rasterization_cost_this_frame_ = rasterization_cost_this_frame_ + cost;
+    return true;
+  }
+  const bool is_first_of_frame = reserved_candidates_.empty() &&
+                                 picture_cached_this_frame_ == 0 &&
+                                 display_list_cached_this_frame_ == 0;
+  if (rasterization_budget_ == fml::TimeDelta::Zero() || is_first_of_frame ||
+      rasterization_cost_this_frame_ + reserved_rasterization_cost_ + cost <=
+          rasterization_budget_) {
+    rasterization_cost_this_frame_ = rasterization_cost_this_frame_ + cost;
+    return true;
+  }
+  pending_candidates_[candidate_id] = {area, cost};
+  return false;
+}
+
+void RasterCache::ReserveRasterizationBudget() {
+  rasterization_cost_this_frame_ = fml::TimeDelta::Zero();
+  reserved_rasterization_cost_ = fml::TimeDelta::Zero();
+  reserved_candidates_.clear();
+  if (pending_candidates_.empty()) {
+    return;
+  }
+  std::vector<std::pair<uint64_t, RasterizationCandidate>> candidates(
+      pending_candidates_.begin(), pending_candidates_.end());
+  pending_candidates_.clear();
+  std::sort(candidates.begin(), candidates.end(),
+            [](const auto& a, const auto& b) {
+              return a.second.area > b.second.area;
+            });
+  // The largest candidate is reserved even if it does not fit on its own,
+  // as it would be the first of the frame anyway.
+  for (const auto& [candidate_id, candidate] : candidates) {
+    const fml::TimeDelta cost = reserved_rasterization_cost_ + candidate.cost;
+    if (!reserved_candidates_.empty() && cost > rasterization_budget_) {
+      break;
+    }
+    reserved_candidates_[candidate_id] = candidate.cost;
+    reserved_rasterization_cost_ = cost;
+  }
+}
+
 bool RasterCache::Prepare(PrerollContext* context,
                           SkPicture* picture,
                           bool is_complex,
                           bool will_change,
                           const SkMatrix& untranslated_matrix,
                           const SkPoint& offset) {
+  if (auto* deferred_calls = context->deferred_raster_cache_calls) {
+    deferred_calls->push_back([this, picture, is_complex, will_change,
+                               untranslated_matrix,
+                               offset](PrerollContext* context) {
+      Prepare(context, picture, is_complex, will_change, untranslated_matrix,
+              offset);
+    });
+    return false;
+  }
   if (!GenerateNewCacheInThisFrame()) {
     return false;
   }
@@ -252,26 +692,98 @@ bool RasterCache::Prepare(PrerollContext* context,
   }
 
   if (!entry.image) {
+    if (entry.async_pending) {
+      // The image is still being rasterized with the resource context.
+      return false;
+    }
     // GetIntegralTransCTM effect for matrix which only contains scale,
     // translate, so it won't affect result of matrix decomposition and cache
     // key.
 #ifndef SUPPORT_FRACTIONAL_TRANSLATION
     transformation_matrix = GetIntegralTransCTM(transformation_matrix);
+#else
+    transformation_matrix = GetSubpixelBucketCTM(transformation_matrix);
 #endif
+    const unsigned int complexity = picture->approximateOpCount(true);
+    if (!FitsRasterizationBudget(
+            RasterizationCandidateId(picture->uniqueID(), true,
+                                     transformation_matrix),
+            GetDeviceArea(picture->cullRect(), transformation_matrix),
+            picture_cost_estimator_.Estimate(complexity))) {
+      return false;
+    }
+    size_t bytes =
+        EstimateImageBytes(picture->cullRect(), transformation_matrix);
+    if (!ReserveBytes(bytes)) {
+      return false;
+    }
+    if (ShouldRasterizeAsync(entry)) {
+      RasterizeAsync(
+          entry, cache_key, bytes, context, transformation_matrix,
+          picture->cullRect(), "RasterCacheFlow::SkPicture",
+          [picture = sk_ref_sp(picture)](SkCanvas* canvas) {
+            canvas->drawPicture(picture);
+          },
+          &AsyncResults::pictures, nullptr);
+      picture_cached_this_frame_++;
+      return false;
+    }
+    if (ShouldRecordConcurrently(context, entry) &&
+        RecordConcurrently(
+            entry, bytes, context, transformation_matrix, picture->cullRect(),
+            "RasterCacheFlow::SkPicture",
+            [picture = sk_ref_sp(picture)](SkCanvas* canvas) {
+              canvas->drawPicture(picture);
+            },
+            nullptr)) {
+      picture_cached_this_frame_++;
+      return false;
+    }
+    const fml::TimePoint start = fml::TimePoint::Now();
     entry.image =
         RasterizePicture(picture, context->gr_context, transformation_matrix,
                          context->dst_color_space, checkerboard_images_);
+    picture_cost_estimator_.AddSample(complexity,
+                                      fml::TimePoint::Now() - start);
     picture_cached_this_frame_++;
   }
+  // Keep the entry from being evicted for the budget before it is drawn.
+  entry.last_access = ++access_clock_;
   return true;
 }
 
+// DisplayLists are cached by content rather than by identity so that a
+// list which is rebuilt with the same ops on a later frame can reuse the
+// image rasterized for its predecessor. The content hash only covers the
+// op records, so the cull rect that bounds any drawPaint() or drawColor()
+// ops is mixed in as well.
+static uint64_t DisplayListCacheId(const DisplayList& display_list) {
+  uint64_t id = display_list.content_hash();
+  const SkRect& cull_rect = display_list.cull_rect();
+  for (SkScalar value : {cull_rect.fLeft, cull_rect.fTop, cull_rect.fRight,
+                         cull_rect.fBottom}) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    id = (id ^ bits) * 0x100000001b3ULL;
+  }
+  return id;
+}
+
 bool RasterCache::Prepare(PrerollContext* context,
                           DisplayList* display_list,
                           bool is_complex,
                           bool will_change,
                           const SkMatrix& untranslated_matrix,
                           const SkPoint& offset) {
+  if (auto* deferred_calls = context->deferred_raster_cache_calls) {
+    deferred_calls->push_back([this, display_list, is_complex, will_change,
+                               untranslated_matrix,
+                               offset](PrerollContext* context) {
+      Prepare(context, display_list, is_complex, will_change,
+              untranslated_matrix, offset);
+    });
+    return false;
+  }
   if (!GenerateNewCacheInThisFrame()) {
     return false;
   }
@@ -295,58 +807,142 @@ bool RasterCache::Prepare(PrerollContext* context,
     return false;
   }
 
-  DisplayListRasterCacheKey cache_key(display_list->unique_id(),
+  DisplayListRasterCacheKey cache_key(DisplayListCacheId(*display_list),
                                       transformation_matrix);
 
   // Creates an entry, if not present prior.
   Entry& entry = display_list_cache_[cache_key];
-  if (entry.access_count < access_threshold_) {
+  // GetIntegralTransCTM effect for matrix which only contains scale,
+  // translate, so it won't affect result of matrix decomposition and cache
+  // key.
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+  transformation_matrix = GetIntegralTransCTM(transformation_matrix);
+#else
+  transformation_matrix = GetSubpixelBucketCTM(transformation_matrix);
+#endif
+  sk_sp<SkData> persistent_key;
+  if (!entry.image && !entry.async_pending) {
+    persistent_key = GetPersistentKey(context, *display_list, cache_key);
+    if (persistent_key) {
+      size_t bytes =
+          EstimateImageBytes(display_list->bounds(), transformation_matrix);
+      if (ReserveBytes(bytes)) {
+        entry.image = persistent_cache_->Take(
+            *persistent_key, display_list->bounds(), transformation_matrix);
+      }
+    }
+  }
+  if (!entry.image && entry.access_count < access_threshold_) {
     // Frame threshold has not yet been reached.
     return false;
   }
 
   if (!entry.image) {
-    // GetIntegralTransCTM effect for matrix which only contains scale,
-    // translate, so it won't affect result of matrix decomposition and cache
-    // key.
-#ifndef SUPPORT_FRACTIONAL_TRANSLATION
-    transformation_matrix = GetIntegralTransCTM(transformation_matrix);
-#endif
+    if (entry.async_pending) {
+      // The image is still being rasterized with the resource context.
+      return false;
+    }
+    const unsigned int complexity =
+        complexity_calculator->compute(display_list);
+    if (!FitsRasterizationBudget(
+            RasterizationCandidateId(cache_key.id(), false,
+                                     transformation_matrix),
+            GetDeviceArea(display_list->bounds(), transformation_matrix),
+            display_list_cost_estimator_.Estimate(complexity))) {
+      return false;
+    }
+    size_t bytes =
+        EstimateImageBytes(display_list->bounds(), transformation_matrix);
+    if (!ReserveBytes(bytes)) {
+      return false;
+    }
+    if (ShouldRasterizeAsync(entry)) {
+      RasterizeAsync(
+          entry, cache_key, bytes, context, transformation_matrix,
+          display_list->bounds(), "RasterCacheFlow::DisplayList",
+          [display_list = sk_ref_sp(display_list)](SkCanvas* canvas) {
+            display_list->RenderTo(canvas);
+          },
+          &AsyncResults::display_lists, std::move(persistent_key));
+      display_list_cached_this_frame_++;
+      return false;
+    }
+    if (ShouldRecordConcurrently(context, entry) &&
+        RecordConcurrently(
+            entry, bytes, context, transformation_matrix,
+            display_list->bounds(), "RasterCacheFlow::DisplayList",
+            [display_list = sk_ref_sp(display_list)](SkCanvas* canvas) {
+              display_list->RenderTo(canvas);
+            },
+            persistent_key)) {
+      display_list_cached_this_frame_++;
+      return false;
+    }
+    const fml::TimePoint start = fml::TimePoint::Now();
     entry.image = RasterizeDisplayList(
         display_list, context->gr_context, transformation_matrix,
         context->dst_color_space, checkerboard_images_);
+    display_list_cost_estimator_.AddSample(complexity,
+                                           fml::TimePoint::Now() - start);
+    if (entry.image && persistent_key) {
+      persistent_cache_->Store(*persistent_key, *entry.image->image(),
+                               context->gr_context);
+    }
     display_list_cached_this_frame_++;
   }
+  // Keep the entry from being evicted for the budget before it is drawn.
+  entry.last_access = ++access_clock_;
   return true;
 }
 
-void RasterCache::Touch(Layer* layer, const SkMatrix& ctm) {
+void RasterCache::Touch(PrerollContext* context,
+                        Layer* layer,
+                        const SkMatrix& ctm) {
+  if (auto* deferred_calls = context->deferred_raster_cache_calls) {
+    deferred_calls->push_back([this, layer, ctm](PrerollContext* context) {
+      Touch(context, layer, ctm);
+    });
+    return;
+  }
   LayerRasterCacheKey cache_key(layer->unique_id(), ctm);
   auto it = layer_cache_.find(cache_key);
   if (it != layer_cache_.end()) {
-    it->second.used_this_frame = true;
-    it->second.access_count++;
+    MarkUsed(it->second);
   }
 }
 
-void RasterCache::Touch(SkPicture* picture,
+void RasterCache::Touch(PrerollContext* context,
+                        SkPicture* picture,
                         const SkMatrix& transformation_matrix) {
+  if (auto* deferred_calls = context->deferred_raster_cache_calls) {
+    deferred_calls->push_back(
+        [this, picture, transformation_matrix](PrerollContext* context) {
+          Touch(context, picture, transformation_matrix);
+        });
+    return;
+  }
   PictureRasterCacheKey cache_key(picture->uniqueID(), transformation_matrix);
   auto it = picture_cache_.find(cache_key);
   if (it != picture_cache_.end()) {
-    it->second.used_this_frame = true;
-    it->second.access_count++;
+    MarkUsed(it->second);
   }
 }
 
-void RasterCache::Touch(DisplayList* display_list,
+void RasterCache::Touch(PrerollContext* context,
+                        DisplayList* display_list,
                         const SkMatrix& transformation_matrix) {
-  DisplayListRasterCacheKey cache_key(display_list->unique_id(),
+  if (auto* deferred_calls = context->deferred_raster_cache_calls) {
+    deferred_calls->push_back(
+        [this, display_list, transformation_matrix](PrerollContext* context) {
+          Touch(context, display_list, transformation_matrix);
+        });
+    return;
+  }
+  DisplayListRasterCacheKey cache_key(DisplayListCacheId(*display_list),
                                       transformation_matrix);
   auto it = display_list_cache_.find(cache_key);
   if (it != display_list_cache_.end()) {
-    it->second.used_this_frame = true;
-    it->second.access_count++;
+    MarkUsed(it->second);
   }
 }
 
@@ -360,8 +956,7 @@ bool RasterCache::Draw(const SkPicture& picture,
   }
 
   Entry& entry = it->second;
-  entry.access_count++;
-  entry.used_this_frame = true;
+  MarkUsed(entry);
 
   if (entry.image) {
     entry.image->draw(canvas, paint);
@@ -374,7 +969,7 @@ bool RasterCache::Draw(const SkPicture& picture,
 bool RasterCache::Draw(const DisplayList& display_list,
                        SkCanvas& canvas,
                        const SkPaint* paint) const {
-  DisplayListRasterCacheKey cache_key(display_list.unique_id(),
+  DisplayListRasterCacheKey cache_key(DisplayListCacheId(display_list),
                                       canvas.getTotalMatrix());
   auto it = display_list_cache_.find(cache_key);
   if (it == display_list_cache_.end()) {
@@ -382,8 +977,7 @@ bool RasterCache::Draw(const DisplayList& display_list,
   }
 
   Entry& entry = it->second;
-  entry.access_count++;
-  entry.used_this_frame = true;
+  MarkUsed(entry);
 
   if (entry.image) {
     entry.image->draw(canvas, paint);
@@ -403,8 +997,7 @@ bool RasterCache::Draw(const Layer* layer,
   }
 
   Entry& entry = it->second;
-  entry.access_count++;
-  entry.used_this_frame = true;
+  MarkUsed(entry);
 
   if (entry.image) {
     entry.image->draw(canvas, paint);
@@ -414,9 +1007,175 @@ bool RasterCache::Draw(const Layer* layer,
   return false;
 }
 
+bool RasterCache::DrawShadow(const SkPath& path,
+                             SkColor color,
+                             SkScalar elevation,
+                             bool transparent_occluder,
+                             SkScalar dpr,
+                             SkCanvas& canvas) const {
+  const SkMatrix& ctm = canvas.getTotalMatrix();
+  ShadowRasterCacheKey cache_key(
+      ShadowCacheId(path, color, elevation, transparent_occluder, dpr), ctm);
+  auto it = shadow_cache_.find(cache_key);
+  if (it == shadow_cache_.end()) {
+    return false;
+  }
+
+  Entry& entry = it->second;
+  MarkUsed(entry);
+  if (!entry.image) {
+    return false;
+  }
+
+  // Unlike the pictures and layers, whose matrices are snapped, the path
+  // that casts the shadow is drawn at any translation, so the image is
+  // drawn at the part of the translation that it was not rasterized with.
+  SkMatrix raster_matrix = GetSubpixelBucketCTM(ctm);
+  SkIRect bounds = GetDeviceBounds(entry.image->logical_rect(), raster_matrix);
+  SkScalar dx = ctm.getTranslateX() - raster_matrix.getTranslateX();
+  SkScalar dy = ctm.getTranslateY() - raster_matrix.getTranslateY();
+  SkAutoCanvasRestore auto_restore(&canvas, true);
+  canvas.resetMatrix();
+  canvas.drawImage(entry.image->image(), bounds.fLeft + dx, bounds.fTop + dy,
+                   SkSamplingOptions(SkFilterMode::kLinear));
+  return true;
+}
+
+size_t RasterCache::GetByteLimit() const {
+  size_t limit =
+      max_bytes_ != 0 ? max_bytes_ : std::numeric_limits<size_t>::max();
+  if (budget_ && budget_->max_bytes() != 0) {
+    size_t others = std::min(budget_->GetBytesUsedByOthers(this),
+                             budget_->max_bytes());
+    limit = std::min(limit, budget_->max_bytes() - others);
+  }
+  return limit;
+}
+
+bool RasterCache::EvictForBytes(size_t bytes, size_t max_last_access) {
+  size_t cached_bytes = GetUsedBytes();
+  size_t max_bytes = GetByteLimit();
+  if (cached_bytes + bytes <= max_bytes) {
+    return true;
+  }
+  if (bytes > max_bytes) {
+    return false;
+  }
+  size_t needed_bytes = cached_bytes + bytes - max_bytes;
+
+  std::vector<EvictionCandidate> candidates;
+  CollectEvictionCandidates(picture_cache_, max_last_access,
+                            &picture_budget_evictions_, candidates);
+  CollectEvictionCandidates(display_list_cache_, max_last_access,
+                            &picture_budget_evictions_, candidates);
+  CollectEvictionCandidates(layer_cache_, max_last_access,
+                            &layer_budget_evictions_, candidates);
+  CollectEvictionCandidates(shadow_cache_, max_last_access,
+                            &layer_budget_evictions_, candidates);
+  std::sort(candidates.begin(), candidates.end(),
+            [](const EvictionCandidate& a, const EvictionCandidate& b) {
+              return a.entry->last_access < b.entry->last_access;
+            });
+
+  // Only evict anything if enough can be evicted, rather than throwing
+  // away images without making room for the new one.
+  size_t evictable_bytes = 0;
+  size_t evict_count = 0;
+  while (evict_count < candidates.size() && evictable_bytes < needed_bytes) {
+    evictable_bytes += candidates[evict_count++].entry->image->image_bytes();
+  }
+  if (evictable_bytes < needed_bytes) {
+    return false;
+  }
+
+  for (size_t i = 0; i < evict_count; i++) {
+    Entry* entry = candidates[i].entry;
+    RasterCacheMetrics* metrics = candidates[i].metrics;
+    metrics->eviction_count++;
+    metrics->eviction_bytes += entry->image->image_bytes();
+    entry->image.reset();
+    // The entry must reach the access threshold again before it is given a
+    // new image so that entries cannot displace each other every frame.
+    entry->access_count = 0;
+  }
+  return true;
+}
+
+size_t RasterCache::Trim(size_t max_bytes) {
+  size_t cached_bytes =
+      EstimatePictureCacheByteSize() + EstimateLayerCacheByteSize();
+  if (cached_bytes <= max_bytes) {
+    return 0;
+  }
+  TRACE_EVENT0("flutter", "RasterCache::Trim");
+
+  std::vector<EvictionCandidate> candidates;
+  CollectEvictionCandidates(picture_cache_, access_clock_,
+                            &picture_budget_evictions_, candidates);
+  CollectEvictionCandidates(display_list_cache_, access_clock_,
+                            &picture_budget_evictions_, candidates);
+  CollectEvictionCandidates(layer_cache_, access_clock_,
+                            &layer_budget_evictions_, candidates);
+  CollectEvictionCandidates(shadow_cache_, access_clock_,
+                            &layer_budget_evictions_, candidates);
+  std::sort(candidates.begin(), candidates.end(),
+            [](const EvictionCandidate& a, const EvictionCandidate& b) {
+              return a.entry->last_access < b.entry->last_access;
+            });
+
+  size_t evicted_bytes = 0;
+  for (const EvictionCandidate& candidate : candidates) {
+    if (cached_bytes - evicted_bytes <= max_bytes) {
+      break;
+    }
+    Entry* entry = candidate.entry;
+    size_t bytes = entry->image->image_bytes();
+    candidate.metrics->eviction_count++;
+    candidate.metrics->eviction_bytes += bytes;
+    entry->image.reset();
+    entry->access_count = 0;
+    evicted_bytes += bytes;
+  }
+  return evicted_bytes;
+}
+
+bool RasterCache::ReserveBytes(size_t bytes) {
+  if (!HasByteLimit()) {
+    return true;
+  }
+  if (EvictForBytes(bytes, frame_start_access_)) {
+    return true;
+  }
+  over_budget_this_frame_ = true;
+  return false;
+}
+
 void RasterCache::PrepareNewFrame() {
+  // Any images recorded outside of a Preroll are drawn before the frame.
+  DrawRecordedImages();
   picture_cached_this_frame_ = 0;
   display_list_cached_this_frame_ = 0;
+  shadow_cached_this_frame_ = 0;
+  ReserveRasterizationBudget();
+  frame_start_access_ = access_clock_;
+  if (persistent_cache_ &&
+      persistent_frame_count_ < PersistentRasterCache::kStartupFrameCount) {
+    persistent_frame_count_++;
+    if (persistent_frame_count_ == PersistentRasterCache::kStartupFrameCount) {
+      persistent_cache_->RemoveUnusedImages();
+    }
+  }
+  if (async_results_) {
+    std::vector<AsyncResult<PictureRasterCacheKey>> pictures;
+    std::vector<AsyncResult<DisplayListRasterCacheKey>> display_lists;
+    {
+      std::scoped_lock lock(async_results_->mutex);
+      pictures.swap(async_results_->pictures);
+      display_lists.swap(async_results_->display_lists);
+    }
+    PromoteAsyncResults(picture_cache_, pictures);
+    PromoteAsyncResults(display_list_cache_, display_lists);
+  }
 }
 
 void RasterCache::CleanupAfterFrame() {
@@ -427,16 +1186,60 @@ void RasterCache::CleanupAfterFrame() {
     SweepOneCacheAfterFrame(picture_cache_, picture_metrics_);
     SweepOneCacheAfterFrame(display_list_cache_, picture_metrics_);
     SweepOneCacheAfterFrame(layer_cache_, layer_metrics_);
+    SweepOneCacheAfterFrame(shadow_cache_, layer_metrics_);
+  }
+  if (HasByteLimit()) {
+    // Every remaining image was used in this frame, so this only evicts
+    // anything if the budget was lowered below what the cache holds. The
+    // images evicted here were counted as in use by the sweep.
+    RasterCacheMetrics picture_evictions = picture_budget_evictions_;
+    RasterCacheMetrics layer_evictions = layer_budget_evictions_;
+    EvictForBytes(0, access_clock_);
+    picture_metrics_.in_use_count -= picture_budget_evictions_.eviction_count -
+                                     picture_evictions.eviction_count;
+    picture_metrics_.in_use_bytes -= picture_budget_evictions_.eviction_bytes -
+                                     picture_evictions.eviction_bytes;
+    layer_metrics_.in_use_count -= layer_budget_evictions_.eviction_count -
+                                   layer_evictions.eviction_count;
+    layer_metrics_.in_use_bytes -= layer_budget_evictions_.eviction_bytes -
+                                   layer_evictions.eviction_bytes;
   }
+  picture_metrics_.eviction_count += picture_budget_evictions_.eviction_count;
+  picture_metrics_.eviction_bytes += picture_budget_evictions_.eviction_bytes;
+  layer_metrics_.eviction_count += layer_budget_evictions_.eviction_count;
+  layer_metrics_.eviction_bytes += layer_budget_evictions_.eviction_bytes;
+  bool over_budget = over_budget_this_frame_ ||
+                     picture_budget_evictions_.eviction_count > 0 ||
+                     layer_budget_evictions_.eviction_count > 0;
+  picture_budget_evictions_ = {};
+  layer_budget_evictions_ = {};
+  over_budget_this_frame_ = false;
   TraceStatsToTimeline();
+  if (over_budget && over_budget_callback_) {
+    over_budget_callback_();
+  }
 }
 
 void RasterCache::Clear() {
+  // The recordings refer to the entries, so they must finish before the
+  // entries are cleared, but their images are discarded.
+  for (Recording& recording : recordings_) {
+    recording.display_list.wait();
+  }
+  recordings_.clear();
   picture_cache_.clear();
   display_list_cache_.clear();
   layer_cache_.clear();
+  shadow_cache_.clear();
   picture_metrics_ = {};
   layer_metrics_ = {};
+  picture_budget_evictions_ = {};
+  layer_budget_evictions_ = {};
+  if (async_results_) {
+    // Any images still being rasterized belong to the cleared entries.
+    async_results_ = std::make_shared<AsyncResults>();
+  }
+  pending_bytes_ = 0;
 }
 
 size_t RasterCache::GetCachedEntriesCount() const {
@@ -448,6 +1251,10 @@ size_t RasterCache::GetLayerCachedEntriesCount() const {
   return layer_cache_.size();
 }
 
+size_t RasterCache::GetShadowCachedEntriesCount() const {
+  return shadow_cache_.size();
+}
+
 size_t RasterCache::GetPictureCachedEntriesCount() const {
   return picture_cache_.size() + display_list_cache_.size();
 }
@@ -484,9 +1291,27 @@ size_t RasterCache::EstimateLayerCacheByteSize() const {
       layer_cache_bytes += item.second.image->image_bytes();
     }
   }
+  for (const auto& item : shadow_cache_) {
+    if (item.second.image) {
+      layer_cache_bytes += item.second.image->image_bytes();
+    }
+  }
   return layer_cache_bytes;
 }
 
+std::vector<RasterCache::EntryInfo> RasterCache::GetEntryInfos() const {
+  std::vector<EntryInfo> infos;
+  CollectEntryInfos(picture_cache_, EntryInfo::Type::kPicture, infos);
+  CollectEntryInfos(display_list_cache_, EntryInfo::Type::kDisplayList, infos);
+  CollectEntryInfos(layer_cache_, EntryInfo::Type::kLayer, infos);
+  CollectEntryInfos(shadow_cache_, EntryInfo::Type::kShadow, infos);
+  std::sort(infos.begin(), infos.end(),
+            [](const EntryInfo& a, const EntryInfo& b) {
+              return a.image_bytes > b.image_bytes;
+            });
+  return infos;
+}
+
 size_t RasterCache::EstimatePictureCacheByteSize() const {
   size_t picture_cache_bytes = 0;
   for (const auto& item : picture_cache_) {
@@ -5,17 +5,29 @@
 #ifndef FLUTTER_FLOW_RASTER_CACHE_H_
 #define FLUTTER_FLOW_RASTER_CACHE_H_
 
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/display_list_complexity.h"
 #include "flutter/flow/raster_cache_key.h"
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/closure.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkDeferredDisplayList.h"
 #include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPath.h"
 #include "third_party/skia/include/core/SkSize.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 
@@ -37,13 +49,34 @@ class RasterCacheResult {
     return image_ ? image_->imageInfo().computeMinByteSize() : 0;
   };
 
+  const sk_sp<SkImage>& image() const { return image_; }
+
+  const SkRect& logical_rect() const { return logical_rect_; }
+
  private:
   sk_sp<SkImage> image_;
   SkRect logical_rect_;
   fml::tracing::TraceFlow flow_;
 };
 
+// The result of rasterizing with a resource context, whose image must be
+// released on the thread of that context.
+class ResourceContextRasterCacheResult : public RasterCacheResult {
+ public:
+  ResourceContextRasterCacheResult(SkiaGPUObject<SkImage> image,
+                                   const SkRect& logical_rect,
+                                   const char* type)
+      : RasterCacheResult(image.skia_object(), logical_rect, type),
+        image_(std::move(image)) {}
+
+ private:
+  SkiaGPUObject<SkImage> image_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ResourceContextRasterCacheResult);
+};
+
 struct PrerollContext;
+class PersistentRasterCache;
 
 struct RasterCacheMetrics {
   /**
@@ -81,19 +114,93 @@ struct RasterCacheMetrics {
   size_t total_bytes() const { return in_use_bytes + eviction_bytes; }
 };
 
+class RasterCache;
+
+/**
+ * A limit on the memory used by the images of several |RasterCache|s
+ * together, such as the caches of the shells that are spawned from one
+ * another, so that their caches grow within a single budget rather than
+ * each within its own. A cache only ever evicts its own images to make room
+ * for new ones, and may only use what the other caches leave of the budget.
+ *
+ * The caches that share a budget must all be used on the same thread.
+ */
+class RasterCacheBudget {
+ public:
+  explicit RasterCacheBudget(size_t max_bytes) : max_bytes_(max_bytes) {}
+
+  size_t max_bytes() const { return max_bytes_; }
+
+  /**
+   * @brief Evict the images of the least recently used entries until the
+   * cached images use at most |max_bytes|, for example under memory
+   * pressure. Unlike |SetMaxBytes|, this does not limit the images cached
+   * afterwards. Must be called between frames.
+   *
+   * @return The bytes of the evicted images.
+   */
+  size_t Trim(size_t max_bytes);
+
+  /**
+   * @brief Also limit the memory used by the images of this cache to what
+   * the other caches that share |budget| leave of it, or stop sharing a
+   * budget if |budget| is null. The |max_bytes| of the cache still applies.
+   */
+  void SetSharedBudget(std::shared_ptr<RasterCacheBudget> budget);
+
+  const std::shared_ptr<RasterCacheBudget>& shared_budget() const {
+    return budget_;
+  }
+
+  // Returns the bytes used by the caches that share the budget, other than
+  // |cache|.
+  size_t GetBytesUsedByOthers(const RasterCache* cache) const;
+
+ private:
+  friend class RasterCache;
+
+  void AddCache(const RasterCache* cache) { caches_.push_back(cache); }
+  void RemoveCache(const RasterCache* cache);
+
+  const size_t max_bytes_;
+  std::vector<const RasterCache*> caches_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterCacheBudget);
+};
+
 class RasterCache {
  public:
+  // A task that rasterizes cache entries on the thread of a
+  // |resource_context| which shares its resources with the GrDirectContext
+  // of the raster thread, or which is null if no such context is available.
+  using ResourceContextTask =
+      std::function<void(GrDirectContext* resource_context)>;
+
+  // Runs a |ResourceContextTask| on the thread of the resource context.
+  using ResourceContextTaskRunner =
+      std::function<void(ResourceContextTask task)>;
+
+  // A |Prepare| or |Touch| call made during the concurrent Preroll of a
+  // subtree, which is made again with the |PrerollContext| of the raster
+  // thread once the Preroll of the subtree has finished.
+  using DeferredCall = std::function<void(PrerollContext* context)>;
+
   // The default max number of picture and display list raster caches to be
-  // generated per frame. Generating too many caches in one frame may cause jank
-  // on that frame. This limit allows us to throttle the cache and distribute
-  // the work across multiple frames.
-  static constexpr int kDefaultPictureAndDispLayListCacheLimitPerFrame = 3;
+  // generated per frame. The work of each frame is throttled by the
+  // rasterization budget, and this limit is only a backstop for when the
+  // cost of the caches is not known yet.
+  static constexpr int kDefaultPictureAndDispLayListCacheLimitPerFrame = 16;
+
+  // The default time that the rasterization of new picture and display list
+  // caches may take in a frame. See |SetRasterizationBudget|.
+  static constexpr fml::TimeDelta kDefaultRasterizationBudget =
+      fml::TimeDelta::FromMilliseconds(4);
 
   explicit RasterCache(size_t access_threshold = 3,
                        size_t picture_and_display_list_cache_limit_per_frame =
                            kDefaultPictureAndDispLayListCacheLimitPerFrame);
 
-  virtual ~RasterCache() = default;
+  virtual ~RasterCache();
 
   /**
    * @brief Rasterize a picture object and produce a RasterCacheResult
@@ -172,14 +279,47 @@ class RasterCache {
     return result;
   }
 
+  /**
+   * @brief Snap the translation components of the matrix to the subpixel
+   * bucket that they fall in, which is where the image of a cache entry
+   * keyed with the matrix is rasterized and drawn.
+   *
+   * The snapping only changes the matrix when fractional translations are
+   * supported and the matrix has no perspective. Otherwise the matrix is
+   * returned unchanged.
+   *
+   * @param ctm the current transformation matrix.
+   * @return SkMatrix the snapped transformation matrix.
+   */
+  static SkMatrix GetSubpixelBucketCTM(const SkMatrix& ctm) {
+#ifdef SUPPORT_FRACTIONAL_TRANSLATION
+    if (ctm.hasPerspective()) {
+      return ctm;
+    }
+    SkMatrix result = ctm;
+    SkScalar tx = ctm.getTranslateX();
+    SkScalar ty = ctm.getTranslateY();
+    result[SkMatrix::kMTransX] =
+        SkScalarFloorToScalar(tx) + GetRasterCacheSubpixelBucket(tx);
+    result[SkMatrix::kMTransY] =
+        SkScalarFloorToScalar(ty) + GetRasterCacheSubpixelBucket(ty);
+    return result;
+#else
+    return ctm;
+#endif
+  }
+
   // Return true if the cache is generated.
   //
   // We may return false and not generate the cache if
-  // 1. There are too many pictures to be cached in the current frame.
+  // 1. There are too many pictures to be cached in the current frame, or
+  //    their rasterization would not fit into the rasterization budget.
   //    (See also kDefaultPictureAndDispLayListCacheLimitPerFrame.)
   // 2. The picture is not worth rasterizing
   // 3. The matrix is singular
   // 4. The picture is accessed too few times
+  // 5. The call is deferred to the raster thread by a concurrent Preroll
+  //    (see |PrerollContext::deferred_raster_cache_calls|)
   bool Prepare(PrerollContext* context,
                SkPicture* picture,
                bool is_complex,
@@ -197,9 +337,13 @@ class RasterCache {
   // used for this frame in order to not get evicted. This is needed during
   // partial repaint for layers that are outside of current clip and are culled
   // away.
-  void Touch(SkPicture* picture, const SkMatrix& transformation_matrix);
-  void Touch(DisplayList* display_list, const SkMatrix& transformation_matrix);
-  void Touch(Layer* layer, const SkMatrix& ctm);
+  void Touch(PrerollContext* context,
+             SkPicture* picture,
+             const SkMatrix& transformation_matrix);
+  void Touch(PrerollContext* context,
+             DisplayList* display_list,
+             const SkMatrix& transformation_matrix);
+  void Touch(PrerollContext* context, Layer* layer, const SkMatrix& ctm);
 
   void Prepare(PrerollContext* context, Layer* layer, const SkMatrix& ctm);
 
@@ -227,6 +371,30 @@ class RasterCache {
             SkCanvas& canvas,
             const SkPaint* paint = nullptr) const;
 
+  // Prepares the image of the shadow that |path| casts when it is drawn with
+  // |DisplayListCanvasDispatcher::DrawShadow|, once the shadow was prepared
+  // in |access_threshold| frames. Volatile paths are not cached.
+  //
+  // Return true if the image is ready to be drawn.
+  bool PrepareShadow(PrerollContext* context,
+                     const SkPath& path,
+                     SkColor color,
+                     SkScalar elevation,
+                     bool transparent_occluder,
+                     SkScalar dpr,
+                     const SkMatrix& ctm);
+
+  // Find the raster cache for the shadow and draw it to the canvas, at the
+  // translation of the canvas so that it stays aligned with the path.
+  //
+  // Return true if it's found and drawn.
+  bool DrawShadow(const SkPath& path,
+                  SkColor color,
+                  SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr,
+                  SkCanvas& canvas) const;
+
   void PrepareNewFrame();
   void CleanupAfterFrame();
 
@@ -245,6 +413,12 @@ class RasterCache {
    */
   size_t GetLayerCachedEntriesCount() const;
 
+  /**
+   * Return the number of map entries in the shadow cache regardless of
+   * whether the entries have been populated with an image.
+   */
+  size_t GetShadowCachedEntriesCount() const;
+
   /**
    * Return the number of map entries in the picture caches (SkPicture and
    * DisplayList) regardless of whether the entries have been populated with
@@ -265,7 +439,7 @@ class RasterCache {
 
   /**
    * @brief Estimate how much memory is used by layer raster cache entries in
-   * bytes.
+   * bytes, including the shadows cast by the layers.
    *
    * Only SkImage's memory usage is counted as other objects are often much
    * smaller compared to SkImage. SkImageInfo::computeMinByteSize is used to
@@ -273,6 +447,33 @@ class RasterCache {
    */
   size_t EstimateLayerCacheByteSize() const;
 
+  /**
+   * A cache entry that holds an image, for memory profiling.
+   */
+  struct EntryInfo {
+    enum class Type { kPicture, kDisplayList, kLayer, kShadow };
+
+    Type type;
+    /**
+     * The unique ID of the picture, the content hash of the display list,
+     * the unique ID of the layer or the generation ID of the shadow's path.
+     */
+    uint64_t id;
+    SkISize image_dimensions;
+    size_t image_bytes;
+    /**
+     * The number of frames that used the entry, including the ones before
+     * its image was generated.
+     */
+    size_t access_count;
+  };
+
+  /**
+   * @brief Describe the entries of the picture, display list and layer
+   * caches that hold an image, largest first.
+   */
+  std::vector<EntryInfo> GetEntryInfos() const;
+
   /**
    * @brief Return the number of frames that a picture must be prepared
    * before it will be cached. If the number is 0, then no picture will
@@ -283,13 +484,256 @@ class RasterCache {
    */
   int access_threshold() const { return access_threshold_; }
 
+  /**
+   * @brief Limit the memory used by the images of the picture, display
+   * list and layer caches together to |max_bytes|, or remove the limit if
+   * |max_bytes| is 0.
+   *
+   * When a new image would not fit, the images of the least recently used
+   * entries that have not been used in the current frame are evicted to
+   * make room for it. If that would still not free enough memory then
+   * nothing is evicted and the new image is not generated. If the limit is
+   * lowered below the current usage then the least recently used images
+   * are evicted at the end of the frame.
+   */
+  void SetMaxBytes(size_t max_bytes) { max_bytes_ = max_bytes; }
+
+  size_t max_bytes() const { return max_bytes_; }
+
+  /**
+   * @brief Limit the time that the rasterization of new picture and display
+   * list caches may take in a frame to about |budget|, or remove the limit
+   * if |budget| is zero.
+   *
+   * The time is estimated from the complexity of the contents of the caches
+   * and the time that the earlier rasterizations took. The first cache of a
+   * frame is always rasterized so that the caches that take longer than the
+   * whole budget are still generated. The caches that do not fit are
+   * rasterized in the following frames, those with the largest images
+   * first, before any new ones.
+   */
+  void SetRasterizationBudget(fml::TimeDelta budget) {
+    rasterization_budget_ = budget;
+  }
+
+  fml::TimeDelta rasterization_budget() const { return rasterization_budget_; }
+
+  /**
+   * @brief Set a callback that is made at the end of any frame in which
+   * images were evicted, or not generated, to stay within |max_bytes|, so
+   * that the owner can release the memory of the evicted images.
+   */
+  void SetOverBudgetCallback(fml::closure callback) {
+    over_budget_callback_ = std::move(callback);
+  }
+
+  /**
+   * @brief Rasterize the images of new picture and display list entries
+   * with |task_runner| instead of during Prepare.
+   *
+   * An image is promoted into the cache by the first PrepareNewFrame after
+   * it is ready. Until then Prepare returns false and the picture or
+   * display list is drawn directly. Layer entries are still rasterized
+   * during Prepare since the layer tree may only be read on the raster
+   * thread. The images made with the resource context are released
+   * through |unref_queue|.
+   *
+   * If a task has no resource context but the frame that prepared its
+   * entry has a GrDirectContext, the entry is rasterized during a later
+   * Prepare instead.
+   *
+   * Any existing entries are cleared. Passing a null |task_runner| returns
+   * to rasterizing every entry during Prepare.
+   */
+  void SetResourceContextTaskRunner(ResourceContextTaskRunner task_runner,
+                                    fml::RefPtr<SkiaUnrefQueue> unref_queue);
+
+  /**
+   * @brief Reuse the images of display list entries that were stored in
+   * |persistent_cache| by an earlier launch, and store the images of new
+   * entries, during the first |PersistentRasterCache::kStartupFrameCount|
+   * frames.
+   *
+   * The persisted images skip the access threshold so that the first
+   * frames that draw them do not have to rasterize them. Passing nullptr
+   * stops using the persistent cache.
+   */
+  void SetPersistentRasterCache(
+      std::shared_ptr<PersistentRasterCache> persistent_cache);
+
+  /**
+   * @brief Record the images of new picture and display list entries into
+   * deferred display lists on |task_runner| during Prepare, so that they
+   * are recorded concurrently with the rest of the Preroll, and draw them
+   * in |DrawRecordedImages|.
+   *
+   * Only the frames with a GrDirectContext record their images, and the
+   * entries rasterized with the resource context are not affected. Layer
+   * entries are still rasterized during Prepare since the layer tree may
+   * only be read on the raster thread. Passing a null |task_runner|
+   * returns to rasterizing the entries during Prepare.
+   */
+  void SetConcurrentRecordingTaskRunner(
+      std::shared_ptr<fml::ConcurrentTaskRunner> task_runner);
+
+  /**
+   * @brief Draw the images recorded since the last call, in the order their
+   * entries were prepared, on the raster thread.
+   *
+   * Called at the end of the Preroll so that the images can be drawn in the
+   * Paint of the same frame. Prepare returns false for the recorded entries
+   * since their images are not ready yet when it returns.
+   */
+  void DrawRecordedImages();
+
  private:
+  friend class RasterCacheBudget;
+
   struct Entry {
     bool used_this_frame = false;
     size_t access_count = 0;
+    // The value of |access_clock_| when the entry was last used.
+    size_t last_access = 0;
+    // Whether the image is being rasterized by a |ResourceContextTask|.
+    bool async_pending = false;
+    // Whether a |ResourceContextTask| failed to rasterize the image, so
+    // that it must be rasterized during Prepare.
+    bool async_failed = false;
+    std::unique_ptr<RasterCacheResult> image;
+  };
+
+  template <class Key>
+  struct AsyncResult {
+    Key key;
+    size_t reserved_bytes;
+    // Null if the image could not be rasterized.
     std::unique_ptr<RasterCacheResult> image;
   };
 
+  // The images finished by the |ResourceContextTask|s, which are shared
+  // with the tasks so that they can outlive the cache.
+  struct AsyncResults {
+    std::mutex mutex;
+    std::vector<AsyncResult<PictureRasterCacheKey>> pictures;
+    std::vector<AsyncResult<DisplayListRasterCacheKey>> display_lists;
+  };
+
+  // Returns the key of the persisted image of the |display_list| entry
+  // with |key|, or nullptr if that image should not be persisted.
+  sk_sp<SkData> GetPersistentKey(PrerollContext* context,
+                                 const DisplayList& display_list,
+                                 const DisplayListRasterCacheKey& key) const;
+
+  bool ShouldRasterizeAsync(const Entry& entry) const {
+    return resource_context_task_runner_ && !entry.async_failed;
+  }
+
+  // Posts a |ResourceContextTask| that rasterizes the image of |entry|
+  // and adds it to |results_member| of the |async_results_|.
+  template <class Key>
+  void RasterizeAsync(
+      Entry& entry,
+      const Key& key,
+      size_t reserved_bytes,
+      PrerollContext* context,
+      const SkMatrix& ctm,
+      const SkRect& logical_rect,
+      const char* type,
+      std::function<void(SkCanvas*)> draw_function,
+      std::vector<AsyncResult<Key>> AsyncResults::*results_member,
+      sk_sp<SkData> persistent_key);
+
+  template <class Cache, class Key>
+  void PromoteAsyncResults(Cache& cache,
+                           std::vector<AsyncResult<Key>>& results);
+
+  // An image that is recorded on the |recording_task_runner_|.
+  struct Recording {
+    Entry* entry;
+    size_t reserved_bytes;
+    GrDirectContext* context;
+    sk_sp<SkSurface> surface;
+    std::future<sk_sp<SkDeferredDisplayList>> display_list;
+    SkRect logical_rect;
+    const char* type;
+    sk_sp<SkData> persistent_key;
+  };
+
+  bool ShouldRecordConcurrently(const PrerollContext* context,
+                                const Entry& entry) const;
+
+  // Posts the recording of the image of |entry| to the
+  // |recording_task_runner_|. Returns false if the surface of the image
+  // could not be created, in which case it must be rasterized directly.
+  bool RecordConcurrently(Entry& entry,
+                          size_t reserved_bytes,
+                          PrerollContext* context,
+                          const SkMatrix& ctm,
+                          const SkRect& logical_rect,
+                          const char* type,
+                          std::function<void(SkCanvas*)> draw_function,
+                          sk_sp<SkData> persistent_key);
+
+  // Estimates the time that the rasterization of a cache takes from the
+  // complexity of its contents, at the rate measured for the earlier ones.
+  class RasterizationCostEstimator {
+   public:
+    fml::TimeDelta Estimate(unsigned int complexity) const {
+      return fml::TimeDelta::FromNanoseconds(
+          static_cast<int64_t>(nanos_per_unit_ * complexity));
+    }
+
+    void AddSample(unsigned int complexity, fml::TimeDelta time);
+
+   private:
+    // Zero until the first rasterization is measured.
+    double nanos_per_unit_ = 0;
+  };
+
+  // A rasterization that did not fit into the budget of a frame.
+  struct RasterizationCandidate {
+    int64_t area = 0;
+    fml::TimeDelta cost;
+  };
+
+  // Returns whether the rasterization of the cache identified by
+  // |candidate_id|, whose image covers |area| device pixels and is
+  // estimated to take |cost|, fits into the rasterization budget of this
+  // frame. The ones that do not are rasterized in the following frames.
+  bool FitsRasterizationBudget(uint64_t candidate_id,
+                               int64_t area,
+                               fml::TimeDelta cost);
+
+  // Reserves the budget of the new frame for the candidates that did not
+  // fit into the last one, largest first, as far as the budget goes.
+  void ReserveRasterizationBudget();
+
+  void MarkUsed(Entry& entry) const {
+    entry.used_this_frame = true;
+    entry.access_count++;
+    entry.last_access = ++access_clock_;
+  }
+
+  static uint64_t EntryInfoId(uint64_t id) { return id; }
+  static uint64_t EntryInfoId(const ShadowRasterCacheId& id) {
+    return id.path_id;
+  }
+
+  template <class Cache>
+  static void CollectEntryInfos(const Cache& cache,
+                                EntryInfo::Type type,
+                                std::vector<EntryInfo>& infos) {
+    for (const auto& item : cache) {
+      const Entry& entry = item.second;
+      if (entry.image) {
+        infos.push_back({type, EntryInfoId(item.first.id()),
+                         entry.image->image_dimensions(),
+                         static_cast<size_t>(entry.image->image_bytes()),
+                         entry.access_count});
+      }
+    }
+  }
+
   template <class Cache>
   static void SweepOneCacheAfterFrame(Cache& cache,
                                       RasterCacheMetrics& metrics) {
@@ -322,15 +766,95 @@ class RasterCache {
                picture_and_display_list_cache_limit_per_frame_;
   }
 
+  struct EvictionCandidate {
+    Entry* entry;
+    RasterCacheMetrics* metrics;
+  };
+
+  template <class Cache>
+  static void CollectEvictionCandidates(
+      Cache& cache,
+      size_t max_last_access,
+      RasterCacheMetrics* metrics,
+      std::vector<EvictionCandidate>& candidates) {
+    for (auto& item : cache) {
+      Entry& entry = item.second;
+      if (entry.image && entry.last_access <= max_last_access) {
+        candidates.push_back({&entry, metrics});
+      }
+    }
+  }
+
+  // The bytes of the cached images and of the images being rasterized
+  // asynchronously.
+  size_t GetUsedBytes() const {
+    return EstimatePictureCacheByteSize() + EstimateLayerCacheByteSize() +
+           pending_bytes_;
+  }
+
+  bool HasByteLimit() const {
+    return max_bytes_ != 0 || (budget_ && budget_->max_bytes() != 0);
+  }
+
+  // The most bytes that this cache may use, within |max_bytes_| and within
+  // what the other caches leave of |budget_|.
+  size_t GetByteLimit() const;
+
+  // Evicts the least recently used images that were last used at or before
+  // |max_last_access| until |bytes| more can be cached within the limit.
+  // Returns false, and evicts nothing, if that is not possible.
+  bool EvictForBytes(size_t bytes, size_t max_last_access);
+
+  // Returns whether an image of |bytes| may be generated during this frame,
+  // evicting older images to make room for it when necessary.
+  bool ReserveBytes(size_t bytes);
+
   const size_t access_threshold_;
   const size_t picture_and_display_list_cache_limit_per_frame_;
   size_t picture_cached_this_frame_ = 0;
   size_t display_list_cached_this_frame_ = 0;
+  size_t shadow_cached_this_frame_ = 0;
+  fml::TimeDelta rasterization_budget_ = kDefaultRasterizationBudget;
+  // The estimated time of the rasterizations of this frame, and of the ones
+  // that the candidates left over from the last frame are expected to take.
+  fml::TimeDelta rasterization_cost_this_frame_;
+  fml::TimeDelta reserved_rasterization_cost_;
+  RasterizationCostEstimator picture_cost_estimator_;
+  RasterizationCostEstimator display_list_cost_estimator_;
+  // The candidates that did not fit into the budget of this frame, and those
+  // of the last frame that the budget of this frame is reserved for, with
+  // their estimated costs.
+  std::unordered_map<uint64_t, RasterizationCandidate> pending_candidates_;
+  std::unordered_map<uint64_t, fml::TimeDelta> reserved_candidates_;
+  size_t max_bytes_ = 0;
+  std::shared_ptr<RasterCacheBudget> budget_;
+  mutable size_t access_clock_ = 0;
+  // The value of |access_clock_| when the current frame started. Entries
+  // with a |last_access| after it have been used in this frame.
+  size_t frame_start_access_ = 0;
+  bool over_budget_this_frame_ = false;
+  fml::closure over_budget_callback_;
+  ResourceContextTaskRunner resource_context_task_runner_;
+  fml::RefPtr<SkiaUnrefQueue> unref_queue_;
+  std::shared_ptr<AsyncResults> async_results_;
+  // The bytes reserved for the images being rasterized asynchronously.
+  size_t pending_bytes_ = 0;
+  std::shared_ptr<fml::ConcurrentTaskRunner> recording_task_runner_;
+  std::vector<Recording> recordings_;
+  std::shared_ptr<PersistentRasterCache> persistent_cache_;
+  // The frames prepared since the persistent cache was set, up to
+  // |PersistentRasterCache::kStartupFrameCount|.
+  size_t persistent_frame_count_ = 0;
   RasterCacheMetrics layer_metrics_;
   RasterCacheMetrics picture_metrics_;
+  // The evictions made during the current frame to stay within the budget,
+  // which become the starting point of the metrics of the frame.
+  RasterCacheMetrics layer_budget_evictions_;
+  RasterCacheMetrics picture_budget_evictions_;
   mutable PictureRasterCacheKey::Map<Entry> picture_cache_;
   mutable DisplayListRasterCacheKey::Map<Entry> display_list_cache_;
   mutable LayerRasterCacheKey::Map<Entry> layer_cache_;
+  mutable ShadowRasterCacheKey::Map<Entry> shadow_cache_;
   bool checkerboard_images_;
 
   void TraceStatsToTimeline() const;
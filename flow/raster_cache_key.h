@@ -7,17 +7,41 @@
 
 #include <unordered_map>
 
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkColor.h"
 #include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkScalar.h"
 
 namespace flutter {
 
+// The number of positions between two pixels at which the images of the
+// raster cache are rasterized when fractional translations are supported.
+constexpr int kRasterCacheSubpixelBucketCount = 4;
+
+// Returns the subpixel bucket of a translation: its fractional part
+// rounded down to a multiple of 1 / kRasterCacheSubpixelBucketCount.
+//
+// Without fractional translation support the translations of the images
+// are snapped to whole pixels, so every translation is in bucket 0.
+inline SkScalar GetRasterCacheSubpixelBucket(SkScalar translate) {
+#ifdef SUPPORT_FRACTIONAL_TRANSLATION
+  SkScalar fraction = translate - SkScalarFloorToScalar(translate);
+  return SkScalarFloorToScalar(fraction * kRasterCacheSubpixelBucketCount) /
+         kRasterCacheSubpixelBucketCount;
+#else
+  return 0;
+#endif
+}
+
 template <typename ID>
 class RasterCacheKey {
  public:
   RasterCacheKey(ID id, const SkMatrix& ctm) : id_(id), matrix_(ctm) {
-    matrix_[SkMatrix::kMTransX] = 0;
-    matrix_[SkMatrix::kMTransY] = 0;
+    matrix_[SkMatrix::kMTransX] =
+        GetRasterCacheSubpixelBucket(ctm.getTranslateX());
+    matrix_[SkMatrix::kMTransY] =
+        GetRasterCacheSubpixelBucket(ctm.getTranslateY());
   }
 
   ID id() const { return id_; }
@@ -42,24 +66,58 @@ class RasterCacheKey {
  private:
   ID id_;
 
-  // ctm where only fractional (0-1) translations are preserved:
+  // ctm where only the subpixel bucket of the translation is preserved, so
+  // that one image can be drawn at any scroll offset within the bucket:
   //   matrix_ = ctm;
-  //   matrix_[SkMatrix::kMTransX] = SkScalarFraction(ctm.getTranslateX());
-  //   matrix_[SkMatrix::kMTransY] = SkScalarFraction(ctm.getTranslateY());
+  //   matrix_[SkMatrix::kMTransX] = SubpixelBucket(ctm.getTranslateX());
+  //   matrix_[SkMatrix::kMTransY] = SubpixelBucket(ctm.getTranslateY());
   SkMatrix matrix_;
 };
 
 // The ID is the uint32_t picture uniqueID
 using PictureRasterCacheKey = RasterCacheKey<uint32_t>;
 
-// The ID is the uint32_t DisplayList uniqueID
-using DisplayListRasterCacheKey = RasterCacheKey<uint32_t>;
+// The ID is derived from the uint64_t DisplayList content_hash so that
+// equal DisplayLists share a cache entry
+using DisplayListRasterCacheKey = RasterCacheKey<uint64_t>;
 
 class Layer;
 
 // The ID is the uint64_t layer unique_id
 using LayerRasterCacheKey = RasterCacheKey<uint64_t>;
 
+// The shadow that a path casts, which does not depend on where the path is
+// drawn, so that the layers that cast the same shadow share its image.
+struct ShadowRasterCacheId {
+  // The generation ID of the path, which copies of the path share.
+  uint32_t path_id;
+  SkColor color;
+  SkScalar elevation;
+  bool transparent_occluder;
+  SkScalar dpr;
+
+  bool operator==(const ShadowRasterCacheId& other) const {
+    return path_id == other.path_id && color == other.color &&
+           elevation == other.elevation &&
+           transparent_occluder == other.transparent_occluder &&
+           dpr == other.dpr;
+  }
+};
+
+using ShadowRasterCacheKey = RasterCacheKey<ShadowRasterCacheId>;
+
 }  // namespace flutter
 
+namespace std {
+
+template <>
+struct hash<flutter::ShadowRasterCacheId> {
+  size_t operator()(const flutter::ShadowRasterCacheId& id) const {
+    return fml::HashCombine(id.path_id, id.color, id.elevation,
+                            id.transparent_occluder, id.dpr);
+  }
+};
+
+}  // namespace std
+
 #endif  // FLUTTER_FLOW_RASTER_CACHE_KEY_H_
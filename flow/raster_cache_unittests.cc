@@ -6,6 +6,7 @@
 #include "flutter/display_list/display_list_builder.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/testing/mock_raster_cache.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "gtest/gtest.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkPaint.h"
@@ -72,6 +73,15 @@ sk_sp<DisplayList> GetSampleDisplayList(int ops) {
   return builder.Build();
 }
 
+// A list of six rects within |size|, so that it is worth rasterizing.
+sk_sp<DisplayList> GetSampleDisplayListOfSize(SkScalar size) {
+  DisplayListBuilder builder(SkRect::MakeWH(size, size));
+  for (int i = 0; i < 6; i++) {
+    builder.drawRect(SkRect::MakeXYWH(i, i, size - i, size - i));
+  }
+  return builder.Build();
+}
+
 }  // namespace
 
 TEST(RasterCache, SimpleInitialization) {
@@ -199,6 +209,47 @@ TEST(RasterCache, ThresholdIsRespectedForDisplayList) {
   ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
 }
 
+TEST(RasterCache, RebuiltDisplayListReusesCacheEntry) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  cache.PrepareNewFrame();
+
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             display_list.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Draw(*display_list, dummy_canvas));
+
+  cache.CleanupAfterFrame();
+  cache.PrepareNewFrame();
+
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            display_list.get(), true, false, matrix));
+  ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
+
+  cache.CleanupAfterFrame();
+  cache.PrepareNewFrame();
+
+  // A list with the same content but a new unique_id uses the same entry.
+  auto rebuilt_display_list = GetSampleDisplayList();
+  ASSERT_NE(rebuilt_display_list->unique_id(), display_list->unique_id());
+  ASSERT_TRUE(cache.Draw(*rebuilt_display_list, dummy_canvas));
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            rebuilt_display_list.get(), true, false, matrix));
+  ASSERT_EQ(cache.GetCachedEntriesCount(), 1u);
+
+  // A list with different content does not.
+  auto other_display_list = GetSampleDisplayList(6);
+  ASSERT_FALSE(cache.Draw(*other_display_list, dummy_canvas));
+}
+
 TEST(RasterCache, AccessThresholdOfZeroDisablesCachingForSkPicture) {
   size_t threshold = 0;
   flutter::RasterCache cache(threshold);
@@ -537,6 +588,83 @@ TEST(RasterCache, NaiveComplexityScoringDisplayList) {
   ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
 }
 
+TEST(RasterCache, RasterizationBudgetDefersTheLargestCandidatesFirst) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  // Any rasterization that has been measured exceeds the budget.
+  cache.SetRasterizationBudget(fml::TimeDelta::FromNanoseconds(1));
+
+  SkMatrix matrix = SkMatrix::I();
+  auto first = GetSampleDisplayListOfSize(10);
+  auto small = GetSampleDisplayListOfSize(20);
+  auto large = GetSampleDisplayListOfSize(40);
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+  auto prepare = [&](const sk_sp<DisplayList>& display_list) {
+    return cache.Prepare(&preroll_context_holder.preroll_context,
+                         display_list.get(), false, false, matrix);
+  };
+  auto draw_all = [&]() {
+    for (const auto& display_list : {first, small, large}) {
+      cache.Draw(*display_list, dummy_canvas);
+    }
+  };
+
+  cache.PrepareNewFrame();
+  ASSERT_FALSE(prepare(first));
+  ASSERT_FALSE(prepare(small));
+  ASSERT_FALSE(prepare(large));
+  draw_all();
+  cache.CleanupAfterFrame();
+
+  // The first rasterization of a frame always fits, and the others do not
+  // once it has been measured.
+  cache.PrepareNewFrame();
+  ASSERT_TRUE(prepare(first));
+  ASSERT_FALSE(prepare(small));
+  ASSERT_FALSE(prepare(large));
+  draw_all();
+  cache.CleanupAfterFrame();
+
+  // The larger of the candidates left over goes first, even if it is
+  // prepared last.
+  cache.PrepareNewFrame();
+  ASSERT_FALSE(prepare(small));
+  ASSERT_TRUE(prepare(large));
+  draw_all();
+  cache.CleanupAfterFrame();
+
+  cache.PrepareNewFrame();
+  ASSERT_TRUE(prepare(small));
+}
+
+TEST(RasterCache, ZeroRasterizationBudgetOnlyLimitsTheCount) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetRasterizationBudget(fml::TimeDelta::Zero());
+
+  SkMatrix matrix = SkMatrix::I();
+  auto first = GetSampleDisplayListOfSize(10);
+  auto second = GetSampleDisplayListOfSize(20);
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  for (int frame = 0; frame < 2; frame++) {
+    cache.PrepareNewFrame();
+    for (const auto& display_list : {first, second}) {
+      ASSERT_EQ(cache.Prepare(&preroll_context_holder.preroll_context,
+                              display_list.get(), false, false, matrix),
+                frame == 1);
+      cache.Draw(*display_list, dummy_canvas);
+    }
+    cache.CleanupAfterFrame();
+  }
+}
+
 TEST(RasterCache, SkPictureWithSingularMatrixIsNotCached) {
   size_t threshold = 2;
   flutter::RasterCache cache(threshold);
@@ -605,6 +733,526 @@ TEST(RasterCache, DisplayListWithSingularMatrixIsNotCached) {
   }
 }
 
+TEST(RasterCache, BudgetEvictsLeastRecentlyUsedImage) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  // Room for only one 150w * 100h * 4bpp image.
+  cache.SetMaxBytes(100000);
+  int over_budget_count = 0;
+  cache.SetOverBudgetCallback([&over_budget_count]() { over_budget_count++; });
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture1 = GetSamplePicture();
+  auto picture2 = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  cache.PrepareNewFrame();
+
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             picture1.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Draw(*picture1, dummy_canvas));
+
+  cache.CleanupAfterFrame();
+  cache.PrepareNewFrame();
+
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            picture1.get(), true, false, matrix));
+  ASSERT_TRUE(cache.Draw(*picture1, dummy_canvas));
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             picture2.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Draw(*picture2, dummy_canvas));
+
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(over_budget_count, 0);
+  cache.PrepareNewFrame();
+
+  // picture1 has not been used yet in this frame, so it makes room.
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            picture2.get(), true, false, matrix));
+  ASSERT_TRUE(cache.Draw(*picture2, dummy_canvas));
+  ASSERT_FALSE(cache.Draw(*picture1, dummy_canvas));
+
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(over_budget_count, 1);
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().eviction_bytes, 60000u);
+  ASSERT_EQ(cache.picture_metrics().in_use_count, 1u);
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 60000u);
+}
+
+TEST(RasterCache, EntryInfosDescribeEntriesWithImages) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+  auto display_list = GetSampleDisplayList();
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  cache.PrepareNewFrame();
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             picture.get(), true, false, matrix));
+  cache.CleanupAfterFrame();
+  cache.PrepareNewFrame();
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            picture.get(), true, false, matrix));
+  // The display list has no image yet.
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             display_list.get(), true, false, matrix));
+  cache.CleanupAfterFrame();
+
+  auto infos = cache.GetEntryInfos();
+  ASSERT_EQ(infos.size(), 1u);
+  ASSERT_EQ(infos[0].type, RasterCache::EntryInfo::Type::kPicture);
+  ASSERT_EQ(infos[0].id, picture->uniqueID());
+  ASSERT_EQ(infos[0].image_dimensions, SkISize::Make(150, 100));
+  ASSERT_EQ(infos[0].image_bytes, 60000u);
+  ASSERT_EQ(infos[0].access_count, 2u);
+}
+
+TEST(RasterCache, BudgetDoesNotEvictImagesUsedInThisFrame) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetMaxBytes(100000);
+  int over_budget_count = 0;
+  cache.SetOverBudgetCallback([&over_budget_count]() { over_budget_count++; });
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture1 = GetSamplePicture();
+  auto picture2 = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  cache.PrepareNewFrame();
+
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             picture1.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Draw(*picture1, dummy_canvas));
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             picture2.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Draw(*picture2, dummy_canvas));
+
+  cache.CleanupAfterFrame();
+  cache.PrepareNewFrame();
+
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            picture1.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             picture2.get(), true, false, matrix));
+  ASSERT_TRUE(cache.Draw(*picture1, dummy_canvas));
+  ASSERT_FALSE(cache.Draw(*picture2, dummy_canvas));
+
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(over_budget_count, 1);
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 0u);
+  ASSERT_EQ(cache.picture_metrics().in_use_count, 1u);
+}
+
+TEST(RasterCache, ImageLargerThanBudgetIsNotCached) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetMaxBytes(1000);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  cache.PrepareNewFrame();
+
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             picture.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+
+  cache.CleanupAfterFrame();
+  cache.PrepareNewFrame();
+
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             picture.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+}
+
+TEST(RasterCache, LoweringBudgetEvictsAtEndOfFrame) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  cache.PrepareNewFrame();
+
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             picture.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+
+  cache.CleanupAfterFrame();
+  cache.PrepareNewFrame();
+
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            picture.get(), true, false, matrix));
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+  cache.SetMaxBytes(1000);
+
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().eviction_bytes, 60000u);
+  ASSERT_EQ(cache.picture_metrics().in_use_count, 0u);
+  ASSERT_EQ(cache.picture_metrics().in_use_bytes, 0u);
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+}
+
+TEST(RasterCache, TrimEvictsLeastRecentlyUsedImages) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture1 = GetSamplePicture();
+  auto picture2 = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  cache.PrepareNewFrame();
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             picture1.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             picture2.get(), true, false, matrix));
+  cache.CleanupAfterFrame();
+  cache.PrepareNewFrame();
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            picture1.get(), true, false, matrix));
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            picture2.get(), true, false, matrix));
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 120000u);
+
+  ASSERT_EQ(cache.Trim(120000), 0u);
+  ASSERT_EQ(cache.Trim(100000), 60000u);
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 60000u);
+
+  // The image of picture2 was used last, so it is kept.
+  cache.PrepareNewFrame();
+  ASSERT_TRUE(cache.Draw(*picture2, dummy_canvas));
+  ASSERT_FALSE(cache.Draw(*picture1, dummy_canvas));
+  cache.CleanupAfterFrame();
+
+  ASSERT_EQ(cache.Trim(0), 60000u);
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+}
+
+TEST(RasterCache, ShadowsAreCachedAfterThresholdAndSharedByPath) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  SkPath path = SkPath::Rect(SkRect::MakeLTRB(10, 10, 110, 60));
+  SkPath copy = path;
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+  PrerollContext* preroll_context = &preroll_context_holder.preroll_context;
+
+  cache.PrepareNewFrame();
+  ASSERT_FALSE(cache.PrepareShadow(preroll_context, path, SK_ColorBLACK, 4,
+                                   false, 2, matrix));
+  ASSERT_FALSE(
+      cache.DrawShadow(path, SK_ColorBLACK, 4, false, 2, dummy_canvas));
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.EstimateLayerCacheByteSize(), 0u);
+
+  cache.PrepareNewFrame();
+  ASSERT_TRUE(cache.PrepareShadow(preroll_context, path, SK_ColorBLACK, 4,
+                                  false, 2, matrix));
+  // A copy of the path casts the same shadow, but not from another height.
+  ASSERT_TRUE(cache.DrawShadow(copy, SK_ColorBLACK, 4, false, 2, dummy_canvas));
+  ASSERT_FALSE(
+      cache.DrawShadow(copy, SK_ColorBLACK, 8, false, 2, dummy_canvas));
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.GetShadowCachedEntriesCount(), 1u);
+  ASSERT_GT(cache.EstimateLayerCacheByteSize(), 0u);
+
+  // The shadow is dropped once a frame does not cast it.
+  cache.PrepareNewFrame();
+  cache.CleanupAfterFrame();
+  ASSERT_EQ(cache.GetShadowCachedEntriesCount(), 0u);
+  ASSERT_EQ(cache.EstimateLayerCacheByteSize(), 0u);
+}
+
+TEST(RasterCache, ShadowsOfVolatilePathsAreNotCached) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  SkPath path = SkPath::Rect(SkRect::MakeLTRB(10, 10, 110, 60));
+  path.setIsVolatile(true);
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+  PrerollContext* preroll_context = &preroll_context_holder.preroll_context;
+
+  for (int i = 0; i < 3; i++) {
+    cache.PrepareNewFrame();
+    ASSERT_FALSE(cache.PrepareShadow(preroll_context, path, SK_ColorBLACK, 4,
+                                     false, 2, matrix));
+    ASSERT_FALSE(
+        cache.DrawShadow(path, SK_ColorBLACK, 4, false, 2, dummy_canvas));
+    cache.CleanupAfterFrame();
+  }
+  ASSERT_EQ(cache.GetShadowCachedEntriesCount(), 0u);
+}
+
+TEST(RasterCache, CachesSharingABudgetStayWithinIt) {
+  size_t threshold = 1;
+  auto budget = std::make_shared<RasterCacheBudget>(100000);
+  flutter::RasterCache first_cache(threshold);
+  first_cache.SetSharedBudget(budget);
+  auto second_cache = std::make_unique<flutter::RasterCache>(threshold);
+  second_cache->SetSharedBudget(budget);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  for (int i = 0; i < 2; i++) {
+    second_cache->PrepareNewFrame();
+    second_cache->Prepare(&preroll_context_holder.preroll_context,
+                          picture.get(), true, false, matrix);
+    second_cache->CleanupAfterFrame();
+  }
+  ASSERT_EQ(second_cache->EstimatePictureCacheByteSize(), 60000u);
+  ASSERT_EQ(budget->GetBytesUsedByOthers(&first_cache), 60000u);
+
+  // The other cache leaves too little of the budget for the image.
+  for (int i = 0; i < 2; i++) {
+    first_cache.PrepareNewFrame();
+    ASSERT_FALSE(first_cache.Prepare(&preroll_context_holder.preroll_context,
+                                     picture.get(), true, false, matrix));
+    ASSERT_FALSE(first_cache.Draw(*picture, dummy_canvas));
+    first_cache.CleanupAfterFrame();
+  }
+  ASSERT_EQ(first_cache.EstimatePictureCacheByteSize(), 0u);
+
+  // The budget is freed when the other cache goes away.
+  second_cache.reset();
+  ASSERT_EQ(budget->GetBytesUsedByOthers(&first_cache), 0u);
+  first_cache.PrepareNewFrame();
+  ASSERT_TRUE(first_cache.Prepare(&preroll_context_holder.preroll_context,
+                                  picture.get(), true, false, matrix));
+  ASSERT_TRUE(first_cache.Draw(*picture, dummy_canvas));
+  first_cache.CleanupAfterFrame();
+  ASSERT_EQ(first_cache.EstimatePictureCacheByteSize(), 60000u);
+}
+
+TEST(RasterCache, AsyncImageIsPromotedOnNextFrame) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  std::vector<RasterCache::ResourceContextTask> tasks;
+  cache.SetResourceContextTaskRunner(
+      [&tasks](RasterCache::ResourceContextTask task) {
+        tasks.push_back(std::move(task));
+      },
+      nullptr);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  cache.PrepareNewFrame();
+
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             display_list.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Draw(*display_list, dummy_canvas));
+
+  cache.CleanupAfterFrame();
+  cache.PrepareNewFrame();
+
+  // The image is rasterized by the task rather than by Prepare.
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             display_list.get(), true, false, matrix));
+  ASSERT_EQ(tasks.size(), 1u);
+  ASSERT_FALSE(cache.Draw(*display_list, dummy_canvas));
+  tasks[0](nullptr);
+  // The image is not used until the next frame.
+  ASSERT_FALSE(cache.Draw(*display_list, dummy_canvas));
+
+  cache.CleanupAfterFrame();
+  cache.PrepareNewFrame();
+
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            display_list.get(), true, false, matrix));
+  ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
+  ASSERT_EQ(tasks.size(), 1u);
+}
+
+TEST(RasterCache, AsyncImageOfSweptEntryIsDropped) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  std::vector<RasterCache::ResourceContextTask> tasks;
+  cache.SetResourceContextTaskRunner(
+      [&tasks](RasterCache::ResourceContextTask task) {
+        tasks.push_back(std::move(task));
+      },
+      nullptr);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  cache.PrepareNewFrame();
+
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             picture.get(), true, false, matrix));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+
+  cache.CleanupAfterFrame();
+  cache.PrepareNewFrame();
+
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             picture.get(), true, false, matrix));
+  ASSERT_EQ(tasks.size(), 1u);
+
+  cache.CleanupAfterFrame();  // The entry is not drawn and is swept.
+  tasks[0](nullptr);
+  cache.PrepareNewFrame();
+
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 0u);
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+}
+
+TEST(RasterCache, DeferredPrepareIsReplayedOnRasterThread) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+  PrerollContext* context = &preroll_context_holder.preroll_context;
+  std::vector<RasterCache::DeferredCall> calls;
+
+  for (int i = 0; i < 2; i++) {
+    cache.PrepareNewFrame();
+
+    context->deferred_raster_cache_calls = &calls;
+    ASSERT_FALSE(
+        cache.Prepare(context, display_list.get(), true, false, matrix));
+    ASSERT_EQ(calls.size(), 1u);
+    ASSERT_EQ(cache.GetCachedEntriesCount(), static_cast<size_t>(i));
+
+    context->deferred_raster_cache_calls = nullptr;
+    calls[0](context);
+    calls.clear();
+    ASSERT_EQ(cache.GetCachedEntriesCount(), 1u);
+    // The replayed Prepare caches the display list on the 2nd frame.
+    ASSERT_EQ(cache.Draw(*display_list, dummy_canvas), i == 1);
+
+    cache.CleanupAfterFrame();
+  }
+}
+
+TEST(RasterCache, KeyIgnoresIntegralTranslation) {
+  SkMatrix matrix = SkMatrix::Scale(2, 2);
+  SkMatrix translated = matrix;
+  translated.postTranslate(37, -120);
+  RasterCacheKey<uint32_t>::Equal equal;
+
+  ASSERT_TRUE(equal(RasterCacheKey<uint32_t>(1, matrix),
+                    RasterCacheKey<uint32_t>(1, translated)));
+  ASSERT_FALSE(equal(RasterCacheKey<uint32_t>(1, matrix),
+                     RasterCacheKey<uint32_t>(1, SkMatrix::Scale(3, 3))));
+}
+
+#ifdef SUPPORT_FRACTIONAL_TRANSLATION
+TEST(RasterCache, KeyIncludesSubpixelBucket) {
+  RasterCacheKey<uint32_t>::Equal equal;
+
+  // 0.1 and 0.2 share the first of the four buckets while 0.3 is in the
+  // second.
+  ASSERT_TRUE(equal(RasterCacheKey<uint32_t>(1, SkMatrix::Translate(10.1, 0)),
+                    RasterCacheKey<uint32_t>(1, SkMatrix::Translate(3.2, 0))));
+  ASSERT_FALSE(
+      equal(RasterCacheKey<uint32_t>(1, SkMatrix::Translate(10.1, 0)),
+            RasterCacheKey<uint32_t>(1, SkMatrix::Translate(10.3, 0))));
+}
+
+TEST(RasterCache, SubpixelBucketCTMSnapsTranslation) {
+  SkMatrix snapped =
+      RasterCache::GetSubpixelBucketCTM(SkMatrix::Translate(10.3, -2.6));
+
+  ASSERT_FLOAT_EQ(snapped.getTranslateX(), 10.25);
+  ASSERT_FLOAT_EQ(snapped.getTranslateY(), -2.75);
+}
+#endif  // SUPPORT_FRACTIONAL_TRANSLATION
+
+TEST(RasterCache, ConcurrentRecordingIsSkippedWithoutGrContext) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  auto loop = fml::ConcurrentMessageLoop::Create(1);
+  cache.SetConcurrentRecordingTaskRunner(loop->GetTaskRunner());
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+
+  SkCanvas dummy_canvas;
+
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder();
+
+  cache.PrepareNewFrame();
+
+  ASSERT_FALSE(cache.Prepare(&preroll_context_holder.preroll_context,
+                             display_list.get(), true, false, matrix));
+
+  cache.CleanupAfterFrame();
+  cache.PrepareNewFrame();
+
+  // Deferred display lists need a GrDirectContext, so the image is
+  // rasterized by Prepare as usual.
+  ASSERT_TRUE(cache.Prepare(&preroll_context_holder.preroll_context,
+                            display_list.get(), true, false, matrix));
+  cache.DrawRecordedImages();
+  ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
+}
+
 }  // namespace testing
 
 }  // namespace flutter
@@ -4,85 +4,218 @@
 
 #include "rtree.h"
 
-#include <list>
+#include <algorithm>
+#include <cmath>
 
 #include "flutter/fml/logging.h"
 #include "third_party/skia/include/core/SkBBHFactory.h"
 
 namespace flutter {
 
-RTree::RTree() : bbh_{SkRTreeFactory{}()}, all_ops_count_(0) {}
+RTree::RTree() : all_ops_count_(0) {}
 
 void RTree::insert(const SkRect boundsArray[],
                    const SkBBoxHierarchy::Metadata metadata[],
                    int N) {
   FML_DCHECK(0 == all_ops_count_);
-  bbh_->insert(boundsArray, metadata, N);
+  all_ops_count_ = N;
+  is_draw_.resize(N);
+  for (int i = 0; i < N; i++) {
+    is_draw_[i] = metadata != nullptr && metadata[i].isDraw;
+  }
+
+  // Empty rects never intersect with a query, so they are left out.
   for (int i = 0; i < N; i++) {
-    if (metadata != nullptr && metadata[i].isDraw) {
-      draw_op_[i] = boundsArray[i];
+    if (!boundsArray[i].isEmpty()) {
+      leaf_indices_.push_back(i);
     }
   }
-  all_ops_count_ = N;
+  size_t leaf_count = leaf_indices_.size();
+  if (leaf_count == 0) {
+    return;
+  }
+
+  // Sort-Tile-Recursive: sort the rects into vertical slices by the x of
+  // their centers, and each slice by the y of their centers, so that each
+  // group of |kNodeCapacity| consecutive rects covers a compact tile.
+  auto center_x = [boundsArray](int index) {
+    return boundsArray[index].centerX();
+  };
+  auto center_y = [boundsArray](int index) {
+    return boundsArray[index].centerY();
+  };
+  std::sort(leaf_indices_.begin(), leaf_indices_.end(),
+            [&center_x](int a, int b) { return center_x(a) < center_x(b); });
+  size_t node_count = (leaf_count + kNodeCapacity - 1) / kNodeCapacity;
+  size_t slice_count = static_cast<size_t>(
+      std::ceil(std::sqrt(static_cast<double>(node_count))));
+  size_t slice_size = slice_count * kNodeCapacity;
+  for (size_t start = 0; start < leaf_count; start += slice_size) {
+    auto first = leaf_indices_.begin() + start;
+    auto last =
+        leaf_indices_.begin() + std::min(start + slice_size, leaf_count);
+    std::sort(first, last, [&center_y](int a, int b) {
+      return center_y(a) < center_y(b);
+    });
+  }
+
+  for (int index : leaf_indices_) {
+    const SkRect& bounds = boundsArray[index];
+    left_.push_back(bounds.fLeft);
+    top_.push_back(bounds.fTop);
+    right_.push_back(bounds.fRight);
+    bottom_.push_back(bounds.fBottom);
+  }
+
+  // Each level above the leaves has a node for every group of
+  // |kNodeCapacity| consecutive nodes of the level below, up to the root.
+  level_starts_.push_back(0);
+  size_t start = 0;
+  size_t count = leaf_count;
+  while (count > 1) {
+    size_t parent_start = start + count;
+    for (size_t first = 0; first < count; first += kNodeCapacity) {
+      size_t last = std::min(first + kNodeCapacity, count);
+      float left = left_[start + first];
+      float top = top_[start + first];
+      float right = right_[start + first];
+      float bottom = bottom_[start + first];
+      for (size_t i = start + first + 1; i < start + last; i++) {
+        left = std::min(left, left_[i]);
+        top = std::min(top, top_[i]);
+        right = std::max(right, right_[i]);
+        bottom = std::max(bottom, bottom_[i]);
+      }
+      left_.push_back(left);
+      top_.push_back(top);
+      right_.push_back(right);
+      bottom_.push_back(bottom);
+    }
+    start = parent_start;
+    count = left_.size() - start;
+    level_starts_.push_back(start);
+  }
+  level_starts_.push_back(start + count);
 }
 
 void RTree::insert(const SkRect boundsArray[], int N) {
   insert(boundsArray, nullptr, N);
 }
 
+void RTree::SearchNodes(size_t level,
+                        size_t first,
+                        size_t last,
+                        const SkRect& query,
+                        std::vector<size_t>* leaves) const {
+  FML_DCHECK(last - first <= kNodeCapacity);
+  size_t base = level_starts_[level];
+  const float* left = left_.data() + base;
+  const float* top = top_.data() + base;
+  const float* right = right_.data() + base;
+  const float* bottom = bottom_.data() + base;
+  // Test all of the nodes without branching so that the loop is
+  // vectorized. This matches SkRect::Intersects.
+  bool hits[kNodeCapacity];
+  for (size_t i = first; i < last; i++) {
+    float l = std::max(left[i], query.fLeft);
+    float t = std::max(top[i], query.fTop);
+    float r = std::min(right[i], query.fRight);
+    float b = std::min(bottom[i], query.fBottom);
+    hits[i - first] = (l < r) & (t < b);
+  }
+  for (size_t i = first; i < last; i++) {
+    if (!hits[i - first]) {
+      continue;
+    }
+    if (level == 0) {
+      leaves->push_back(i);
+    } else {
+      size_t child_count = level_starts_[level] - level_starts_[level - 1];
+      size_t child_first = i * kNodeCapacity;
+      SearchNodes(level - 1, child_first,
+                  std::min(child_first + kNodeCapacity, child_count), query,
+                  leaves);
+    }
+  }
+}
+
+void RTree::SearchLeaves(const SkRect& query,
+                         std::vector<size_t>* leaves) const {
+  if (level_starts_.empty() || query.isEmpty()) {
+    return;
+  }
+  size_t root_level = level_starts_.size() - 2;
+  SearchNodes(root_level, 0,
+              level_starts_[root_level + 1] - level_starts_[root_level], query,
+              leaves);
+  // The picture plays back the operations in the order that they are
+  // returned, which must be the order in which they were recorded.
+  std::sort(leaves->begin(), leaves->end(), [this](size_t a, size_t b) {
+    return leaf_indices_[a] < leaf_indices_[b];
+  });
+}
+
 void RTree::search(const SkRect& query, std::vector<int>* results) const {
-  bbh_->search(query, results);
+  std::vector<size_t> leaves;
+  SearchLeaves(query, &leaves);
+  for (size_t leaf : leaves) {
+    results->push_back(leaf_indices_[leaf]);
+  }
 }
 
-std::list<SkRect> RTree::searchNonOverlappingDrawnRects(
-    const SkRect& query) const {
-  // Get the indexes for the operations that intersect with the query rect.
-  std::vector<int> intermediary_results;
-  search(query, &intermediary_results);
+void RTree::searchNonOverlappingDrawnRects(
+    const SkRect& query,
+    std::vector<SkRect>* results) const {
+  results->clear();
+  // Get the leaves for the operations that intersect with the query rect.
+  std::vector<size_t> leaves;
+  SearchLeaves(query, &leaves);
 
-  std::list<SkRect> final_results;
-  for (int index : intermediary_results) {
-    auto draw_op = draw_op_.find(index);
+  for (size_t leaf : leaves) {
     // Ignore records that don't draw anything.
-    if (draw_op == draw_op_.end()) {
+    if (!is_draw_[leaf_indices_[leaf]]) {
       continue;
     }
-    auto current_record_rect = draw_op->second;
-    auto replaced_existing_rect = false;
-    // // If the current record rect intersects with any of the rects in the
-    // // result list, then join them, and update the rect in final_results.
-    std::list<SkRect>::iterator curr_rect_itr = final_results.begin();
-    std::list<SkRect>::iterator first_intersecting_rect_itr;
-    while (!replaced_existing_rect && curr_rect_itr != final_results.end()) {
-      if (SkRect::Intersects(*curr_rect_itr, current_record_rect)) {
-        replaced_existing_rect = true;
-        first_intersecting_rect_itr = curr_rect_itr;
-        curr_rect_itr->join(current_record_rect);
+    SkRect current_record_rect = SkRect::MakeLTRB(
+        left_[leaf], top_[leaf], right_[leaf], bottom_[leaf]);
+    // If the current record rect intersects with any of the rects in the
+    // result list, then join them, and update the rect in results.
+    size_t count = results->size();
+    size_t first_intersecting = count;
+    for (size_t i = 0; i < count; i++) {
+      if (SkRect::Intersects((*results)[i], current_record_rect)) {
+        first_intersecting = i;
+        (*results)[i].join(current_record_rect);
+        break;
       }
-      curr_rect_itr++;
+    }
+    if (first_intersecting == count) {
+      results->push_back(current_record_rect);
+      continue;
     }
     // It's possible that the result contains duplicated rects at this point.
     // For example, consider a result list that contains rects A, B. If a
     // new rect C is a superset of A and B, then A and B are the same set after
     // the merge. As a result, find such cases and remove them from the result
-    // list.
-    while (replaced_existing_rect && curr_rect_itr != final_results.end()) {
-      if (SkRect::Intersects(*curr_rect_itr, *first_intersecting_rect_itr)) {
-        first_intersecting_rect_itr->join(*curr_rect_itr);
-        curr_rect_itr = final_results.erase(curr_rect_itr);
+    // list, keeping the order of the remaining rects.
+    SkRect& joined = (*results)[first_intersecting];
+    size_t kept = first_intersecting + 1;
+    for (size_t i = first_intersecting + 1; i < count; i++) {
+      if (SkRect::Intersects((*results)[i], joined)) {
+        joined.join((*results)[i]);
       } else {
-        curr_rect_itr++;
+        (*results)[kept++] = (*results)[i];
       }
     }
-    if (!replaced_existing_rect) {
-      final_results.push_back(current_record_rect);
-    }
+    results->resize(kept);
   }
-  return final_results;
 }
 
 size_t RTree::bytesUsed() const {
-  return bbh_->bytesUsed();
+  return sizeof(float) * (left_.capacity() + top_.capacity() +
+                          right_.capacity() + bottom_.capacity()) +
+         sizeof(size_t) * level_starts_.capacity() +
+         sizeof(int) * leaf_indices_.capacity() + is_draw_.capacity() / 8;
 }
 
 RTreeFactory::RTreeFactory() {
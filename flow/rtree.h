@@ -5,21 +5,31 @@
 #ifndef FLUTTER_FLOW_RTREE_H_
 #define FLUTTER_FLOW_RTREE_H_
 
-#include <list>
-#include <map>
+#include <vector>
 
 #include "third_party/skia/include/core/SkBBHFactory.h"
 #include "third_party/skia/include/core/SkTypes.h"
 
 namespace flutter {
 /**
- * An R-Tree implementation that forwards calls to an SkRTree.
+ * A bulk loaded, packed R-Tree.
+ *
+ * The picture recorder inserts all of the rects of a picture at once, so
+ * the tree is built in a single pass with the Sort-Tile-Recursive
+ * algorithm rather than one insertion at a time, and every node is full
+ * except for the last one of each level. This lets the nodes of each
+ * level be stored contiguously, with the bounds of the nodes in separate
+ * arrays of floats, so that the children of a node are tested against a
+ * query in one tight loop which the compiler can vectorize.
  *
  * This implementation provides a searchNonOverlappingDrawnRects method,
  * which can be used to query the rects for the operations recorded in the tree.
  */
 class RTree : public SkBBoxHierarchy {
  public:
+  // The number of children of each node.
+  static constexpr size_t kNodeCapacity = 16;
+
   RTree();
 
   void insert(const SkRect[],
@@ -30,21 +40,44 @@ class RTree : public SkBBoxHierarchy {
   size_t bytesUsed() const override;
 
   // Finds the rects in the tree that represent drawing operations and intersect
-  // with the query rect.
+  // with the query rect, and replaces the contents of |results| with them.
   //
   // When two rects intersect with each other, they are joined into a single
   // rect which also intersects with the query rect. In other words, the bounds
   // of each rect in the result list are mutually exclusive.
-  std::list<SkRect> searchNonOverlappingDrawnRects(const SkRect& query) const;
+  void searchNonOverlappingDrawnRects(const SkRect& query,
+                                      std::vector<SkRect>* results) const;
 
   // Insertion count (not overall node count, which may be greater).
   int getCount() const { return all_ops_count_; }
 
  private:
-  // A map containing the draw operation rects keyed off the operation index
-  // in the insert call.
-  std::map<int, SkRect> draw_op_;
-  sk_sp<SkBBoxHierarchy> bbh_;
+  // Appends the leaves under the nodes [first, last) of |level| whose rects
+  // intersect with |query| to |leaves|.
+  void SearchNodes(size_t level,
+                   size_t first,
+                   size_t last,
+                   const SkRect& query,
+                   std::vector<size_t>* leaves) const;
+
+  // Appends the leaves whose rects intersect with |query| to the empty
+  // |leaves|, in insertion order.
+  void SearchLeaves(const SkRect& query, std::vector<size_t>* leaves) const;
+
+  // The bounds of the nodes of all of the levels, starting with the leaves,
+  // which are the inserted rects. The nodes of the level above are the
+  // groups of |kNodeCapacity| consecutive nodes of a level.
+  std::vector<float> left_;
+  std::vector<float> top_;
+  std::vector<float> right_;
+  std::vector<float> bottom_;
+  // The index of the first node of each level, followed by the total node
+  // count.
+  std::vector<size_t> level_starts_;
+  // The insertion index of each leaf.
+  std::vector<int> leaf_indices_;
+  // Whether the rect at each insertion index is that of a drawing operation.
+  std::vector<bool> is_draw_;
   int all_ops_count_;
 };
 
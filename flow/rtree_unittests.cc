@@ -26,8 +26,9 @@ TEST(RTree, searchNonOverlappingDrawnRectsNoIntersection) {
   recording_canvas->drawRect(SkRect::MakeLTRB(20, 20, 40, 40), rect_paint);
   recorder->finishRecordingAsPicture();
 
-  auto hits = rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
-      SkRect::MakeLTRB(40, 40, 80, 80));
+  std::vector<SkRect> hits;
+  rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeLTRB(40, 40, 80, 80), &hits);
   ASSERT_TRUE(hits.empty());
 }
 
@@ -47,8 +48,9 @@ TEST(RTree, searchNonOverlappingDrawnRectsSingleRectIntersection) {
 
   recorder->finishRecordingAsPicture();
 
-  auto hits = rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
-      SkRect::MakeLTRB(140, 140, 150, 150));
+  std::vector<SkRect> hits;
+  rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeLTRB(140, 140, 150, 150), &hits);
   ASSERT_EQ(1UL, hits.size());
   ASSERT_EQ(*hits.begin(), SkRect::MakeLTRB(120, 120, 160, 160));
 }
@@ -75,8 +77,9 @@ TEST(RTree, searchNonOverlappingDrawnRectsIgnoresNonDrawingRecords) {
   // The rtree has a translate, a clip and a rect record.
   ASSERT_EQ(3, rtree_factory.getInstance()->getCount());
 
-  auto hits = rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
-      SkRect::MakeLTRB(0, 0, 1000, 1000));
+  std::vector<SkRect> hits;
+  rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeLTRB(0, 0, 1000, 1000), &hits);
   ASSERT_EQ(1UL, hits.size());
   ASSERT_EQ(*hits.begin(), SkRect::MakeLTRB(120, 120, 180, 180));
 }
@@ -105,8 +108,9 @@ TEST(RTree, searchNonOverlappingDrawnRectsMultipleRectIntersection) {
 
   recorder->finishRecordingAsPicture();
 
-  auto hits = rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
-      SkRect::MakeLTRB(0, 0, 1000, 1050));
+  std::vector<SkRect> hits;
+  rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeLTRB(0, 0, 1000, 1050), &hits);
   ASSERT_EQ(2UL, hits.size());
   ASSERT_EQ(*hits.begin(), SkRect::MakeLTRB(100, 100, 200, 200));
   ASSERT_EQ(*std::next(hits.begin(), 1), SkRect::MakeLTRB(300, 100, 400, 200));
@@ -140,8 +144,9 @@ TEST(RTree, searchNonOverlappingDrawnRectsJoinRectsWhenIntersectedCase1) {
 
   recorder->finishRecordingAsPicture();
 
-  auto hits = rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
-      SkRect::MakeXYWH(120, 120, 126, 126));
+  std::vector<SkRect> hits;
+  rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeXYWH(120, 120, 126, 126), &hits);
   ASSERT_EQ(1UL, hits.size());
   ASSERT_EQ(*hits.begin(), SkRect::MakeLTRB(100, 100, 175, 175));
 }
@@ -181,8 +186,9 @@ TEST(RTree, searchNonOverlappingDrawnRectsJoinRectsWhenIntersectedCase2) {
 
   recorder->finishRecordingAsPicture();
 
-  auto hits = rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
-      SkRect::MakeLTRB(30, 30, 550, 270));
+  std::vector<SkRect> hits;
+  rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeLTRB(30, 30, 550, 270), &hits);
   ASSERT_EQ(1UL, hits.size());
   ASSERT_EQ(*hits.begin(), SkRect::MakeLTRB(50, 50, 500, 250));
 }
@@ -225,11 +231,61 @@ TEST(RTree, searchNonOverlappingDrawnRectsJoinRectsWhenIntersectedCase3) {
 
   recorder->finishRecordingAsPicture();
 
-  auto hits = rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
-      SkRect::MakeLTRB(30, 30, 550, 270));
+  std::vector<SkRect> hits;
+  rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeLTRB(30, 30, 550, 270), &hits);
   ASSERT_EQ(1UL, hits.size());
   ASSERT_EQ(*hits.begin(), SkRect::MakeLTRB(50, 50, 620, 300));
 }
 
+TEST(RTree, searchMatchesBruteForceInInsertionOrder) {
+  // Enough rects for several levels of nodes.
+  std::vector<SkRect> rects;
+  for (int i = 0; i < 1000; i++) {
+    // Scattered rects of varying sizes, including some empty ones.
+    SkScalar x = (i * 37) % 997;
+    SkScalar y = (i * 61) % 983;
+    rects.push_back(SkRect::MakeXYWH(x, y, i % 50, (i * 7) % 40));
+  }
+  auto rtree = sk_make_sp<RTree>();
+  rtree->insert(rects.data(), static_cast<int>(rects.size()));
+  ASSERT_EQ(1000, rtree->getCount());
+
+  for (const SkRect& query : {SkRect::MakeLTRB(0, 0, 1000, 1000),
+                              SkRect::MakeLTRB(100, 200, 300, 250),
+                              SkRect::MakeLTRB(500, 500, 501, 501),
+                              SkRect::MakeEmpty()}) {
+    std::vector<int> expected;
+    for (int i = 0; i < static_cast<int>(rects.size()); i++) {
+      if (SkRect::Intersects(rects[i], query)) {
+        expected.push_back(i);
+      }
+    }
+    std::vector<int> results;
+    rtree->search(query, &results);
+    ASSERT_EQ(results, expected);
+  }
+}
+
+TEST(RTree, searchNonOverlappingDrawnRectsReplacesResults) {
+  auto rtree_factory = RTreeFactory();
+  auto recorder = std::make_unique<SkPictureRecorder>();
+  auto recording_canvas =
+      recorder->beginRecording(SkRect::MakeIWH(1000, 1000), &rtree_factory);
+
+  auto rect_paint = SkPaint();
+  rect_paint.setColor(SkColors::kCyan);
+  rect_paint.setStyle(SkPaint::Style::kFill_Style);
+
+  recording_canvas->drawRect(SkRect::MakeLTRB(100, 100, 200, 200), rect_paint);
+  recorder->finishRecordingAsPicture();
+
+  std::vector<SkRect> hits = {SkRect::MakeLTRB(0, 0, 10, 10)};
+  rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeLTRB(0, 0, 1000, 1000), &hits);
+  ASSERT_EQ(1UL, hits.size());
+  ASSERT_EQ(hits[0], SkRect::MakeLTRB(100, 100, 200, 200));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -9,44 +9,121 @@
 
 namespace flutter {
 
+namespace {
+
+// The number of objects unreffed between two checks of the drain deadline.
+constexpr size_t kObjectsPerDeadlineCheck = 16;
+
+}  // namespace
+
 SkiaUnrefQueue::SkiaUnrefQueue(fml::RefPtr<fml::TaskRunner> task_runner,
                                fml::TimeDelta delay,
-                               fml::WeakPtr<GrDirectContext> context)
+                               fml::WeakPtr<GrDirectContext> context,
+                               fml::TimeDelta drain_budget)
     : task_runner_(std::move(task_runner)),
       drain_delay_(delay),
+      drain_budget_(drain_budget),
+      incoming_(nullptr),
+      depth_(0),
       drain_pending_(false),
+      draining_(nullptr),
+      needs_deferred_cleanup_(false),
       context_(context) {}
 
 SkiaUnrefQueue::~SkiaUnrefQueue() {
-  FML_DCHECK(objects_.empty());
+  FML_DCHECK(incoming_.load() == nullptr);
+  FML_DCHECK(draining_ == nullptr);
 }
 
 void SkiaUnrefQueue::Unref(SkRefCnt* object) {
-  std::scoped_lock lock(mutex_);
-  objects_.push_back(object);
-  if (!drain_pending_) {
-    drain_pending_ = true;
-    task_runner_->PostDelayedTask(
-        [strong = fml::Ref(this)]() { strong->Drain(); }, drain_delay_);
+  Node* node = new Node{object, incoming_.load(std::memory_order_relaxed)};
+  while (!incoming_.compare_exchange_weak(node->next, node,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed)) {
+  }
+  depth_.fetch_add(1, std::memory_order_relaxed);
+  if (!drain_pending_.exchange(true, std::memory_order_acq_rel)) {
+    drain_posted_time_ = fml::TimePoint::Now();
+    PostDrain(drain_delay_);
   }
 }
 
+void SkiaUnrefQueue::PostDrain(fml::TimeDelta delay) {
+  task_runner_->PostDelayedTask(
+      [strong = fml::Ref(this)]() { strong->DrainWithBudget(); }, delay);
+}
+
 void SkiaUnrefQueue::Drain() {
   TRACE_EVENT0("flutter", "SkiaUnrefQueue::Drain");
-  std::deque<SkRefCnt*> skia_objects;
-  {
-    std::scoped_lock lock(mutex_);
-    objects_.swap(skia_objects);
-    drain_pending_ = false;
+  UnrefObjects(nullptr);
+  PerformDeferredCleanup();
+}
+
+void SkiaUnrefQueue::DrainWithBudget() {
+  TRACE_EVENT0("flutter", "SkiaUnrefQueue::DrainWithBudget");
+  fml::TimePoint deadline = fml::TimePoint::Now() + drain_budget_;
+  UnrefObjects(&deadline);
+#if !FLUTTER_RELEASE
+  int64_t depth = depth_.load(std::memory_order_relaxed);
+  int64_t latency_micros =
+      (fml::TimePoint::Now() - drain_posted_time_).ToMicroseconds();
+  FML_TRACE_COUNTER("flutter", "SkiaUnrefQueue",
+                    reinterpret_cast<int64_t>(this), "QueueDepth", depth,
+                    "DrainLatencyMicros", latency_micros);
+#endif  // !FLUTTER_RELEASE
+
+  if (draining_) {
+    // The budget ran out. Let the other tasks of the task runner go first.
+    PostDrain(fml::TimeDelta::Zero());
+    return;
+  }
+  PerformDeferredCleanup();
+
+  drain_pending_.store(false, std::memory_order_release);
+  // The objects queued after the last objects were taken, but before the
+  // pending drain was cleared, did not post a drain of their own.
+  if (incoming_.load(std::memory_order_acquire) &&
+      !drain_pending_.exchange(true, std::memory_order_acq_rel)) {
+    drain_posted_time_ = fml::TimePoint::Now();
+    PostDrain(drain_delay_);
   }
+}
 
-  for (SkRefCnt* skia_object : skia_objects) {
-    skia_object->unref();
+void SkiaUnrefQueue::UnrefObjects(const fml::TimePoint* deadline) {
+  size_t count = 0;
+  while (true) {
+    if (!draining_) {
+      // Reverse the taken stack into the order the objects were queued in.
+      Node* node = incoming_.exchange(nullptr, std::memory_order_acquire);
+      while (node) {
+        Node* next = node->next;
+        node->next = draining_;
+        draining_ = node;
+        node = next;
+      }
+      if (!draining_) {
+        break;
+      }
+    }
+    Node* node = draining_;
+    draining_ = node->next;
+    node->object->unref();
+    delete node;
+    count++;
+    if (deadline && count % kObjectsPerDeadlineCheck == 0 &&
+        fml::TimePoint::Now() >= *deadline) {
+      break;
+    }
   }
+  depth_.fetch_sub(count, std::memory_order_relaxed);
+  needs_deferred_cleanup_ = needs_deferred_cleanup_ || count > 0;
+}
 
-  if (context_ && skia_objects.size() > 0) {
+void SkiaUnrefQueue::PerformDeferredCleanup() {
+  if (context_ && needs_deferred_cleanup_) {
     context_->performDeferredCleanup(std::chrono::milliseconds(0));
   }
+  needs_deferred_cleanup_ = false;
 }
 
 }  // namespace flutter
@@ -5,12 +5,13 @@
 #ifndef FLUTTER_FLOW_SKIA_GPU_OBJECT_H_
 #define FLUTTER_FLOW_SKIA_GPU_OBJECT_H_
 
-#include <mutex>
-#include <queue>
+#include <atomic>
 
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
@@ -18,8 +19,19 @@ namespace flutter {
 
 // A queue that holds Skia objects that must be destructed on the given task
 // runner.
+//
+// Any thread may queue objects without taking a lock: they are pushed onto
+// a lock-free stack which the task runner takes as a whole. The task runner
+// then unrefs the taken objects, in the order they were queued, in tasks
+// that each run for at most the drain budget, so that releasing many
+// objects at once does not stall it.
 class SkiaUnrefQueue : public fml::RefCountedThreadSafe<SkiaUnrefQueue> {
  public:
+  // The default time a drain task may spend unreffing objects before it
+  // posts another task for the remaining ones.
+  static constexpr fml::TimeDelta kDefaultDrainBudget =
+      fml::TimeDelta::FromMilliseconds(2);
+
   void Unref(SkRefCnt* object);
 
   // Usually, the drain is called automatically. However, during IO manager
@@ -27,14 +39,31 @@ class SkiaUnrefQueue : public fml::RefCountedThreadSafe<SkiaUnrefQueue> {
   // to go away), we may need to pre-emptively drain the unref queue. It is the
   // responsibility of the caller to ensure that no further unrefs are queued
   // after this call.
+  //
+  // Unlike the automatic drain, this unrefs every queued object at once.
   void Drain();
 
  private:
+  struct Node {
+    SkRefCnt* object;
+    Node* next;
+  };
+
   const fml::RefPtr<fml::TaskRunner> task_runner_;
   const fml::TimeDelta drain_delay_;
-  std::mutex mutex_;
-  std::deque<SkRefCnt*> objects_;
-  bool drain_pending_;
+  const fml::TimeDelta drain_budget_;
+  // The objects queued since they were last taken, most recent first.
+  std::atomic<Node*> incoming_;
+  // The number of queued objects that are yet to be unreffed.
+  std::atomic<size_t> depth_;
+  std::atomic<bool> drain_pending_;
+  // When the first task of the pending drain was posted. Written by the
+  // thread that posts it and only read by the drain.
+  fml::TimePoint drain_posted_time_;
+  // The objects taken from |incoming_| that are yet to be unreffed, in the
+  // order they were queued. Only accessed by the drain.
+  Node* draining_;
+  bool needs_deferred_cleanup_;
   fml::WeakPtr<GrDirectContext> context_;
 
   // The `GrDirectContext* context` is only used for signaling Skia to
@@ -42,10 +71,24 @@ class SkiaUnrefQueue : public fml::RefCountedThreadSafe<SkiaUnrefQueue> {
   // (e.g., in unit tests).
   SkiaUnrefQueue(fml::RefPtr<fml::TaskRunner> task_runner,
                  fml::TimeDelta delay,
-                 fml::WeakPtr<GrDirectContext> context = {});
+                 fml::WeakPtr<GrDirectContext> context = {},
+                 fml::TimeDelta drain_budget = kDefaultDrainBudget);
 
   ~SkiaUnrefQueue();
 
+  // Posts a task that calls |DrainWithBudget| after |delay|.
+  void PostDrain(fml::TimeDelta delay);
+
+  // Unrefs queued objects for at most |drain_budget_|, posting another drain
+  // if any are left.
+  void DrainWithBudget();
+
+  // Unrefs the queued objects until there are none left or, if |deadline|
+  // is not null, until it is passed.
+  void UnrefObjects(const fml::TimePoint* deadline);
+
+  void PerformDeferredCleanup();
+
   FML_FRIEND_REF_COUNTED_THREAD_SAFE(SkiaUnrefQueue);
   FML_FRIEND_MAKE_REF_COUNTED(SkiaUnrefQueue);
   FML_DISALLOW_COPY_AND_ASSIGN(SkiaUnrefQueue);
@@ -75,8 +118,10 @@ class SkiaGPUObject {
     if (object_ && queue_) {
       queue_->Unref(object_.release());
     }
+    // The objects without a queue, like the images made while the GPU is
+    // disabled, are released right away.
+    object_ = nullptr;
     queue_ = nullptr;
-    FML_DCHECK(object_ == nullptr);
   }
 
  private:
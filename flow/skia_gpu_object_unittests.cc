@@ -4,7 +4,9 @@
 
 #include "flutter/flow/skia_gpu_object.h"
 
+#include <functional>
 #include <future>
+#include <vector>
 
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -34,6 +36,19 @@ class TestSkObject : public SkRefCnt {
   fml::TaskQueueId* dtor_task_queue_id_;
 };
 
+// Records the order in which the objects are destroyed.
+class OrderedSkObject : public SkRefCnt {
+ public:
+  OrderedSkObject(std::vector<int>* destroyed, int id)
+      : destroyed_(destroyed), id_(id) {}
+
+  ~OrderedSkObject() { destroyed_->push_back(id_); }
+
+ private:
+  std::vector<int>* destroyed_;
+  int id_;
+};
+
 class SkiaGpuObjectTest : public ThreadTest {
  public:
   SkiaGpuObjectTest()
@@ -127,5 +142,59 @@ TEST_F(SkiaGpuObjectTest, ObjectResetTwice) {
   ASSERT_EQ(dtor_task_queue_id, unref_task_runner()->GetTaskQueueId());
 }
 
+TEST_F(SkiaGpuObjectTest, QueueDrainsInOrderWithinBudget) {
+  auto queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+      unref_task_runner(), fml::TimeDelta::Zero(),
+      fml::WeakPtr<GrDirectContext>(), fml::TimeDelta::Zero());
+  std::vector<int> destroyed;
+
+  // Hold the task runner so that every object is queued before the drain.
+  fml::AutoResetWaitableEvent queued;
+  unref_task_runner()->PostTask([&queued]() { queued.Wait(); });
+  for (int i = 0; i < 64; i++) {
+    queue->Unref(new OrderedSkObject(&destroyed, i));
+  }
+  size_t destroyed_by_first_drain = 0;
+  fml::AutoResetWaitableEvent first_drain_done;
+  unref_task_runner()->PostTask([&]() {
+    destroyed_by_first_drain = destroyed.size();
+    first_drain_done.Signal();
+  });
+  queued.Signal();
+  first_drain_done.Wait();
+  // With no budget, a drain task stops at the first deadline check.
+  EXPECT_GT(destroyed_by_first_drain, 0u);
+  EXPECT_LT(destroyed_by_first_drain, 64u);
+
+  std::promise<size_t> destroyed_count;
+  std::function<void()> check_done;
+  check_done = [&]() {
+    if (destroyed.size() < 64) {
+      unref_task_runner()->PostTask(check_done);
+    } else {
+      destroyed_count.set_value(destroyed.size());
+    }
+  };
+  unref_task_runner()->PostTask(check_done);
+  ASSERT_EQ(destroyed_count.get_future().get(), 64u);
+  for (int i = 0; i < 64; i++) {
+    EXPECT_EQ(destroyed[i], i);
+  }
+}
+
+TEST_F(SkiaGpuObjectTest, ExplicitDrainUnrefsEveryObject) {
+  std::vector<int> destroyed;
+  for (int i = 0; i < 40; i++) {
+    delayed_unref_queue()->Unref(new OrderedSkObject(&destroyed, i));
+  }
+
+  std::promise<size_t> destroyed_count;
+  unref_task_runner()->PostTask([&]() {
+    delayed_unref_queue()->Drain();
+    destroyed_count.set_value(destroyed.size());
+  });
+  ASSERT_EQ(destroyed_count.get_future().get(), 40u);
+}
+
 }  // namespace testing
 }  // namespace flutter
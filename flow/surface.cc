@@ -22,4 +22,12 @@ bool Surface::AllowsDrawingWhenGpuDisabled() const {
   return true;
 }
 
+bool Surface::AllowsSkippingUnchangedFrames() const {
+  return false;
+}
+
+bool Surface::EnableGpuTiming(GpuTimeCallback callback) {
+  return false;
+}
+
 }  // namespace flutter
@@ -5,12 +5,14 @@
 #ifndef FLUTTER_FLOW_SURFACE_H_
 #define FLUTTER_FLOW_SURFACE_H_
 
+#include <functional>
 #include <memory>
 
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/surface_frame.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
 
 namespace flutter {
 
@@ -35,6 +37,20 @@ class Surface {
 
   virtual bool AllowsDrawingWhenGpuDisabled() const;
 
+  // Whether the rasterizer may skip a frame that is identical to the last
+  // one, without acquiring or presenting a frame, in which case the last
+  // presented frame must stay on screen.
+  virtual bool AllowsSkippingUnchangedFrames() const;
+
+  using GpuTimeCallback = std::function<void(fml::TimeDelta)>;
+
+  // Asks the surface to measure the time the GPU takes to execute each frame.
+  // The callback is called on the raster thread with the time of each frame,
+  // in the order they were submitted, once the GPU has executed it. That is
+  // usually a few frames after it was submitted. Returns false if the surface
+  // cannot measure it.
+  virtual bool EnableGpuTiming(GpuTimeCallback callback);
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(Surface);
 };
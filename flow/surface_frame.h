@@ -55,6 +55,14 @@ class SurfaceFrame {
                const SubmitCallback& submit_callback,
                std::unique_ptr<GLContextResult> context_result);
 
+  // Creates a frame that is drawn into |canvas| instead of the canvas of
+  // |surface|, such as a canvas that records the frame to play it back into
+  // the surface on submit. The canvas must outlive the frame.
+  SurfaceFrame(sk_sp<SkSurface> surface,
+               SkCanvas* canvas,
+               FramebufferInfo framebuffer_info,
+               const SubmitCallback& submit_callback);
+
   ~SurfaceFrame();
 
   struct SubmitInfo {
@@ -90,6 +98,7 @@ class SurfaceFrame {
  private:
   bool submitted_ = false;
   sk_sp<SkSurface> surface_;
+  SkCanvas* canvas_ = nullptr;
   FramebufferInfo framebuffer_info_;
   SubmitInfo submit_info_;
   SubmitCallback submit_callback_;
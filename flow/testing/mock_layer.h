@@ -22,6 +22,10 @@ class MockLayer : public Layer {
                      bool fake_reads_surface = false);
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
+
+  bool PrepareForConcurrentPreroll() override {
+    return !fake_has_platform_view_;
+  }
   void Paint(PaintContext& context) const override;
 
   const MutatorsStack& parent_mutators() { return parent_mutators_; }
@@ -0,0 +1,347 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/text_batching_canvas.h"
+
+#include <string>
+
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkRegion.h"
+#include "third_party/skia/include/core/SkVertices.h"
+
+namespace flutter {
+
+TextBatchingCanvas::TextBatchingCanvas(SkCanvas* canvas)
+    : SkNWayCanvas(canvas->getBaseLayerSize().width(),
+                   canvas->getBaseLayerSize().height()),
+      canvas_(canvas) {
+  addCanvas(canvas);
+  clip_changed_.push_back(false);
+}
+
+TextBatchingCanvas::~TextBatchingCanvas() {
+  FlushText();
+}
+
+void TextBatchingCanvas::FlushText() {
+  if (deferred_texts_.empty()) {
+    return;
+  }
+  TRACE_EVENT1("flutter", "TextBatchingCanvas::FlushText", "count",
+               std::to_string(deferred_texts_.size()).c_str());
+  for (const DeferredText& text : deferred_texts_) {
+    if (text.matrix == canvas_->getTotalMatrix()) {
+      canvas_->drawTextBlob(text.blob, text.x, text.y, text.paint);
+      continue;
+    }
+    canvas_->save();
+    canvas_->setMatrix(text.matrix);
+    canvas_->drawTextBlob(text.blob, text.x, text.y, text.paint);
+    canvas_->restore();
+  }
+  deferred_texts_.clear();
+  deferred_bounds_.setEmpty();
+}
+
+void TextBatchingCanvas::FlushTextOverlapping(const SkRect& bounds,
+                                              const SkPaint* paint) {
+  if (deferred_texts_.empty()) {
+    return;
+  }
+  if (paint && !paint->canComputeFastBounds()) {
+    FlushText();
+    return;
+  }
+  SkRect storage;
+  const SkRect& paint_bounds =
+      paint ? paint->computeFastBounds(bounds, &storage) : bounds;
+  SkRect device_bounds = canvas_->getTotalMatrix().mapRect(paint_bounds);
+  // Antialiased edges and hairlines reach into the pixels around the
+  // bounds.
+  device_bounds.outset(1, 1);
+  if (SkRect::Intersects(device_bounds, deferred_bounds_)) {
+    FlushText();
+  }
+}
+
+void TextBatchingCanvas::FlushTextForClip() {
+  FlushText();
+  clip_changed_.back() = true;
+}
+
+void TextBatchingCanvas::willSave() {
+  clip_changed_.push_back(false);
+  SkNWayCanvas::willSave();
+}
+
+SkCanvas::SaveLayerStrategy TextBatchingCanvas::getSaveLayerStrategy(
+    const SaveLayerRec& rec) {
+  // The text must be drawn into the surface that it was drawn into, and
+  // before the layer reads the surface back.
+  FlushText();
+  clip_changed_.push_back(true);
+  return SkNWayCanvas::getSaveLayerStrategy(rec);
+}
+
+bool TextBatchingCanvas::onDoSaveBehind(const SkRect* bounds) {
+  FlushText();
+  return SkNWayCanvas::onDoSaveBehind(bounds);
+}
+
+void TextBatchingCanvas::willRestore() {
+  if (clip_changed_.back()) {
+    FlushText();
+  }
+  if (clip_changed_.size() > 1) {
+    clip_changed_.pop_back();
+  }
+  SkNWayCanvas::willRestore();
+}
+
+void TextBatchingCanvas::onClipRect(const SkRect& rect,
+                                    SkClipOp op,
+                                    ClipEdgeStyle style) {
+  FlushTextForClip();
+  SkNWayCanvas::onClipRect(rect, op, style);
+}
+
+void TextBatchingCanvas::onClipRRect(const SkRRect& rrect,
+                                     SkClipOp op,
+                                     ClipEdgeStyle style) {
+  FlushTextForClip();
+  SkNWayCanvas::onClipRRect(rrect, op, style);
+}
+
+void TextBatchingCanvas::onClipPath(const SkPath& path,
+                                    SkClipOp op,
+                                    ClipEdgeStyle style) {
+  FlushTextForClip();
+  SkNWayCanvas::onClipPath(path, op, style);
+}
+
+void TextBatchingCanvas::onClipShader(sk_sp<SkShader> shader, SkClipOp op) {
+  FlushTextForClip();
+  SkNWayCanvas::onClipShader(std::move(shader), op);
+}
+
+void TextBatchingCanvas::onClipRegion(const SkRegion& region, SkClipOp op) {
+  FlushTextForClip();
+  SkNWayCanvas::onClipRegion(region, op);
+}
+
+void TextBatchingCanvas::onDrawTextBlob(const SkTextBlob* blob,
+                                        SkScalar x,
+                                        SkScalar y,
+                                        const SkPaint& paint) {
+  if (!paint.canComputeFastBounds()) {
+    FlushText();
+    canvas_->drawTextBlob(blob, x, y, paint);
+    return;
+  }
+  SkMatrix matrix = canvas_->getTotalMatrix();
+  SkRect storage;
+  deferred_bounds_.join(matrix.mapRect(
+      paint.computeFastBounds(blob->bounds().makeOffset(x, y), &storage)));
+  deferred_texts_.push_back({sk_ref_sp(blob), x, y, paint, matrix});
+}
+
+void TextBatchingCanvas::onDrawPaint(const SkPaint& paint) {
+  FlushText();
+  SkNWayCanvas::onDrawPaint(paint);
+}
+
+void TextBatchingCanvas::onDrawBehind(const SkPaint& paint) {
+  FlushText();
+  SkNWayCanvas::onDrawBehind(paint);
+}
+
+void TextBatchingCanvas::onDrawPoints(PointMode mode,
+                                      size_t count,
+                                      const SkPoint points[],
+                                      const SkPaint& paint) {
+  SkRect bounds;
+  bounds.setBounds(points, count);
+  // The points and lines are stroked whatever the style of the paint.
+  SkScalar radius = paint.getStrokeWidth() / 2;
+  FlushTextOverlapping(bounds.makeOutset(radius, radius), &paint);
+  SkNWayCanvas::onDrawPoints(mode, count, points, paint);
+}
+
+void TextBatchingCanvas::onDrawRect(const SkRect& rect, const SkPaint& paint) {
+  FlushTextOverlapping(rect, &paint);
+  SkNWayCanvas::onDrawRect(rect, paint);
+}
+
+void TextBatchingCanvas::onDrawRegion(const SkRegion& region,
+                                      const SkPaint& paint) {
+  FlushTextOverlapping(SkRect::Make(region.getBounds()), &paint);
+  SkNWayCanvas::onDrawRegion(region, paint);
+}
+
+void TextBatchingCanvas::onDrawOval(const SkRect& rect, const SkPaint& paint) {
+  FlushTextOverlapping(rect, &paint);
+  SkNWayCanvas::onDrawOval(rect, paint);
+}
+
+void TextBatchingCanvas::onDrawArc(const SkRect& rect,
+                                   SkScalar start_angle,
+                                   SkScalar sweep_angle,
+                                   bool use_center,
+                                   const SkPaint& paint) {
+  FlushTextOverlapping(rect, &paint);
+  SkNWayCanvas::onDrawArc(rect, start_angle, sweep_angle, use_center, paint);
+}
+
+void TextBatchingCanvas::onDrawRRect(const SkRRect& rrect,
+                                     const SkPaint& paint) {
+  FlushTextOverlapping(rrect.getBounds(), &paint);
+  SkNWayCanvas::onDrawRRect(rrect, paint);
+}
+
+void TextBatchingCanvas::onDrawDRRect(const SkRRect& outer,
+                                      const SkRRect& inner,
+                                      const SkPaint& paint) {
+  FlushTextOverlapping(outer.getBounds(), &paint);
+  SkNWayCanvas::onDrawDRRect(outer, inner, paint);
+}
+
+void TextBatchingCanvas::onDrawPath(const SkPath& path, const SkPaint& paint) {
+  if (path.isInverseFillType()) {
+    FlushText();
+  } else {
+    FlushTextOverlapping(path.getBounds(), &paint);
+  }
+  SkNWayCanvas::onDrawPath(path, paint);
+}
+
+void TextBatchingCanvas::onDrawImage2(const SkImage* image,
+                                      SkScalar x,
+                                      SkScalar y,
+                                      const SkSamplingOptions& sampling,
+                                      const SkPaint* paint) {
+  FlushTextOverlapping(
+      SkRect::MakeXYWH(x, y, image->width(), image->height()), paint);
+  SkNWayCanvas::onDrawImage2(image, x, y, sampling, paint);
+}
+
+void TextBatchingCanvas::onDrawImageRect2(const SkImage* image,
+                                          const SkRect& src,
+                                          const SkRect& dst,
+                                          const SkSamplingOptions& sampling,
+                                          const SkPaint* paint,
+                                          SrcRectConstraint constraint) {
+  FlushTextOverlapping(dst, paint);
+  SkNWayCanvas::onDrawImageRect2(image, src, dst, sampling, paint,
+                                 constraint);
+}
+
+void TextBatchingCanvas::onDrawImageLattice2(const SkImage* image,
+                                             const Lattice& lattice,
+                                             const SkRect& dst,
+                                             SkFilterMode filter,
+                                             const SkPaint* paint) {
+  FlushTextOverlapping(dst, paint);
+  SkNWayCanvas::onDrawImageLattice2(image, lattice, dst, filter, paint);
+}
+
+void TextBatchingCanvas::onDrawAtlas2(const SkImage* image,
+                                      const SkRSXform xform[],
+                                      const SkRect src[],
+                                      const SkColor colors[],
+                                      int count,
+                                      SkBlendMode mode,
+                                      const SkSamplingOptions& sampling,
+                                      const SkRect* cull,
+                                      const SkPaint* paint) {
+  if (cull) {
+    FlushTextOverlapping(*cull, paint);
+  } else {
+    FlushText();
+  }
+  SkNWayCanvas::onDrawAtlas2(image, xform, src, colors, count, mode, sampling,
+                             cull, paint);
+}
+
+void TextBatchingCanvas::onDrawVerticesObject(const SkVertices* vertices,
+                                              SkBlendMode mode,
+                                              const SkPaint& paint) {
+  FlushTextOverlapping(vertices->bounds(), &paint);
+  SkNWayCanvas::onDrawVerticesObject(vertices, mode, paint);
+}
+
+void TextBatchingCanvas::onDrawPatch(const SkPoint cubics[12],
+                                     const SkColor colors[4],
+                                     const SkPoint tex_coords[4],
+                                     SkBlendMode mode,
+                                     const SkPaint& paint) {
+  SkRect bounds;
+  bounds.setBounds(cubics, 12);
+  FlushTextOverlapping(bounds, &paint);
+  SkNWayCanvas::onDrawPatch(cubics, colors, tex_coords, mode, paint);
+}
+
+void TextBatchingCanvas::onDrawShadowRec(const SkPath& path,
+                                         const SkDrawShadowRec& rec) {
+  // The shadow spreads beyond the path by an amount that depends on the
+  // light.
+  FlushText();
+  SkNWayCanvas::onDrawShadowRec(path, rec);
+}
+
+void TextBatchingCanvas::onDrawPicture(const SkPicture* picture,
+                                       const SkMatrix* matrix,
+                                       const SkPaint* paint) {
+  SkRect bounds = picture->cullRect();
+  if (matrix) {
+    bounds = matrix->mapRect(bounds);
+  }
+  FlushTextOverlapping(bounds, paint);
+  SkNWayCanvas::onDrawPicture(picture, matrix, paint);
+}
+
+void TextBatchingCanvas::onDrawDrawable(SkDrawable* drawable,
+                                        const SkMatrix* matrix) {
+  FlushText();
+  SkNWayCanvas::onDrawDrawable(drawable, matrix);
+}
+
+void TextBatchingCanvas::onDrawAnnotation(const SkRect& rect,
+                                          const char key[],
+                                          SkData* value) {
+  FlushText();
+  SkNWayCanvas::onDrawAnnotation(rect, key, value);
+}
+
+void TextBatchingCanvas::onDrawEdgeAAQuad(const SkRect& rect,
+                                          const SkPoint clip[4],
+                                          QuadAAFlags aa_flags,
+                                          const SkColor4f& color,
+                                          SkBlendMode mode) {
+  FlushTextOverlapping(rect, nullptr);
+  SkNWayCanvas::onDrawEdgeAAQuad(rect, clip, aa_flags, color, mode);
+}
+
+void TextBatchingCanvas::onDrawEdgeAAImageSet2(
+    const ImageSetEntry set[],
+    int count,
+    const SkPoint dst_clips[],
+    const SkMatrix pre_view_matrices[],
+    const SkSamplingOptions& sampling,
+    const SkPaint* paint,
+    SrcRectConstraint constraint) {
+  FlushText();
+  SkNWayCanvas::onDrawEdgeAAImageSet2(set, count, dst_clips,
+                                      pre_view_matrices, sampling, paint,
+                                      constraint);
+}
+
+void TextBatchingCanvas::onFlush() {
+  FlushText();
+  SkNWayCanvas::onFlush();
+}
+
+}  // namespace flutter
@@ -0,0 +1,164 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_TEXT_BATCHING_CANVAS_H_
+#define FLUTTER_FLOW_TEXT_BATCHING_CANVAS_H_
+
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/utils/SkNWayCanvas.h"
+
+namespace flutter {
+
+// Forwards the draws made into it to a canvas, deferring the text so that
+// the text drawn by neighbouring layers reaches the canvas as consecutive
+// draws, which the GPU backend batches into fewer ops.
+//
+// A text draw is moved after the draws that followed it only when they do
+// not overlap it. The deferred text is drawn before any draw that may
+// overlap it, before the clip it was drawn with changes, before a save
+// layer starts or ends, and when the canvas is flushed.
+class TextBatchingCanvas : public SkNWayCanvas {
+ public:
+  explicit TextBatchingCanvas(SkCanvas* canvas);
+
+  ~TextBatchingCanvas() override;
+
+  // Draws the deferred text into the canvas.
+  void FlushText();
+
+  size_t deferred_text_count() const { return deferred_texts_.size(); }
+
+ protected:
+  void willSave() override;
+  SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec& rec) override;
+  bool onDoSaveBehind(const SkRect* bounds) override;
+  void willRestore() override;
+
+  void onClipRect(const SkRect& rect,
+                  SkClipOp op,
+                  ClipEdgeStyle style) override;
+  void onClipRRect(const SkRRect& rrect,
+                   SkClipOp op,
+                   ClipEdgeStyle style) override;
+  void onClipPath(const SkPath& path,
+                  SkClipOp op,
+                  ClipEdgeStyle style) override;
+  void onClipShader(sk_sp<SkShader> shader, SkClipOp op) override;
+  void onClipRegion(const SkRegion& region, SkClipOp op) override;
+
+  void onDrawTextBlob(const SkTextBlob* blob,
+                      SkScalar x,
+                      SkScalar y,
+                      const SkPaint& paint) override;
+
+  void onDrawPaint(const SkPaint& paint) override;
+  void onDrawBehind(const SkPaint& paint) override;
+  void onDrawPoints(PointMode mode,
+                    size_t count,
+                    const SkPoint points[],
+                    const SkPaint& paint) override;
+  void onDrawRect(const SkRect& rect, const SkPaint& paint) override;
+  void onDrawRegion(const SkRegion& region, const SkPaint& paint) override;
+  void onDrawOval(const SkRect& rect, const SkPaint& paint) override;
+  void onDrawArc(const SkRect& rect,
+                 SkScalar start_angle,
+                 SkScalar sweep_angle,
+                 bool use_center,
+                 const SkPaint& paint) override;
+  void onDrawRRect(const SkRRect& rrect, const SkPaint& paint) override;
+  void onDrawDRRect(const SkRRect& outer,
+                    const SkRRect& inner,
+                    const SkPaint& paint) override;
+  void onDrawPath(const SkPath& path, const SkPaint& paint) override;
+  void onDrawImage2(const SkImage* image,
+                    SkScalar x,
+                    SkScalar y,
+                    const SkSamplingOptions& sampling,
+                    const SkPaint* paint) override;
+  void onDrawImageRect2(const SkImage* image,
+                        const SkRect& src,
+                        const SkRect& dst,
+                        const SkSamplingOptions& sampling,
+                        const SkPaint* paint,
+                        SrcRectConstraint constraint) override;
+  void onDrawImageLattice2(const SkImage* image,
+                           const Lattice& lattice,
+                           const SkRect& dst,
+                           SkFilterMode filter,
+                           const SkPaint* paint) override;
+  void onDrawAtlas2(const SkImage* image,
+                    const SkRSXform xform[],
+                    const SkRect src[],
+                    const SkColor colors[],
+                    int count,
+                    SkBlendMode mode,
+                    const SkSamplingOptions& sampling,
+                    const SkRect* cull,
+                    const SkPaint* paint) override;
+  void onDrawVerticesObject(const SkVertices* vertices,
+                            SkBlendMode mode,
+                            const SkPaint& paint) override;
+  void onDrawPatch(const SkPoint cubics[12],
+                   const SkColor colors[4],
+                   const SkPoint tex_coords[4],
+                   SkBlendMode mode,
+                   const SkPaint& paint) override;
+  void onDrawShadowRec(const SkPath& path, const SkDrawShadowRec& rec) override;
+  void onDrawPicture(const SkPicture* picture,
+                     const SkMatrix* matrix,
+                     const SkPaint* paint) override;
+  void onDrawDrawable(SkDrawable* drawable, const SkMatrix* matrix) override;
+  void onDrawAnnotation(const SkRect& rect,
+                        const char key[],
+                        SkData* value) override;
+  void onDrawEdgeAAQuad(const SkRect& rect,
+                        const SkPoint clip[4],
+                        QuadAAFlags aa_flags,
+                        const SkColor4f& color,
+                        SkBlendMode mode) override;
+  void onDrawEdgeAAImageSet2(const ImageSetEntry set[],
+                             int count,
+                             const SkPoint dst_clips[],
+                             const SkMatrix pre_view_matrices[],
+                             const SkSamplingOptions& sampling,
+                             const SkPaint* paint,
+                             SrcRectConstraint constraint) override;
+
+  void onFlush() override;
+
+ private:
+  struct DeferredText {
+    sk_sp<SkTextBlob> blob;
+    SkScalar x;
+    SkScalar y;
+    SkPaint paint;
+    SkMatrix matrix;
+  };
+
+  // Draws the deferred text first if |bounds|, in local coordinates, may
+  // overlap it once drawn with |paint|.
+  void FlushTextOverlapping(const SkRect& bounds, const SkPaint* paint);
+
+  // Draws the deferred text first and records that the clip of the current
+  // save level changes.
+  void FlushTextForClip();
+
+  SkCanvas* canvas_;
+  std::vector<DeferredText> deferred_texts_;
+  // The union of the device bounds of the deferred text.
+  SkRect deferred_bounds_ = SkRect::MakeEmpty();
+  // Whether the clip was changed at each save level, in which case the
+  // restore of the level changes the clip back.
+  std::vector<bool> clip_changed_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TextBatchingCanvas);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_TEXT_BATCHING_CANVAS_H_
@@ -0,0 +1,126 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/text_batching_canvas.h"
+
+#include <variant>
+
+#include "flutter/testing/mock_canvas.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkFont.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// A blob of one glyph covering |bounds|.
+sk_sp<SkTextBlob> MakeBlob(const SkRect& bounds) {
+  SkTextBlobBuilder builder;
+  const auto& run = builder.allocRun(SkFont(), 1, 0, 0, &bounds);
+  run.glyphs[0] = 1;
+  return builder.make();
+}
+
+// The kinds of the draws made into |canvas|, 't' for text and 'r' for
+// rects.
+std::string GetDrawKinds(const MockCanvas& canvas) {
+  std::string kinds;
+  for (const auto& call : canvas.draw_calls()) {
+    if (std::holds_alternative<MockCanvas::DrawTextData>(call.data)) {
+      kinds += 't';
+    } else if (std::holds_alternative<MockCanvas::DrawRectData>(call.data)) {
+      kinds += 'r';
+    }
+  }
+  return kinds;
+}
+
+}  // namespace
+
+TEST(TextBatchingCanvas, TextIsDeferredPastDisjointDraws) {
+  MockCanvas mock_canvas;
+  TextBatchingCanvas canvas(&mock_canvas);
+  sk_sp<SkTextBlob> blob = MakeBlob(SkRect::MakeLTRB(0, 0, 10, 10));
+
+  canvas.drawTextBlob(blob, 0, 0, SkPaint());
+  canvas.drawRect(SkRect::MakeLTRB(40, 40, 50, 50), SkPaint());
+  canvas.drawTextBlob(blob, 0, 20, SkPaint());
+  EXPECT_EQ(canvas.deferred_text_count(), 2u);
+  EXPECT_EQ(GetDrawKinds(mock_canvas), "r");
+
+  canvas.FlushText();
+  EXPECT_EQ(canvas.deferred_text_count(), 0u);
+  EXPECT_EQ(GetDrawKinds(mock_canvas), "rtt");
+}
+
+TEST(TextBatchingCanvas, OverlappingDrawFlushesText) {
+  MockCanvas mock_canvas;
+  TextBatchingCanvas canvas(&mock_canvas);
+  sk_sp<SkTextBlob> blob = MakeBlob(SkRect::MakeLTRB(0, 0, 10, 10));
+
+  canvas.drawTextBlob(blob, 0, 0, SkPaint());
+  canvas.drawRect(SkRect::MakeLTRB(40, 40, 50, 50), SkPaint());
+  canvas.drawRect(SkRect::MakeLTRB(5, 5, 15, 15), SkPaint());
+  canvas.FlushText();
+  EXPECT_EQ(GetDrawKinds(mock_canvas), "rtr");
+}
+
+TEST(TextBatchingCanvas, OverlapIsTestedInDeviceSpace) {
+  MockCanvas mock_canvas;
+  TextBatchingCanvas canvas(&mock_canvas);
+  sk_sp<SkTextBlob> blob = MakeBlob(SkRect::MakeLTRB(0, 0, 10, 10));
+
+  canvas.save();
+  canvas.translate(40, 40);
+  canvas.drawTextBlob(blob, 0, 0, SkPaint());
+  canvas.restore();
+  canvas.drawRect(SkRect::MakeLTRB(5, 5, 15, 15), SkPaint());
+  EXPECT_EQ(canvas.deferred_text_count(), 1u);
+  canvas.drawRect(SkRect::MakeLTRB(45, 45, 55, 55), SkPaint());
+  EXPECT_EQ(canvas.deferred_text_count(), 0u);
+  EXPECT_EQ(GetDrawKinds(mock_canvas), "rtr");
+  // The text is drawn with the matrix it was drawn with.
+  EXPECT_EQ(mock_canvas.draw_calls()[5],
+            (MockCanvas::DrawCall{
+                1, MockCanvas::SetMatrixData{SkM44::Translate(40, 40)}}));
+}
+
+TEST(TextBatchingCanvas, ClipChangesFlushText) {
+  MockCanvas mock_canvas;
+  TextBatchingCanvas canvas(&mock_canvas);
+  sk_sp<SkTextBlob> blob = MakeBlob(SkRect::MakeLTRB(0, 0, 10, 10));
+
+  canvas.save();
+  canvas.drawTextBlob(blob, 0, 0, SkPaint());
+  canvas.clipRect(SkRect::MakeLTRB(0, 0, 30, 30));
+  EXPECT_EQ(canvas.deferred_text_count(), 0u);
+
+  canvas.drawTextBlob(blob, 0, 0, SkPaint());
+  canvas.restore();
+  EXPECT_EQ(canvas.deferred_text_count(), 0u);
+
+  // Restoring a level that did not change the clip keeps the text.
+  canvas.save();
+  canvas.drawTextBlob(blob, 0, 0, SkPaint());
+  canvas.restore();
+  EXPECT_EQ(canvas.deferred_text_count(), 1u);
+}
+
+TEST(TextBatchingCanvas, SaveLayerFlushesText) {
+  MockCanvas mock_canvas;
+  TextBatchingCanvas canvas(&mock_canvas);
+  sk_sp<SkTextBlob> blob = MakeBlob(SkRect::MakeLTRB(0, 0, 10, 10));
+
+  canvas.drawTextBlob(blob, 0, 0, SkPaint());
+  canvas.saveLayer(nullptr, nullptr);
+  EXPECT_EQ(canvas.deferred_text_count(), 0u);
+  canvas.drawTextBlob(blob, 0, 0, SkPaint());
+  canvas.restore();
+  EXPECT_EQ(canvas.deferred_text_count(), 0u);
+  EXPECT_EQ(GetDrawKinds(mock_canvas), "tt");
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,12 +4,56 @@
 
 #include "flutter/common/graphics/texture.h"
 
+#include <vector>
+
 #include "flutter/flow/testing/mock_texture.h"
 #include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 namespace testing {
 
+namespace {
+
+// A frame of a single color that records when it is released without
+// having been painted.
+class ColorFrame : public BufferedTextureFrame {
+ public:
+  ColorFrame(SkColor color, std::vector<SkColor>* dropped)
+      : color_(color), dropped_(dropped) {}
+
+  ~ColorFrame() override {
+    if (!painted_) {
+      dropped_->push_back(color_);
+    }
+  }
+
+  sk_sp<SkImage> MakeImage(GrDirectContext* context) override {
+    painted_ = true;
+    sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(1, 1);
+    surface->getCanvas()->clear(color_);
+    return surface->makeImageSnapshot();
+  }
+
+ private:
+  SkColor color_;
+  std::vector<SkColor>* dropped_;
+  bool painted_ = false;
+};
+
+SkColor PaintTexture(Texture& texture, bool freeze = false) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(1, 1);
+  SkCanvas canvas(bitmap);
+  canvas.clear(SK_ColorTRANSPARENT);
+  texture.Paint(canvas, SkRect::MakeWH(1, 1), freeze, nullptr,
+                SkSamplingOptions());
+  return bitmap.getColor(0, 0);
+}
+
+}  // namespace
+
 TEST(TextureRegistryTest, UnregisterTextureCallbackTriggered) {
   TextureRegistry registry;
   auto mock_texture1 = std::make_shared<MockTexture>(0);
@@ -95,5 +139,72 @@ TEST(TextureRegistryTest, ReuseSameTextureSlot) {
   ASSERT_TRUE(mock_texture2->unregistered());
 }
 
+TEST(BufferedTextureTest, PaintsNewestPushedFrame) {
+  std::vector<SkColor> dropped;
+  BufferedTexture texture(0);
+  EXPECT_EQ(PaintTexture(texture), SK_ColorTRANSPARENT);
+
+  texture.PushFrame(std::make_unique<ColorFrame>(SK_ColorRED, &dropped));
+  texture.PushFrame(std::make_unique<ColorFrame>(SK_ColorGREEN, &dropped));
+  EXPECT_EQ(texture.GetPendingFrameCount(), 2u);
+  EXPECT_EQ(PaintTexture(texture), SK_ColorGREEN);
+  EXPECT_EQ(texture.GetPendingFrameCount(), 0u);
+  EXPECT_EQ(dropped, std::vector<SkColor>{SK_ColorRED});
+
+  // The last painted frame is painted until a new frame is pushed.
+  EXPECT_EQ(PaintTexture(texture), SK_ColorGREEN);
+}
+
+TEST(BufferedTextureTest, FullQueueDropsOldestFrame) {
+  std::vector<SkColor> dropped;
+  BufferedTexture texture(0);
+  for (size_t i = 0; i <= BufferedTexture::kMaxPendingFrames; i++) {
+    texture.PushFrame(std::make_unique<ColorFrame>(i, &dropped));
+  }
+
+  EXPECT_EQ(texture.GetPendingFrameCount(), BufferedTexture::kMaxPendingFrames);
+  EXPECT_EQ(dropped, std::vector<SkColor>{0});
+}
+
+TEST(BufferedTextureTest, FrozenTextureKeepsPaintedFrame) {
+  std::vector<SkColor> dropped;
+  BufferedTexture texture(0);
+  texture.PushFrame(std::make_unique<ColorFrame>(SK_ColorRED, &dropped));
+  ASSERT_EQ(PaintTexture(texture), SK_ColorRED);
+
+  texture.PushFrame(std::make_unique<ColorFrame>(SK_ColorGREEN, &dropped));
+  EXPECT_EQ(PaintTexture(texture, true), SK_ColorRED);
+  EXPECT_EQ(texture.GetPendingFrameCount(), 1u);
+  EXPECT_EQ(PaintTexture(texture), SK_ColorGREEN);
+}
+
+TEST(BufferedTextureTest, UnregisteredTextureDropsFrames) {
+  std::vector<SkColor> dropped;
+  TextureRegistry registry;
+  auto texture = std::make_shared<BufferedTexture>(0);
+  registry.RegisterTexture(texture);
+  texture->PushFrame(std::make_unique<ColorFrame>(SK_ColorRED, &dropped));
+
+  registry.UnregisterTexture(0);
+
+  EXPECT_EQ(texture->GetPendingFrameCount(), 0u);
+  EXPECT_EQ(dropped, std::vector<SkColor>{SK_ColorRED});
+  EXPECT_EQ(PaintTexture(*texture), SK_ColorTRANSPARENT);
+}
+
+TEST(BufferedTextureTest, RegistryReportsMemoryOfPaintedFrames) {
+  std::vector<SkColor> dropped;
+  TextureRegistry registry;
+  auto texture = std::make_shared<BufferedTexture>(0);
+  registry.RegisterTexture(texture);
+  registry.RegisterTexture(std::make_shared<MockTexture>(1));
+  texture->PushFrame(std::make_unique<ColorFrame>(SK_ColorRED, &dropped));
+  EXPECT_EQ(registry.GetMemoryBytes(), 0u);
+
+  PaintTexture(*texture);
+  // The 1x1 N32 image of the frame.
+  EXPECT_EQ(registry.GetMemoryBytes(), 4u);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -0,0 +1,135 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/allocation_tracker.h"
+
+#if FLUTTER_TRACK_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+#endif  // FLUTTER_TRACK_ALLOCATIONS
+
+namespace fml {
+namespace tracing {
+
+#if FLUTTER_TRACK_ALLOCATIONS
+
+// Trivially constructed, so that the first allocation of a thread does not
+// itself allocate to initialize the counts.
+static thread_local AllocationCounts tls_allocation_counts;
+
+AllocationCounts GetThreadAllocationCounts() {
+  return tls_allocation_counts;
+}
+
+static void* Allocate(std::size_t size) {
+  tls_allocation_counts.count++;
+  tls_allocation_counts.bytes += size;
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+static void* AllocateAligned(std::size_t size, std::align_val_t alignment) {
+  tls_allocation_counts.count++;
+  tls_allocation_counts.bytes += size;
+  auto align = static_cast<std::size_t>(alignment);
+  if (align < sizeof(void*)) {
+    align = sizeof(void*);
+  }
+#if defined(_WIN32)
+  return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+  void* pointer = nullptr;
+  if (posix_memalign(&pointer, align, size == 0 ? 1 : size) != 0) {
+    return nullptr;
+  }
+  return pointer;
+#endif
+}
+
+static void FreeAligned(void* pointer) {
+#if defined(_WIN32)
+  _aligned_free(pointer);
+#else
+  std::free(pointer);
+#endif
+}
+
+#else  // FLUTTER_TRACK_ALLOCATIONS
+
+AllocationCounts GetThreadAllocationCounts() {
+  return {};
+}
+
+#endif  // FLUTTER_TRACK_ALLOCATIONS
+
+}  // namespace tracing
+}  // namespace fml
+
+#if FLUTTER_TRACK_ALLOCATIONS
+
+void* operator new(std::size_t size) {
+  void* pointer = fml::tracing::Allocate(size);
+  if (!pointer) {
+    // The engine is built without exceptions.
+    std::abort();
+  }
+  return pointer;
+}
+
+void* operator new[](std::size_t size) {
+  return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return fml::tracing::Allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return fml::tracing::Allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  void* pointer = fml::tracing::AllocateAligned(size, alignment);
+  if (!pointer) {
+    std::abort();
+  }
+  return pointer;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return operator new(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+  fml::tracing::FreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+  fml::tracing::FreeAligned(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+  fml::tracing::FreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+  fml::tracing::FreeAligned(pointer);
+}
+
+#endif  // FLUTTER_TRACK_ALLOCATIONS
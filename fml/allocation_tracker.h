@@ -0,0 +1,47 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_ALLOCATION_TRACKER_H_
+#define FLUTTER_FML_ALLOCATION_TRACKER_H_
+
+#include <cstdint>
+
+#if !defined(FLUTTER_TRACK_ALLOCATIONS)
+#define FLUTTER_TRACK_ALLOCATIONS 0
+#endif
+
+namespace fml {
+namespace tracing {
+
+/// The number and total size of the heap allocations made by a thread.
+struct AllocationCounts {
+  uint64_t count = 0;
+  uint64_t bytes = 0;
+
+  AllocationCounts operator-(const AllocationCounts& other) const {
+    return {count - other.count, bytes - other.bytes};
+  }
+};
+
+/// Whether the build counts heap allocations, which it does when it is
+/// configured with `flutter_track_allocations = true`.
+///
+/// The count includes every allocation made through the global operator new,
+/// which the engine replaces in those builds. Allocations made directly with
+/// malloc, such as the ones of the Dart VM, are not counted.
+constexpr bool IsAllocationTrackingEnabled() {
+  return FLUTTER_TRACK_ALLOCATIONS;
+}
+
+/// Returns the allocations made by the calling thread since it started, or
+/// zero counts if the build does not count allocations.
+///
+/// Subtracting the counts at the start of a piece of work from the counts at
+/// its end gives the allocations that the work made on the thread.
+AllocationCounts GetThreadAllocationCounts();
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_ALLOCATION_TRACKER_H_
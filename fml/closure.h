@@ -8,11 +8,15 @@
 #include <functional>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/unique_function.h"
 
 namespace fml {
 
 using closure = std::function<void()>;
 
+/// A move-only closure, which tasks are posted and queued as.
+using UniqueClosure = UniqueFunction<void()>;
+
 //------------------------------------------------------------------------------
 /// @brief      Wraps a closure that is invoked in the destructor unless
 ///             released by the caller.
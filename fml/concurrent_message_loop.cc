@@ -7,10 +7,27 @@
 #include <algorithm>
 
 #include "flutter/fml/thread.h"
+#include "flutter/fml/thread_local.h"
 #include "flutter/fml/trace_event.h"
 
 namespace fml {
 
+namespace {
+
+// The worker of a concurrent message loop that runs on the current thread.
+struct WorkerIdentity {
+  const ConcurrentMessageLoop* loop;
+  size_t index;
+};
+
+// The most rounds of yields an idle worker spins for before it sleeps. The
+// number of yields doubles in each round.
+constexpr size_t kMaxSpinRounds = 6;
+
+}  // namespace
+
+FML_THREAD_LOCAL ThreadLocalUniquePtr<WorkerIdentity> tls_worker_identity;
+
 std::shared_ptr<ConcurrentMessageLoop> ConcurrentMessageLoop::Create(
     size_t worker_count) {
   return std::shared_ptr<ConcurrentMessageLoop>{
@@ -19,17 +36,16 @@ std::shared_ptr<ConcurrentMessageLoop> ConcurrentMessageLoop::Create(
 
 ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
     : worker_count_(std::max<size_t>(worker_count, 1ul)) {
+  for (size_t i = 0; i < worker_count_; ++i) {
+    queues_.emplace_back(std::make_unique<WorkerQueue>());
+  }
   for (size_t i = 0; i < worker_count_; ++i) {
     workers_.emplace_back([i, this]() {
       fml::Thread::SetCurrentThreadName(fml::Thread::ThreadConfig(
           std::string{"io.worker." + std::to_string(i + 1)}));
-      WorkerMain();
+      WorkerMain(i);
     });
   }
-
-  for (const auto& worker : workers_) {
-    worker_thread_ids_.emplace_back(worker.get_id());
-  }
 }
 
 ConcurrentMessageLoop::~ConcurrentMessageLoop() {
@@ -47,80 +63,167 @@ std::shared_ptr<ConcurrentTaskRunner> ConcurrentMessageLoop::GetTaskRunner() {
   return std::make_shared<ConcurrentTaskRunner>(weak_from_this());
 }
 
-void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
+void ConcurrentMessageLoop::PostTask(fml::UniqueClosure task,
+                                     ConcurrentTaskPriority priority,
+                                     fml::TimePoint deadline) {
   if (!task) {
     return;
   }
 
-  std::unique_lock lock(tasks_mutex_);
-
   // Don't just drop tasks on the floor in case of shutdown.
   if (shutdown_) {
     FML_DLOG(WARNING)
         << "Tried to post a task to shutdown concurrent message "
            "loop. The task will be executed on the callers thread.";
-    lock.unlock();
     task();
     return;
   }
 
-  tasks_.push(task);
+  // The tasks posted from a worker stay on that worker unless another one
+  // runs out of tasks, which keeps the tasks that fan out where their data
+  // is.
+  size_t index;
+  const WorkerIdentity* worker = tls_worker_identity.get();
+  if (worker != nullptr && worker->loop == this) {
+    index = worker->index;
+  } else {
+    index = next_queue_.fetch_add(1) % worker_count_;
+  }
 
-  // Unlock the mutex before notifying the condition variable because that mutex
-  // has to be acquired on the other thread anyway. Waiting in this scope till
-  // it is acquired there is a pessimization.
-  lock.unlock();
+  // Counted before it is pushed so that the count never goes below the
+  // number of tasks in the deques.
+  pending_task_count_++;
+  const bool has_deadline = priority != ConcurrentTaskPriority::kUserBlocking &&
+                            deadline != fml::TimePoint::Max();
+  if (has_deadline) {
+    deadline_task_count_++;
+  }
+  WorkerQueue& queue = *queues_[index];
+  {
+    std::scoped_lock lock(queue.mutex);
+    queue.tasks[static_cast<size_t>(priority)].push_back(
+        {std::move(task), has_deadline ? deadline : fml::TimePoint::Max()});
+  }
 
-  tasks_condition_.notify_one();
+  // A sleeping worker either sees the pending task before it sleeps, or
+  // counts itself as sleeping before the count is read here.
+  if (sleeping_worker_count_ > 0) {
+    { std::scoped_lock lock(sleep_mutex_); }
+    sleep_condition_.notify_one();
+  }
 }
 
-void ConcurrentMessageLoop::WorkerMain() {
-  while (true) {
-    std::unique_lock lock(tasks_mutex_);
-    tasks_condition_.wait(lock, [&]() {
-      return tasks_.size() > 0 || shutdown_ || HasThreadTasksLocked();
-    });
-
-    // Shutdown cannot be read with the task mutex unlocked.
-    bool shutdown_now = shutdown_;
-    fml::closure task;
-    std::vector<fml::closure> thread_tasks;
-
-    if (tasks_.size() != 0) {
-      task = tasks_.front();
-      tasks_.pop();
+fml::UniqueClosure ConcurrentMessageLoop::TakeTask(size_t index) {
+  auto take = [this](std::deque<Task>& tasks, bool newest) {
+    Task task;
+    if (newest) {
+      task = std::move(tasks.back());
+      tasks.pop_back();
+    } else {
+      task = std::move(tasks.front());
+      tasks.pop_front();
+    }
+    pending_task_count_--;
+    if (task.deadline != fml::TimePoint::Max()) {
+      deadline_task_count_--;
     }
+    return std::move(task.closure);
+  };
+
+  // The tasks of the highest priority never have a deadline, as nothing
+  // runs ahead of them anyway.
+  const fml::TimePoint now = deadline_task_count_ > 0 ? fml::TimePoint::Now()
+                                                      : fml::TimePoint::Min();
+  for (size_t i = 0; deadline_task_count_ > 0 && i < worker_count_; ++i) {
+    WorkerQueue& queue = *queues_[(index + i) % worker_count_];
+    std::scoped_lock lock(queue.mutex);
+    for (size_t priority = 1; priority < kPriorityCount; ++priority) {
+      std::deque<Task>& tasks = queue.tasks[priority];
+      if (!tasks.empty() && tasks.front().deadline <= now) {
+        return take(tasks, false);
+      }
+    }
+  }
 
-    if (HasThreadTasksLocked()) {
-      thread_tasks = GetThreadTasksLocked();
-      FML_DCHECK(!HasThreadTasksLocked());
+  for (size_t priority = 0; priority < kPriorityCount; ++priority) {
+    for (size_t i = 0; i < worker_count_; ++i) {
+      WorkerQueue& queue = *queues_[(index + i) % worker_count_];
+      std::scoped_lock lock(queue.mutex);
+      std::deque<Task>& tasks = queue.tasks[priority];
+      if (!tasks.empty()) {
+        return take(tasks, i == 0);
+      }
     }
+  }
+  return nullptr;
+}
 
-    // Don't hold onto the mutex while tasks are being executed as they could
-    // themselves try to post more tasks to the message loop.
-    lock.unlock();
+std::vector<fml::closure> ConcurrentMessageLoop::TakeThreadTasks(
+    size_t index) {
+  std::vector<fml::closure> thread_tasks;
+  WorkerQueue& queue = *queues_[index];
+  if (!queue.has_thread_tasks) {
+    return thread_tasks;
+  }
+  std::scoped_lock lock(queue.mutex);
+  std::swap(thread_tasks, queue.thread_tasks);
+  queue.has_thread_tasks = false;
+  return thread_tasks;
+}
 
-    TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
-    // Execute the primary task we woke up for.
-    if (task) {
-      task();
+void ConcurrentMessageLoop::WaitForTasks(size_t index) {
+  const WorkerQueue& queue = *queues_[index];
+  auto has_tasks = [&]() {
+    return pending_task_count_ > 0 || shutdown_ || queue.has_thread_tasks;
+  };
+
+  // Waking up a sleeping worker costs more than spinning for a little while
+  // when the tasks come in bursts.
+  for (size_t round = 0; round < kMaxSpinRounds; ++round) {
+    for (size_t i = 0; i < (1u << round); ++i) {
+      std::this_thread::yield();
+    }
+    if (has_tasks()) {
+      return;
     }
+  }
 
+  std::unique_lock lock(sleep_mutex_);
+  sleeping_worker_count_++;
+  sleep_condition_.wait(lock, has_tasks);
+  sleeping_worker_count_--;
+  lock.unlock();
+  TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
+}
+
+void ConcurrentMessageLoop::WorkerMain(size_t index) {
+  tls_worker_identity.reset(new WorkerIdentity{this, index});
+  while (true) {
     // Execute any thread tasks.
-    for (const auto& thread_task : thread_tasks) {
+    for (const auto& thread_task : TakeThreadTasks(index)) {
       thread_task();
     }
 
-    if (shutdown_now) {
+    if (shutdown_) {
       break;
     }
+
+    if (fml::UniqueClosure task = TakeTask(index)) {
+      task();
+      continue;
+    }
+
+    WaitForTasks(index);
   }
+  tls_worker_identity.reset(nullptr);
 }
 
 void ConcurrentMessageLoop::Terminate() {
-  std::scoped_lock lock(tasks_mutex_);
-  shutdown_ = true;
-  tasks_condition_.notify_all();
+  {
+    std::scoped_lock lock(sleep_mutex_);
+    shutdown_ = true;
+  }
+  sleep_condition_.notify_all();
 }
 
 void ConcurrentMessageLoop::PostTaskToAllWorkers(fml::closure task) {
@@ -128,24 +231,13 @@ void ConcurrentMessageLoop::PostTaskToAllWorkers(fml::closure task) {
     return;
   }
 
-  std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    thread_tasks_[worker_thread_id].emplace_back(task);
+  for (const auto& queue : queues_) {
+    std::scoped_lock lock(queue->mutex);
+    queue->thread_tasks.emplace_back(task);
+    queue->has_thread_tasks = true;
   }
-  tasks_condition_.notify_all();
-}
-
-bool ConcurrentMessageLoop::HasThreadTasksLocked() const {
-  return thread_tasks_.count(std::this_thread::get_id()) > 0;
-}
-
-std::vector<fml::closure> ConcurrentMessageLoop::GetThreadTasksLocked() {
-  auto found = thread_tasks_.find(std::this_thread::get_id());
-  FML_DCHECK(found != thread_tasks_.end());
-  std::vector<fml::closure> pending_tasks;
-  std::swap(pending_tasks, found->second);
-  thread_tasks_.erase(found);
-  return pending_tasks;
+  { std::scoped_lock lock(sleep_mutex_); }
+  sleep_condition_.notify_all();
 }
 
 ConcurrentTaskRunner::ConcurrentTaskRunner(
@@ -154,13 +246,19 @@ ConcurrentTaskRunner::ConcurrentTaskRunner(
 
 ConcurrentTaskRunner::~ConcurrentTaskRunner() = default;
 
-void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
+void ConcurrentTaskRunner::PostTask(fml::UniqueClosure task) {
+  PostTask(std::move(task), ConcurrentTaskPriority::kNextFrame);
+}
+
+void ConcurrentTaskRunner::PostTask(fml::UniqueClosure task,
+                                    ConcurrentTaskPriority priority,
+                                    fml::TimePoint deadline) {
   if (!task) {
     return;
   }
 
   if (auto loop = weak_loop_.lock()) {
-    loop->PostTask(task);
+    loop->PostTask(std::move(task), priority, deadline);
     return;
   }
 
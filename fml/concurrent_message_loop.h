@@ -5,19 +5,49 @@
 #ifndef FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 #define FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 
+#include <atomic>
 #include <condition_variable>
-#include <map>
-#include <queue>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_point.h"
 
 namespace fml {
 
 class ConcurrentTaskRunner;
 
+/// The classes of the tasks of a |ConcurrentMessageLoop|. The workers run
+/// the tasks of a class before those of the classes that follow it.
+enum class ConcurrentTaskPriority {
+  /// Tasks that the user is waiting on, like the decodes of images.
+  kUserBlocking,
+  /// Tasks that the next frame needs, like the compiles of shaders. This is
+  /// the class of the tasks posted without one.
+  kNextFrame,
+  /// Tasks that nothing waits on, like the writes to caches.
+  kBackground,
+};
+
+/// A pool of worker threads that schedules its tasks by work stealing.
+///
+/// Each worker has its own deque of tasks. A task posted from a worker is
+/// pushed to the deque of that worker, and a task posted from any other
+/// thread is pushed to the deques of the workers in turn. A worker runs the
+/// most recently pushed task of its own deque, and once that is empty it
+/// steals the oldest task of the deque of another worker. An idle worker
+/// spins for a little while, backing off, before it goes to sleep. This
+/// keeps the threads that post tasks from all contending on one lock.
+///
+/// Each worker has one deque per |ConcurrentTaskPriority|, and a task is
+/// only taken once there is no task of a higher priority to pop or steal. A
+/// task whose deadline has passed is taken ahead of the tasks of higher
+/// priorities once it is the oldest task of its deque.
 class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
@@ -37,24 +67,57 @@ class ConcurrentMessageLoop
  private:
   friend ConcurrentTaskRunner;
 
+  static constexpr size_t kPriorityCount = 3;
+
+  struct Task {
+    fml::UniqueClosure closure;
+    fml::TimePoint deadline;
+  };
+
+  struct WorkerQueue {
+    std::mutex mutex;
+    // The tasks of each |ConcurrentTaskPriority|.
+    std::deque<Task> tasks[kPriorityCount];
+    // The tasks that must run on this worker, posted by
+    // |PostTaskToAllWorkers|.
+    std::vector<fml::closure> thread_tasks;
+    std::atomic_bool has_thread_tasks = false;
+  };
+
   size_t worker_count_ = 0;
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
   std::vector<std::thread> workers_;
-  std::mutex tasks_mutex_;
-  std::condition_variable tasks_condition_;
-  std::queue<fml::closure> tasks_;
-  std::vector<std::thread::id> worker_thread_ids_;
-  std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
-  bool shutdown_ = false;
+  // The queue of the next task that is posted from outside of the workers.
+  std::atomic_size_t next_queue_ = 0;
+  // The tasks in the deques of all of the workers.
+  std::atomic_size_t pending_task_count_ = 0;
+  // The tasks in the deques that have a deadline and may become overdue.
+  std::atomic_size_t deadline_task_count_ = 0;
+  std::atomic_size_t sleeping_worker_count_ = 0;
+  std::atomic_bool shutdown_ = false;
+  // Guards the sleep of the idle workers, and the notifications that wake
+  // them up.
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_condition_;
 
   explicit ConcurrentMessageLoop(size_t worker_count);
 
-  void WorkerMain();
+  void WorkerMain(size_t index);
+
+  void PostTask(fml::UniqueClosure task,
+                ConcurrentTaskPriority priority,
+                fml::TimePoint deadline);
 
-  void PostTask(const fml::closure& task);
+  // Takes the overdue task of any worker, or else pops the most recent task
+  // of the worker |index| or steals the oldest task of another worker, in
+  // the order of their priorities. Returns null if there is none.
+  fml::UniqueClosure TakeTask(size_t index);
 
-  bool HasThreadTasksLocked() const;
+  std::vector<fml::closure> TakeThreadTasks(size_t index);
 
-  std::vector<fml::closure> GetThreadTasksLocked();
+  // Returns once there are tasks for the worker |index|, or the loop is
+  // shutting down.
+  void WaitForTasks(size_t index);
 
   FML_DISALLOW_COPY_AND_ASSIGN(ConcurrentMessageLoop);
 };
@@ -65,7 +128,14 @@ class ConcurrentTaskRunner : public BasicTaskRunner {
 
   virtual ~ConcurrentTaskRunner();
 
-  void PostTask(const fml::closure& task) override;
+  // Posts |task| as a |ConcurrentTaskPriority::kNextFrame| task.
+  void PostTask(fml::UniqueClosure task) override;
+
+  // Posts |task| with |priority|. Once |deadline| has passed, the task is
+  // run ahead of the tasks of higher priorities.
+  void PostTask(fml::UniqueClosure task,
+                ConcurrentTaskPriority priority,
+                fml::TimePoint deadline = fml::TimePoint::Max());
 
  private:
   friend ConcurrentMessageLoop;
@@ -0,0 +1,65 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/concurrent_message_loop.h"
+
+#include <thread>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+
+namespace fml {
+namespace benchmarking {
+
+static void BM_PostTasksFromManyThreads(  // NOLINT
+    benchmark::State& state) {
+  auto loop = ConcurrentMessageLoop::Create(4);
+  auto task_runner = loop->GetTaskRunner();
+  const int num_threads = 8;
+  const int num_tasks_per_thread = 1000;
+
+  while (state.KeepRunning()) {
+    CountDownLatch tasks_done(num_threads * num_tasks_per_thread);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; i++) {
+      threads.emplace_back([&task_runner, &tasks_done]() {
+        for (int j = 0; j < num_tasks_per_thread; j++) {
+          task_runner->PostTask([&tasks_done]() { tasks_done.CountDown(); });
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    tasks_done.Wait();
+  }
+}
+
+static void BM_PostTasksFromWorkers(benchmark::State& state) {  // NOLINT
+  auto loop = ConcurrentMessageLoop::Create(4);
+  auto task_runner = loop->GetTaskRunner();
+  const int num_roots = 16;
+  const int num_tasks_per_root = 500;
+
+  while (state.KeepRunning()) {
+    CountDownLatch tasks_done(num_roots * num_tasks_per_root);
+    for (int i = 0; i < num_roots; i++) {
+      // Each task fans out into more tasks, like the decodes of the frames
+      // of an image.
+      task_runner->PostTask([&task_runner, &tasks_done]() {
+        for (int j = 0; j < num_tasks_per_root; j++) {
+          task_runner->PostTask([&tasks_done]() { tasks_done.CountDown(); });
+        }
+      });
+    }
+    tasks_done.Wait();
+  }
+}
+
+BENCHMARK(BM_PostTasksFromManyThreads);
+BENCHMARK(BM_PostTasksFromWorkers);
+
+}  // namespace benchmarking
+}  // namespace fml
@@ -0,0 +1,171 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/cpu_affinity.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/logging.h"
+
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+#include <sched.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#elif defined(FML_OS_MACOSX)
+#include <pthread.h>
+#include <pthread/qos.h>
+#elif defined(FML_OS_WIN)
+#include <windows.h>
+#endif
+
+namespace fml {
+
+namespace {
+
+constexpr size_t kMaxCpuCount = 64;
+
+size_t GetCpuCount() {
+  return std::clamp<size_t>(std::thread::hardware_concurrency(), 1,
+                            kMaxCpuCount);
+}
+
+uint64_t GetAllCpusMask() {
+  const size_t count = GetCpuCount();
+  return count == kMaxCpuCount ? ~uint64_t{0} : (uint64_t{1} << count) - 1;
+}
+
+struct CpuMasks {
+  uint64_t any = 0;
+  uint64_t performance = 0;
+  uint64_t efficiency = 0;
+};
+
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+
+// Classifies the cores by their maximum frequency. The cores are all treated
+// as the same kind when the frequencies cannot be read, like in some
+// containers and emulators.
+CpuMasks ReadCpuMasks() {
+  CpuMasks masks;
+  masks.any = GetAllCpusMask();
+  masks.performance = masks.any;
+  masks.efficiency = masks.any;
+
+  std::vector<int64_t> frequencies;
+  for (size_t cpu = 0; cpu < GetCpuCount(); cpu++) {
+    std::ifstream stream("/sys/devices/system/cpu/cpu" + std::to_string(cpu) +
+                         "/cpufreq/cpuinfo_max_freq");
+    int64_t frequency = 0;
+    if (!(stream >> frequency) || frequency <= 0) {
+      return masks;
+    }
+    frequencies.push_back(frequency);
+  }
+
+  const auto [min, max] =
+      std::minmax_element(frequencies.begin(), frequencies.end());
+  const int64_t min_frequency = *min;
+  const int64_t max_frequency = *max;
+  masks.performance = 0;
+  masks.efficiency = 0;
+  for (size_t cpu = 0; cpu < frequencies.size(); cpu++) {
+    if (frequencies[cpu] == max_frequency) {
+      masks.performance |= uint64_t{1} << cpu;
+    }
+    if (frequencies[cpu] == min_frequency) {
+      masks.efficiency |= uint64_t{1} << cpu;
+    }
+  }
+  return masks;
+}
+
+#else
+
+// The kinds of the cores are not known on the other platforms.
+CpuMasks ReadCpuMasks() {
+  CpuMasks masks;
+  masks.any = GetAllCpusMask();
+  return masks;
+}
+
+#endif
+
+const CpuMasks& GetCpuMasks() {
+  static const CpuMasks masks = ReadCpuMasks();
+  return masks;
+}
+
+}  // namespace
+
+uint64_t GetCpuMask(CpuAffinity affinity) {
+  const CpuMasks& masks = GetCpuMasks();
+  switch (affinity) {
+    case CpuAffinity::kAny:
+      return masks.any;
+    case CpuAffinity::kPerformance:
+      return masks.performance;
+    case CpuAffinity::kEfficiency:
+      return masks.efficiency;
+  }
+  return 0;
+}
+
+bool SetCurrentThreadCpuMask(uint64_t mask) {
+  if (mask == 0) {
+    return false;
+  }
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (size_t cpu = 0; cpu < kMaxCpuCount; cpu++) {
+    if (mask & (uint64_t{1} << cpu)) {
+      CPU_SET(cpu, &set);
+    }
+  }
+  // A pid of zero is the calling thread.
+  if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+    FML_DLOG(WARNING) << "Could not set the CPU mask of the thread.";
+    return false;
+  }
+  return true;
+#elif defined(FML_OS_WIN)
+  DWORD cpu = 0;
+  while ((mask & (uint64_t{1} << cpu)) == 0) {
+    cpu++;
+  }
+  return SetThreadIdealProcessor(GetCurrentThread(), cpu) != (DWORD)-1;
+#else
+  return false;
+#endif
+}
+
+bool RequestAffinity(CpuAffinity affinity) {
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+  return SetCurrentThreadCpuMask(GetCpuMask(affinity));
+#elif defined(FML_OS_MACOSX)
+  // Darwin does not let threads pick their cores, but it schedules the
+  // threads of the higher classes on the performance cores.
+  qos_class_t qos_class = QOS_CLASS_DEFAULT;
+  switch (affinity) {
+    case CpuAffinity::kAny:
+      qos_class = QOS_CLASS_DEFAULT;
+      break;
+    case CpuAffinity::kPerformance:
+      qos_class = QOS_CLASS_USER_INTERACTIVE;
+      break;
+    case CpuAffinity::kEfficiency:
+      qos_class = QOS_CLASS_UTILITY;
+      break;
+  }
+  return pthread_set_qos_class_self_np(qos_class, 0) == 0;
+#else
+  // There is nothing to release, but the kinds of the cores are unknown.
+  return affinity == CpuAffinity::kAny;
+#endif
+}
+
+}  // namespace fml
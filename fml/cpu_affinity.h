@@ -0,0 +1,52 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_CPU_AFFINITY_H_
+#define FLUTTER_FML_CPU_AFFINITY_H_
+
+#include <cstdint>
+
+namespace fml {
+
+/// The kind of CPU cores a thread prefers to run on. On devices with cores of
+/// a single kind, all of the cores are both performance and efficiency cores.
+enum class CpuAffinity {
+  /// Any core, as decided by the scheduler.
+  kAny,
+  /// The fastest cores of the device.
+  kPerformance,
+  /// The slowest, most power efficient cores of the device.
+  kEfficiency,
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Returns the CPUs of the given kind, one bit per CPU, or zero if
+///             the kinds of the cores cannot be told apart on this platform.
+///             Only the first 64 CPUs are considered.
+///
+uint64_t GetCpuMask(CpuAffinity affinity);
+
+//------------------------------------------------------------------------------
+/// @brief      Restricts the current thread to the CPUs of the mask, with one
+///             bit per CPU. On Windows, where masks are a hint, the thread
+///             prefers the first CPU of the mask instead.
+///
+/// @return     Whether the mask was applied. This fails on platforms that
+///             have no thread affinity, like Darwin and Fuchsia.
+///
+bool SetCurrentThreadCpuMask(uint64_t mask);
+
+//------------------------------------------------------------------------------
+/// @brief      Asks for the current thread to run on cores of the given kind.
+///             This uses the affinity masks where cores can be classified and
+///             the quality of service classes on Darwin, where they cannot.
+///             Asking for |CpuAffinity::kAny| releases an earlier request.
+///
+/// @return     Whether the request was applied.
+///
+bool RequestAffinity(CpuAffinity affinity);
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_CPU_AFFINITY_H_
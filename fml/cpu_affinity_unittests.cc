@@ -0,0 +1,57 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/cpu_affinity.h"
+
+#include <thread>
+
+#include "flutter/fml/build_config.h"
+#include "gtest/gtest.h"
+
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+#include <sched.h>
+#endif
+
+namespace fml {
+namespace testing {
+
+TEST(CpuAffinityTest, KindsOfCoresAreAmongAllOfTheCores) {
+  const uint64_t any = GetCpuMask(CpuAffinity::kAny);
+  ASSERT_NE(any, 0u);
+  EXPECT_EQ(GetCpuMask(CpuAffinity::kPerformance) & ~any, 0u);
+  EXPECT_EQ(GetCpuMask(CpuAffinity::kEfficiency) & ~any, 0u);
+}
+
+TEST(CpuAffinityTest, ReleasingTheAffinitySucceeds) {
+  std::thread thread([] { EXPECT_TRUE(RequestAffinity(CpuAffinity::kAny)); });
+  thread.join();
+}
+
+TEST(CpuAffinityTest, EmptyMaskIsRejected) {
+  EXPECT_FALSE(SetCurrentThreadCpuMask(0));
+}
+
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+TEST(CpuAffinityTest, ThreadIsPinnedToTheCoresOfItsKind) {
+  std::thread thread([] {
+    ASSERT_TRUE(RequestAffinity(CpuAffinity::kPerformance));
+    cpu_set_t set;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(set), &set), 0);
+    const uint64_t performance = GetCpuMask(CpuAffinity::kPerformance);
+    for (int cpu = 0; cpu < 64; cpu++) {
+      EXPECT_EQ(CPU_ISSET(cpu, &set) != 0,
+                (performance & (uint64_t{1} << cpu)) != 0);
+    }
+
+    ASSERT_TRUE(SetCurrentThreadCpuMask(1));
+    ASSERT_EQ(sched_getaffinity(0, sizeof(set), &set), 0);
+    EXPECT_EQ(CPU_COUNT(&set), 1);
+    EXPECT_TRUE(CPU_ISSET(0, &set));
+  });
+  thread.join();
+}
+#endif
+
+}  // namespace testing
+}  // namespace fml
@@ -0,0 +1,140 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include "flutter/fml/delayed_task_wheel.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "flutter/fml/logging.h"
+
+namespace fml {
+
+// 2^20 nanoseconds, about a millisecond.
+static constexpr int kTickShift = 20;
+
+DelayedTaskWheel::DelayedTaskWheel() = default;
+
+DelayedTaskWheel::~DelayedTaskWheel() = default;
+
+uint64_t DelayedTaskWheel::GetTick(fml::TimePoint target_time) {
+  // Flipping the sign bit keeps the order of the negative times.
+  const uint64_t nanos =
+      static_cast<uint64_t>(target_time.ToEpochDelta().ToNanoseconds()) ^
+      (uint64_t{1} << 63);
+  return nanos >> kTickShift;
+}
+
+void DelayedTaskWheel::Push(DelayedTask task) {
+  const uint64_t tick = GetTick(task.GetTargetTime());
+  if (size_ == 0) {
+    cursor_ = tick;
+  }
+  size_++;
+  if (tick <= cursor_) {
+    due_.push_back(std::move(task));
+    std::push_heap(due_.begin(), due_.end(), std::greater<DelayedTask>());
+    return;
+  }
+  Place(tick, std::move(task));
+  if (due_.empty()) {
+    Advance();
+  }
+}
+
+const DelayedTask& DelayedTaskWheel::Top() const {
+  FML_DCHECK(!due_.empty());
+  return due_.front();
+}
+
+DelayedTask DelayedTaskWheel::Pop() {
+  FML_DCHECK(!due_.empty());
+  std::pop_heap(due_.begin(), due_.end(), std::greater<DelayedTask>());
+  DelayedTask task = std::move(due_.back());
+  due_.pop_back();
+  size_--;
+  if (due_.empty() && size_ > 0) {
+    Advance();
+  }
+  return task;
+}
+
+void DelayedTaskWheel::Clear() {
+  due_.clear();
+  for (auto& level : slots_) {
+    for (auto& slot : level) {
+      slot.clear();
+    }
+  }
+  occupied_slots_ = {};
+  overflow_.clear();
+  size_ = 0;
+}
+
+void DelayedTaskWheel::Place(uint64_t tick, DelayedTask task) {
+  FML_DCHECK(tick > cursor_);
+  // The task goes to the level of the highest slot digit in which its tick
+  // differs from the cursor.
+  const size_t level = (63 - __builtin_clzll(tick ^ cursor_)) / kSlotBits;
+  if (level >= kLevelCount) {
+    overflow_.push_back(std::move(task));
+    return;
+  }
+  const size_t slot = (tick >> (level * kSlotBits)) & (kSlotCount - 1);
+  slots_[level][slot].push_back(std::move(task));
+  occupied_slots_[level] |= uint64_t{1} << slot;
+}
+
+void DelayedTaskWheel::Advance() {
+  while (due_.empty() && size_ > 0) {
+    bool found_slot = false;
+    for (size_t level = 0; level < kLevelCount && !found_slot; level++) {
+      const size_t shift = level * kSlotBits;
+      const size_t digit = (cursor_ >> shift) & (kSlotCount - 1);
+      // The occupied slots of a level all come after the digit of the cursor,
+      // and the lower levels are empty when a higher one is looked at.
+      const uint64_t later_slots =
+          digit + 1 < kSlotCount
+              ? occupied_slots_[level] & (~uint64_t{0} << (digit + 1))
+              : 0;
+      if (later_slots == 0) {
+        continue;
+      }
+      const size_t slot = __builtin_ctzll(later_slots);
+      const size_t level_shift = shift + kSlotBits;
+      cursor_ = (cursor_ >> level_shift << level_shift) |
+                (static_cast<uint64_t>(slot) << shift);
+      cascading_.swap(slots_[level][slot]);
+      occupied_slots_[level] &= ~(uint64_t{1} << slot);
+      found_slot = true;
+    }
+    if (!found_slot) {
+      FML_DCHECK(!overflow_.empty());
+      uint64_t earliest_tick = ~uint64_t{0};
+      for (const auto& task : overflow_) {
+        earliest_tick = std::min(earliest_tick, GetTick(task.GetTargetTime()));
+      }
+      cursor_ = earliest_tick;
+      cascading_.swap(overflow_);
+    }
+    Cascade();
+  }
+}
+
+void DelayedTaskWheel::Cascade() {
+  for (auto& task : cascading_) {
+    const uint64_t tick = GetTick(task.GetTargetTime());
+    if (tick <= cursor_) {
+      due_.push_back(std::move(task));
+      std::push_heap(due_.begin(), due_.end(), std::greater<DelayedTask>());
+    } else {
+      Place(tick, std::move(task));
+    }
+  }
+  cascading_.clear();
+}
+
+}  // namespace fml
@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_DELAYED_TASK_WHEEL_H_
+#define FLUTTER_FML_DELAYED_TASK_WHEEL_H_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "flutter/fml/delayed_task.h"
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+/// Holds delayed tasks and hands them out in the order of their target times,
+/// and of their registration for the same target time, like a min-heap would.
+///
+/// It is a hierarchical timer wheel. The target times are rounded to ticks of
+/// about a millisecond, and a task that is due after the current tick of the
+/// wheel is appended to a slot of the lowest level that covers its tick, which
+/// takes constant time. When the tasks due by the current tick have all been
+/// popped, the wheel moves on to the next occupied slot, and the tasks of that
+/// slot are either due by the new tick or distributed to the lower levels. Only
+/// the tasks due by the current tick are kept in a heap, so that the tasks of
+/// the same tick are still ordered exactly.
+///
+/// The tasks are moved in and out of the wheel rather than copied. It is not
+/// thread-safe.
+class DelayedTaskWheel {
+ public:
+  DelayedTaskWheel();
+
+  ~DelayedTaskWheel();
+
+  void Push(DelayedTask task);
+
+  /// Returns the earliest task. The wheel must not be empty.
+  const DelayedTask& Top() const;
+
+  /// Removes and returns the earliest task. The wheel must not be empty.
+  DelayedTask Pop();
+
+  size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  /// Drops all of the tasks.
+  void Clear();
+
+ private:
+  static constexpr size_t kSlotBits = 6;
+  static constexpr size_t kSlotCount = 1 << kSlotBits;
+  static constexpr size_t kLevelCount = 4;
+
+  static uint64_t GetTick(fml::TimePoint target_time);
+
+  // Adds a task that is due after |cursor_| to its slot, or to |overflow_| if
+  // it is too far out for the wheel.
+  void Place(uint64_t tick, DelayedTask task);
+
+  // Moves |cursor_| to the tick of the earliest task once the tasks due by the
+  // current tick have all been popped.
+  void Advance();
+
+  // Makes the tasks of |cascading_| due or places them again after |cursor_|
+  // moved.
+  void Cascade();
+
+  // The current tick. All of the tasks in the slots and in |overflow_| are due
+  // after it, and all of the tasks in |due_| by it.
+  uint64_t cursor_ = 0;
+  // A min-heap of the tasks due by |cursor_|.
+  std::vector<DelayedTask> due_;
+  std::array<std::array<std::vector<DelayedTask>, kSlotCount>, kLevelCount>
+      slots_;
+  // One bit per slot of each level that holds tasks.
+  std::array<uint64_t, kLevelCount> occupied_slots_ = {};
+  // The tasks that are due beyond the last level of the wheel.
+  std::vector<DelayedTask> overflow_;
+  // The tasks being moved out of a slot, whose storage is swapped with that of
+  // the slot so that it is reused.
+  std::vector<DelayedTask> cascading_;
+  size_t size_ = 0;
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(DelayedTaskWheel);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_DELAYED_TASK_WHEEL_H_
@@ -0,0 +1,156 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include "flutter/fml/delayed_task_wheel.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+namespace {
+
+DelayedTask MakeTask(size_t order, fml::TimePoint target_time) {
+  return {order, [] {}, target_time, TaskSourceGrade::kUnspecified};
+}
+
+// Pops all of the tasks and checks that they come in the order of a min-heap.
+void ExpectTasksInOrder(DelayedTaskWheel& wheel,
+                        std::vector<DelayedTask> tasks) {
+  std::sort(tasks.begin(), tasks.end(),
+            [](const auto& a, const auto& b) { return b > a; });
+  ASSERT_EQ(wheel.size(), tasks.size());
+  for (const auto& expected : tasks) {
+    ASSERT_FALSE(wheel.empty());
+    EXPECT_EQ(wheel.Top().GetTargetTime(), expected.GetTargetTime());
+    DelayedTask task = wheel.Pop();
+    EXPECT_FALSE(task > expected);
+    EXPECT_FALSE(expected > task);
+  }
+  EXPECT_TRUE(wheel.empty());
+}
+
+}  // namespace
+
+TEST(DelayedTaskWheelTest, TasksOfTheSameTimeComeInRegistrationOrder) {
+  DelayedTaskWheel wheel;
+  const auto now = fml::TimePoint::Now();
+  std::vector<size_t> popped;
+
+  for (size_t order = 0; order < 10; order++) {
+    wheel.Push({order, [&popped, order] { popped.push_back(order); }, now,
+                TaskSourceGrade::kUnspecified});
+  }
+  while (!wheel.empty()) {
+    wheel.Pop().GetTask()();
+  }
+
+  EXPECT_EQ(popped, (std::vector<size_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST(DelayedTaskWheelTest, TasksOfTheSameTickAreOrderedExactly) {
+  DelayedTaskWheel wheel;
+  const auto now = fml::TimePoint::Now();
+  std::vector<DelayedTask> tasks;
+
+  for (size_t order = 0; order < 10; order++) {
+    const auto target_time =
+        now + fml::TimeDelta::FromMilliseconds(5) -
+        fml::TimeDelta::FromMicroseconds(static_cast<int64_t>(order) * 7);
+    tasks.push_back(MakeTask(order, target_time));
+    wheel.Push(MakeTask(order, target_time));
+  }
+
+  ExpectTasksInOrder(wheel, std::move(tasks));
+}
+
+TEST(DelayedTaskWheelTest, TasksAtAllLevelsAndBeyondComeInOrder) {
+  DelayedTaskWheel wheel;
+  const auto now = fml::TimePoint::Now();
+  std::vector<DelayedTask> tasks;
+  std::mt19937_64 random(42);
+  std::uniform_int_distribution<int64_t> level(0, 5);
+
+  for (size_t order = 0; order < 1000; order++) {
+    // Spreads the delays from microseconds to days.
+    const int64_t max_delay = int64_t{1} << (10 + level(random) * 6);
+    const auto target_time =
+        now + fml::TimeDelta::FromMicroseconds(random() % max_delay);
+    tasks.push_back(MakeTask(order, target_time));
+    wheel.Push(MakeTask(order, target_time));
+  }
+  tasks.push_back(MakeTask(tasks.size(), fml::TimePoint::Max()));
+  wheel.Push(MakeTask(tasks.size() - 1, fml::TimePoint::Max()));
+  tasks.push_back(MakeTask(tasks.size(), fml::TimePoint::Min()));
+  wheel.Push(MakeTask(tasks.size() - 1, fml::TimePoint::Min()));
+
+  ExpectTasksInOrder(wheel, std::move(tasks));
+}
+
+TEST(DelayedTaskWheelTest, TasksPushedWhilePoppingComeInOrder) {
+  DelayedTaskWheel wheel;
+  const auto now = fml::TimePoint::Now();
+  std::mt19937_64 random(7);
+  size_t order = 0;
+  auto last_popped = MakeTask(0, fml::TimePoint::Min());
+
+  for (size_t i = 0; i < 200; i++) {
+    wheel.Push(MakeTask(order++, now + fml::TimeDelta::FromMicroseconds(
+                                           random() % 100000000)));
+  }
+  for (size_t i = 0; i < 2000; i++) {
+    // Tasks are pushed after the last popped one, like the tasks posted by a
+    // message loop while it runs the expired ones.
+    const auto base = last_popped.GetTargetTime();
+    wheel.Push(MakeTask(order++, base + fml::TimeDelta::FromMicroseconds(
+                                            random() % (1 << (i % 30)))));
+    DelayedTask task = wheel.Pop();
+    EXPECT_FALSE(last_popped > task);
+    last_popped = std::move(task);
+  }
+  while (!wheel.empty()) {
+    DelayedTask task = wheel.Pop();
+    EXPECT_FALSE(last_popped > task);
+    last_popped = std::move(task);
+  }
+}
+
+TEST(DelayedTaskWheelTest, TaskIsMovedOut) {
+  DelayedTaskWheel wheel;
+  auto value = std::make_shared<int>(1);
+
+  wheel.Push({1, [value] {}, fml::TimePoint::Now(),
+              TaskSourceGrade::kUnspecified});
+  EXPECT_EQ(value.use_count(), 2);
+  fml::UniqueClosure closure = wheel.Pop().TakeTask();
+  EXPECT_EQ(value.use_count(), 2);
+  closure = nullptr;
+  EXPECT_EQ(value.use_count(), 1);
+}
+
+TEST(DelayedTaskWheelTest, ClearDropsAllOfTheTasks) {
+  DelayedTaskWheel wheel;
+  const auto now = fml::TimePoint::Now();
+
+  wheel.Push(MakeTask(1, now));
+  wheel.Push(MakeTask(2, now + fml::TimeDelta::FromSeconds(10)));
+  wheel.Push(MakeTask(3, fml::TimePoint::Max()));
+  wheel.Clear();
+  EXPECT_TRUE(wheel.empty());
+
+  wheel.Push(MakeTask(4, now + fml::TimeDelta::FromSeconds(1)));
+  ASSERT_EQ(wheel.size(), 1u);
+  EXPECT_EQ(wheel.Pop().GetTargetTime(), now + fml::TimeDelta::FromSeconds(1));
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -74,6 +74,12 @@ bool TruncateFile(const fml::UniqueFD& file, size_t size);
 
 bool FileExists(const fml::UniqueFD& base_directory, const char* path);
 
+/// Asks the OS to start reading the file into its page cache in the
+/// background, so that reading or mapping it later does not stall on the disk.
+/// This does not wait for the reads. Returns false if the file could not be
+/// opened or if the platform has no way of reading files ahead.
+bool PrefetchFile(const fml::UniqueFD& base_directory, const char* path);
+
 bool UnlinkDirectory(const char* path);
 
 bool UnlinkDirectory(const fml::UniqueFD& base_directory, const char* path);
@@ -299,6 +299,55 @@ TEST(FileTest, MappingDontNeedSafeTest) {
   ASSERT_TRUE(fml::UnlinkFile(dir.fd(), "my_contents"));
 }
 
+TEST(FileTest, CanPrefetchFilesAndMappings) {
+  fml::ScopedTemporaryDirectory dir;
+
+  {
+    auto file = fml::OpenFile(dir.fd(), "my_contents", true,
+                              fml::FilePermission::kReadWrite);
+    ASSERT_TRUE(WriteStringToFile(file, "some content"));
+  }
+
+#if FML_OS_LINUX || FML_OS_ANDROID || FML_OS_MACOSX || FML_OS_IOS
+  ASSERT_TRUE(fml::PrefetchFile(dir.fd(), "my_contents"));
+#endif
+  ASSERT_FALSE(fml::PrefetchFile(dir.fd(), "missing_contents"));
+
+  {
+    auto mapping = fml::FileMapping::CreateReadOnly(dir.fd(), "my_contents");
+    ASSERT_NE(mapping, nullptr);
+    mapping->Prefetch();
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                          mapping->GetSize()),
+              "some content");
+  }
+
+  ASSERT_TRUE(fml::UnlinkFile(dir.fd(), "my_contents"));
+}
+
+TEST(FileTest, MappedFilesCanBeReadAgainAfterDontNeed) {
+  fml::ScopedTemporaryDirectory dir;
+
+  {
+    auto file = fml::OpenFile(dir.fd(), "my_contents", true,
+                              fml::FilePermission::kReadWrite);
+    ASSERT_TRUE(WriteStringToFile(file, "some content"));
+  }
+
+  {
+    auto mapping = fml::FileMapping::CreateReadOnly(dir.fd(), "my_contents");
+    ASSERT_NE(mapping, nullptr);
+    ASSERT_TRUE(mapping->IsDontNeedSafe());
+    mapping->DontNeed();
+    // The pages are read again from the file.
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                          mapping->GetSize()),
+              "some content");
+  }
+
+  ASSERT_TRUE(fml::UnlinkFile(dir.fd(), "my_contents"));
+}
+
 TEST(FileTest, FileTestsWork) {
   fml::ScopedTemporaryDirectory dir;
   ASSERT_TRUE(dir.fd().is_valid());
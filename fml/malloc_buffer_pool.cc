@@ -0,0 +1,112 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/malloc_buffer_pool.h"
+
+#include <cstdlib>
+
+#include "flutter/fml/logging.h"
+
+namespace fml {
+
+namespace {
+
+// Returns the index of the size class of the size, which must not be larger
+// than |MallocBufferPool::kMaxCapacity|.
+size_t GetSizeClass(size_t size) {
+  size_t size_class = 0;
+  size_t capacity = MallocBufferPool::kMinCapacity;
+  while (capacity < size) {
+    capacity <<= 1;
+    size_class++;
+  }
+  return size_class;
+}
+
+}  // namespace
+
+static_assert(MallocBufferPool::kMinCapacity << 8 ==
+                  MallocBufferPool::kMaxCapacity,
+              "There must be a size class for every power of two capacity.");
+
+MallocBufferPool& MallocBufferPool::GetInstance() {
+  // Leaked so that the buffers may be given back while the process exits.
+  static MallocBufferPool* pool = new MallocBufferPool();
+  return *pool;
+}
+
+MallocBufferPool::MallocBufferPool() = default;
+
+MallocBufferPool::~MallocBufferPool() {
+  Purge();
+}
+
+size_t MallocBufferPool::GetCapacity(size_t size) {
+  if (size == 0 || size > kMaxCapacity) {
+    return 0;
+  }
+  return kMinCapacity << GetSizeClass(size);
+}
+
+uint8_t* MallocBufferPool::Acquire(size_t size) {
+  const size_t capacity = GetCapacity(size);
+  if (capacity == 0) {
+    return nullptr;
+  }
+  {
+    std::scoped_lock lock(mutex_);
+    auto& buffers = free_buffers_[GetSizeClass(size)];
+    if (!buffers.empty()) {
+      uint8_t* buffer = buffers.back();
+      buffers.pop_back();
+      return buffer;
+    }
+  }
+  auto buffer = static_cast<uint8_t*>(malloc(capacity));
+  FML_CHECK(buffer != nullptr);
+  return buffer;
+}
+
+void MallocBufferPool::Recycle(uint8_t* buffer, size_t size) {
+  if (buffer == nullptr) {
+    return;
+  }
+  FML_DCHECK(GetCapacity(size) != 0);
+  {
+    std::scoped_lock lock(mutex_);
+    auto& buffers = free_buffers_[GetSizeClass(size)];
+    if (buffers.size() < kMaxFreeBuffersPerSizeClass) {
+      if (buffers.capacity() == 0) {
+        buffers.reserve(kMaxFreeBuffersPerSizeClass);
+      }
+      buffers.push_back(buffer);
+      return;
+    }
+  }
+  free(buffer);
+}
+
+void MallocBufferPool::Purge() {
+  std::array<std::vector<uint8_t*>, kSizeClassCount> free_buffers;
+  {
+    std::scoped_lock lock(mutex_);
+    free_buffers.swap(free_buffers_);
+  }
+  for (const auto& buffers : free_buffers) {
+    for (uint8_t* buffer : buffers) {
+      free(buffer);
+    }
+  }
+}
+
+size_t MallocBufferPool::GetFreeBufferCount() const {
+  std::scoped_lock lock(mutex_);
+  size_t count = 0;
+  for (const auto& buffers : free_buffers_) {
+    count += buffers.size();
+  }
+  return count;
+}
+
+}  // namespace fml
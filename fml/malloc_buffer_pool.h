@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_MALLOC_BUFFER_POOL_H_
+#define FLUTTER_FML_MALLOC_BUFFER_POOL_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// A thread-safe cache of small buffers allocated with `malloc`, in power of
+/// two size classes. It saves the allocations of the payloads of the busy
+/// platform channels, which are allocated on one thread and freed on another
+/// at the rate of the messages.
+///
+/// The buffers are plain `malloc` buffers, so a buffer that is never given
+/// back to the pool may still be released with `free`.
+///
+class MallocBufferPool {
+ public:
+  /// The capacity of the smallest size class.
+  static constexpr size_t kMinCapacity = 64;
+
+  /// The capacity of the largest size class. Larger buffers are not pooled.
+  static constexpr size_t kMaxCapacity = 16 * 1024;
+
+  /// The number of free buffers each size class keeps.
+  static constexpr size_t kMaxFreeBuffersPerSizeClass = 8;
+
+  /// The pool of the process.
+  static MallocBufferPool& GetInstance();
+
+  MallocBufferPool();
+
+  ~MallocBufferPool();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the capacity of the buffers handed out for the size,
+  ///             or zero if buffers of the size are not pooled.
+  ///
+  static size_t GetCapacity(size_t size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a buffer of at least |size| bytes, reusing one that
+  ///             was given back when possible.
+  ///
+  /// @return     The buffer, or null if buffers of the size are not pooled.
+  ///
+  uint8_t* Acquire(size_t size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Gives a buffer returned by |Acquire| for the same size back to
+  ///             the pool. The buffer is freed if its size class is full.
+  ///
+  void Recycle(uint8_t* buffer, size_t size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Frees all of the buffers kept by the pool.
+  ///
+  void Purge();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the number of buffers kept by the pool.
+  ///
+  size_t GetFreeBufferCount() const;
+
+ private:
+  static constexpr size_t kSizeClassCount = 9;
+
+  mutable std::mutex mutex_;
+  std::array<std::vector<uint8_t*>, kSizeClassCount> free_buffers_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(MallocBufferPool);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_MALLOC_BUFFER_POOL_H_
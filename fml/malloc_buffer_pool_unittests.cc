@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/malloc_buffer_pool.h"
+
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(MallocBufferPoolTest, SizesAreRoundedUpToTheirSizeClass) {
+  EXPECT_EQ(MallocBufferPool::GetCapacity(0), 0u);
+  EXPECT_EQ(MallocBufferPool::GetCapacity(1), 64u);
+  EXPECT_EQ(MallocBufferPool::GetCapacity(64), 64u);
+  EXPECT_EQ(MallocBufferPool::GetCapacity(65), 128u);
+  EXPECT_EQ(MallocBufferPool::GetCapacity(1000), 1024u);
+  EXPECT_EQ(MallocBufferPool::GetCapacity(MallocBufferPool::kMaxCapacity),
+            MallocBufferPool::kMaxCapacity);
+  EXPECT_EQ(MallocBufferPool::GetCapacity(MallocBufferPool::kMaxCapacity + 1),
+            0u);
+}
+
+TEST(MallocBufferPoolTest, RecycledBuffersAreReused) {
+  MallocBufferPool pool;
+  uint8_t* buffer = pool.Acquire(100);
+  ASSERT_NE(buffer, nullptr);
+  // The whole capacity may be written.
+  memset(buffer, 0xac, MallocBufferPool::GetCapacity(100));
+  pool.Recycle(buffer, 100);
+  EXPECT_EQ(pool.GetFreeBufferCount(), 1u);
+
+  // Buffers are not shared across size classes.
+  uint8_t* other = pool.Acquire(1000);
+  EXPECT_NE(other, buffer);
+  EXPECT_EQ(pool.Acquire(128), buffer);
+  EXPECT_EQ(pool.GetFreeBufferCount(), 0u);
+
+  pool.Recycle(buffer, 128);
+  pool.Recycle(other, 1000);
+}
+
+TEST(MallocBufferPoolTest, LargeSizesAreNotPooled) {
+  MallocBufferPool pool;
+  EXPECT_EQ(pool.Acquire(0), nullptr);
+  EXPECT_EQ(pool.Acquire(MallocBufferPool::kMaxCapacity + 1), nullptr);
+}
+
+TEST(MallocBufferPoolTest, SizeClassesKeepALimitedNumberOfBuffers) {
+  MallocBufferPool pool;
+  std::vector<uint8_t*> buffers;
+  for (size_t i = 0; i < MallocBufferPool::kMaxFreeBuffersPerSizeClass * 2;
+       i++) {
+    buffers.push_back(pool.Acquire(64));
+  }
+  for (uint8_t* buffer : buffers) {
+    pool.Recycle(buffer, 64);
+  }
+  EXPECT_EQ(pool.GetFreeBufferCount(),
+            MallocBufferPool::kMaxFreeBuffersPerSizeClass);
+
+  pool.Purge();
+  EXPECT_EQ(pool.GetFreeBufferCount(), 0u);
+}
+
+TEST(MallocBufferPoolTest, BuffersCanBeRecycledOnOtherThreads) {
+  MallocBufferPool pool;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 4; i++) {
+    threads.emplace_back([&pool, i] {
+      for (size_t j = 0; j < 1000; j++) {
+        const size_t size = 1 + (i * 1000 + j) % MallocBufferPool::kMaxCapacity;
+        uint8_t* buffer = pool.Acquire(size);
+        memset(buffer, 0xac, size);
+        pool.Recycle(buffer, size);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  // There is a size class per power of two from 64 bytes to 16 KiB.
+  const size_t size_class_count = 9;
+  EXPECT_LE(pool.GetFreeBufferCount(),
+            MallocBufferPool::kMaxFreeBuffersPerSizeClass * size_class_count);
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -7,8 +7,16 @@
 #include <algorithm>
 #include <sstream>
 
+#include "flutter/fml/malloc_buffer_pool.h"
+
 namespace fml {
 
+// Mapping
+
+void Mapping::Prefetch() const {}
+
+void Mapping::DontNeed() const {}
+
 // FileMapping
 
 uint8_t* FileMapping::GetMutableMapping() {
@@ -119,14 +127,30 @@ MallocMapping::MallocMapping() : data_(nullptr), size_(0) {}
 MallocMapping::MallocMapping(uint8_t* data, size_t size)
     : data_(data), size_(size) {}
 
+MallocMapping::MallocMapping(uint8_t* data,
+                             size_t size,
+                             NonOwnedMapping::ReleaseProc release_proc)
+    : data_(data), size_(size), release_proc_(std::move(release_proc)) {}
+
 MallocMapping::MallocMapping(fml::MallocMapping&& mapping)
-    : data_(mapping.data_), size_(mapping.size_) {
+    : data_(mapping.data_),
+      size_(mapping.size_),
+      pooled_(mapping.pooled_),
+      release_proc_(std::move(mapping.release_proc_)) {
   mapping.data_ = nullptr;
   mapping.size_ = 0;
+  mapping.pooled_ = false;
+  mapping.release_proc_ = nullptr;
 }
 
 MallocMapping::~MallocMapping() {
-  free(data_);
+  if (release_proc_) {
+    release_proc_(data_, size_);
+  } else if (pooled_) {
+    MallocBufferPool::GetInstance().Recycle(data_, size_);
+  } else {
+    free(data_);
+  }
   data_ = nullptr;
 }
 
@@ -138,6 +162,17 @@ MallocMapping MallocMapping::Copy(const void* begin, size_t length) {
   return result;
 }
 
+MallocMapping MallocMapping::CopyPooled(const void* begin, size_t length) {
+  uint8_t* data = MallocBufferPool::GetInstance().Acquire(length);
+  if (data == nullptr) {
+    return Copy(begin, length);
+  }
+  memcpy(data, begin, length);
+  auto result = MallocMapping(data, length);
+  result.pooled_ = true;
+  return result;
+}
+
 size_t MallocMapping::GetSize() const {
   return size_;
 }
@@ -151,10 +186,23 @@ bool MallocMapping::IsDontNeedSafe() const {
 }
 
 uint8_t* MallocMapping::Release() {
+  if (release_proc_) {
+    // The new owner frees the buffer, so it has to be allocated with malloc.
+    uint8_t* result = size_ == 0 ? nullptr : Copy(data_, size_).Release();
+    release_proc_(data_, size_);
+    Reset();
+    return result;
+  }
   uint8_t* result = data_;
+  Reset();
+  return result;
+}
+
+void MallocMapping::Reset() {
   data_ = nullptr;
   size_ = 0;
-  return result;
+  pooled_ = false;
+  release_proc_ = nullptr;
 }
 
 // Symbol Mapping
@@ -32,6 +32,18 @@ class Mapping {
   // Generally true for file-mapped memory and false for anonymous memory.
   virtual bool IsDontNeedSafe() const = 0;
 
+  // Hints that the whole mapping is about to be read, so that the pages of a
+  // mapped file are read ahead by the kernel instead of being faulted in one
+  // at a time by the thread that first touches them. This does not wait for
+  // the reads. Does nothing for memory that is not backed by a file.
+  virtual void Prefetch() const;
+
+  // Hints that the mapping will not be read for a while, so that the pages of
+  // a mapped file are dropped from the memory of the process until they are
+  // read again, when they are faulted back in from the file. Does nothing for
+  // memory that is not |IsDontNeedSafe|.
+  virtual void DontNeed() const;
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(Mapping);
 };
@@ -72,6 +84,12 @@ class FileMapping final : public Mapping {
   // |Mapping|
   bool IsDontNeedSafe() const override;
 
+  // |Mapping|
+  void Prefetch() const override;
+
+  // |Mapping|
+  void DontNeed() const override;
+
   uint8_t* GetMutableMapping();
 
   bool IsValid() const;
@@ -151,6 +169,17 @@ class MallocMapping final : public Mapping {
   /// @param size The size of the mapping in bytes.
   MallocMapping(uint8_t* data, size_t size);
 
+  /// Creates a MallocMapping for a region of memory that was not allocated
+  /// with `malloc` (without copying it), such as a buffer lent by an
+  /// embedder. The region is handed back to |release_proc|, on whichever
+  /// thread destroys the mapping, instead of being freed.
+  /// @param data The starting address of the mapping.
+  /// @param size The size of the mapping in bytes.
+  /// @param release_proc Called with the region once it is no longer used.
+  MallocMapping(uint8_t* data,
+                size_t size,
+                NonOwnedMapping::ReleaseProc release_proc);
+
   MallocMapping(fml::MallocMapping&& mapping);
 
   ~MallocMapping() override;
@@ -171,6 +200,14 @@ class MallocMapping final : public Mapping {
   /// @param length The length of the region to copy in bytes.
   static MallocMapping Copy(const void* begin, size_t length);
 
+  /// Copies a region of memory into a MallocMapping whose buffer comes from
+  /// the |MallocBufferPool| of the process, and goes back to it when the
+  /// mapping is destroyed. Regions too large to be pooled are copied as with
+  /// |Copy|.
+  /// @param begin The starting address of where we will copy.
+  /// @param length The length of the region to copy in bytes.
+  static MallocMapping CopyPooled(const void* begin, size_t length);
+
   // |Mapping|
   size_t GetSize() const override;
 
@@ -182,11 +219,19 @@ class MallocMapping final : public Mapping {
 
   /// Removes ownership of the data buffer.
   /// After this is called; the mapping will point to nullptr.
+  /// The buffer is released with `free` even if it came from the pool. A
+  /// region with a release proc is copied first, and handed back right away.
   [[nodiscard]] uint8_t* Release();
 
  private:
   uint8_t* data_;
   size_t size_;
+  // Whether |data_| goes back to the |MallocBufferPool|.
+  bool pooled_ = false;
+  // Hands |data_| back when it was not allocated with `malloc`.
+  NonOwnedMapping::ReleaseProc release_proc_;
+
+  void Reset();
 
   FML_DISALLOW_COPY_AND_ASSIGN(MallocMapping);
 };
@@ -3,6 +3,10 @@
 // found in the LICENSE file.
 
 #include "flutter/fml/mapping.h"
+
+#include <vector>
+
+#include "flutter/fml/malloc_buffer_pool.h"
 #include "flutter/testing/testing.h"
 
 namespace fml {
@@ -53,6 +57,69 @@ TEST(MallocMapping, Release) {
   ASSERT_EQ(0u, mapping.GetSize());
 }
 
+TEST(MallocMapping, CopyPooledReusesBuffers) {
+  auto& pool = MallocBufferPool::GetInstance();
+  pool.Purge();
+  std::vector<uint8_t> data(100, 0xac);
+
+  const uint8_t* buffer = nullptr;
+  {
+    MallocMapping copied = MallocMapping::CopyPooled(data.data(), data.size());
+    ASSERT_EQ(data.size(), copied.GetSize());
+    ASSERT_EQ(0, memcmp(data.data(), copied.GetMapping(), data.size()));
+    buffer = copied.GetMapping();
+    MallocMapping moved = std::move(copied);
+    ASSERT_EQ(0u, pool.GetFreeBufferCount());
+  }
+  ASSERT_EQ(1u, pool.GetFreeBufferCount());
+
+  // The sizes of the same size class share the buffers.
+  MallocMapping copied = MallocMapping::CopyPooled(data.data(), 120);
+  ASSERT_EQ(buffer, copied.GetMapping());
+  ASSERT_EQ(0u, pool.GetFreeBufferCount());
+
+  // Released buffers are freed by their new owner.
+  free(copied.Release());
+  ASSERT_EQ(0u, pool.GetFreeBufferCount());
+}
+
+TEST(MallocMapping, CopyPooledCopiesLargeRegions) {
+  auto& pool = MallocBufferPool::GetInstance();
+  pool.Purge();
+  std::vector<uint8_t> data(MallocBufferPool::kMaxCapacity + 1, 0xac);
+  {
+    MallocMapping copied = MallocMapping::CopyPooled(data.data(), data.size());
+    ASSERT_EQ(data.size(), copied.GetSize());
+    ASSERT_EQ(0, memcmp(data.data(), copied.GetMapping(), data.size()));
+  }
+  ASSERT_EQ(0u, pool.GetFreeBufferCount());
+}
+
+TEST(MallocMapping, ReleaseProcHandsBackTheRegion) {
+  std::vector<uint8_t> data(10, 0xac);
+  size_t released = 0;
+  auto release_proc = [&](const uint8_t* region, size_t size) {
+    ASSERT_EQ(data.data(), region);
+    ASSERT_EQ(data.size(), size);
+    released++;
+  };
+  {
+    MallocMapping mapping(data.data(), data.size(), release_proc);
+    MallocMapping moved = std::move(mapping);
+    ASSERT_EQ(data.data(), moved.GetMapping());
+    ASSERT_EQ(0u, released);
+  }
+  ASSERT_EQ(1u, released);
+
+  // Released regions are copied for their new owner to free.
+  MallocMapping mapping(data.data(), data.size(), release_proc);
+  uint8_t* copied = mapping.Release();
+  ASSERT_EQ(2u, released);
+  ASSERT_NE(data.data(), copied);
+  ASSERT_EQ(0, memcmp(data.data(), copied, data.size()));
+  free(copied);
+}
+
 TEST(MallocMapping, IsDontNeedSafe) {
   size_t length = 10;
   MallocMapping mapping(reinterpret_cast<uint8_t*>(malloc(length)), length);
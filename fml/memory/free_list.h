@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_MEMORY_FREE_LIST_H_
+#define FLUTTER_FML_MEMORY_FREE_LIST_H_
+
+#include <cstddef>
+#include <new>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// A per-thread cache of freed blocks of |kSize| bytes, for classes whose
+/// instances are allocated and freed at a high rate.
+///
+/// A class uses it by overriding its operator new and delete:
+///
+/// ```
+/// static void* operator new(size_t size) {
+///   return fml::FreeList<sizeof(Foo)>::Allocate(size);
+/// }
+/// static void operator delete(void* pointer, size_t size) {
+///   fml::FreeList<sizeof(Foo)>::Free(pointer, size);
+/// }
+/// ```
+///
+/// Blocks of any other size, such as the ones of subclasses, go straight to
+/// the global operator new and delete. A block may be freed on a different
+/// thread from the one that allocated it, in which case it joins the cache of
+/// the freeing thread. At most |kCapacity| blocks are cached per thread, and
+/// they are freed when the thread exits.
+///
+template <size_t kSize, size_t kCapacity = 256>
+class FreeList {
+ public:
+  static void* Allocate(size_t size) {
+    if (size == kSize) {
+      Blocks& blocks = GetBlocks();
+      if (blocks.count > 0) {
+        return blocks.items[--blocks.count];
+      }
+    }
+    return ::operator new(size);
+  }
+
+  static void Free(void* pointer, size_t size) {
+    if (pointer == nullptr) {
+      return;
+    }
+    if (size == kSize) {
+      Blocks& blocks = GetBlocks();
+      if (blocks.count < kCapacity) {
+        blocks.items[blocks.count++] = pointer;
+        return;
+      }
+    }
+    ::operator delete(pointer);
+  }
+
+  /// The number of blocks cached by the calling thread.
+  static size_t GetCachedCount() { return GetBlocks().count; }
+
+ private:
+  struct Blocks {
+    void* items[kCapacity];
+    size_t count = 0;
+
+    ~Blocks() {
+      while (count > 0) {
+        ::operator delete(items[--count]);
+      }
+    }
+  };
+
+  static Blocks& GetBlocks() {
+    static thread_local Blocks blocks;
+    return blocks;
+  }
+
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(FreeList);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_MEMORY_FREE_LIST_H_
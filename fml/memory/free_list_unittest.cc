@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/memory/free_list.h"
+
+#include <cstdint>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace {
+
+struct Pooled {
+  static void* operator new(size_t size) {
+    return FreeList<sizeof(Pooled), 2>::Allocate(size);
+  }
+  static void operator delete(void* pointer, size_t size) {
+    FreeList<sizeof(Pooled), 2>::Free(pointer, size);
+  }
+
+  int64_t values[4];
+};
+
+struct PooledSubclass : public Pooled {
+  int64_t more_values[4];
+};
+
+using PooledFreeList = FreeList<sizeof(Pooled), 2>;
+
+}  // namespace
+
+TEST(FreeListTest, ReusesFreedBlocks) {
+  std::thread thread([]() {
+    auto* first = new Pooled();
+    EXPECT_EQ(PooledFreeList::GetCachedCount(), 0u);
+    delete first;
+    EXPECT_EQ(PooledFreeList::GetCachedCount(), 1u);
+    auto* second = new Pooled();
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(PooledFreeList::GetCachedCount(), 0u);
+    delete second;
+  });
+  thread.join();
+}
+
+TEST(FreeListTest, CachesAtMostTheCapacity) {
+  std::thread thread([]() {
+    auto* first = new Pooled();
+    auto* second = new Pooled();
+    auto* third = new Pooled();
+    delete first;
+    delete second;
+    delete third;
+    EXPECT_EQ(PooledFreeList::GetCachedCount(), 2u);
+  });
+  thread.join();
+}
+
+TEST(FreeListTest, DoesNotCacheOtherSizes) {
+  std::thread thread([]() {
+    Pooled* subclass = new PooledSubclass();
+    delete static_cast<PooledSubclass*>(subclass);
+    EXPECT_EQ(PooledFreeList::GetCachedCount(), 0u);
+  });
+  thread.join();
+}
+
+}  // namespace fml
@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/memory/weak_ptr.h"
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/message_loop.h"
+
+namespace fml {
+namespace benchmarking {
+
+namespace {
+
+struct Target {
+  int value = 0;
+};
+
+}  // namespace
+
+static void BM_WeakPtrDeref(benchmark::State& state) {  // NOLINT
+  Target target;
+  WeakPtrFactory<Target> factory(&target);
+  const WeakPtr<Target> weak = factory.GetWeakPtr();
+  while (state.KeepRunning()) {
+    if (weak) {
+      weak->value++;
+    }
+  }
+  benchmark::DoNotOptimize(target.value);
+}
+
+static void BM_WeakPtrCopy(benchmark::State& state) {  // NOLINT
+  Target target;
+  WeakPtrFactory<Target> factory(&target);
+  const WeakPtr<Target> weak = factory.GetWeakPtr();
+  while (state.KeepRunning()) {
+    WeakPtr<Target> copy = weak;
+    benchmark::DoNotOptimize(copy);
+  }
+}
+
+static void BM_WeakPtrFactoryGetWeakPtr(benchmark::State& state) {  // NOLINT
+  Target target;
+  WeakPtrFactory<Target> factory(&target);
+  while (state.KeepRunning()) {
+    WeakPtr<Target> weak = factory.GetWeakPtr();
+    benchmark::DoNotOptimize(weak);
+  }
+}
+
+static void BM_TaskRunnerAffineWeakPtrDeref(  // NOLINT
+    benchmark::State& state) {
+  // The checkers of the pointers look up the task queue of the thread.
+  MessageLoop::EnsureInitializedForCurrentThread();
+  Target target;
+  TaskRunnerAffineWeakPtrFactory<Target> factory(&target);
+  const TaskRunnerAffineWeakPtr<Target> weak = factory.GetWeakPtr();
+  while (state.KeepRunning()) {
+    if (weak) {
+      weak->value++;
+    }
+  }
+  benchmark::DoNotOptimize(target.value);
+}
+
+BENCHMARK(BM_WeakPtrDeref);
+BENCHMARK(BM_WeakPtrCopy);
+BENCHMARK(BM_WeakPtrFactoryGetWeakPtr);
+BENCHMARK(BM_TaskRunnerAffineWeakPtrDeref);
+
+}  // namespace benchmarking
+}  // namespace fml
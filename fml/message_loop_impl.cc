@@ -54,7 +54,7 @@ MessageLoopImpl::~MessageLoopImpl() {
   task_queue_->Dispose(queue_id_);
 }
 
-void MessageLoopImpl::PostTask(const fml::closure& task,
+void MessageLoopImpl::PostTask(fml::UniqueClosure task,
                                fml::TimePoint target_time) {
   FML_DCHECK(task != nullptr);
   FML_DCHECK(task != nullptr);
@@ -63,7 +63,7 @@ void MessageLoopImpl::PostTask(const fml::closure& task,
     // |task| synchronously within this function.
     return;
   }
-  task_queue_->RegisterTask(queue_id_, task, target_time);
+  task_queue_->RegisterTask(queue_id_, std::move(task), target_time);
 }
 
 void MessageLoopImpl::AddTaskObserver(intptr_t key,
@@ -121,7 +121,7 @@ void MessageLoopImpl::FlushTasks(FlushType type) {
   TRACE_EVENT0("fml", "MessageLoop::FlushTasks");
 
   const auto now = fml::TimePoint::Now();
-  fml::closure invocation;
+  fml::UniqueClosure invocation;
   do {
     invocation = task_queue_->GetNextTaskToRun(queue_id_, now);
     if (!invocation) {
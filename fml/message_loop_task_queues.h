@@ -6,6 +6,7 @@
 #define FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 
 #include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <vector>
@@ -31,6 +32,12 @@ static const TaskQueueId _kUnmerged = TaskQueueId(TaskQueueId::kUnmerged);
 class TaskQueueEntry {
  public:
   using TaskObservers = std::map<intptr_t, fml::closure>;
+
+  /// Guards the wakeable, the task observers and the task source of this
+  /// TaskQueue and of the TaskQueues it owns. The members of a subsumed
+  /// TaskQueue are guarded by the mutex of its owner instead.
+  std::mutex mutex;
+
   Wakeable* wakeable;
   TaskObservers task_observers;
   std::unique_ptr<TaskSource> task_source;
@@ -60,6 +67,12 @@ enum class FlushType {
 /// fml::MessageLoops.
 ///
 /// This also wakes up the loop at the required times.
+///
+/// The set of the TaskQueues and the merges between them are guarded by a
+/// reader/writer lock, which only creating, disposing, merging and
+/// unmerging TaskQueues acquire exclusively. The tasks of each TaskQueue
+/// are guarded by the mutex of its entry, so that the loops of different
+/// engines don't contend with each other to register and run their tasks.
 /// \see fml::MessageLoop
 /// \see fml::Wakeable
 class MessageLoopTaskQueues
@@ -78,14 +91,15 @@ class MessageLoopTaskQueues
   // Tasks methods.
 
   void RegisterTask(TaskQueueId queue_id,
-                    const fml::closure& task,
+                    fml::UniqueClosure task,
                     fml::TimePoint target_time,
                     fml::TaskSourceGrade task_source_grade =
                         fml::TaskSourceGrade::kUnspecified);
 
   bool HasPendingTasks(TaskQueueId queue_id) const;
 
-  fml::closure GetNextTaskToRun(TaskQueueId queue_id, fml::TimePoint from_time);
+  fml::UniqueClosure GetNextTaskToRun(TaskQueueId queue_id,
+                                      fml::TimePoint from_time);
 
   size_t GetNumPendingTasks(TaskQueueId queue_id) const;
 
@@ -144,6 +158,10 @@ class MessageLoopTaskQueues
 
   ~MessageLoopTaskQueues();
 
+  // Returns the mutex that guards the tasks of |queue_id|, which is that of
+  // its owner if it is subsumed. |queue_meta_mutex_| must be held.
+  std::mutex& GetQueueMutex(TaskQueueId queue_id) const;
+
   void WakeUpUnlocked(TaskQueueId queue_id, fml::TimePoint time) const;
 
   bool HasPendingTasksUnlocked(TaskQueueId queue_id) const;
@@ -155,7 +173,8 @@ class MessageLoopTaskQueues
   static std::mutex creation_mutex_;
   static fml::RefPtr<MessageLoopTaskQueues> instance_;
 
-  mutable std::mutex queue_mutex_;
+  // Guards |queue_entries_| and the merged state of the entries.
+  std::unique_ptr<fml::SharedMutex> queue_meta_mutex_;
   std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
 
   size_t task_queue_id_counter_;
@@ -44,7 +44,7 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
         const auto now = fml::TimePoint::Now();
         int num_invocations = 0;
         for (;;) {
-          fml::closure invocation =
+          fml::UniqueClosure invocation =
               task_queue->GetNextTaskToRun(TaskQueueId(task_runner_id), now);
           if (!invocation) {
             break;
@@ -64,7 +64,53 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
   }
 }
 
+// Every engine has its own platform, UI, raster and IO queues, each of which
+// is fed and drained by its own thread at the same time as the others.
+static void BM_RegisterAndGetTasksOfEngines(  // NOLINT
+    benchmark::State& state) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  const int num_engines = state.range(0);
+  const int num_task_queues = num_engines * 4;
+  const int num_tasks_per_queue = 1000;
+
+  std::vector<TaskQueueId> queue_ids;
+  for (int i = 0; i < num_task_queues; i++) {
+    queue_ids.push_back(task_queue->CreateTaskQueue());
+  }
+
+  while (state.KeepRunning()) {
+    std::vector<std::thread> threads;
+    CountDownLatch tasks_done(num_task_queues);
+    for (TaskQueueId queue_id : queue_ids) {
+      threads.emplace_back([queue_id, &task_queue, &tasks_done]() {
+        const fml::TimePoint past = fml::TimePoint::Now();
+        int num_invocations = 0;
+        for (int j = 0; j < num_tasks_per_queue; j++) {
+          task_queue->RegisterTask(
+              queue_id, [] {}, past);
+          if (task_queue->GetNextTaskToRun(queue_id, fml::TimePoint::Now())) {
+            num_invocations++;
+          }
+        }
+        assert(num_invocations == num_tasks_per_queue);
+        tasks_done.CountDown();
+      });
+    }
+
+    tasks_done.Wait();
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  for (TaskQueueId queue_id : queue_ids) {
+    task_queue->Dispose(queue_id);
+  }
+}
+
 BENCHMARK(BM_RegisterAndGetTasks);
+BENCHMARK(BM_RegisterAndGetTasksOfEngines)->Arg(1)->Arg(4)->Arg(16);
 
 }  // namespace benchmarking
 }  // namespace fml
@@ -108,7 +108,8 @@ TEST(MessageLoopTaskQueue, PreserveTaskOrdering) {
   const auto now = ChronoTicksSinceEpoch();
   int expected_value = 1;
   while (true) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(queue_id, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(queue_id, now);
     if (!invocation) {
       break;
     }
@@ -148,7 +149,8 @@ TEST(MessageLoopTaskQueue, RegisterTasksOnMergedQueuesPreserveTaskOrdering) {
   // "test_val = 1" in platform_queue
   // "test_val = 2" in raster2_queue
   while (true) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(platform_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
     if (!invocation) {
       break;
     }
@@ -191,7 +193,8 @@ TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   // "test_val = 1" in platform_queue
   // "test_val = 2" in raster_queue (running on platform)
   for (int i = 0; i < 3; i++) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(platform_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == i);
@@ -210,7 +213,8 @@ TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   // platform_queue has 1 task left: "test_val = 4"
   {
     ASSERT_TRUE(task_queue->GetNumPendingTasks(platform_queue) == 1);
-    fml::closure invocation = task_queue->GetNextTaskToRun(platform_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == 4);
@@ -220,14 +224,16 @@ TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   // raster_queue has 2 tasks left: "test_val = 3" and "test_val = 5"
   {
     ASSERT_TRUE(task_queue->GetNumPendingTasks(raster_queue) == 2);
-    fml::closure invocation = task_queue->GetNextTaskToRun(raster_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(raster_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == 3);
   }
   {
     ASSERT_TRUE(task_queue->GetNumPendingTasks(raster_queue) == 1);
-    fml::closure invocation = task_queue->GetNextTaskToRun(raster_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(raster_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == 5);
@@ -411,6 +417,40 @@ TEST(MessageLoopTaskQueue, ConcurrentQueueAndTaskCreatingCounts) {
   ASSERT_EQ(pending_tasks, kThreadCount * kThreadTaskCount);
 }
 
+TEST(MessageLoopTaskQueue, ConcurrentTasksOfMergedQueuesAllRun) {
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  auto owner = task_queues->CreateTaskQueue();
+  auto subsumed = task_queues->CreateTaskQueue();
+  auto other = task_queues->CreateTaskQueue();
+  ASSERT_TRUE(task_queues->Merge(owner, subsumed));
+
+  // Tasks are posted to the merged queues and to an unrelated queue while
+  // the owner runs them.
+  constexpr size_t kThreadTaskCount = 500;
+  std::vector<std::thread> threads;
+  for (auto queue_id : {owner, subsumed, other}) {
+    threads.emplace_back([&task_queues, queue_id]() {
+      for (size_t i = 0; i < kThreadTaskCount; i++) {
+        task_queues->RegisterTask(
+            queue_id, []() {}, ChronoTicksSinceEpoch());
+      }
+    });
+  }
+
+  size_t run_tasks = 0u;
+  while (run_tasks < 2 * kThreadTaskCount) {
+    if (task_queues->GetNextTaskToRun(owner, fml::TimePoint::Max())) {
+      run_tasks++;
+    }
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_FALSE(task_queues->HasPendingTasks(owner));
+  ASSERT_EQ(task_queues->GetNumPendingTasks(other), kThreadTaskCount);
+}
+
 TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
   auto platform_queue = task_queue->CreateTaskQueue();
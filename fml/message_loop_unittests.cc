@@ -317,3 +317,91 @@ TEST(MessageLoop, CanCreateConcurrentMessageLoop) {
   latch.Wait();
   ASSERT_GE(thread_ids.size(), 1u);
 }
+
+TEST(MessageLoop, ConcurrentMessageLoopStealsTasksOfABusyWorker) {
+  auto loop = fml::ConcurrentMessageLoop::Create(2);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t kCount = 10;
+  fml::CountDownLatch latch(kCount);
+  fml::AutoResetWaitableEvent done;
+  // The tasks are posted to the deque of the worker that then blocks, so
+  // only the other worker can run them.
+  task_runner->PostTask([&]() {
+    for (size_t i = 0; i < kCount; ++i) {
+      task_runner->PostTask([&]() { latch.CountDown(); });
+    }
+    latch.Wait();
+    done.Signal();
+  });
+  done.Wait();
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsTasksInTheOrderOfTheirPriorities) {
+  auto loop = fml::ConcurrentMessageLoop::Create(1);
+  auto task_runner = loop->GetTaskRunner();
+  fml::AutoResetWaitableEvent blocked;
+  fml::CountDownLatch latch(3);
+  std::vector<int> order;
+  // The only worker runs the tasks in order once it is unblocked.
+  task_runner->PostTask([&]() { blocked.Wait(); });
+  task_runner->PostTask(
+      [&]() {
+        order.push_back(3);
+        latch.CountDown();
+      },
+      fml::ConcurrentTaskPriority::kBackground);
+  task_runner->PostTask([&]() {
+    order.push_back(2);
+    latch.CountDown();
+  });
+  task_runner->PostTask(
+      [&]() {
+        order.push_back(1);
+        latch.CountDown();
+      },
+      fml::ConcurrentTaskPriority::kUserBlocking);
+  blocked.Signal();
+  latch.Wait();
+  ASSERT_EQ(order, std::vector<int>({1, 2, 3}));
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsOverdueTasksFirst) {
+  auto loop = fml::ConcurrentMessageLoop::Create(1);
+  auto task_runner = loop->GetTaskRunner();
+  fml::AutoResetWaitableEvent blocked;
+  fml::CountDownLatch latch(2);
+  std::vector<int> order;
+  task_runner->PostTask([&]() { blocked.Wait(); });
+  task_runner->PostTask(
+      [&]() {
+        order.push_back(1);
+        latch.CountDown();
+      },
+      fml::ConcurrentTaskPriority::kBackground, fml::TimePoint::Now());
+  task_runner->PostTask(
+      [&]() {
+        order.push_back(2);
+        latch.CountDown();
+      },
+      fml::ConcurrentTaskPriority::kUserBlocking);
+  blocked.Signal();
+  latch.Wait();
+  ASSERT_EQ(order, std::vector<int>({1, 2}));
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsTaskOnAllWorkers) {
+  const size_t kWorkerCount = 4;
+  auto loop = fml::ConcurrentMessageLoop::Create(kWorkerCount);
+  fml::CountDownLatch latch(kWorkerCount);
+  std::mutex thread_ids_mutex;
+  std::set<std::thread::id> thread_ids;
+  loop->PostTaskToAllWorkers([&]() {
+    {
+      std::scoped_lock lock(thread_ids_mutex);
+      thread_ids.insert(std::this_thread::get_id());
+    }
+    latch.CountDown();
+  });
+  latch.Wait();
+  ASSERT_EQ(thread_ids.size(), kWorkerCount);
+}
@@ -7,11 +7,14 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <limits>
+
 #include "flutter/fml/platform/linux/timerfd.h"
 
 namespace fml {
 
 static constexpr int kClockType = CLOCK_MONOTONIC;
+static constexpr int64_t kTimerDisarmed = std::numeric_limits<int64_t>::max();
 
 static ALooper* AcquireLooperForThread() {
   ALooper* looper = ALooper_forThread();
@@ -31,7 +34,8 @@ static ALooper* AcquireLooperForThread() {
 MessageLoopAndroid::MessageLoopAndroid()
     : looper_(AcquireLooperForThread()),
       timer_fd_(::timerfd_create(kClockType, TFD_NONBLOCK | TFD_CLOEXEC)),
-      running_(false) {
+      running_(false),
+      armed_wake_time_(kTimerDisarmed) {
   FML_CHECK(looper_.is_valid());
   FML_CHECK(timer_fd_.is_valid());
 
@@ -83,12 +87,20 @@ void MessageLoopAndroid::Terminate() {
 }
 
 void MessageLoopAndroid::WakeUp(fml::TimePoint time_point) {
+  // The task queues wake the loop up for its next task whenever a task is
+  // registered or run, which is mostly for the time it is already armed for.
+  const int64_t wake_time = time_point.ToEpochDelta().ToNanoseconds();
+  if (armed_wake_time_.exchange(wake_time) == wake_time) {
+    return;
+  }
   [[maybe_unused]] bool result = TimerRearm(timer_fd_.get(), time_point);
   FML_DCHECK(result);
 }
 
 void MessageLoopAndroid::OnEventFired() {
   if (TimerDrain(timer_fd_.get())) {
+    // Running the expired tasks wakes the loop up again for the next one.
+    armed_wake_time_ = kTimerDisarmed;
     RunExpiredTasksNow();
   }
 }
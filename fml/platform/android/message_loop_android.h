@@ -30,6 +30,9 @@ class MessageLoopAndroid : public MessageLoopImpl {
   fml::UniqueObject<ALooper*, UniqueLooperTraits> looper_;
   fml::UniqueFD timer_fd_;
   bool running_;
+  // The time in nanoseconds that the timer is armed for, which is not rearmed
+  // when the loop is woken up for the same time again.
+  std::atomic<int64_t> armed_wake_time_;
 
   MessageLoopAndroid();
 
@@ -0,0 +1,39 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/platform/linux/futex.h"
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <ctime>
+
+namespace fml {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "The futex word must be a plain 32 bit integer.");
+
+bool FutexWait(std::atomic<uint32_t>* word,
+               uint32_t expected,
+               TimeDelta timeout) {
+  struct timespec timeout_spec = {};
+  struct timespec* timeout_ptr = nullptr;
+  if (timeout >= TimeDelta::Zero()) {
+    timeout_spec = timeout.ToTimespec();
+    timeout_ptr = &timeout_spec;
+  }
+  const long result =
+      syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT_PRIVATE,
+              expected, timeout_ptr, nullptr, 0);
+  return result == 0 || errno != ETIMEDOUT;
+}
+
+void FutexWake(std::atomic<uint32_t>* word, int count) {
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE_PRIVATE,
+          count, nullptr, nullptr, 0);
+}
+
+}  // namespace fml
@@ -0,0 +1,29 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_PLATFORM_LINUX_FUTEX_H_
+#define FLUTTER_FML_PLATFORM_LINUX_FUTEX_H_
+
+#include <atomic>
+#include <cstdint>
+
+#include "flutter/fml/time/time_delta.h"
+
+namespace fml {
+
+/// Blocks the calling thread while the word holds the expected value, until
+/// |FutexWake| is called on it, a spurious wakeup or the timeout. A negative
+/// timeout waits forever.
+///
+/// @return     False if the timeout expired, true otherwise.
+bool FutexWait(std::atomic<uint32_t>* word,
+               uint32_t expected,
+               TimeDelta timeout = TimeDelta::FromMicroseconds(-1));
+
+/// Wakes up to |count| of the threads waiting on the word.
+void FutexWake(std::atomic<uint32_t>* word, int count);
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_PLATFORM_LINUX_FUTEX_H_
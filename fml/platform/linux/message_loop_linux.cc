@@ -7,17 +7,21 @@
 #include <sys/epoll.h>
 #include <unistd.h>
 
+#include <limits>
+
 #include "flutter/fml/eintr_wrapper.h"
 #include "flutter/fml/platform/linux/timerfd.h"
 
 namespace fml {
 
 static constexpr int kClockType = CLOCK_MONOTONIC;
+static constexpr int64_t kTimerDisarmed = std::numeric_limits<int64_t>::max();
 
 MessageLoopLinux::MessageLoopLinux()
     : epoll_fd_(FML_HANDLE_EINTR(::epoll_create(1 /* unused */))),
       timer_fd_(::timerfd_create(kClockType, TFD_NONBLOCK | TFD_CLOEXEC)),
-      running_(false) {
+      running_(false),
+      armed_wake_time_(kTimerDisarmed) {
   FML_CHECK(epoll_fd_.is_valid());
   FML_CHECK(timer_fd_.is_valid());
   bool added_source = AddOrRemoveTimerSource(true);
@@ -80,6 +84,12 @@ void MessageLoopLinux::Terminate() {
 
 // |fml::MessageLoopImpl|
 void MessageLoopLinux::WakeUp(fml::TimePoint time_point) {
+  // The task queues wake the loop up for its next task whenever a task is
+  // registered or run, which is mostly for the time it is already armed for.
+  const int64_t wake_time = time_point.ToEpochDelta().ToNanoseconds();
+  if (armed_wake_time_.exchange(wake_time) == wake_time) {
+    return;
+  }
   bool result = TimerRearm(timer_fd_.get(), time_point);
   (void)result;
   FML_DCHECK(result);
@@ -87,6 +97,8 @@ void MessageLoopLinux::WakeUp(fml::TimePoint time_point) {
 
 void MessageLoopLinux::OnEventFired() {
   if (TimerDrain(timer_fd_.get())) {
+    // Running the expired tasks wakes the loop up again for the next one.
+    armed_wake_time_ = kTimerDisarmed;
     RunExpiredTasksNow();
   }
 }
@@ -18,6 +18,9 @@ class MessageLoopLinux : public MessageLoopImpl {
   fml::UniqueFD epoll_fd_;
   fml::UniqueFD timer_fd_;
   bool running_;
+  // The time in nanoseconds that the timer is armed for, which is not rearmed
+  // when the loop is woken up for the same time again.
+  std::atomic<int64_t> armed_wake_time_;
 
   MessageLoopLinux();
 
@@ -10,9 +10,12 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <sstream>
 
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/eintr_wrapper.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/mapping.h"
@@ -187,6 +190,29 @@ bool FileExists(const fml::UniqueFD& base_directory, const char* path) {
   return ::faccessat(base_directory.get(), path, F_OK, 0) == 0;
 }
 
+bool PrefetchFile(const fml::UniqueFD& base_directory, const char* path) {
+  auto file = OpenFileReadOnly(base_directory, path);
+  if (!file.is_valid()) {
+    return false;
+  }
+
+#if FML_OS_LINUX || FML_OS_ANDROID
+  return ::posix_fadvise(file.get(), 0, 0, POSIX_FADV_WILLNEED) == 0;
+#elif FML_OS_MACOSX || FML_OS_IOS
+  struct stat stat_buffer = {};
+  if (::fstat(file.get(), &stat_buffer) != 0) {
+    return false;
+  }
+  struct radvisory advisory = {};
+  advisory.ra_offset = 0;
+  advisory.ra_count = static_cast<int>(
+      std::min<off_t>(stat_buffer.st_size, std::numeric_limits<int>::max()));
+  return ::fcntl(file.get(), F_RDADVISE, &advisory) != -1;
+#else
+  return false;
+#endif
+}
+
 bool WriteAtomically(const fml::UniqueFD& base_directory,
                      const char* file_name,
                      const Mapping& data) {
@@ -104,6 +104,18 @@ bool FileMapping::IsDontNeedSafe() const {
   return mutable_mapping_ == nullptr;
 }
 
+void FileMapping::Prefetch() const {
+  if (mapping_ != nullptr) {
+    ::madvise(mapping_, size_, MADV_WILLNEED);
+  }
+}
+
+void FileMapping::DontNeed() const {
+  if (mapping_ != nullptr && IsDontNeedSafe()) {
+    ::madvise(mapping_, size_, MADV_DONTNEED);
+  }
+}
+
 bool FileMapping::IsValid() const {
   return valid_;
 }
@@ -375,6 +375,10 @@ bool FileExists(const fml::UniqueFD& base_directory, const char* path) {
          INVALID_FILE_ATTRIBUTES;
 }
 
+bool PrefetchFile(const fml::UniqueFD& base_directory, const char* path) {
+  return false;
+}
+
 bool WriteAtomically(const fml::UniqueFD& base_directory,
                      const char* file_name,
                      const Mapping& mapping) {
@@ -119,6 +119,14 @@ bool FileMapping::IsDontNeedSafe() const {
   return mutable_mapping_ == nullptr;
 }
 
+void FileMapping::Prefetch() const {
+  // PrefetchVirtualMemory is not available on Windows 7.
+}
+
+void FileMapping::DontNeed() const {
+  // The pages of a view of a file are trimmed by the system on its own.
+}
+
 bool FileMapping::IsValid() const {
   return valid_;
 }
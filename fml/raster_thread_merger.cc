@@ -6,6 +6,8 @@
 
 #include "flutter/fml/raster_thread_merger.h"
 
+#include <algorithm>
+
 #include "flutter/fml/message_loop_impl.h"
 
 namespace fml {
@@ -65,6 +67,10 @@ void RasterThreadMerger::MergeWithLease(size_t lease_term) {
   }
 
   bool success = shared_merger_->MergeWithLease(this, lease_term);
+  if (success) {
+    UpdateLeaseMultiplierUnSafe();
+    last_lease_term_ = lease_term;
+  }
   if (success && merge_unmerge_callback_ != nullptr) {
     merge_unmerge_callback_();
   }
@@ -82,6 +88,7 @@ void RasterThreadMerger::UnMergeNowIfLastOne() {
     return;
   }
   bool success = shared_merger_->UnMergeNowIfLastOne(this);
+  has_unmerged_ = false;
   if (success && merge_unmerge_callback_ != nullptr) {
     merge_unmerge_callback_();
   }
@@ -111,6 +118,7 @@ void RasterThreadMerger::ExtendLeaseTo(size_t lease_term) {
     return;
   }
   shared_merger_->ExtendLeaseTo(this, lease_term);
+  last_lease_term_ = lease_term;
 }
 
 bool RasterThreadMerger::IsMerged() {
@@ -160,6 +168,7 @@ RasterThreadStatus RasterThreadMerger::DecrementLease() {
   }
   std::scoped_lock lock(mutex_);
   if (!IsMergedUnSafe()) {
+    frames_since_unmerge_++;
     return RasterThreadStatus::kRemainsUnmerged;
   }
   if (!IsEnabledUnSafe()) {
@@ -167,6 +176,8 @@ RasterThreadStatus RasterThreadMerger::DecrementLease() {
   }
   bool unmerged_after_decrement = shared_merger_->DecrementLease(this);
   if (unmerged_after_decrement) {
+    has_unmerged_ = true;
+    frames_since_unmerge_ = 0;
     if (merge_unmerge_callback_ != nullptr) {
       merge_unmerge_callback_();
     }
@@ -176,4 +187,21 @@ RasterThreadStatus RasterThreadMerger::DecrementLease() {
   return RasterThreadStatus::kRemainsMerged;
 }
 
+size_t RasterThreadMerger::GetAdaptiveLeaseTerm(size_t lease_term) {
+  std::scoped_lock lock(mutex_);
+  return lease_term * lease_multiplier_;
+}
+
+void RasterThreadMerger::UpdateLeaseMultiplierUnSafe() {
+  if (!has_unmerged_) {
+    return;
+  }
+  has_unmerged_ = false;
+  if (frames_since_unmerge_ < last_lease_term_) {
+    lease_multiplier_ = std::min(lease_multiplier_ * 2, kMaxLeaseMultiplier);
+  } else if (lease_multiplier_ > 1) {
+    lease_multiplier_ /= 2;
+  }
+}
+
 }  // namespace fml
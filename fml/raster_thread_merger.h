@@ -76,6 +76,19 @@ class RasterThreadMerger
   // When task queues are statically merged this method becomes no-op.
   RasterThreadStatus DecrementLease();
 
+  // Returns |lease_term| scaled to how often the threads were merged again
+  // soon after they were unmerged, as happens when a platform view scrolls
+  // in and out of view. A merge that happens within one lease term of the
+  // previous unmerge doubles the scale, up to |kMaxLeaseMultiplier|, and a
+  // merge after a longer gap halves it.
+  //
+  // Callers that pass the result to |MergeWithLease| and |ExtendLeaseTo|
+  // keep the threads merged across short gaps, rather than paying for a
+  // merge on each transition.
+  size_t GetAdaptiveLeaseTerm(size_t lease_term);
+
+  static constexpr size_t kMaxLeaseMultiplier = 8;
+
   // The method is locked by current instance, and asks the shared instance of
   // SharedThreadMerger and the merging state is determined by the
   // lease_term_ counter.
@@ -128,6 +141,12 @@ class RasterThreadMerger
   std::mutex mutex_;
   fml::closure merge_unmerge_callback_;
 
+  // The state of |GetAdaptiveLeaseTerm|.
+  size_t lease_multiplier_ = 1;
+  size_t last_lease_term_ = 0;
+  bool has_unmerged_ = false;
+  size_t frames_since_unmerge_ = 0;
+
   bool IsMergedUnSafe() const;
 
   bool IsEnabledUnSafe() const;
@@ -136,6 +155,10 @@ class RasterThreadMerger
   // We consider the threads are always merged and cannot be unmerged.
   bool TaskQueuesAreSame() const;
 
+  // Adapts |lease_multiplier_| to the number of frames since the threads
+  // were last unmerged. Called when the threads are merged again.
+  void UpdateLeaseMultiplierUnSafe();
+
   FML_FRIEND_REF_COUNTED_THREAD_SAFE(RasterThreadMerger);
   FML_FRIEND_MAKE_REF_COUNTED(RasterThreadMerger);
   FML_DISALLOW_COPY_AND_ASSIGN(RasterThreadMerger);
@@ -76,6 +76,79 @@ TEST(RasterThreadMerger, RemainMergedTillLeaseExpires) {
   ASSERT_FALSE(raster_thread_merger->IsMerged());
 }
 
+TEST(RasterThreadMerger, AdaptiveLeaseGrowsWhenMergedAgainSoon) {
+  TaskQueueWrapper queue1;
+  TaskQueueWrapper queue2;
+  fml::TaskQueueId qid1 = queue1.GetTaskQueueId();
+  fml::TaskQueueId qid2 = queue2.GetTaskQueueId();
+  const auto raster_thread_merger =
+      fml::MakeRefCounted<fml::RasterThreadMerger>(qid1, qid2);
+  const size_t kNumFramesMerged = 5;
+
+  ASSERT_EQ(raster_thread_merger->GetAdaptiveLeaseTerm(kNumFramesMerged),
+            kNumFramesMerged);
+
+  raster_thread_merger->MergeWithLease(kNumFramesMerged);
+  for (size_t i = 0; i < kNumFramesMerged; i++) {
+    raster_thread_merger->DecrementLease();
+  }
+  ASSERT_FALSE(raster_thread_merger->IsMerged());
+
+  // Merged again within the lease term of the unmerge.
+  raster_thread_merger->DecrementLease();
+  raster_thread_merger->MergeWithLease(kNumFramesMerged);
+  ASSERT_EQ(raster_thread_merger->GetAdaptiveLeaseTerm(kNumFramesMerged),
+            2 * kNumFramesMerged);
+
+  // The multiplier is capped.
+  for (size_t i = 0; i < 4; i++) {
+    const size_t lease_term =
+        raster_thread_merger->GetAdaptiveLeaseTerm(kNumFramesMerged);
+    raster_thread_merger->ExtendLeaseTo(lease_term);
+    for (size_t j = 0; j < lease_term; j++) {
+      raster_thread_merger->DecrementLease();
+    }
+    ASSERT_FALSE(raster_thread_merger->IsMerged());
+    raster_thread_merger->MergeWithLease(lease_term);
+  }
+  ASSERT_EQ(raster_thread_merger->GetAdaptiveLeaseTerm(kNumFramesMerged),
+            fml::RasterThreadMerger::kMaxLeaseMultiplier * kNumFramesMerged);
+
+  raster_thread_merger->UnMergeNowIfLastOne();
+}
+
+TEST(RasterThreadMerger, AdaptiveLeaseShrinksWhenMergedAgainLater) {
+  TaskQueueWrapper queue1;
+  TaskQueueWrapper queue2;
+  fml::TaskQueueId qid1 = queue1.GetTaskQueueId();
+  fml::TaskQueueId qid2 = queue2.GetTaskQueueId();
+  const auto raster_thread_merger =
+      fml::MakeRefCounted<fml::RasterThreadMerger>(qid1, qid2);
+  const size_t kNumFramesMerged = 5;
+
+  raster_thread_merger->MergeWithLease(kNumFramesMerged);
+  for (size_t i = 0; i < kNumFramesMerged; i++) {
+    raster_thread_merger->DecrementLease();
+  }
+  raster_thread_merger->MergeWithLease(kNumFramesMerged);
+  ASSERT_EQ(raster_thread_merger->GetAdaptiveLeaseTerm(kNumFramesMerged),
+            2 * kNumFramesMerged);
+
+  for (size_t i = 0; i < kNumFramesMerged; i++) {
+    raster_thread_merger->DecrementLease();
+  }
+  ASSERT_FALSE(raster_thread_merger->IsMerged());
+  // Stays unmerged for longer than the lease term.
+  for (size_t i = 0; i < kNumFramesMerged; i++) {
+    raster_thread_merger->DecrementLease();
+  }
+  raster_thread_merger->MergeWithLease(kNumFramesMerged);
+  ASSERT_EQ(raster_thread_merger->GetAdaptiveLeaseTerm(kNumFramesMerged),
+            kNumFramesMerged);
+
+  raster_thread_merger->UnMergeNowIfLastOne();
+}
+
 TEST(RasterThreadMerger, IsNotOnRasterizingThread) {
   fml::MessageLoop* loop1 = nullptr;
   fml::AutoResetWaitableEvent latch1;
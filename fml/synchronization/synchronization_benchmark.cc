@@ -0,0 +1,227 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/semaphore.h"
+#include "flutter/fml/synchronization/shared_mutex.h"
+#include "flutter/fml/synchronization/sync_switch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+
+namespace fml {
+namespace benchmarking {
+
+namespace {
+
+void Signal(AutoResetWaitableEvent& event) {
+  event.Signal();
+}
+
+void Wait(AutoResetWaitableEvent& event) {
+  event.Wait();
+}
+
+void Signal(Semaphore& semaphore) {
+  semaphore.Signal();
+}
+
+void Wait(Semaphore& semaphore) {
+  FML_CHECK(semaphore.Wait());
+}
+
+// Bounces a signal between the benchmark thread and a partner thread. Each
+// iteration is a round trip, so half of its time is the latency of waking the
+// other thread.
+template <typename Event>
+void RunPingPong(benchmark::State& state, Event& ping, Event& pong) {
+  std::atomic_bool done = false;
+  std::thread partner([&]() {
+    while (true) {
+      Wait(ping);
+      if (done) {
+        return;
+      }
+      Signal(pong);
+    }
+  });
+  while (state.KeepRunning()) {
+    Signal(ping);
+    Wait(pong);
+  }
+  done = true;
+  Signal(ping);
+  partner.join();
+}
+
+}  // namespace
+
+static void BM_AutoResetWaitableEventSignalAndWait(  // NOLINT
+    benchmark::State& state) {
+  AutoResetWaitableEvent event;
+  while (state.KeepRunning()) {
+    event.Signal();
+    event.Wait();
+  }
+}
+
+static void BM_AutoResetWaitableEventSignalWithoutWaiter(  // NOLINT
+    benchmark::State& state) {
+  static AutoResetWaitableEvent event;
+  while (state.KeepRunning()) {
+    event.Signal();
+  }
+}
+
+static void BM_AutoResetWaitableEventPingPong(  // NOLINT
+    benchmark::State& state) {
+  AutoResetWaitableEvent ping;
+  AutoResetWaitableEvent pong;
+  RunPingPong(state, ping, pong);
+}
+
+// Measures the time from the signal until all of the waiters are awake. The
+// waiters may not all be blocked yet when the event is signaled.
+static void BM_ManualResetWaitableEventWakeAll(  // NOLINT
+    benchmark::State& state) {
+  const int num_waiters = state.range(0);
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    ManualResetWaitableEvent event;
+    CountDownLatch started(num_waiters);
+    CountDownLatch woken(num_waiters);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_waiters; i++) {
+      threads.emplace_back([&]() {
+        started.CountDown();
+        event.Wait();
+        woken.CountDown();
+      });
+    }
+    started.Wait();
+    state.ResumeTiming();
+
+    event.Signal();
+    woken.Wait();
+
+    ::benchmarking::ScopedPauseTiming pause(state);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+}
+
+static void BM_CountDownLatchCountDownAndWait(  // NOLINT
+    benchmark::State& state) {
+  while (state.KeepRunning()) {
+    CountDownLatch latch(1);
+    latch.CountDown();
+    latch.Wait();
+  }
+}
+
+// Measures the time from waking the threads until the last of them has
+// counted the latch down and woken the benchmark thread.
+static void BM_CountDownLatchCountDownFromThreads(  // NOLINT
+    benchmark::State& state) {
+  const int num_threads = state.range(0);
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    ManualResetWaitableEvent go;
+    CountDownLatch started(num_threads);
+    CountDownLatch latch(num_threads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; i++) {
+      threads.emplace_back([&]() {
+        started.CountDown();
+        go.Wait();
+        latch.CountDown();
+      });
+    }
+    started.Wait();
+    state.ResumeTiming();
+
+    go.Signal();
+    latch.Wait();
+
+    ::benchmarking::ScopedPauseTiming pause(state);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+}
+
+static void BM_SemaphoreSignalAndWait(benchmark::State& state) {  // NOLINT
+  Semaphore semaphore(0);
+  while (state.KeepRunning()) {
+    semaphore.Signal();
+    if (!semaphore.Wait()) {
+      state.SkipWithError("Could not wait on the semaphore.");
+      return;
+    }
+  }
+}
+
+static void BM_SemaphorePingPong(benchmark::State& state) {  // NOLINT
+  Semaphore ping(0);
+  Semaphore pong(0);
+  RunPingPong(state, ping, pong);
+}
+
+static SharedMutex& GetBenchmarkSharedMutex() {
+  static std::unique_ptr<SharedMutex> mutex(SharedMutex::Create());
+  return *mutex;
+}
+
+// With more than one thread, the readers contend on the reader count.
+static void BM_SharedMutexLockShared(benchmark::State& state) {  // NOLINT
+  SharedMutex& mutex = GetBenchmarkSharedMutex();
+  while (state.KeepRunning()) {
+    SharedLock lock(mutex);
+  }
+}
+
+static void BM_SharedMutexLock(benchmark::State& state) {  // NOLINT
+  SharedMutex& mutex = GetBenchmarkSharedMutex();
+  while (state.KeepRunning()) {
+    UniqueLock lock(mutex);
+  }
+}
+
+static void BM_SyncSwitchExecute(benchmark::State& state) {  // NOLINT
+  static SyncSwitch sync_switch(false);
+  int count = 0;
+  const auto handlers =
+      SyncSwitch::Handlers().SetIfFalse([&count]() { count++; });
+  while (state.KeepRunning()) {
+    sync_switch.Execute(handlers);
+  }
+  benchmark::DoNotOptimize(count);
+}
+
+BENCHMARK(BM_AutoResetWaitableEventSignalAndWait);
+BENCHMARK(BM_AutoResetWaitableEventSignalWithoutWaiter)->Threads(1)->Threads(4);
+BENCHMARK(BM_AutoResetWaitableEventPingPong)->UseRealTime();
+BENCHMARK(BM_ManualResetWaitableEventWakeAll)
+    ->Arg(1)
+    ->Arg(4)
+    ->UseRealTime();
+BENCHMARK(BM_CountDownLatchCountDownAndWait);
+BENCHMARK(BM_CountDownLatchCountDownFromThreads)
+    ->Arg(1)
+    ->Arg(4)
+    ->UseRealTime();
+BENCHMARK(BM_SemaphoreSignalAndWait);
+BENCHMARK(BM_SemaphorePingPong)->UseRealTime();
+BENCHMARK(BM_SharedMutexLockShared)->Threads(1)->Threads(4);
+BENCHMARK(BM_SharedMutexLock)->Threads(1)->Threads(4);
+BENCHMARK(BM_SyncSwitchExecute)->Threads(1)->Threads(4);
+
+}  // namespace benchmarking
+}  // namespace fml
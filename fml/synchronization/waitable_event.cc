@@ -11,8 +11,139 @@
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 
+#if FML_WAITABLE_EVENT_USES_FUTEX
+#include <climits>
+#include <optional>
+
+#include "flutter/fml/platform/linux/futex.h"
+#endif
+
 namespace fml {
 
+#if FML_WAITABLE_EVENT_USES_FUTEX
+
+namespace {
+
+// Waits on |*state| until |is_awoken(value)| returns true for one of its
+// values, or |timeout| expires, in which case it returns true. Without a
+// timeout, it waits forever. |is_awoken()| may also consume the value it is
+// given, so the first check is made before counting the thread in |*waiters|.
+template <typename IsAwokenFn>
+bool FutexWaitImpl(std::atomic<uint32_t>* state,
+                   std::atomic<uint32_t>* waiters,
+                   IsAwokenFn is_awoken,
+                   std::optional<TimeDelta> timeout) {
+  if (is_awoken(state->load())) {
+    return false;
+  }
+
+  const TimePoint start = timeout ? TimePoint::Now() : TimePoint();
+  bool timed_out = false;
+  // The signalers read |*waiters| after changing |*state|, so they either see
+  // this thread or it sees their change before sleeping.
+  waiters->fetch_add(1);
+  while (true) {
+    const uint32_t value = state->load();
+    if (is_awoken(value)) {
+      break;
+    }
+    TimeDelta wait_remaining = TimeDelta::FromMicroseconds(-1);
+    if (timeout) {
+      const TimeDelta elapsed = TimePoint::Now() - start;
+      if (elapsed >= *timeout) {
+        timed_out = true;
+        break;
+      }
+      wait_remaining = *timeout - elapsed;
+    }
+    // This returns right away if |*state| no longer holds |value|, and may
+    // wake up spuriously.
+    FutexWait(state, value, wait_remaining);
+  }
+  waiters->fetch_sub(1);
+  return timed_out;
+}
+
+}  // namespace
+
+// AutoResetWaitableEvent ------------------------------------------------------
+
+void AutoResetWaitableEvent::Signal() {
+  state_.store(1);
+  if (waiters_.load() > 0) {
+    FutexWake(&state_, 1);
+  }
+}
+
+void AutoResetWaitableEvent::Reset() {
+  state_.store(0);
+}
+
+void AutoResetWaitableEvent::Wait() {
+  FutexWaitImpl(
+      &state_, &waiters_,
+      [this](uint32_t value) {
+        return value == 1 && state_.compare_exchange_strong(value, 0);
+      },
+      std::nullopt);
+}
+
+bool AutoResetWaitableEvent::WaitWithTimeout(TimeDelta timeout) {
+  return FutexWaitImpl(
+      &state_, &waiters_,
+      [this](uint32_t value) {
+        return value == 1 && state_.compare_exchange_strong(value, 0);
+      },
+      timeout);
+}
+
+bool AutoResetWaitableEvent::IsSignaledForTest() {
+  return state_.load() == 1;
+}
+
+// ManualResetWaitableEvent ----------------------------------------------------
+
+void ManualResetWaitableEvent::Signal() {
+  uint32_t value = state_.load();
+  // Counts the signal in the upper bits and sets the signaled bit.
+  while (!state_.compare_exchange_weak(value, (value + 2) | 1)) {
+  }
+  if (waiters_.load() > 0) {
+    FutexWake(&state_, INT_MAX);
+  }
+}
+
+void ManualResetWaitableEvent::Reset() {
+  state_.fetch_and(~uint32_t{1});
+}
+
+void ManualResetWaitableEvent::Wait() {
+  const uint32_t last_signal_id = state_.load() >> 1;
+  FutexWaitImpl(
+      &state_, &waiters_,
+      [last_signal_id](uint32_t value) {
+        return (value & 1) != 0 || (value >> 1) != last_signal_id;
+      },
+      std::nullopt);
+}
+
+bool ManualResetWaitableEvent::WaitWithTimeout(TimeDelta timeout) {
+  const uint32_t last_signal_id = state_.load() >> 1;
+  return FutexWaitImpl(
+      &state_, &waiters_,
+      [last_signal_id](uint32_t value) {
+        // Also check the signaled bit in case we're already signaled.
+        return (value & 1) != 0 || (value >> 1) != last_signal_id;
+      },
+      timeout);
+}
+
+bool ManualResetWaitableEvent::IsSignaledForTest() {
+  return (state_.load() & 1) != 0;
+}
+
+#else  // FML_WAITABLE_EVENT_USES_FUTEX
+
 // Waits with a timeout on |condition()|. Returns true on timeout, or false if
 // |condition()| ever returns true. |condition()| should have no side effects
 // (and will always be called with |*mutex| held).
@@ -173,4 +304,6 @@ bool ManualResetWaitableEvent::IsSignaledForTest() {
   return signaled_;
 }
 
+#endif  // FML_WAITABLE_EVENT_USES_FUTEX
+
 }  // namespace fml
@@ -10,12 +10,24 @@
 #ifndef FLUTTER_FML_SYNCHRONIZATION_WAITABLE_EVENT_H_
 #define FLUTTER_FML_SYNCHRONIZATION_WAITABLE_EVENT_H_
 
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <mutex>
 
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_delta.h"
 
+// On Linux and Android, the events wait on futexes directly. Signaling an
+// event that no thread waits on does not make a system call, and a woken
+// thread does not have to reacquire a mutex that its signaler may still hold.
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+#define FML_WAITABLE_EVENT_USES_FUTEX 1
+#else
+#define FML_WAITABLE_EVENT_USES_FUTEX 0
+#endif
+
 namespace fml {
 
 // AutoResetWaitableEvent ------------------------------------------------------
@@ -62,11 +74,19 @@ class AutoResetWaitableEvent final {
   bool IsSignaledForTest();
 
  private:
+#if FML_WAITABLE_EVENT_USES_FUTEX
+  // One if this event is in the signaled state, zero otherwise.
+  std::atomic<uint32_t> state_ = 0;
+
+  // The number of threads that are waiting or about to wait on |state_|.
+  std::atomic<uint32_t> waiters_ = 0;
+#else
   std::condition_variable cv_;
   std::mutex mutex_;
 
   // True if this event is in the signaled state.
   bool signaled_ = false;
+#endif
 
   FML_DISALLOW_COPY_AND_ASSIGN(AutoResetWaitableEvent);
 };
@@ -104,6 +124,16 @@ class ManualResetWaitableEvent final {
   bool IsSignaledForTest();
 
  private:
+#if FML_WAITABLE_EVENT_USES_FUTEX
+  // The lowest bit is set if this event is in the signaled state. The other
+  // bits count the calls to |Signal()|, so that a waiting thread knows it was
+  // awoken even if the event has been reset since, like |signal_id_| does in
+  // the other implementation.
+  std::atomic<uint32_t> state_ = 0;
+
+  // The number of threads that are waiting or about to wait on |state_|.
+  std::atomic<uint32_t> waiters_ = 0;
+#else
   std::condition_variable cv_;
   std::mutex mutex_;
 
@@ -118,6 +148,7 @@ class ManualResetWaitableEvent final {
   // |std::condition_variable::notify_all()|. A waiting thread knows it was
   // awoken if |signal_id_| is different from when it started waiting.
   unsigned signal_id_ = 0u;
+#endif
 
   FML_DISALLOW_COPY_AND_ASSIGN(ManualResetWaitableEvent);
 };
@@ -128,6 +128,25 @@ TEST(AutoResetWaitableEventTest, MultipleWaiters) {
   }
 }
 
+TEST(AutoResetWaitableEventTest, PingPong) {
+  AutoResetWaitableEvent ping;
+  AutoResetWaitableEvent pong;
+  const size_t round_trips = 10000u;
+
+  std::thread thread([&ping, &pong]() {
+    for (size_t i = 0u; i < round_trips; i++) {
+      ping.Wait();
+      pong.Signal();
+    }
+  });
+  for (size_t i = 0u; i < round_trips; i++) {
+    ping.Signal();
+    // A lost wakeup would make this time out.
+    ASSERT_FALSE(pong.WaitWithTimeout(kActionTimeout));
+  }
+  thread.join();
+}
+
 // ManualResetWaitableEvent ----------------------------------------------------
 
 TEST(ManualResetWaitableEventTest, Basic) {
@@ -184,6 +203,34 @@ TEST(ManualResetWaitableEventTest, SignalMultiple) {
   }
 }
 
+TEST(ManualResetWaitableEventTest, SignalWakesWaitersEvenIfReset) {
+  ManualResetWaitableEvent ev;
+  ManualResetWaitableEvent waiting;
+  std::atomic<size_t> num_waiting = 0u;
+  const size_t num_waiters = 4u;
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0u; i < num_waiters; i++) {
+    threads.push_back(std::thread([&]() {
+      if (++num_waiting == num_waiters) {
+        waiting.Signal();
+      }
+      EXPECT_FALSE(ev.WaitWithTimeout(kActionTimeout));
+    }));
+  }
+
+  waiting.Wait();
+  // Give the threads a chance to block.
+  SleepFor(kEpsilonTimeout);
+  ev.Signal();
+  ev.Reset();
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_FALSE(ev.IsSignaledForTest());
+}
+
 }  // namespace
 }  // namespace fml
 
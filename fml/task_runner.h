@@ -16,12 +16,26 @@ namespace fml {
 
 class MessageLoopImpl;
 
+/// How urgently a task has to run, as a hint for the task runners that hand
+/// their tasks to an event loop shared with other work. The message loops of
+/// the engine run the tasks in the order of their target times regardless.
+enum class TaskPriority {
+  /// The absence of a specialized `TaskPriority`.
+  kNormal,
+  /// The task produces the frame for the next vsync.
+  kFrame,
+  /// The task services an input event.
+  kInput,
+  /// The task may be deferred until there is nothing else to do.
+  kIdle,
+};
+
 /// An interface over the ability to schedule tasks on a \p TaskRunner.
 class BasicTaskRunner {
  public:
   /// Schedules \p task to be executed on the TaskRunner's associated event
   /// loop.
-  virtual void PostTask(const fml::closure& task) = 0;
+  virtual void PostTask(fml::UniqueClosure task) = 0;
 };
 
 /// The object for scheduling tasks on a \p fml::MessageLoop.
@@ -36,9 +50,9 @@ class TaskRunner : public fml::RefCountedThreadSafe<TaskRunner>,
  public:
   virtual ~TaskRunner();
 
-  virtual void PostTask(const fml::closure& task) override;
+  virtual void PostTask(fml::UniqueClosure task) override;
 
-  virtual void PostTaskForTime(const fml::closure& task,
+  virtual void PostTaskForTime(fml::UniqueClosure task,
                                fml::TimePoint target_time);
 
   /// Schedules a task to be run on the MessageLoop after the time \p delay has
@@ -47,7 +61,21 @@ class TaskRunner : public fml::RefCountedThreadSafe<TaskRunner>,
   /// executed so that the actual execution time is: now + delay +
   /// message_loop_latency, where message_loop_latency is undefined and could be
   /// tens of milliseconds.
-  virtual void PostDelayedTask(const fml::closure& task, fml::TimeDelta delay);
+  virtual void PostDelayedTask(fml::UniqueClosure task, fml::TimeDelta delay);
+
+  /// Schedules a task like \p PostTaskForTime with a hint of how urgently it
+  /// has to run. The hint is ignored by the message loops of the engine.
+  virtual void PostTaskForTimeWithPriority(fml::UniqueClosure task,
+                                           fml::TimePoint target_time,
+                                           TaskPriority priority);
+
+  /// Schedules a task like \p PostTask with the given \p priority.
+  void PostTaskWithPriority(fml::UniqueClosure task, TaskPriority priority);
+
+  /// Schedules a task like \p PostDelayedTask with the given \p priority.
+  void PostDelayedTaskWithPriority(fml::UniqueClosure task,
+                                   fml::TimeDelta delay,
+                                   TaskPriority priority);
 
   /// Returns \p true when the current executing thread's TaskRunner matches
   /// this instance.
@@ -57,10 +85,15 @@ class TaskRunner : public fml::RefCountedThreadSafe<TaskRunner>,
   /// \see fml::MessageLoopTaskQueues
   virtual TaskQueueId GetTaskQueueId();
 
+  /// Returns the number of the tasks posted to the TaskRunner that have not
+  /// run yet, including the delayed tasks. The tasks of a queue merged into
+  /// another are counted by the queue that they were merged into.
+  virtual size_t GetNumPendingTasks();
+
   /// Executes the \p task directly if the TaskRunner \p runner is the
   /// TaskRunner associated with the current executing thread.
   static void RunNowOrPostTask(fml::RefPtr<fml::TaskRunner> runner,
-                               const fml::closure& task);
+                               fml::UniqueClosure task);
 
  protected:
   explicit TaskRunner(fml::RefPtr<MessageLoopImpl> loop);
@@ -16,36 +16,34 @@ TaskSource::~TaskSource() {
 }
 
 void TaskSource::ShutDown() {
-  primary_task_queue_ = {};
-  secondary_task_queue_ = {};
+  primary_task_queue_.Clear();
+  secondary_task_queue_.Clear();
 }
 
-void TaskSource::RegisterTask(const DelayedTask& task) {
+void TaskSource::RegisterTask(DelayedTask task) {
   switch (task.GetTaskSourceGrade()) {
     case TaskSourceGrade::kUserInteraction:
-      primary_task_queue_.push(task);
+      primary_task_queue_.Push(std::move(task));
       break;
     case TaskSourceGrade::kUnspecified:
-      primary_task_queue_.push(task);
+      primary_task_queue_.Push(std::move(task));
       break;
     case TaskSourceGrade::kDartMicroTasks:
-      secondary_task_queue_.push(task);
+      secondary_task_queue_.Push(std::move(task));
       break;
   }
 }
 
-void TaskSource::PopTask(TaskSourceGrade grade) {
+fml::UniqueClosure TaskSource::PopTask(TaskSourceGrade grade) {
   switch (grade) {
     case TaskSourceGrade::kUserInteraction:
-      primary_task_queue_.pop();
-      break;
+      return primary_task_queue_.Pop().TakeTask();
     case TaskSourceGrade::kUnspecified:
-      primary_task_queue_.pop();
-      break;
+      return primary_task_queue_.Pop().TakeTask();
     case TaskSourceGrade::kDartMicroTasks:
-      secondary_task_queue_.pop();
-      break;
+      return secondary_task_queue_.Pop().TakeTask();
   }
+  return nullptr;
 }
 
 size_t TaskSource::GetNumPendingTasks() const {
@@ -63,20 +61,20 @@ bool TaskSource::IsEmpty() const {
 TaskSource::TopTask TaskSource::Top() const {
   FML_CHECK(!IsEmpty());
   if (secondary_pause_requests_ > 0 || secondary_task_queue_.empty()) {
-    const auto& primary_top = primary_task_queue_.top();
+    const auto& primary_top = primary_task_queue_.Top();
     return {
         .task_queue_id = task_queue_id_,
         .task = primary_top,
     };
   } else if (primary_task_queue_.empty()) {
-    const auto& secondary_top = secondary_task_queue_.top();
+    const auto& secondary_top = secondary_task_queue_.Top();
     return {
         .task_queue_id = task_queue_id_,
         .task = secondary_top,
     };
   } else {
-    const auto& primary_top = primary_task_queue_.top();
-    const auto& secondary_top = secondary_task_queue_.top();
+    const auto& primary_top = primary_task_queue_.Top();
+    const auto& secondary_top = secondary_task_queue_.Top();
     if (primary_top > secondary_top) {
       return {
           .task_queue_id = task_queue_id_,
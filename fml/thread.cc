@@ -13,6 +13,7 @@
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/trace_ring_buffer.h"
 
 #if defined(FML_OS_WIN)
 #include <windows.h>
@@ -67,6 +68,14 @@ void Thread::SetCurrentThreadName(const Thread::ThreadConfig& config) {
   SetThreadName(config.name);
 }
 
+void Thread::SetCurrentThreadAffinity(const Thread::ThreadConfig& config) {
+  if (config.cpu_mask != 0) {
+    SetCurrentThreadCpuMask(config.cpu_mask);
+  } else if (config.affinity != CpuAffinity::kAny) {
+    RequestAffinity(config.affinity);
+  }
+}
+
 Thread::Thread(const std::string& name)
     : Thread(Thread::SetCurrentThreadName, ThreadConfig(name)) {}
 
@@ -78,6 +87,8 @@ Thread::Thread(const ThreadConfigSetter& setter, const ThreadConfig& config)
   thread_ = std::make_unique<std::thread>(
       [&latch, &runner, setter, config]() -> void {
         setter(config);
+        SetCurrentThreadAffinity(config);
+        fml::tracing::TraceRingBufferSetThreadName(config.name);
         fml::MessageLoop::EnsureInitializedForCurrentThread();
         auto& loop = MessageLoop::GetCurrent();
         runner = loop.GetTaskRunner();
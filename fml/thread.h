@@ -11,6 +11,7 @@
 #include <string>
 #include <thread>
 
+#include "flutter/fml/cpu_affinity.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
 
@@ -30,7 +31,8 @@ class Thread {
     RASTER,
   };
 
-  /// The ThreadConfig is the thread info include thread name, thread priority.
+  /// The ThreadConfig is the thread info include thread name, thread priority
+  /// and the CPUs the thread runs on.
   struct ThreadConfig {
     ThreadConfig(const std::string& name, ThreadPriority priority)
         : name(name), priority(priority) {}
@@ -42,6 +44,11 @@ class Thread {
 
     std::string name;
     ThreadPriority priority;
+    /// The kind of cores the thread prefers to run on.
+    CpuAffinity affinity = CpuAffinity::kAny;
+    /// The CPUs the thread may run on, one bit per CPU. If not zero, this
+    /// takes precedence over |affinity|.
+    uint64_t cpu_mask = 0;
   };
 
   using ThreadConfigSetter = std::function<void(const ThreadConfig&)>;
@@ -59,6 +66,10 @@ class Thread {
 
   static void SetCurrentThreadName(const ThreadConfig& config);
 
+  /// Applies the |affinity| and |cpu_mask| of the config to the current
+  /// thread. Threads apply them on their own after the config setter runs.
+  static void SetCurrentThreadAffinity(const ThreadConfig& config);
+
  private:
   std::unique_ptr<std::thread> thread_;
 
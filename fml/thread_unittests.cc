@@ -4,6 +4,8 @@
 
 #include "flutter/fml/thread.h"
 
+#include "flutter/fml/build_config.h"
+
 #if defined(OS_MACOSX) || defined(OS_LINUX) || defined(OS_ANDROID)
 #define FLUTTER_PTHREAD_SUPPORTED 1
 #else
@@ -16,6 +18,11 @@
 #endif
 
 #include <memory>
+
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+#include <sched.h>
+#endif
+
 #include "gtest/gtest.h"
 
 TEST(Thread, CanStartAndEnd) {
@@ -110,3 +117,20 @@ TEST(Thread, ThreadPriorityCreatedWithConfig) {
   ASSERT_TRUE(done);
 }
 #endif
+
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+TEST(Thread, ThreadCpuMaskCreatedWithConfig) {
+  fml::Thread::ThreadConfig config("Pinned");
+  config.cpu_mask = 1;
+  fml::Thread thread(fml::Thread::SetCurrentThreadName, config);
+
+  bool pinned = false;
+  thread.GetTaskRunner()->PostTask([&pinned]() {
+    cpu_set_t set;
+    pinned = sched_getaffinity(0, sizeof(set), &set) == 0 &&
+             CPU_COUNT(&set) == 1 && CPU_ISSET(0, &set);
+  });
+  thread.Join();
+  ASSERT_TRUE(pinned);
+}
+#endif
@@ -6,11 +6,13 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cstdlib>
 #include <utility>
 
 #include "flutter/fml/ascii_trie.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_ring_buffer.h"
 
 namespace fml {
 namespace tracing {
@@ -28,6 +30,14 @@ inline void FlutterTimelineEvent(const char* label,
                                  intptr_t argument_count,
                                  const char** argument_names,
                                  const char** argument_values) {
+  if (TraceRingBufferIsEnabled()) {
+    const int64_t value = type == Dart_Timeline_Event_Counter &&
+                                  argument_count > 0 && argument_values[0]
+                              ? strtoll(argument_values[0], nullptr, 10)
+                              : 0;
+    TraceRingBufferRecord(label, timestamp0, timestamp1_or_async_id, type,
+                          value);
+  }
   if (gTimelineEventHandler && gAllowlist.Query(label)) {
     gTimelineEventHandler(label, timestamp0, timestamp1_or_async_id, type,
                           argument_count, argument_names, argument_values);
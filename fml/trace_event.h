@@ -43,6 +43,7 @@
 #include <type_traits>
 #include <vector>
 
+#include "flutter/fml/allocation_tracker.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_point.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
@@ -58,9 +59,19 @@
 
 #define __FML__TOKEN_CAT__(x, y) x##y
 #define __FML__TOKEN_CAT__2(x, y) __FML__TOKEN_CAT__(x, y)
+#if FLUTTER_TRACK_ALLOCATIONS
+// Also reports the allocations made in the scope, which are counted before
+// the scoped trace ends.
+#define __FML__AUTO_TRACE_END(name)                                        \
+  ::fml::tracing::ScopedInstantEnd __FML__TOKEN_CAT__2(__trace_end_,       \
+                                                       __LINE__)(name);    \
+  ::fml::tracing::ScopedAllocationCounter __FML__TOKEN_CAT__2(             \
+      __trace_allocations_, __LINE__)(name);
+#else  // FLUTTER_TRACK_ALLOCATIONS
 #define __FML__AUTO_TRACE_END(name)                                  \
   ::fml::tracing::ScopedInstantEnd __FML__TOKEN_CAT__2(__trace_end_, \
                                                        __LINE__)(name);
+#endif  // FLUTTER_TRACK_ALLOCATIONS
 
 // This macro has the FML_ prefix so that it does not collide with the macros
 // from lib/trace/event.h on Fuchsia.
@@ -353,6 +364,31 @@ class ScopedInstantEnd {
   FML_DISALLOW_COPY_AND_ASSIGN(ScopedInstantEnd);
 };
 
+// Reports the number and size of the heap allocations that the thread made
+// while it is alive as a counter with the given name, which includes the
+// allocations of the nested scopes. Only counts allocations in builds that
+// track them. See |IsAllocationTrackingEnabled|.
+class ScopedAllocationCounter {
+ public:
+  explicit ScopedAllocationCounter(const char* name)
+      : name_(name), start_(GetThreadAllocationCounts()) {}
+
+  ~ScopedAllocationCounter() {
+    if (!IsAllocationTrackingEnabled()) {
+      return;
+    }
+    const AllocationCounts counts = GetThreadAllocationCounts() - start_;
+    TraceCounter("flutter", name_, 0, "allocations", counts.count,
+                 "allocated_bytes", counts.bytes);
+  }
+
+ private:
+  const char* name_;
+  const AllocationCounts start_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ScopedAllocationCounter);
+};
+
 // A move-only utility object that creates a new flow with a unique ID and
 // automatically ends it when it goes out of scope. When tracing using multiple
 // overlapping flows, it often gets hard to make sure to end the flow
@@ -0,0 +1,351 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_ring_buffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include "flutter/fml/thread_local.h"
+
+namespace fml {
+namespace tracing {
+
+namespace {
+
+constexpr size_t kNameWordCount =
+    (kTraceRingBufferMaxNameLength + sizeof(uint64_t)) / sizeof(uint64_t);
+
+// All of the fields are atomics so that a dump can read a slot while its
+// thread overwrites it. The sequence is odd while the slot is being written,
+// and is twice the position of the event plus two once it is done, which lets
+// the dump discard the slots that have been overwritten since it started.
+struct Slot {
+  std::atomic<uint64_t> sequence = 0;
+  std::atomic<int64_t> timestamp = 0;
+  std::atomic<int64_t> id = 0;
+  std::atomic<int64_t> value = 0;
+  std::atomic<int32_t> type = 0;
+  std::atomic<uint64_t> name[kNameWordCount] = {};
+};
+
+struct ThreadBuffer {
+  explicit ThreadBuffer(int64_t thread_id) : thread_id(thread_id) {}
+
+  ~ThreadBuffer() { delete[] slots.load(); }
+
+  const int64_t thread_id;
+  // Guarded by the registry mutex.
+  std::string thread_name;
+  std::atomic_bool exited = false;
+  // Only written by the thread, which allocates the slots on its first event.
+  std::atomic<Slot*> slots = nullptr;
+  std::atomic<uint64_t> head = 0;
+  // The position of the first event that has not been cleared.
+  std::atomic<uint64_t> tail = 0;
+};
+
+class ThreadBufferHolder {
+ public:
+  explicit ThreadBufferHolder(std::shared_ptr<ThreadBuffer> buffer)
+      : buffer_(std::move(buffer)) {}
+
+  ~ThreadBufferHolder() { buffer_->exited = true; }
+
+  ThreadBuffer& buffer() const { return *buffer_; }
+
+ private:
+  std::shared_ptr<ThreadBuffer> buffer_;
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  int64_t last_thread_id = 0;
+};
+
+std::atomic_bool gEnabled = false;
+
+FML_THREAD_LOCAL ThreadLocalUniquePtr<ThreadBufferHolder> tls_buffer;
+
+Registry& GetRegistry() {
+  // Leaked so that threads can still record while the process exits.
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+ThreadBuffer& GetThreadBuffer() {
+  if (auto holder = tls_buffer.get()) {
+    return holder->buffer();
+  }
+  auto& registry = GetRegistry();
+  std::shared_ptr<ThreadBuffer> buffer;
+  {
+    std::scoped_lock lock(registry.mutex);
+    // The events of the threads that have exited are kept until another
+    // thread starts recording.
+    auto& buffers = registry.buffers;
+    buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                                 [](const auto& buffer) {
+                                   return buffer->exited.load();
+                                 }),
+                  buffers.end());
+    buffer = std::make_shared<ThreadBuffer>(++registry.last_thread_id);
+    registry.buffers.push_back(buffer);
+  }
+  tls_buffer.reset(new ThreadBufferHolder(std::move(buffer)));
+  return tls_buffer.get()->buffer();
+}
+
+// Appends the events of the buffer that have not been overwritten while they
+// were read, oldest first.
+void ReadEvents(const ThreadBuffer& buffer,
+                std::vector<TraceRingBufferEvent>& events) {
+  const Slot* slots = buffer.slots.load(std::memory_order_acquire);
+  if (slots == nullptr) {
+    return;
+  }
+  const uint64_t head = buffer.head.load(std::memory_order_acquire);
+  uint64_t position = buffer.tail.load(std::memory_order_relaxed);
+  if (head - std::min(position, head) > kTraceRingBufferEventCount) {
+    position = head - kTraceRingBufferEventCount;
+  }
+  for (; position < head; position++) {
+    const Slot& slot = slots[position % kTraceRingBufferEventCount];
+    const uint64_t sequence = position * 2 + 2;
+    if (slot.sequence.load(std::memory_order_acquire) != sequence) {
+      continue;
+    }
+    TraceRingBufferEvent event;
+    event.timestamp_micros = slot.timestamp.load(std::memory_order_relaxed);
+    event.id = slot.id.load(std::memory_order_relaxed);
+    event.value = slot.value.load(std::memory_order_relaxed);
+    event.type = static_cast<Dart_Timeline_Event_Type>(
+        slot.type.load(std::memory_order_relaxed));
+    char name[kNameWordCount * sizeof(uint64_t)];
+    for (size_t i = 0; i < kNameWordCount; i++) {
+      const uint64_t word = slot.name[i].load(std::memory_order_relaxed);
+      memcpy(name + i * sizeof(uint64_t), &word, sizeof(word));
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+      continue;
+    }
+    event.name.assign(name, strnlen(name, sizeof(name)));
+    event.thread_id = buffer.thread_id;
+    events.push_back(std::move(event));
+  }
+}
+
+void WriteJsonString(std::ostream& stream, const std::string& string) {
+  stream << '"';
+  for (const char c : string) {
+    switch (c) {
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          static constexpr char kHexDigits[] = "0123456789abcdef";
+          stream << "\\u00" << kHexDigits[c >> 4] << kHexDigits[c & 0xf];
+        } else {
+          stream << c;
+        }
+    }
+  }
+  stream << '"';
+}
+
+// Returns the Chrome trace phase of the event type, or null if it has none.
+const char* GetPhase(Dart_Timeline_Event_Type type) {
+  switch (type) {
+    case Dart_Timeline_Event_Begin:
+      return "B";
+    case Dart_Timeline_Event_End:
+      return "E";
+    case Dart_Timeline_Event_Instant:
+      return "i";
+    case Dart_Timeline_Event_Duration:
+      return "X";
+    case Dart_Timeline_Event_Async_Begin:
+      return "b";
+    case Dart_Timeline_Event_Async_End:
+      return "e";
+    case Dart_Timeline_Event_Async_Instant:
+      return "n";
+    case Dart_Timeline_Event_Counter:
+      return "C";
+    case Dart_Timeline_Event_Flow_Begin:
+      return "s";
+    case Dart_Timeline_Event_Flow_Step:
+      return "t";
+    case Dart_Timeline_Event_Flow_End:
+      return "f";
+    default:
+      return nullptr;
+  }
+}
+
+void WriteEvent(std::ostream& stream, const TraceRingBufferEvent& event) {
+  const char* phase = GetPhase(event.type);
+  if (phase == nullptr) {
+    return;
+  }
+  stream << ",{\"name\":";
+  WriteJsonString(stream, event.name);
+  stream << ",\"cat\":\"flutter\",\"ph\":\"" << phase << "\",\"ts\":"
+         << event.timestamp_micros << ",\"pid\":0,\"tid\":" << event.thread_id;
+  switch (event.type) {
+    case Dart_Timeline_Event_Instant:
+      stream << ",\"s\":\"t\"";
+      break;
+    case Dart_Timeline_Event_Duration:
+      stream << ",\"dur\":" << event.id - event.timestamp_micros;
+      break;
+    case Dart_Timeline_Event_Async_Begin:
+    case Dart_Timeline_Event_Async_End:
+    case Dart_Timeline_Event_Async_Instant:
+    case Dart_Timeline_Event_Flow_Begin:
+    case Dart_Timeline_Event_Flow_Step:
+    case Dart_Timeline_Event_Flow_End:
+      stream << ",\"id\":\"0x" << std::hex << event.id << std::dec << "\"";
+      break;
+    case Dart_Timeline_Event_Counter:
+      stream << ",\"id\":\"0x" << std::hex << event.id << std::dec
+             << "\",\"args\":{\"value\":" << event.value << "}";
+      break;
+    default:
+      break;
+  }
+  stream << "}";
+}
+
+}  // namespace
+
+void TraceRingBufferSetEnabled(bool enabled) {
+  gEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool TraceRingBufferIsEnabled() {
+  return gEnabled.load(std::memory_order_relaxed);
+}
+
+void TraceRingBufferRecord(const char* name,
+                           int64_t timestamp_micros,
+                           int64_t id,
+                           Dart_Timeline_Event_Type type,
+                           int64_t value) {
+  if (!TraceRingBufferIsEnabled() || name == nullptr) {
+    return;
+  }
+  ThreadBuffer& buffer = GetThreadBuffer();
+  Slot* slots = buffer.slots.load(std::memory_order_relaxed);
+  if (slots == nullptr) {
+    slots = new Slot[kTraceRingBufferEventCount];
+    buffer.slots.store(slots, std::memory_order_release);
+  }
+
+  size_t length = strnlen(name, kTraceRingBufferMaxNameLength + 1);
+  if (length > kTraceRingBufferMaxNameLength) {
+    length = kTraceRingBufferMaxNameLength;
+    // Does not leave a partial UTF-8 sequence at the end.
+    while (length > 0 && (name[length] & 0xc0) == 0x80) {
+      length--;
+    }
+  }
+  char name_words[kNameWordCount * sizeof(uint64_t)] = {};
+  memcpy(name_words, name, length);
+
+  const uint64_t position = buffer.head.load(std::memory_order_relaxed);
+  Slot& slot = slots[position % kTraceRingBufferEventCount];
+  slot.sequence.store(position * 2 + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.timestamp.store(timestamp_micros, std::memory_order_relaxed);
+  slot.id.store(id, std::memory_order_relaxed);
+  slot.value.store(value, std::memory_order_relaxed);
+  slot.type.store(type, std::memory_order_relaxed);
+  for (size_t i = 0; i < kNameWordCount; i++) {
+    uint64_t word;
+    memcpy(&word, name_words + i * sizeof(uint64_t), sizeof(word));
+    slot.name[i].store(word, std::memory_order_relaxed);
+  }
+  slot.sequence.store(position * 2 + 2, std::memory_order_release);
+  buffer.head.store(position + 1, std::memory_order_release);
+}
+
+void TraceRingBufferSetThreadName(const std::string& name) {
+  ThreadBuffer& buffer = GetThreadBuffer();
+  auto& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  buffer.thread_name = name;
+}
+
+std::string TraceRingBufferToChromeTraceJson() {
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  std::vector<std::string> thread_names;
+  {
+    auto& registry = GetRegistry();
+    std::scoped_lock lock(registry.mutex);
+    buffers = registry.buffers;
+    for (const auto& buffer : buffers) {
+      thread_names.push_back(buffer->thread_name);
+    }
+  }
+
+  std::ostringstream stream;
+  stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  // Leads with an event so that all of the others can start with a comma.
+  stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,"
+            "\"args\":{\"name\":\"flutter\"}}";
+  for (size_t i = 0; i < buffers.size(); i++) {
+    const int64_t thread_id = buffers[i]->thread_id;
+    if (!thread_names[i].empty()) {
+      stream << ",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":"
+             << thread_id << ",\"args\":{\"name\":";
+      WriteJsonString(stream, thread_names[i]);
+      stream << "}}";
+    }
+    std::vector<TraceRingBufferEvent> events;
+    ReadEvents(*buffers[i], events);
+    for (const auto& event : events) {
+      WriteEvent(stream, event);
+    }
+  }
+  stream << "]}";
+  return stream.str();
+}
+
+std::vector<TraceRingBufferEvent> TraceRingBufferGetEvents() {
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  {
+    auto& registry = GetRegistry();
+    std::scoped_lock lock(registry.mutex);
+    buffers = registry.buffers;
+  }
+  std::vector<TraceRingBufferEvent> events;
+  for (const auto& buffer : buffers) {
+    ReadEvents(*buffer, events);
+  }
+  return events;
+}
+
+void TraceRingBufferClear() {
+  auto& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  for (const auto& buffer : registry.buffers) {
+    buffer->tail.store(buffer->head.load(std::memory_order_acquire),
+                       std::memory_order_relaxed);
+  }
+}
+
+}  // namespace tracing
+}  // namespace fml
@@ -0,0 +1,96 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_RING_BUFFER_H_
+#define FLUTTER_FML_TRACE_RING_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "third_party/dart/runtime/include/dart_tools_api.h"
+
+namespace fml {
+namespace tracing {
+
+//------------------------------------------------------------------------------
+/// The trace ring buffer is an in-process flight recorder for the events of
+/// the `TRACE_EVENT*` macros. Each thread records into its own fixed size ring
+/// buffer without taking locks, so that it can be left on in production, and
+/// the most recent events of all threads can be dumped at any time in the
+/// Chrome trace event JSON format, which Perfetto can import as well.
+///
+/// Recording is disabled by default.
+///
+
+/// The number of events each thread keeps before overwriting the oldest ones.
+constexpr size_t kTraceRingBufferEventCount = 2048;
+
+/// Event names longer than this are truncated.
+constexpr size_t kTraceRingBufferMaxNameLength = 47;
+
+void TraceRingBufferSetEnabled(bool enabled);
+
+bool TraceRingBufferIsEnabled();
+
+//------------------------------------------------------------------------------
+/// @brief      Records an event into the ring buffer of the current thread if
+///             recording is enabled.
+///
+/// @param[in]  name              The name of the event. It is copied.
+/// @param[in]  timestamp_micros  The time of the event on the timeline clock.
+/// @param[in]  id                The id of async and flow events, or the end
+///                               time of duration events.
+/// @param[in]  type              The type of the event.
+/// @param[in]  value             The value of counter events.
+///
+void TraceRingBufferRecord(const char* name,
+                           int64_t timestamp_micros,
+                           int64_t id,
+                           Dart_Timeline_Event_Type type,
+                           int64_t value = 0);
+
+//------------------------------------------------------------------------------
+/// @brief      Names the current thread in the dumps.
+///
+void TraceRingBufferSetThreadName(const std::string& name);
+
+//------------------------------------------------------------------------------
+/// @brief      Dumps the events recorded by all of the threads as a Chrome
+///             trace event JSON object. It may be called from any thread while
+///             the others keep recording.
+///
+std::string TraceRingBufferToChromeTraceJson();
+
+/// An event read back from the ring buffers.
+struct TraceRingBufferEvent {
+  std::string name;
+  int64_t timestamp_micros;
+  /// The id of async and flow events, or the end time of duration events.
+  int64_t id;
+  int64_t value;
+  Dart_Timeline_Event_Type type;
+  /// Identifies the thread that recorded the event within the process. It is
+  /// not the id of the thread in the system.
+  int64_t thread_id;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Returns the events recorded by all of the threads, oldest first
+///             for each thread, so that tools such as benchmarks can
+///             summarize them without a dump. It may be called from any thread
+///             while the others keep recording.
+///
+std::vector<TraceRingBufferEvent> TraceRingBufferGetEvents();
+
+//------------------------------------------------------------------------------
+/// @brief      Drops all of the events recorded so far.
+///
+void TraceRingBufferClear();
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TRACE_RING_BUFFER_H_
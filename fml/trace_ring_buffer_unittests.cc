@@ -0,0 +1,180 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_ring_buffer.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+namespace {
+
+size_t CountOccurrences(const std::string& string, const std::string& part) {
+  size_t count = 0;
+  for (size_t position = string.find(part); position != std::string::npos;
+       position = string.find(part, position + part.size())) {
+    count++;
+  }
+  return count;
+}
+
+class TraceRingBufferTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    TraceRingBufferClear();
+    TraceRingBufferSetEnabled(true);
+  }
+
+  void TearDown() override {
+    TraceRingBufferSetEnabled(false);
+    TraceRingBufferClear();
+  }
+};
+
+}  // namespace
+
+TEST_F(TraceRingBufferTest, RecordsNothingWhenDisabled) {
+  TraceRingBufferSetEnabled(false);
+  TraceRingBufferRecord("Disabled", 1, 0, Dart_Timeline_Event_Begin);
+
+  const auto json = TraceRingBufferToChromeTraceJson();
+  EXPECT_EQ(json.find("Disabled"), std::string::npos);
+}
+
+TEST_F(TraceRingBufferTest, DumpsEventsInChromeTraceFormat) {
+  TraceRingBufferRecord("Frame", 10, 0, Dart_Timeline_Event_Begin);
+  TraceRingBufferRecord("Frame", 20, 0, Dart_Timeline_Event_End);
+  TraceRingBufferRecord("Load", 30, 42, Dart_Timeline_Event_Async_Begin);
+  TraceRingBufferRecord("Memory", 40, 7, Dart_Timeline_Event_Counter, 1024);
+
+  const auto json = TraceRingBufferToChromeTraceJson();
+  EXPECT_EQ(json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0u);
+  EXPECT_NE(json.find("\"name\":\"Frame\",\"cat\":\"flutter\",\"ph\":\"B\","
+                      "\"ts\":10,"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"Frame\",\"cat\":\"flutter\",\"ph\":\"E\","
+                      "\"ts\":20,"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"ph\":\"b\",\"ts\":30,"), std::string::npos);
+  EXPECT_NE(json.find("\"id\":\"0x2a\""), std::string::npos);
+  EXPECT_NE(json.find("\"ph\":\"C\",\"ts\":40,"), std::string::npos);
+  EXPECT_NE(json.find("\"args\":{\"value\":1024}"), std::string::npos);
+  EXPECT_LT(json.find("\"ts\":10,"), json.find("\"ts\":20,"));
+}
+
+TEST_F(TraceRingBufferTest, ReturnsTheRecordedEvents) {
+  TraceRingBufferRecord("Frame", 10, 0, Dart_Timeline_Event_Begin);
+  TraceRingBufferRecord("Memory", 20, 7, Dart_Timeline_Event_Counter, 1024);
+
+  const auto events = TraceRingBufferGetEvents();
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].name, "Frame");
+  EXPECT_EQ(events[0].timestamp_micros, 10);
+  EXPECT_EQ(events[0].type, Dart_Timeline_Event_Begin);
+  EXPECT_EQ(events[1].name, "Memory");
+  EXPECT_EQ(events[1].id, 7);
+  EXPECT_EQ(events[1].value, 1024);
+  EXPECT_EQ(events[0].thread_id, events[1].thread_id);
+}
+
+TEST_F(TraceRingBufferTest, KeepsTheMostRecentEvents) {
+  const size_t overwritten_count = 10;
+  for (size_t i = 0; i < kTraceRingBufferEventCount + overwritten_count; i++) {
+    TraceRingBufferRecord(("Event " + std::to_string(i) + ".").c_str(), i, 0,
+                          Dart_Timeline_Event_Instant);
+  }
+
+  const auto json = TraceRingBufferToChromeTraceJson();
+  EXPECT_EQ(CountOccurrences(json, "\"ph\":\"i\""), kTraceRingBufferEventCount);
+  EXPECT_EQ(json.find("\"Event 9.\""), std::string::npos);
+  EXPECT_NE(json.find("\"Event 10.\""), std::string::npos);
+  EXPECT_NE(json.find("\"Event " +
+                      std::to_string(kTraceRingBufferEventCount + 9) + ".\""),
+            std::string::npos);
+}
+
+TEST_F(TraceRingBufferTest, ClearDropsTheRecordedEvents) {
+  TraceRingBufferRecord("Before", 1, 0, Dart_Timeline_Event_Instant);
+  TraceRingBufferClear();
+  TraceRingBufferRecord("After", 2, 0, Dart_Timeline_Event_Instant);
+
+  const auto json = TraceRingBufferToChromeTraceJson();
+  EXPECT_EQ(json.find("Before"), std::string::npos);
+  EXPECT_NE(json.find("After"), std::string::npos);
+}
+
+TEST_F(TraceRingBufferTest, EscapesAndTruncatesNames) {
+  TraceRingBufferRecord("Quote \" and \\ and \n", 1, 0,
+                        Dart_Timeline_Event_Instant);
+  const std::string long_name(kTraceRingBufferMaxNameLength - 1, 'a');
+  // The two byte character does not fit, so it is dropped whole.
+  TraceRingBufferRecord((long_name + "\xc3\xa9").c_str(), 2, 0,
+                        Dart_Timeline_Event_Instant);
+
+  const auto json = TraceRingBufferToChromeTraceJson();
+  EXPECT_NE(json.find("\"Quote \\\" and \\\\ and \\u000a\""),
+            std::string::npos);
+  EXPECT_NE(json.find("\"" + long_name + "\""), std::string::npos);
+}
+
+TEST_F(TraceRingBufferTest, ThreadsRecordIntoTheirOwnNamedBuffers) {
+  std::thread thread([] {
+    TraceRingBufferSetThreadName("worker");
+    TraceRingBufferRecord("OnWorker", 1, 0, Dart_Timeline_Event_Instant);
+  });
+  thread.join();
+  TraceRingBufferRecord("OnMain", 2, 0, Dart_Timeline_Event_Instant);
+
+  const auto json = TraceRingBufferToChromeTraceJson();
+  const auto worker_name = json.find("\"args\":{\"name\":\"worker\"}");
+  ASSERT_NE(worker_name, std::string::npos);
+  const auto worker_tid = json.rfind("\"tid\":", worker_name);
+  const auto worker_event = json.find("\"OnWorker\"");
+  const auto main_event = json.find("\"OnMain\"");
+  ASSERT_NE(worker_event, std::string::npos);
+  ASSERT_NE(main_event, std::string::npos);
+  const auto tid_of = [&json](size_t event) {
+    const auto tid = json.find("\"tid\":", event);
+    return json.substr(tid, json.find_first_of(",}", tid) - tid);
+  };
+  EXPECT_EQ(tid_of(worker_event),
+            json.substr(worker_tid, json.find(',', worker_tid) - worker_tid));
+  EXPECT_NE(tid_of(worker_event), tid_of(main_event));
+}
+
+TEST_F(TraceRingBufferTest, DumpsWhileThreadsRecord) {
+  std::atomic_bool done = false;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 4; i++) {
+    threads.emplace_back([&done] {
+      for (int64_t timestamp = 0; !done; timestamp++) {
+        TraceRingBufferRecord("Work", timestamp, 0, Dart_Timeline_Event_Begin);
+        TraceRingBufferRecord("Work", timestamp, 0, Dart_Timeline_Event_End);
+      }
+    });
+  }
+
+  for (size_t i = 0; i < 20; i++) {
+    const auto json = TraceRingBufferToChromeTraceJson();
+    EXPECT_EQ(json.substr(json.size() - 2), "]}");
+    EXPECT_LE(CountOccurrences(json, "\"Work\""),
+              threads.size() * kTraceRingBufferEventCount);
+  }
+
+  done = true;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
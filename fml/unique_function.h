@@ -0,0 +1,188 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_UNIQUE_FUNCTION_H_
+#define FLUTTER_FML_UNIQUE_FUNCTION_H_
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+template <typename Signature>
+class UniqueFunction;
+
+//------------------------------------------------------------------------------
+/// @brief      A move-only counterpart of `std::function`.
+///
+///             Since it never has to be copied, it accepts callables with
+///             move-only captures without the need for `fml::MakeCopyable`.
+///             Callables of up to `kInlineSize` bytes, which holds most of the
+///             lambdas posted as tasks as well as a whole `std::function`, are
+///             stored inline rather than allocated on the heap.
+///
+template <typename R, typename... Args>
+class UniqueFunction<R(Args...)> {
+ public:
+  static constexpr size_t kInlineSize = 8 * sizeof(void*);
+
+  UniqueFunction() = default;
+
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  UniqueFunction(std::nullptr_t) {}
+
+  template <typename F,
+            typename Callable = std::decay_t<F>,
+            typename = std::enable_if_t<
+                !std::is_same_v<Callable, UniqueFunction> &&
+                std::is_invocable_r_v<R, Callable&, Args...>>>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  UniqueFunction(F&& function) {
+    if (IsNull(function)) {
+      return;
+    }
+    if constexpr (IsStoredInline<Callable>()) {
+      new (storage_) Callable(std::forward<F>(function));
+      ops_ = &InlineOps<Callable>::kOps;
+    } else {
+      *reinterpret_cast<Callable**>(storage_) =
+          new Callable(std::forward<F>(function));
+      ops_ = &HeapOps<Callable>::kOps;
+    }
+  }
+
+  UniqueFunction(UniqueFunction&& other) { MoveFrom(other); }
+
+  UniqueFunction& operator=(UniqueFunction&& other) {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  UniqueFunction& operator=(std::nullptr_t) {
+    Reset();
+    return *this;
+  }
+
+  ~UniqueFunction() { Reset(); }
+
+  explicit operator bool() const { return ops_ != nullptr; }
+
+  friend bool operator==(const UniqueFunction& function, std::nullptr_t) {
+    return !function;
+  }
+
+  friend bool operator!=(const UniqueFunction& function, std::nullptr_t) {
+    return static_cast<bool>(function);
+  }
+
+  R operator()(Args... args) const {
+    FML_DCHECK(ops_);
+    return ops_->invoke(storage_, std::forward<Args>(args)...);
+  }
+
+ private:
+  struct Ops {
+    R (*invoke)(void* storage, Args&&... args);
+    // Move constructs the callable in |to| and destroys the one in |from|.
+    void (*move)(void* from, void* to);
+    void (*destroy)(void* storage);
+  };
+
+  template <typename Callable>
+  struct InlineOps {
+    static R Invoke(void* storage, Args&&... args) {
+      return (*static_cast<Callable*>(storage))(std::forward<Args>(args)...);
+    }
+
+    static void Move(void* from, void* to) {
+      new (to) Callable(std::move(*static_cast<Callable*>(from)));
+      static_cast<Callable*>(from)->~Callable();
+    }
+
+    static void Destroy(void* storage) {
+      static_cast<Callable*>(storage)->~Callable();
+    }
+
+    static constexpr Ops kOps = {&Invoke, &Move, &Destroy};
+  };
+
+  template <typename Callable>
+  struct HeapOps {
+    static R Invoke(void* storage, Args&&... args) {
+      return (**static_cast<Callable**>(storage))(std::forward<Args>(args)...);
+    }
+
+    static void Move(void* from, void* to) {
+      *static_cast<Callable**>(to) = *static_cast<Callable**>(from);
+    }
+
+    static void Destroy(void* storage) {
+      delete *static_cast<Callable**>(storage);
+    }
+
+    static constexpr Ops kOps = {&Invoke, &Move, &Destroy};
+  };
+
+  template <typename T>
+  struct IsStdFunction : std::false_type {};
+
+  template <typename T>
+  struct IsStdFunction<std::function<T>> : std::true_type {};
+
+  template <typename Callable>
+  static constexpr bool IsStoredInline() {
+    return sizeof(Callable) <= kInlineSize &&
+           alignof(Callable) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible_v<Callable>;
+  }
+
+  // Wrapping an empty std::function or a null function pointer gives an empty
+  // function, like it does for std::function.
+  template <typename F>
+  static bool IsNull(const F& function) {
+    using Callable = std::decay_t<F>;
+    if constexpr (std::is_pointer_v<Callable> ||
+                  std::is_member_pointer_v<Callable> ||
+                  IsStdFunction<Callable>::value) {
+      return function == nullptr;
+    } else {
+      return false;
+    }
+  }
+
+  void MoveFrom(UniqueFunction& other) {
+    if (other.ops_) {
+      other.ops_->move(other.storage_, storage_);
+      ops_ = other.ops_;
+      other.ops_ = nullptr;
+    }
+  }
+
+  void Reset() {
+    if (ops_) {
+      // Cleared first in case destroying the callable reenters.
+      const Ops* ops = ops_;
+      ops_ = nullptr;
+      ops->destroy(storage_);
+    }
+  }
+
+  const Ops* ops_ = nullptr;
+  alignas(std::max_align_t) mutable unsigned char storage_[kInlineSize];
+
+  FML_DISALLOW_COPY_AND_ASSIGN(UniqueFunction);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_UNIQUE_FUNCTION_H_
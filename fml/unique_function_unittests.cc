@@ -0,0 +1,127 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/unique_function.h"
+
+#include <array>
+#include <memory>
+
+#include "flutter/fml/closure.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+namespace {
+
+// Records where it is stored when it is invoked.
+template <size_t kPaddingSize>
+struct AddressRecorder {
+  const void** address;
+  std::array<char, kPaddingSize> padding = {};
+
+  void operator()() const { *address = this; }
+};
+
+bool IsStoredIn(const void* address, const UniqueClosure& closure) {
+  const char* begin = reinterpret_cast<const char*>(&closure);
+  const char* end = begin + sizeof(closure);
+  return address >= begin && address < end;
+}
+
+}  // namespace
+
+TEST(UniqueFunctionTest, InvokesCallablesWithMoveOnlyCaptures) {
+  auto value = std::make_unique<int>(3);
+  UniqueFunction<int(int)> function = [value = std::move(value)](int x) {
+    return *value + x;
+  };
+
+  ASSERT_TRUE(function);
+  EXPECT_EQ(function(4), 7);
+}
+
+TEST(UniqueFunctionTest, SmallCallablesAreStoredInline) {
+  const void* address = nullptr;
+  UniqueClosure closure =
+      AddressRecorder<UniqueClosure::kInlineSize - sizeof(void*)>{&address};
+
+  closure();
+  EXPECT_TRUE(IsStoredIn(address, closure));
+
+  UniqueClosure moved = std::move(closure);
+  moved();
+  EXPECT_TRUE(IsStoredIn(address, moved));
+}
+
+TEST(UniqueFunctionTest, StdFunctionsAreStoredInline) {
+  const void* address = nullptr;
+  fml::closure function = AddressRecorder<0>{&address};
+  UniqueClosure closure = function;
+
+  // The recorder is stored inline in the std::function, which is in turn
+  // stored inline in the closure.
+  closure();
+  EXPECT_TRUE(IsStoredIn(address, closure));
+}
+
+TEST(UniqueFunctionTest, LargeCallablesAreStoredOnTheHeap) {
+  const void* address = nullptr;
+  UniqueClosure closure =
+      AddressRecorder<UniqueClosure::kInlineSize>{&address};
+
+  closure();
+  const void* heap_address = address;
+  EXPECT_FALSE(IsStoredIn(heap_address, closure));
+
+  UniqueClosure moved = std::move(closure);
+  moved();
+  EXPECT_EQ(address, heap_address);
+}
+
+TEST(UniqueFunctionTest, MovingLeavesTheSourceEmpty) {
+  int calls = 0;
+  UniqueClosure closure = [&calls] { calls++; };
+
+  UniqueClosure moved = std::move(closure);
+  EXPECT_FALSE(closure);  // NOLINT(bugprone-use-after-move)
+  EXPECT_TRUE(moved);
+  moved();
+
+  closure = std::move(moved);
+  EXPECT_FALSE(moved);  // NOLINT(bugprone-use-after-move)
+  closure();
+  EXPECT_EQ(calls, 2);
+}
+
+TEST(UniqueFunctionTest, CallableIsDestroyedOnce) {
+  auto value = std::make_shared<int>(1);
+  {
+    UniqueClosure closure = [value] {};
+    UniqueClosure large = [value, padding = std::array<char, 128>()] {};
+    EXPECT_EQ(value.use_count(), 3);
+
+    UniqueClosure moved = std::move(closure);
+    UniqueClosure large_moved = std::move(large);
+    EXPECT_EQ(value.use_count(), 3);
+
+    moved = nullptr;
+    EXPECT_EQ(value.use_count(), 2);
+  }
+  EXPECT_EQ(value.use_count(), 1);
+}
+
+TEST(UniqueFunctionTest, EmptyStdFunctionGivesEmptyFunction) {
+  fml::closure empty;
+  UniqueClosure closure = empty;
+  UniqueClosure null = nullptr;
+
+  EXPECT_FALSE(closure);
+  EXPECT_TRUE(closure == nullptr);
+  EXPECT_FALSE(null);
+  EXPECT_FALSE(UniqueClosure());
+}
+
+}  // namespace testing
+}  // namespace fml
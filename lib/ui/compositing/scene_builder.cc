@@ -71,10 +71,11 @@ void SceneBuilder::RegisterNatives(tonic::DartLibraryNatives* natives) {
        FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
 }
 
-SceneBuilder::SceneBuilder() {
+SceneBuilder::SceneBuilder()
+    : layer_arena_(fml::MakeRefCounted<flutter::LayerArena>()) {
   // Add a ContainerLayer as the root layer, so that AddLayer operations are
   // always valid.
-  PushLayer(std::make_shared<flutter::ContainerLayer>());
+  PushLayer(layer_arena_->Make<flutter::ContainerLayer>());
 }
 
 SceneBuilder::~SceneBuilder() = default;
@@ -83,7 +84,7 @@ void SceneBuilder::pushTransform(Dart_Handle layer_handle,
                                  tonic::Float64List& matrix4,
                                  fml::RefPtr<EngineLayer> oldLayer) {
   SkMatrix sk_matrix = ToSkMatrix(matrix4);
-  auto layer = std::make_shared<flutter::TransformLayer>(sk_matrix);
+  auto layer = layer_arena_->Make<flutter::TransformLayer>(sk_matrix);
   PushLayer(layer);
   // matrix4 has to be released before we can return another Dart object
   matrix4.Release();
@@ -99,7 +100,7 @@ void SceneBuilder::pushOffset(Dart_Handle layer_handle,
                               double dy,
                               fml::RefPtr<EngineLayer> oldLayer) {
   SkMatrix sk_matrix = SkMatrix::Translate(dx, dy);
-  auto layer = std::make_shared<flutter::TransformLayer>(sk_matrix);
+  auto layer = layer_arena_->Make<flutter::TransformLayer>(sk_matrix);
   PushLayer(layer);
   EngineLayer::MakeRetained(layer_handle, layer);
 
@@ -118,7 +119,7 @@ void SceneBuilder::pushClipRect(Dart_Handle layer_handle,
   SkRect clipRect = SkRect::MakeLTRB(left, top, right, bottom);
   flutter::Clip clip_behavior = static_cast<flutter::Clip>(clipBehavior);
   auto layer =
-      std::make_shared<flutter::ClipRectLayer>(clipRect, clip_behavior);
+      layer_arena_->Make<flutter::ClipRectLayer>(clipRect, clip_behavior);
   PushLayer(layer);
   EngineLayer::MakeRetained(layer_handle, layer);
 
@@ -132,8 +133,8 @@ void SceneBuilder::pushClipRRect(Dart_Handle layer_handle,
                                  int clipBehavior,
                                  fml::RefPtr<EngineLayer> oldLayer) {
   flutter::Clip clip_behavior = static_cast<flutter::Clip>(clipBehavior);
-  auto layer =
-      std::make_shared<flutter::ClipRRectLayer>(rrect.sk_rrect, clip_behavior);
+  auto layer = layer_arena_->Make<flutter::ClipRRectLayer>(rrect.sk_rrect,
+                                                          clip_behavior);
   PushLayer(layer);
   EngineLayer::MakeRetained(layer_handle, layer);
 
@@ -149,7 +150,7 @@ void SceneBuilder::pushClipPath(Dart_Handle layer_handle,
   flutter::Clip clip_behavior = static_cast<flutter::Clip>(clipBehavior);
   FML_DCHECK(clip_behavior != flutter::Clip::none);
   auto layer =
-      std::make_shared<flutter::ClipPathLayer>(path->path(), clip_behavior);
+      layer_arena_->Make<flutter::ClipPathLayer>(path->path(), clip_behavior);
   PushLayer(layer);
   EngineLayer::MakeRetained(layer_handle, layer);
 
@@ -164,7 +165,7 @@ void SceneBuilder::pushOpacity(Dart_Handle layer_handle,
                                double dy,
                                fml::RefPtr<EngineLayer> oldLayer) {
   auto layer =
-      std::make_shared<flutter::OpacityLayer>(alpha, SkPoint::Make(dx, dy));
+      layer_arena_->Make<flutter::OpacityLayer>(alpha, SkPoint::Make(dx, dy));
   PushLayer(layer);
   EngineLayer::MakeRetained(layer_handle, layer);
 
@@ -177,7 +178,7 @@ void SceneBuilder::pushColorFilter(Dart_Handle layer_handle,
                                    const ColorFilter* color_filter,
                                    fml::RefPtr<EngineLayer> oldLayer) {
   auto layer =
-      std::make_shared<flutter::ColorFilterLayer>(color_filter->filter());
+      layer_arena_->Make<flutter::ColorFilterLayer>(color_filter->filter());
   PushLayer(layer);
   EngineLayer::MakeRetained(layer_handle, layer);
 
@@ -190,7 +191,7 @@ void SceneBuilder::pushImageFilter(Dart_Handle layer_handle,
                                    const ImageFilter* image_filter,
                                    fml::RefPtr<EngineLayer> oldLayer) {
   auto layer =
-      std::make_shared<flutter::ImageFilterLayer>(image_filter->filter());
+      layer_arena_->Make<flutter::ImageFilterLayer>(image_filter->filter());
   PushLayer(layer);
   EngineLayer::MakeRetained(layer_handle, layer);
 
@@ -203,7 +204,7 @@ void SceneBuilder::pushBackdropFilter(Dart_Handle layer_handle,
                                       ImageFilter* filter,
                                       int blendMode,
                                       fml::RefPtr<EngineLayer> oldLayer) {
-  auto layer = std::make_shared<flutter::BackdropFilterLayer>(
+  auto layer = layer_arena_->Make<flutter::BackdropFilterLayer>(
       filter->filter(), static_cast<SkBlendMode>(blendMode));
   PushLayer(layer);
   EngineLayer::MakeRetained(layer_handle, layer);
@@ -225,7 +226,7 @@ void SceneBuilder::pushShaderMask(Dart_Handle layer_handle,
   SkRect rect = SkRect::MakeLTRB(maskRectLeft, maskRectTop, maskRectRight,
                                  maskRectBottom);
   auto sampling = ImageFilter::SamplingFromIndex(filterQualityIndex);
-  auto layer = std::make_shared<flutter::ShaderMaskLayer>(
+  auto layer = layer_arena_->Make<flutter::ShaderMaskLayer>(
       shader->shader(sampling), rect, static_cast<SkBlendMode>(blendMode));
   PushLayer(layer);
   EngineLayer::MakeRetained(layer_handle, layer);
@@ -242,7 +243,7 @@ void SceneBuilder::pushPhysicalShape(Dart_Handle layer_handle,
                                      int shadow_color,
                                      int clipBehavior,
                                      fml::RefPtr<EngineLayer> oldLayer) {
-  auto layer = std::make_shared<flutter::PhysicalShapeLayer>(
+  auto layer = layer_arena_->Make<flutter::PhysicalShapeLayer>(
       static_cast<SkColor>(color), static_cast<SkColor>(shadow_color),
       static_cast<float>(elevation), path->path(),
       static_cast<flutter::Clip>(clipBehavior));
@@ -267,12 +268,12 @@ void SceneBuilder::addPicture(double dx,
                               Picture* picture,
                               int hints) {
   if (picture->picture()) {
-    auto layer = std::make_unique<flutter::PictureLayer>(
+    auto layer = layer_arena_->Make<flutter::PictureLayer>(
         SkPoint::Make(dx, dy), UIDartState::CreateGPUObject(picture->picture()),
         !!(hints & 1), !!(hints & 2));
     AddLayer(std::move(layer));
   } else {
-    auto layer = std::make_unique<flutter::DisplayListLayer>(
+    auto layer = layer_arena_->Make<flutter::DisplayListLayer>(
         SkPoint::Make(dx, dy),
         UIDartState::CreateGPUObject(picture->display_list()), !!(hints & 1),
         !!(hints & 2));
@@ -288,7 +289,7 @@ void SceneBuilder::addTexture(double dx,
                               bool freeze,
                               int filterQualityIndex) {
   auto sampling = ImageFilter::SamplingFromIndex(filterQualityIndex);
-  auto layer = std::make_unique<flutter::TextureLayer>(
+  auto layer = layer_arena_->Make<flutter::TextureLayer>(
       SkPoint::Make(dx, dy), SkSize::Make(width, height), textureId, freeze,
       sampling);
   AddLayer(std::move(layer));
@@ -299,9 +300,10 @@ void SceneBuilder::addPlatformView(double dx,
                                    double width,
                                    double height,
                                    int64_t viewId) {
-  auto layer = std::make_unique<flutter::PlatformViewLayer>(
+  auto layer = layer_arena_->Make<flutter::PlatformViewLayer>(
       SkPoint::Make(dx, dy), SkSize::Make(width, height), viewId);
   AddLayer(std::move(layer));
+  has_platform_view_ = true;
 }
 
 void SceneBuilder::addPerformanceOverlay(uint64_t enabledOptions,
@@ -311,7 +313,7 @@ void SceneBuilder::addPerformanceOverlay(uint64_t enabledOptions,
                                          double bottom) {
   SkRect rect = SkRect::MakeLTRB(left, top, right, bottom);
   auto layer =
-      std::make_unique<flutter::PerformanceOverlayLayer>(enabledOptions);
+      layer_arena_->Make<flutter::PerformanceOverlayLayer>(enabledOptions);
   layer->set_paint_bounds(rect);
   AddLayer(std::move(layer));
 }
@@ -333,7 +335,8 @@ void SceneBuilder::build(Dart_Handle scene_handle) {
 
   Scene::create(
       scene_handle, std::move(layer_stack_[0]), rasterizer_tracing_threshold_,
-      checkerboard_raster_cache_images_, checkerboard_offscreen_layers_);
+      checkerboard_raster_cache_images_, checkerboard_offscreen_layers_,
+      has_platform_view_);
   layer_stack_.clear();
   ClearDartWrapper();  // may delete this object.
 }
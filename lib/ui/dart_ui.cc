@@ -52,6 +52,10 @@ const uint8_t* GetSymbol(Dart_NativeFunction native_function) {
   return g_natives->GetSymbol(native_function);
 }
 
+void* GetFfiNativeFunction(const char* name, uintptr_t args) {
+  return g_natives->GetFfiNativeFunction(name);
+}
+
 }  // namespace
 
 void DartUI::InitForGlobal() {
@@ -89,8 +93,13 @@ void DartUI::InitForGlobal() {
 
 void DartUI::InitForIsolate() {
   FML_DCHECK(g_natives);
-  Dart_Handle result = Dart_SetNativeResolver(
-      Dart_LookupLibrary(ToDart("dart:ui")), GetNativeFunction, GetSymbol);
+  Dart_Handle library = Dart_LookupLibrary(ToDart("dart:ui"));
+  Dart_Handle result =
+      Dart_SetNativeResolver(library, GetNativeFunction, GetSymbol);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  result = Dart_SetFfiNativeResolver(library, GetFfiNativeFunction);
   if (Dart_IsError(result)) {
     Dart_PropagateError(result);
   }
@@ -196,6 +196,37 @@ void createPath() {
 }
 void _validatePath(Path path) native 'ValidatePath';
 
+/// Builds a path with five calls into the engine, [count] times.
+@pragma('vm:entry-point')
+void benchmarkPathCalls(int count) {
+  final Path path = Path();
+  for (int i = 0; i < count; i++) {
+    path.reset();
+    path.moveTo(0, 0);
+    path.lineTo(10, 10);
+    path.cubicTo(10, 20, 20, 20, 20, 10);
+    path.close();
+  }
+}
+
+/// Transforms and clips a canvas with six calls into the engine, [count]
+/// times.
+@pragma('vm:entry-point')
+void benchmarkCanvasCalls(int count) {
+  final PictureRecorder recorder = PictureRecorder();
+  final Canvas canvas = Canvas(recorder);
+  const Rect clip = Rect.fromLTRB(0, 0, 100, 100);
+  for (int i = 0; i < count; i++) {
+    canvas.save();
+    canvas.translate(1, 1);
+    canvas.scale(2);
+    canvas.rotate(0.1);
+    canvas.clipRect(clip);
+    canvas.restore();
+  }
+  recorder.endRecording().dispose();
+}
+
 @pragma('vm:entry-point')
 void frameCallback(_Image, int) {
   print('called back');
@@ -89,6 +89,24 @@ void _dispatchPlatformMessage(String name, ByteData? data, int responseId) {
   PlatformDispatcher.instance._dispatchPlatformMessage(name, data, responseId);
 }
 
+@pragma('vm:entry-point')
+void _dispatchPlatformMessages(List<Object?> messages) {
+  // Each message is its channel, its data and its response ID.
+  for (int i = 0; i < messages.length; i += 3) {
+    final String? name = messages[i] as String?;
+    if (name == null) {
+      continue;
+    }
+    try {
+      PlatformDispatcher.instance._dispatchPlatformMessage(
+          name, messages[i + 1] as ByteData?, messages[i + 2]! as int);
+    } catch (error, stackTrace) {
+      // An error in one handler does not prevent delivering the next messages.
+      Zone.current.handleUncaughtError(error, stackTrace);
+    }
+  }
+}
+
 @pragma('vm:entry-point')
 void _dispatchPointerDataPacket(ByteData packet) {
   PlatformDispatcher.instance._dispatchPointerDataPacket(packet);
@@ -2308,51 +2308,62 @@ class Path extends NativeFieldWrapperClass1 {
   PathFillType get fillType => PathFillType.values[_getFillType()];
   set fillType(PathFillType value) => _setFillType(value.index);
 
-  int _getFillType() native 'Path_getFillType';
-  void _setFillType(int fillType) native 'Path_setFillType';
+  @FfiNative<Int32 Function(Pointer<Void>)>('Path::getFillType', isLeaf: true)
+  external int _getFillType();
+  @FfiNative<Void Function(Pointer<Void>, Int32)>('Path::setFillType', isLeaf: true)
+  external void _setFillType(int fillType);
 
   /// Starts a new sub-path at the given coordinate.
-  void moveTo(double x, double y) native 'Path_moveTo';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float)>('Path::moveTo', isLeaf: true)
+  external void moveTo(double x, double y);
 
   /// Starts a new sub-path at the given offset from the current point.
-  void relativeMoveTo(double dx, double dy) native 'Path_relativeMoveTo';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float)>('Path::relativeMoveTo', isLeaf: true)
+  external void relativeMoveTo(double dx, double dy);
 
   /// Adds a straight line segment from the current point to the given
   /// point.
-  void lineTo(double x, double y) native 'Path_lineTo';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float)>('Path::lineTo', isLeaf: true)
+  external void lineTo(double x, double y);
 
   /// Adds a straight line segment from the current point to the point
   /// at the given offset from the current point.
-  void relativeLineTo(double dx, double dy) native 'Path_relativeLineTo';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float)>('Path::relativeLineTo', isLeaf: true)
+  external void relativeLineTo(double dx, double dy);
 
   /// Adds a quadratic bezier segment that curves from the current
   /// point to the given point (x2,y2), using the control point
   /// (x1,y1).
-  void quadraticBezierTo(double x1, double y1, double x2, double y2) native 'Path_quadraticBezierTo';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float, Float, Float)>('Path::quadraticBezierTo', isLeaf: true)
+  external void quadraticBezierTo(double x1, double y1, double x2, double y2);
 
   /// Adds a quadratic bezier segment that curves from the current
   /// point to the point at the offset (x2,y2) from the current point,
   /// using the control point at the offset (x1,y1) from the current
   /// point.
-  void relativeQuadraticBezierTo(double x1, double y1, double x2, double y2) native 'Path_relativeQuadraticBezierTo';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float, Float, Float)>('Path::relativeQuadraticBezierTo', isLeaf: true)
+  external void relativeQuadraticBezierTo(double x1, double y1, double x2, double y2);
 
   /// Adds a cubic bezier segment that curves from the current point
   /// to the given point (x3,y3), using the control points (x1,y1) and
   /// (x2,y2).
-  void cubicTo(double x1, double y1, double x2, double y2, double x3, double y3) native 'Path_cubicTo';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float, Float, Float, Float, Float)>('Path::cubicTo', isLeaf: true)
+  external void cubicTo(double x1, double y1, double x2, double y2, double x3, double y3);
 
   /// Adds a cubic bezier segment that curves from the current point
   /// to the point at the offset (x3,y3) from the current point, using
   /// the control points at the offsets (x1,y1) and (x2,y2) from the
   /// current point.
-  void relativeCubicTo(double x1, double y1, double x2, double y2, double x3, double y3) native 'Path_relativeCubicTo';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float, Float, Float, Float, Float)>('Path::relativeCubicTo', isLeaf: true)
+  external void relativeCubicTo(double x1, double y1, double x2, double y2, double x3, double y3);
 
   /// Adds a bezier segment that curves from the current point to the
   /// given point (x2,y2), using the control points (x1,y1) and the
   /// weight w. If the weight is greater than 1, then the curve is a
   /// hyperbola; if the weight equals 1, it's a parabola; and if it is
   /// less than 1, it is an ellipse.
-  void conicTo(double x1, double y1, double x2, double y2, double w) native 'Path_conicTo';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float, Float, Float, Float)>('Path::conicTo', isLeaf: true)
+  external void conicTo(double x1, double y1, double x2, double y2, double w);
 
   /// Adds a bezier segment that curves from the current point to the
   /// point at the offset (x2,y2) from the current point, using the
@@ -2360,7 +2371,8 @@ class Path extends NativeFieldWrapperClass1 {
   /// the weight w. If the weight is greater than 1, then the curve is
   /// a hyperbola; if the weight equals 1, it's a parabola; and if it
   /// is less than 1, it is an ellipse.
-  void relativeConicTo(double x1, double y1, double x2, double y2, double w) native 'Path_relativeConicTo';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float, Float, Float, Float)>('Path::relativeConicTo', isLeaf: true)
+  external void relativeConicTo(double x1, double y1, double x2, double y2, double w);
 
   /// If the `forceMoveTo` argument is false, adds a straight line
   /// segment and an arc segment.
@@ -2382,8 +2394,9 @@ class Path extends NativeFieldWrapperClass1 {
     assert(_rectIsValid(rect));
     _arcTo(rect.left, rect.top, rect.right, rect.bottom, startAngle, sweepAngle, forceMoveTo);
   }
-  void _arcTo(double left, double top, double right, double bottom,
-              double startAngle, double sweepAngle, bool forceMoveTo) native 'Path_arcTo';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float, Float, Float, Float, Float, Bool)>('Path::arcTo', isLeaf: true)
+  external void _arcTo(double left, double top, double right, double bottom,
+                       double startAngle, double sweepAngle, bool forceMoveTo);
 
   /// Appends up to four conic curves weighted to describe an oval of `radius`
   /// and rotated by `rotation` (measured in degrees and clockwise).
@@ -2408,9 +2421,10 @@ class Path extends NativeFieldWrapperClass1 {
     _arcToPoint(arcEnd.dx, arcEnd.dy, radius.x, radius.y, rotation,
                 largeArc, clockwise);
   }
-  void _arcToPoint(double arcEndX, double arcEndY, double radiusX,
-                   double radiusY, double rotation, bool largeArc,
-                   bool clockwise) native 'Path_arcToPoint';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float, Float, Float, Float, Bool, Bool)>('Path::arcToPoint', isLeaf: true)
+  external void _arcToPoint(double arcEndX, double arcEndY, double radiusX,
+                            double radiusY, double rotation, bool largeArc,
+                            bool clockwise);
 
 
   /// Appends up to four conic curves weighted to describe an oval of `radius`
@@ -2438,10 +2452,10 @@ class Path extends NativeFieldWrapperClass1 {
     _relativeArcToPoint(arcEndDelta.dx, arcEndDelta.dy, radius.x, radius.y,
                         rotation, largeArc, clockwise);
   }
-  void _relativeArcToPoint(double arcEndX, double arcEndY, double radiusX,
-                           double radiusY, double rotation,
-                           bool largeArc, bool clockwise)
-                           native 'Path_relativeArcToPoint';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float, Float, Float, Float, Bool, Bool)>('Path::relativeArcToPoint', isLeaf: true)
+  external void _relativeArcToPoint(double arcEndX, double arcEndY, double radiusX,
+                                    double radiusY, double rotation,
+                                    bool largeArc, bool clockwise);
 
   /// Adds a new sub-path that consists of four lines that outline the
   /// given rectangle.
@@ -2449,7 +2463,8 @@ class Path extends NativeFieldWrapperClass1 {
     assert(_rectIsValid(rect));
     _addRect(rect.left, rect.top, rect.right, rect.bottom);
   }
-  void _addRect(double left, double top, double right, double bottom) native 'Path_addRect';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float, Float, Float)>('Path::addRect', isLeaf: true)
+  external void _addRect(double left, double top, double right, double bottom);
 
   /// Adds a new sub-path that consists of a curve that forms the
   /// ellipse that fills the given rectangle.
@@ -2460,7 +2475,8 @@ class Path extends NativeFieldWrapperClass1 {
     assert(_rectIsValid(oval));
     _addOval(oval.left, oval.top, oval.right, oval.bottom);
   }
-  void _addOval(double left, double top, double right, double bottom) native 'Path_addOval';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float, Float, Float)>('Path::addOval', isLeaf: true)
+  external void _addOval(double left, double top, double right, double bottom);
 
   /// Adds a new sub-path with one arc segment that consists of the arc
   /// that follows the edge of the oval bounded by the given
@@ -2474,8 +2490,9 @@ class Path extends NativeFieldWrapperClass1 {
     assert(_rectIsValid(oval));
     _addArc(oval.left, oval.top, oval.right, oval.bottom, startAngle, sweepAngle);
   }
-  void _addArc(double left, double top, double right, double bottom,
-               double startAngle, double sweepAngle) native 'Path_addArc';
+  @FfiNative<Void Function(Pointer<Void>, Float, Float, Float, Float, Float, Float)>('Path::addArc', isLeaf: true)
+  external void _addArc(double left, double top, double right, double bottom,
+                        double startAngle, double sweepAngle);
 
   /// Adds a new sub-path with a sequence of line segments that connect the given
   /// points.
@@ -2539,12 +2556,14 @@ class Path extends NativeFieldWrapperClass1 {
 
   /// Closes the last sub-path, as if a straight line had been drawn
   /// from the current point to the first point of the sub-path.
-  void close() native 'Path_close';
+  @FfiNative<Void Function(Pointer<Void>)>('Path::close', isLeaf: true)
+  external void close();
 
   /// Clears the [Path] object of all sub-paths, returning it to the
   /// same state it had when it was created. The _current point_ is
   /// reset to the origin.
-  void reset() native 'Path_reset';
+  @FfiNative<Void Function(Pointer<Void>)>('Path::reset', isLeaf: true)
+  external void reset();
 
   /// Tests to see if the given point is within the path. (That is, whether the
   /// point would be in the visible portion of the path if the path was used
@@ -2557,7 +2576,8 @@ class Path extends NativeFieldWrapperClass1 {
     assert(_offsetIsValid(point));
     return _contains(point.dx, point.dy);
   }
-  bool _contains(double x, double y) native 'Path_contains';
+  @FfiNative<Bool Function(Pointer<Void>, Double, Double)>('Path::contains', isLeaf: true)
+  external bool _contains(double x, double y);
 
   /// Returns a copy of the path with all the segments of every
   /// sub-path translated by the given offset.
@@ -3869,6 +3889,36 @@ class FragmentProgram extends NativeFieldWrapperClass1 {
     return shader;
   }
 
+  /// Compiles the GPU program that draws the shaders of this program with the
+  /// given kind of uniforms, so that the first frame that draws one of them
+  /// does not have to.
+  ///
+  /// The arguments are the same as for [shader]. Only the number and the kind
+  /// of the uniforms matter to the GPU program, not their values.
+  ///
+  /// The program is compiled by drawing this shader once on the raster
+  /// thread, with the graphics context that draws the frames, so it is also
+  /// stored in the persistent shader cache when that is enabled. The returned
+  /// future completes once it has been compiled.
+  Future<void> warmUp({
+    Float32List? floatUniforms,
+    List<ImageShader>? samplerUniforms,
+  }) async {
+    final Shader shader = this.shader(
+      floatUniforms: floatUniforms,
+      samplerUniforms: samplerUniforms,
+    );
+    final PictureRecorder recorder = PictureRecorder();
+    Canvas(recorder).drawRect(const Rect.fromLTWH(0, 0, 1, 1), Paint()..shader = shader);
+    final Picture picture = recorder.endRecording();
+    try {
+      final Image image = await picture.toImage(1, 1);
+      image.dispose();
+    } finally {
+      picture.dispose();
+    }
+  }
+
   void _shader(
     _FragmentShader shader,
     Float32List floatUniforms,
@@ -4068,6 +4118,117 @@ enum ClipOp {
   intersect,
 }
 
+/// A run of rectangles, lines and circles that [Canvas.drawBatch] draws with a
+/// single call into the engine.
+///
+/// Each call to a [Canvas] method crosses into the engine on its own, which
+/// dominates the cost of drawing many small shapes, such as the bars of a chart
+/// or the particles of a game. A batch encodes the shapes as they are added and
+/// hands all of them to the engine at once.
+///
+/// The paint of each shape is captured when the shape is added, so the same
+/// [Paint] may be changed and used again for the next shapes. Consecutive
+/// shapes that use the same paint settings share a single copy of them.
+class CanvasBatch {
+  /// Creates an empty batch.
+  CanvasBatch();
+
+  // Each operation is encoded as its kind, the index of its paint and four
+  // values of geometry. The encoding must match the decoding in canvas.cc.
+  static const int _kRectOp = 0;
+  static const int _kLineOp = 1;
+  static const int _kCircleOp = 2;
+  static const int _kValuesPerOp = 6;
+  static const int _kInitialOpCapacity = 64;
+
+  Float32List _ops = Float32List(_kInitialOpCapacity * _kValuesPerOp);
+  int _opCount = 0;
+  final List<ByteData> _paintData = <ByteData>[];
+  final List<List<dynamic>?> _paintObjects = <List<dynamic>?>[];
+
+  /// The number of shapes in the batch.
+  int get length => _opCount;
+
+  /// Adds a rectangle, as drawn by [Canvas.drawRect].
+  void addRect(Rect rect, Paint paint) {
+    assert(_rectIsValid(rect));
+    assert(paint != null);
+    _addOp(_kRectOp, paint, rect.left, rect.top, rect.right, rect.bottom);
+  }
+
+  /// Adds a line, as drawn by [Canvas.drawLine].
+  void addLine(Offset p1, Offset p2, Paint paint) {
+    assert(_offsetIsValid(p1));
+    assert(_offsetIsValid(p2));
+    assert(paint != null);
+    _addOp(_kLineOp, paint, p1.dx, p1.dy, p2.dx, p2.dy);
+  }
+
+  /// Adds a circle, as drawn by [Canvas.drawCircle].
+  void addCircle(Offset c, double radius, Paint paint) {
+    assert(_offsetIsValid(c));
+    assert(paint != null);
+    _addOp(_kCircleOp, paint, c.dx, c.dy, radius, 0.0);
+  }
+
+  /// Removes all of the shapes from the batch, keeping its storage for the
+  /// shapes that are added next.
+  void clear() {
+    _opCount = 0;
+    _paintData.clear();
+    _paintObjects.clear();
+  }
+
+  void _addOp(int op, Paint paint, double a, double b, double c, double d) {
+    final int paintIndex = _paintIndexOf(paint);
+    int offset = _opCount * _kValuesPerOp;
+    if (offset == _ops.length) {
+      final Float32List ops = Float32List(_ops.length * 2);
+      ops.setAll(0, _ops);
+      _ops = ops;
+    }
+    _ops[offset++] = op.toDouble();
+    _ops[offset++] = paintIndex.toDouble();
+    _ops[offset++] = a;
+    _ops[offset++] = b;
+    _ops[offset++] = c;
+    _ops[offset] = d;
+    _opCount += 1;
+  }
+
+  // Returns the index of a copy of the paint, which is the last copy when the
+  // paint has not changed since it was made.
+  int _paintIndexOf(Paint paint) {
+    final int last = _paintData.length - 1;
+    if (last >= 0 && _paintMatches(last, paint))
+      return last;
+    final ByteData data = ByteData(Paint._kDataByteCount);
+    for (int i = 0; i < Paint._kDataByteCount; i += 4)
+      data.setInt32(i, paint._data.getInt32(i, _kFakeHostEndian), _kFakeHostEndian);
+    final List<dynamic>? objects = paint._objects;
+    _paintData.add(data);
+    _paintObjects.add(objects == null ? null : List<dynamic>.of(objects, growable: false));
+    return last + 1;
+  }
+
+  bool _paintMatches(int index, Paint paint) {
+    final ByteData data = _paintData[index];
+    for (int i = 0; i < Paint._kDataByteCount; i += 4) {
+      if (data.getInt32(i, _kFakeHostEndian) != paint._data.getInt32(i, _kFakeHostEndian))
+        return false;
+    }
+    final List<dynamic>? objects = _paintObjects[index];
+    final List<dynamic>? paintObjects = paint._objects;
+    if (objects == null || paintObjects == null)
+      return objects == null && paintObjects == null;
+    for (int i = 0; i < Paint._kObjectCount; i++) {
+      if (!identical(objects[i], paintObjects[i]))
+        return false;
+    }
+    return true;
+  }
+}
+
 /// An interface for recording graphical operations.
 ///
 /// [Canvas] objects are used in creating [Picture] objects, which can
@@ -4126,7 +4287,8 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///
   ///  * [saveLayer], which does the same thing but additionally also groups the
   ///    commands done until the matching [restore].
-  void save() native 'Canvas_save';
+  @FfiNative<Void Function(Pointer<Void>)>('Canvas::save', isLeaf: true)
+  external void save();
 
   /// Saves a copy of the current transform and clip on the save stack, and then
   /// creates a new group which subsequent calls will become a part of. When the
@@ -4263,7 +4425,8 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///
   /// If the state was pushed with with [saveLayer], then this call will also
   /// cause the new layer to be composited into the previous layer.
-  void restore() native 'Canvas_restore';
+  @FfiNative<Void Function(Pointer<Void>)>('Canvas::restore', isLeaf: true)
+  external void restore();
 
   /// Returns the number of items on the save stack, including the
   /// initial state. This means it returns 1 for a clean canvas, and
@@ -4271,11 +4434,13 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// each matching call to [restore] decrements it.
   ///
   /// This number cannot go below 1.
-  int getSaveCount() native 'Canvas_getSaveCount';
+  @FfiNative<Int32 Function(Pointer<Void>)>('Canvas::getSaveCount', isLeaf: true)
+  external int getSaveCount();
 
   /// Add a translation to the current transform, shifting the coordinate space
   /// horizontally by the first argument and vertically by the second argument.
-  void translate(double dx, double dy) native 'Canvas_translate';
+  @FfiNative<Void Function(Pointer<Void>, Double, Double)>('Canvas::translate', isLeaf: true)
+  external void translate(double dx, double dy);
 
   /// Add an axis-aligned scale to the current transform, scaling by the first
   /// argument in the horizontal direction and the second in the vertical
@@ -4285,16 +4450,19 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// directions.
   void scale(double sx, [double? sy]) => _scale(sx, sy ?? sx);
 
-  void _scale(double sx, double sy) native 'Canvas_scale';
+  @FfiNative<Void Function(Pointer<Void>, Double, Double)>('Canvas::scale', isLeaf: true)
+  external void _scale(double sx, double sy);
 
   /// Add a rotation to the current transform. The argument is in radians clockwise.
-  void rotate(double radians) native 'Canvas_rotate';
+  @FfiNative<Void Function(Pointer<Void>, Double)>('Canvas::rotate', isLeaf: true)
+  external void rotate(double radians);
 
   /// Add an axis-aligned skew to the current transform, with the first argument
   /// being the horizontal skew in rise over run units clockwise around the
   /// origin, and the second argument being the vertical skew in rise over run
   /// units clockwise around the origin.
-  void skew(double sx, double sy) native 'Canvas_skew';
+  @FfiNative<Void Function(Pointer<Void>, Double, Double)>('Canvas::skew', isLeaf: true)
+  external void skew(double sx, double sy);
 
   /// Multiply the current transform by the specified 4⨉4 transformation matrix
   /// specified as a list of values in column-major order.
@@ -4323,12 +4491,13 @@ class Canvas extends NativeFieldWrapperClass1 {
     assert(doAntiAlias != null);
     _clipRect(rect.left, rect.top, rect.right, rect.bottom, clipOp.index, doAntiAlias);
   }
-  void _clipRect(double left,
-                 double top,
-                 double right,
-                 double bottom,
-                 int clipOp,
-                 bool doAntiAlias) native 'Canvas_clipRect';
+  @FfiNative<Void Function(Pointer<Void>, Double, Double, Double, Double, Int32, Bool)>('Canvas::clipRect', isLeaf: true)
+  external void _clipRect(double left,
+                          double top,
+                          double right,
+                          double bottom,
+                          int clipOp,
+                          bool doAntiAlias);
 
   /// Reduces the clip region to the intersection of the current clip and the
   /// given rounded rectangle.
@@ -4470,6 +4639,23 @@ class Canvas extends NativeFieldWrapperClass1 {
                    List<dynamic>? paintObjects,
                    ByteData paintData) native 'Canvas_drawCircle';
 
+  /// Draws the rectangles, lines and circles of the given [CanvasBatch], in
+  /// the order they were added to it, each with the paint it was added with.
+  ///
+  /// This is the same as calling [drawRect], [drawLine] and [drawCircle] for
+  /// each of the shapes, but crosses into the engine once for the whole batch.
+  /// The batch is not changed, so it may be drawn again.
+  void drawBatch(CanvasBatch batch) {
+    assert(batch != null);
+    if (batch._opCount == 0)
+      return;
+    _drawBatch(batch._paintObjects, batch._paintData, batch._ops, batch._opCount);
+  }
+  void _drawBatch(List<List<dynamic>?> paintObjects,
+                  List<ByteData> paintData,
+                  Float32List ops,
+                  int opCount) native 'Canvas_drawBatch';
+
   /// Draw an arc scaled to fit inside the given rectangle.
   ///
   /// It starts from `startAngle` radians around the oval up to
@@ -4612,6 +4798,13 @@ class Canvas extends NativeFieldWrapperClass1 {
 
   /// Draw the given picture onto the canvas. To create a picture, see
   /// [PictureRecorder].
+  ///
+  /// The picture is recorded by reference rather than copied, so a picture
+  /// that is recorded once and drawn into the pictures recorded in later
+  /// frames is a cheap way to retain the parts of a drawing that do not
+  /// change, such as the static series of a chart. The engine also caches
+  /// the rasterization of such a picture across frames, even when the
+  /// picture that it is drawn into changes in every frame.
   void drawPicture(Picture picture) {
     assert(picture != null); // picture is checked on the engine side
     _drawPicture(picture);
@@ -5388,7 +5581,7 @@ class Shadow {
 /// The creator of this object is responsible for calling [dispose] when it is
 /// no longer needed.
 class ImmutableBuffer extends NativeFieldWrapperClass1 {
-  ImmutableBuffer._(this.length);
+  ImmutableBuffer._(this._length);
 
   /// Creates a copy of the data from a [Uint8List] suitable for internal use
   /// in the engine.
@@ -5400,8 +5593,24 @@ class ImmutableBuffer extends NativeFieldWrapperClass1 {
   }
   void _init(Uint8List list, _Callback<void> callback) native 'ImmutableBuffer_init';
 
+  /// Create a buffer from the asset with key [assetKey].
+  ///
+  /// The bytes of the asset are not copied when the engine can map them from
+  /// the asset bundle instead, so that large images and fonts do not take
+  /// twice their size in memory while they are loaded.
+  ///
+  /// Throws an [Exception] if the asset does not exist.
+  static Future<ImmutableBuffer> fromAsset(String assetKey) {
+    final ImmutableBuffer instance = ImmutableBuffer._(0);
+    return _futurize((_Callback<int> callback) {
+      return instance._initFromAsset(assetKey, callback);
+    }).then((int length) => instance.._length = length);
+  }
+  String? _initFromAsset(String assetKey, _Callback<int> callback) native 'ImmutableBuffer_initFromAsset';
+
   /// The length, in bytes, of the underlying data.
-  final int length;
+  int get length => _length;
+  int _length;
 
   bool _debugDisposed = false;
 
@@ -5448,11 +5657,22 @@ class ImageDescriptor extends NativeFieldWrapperClass1 {
   /// Creates an image descriptor from encoded data in a supported format.
   static Future<ImageDescriptor> encoded(ImmutableBuffer buffer) {
     final ImageDescriptor descriptor = ImageDescriptor._();
-    return _futurize((_Callback<void> callback) {
-      return descriptor._initEncoded(buffer, callback);
-    }).then((_) => descriptor);
+    final Completer<ImageDescriptor> completer = Completer<ImageDescriptor>.sync();
+    // The callback receives the error of images whose header is only read
+    // once the call returned.
+    final String? error = descriptor._initEncoded(buffer, (String? error) {
+      if (error == null) {
+        completer.complete(descriptor);
+      } else {
+        completer.completeError(Exception(error));
+      }
+    });
+    if (error != null) {
+      throw Exception(error);
+    }
+    return completer.future;
   }
-  String? _initEncoded(ImmutableBuffer buffer, _Callback<void> callback) native 'ImageDescriptor_initEncoded';
+  String? _initEncoded(ImmutableBuffer buffer, _Callback<String?> callback) native 'ImageDescriptor_initEncoded';
 
   /// Creates an image descriptor from raw image pixels.
   ///
@@ -5512,7 +5732,14 @@ class ImageDescriptor extends NativeFieldWrapperClass1 {
   ///
   /// If either targetWidth or targetHeight is less than or equal to zero, it
   /// will be treated as if it is null.
-  Future<Codec> instantiateCodec({int? targetWidth, int? targetHeight}) async {
+  ///
+  /// If sourceRect is specified, only the pixels of the image within it,
+  /// rounded out to whole pixels, make up the decoded image. The target
+  /// dimensions then default to the size of the rect and follow its aspect
+  /// ratio instead of the image's. Codecs that support it, such as JPEG, PNG
+  /// and WebP, decode only the region of the image that the rect covers. The
+  /// rect must overlap the image. It is ignored for animated images.
+  Future<Codec> instantiateCodec({int? targetWidth, int? targetHeight, Rect? sourceRect}) async {
     if (targetWidth != null && targetWidth <= 0) {
       targetWidth = null;
     }
@@ -5520,24 +5747,48 @@ class ImageDescriptor extends NativeFieldWrapperClass1 {
       targetHeight = null;
     }
 
+    Rect source = Offset.zero & Size(width.toDouble(), height.toDouble());
+    if (sourceRect != null) {
+      source = sourceRect.intersect(source);
+      if (source.isEmpty) {
+        throw ArgumentError.value(sourceRect, 'sourceRect', 'must overlap the image');
+      }
+      source = Rect.fromLTRB(
+        source.left.floorToDouble(),
+        source.top.floorToDouble(),
+        source.right.ceilToDouble(),
+        source.bottom.ceilToDouble(),
+      );
+    }
+    final int sourceWidth = source.width.toInt();
+    final int sourceHeight = source.height.toInt();
+
     if (targetWidth == null && targetHeight == null) {
-      targetWidth = width;
-      targetHeight = height;
+      targetWidth = sourceWidth;
+      targetHeight = sourceHeight;
     } else if (targetWidth == null && targetHeight != null) {
-      targetWidth = (targetHeight * (width / height)).round();
+      targetWidth = (targetHeight * (sourceWidth / sourceHeight)).round();
       targetHeight = targetHeight;
     } else if (targetHeight == null && targetWidth != null) {
       targetWidth = targetWidth;
-      targetHeight = targetWidth ~/ (width / height);
+      targetHeight = targetWidth ~/ (sourceWidth / sourceHeight);
     }
     assert(targetWidth != null);
     assert(targetHeight != null);
 
     final Codec codec = Codec._();
-    _instantiateCodec(codec, targetWidth!, targetHeight!);
+    _instantiateCodec(
+      codec,
+      targetWidth!,
+      targetHeight!,
+      source.left.toInt(),
+      source.top.toInt(),
+      source.right.toInt(),
+      source.bottom.toInt(),
+    );
     return codec;
   }
-  void _instantiateCodec(Codec outCodec, int targetWidth, int targetHeight) native 'ImageDescriptor_instantiateCodec';
+  void _instantiateCodec(Codec outCodec, int targetWidth, int targetHeight, int sourceLeft, int sourceTop, int sourceRight, int sourceBottom) native 'ImageDescriptor_instantiateCodec';
 }
 
 /// Generic callback signature, used by [_futurize].
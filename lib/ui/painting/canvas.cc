@@ -5,7 +5,9 @@
 #include "flutter/lib/ui/painting/canvas.h"
 #include "flutter/lib/ui/painting/image_filter.h"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 #include "flutter/display_list/display_list_builder.h"
 #include "flutter/display_list/display_list_canvas_dispatcher.h"
@@ -27,6 +29,22 @@ using tonic::ToDart;
 
 namespace flutter {
 
+namespace {
+
+// The encoding of the operations of a CanvasBatch, which must match the
+// encoding in painting.dart.
+enum class BatchOp {
+  kRect = 0,
+  kLine = 1,
+  kCircle = 2,
+};
+constexpr size_t kBatchOpKindIndex = 0;
+constexpr size_t kBatchOpPaintIndex = 1;
+constexpr size_t kBatchOpValuesIndex = 2;
+constexpr size_t kBatchValuesPerOp = 6;
+
+}  // namespace
+
 static void Canvas_constructor(Dart_NativeArguments args) {
   UIDartState::ThrowIfUIOperationsProhibited();
   DartCallConstructor(&Canvas::Create, args);
@@ -35,17 +53,9 @@ static void Canvas_constructor(Dart_NativeArguments args) {
 IMPLEMENT_WRAPPERTYPEINFO(ui, Canvas);
 
 #define FOR_EACH_BINDING(V)         \
-  V(Canvas, save)                   \
   V(Canvas, saveLayerWithoutBounds) \
   V(Canvas, saveLayer)              \
-  V(Canvas, restore)                \
-  V(Canvas, getSaveCount)           \
-  V(Canvas, translate)              \
-  V(Canvas, scale)                  \
-  V(Canvas, rotate)                 \
-  V(Canvas, skew)                   \
   V(Canvas, transform)              \
-  V(Canvas, clipRect)               \
   V(Canvas, clipRRect)              \
   V(Canvas, clipPath)               \
   V(Canvas, drawColor)              \
@@ -56,6 +66,7 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Canvas);
   V(Canvas, drawDRRect)             \
   V(Canvas, drawOval)               \
   V(Canvas, drawCircle)             \
+  V(Canvas, drawBatch)              \
   V(Canvas, drawArc)                \
   V(Canvas, drawPath)               \
   V(Canvas, drawImage)              \
@@ -67,11 +78,25 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Canvas);
   V(Canvas, drawAtlas)              \
   V(Canvas, drawShadow)
 
+// The methods that only take numbers, which Dart calls through FFI leaf calls.
+// They must not call into the Dart API. They don't check whether UI operations
+// are allowed, because a canvas can only be constructed where they are.
+#define FOR_EACH_FFI_BINDING(V) \
+  V(Canvas, save)               \
+  V(Canvas, restore)            \
+  V(Canvas, getSaveCount)       \
+  V(Canvas, translate)          \
+  V(Canvas, scale)              \
+  V(Canvas, rotate)             \
+  V(Canvas, skew)               \
+  V(Canvas, clipRect)
+
 FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
 
 void Canvas::RegisterNatives(tonic::DartLibraryNatives* natives) {
   natives->Register({{"Canvas_constructor", Canvas_constructor, 6, true},
                      FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
+  natives->RegisterFfi({FOR_EACH_FFI_BINDING(DART_REGISTER_FFI_NATIVE)});
 }
 
 fml::RefPtr<Canvas> Canvas::Create(PictureRecorder* recorder,
@@ -248,7 +273,8 @@ void Canvas::clipPath(const CanvasPath* path, bool doAntiAlias) {
     return;
   }
   if (display_list_recorder_) {
-    builder()->clipPath(path->path(), SkClipOp::kIntersect, doAntiAlias);
+    builder()->clipPath(path->deduplicated_path(), SkClipOp::kIntersect,
+                        doAntiAlias);
   } else if (canvas_) {
     canvas_->clipPath(path->path(), doAntiAlias);
   }
@@ -378,6 +404,106 @@ void Canvas::drawCircle(double x,
   }
 }
 
+void Canvas::drawBatch(Dart_Handle paint_objects,
+                       Dart_Handle paint_data,
+                       Dart_Handle ops,
+                       int op_count) {
+  if (!display_list_recorder_ && !canvas_) {
+    return;
+  }
+
+  // The operations are copied out of the typed data so that the paints, which
+  // are read from Dart, can be synchronized between them.
+  std::vector<float> values;
+  {
+    tonic::Float32List list(ops);
+    FML_DCHECK(op_count >= 0 &&
+               static_cast<size_t>(op_count) * kBatchValuesPerOp <=
+                   list.num_elements());
+    const size_t value_count =
+        std::min(static_cast<size_t>(std::max(op_count, 0)) * kBatchValuesPerOp,
+                 list.num_elements() / kBatchValuesPerOp * kBatchValuesPerOp);
+    values.assign(list.data(), list.data() + value_count);
+  }
+
+  intptr_t paint_count = 0;
+  Dart_ListLength(paint_data, &paint_count);
+
+  Paint paint;
+  SkPaint sk_paint;
+  intptr_t current_paint = -1;
+  int current_kind = -1;
+  for (size_t i = 0; i < values.size(); i += kBatchValuesPerOp) {
+    const int kind = static_cast<int>(values[i + kBatchOpKindIndex]);
+    const intptr_t paint_index =
+        static_cast<intptr_t>(values[i + kBatchOpPaintIndex]);
+    if (paint_index < 0 || paint_index >= paint_count) {
+      FML_DCHECK(false);
+      continue;
+    }
+    const float* op = &values[i + kBatchOpValuesIndex];
+
+    if (paint_index != current_paint) {
+      paint = Paint(Dart_ListGetAt(paint_objects, paint_index),
+                    Dart_ListGetAt(paint_data, paint_index));
+      if (!display_list_recorder_) {
+        sk_paint = SkPaint();
+        paint.paint(sk_paint);
+      }
+    }
+    // The attributes only need to be synchronized again when the paint or the
+    // kind of operation, which uses other attributes, changes.
+    const bool sync =
+        display_list_recorder_ &&
+        (paint_index != current_paint || kind != current_kind);
+    current_paint = paint_index;
+    current_kind = kind;
+
+    switch (static_cast<BatchOp>(kind)) {
+      case BatchOp::kRect: {
+        const SkRect rect = SkRect::MakeLTRB(op[0], op[1], op[2], op[3]);
+        if (display_list_recorder_) {
+          if (sync) {
+            paint.sync_to(builder(), kDrawRectFlags);
+          }
+          builder()->drawRect(rect);
+        } else {
+          canvas_->drawRect(rect, sk_paint);
+        }
+        break;
+      }
+      case BatchOp::kLine: {
+        const SkPoint p0 = SkPoint::Make(op[0], op[1]);
+        const SkPoint p1 = SkPoint::Make(op[2], op[3]);
+        if (display_list_recorder_) {
+          if (sync) {
+            paint.sync_to(builder(), kDrawLineFlags);
+          }
+          builder()->drawLine(p0, p1);
+        } else {
+          canvas_->drawLine(p0, p1, sk_paint);
+        }
+        break;
+      }
+      case BatchOp::kCircle: {
+        const SkPoint center = SkPoint::Make(op[0], op[1]);
+        if (display_list_recorder_) {
+          if (sync) {
+            paint.sync_to(builder(), kDrawCircleFlags);
+          }
+          builder()->drawCircle(center, op[2]);
+        } else {
+          canvas_->drawCircle(center, op[2], sk_paint);
+        }
+        break;
+      }
+      default:
+        FML_DCHECK(false);
+        break;
+    }
+  }
+}
+
 void Canvas::drawArc(double left,
                      double top,
                      double right,
@@ -415,7 +541,7 @@ void Canvas::drawPath(const CanvasPath* path,
   }
   if (display_list_recorder_) {
     paint.sync_to(builder(), kDrawPathFlags);
-    builder()->drawPath(path->path());
+    builder()->drawPath(path->deduplicated_path());
   } else if (canvas_) {
     SkPaint sk_paint;
     canvas_->drawPath(path->path(), *paint.paint(sk_paint));
@@ -94,6 +94,12 @@ class Canvas : public RefCountedDartWrappable<Canvas>, DisplayListOpFlags {
                   double radius,
                   const Paint& paint,
                   const PaintData& paint_data);
+  // Draws the operations encoded by a CanvasBatch, which references its paints
+  // by their index in the two lists of paint objects and paint data.
+  void drawBatch(Dart_Handle paint_objects,
+                 Dart_Handle paint_data,
+                 Dart_Handle ops,
+                 int op_count);
   void drawArc(double left,
                double top,
                double right,
@@ -0,0 +1,146 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+
+#include <cstring>
+#include <iterator>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+// Hashes the bytes eight at a time with FNV-1a and a final avalanche step.
+uint64_t HashBytes(const uint8_t* bytes, size_t size) {
+  constexpr uint64_t kPrime = 0x100000001b3;
+  uint64_t hash = 0xcbf29ce484222325;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, bytes + i, sizeof(word));
+    hash = (hash ^ word) * kPrime;
+  }
+  for (; i < size; i++) {
+    hash = (hash ^ bytes[i]) * kPrime;
+  }
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccd;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+}  // namespace
+
+bool DecodedImageCache::Key::operator==(const Key& other) const {
+  return content_hash == other.content_hash &&
+         encoded_size == other.encoded_size && subset == other.subset &&
+         target_width == other.target_width &&
+         target_height == other.target_height;
+}
+
+size_t DecodedImageCache::KeyHash::operator()(const Key& key) const {
+  return fml::HashCombine(key.content_hash, key.subset.left(),
+                          key.subset.top(), key.subset.right(),
+                          key.subset.bottom(), key.target_width,
+                          key.target_height);
+}
+
+DecodedImageCache::Key DecodedImageCache::MakeKey(const SkData& encoded_data,
+                                                  const SkIRect& subset,
+                                                  uint32_t target_width,
+                                                  uint32_t target_height) {
+  TRACE_EVENT0("flutter", "DecodedImageCache::MakeKey");
+  return {HashBytes(encoded_data.bytes(), encoded_data.size()),
+          encoded_data.size(), subset, target_width, target_height};
+}
+
+DecodedImageCache::DecodedImageCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+DecodedImageCache::~DecodedImageCache() {
+  Purge();
+}
+
+SkiaGPUObject<SkImage> DecodedImageCache::Get(const Key& key,
+                                              const SkData& encoded_data) {
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    return {};
+  }
+  auto entry = found->second;
+  if (!entry->encoded_data->equals(&encoded_data)) {
+    return {};
+  }
+  entries_.splice(entries_.begin(), entries_, entry);
+  return {entry->image, entry->unref_queue};
+}
+
+void DecodedImageCache::Put(const Key& key,
+                            sk_sp<SkData> encoded_data,
+                            sk_sp<SkImage> image,
+                            fml::RefPtr<SkiaUnrefQueue> unref_queue) {
+  if (!encoded_data || !image) {
+    return;
+  }
+  const size_t byte_size =
+      encoded_data->size() + image->imageInfo().computeMinByteSize();
+  if (byte_size > max_bytes_) {
+    return;
+  }
+
+  std::scoped_lock lock(mutex_);
+  // A collision of the hashes replaces the older entry.
+  auto found = index_.find(key);
+  if (found != index_.end()) {
+    EraseLocked(found->second);
+  }
+  entries_.push_front({key, std::move(encoded_data), std::move(image),
+                       std::move(unref_queue), byte_size});
+  index_[key] = entries_.begin();
+  byte_size_ += byte_size;
+  while (byte_size_ > max_bytes_) {
+    EraseLocked(std::prev(entries_.end()));
+  }
+}
+
+void DecodedImageCache::Purge() {
+  std::scoped_lock lock(mutex_);
+  while (!entries_.empty()) {
+    EraseLocked(entries_.begin());
+  }
+}
+
+size_t DecodedImageCache::Trim(size_t max_bytes) {
+  std::scoped_lock lock(mutex_);
+  const size_t byte_size = byte_size_;
+  while (byte_size_ > max_bytes) {
+    EraseLocked(std::prev(entries_.end()));
+  }
+  return byte_size - byte_size_;
+}
+
+size_t DecodedImageCache::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+size_t DecodedImageCache::GetByteSize() const {
+  std::scoped_lock lock(mutex_);
+  return byte_size_;
+}
+
+void DecodedImageCache::EraseLocked(Entries::iterator entry) {
+  byte_size_ -= entry->byte_size;
+  index_.erase(entry->key);
+  if (entry->unref_queue) {
+    entry->unref_queue->Unref(entry->image.release());
+  }
+  entries_.erase(entry);
+}
+
+}  // namespace flutter
@@ -0,0 +1,135 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
+#define FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/include/core/SkRefCnt.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A cache of the images that the `ImageDecoder` has decoded, so that the same
+/// encoded bytes requested again at the same size, for example after the
+/// framework evicted the image from its own cache, give back the decoded image
+/// instead of being decoded again.
+///
+/// Entries are found by a hash of the encoded bytes and checked against the
+/// bytes themselves, so that a hash collision never returns the wrong image.
+/// The least recently used entries are evicted once the images and their
+/// encoded bytes take more than the budget of the cache.
+///
+/// The cache is owned by the IO manager, whose resource context the uploaded
+/// images belong to, so it is shared by all of the engines that share that IO
+/// manager. It may be used from any thread.
+///
+class DecodedImageCache {
+ public:
+  struct Key {
+    uint64_t content_hash;
+    size_t encoded_size;
+    SkIRect subset;
+    uint32_t target_width;
+    uint32_t target_height;
+
+    bool operator==(const Key& other) const;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the key of a decode of the encoded bytes. This hashes
+  ///             all of the bytes, so it should not be called on the UI
+  ///             thread.
+  ///
+  static Key MakeKey(const SkData& encoded_data,
+                     const SkIRect& subset,
+                     uint32_t target_width,
+                     uint32_t target_height);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a cache that keeps at most `max_bytes` of images and
+  ///             encoded bytes. A cache with a budget of zero keeps nothing.
+  ///
+  explicit DecodedImageCache(size_t max_bytes);
+
+  ~DecodedImageCache();
+
+  size_t GetMaxBytes() const { return max_bytes_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the image decoded for the key and the encoded bytes,
+  ///             and marks it as the most recently used, or an empty object if
+  ///             there is none.
+  ///
+  SkiaGPUObject<SkImage> Get(const Key& key, const SkData& encoded_data);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Remembers the image decoded for the key from the encoded
+  ///             bytes, and evicts the least recently used images that no
+  ///             longer fit. The cache keeps a reference to the image, which it
+  ///             releases on the unref queue if there is one.
+  ///
+  void Put(const Key& key,
+           sk_sp<SkData> encoded_data,
+           sk_sp<SkImage> image,
+           fml::RefPtr<SkiaUnrefQueue> unref_queue);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops all of the entries, for example when the system is low
+  ///             on memory.
+  ///
+  void Purge();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops the least recently used entries until the cache uses at
+  ///             most `max_bytes`, for example under moderate memory
+  ///             pressure. This does not lower the budget of the cache.
+  ///
+  /// @return     The bytes of the dropped entries.
+  ///
+  size_t Trim(size_t max_bytes);
+
+  size_t GetEntryCount() const;
+
+  size_t GetByteSize() const;
+
+ private:
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Entry {
+    Key key;
+    sk_sp<SkData> encoded_data;
+    sk_sp<SkImage> image;
+    fml::RefPtr<SkiaUnrefQueue> unref_queue;
+    size_t byte_size;
+  };
+
+  using Entries = std::list<Entry>;
+
+  const size_t max_bytes_;
+  mutable std::mutex mutex_;
+  // The most recently used entry is the first.
+  Entries entries_;
+  std::unordered_map<Key, Entries::iterator, KeyHash> index_;
+  size_t byte_size_ = 0;
+
+  void EraseLocked(Entries::iterator entry);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DecodedImageCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+sk_sp<SkData> MakeEncodedData(const std::string& contents) {
+  return SkData::MakeWithCopy(contents.data(), contents.size());
+}
+
+sk_sp<SkImage> MakeImage(int width, int height) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(width, height);
+  bitmap.eraseColor(SK_ColorRED);
+  bitmap.setImmutable();
+  return SkImage::MakeFromBitmap(bitmap);
+}
+
+DecodedImageCache::Key MakeKey(const sk_sp<SkData>& data,
+                               uint32_t width,
+                               uint32_t height) {
+  return DecodedImageCache::MakeKey(*data, SkIRect::MakeWH(width, height),
+                                    width, height);
+}
+
+}  // namespace
+
+TEST(DecodedImageCacheTest, ReturnsTheImageOfTheSameBytesAndSize) {
+  DecodedImageCache cache(1 << 20);
+  auto data = MakeEncodedData("encoded image");
+  auto image = MakeImage(10, 10);
+
+  cache.Put(MakeKey(data, 10, 10), data, image, nullptr);
+
+  // Equal bytes in another buffer find the image too.
+  auto copy = MakeEncodedData("encoded image");
+  auto cached = cache.Get(MakeKey(copy, 10, 10), *copy);
+  EXPECT_EQ(cached.skia_object(), image);
+
+  EXPECT_FALSE(cache.Get(MakeKey(data, 5, 5), *data).skia_object());
+  auto other = MakeEncodedData("other image");
+  EXPECT_FALSE(cache.Get(MakeKey(other, 10, 10), *other).skia_object());
+}
+
+TEST(DecodedImageCacheTest, EntriesAreCheckedAgainstTheEncodedBytes) {
+  DecodedImageCache cache(1 << 20);
+  auto data = MakeEncodedData("encoded image");
+  auto other = MakeEncodedData("other image!!");
+  ASSERT_EQ(data->size(), other->size());
+
+  cache.Put(MakeKey(data, 10, 10), data, MakeImage(10, 10), nullptr);
+
+  // Looks up the key of the first bytes, as if the hashes of both collided.
+  EXPECT_FALSE(cache.Get(MakeKey(data, 10, 10), *other).skia_object());
+}
+
+TEST(DecodedImageCacheTest, EvictsTheLeastRecentlyUsedImages) {
+  auto first = MakeEncodedData("first");
+  auto second = MakeEncodedData("second");
+  auto third = MakeEncodedData("third");
+  const size_t image_bytes = 10 * 10 * 4;
+  // Fits two of the images with their encoded bytes.
+  DecodedImageCache cache(2 * image_bytes + first->size() + second->size() +
+                          third->size());
+
+  cache.Put(MakeKey(first, 10, 10), first, MakeImage(10, 10), nullptr);
+  cache.Put(MakeKey(second, 10, 10), second, MakeImage(10, 10), nullptr);
+  EXPECT_TRUE(cache.Get(MakeKey(first, 10, 10), *first).skia_object());
+  cache.Put(MakeKey(third, 10, 10), third, MakeImage(10, 10), nullptr);
+
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+  EXPECT_LE(cache.GetByteSize(), cache.GetMaxBytes());
+  EXPECT_TRUE(cache.Get(MakeKey(first, 10, 10), *first).skia_object());
+  EXPECT_FALSE(cache.Get(MakeKey(second, 10, 10), *second).skia_object());
+  EXPECT_TRUE(cache.Get(MakeKey(third, 10, 10), *third).skia_object());
+}
+
+TEST(DecodedImageCacheTest, ImagesLargerThanTheBudgetAreNotKept) {
+  DecodedImageCache cache(100);
+  auto data = MakeEncodedData("encoded image");
+
+  cache.Put(MakeKey(data, 10, 10), data, MakeImage(10, 10), nullptr);
+
+  EXPECT_EQ(cache.GetEntryCount(), 0u);
+  EXPECT_EQ(cache.GetByteSize(), 0u);
+}
+
+TEST(DecodedImageCacheTest, PurgeDropsAllOfTheImages) {
+  DecodedImageCache cache(1 << 20);
+  auto data = MakeEncodedData("encoded image");
+  auto image = MakeImage(10, 10);
+
+  cache.Put(MakeKey(data, 10, 10), data, image, nullptr);
+  cache.Put(MakeKey(data, 5, 5), data, MakeImage(5, 5), nullptr);
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+  EXPECT_FALSE(image->unique());
+
+  cache.Purge();
+  EXPECT_EQ(cache.GetEntryCount(), 0u);
+  EXPECT_EQ(cache.GetByteSize(), 0u);
+  EXPECT_TRUE(image->unique());
+}
+
+TEST(DecodedImageCacheTest, TrimDropsTheLeastRecentlyUsedImages) {
+  auto first = MakeEncodedData("first");
+  auto second = MakeEncodedData("second");
+  DecodedImageCache cache(1 << 20);
+
+  cache.Put(MakeKey(first, 10, 10), first, MakeImage(10, 10), nullptr);
+  cache.Put(MakeKey(second, 10, 10), second, MakeImage(10, 10), nullptr);
+  EXPECT_TRUE(cache.Get(MakeKey(first, 10, 10), *first).skia_object());
+  const size_t byte_size = cache.GetByteSize();
+  const size_t second_bytes = 10 * 10 * 4 + second->size();
+
+  EXPECT_EQ(cache.Trim(byte_size), 0u);
+  EXPECT_EQ(cache.Trim(byte_size - 1), second_bytes);
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+  EXPECT_TRUE(cache.Get(MakeKey(first, 10, 10), *first).skia_object());
+  EXPECT_EQ(cache.GetMaxBytes(), 1u << 20);
+}
+
+}  // namespace testing
+}  // namespace flutter
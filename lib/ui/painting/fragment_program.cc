@@ -3,6 +3,8 @@
 // found in the LICENSE file.
 
 #include <iostream>
+#include <mutex>
+#include <unordered_map>
 
 #include "flutter/lib/ui/painting/fragment_program.h"
 
@@ -19,6 +21,42 @@ using tonic::ToDart;
 
 namespace flutter {
 
+namespace {
+
+// The most runtime effects kept for the fragment programs created next.
+constexpr size_t kMaxCachedRuntimeEffects = 64;
+
+// The runtime effects compiled from the SkSL of the fragment programs, which
+// are shared by all of the engines of the process.
+struct RuntimeEffectCache {
+  std::mutex mutex;
+  std::unordered_map<std::string, sk_sp<SkRuntimeEffect>> effects;
+};
+
+RuntimeEffectCache& GetRuntimeEffectCache() {
+  static RuntimeEffectCache* cache = new RuntimeEffectCache();
+  return *cache;
+}
+
+sk_sp<SkRuntimeEffect> GetCachedRuntimeEffect(const std::string& sksl) {
+  auto& cache = GetRuntimeEffectCache();
+  std::scoped_lock lock(cache.mutex);
+  auto found = cache.effects.find(sksl);
+  return found == cache.effects.end() ? nullptr : found->second;
+}
+
+void CacheRuntimeEffect(const std::string& sksl,
+                        sk_sp<SkRuntimeEffect> effect) {
+  auto& cache = GetRuntimeEffectCache();
+  std::scoped_lock lock(cache.mutex);
+  if (cache.effects.size() >= kMaxCachedRuntimeEffects) {
+    cache.effects.erase(cache.effects.begin());
+  }
+  cache.effects[sksl] = std::move(effect);
+}
+
+}  // namespace
+
 static void FragmentProgram_constructor(Dart_NativeArguments args) {
   DartCallConstructor(&FragmentProgram::Create, args);
 }
@@ -38,15 +76,19 @@ void FragmentProgram::RegisterNatives(tonic::DartLibraryNatives* natives) {
 }
 
 void FragmentProgram::init(std::string sksl, bool debugPrintSksl) {
-  SkRuntimeEffect::Result result =
-      SkRuntimeEffect::MakeForShader(SkString(sksl));
-  runtime_effect_ = result.effect;
-
-  if (runtime_effect_ == nullptr) {
-    Dart_ThrowException(tonic::ToDart(
-        std::string("Invalid SkSL:\n") + sksl.c_str() +
-        std::string("\nSkSL Error:\n") + result.errorText.c_str()));
-    return;
+  runtime_effect_ = GetCachedRuntimeEffect(sksl);
+  if (!runtime_effect_) {
+    SkRuntimeEffect::Result result =
+        SkRuntimeEffect::MakeForShader(SkString(sksl));
+    runtime_effect_ = result.effect;
+
+    if (runtime_effect_ == nullptr) {
+      Dart_ThrowException(tonic::ToDart(
+          std::string("Invalid SkSL:\n") + sksl.c_str() +
+          std::string("\nSkSL Error:\n") + result.errorText.c_str()));
+      return;
+    }
+    CacheRuntimeEffect(sksl, runtime_effect_);
   }
   if (debugPrintSksl) {
     FML_DLOG(INFO) << std::string("debugPrintSksl:\n") + sksl.c_str();
@@ -5,19 +5,90 @@
 #include "flutter/lib/ui/painting/image_decoder.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "flutter/fml/make_copyable.h"
 #include "third_party/skia/include/codec/SkCodec.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkImageGenerator.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/core/SkYUVAPixmaps.h"
 
 namespace flutter {
 
+namespace {
+
+// The decoded images with fewer pixels than this are resized faster on the
+// CPU than they are uploaded and resized on the GPU.
+constexpr int64_t kMinGPUResizePixelCount = 512 * 512;
+
+// Serves YUVA planes decoded ahead of time. Skia uploads the planes of the
+// images it makes from this generator when they are first drawn on a GPU
+// surface, and converts them to RGBA on the GPU. The images are decoded again
+// from the encoded data in the cases where planes cannot be used.
+class YUVAPlanesImageGenerator : public SkImageGenerator {
+ public:
+  YUVAPlanesImageGenerator(const SkImageInfo& info,
+                           SkYUVAPixmaps planes,
+                           sk_sp<SkData> encoded_data)
+      : SkImageGenerator(info),
+        planes_(std::move(planes)),
+        encoded_data_(std::move(encoded_data)) {}
+
+  ~YUVAPlanesImageGenerator() override = default;
+
+ protected:
+  // |SkImageGenerator|
+  sk_sp<SkData> onRefEncodedData() override { return encoded_data_; }
+
+  // |SkImageGenerator|
+  bool onGetPixels(const SkImageInfo& info,
+                   void* pixels,
+                   size_t row_bytes,
+                   const Options& options) override {
+    TRACE_EVENT0("flutter", "YUVAPlanesImageGenerator::onGetPixels");
+    auto generator = SkCodecImageGenerator::MakeFromEncodedCodec(encoded_data_);
+    return generator && generator->getPixels(info, pixels, row_bytes);
+  }
+
+  // |SkImageGenerator|
+  bool onQueryYUVAInfo(
+      const SkYUVAPixmapInfo::SupportedDataTypes& supported_data_types,
+      SkYUVAPixmapInfo* yuva_pixmap_info) const override {
+    *yuva_pixmap_info = planes_.pixmapsInfo();
+    return yuva_pixmap_info->isSupported(supported_data_types);
+  }
+
+  // |SkImageGenerator|
+  bool onGetYUVAPlanes(const SkYUVAPixmaps& yuva_pixmaps) override {
+    for (int i = 0; i < planes_.numPlanes(); i++) {
+      if (!planes_.plane(i).readPixels(yuva_pixmaps.plane(i))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  const SkYUVAPixmaps planes_;
+  const sk_sp<SkData> encoded_data_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(YUVAPlanesImageGenerator);
+};
+
+}  // namespace
+
 ImageDecoder::ImageDecoder(
     TaskRunners runners,
     std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
-    fml::WeakPtr<IOManager> io_manager)
+    fml::WeakPtr<IOManager> io_manager,
+    bool decode_to_yuva_planes,
+    bool resize_on_gpu)
     : runners_(std::move(runners)),
       concurrent_task_runner_(std::move(concurrent_task_runner)),
       io_manager_(std::move(io_manager)),
+      decode_to_yuva_planes_(decode_to_yuva_planes),
+      resize_on_gpu_(resize_on_gpu),
       weak_factory_(this) {
   FML_DCHECK(runners_.IsValid());
   FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread())
@@ -26,7 +97,10 @@ ImageDecoder::ImageDecoder(
 
 ImageDecoder::~ImageDecoder() = default;
 
+// Resizes the |source_rect| of the image, which is the whole image unless
+// only a region of it was requested.
 static sk_sp<SkImage> ResizeRasterImage(sk_sp<SkImage> image,
+                                        const SkRect& source_rect,
                                         const SkISize& resized_dimensions,
                                         const fml::tracing::TraceFlow& flow) {
   FML_DCHECK(!image->isTextureBacked());
@@ -39,7 +113,8 @@ static sk_sp<SkImage> ResizeRasterImage(sk_sp<SkImage> image,
     return nullptr;
   }
 
-  if (image->dimensions() == resized_dimensions) {
+  const bool is_whole_image = source_rect == SkRect::Make(image->bounds());
+  if (is_whole_image && image->dimensions() == resized_dimensions) {
     return image->makeRasterImage();
   }
 
@@ -53,12 +128,20 @@ static sk_sp<SkImage> ResizeRasterImage(sk_sp<SkImage> image,
     return nullptr;
   }
 
-  if (!image->scalePixels(
-          scaled_bitmap.pixmap(),
-          SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kNone),
-          SkImage::kDisallow_CachingHint)) {
-    FML_LOG(ERROR) << "Could not scale pixels";
-    return nullptr;
+  const SkSamplingOptions sampling(SkFilterMode::kLinear, SkMipmapMode::kNone);
+  if (is_whole_image) {
+    if (!image->scalePixels(scaled_bitmap.pixmap(), sampling,
+                            SkImage::kDisallow_CachingHint)) {
+      FML_LOG(ERROR) << "Could not scale pixels";
+      return nullptr;
+    }
+  } else {
+    SkCanvas canvas(scaled_bitmap);
+    SkPaint paint;
+    paint.setBlendMode(SkBlendMode::kSrc);
+    canvas.drawImageRect(image, source_rect,
+                         SkRect::Make(scaled_bitmap.bounds()), sampling,
+                         &paint, SkCanvas::kStrict_SrcRectConstraint);
   }
 
   // Marking this as immutable makes the MakeFromBitmap call share the pixels
@@ -74,11 +157,122 @@ static sk_sp<SkImage> ResizeRasterImage(sk_sp<SkImage> image,
   return scaled_image;
 }
 
+// Same as |ResizeRasterImage|, but leaves the resize to the GPU when
+// |deferred_resize| is given and the image is large enough, in which case the
+// image is returned as is, in raster form, and the resize is stored.
+static sk_sp<SkImage> ResizeOrDeferResize(
+    sk_sp<SkImage> image,
+    const SkRect& source_rect,
+    const SkISize& resized_dimensions,
+    const fml::tracing::TraceFlow& flow,
+    std::optional<ImageResize>* deferred_resize) {
+  const bool is_resized = source_rect != SkRect::Make(image->bounds()) ||
+                         image->dimensions() != resized_dimensions;
+  if (deferred_resize && is_resized && !resized_dimensions.isEmpty() &&
+      static_cast<int64_t>(image->width()) * image->height() >=
+          kMinGPUResizePixelCount) {
+    *deferred_resize = ImageResize{source_rect, resized_dimensions};
+    return image->makeRasterImage();
+  }
+  return ResizeRasterImage(std::move(image), source_rect, resized_dimensions,
+                           flow);
+}
+
+// Resizes the image by uploading it with mipmaps to |context| and drawing it
+// into a render target of the resized dimensions, which is read back so that
+// the result can be uploaded as a cross-context image like any other. The
+// full size texture is freed as soon as the draw is done. Returns null if the
+// GPU cannot resize the image.
+static sk_sp<SkImage> ResizeRasterImageOnGPU(
+    sk_sp<SkImage> image,
+    const ImageResize& resize,
+    GrDirectContext* context,
+    const fml::tracing::TraceFlow& flow) {
+  FML_DCHECK(!image->isTextureBacked());
+
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  flow.Step(__FUNCTION__);
+
+  const int max_texture_size = context->maxTextureSize();
+  if (image->width() > max_texture_size ||
+      image->height() > max_texture_size) {
+    return nullptr;
+  }
+
+  // The GPU generates the mipmaps, so the draw below samples the levels
+  // closest to the resized dimensions instead of skipping over pixels.
+  sk_sp<SkImage> texture_image =
+      image->makeTextureImage(context, GrMipmapped::kYes, SkBudgeted::kNo);
+  if (!texture_image) {
+    return nullptr;
+  }
+
+  const SkImageInfo resized_info =
+      image->imageInfo().makeDimensions(resize.dimensions);
+  sk_sp<SkSurface> surface =
+      SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, resized_info);
+  if (!surface) {
+    return nullptr;
+  }
+
+  const bool is_whole_image =
+      resize.source_rect == SkRect::Make(image->bounds());
+  SkPaint paint;
+  paint.setBlendMode(SkBlendMode::kSrc);
+  surface->getCanvas()->drawImageRect(
+      texture_image, resize.source_rect, SkRect::Make(resized_info.bounds()),
+      SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kLinear), &paint,
+      is_whole_image ? SkCanvas::kFast_SrcRectConstraint
+                     : SkCanvas::kStrict_SrcRectConstraint);
+
+  SkBitmap resized_bitmap;
+  if (!resized_bitmap.tryAllocPixels(resized_info)) {
+    FML_LOG(ERROR) << "Failed to allocate memory for bitmap of size "
+                   << resized_info.computeMinByteSize() << "B";
+    return nullptr;
+  }
+  // Reading the pixels flushes the draw, after which nothing refers to the
+  // full size texture any more.
+  const bool did_read = surface->readPixels(resized_bitmap.pixmap(), 0, 0);
+  texture_image.reset();
+  surface.reset();
+  if (!did_read) {
+    return nullptr;
+  }
+
+  resized_bitmap.setImmutable();
+  return SkImage::MakeFromBitmap(resized_bitmap);
+}
+
+// Applies the resize that the worker left to the IO thread, on the GPU if
+// there is one, and on the CPU otherwise.
+static sk_sp<SkImage> ApplyDeferredResize(sk_sp<SkImage> image,
+                                          const ImageResize& resize,
+                                          fml::WeakPtr<IOManager> io_manager,
+                                          const fml::tracing::TraceFlow& flow) {
+  sk_sp<SkImage> resized_image;
+  if (auto context = io_manager->GetResourceContext()) {
+    io_manager->GetIsGpuDisabledSyncSwitch()->Execute(
+        fml::SyncSwitch::Handlers().SetIfFalse(
+            [&resized_image, &image, &resize, &context, &flow] {
+              resized_image =
+                  ResizeRasterImageOnGPU(image, resize, context.get(), flow);
+            }));
+  }
+  if (!resized_image) {
+    resized_image = ResizeRasterImage(std::move(image), resize.source_rect,
+                                      resize.dimensions, flow);
+  }
+  return resized_image;
+}
+
 static sk_sp<SkImage> ImageFromDecompressedData(
     ImageDescriptor* descriptor,
+    const SkIRect& subset,
     uint32_t target_width,
     uint32_t target_height,
-    const fml::tracing::TraceFlow& flow) {
+    const fml::tracing::TraceFlow& flow,
+    std::optional<ImageResize>* deferred_resize) {
   TRACE_EVENT0("flutter", __FUNCTION__);
   flow.Step(__FUNCTION__);
   auto image = SkImage::MakeRasterData(
@@ -89,37 +283,56 @@ static sk_sp<SkImage> ImageFromDecompressedData(
     return nullptr;
   }
 
-  if (!target_width && !target_height) {
+  if (!target_width && !target_height && subset == image->bounds()) {
     // No resizing requested. Just rasterize the image.
     return image->makeRasterImage();
   }
 
-  return ResizeRasterImage(std::move(image),
-                           SkISize::Make(target_width, target_height), flow);
+  return ResizeOrDeferResize(std::move(image), SkRect::Make(subset),
+                             SkISize::Make(target_width, target_height), flow,
+                             deferred_resize);
 }
 
-sk_sp<SkImage> ImageFromCompressedData(ImageDescriptor* descriptor,
-                                       uint32_t target_width,
-                                       uint32_t target_height,
-                                       const fml::tracing::TraceFlow& flow) {
-  TRACE_EVENT0("flutter", __FUNCTION__);
-  flow.Step(__FUNCTION__);
-
-  if (!descriptor->should_resize(target_width, target_height)) {
-    // No resizing requested. Just decode & rasterize the image.
-    sk_sp<SkImage> image = descriptor->image();
-    return image ? image->makeRasterImage() : nullptr;
+// Finds the smallest size that the image can be efficiently decoded at that is
+// at least |minimum_dimensions|, or the size of the image if there is none.
+//
+// The codecs round the scale to the closest one they support, which may be
+// below the requested one, so the scale is raised until the size suffices.
+static SkISize GetScaledDimensionsAtOrAbove(
+    ImageDescriptor* descriptor,
+    const SkISize& minimum_dimensions) {
+  const SkISize source_dimensions = descriptor->image_info().dimensions();
+  float scale = std::max(static_cast<float>(minimum_dimensions.width()) /
+                             source_dimensions.width(),
+                         static_cast<float>(minimum_dimensions.height()) /
+                             source_dimensions.height());
+  // Raising the scale by a pixel more than the shortfall lands on the next
+  // supported size, so a few attempts are enough for all of the codecs.
+  const float pixel_scale =
+      1.0f / std::max(source_dimensions.width(), source_dimensions.height());
+  for (int attempt = 0; attempt < 4 && scale < 1; attempt++) {
+    const SkISize dimensions = descriptor->get_scaled_dimensions(scale);
+    if (dimensions.width() >= minimum_dimensions.width() &&
+        dimensions.height() >= minimum_dimensions.height()) {
+      return dimensions;
+    }
+    const float shortfall = std::max(
+        static_cast<float>(minimum_dimensions.width()) /
+            std::max(dimensions.width(), 1),
+        static_cast<float>(minimum_dimensions.height()) /
+            std::max(dimensions.height(), 1));
+    scale = std::min(1.0f, scale * shortfall + pixel_scale);
   }
+  return source_dimensions;
+}
 
+// Decodes the whole image at the smallest size that it can be efficiently
+// decoded at that is at least |minimum_dimensions|.
+static sk_sp<SkImage> DecodeScaledImage(ImageDescriptor* descriptor,
+                                        const SkISize& minimum_dimensions) {
   const SkISize source_dimensions = descriptor->image_info().dimensions();
-  const SkISize resized_dimensions = {static_cast<int32_t>(target_width),
-                                      static_cast<int32_t>(target_height)};
-
-  auto decode_dimensions = descriptor->get_scaled_dimensions(
-      std::max(static_cast<double>(resized_dimensions.width()) /
-                   source_dimensions.width(),
-               static_cast<double>(resized_dimensions.height()) /
-                   source_dimensions.height()));
+  const SkISize decode_dimensions =
+      GetScaledDimensionsAtOrAbove(descriptor, minimum_dimensions);
 
   // If the codec supports efficient sub-pixel decoding, decoded at a resolution
   // close to the target resolution before resizing.
@@ -147,17 +360,161 @@ sk_sp<SkImage> ImageFromCompressedData(ImageDescriptor* descriptor,
             << "Could not create a scaled image from a scaled bitmap.";
         return nullptr;
       }
-      return ResizeRasterImage(std::move(decoded_image), resized_dimensions,
-                               flow);
+      return decoded_image;
+    }
+  }
+
+  return descriptor->image();
+}
+
+// Decodes only the |subset| of the image at about |scale| times its size if
+// the codec supports it. Returns the decoded region, which contains the subset,
+// and where the subset is in it.
+static sk_sp<SkImage> DecodeImageSubset(ImageDescriptor* descriptor,
+                                        const SkIRect& subset,
+                                        float scale,
+                                        SkRect* subset_in_image) {
+  SkIRect decoded_subset = subset;
+  const SkISize decode_dimensions =
+      descriptor->get_scaled_subset_dimensions(scale, &decoded_subset);
+  if (decode_dimensions.isEmpty()) {
+    return nullptr;
+  }
+
+  auto image_info = descriptor->image_info().makeDimensions(decode_dimensions);
+  SkBitmap bitmap;
+  if (!bitmap.tryAllocPixels(image_info)) {
+    FML_LOG(ERROR) << "Failed to allocate memory for bitmap of size "
+                   << image_info.computeMinByteSize() << "B";
+    return nullptr;
+  }
+  if (!descriptor->get_subset_pixels(decoded_subset, bitmap.pixmap())) {
+    return nullptr;
+  }
+  bitmap.setImmutable();
+  auto image = SkImage::MakeFromBitmap(bitmap);
+  if (!image) {
+    return nullptr;
+  }
+
+  const float scale_x =
+      static_cast<float>(decode_dimensions.width()) / decoded_subset.width();
+  const float scale_y =
+      static_cast<float>(decode_dimensions.height()) / decoded_subset.height();
+  *subset_in_image = SkRect::MakeXYWH(
+      (subset.left() - decoded_subset.left()) * scale_x,
+      (subset.top() - decoded_subset.top()) * scale_y,
+      subset.width() * scale_x, subset.height() * scale_y);
+  subset_in_image->intersect(SkRect::Make(image->bounds()));
+  return image;
+}
+
+sk_sp<SkImage> ImageFromCompressedData(ImageDescriptor* descriptor,
+                                       uint32_t target_width,
+                                       uint32_t target_height,
+                                       const fml::tracing::TraceFlow& flow) {
+  return ImageFromCompressedData(
+      descriptor, SkIRect::MakeSize(descriptor->image_info().dimensions()),
+      target_width, target_height, flow);
+}
+
+sk_sp<SkImage> ImageFromCompressedData(
+    ImageDescriptor* descriptor,
+    const SkIRect& subset,
+    uint32_t target_width,
+    uint32_t target_height,
+    const fml::tracing::TraceFlow& flow,
+    std::optional<ImageResize>* deferred_resize) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  flow.Step(__FUNCTION__);
+
+  const SkISize source_dimensions = descriptor->image_info().dimensions();
+  const bool is_whole_image = subset == SkIRect::MakeSize(source_dimensions);
+
+  if (is_whole_image &&
+      !descriptor->should_resize(target_width, target_height)) {
+    // No resizing requested. Just decode & rasterize the image.
+    sk_sp<SkImage> image = descriptor->image();
+    return image ? image->makeRasterImage() : nullptr;
+  }
+
+  const SkISize resized_dimensions = {static_cast<int32_t>(target_width),
+                                      static_cast<int32_t>(target_height)};
+  if (resized_dimensions.isEmpty() || subset.isEmpty()) {
+    FML_LOG(ERROR) << "Could not resize to empty dimensions.";
+    return nullptr;
+  }
+
+  const float scale =
+      std::max(static_cast<float>(resized_dimensions.width()) / subset.width(),
+               static_cast<float>(resized_dimensions.height()) /
+                   subset.height());
+
+  if (!is_whole_image) {
+    SkRect subset_in_image;
+    if (auto image =
+            DecodeImageSubset(descriptor, subset, scale, &subset_in_image)) {
+      return ResizeOrDeferResize(std::move(image), subset_in_image,
+                                 resized_dimensions, flow, deferred_resize);
     }
   }
 
-  auto image = descriptor->image();
+  // Decodes the whole image at a size at which the subset is at least as large
+  // as the target, and crops it. The rounding errors of the scale are ignored
+  // so that they do not add a pixel.
+  const auto scaled = [scale](int32_t length) {
+    return static_cast<int32_t>(std::ceil(length * scale - 0.001f));
+  };
+  const SkISize minimum_dimensions = {scaled(source_dimensions.width()),
+                                      scaled(source_dimensions.height())};
+  auto image = DecodeScaledImage(descriptor, minimum_dimensions);
   if (!image) {
     return nullptr;
   }
 
-  return ResizeRasterImage(std::move(image), resized_dimensions, flow);
+  const float scale_x =
+      static_cast<float>(image->width()) / source_dimensions.width();
+  const float scale_y =
+      static_cast<float>(image->height()) / source_dimensions.height();
+  const SkRect subset_in_image =
+      is_whole_image ? SkRect::Make(image->bounds())
+                     : SkRect::MakeXYWH(subset.left() * scale_x,
+                                        subset.top() * scale_y,
+                                        subset.width() * scale_x,
+                                        subset.height() * scale_y);
+  return ResizeOrDeferResize(std::move(image), subset_in_image,
+                             resized_dimensions, flow, deferred_resize);
+}
+
+sk_sp<SkImage> ImageFromYUVAPlanes(ImageDescriptor* descriptor,
+                                   const fml::tracing::TraceFlow& flow) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  flow.Step(__FUNCTION__);
+
+  // All GPUs sample single channel 8 bit textures, which are what the JPEG
+  // decoder produces.
+  SkYUVAPixmapInfo::SupportedDataTypes supported_data_types;
+  for (int channels = 1; channels <= 4; channels++) {
+    supported_data_types.enableDataType(SkYUVAPixmapInfo::DataType::kUnorm8,
+                                        channels);
+  }
+  SkYUVAPixmapInfo yuva_pixmap_info;
+  if (!descriptor->query_yuva_info(supported_data_types, &yuva_pixmap_info)) {
+    return nullptr;
+  }
+
+  auto planes = SkYUVAPixmaps::Allocate(yuva_pixmap_info);
+  if (!planes.isValid()) {
+    FML_LOG(ERROR) << "Failed to allocate memory for the YUVA planes of size "
+                   << yuva_pixmap_info.computeTotalBytes() << "B";
+    return nullptr;
+  }
+  if (!descriptor->get_yuva_planes(planes)) {
+    return nullptr;
+  }
+
+  return SkImage::MakeFromGenerator(std::make_unique<YUVAPlanesImageGenerator>(
+      descriptor->image_info(), std::move(planes), descriptor->data()));
 }
 
 static SkiaGPUObject<SkImage> UploadRasterImage(
@@ -216,7 +573,17 @@ static SkiaGPUObject<SkImage> UploadRasterImage(
   return result;
 }
 
+void ImageDecoder::Decode(fml::RefPtr<ImageDescriptor> descriptor,
+                          uint32_t target_width,
+                          uint32_t target_height,
+                          const ImageResult& result) {
+  const SkIRect subset =
+      SkIRect::MakeSize(descriptor->image_info().dimensions());
+  Decode(std::move(descriptor), subset, target_width, target_height, result);
+}
+
 void ImageDecoder::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
+                          const SkIRect& subset,
                           uint32_t target_width,
                           uint32_t target_height,
                           const ImageResult& callback) {
@@ -264,26 +631,66 @@ void ImageDecoder::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
   }
 
   concurrent_task_runner_->PostTask(
-      fml::MakeCopyable([raw_descriptor,                          //
-                         io_manager = io_manager_,                //
-                         io_runner = runners_.GetIOTaskRunner(),  //
-                         result,                                  //
-                         target_width = target_width,             //
-                         target_height = target_height,           //
-                         flow = std::move(flow)                   //
+      fml::MakeCopyable([raw_descriptor,                                  //
+                         io_manager = io_manager_,                        //
+                         io_runner = runners_.GetIOTaskRunner(),          //
+                         result,                                          //
+                         subset = subset,                                 //
+                         target_width = target_width,                     //
+                         target_height = target_height,                   //
+                         decode_to_yuva_planes = decode_to_yuva_planes_,  //
+                         resize_on_gpu = resize_on_gpu_,                  //
+                         decoded_image_cache = decoded_image_cache_,      //
+                         flow = std::move(flow)                           //
   ]() mutable {
+        // Step 0: Look for an earlier decode of the same bytes.
+        // On Worker.
+
+        std::optional<DecodedImageCache::Key> cache_key;
+        if (decoded_image_cache && raw_descriptor->is_compressed()) {
+          const SkData& encoded_data = *raw_descriptor->data();
+          cache_key = DecodedImageCache::MakeKey(encoded_data, subset,
+                                                 target_width, target_height);
+          auto cached = decoded_image_cache->Get(*cache_key, encoded_data);
+          if (cached.skia_object()) {
+            result(std::move(cached), std::move(flow));
+            return;
+          }
+        }
+
         // Step 1: Decompress the image.
         // On Worker.
 
-        auto decompressed = raw_descriptor->is_compressed()
-                                ? ImageFromCompressedData(raw_descriptor,  //
-                                                          target_width,    //
-                                                          target_height,   //
-                                                          flow)
-                                : ImageFromDecompressedData(raw_descriptor,  //
-                                                            target_width,    //
-                                                            target_height,   //
-                                                            flow);
+        sk_sp<SkImage> decompressed;
+        const bool is_whole_image =
+            subset ==
+            SkIRect::MakeSize(raw_descriptor->image_info().dimensions());
+        // The planes are only used for images that are not resized, because
+        // the decoders only produce them at full size.
+        if (decode_to_yuva_planes && raw_descriptor->is_compressed() &&
+            is_whole_image &&
+            !raw_descriptor->should_resize(target_width, target_height)) {
+          decompressed = ImageFromYUVAPlanes(raw_descriptor, flow);
+        }
+        // The large images are left for the IO thread to resize on the
+        // GPU.
+        std::optional<ImageResize> deferred_resize;
+        if (!decompressed) {
+          auto* resize = resize_on_gpu ? &deferred_resize : nullptr;
+          decompressed = raw_descriptor->is_compressed()
+                             ? ImageFromCompressedData(raw_descriptor,  //
+                                                       subset,          //
+                                                       target_width,    //
+                                                       target_height,   //
+                                                       flow,            //
+                                                       resize)
+                             : ImageFromDecompressedData(raw_descriptor,  //
+                                                         subset,          //
+                                                         target_width,    //
+                                                         target_height,   //
+                                                         flow,            //
+                                                         resize);
+        }
 
         if (!decompressed) {
           FML_DLOG(ERROR) << "Could not decompress image.";
@@ -294,37 +701,90 @@ void ImageDecoder::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
         // Step 2: Update the image to the GPU.
         // On IO Thread.
 
-        io_runner->PostTask(fml::MakeCopyable([io_manager, decompressed, result,
-                                               flow =
-                                                   std::move(flow)]() mutable {
-          if (!io_manager) {
-            FML_DLOG(ERROR) << "Could not acquire IO manager.";
-            result({}, std::move(flow));
-            return;
-          }
-
-          // If the IO manager does not have a resource context, the caller
-          // might not have set one or a software backend could be in use.
-          // Either way, just return the image as-is.
-          if (!io_manager->GetResourceContext()) {
-            result({std::move(decompressed), io_manager->GetSkiaUnrefQueue()},
-                   std::move(flow));
-            return;
-          }
-
-          auto uploaded =
-              UploadRasterImage(std::move(decompressed), io_manager, flow);
+        io_runner->PostTask(fml::MakeCopyable(
+            [io_manager, decompressed, deferred_resize, result,
+             decoded_image_cache, cache_key,
+             encoded_data = raw_descriptor->data(),
+             flow = std::move(flow)]() mutable {
+              if (!io_manager) {
+                FML_DLOG(ERROR) << "Could not acquire IO manager.";
+                result({}, std::move(flow));
+                return;
+              }
+
+              if (deferred_resize) {
+                decompressed = ApplyDeferredResize(
+                    std::move(decompressed), *deferred_resize, io_manager,
+                    flow);
+                if (!decompressed) {
+                  FML_DLOG(ERROR) << "Could not resize image.";
+                  result({}, std::move(flow));
+                  return;
+                }
+              }
+
+              SkiaGPUObject<SkImage> image;
+              if (decompressed->isLazyGenerated()) {
+                bool is_gpu_disabled = !io_manager->GetResourceContext();
+                io_manager->GetIsGpuDisabledSyncSwitch()->Execute(
+                    fml::SyncSwitch::Handlers().SetIfTrue(
+                        [&is_gpu_disabled] { is_gpu_disabled = true; }));
+                // Without a GPU to convert the YUVA planes, they are converted
+                // to RGBA here instead.
+                if (is_gpu_disabled) {
+                  decompressed = decompressed->makeRasterImage();
+                  if (!decompressed) {
+                    FML_DLOG(ERROR) << "Could not decompress image.";
+                    result({}, std::move(flow));
+                    return;
+                  }
+                }
+              }
+
+              if (decompressed->isLazyGenerated() ||
+                  !io_manager->GetResourceContext()) {
+                // The images of YUVA planes are uploaded and converted by the
+                // GPU when they are first drawn. If the IO manager does not
+                // have a resource context, the caller might not have set one or
+                // a software backend could be in use. Either way, just return
+                // the image as-is.
+                image = {std::move(decompressed),
+                         io_manager->GetSkiaUnrefQueue()};
+              } else {
+                image = UploadRasterImage(std::move(decompressed), io_manager,
+                                          flow);
+                if (!image.skia_object()) {
+                  FML_DLOG(ERROR) << "Could not upload image to the GPU.";
+                  result({}, std::move(flow));
+                  return;
+                }
+              }
+
+              if (cache_key) {
+                decoded_image_cache->Put(*cache_key, std::move(encoded_data),
+                                         image.skia_object(),
+                                         io_manager->GetSkiaUnrefQueue());
+              }
+
+              // Finally, all done.
+              result(std::move(image), std::move(flow));
+            }));
+      }),
+      // The user is waiting on the decode to see the image.
+      fml::ConcurrentTaskPriority::kUserBlocking);
+}
 
-          if (!uploaded.skia_object()) {
-            FML_DLOG(ERROR) << "Could not upload image to the GPU.";
-            result({}, std::move(flow));
-            return;
-          }
+void ImageDecoder::SetDecodedImageCache(
+    std::shared_ptr<DecodedImageCache> cache) {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  decoded_image_cache_ = std::move(cache);
+}
 
-          // Finally, all done.
-          result(std::move(uploaded), std::move(flow));
-        }));
-      }));
+void ImageDecoder::SetAnimatedImageFrameBudget(int prefetch_frame_count,
+                                               size_t frame_cache_max_bytes) {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  animated_image_prefetch_frame_count_ = prefetch_frame_count;
+  animated_image_frame_cache_max_bytes_ = frame_cache_max_bytes;
 }
 
 fml::WeakPtr<ImageDecoder> ImageDecoder::GetWeakPtr() const {
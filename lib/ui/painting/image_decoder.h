@@ -15,10 +15,12 @@
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/io_manager.h"
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
 #include "flutter/lib/ui/painting/image_descriptor.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
 #include "third_party/skia/include/core/SkSize.h"
 
@@ -31,10 +33,20 @@ namespace flutter {
 // occur in a frame pipeline.
 class ImageDecoder {
  public:
+  // If |decode_to_yuva_planes| is set, the images that are not resized are
+  // decoded into YUVA planes when their codecs support it, like JPEG, which the
+  // GPU then converts to RGBA. This shrinks the upload of these images to less
+  // than half, but it happens on the raster thread when they are first drawn.
+  //
+  // If |resize_on_gpu| is set, the large images that the codecs cannot decode
+  // at their target size are resized on the IO thread by drawing them into a
+  // texture of that size, instead of being resized on the CPU by the worker.
   ImageDecoder(
       TaskRunners runners,
       std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
-      fml::WeakPtr<IOManager> io_manager);
+      fml::WeakPtr<IOManager> io_manager,
+      bool decode_to_yuva_planes = false,
+      bool resize_on_gpu = false);
 
   ~ImageDecoder();
 
@@ -50,21 +62,83 @@ class ImageDecoder {
               uint32_t target_height,
               const ImageResult& result);
 
+  // Same as above, but only decodes the |subset| of the image, in the EXIF
+  // oriented coordinates of the descriptor, and resizes it to the target. The
+  // codecs that support it decode the subset on its own, sub-sampled to the
+  // closest size at or above the target, and the others decode the whole image
+  // and crop it.
+  void Decode(fml::RefPtr<ImageDescriptor> descriptor,
+              const SkIRect& subset,
+              uint32_t target_width,
+              uint32_t target_height,
+              const ImageResult& result);
+
+  // Makes the decoder look up the compressed images in the cache before it
+  // decodes them, and remember them there after. The cache is off when it is
+  // null, which is the default.
+  void SetDecodedImageCache(std::shared_ptr<DecodedImageCache> cache);
+
+  // Makes the codecs of animated images decode up to |prefetch_frame_count|
+  // frames ahead of the one asked for on the concurrent task runner, and keep
+  // all of the frames of the animations whose frames fit in
+  // |frame_cache_max_bytes| after their first loop. Both are off by default.
+  void SetAnimatedImageFrameBudget(int prefetch_frame_count,
+                                   size_t frame_cache_max_bytes);
+
+  int GetAnimatedImagePrefetchFrameCount() const {
+    return animated_image_prefetch_frame_count_;
+  }
+
+  size_t GetAnimatedImageFrameCacheMaxBytes() const {
+    return animated_image_frame_cache_max_bytes_;
+  }
+
+  std::shared_ptr<fml::ConcurrentTaskRunner> GetConcurrentTaskRunner() const {
+    return concurrent_task_runner_;
+  }
+
   fml::WeakPtr<ImageDecoder> GetWeakPtr() const;
 
  private:
   TaskRunners runners_;
   std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
   fml::WeakPtr<IOManager> io_manager_;
+  const bool decode_to_yuva_planes_;
+  const bool resize_on_gpu_;
+  std::shared_ptr<DecodedImageCache> decoded_image_cache_;
+  int animated_image_prefetch_frame_count_ = 0;
+  size_t animated_image_frame_cache_max_bytes_ = 0;
   fml::WeakPtrFactory<ImageDecoder> weak_factory_;
   FML_DISALLOW_COPY_AND_ASSIGN(ImageDecoder);
 };
 
+// The resize of the |source_rect| of a decoded image to |dimensions|.
+struct ImageResize {
+  SkRect source_rect;
+  SkISize dimensions;
+};
+
 sk_sp<SkImage> ImageFromCompressedData(ImageDescriptor* descriptor,
                                        uint32_t target_width,
                                        uint32_t target_height,
                                        const fml::tracing::TraceFlow& flow);
 
+// If |deferred_resize| is given, the decoded images that are large enough to
+// be resized faster on the GPU are returned as they are decoded, and the
+// resize that they still need is stored in it.
+sk_sp<SkImage> ImageFromCompressedData(
+    ImageDescriptor* descriptor,
+    const SkIRect& subset,
+    uint32_t target_width,
+    uint32_t target_height,
+    const fml::tracing::TraceFlow& flow,
+    std::optional<ImageResize>* deferred_resize = nullptr);
+
+// Decodes the image into YUVA planes at full size if its codec supports it.
+// The result is a lazy image that is converted to RGBA when it is drawn.
+sk_sp<SkImage> ImageFromYUVAPlanes(ImageDescriptor* descriptor,
+                                   const fml::tracing::TraceFlow& flow);
+
 }  // namespace flutter
 
 #endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_H_
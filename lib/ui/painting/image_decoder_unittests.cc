@@ -377,6 +377,78 @@ TEST_F(ImageDecoderFixtureTest, CanDecodeWithoutAGPUContext) {
   latch.Wait();
 }
 
+TEST_F(ImageDecoderFixtureTest, DecodesTheSameBytesAtTheSameSizeOnce) {
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  TaskRunners runners(GetCurrentTestName(),         // label
+                      CreateNewThread("platform"),  // platform
+                      CreateNewThread("raster"),    // raster
+                      CreateNewThread("ui"),        // ui
+                      CreateNewThread("io")         // io
+  );
+
+  fml::AutoResetWaitableEvent latch;
+
+  std::unique_ptr<TestIOManager> io_manager;
+  std::unique_ptr<ImageDecoder> image_decoder;
+  auto cache = std::make_shared<DecodedImageCache>(64 * 1024 * 1024);
+  sk_sp<SkImage> first_image;
+
+  auto release_io_manager = [&]() {
+    cache.reset();
+    io_manager.reset();
+    latch.Signal();
+  };
+
+  auto decode_image_twice = [&]() {
+    image_decoder = std::make_unique<ImageDecoder>(
+        runners, loop->GetTaskRunner(), io_manager->GetWeakIOManager());
+    image_decoder->SetDecodedImageCache(cache);
+
+    auto data = OpenFixtureAsSkData("DashInNooglerHat.jpg");
+    ASSERT_TRUE(data);
+
+    ImageGeneratorRegistry registry;
+    auto make_descriptor = [&registry](sk_sp<SkData> data) {
+      std::shared_ptr<ImageGenerator> generator =
+          registry.CreateCompatibleGenerator(data);
+      return fml::MakeRefCounted<ImageDescriptor>(std::move(data),
+                                                  std::move(generator));
+    };
+    auto descriptor = make_descriptor(data);
+    // The second decode is of a copy of the bytes.
+    auto copy_descriptor =
+        make_descriptor(SkData::MakeWithCopy(data->data(), data->size()));
+
+    ImageDecoder::ImageResult second_callback =
+        [&](SkiaGPUObject<SkImage> image) {
+          ASSERT_TRUE(runners.GetUITaskRunner()->RunsTasksOnCurrentThread());
+          EXPECT_EQ(image.skia_object(), first_image);
+          EXPECT_EQ(cache->GetEntryCount(), 1u);
+          first_image.reset();
+          image_decoder.reset();
+          runners.GetIOTaskRunner()->PostTask(release_io_manager);
+        };
+    ImageDecoder::ImageResult first_callback =
+        [&, copy_descriptor, second_callback](SkiaGPUObject<SkImage> image) {
+          ASSERT_TRUE(runners.GetUITaskRunner()->RunsTasksOnCurrentThread());
+          ASSERT_TRUE(image.skia_object());
+          first_image = image.skia_object();
+          image_decoder->Decode(copy_descriptor, copy_descriptor->width(),
+                                copy_descriptor->height(), second_callback);
+        };
+    image_decoder->Decode(descriptor, descriptor->width(), descriptor->height(),
+                          first_callback);
+  };
+
+  auto setup_io_manager_and_decode = [&]() {
+    io_manager = std::make_unique<TestIOManager>(runners.GetIOTaskRunner());
+    runners.GetUITaskRunner()->PostTask(decode_image_twice);
+  };
+
+  runners.GetIOTaskRunner()->PostTask(setup_io_manager_and_decode);
+  latch.Wait();
+}
+
 TEST_F(ImageDecoderFixtureTest, CanDecodeWithResizes) {
   const auto image_dimensions =
       SkImage::MakeFromEncoded(OpenFixtureAsSkData("DashInNooglerHat.jpg"))
@@ -450,6 +522,66 @@ TEST_F(ImageDecoderFixtureTest, CanDecodeWithResizes) {
   PostTaskSync(runners.GetUITaskRunner(), [&]() { image_decoder.reset(); });
 }
 
+TEST_F(ImageDecoderFixtureTest, CanDecodeWithResizesOnTheGPU) {
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  TaskRunners runners(GetCurrentTestName(),         // label
+                      CreateNewThread("platform"),  // platform
+                      CreateNewThread("raster"),    // raster
+                      CreateNewThread("ui"),        // ui
+                      CreateNewThread("io")         // io
+  );
+
+  fml::AutoResetWaitableEvent latch;
+  std::unique_ptr<IOManager> io_manager;
+  std::unique_ptr<ImageDecoder> image_decoder;
+
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() {
+    io_manager = std::make_unique<TestIOManager>(runners.GetIOTaskRunner());
+  });
+
+  PostTaskSync(runners.GetUITaskRunner(), [&]() {
+    image_decoder = std::make_unique<ImageDecoder>(
+        runners, loop->GetTaskRunner(), io_manager->GetWeakIOManager(),
+        /*decode_to_yuva_planes=*/false, /*resize_on_gpu=*/true);
+  });
+
+  auto decoded_size = [&](uint32_t target_width,
+                          uint32_t target_height) -> SkISize {
+    SkISize final_size = SkISize::MakeEmpty();
+    runners.GetUITaskRunner()->PostTask([&]() {
+      auto data = OpenFixtureAsSkData("DashInNooglerHat.jpg");
+      ASSERT_TRUE(data);
+
+      ImageGeneratorRegistry registry;
+      std::shared_ptr<ImageGenerator> generator =
+          registry.CreateCompatibleGenerator(data);
+      ASSERT_TRUE(generator);
+
+      auto descriptor = fml::MakeRefCounted<ImageDescriptor>(
+          std::move(data), std::move(generator));
+
+      ImageDecoder::ImageResult callback = [&](SkiaGPUObject<SkImage> image) {
+        ASSERT_TRUE(runners.GetUITaskRunner()->RunsTasksOnCurrentThread());
+        ASSERT_TRUE(image.skia_object());
+        final_size = image.skia_object()->dimensions();
+        latch.Signal();
+      };
+      image_decoder->Decode(descriptor, target_width, target_height, callback);
+    });
+    latch.Wait();
+    return final_size;
+  };
+
+  // The JPEG decoder sub-samples the image to 1134x1512 for this size, which
+  // is then resized on the GPU.
+  ASSERT_EQ(decoded_size(1000, 1000), SkISize::Make(1000, 1000));
+  ASSERT_EQ(decoded_size(100, 100), SkISize::Make(100, 100));
+
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() { io_manager.reset(); });
+
+  PostTaskSync(runners.GetUITaskRunner(), [&]() { image_decoder.reset(); });
+}
+
 // TODO(https://github.com/flutter/flutter/issues/81232) - disabled due to
 // flakiness
 TEST_F(ImageDecoderFixtureTest, DISABLED_CanResizeWithoutDecode) {
@@ -610,6 +742,128 @@ TEST(ImageDecoderTest, VerifySubpixelDecodingPreservesExifOrientation) {
   assert_image(decode(300, 100));
 }
 
+TEST(ImageDecoderTest, VerifySubsetDecoding) {
+  auto data = OpenFixtureAsSkData("Horizontal.jpg");
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+
+  // The JPEG decoder decodes any region, sub-sampled.
+  SkIRect subset = SkIRect::MakeXYWH(300, 0, 300, 200);
+  ASSERT_EQ(generator->GetScaledSubsetDimensions(0.5, &subset),
+            SkISize::Make(150, 100));
+  ASSERT_EQ(subset, SkIRect::MakeXYWH(300, 0, 300, 200));
+
+  auto descriptor =
+      fml::MakeRefCounted<ImageDescriptor>(data, std::move(generator));
+  auto image = ImageFromCompressedData(descriptor.get(), subset, 150, 100,
+                                       fml::tracing::TraceFlow(""));
+  ASSERT_TRUE(image);
+  ASSERT_EQ(image->dimensions(), SkISize::Make(150, 100));
+
+  // The region matches the same region of the whole decoded image.
+  auto whole_image = ImageFromCompressedData(descriptor.get(), 300, 100,
+                                             fml::tracing::TraceFlow(""));
+  ASSERT_TRUE(whole_image);
+  SkBitmap region, whole_region;
+  ASSERT_TRUE(region.tryAllocPixels(image->imageInfo()));
+  ASSERT_TRUE(whole_region.tryAllocPixels(image->imageInfo()));
+  ASSERT_TRUE(image->readPixels(region.pixmap(), 0, 0));
+  ASSERT_TRUE(whole_image->readPixels(whole_region.pixmap(), 150, 0));
+  for (int y = 0; y < 100; y += 10) {
+    for (int x = 0; x < 150; x += 10) {
+      const SkColor color = region.getColor(x, y);
+      const SkColor whole_color = whole_region.getColor(x, y);
+      EXPECT_NEAR(SkColorGetR(color), SkColorGetR(whole_color), 8);
+      EXPECT_NEAR(SkColorGetG(color), SkColorGetG(whole_color), 8);
+      EXPECT_NEAR(SkColorGetB(color), SkColorGetB(whole_color), 8);
+    }
+  }
+}
+
+TEST(ImageDecoderTest, LargeImagesAreLeftToResizeOnTheGPU) {
+  auto data = OpenFixtureAsSkData("DashInNooglerHat.jpg");
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+  auto descriptor =
+      fml::MakeRefCounted<ImageDescriptor>(data, std::move(generator));
+  const SkIRect whole_image = SkIRect::MakeWH(3024, 4032);
+
+  std::optional<ImageResize> deferred_resize;
+  auto image =
+      ImageFromCompressedData(descriptor.get(), whole_image, 1000, 1000,
+                              fml::tracing::TraceFlow(""), &deferred_resize);
+  ASSERT_TRUE(image);
+  ASSERT_FALSE(image->isLazyGenerated());
+  ASSERT_TRUE(deferred_resize);
+  EXPECT_EQ(deferred_resize->dimensions, SkISize::Make(1000, 1000));
+  EXPECT_EQ(deferred_resize->source_rect, SkRect::Make(image->bounds()));
+  EXPECT_GE(image->width(), 1000);
+  EXPECT_GE(image->height(), 1000);
+
+  // The images that are decoded small are still resized on the CPU.
+  deferred_resize.reset();
+  image = ImageFromCompressedData(descriptor.get(), whole_image, 100, 100,
+                                  fml::tracing::TraceFlow(""),
+                                  &deferred_resize);
+  ASSERT_TRUE(image);
+  ASSERT_FALSE(deferred_resize);
+  EXPECT_EQ(image->dimensions(), SkISize::Make(100, 100));
+}
+
+TEST(ImageDecoderTest, SubsetOutsideOfTheImageIsNotDecodedOnItsOwn) {
+  auto data = OpenFixtureAsSkData("Horizontal.jpg");
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+
+  SkIRect subset = SkIRect::MakeXYWH(500, 0, 300, 200);
+  ASSERT_TRUE(generator->GetScaledSubsetDimensions(0.5, &subset).isEmpty());
+}
+
+TEST(ImageDecoderTest, VerifyYUVAPlanesDecoding) {
+  auto data = OpenFixtureAsSkData("Horizontal.jpg");
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+  auto descriptor =
+      fml::MakeRefCounted<ImageDescriptor>(data, std::move(generator));
+
+  auto image =
+      ImageFromYUVAPlanes(descriptor.get(), fml::tracing::TraceFlow(""));
+  ASSERT_TRUE(image);
+  ASSERT_TRUE(image->isLazyGenerated());
+  ASSERT_EQ(image->dimensions(), SkISize::Make(600, 200));
+
+  // Without a GPU, the image is decoded into RGBA instead.
+  auto raster_image = image->makeRasterImage();
+  ASSERT_TRUE(raster_image);
+  ASSERT_EQ(raster_image->dimensions(), SkISize::Make(600, 200));
+}
+
+TEST(ImageDecoderTest, ImagesWithoutYUVAPlanesAreNotDecodedToThem) {
+  auto png_data = OpenFixtureAsSkData("Horizontal.png");
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(png_data);
+  ASSERT_TRUE(generator);
+  auto descriptor =
+      fml::MakeRefCounted<ImageDescriptor>(png_data, std::move(generator));
+
+  ASSERT_FALSE(
+      ImageFromYUVAPlanes(descriptor.get(), fml::tracing::TraceFlow("")));
+}
+
 TEST_F(ImageDecoderFixtureTest,
        MultiFrameCodecCanBeCollectedBeforeIOTasksFinish) {
   // This test verifies that the MultiFrameCodec safely shares state between
@@ -765,5 +1019,87 @@ TEST_F(ImageDecoderFixtureTest, MultiFrameCodecDidAccessGpuDisabledSyncSwitch) {
   PostTaskSync(runners.GetIOTaskRunner(), [&]() { io_manager.reset(); });
 }
 
+TEST_F(ImageDecoderFixtureTest, MultiFrameCodecKeepsAllFramesWithinItsBudget) {
+  auto settings = CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  auto vm_data = vm_ref.GetVMData();
+  auto loop = fml::ConcurrentMessageLoop::Create();
+
+  auto gif_mapping = OpenFixtureAsSkData("hello_loop_2.gif");
+
+  ASSERT_TRUE(gif_mapping);
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> gif_generator =
+      registry.CreateCompatibleGenerator(gif_mapping);
+  ASSERT_TRUE(gif_generator);
+
+  TaskRunners runners(GetCurrentTestName(),         // label
+                      CreateNewThread("platform"),  // platform
+                      CreateNewThread("raster"),    // raster
+                      CreateNewThread("ui"),        // ui
+                      CreateNewThread("io")         // io
+  );
+
+  std::unique_ptr<TestIOManager> io_manager;
+  fml::RefPtr<MultiFrameCodec> codec;
+
+  // Setup the IO manager.
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() {
+    io_manager = std::make_unique<TestIOManager>(runners.GetIOTaskRunner());
+  });
+
+  auto isolate = RunDartCodeInIsolate(vm_ref, settings, runners, "main", {},
+                                      GetDefaultKernelFilePath(),
+                                      io_manager->GetWeakIOManager());
+
+  MultiFrameCodec::FrameBudget budget;
+  budget.prefetch_task_runner = loop->GetTaskRunner();
+  budget.prefetch_frame_count = 2;
+  budget.frame_cache_max_bytes = 64 * 1024 * 1024;
+  codec = fml::MakeRefCounted<MultiFrameCodec>(std::move(gif_generator),
+                                               std::move(budget));
+  ASSERT_GT(codec->frameCount(), 1);
+
+  auto get_one_loop_of_frames = [&]() {
+    PostTaskSync(runners.GetUITaskRunner(), [&]() {
+      EXPECT_TRUE(isolate->RunInIsolateScope([&]() -> bool {
+        Dart_Handle closure = Dart_GetField(
+            Dart_RootLibrary(), Dart_NewStringFromCString("frameCallback"));
+        if (Dart_IsError(closure) || !Dart_IsClosure(closure)) {
+          return false;
+        }
+        for (int i = 0; i < codec->frameCount(); i++) {
+          codec->getNextFrame(closure);
+        }
+        return true;
+      }));
+    });
+    // Waits for the frames to be decoded and uploaded.
+    PostTaskSync(runners.GetIOTaskRunner(), [] {});
+  };
+
+  get_one_loop_of_frames();
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() {
+    EXPECT_TRUE(io_manager->did_access_is_gpu_disabled_sync_switch_);
+    io_manager->did_access_is_gpu_disabled_sync_switch_ = false;
+  });
+
+  // The frames of the next loop are neither decoded nor uploaded again.
+  get_one_loop_of_frames();
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() {
+    EXPECT_FALSE(io_manager->did_access_is_gpu_disabled_sync_switch_);
+  });
+
+  // Destroy the Isolate
+  isolate = nullptr;
+
+  // Destroy the MultiFrameCodec
+  PostTaskSync(runners.GetUITaskRunner(), [&]() { codec = nullptr; });
+
+  // Destroy the IO manager
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() { io_manager.reset(); });
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -6,7 +6,9 @@
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/painting/image_header.h"
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
 #include "flutter/lib/ui/painting/single_frame_codec.h"
 #include "flutter/lib/ui/ui_dart_state.h"
@@ -83,8 +85,31 @@ void ImageDescriptor::initEncoded(Dart_NativeArguments args) {
     return;
   }
 
-  auto generator =
-      registry->CreateCompatibleGenerator(immutable_buffer->data());
+  sk_sp<SkData> buffer = immutable_buffer->data();
+
+  // Creating a generator decodes the header of the image, with a platform
+  // decoder on some platforms, so images in the common formats are given
+  // their generator on the workers of the image decoder. The others are
+  // given one right away, which keeps the errors of data that is not an
+  // image synchronous.
+  std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner;
+  if (auto image_decoder = dart_state->GetImageDecoder()) {
+    worker_task_runner = image_decoder->GetConcurrentTaskRunner();
+  }
+  if (worker_task_runner &&
+      ReadImageHeader(buffer->bytes(), buffer->size()).has_value()) {
+    InitEncodedOnWorker(
+        std::move(buffer), registry->GetFactories(),
+        std::make_unique<tonic::DartPersistentValue>(dart_state,
+                                                     descriptor_handle),
+        std::make_unique<tonic::DartPersistentValue>(dart_state,
+                                                     callback_handle),
+        std::move(worker_task_runner),
+        dart_state->GetTaskRunners().GetUITaskRunner());
+    return;
+  }
+
+  auto generator = registry->CreateCompatibleGenerator(buffer);
 
   if (!generator) {
     // No compatible image decoder was found.
@@ -92,13 +117,52 @@ void ImageDescriptor::initEncoded(Dart_NativeArguments args) {
     return;
   }
 
-  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(
-      immutable_buffer->data(), std::move(generator));
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(std::move(buffer),
+                                                         std::move(generator));
 
   FML_DCHECK(descriptor);
 
   descriptor->AssociateWithDartWrapper(descriptor_handle);
-  tonic::DartInvoke(callback_handle, {Dart_TypeVoid()});
+  tonic::DartInvoke(callback_handle, {Dart_Null()});
+}
+
+void ImageDescriptor::InitEncodedOnWorker(
+    sk_sp<SkData> buffer,
+    std::vector<ImageGeneratorFactory> factories,
+    std::unique_ptr<tonic::DartPersistentValue> descriptor_handle,
+    std::unique_ptr<tonic::DartPersistentValue> callback,
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
+    fml::RefPtr<fml::TaskRunner> ui_task_runner) {
+  worker_task_runner->PostTask(fml::MakeCopyable(
+      [buffer = std::move(buffer), factories = std::move(factories),
+       descriptor_handle = std::move(descriptor_handle),
+       callback = std::move(callback),
+       ui_task_runner = std::move(ui_task_runner)]() mutable {
+        TRACE_EVENT0("flutter", "ImageDescriptor::CreateGenerator");
+        std::shared_ptr<ImageGenerator> generator =
+            ImageGeneratorRegistry::CreateCompatibleGenerator(factories,
+                                                              buffer);
+        // The persistent handles are only touched on the UI thread.
+        ui_task_runner->PostTask(fml::MakeCopyable(
+            [buffer = std::move(buffer), generator = std::move(generator),
+             descriptor_handle = std::move(descriptor_handle),
+             callback = std::move(callback)]() mutable {
+              auto dart_state = callback->dart_state().lock();
+              if (!dart_state) {
+                return;
+              }
+              tonic::DartState::Scope scope(dart_state);
+              if (!generator) {
+                tonic::DartInvoke(callback->value(),
+                                  {tonic::ToDart("Invalid image data")});
+                return;
+              }
+              auto descriptor = fml::MakeRefCounted<ImageDescriptor>(
+                  std::move(buffer), std::move(generator));
+              descriptor->AssociateWithDartWrapper(descriptor_handle->value());
+              tonic::DartInvoke(callback->value(), {Dart_Null()});
+            }));
+      }));
 }
 
 void ImageDescriptor::initRaw(Dart_Handle descriptor_handle,
@@ -127,14 +191,32 @@ void ImageDescriptor::initRaw(Dart_Handle descriptor_handle,
 
 void ImageDescriptor::instantiateCodec(Dart_Handle codec_handle,
                                        int target_width,
-                                       int target_height) {
+                                       int target_height,
+                                       int source_left,
+                                       int source_top,
+                                       int source_right,
+                                       int source_bottom) {
   fml::RefPtr<Codec> ui_codec;
   if (!generator_ || generator_->GetFrameCount() == 1) {
+    SkIRect subset = SkIRect::MakeLTRB(source_left, source_top, source_right,
+                                       source_bottom);
+    if (!subset.intersect(SkIRect::MakeSize(image_info_.dimensions()))) {
+      subset = SkIRect::MakeSize(image_info_.dimensions());
+    }
     ui_codec = fml::MakeRefCounted<SingleFrameCodec>(
-        static_cast<fml::RefPtr<ImageDescriptor>>(this), target_width,
+        static_cast<fml::RefPtr<ImageDescriptor>>(this), subset, target_width,
         target_height);
   } else {
-    ui_codec = fml::MakeRefCounted<MultiFrameCodec>(generator_);
+    MultiFrameCodec::FrameBudget budget;
+    if (auto image_decoder = UIDartState::Current()->GetImageDecoder()) {
+      budget.prefetch_task_runner = image_decoder->GetConcurrentTaskRunner();
+      budget.prefetch_frame_count =
+          image_decoder->GetAnimatedImagePrefetchFrameCount();
+      budget.frame_cache_max_bytes =
+          image_decoder->GetAnimatedImageFrameCacheMaxBytes();
+    }
+    ui_codec = fml::MakeRefCounted<MultiFrameCodec>(generator_,
+                                                    std::move(budget));
   }
   ui_codec->AssociateWithDartWrapper(codec_handle);
 }
@@ -149,4 +231,16 @@ bool ImageDescriptor::get_pixels(const SkPixmap& pixmap) const {
                                pixmap.rowBytes());
 }
 
+bool ImageDescriptor::get_subset_pixels(const SkIRect& subset,
+                                        const SkPixmap& pixmap) const {
+  FML_DCHECK(generator_);
+  return generator_->GetSubsetPixels(subset, pixmap.info(),
+                                     pixmap.writable_addr(), pixmap.rowBytes());
+}
+
+bool ImageDescriptor::get_yuva_planes(const SkYUVAPixmaps& yuva_pixmaps) const {
+  FML_DCHECK(generator_);
+  return generator_->GetYUVAPlanes(yuva_pixmaps);
+}
+
 }  // namespace flutter
@@ -8,8 +8,11 @@
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <vector>
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/image_generator_registry.h"
 #include "flutter/lib/ui/painting/immutable_buffer.h"
@@ -18,6 +21,7 @@
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/src/codec/SkCodecImageGenerator.h"
 #include "third_party/tonic/dart_library_natives.h"
+#include "third_party/tonic/dart_persistent_value.h"
 
 namespace flutter {
 
@@ -42,7 +46,9 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   ///         image, as long as the format is recognized by an encoder installed
   ///         in the `ImageGeneratorRegistry`. Calling this method will create
   ///         an `ImageGenerator` and read EXIF corrected dimensions from the
-  ///         image data.
+  ///         image data. The generator of a JPEG, PNG, WebP or GIF image is
+  ///         created on the workers of the image decoder, that of other
+  ///         images right away.
   /// @see    `ImageGeneratorRegistry`
   static void initEncoded(Dart_NativeArguments args);
 
@@ -56,7 +62,15 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
                       PixelFormat pixel_format);
 
   /// @brief  Associates a flutter::Codec object with the dart.ui Codec handle.
-  void instantiateCodec(Dart_Handle codec, int target_width, int target_height);
+  ///         Only the pixels within the source rect are decoded for single
+  ///         frame images.
+  void instantiateCodec(Dart_Handle codec,
+                        int target_width,
+                        int target_height,
+                        int source_left,
+                        int source_top,
+                        int source_right,
+                        int source_bottom);
 
   /// @brief  The width of this image, EXIF oriented if applicable.
   int width() const { return image_info_.width(); }
@@ -106,6 +120,35 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   ///         orientation tag, if applicable.
   bool get_pixels(const SkPixmap& pixmap) const;
 
+  /// @brief  Gets the scaled dimensions of a region of this image, if backed
+  ///         by an `ImageGenerator` that can decode the region on its own.
+  ///         Returns an empty size otherwise.
+  /// @see    `ImageGenerator::GetScaledSubsetDimensions`
+  SkISize get_scaled_subset_dimensions(float scale, SkIRect* subset) {
+    if (generator_) {
+      return generator_->GetScaledSubsetDimensions(scale, subset);
+    }
+    return SkISize::MakeEmpty();
+  }
+
+  /// @brief  Gets the pixels of a region of this image.
+  /// @see    `ImageGenerator::GetSubsetPixels`
+  bool get_subset_pixels(const SkIRect& subset, const SkPixmap& pixmap) const;
+
+  /// @brief  Whether this image can be decoded into YUVA planes, and their
+  ///         layout if so.
+  /// @see    `ImageGenerator::QueryYUVAInfo`
+  bool query_yuva_info(
+      const SkYUVAPixmapInfo::SupportedDataTypes& supported_data_types,
+      SkYUVAPixmapInfo* yuva_pixmap_info) const {
+    return generator_ &&
+           generator_->QueryYUVAInfo(supported_data_types, yuva_pixmap_info);
+  }
+
+  /// @brief  Gets the YUVA planes of this image.
+  /// @see    `ImageGenerator::GetYUVAPlanes`
+  bool get_yuva_planes(const SkYUVAPixmaps& yuva_pixmaps) const;
+
   void dispose() {
     buffer_.reset();
     generator_.reset();
@@ -125,6 +168,17 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   ImageDescriptor(sk_sp<SkData> buffer,
                   std::shared_ptr<ImageGenerator> generator);
 
+  // Tries the |factories| on the |worker_task_runner|, and then associates
+  // a descriptor with |descriptor_handle| and invokes |callback| on the
+  // |ui_task_runner|, with the error if no factory supports the image.
+  static void InitEncodedOnWorker(
+      sk_sp<SkData> buffer,
+      std::vector<ImageGeneratorFactory> factories,
+      std::unique_ptr<tonic::DartPersistentValue> descriptor_handle,
+      std::unique_ptr<tonic::DartPersistentValue> callback,
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
+      fml::RefPtr<fml::TaskRunner> ui_task_runner);
+
   sk_sp<SkData> buffer_;
   std::shared_ptr<ImageGenerator> generator_;
   const SkImageInfo image_info_;
@@ -10,6 +10,7 @@
 
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/build_config.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/image.h"
@@ -201,6 +202,7 @@ void EncodeImageAndInvokeDataCallback(
     fml::RefPtr<fml::TaskRunner> ui_task_runner,
     fml::RefPtr<fml::TaskRunner> raster_task_runner,
     fml::RefPtr<fml::TaskRunner> io_task_runner,
+    std::shared_ptr<fml::ConcurrentTaskRunner> encode_task_runner,
     fml::WeakPtr<GrDirectContext> resource_context,
     fml::WeakPtr<SnapshotDelegate> snapshot_delegate,
     const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch) {
@@ -210,12 +212,24 @@ void EncodeImageAndInvokeDataCallback(
       });
 
   auto encode_task = [callback_task = std::move(callback_task), format,
-                      ui_task_runner](sk_sp<SkImage> raster_image) {
-    sk_sp<SkData> encoded = EncodeImage(std::move(raster_image), format);
-    ui_task_runner->PostTask([callback_task = std::move(callback_task),
-                              encoded = std::move(encoded)]() mutable {
-      callback_task(std::move(encoded));
-    });
+                      ui_task_runner,
+                      encode_task_runner](sk_sp<SkImage> raster_image) {
+    auto encode = [callback_task, format, ui_task_runner,
+                   raster_image = std::move(raster_image)]() {
+      sk_sp<SkData> encoded = EncodeImage(raster_image, format);
+      ui_task_runner->PostTask([callback_task = std::move(callback_task),
+                                encoded = std::move(encoded)]() mutable {
+        callback_task(std::move(encoded));
+      });
+    };
+    // The encode of a large image takes long enough to hold up all of the
+    // uploads of the IO thread, so it happens on a worker instead. The pixels
+    // of the raster image may be read from any thread.
+    if (encode_task_runner) {
+      encode_task_runner->PostTask(std::move(encode));
+    } else {
+      encode();
+    }
   };
 
   ConvertImageToRaster(std::move(image), encode_task, raster_task_runner,
@@ -243,19 +257,26 @@ Dart_Handle EncodeImage(CanvasImage* canvas_image,
 
   const auto& task_runners = UIDartState::Current()->GetTaskRunners();
 
+  // The images are encoded on the workers of the image decoder.
+  std::shared_ptr<fml::ConcurrentTaskRunner> encode_task_runner;
+  if (auto image_decoder = UIDartState::Current()->GetImageDecoder()) {
+    encode_task_runner = image_decoder->GetConcurrentTaskRunner();
+  }
+
   task_runners.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
       [callback = std::move(callback), image = canvas_image->image(),
        image_format, ui_task_runner = task_runners.GetUITaskRunner(),
        raster_task_runner = task_runners.GetRasterTaskRunner(),
        io_task_runner = task_runners.GetIOTaskRunner(),
+       encode_task_runner = std::move(encode_task_runner),
        io_manager = UIDartState::Current()->GetIOManager(),
        snapshot_delegate =
            UIDartState::Current()->GetSnapshotDelegate()]() mutable {
         EncodeImageAndInvokeDataCallback(
             std::move(image), std::move(callback), image_format,
             std::move(ui_task_runner), std::move(raster_task_runner),
-            std::move(io_task_runner), io_manager->GetResourceContext(),
-            std::move(snapshot_delegate),
+            std::move(io_task_runner), std::move(encode_task_runner),
+            io_manager->GetResourceContext(), std::move(snapshot_delegate),
             io_manager->GetIsGpuDisabledSyncSwitch());
       }));
 
@@ -4,12 +4,37 @@
 
 #include "flutter/lib/ui/painting/image_generator.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "flutter/fml/logging.h"
 
 namespace flutter {
 
 ImageGenerator::~ImageGenerator() = default;
 
+SkISize ImageGenerator::GetScaledSubsetDimensions(float scale,
+                                                  SkIRect* subset) {
+  return SkISize::MakeEmpty();
+}
+
+bool ImageGenerator::GetSubsetPixels(const SkIRect& subset,
+                                     const SkImageInfo& info,
+                                     void* pixels,
+                                     size_t row_bytes) {
+  return false;
+}
+
+bool ImageGenerator::QueryYUVAInfo(
+    const SkYUVAPixmapInfo::SupportedDataTypes& supported_data_types,
+    SkYUVAPixmapInfo* yuva_pixmap_info) const {
+  return false;
+}
+
+bool ImageGenerator::GetYUVAPlanes(const SkYUVAPixmaps& yuva_pixmaps) {
+  return false;
+}
+
 sk_sp<SkImage> ImageGenerator::GetImage() {
   SkImageInfo info = GetInfo();
 
@@ -131,6 +156,72 @@ bool BuiltinSkiaCodecImageGenerator::GetPixels(
   return codec_generator_->getPixels(info, pixels, row_bytes, &options);
 }
 
+SkAndroidCodec* BuiltinSkiaCodecImageGenerator::GetRegionCodec() {
+  if (!region_codec_) {
+    region_codec_ =
+        SkAndroidCodec::MakeFromData(codec_generator_->refEncodedData());
+  }
+  return region_codec_.get();
+}
+
+SkISize BuiltinSkiaCodecImageGenerator::GetScaledSubsetDimensions(
+    float scale,
+    SkIRect* subset) {
+  auto codec = GetRegionCodec();
+  // The region codec ignores the EXIF orientation, so the regions of the
+  // images that have one would have to be rotated first.
+  if (!codec || codec->codec()->getOrigin() != kTopLeft_SkEncodedOrigin ||
+      !SkIRect::MakeSize(codec->getInfo().dimensions()).contains(*subset)) {
+    return SkISize::MakeEmpty();
+  }
+  // The codecs that decode regions directly only decode the ones that they
+  // align, which contain the requested one. The others decode any region.
+  SkIRect supported_subset = *subset;
+  if (codec->getSupportedSubset(&supported_subset) &&
+      supported_subset.contains(*subset)) {
+    *subset = supported_subset;
+  }
+  const int sample_size =
+      scale >= 1 ? 1 : std::max(1, static_cast<int>(std::floor(1 / scale)));
+  return codec->getSampledSubsetDimensions(sample_size, *subset);
+}
+
+bool BuiltinSkiaCodecImageGenerator::GetSubsetPixels(const SkIRect& subset,
+                                                     const SkImageInfo& info,
+                                                     void* pixels,
+                                                     size_t row_bytes) {
+  auto codec = GetRegionCodec();
+  if (!codec || info.isEmpty()) {
+    return false;
+  }
+  const int sample_size = std::max(1, subset.width() / info.width());
+  if (codec->getSampledSubsetDimensions(sample_size, subset) !=
+      info.dimensions()) {
+    FML_DLOG(ERROR) << "The region cannot be decoded at the requested size.";
+    return false;
+  }
+  SkIRect options_subset = subset;
+  SkAndroidCodec::AndroidOptions options;
+  options.fSampleSize = sample_size;
+  options.fSubset = &options_subset;
+  const auto result =
+      codec->getAndroidPixels(info, pixels, row_bytes, &options);
+  return result == SkCodec::kSuccess || result == SkCodec::kIncompleteInput ||
+         result == SkCodec::kErrorInInput;
+}
+
+bool BuiltinSkiaCodecImageGenerator::QueryYUVAInfo(
+    const SkYUVAPixmapInfo::SupportedDataTypes& supported_data_types,
+    SkYUVAPixmapInfo* yuva_pixmap_info) const {
+  return codec_generator_->queryYUVAInfo(supported_data_types,
+                                         yuva_pixmap_info);
+}
+
+bool BuiltinSkiaCodecImageGenerator::GetYUVAPlanes(
+    const SkYUVAPixmaps& yuva_pixmaps) {
+  return codec_generator_->getYUVAPlanes(yuva_pixmaps);
+}
+
 std::unique_ptr<ImageGenerator> BuiltinSkiaCodecImageGenerator::MakeFromData(
     sk_sp<SkData> data) {
   auto codec = SkCodec::MakeFromData(data);
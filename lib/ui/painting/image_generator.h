@@ -7,7 +7,10 @@
 
 #include <optional>
 #include "flutter/fml/macros.h"
+#include "third_party/skia/include/codec/SkAndroidCodec.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
+#include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/include/core/SkYUVAPixmaps.h"
 #include "third_party/skia/src/codec/SkCodecImageGenerator.h"
 
 namespace flutter {
@@ -123,10 +126,69 @@ class ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) = 0;
 
+  /// @brief          Given a scale value and a region of the image, find the
+  ///                 closest size that the region can be efficiently decoded
+  ///                 at on its own, without decoding the rest of the image. If
+  ///                 region decoding is not supported by the decoder, this
+  ///                 method should return an empty size, and the whole image
+  ///                 is decoded and cropped instead.
+  /// @param[in]      scale   The desired scale factor of the region.
+  /// @param[in,out]  subset  The region of the image, in the coordinates of
+  ///                         the image described by `GetInfo`. It is grown to
+  ///                         the closest region that the decoder supports.
+  /// @return         The size that the grown region can be decoded at, or an
+  ///                 empty size if it cannot be decoded on its own.
+  /// @note           This method is called prior to `GetSubsetPixels` in order
+  ///                 to query for supported regions and sizes.
+  /// @see            `GetSubsetPixels`
+  virtual SkISize GetScaledSubsetDimensions(float scale, SkIRect* subset);
+
+  /// @brief      Decode a region of the image into a given buffer.
+  /// @param[in]  subset     A region grown by `GetScaledSubsetDimensions`.
+  /// @param[in]  info       The desired size and color info of the decoded
+  ///                        region. Its size is the one returned by
+  ///                        `GetScaledSubsetDimensions` for the region.
+  /// @param[in]  pixels     The location where the raw decoded region data
+  ///                        should be written.
+  /// @param[in]  row_bytes  The total number of bytes that should make up a
+  ///                        single row of decoded region data.
+  /// @return     True if the region was successfully decoded.
+  /// @note       Like `GetPixels`, this method performs potentially long
+  ///             synchronous work and should never be executed on the UI
+  ///             thread.
+  /// @see        `GetScaledSubsetDimensions`
+  virtual bool GetSubsetPixels(const SkIRect& subset,
+                               const SkImageInfo& info,
+                               void* pixels,
+                               size_t row_bytes);
+
+  /// @brief      Whether the image can be decoded into separate Y, U, V (and
+  ///             A) planes at full size, which can then be uploaded to the
+  ///             GPU and converted to RGBA there, and how large the planes
+  ///             are.
+  /// @param[in]  supported_data_types  The plane layouts and data types that
+  ///                                   can be used.
+  /// @param[out] yuva_pixmap_info      The layout and data type of the planes
+  ///                                   the image would be decoded into.
+  /// @return     True if the image can be decoded into planes. Most decoders
+  ///             cannot, and return false.
+  /// @see        `GetYUVAPlanes`
+  virtual bool QueryYUVAInfo(
+      const SkYUVAPixmapInfo::SupportedDataTypes& supported_data_types,
+      SkYUVAPixmapInfo* yuva_pixmap_info) const;
+
+  /// @brief      Decode the image into the planes described by the info
+  ///             returned by `QueryYUVAInfo`.
+  /// @return     True if the planes were successfully decoded.
+  /// @see        `QueryYUVAInfo`
+  virtual bool GetYUVAPlanes(const SkYUVAPixmaps& yuva_pixmaps);
+
   /// @brief   Creates an `SkImage` based on the current `ImageInfo` of this
-  ///          `ImageGenerator`.
+  ///          `ImageGenerator`. By default, the image is decoded into new
+  ///          pixels with `GetPixels`, but generators that already hold the
+  ///          decoded pixels may share them with the image instead.
   /// @return  A new `SkImage` containing the decoded image data.
-  sk_sp<SkImage> GetImage();
+  virtual sk_sp<SkImage> GetImage();
 };
 
 class BuiltinSkiaImageGenerator : public ImageGenerator {
@@ -200,11 +262,33 @@ class BuiltinSkiaCodecImageGenerator : public ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) override;
 
+  // |ImageGenerator|
+  SkISize GetScaledSubsetDimensions(float scale, SkIRect* subset) override;
+
+  // |ImageGenerator|
+  bool GetSubsetPixels(const SkIRect& subset,
+                       const SkImageInfo& info,
+                       void* pixels,
+                       size_t row_bytes) override;
+
+  // |ImageGenerator|
+  bool QueryYUVAInfo(
+      const SkYUVAPixmapInfo::SupportedDataTypes& supported_data_types,
+      SkYUVAPixmapInfo* yuva_pixmap_info) const override;
+
+  // |ImageGenerator|
+  bool GetYUVAPlanes(const SkYUVAPixmaps& yuva_pixmaps) override;
+
   static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
 
  private:
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(BuiltinSkiaCodecImageGenerator);
   std::unique_ptr<SkCodecImageGenerator> codec_generator_;
+  // Decodes the regions of the image, which the codec of the generator does
+  // not support for most formats. Created on the first region decode.
+  std::unique_ptr<SkAndroidCodec> region_codec_;
+
+  SkAndroidCodec* GetRegionCodec();
 };
 
 }  // namespace flutter
@@ -50,6 +50,12 @@ void ImageGeneratorRegistry::AddFactory(ImageGeneratorFactory factory,
   image_generator_factories_.insert({factory, priority, ++nonce_});
 }
 
+void ImageGeneratorRegistry::CopyFactoriesFrom(
+    const ImageGeneratorRegistry& other) {
+  image_generator_factories_ = other.image_generator_factories_;
+  nonce_ = other.nonce_;
+}
+
 std::shared_ptr<ImageGenerator>
 ImageGeneratorRegistry::CreateCompatibleGenerator(sk_sp<SkData> buffer) {
   if (!image_generator_factories_.size()) {
@@ -70,6 +76,29 @@ ImageGeneratorRegistry::CreateCompatibleGenerator(sk_sp<SkData> buffer) {
   return nullptr;
 }
 
+std::vector<ImageGeneratorFactory> ImageGeneratorRegistry::GetFactories()
+    const {
+  std::vector<ImageGeneratorFactory> factories;
+  factories.reserve(image_generator_factories_.size());
+  for (auto& factory : image_generator_factories_) {
+    factories.push_back(factory.callback);
+  }
+  return factories;
+}
+
+std::shared_ptr<ImageGenerator>
+ImageGeneratorRegistry::CreateCompatibleGenerator(
+    const std::vector<ImageGeneratorFactory>& factories,
+    sk_sp<SkData> buffer) {
+  for (auto& factory : factories) {
+    std::shared_ptr<ImageGenerator> result = factory(buffer);
+    if (result) {
+      return result;
+    }
+  }
+  return nullptr;
+}
+
 fml::WeakPtr<ImageGeneratorRegistry> ImageGeneratorRegistry::GetWeakPtr()
     const {
   return weak_factory_.GetWeakPtr();
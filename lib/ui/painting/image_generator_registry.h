@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <set>
+#include <vector>
 
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/memory/weak_ptr.h"
@@ -44,6 +45,12 @@ class ImageGeneratorRegistry {
   /// @see        `CreateCompatibleGenerator`
   void AddFactory(ImageGeneratorFactory factory, int32_t priority);
 
+  /// @brief      Replaces the factories of this registry with those of another
+  ///             one, in the same order, so that an engine spawned from another
+  ///             one decodes images with the factories installed on it.
+  /// @param[in]  other  The registry to copy the factories of.
+  void CopyFactoriesFrom(const ImageGeneratorRegistry& other);
+
   /// @brief      Walks the list of image generator builders in descending
   ///             priority order until a compatible `ImageGenerator` is able to
   ///             be built. This method is safe to perform on the UI thread, as
@@ -58,6 +65,24 @@ class ImageGeneratorRegistry {
   std::shared_ptr<ImageGenerator> CreateCompatibleGenerator(
       sk_sp<SkData> buffer);
 
+  /// @brief      Returns the factories of this registry, in the order in which
+  ///             `CreateCompatibleGenerator` tries them.
+  /// @see        `CreateCompatibleGenerator(factories, buffer)`
+  std::vector<ImageGeneratorFactory> GetFactories() const;
+
+  /// @brief      Tries the `factories` in order until one of them builds an
+  ///             `ImageGenerator` for the input data. Unlike the registry,
+  ///             whose weak pointer is bound to the thread that owns it, the
+  ///             factories it returns from `GetFactories` may be tried on
+  ///             any thread.
+  /// @param[in]  factories  The factories returned by `GetFactories`.
+  /// @param[in]  buffer     The raw encoded image data.
+  /// @return     An `ImageGenerator` that is compatible with the input buffer,
+  ///             or `std::shared_ptr<ImageGenerator>(nullptr)`.
+  static std::shared_ptr<ImageGenerator> CreateCompatibleGenerator(
+      const std::vector<ImageGeneratorFactory>& factories,
+      sk_sp<SkData> buffer);
+
   fml::WeakPtr<ImageGeneratorRegistry> GetWeakPtr() const;
 
  private:
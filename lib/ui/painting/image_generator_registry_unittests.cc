@@ -148,5 +148,34 @@ TEST_F(ShellTest, ImageGeneratorsWithSamePriorityCascadeChronologically) {
   ASSERT_EQ(result->GetInfo().width(), 1337);
 }
 
+TEST_F(ShellTest, CopiedImageGeneratorsKeepTheirOrder) {
+  ImageGeneratorRegistry registry;
+  registry.AddFactory(
+      [](sk_sp<SkData> buffer) {
+        return std::make_unique<FakeImageGenerator>(1337);
+      },
+      5);
+  registry.AddFactory(
+      [](sk_sp<SkData> buffer) {
+        return std::make_unique<FakeImageGenerator>(7777);
+      },
+      5);
+
+  ImageGeneratorRegistry copy;
+  copy.CopyFactoriesFrom(registry);
+  auto result = copy.CreateCompatibleGenerator(SkData::MakeEmpty());
+  ASSERT_EQ(result->GetInfo().width(), 1337);
+
+  // Factories added to the copy come after the copied ones of the same
+  // priority.
+  copy.AddFactory(
+      [](sk_sp<SkData> buffer) {
+        return std::make_unique<FakeImageGenerator>(4242);
+      },
+      5);
+  result = copy.CreateCompatibleGenerator(SkData::MakeEmpty());
+  ASSERT_EQ(result->GetInfo().width(), 1337);
+}
+
 }  // namespace testing
 }  // namespace flutter
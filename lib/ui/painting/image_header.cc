@@ -0,0 +1,164 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_header.h"
+
+#include <cstring>
+
+namespace flutter {
+
+namespace {
+
+uint32_t ReadBigEndian16(const uint8_t* data) {
+  return (data[0] << 8) | data[1];
+}
+
+uint32_t ReadBigEndian32(const uint8_t* data) {
+  return (static_cast<uint32_t>(data[0]) << 24) | (data[1] << 16) |
+         (data[2] << 8) | data[3];
+}
+
+uint32_t ReadLittleEndian16(const uint8_t* data) {
+  return data[0] | (data[1] << 8);
+}
+
+uint32_t ReadLittleEndian24(const uint8_t* data) {
+  return data[0] | (data[1] << 8) | (data[2] << 16);
+}
+
+uint32_t ReadLittleEndian32(const uint8_t* data) {
+  return ReadLittleEndian24(data) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+bool StartsWith(const uint8_t* data,
+                size_t size,
+                size_t offset,
+                const char* prefix) {
+  size_t length = strlen(prefix);
+  return size >= offset + length && memcmp(data + offset, prefix, length) == 0;
+}
+
+std::optional<ImageHeader> ReadPNGHeader(const uint8_t* data, size_t size) {
+  // The signature is followed by the IHDR chunk, which starts with the
+  // width and the height.
+  if (!StartsWith(data, size, 0, "\x89PNG\r\n\x1a\n") ||
+      !StartsWith(data, size, 12, "IHDR") || size < 24) {
+    return std::nullopt;
+  }
+  return ImageHeader{ImageHeader::Format::kPNG, ReadBigEndian32(data + 16),
+                     ReadBigEndian32(data + 20)};
+}
+
+std::optional<ImageHeader> ReadGIFHeader(const uint8_t* data, size_t size) {
+  if ((!StartsWith(data, size, 0, "GIF87a") &&
+       !StartsWith(data, size, 0, "GIF89a")) ||
+      size < 10) {
+    return std::nullopt;
+  }
+  return ImageHeader{ImageHeader::Format::kGIF, ReadLittleEndian16(data + 6),
+                     ReadLittleEndian16(data + 8)};
+}
+
+std::optional<ImageHeader> ReadWebPHeader(const uint8_t* data, size_t size) {
+  if (!StartsWith(data, size, 0, "RIFF") ||
+      !StartsWith(data, size, 8, "WEBP") || size < 30) {
+    return std::nullopt;
+  }
+  const uint8_t* chunk = data + 20;
+  if (StartsWith(data, size, 12, "VP8 ")) {
+    // A lossy key frame starts with a frame tag and a start code.
+    if (chunk[3] != 0x9d || chunk[4] != 0x01 || chunk[5] != 0x2a) {
+      return std::nullopt;
+    }
+    return ImageHeader{ImageHeader::Format::kWebP,
+                       ReadLittleEndian16(chunk + 6) & 0x3fff,
+                       ReadLittleEndian16(chunk + 8) & 0x3fff};
+  }
+  if (StartsWith(data, size, 12, "VP8L")) {
+    // A lossless image starts with a signature, followed by the width and
+    // the height minus one in 14 bits each.
+    if (chunk[0] != 0x2f) {
+      return std::nullopt;
+    }
+    uint32_t bits = ReadLittleEndian32(chunk + 1);
+    return ImageHeader{ImageHeader::Format::kWebP, (bits & 0x3fff) + 1,
+                       ((bits >> 14) & 0x3fff) + 1};
+  }
+  if (StartsWith(data, size, 12, "VP8X")) {
+    // The extended format stores the canvas width and height minus one.
+    return ImageHeader{ImageHeader::Format::kWebP,
+                       ReadLittleEndian24(chunk + 4) + 1,
+                       ReadLittleEndian24(chunk + 7) + 1};
+  }
+  return std::nullopt;
+}
+
+std::optional<ImageHeader> ReadJPEGHeader(const uint8_t* data, size_t size) {
+  if (size < 2 || data[0] != 0xff || data[1] != 0xd8) {
+    return std::nullopt;
+  }
+  // Walk the marker segments up to the start of frame, which holds the
+  // dimensions, before the start of scan.
+  size_t offset = 2;
+  while (offset + 4 <= size) {
+    if (data[offset] != 0xff) {
+      return std::nullopt;
+    }
+    uint8_t marker = data[offset + 1];
+    if (marker == 0xff) {
+      // Fill byte.
+      offset++;
+      continue;
+    }
+    if (marker == 0x01 || (marker >= 0xd0 && marker <= 0xd7)) {
+      // Markers without a segment.
+      offset += 2;
+      continue;
+    }
+    if (marker == 0xd9 || marker == 0xda) {
+      return std::nullopt;
+    }
+    uint32_t length = ReadBigEndian16(data + offset + 2);
+    if (length < 2) {
+      return std::nullopt;
+    }
+    // The start of frame markers, without DHT, JPG and DAC.
+    bool is_start_of_frame = marker >= 0xc0 && marker <= 0xcf &&
+                             marker != 0xc4 && marker != 0xc8 &&
+                             marker != 0xcc;
+    if (is_start_of_frame) {
+      // The segment length is followed by the sample precision, the height
+      // and the width.
+      if (length < 7 || offset + 9 > size) {
+        return std::nullopt;
+      }
+      return ImageHeader{ImageHeader::Format::kJPEG,
+                         ReadBigEndian16(data + offset + 7),
+                         ReadBigEndian16(data + offset + 5)};
+    }
+    offset += 2 + length;
+  }
+  return std::nullopt;
+}
+
+}  // namespace
+
+std::optional<ImageHeader> ReadImageHeader(const uint8_t* data, size_t size) {
+  std::optional<ImageHeader> header = ReadJPEGHeader(data, size);
+  if (!header) {
+    header = ReadPNGHeader(data, size);
+  }
+  if (!header) {
+    header = ReadWebPHeader(data, size);
+  }
+  if (!header) {
+    header = ReadGIFHeader(data, size);
+  }
+  if (!header || header->width == 0 || header->height == 0) {
+    return std::nullopt;
+  }
+  return header;
+}
+
+}  // namespace flutter
@@ -0,0 +1,35 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_HEADER_H_
+#define FLUTTER_LIB_UI_PAINTING_IMAGE_HEADER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace flutter {
+
+/// The format and the dimensions read from the header of an encoded image.
+struct ImageHeader {
+  enum class Format { kJPEG, kPNG, kWebP, kGIF };
+
+  Format format;
+  /// The dimensions as they are encoded, before any orientation stored in
+  /// the metadata of the image is applied.
+  uint32_t width;
+  uint32_t height;
+};
+
+/// @brief      Reads the header of a JPEG, PNG, WebP or GIF image, without
+///             creating a codec for it.
+/// @param[in]  data  The encoded image.
+/// @param[in]  size  The size of the encoded image in bytes.
+/// @return     The header, or `std::nullopt` if the image is in another
+///             format or if its header is truncated or has empty dimensions.
+std::optional<ImageHeader> ReadImageHeader(const uint8_t* data, size_t size);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_HEADER_H_
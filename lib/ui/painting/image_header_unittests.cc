@@ -0,0 +1,96 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_header.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+std::optional<ImageHeader> ReadHeader(const std::vector<uint8_t>& data) {
+  return ReadImageHeader(data.data(), data.size());
+}
+
+void ExpectHeader(const std::optional<ImageHeader>& header,
+                  ImageHeader::Format format,
+                  uint32_t width,
+                  uint32_t height) {
+  ASSERT_TRUE(header.has_value());
+  EXPECT_EQ(header->format, format);
+  EXPECT_EQ(header->width, width);
+  EXPECT_EQ(header->height, height);
+}
+
+}  // namespace
+
+TEST(ImageHeaderTest, ReadsPNGHeader) {
+  std::vector<uint8_t> data = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n',
+                               0,    0,   0,   13,  'I',  'H',  'D',  'R',
+                               0,    0,   1,   44,  0,    0,    0,    200};
+  ExpectHeader(ReadHeader(data), ImageHeader::Format::kPNG, 300, 200);
+
+  data.pop_back();
+  EXPECT_FALSE(ReadHeader(data).has_value());
+}
+
+TEST(ImageHeaderTest, ReadsGIFHeader) {
+  std::vector<uint8_t> data = {'G', 'I', 'F', '8', '9', 'a', 44, 1, 200, 0};
+  ExpectHeader(ReadHeader(data), ImageHeader::Format::kGIF, 300, 200);
+}
+
+TEST(ImageHeaderTest, ReadsJPEGHeader) {
+  std::vector<uint8_t> data = {
+      0xff, 0xd8,
+      // An APP0 segment.
+      0xff, 0xe0, 0, 4, 0, 0,
+      // A baseline start of frame with 8 bit samples, 200x300.
+      0xff, 0xc0, 0, 11, 8, 0, 200, 1, 44, 1, 1, 0x11, 0};
+  ExpectHeader(ReadHeader(data), ImageHeader::Format::kJPEG, 300, 200);
+
+  // The start of scan comes before any start of frame.
+  data[3] = 0xda;
+  EXPECT_FALSE(ReadHeader(data).has_value());
+}
+
+TEST(ImageHeaderTest, ReadsWebPHeaders) {
+  std::vector<uint8_t> riff = {'R', 'I', 'F', 'F', 0, 0, 0, 0,
+                               'W', 'E', 'B', 'P'};
+  std::vector<uint8_t> lossy = riff;
+  lossy.insert(lossy.end(), {'V', 'P', '8', ' ', 0, 0, 0, 0, 0, 0, 0, 0x9d,
+                             0x01, 0x2a, 44, 1, 200, 0});
+  ExpectHeader(ReadHeader(lossy), ImageHeader::Format::kWebP, 300, 200);
+
+  // Width and height minus one, in 14 bits each.
+  uint32_t bits = 299 | (199 << 14);
+  std::vector<uint8_t> lossless = riff;
+  lossless.insert(lossless.end(),
+                  {'V', 'P', '8', 'L', 0, 0, 0, 0, 0x2f,
+                   static_cast<uint8_t>(bits), static_cast<uint8_t>(bits >> 8),
+                   static_cast<uint8_t>(bits >> 16),
+                   static_cast<uint8_t>(bits >> 24), 0, 0, 0, 0, 0});
+  ExpectHeader(ReadHeader(lossless), ImageHeader::Format::kWebP, 300, 200);
+
+  std::vector<uint8_t> extended = riff;
+  extended.insert(extended.end(), {'V', 'P', '8', 'X', 0, 0, 0, 0, 0, 0, 0,
+                                   0, 43, 1, 0, 199, 0, 0});
+  ExpectHeader(ReadHeader(extended), ImageHeader::Format::kWebP, 300, 200);
+}
+
+TEST(ImageHeaderTest, RejectsOtherData) {
+  EXPECT_FALSE(ReadHeader({1, 2, 3}).has_value());
+  EXPECT_FALSE(ReadHeader({}).has_value());
+  // A BMP header.
+  EXPECT_FALSE(ReadHeader({'B', 'M', 0, 0, 0, 0, 0, 0, 0, 0}).has_value());
+  // A GIF with an empty screen.
+  EXPECT_FALSE(
+      ReadHeader({'G', 'I', 'F', '8', '7', 'a', 0, 0, 1, 0}).has_value());
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -7,6 +7,7 @@
 #include <cstring>
 
 #include "flutter/lib/ui/ui_dart_state.h"
+#include "flutter/lib/ui/window/platform_configuration.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -28,8 +29,11 @@ FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
 ImmutableBuffer::~ImmutableBuffer() {}
 
 void ImmutableBuffer::RegisterNatives(tonic::DartLibraryNatives* natives) {
-  natives->Register({{"ImmutableBuffer_init", ImmutableBuffer::init, 3, true},
-                     FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
+  natives->Register(
+      {{"ImmutableBuffer_init", ImmutableBuffer::init, 3, true},
+       {"ImmutableBuffer_initFromAsset", ImmutableBuffer::initFromAsset, 3,
+        true},
+       FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
 }
 
 void ImmutableBuffer::init(Dart_NativeArguments args) {
@@ -49,6 +53,62 @@ void ImmutableBuffer::init(Dart_NativeArguments args) {
   tonic::DartInvoke(callback_handle, {Dart_TypeVoid()});
 }
 
+void ImmutableBuffer::initFromAsset(Dart_NativeArguments args) {
+  UIDartState::ThrowIfUIOperationsProhibited();
+  Dart_Handle callback_handle = Dart_GetNativeArgument(args, 2);
+  if (!Dart_IsClosure(callback_handle)) {
+    Dart_SetReturnValue(args, tonic::ToDart("Callback must be a function"));
+    return;
+  }
+
+  Dart_Handle buffer_handle = Dart_GetNativeArgument(args, 0);
+  std::string asset_name = tonic::DartConverter<std::string>::FromDart(
+      Dart_GetNativeArgument(args, 1));
+
+  auto* platform_configuration =
+      UIDartState::Current()->platform_configuration();
+  std::shared_ptr<AssetManager> asset_manager;
+  if (platform_configuration) {
+    asset_manager = platform_configuration->client()->GetAssetManager();
+  }
+  std::unique_ptr<fml::Mapping> mapping;
+  if (asset_manager) {
+    mapping = asset_manager->GetAsMapping(asset_name);
+  }
+  if (!mapping) {
+    Dart_SetReturnValue(args, tonic::ToDart("Asset not found"));
+    return;
+  }
+
+  auto sk_data = MakeSkDataFromMapping(std::move(mapping));
+  const size_t length = sk_data->size();
+  auto buffer = fml::MakeRefCounted<ImmutableBuffer>(std::move(sk_data));
+  buffer->AssociateWithDartWrapper(buffer_handle);
+  tonic::DartInvoke(callback_handle, {tonic::ToDart(length)});
+}
+
+sk_sp<SkData> ImmutableBuffer::MakeSkDataFromMapping(
+    std::unique_ptr<fml::Mapping> mapping) {
+#if FML_OS_ANDROID
+  // The mappings that are not safe to drop live in the native heap, like the
+  // assets that had to be decompressed, and are copied for the same reason as
+  // the bytes from Dart.
+  if (!mapping->IsDontNeedSafe()) {
+    return MakeSkDataWithCopy(mapping->GetMapping(), mapping->GetSize());
+  }
+#endif  // FML_OS_ANDROID
+  if (mapping->GetSize() == 0) {
+    return SkData::MakeEmpty();
+  }
+
+  const void* bytes = mapping->GetMapping();
+  const size_t length = mapping->GetSize();
+  SkData::ReleaseProc proc = [](const void* ptr, void* context) {
+    delete reinterpret_cast<fml::Mapping*>(context);
+  };
+  return SkData::MakeWithProc(bytes, length, proc, mapping.release());
+}
+
 size_t ImmutableBuffer::GetAllocationSize() const {
   return sizeof(ImmutableBuffer) + data_->size();
 }
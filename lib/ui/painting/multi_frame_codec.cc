@@ -5,6 +5,7 @@
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/image.h"
 #include "third_party/dart/runtime/include/dart_api.h"
 #include "third_party/skia/include/core/SkPixelRef.h"
@@ -12,19 +13,42 @@
 
 namespace flutter {
 
-MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator)
-    : state_(new State(std::move(generator))) {}
+MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator,
+                                 FrameBudget budget)
+    : state_(
+          std::make_shared<State>(std::move(generator), std::move(budget))) {}
 
 MultiFrameCodec::~MultiFrameCodec() = default;
 
-MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator)
+static bool FitsAllFrames(const ImageGenerator& generator,
+                          int frame_count,
+                          size_t max_bytes) {
+  if (frame_count <= 0) {
+    return false;
+  }
+  const size_t frame_bytes = generator.GetInfo()
+                                 .makeColorType(kN32_SkColorType)
+                                 .computeMinByteSize();
+  return frame_bytes <= max_bytes / frame_count;
+}
+
+MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator,
+                              FrameBudget budget)
     : generator_(std::move(generator)),
       frameCount_(generator_->GetFrameCount()),
       repetitionCount_(generator_->GetPlayCount() ==
                                ImageGenerator::kInfinitePlayCount
                            ? -1
                            : generator_->GetPlayCount() - 1),
-      nextFrameIndex_(0) {}
+      budget_(std::move(budget)),
+      cachesAllFrames_(FitsAllFrames(*generator_,
+                                     frameCount_,
+                                     budget_.frame_cache_max_bytes)),
+      nextFrameIndex_(0) {
+  if (cachesAllFrames_) {
+    cachedFrames_.resize(frameCount_);
+  }
+}
 
 static void InvokeNextFrameCallback(
     fml::RefPtr<CanvasImage> image,
@@ -75,9 +99,12 @@ static bool CopyToBitmap(SkBitmap* dst,
   return true;
 }
 
-sk_sp<SkImage> MultiFrameCodec::State::GetNextFrameImage(
-    fml::WeakPtr<GrDirectContext> resourceContext,
-    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch) {
+MultiFrameCodec::State::DecodedFrame
+MultiFrameCodec::State::DecodeNextFrameLocked() {
+  DecodedFrame frame;
+  frame.index = nextDecodeIndex_;
+  nextDecodeIndex_ = (nextDecodeIndex_ + 1) % frameCount_;
+
   SkBitmap bitmap = SkBitmap();
   SkImageInfo info = generator_->GetInfo().makeColorType(kN32_SkColorType);
   if (info.alphaType() == kUnpremul_SkAlphaType) {
@@ -86,8 +113,7 @@ sk_sp<SkImage> MultiFrameCodec::State::GetNextFrameImage(
   }
   bitmap.allocPixels(info);
 
-  ImageGenerator::FrameInfo frameInfo =
-      generator_->GetFrameInfo(nextFrameIndex_);
+  ImageGenerator::FrameInfo frameInfo = generator_->GetFrameInfo(frame.index);
 
   const int requiredFrameIndex =
       frameInfo.required_frame.value_or(SkCodec::kNoFrame);
@@ -95,10 +121,10 @@ sk_sp<SkImage> MultiFrameCodec::State::GetNextFrameImage(
 
   if (requiredFrameIndex != SkCodec::kNoFrame) {
     if (lastRequiredFrame_ == nullptr) {
-      FML_LOG(ERROR) << "Frame " << nextFrameIndex_ << " depends on frame "
+      FML_LOG(ERROR) << "Frame " << frame.index << " depends on frame "
                      << requiredFrameIndex
                      << " and no required frames are cached.";
-      return nullptr;
+      return frame;
     } else if (lastRequiredFrameIndex_ != requiredFrameIndex) {
       FML_DLOG(INFO) << "Required frame " << requiredFrameIndex
                      << " is not cached. Using " << lastRequiredFrameIndex_
@@ -113,16 +139,112 @@ sk_sp<SkImage> MultiFrameCodec::State::GetNextFrameImage(
   }
 
   if (!generator_->GetPixels(info, bitmap.getPixels(), bitmap.rowBytes(),
-                             nextFrameIndex_, requiredFrameIndex)) {
-    FML_LOG(ERROR) << "Could not getPixels for frame " << nextFrameIndex_;
-    return nullptr;
+                             frame.index, requiredFrameIndex)) {
+    FML_LOG(ERROR) << "Could not getPixels for frame " << frame.index;
+    return frame;
   }
 
   // Hold onto this if we need it to decode future frames.
   if (frameInfo.disposal_method == SkCodecAnimation::DisposalMethod::kKeep) {
     lastRequiredFrame_ = std::make_unique<SkBitmap>(bitmap);
-    lastRequiredFrameIndex_ = nextFrameIndex_;
+    lastRequiredFrameIndex_ = frame.index;
+  }
+  frame.duration = frameInfo.duration;
+  frame.bitmap = std::move(bitmap);
+  return frame;
+}
+
+MultiFrameCodec::State::DecodedFrame
+MultiFrameCodec::State::TakeNextDecodedFrame() {
+  {
+    std::scoped_lock lock(prefetchMutex_);
+    if (!prefetchedFrames_.empty()) {
+      DecodedFrame frame = std::move(prefetchedFrames_.front());
+      prefetchedFrames_.pop_front();
+      return frame;
+    }
+  }
+
+  // The frame is either being decoded ahead of time, which this waits for, or
+  // is decoded here.
+  std::scoped_lock decode_lock(decodeMutex_);
+  {
+    std::scoped_lock lock(prefetchMutex_);
+    if (!prefetchedFrames_.empty()) {
+      DecodedFrame frame = std::move(prefetchedFrames_.front());
+      prefetchedFrames_.pop_front();
+      return frame;
+    }
+  }
+  return DecodeNextFrameLocked();
+}
+
+void MultiFrameCodec::State::SchedulePrefetch() {
+  if (!budget_.prefetch_task_runner || budget_.prefetch_frame_count <= 0) {
+    return;
   }
+  {
+    std::scoped_lock lock(prefetchMutex_);
+    if (isPrefetching_ || stopsPrefetching_ ||
+        prefetchedFrames_.size() >=
+            static_cast<size_t>(budget_.prefetch_frame_count)) {
+      return;
+    }
+    isPrefetching_ = true;
+  }
+  budget_.prefetch_task_runner->PostTask([weak_state = weak_from_this()]() {
+    if (auto state = weak_state.lock()) {
+      state->PrefetchFrames();
+    }
+  });
+}
+
+void MultiFrameCodec::State::PrefetchFrames() {
+  TRACE_EVENT0("flutter", "MultiFrameCodec::PrefetchFrames");
+  while (true) {
+    std::scoped_lock decode_lock(decodeMutex_);
+    {
+      std::scoped_lock lock(prefetchMutex_);
+      if (stopsPrefetching_ ||
+          prefetchedFrames_.size() >=
+              static_cast<size_t>(budget_.prefetch_frame_count)) {
+        isPrefetching_ = false;
+        return;
+      }
+    }
+    DecodedFrame frame = DecodeNextFrameLocked();
+    std::scoped_lock lock(prefetchMutex_);
+    prefetchedFrames_.push_back(std::move(frame));
+  }
+}
+
+void MultiFrameCodec::State::CacheFrame(
+    int index,
+    sk_sp<SkImage> image,
+    int duration,
+    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
+  CachedFrame& cached = cachedFrames_[index];
+  if (cached.image.skia_object()) {
+    return;
+  }
+  cached = {{std::move(image), std::move(unref_queue)}, duration};
+  if (++cachedFrameCount_ < frameCount_) {
+    return;
+  }
+
+  // All of the frames are kept, so the ones decoded ahead of time and the
+  // frame required to decode the others are not needed anymore.
+  std::scoped_lock decode_lock(decodeMutex_);
+  lastRequiredFrame_.reset();
+  std::scoped_lock lock(prefetchMutex_);
+  stopsPrefetching_ = true;
+  prefetchedFrames_.clear();
+}
+
+static sk_sp<SkImage> UploadFrame(
+    const SkBitmap& bitmap,
+    const fml::WeakPtr<GrDirectContext>& resourceContext,
+    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch) {
   sk_sp<SkImage> result;
 
   gpu_disable_sync_switch->Execute(
@@ -152,20 +274,34 @@ sk_sp<SkImage> MultiFrameCodec::State::GetNextFrameImage(
 void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
     std::unique_ptr<DartPersistentValue> callback,
     fml::RefPtr<fml::TaskRunner> ui_task_runner,
-    fml::WeakPtr<GrDirectContext> resourceContext,
-    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue,
-    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
+    const fml::WeakPtr<IOManager>& io_manager,
     size_t trace_id) {
   fml::RefPtr<CanvasImage> image = nullptr;
   int duration = 0;
-  sk_sp<SkImage> skImage =
-      GetNextFrameImage(resourceContext, gpu_disable_sync_switch);
-  if (skImage) {
+  fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue =
+      io_manager->GetSkiaUnrefQueue();
+  if (cachesAllFrames_ && cachedFrameCount_ == frameCount_) {
+    const CachedFrame& cached = cachedFrames_[nextFrameIndex_];
     image = CanvasImage::Create();
-    image->set_image({skImage, std::move(unref_queue)});
-    ImageGenerator::FrameInfo frameInfo =
-        generator_->GetFrameInfo(nextFrameIndex_);
-    duration = frameInfo.duration;
+    image->set_image({cached.image.skia_object(), std::move(unref_queue)});
+    duration = cached.duration;
+  } else {
+    DecodedFrame frame = TakeNextDecodedFrame();
+    SchedulePrefetch();
+    FML_DCHECK(frame.index == nextFrameIndex_);
+    sk_sp<SkImage> skImage =
+        frame.bitmap.isNull()
+            ? nullptr
+            : UploadFrame(frame.bitmap, io_manager->GetResourceContext(),
+                          io_manager->GetIsGpuDisabledSyncSwitch());
+    if (skImage) {
+      if (cachesAllFrames_) {
+        CacheFrame(frame.index, skImage, frame.duration, unref_queue);
+      }
+      image = CanvasImage::Create();
+      image->set_image({skImage, std::move(unref_queue)});
+      duration = frame.duration;
+    }
   }
   nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
 
@@ -213,9 +349,8 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
           return;
         }
         state->GetNextFrameAndInvokeCallback(
-            std::move(callback), std::move(ui_task_runner),
-            io_manager->GetResourceContext(), io_manager->GetSkiaUnrefQueue(),
-            io_manager->GetIsGpuDisabledSyncSwitch(), trace_id);
+            std::move(callback), std::move(ui_task_runner), io_manager,
+            trace_id);
       }));
 
   return Dart_Null();
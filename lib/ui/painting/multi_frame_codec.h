@@ -5,6 +5,12 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_MUTLI_FRAME_CODEC_H_
 #define FLUTTER_LIB_UI_PAINTING_MUTLI_FRAME_CODEC_H_
 
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/painting/codec.h"
 #include "flutter/lib/ui/painting/image_generator.h"
@@ -13,7 +19,20 @@ namespace flutter {
 
 class MultiFrameCodec : public Codec {
  public:
-  explicit MultiFrameCodec(std::shared_ptr<ImageGenerator> generator);
+  // How much of the animation the codec decodes before its frames are asked
+  // for. By default, each frame is decoded on the IO thread when it is asked
+  // for.
+  struct FrameBudget {
+    // The task runner that decodes up to |prefetch_frame_count| frames ahead
+    // of the one asked for.
+    std::shared_ptr<fml::ConcurrentTaskRunner> prefetch_task_runner;
+    int prefetch_frame_count = 0;
+    // The frames are kept after the first loop if all of them fit in this.
+    size_t frame_cache_max_bytes = 0;
+  };
+
+  explicit MultiFrameCodec(std::shared_ptr<ImageGenerator> generator,
+                           FrameBudget budget = {});
 
   ~MultiFrameCodec() override;
 
@@ -36,33 +55,78 @@ class MultiFrameCodec : public Codec {
   // Instead, the MultiFrameCodec creates this object when it is constructed,
   // shares it with the IO task runner's decoding work, and sets the live_
   // member to false when it is destructed.
-  struct State {
-    explicit State(std::shared_ptr<ImageGenerator> generator);
+  //
+  // The frames are decoded in order, either on the IO thread when they are
+  // asked for or ahead of time on the prefetch task runner, and are uploaded on
+  // the IO thread.
+  struct State : public std::enable_shared_from_this<State> {
+    State(std::shared_ptr<ImageGenerator> generator, FrameBudget budget);
+
+    // A frame decoded into a bitmap that is yet to be uploaded. The bitmap is
+    // empty if the frame could not be decoded.
+    struct DecodedFrame {
+      int index = 0;
+      int duration = 0;
+      SkBitmap bitmap;
+    };
+
+    struct CachedFrame {
+      SkiaGPUObject<SkImage> image;
+      int duration = 0;
+    };
 
     const std::shared_ptr<ImageGenerator> generator_;
     const int frameCount_;
     const int repetitionCount_;
+    const FrameBudget budget_;
+    // Whether all of the frames fit in the frame cache of the budget.
+    const bool cachesAllFrames_;
 
     // The non-const members and functions below here are only read or written
     // to on the IO thread. They are not safe to access or write on the UI
     // thread.
     int nextFrameIndex_;
+    // The uploaded frames, kept if they all fit in the budget. Once all of them
+    // are there, nothing is decoded anymore.
+    std::vector<CachedFrame> cachedFrames_;
+    int cachedFrameCount_ = 0;
+
+    // Guards the generator and the members below, which are used by the
+    // decodes of the IO thread and of the prefetch task runner.
+    std::mutex decodeMutex_;
+    // The index of the frame that the next decode produces.
+    int nextDecodeIndex_ = 0;
     // The last decoded frame that's required to decode any subsequent frames.
     std::unique_ptr<SkBitmap> lastRequiredFrame_;
 
     // The index of the last decoded required frame.
     int lastRequiredFrameIndex_ = -1;
 
-    sk_sp<SkImage> GetNextFrameImage(
-        fml::WeakPtr<GrDirectContext> resourceContext,
-        const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch);
+    // Guards the members below. The frames are only added while the decode
+    // mutex is held too, which is always taken first.
+    std::mutex prefetchMutex_;
+    // The frames decoded ahead of time, in order from |nextFrameIndex_|.
+    std::deque<DecodedFrame> prefetchedFrames_;
+    bool isPrefetching_ = false;
+    bool stopsPrefetching_ = false;
+
+    DecodedFrame DecodeNextFrameLocked();
+
+    DecodedFrame TakeNextDecodedFrame();
+
+    void SchedulePrefetch();
+
+    void PrefetchFrames();
+
+    void CacheFrame(int index,
+                    sk_sp<SkImage> image,
+                    int duration,
+                    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue);
 
     void GetNextFrameAndInvokeCallback(
         std::unique_ptr<DartPersistentValue> callback,
         fml::RefPtr<fml::TaskRunner> ui_task_runner,
-        fml::WeakPtr<GrDirectContext> resourceContext,
-        fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue,
-        const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
+        const fml::WeakPtr<IOManager>& io_manager,
         size_t trace_id);
   };
 
@@ -194,59 +194,64 @@ bool Paint::sync_to(DisplayListBuilder* builder,
   const uint32_t* uint_data = static_cast<const uint32_t*>(byte_data.data());
   const float* float_data = static_cast<const float*>(byte_data.data());
 
-  Dart_Handle values[kObjectCount];
-  if (Dart_IsNull(paint_objects_)) {
-    if (flags.applies_shader()) {
-      builder->setShader(nullptr);
-    }
-    if (flags.applies_color_filter()) {
-      builder->setColorFilter(nullptr);
-    }
-    if (flags.applies_image_filter()) {
-      builder->setImageFilter(nullptr);
-    }
-  } else {
-    FML_DCHECK(Dart_IsList(paint_objects_));
-    intptr_t length = 0;
-    Dart_ListLength(paint_objects_, &length);
-
-    FML_CHECK(length == kObjectCount);
-    if (Dart_IsError(
-            Dart_ListGetRange(paint_objects_, 0, kObjectCount, values))) {
-      return false;
-    }
-
-    if (flags.applies_shader()) {
-      Dart_Handle shader = values[kShaderIndex];
-      if (Dart_IsNull(shader)) {
+  // The objects of the paint are only read from Dart for the operations that
+  // use them.
+  if (flags.applies_shader() || flags.applies_color_filter() ||
+      flags.applies_image_filter()) {
+    Dart_Handle values[kObjectCount];
+    if (Dart_IsNull(paint_objects_)) {
+      if (flags.applies_shader()) {
         builder->setShader(nullptr);
-      } else {
-        Shader* decoded = tonic::DartConverter<Shader*>::FromDart(shader);
-        auto sampling =
-            ImageFilter::SamplingFromIndex(uint_data[kFilterQualityIndex]);
-        builder->setShader(decoded->shader(sampling));
       }
-    }
-
-    if (flags.applies_color_filter()) {
-      Dart_Handle color_filter = values[kColorFilterIndex];
-      if (Dart_IsNull(color_filter)) {
+      if (flags.applies_color_filter()) {
         builder->setColorFilter(nullptr);
-      } else {
-        ColorFilter* decoded_color_filter =
-            tonic::DartConverter<ColorFilter*>::FromDart(color_filter);
-        builder->setColorFilter(decoded_color_filter->filter());
       }
-    }
-
-    if (flags.applies_image_filter()) {
-      Dart_Handle image_filter = values[kImageFilterIndex];
-      if (Dart_IsNull(image_filter)) {
+      if (flags.applies_image_filter()) {
         builder->setImageFilter(nullptr);
-      } else {
-        ImageFilter* decoded =
-            tonic::DartConverter<ImageFilter*>::FromDart(image_filter);
-        builder->setImageFilter(decoded->filter());
+      }
+    } else {
+      FML_DCHECK(Dart_IsList(paint_objects_));
+      intptr_t length = 0;
+      Dart_ListLength(paint_objects_, &length);
+
+      FML_CHECK(length == kObjectCount);
+      if (Dart_IsError(
+              Dart_ListGetRange(paint_objects_, 0, kObjectCount, values))) {
+        return false;
+      }
+
+      if (flags.applies_shader()) {
+        Dart_Handle shader = values[kShaderIndex];
+        if (Dart_IsNull(shader)) {
+          builder->setShader(nullptr);
+        } else {
+          Shader* decoded = tonic::DartConverter<Shader*>::FromDart(shader);
+          auto sampling =
+              ImageFilter::SamplingFromIndex(uint_data[kFilterQualityIndex]);
+          builder->setShader(decoded->shader(sampling));
+        }
+      }
+
+      if (flags.applies_color_filter()) {
+        Dart_Handle color_filter = values[kColorFilterIndex];
+        if (Dart_IsNull(color_filter)) {
+          builder->setColorFilter(nullptr);
+        } else {
+          ColorFilter* decoded_color_filter =
+              tonic::DartConverter<ColorFilter*>::FromDart(color_filter);
+          builder->setColorFilter(decoded_color_filter->filter());
+        }
+      }
+
+      if (flags.applies_image_filter()) {
+        Dart_Handle image_filter = values[kImageFilterIndex];
+        if (Dart_IsNull(image_filter)) {
+          builder->setImageFilter(nullptr);
+        } else {
+          ImageFilter* decoded =
+              tonic::DartConverter<ImageFilter*>::FromDart(image_filter);
+          builder->setImageFilter(decoded->filter());
+        }
       }
     }
   }
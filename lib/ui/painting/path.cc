@@ -26,21 +26,32 @@ static void Path_constructor(Dart_NativeArguments args) {
 
 IMPLEMENT_WRAPPERTYPEINFO(ui, Path);
 
-#define FOR_EACH_BINDING(V)          \
+#define FOR_EACH_BINDING(V)        \
+  V(Path, addPath)                 \
+  V(Path, addPolygon)              \
+  V(Path, addRRect)                \
+  V(Path, extendWithPath)          \
+  V(Path, extendWithPathAndMatrix) \
+  V(Path, shift)                   \
+  V(Path, transform)               \
+  V(Path, getBounds)               \
+  V(Path, addPathWithMatrix)       \
+  V(Path, op)                      \
+  V(Path, clone)
+
+// The methods that only take numbers, which Dart calls through FFI leaf calls.
+// They must not call into the Dart API. They don't check whether UI operations
+// are allowed, because a path can only be constructed where they are.
+#define FOR_EACH_FFI_BINDING(V)      \
   V(Path, addArc)                    \
   V(Path, addOval)                   \
-  V(Path, addPath)                   \
-  V(Path, addPolygon)                \
   V(Path, addRect)                   \
-  V(Path, addRRect)                  \
   V(Path, arcTo)                     \
   V(Path, arcToPoint)                \
   V(Path, close)                     \
   V(Path, conicTo)                   \
   V(Path, contains)                  \
   V(Path, cubicTo)                   \
-  V(Path, extendWithPath)            \
-  V(Path, extendWithPathAndMatrix)   \
   V(Path, getFillType)               \
   V(Path, lineTo)                    \
   V(Path, moveTo)                    \
@@ -52,19 +63,14 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Path);
   V(Path, relativeMoveTo)            \
   V(Path, relativeQuadraticBezierTo) \
   V(Path, reset)                     \
-  V(Path, setFillType)               \
-  V(Path, shift)                     \
-  V(Path, transform)                 \
-  V(Path, getBounds)                 \
-  V(Path, addPathWithMatrix)         \
-  V(Path, op)                        \
-  V(Path, clone)
+  V(Path, setFillType)
 
 FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
 
 void CanvasPath::RegisterNatives(tonic::DartLibraryNatives* natives) {
   natives->Register({{"Path_constructor", Path_constructor, 1, true},
                      FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
+  natives->RegisterFfi({FOR_EACH_FFI_BINDING(DART_REGISTER_FFI_NATIVE)});
 }
 
 CanvasPath::CanvasPath()
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_PATH_H_
 #define FLUTTER_LIB_UI_PAINTING_PATH_H_
 
+#include "flutter/fml/memory/free_list.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/rrect.h"
 #include "flutter/lib/ui/volatile_path_tracker.h"
@@ -24,6 +25,16 @@ class CanvasPath : public RefCountedDartWrappable<CanvasPath> {
 
  public:
   ~CanvasPath() override;
+
+  // Paths are created and collected at a high rate, so their memory is
+  // recycled through a per-thread free list.
+  static void* operator new(size_t size) {
+    return fml::FreeList<sizeof(CanvasPath)>::Allocate(size);
+  }
+  static void operator delete(void* pointer, size_t size) {
+    fml::FreeList<sizeof(CanvasPath)>::Free(pointer, size);
+  }
+
   static fml::RefPtr<CanvasPath> CreateNew(Dart_Handle path_handle) {
     return fml::MakeRefCounted<CanvasPath>();
   }
@@ -111,6 +122,13 @@ class CanvasPath : public RefCountedDartWrappable<CanvasPath> {
 
   const SkPath& path() const { return tracked_path_->path; }
 
+  // The path to record when drawing this path, which is shared with the paths
+  // with the same contents drawn in the last frames when the path tracker
+  // deduplicates them. See |VolatilePathTracker::Deduplicate|.
+  const SkPath& deduplicated_path() const {
+    return path_tracker_->Deduplicate(path());
+  }
+
   size_t GetAllocationSize() const override;
 
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
@@ -182,5 +182,47 @@ TEST_F(ShellTest, DeterministicRenderingDisablesPathVolatility) {
   DestroyShell(std::move(shell), std::move(task_runners));
 }
 
+TEST_F(ShellTest, PathDeduplicationSharesPathsAcrossFrames) {
+  VolatilePathTracker tracker(GetCurrentTaskRunner(), true, true);
+  auto make_path = [](SkScalar size) {
+    SkPath path;
+    path.addRect(SkRect::MakeWH(size, size));
+    path.setIsVolatile(true);
+    return path;
+  };
+
+  SkPath first_frame_path = make_path(10);
+  EXPECT_EQ(&tracker.Deduplicate(first_frame_path), &first_frame_path);
+  tracker.OnFrame();
+
+  // The same contents rebuilt in the next frame are drawn as the first path.
+  SkPath second_frame_path = make_path(10);
+  const SkPath& deduplicated = tracker.Deduplicate(second_frame_path);
+  EXPECT_EQ(deduplicated, second_frame_path);
+  EXPECT_EQ(deduplicated.getGenerationID(), first_frame_path.getGenerationID());
+  EXPECT_FALSE(deduplicated.isVolatile());
+
+  SkPath other_path = make_path(20);
+  EXPECT_EQ(&tracker.Deduplicate(other_path), &other_path);
+
+  // Paths that are not drawn for a few frames are forgotten.
+  for (int i = 0; i <= VolatilePathTracker::kFramesOfVolatility; i++) {
+    tracker.OnFrame();
+  }
+  SkPath later_path = make_path(10);
+  EXPECT_EQ(&tracker.Deduplicate(later_path), &later_path);
+}
+
+TEST_F(ShellTest, PathDeduplicationIsOptIn) {
+  VolatilePathTracker tracker(GetCurrentTaskRunner(), true);
+  SkPath path;
+  path.addRect(SkRect::MakeWH(10, 10));
+  path.setIsVolatile(true);
+  EXPECT_EQ(&tracker.Deduplicate(path), &path);
+  tracker.OnFrame();
+  SkPath same_path = path;
+  EXPECT_EQ(&tracker.Deduplicate(same_path), &same_path);
+}
+
 }  // namespace testing
 }  // namespace flutter
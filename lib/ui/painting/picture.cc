@@ -156,12 +156,16 @@ Dart_Handle Picture::RasterizeToImage(
   fml::TaskRunner::RunNowOrPostTask(
       raster_task_runner, [ui_task_runner, snapshot_delegate, draw_callback,
                            picture_bounds, ui_task] {
-        sk_sp<SkImage> raster_image = snapshot_delegate->MakeRasterSnapshot(
-            draw_callback, picture_bounds);
-
-        fml::TaskRunner::RunNowOrPostTask(
-            ui_task_runner,
-            [ui_task, raster_image]() { ui_task(raster_image); });
+        // The raster thread is not blocked on the transfer of the pixels
+        // from the GPU, and the image is handed to the UI thread when it
+        // completes.
+        snapshot_delegate->MakeRasterSnapshotAsync(
+            draw_callback, picture_bounds,
+            [ui_task_runner, ui_task](sk_sp<SkImage> raster_image) {
+              fml::TaskRunner::RunNowOrPostTask(
+                  ui_task_runner,
+                  [ui_task, raster_image]() { ui_task(raster_image); });
+            });
       });
 
   return Dart_Null();
@@ -10,10 +10,12 @@
 namespace flutter {
 
 SingleFrameCodec::SingleFrameCodec(fml::RefPtr<ImageDescriptor> descriptor,
+                                   const SkIRect& subset,
                                    uint32_t target_width,
                                    uint32_t target_height)
     : status_(Status::kNew),
       descriptor_(std::move(descriptor)),
+      subset_(subset),
       target_width_(target_width),
       target_height_(target_height) {}
 
@@ -66,7 +68,8 @@ Dart_Handle SingleFrameCodec::getNextFrame(Dart_Handle callback_handle) {
       new fml::RefPtr<SingleFrameCodec>(this);
 
   decoder->Decode(
-      descriptor_, target_width_, target_height_, [raw_codec_ref](auto image) {
+      descriptor_, subset_, target_width_, target_height_,
+      [raw_codec_ref](auto image) {
         std::unique_ptr<fml::RefPtr<SingleFrameCodec>> codec_ref(raw_codec_ref);
         fml::RefPtr<SingleFrameCodec> codec(std::move(*codec_ref));
 
@@ -16,6 +16,7 @@ namespace flutter {
 class SingleFrameCodec : public Codec {
  public:
   SingleFrameCodec(fml::RefPtr<ImageDescriptor> descriptor,
+                   const SkIRect& subset,
                    uint32_t target_width,
                    uint32_t target_height);
 
@@ -37,6 +38,7 @@ class SingleFrameCodec : public Codec {
   enum class Status { kNew, kInProgress, kComplete };
   Status status_;
   fml::RefPtr<ImageDescriptor> descriptor_;
+  const SkIRect subset_;
   uint32_t target_width_;
   uint32_t target_height_;
   fml::RefPtr<CanvasImage> cached_image_;
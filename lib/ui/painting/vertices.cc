@@ -5,6 +5,7 @@
 #include "flutter/lib/ui/painting/vertices.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -14,17 +15,18 @@ namespace flutter {
 
 namespace {
 
+// The typed data has the layout of the Skia types, so it is copied in bulk
+// rather than one element at a time.
 void DecodePoints(const tonic::Float32List& coords, SkPoint* points) {
-  for (int i = 0; i < coords.num_elements(); i += 2) {
-    points[i / 2] = SkPoint::Make(coords[i], coords[i + 1]);
-  }
+  static_assert(sizeof(SkPoint) == sizeof(float) * 2,
+                "SkPoint doesn't use floats.");
+  memcpy(points, coords.data(), coords.num_elements() / 2 * sizeof(SkPoint));
 }
 
-template <typename T>
-void DecodeInts(const tonic::Int32List& ints, T* out) {
-  for (int i = 0; i < ints.num_elements(); i++) {
-    out[i] = ints[i];
-  }
+void DecodeColors(const tonic::Int32List& ints, SkColor* colors) {
+  static_assert(sizeof(SkColor) == sizeof(int32_t),
+                "SkColor doesn't use 32 bits.");
+  memcpy(colors, ints.data(), ints.num_elements() * sizeof(SkColor));
 }
 
 }  // namespace
@@ -79,7 +81,7 @@ bool Vertices::init(Dart_Handle vertices_handle,
   if (colors.data()) {
     // SkVertices::Builder assumes equal numbers of elements
     FML_DCHECK(positions.num_elements() / 2 == colors.num_elements());
-    DecodeInts<SkColor>(colors, builder.colors());
+    DecodeColors(colors, builder.colors());
   }
 
   if (indices.data()) {
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_LIB_UI_SNAPSHOT_DELEGATE_H_
 #define FLUTTER_LIB_UI_SNAPSHOT_DELEGATE_H_
 
+#include <functional>
+
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkPicture.h"
 
@@ -20,6 +22,16 @@ class SnapshotDelegate {
                                             SkISize picture_size) = 0;
 
   virtual sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) = 0;
+
+  using RasterSnapshotCallback = std::function<void(sk_sp<SkImage>)>;
+
+  /// Like |MakeRasterSnapshot|, but without blocking the calling thread on
+  /// the transfer of the pixels from the GPU. |callback| is called on the
+  /// raster thread with the snapshot, or with null if it could not be made.
+  virtual void MakeRasterSnapshotAsync(
+      std::function<void(SkCanvas*)> draw_callback,
+      SkISize picture_size,
+      RasterSnapshotCallback callback) = 0;
 };
 
 }  // namespace flutter
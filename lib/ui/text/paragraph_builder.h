@@ -7,6 +7,7 @@
 
 #include <memory>
 
+#include "flutter/fml/memory/free_list.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/paint.h"
 #include "flutter/lib/ui/text/paragraph.h"
@@ -26,6 +27,15 @@ class ParagraphBuilder : public RefCountedDartWrappable<ParagraphBuilder> {
   FML_FRIEND_MAKE_REF_COUNTED(ParagraphBuilder);
 
  public:
+  // A builder is created for every paragraph, so the memory of builders is
+  // recycled through a per-thread free list.
+  static void* operator new(size_t size) {
+    return fml::FreeList<sizeof(ParagraphBuilder)>::Allocate(size);
+  }
+  static void operator delete(void* pointer, size_t size) {
+    fml::FreeList<sizeof(ParagraphBuilder)>::Free(pointer, size);
+  }
+
   static fml::RefPtr<ParagraphBuilder> create(
       tonic::Int32List& encoded,
       Dart_Handle strutData,
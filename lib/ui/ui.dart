@@ -17,6 +17,7 @@ import 'dart:async';
 import 'dart:collection' as collection;
 import 'dart:convert';
 import 'dart:developer' as developer;
+import 'dart:ffi' hide Size; // ignore: undefined_hidden_name
 import 'dart:io'; // ignore: unused_import
 import 'dart:isolate' show SendPort;
 import 'dart:math' as math;
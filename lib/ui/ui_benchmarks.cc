@@ -10,6 +10,9 @@
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/dart_isolate_runner.h"
 #include "flutter/testing/fixture_test.h"
+#include "third_party/tonic/converter/dart_converter.h"
+#include "third_party/tonic/logging/dart_error.h"
+#include "third_party/tonic/logging/dart_invoke.h"
 
 #include <future>
 
@@ -112,9 +115,48 @@ static void BM_PathVolatilityTracker(benchmark::State& state) {
   }
 }
 
+// Calls the given entrypoint of the fixtures with the number of times to run
+// its loop, which makes |calls_per_loop| calls into the engine.
+static void BM_DartUICalls(benchmark::State& state,
+                           const char* entrypoint,
+                           int calls_per_loop) {
+  ThreadHost thread_host(ThreadHost::ThreadHostConfig(
+      "test", ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                  ThreadHost::Type::IO | ThreadHost::Type::UI));
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  Fixture fixture;
+  auto settings = fixture.CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  auto tracker = std::make_shared<VolatilePathTracker>(
+      task_runners.GetUITaskRunner(), true);
+  auto isolate = testing::RunDartCodeInIsolate(
+      vm_ref, settings, task_runners, "main", {},
+      testing::GetDefaultKernelFilePath(), {}, tracker);
+  FML_CHECK(isolate);
+
+  constexpr int kLoopCount = 10000;
+  while (state.KeepRunning()) {
+    bool successful = isolate->RunInIsolateScope([&]() -> bool {
+      return !tonic::LogIfError(tonic::DartInvokeField(
+          Dart_RootLibrary(), entrypoint, {tonic::ToDart(kLoopCount)}));
+    });
+    FML_CHECK(successful);
+  }
+  state.SetItemsProcessed(state.iterations() * kLoopCount * calls_per_loop);
+}
+
 BENCHMARK(BM_PlatformMessageResponseDartComplete)
     ->Unit(benchmark::kMicrosecond);
 
 BENCHMARK(BM_PathVolatilityTracker)->Unit(benchmark::kMillisecond);
 
+BENCHMARK_CAPTURE(BM_DartUICalls, PathCalls, "benchmarkPathCalls", 5)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DartUICalls, CanvasCalls, "benchmarkCanvasCalls", 6)
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
@@ -4,12 +4,18 @@
 
 #include "flutter/lib/ui/volatile_path_tracker.h"
 
+#include <functional>
+#include <string_view>
+
 namespace flutter {
 
 VolatilePathTracker::VolatilePathTracker(
     fml::RefPtr<fml::TaskRunner> ui_task_runner,
-    bool enabled)
-    : ui_task_runner_(ui_task_runner), enabled_(enabled) {}
+    bool enabled,
+    bool deduplicate)
+    : ui_task_runner_(ui_task_runner),
+      enabled_(enabled),
+      deduplicate_(enabled && deduplicate) {}
 
 void VolatilePathTracker::Track(std::shared_ptr<TrackedPath> path) {
   FML_DCHECK(ui_task_runner_->RunsTasksOnCurrentThread());
@@ -27,6 +33,16 @@ void VolatilePathTracker::OnFrame() {
   if (!enabled_) {
     return;
   }
+  frame_count_++;
+  for (auto it = deduplicated_paths_.begin();
+       it != deduplicated_paths_.end();) {
+    if (frame_count_ - it->second.last_frame >
+        static_cast<size_t>(kFramesOfVolatility)) {
+      it = deduplicated_paths_.erase(it);
+    } else {
+      ++it;
+    }
+  }
 #if !FLUTTER_RELEASE
   std::string total_count = std::to_string(paths_.size());
   TRACE_EVENT1("flutter", "VolatilePathTracker::OnFrame", "total_count",
@@ -58,4 +74,40 @@ void VolatilePathTracker::OnFrame() {
 #endif
 }
 
+const SkPath& VolatilePathTracker::Deduplicate(const SkPath& path) {
+  FML_DCHECK(ui_task_runner_->RunsTasksOnCurrentThread());
+  if (!deduplicate_ || !path.isVolatile()) {
+    return path;
+  }
+
+  serialized_path_.resize(path.writeToMemory(nullptr));
+  path.writeToMemory(serialized_path_.data());
+  const size_t hash = std::hash<std::string_view>()(
+      std::string_view(reinterpret_cast<const char*>(serialized_path_.data()),
+                       serialized_path_.size()));
+
+  auto found = deduplicated_paths_.find(hash);
+  if (found == deduplicated_paths_.end() || found->second.path != path) {
+    // A path with another hash only replaces an entry that collided with it.
+    if (found == deduplicated_paths_.end() &&
+        deduplicated_paths_.size() >= kMaxDeduplicatedPaths) {
+      return path;
+    }
+    DeduplicatedPath& entry = deduplicated_paths_[hash];
+    entry.path = path;
+    entry.first_frame = frame_count_;
+    entry.last_frame = frame_count_;
+    return path;
+  }
+
+  DeduplicatedPath& entry = found->second;
+  entry.last_frame = frame_count_;
+  // Like the tracked paths, the path only becomes non-volatile once it has
+  // been drawn in more than one frame.
+  if (entry.first_frame != frame_count_) {
+    entry.path.setIsVolatile(false);
+  }
+  return entry.path;
+}
+
 }  // namespace flutter
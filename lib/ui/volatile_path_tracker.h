@@ -8,6 +8,7 @@
 #include <deque>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -33,6 +34,14 @@ class ShellTest;
 /// when paths are rendered. If deterministic rendering is needed, e.g. for a
 /// screen diffing test, this class will not cache any paths and will
 /// automatically set the volatility of the path to false.
+///
+/// A path that the framework rebuilds with the same commands in every frame is
+/// a new path each time, so it never survives long enough to become
+/// non-volatile. When deduplication is enabled, the tracker keeps the paths
+/// drawn in the last frames by their contents, and |Deduplicate| replaces a
+/// volatile path by the one drawn with the same contents in an earlier frame.
+/// Those paths share their generation ID, and so the masks and tessellations
+/// that Skia caches for it.
 class VolatilePathTracker {
  public:
   /// The fields of this struct must only accessed on the UI task runner.
@@ -43,10 +52,14 @@ class VolatilePathTracker {
   };
 
   VolatilePathTracker(fml::RefPtr<fml::TaskRunner> ui_task_runner,
-                      bool enabled);
+                      bool enabled,
+                      bool deduplicate = false);
 
   static constexpr int kFramesOfVolatility = 2;
 
+  // The most paths kept to deduplicate the paths drawn in the next frames.
+  static constexpr size_t kMaxDeduplicatedPaths = 256;
+
   // Starts tracking a path.
   // Must be called from the UI task runner.
   //
@@ -62,12 +75,34 @@ class VolatilePathTracker {
   // Must be called from the UI task runner.
   void OnFrame();
 
+  // Returns the path to draw in place of |path|: a non-volatile copy of the
+  // path with the same contents drawn in one of the last
+  // |kFramesOfVolatility| frames, or |path| itself if there is none, the path
+  // is not volatile or deduplication is disabled. The returned reference is
+  // only valid until the next call to the tracker.
+  //
+  // Must be called from the UI task runner.
+  const SkPath& Deduplicate(const SkPath& path);
+
   bool enabled() const { return enabled_; }
 
+  bool deduplicates() const { return deduplicate_; }
+
  private:
+  struct DeduplicatedPath {
+    SkPath path;
+    size_t first_frame = 0;
+    size_t last_frame = 0;
+  };
+
   fml::RefPtr<fml::TaskRunner> ui_task_runner_;
   std::vector<std::weak_ptr<TrackedPath>> paths_;
   bool enabled_ = true;
+  const bool deduplicate_;
+  size_t frame_count_ = 0;
+  // Keyed by the hash of the serialized paths.
+  std::unordered_map<size_t, DeduplicatedPath> deduplicated_paths_;
+  std::vector<uint8_t> serialized_path_;
 
   friend class testing::ShellTest;
 
@@ -9,6 +9,7 @@
 #include "flutter/lib/ui/compositing/scene.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_message_response_dart.h"
+#include "flutter/lib/ui/window/platform_message_ring_buffer.h"
 #include "flutter/lib/ui/window/viewport_metrics.h"
 #include "flutter/lib/ui/window/window.h"
 #include "third_party/tonic/converter/dart_converter.h"
@@ -130,7 +131,8 @@ Dart_Handle SendPlatformMessage(Dart_Handle window,
     const uint8_t* buffer = static_cast<const uint8_t*>(data.data());
     dart_state->platform_configuration()->client()->HandlePlatformMessage(
         std::make_unique<PlatformMessage>(
-            name, fml::MallocMapping::Copy(buffer, data.length_in_bytes()),
+            name,
+            fml::MallocMapping::CopyPooled(buffer, data.length_in_bytes()),
             response));
   }
 
@@ -155,7 +157,7 @@ void RespondToPlatformMessage(Dart_Handle window,
         ->platform_configuration()
         ->CompletePlatformMessageResponse(
             response_id,
-            std::vector<uint8_t>(buffer, buffer + data.length_in_bytes()));
+            fml::MallocMapping::CopyPooled(buffer, data.length_in_bytes()));
   }
 }
 
@@ -185,6 +187,50 @@ Dart_Handle ToByteData(const fml::Mapping& buffer) {
   return tonic::DartByteData::Create(buffer.GetMapping(), buffer.GetSize());
 }
 
+void DeleteMappingFinalizer(void* isolate_callback_data, void* peer) {
+  delete static_cast<fml::MallocMapping*>(peer);
+}
+
+void ReleaseRingBufferCopyFinalizer(void* isolate_callback_data, void* peer) {
+  PlatformMessageRingBuffer::ReleaseCopy(static_cast<uint8_t*>(peer));
+}
+
+// Moves the payload of the message into byte data. Large payloads are not
+// copied, their buffer stays alive until the byte data is collected. Small
+// payloads are copied into |ring_buffer|, if any and if it has room, and
+// viewed from there.
+Dart_Handle ReleaseDataToByteData(PlatformMessage& message,
+                                  PlatformMessageRingBuffer* ring_buffer) {
+  const size_t size = message.data().GetSize();
+  if (size < tonic::DartByteData::kExternalSizeThreshold && ring_buffer) {
+    if (uint8_t* copy = ring_buffer->Push(message.data().GetMapping(), size)) {
+      message.releaseData();
+      Dart_Handle handle = Dart_NewExternalTypedDataWithFinalizer(
+          Dart_TypedData_kByteData, copy, size, copy, size,
+          ReleaseRingBufferCopyFinalizer);
+      if (Dart_IsError(handle)) {
+        PlatformMessageRingBuffer::ReleaseCopy(copy);
+      }
+      return handle;
+    }
+  }
+  if (size < tonic::DartByteData::kExternalSizeThreshold) {
+    Dart_Handle handle = ToByteData(message.data());
+    // The buffer goes back to the pool before the handler runs.
+    message.releaseData();
+    return handle;
+  }
+  auto* mapping = new fml::MallocMapping(message.releaseData());
+  Dart_Handle handle = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kByteData, const_cast<uint8_t*>(mapping->GetMapping()),
+      mapping->GetSize(), mapping, mapping->GetSize(),
+      DeleteMappingFinalizer);
+  if (Dart_IsError(handle)) {
+    delete mapping;
+  }
+  return handle;
+}
+
 }  // namespace
 
 PlatformConfigurationClient::~PlatformConfigurationClient() {}
@@ -214,6 +260,9 @@ void PlatformConfiguration::DidCreateIsolate() {
   dispatch_platform_message_.Set(
       tonic::DartState::Current(),
       Dart_GetField(library, tonic::ToDart("_dispatchPlatformMessage")));
+  dispatch_platform_messages_.Set(
+      tonic::DartState::Current(),
+      Dart_GetField(library, tonic::ToDart("_dispatchPlatformMessages")));
   dispatch_semantics_action_.Set(
       tonic::DartState::Current(),
       Dart_GetField(library, tonic::ToDart("_dispatchSemanticsAction")));
@@ -308,7 +357,10 @@ void PlatformConfiguration::DispatchPlatformMessage(
   }
   tonic::DartState::Scope scope(dart_state);
   Dart_Handle data_handle =
-      (message->hasData()) ? ToByteData(message->data()) : Dart_Null();
+      (message->hasData())
+          ? ReleaseDataToByteData(*message,
+                                  GetChannelRingBuffer(message->channel()))
+          : Dart_Null();
   if (Dart_IsError(data_handle)) {
     FML_DLOG(WARNING)
         << "Dropping platform message because of a Dart error on channel: "
@@ -328,6 +380,72 @@ void PlatformConfiguration::DispatchPlatformMessage(
                          tonic::ToDart(response_id)}));
 }
 
+void PlatformConfiguration::DispatchPlatformMessages(
+    std::vector<std::unique_ptr<PlatformMessage>> messages) {
+  if (messages.size() == 1) {
+    DispatchPlatformMessage(std::move(messages.front()));
+    return;
+  }
+  std::shared_ptr<tonic::DartState> dart_state =
+      dispatch_platform_messages_.dart_state().lock();
+  if (!dart_state) {
+    FML_DLOG(WARNING) << "Dropping " << messages.size()
+                      << " platform messages for lack of DartState.";
+    return;
+  }
+  tonic::DartState::Scope scope(dart_state);
+
+  // The channel, data and response ID of each message follow each other in a
+  // single list.
+  Dart_Handle list = Dart_NewList(messages.size() * 3);
+  for (size_t i = 0; i < messages.size(); i++) {
+    auto& message = messages[i];
+    Dart_Handle data_handle =
+        (message->hasData())
+            ? ReleaseDataToByteData(*message,
+                                    GetChannelRingBuffer(message->channel()))
+            : Dart_Null();
+    if (Dart_IsError(data_handle)) {
+      FML_DLOG(WARNING)
+          << "Dropping platform message because of a Dart error on channel: "
+          << message->channel();
+      // The entry is left null, which the Dart side skips.
+      continue;
+    }
+
+    int response_id = 0;
+    if (auto response = message->response()) {
+      response_id = next_response_id_++;
+      pending_responses_[response_id] = response;
+    }
+
+    Dart_ListSetAt(list, i * 3, tonic::ToDart(message->channel()));
+    Dart_ListSetAt(list, i * 3 + 1, data_handle);
+    Dart_ListSetAt(list, i * 3 + 2, tonic::ToDart(response_id));
+  }
+
+  tonic::LogIfError(
+      tonic::DartInvoke(dispatch_platform_messages_.Get(), {list}));
+}
+
+PlatformMessageRingBuffer* PlatformConfiguration::GetChannelRingBuffer(
+    const std::string& channel) {
+  auto it = channel_ring_buffers_.find(channel);
+  if (it == channel_ring_buffers_.end()) {
+    if (channel_ring_buffers_.size() >= kMaxChannelRingBuffers) {
+      return nullptr;
+    }
+    it = channel_ring_buffers_.emplace(channel, ChannelRingBuffer()).first;
+  }
+  ChannelRingBuffer& channel_ring_buffer = it->second;
+  if (!channel_ring_buffer.ring_buffer &&
+      ++channel_ring_buffer.message_count >= kMessagesBeforeRingBuffer) {
+    channel_ring_buffer.ring_buffer =
+        fml::MakeRefCounted<PlatformMessageRingBuffer>();
+  }
+  return channel_ring_buffer.ring_buffer.get();
+}
+
 void PlatformConfiguration::DispatchSemanticsAction(int32_t id,
                                                     SemanticsAction action,
                                                     fml::MallocMapping args) {
@@ -415,7 +533,7 @@ void PlatformConfiguration::CompletePlatformMessageEmptyResponse(
 
 void PlatformConfiguration::CompletePlatformMessageResponse(
     int response_id,
-    std::vector<uint8_t> data) {
+    fml::MallocMapping data) {
   if (!response_id) {
     return;
   }
@@ -425,7 +543,7 @@ void PlatformConfiguration::CompletePlatformMessageResponse(
   }
   auto response = std::move(it->second);
   pending_responses_.erase(it);
-  response->Complete(std::make_unique<fml::DataMapping>(std::move(data)));
+  response->Complete(std::make_unique<fml::MallocMapping>(std::move(data)));
 }
 
 Dart_Handle ComputePlatformResolvedLocale(Dart_Handle supportedLocalesHandle) {
@@ -11,8 +11,11 @@
 #include <unordered_map>
 #include <vector>
 
+#include "flutter/assets/asset_manager.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/lib/ui/semantics/semantics_update.h"
+#include "flutter/lib/ui/window/platform_message_ring_buffer.h"
 #include "flutter/lib/ui/window/pointer_data_packet.h"
 #include "flutter/lib/ui/window/viewport_metrics.h"
 #include "flutter/lib/ui/window/window.h"
@@ -97,6 +100,11 @@ class PlatformConfigurationClient {
   ///             creation.
   virtual FontCollection& GetFontCollection() = 0;
 
+  //--------------------------------------------------------------------------
+  /// @brief      Returns the current collection of assets available on the
+  ///             platform.
+  virtual std::shared_ptr<AssetManager> GetAssetManager() = 0;
+
   //--------------------------------------------------------------------------
   /// @brief      Notifies this client of the name of the root isolate and its
   ///             port when that isolate is launched, restarted (in the
@@ -310,6 +318,17 @@ class PlatformConfiguration final {
   ///
   void DispatchPlatformMessage(std::unique_ptr<PlatformMessage> message);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the PlatformConfiguration that the client has sent
+  ///             it messages, which are delivered to the Dart application in a
+  ///             single call.
+  ///
+  /// @param[in]  messages  The messages sent from the embedder to the Dart
+  ///                       application, in the order they were sent.
+  ///
+  void DispatchPlatformMessages(
+      std::vector<std::unique_ptr<PlatformMessage>> messages);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the framework that the embedder encountered an
   ///             accessibility related action on the specified node. This call
@@ -408,7 +427,7 @@ class PlatformConfiguration final {
   /// @param[in] data        The data to send back in the response.
   ///
   void CompletePlatformMessageResponse(int response_id,
-                                       std::vector<uint8_t> data);
+                                       fml::MallocMapping data);
 
   //----------------------------------------------------------------------------
   /// @brief      Responds to a previous platform message to the engine from the
@@ -420,6 +439,22 @@ class PlatformConfiguration final {
   void CompletePlatformMessageEmptyResponse(int response_id);
 
  private:
+  // The number of messages a channel receives before the payloads of its
+  // messages are held in a ring buffer.
+  static constexpr size_t kMessagesBeforeRingBuffer = 8;
+  // The number of channels for which the payloads of messages are held in
+  // ring buffers.
+  static constexpr size_t kMaxChannelRingBuffers = 16;
+
+  struct ChannelRingBuffer {
+    size_t message_count = 0;
+    fml::RefPtr<PlatformMessageRingBuffer> ring_buffer;
+  };
+
+  // Returns the ring buffer that holds the payloads of the messages of
+  // |channel|, or nullptr if the channel has none.
+  PlatformMessageRingBuffer* GetChannelRingBuffer(const std::string& channel);
+
   PlatformConfigurationClient* client_;
   tonic::DartPersistentValue update_locales_;
   tonic::DartPersistentValue update_user_settings_data_;
@@ -427,6 +462,7 @@ class PlatformConfiguration final {
   tonic::DartPersistentValue update_semantics_enabled_;
   tonic::DartPersistentValue update_accessibility_features_;
   tonic::DartPersistentValue dispatch_platform_message_;
+  tonic::DartPersistentValue dispatch_platform_messages_;
   tonic::DartPersistentValue dispatch_semantics_action_;
   tonic::DartPersistentValue begin_frame_;
   tonic::DartPersistentValue draw_frame_;
@@ -438,6 +474,8 @@ class PlatformConfiguration final {
   int next_response_id_ = 1;
   std::unordered_map<int, fml::RefPtr<PlatformMessageResponse>>
       pending_responses_;
+
+  std::unordered_map<std::string, ChannelRingBuffer> channel_ring_buffers_;
 };
 
 }  // namespace flutter
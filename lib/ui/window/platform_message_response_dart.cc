@@ -44,6 +44,9 @@ void PlatformMessageResponseDart::Complete(std::unique_ptr<fml::Mapping> data) {
 
         Dart_Handle byte_buffer =
             tonic::DartByteData::Create(data->GetMapping(), data->GetSize());
+        // The response has been copied, so a pooled buffer can go back to the
+        // pool before the callback runs.
+        data.reset();
         tonic::DartInvoke(callback.Release(), {byte_buffer});
       }));
 }
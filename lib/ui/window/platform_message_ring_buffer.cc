@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/platform_message_ring_buffer.h"
+
+#include <cstring>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+// Regions are multiples of the header alignment, so that the space left at
+// the end of the slab can always hold the header of a skipped region.
+static size_t RegionSize(size_t payload_size, size_t header_size) {
+  constexpr size_t kAlignment = 16;
+  return (payload_size + header_size + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+PlatformMessageRingBuffer::PlatformMessageRingBuffer()
+    : slab_(new uint8_t[kCapacity]) {}
+
+PlatformMessageRingBuffer::~PlatformMessageRingBuffer() {
+  FML_DCHECK(used_bytes_ == 0);
+}
+
+uint8_t* PlatformMessageRingBuffer::Push(const uint8_t* data, size_t size) {
+  size_t region_size = RegionSize(size, sizeof(RegionHeader));
+  if (region_size > kCapacity) {
+    return nullptr;
+  }
+  RegionHeader* header = nullptr;
+  {
+    std::scoped_lock lock(mutex_);
+    if (used_bytes_ == 0) {
+      head_ = tail_ = 0;
+    } else if (head_ == tail_) {
+      return nullptr;
+    }
+    size_t offset;
+    if (head_ < tail_) {
+      if (tail_ - head_ < region_size) {
+        return nullptr;
+      }
+      offset = head_;
+    } else if (kCapacity - head_ >= region_size) {
+      offset = head_;
+    } else if (tail_ >= region_size) {
+      // Skip the end of the slab, which the tail then passes over.
+      WriteHeader(head_, kCapacity - head_, true);
+      offset = 0;
+    } else {
+      return nullptr;
+    }
+    header = WriteHeader(offset, region_size, false);
+  }
+  AddRef();
+  uint8_t* copy = reinterpret_cast<uint8_t*>(header + 1);
+  memcpy(copy, data, size);
+  return copy;
+}
+
+PlatformMessageRingBuffer::RegionHeader*
+PlatformMessageRingBuffer::WriteHeader(size_t offset,
+                                       size_t size,
+                                       bool released) {
+  auto* header = reinterpret_cast<RegionHeader*>(slab_.get() + offset);
+  header->ring = this;
+  header->size = static_cast<uint32_t>(size);
+  header->released = released;
+  head_ = (offset + size) % kCapacity;
+  used_bytes_ += size;
+  return header;
+}
+
+void PlatformMessageRingBuffer::ReleaseCopy(uint8_t* copy) {
+  auto* header = reinterpret_cast<RegionHeader*>(copy) - 1;
+  PlatformMessageRingBuffer* ring = header->ring;
+  ring->ReleaseRegion(header);
+  ring->Release();
+}
+
+void PlatformMessageRingBuffer::ReleaseRegion(RegionHeader* header) {
+  std::scoped_lock lock(mutex_);
+  FML_DCHECK(!header->released);
+  header->released = true;
+  while (used_bytes_ > 0) {
+    auto* tail = reinterpret_cast<RegionHeader*>(slab_.get() + tail_);
+    if (!tail->released) {
+      break;
+    }
+    used_bytes_ -= tail->size;
+    tail_ = (tail_ + tail->size) % kCapacity;
+  }
+}
+
+size_t PlatformMessageRingBuffer::used_bytes() const {
+  std::scoped_lock lock(mutex_);
+  return used_bytes_;
+}
+
+}  // namespace flutter
@@ -0,0 +1,79 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_WINDOW_PLATFORM_MESSAGE_RING_BUFFER_H_
+#define FLUTTER_LIB_UI_WINDOW_PLATFORM_MESSAGE_RING_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/ref_counted.h"
+
+namespace flutter {
+
+// Holds the payloads of the platform messages of one channel while the
+// Dart byte data that views them is alive.
+//
+// The payloads are copied one after the other into a slab of fixed
+// capacity that is used as a ring. They are released as Dart collects the
+// byte data, in any order, and the ring reuses their space once the
+// payloads copied before them are released too. This keeps the payloads of
+// channels that receive many small messages out of the Dart heap.
+class PlatformMessageRingBuffer
+    : public fml::RefCountedThreadSafe<PlatformMessageRingBuffer> {
+ public:
+  // The size of the slab.
+  static constexpr size_t kCapacity = 16 * 1024;
+
+  // Copies |size| bytes from |data| into the ring, and returns the copy,
+  // or nullptr if the ring has no room for it. The ring stays alive until
+  // the copy is released.
+  uint8_t* Push(const uint8_t* data, size_t size);
+
+  // Releases a copy returned by |Push|. May be called on any thread.
+  static void ReleaseCopy(uint8_t* copy);
+
+  // The bytes of the slab taken by the copies that are not released yet,
+  // including the space the ring skips to keep each copy contiguous.
+  size_t used_bytes() const;
+
+ private:
+  // Precedes each copy in the slab.
+  struct alignas(16) RegionHeader {
+    PlatformMessageRingBuffer* ring;
+    // The size of the region, this header included.
+    uint32_t size;
+    bool released;
+  };
+
+  PlatformMessageRingBuffer();
+
+  ~PlatformMessageRingBuffer();
+
+  // Writes the header of a region of |size| bytes at |offset|.
+  RegionHeader* WriteHeader(size_t offset, size_t size, bool released);
+
+  // Marks |header| as released and frees the released regions at the tail
+  // of the ring.
+  void ReleaseRegion(RegionHeader* header);
+
+  mutable std::mutex mutex_;
+  std::unique_ptr<uint8_t[]> slab_;
+  // The offset at which the next region is written.
+  size_t head_ = 0;
+  // The offset of the oldest region.
+  size_t tail_ = 0;
+  size_t used_bytes_ = 0;
+
+  FML_FRIEND_MAKE_REF_COUNTED(PlatformMessageRingBuffer);
+  FML_FRIEND_REF_COUNTED_THREAD_SAFE(PlatformMessageRingBuffer);
+  FML_DISALLOW_COPY_AND_ASSIGN(PlatformMessageRingBuffer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_WINDOW_PLATFORM_MESSAGE_RING_BUFFER_H_
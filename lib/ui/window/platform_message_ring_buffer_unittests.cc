@@ -0,0 +1,75 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/platform_message_ring_buffer.h"
+
+#include <vector>
+
+#include "flutter/fml/memory/ref_ptr.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(PlatformMessageRingBufferTest, CopiesPayloads) {
+  auto ring = fml::MakeRefCounted<PlatformMessageRingBuffer>();
+  const uint8_t data[] = {1, 2, 3, 4, 5};
+  uint8_t* copy = ring->Push(data, sizeof(data));
+  ASSERT_NE(copy, nullptr);
+  EXPECT_EQ(std::vector<uint8_t>(copy, copy + sizeof(data)),
+            std::vector<uint8_t>(data, data + sizeof(data)));
+  EXPECT_GT(ring->used_bytes(), sizeof(data));
+
+  PlatformMessageRingBuffer::ReleaseCopy(copy);
+  EXPECT_EQ(ring->used_bytes(), 0u);
+}
+
+TEST(PlatformMessageRingBufferTest, SpaceIsReusedOnceTheTailIsReleased) {
+  auto ring = fml::MakeRefCounted<PlatformMessageRingBuffer>();
+  std::vector<uint8_t> data(1000);
+  std::vector<uint8_t*> copies;
+  while (uint8_t* copy = ring->Push(data.data(), data.size())) {
+    copies.push_back(copy);
+  }
+  ASSERT_GT(copies.size(), 2u);
+  EXPECT_EQ(ring->Push(data.data(), data.size()), nullptr);
+
+  // Releasing a copy after the tail frees nothing.
+  size_t used_bytes = ring->used_bytes();
+  PlatformMessageRingBuffer::ReleaseCopy(copies[1]);
+  EXPECT_EQ(ring->used_bytes(), used_bytes);
+  EXPECT_EQ(ring->Push(data.data(), data.size()), nullptr);
+
+  // Releasing the tail frees it and the released copy after it, and the
+  // ring wraps around to the start of the slab.
+  PlatformMessageRingBuffer::ReleaseCopy(copies[0]);
+  EXPECT_LT(ring->used_bytes(), used_bytes);
+  uint8_t* copy = ring->Push(data.data(), data.size());
+  EXPECT_EQ(copy, copies[0]);
+  copies[0] = copy;
+  copies.erase(copies.begin() + 1);
+
+  for (uint8_t* copy : copies) {
+    PlatformMessageRingBuffer::ReleaseCopy(copy);
+  }
+  EXPECT_EQ(ring->used_bytes(), 0u);
+}
+
+TEST(PlatformMessageRingBufferTest, RejectsPayloadsLargerThanTheSlab) {
+  auto ring = fml::MakeRefCounted<PlatformMessageRingBuffer>();
+  std::vector<uint8_t> data(PlatformMessageRingBuffer::kCapacity);
+  EXPECT_EQ(ring->Push(data.data(), data.size()), nullptr);
+}
+
+TEST(PlatformMessageRingBufferTest, CopiesKeepTheRingAlive) {
+  auto ring = fml::MakeRefCounted<PlatformMessageRingBuffer>();
+  const uint8_t data[] = {1, 2, 3};
+  uint8_t* copy = ring->Push(data, sizeof(data));
+  ring = nullptr;
+  EXPECT_EQ(copy[2], 3);
+  PlatformMessageRingBuffer::ReleaseCopy(copy);
+}
+
+}  // namespace testing
+}  // namespace flutter
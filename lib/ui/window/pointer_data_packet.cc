@@ -20,4 +20,18 @@ void PointerDataPacket::SetPointerData(size_t i, const PointerData& data) {
   memcpy(&data_[i * sizeof(PointerData)], &data, sizeof(PointerData));
 }
 
+PointerData PointerDataPacket::GetPointerData(size_t i) const {
+  PointerData data;
+  memcpy(&data, &data_[i * sizeof(PointerData)], sizeof(PointerData));
+  return data;
+}
+
+size_t PointerDataPacket::GetLength() const {
+  return data_.size() / sizeof(PointerData);
+}
+
+void PointerDataPacket::SetLength(size_t count) {
+  data_.resize(count * sizeof(PointerData));
+}
+
 }  // namespace flutter
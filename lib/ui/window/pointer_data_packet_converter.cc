@@ -17,29 +17,34 @@ PointerDataPacketConverter::~PointerDataPacketConverter() = default;
 
 std::unique_ptr<PointerDataPacket> PointerDataPacketConverter::Convert(
     std::unique_ptr<PointerDataPacket> packet) {
-  size_t kBytesPerPointerData = kPointerDataFieldCount * kBytesPerField;
-  auto buffer = packet->data();
-  size_t buffer_length = buffer.size();
-
-  std::vector<PointerData> converted_pointers;
-  // Converts each pointer data in the buffer and stores it in the
-  // converted_pointers.
-  for (size_t i = 0; i < buffer_length / kBytesPerPointerData; i++) {
-    PointerData pointer_data;
-    memcpy(&pointer_data, &buffer[i * kBytesPerPointerData],
-           sizeof(PointerData));
-    ConvertPointerData(pointer_data, converted_pointers);
+  size_t length = packet->GetLength();
+
+  // Most pointer data convert to exactly one pointer data, which replaces it
+  // in the packet.
+  size_t converted_length = 0;
+  for (; converted_length < length; converted_length++) {
+    converted_pointers_.clear();
+    ConvertPointerData(packet->GetPointerData(converted_length),
+                       converted_pointers_);
+    if (converted_pointers_.size() != 1) {
+      break;
+    }
+    packet->SetPointerData(converted_length, converted_pointers_[0]);
   }
-
-  // Writes converted_pointers into converted_packet.
-  auto converted_packet =
-      std::make_unique<flutter::PointerDataPacket>(converted_pointers.size());
-  size_t count = 0;
-  for (auto& converted_pointer : converted_pointers) {
-    converted_packet->SetPointerData(count++, converted_pointer);
+  if (converted_length == length) {
+    return packet;
   }
 
-  return converted_packet;
+  // From the first pointer data that was dropped or came with synthesized
+  // ones, the rest of the packet is converted aside and then written back.
+  for (size_t i = converted_length + 1; i < length; i++) {
+    ConvertPointerData(packet->GetPointerData(i), converted_pointers_);
+  }
+  packet->SetLength(converted_length + converted_pointers_.size());
+  for (const auto& converted_pointer : converted_pointers_) {
+    packet->SetPointerData(converted_length++, converted_pointer);
+  }
+  return packet;
 }
 
 void PointerDataPacketConverter::ConvertPointerData(
@@ -52,9 +57,9 @@ void PointerDataPacketConverter::ConvertPointerData(
         // to a non-existing pointer. Drops the cancel if pointer
         // is not previously added.
         // https://github.com/flutter/flutter/issues/20517
-        auto iter = states_.find(pointer_data.device);
-        if (iter != states_.end()) {
-          PointerState state = iter->second;
+        PointerState* found_state = FindPointerState(pointer_data.device);
+        if (found_state) {
+          PointerState state = *found_state;
           FML_DCHECK(state.is_down);
           UpdatePointerIdentifier(pointer_data, state, false);
 
@@ -69,22 +74,22 @@ void PointerDataPacketConverter::ConvertPointerData(
           }
 
           state.is_down = false;
-          states_[pointer_data.device] = state;
+          SetPointerState(pointer_data.device, state);
           converted_pointers.push_back(pointer_data);
         }
         break;
       }
       case PointerData::Change::kAdd: {
-        FML_DCHECK(states_.find(pointer_data.device) == states_.end());
+        FML_DCHECK(!FindPointerState(pointer_data.device));
         EnsurePointerState(pointer_data);
         converted_pointers.push_back(pointer_data);
         break;
       }
       case PointerData::Change::kRemove: {
         // Makes sure we have an existing pointer
-        auto iter = states_.find(pointer_data.device);
-        FML_DCHECK(iter != states_.end());
-        PointerState state = iter->second;
+        PointerState* found_state = FindPointerState(pointer_data.device);
+        FML_DCHECK(found_state);
+        PointerState state = *found_state;
 
         if (state.is_down) {
           // Synthesizes cancel event if the pointer is down.
@@ -94,7 +99,7 @@ void PointerDataPacketConverter::ConvertPointerData(
           UpdatePointerIdentifier(synthesized_cancel_event, state, false);
 
           state.is_down = false;
-          states_[synthesized_cancel_event.device] = state;
+          SetPointerState(synthesized_cancel_event.device, state);
           converted_pointers.push_back(synthesized_cancel_event);
         }
 
@@ -108,14 +113,14 @@ void PointerDataPacketConverter::ConvertPointerData(
           converted_pointers.push_back(synthesized_hover_event);
         }
 
-        states_.erase(pointer_data.device);
+        RemovePointerState(pointer_data.device);
         converted_pointers.push_back(pointer_data);
         break;
       }
       case PointerData::Change::kHover: {
-        auto iter = states_.find(pointer_data.device);
+        PointerState* found_state = FindPointerState(pointer_data.device);
         PointerState state;
-        if (iter == states_.end()) {
+        if (!found_state) {
           // Synthesizes add event if the pointer is not previously added.
           PointerData synthesized_add_event = pointer_data;
           synthesized_add_event.change = PointerData::Change::kAdd;
@@ -124,7 +129,7 @@ void PointerDataPacketConverter::ConvertPointerData(
           state = EnsurePointerState(synthesized_add_event);
           converted_pointers.push_back(synthesized_add_event);
         } else {
-          state = iter->second;
+          state = *found_state;
         }
 
         FML_DCHECK(!state.is_down);
@@ -136,9 +141,9 @@ void PointerDataPacketConverter::ConvertPointerData(
         break;
       }
       case PointerData::Change::kDown: {
-        auto iter = states_.find(pointer_data.device);
+        PointerState* found_state = FindPointerState(pointer_data.device);
         PointerState state;
-        if (iter == states_.end()) {
+        if (!found_state) {
           // Synthesizes a add event if the pointer is not previously added.
           PointerData synthesized_add_event = pointer_data;
           synthesized_add_event.change = PointerData::Change::kAdd;
@@ -147,7 +152,7 @@ void PointerDataPacketConverter::ConvertPointerData(
           state = EnsurePointerState(synthesized_add_event);
           converted_pointers.push_back(synthesized_add_event);
         } else {
-          state = iter->second;
+          state = *found_state;
         }
 
         FML_DCHECK(!state.is_down);
@@ -165,15 +170,15 @@ void PointerDataPacketConverter::ConvertPointerData(
         UpdatePointerIdentifier(pointer_data, state, true);
         state.is_down = true;
         state.buttons = pointer_data.buttons;
-        states_[pointer_data.device] = state;
+        SetPointerState(pointer_data.device, state);
         converted_pointers.push_back(pointer_data);
         break;
       }
       case PointerData::Change::kMove: {
         // Makes sure we have an existing pointer in down state
-        auto iter = states_.find(pointer_data.device);
-        FML_DCHECK(iter != states_.end());
-        PointerState state = iter->second;
+        PointerState* found_state = FindPointerState(pointer_data.device);
+        FML_DCHECK(found_state);
+        PointerState state = *found_state;
         FML_DCHECK(state.is_down);
 
         UpdatePointerIdentifier(pointer_data, state, false);
@@ -184,9 +189,9 @@ void PointerDataPacketConverter::ConvertPointerData(
       }
       case PointerData::Change::kUp: {
         // Makes sure we have an existing pointer in down state
-        auto iter = states_.find(pointer_data.device);
-        FML_DCHECK(iter != states_.end());
-        PointerState state = iter->second;
+        PointerState* found_state = FindPointerState(pointer_data.device);
+        FML_DCHECK(found_state);
+        PointerState state = *found_state;
         FML_DCHECK(state.is_down);
 
         UpdatePointerIdentifier(pointer_data, state, false);
@@ -204,15 +209,15 @@ void PointerDataPacketConverter::ConvertPointerData(
 
         state.is_down = false;
         state.buttons = pointer_data.buttons;
-        states_[pointer_data.device] = state;
+        SetPointerState(pointer_data.device, state);
         converted_pointers.push_back(pointer_data);
         break;
       }
       case PointerData::Change::kPanZoomStart: {
         // Makes sure we have an existing pointer
-        auto iter = states_.find(pointer_data.device);
+        PointerState* found_state = FindPointerState(pointer_data.device);
         PointerState state;
-        if (iter == states_.end()) {
+        if (!found_state) {
           // Synthesizes add event if the pointer is not previously added.
           PointerData synthesized_add_event = pointer_data;
           synthesized_add_event.change = PointerData::Change::kAdd;
@@ -221,7 +226,7 @@ void PointerDataPacketConverter::ConvertPointerData(
           state = EnsurePointerState(synthesized_add_event);
           converted_pointers.push_back(synthesized_add_event);
         } else {
-          state = iter->second;
+          state = *found_state;
         }
         FML_DCHECK(!state.is_down);
         FML_DCHECK(!state.is_pan_zoom_active);
@@ -242,15 +247,15 @@ void PointerDataPacketConverter::ConvertPointerData(
         state.pan_y = 0;
         state.scale = 1;
         state.rotation = 0;
-        states_[pointer_data.device] = state;
+        SetPointerState(pointer_data.device, state);
         converted_pointers.push_back(pointer_data);
         break;
       }
       case PointerData::Change::kPanZoomUpdate: {
         // Makes sure we have an existing pointer in pan_zoom_active state
-        auto iter = states_.find(pointer_data.device);
-        FML_DCHECK(iter != states_.end());
-        PointerState state = iter->second;
+        PointerState* found_state = FindPointerState(pointer_data.device);
+        FML_DCHECK(found_state);
+        PointerState state = *found_state;
         FML_DCHECK(!state.is_down);
         FML_DCHECK(state.is_pan_zoom_active);
 
@@ -262,9 +267,9 @@ void PointerDataPacketConverter::ConvertPointerData(
       }
       case PointerData::Change::kPanZoomEnd: {
         // Makes sure we have an existing pointer in pan_zoom_active state
-        auto iter = states_.find(pointer_data.device);
-        FML_DCHECK(iter != states_.end());
-        PointerState state = iter->second;
+        PointerState* found_state = FindPointerState(pointer_data.device);
+        FML_DCHECK(found_state);
+        PointerState state = *found_state;
         FML_DCHECK(state.is_pan_zoom_active);
 
         UpdatePointerIdentifier(pointer_data, state, false);
@@ -286,7 +291,7 @@ void PointerDataPacketConverter::ConvertPointerData(
         }
 
         state.is_pan_zoom_active = false;
-        states_[pointer_data.device] = state;
+        SetPointerState(pointer_data.device, state);
         converted_pointers.push_back(pointer_data);
         break;
       }
@@ -299,10 +304,10 @@ void PointerDataPacketConverter::ConvertPointerData(
     switch (pointer_data.signal_kind) {
       case PointerData::SignalKind::kScroll: {
         // Makes sure we have an existing pointer
-        auto iter = states_.find(pointer_data.device);
-        FML_DCHECK(iter != states_.end());
+        PointerState* found_state = FindPointerState(pointer_data.device);
+        FML_DCHECK(found_state);
 
-        PointerState state = iter->second;
+        PointerState state = *found_state;
         if (LocationNeedsUpdate(pointer_data, state)) {
           if (state.is_down) {
             // Synthesizes a move event if the pointer is down.
@@ -349,7 +354,7 @@ PointerState PointerDataPacketConverter::EnsurePointerState(
   state.physical_y = pointer_data.physical_y;
   state.pan_x = 0;
   state.pan_y = 0;
-  states_[pointer_data.device] = state;
+  SetPointerState(pointer_data.device, state);
   return state;
 }
 
@@ -365,7 +370,34 @@ void PointerDataPacketConverter::UpdateDeltaAndState(PointerData& pointer_data,
   state.pan_y = pointer_data.pan_y;
   state.scale = pointer_data.scale;
   state.rotation = pointer_data.rotation;
-  states_[pointer_data.device] = state;
+  SetPointerState(pointer_data.device, state);
+}
+
+PointerState* PointerDataPacketConverter::FindPointerState(int64_t device) {
+  for (auto& [state_device, state] : states_) {
+    if (state_device == device) {
+      return &state;
+    }
+  }
+  return nullptr;
+}
+
+void PointerDataPacketConverter::SetPointerState(int64_t device,
+                                                 const PointerState& state) {
+  if (PointerState* found_state = FindPointerState(device)) {
+    *found_state = state;
+  } else {
+    states_.emplace_back(device, state);
+  }
+}
+
+void PointerDataPacketConverter::RemovePointerState(int64_t device) {
+  for (auto it = states_.begin(); it != states_.end(); ++it) {
+    if (it->first == device) {
+      states_.erase(it);
+      return;
+    }
+  }
 }
 
 bool PointerDataPacketConverter::LocationNeedsUpdate(
@@ -381,7 +413,7 @@ void PointerDataPacketConverter::UpdatePointerIdentifier(
     bool start_new_pointer) {
   if (start_new_pointer) {
     state.pointer_identifier = ++pointer_;
-    states_[pointer_data.device] = state;
+    SetPointerState(pointer_data.device, state);
   }
   pointer_data.pointer_identifier = state.pointer_identifier;
 }
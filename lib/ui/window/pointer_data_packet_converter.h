@@ -6,8 +6,8 @@
 #define FLUTTER_LIB_UI_WINDOW_POINTER_DATA_PACKET_CONVERTER_H_
 
 #include <cstring>
-#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -92,15 +92,31 @@ class PointerDataPacketConverter {
   /// filled.
   ///             It may contain synthetic pointer data as the result of
   ///             converter's attempt to correct illegal pointer transitions.
+  ///             The pointer data are converted in place, so the returned
+  ///             packet is the given one, grown only if pointer data were
+  ///             synthesized.
   ///
   std::unique_ptr<PointerDataPacket> Convert(
       std::unique_ptr<PointerDataPacket> packet);
 
  private:
-  std::map<int64_t, PointerState> states_;
+  // The states of the devices that were added, by device. There are rarely
+  // more than a few devices, so a flat table is faster to search than a map.
+  std::vector<std::pair<int64_t, PointerState>> states_;
+
+  // The pointer data converted from the event that is being converted and the
+  // ones after it, kept to reuse its buffer from one packet to the next.
+  std::vector<PointerData> converted_pointers_;
 
   int64_t pointer_;
 
+  // Returns the state of the device, or null if it was not added.
+  PointerState* FindPointerState(int64_t device);
+
+  void SetPointerState(int64_t device, const PointerState& state);
+
+  void RemovePointerState(int64_t device);
+
   void ConvertPointerData(PointerData pointer_data,
                           std::vector<PointerData>& converted_pointers);
 
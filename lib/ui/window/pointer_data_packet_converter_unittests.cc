@@ -338,6 +338,102 @@ TEST(PointerDataPacketConverterTest, AlwaysForwardMoveEvent) {
   ASSERT_EQ(result[3].synthesized, 0);
 }
 
+TEST(PointerDataPacketConverterTest, ConvertsPacketInPlace) {
+  PointerDataPacketConverter converter;
+  auto packet = std::make_unique<PointerDataPacket>(4);
+  PointerData data;
+  CreateSimulatedPointerData(data, PointerData::Change::kAdd, 0, 0.0, 0.0, 0);
+  packet->SetPointerData(0, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kDown, 0, 0.0, 0.0, 1);
+  packet->SetPointerData(1, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 0, 1.0, 0.0, 1);
+  packet->SetPointerData(2, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 0, 3.0, 0.0, 1);
+  packet->SetPointerData(3, data);
+  const PointerDataPacket* raw_packet = packet.get();
+  const uint8_t* raw_data = packet->data().data();
+
+  auto converted_packet = converter.Convert(std::move(packet));
+
+  // The packet and its buffer are reused.
+  ASSERT_EQ(converted_packet.get(), raw_packet);
+  ASSERT_EQ(converted_packet->data().data(), raw_data);
+  ASSERT_EQ(converted_packet->GetLength(), (size_t)4);
+
+  std::vector<PointerData> result;
+  UnpackPointerPacket(result, std::move(converted_packet));
+
+  ASSERT_EQ(result[2].change, PointerData::Change::kMove);
+  ASSERT_EQ(result[2].pointer_identifier, 1);
+  ASSERT_EQ(result[2].physical_delta_x, 1.0);
+
+  ASSERT_EQ(result[3].change, PointerData::Change::kMove);
+  ASSERT_EQ(result[3].pointer_identifier, 1);
+  ASSERT_EQ(result[3].physical_delta_x, 2.0);
+}
+
+TEST(PointerDataPacketConverterTest, CanGrowAndShrinkPacket) {
+  PointerDataPacketConverter converter;
+  auto packet = std::make_unique<PointerDataPacket>(5);
+  PointerData data;
+  CreateSimulatedPointerData(data, PointerData::Change::kAdd, 0, 0.0, 0.0, 0);
+  packet->SetPointerData(0, data);
+  // Hovers without a location change are dropped.
+  CreateSimulatedPointerData(data, PointerData::Change::kHover, 0, 0.0, 0.0, 0);
+  packet->SetPointerData(1, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kHover, 0, 0.0, 0.0, 0);
+  packet->SetPointerData(2, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kDown, 0, 3.0, 0.0, 1);
+  packet->SetPointerData(3, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 0, 3.0, 4.0, 1);
+  packet->SetPointerData(4, data);
+
+  auto converted_packet = converter.Convert(std::move(packet));
+  ASSERT_EQ(converted_packet->GetLength(), (size_t)4);
+
+  std::vector<PointerData> result;
+  UnpackPointerPacket(result, std::move(converted_packet));
+
+  ASSERT_EQ(result[0].change, PointerData::Change::kAdd);
+
+  // A hover should be synthesized.
+  ASSERT_EQ(result[1].change, PointerData::Change::kHover);
+  ASSERT_EQ(result[1].synthesized, 1);
+  ASSERT_EQ(result[1].physical_delta_x, 3.0);
+
+  ASSERT_EQ(result[2].change, PointerData::Change::kDown);
+  ASSERT_EQ(result[2].pointer_identifier, 1);
+
+  ASSERT_EQ(result[3].change, PointerData::Change::kMove);
+  ASSERT_EQ(result[3].pointer_identifier, 1);
+  ASSERT_EQ(result[3].physical_delta_y, 4.0);
+
+  // A packet that grows keeps the pointer data converted before.
+  packet = std::make_unique<PointerDataPacket>(2);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 0, 3.0, 5.0, 1);
+  packet->SetPointerData(0, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kUp, 0, 3.0, 6.0, 0);
+  packet->SetPointerData(1, data);
+
+  converted_packet = converter.Convert(std::move(packet));
+  ASSERT_EQ(converted_packet->GetLength(), (size_t)3);
+
+  result.clear();
+  UnpackPointerPacket(result, std::move(converted_packet));
+
+  ASSERT_EQ(result[0].change, PointerData::Change::kMove);
+  ASSERT_EQ(result[0].synthesized, 0);
+  ASSERT_EQ(result[0].physical_delta_y, 1.0);
+
+  // A move should be synthesized.
+  ASSERT_EQ(result[1].change, PointerData::Change::kMove);
+  ASSERT_EQ(result[1].synthesized, 1);
+  ASSERT_EQ(result[1].physical_delta_y, 1.0);
+
+  ASSERT_EQ(result[2].change, PointerData::Change::kUp);
+  ASSERT_EQ(result[2].pointer_identifier, 1);
+}
+
 TEST(PointerDataPacketConverterTest, CanWorkWithDifferentDevices) {
   PointerDataPacketConverter converter;
   auto packet = std::make_unique<PointerDataPacket>(12);
@@ -4,6 +4,8 @@
 
 #include "flutter/lib/ui/window/window.h"
 
+#include <utility>
+
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/logging/dart_invoke.h"
@@ -19,16 +21,41 @@ Window::Window(int64_t window_id, ViewportMetrics metrics)
 
 Window::~Window() {}
 
-void Window::DispatchPointerDataPacket(const PointerDataPacket& packet) {
+namespace {
+
+void DeletePacketFinalizer(void* isolate_callback_data, void* peer) {
+  delete static_cast<PointerDataPacket*>(peer);
+}
+
+// Moves the packet into byte data. Large packets are not copied, they stay
+// alive until the byte data is collected.
+Dart_Handle ToByteData(std::unique_ptr<PointerDataPacket> packet) {
+  const std::vector<uint8_t>& buffer = packet->data();
+  if (buffer.size() < tonic::DartByteData::kExternalSizeThreshold) {
+    return tonic::DartByteData::Create(buffer.data(), buffer.size());
+  }
+  void* data = const_cast<uint8_t*>(buffer.data());
+  intptr_t size = buffer.size();
+  PointerDataPacket* peer = packet.release();
+  Dart_Handle handle = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kByteData, data, size, peer, size, DeletePacketFinalizer);
+  if (Dart_IsError(handle)) {
+    delete peer;
+  }
+  return handle;
+}
+
+}  // namespace
+
+void Window::DispatchPointerDataPacket(
+    std::unique_ptr<PointerDataPacket> packet) {
   std::shared_ptr<tonic::DartState> dart_state = library_.dart_state().lock();
   if (!dart_state) {
     return;
   }
   tonic::DartState::Scope scope(dart_state);
 
-  const std::vector<uint8_t>& buffer = packet.data();
-  Dart_Handle data_handle =
-      tonic::DartByteData::Create(buffer.data(), buffer.size());
+  Dart_Handle data_handle = ToByteData(std::move(packet));
   if (Dart_IsError(data_handle)) {
     return;
   }
@@ -6,6 +6,7 @@
 #define FLUTTER_LIB_UI_WINDOW_WINDOW_H_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -29,8 +30,8 @@ class Window final {
   const ViewportMetrics& viewport_metrics() const { return viewport_metrics_; }
 
   // Dispatch a packet to the framework that indicates one or a few pointer
-  // events.
-  void DispatchPointerDataPacket(const PointerDataPacket& packet);
+  // events. Large packets are handed to the framework without a copy.
+  void DispatchPointerDataPacket(std::unique_ptr<PointerDataPacket> packet);
   void UpdateWindowMetrics(const ViewportMetrics& metrics);
 
  private:
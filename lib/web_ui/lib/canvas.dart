@@ -82,6 +82,15 @@ abstract class PictureRecorder {
   Picture endRecording();
 }
 
+abstract class CanvasBatch {
+  factory CanvasBatch() => engine.EngineCanvasBatch();
+  int get length;
+  void addRect(Rect rect, Paint paint);
+  void addLine(Offset p1, Offset p2, Paint paint);
+  void addCircle(Offset c, double radius, Paint paint);
+  void clear();
+}
+
 abstract class Canvas {
   factory Canvas(PictureRecorder recorder, [Rect? cullRect]) {
     if (engine.useCanvasKit) {
@@ -112,6 +121,7 @@ abstract class Canvas {
   void drawDRRect(RRect outer, RRect inner, Paint paint);
   void drawOval(Rect rect, Paint paint);
   void drawCircle(Offset c, double radius, Paint paint);
+  void drawBatch(CanvasBatch batch);
   void drawArc(Rect rect, double startAngle, double sweepAngle, bool useCenter,
       Paint paint);
   void drawPath(Path path, Paint paint);
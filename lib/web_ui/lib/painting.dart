@@ -728,6 +728,12 @@ class ImmutableBuffer {
     return instance;
   }
 
+  static Future<ImmutableBuffer> fromAsset(String assetKey) async {
+    final ByteData data = await _assetManager!.load(assetKey);
+    return fromUint8List(
+        data.buffer.asUint8List(data.offsetInBytes, data.lengthInBytes));
+  }
+
   Uint8List? _list;
   final int length;
 
@@ -783,10 +789,13 @@ class ImageDescriptor {
   int get bytesPerPixel =>
       throw UnsupportedError('ImageDescriptor.bytesPerPixel is not supported on web.');
   void dispose() => _data = null;
-  Future<Codec> instantiateCodec({int? targetWidth, int? targetHeight}) async {
+  Future<Codec> instantiateCodec({int? targetWidth, int? targetHeight, Rect? sourceRect}) async {
     if (_data == null) {
       throw StateError('Object is disposed');
     }
+    if (sourceRect != null) {
+      _throw('instantiateCodec(sourceRect)');
+    }
     if (_width == null) {
       return instantiateImageCodec(
         _data!,
@@ -814,4 +823,9 @@ class FragmentProgram {
     Float32List? floatUniforms,
     List<ImageShader>? samplerUniforms,
   }) => throw UnsupportedError('FragmentProgram is not supported for the CanvasKit or HTML renderers.');
+
+  Future<void> warmUp({
+    Float32List? floatUniforms,
+    List<ImageShader>? samplerUniforms,
+  }) => throw UnsupportedError('FragmentProgram is not supported for the CanvasKit or HTML renderers.');
 }
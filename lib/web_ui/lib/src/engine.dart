@@ -18,6 +18,7 @@ library engine;
 export 'engine/alarm_clock.dart';
 export 'engine/assets.dart';
 export 'engine/browser_detection.dart';
+export 'engine/canvas_batch.dart';
 export 'engine/canvas_pool.dart';
 export 'engine/canvaskit/canvas.dart';
 export 'engine/canvaskit/canvaskit_api.dart';
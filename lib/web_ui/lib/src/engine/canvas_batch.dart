@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'package:ui/ui.dart' as ui;
+
+/// The web implementation of [ui.CanvasBatch].
+///
+/// Calls to a canvas do not cross into a separate engine on the web, so the
+/// batch keeps the shapes with a copy of their paints and draws them one at a
+/// time.
+class EngineCanvasBatch implements ui.CanvasBatch {
+  final List<void Function(ui.Canvas)> _ops = <void Function(ui.Canvas)>[];
+
+  @override
+  int get length => _ops.length;
+
+  @override
+  void addRect(ui.Rect rect, ui.Paint paint) {
+    final ui.Paint copy = _copyPaint(paint);
+    _ops.add((ui.Canvas canvas) => canvas.drawRect(rect, copy));
+  }
+
+  @override
+  void addLine(ui.Offset p1, ui.Offset p2, ui.Paint paint) {
+    final ui.Paint copy = _copyPaint(paint);
+    _ops.add((ui.Canvas canvas) => canvas.drawLine(p1, p2, copy));
+  }
+
+  @override
+  void addCircle(ui.Offset c, double radius, ui.Paint paint) {
+    final ui.Paint copy = _copyPaint(paint);
+    _ops.add((ui.Canvas canvas) => canvas.drawCircle(c, radius, copy));
+  }
+
+  @override
+  void clear() {
+    _ops.clear();
+  }
+
+  /// Draws the shapes of the batch into the canvas, in the order they were
+  /// added.
+  void drawTo(ui.Canvas canvas) {
+    for (final void Function(ui.Canvas) op in _ops) {
+      op(canvas);
+    }
+  }
+
+  static ui.Paint _copyPaint(ui.Paint paint) {
+    return ui.Paint()
+      ..blendMode = paint.blendMode
+      ..style = paint.style
+      ..strokeWidth = paint.strokeWidth
+      ..strokeCap = paint.strokeCap
+      ..strokeJoin = paint.strokeJoin
+      ..isAntiAlias = paint.isAntiAlias
+      ..color = paint.color
+      ..invertColors = paint.invertColors
+      ..shader = paint.shader
+      ..maskFilter = paint.maskFilter
+      ..filterQuality = paint.filterQuality
+      ..colorFilter = paint.colorFilter
+      ..strokeMiterLimit = paint.strokeMiterLimit
+      ..imageFilter = paint.imageFilter;
+  }
+}
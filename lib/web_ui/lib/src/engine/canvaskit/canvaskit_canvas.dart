@@ -7,6 +7,7 @@ import 'dart:typed_data';
 import 'package:ui/ui.dart' as ui;
 
 import '../../engine.dart' show toMatrix32;
+import '../canvas_batch.dart';
 import '../validators.dart';
 import 'canvas.dart';
 import 'canvaskit_api.dart';
@@ -225,6 +226,12 @@ class CanvasKitCanvas implements ui.Canvas {
     _canvas.drawCircle(c, radius, paint as CkPaint);
   }
 
+  @override
+  void drawBatch(ui.CanvasBatch batch) {
+    assert(batch != null); // ignore: unnecessary_null_comparison
+    (batch as EngineCanvasBatch).drawTo(this);
+  }
+
   @override
   void drawArc(ui.Rect rect, double startAngle, double sweepAngle,
       bool useCenter, ui.Paint paint) {
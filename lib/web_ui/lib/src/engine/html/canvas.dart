@@ -8,6 +8,7 @@ import 'dart:typed_data';
 import 'package:ui/ui.dart' as ui;
 
 import '../../engine.dart' show toMatrix32;
+import '../canvas_batch.dart';
 import '../picture.dart';
 import '../util.dart';
 import '../validators.dart';
@@ -221,6 +222,12 @@ class SurfaceCanvas implements ui.Canvas {
     _canvas.drawCircle(c, radius, paint as SurfacePaint);
   }
 
+  @override
+  void drawBatch(ui.CanvasBatch batch) {
+    assert(batch != null); // ignore: unnecessary_null_comparison
+    (batch as EngineCanvasBatch).drawTo(this);
+  }
+
   @override
   void drawArc(ui.Rect rect, double startAngle, double sweepAngle,
       bool useCenter, ui.Paint paint) {
@@ -532,6 +532,13 @@ bool DartIsolate::LoadKernel(std::shared_ptr<const fml::Mapping> mapping,
   if (tonic::LogIfError(Dart_FinalizeLoading(false))) {
     return false;
   }
+
+  // The rest of the kernel is only read as its functions are compiled, so the
+  // pages of the mapped files may be dropped until then instead of staying in
+  // the memory of the process.
+  for (const auto& buffer : kernel_buffers_) {
+    buffer->DontNeed();
+  }
   return true;
 }
 
@@ -786,6 +793,15 @@ Dart_Isolate DartIsolate::DartCreateAndStartServiceIsolate(
     return nullptr;
   }
 
+  // This runs on a thread of the VM, which waits here while the launch is
+  // deferred.
+  if (!DartServiceIsolate::WaitForDeferredLaunch()) {
+    *error = fml::strdup(
+        "The VM shut down before the deferred launch of the service isolate.");
+    return nullptr;
+  }
+  TRACE_EVENT0("flutter", "DartIsolate::DartCreateAndStartServiceIsolate");
+
   flags->load_vmservice_library = true;
 
 #if (FLUTTER_RUNTIME_MODE != FLUTTER_RUNTIME_MODE_DEBUG)
@@ -949,6 +965,9 @@ Dart_Isolate DartIsolate::DartIsolateGroupCreateCallback(
 bool DartIsolate::DartIsolateInitializeCallback(void** child_callback_data,
                                                 char** error) {
   TRACE_EVENT0("flutter", "DartIsolate::DartIsolateInitializeCallback");
+  // The VM creates the isolates spawned by Dart code in the group of their
+  // parent itself and only asks the engine to set them up here, so the engine
+  // has no way to hand out isolates that it created ahead of time instead.
   Dart_Isolate isolate = Dart_CurrentIsolate();
   if (isolate == nullptr) {
     *error = fml::strdup("Isolate should be available in initialize callback.");
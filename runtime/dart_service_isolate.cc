@@ -54,6 +54,14 @@ std::mutex DartServiceIsolate::callbacks_mutex_;
 std::set<std::unique_ptr<DartServiceIsolate::ObservatoryServerStateCallback>>
     DartServiceIsolate::callbacks_;
 
+std::mutex DartServiceIsolate::deferred_launch_mutex_;
+
+std::condition_variable DartServiceIsolate::deferred_launch_condition_;
+
+DartServiceIsolate::DeferredLaunchState
+    DartServiceIsolate::deferred_launch_state_ =
+        DartServiceIsolate::DeferredLaunchState::kNotDeferred;
+
 void DartServiceIsolate::NotifyServerState(Dart_NativeArguments args) {
   Dart_Handle exception = nullptr;
   std::string uri =
@@ -122,6 +130,36 @@ bool DartServiceIsolate::RemoveServerStatusCallback(
   return true;
 }
 
+void DartServiceIsolate::SetLaunchDeferred(bool deferred) {
+  std::scoped_lock lock(deferred_launch_mutex_);
+  deferred_launch_state_ = deferred ? DeferredLaunchState::kDeferred
+                                    : DeferredLaunchState::kNotDeferred;
+}
+
+void DartServiceIsolate::ReleaseDeferredLaunch() {
+  std::scoped_lock lock(deferred_launch_mutex_);
+  if (deferred_launch_state_ == DeferredLaunchState::kDeferred) {
+    deferred_launch_state_ = DeferredLaunchState::kReleased;
+    deferred_launch_condition_.notify_all();
+  }
+}
+
+void DartServiceIsolate::CancelDeferredLaunch() {
+  std::scoped_lock lock(deferred_launch_mutex_);
+  if (deferred_launch_state_ == DeferredLaunchState::kDeferred) {
+    deferred_launch_state_ = DeferredLaunchState::kCancelled;
+    deferred_launch_condition_.notify_all();
+  }
+}
+
+bool DartServiceIsolate::WaitForDeferredLaunch() {
+  std::unique_lock lock(deferred_launch_mutex_);
+  deferred_launch_condition_.wait(lock, [] {
+    return deferred_launch_state_ != DeferredLaunchState::kDeferred;
+  });
+  return deferred_launch_state_ != DeferredLaunchState::kCancelled;
+}
+
 void DartServiceIsolate::Shutdown(Dart_NativeArguments args) {
   // NO-OP.
 }
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_RUNTIME_DART_SERVICE_ISOLATE_H_
 #define FLUTTER_RUNTIME_DART_SERVICE_ISOLATE_H_
 
+#include <condition_variable>
 #include <functional>
 #include <mutex>
 #include <set>
@@ -95,13 +96,63 @@ class DartServiceIsolate {
   ///
   static bool RemoveServerStatusCallback(CallbackHandle handle);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets whether the next launch of the service isolate waits
+  ///             until `ReleaseDeferredLaunch` or `CancelDeferredLaunch` is
+  ///             called. The VM launches the service isolate on a thread of its
+  ///             own, so the startup of the engine does not wait for it. This
+  ///             must be called before the VM is initialized.
+  ///
+  ///             This method is thread safe.
+  ///
+  /// @param[in]  deferred  Whether the launch is deferred.
+  ///
+  static void SetLaunchDeferred(bool deferred);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Lets the deferred launch of the service isolate proceed. This
+  ///             does nothing if the launch was not deferred.
+  ///
+  ///             This method is thread safe.
+  ///
+  static void ReleaseDeferredLaunch();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Gives up the deferred launch of the service isolate, such as
+  ///             when the VM shuts down before the launch was released. This
+  ///             does nothing if the launch was not deferred.
+  ///
+  ///             This method is thread safe.
+  ///
+  static void CancelDeferredLaunch();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Waits until the deferred launch of the service isolate is
+  ///             released or cancelled. This returns immediately if the launch
+  ///             was not deferred.
+  ///
+  /// @return     Whether the service isolate may be launched.
+  ///
+  static bool WaitForDeferredLaunch();
+
  private:
+  enum class DeferredLaunchState {
+    kNotDeferred,
+    kDeferred,
+    kReleased,
+    kCancelled,
+  };
+
   // Native entries.
   static void NotifyServerState(Dart_NativeArguments args);
   static void Shutdown(Dart_NativeArguments args);
 
   static std::mutex callbacks_mutex_;
   static std::set<std::unique_ptr<ObservatoryServerStateCallback>> callbacks_;
+
+  static std::mutex deferred_launch_mutex_;
+  static std::condition_variable deferred_launch_condition_;
+  static DeferredLaunchState deferred_launch_state_;
 };
 
 }  // namespace flutter
@@ -4,6 +4,10 @@
 
 #include "flutter/runtime/dart_service_isolate.h"
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 #include "flutter/testing/testing.h"
 
 namespace flutter {
@@ -15,4 +19,37 @@ TEST(DartServiceIsolateTest, CanAddAndRemoveHandles) {
   ASSERT_TRUE(DartServiceIsolate::RemoveServerStatusCallback(handle));
 }
 
+TEST(DartServiceIsolateTest, DeferredLaunchWaitsUntilReleased) {
+  DartServiceIsolate::SetLaunchDeferred(false);
+  ASSERT_TRUE(DartServiceIsolate::WaitForDeferredLaunch());
+
+  DartServiceIsolate::SetLaunchDeferred(true);
+  std::atomic<bool> launched = false;
+  std::thread launcher([&launched]() {
+    ASSERT_TRUE(DartServiceIsolate::WaitForDeferredLaunch());
+    launched = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  ASSERT_FALSE(launched);
+  DartServiceIsolate::ReleaseDeferredLaunch();
+  launcher.join();
+  ASSERT_TRUE(launched);
+
+  DartServiceIsolate::SetLaunchDeferred(false);
+}
+
+TEST(DartServiceIsolateTest, CancelledLaunchDoesNotLaunch) {
+  DartServiceIsolate::SetLaunchDeferred(true);
+  std::thread launcher(
+      []() { ASSERT_FALSE(DartServiceIsolate::WaitForDeferredLaunch()); });
+  DartServiceIsolate::CancelDeferredLaunch();
+  launcher.join();
+
+  // Releasing a launch that is not deferred does nothing.
+  DartServiceIsolate::ReleaseDeferredLaunch();
+  ASSERT_FALSE(DartServiceIsolate::WaitForDeferredLaunch());
+
+  DartServiceIsolate::SetLaunchDeferred(false);
+}
+
 }  // namespace flutter
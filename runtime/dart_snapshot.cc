@@ -229,7 +229,13 @@ fml::RefPtr<DartSnapshot> DartSnapshot::VMServiceIsolateSnapshotFromSettings(
 
 DartSnapshot::DartSnapshot(std::shared_ptr<const fml::Mapping> data,
                            std::shared_ptr<const fml::Mapping> instructions)
-    : data_(std::move(data)), instructions_(std::move(instructions)) {}
+    : data_(std::move(data)), instructions_(std::move(instructions)) {
+  // All of the data is read when the snapshot is loaded, while the
+  // instructions are only paged in as the code runs.
+  if (data_) {
+    data_->Prefetch();
+  }
+}
 
 DartSnapshot::~DartSnapshot() = default;
 
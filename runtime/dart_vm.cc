@@ -6,6 +6,7 @@
 
 #include <sys/stat.h>
 
+#include <algorithm>
 #include <sstream>
 #include <vector>
 
@@ -18,6 +19,7 @@
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/dart_ui.h"
 #include "flutter/runtime/dart_isolate.h"
+#include "flutter/runtime/dart_service_isolate.h"
 #include "flutter/runtime/dart_vm_initializer.h"
 #include "flutter/runtime/ptrace_check.h"
 #include "third_party/dart/runtime/include/bin/dart_io_api.h"
@@ -280,13 +282,29 @@ size_t DartVM::GetVMLaunchCount() {
   return gVMLaunchCount;
 }
 
+// Leaves half of the workers free for the other tasks of the pool, such as the
+// decodes of images, unless the settings specify another limit.
+static size_t GetSkiaExecutorMaxConcurrency(
+    const Settings& settings,
+    const fml::ConcurrentMessageLoop& concurrent_message_loop) {
+  if (settings.skia_executor_max_concurrency > 0) {
+    return settings.skia_executor_max_concurrency;
+  }
+  return std::max<size_t>(1,
+                          (concurrent_message_loop.GetWorkerCount() + 1) / 2);
+}
+
 DartVM::DartVM(std::shared_ptr<const DartVMData> vm_data,
                std::shared_ptr<IsolateNameServer> isolate_name_server)
     : settings_(vm_data->GetSettings()),
       concurrent_message_loop_(fml::ConcurrentMessageLoop::Create()),
       skia_concurrent_executor_(
           [runner = concurrent_message_loop_->GetTaskRunner()](
-              fml::closure work) { runner->PostTask(work); }),
+              fml::closure work) {
+            runner->PostTask(work, fml::ConcurrentTaskPriority::kNextFrame);
+          },
+          GetSkiaExecutorMaxConcurrency(settings_,
+                                        *concurrent_message_loop_)),
       vm_data_(vm_data),
       isolate_name_server_(std::move(isolate_name_server)),
       service_protocol_(std::make_shared<ServiceProtocol>()) {
@@ -435,6 +453,10 @@ DartVM::DartVM(std::shared_ptr<const DartVMData> vm_data,
 
   DartUI::InitForGlobal();
 
+  DartServiceIsolate::SetLaunchDeferred(
+      settings_.enable_observatory && settings_.defer_service_isolate_launch &&
+      !settings_.start_paused);
+
   {
     TRACE_EVENT0("flutter", "Dart_Initialize");
     Dart_InitializeParams params = {};
@@ -502,6 +524,9 @@ DartVM::~DartVM() {
     Dart_ExitIsolate();
   }
 
+  // The VM waits for the service isolate to launch when it shuts down.
+  DartServiceIsolate::CancelDeferredLaunch();
+
   DartVMInitializer::Cleanup();
 
   dart::bin::CleanupDartIo();
@@ -230,6 +230,8 @@ std::unique_ptr<IsolateConfiguration> IsolateConfiguration::InferFromSettings(
     std::unique_ptr<fml::Mapping> kernel =
         asset_manager->GetAsMapping(settings.application_kernel_asset);
     if (kernel) {
+      // The kernel is only read once the isolate is launched.
+      kernel->Prefetch();
       return CreateForKernel(std::move(kernel));
     }
   }
@@ -251,6 +253,9 @@ std::unique_ptr<IsolateConfiguration> IsolateConfiguration::InferFromSettings(
       return nullptr;
     }
     auto kernel_pieces_paths = ParseKernelListPaths(std::move(kernel_list));
+    for (const auto& kernel_pieces_path : kernel_pieces_paths) {
+      asset_manager->Prefetch(kernel_pieces_path);
+    }
     auto kernel_mappings = PrepareKernelMappings(std::move(kernel_pieces_paths),
                                                  asset_manager, io_worker);
     return CreateForKernelList(std::move(kernel_mappings));
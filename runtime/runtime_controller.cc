@@ -215,6 +215,11 @@ bool RuntimeController::NotifyIdle(fml::TimePoint deadline) {
 
   Dart_NotifyIdle(deadline.ToEpochDelta().ToMicroseconds());
 
+  {
+    TRACE_EVENT0("flutter", "ReleaseFinalizedWrappables");
+    root_isolate->ReleaseFinalizedWrappables();
+  }
+
   // Idle notifications being in isolate scope are part of the contract.
   if (idle_notification_callback_) {
     TRACE_EVENT0("flutter", "EmbedderIdleNotification");
@@ -235,12 +240,25 @@ bool RuntimeController::DispatchPlatformMessage(
   return false;
 }
 
+bool RuntimeController::DispatchPlatformMessages(
+    std::vector<std::unique_ptr<PlatformMessage>> messages) {
+  if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
+    TRACE_EVENT1("flutter", "RuntimeController::DispatchPlatformMessages",
+                 "mode", "basic");
+    platform_configuration->DispatchPlatformMessages(std::move(messages));
+    return true;
+  }
+
+  return false;
+}
+
 bool RuntimeController::DispatchPointerDataPacket(
-    const PointerDataPacket& packet) {
+    std::unique_ptr<PointerDataPacket> packet) {
   if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
     TRACE_EVENT1("flutter", "RuntimeController::DispatchPointerDataPacket",
                  "mode", "basic");
-    platform_configuration->get_window(0)->DispatchPointerDataPacket(packet);
+    platform_configuration->get_window(0)->DispatchPointerDataPacket(
+        std::move(packet));
     return true;
   }
 
@@ -300,6 +318,11 @@ FontCollection& RuntimeController::GetFontCollection() {
   return client_.GetFontCollection();
 }
 
+// |PlatformConfigurationClient|
+std::shared_ptr<AssetManager> RuntimeController::GetAssetManager() {
+  return client_.GetAssetManager();
+}
+
 // |PlatformConfigurationClient|
 void RuntimeController::UpdateIsolateDescription(const std::string isolate_name,
                                                  int64_t isolate_port) {
@@ -391,6 +414,10 @@ bool RuntimeController::LaunchRootIsolate(
   strong_root_isolate->SetReturnCodeCallback(
       [this](uint32_t code) { root_isolate_return_code_ = code; });
 
+  // The wrappers collected by the garbage collector are released in
+  // |NotifyIdle| rather than in their finalizers.
+  strong_root_isolate->SetDefersWrappableFinalization(true);
+
   if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
     tonic::DartState::Scope scope(strong_root_isolate);
     platform_configuration->DidCreateIsolate();
@@ -378,6 +378,18 @@ class RuntimeController : public PlatformConfigurationClient {
   virtual bool DispatchPlatformMessage(
       std::unique_ptr<PlatformMessage> message);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Dispatch the specified platform messages to the running root
+  ///             isolate in a single call.
+  ///
+  /// @param[in]  messages  The messages to dispatch to the isolate, in order.
+  ///
+  /// @return     If the messages were dispatched to the running root isolate.
+  ///             This may fail is an isolate is not running.
+  ///
+  virtual bool DispatchPlatformMessages(
+      std::vector<std::unique_ptr<PlatformMessage>> messages);
+
   //----------------------------------------------------------------------------
   /// @brief      Dispatch the specified pointer data message to the running
   ///             root isolate.
@@ -387,7 +399,7 @@ class RuntimeController : public PlatformConfigurationClient {
   /// @return     If the pointer data message was dispatched. This may fail is
   ///             an isolate is not running.
   ///
-  bool DispatchPointerDataPacket(const PointerDataPacket& packet);
+  bool DispatchPointerDataPacket(std::unique_ptr<PointerDataPacket> packet);
 
   //----------------------------------------------------------------------------
   /// @brief      Dispatch the semantics action to the specified accessibility
@@ -609,6 +621,9 @@ class RuntimeController : public PlatformConfigurationClient {
   // |PlatformConfigurationClient|
   FontCollection& GetFontCollection() override;
 
+  // |PlatformConfigurationClient|
+  std::shared_ptr<AssetManager> GetAssetManager() override;
+
   // |PlatformConfigurationClient|
   void UpdateIsolateDescription(const std::string isolate_name,
                                 int64_t isolate_port) override;
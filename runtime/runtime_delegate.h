@@ -33,6 +33,8 @@ class RuntimeDelegate {
 
   virtual FontCollection& GetFontCollection() = 0;
 
+  virtual std::shared_ptr<AssetManager> GetAssetManager() = 0;
+
   virtual void OnRootIsolateCreated() = 0;
 
   virtual void UpdateIsolateDescription(const std::string isolate_name,
@@ -6,12 +6,15 @@
 
 #include "flutter/runtime/service_protocol.h"
 
+#include <atomic>
+#include <cstdlib>
 #include <cstring>
 #include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "flutter/fml/logging.h"
 #include "flutter/fml/posix_wrappers.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "rapidjson/stringbuffer.h"
@@ -37,6 +40,23 @@ const std::string_view ServiceProtocol::kGetSkSLsExtensionName =
 const std::string_view
     ServiceProtocol::kEstimateRasterCacheMemoryExtensionName =
         "_flutter.estimateRasterCacheMemory";
+const std::string_view
+    ServiceProtocol::kGetPartialRepaintStatisticsExtensionName =
+        "_flutter.getPartialRepaintStatistics";
+const std::string_view
+    ServiceProtocol::kGetFrameTimingPercentilesExtensionName =
+        "_flutter.getFrameTimingPercentiles";
+const std::string_view ServiceProtocol::kGetTraceRingBufferExtensionName =
+    "_flutter.getTraceRingBuffer";
+const std::string_view ServiceProtocol::kGetGpuMemoryUsageExtensionName =
+    "_flutter.getGpuMemoryUsage";
+const std::string_view ServiceProtocol::kFrameStatsStreamName =
+    "_FlutterFrameStats";
+const std::string_view ServiceProtocol::kFrameStatsEventKind = "FrameStats";
+
+// The stream callbacks of the VM are global, and so is whether they are set.
+static std::atomic_bool gStreamCallbacksSet;
+static std::atomic_bool gFrameStatsStreamListened;
 
 static constexpr std::string_view kViewIdPrefx = "_flutterView/";
 static constexpr std::string_view kListViewsExtensionName =
@@ -56,6 +76,10 @@ ServiceProtocol::ServiceProtocol()
           kGetDisplayRefreshRateExtensionName,
           kGetSkSLsExtensionName,
           kEstimateRasterCacheMemoryExtensionName,
+          kGetPartialRepaintStatisticsExtensionName,
+          kGetFrameTimingPercentilesExtensionName,
+          kGetTraceRingBufferExtensionName,
+          kGetGpuMemoryUsageExtensionName,
       }),
       handlers_mutex_(fml::SharedMutex::Create()) {}
 
@@ -91,6 +115,50 @@ void ServiceProtocol::ToggleHooks(bool set) {
         set ? this : nullptr              // user data
     );
   }
+
+  if (gStreamCallbacksSet.exchange(set) == set) {
+    return;
+  }
+  char* error = Dart_SetServiceStreamCallbacks(
+      set ? &ServiceProtocol::OnStreamListen : nullptr,
+      set ? &ServiceProtocol::OnStreamCancel : nullptr);
+  if (error) {
+    FML_DLOG(ERROR) << "Could not set the service stream callbacks: " << error;
+    ::free(error);
+  }
+  if (!set) {
+    gFrameStatsStreamListened = false;
+  }
+}
+
+bool ServiceProtocol::OnStreamListen(const char* stream_id) {
+  if (kFrameStatsStreamName != stream_id) {
+    return false;
+  }
+  gFrameStatsStreamListened = true;
+  return true;
+}
+
+void ServiceProtocol::OnStreamCancel(const char* stream_id) {
+  if (kFrameStatsStreamName == stream_id) {
+    gFrameStatsStreamListened = false;
+  }
+}
+
+bool ServiceProtocol::IsFrameStatsStreamListened() {
+  return gFrameStatsStreamListened;
+}
+
+void ServiceProtocol::SendFrameStatsEvent(const rapidjson::Value& event) {
+  if (!gFrameStatsStreamListened) {
+    return;
+  }
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  event.Accept(writer);
+  Dart_ServiceSendDataEvent(
+      kFrameStatsStreamName.data(), kFrameStatsEventKind.data(),
+      reinterpret_cast<const uint8_t*>(buffer.GetString()), buffer.GetSize());
 }
 
 static void WriteServerErrorResponse(rapidjson::Document* document,
@@ -29,6 +29,14 @@ class ServiceProtocol {
   static const std::string_view kGetDisplayRefreshRateExtensionName;
   static const std::string_view kGetSkSLsExtensionName;
   static const std::string_view kEstimateRasterCacheMemoryExtensionName;
+  static const std::string_view kGetPartialRepaintStatisticsExtensionName;
+  static const std::string_view kGetFrameTimingPercentilesExtensionName;
+  static const std::string_view kGetTraceRingBufferExtensionName;
+  static const std::string_view kGetGpuMemoryUsageExtensionName;
+  // The stream of the VM service on which the records of the rasterized
+  // frames are sent, in batches, to the clients that listen to it.
+  static const std::string_view kFrameStatsStreamName;
+  static const std::string_view kFrameStatsEventKind;
 
   class Handler {
    public:
@@ -73,6 +81,13 @@ class ServiceProtocol {
   void SetHandlerDescription(Handler* handler,
                              Handler::Description description);
 
+  // Whether any client of the VM service listens to the stream of frame stats.
+  static bool IsFrameStatsStreamListened();
+
+  // Sends the JSON object to the clients that listen to the stream of frame
+  // stats. May be called on any thread.
+  static void SendFrameStatsEvent(const rapidjson::Value& event);
+
  private:
   const std::set<std::string_view> endpoints_;
   std::unique_ptr<fml::SharedMutex> handlers_mutex_;
@@ -95,6 +110,10 @@ class ServiceProtocol {
 
   [[nodiscard]] bool HandleListViewsMethod(rapidjson::Document* response) const;
 
+  static bool OnStreamListen(const char* stream_id);
+
+  static void OnStreamCancel(const char* stream_id);
+
   FML_DISALLOW_COPY_AND_ASSIGN(ServiceProtocol);
 };
 
@@ -4,12 +4,18 @@
 
 #include "flutter/runtime/skia_concurrent_executor.h"
 
+#include <string>
+#include <utility>
+
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
 
-SkiaConcurrentExecutor::SkiaConcurrentExecutor(const OnWorkCallback& on_work)
-    : on_work_(on_work) {}
+SkiaConcurrentExecutor::SkiaConcurrentExecutor(const OnWorkCallback& on_work,
+                                               size_t max_concurrent_work)
+    : on_work_(on_work),
+      max_concurrent_work_(max_concurrent_work),
+      queue_(std::make_shared<Queue>()) {}
 
 SkiaConcurrentExecutor::~SkiaConcurrentExecutor() = default;
 
@@ -17,10 +23,49 @@ void SkiaConcurrentExecutor::add(fml::closure work) {
   if (!work) {
     return;
   }
-  on_work_([work]() {
-    TRACE_EVENT0("flutter", "SkiaExecutor");
-    work();
-  });
+  PendingWork pending_work = {std::move(work), fml::TimePoint::Now()};
+  if (max_concurrent_work_ == 0) {
+    on_work_([pending_work]() { RunWork(pending_work); });
+    return;
+  }
+
+  {
+    std::scoped_lock lock(queue_->mutex);
+    queue_->pending.push_back(std::move(pending_work));
+    FML_TRACE_COUNTER("flutter", "SkiaExecutor",
+                      reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                      "Pending", queue_->pending.size(), "Running",
+                      queue_->running);
+    if (queue_->running >= max_concurrent_work_) {
+      return;
+    }
+    queue_->running++;
+  }
+  on_work_([queue = queue_]() { DrainQueue(queue); });
+}
+
+void SkiaConcurrentExecutor::DrainQueue(const std::shared_ptr<Queue>& queue) {
+  while (true) {
+    PendingWork pending_work;
+    {
+      std::scoped_lock lock(queue->mutex);
+      if (queue->pending.empty()) {
+        queue->running--;
+        return;
+      }
+      pending_work = std::move(queue->pending.front());
+      queue->pending.pop_front();
+    }
+    RunWork(pending_work);
+  }
+}
+
+void SkiaConcurrentExecutor::RunWork(const PendingWork& pending_work) {
+  TRACE_EVENT1("flutter", "SkiaExecutor", "queued_micros",
+               std::to_string((fml::TimePoint::Now() - pending_work.queued_time)
+                                  .ToMicroseconds())
+                   .c_str());
+  pending_work.work();
 }
 
 }  // namespace flutter
@@ -5,8 +5,13 @@
 #ifndef FLUTTER_RUNTIME_SKIA_CONCURRENT_EXECUTOR_H_
 #define FLUTTER_RUNTIME_SKIA_CONCURRENT_EXECUTOR_H_
 
+#include <deque>
+#include <memory>
+#include <mutex>
+
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
 #include "third_party/skia/include/core/SkExecutor.h"
 
 namespace flutter {
@@ -24,6 +29,11 @@ namespace flutter {
 ///             worker pool is held next to the process global Dart VM instance.
 ///             The Skia executor is wired up there as well.
 ///
+///             The executor may limit how many of its tasks are scheduled at
+///             once, and queue the others until one is done, so that a burst
+///             of Skia work leaves the other workers of the pool free for other
+///             tasks, such as image decodes.
+///
 class SkiaConcurrentExecutor : public SkExecutor {
  public:
   //----------------------------------------------------------------------------
@@ -35,9 +45,12 @@ class SkiaConcurrentExecutor : public SkExecutor {
   //----------------------------------------------------------------------------
   /// @brief      Create a new instance of the executor.
   ///
-  /// @param[in]  on_work  The work callback.
+  /// @param[in]  on_work              The work callback.
+  /// @param[in]  max_concurrent_work  The most tasks scheduled with the work
+  ///                                  callback at once, or zero for no limit.
   ///
-  explicit SkiaConcurrentExecutor(const OnWorkCallback& on_work);
+  explicit SkiaConcurrentExecutor(const OnWorkCallback& on_work,
+                                  size_t max_concurrent_work = 0);
 
   // |SkExecutor|
   ~SkiaConcurrentExecutor() override;
@@ -46,7 +59,29 @@ class SkiaConcurrentExecutor : public SkExecutor {
   void add(fml::closure work) override;
 
  private:
+  struct PendingWork {
+    fml::closure work;
+    fml::TimePoint queued_time;
+  };
+
+  // The queue of the limited executor, which its scheduled tasks keep alive
+  // while they run.
+  struct Queue {
+    std::mutex mutex;
+    std::deque<PendingWork> pending;
+    // The number of tasks scheduled with the work callback that still run
+    // work from |pending|.
+    size_t running = 0;
+  };
+
+  // Runs the queued work until there is none left.
+  static void DrainQueue(const std::shared_ptr<Queue>& queue);
+
+  static void RunWork(const PendingWork& pending_work);
+
   OnWorkCallback on_work_;
+  const size_t max_concurrent_work_;
+  std::shared_ptr<Queue> queue_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(SkiaConcurrentExecutor);
 };
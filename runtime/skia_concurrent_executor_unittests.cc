@@ -0,0 +1,69 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/skia_concurrent_executor.h"
+
+#include <vector>
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(SkiaConcurrentExecutorTest, RunsAllOfTheWorkWithoutALimit) {
+  std::vector<fml::closure> scheduled;
+  SkiaConcurrentExecutor executor(
+      [&scheduled](fml::closure work) { scheduled.push_back(work); });
+
+  int runs = 0;
+  for (int i = 0; i < 3; i++) {
+    executor.add([&runs]() { runs++; });
+  }
+  ASSERT_EQ(scheduled.size(), 3u);
+  for (const auto& work : scheduled) {
+    work();
+  }
+  EXPECT_EQ(runs, 3);
+}
+
+TEST(SkiaConcurrentExecutorTest, SchedulesAtMostTheLimitOfTasks) {
+  std::vector<fml::closure> scheduled;
+  SkiaConcurrentExecutor executor(
+      [&scheduled](fml::closure work) { scheduled.push_back(work); }, 2);
+
+  std::vector<int> runs;
+  for (int i = 0; i < 5; i++) {
+    executor.add([&runs, i]() { runs.push_back(i); });
+  }
+  ASSERT_EQ(scheduled.size(), 2u);
+
+  // The first task runs all of the queued work in order.
+  scheduled[0]();
+  EXPECT_EQ(runs, std::vector<int>({0, 1, 2, 3, 4}));
+  scheduled[1]();
+  EXPECT_EQ(runs.size(), 5u);
+
+  // Both tasks are done, so new work schedules a task again.
+  executor.add([&runs]() { runs.push_back(5); });
+  ASSERT_EQ(scheduled.size(), 3u);
+  scheduled[2]();
+  EXPECT_EQ(runs.size(), 6u);
+}
+
+TEST(SkiaConcurrentExecutorTest, QueuedWorkRunsAfterTheExecutorIsGone) {
+  std::vector<fml::closure> scheduled;
+  int runs = 0;
+  {
+    SkiaConcurrentExecutor executor(
+        [&scheduled](fml::closure work) { scheduled.push_back(work); }, 1);
+    executor.add([&runs]() { runs++; });
+    executor.add([&runs]() { runs++; });
+  }
+  ASSERT_EQ(scheduled.size(), 1u);
+  scheduled[0]();
+  EXPECT_EQ(runs, 2);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -19,6 +19,26 @@ namespace {
 constexpr fml::TimeDelta kNotifyIdleTaskWaitTime =
     fml::TimeDelta::FromMilliseconds(51);
 
+// The number of consecutive rasterized frames that must call for a deeper or
+// a shallower pipeline before an adaptive pipeline depth changes. Shrinking
+// the pipeline waits longer since a too shallow pipeline drops frames.
+constexpr int kGrowPipelineDepthFrameCount = 5;
+constexpr int kShrinkPipelineDepthFrameCount = 60;
+
+uint32_t GetDefaultPipelineDepth(const TaskRunners& task_runners) {
+#if SHELL_ENABLE_METAL
+  return 2;
+#else   // SHELL_ENABLE_METAL
+  // TODO(dnfield): We should remove this logic and set the pipeline depth
+  // back to 2 in this case. See
+  // https://github.com/flutter/engine/pull/9132 for discussion.
+  return task_runners.GetPlatformTaskRunner() ==
+                 task_runners.GetRasterTaskRunner()
+             ? 1
+             : 2;
+#endif  // SHELL_ENABLE_METAL
+}
+
 }  // namespace
 
 Animator::Animator(Delegate& delegate,
@@ -27,24 +47,73 @@ Animator::Animator(Delegate& delegate,
     : delegate_(delegate),
       task_runners_(std::move(task_runners)),
       waiter_(std::move(waiter)),
-#if SHELL_ENABLE_METAL
-      layer_tree_pipeline_(std::make_shared<LayerTreePipeline>(2)),
-#else   // SHELL_ENABLE_METAL
-      // TODO(dnfield): We should remove this logic and set the pipeline depth
-      // back to 2 in this case. See
-      // https://github.com/flutter/engine/pull/9132 for discussion.
-      layer_tree_pipeline_(std::make_shared<LayerTreePipeline>(
-          task_runners.GetPlatformTaskRunner() ==
-                  task_runners.GetRasterTaskRunner()
-              ? 1
-              : 2)),
-#endif  // SHELL_ENABLE_METAL
+      layer_tree_pipeline_(
+          std::make_shared<LayerTreePipeline>(kMaxLayerTreePipelineDepth)),
       pending_frame_semaphore_(1),
       weak_factory_(this) {
+  layer_tree_pipeline_->SetDepth(GetDefaultPipelineDepth(task_runners_));
 }
 
 Animator::~Animator() = default;
 
+void Animator::EnableAdaptivePipelineDepth() {
+  adaptive_pipeline_depth_ = true;
+}
+
+void Animator::UseDeepestPipelineDepth() {
+  adaptive_pipeline_depth_ = false;
+  layer_tree_pipeline_->SetDepth(kMaxLayerTreePipelineDepth);
+}
+
+void Animator::EnablePredictiveFrameScheduling() {
+  frame_scheduler_ = std::make_unique<FrameScheduler>();
+}
+
+uint32_t Animator::GetLayerTreePipelineDepth() const {
+  return layer_tree_pipeline_->GetDepth();
+}
+
+int Animator::GetLayerTreePipelineInflightCount() const {
+  return layer_tree_pipeline_->GetInflightCount();
+}
+
+void Animator::OnFrameRasterized(const FrameTiming& timing) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  if (frame_scheduler_) {
+    frame_scheduler_->AddFrameTiming(timing, frame_interval_);
+  }
+  if (!adaptive_pipeline_depth_) {
+    return;
+  }
+  fml::TimeDelta build_duration = timing.Get(FrameTiming::kBuildFinish) -
+                                  timing.Get(FrameTiming::kBuildStart);
+  fml::TimeDelta raster_duration = timing.Get(FrameTiming::kRasterFinish) -
+                                   timing.Get(FrameTiming::kRasterStart);
+  uint32_t depth = 2;
+  if (raster_duration > frame_interval_) {
+    depth = kMaxLayerTreePipelineDepth;
+  } else if ((build_duration + raster_duration) * 2 < frame_interval_) {
+    // The next frame is built after this one is rasterized and still makes
+    // its vsync.
+    depth = 1;
+  }
+
+  if (depth != adaptive_depth_) {
+    adaptive_depth_ = depth;
+    adaptive_depth_frame_count_ = 0;
+  }
+  adaptive_depth_frame_count_++;
+  uint32_t current_depth = layer_tree_pipeline_->GetDepth();
+  int needed_frame_count = depth > current_depth
+                               ? kGrowPipelineDepthFrameCount
+                               : kShrinkPipelineDepthFrameCount;
+  if (depth != current_depth &&
+      adaptive_depth_frame_count_ >= needed_frame_count) {
+    TRACE_EVENT0("flutter", "Animator::AdaptPipelineDepth");
+    layer_tree_pipeline_->SetDepth(depth);
+  }
+}
+
 void Animator::EnqueueTraceFlowId(uint64_t trace_flow_id) {
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetUITaskRunner(),
@@ -81,6 +150,11 @@ void Animator::BeginFrame(
 
   frame_timings_recorder_ = std::move(frame_timings_recorder);
   frame_timings_recorder_->RecordBuildStart(fml::TimePoint::Now());
+  if (frame_timings_recorder_->GetVsyncTargetTime() >
+      frame_timings_recorder_->GetVsyncStartTime()) {
+    frame_interval_ = frame_timings_recorder_->GetVsyncTargetTime() -
+                      frame_timings_recorder_->GetVsyncStartTime();
+  }
 
   TRACE_EVENT_WITH_FRAME_NUMBER(frame_timings_recorder_, "flutter",
                                 "Animator::BeginFrame");
@@ -136,7 +210,7 @@ void Animator::BeginFrame(
     // viewport event).  Because of this, we hold off on calling
     // |OnAnimatorNotifyIdle| for a little bit, as that could cause garbage
     // collection to trigger at a highly undesirable time.
-    task_runners_.GetUITaskRunner()->PostDelayedTask(
+    task_runners_.GetUITaskRunner()->PostDelayedTaskWithPriority(
         [self = weak_factory_.GetWeakPtr(),
          notify_idle_task_id = notify_idle_task_id_]() {
           if (!self) {
@@ -149,12 +223,13 @@ void Animator::BeginFrame(
           if (notify_idle_task_id == self->notify_idle_task_id_ &&
               !self->frame_scheduled_) {
             TRACE_EVENT0("flutter", "BeginFrame idle callback");
+            self->delegate_.OnAnimatorIdle();
             self->delegate_.OnAnimatorNotifyIdle(
                 FxlToDartOrEarlier(fml::TimePoint::Now() +
                                    fml::TimeDelta::FromMicroseconds(100000)));
           }
         },
-        kNotifyIdleTaskWaitTime);
+        kNotifyIdleTaskWaitTime, fml::TaskPriority::kIdle);
   }
 }
 
@@ -243,6 +318,8 @@ void Animator::AwaitVSync() {
         if (self) {
           if (self->CanReuseLastLayerTree()) {
             self->DrawLastLayerTree(std::move(frame_timings_recorder));
+          } else if (self->frame_scheduler_) {
+            self->BeginFrameLate(std::move(frame_timings_recorder));
           } else {
             self->BeginFrame(std::move(frame_timings_recorder));
           }
@@ -253,6 +330,29 @@ void Animator::AwaitVSync() {
   }
 }
 
+void Animator::BeginFrameLate(
+    std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
+  fml::TimePoint frame_start_time = frame_timings_recorder->GetVsyncStartTime();
+  fml::TimeDelta delay = frame_scheduler_->GetBuildDelay(
+      frame_start_time, frame_timings_recorder->GetVsyncTargetTime());
+  FML_TRACE_COUNTER("flutter", "Animator Build Delay",
+                    reinterpret_cast<int64_t>(this),  //
+                    "micros", delay.ToMicroseconds()  //
+  );
+  if (delay <= fml::TimeDelta::Zero()) {
+    BeginFrame(std::move(frame_timings_recorder));
+    return;
+  }
+  task_runners_.GetUITaskRunner()->PostTaskForTimeWithPriority(
+      [self = weak_factory_.GetWeakPtr(),
+       recorder = std::move(frame_timings_recorder)]() mutable {
+        if (self) {
+          self->BeginFrame(std::move(recorder));
+        }
+      },
+      frame_start_time + delay, fml::TaskPriority::kFrame);
+}
+
 void Animator::ScheduleSecondaryVsyncCallback(uintptr_t id,
                                               const fml::closure& callback) {
   waiter_->ScheduleSecondaryCallback(id, callback);
@@ -13,6 +13,7 @@
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/frame_scheduler.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/vsync_waiter.h"
@@ -36,6 +37,10 @@ class Animator final {
 
     virtual void OnAnimatorNotifyIdle(fml::TimePoint deadline) = 0;
 
+    // Called once no frame has been produced for |kNotifyIdleTaskWaitTime|
+    // since the last one, that is when the animations have stopped.
+    virtual void OnAnimatorIdle() = 0;
+
     virtual void OnAnimatorDraw(
         std::shared_ptr<Pipeline<flutter::LayerTree>> pipeline,
         std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) = 0;
@@ -74,6 +79,48 @@ class Animator final {
   void ScheduleSecondaryVsyncCallback(uintptr_t id,
                                       const fml::closure& callback);
 
+  //--------------------------------------------------------------------------
+  /// @brief    Adapts the depth of the layer tree pipeline to the timings of
+  ///           the rasterized frames, as reported to `OnFrameRasterized`.
+  ///
+  ///           The depth grows to `kMaxLayerTreePipelineDepth` while the
+  ///           frames take longer than a vsync interval to rasterize, so that
+  ///           the UI thread builds the next frames in the meanwhile, and
+  ///           shrinks to 1 while the frames are built and rasterized in less
+  ///           than half an interval, which saves the input latency of the
+  ///           frame waiting in the pipeline. Otherwise the depth is 2.
+  void EnableAdaptivePipelineDepth();
+
+  //--------------------------------------------------------------------------
+  /// @brief    Lets the layer tree pipeline hold `kMaxLayerTreePipelineDepth`
+  ///           layer trees, so that the UI thread keeps building frames
+  ///           while the raster thread rasterizes the earlier ones. This
+  ///           trades the latency of the frames for their throughput.
+  void UseDeepestPipelineDepth();
+
+  //--------------------------------------------------------------------------
+  /// @brief    Delays building each frame after its vsync for as long as the
+  ///           `FrameScheduler` predicts that the frame can still be built
+  ///           and rasterized by its target time, from the timings reported
+  ///           to `OnFrameRasterized`.
+  void EnablePredictiveFrameScheduling();
+
+  //--------------------------------------------------------------------------
+  /// @brief    Called on the UI thread with the timing of every rasterized
+  ///           frame once `EnableAdaptivePipelineDepth` or
+  ///           `EnablePredictiveFrameScheduling` has been called.
+  void OnFrameRasterized(const FrameTiming& timing);
+
+  //--------------------------------------------------------------------------
+  /// @brief    The number of layer trees that the layer tree pipeline may
+  ///           hold at once, which changes with the frames once
+  ///           `EnableAdaptivePipelineDepth` has been called.
+  uint32_t GetLayerTreePipelineDepth() const;
+
+  //--------------------------------------------------------------------------
+  /// @brief    The number of layer trees built but not rasterized yet.
+  int GetLayerTreePipelineInflightCount() const;
+
   // Enqueue |trace_flow_id| into |trace_flow_ids_|.  The flow event will be
   // ended at either the next frame, or the next vsync interval with no active
   // active rendering.
@@ -82,8 +129,15 @@ class Animator final {
  private:
   using LayerTreePipeline = Pipeline<flutter::LayerTree>;
 
+  // The deepest that the layer tree pipeline gets with an adaptive depth.
+  static constexpr uint32_t kMaxLayerTreePipelineDepth = 3;
+
   void BeginFrame(std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
 
+  // Begins the frame once the |frame_scheduler_| says it is late enough.
+  void BeginFrameLate(
+      std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
+
   bool CanReuseLastLayerTree();
 
   void DrawLastLayerTree(
@@ -112,6 +166,13 @@ class Animator final {
   SkISize last_layer_tree_size_ = {0, 0};
   std::deque<uint64_t> trace_flow_ids_;
   bool has_rendered_ = false;
+  bool adaptive_pipeline_depth_ = false;
+  std::unique_ptr<FrameScheduler> frame_scheduler_;
+  fml::TimeDelta frame_interval_ = fml::TimeDelta::FromSecondsF(1.0 / 60.0);
+  // The depth that the timings of the last |adaptive_depth_frame_count_|
+  // rasterized frames called for.
+  uint32_t adaptive_depth_ = 0;
+  int adaptive_depth_frame_count_ = 0;
 
   fml::WeakPtrFactory<Animator> weak_factory_;
 
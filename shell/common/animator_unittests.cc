@@ -12,6 +12,7 @@
 
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/shell_test_platform_view.h"
+#include "flutter/shell/common/vsync_waiter_immediate.h"
 #include "flutter/testing/testing.h"
 #include "gtest/gtest.h"
 
@@ -30,6 +31,8 @@ class FakeAnimatorDelegate : public Animator::Delegate {
     notify_idle_called_ = true;
   }
 
+  void OnAnimatorIdle() override { idle_called_ = true; }
+
   void OnAnimatorDraw(
       std::shared_ptr<Pipeline<flutter::LayerTree>> pipeline,
       std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) override {}
@@ -38,6 +41,7 @@ class FakeAnimatorDelegate : public Animator::Delegate {
       std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) override {}
 
   bool notify_idle_called_ = false;
+  bool idle_called_ = false;
 };
 
 TEST_F(ShellTest, VSyncTargetTime) {
@@ -164,6 +168,7 @@ TEST_F(ShellTest, AnimatorDoesNotNotifyIdleBeforeRender) {
   // Still hasn't notified idle because there has been no frame request.
   task_runners.GetUITaskRunner()->PostTask([&] {
     ASSERT_FALSE(delegate.notify_idle_called_);
+    ASSERT_FALSE(delegate.idle_called_);
     // False to avoid getting cals to BeginFrame that will request more frames
     // before we are ready.
     animator->RequestFrame(false);
@@ -174,6 +179,16 @@ TEST_F(ShellTest, AnimatorDoesNotNotifyIdleBeforeRender) {
   // Now it should notify idle. Make sure it is destroyed on the UI thread.
   ASSERT_TRUE(delegate.notify_idle_called_);
 
+  // Without more frames, it reports that it is idle as well.
+  task_runners.GetUITaskRunner()->PostDelayedTask(
+      [&] {
+        EXPECT_TRUE(delegate.idle_called_);
+        latch.Signal();
+      },
+      // See kNotifyIdleTaskWaitTime in animator.cc.
+      fml::TimeDelta::FromMilliseconds(60));
+  latch.Wait();
+
   task_runners.GetPlatformTaskRunner()->PostTask(flush_vsync_task);
   latch.Wait();
 
@@ -184,6 +199,100 @@ TEST_F(ShellTest, AnimatorDoesNotNotifyIdleBeforeRender) {
   latch.Wait();
 }
 
+TEST_F(ShellTest, AnimatorAdaptsPipelineDepthToFrameTimings) {
+  FakeAnimatorDelegate delegate;
+  TaskRunners task_runners = {
+      "test",
+      CreateNewThread(),  // platform
+      CreateNewThread(),  // raster
+      CreateNewThread(),  // ui
+      CreateNewThread()   // io
+  };
+  auto clock = std::make_shared<ShellTestVsyncClock>();
+
+  // Frames at 60Hz that take |build| and |raster| milliseconds.
+  auto make_timing = [](int64_t build, int64_t raster) {
+    FrameTiming timing;
+    fml::TimePoint start = fml::TimePoint::Now();
+    timing.Set(FrameTiming::kBuildStart, start);
+    timing.Set(FrameTiming::kBuildFinish,
+               start + fml::TimeDelta::FromMilliseconds(build));
+    timing.Set(FrameTiming::kRasterStart,
+               start + fml::TimeDelta::FromMilliseconds(build));
+    timing.Set(FrameTiming::kRasterFinish,
+               start + fml::TimeDelta::FromMilliseconds(build + raster));
+    return timing;
+  };
+
+  fml::AutoResetWaitableEvent latch;
+  task_runners.GetUITaskRunner()->PostTask([&] {
+    auto vsync_waiter = static_cast<std::unique_ptr<VsyncWaiter>>(
+        std::make_unique<ShellTestVsyncWaiter>(task_runners, clock));
+    auto animator = std::make_unique<Animator>(delegate, task_runners,
+                                               std::move(vsync_waiter));
+    animator->EnableAdaptivePipelineDepth();
+    EXPECT_EQ(GetLayerTreePipelineDepth(animator.get()), 2u);
+
+    // A single slow frame does not change the depth.
+    animator->OnFrameRasterized(make_timing(2, 30));
+    animator->OnFrameRasterized(make_timing(2, 10));
+    EXPECT_EQ(GetLayerTreePipelineDepth(animator.get()), 2u);
+
+    for (int i = 0; i < 5; i++) {
+      animator->OnFrameRasterized(make_timing(2, 30));
+    }
+    EXPECT_EQ(GetLayerTreePipelineDepth(animator.get()), 3u);
+
+    for (int i = 0; i < 60; i++) {
+      animator->OnFrameRasterized(make_timing(1, 2));
+    }
+    EXPECT_EQ(GetLayerTreePipelineDepth(animator.get()), 1u);
+
+    for (int i = 0; i < 5; i++) {
+      animator->OnFrameRasterized(make_timing(6, 6));
+    }
+    EXPECT_EQ(GetLayerTreePipelineDepth(animator.get()), 2u);
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+TEST_F(ShellTest, AnimatorKeepsTheDeepestPipelineDepth) {
+  FakeAnimatorDelegate delegate;
+  TaskRunners task_runners = {
+      "test",
+      CreateNewThread(),  // platform
+      CreateNewThread(),  // raster
+      CreateNewThread(),  // ui
+      CreateNewThread()   // io
+  };
+
+  fml::AutoResetWaitableEvent latch;
+  task_runners.GetUITaskRunner()->PostTask([&] {
+    auto vsync_waiter = static_cast<std::unique_ptr<VsyncWaiter>>(
+        std::make_unique<VsyncWaiterImmediate>(task_runners));
+    auto animator = std::make_unique<Animator>(delegate, task_runners,
+                                               std::move(vsync_waiter));
+    animator->EnableAdaptivePipelineDepth();
+    animator->UseDeepestPipelineDepth();
+    EXPECT_EQ(GetLayerTreePipelineDepth(animator.get()), 3u);
+
+    // Fast frames do not make the pipeline shallower.
+    FrameTiming timing;
+    fml::TimePoint start = fml::TimePoint::Now();
+    timing.Set(FrameTiming::kBuildStart, start);
+    timing.Set(FrameTiming::kBuildFinish, start);
+    timing.Set(FrameTiming::kRasterStart, start);
+    timing.Set(FrameTiming::kRasterFinish, start);
+    for (int i = 0; i < 60; i++) {
+      animator->OnFrameRasterized(timing);
+    }
+    EXPECT_EQ(GetLayerTreePipelineDepth(animator.get()), 3u);
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -4,14 +4,18 @@
 
 #include "flutter/shell/common/engine.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/common/settings.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/string_conversion.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/snapshot/snapshot.h"
 #include "flutter/lib/ui/text/font_collection.h"
@@ -20,6 +24,8 @@
 #include "flutter/shell/common/shell.h"
 #include "rapidjson/document.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "txt/paragraph_builder.h"
 
 namespace flutter {
 
@@ -30,6 +36,12 @@ static constexpr char kLocalizationChannel[] = "flutter/localization";
 static constexpr char kSettingsChannel[] = "flutter/settings";
 static constexpr char kIsolateChannel[] = "flutter/isolate";
 
+// The asset that declares the text whose glyphs are drawn before the first
+// frame, in the form
+// {"glyphs": [{"fontFamily": "Roboto", "fontSize": 24, "fontWeight": 700,
+//              "text": "Welcome"}]}.
+static constexpr char kGlyphWarmUpAssetName[] = "io.flutter.glyphs.json";
+
 namespace {
 fml::MallocMapping MakeMapping(const std::string& str) {
   return fml::MallocMapping::Copy(str.c_str(), str.length());
@@ -51,10 +63,29 @@ Engine::Engine(
       animator_(std::move(animator)),
       runtime_controller_(std::move(runtime_controller)),
       font_collection_(font_collection),
-      image_decoder_(task_runners, image_decoder_task_runner, io_manager),
+      image_decoder_(task_runners,
+                     image_decoder_task_runner,
+                     io_manager,
+                     settings_.decode_images_to_yuv_planes,
+                     settings_.resize_images_on_gpu),
       task_runners_(std::move(task_runners)),
       weak_factory_(this) {
   pointer_data_dispatcher_ = dispatcher_maker(*this);
+  image_decoder_.SetAnimatedImageFrameBudget(
+      settings_.animated_image_prefetch_frame_count,
+      settings_.animated_image_frame_cache_max_bytes);
+  if (settings_.text_layout_cache_max_bytes > 0) {
+    txt::FontCollection::SetLayoutCacheMaxBytes(
+        settings_.text_layout_cache_max_bytes);
+  }
+  if (settings_.enable_persistent_font_fallback_cache) {
+    idle_task_scheduler_.AddTask("StoreFontFallbackMatches",
+                                 [this](fml::TimePoint) {
+                                   if (!shares_font_collection_) {
+                                     StoreFontFallbackMatches();
+                                   }
+                                 });
+  }
 }
 
 Engine::Engine(Delegate& delegate,
@@ -130,6 +161,10 @@ std::unique_ptr<Engine> Engine::Spawn(
       result->GetImageDecoderWeakPtr()      // imageDecoder
   );
   result->initial_route_ = initial_route;
+  result->shares_font_collection_ = true;
+  // The platform only installs its image decoders on the engine it launched.
+  result->image_generator_registry_.CopyFactoriesFrom(
+      image_generator_registry_);
   return result;
 }
 
@@ -142,6 +177,68 @@ fml::WeakPtr<Engine> Engine::GetWeakPtr() const {
 void Engine::SetupDefaultFontManager() {
   TRACE_EVENT0("flutter", "Engine::SetupDefaultFontManager");
   font_collection_->SetupDefaultFontManager(settings_.font_initialization_data);
+  if (settings_.enable_persistent_font_fallback_cache) {
+    LoadFontFallbackMatches();
+  }
+}
+
+void Engine::LoadFontFallbackMatches() {
+  // The matches are stored on the IO task runner too, so they are read before
+  // this run overwrites them.
+  task_runners_.GetIOTaskRunner()->PostTask(
+      [engine = GetWeakPtr(),
+       ui_task_runner = task_runners_.GetUITaskRunner()]() {
+        auto mapping =
+            PersistentCache::GetCacheForProcess()->LoadFontFallbackMatches();
+        if (!mapping) {
+          return;
+        }
+        std::string data(reinterpret_cast<const char*>(mapping->GetMapping()),
+                         mapping->GetSize());
+        ui_task_runner->PostTask(
+            fml::MakeCopyable([engine, data = std::move(data)]() {
+              if (!engine) {
+                return;
+              }
+              auto collection = engine->font_collection_->GetFontCollection();
+              if (collection->DecodeFallbackFontMatches(data)) {
+                engine->stored_fallback_font_match_count_ =
+                    collection->GetFallbackFontMatchCount();
+              }
+            }));
+      });
+}
+
+void Engine::StoreFontFallbackMatches() {
+  auto collection = font_collection_->GetFontCollection();
+  size_t count = collection->GetFallbackFontMatchCount();
+  if (count == stored_fallback_font_match_count_) {
+    return;
+  }
+  stored_fallback_font_match_count_ = count;
+  PersistentCache::GetCacheForProcess()->StoreFontFallbackMatches(
+      collection->EncodeFallbackFontMatches());
+}
+
+void Engine::PrefetchStartupAssets() {
+  startup_asset_manager_ = asset_manager_;
+  startup_asset_manager_->StartRecordingAssets();
+  // The prefetches also find which resolver has each asset, so the reads of
+  // the root isolate do not probe the others.
+  task_runners_.GetIOTaskRunner()->PostTask(
+      [asset_manager = asset_manager_]() {
+        TRACE_EVENT0("flutter", "Engine::PrefetchStartupAssets");
+        for (const auto& asset_name :
+             PersistentCache::GetCacheForProcess()->LoadStartupAssets()) {
+          asset_manager->Prefetch(asset_name);
+        }
+      });
+}
+
+void Engine::StoreStartupAssets() {
+  auto asset_manager = std::move(startup_asset_manager_);
+  PersistentCache::GetCacheForProcess()->StoreStartupAssets(
+      asset_manager->StopRecordingAssets());
 }
 
 std::shared_ptr<AssetManager> Engine::GetAssetManager() {
@@ -175,9 +272,107 @@ bool Engine::UpdateAssetManager(
     font_collection_->RegisterTestFonts();
   }
 
+  glyph_warm_up_pending_ = true;
+  WarmUpGlyphs();
+
   return true;
 }
 
+void Engine::WarmUpGlyphs() {
+  if (!glyph_warm_up_pending_ || !asset_manager_) {
+    return;
+  }
+  const ViewportMetrics& metrics =
+      runtime_controller_->GetPlatformData().viewport_metrics;
+  if (metrics.physical_width <= 0 || metrics.device_pixel_ratio <= 0) {
+    return;
+  }
+  glyph_warm_up_pending_ = false;
+
+  std::unique_ptr<fml::Mapping> mapping =
+      asset_manager_->GetAsMapping(kGlyphWarmUpAssetName);
+  if (!mapping) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "Engine::WarmUpGlyphs");
+  rapidjson::Document document;
+  document.Parse(reinterpret_cast<const char*>(mapping->GetMapping()),
+                 mapping->GetSize());
+  if (document.HasParseError() || !document.IsObject()) {
+    FML_LOG(ERROR) << "Could not parse " << kGlyphWarmUpAssetName;
+    return;
+  }
+  auto glyphs = document.FindMember("glyphs");
+  if (glyphs == document.MemberEnd() || !glyphs->value.IsArray()) {
+    return;
+  }
+
+  // The same backend as the paragraphs of the frames, which share its cache.
+  typedef std::unique_ptr<txt::ParagraphBuilder> (*ParagraphBuilderFactory)(
+      const txt::ParagraphStyle& style,
+      std::shared_ptr<txt::FontCollection> font_collection);
+  ParagraphBuilderFactory factory = txt::ParagraphBuilder::CreateTxtBuilder;
+#if FLUTTER_ENABLE_SKSHAPER
+#if FLUTTER_ALWAYS_USE_SKSHAPER
+  bool enable_skparagraph = true;
+#else
+  bool enable_skparagraph = settings_.enable_skparagraph;
+#endif
+  if (enable_skparagraph) {
+    factory = txt::ParagraphBuilder::CreateSkiaBuilder;
+  }
+#endif  // FLUTTER_ENABLE_SKSHAPER
+
+  // The text is drawn at the scale of the frames, since the atlas holds the
+  // glyphs of each size in device pixels.
+  const double pixel_ratio = metrics.device_pixel_ratio;
+  const double width = metrics.physical_width / pixel_ratio;
+  auto font_collection = font_collection_->GetFontCollection();
+  std::vector<sk_sp<SkPicture>> pictures;
+  for (const auto& entry : glyphs->value.GetArray()) {
+    if (!entry.IsObject()) {
+      continue;
+    }
+    auto text = entry.FindMember("text");
+    if (text == entry.MemberEnd() || !text->value.IsString()) {
+      continue;
+    }
+    txt::TextStyle style;
+    auto family = entry.FindMember("fontFamily");
+    if (family != entry.MemberEnd() && family->value.IsString()) {
+      style.font_families = {family->value.GetString()};
+    }
+    auto size = entry.FindMember("fontSize");
+    if (size != entry.MemberEnd() && size->value.IsNumber()) {
+      style.font_size = size->value.GetDouble();
+    }
+    auto weight = entry.FindMember("fontWeight");
+    if (weight != entry.MemberEnd() && weight->value.IsInt()) {
+      style.font_weight = static_cast<txt::FontWeight>(
+          std::clamp(weight->value.GetInt() / 100 - 1, 0, 8));
+    }
+
+    auto builder = factory(txt::ParagraphStyle(), font_collection);
+    builder->PushStyle(style);
+    builder->AddText(fml::Utf8ToUtf16(text->value.GetString()));
+    builder->Pop();
+    auto paragraph = builder->Build();
+    paragraph->Layout(width);
+
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(
+        metrics.physical_width,
+        std::ceil(paragraph->GetHeight() * pixel_ratio)));
+    canvas->scale(pixel_ratio, pixel_ratio);
+    paragraph->Paint(canvas, 0, 0);
+    pictures.push_back(recorder.finishRecordingAsPicture());
+  }
+
+  if (!pictures.empty()) {
+    delegate_.OnEngineWarmUpGlyphs(std::move(pictures));
+  }
+}
+
 bool Engine::Restart(RunConfiguration configuration) {
   TRACE_EVENT0("flutter", "Engine::Restart");
   if (!configuration.IsValid()) {
@@ -209,11 +404,15 @@ Engine::RunStatus Engine::Run(RunConfiguration configuration) {
     return RunStatus::FailureAlreadyRunning;
   }
 
+  if (settings_.enable_startup_asset_prefetch) {
+    PrefetchStartupAssets();
+  }
+
   // If the embedding prefetched the default font manager, then set up the
   // font manager later in the engine launch process.  This makes it less
   // likely that the setup will need to wait for the prefetch to complete.
   auto root_isolate_create_callback = [&]() {
-    if (settings_.prefetched_default_font_manager) {
+    if (settings_.prefetched_default_font_manager && !shares_font_collection_) {
       SetupDefaultFontManager();
     }
   };
@@ -256,6 +455,7 @@ void Engine::NotifyIdle(fml::TimePoint deadline) {
   TRACE_EVENT1("flutter", "Engine::NotifyIdle", "deadline_now_delta",
                trace_event.c_str());
   runtime_controller_->NotifyIdle(deadline);
+  idle_task_scheduler_.RunTasks(deadline);
 }
 
 std::optional<uint32_t> Engine::GetUIIsolateReturnCode() {
@@ -280,6 +480,7 @@ tonic::DartErrorHandleType Engine::GetUIIsolateLastError() {
 
 void Engine::SetViewportMetrics(const ViewportMetrics& metrics) {
   runtime_controller_->SetViewportMetrics(metrics);
+  WarmUpGlyphs();
   ScheduleFrame();
 }
 
@@ -311,6 +512,43 @@ void Engine::DispatchPlatformMessage(std::unique_ptr<PlatformMessage> message) {
   FML_DLOG(WARNING) << "Dropping platform message on channel: " << channel;
 }
 
+void Engine::DispatchPlatformMessages(
+    std::vector<std::unique_ptr<PlatformMessage>> messages) {
+  TRACE_EVENT1("flutter", "Engine::DispatchPlatformMessages", "count",
+               std::to_string(messages.size()).c_str());
+  if (!runtime_controller_->IsRootIsolateRunning()) {
+    for (auto& message : messages) {
+      DispatchPlatformMessage(std::move(message));
+    }
+    return;
+  }
+
+  std::vector<std::unique_ptr<PlatformMessage>> batch;
+  auto dispatch_batch = [this, &batch]() {
+    if (batch.empty()) {
+      return;
+    }
+    const size_t count = batch.size();
+    if (!runtime_controller_->DispatchPlatformMessages(std::move(batch))) {
+      FML_DLOG(WARNING) << "Dropping " << count << " platform messages.";
+    }
+    batch.clear();
+  };
+  for (auto& message : messages) {
+    const std::string& channel = message->channel();
+    if (channel == kLifecycleChannel || channel == kLocalizationChannel ||
+        channel == kSettingsChannel) {
+      // The engine handles these messages itself, after the messages that
+      // were sent before them.
+      dispatch_batch();
+      DispatchPlatformMessage(std::move(message));
+    } else {
+      batch.push_back(std::move(message));
+    }
+  }
+  dispatch_batch();
+}
+
 bool Engine::HandleLifecyclePlatformMessage(PlatformMessage* message) {
   const auto& data = message->data();
   std::string state(reinterpret_cast<const char*>(data.GetMapping()),
@@ -433,6 +671,10 @@ void Engine::ScheduleFrame(bool regenerate_layer_tree) {
   animator_->RequestFrame(regenerate_layer_tree);
 }
 
+void Engine::OnFrameRasterized(const FrameTiming& timing) {
+  animator_->OnFrameRasterized(timing);
+}
+
 void Engine::Render(std::unique_ptr<flutter::LayerTree> layer_tree) {
   if (!layer_tree) {
     return;
@@ -444,6 +686,16 @@ void Engine::Render(std::unique_ptr<flutter::LayerTree> layer_tree) {
     return;
   }
 
+  if (settings_.enable_display_list_prewarm) {
+    if (DartVM* vm = runtime_controller_->GetDartVM()) {
+      layer_tree->PrewarmDisplayLists(vm->GetConcurrentWorkerTaskRunner());
+    }
+  }
+
+  if (startup_asset_manager_) {
+    StoreStartupAssets();
+  }
+
   animator_->Render(std::move(layer_tree));
 }
 
@@ -486,7 +738,7 @@ void Engine::DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
                               uint64_t trace_flow_id) {
   animator_->EnqueueTraceFlowId(trace_flow_id);
   if (runtime_controller_) {
-    runtime_controller_->DispatchPointerDataPacket(*packet);
+    runtime_controller_->DispatchPointerDataPacket(std::move(packet));
   }
 }
 
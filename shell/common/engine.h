@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "flutter/assets/asset_manager.h"
 #include "flutter/common/task_runners.h"
@@ -27,6 +28,7 @@
 #include "flutter/runtime/runtime_delegate.h"
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/display_manager.h"
+#include "flutter/shell/common/idle_task_scheduler.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 #include "flutter/shell/common/rasterizer.h"
@@ -288,6 +290,18 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
     ///             This method is primarily provided to allow tests to control
     ///             Any methods that rely on advancing the clock.
     virtual fml::TimePoint GetCurrentTimePoint() = 0;
+
+    //--------------------------------------------------------------------------
+    /// @brief      Invoked when the engine has recorded the text declared in
+    ///             the glyph warm-up asset of the bundle. The pictures should
+    ///             be drawn offscreen with the context that draws the frames,
+    ///             so that the glyphs are in its glyph atlas before the first
+    ///             frame that shows them.
+    ///
+    /// @param[in]  pictures  The pictures of the text to warm up.
+    ///
+    virtual void OnEngineWarmUpGlyphs(
+        std::vector<sk_sp<SkPicture>> pictures) = 0;
   };
 
   //----------------------------------------------------------------------------
@@ -438,6 +452,13 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   void SetupDefaultFontManager();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the font collection of this engine is the one of the
+  ///             engine that it was spawned from, whose default font manager
+  ///             is then already set up and need not be set up again.
+  ///
+  bool SharesFontCollection() const { return shares_font_collection_; }
+
   //----------------------------------------------------------------------------
   /// @brief      Updates the asset manager referenced by the root isolate of a
   ///             Flutter application. This happens implicitly in the call to
@@ -539,6 +560,8 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///             collection, just gives the Dart VM more hints about opportune
   ///             moments to perform collections.
   ///
+  ///             The tasks of the `IdleTaskScheduler` of the engine run after
+  ///             the VM is notified, under the same deadline.
   ///
   /// @param[in]  deadline  The deadline is used by the VM to determine if the
   ///                       corresponding sweep can be performed within the
@@ -680,6 +703,18 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   void DispatchPlatformMessage(std::unique_ptr<PlatformMessage> message);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the engine that the embedder has sent it messages,
+  ///             which are delivered to the Dart application in a single call
+  ///             where possible. The messages that the engine handles itself
+  ///             are handled in their order among the others.
+  ///
+  /// @param[in]  messages  The messages sent from the embedder to the Dart
+  ///                       application, in the order they were sent.
+  ///
+  void DispatchPlatformMessages(
+      std::vector<std::unique_ptr<PlatformMessage>> messages);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the engine that the embedder has sent it a pointer
   ///             data packet. A pointer data packet may contain multiple
@@ -751,11 +786,25 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   /// tree.
   void ScheduleFrame() { ScheduleFrame(true); }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the animator of the timing of a rasterized frame, for
+  ///             the adaptive depth of its layer tree pipeline and its
+  ///             predictive frame scheduling.
+  ///
+  /// @see        `Animator::EnableAdaptivePipelineDepth`
+  /// @see        `Animator::EnablePredictiveFrameScheduling`
+  ///
+  /// @param[in]  timing  The timing of the rasterized frame.
+  ///
+  void OnFrameRasterized(const FrameTiming& timing);
+
   // |RuntimeDelegate|
   FontCollection& GetFontCollection() override;
 
+  // |RuntimeDelegate|
+  //
   // Return the asset manager associated with the current engine, or nullptr.
-  std::shared_ptr<AssetManager> GetAssetManager();
+  std::shared_ptr<AssetManager> GetAssetManager() override;
 
   // Return the weak_ptr of ImageDecoder.
   fml::WeakPtr<ImageDecoder> GetImageDecoderWeakPtr();
@@ -768,6 +817,14 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   fml::WeakPtr<ImageGeneratorRegistry> GetImageGeneratorRegistry();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the scheduler of the deferrable work that runs on the UI
+  ///             task runner after each `NotifyIdle`, within its deadline.
+  ///
+  /// @return     The engine's `IdleTaskScheduler`.
+  ///
+  IdleTaskScheduler& GetIdleTaskScheduler() { return idle_task_scheduler_; }
+
   // |PointerDataDispatcher::Delegate|
   void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
                         uint64_t trace_flow_id) override;
@@ -870,6 +927,11 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
     return runtime_controller_.get();
   }
 
+  //--------------------------------------------------------------------------
+  /// @brief      Accessor for the Animator.
+  ///
+  const Animator& GetAnimator() const { return *animator_; }
+
   const VsyncWaiter& GetVsyncWaiter() const;
 
  private:
@@ -913,8 +975,28 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
 
   void HandleAssetPlatformMessage(std::unique_ptr<PlatformMessage> message);
 
+  // Records the text of the glyph warm-up asset once the viewport metrics are
+  // known and hands the pictures to the delegate.
+  void WarmUpGlyphs();
+
   bool GetAssetAsBuffer(const std::string& name, std::vector<uint8_t>* data);
 
+  // Loads the font fallback matches of the previous runs from the persistent
+  // cache off the UI thread, and hands them to the font collection.
+  void LoadFontFallbackMatches();
+
+  // Saves the font fallback matches in the persistent cache if the font
+  // collection matched some more since they were last saved or loaded.
+  void StoreFontFallbackMatches();
+
+  // Reads ahead the assets that the previous runs read before their first
+  // frame on the IO thread, and starts to record the ones this run reads.
+  void PrefetchStartupAssets();
+
+  // Saves the names of the assets that were read before the first frame in
+  // the persistent cache.
+  void StoreStartupAssets();
+
   friend class testing::ShellTest;
 
   Engine::Delegate& delegate_;
@@ -932,9 +1014,18 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   std::vector<std::string> last_entry_point_args_;
   std::string initial_route_;
   std::shared_ptr<AssetManager> asset_manager_;
+  // The asset manager that records the assets read before the first frame,
+  // until the first frame is rendered.
+  std::shared_ptr<AssetManager> startup_asset_manager_;
   std::shared_ptr<FontCollection> font_collection_;
+  bool shares_font_collection_ = false;
+  // Whether the glyphs of the asset manager still have to be warmed up, which
+  // waits for the viewport metrics.
+  bool glyph_warm_up_pending_ = false;
+  size_t stored_fallback_font_match_count_ = 0;
   ImageDecoder image_decoder_;
   ImageGeneratorRegistry image_generator_registry_;
+  IdleTaskScheduler idle_task_scheduler_;
   TaskRunners task_runners_;
   fml::WeakPtrFactory<Engine> weak_factory_;  // Must be the last member.
   FML_DISALLOW_COPY_AND_ASSIGN(Engine);
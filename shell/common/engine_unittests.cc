@@ -36,6 +36,7 @@ class MockDelegate : public Engine::Delegate {
                    const std::vector<std::string>&));
   MOCK_METHOD1(RequestDartDeferredLibrary, void(intptr_t));
   MOCK_METHOD0(GetCurrentTimePoint, fml::TimePoint());
+  MOCK_METHOD1(OnEngineWarmUpGlyphs, void(std::vector<sk_sp<SkPicture>>));
 };
 
 class MockResponse : public PlatformMessageResponse {
@@ -53,6 +54,7 @@ class MockRuntimeDelegate : public RuntimeDelegate {
                void(SemanticsNodeUpdates, CustomAccessibilityActionUpdates));
   MOCK_METHOD1(HandlePlatformMessage, void(std::unique_ptr<PlatformMessage>));
   MOCK_METHOD0(GetFontCollection, FontCollection&());
+  MOCK_METHOD0(GetAssetManager, std::shared_ptr<AssetManager>());
   MOCK_METHOD0(OnRootIsolateCreated, void());
   MOCK_METHOD2(UpdateIsolateDescription, void(const std::string, int64_t));
   MOCK_METHOD1(SetNeedsReportTimings, void(bool));
@@ -68,6 +70,8 @@ class MockRuntimeController : public RuntimeController {
       : RuntimeController(client, p_task_runners) {}
   MOCK_METHOD0(IsRootIsolateRunning, bool());
   MOCK_METHOD1(DispatchPlatformMessage, bool(std::unique_ptr<PlatformMessage>));
+  MOCK_METHOD1(DispatchPlatformMessages,
+               bool(std::vector<std::unique_ptr<PlatformMessage>>));
   MOCK_METHOD3(LoadDartDeferredLibraryError,
                void(intptr_t, const std::string, bool));
   MOCK_CONST_METHOD0(GetDartVM, DartVM*());
@@ -249,6 +253,47 @@ TEST_F(EngineTest, DispatchPlatformMessageInitialRouteIgnored) {
   });
 }
 
+TEST_F(EngineTest, DispatchPlatformMessagesBatchesAroundEngineMessages) {
+  PostUITaskSync([this] {
+    MockRuntimeDelegate client;
+    auto mock_runtime_controller =
+        std::make_unique<MockRuntimeController>(client, task_runners_);
+    EXPECT_CALL(*mock_runtime_controller, IsRootIsolateRunning())
+        .WillRepeatedly(::testing::Return(true));
+    {
+      // The settings message, which the engine handles, splits the other
+      // messages in two batches.
+      ::testing::InSequence sequence;
+      EXPECT_CALL(*mock_runtime_controller,
+                  DispatchPlatformMessages(::testing::SizeIs(2)))
+          .WillOnce(::testing::Return(true));
+      EXPECT_CALL(*mock_runtime_controller,
+                  DispatchPlatformMessages(::testing::SizeIs(1)))
+          .WillOnce(::testing::Return(true));
+    }
+    auto engine = std::make_unique<Engine>(
+        /*delegate=*/delegate_,
+        /*dispatcher_maker=*/dispatcher_maker_,
+        /*image_decoder_task_runner=*/image_decoder_task_runner_,
+        /*task_runners=*/task_runners_,
+        /*settings=*/settings_,
+        /*animator=*/std::move(animator_),
+        /*io_manager=*/io_manager_,
+        /*font_collection=*/std::make_shared<FontCollection>(),
+        /*runtime_controller=*/std::move(mock_runtime_controller));
+
+    fml::RefPtr<PlatformMessageResponse> response =
+        fml::MakeRefCounted<MockResponse>();
+    std::vector<std::unique_ptr<PlatformMessage>> messages;
+    messages.push_back(std::make_unique<PlatformMessage>("foo", response));
+    messages.push_back(std::make_unique<PlatformMessage>("bar", response));
+    messages.push_back(MakePlatformMessage(
+        "flutter/settings", {{"textScaleFactor", "1.0"}}, response));
+    messages.push_back(std::make_unique<PlatformMessage>("baz", response));
+    engine->DispatchPlatformMessages(std::move(messages));
+  });
+}
+
 TEST_F(EngineTest, SpawnSharesFontLibrary) {
   PostUITaskSync([this] {
     MockRuntimeDelegate client;
@@ -272,6 +317,8 @@ TEST_F(EngineTest, SpawnSharesFontLibrary) {
                                std::string(), io_manager_);
     EXPECT_TRUE(spawn != nullptr);
     EXPECT_EQ(&engine->GetFontCollection(), &spawn->GetFontCollection());
+    EXPECT_FALSE(engine->SharesFontCollection());
+    EXPECT_TRUE(spawn->SharesFontCollection());
   });
 }
 
@@ -262,3 +262,127 @@ void canReceiveArgumentsWhenEngineRun(List<String> args) {
 void canReceiveArgumentsWhenEngineSpawn(List<String> args) {
   notifyNativeWhenEngineSpawn(args.length == 2 && args[0] == 'arg1' && args[1] == 'arg2');
 }
+
+// Renders the picture painted by [paint] on every frame, for the frame
+// benchmarks in shell_frame_benchmarks.cc.
+void _paintEveryFrame(void Function(Canvas canvas, Size size, int frame) paint) {
+  int frame = 0;
+  PlatformDispatcher.instance.onBeginFrame = (Duration beginTime) {
+    final PictureRecorder recorder = PictureRecorder();
+    final Canvas canvas = Canvas(recorder);
+    paint(canvas, window.physicalSize, frame++);
+    final Picture picture = recorder.endRecording();
+    final SceneBuilder builder = SceneBuilder();
+    builder.addPicture(Offset.zero, picture);
+    final Scene scene = builder.build();
+    window.render(scene);
+    scene.dispose();
+    picture.dispose();
+    PlatformDispatcher.instance.scheduleFrame();
+  };
+  PlatformDispatcher.instance.scheduleFrame();
+}
+
+Paragraph _layoutParagraph(String text, double fontSize, double width) {
+  final ParagraphBuilder builder = ParagraphBuilder(ParagraphStyle(fontSize: fontSize))
+    ..pushStyle(TextStyle(color: const Color(0xFF212121)))
+    ..addText(text);
+  return builder.build()..layout(ParagraphConstraints(width: width));
+}
+
+@pragma('vm:entry-point')
+void benchmarkScrollingList() {
+  const double rowHeight = 56;
+  const double scrollPerFrame = 7;
+  final Paint avatarPaint = Paint()..color = const Color(0xFF2196F3);
+  final Paint dividerPaint = Paint()..color = const Color(0xFFE0E0E0);
+  final Map<int, Paragraph> labels = <int, Paragraph>{};
+  _paintEveryFrame((Canvas canvas, Size size, int frame) {
+    canvas.drawColor(const Color(0xFFFFFFFF), BlendMode.src);
+    final double scrollOffset = frame * scrollPerFrame;
+    final int firstRow = scrollOffset ~/ rowHeight;
+    final int lastRow = (scrollOffset + size.height) ~/ rowHeight;
+    // Like a list view, lay out the rows that scroll into view and drop the
+    // ones that scroll out.
+    labels.removeWhere((int row, Paragraph label) => row < firstRow);
+    for (int row = firstRow; row <= lastRow; row++) {
+      final double top = row * rowHeight - scrollOffset;
+      canvas.drawCircle(Offset(28, top + rowHeight / 2), 20, avatarPaint);
+      final Paragraph label = labels.putIfAbsent(
+          row, () => _layoutParagraph('List item $row', 16, size.width - 72));
+      canvas.drawParagraph(label, Offset(64, top + (rowHeight - label.height) / 2));
+      canvas.drawRect(Rect.fromLTWH(64, top + rowHeight - 1, size.width - 64, 1), dividerPaint);
+    }
+  });
+}
+
+@pragma('vm:entry-point')
+void benchmarkAnimation() {
+  const int squareCount = 100;
+  final Paint squarePaint = Paint();
+  _paintEveryFrame((Canvas canvas, Size size, int frame) {
+    canvas.drawColor(const Color(0xFF000000), BlendMode.src);
+    for (int i = 0; i < squareCount; i++) {
+      final double t = (frame + i * 3) / 60;
+      canvas.save();
+      canvas.translate(
+        size.width * ((i % 10) + 0.5) / 10,
+        size.height * ((i ~/ 10) + 0.5) / 10,
+      );
+      canvas.rotate(t);
+      squarePaint.color = Color.fromARGB(
+          128 + (127 * (i / squareCount)).round(), 255, (frame * 4 + i * 16) % 256, 64);
+      canvas.drawRRect(
+          RRect.fromRectAndRadius(const Rect.fromLTWH(-20, -20, 40, 40), const Radius.circular(8)),
+          squarePaint);
+      canvas.restore();
+    }
+  });
+}
+
+@pragma('vm:entry-point')
+void benchmarkTextPage() {
+  const String text = 'Lorem ipsum dolor sit amet, consectetur adipiscing '
+      'elit, sed do eiusmod tempor incididunt ut labore et dolore magna '
+      'aliqua. Ut enim ad minim veniam, quis nostrud exercitation ullamco '
+      'laboris nisi ut aliquip ex ea commodo consequat.';
+  _paintEveryFrame((Canvas canvas, Size size, int frame) {
+    canvas.drawColor(const Color(0xFFFFFFFF), BlendMode.src);
+    // The paragraphs change on every frame, so each frame lays out the page.
+    double top = 0;
+    for (int i = 0; top < size.height; i++) {
+      final Paragraph paragraph =
+          _layoutParagraph('${frame + i}. $text', 14, size.width - 32);
+      canvas.drawParagraph(paragraph, Offset(16, top));
+      top += paragraph.height + 8;
+    }
+  });
+}
+
+// Renders a single frame once the view has a size, for the startup benchmarks
+// in shell_startup_benchmarks.cc.
+@pragma('vm:entry-point')
+void benchmarkFirstFrame() {
+  bool rendered = false;
+  PlatformDispatcher.instance.onBeginFrame = (Duration beginTime) {
+    final Size size = window.physicalSize;
+    if (rendered || size.isEmpty) {
+      return;
+    }
+    rendered = true;
+    final PictureRecorder recorder = PictureRecorder();
+    final Canvas canvas = Canvas(recorder);
+    canvas.drawColor(const Color(0xFFFFFFFF), BlendMode.src);
+    canvas.drawRect(Rect.fromLTWH(0, 0, size.width, 56), Paint()..color = const Color(0xFF2196F3));
+    canvas.drawParagraph(_layoutParagraph('Hello, startup', 20, size.width - 32), const Offset(16, 72));
+    final Picture picture = recorder.endRecording();
+    final SceneBuilder builder = SceneBuilder();
+    builder.addPicture(Offset.zero, picture);
+    final Scene scene = builder.build();
+    window.render(scene);
+    scene.dispose();
+    picture.dispose();
+  };
+  PlatformDispatcher.instance.onMetricsChanged = PlatformDispatcher.instance.scheduleFrame;
+  PlatformDispatcher.instance.scheduleFrame();
+}
@@ -0,0 +1,50 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_scheduler.h"
+
+#include <algorithm>
+
+namespace flutter {
+
+FrameScheduler::FrameScheduler() = default;
+
+FrameScheduler::~FrameScheduler() = default;
+
+void FrameScheduler::AddFrameTiming(const FrameTiming& timing,
+                                    fml::TimeDelta frame_interval) {
+  fml::TimePoint target_time =
+      timing.Get(FrameTiming::kVsyncStart) + frame_interval;
+  if (timing.Get(FrameTiming::kRasterFinish) > target_time) {
+    // A late frame means that the frames were started too late, or that they
+    // got more expensive. Either way, the history no longer predicts them, so
+    // they are started at their vsyncs again until it is rebuilt.
+    frame_durations_.clear();
+    return;
+  }
+  frame_durations_.push_back(timing.Get(FrameTiming::kRasterFinish) -
+                             timing.Get(FrameTiming::kBuildStart));
+  if (frame_durations_.size() > kHistorySize) {
+    frame_durations_.pop_front();
+  }
+}
+
+fml::TimeDelta FrameScheduler::GetBuildDelay(
+    fml::TimePoint frame_start_time,
+    fml::TimePoint frame_target_time) const {
+  if (frame_durations_.size() < kMinHistorySize) {
+    return fml::TimeDelta::Zero();
+  }
+  // The slowest of the last frames, since a frame that misses its target
+  // time costs a whole vsync interval of latency rather than a fraction.
+  fml::TimeDelta predicted_duration =
+      *std::max_element(frame_durations_.begin(), frame_durations_.end());
+  fml::TimeDelta frame_interval = frame_target_time - frame_start_time;
+  // Leaves room for the jitter of the vsync and of the task runners.
+  fml::TimeDelta margin = frame_interval / 8;
+  fml::TimeDelta delay = frame_interval - predicted_duration - margin;
+  return std::max(delay, fml::TimeDelta::Zero());
+}
+
+}  // namespace flutter
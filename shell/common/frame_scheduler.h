@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_SCHEDULER_H_
+#define FLUTTER_SHELL_COMMON_FRAME_SCHEDULER_H_
+
+#include <deque>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Predicts how long the next frame will take to build and
+///             rasterize from the timings of the last frames, so that the
+///             |Animator| can start building each frame as late as it can
+///             while still finishing it by its target time. The input events
+///             that arrive in the meanwhile make it into the frame rather
+///             than waiting for the next one.
+///
+///             Building a frame is only ever delayed: it cannot start before
+///             the vsync that the frame is scheduled for.
+///
+class FrameScheduler {
+ public:
+  /// The number of frames whose timings the prediction is made from.
+  static constexpr size_t kHistorySize = 16;
+
+  /// The number of frames whose timings are needed before building a frame is
+  /// delayed at all.
+  static constexpr size_t kMinHistorySize = 4;
+
+  FrameScheduler();
+
+  ~FrameScheduler();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the timing of a rasterized frame to the history.
+  ///
+  /// @param[in]  timing          The timing of the rasterized frame.
+  /// @param[in]  frame_interval  The vsync interval of the frame.
+  ///
+  void AddFrameTiming(const FrameTiming& timing, fml::TimeDelta frame_interval);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns how long the frame for the vsync at
+  ///             |frame_start_time| should wait before it is built to be done
+  ///             by |frame_target_time|. This is zero until enough frames have
+  ///             been rasterized, and after a frame missed its target time.
+  ///
+  fml::TimeDelta GetBuildDelay(fml::TimePoint frame_start_time,
+                               fml::TimePoint frame_target_time) const;
+
+ private:
+  // The durations from the start of the build to the end of the raster of
+  // the last frames that made their target times, newest last.
+  std::deque<fml::TimeDelta> frame_durations_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameScheduler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_SCHEDULER_H_
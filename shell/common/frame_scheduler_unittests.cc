@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_scheduler.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr fml::TimeDelta kFrameInterval = fml::TimeDelta::FromMilliseconds(8);
+
+// A frame of a 125Hz display that starts building |build_delay| milliseconds
+// after its vsync and is done |duration| milliseconds later.
+FrameTiming MakeTiming(int64_t build_delay, int64_t duration) {
+  FrameTiming timing;
+  fml::TimePoint vsync = fml::TimePoint::Now();
+  fml::TimePoint build_start =
+      vsync + fml::TimeDelta::FromMilliseconds(build_delay);
+  timing.Set(FrameTiming::kVsyncStart, vsync);
+  timing.Set(FrameTiming::kBuildStart, build_start);
+  timing.Set(FrameTiming::kRasterFinish,
+             build_start + fml::TimeDelta::FromMilliseconds(duration));
+  return timing;
+}
+
+fml::TimeDelta GetBuildDelay(const FrameScheduler& scheduler) {
+  fml::TimePoint vsync = fml::TimePoint::Now();
+  return scheduler.GetBuildDelay(vsync, vsync + kFrameInterval);
+}
+
+}  // namespace
+
+TEST(FrameSchedulerTest, DoesNotDelayWithoutEnoughHistory) {
+  FrameScheduler scheduler;
+  for (size_t i = 1; i < FrameScheduler::kMinHistorySize; i++) {
+    scheduler.AddFrameTiming(MakeTiming(0, 2), kFrameInterval);
+  }
+
+  EXPECT_EQ(GetBuildDelay(scheduler), fml::TimeDelta::Zero());
+}
+
+TEST(FrameSchedulerTest, DelaysBySlackOfSlowestFrame) {
+  FrameScheduler scheduler;
+  scheduler.AddFrameTiming(MakeTiming(0, 2), kFrameInterval);
+  scheduler.AddFrameTiming(MakeTiming(0, 4), kFrameInterval);
+  scheduler.AddFrameTiming(MakeTiming(0, 3), kFrameInterval);
+  scheduler.AddFrameTiming(MakeTiming(0, 2), kFrameInterval);
+
+  // 8ms minus the 4ms of the slowest frame and a 1ms margin.
+  EXPECT_EQ(GetBuildDelay(scheduler), fml::TimeDelta::FromMilliseconds(3));
+}
+
+TEST(FrameSchedulerTest, ForgetsFramesOutsideOfHistory) {
+  FrameScheduler scheduler;
+  scheduler.AddFrameTiming(MakeTiming(0, 6), kFrameInterval);
+  for (size_t i = 0; i < FrameScheduler::kHistorySize; i++) {
+    scheduler.AddFrameTiming(MakeTiming(0, 2), kFrameInterval);
+  }
+
+  EXPECT_EQ(GetBuildDelay(scheduler), fml::TimeDelta::FromMilliseconds(5));
+}
+
+TEST(FrameSchedulerTest, LateFrameStopsDelays) {
+  FrameScheduler scheduler;
+  for (size_t i = 0; i < FrameScheduler::kMinHistorySize; i++) {
+    scheduler.AddFrameTiming(MakeTiming(3, 2), kFrameInterval);
+  }
+  ASSERT_GT(GetBuildDelay(scheduler), fml::TimeDelta::Zero());
+
+  scheduler.AddFrameTiming(MakeTiming(3, 6), kFrameInterval);
+
+  EXPECT_EQ(GetBuildDelay(scheduler), fml::TimeDelta::Zero());
+}
+
+TEST(FrameSchedulerTest, NeverDelaysFramesWithoutSlack) {
+  FrameScheduler scheduler;
+  for (size_t i = 0; i < FrameScheduler::kHistorySize; i++) {
+    scheduler.AddFrameTiming(MakeTiming(0, 8), kFrameInterval);
+  }
+
+  EXPECT_EQ(GetBuildDelay(scheduler), fml::TimeDelta::Zero());
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_task_scheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+IdleTaskScheduler::IdleTaskScheduler() = default;
+
+IdleTaskScheduler::~IdleTaskScheduler() = default;
+
+IdleTaskScheduler::TaskId IdleTaskScheduler::AddTask(std::string name,
+                                                     Task task) {
+  TaskId id = next_id_++;
+  entries_.push_back({id, std::move(name), std::move(task)});
+  return id;
+}
+
+void IdleTaskScheduler::RemoveTask(TaskId id) {
+  entries_.erase(
+      std::remove_if(entries_.begin(), entries_.end(),
+                     [id](const Entry& entry) { return entry.id == id; }),
+      entries_.end());
+}
+
+size_t IdleTaskScheduler::RunTasks(fml::TimePoint deadline) {
+  fml::TimePoint start = fml::TimePoint::Now();
+  TRACE_EVENT0("flutter", "IdleTaskScheduler::RunTasks");
+
+  std::stable_sort(entries_.begin(), entries_.end(),
+                   [](const Entry& a, const Entry& b) {
+                     return a.deferred_idle_periods > b.deferred_idle_periods;
+                   });
+  // The tasks may add or remove tasks, so only the ones present when the idle
+  // period starts are run, by id.
+  std::vector<TaskId> ids;
+  ids.reserve(entries_.size());
+  for (const Entry& entry : entries_) {
+    ids.push_back(entry.id);
+  }
+
+  size_t ran_count = 0;
+  size_t deferred_count = 0;
+  for (TaskId id : ids) {
+    auto found = std::find_if(entries_.begin(), entries_.end(),
+                              [id](const Entry& entry) {
+                                return entry.id == id;
+                              });
+    if (found == entries_.end()) {
+      continue;
+    }
+    if (deadline - fml::TimePoint::Now() < kMinTaskBudget &&
+        found->deferred_idle_periods < kMaxDeferredIdlePeriods) {
+      found->deferred_idle_periods++;
+      deferred_count++;
+      continue;
+    }
+    found->deferred_idle_periods = 0;
+    // The task is copied since it may remove itself.
+    std::string name = found->name;
+    Task task = found->task;
+    {
+      TRACE_EVENT1("flutter", "IdleTask", "name", name.c_str());
+      task(deadline);
+    }
+    ran_count++;
+  }
+
+  int64_t budget = std::max<int64_t>(0, (deadline - start).ToMicroseconds());
+  int64_t used = (fml::TimePoint::Now() - start).ToMicroseconds();
+  FML_TRACE_COUNTER("flutter", "IdleTaskScheduler",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "BudgetMicros", budget, "UsedMicros", used,
+                    "DeferredTasks", deferred_count);
+  return ran_count;
+}
+
+}  // namespace flutter
@@ -0,0 +1,90 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_IDLE_TASK_SCHEDULER_H_
+#define FLUTTER_SHELL_COMMON_IDLE_TASK_SCHEDULER_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Runs the deferrable work of the subsystems of the engine in the
+///             time that the frames leave on the UI task runner, after the
+///             Dart VM was notified that it is idle.
+///
+///             Each idle period runs the tasks that were deferred the longest
+///             first, and starts no task once less than |kMinTaskBudget| is
+///             left before the deadline. A task that was deferred for
+///             |kMaxDeferredIdlePeriods| idle periods runs regardless, so
+///             that frames that never leave time do not starve it.
+///
+///             The scheduler may only be used on the UI task runner.
+///
+class IdleTaskScheduler {
+ public:
+  /// A deferrable task. It is given the deadline of the idle period, which it
+  /// should return by.
+  using Task = std::function<void(fml::TimePoint deadline)>;
+
+  using TaskId = size_t;
+
+  /// The least time before the deadline for which a task is started.
+  static constexpr fml::TimeDelta kMinTaskBudget =
+      fml::TimeDelta::FromMicroseconds(500);
+
+  /// The number of idle periods a task may be deferred for.
+  static constexpr size_t kMaxDeferredIdlePeriods = 10;
+
+  IdleTaskScheduler();
+
+  ~IdleTaskScheduler();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds a task that runs in the idle periods until it is
+  ///             removed.
+  ///
+  /// @param[in]  name  The name of the task in the timeline.
+  /// @param[in]  task  The task.
+  ///
+  /// @return     The id of the task for |RemoveTask|.
+  ///
+  TaskId AddTask(std::string name, Task task);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes a task added with |AddTask|.
+  ///
+  void RemoveTask(TaskId id);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Runs the tasks for the idle period that ends at |deadline|.
+  ///
+  /// @return     The number of tasks that ran.
+  ///
+  size_t RunTasks(fml::TimePoint deadline);
+
+ private:
+  struct Entry {
+    TaskId id;
+    std::string name;
+    Task task;
+    // The number of idle periods since the task last ran.
+    size_t deferred_idle_periods = 0;
+  };
+
+  std::vector<Entry> entries_;
+  TaskId next_id_ = 1;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(IdleTaskScheduler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_IDLE_TASK_SCHEDULER_H_
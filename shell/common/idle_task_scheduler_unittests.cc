@@ -0,0 +1,94 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_task_scheduler.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+fml::TimePoint GetLongDeadline() {
+  return fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(10);
+}
+
+fml::TimePoint GetPassedDeadline() {
+  return fml::TimePoint::Now() - fml::TimeDelta::FromMilliseconds(1);
+}
+
+}  // namespace
+
+TEST(IdleTaskSchedulerTest, RunsTheTasksWithinTheDeadline) {
+  IdleTaskScheduler scheduler;
+  std::vector<std::string> ran;
+  scheduler.AddTask("a", [&ran](fml::TimePoint) { ran.push_back("a"); });
+  scheduler.AddTask("b", [&ran](fml::TimePoint) { ran.push_back("b"); });
+
+  EXPECT_EQ(scheduler.RunTasks(GetLongDeadline()), 2u);
+  EXPECT_EQ(ran, (std::vector<std::string>{"a", "b"}));
+
+  ran.clear();
+  EXPECT_EQ(scheduler.RunTasks(GetPassedDeadline()), 0u);
+  EXPECT_TRUE(ran.empty());
+}
+
+TEST(IdleTaskSchedulerTest, RunsTheTasksDeferredTheLongestFirst) {
+  IdleTaskScheduler scheduler;
+  std::vector<std::string> ran;
+  // Uses up the idle period, so that the next task is deferred.
+  scheduler.AddTask("a", [&ran](fml::TimePoint deadline) {
+    ran.push_back("a");
+    std::this_thread::sleep_until(
+        std::chrono::steady_clock::now() +
+        std::chrono::microseconds(
+            (deadline - fml::TimePoint::Now()).ToMicroseconds()));
+  });
+  scheduler.AddTask("b", [&ran](fml::TimePoint) { ran.push_back("b"); });
+
+  EXPECT_EQ(scheduler.RunTasks(fml::TimePoint::Now() +
+                               fml::TimeDelta::FromMilliseconds(20)),
+            1u);
+  EXPECT_EQ(ran, (std::vector<std::string>{"a"}));
+
+  ran.clear();
+  EXPECT_EQ(scheduler.RunTasks(GetLongDeadline()), 2u);
+  EXPECT_EQ(ran, (std::vector<std::string>{"b", "a"}));
+}
+
+TEST(IdleTaskSchedulerTest, DeferredTasksRunEventually) {
+  IdleTaskScheduler scheduler;
+  size_t run_count = 0;
+  scheduler.AddTask("task", [&run_count](fml::TimePoint) { run_count++; });
+
+  for (size_t i = 0; i < IdleTaskScheduler::kMaxDeferredIdlePeriods; i++) {
+    EXPECT_EQ(scheduler.RunTasks(GetPassedDeadline()), 0u);
+  }
+  EXPECT_EQ(scheduler.RunTasks(GetPassedDeadline()), 1u);
+  EXPECT_EQ(run_count, 1u);
+  EXPECT_EQ(scheduler.RunTasks(GetPassedDeadline()), 0u);
+}
+
+TEST(IdleTaskSchedulerTest, RemovedTasksDoNotRun) {
+  IdleTaskScheduler scheduler;
+  size_t run_count = 0;
+  IdleTaskScheduler::TaskId second = 0;
+  scheduler.AddTask("first", [&scheduler, &second](fml::TimePoint) {
+    scheduler.RemoveTask(second);
+  });
+  second = scheduler.AddTask("second",
+                             [&run_count](fml::TimePoint) { run_count++; });
+
+  EXPECT_EQ(scheduler.RunTasks(GetLongDeadline()), 1u);
+  EXPECT_EQ(run_count, 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
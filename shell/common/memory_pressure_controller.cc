@@ -0,0 +1,59 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/memory_pressure_controller.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace flutter {
+
+size_t MemoryPressureReport::GetTotalBytes() const {
+  return raster_cache_bytes + decoded_image_cache_bytes +
+         text_layout_cache_bytes + pending_sksl_bytes + overlay_surface_bytes;
+}
+
+MemoryPressureController::MemoryPressureController(size_t target_bytes)
+    : target_bytes_(target_bytes) {}
+
+MemoryPressureController::~MemoryPressureController() = default;
+
+void MemoryPressureController::AddCache(Cache cache) {
+  caches_.push_back(std::move(cache));
+}
+
+MemoryPressureReport MemoryPressureController::Relieve(
+    MemoryPressureLevel level) const {
+  MemoryPressureReport report;
+  report.level = level;
+
+  std::vector<size_t> cache_bytes;
+  size_t total_bytes = 0;
+  for (const auto& cache : caches_) {
+    cache_bytes.push_back(cache.get_bytes());
+    total_bytes += cache_bytes.back();
+  }
+
+  size_t kept_bytes = 0;
+  if (level == MemoryPressureLevel::kModerate) {
+    kept_bytes = target_bytes_ > 0 ? target_bytes_ : total_bytes / 2;
+  }
+  if (total_bytes <= kept_bytes) {
+    return report;
+  }
+
+  size_t excess_bytes = total_bytes - kept_bytes;
+  for (size_t i = 0; i < caches_.size() && excess_bytes > 0; i++) {
+    if (cache_bytes[i] == 0) {
+      continue;
+    }
+    size_t max_bytes = cache_bytes[i] - std::min(excess_bytes, cache_bytes[i]);
+    size_t freed_bytes = caches_[i].trim(max_bytes);
+    report.*caches_[i].freed_bytes += freed_bytes;
+    excess_bytes -= std::min(excess_bytes, freed_bytes);
+  }
+  return report;
+}
+
+}  // namespace flutter
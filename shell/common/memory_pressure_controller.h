@@ -0,0 +1,94 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_MEMORY_PRESSURE_CONTROLLER_H_
+#define FLUTTER_SHELL_COMMON_MEMORY_PRESSURE_CONTROLLER_H_
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+/// How much memory the platform asks the engine to give back.
+enum class MemoryPressureLevel {
+  /// The system is running low on memory, but the app is still visible. The
+  /// caches are trimmed down to the memory target, so that the next frames
+  /// have little to rebuild.
+  kModerate,
+  /// The system is about to kill processes. Everything that can be recreated
+  /// is dropped.
+  kCritical,
+};
+
+/// The memory in bytes that a response to memory pressure freed from each of
+/// the caches.
+struct MemoryPressureReport {
+  MemoryPressureLevel level = MemoryPressureLevel::kModerate;
+  size_t raster_cache_bytes = 0;
+  size_t decoded_image_cache_bytes = 0;
+  size_t text_layout_cache_bytes = 0;
+  size_t pending_sksl_bytes = 0;
+  size_t overlay_surface_bytes = 0;
+
+  size_t GetTotalBytes() const;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Trims the caches of a shell in response to memory pressure, in
+///             the order in which they were added, so that the caches that
+///             are cheapest to refill give back their memory first.
+///
+///             Under moderate pressure, only the memory above the target is
+///             freed, and the caches after the ones that freed it are left
+///             alone. Under critical pressure, every cache is emptied.
+///
+class MemoryPressureController {
+ public:
+  /// A cache that the controller trims.
+  struct Cache {
+    /// The field of the report that the memory freed from the cache is
+    /// added to.
+    size_t MemoryPressureReport::*freed_bytes;
+    /// Returns the memory that the cache holds.
+    std::function<size_t()> get_bytes;
+    /// Frees entries of the cache until it holds at most |max_bytes|, and
+    /// returns the memory it freed. A cache that can't be trimmed partially
+    /// may free nothing unless |max_bytes| is 0.
+    std::function<size_t(size_t max_bytes)> trim;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  target_bytes  The memory that the caches may keep in total
+  ///                           under moderate pressure, or 0 to free half of
+  ///                           what they hold.
+  ///
+  explicit MemoryPressureController(size_t target_bytes);
+
+  ~MemoryPressureController();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds a cache, to be trimmed after the ones added before it.
+  ///
+  void AddCache(Cache cache);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Trims the caches for the given level of pressure.
+  ///
+  /// @return     The memory freed from each cache.
+  ///
+  MemoryPressureReport Relieve(MemoryPressureLevel level) const;
+
+ private:
+  const size_t target_bytes_;
+  std::vector<Cache> caches_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(MemoryPressureController);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_MEMORY_PRESSURE_CONTROLLER_H_
@@ -0,0 +1,141 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/memory_pressure_controller.h"
+
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// A cache of |bytes| that frees the smallest multiple of |entry_bytes| that
+// brings it within the size it is trimmed to.
+class FakeCache {
+ public:
+  FakeCache(size_t bytes, size_t entry_bytes)
+      : bytes_(bytes), entry_bytes_(entry_bytes) {}
+
+  size_t bytes() const { return bytes_; }
+
+  size_t trim_count() const { return trim_count_; }
+
+  MemoryPressureController::Cache Get(
+      size_t MemoryPressureReport::*freed_bytes) {
+    return {
+        freed_bytes,
+        [this]() { return bytes_; },
+        [this](size_t max_bytes) {
+          trim_count_++;
+          size_t freed_bytes = 0;
+          while (bytes_ > max_bytes) {
+            size_t entry_bytes = std::min(entry_bytes_, bytes_);
+            bytes_ -= entry_bytes;
+            freed_bytes += entry_bytes;
+          }
+          return freed_bytes;
+        },
+    };
+  }
+
+ private:
+  size_t bytes_;
+  const size_t entry_bytes_;
+  size_t trim_count_ = 0;
+};
+
+}  // namespace
+
+TEST(MemoryPressureControllerTest, ModeratePressureTrimsDownToTheTarget) {
+  FakeCache raster_cache(600, 100);
+  FakeCache image_cache(400, 100);
+  MemoryPressureController controller(700);
+  controller.AddCache(
+      raster_cache.Get(&MemoryPressureReport::raster_cache_bytes));
+  controller.AddCache(
+      image_cache.Get(&MemoryPressureReport::decoded_image_cache_bytes));
+
+  auto report = controller.Relieve(MemoryPressureLevel::kModerate);
+
+  EXPECT_EQ(report.level, MemoryPressureLevel::kModerate);
+  EXPECT_EQ(report.raster_cache_bytes, 300u);
+  EXPECT_EQ(report.decoded_image_cache_bytes, 0u);
+  EXPECT_EQ(report.GetTotalBytes(), 300u);
+  EXPECT_EQ(raster_cache.bytes(), 300u);
+  EXPECT_EQ(image_cache.bytes(), 400u);
+  EXPECT_EQ(image_cache.trim_count(), 0u);
+}
+
+TEST(MemoryPressureControllerTest, ModeratePressureMovesOnToTheNextCache) {
+  FakeCache raster_cache(200, 100);
+  FakeCache image_cache(400, 300);
+  MemoryPressureController controller(300);
+  controller.AddCache(
+      raster_cache.Get(&MemoryPressureReport::raster_cache_bytes));
+  controller.AddCache(
+      image_cache.Get(&MemoryPressureReport::decoded_image_cache_bytes));
+
+  auto report = controller.Relieve(MemoryPressureLevel::kModerate);
+
+  EXPECT_EQ(report.raster_cache_bytes, 200u);
+  EXPECT_EQ(report.decoded_image_cache_bytes, 300u);
+  EXPECT_EQ(raster_cache.bytes(), 0u);
+  EXPECT_EQ(image_cache.bytes(), 100u);
+}
+
+TEST(MemoryPressureControllerTest, ModeratePressureWithoutTargetFreesHalf) {
+  FakeCache raster_cache(600, 100);
+  FakeCache image_cache(400, 100);
+  MemoryPressureController controller(0);
+  controller.AddCache(
+      raster_cache.Get(&MemoryPressureReport::raster_cache_bytes));
+  controller.AddCache(
+      image_cache.Get(&MemoryPressureReport::decoded_image_cache_bytes));
+
+  auto report = controller.Relieve(MemoryPressureLevel::kModerate);
+
+  EXPECT_EQ(report.GetTotalBytes(), 500u);
+  EXPECT_EQ(raster_cache.bytes(), 100u);
+  EXPECT_EQ(image_cache.bytes(), 400u);
+}
+
+TEST(MemoryPressureControllerTest, ModeratePressureWithinTheTargetFreesNone) {
+  FakeCache raster_cache(600, 100);
+  MemoryPressureController controller(1000);
+  controller.AddCache(
+      raster_cache.Get(&MemoryPressureReport::raster_cache_bytes));
+
+  auto report = controller.Relieve(MemoryPressureLevel::kModerate);
+
+  EXPECT_EQ(report.GetTotalBytes(), 0u);
+  EXPECT_EQ(raster_cache.trim_count(), 0u);
+}
+
+TEST(MemoryPressureControllerTest, CriticalPressureEmptiesEveryCache) {
+  FakeCache raster_cache(600, 100);
+  FakeCache image_cache(400, 100);
+  FakeCache overlay_surfaces(0, 100);
+  MemoryPressureController controller(1000);
+  controller.AddCache(
+      raster_cache.Get(&MemoryPressureReport::raster_cache_bytes));
+  controller.AddCache(
+      image_cache.Get(&MemoryPressureReport::decoded_image_cache_bytes));
+  controller.AddCache(
+      overlay_surfaces.Get(&MemoryPressureReport::overlay_surface_bytes));
+
+  auto report = controller.Relieve(MemoryPressureLevel::kCritical);
+
+  EXPECT_EQ(report.level, MemoryPressureLevel::kCritical);
+  EXPECT_EQ(report.raster_cache_bytes, 600u);
+  EXPECT_EQ(report.decoded_image_cache_bytes, 400u);
+  EXPECT_EQ(report.overlay_surface_bytes, 0u);
+  EXPECT_EQ(raster_cache.bytes(), 0u);
+  EXPECT_EQ(image_cache.bytes(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
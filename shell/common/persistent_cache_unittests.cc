@@ -402,5 +402,181 @@ TEST_F(PersistentCacheTest,
   DestroyShell(std::move(shell));
 }
 
+TEST_F(PersistentCacheTest, LoadsMostUsedSkSLsFirst) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+  PersistentCache::SetAssetManager(nullptr);
+  PersistentCache::SetCacheSkSL(true);
+  PersistentCache::SetPrioritizeSkSLPrecompilation(true);
+
+  sk_sp<SkData> rare_key = SkData::MakeWithCopy("rare", 4);
+  sk_sp<SkData> common_key = SkData::MakeWithCopy("common", 6);
+  sk_sp<SkData> value = SkData::MakeWithCString("value");
+  PersistentCache* cache = PersistentCache::GetCacheForProcess();
+  StorePersistentCache(cache, *rare_key, *value);
+  StorePersistentCache(cache, *common_key, *value);
+  StorePersistentCache(cache, *common_key, *value);
+
+  // The counts are read back from the disk by a new cache.
+  PersistentCache::ResetCacheForProcess();
+  auto shaders = PersistentCache::GetCacheForProcess()->LoadSkSLsByUsage();
+  ASSERT_EQ(shaders.size(), 2u);
+  CheckTextSkData(shaders[0].key, "common");
+  CheckTextSkData(shaders[1].key, "rare");
+
+  // Without a context nothing is left pending.
+  PersistentCache::GetCacheForProcess()->PrecompileKnownSkSLs(nullptr);
+  EXPECT_FALSE(PersistentCache::GetCacheForProcess()->PrecompilePendingSkSLs(
+      nullptr, fml::TimeDelta::Zero()));
+
+  // Cleanup
+  PersistentCache::SetPrioritizeSkSLPrecompilation(false);
+  PersistentCache::SetCacheSkSL(false);
+  fml::RemoveFilesInDirectory(base_dir.fd());
+  PersistentCache::SetCacheDirectoryPath("");
+  PersistentCache::ResetCacheForProcess();
+}
+
+static sk_sp<SkData> MakeTextSkData(const std::string& text) {
+  return SkData::MakeWithCopy(text.data(), text.size());
+}
+
+TEST(PersistentCachePack, StoredEntriesAreLoadedFromTheFile) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = std::make_shared<fml::UniqueFD>(
+      fml::OpenDirectory(dir.path().c_str(), false,
+                         fml::FilePermission::kReadWrite));
+  {
+    auto pack = std::make_shared<PersistentCachePack>(directory, "test.pack");
+    pack->Store(*MakeTextSkData("a"), *MakeTextSkData("x"), nullptr);
+    pack->Store(*MakeTextSkData("b"), *MakeTextSkData("y"), nullptr);
+    pack->Store(*MakeTextSkData("a"), *MakeTextSkData("z"), nullptr);
+    CheckTextSkData(pack->Load(*MakeTextSkData("a")), "z");
+  }
+
+  auto pack = std::make_shared<PersistentCachePack>(directory, "test.pack");
+  ASSERT_EQ(pack->GetEntryCount(), 2u);
+  CheckTextSkData(pack->Load(*MakeTextSkData("a")), "z");
+  CheckTextSkData(pack->Load(*MakeTextSkData("b")), "y");
+  EXPECT_EQ(pack->Load(*MakeTextSkData("c")), nullptr);
+  EXPECT_EQ(pack->LoadAll().size(), 2u);
+}
+
+TEST(PersistentCachePack, PartialRecordIsDroppedByCompaction) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = std::make_shared<fml::UniqueFD>(
+      fml::OpenDirectory(dir.path().c_str(), false,
+                         fml::FilePermission::kReadWrite));
+  {
+    auto pack = std::make_shared<PersistentCachePack>(directory, "test.pack");
+    pack->Store(*MakeTextSkData("a"), *MakeTextSkData("x"), nullptr);
+    pack->Store(*MakeTextSkData("b"), *MakeTextSkData("y"), nullptr);
+  }
+  size_t full_size;
+  {
+    auto file = fml::OpenFile(*directory, "test.pack", false,
+                              fml::FilePermission::kReadWrite);
+    full_size = fml::FileMapping(file).GetSize();
+    ASSERT_TRUE(fml::TruncateFile(file, full_size - 1));
+  }
+
+  {
+    auto pack = std::make_shared<PersistentCachePack>(directory, "test.pack");
+    ASSERT_EQ(pack->GetEntryCount(), 1u);
+    CheckTextSkData(pack->Load(*MakeTextSkData("a")), "x");
+    pack->Store(*MakeTextSkData("c"), *MakeTextSkData("w"), nullptr);
+  }
+
+  auto pack = std::make_shared<PersistentCachePack>(directory, "test.pack");
+  ASSERT_EQ(pack->GetEntryCount(), 2u);
+  CheckTextSkData(pack->Load(*MakeTextSkData("a")), "x");
+  CheckTextSkData(pack->Load(*MakeTextSkData("c")), "w");
+  auto file = fml::OpenFileReadOnly(*directory, "test.pack");
+  EXPECT_EQ(fml::FileMapping(file).GetSize(), full_size);
+}
+
+TEST_F(PersistentCacheTest, SkSLsAreStoredInThePackFile) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::SetUsePackFiles(true);
+  PersistentCache::ResetCacheForProcess();
+  PersistentCache::SetAssetManager(nullptr);
+  PersistentCache::SetCacheSkSL(true);
+
+  StorePersistentCache(PersistentCache::GetCacheForProcess(),
+                       *MakeTextSkData("key"), *MakeTextSkData("value"));
+
+  // A new cache loads the SkSL from the pack file.
+  PersistentCache::ResetCacheForProcess();
+  auto shaders = PersistentCache::GetCacheForProcess()->LoadSkSLs();
+  ASSERT_EQ(shaders.size(), 1u);
+  CheckTextSkData(shaders[0].key, "key");
+  CheckTextSkData(shaders[0].value, "value");
+
+  // Without the pack files, the SkSL is not found in its own file.
+  PersistentCache::SetUsePackFiles(false);
+  EXPECT_EQ(PersistentCache::GetCacheForProcess()->LoadSkSLs().size(), 0u);
+
+  // Cleanup
+  PersistentCache::SetCacheSkSL(false);
+  fml::RemoveFilesInDirectory(base_dir.fd());
+  PersistentCache::SetCacheDirectoryPath("");
+  PersistentCache::ResetCacheForProcess();
+}
+
+TEST_F(PersistentCacheTest, VkPipelineCacheIsNotStoredAsSkSL) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+  PersistentCache::SetAssetManager(nullptr);
+  PersistentCache::SetCacheSkSL(true);
+
+  uint32_t key_type = 1;
+  sk_sp<SkData> key = SkData::MakeWithCopy(&key_type, sizeof(key_type));
+  ASSERT_TRUE(PersistentCache::IsVkPipelineCacheKey(*key));
+  EXPECT_FALSE(PersistentCache::IsVkPipelineCacheKey(*MakeTextSkData("key")));
+  StorePersistentCache(PersistentCache::GetCacheForProcess(), *key,
+                       *MakeTextSkData("pipelines"));
+
+  // A new cache loads the pipeline cache, and does not take it for SkSL.
+  PersistentCache::ResetCacheForProcess();
+  PersistentCache* cache = PersistentCache::GetCacheForProcess();
+  EXPECT_EQ(cache->LoadSkSLs().size(), 0u);
+  CheckTextSkData(cache->load(*key), "pipelines");
+
+  // Cleanup
+  PersistentCache::SetCacheSkSL(false);
+  fml::RemoveFilesInDirectory(base_dir.fd());
+  PersistentCache::SetCacheDirectoryPath("");
+  PersistentCache::ResetCacheForProcess();
+}
+
+TEST_F(PersistentCacheTest, StartupAssetsAreLoadedInOrder) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+
+  PersistentCache* cache = PersistentCache::GetCacheForProcess();
+  EXPECT_TRUE(cache->LoadStartupAssets().empty());
+  cache->StoreStartupAssets(
+      {"FontManifest.json", "bad\nname", "packages/icons/icon.png"});
+
+  PersistentCache::ResetCacheForProcess();
+  std::vector<std::string> expected = {"FontManifest.json",
+                                       "packages/icons/icon.png"};
+  EXPECT_EQ(PersistentCache::GetCacheForProcess()->LoadStartupAssets(),
+            expected);
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+  PersistentCache::SetCacheDirectoryPath("");
+  PersistentCache::ResetCacheForProcess();
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_COMMON_PIPELINE_H_
 #define FLUTTER_SHELL_COMMON_PIPELINE_H_
 
+#include <algorithm>
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -91,14 +93,35 @@ class Pipeline {
   };
 
   explicit Pipeline(uint32_t depth)
-      : depth_(depth), empty_(depth), available_(0), inflight_(0) {}
+      : max_depth_(depth),
+        depth_(depth),
+        empty_(depth),
+        available_(0),
+        inflight_(0) {}
 
   ~Pipeline() = default;
 
   bool IsValid() const { return empty_.IsValid() && available_.IsValid(); }
 
+  /// Limits the number of resources in flight to |depth|, between 1 and the
+  /// depth that the pipeline was created with. Lowering the depth does not
+  /// drop the resources already in flight, but no resource can be produced
+  /// until enough of them have been consumed.
+  void SetDepth(uint32_t depth) {
+    depth_ = std::clamp<uint32_t>(depth, 1, max_depth_);
+    FML_TRACE_COUNTER("flutter", "Pipeline Depth Limit",
+                      reinterpret_cast<int64_t>(this),  //
+                      "depth", depth_.load()            //
+    );
+  }
+
+  uint32_t GetDepth() const { return depth_; }
+
+  /// The number of resources that have been produced but not consumed yet.
+  int GetInflightCount() const { return inflight_; }
+
   ProducerContinuation Produce() {
-    if (!empty_.TryWait()) {
+    if (!CanProduce()) {
       return {};
     }
     ++inflight_;
@@ -118,7 +141,7 @@ class Pipeline {
   // Prefer using |Produce|. ProducerContinuation returned by this method
   // doesn't guarantee that the frame will be rendered.
   ProducerContinuation ProduceIfEmpty() {
-    if (!empty_.TryWait()) {
+    if (!CanProduce()) {
       return {};
     }
     ++inflight_;
@@ -172,13 +195,21 @@ class Pipeline {
   }
 
  private:
-  const uint32_t depth_;
+  const uint32_t max_depth_;
+  std::atomic<uint32_t> depth_;
   fml::Semaphore empty_;
   fml::Semaphore available_;
   std::atomic<int> inflight_;
   std::mutex queue_mutex_;
   std::deque<std::pair<ResourcePtr, size_t>> queue_;
 
+  bool CanProduce() {
+    if (inflight_.load() >= static_cast<int>(depth_.load())) {
+      return false;
+    }
+    return empty_.TryWait();
+  }
+
   bool ProducerCommit(ResourcePtr resource, size_t trace_id) {
     {
       std::scoped_lock lock(queue_mutex_);
@@ -197,6 +228,7 @@ class Pipeline {
         // Bail if the queue is not empty, opens up spaces to produce other
         // frames.
         empty_.Signal();
+        --inflight_;
         return false;
       }
       queue_.emplace_back(std::move(resource), trace_id);
@@ -131,5 +131,62 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, SetDepthLimitsResourcesInFlight) {
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(3);
+  pipeline->SetDepth(1);
+
+  Continuation continuation_1 = pipeline->Produce();
+  ASSERT_TRUE(continuation_1);
+  ASSERT_FALSE(pipeline->Produce());
+  ASSERT_TRUE(continuation_1.Complete(std::make_unique<int>(1)));
+  ASSERT_FALSE(pipeline->Produce());
+
+  pipeline->SetDepth(3);
+  Continuation continuation_2 = pipeline->Produce();
+  Continuation continuation_3 = pipeline->Produce();
+  ASSERT_TRUE(continuation_2);
+  ASSERT_TRUE(continuation_3);
+  ASSERT_FALSE(pipeline->Produce());
+
+  // Lowering the depth keeps the resources in flight.
+  pipeline->SetDepth(2);
+  ASSERT_TRUE(continuation_2.Complete(std::make_unique<int>(2)));
+  ASSERT_TRUE(continuation_3.Complete(std::make_unique<int>(3)));
+  ASSERT_EQ(pipeline->Consume([](std::unique_ptr<int> v) {}),
+            PipelineConsumeResult::MoreAvailable);
+  ASSERT_FALSE(pipeline->Produce());
+  ASSERT_EQ(pipeline->Consume([](std::unique_ptr<int> v) {}),
+            PipelineConsumeResult::MoreAvailable);
+  ASSERT_TRUE(pipeline->Produce());
+}
+
+TEST(PipelineTest, SetDepthIsClampedToCreationDepth) {
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(2);
+
+  pipeline->SetDepth(5);
+  ASSERT_EQ(pipeline->GetDepth(), 2u);
+  pipeline->SetDepth(0);
+  ASSERT_EQ(pipeline->GetDepth(), 1u);
+}
+
+TEST(PipelineTest, CountsTheResourcesInFlight) {
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(2);
+  ASSERT_EQ(pipeline->GetInflightCount(), 0);
+
+  Continuation continuation_1 = pipeline->Produce();
+  Continuation continuation_2 = pipeline->Produce();
+  ASSERT_EQ(pipeline->GetInflightCount(), 2);
+  ASSERT_TRUE(continuation_1.Complete(std::make_unique<int>(1)));
+  ASSERT_TRUE(continuation_2.Complete(std::make_unique<int>(2)));
+
+  PipelineConsumeResult consume_result =
+      pipeline->Consume([&pipeline](std::unique_ptr<int> v) {
+        // The resource being consumed is still in flight.
+        ASSERT_EQ(pipeline->GetInflightCount(), 2);
+      });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::MoreAvailable);
+  ASSERT_EQ(pipeline->GetInflightCount(), 1);
+}
+
 }  // namespace testing
 }  // namespace flutter
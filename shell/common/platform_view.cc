@@ -13,6 +13,22 @@
 
 namespace flutter {
 
+void PlatformView::Delegate::OnPlatformViewDispatchPlatformEvents(
+    std::vector<PlatformEvent> events) {
+  for (auto& event : events) {
+    if (event.viewport_metrics) {
+      OnPlatformViewSetViewportMetrics(*event.viewport_metrics);
+    }
+    if (event.pointer_data_packet) {
+      OnPlatformViewDispatchPointerDataPacket(
+          std::move(event.pointer_data_packet));
+    }
+    if (event.platform_message) {
+      OnPlatformViewDispatchPlatformMessage(std::move(event.platform_message));
+    }
+  }
+}
+
 PlatformView::PlatformView(Delegate& delegate, TaskRunners task_runners)
     : delegate_(delegate),
       task_runners_(std::move(task_runners)),
@@ -38,6 +54,16 @@ void PlatformView::DispatchPointerDataPacket(
       pointer_data_packet_converter_.Convert(std::move(packet)));
 }
 
+void PlatformView::DispatchPlatformEvents(std::vector<PlatformEvent> events) {
+  for (auto& event : events) {
+    if (event.pointer_data_packet) {
+      event.pointer_data_packet = pointer_data_packet_converter_.Convert(
+          std::move(event.pointer_data_packet));
+    }
+  }
+  delegate_.OnPlatformViewDispatchPlatformEvents(std::move(events));
+}
+
 void PlatformView::DispatchSemanticsAction(int32_t id,
                                            SemanticsAction action,
                                            fml::MallocMapping args) {
@@ -7,6 +7,8 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "flutter/common/graphics/texture.h"
 #include "flutter/common/task_runners.h"
@@ -29,6 +31,16 @@
 
 namespace flutter {
 
+//------------------------------------------------------------------------------
+/// @brief      An event sent by the embedder to the engine, of which exactly
+///             one member is set.
+///
+struct PlatformEvent {
+  std::optional<ViewportMetrics> viewport_metrics;
+  std::unique_ptr<PointerDataPacket> pointer_data_packet;
+  std::unique_ptr<PlatformMessage> platform_message;
+};
+
 //------------------------------------------------------------------------------
 /// @brief      Platform views are created by the shell on the platform task
 ///             runner. Unless explicitly specified, all platform view methods
@@ -126,6 +138,18 @@ class PlatformView {
     virtual void OnPlatformViewDispatchPointerDataPacket(
         std::unique_ptr<PointerDataPacket> packet) = 0;
 
+    //--------------------------------------------------------------------------
+    /// @brief      Notifies the delegate that the platform view has encountered
+    ///             a batch of events, to be forwarded to the engine on the UI
+    ///             thread in their order. By default, the events are forwarded
+    ///             one at a time as if they had been encountered one after the
+    ///             other.
+    ///
+    /// @param[in]  events  The events, in the order they were encountered.
+    ///
+    virtual void OnPlatformViewDispatchPlatformEvents(
+        std::vector<PlatformEvent> events);
+
     //--------------------------------------------------------------------------
     /// @brief      Notifies the delegate that the platform view has encountered
     ///             an accessibility related action on the specified node. This
@@ -576,6 +600,16 @@ class PlatformView {
   ///
   void DispatchPointerDataPacket(std::unique_ptr<PointerDataPacket> packet);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Dispatches a batch of viewport metrics, pointer events and
+  ///             platform messages from the embedder to the framework, in
+  ///             their order. Unlike the calls that dispatch one event each,
+  ///             the whole batch only wakes up the UI thread once.
+  ///
+  /// @param[in]  events  The events to dispatch to the framework.
+  ///
+  void DispatchPlatformEvents(std::vector<PlatformEvent> events);
+
   //--------------------------------------------------------------------------
   /// @brief      Used by the embedder to specify a texture that it wants the
   ///             rasterizer to composite within the Flutter layer tree. All
@@ -4,6 +4,9 @@
 
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -15,6 +18,11 @@ SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate)
     : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
 SmoothPointerDataDispatcher::~SmoothPointerDataDispatcher() = default;
 
+CoalescingPointerDataDispatcher::CoalescingPointerDataDispatcher(
+    Delegate& delegate)
+    : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
+CoalescingPointerDataDispatcher::~CoalescingPointerDataDispatcher() = default;
+
 void DefaultPointerDataDispatcher::DispatchPacket(
     std::unique_ptr<PointerDataPacket> packet,
     uint64_t trace_flow_id) {
@@ -68,4 +76,134 @@ void SmoothPointerDataDispatcher::DispatchPendingPacket() {
   ScheduleSecondaryVsyncCallback();
 }
 
+void CoalescingPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  TRACE_EVENT0("flutter", "CoalescingPointerDataDispatcher::DispatchPacket");
+  TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
+
+  const fml::TimePoint arrival = fml::TimePoint::Now();
+  const std::vector<uint8_t>& bytes = packet->data();
+  for (size_t offset = 0; offset + sizeof(PointerData) <= bytes.size();
+       offset += sizeof(PointerData)) {
+    PointerData data;
+    memcpy(&data, &bytes[offset], sizeof(PointerData));
+    AddPointerData(data, arrival);
+  }
+  pending_trace_flow_ids_.push_back(trace_flow_id);
+
+  if (is_vsync_scheduled_) {
+    return;
+  }
+  is_vsync_scheduled_ = true;
+  delegate_.ScheduleSecondaryVsyncCallback(
+      reinterpret_cast<uintptr_t>(this),
+      [dispatcher = weak_factory_.GetWeakPtr()]() {
+        if (dispatcher) {
+          dispatcher->DispatchPendingData();
+        }
+      });
+}
+
+void CoalescingPointerDataDispatcher::AddPointerData(const PointerData& data,
+                                                     fml::TimePoint arrival) {
+  DeviceState& device = devices_[data.device];
+  PointerData sample = data;
+  const bool is_motion = (sample.change == PointerData::Change::kMove ||
+                          sample.change == PointerData::Change::kHover) &&
+                         sample.signal_kind == PointerData::SignalKind::kNone;
+  if (is_motion) {
+    sample.physical_delta_x -= device.prediction_offset_x;
+    sample.physical_delta_y -= device.prediction_offset_y;
+  }
+  device.prediction_offset_x = 0;
+  device.prediction_offset_y = 0;
+
+  device.has_velocity = is_motion && device.last_sample_is_motion &&
+                        sample.time_stamp > device.last_time_stamp;
+  if (device.has_velocity) {
+    double elapsed = sample.time_stamp - device.last_time_stamp;
+    device.velocity_x = (sample.physical_x - device.last_x) / elapsed;
+    device.velocity_y = (sample.physical_y - device.last_y) / elapsed;
+  }
+  device.last_sample_is_motion = is_motion;
+  device.is_removed = sample.change == PointerData::Change::kRemove;
+  device.last_time_stamp = sample.time_stamp;
+  device.last_x = sample.physical_x;
+  device.last_y = sample.physical_y;
+  device.last_arrival = arrival;
+
+  if (is_motion && device.coalesced_index >= 0) {
+    PointerData& coalesced = pending_data_[device.coalesced_index];
+    if (coalesced.change == sample.change &&
+        coalesced.buttons == sample.buttons && coalesced.kind == sample.kind) {
+      sample.physical_delta_x += coalesced.physical_delta_x;
+      sample.physical_delta_y += coalesced.physical_delta_y;
+      coalesced = sample;
+      return;
+    }
+  }
+  device.coalesced_index = is_motion ? pending_data_.size() : -1;
+  pending_data_.push_back(sample);
+}
+
+void CoalescingPointerDataDispatcher::ResamplePendingData(
+    fml::TimePoint vsync_time) {
+  for (auto& [id, device] : devices_) {
+    // The move or hover being coalesced is always the last pending event of
+    // its device.
+    if (device.coalesced_index < 0 || !device.has_velocity) {
+      continue;
+    }
+    int64_t prediction = std::min(
+        (vsync_time - device.last_arrival).ToMicroseconds(),
+        kMaxPredictionMicros);
+    if (prediction <= 0) {
+      continue;
+    }
+    PointerData& data = pending_data_[device.coalesced_index];
+    device.prediction_offset_x = device.velocity_x * prediction;
+    device.prediction_offset_y = device.velocity_y * prediction;
+    data.time_stamp += prediction;
+    data.physical_x += device.prediction_offset_x;
+    data.physical_y += device.prediction_offset_y;
+    data.physical_delta_x += device.prediction_offset_x;
+    data.physical_delta_y += device.prediction_offset_y;
+  }
+}
+
+void CoalescingPointerDataDispatcher::DispatchPendingData() {
+  is_vsync_scheduled_ = false;
+  if (pending_data_.empty()) {
+    return;
+  }
+  TRACE_EVENT0("flutter",
+               "CoalescingPointerDataDispatcher::DispatchPendingData");
+  ResamplePendingData(fml::TimePoint::Now());
+
+  auto packet = std::make_unique<PointerDataPacket>(pending_data_.size());
+  for (size_t i = 0; i < pending_data_.size(); i++) {
+    packet->SetPointerData(i, pending_data_[i]);
+  }
+  pending_data_.clear();
+  for (auto it = devices_.begin(); it != devices_.end();) {
+    if (it->second.is_removed) {
+      it = devices_.erase(it);
+    } else {
+      it->second.coalesced_index = -1;
+      ++it;
+    }
+  }
+
+  // The packets merged into an earlier one end their flows here.
+  uint64_t trace_flow_id = pending_trace_flow_ids_.back();
+  pending_trace_flow_ids_.pop_back();
+  for (uint64_t merged_trace_flow_id : pending_trace_flow_ids_) {
+    TRACE_FLOW_END("flutter", "PointerEvent", merged_trace_flow_id);
+  }
+  pending_trace_flow_ids_.clear();
+  DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                               trace_flow_id);
+}
+
 }  // namespace flutter
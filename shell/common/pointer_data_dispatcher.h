@@ -5,6 +5,9 @@
 #ifndef POINTER_DATA_DISPATCHER_H_
 #define POINTER_DATA_DISPATCHER_H_
 
+#include <unordered_map>
+#include <vector>
+
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/shell/common/animator.h"
 
@@ -163,6 +166,74 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// A dispatcher that holds the pointer data received during a VSYNC interval
+/// and dispatches it in a single packet at the next VSYNC, with the
+/// consecutive move or hover events of each device coalesced into one.
+///
+/// Touch panels and mice that sample faster than the display refreshes
+/// deliver several moves per frame. Only the last position of each matters to
+/// the frame, but each one would otherwise be processed by the gesture
+/// recognizers of the framework. A coalesced event has the position, the time
+/// stamp and the other fields of the last event that it replaces, and the sum
+/// of their deltas. The downs, ups and other changes of a device, as well as
+/// the moves and hovers with different buttons, are never coalesced, so the
+/// order of the transitions of each device is unchanged.
+///
+/// The last coalesced position of each device is then resampled to the time
+/// of the VSYNC, extrapolated from the velocity of its last two samples by at
+/// most `kMaxPredictionMicros`. The deltas of the next event of the device
+/// are corrected so that they still add up to its position.
+class CoalescingPointerDataDispatcher : public DefaultPointerDataDispatcher {
+ public:
+  /// The longest that a position is extrapolated ahead of its sample.
+  static constexpr int64_t kMaxPredictionMicros = 8000;
+
+  explicit CoalescingPointerDataDispatcher(Delegate& delegate);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  virtual ~CoalescingPointerDataDispatcher();
+
+ private:
+  struct DeviceState {
+    // The index in |pending_data_| of the move or hover that the next one of
+    // the device is coalesced into, or -1.
+    int64_t coalesced_index = -1;
+    // The last sample of the device, and when it was received.
+    bool last_sample_is_motion = false;
+    bool is_removed = false;
+    int64_t last_time_stamp = 0;
+    double last_x = 0;
+    double last_y = 0;
+    fml::TimePoint last_arrival;
+    // The velocity in pixels per microsecond between the last two samples of
+    // the device, if they are consecutive moves or hovers.
+    bool has_velocity = false;
+    double velocity_x = 0;
+    double velocity_y = 0;
+    // The offset from its sample of the last position dispatched for the
+    // device, to take out of the delta of its next move or hover.
+    double prediction_offset_x = 0;
+    double prediction_offset_y = 0;
+  };
+
+  void AddPointerData(const PointerData& data, fml::TimePoint arrival);
+  void ResamplePendingData(fml::TimePoint vsync_time);
+  void DispatchPendingData();
+
+  std::vector<PointerData> pending_data_;
+  std::vector<uint64_t> pending_trace_flow_ids_;
+  std::unordered_map<int64_t, DeviceState> devices_;
+  bool is_vsync_scheduled_ = false;
+
+  // WeakPtrFactory must be the last member.
+  fml::WeakPtrFactory<CoalescingPointerDataDispatcher> weak_factory_;
+  FML_DISALLOW_COPY_AND_ASSIGN(CoalescingPointerDataDispatcher);
+};
+
 //--------------------------------------------------------------------------
 /// @brief      Signature for constructing PointerDataDispatcher.
 ///
@@ -0,0 +1,197 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_data_dispatcher.h"
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class FakeDelegate : public PointerDataDispatcher::Delegate {
+ public:
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    std::vector<PointerData> data;
+    const std::vector<uint8_t>& bytes = packet->data();
+    for (size_t offset = 0; offset < bytes.size();
+         offset += sizeof(PointerData)) {
+      PointerData record;
+      memcpy(&record, &bytes[offset], sizeof(PointerData));
+      data.push_back(record);
+    }
+    dispatched.push_back(data);
+    dispatched_trace_flow_ids.push_back(trace_flow_id);
+  }
+
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    vsync_callbacks.push_back(callback);
+  }
+
+  // Runs the secondary vsync callbacks that are scheduled so far.
+  void FireVsync() {
+    std::vector<fml::closure> callbacks;
+    callbacks.swap(vsync_callbacks);
+    for (const auto& callback : callbacks) {
+      callback();
+    }
+  }
+
+  std::vector<std::vector<PointerData>> dispatched;
+  std::vector<uint64_t> dispatched_trace_flow_ids;
+  std::vector<fml::closure> vsync_callbacks;
+};
+
+PointerData MakePointerData(PointerData::Change change,
+                            int64_t device,
+                            int64_t time_stamp,
+                            double x,
+                            double dx) {
+  PointerData data;
+  data.Clear();
+  data.time_stamp = time_stamp;
+  data.change = change;
+  data.kind = PointerData::DeviceKind::kTouch;
+  data.signal_kind = PointerData::SignalKind::kNone;
+  data.device = device;
+  data.physical_x = x;
+  data.physical_delta_x = dx;
+  return data;
+}
+
+std::unique_ptr<PointerDataPacket> MakePacket(
+    const std::vector<PointerData>& data) {
+  auto packet = std::make_unique<PointerDataPacket>(data.size());
+  for (size_t i = 0; i < data.size(); i++) {
+    packet->SetPointerData(i, data[i]);
+  }
+  return packet;
+}
+
+}  // namespace
+
+TEST(CoalescingPointerDataDispatcher, CoalescesMovesOfAFrame) {
+  FakeDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(delegate);
+
+  dispatcher.DispatchPacket(
+      MakePacket({MakePointerData(PointerData::Change::kDown, 0, 0, 0, 0),
+                  MakePointerData(PointerData::Change::kMove, 0, 0, 1, 1)}),
+      1);
+  dispatcher.DispatchPacket(
+      MakePacket({MakePointerData(PointerData::Change::kMove, 0, 0, 3, 2)}),
+      2);
+  dispatcher.DispatchPacket(
+      MakePacket({MakePointerData(PointerData::Change::kMove, 0, 0, 6, 3)}),
+      3);
+
+  ASSERT_EQ(delegate.vsync_callbacks.size(), 1u);
+  EXPECT_TRUE(delegate.dispatched.empty());
+  delegate.FireVsync();
+
+  ASSERT_EQ(delegate.dispatched.size(), 1u);
+  const std::vector<PointerData>& data = delegate.dispatched[0];
+  ASSERT_EQ(data.size(), 2u);
+  EXPECT_EQ(data[0].change, PointerData::Change::kDown);
+  EXPECT_EQ(data[1].change, PointerData::Change::kMove);
+  EXPECT_EQ(data[1].physical_x, 6);
+  EXPECT_EQ(data[1].physical_delta_x, 6);
+  EXPECT_EQ(delegate.dispatched_trace_flow_ids[0], 3u);
+}
+
+TEST(CoalescingPointerDataDispatcher, KeepsTransitionsInOrder) {
+  FakeDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(delegate);
+
+  dispatcher.DispatchPacket(
+      MakePacket({MakePointerData(PointerData::Change::kMove, 0, 0, 1, 1),
+                  MakePointerData(PointerData::Change::kUp, 0, 0, 1, 0),
+                  MakePointerData(PointerData::Change::kDown, 0, 0, 5, 0),
+                  MakePointerData(PointerData::Change::kMove, 0, 0, 6, 1),
+                  MakePointerData(PointerData::Change::kMove, 0, 0, 8, 2)}),
+      1);
+  delegate.FireVsync();
+
+  ASSERT_EQ(delegate.dispatched.size(), 1u);
+  const std::vector<PointerData>& data = delegate.dispatched[0];
+  ASSERT_EQ(data.size(), 4u);
+  EXPECT_EQ(data[0].change, PointerData::Change::kMove);
+  EXPECT_EQ(data[1].change, PointerData::Change::kUp);
+  EXPECT_EQ(data[2].change, PointerData::Change::kDown);
+  EXPECT_EQ(data[3].change, PointerData::Change::kMove);
+  EXPECT_EQ(data[3].physical_x, 8);
+  EXPECT_EQ(data[3].physical_delta_x, 3);
+}
+
+TEST(CoalescingPointerDataDispatcher, CoalescesEachDeviceSeparately) {
+  FakeDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(delegate);
+
+  dispatcher.DispatchPacket(
+      MakePacket({MakePointerData(PointerData::Change::kMove, 0, 0, 1, 1),
+                  MakePointerData(PointerData::Change::kMove, 1, 0, 10, 10),
+                  MakePointerData(PointerData::Change::kMove, 0, 0, 2, 1),
+                  MakePointerData(PointerData::Change::kMove, 1, 0, 20, 10)}),
+      1);
+  delegate.FireVsync();
+
+  ASSERT_EQ(delegate.dispatched.size(), 1u);
+  const std::vector<PointerData>& data = delegate.dispatched[0];
+  ASSERT_EQ(data.size(), 2u);
+  EXPECT_EQ(data[0].device, 0);
+  EXPECT_EQ(data[0].physical_x, 2);
+  EXPECT_EQ(data[0].physical_delta_x, 2);
+  EXPECT_EQ(data[1].device, 1);
+  EXPECT_EQ(data[1].physical_x, 20);
+  EXPECT_EQ(data[1].physical_delta_x, 20);
+}
+
+TEST(CoalescingPointerDataDispatcher, DoesNotCoalesceScrolls) {
+  FakeDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(delegate);
+  PointerData scroll = MakePointerData(PointerData::Change::kHover, 0, 0, 1, 0);
+  scroll.signal_kind = PointerData::SignalKind::kScroll;
+
+  dispatcher.DispatchPacket(MakePacket({scroll, scroll}), 1);
+  delegate.FireVsync();
+
+  ASSERT_EQ(delegate.dispatched.size(), 1u);
+  EXPECT_EQ(delegate.dispatched[0].size(), 2u);
+}
+
+TEST(CoalescingPointerDataDispatcher, PredictionIsTakenOutOfTheNextDelta) {
+  FakeDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(delegate);
+
+  // Moves at 1 pixel per millisecond.
+  dispatcher.DispatchPacket(
+      MakePacket({MakePointerData(PointerData::Change::kMove, 0, 0, 0, 0),
+                  MakePointerData(PointerData::Change::kMove, 0, 1000, 1, 1)}),
+      1);
+  delegate.FireVsync();
+  dispatcher.DispatchPacket(
+      MakePacket({MakePointerData(PointerData::Change::kMove, 0, 2000, 2, 1),
+                  MakePointerData(PointerData::Change::kUp, 0, 2000, 2, 0)}),
+      2);
+  delegate.FireVsync();
+
+  ASSERT_EQ(delegate.dispatched.size(), 2u);
+  const PointerData& predicted = delegate.dispatched[0][0];
+  EXPECT_GE(predicted.physical_x, 1);
+  EXPECT_LE(predicted.physical_x,
+            1 + CoalescingPointerDataDispatcher::kMaxPredictionMicros / 1000.0);
+  EXPECT_DOUBLE_EQ(predicted.physical_delta_x, predicted.physical_x);
+  const PointerData& next = delegate.dispatched[1][0];
+  EXPECT_EQ(next.physical_x, 2);
+  EXPECT_DOUBLE_EQ(predicted.physical_delta_x + next.physical_delta_x, 2);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -5,6 +5,7 @@
 #include "flutter/shell/common/rasterizer.h"
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <utility>
 
@@ -15,10 +16,10 @@
 #include "flutter/shell/common/serialization_callbacks.h"
 #include "fml/make_copyable.h"
 #include "third_party/skia/include/core/SkImageEncoder.h"
-#include "third_party/skia/include/core/SkPictureRecorder.h"
 #include "third_party/skia/include/core/SkSerialProcs.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/core/SkSurfaceCharacterization.h"
+#include "third_party/skia/include/core/SkTraceMemoryDump.h"
 #include "third_party/skia/include/utils/SkBase64.h"
 
 namespace flutter {
@@ -33,6 +34,10 @@ Rasterizer::Rasterizer(Delegate& delegate)
       user_override_resource_cache_bytes_(false),
       weak_factory_(this) {
   FML_DCHECK(compositor_context_);
+  // Release the memory of the images that the raster cache evicted to stay
+  // within its budget.
+  compositor_context_->raster_cache().SetOverBudgetCallback(
+      [this]() { NotifyLowMemoryWarning(); });
 }
 
 Rasterizer::~Rasterizer() = default;
@@ -49,6 +54,17 @@ fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> Rasterizer::GetSnapshotDelegate()
 void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
   surface_ = std::move(surface);
 
+#if !FLUTTER_RELEASE
+  // The GPU time of frames is shown in the timeline and the performance
+  // overlay, next to the raster time.
+  surface_->EnableGpuTiming(
+      [rasterizer = weak_factory_.GetWeakPtr()](fml::TimeDelta gpu_time) {
+        if (rasterizer) {
+          rasterizer->compositor_context_->RecordGpuTime(gpu_time);
+        }
+      });
+#endif  // !FLUTTER_RELEASE
+
   if (max_cache_bytes_.has_value()) {
     SetResourceCacheMaxBytes(max_cache_bytes_.value(),
                              user_override_resource_cache_bytes_);
@@ -59,6 +75,18 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
     compositor_context_->OnGrContextCreated();
   }
 
+  DrawPendingGlyphWarmUps();
+
+  if (PersistentCache::prioritize_sksl_precompilation()) {
+    // The first frame is drawn in between the precompilation tasks.
+    delegate_.GetTaskRunners().GetRasterTaskRunner()->PostTask(
+        [rasterizer = weak_factory_.GetWeakPtr()]() {
+          if (rasterizer) {
+            rasterizer->PrecompilePendingSkSLs();
+          }
+        });
+  }
+
   if (external_view_embedder_ &&
       external_view_embedder_->SupportsDynamicThreadMerging() &&
       !raster_thread_merger_) {
@@ -79,6 +107,67 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
   }
 }
 
+void Rasterizer::PrecompilePendingSkSLs() {
+  TRACE_EVENT0("flutter", "Rasterizer::PrecompilePendingSkSLs");
+  if (!surface_ || !surface_->GetContext()) {
+    return;
+  }
+  auto context_switch = surface_->MakeRenderContextCurrent();
+  if (!context_switch->GetResult()) {
+    return;
+  }
+  fml::TimeDelta budget = fml::TimeDelta::FromMicroseconds(
+      delegate_.GetFrameBudget().count() * 1000 / 4);
+  if (!PersistentCache::GetCacheForProcess()->PrecompilePendingSkSLs(
+          surface_->GetContext(), budget)) {
+    return;
+  }
+  delegate_.GetTaskRunners().GetRasterTaskRunner()->PostTask(
+      [rasterizer = weak_factory_.GetWeakPtr()]() {
+        if (rasterizer) {
+          rasterizer->PrecompilePendingSkSLs();
+        }
+      });
+}
+
+void Rasterizer::WarmUpGlyphs(std::vector<sk_sp<SkPicture>> pictures) {
+  for (auto& picture : pictures) {
+    pending_glyph_warm_ups_.push_back(std::move(picture));
+  }
+  DrawPendingGlyphWarmUps();
+}
+
+void Rasterizer::DrawPendingGlyphWarmUps() {
+  if (pending_glyph_warm_ups_.empty() || !surface_ ||
+      !surface_->GetContext()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "Rasterizer::DrawPendingGlyphWarmUps");
+  auto context_switch = surface_->MakeRenderContextCurrent();
+  if (!context_switch->GetResult()) {
+    return;
+  }
+  GrDirectContext* context = surface_->GetContext();
+  for (const auto& picture : pending_glyph_warm_ups_) {
+    SkIRect bounds = picture->cullRect().roundOut();
+    if (bounds.isEmpty()) {
+      continue;
+    }
+    // The glyph atlas belongs to the context, so the glyphs drawn into this
+    // surface stay in it after the surface is gone.
+    auto surface = SkSurface::MakeRenderTarget(
+        context, SkBudgeted::kNo,
+        SkImageInfo::MakeN32Premul(bounds.width(), bounds.height()));
+    if (!surface) {
+      continue;
+    }
+    surface->getCanvas()->translate(-bounds.left(), -bounds.top());
+    surface->getCanvas()->drawPicture(picture);
+    surface->flushAndSubmit();
+  }
+  pending_glyph_warm_ups_.clear();
+}
+
 void Rasterizer::TeardownExternalViewEmbedder() {
   if (external_view_embedder_) {
     external_view_embedder_->Teardown();
@@ -92,6 +181,10 @@ void Rasterizer::Teardown() {
     compositor_context_->OnGrContextDestroyed();
   }
 
+  if (surface_ && surface_->GetContext()) {
+    PersistentCache::GetCacheForProcess()->DiscardPendingSkSLs(
+        surface_->GetContext());
+  }
   surface_.reset();
   last_layer_tree_.reset();
 
@@ -134,6 +227,20 @@ void Rasterizer::NotifyLowMemoryWarning() const {
   context->performDeferredCleanup(std::chrono::milliseconds(0));
 }
 
+size_t Rasterizer::GetOverlaySurfaceBytes() const {
+  if (!external_view_embedder_) {
+    return 0;
+  }
+  return external_view_embedder_->GetOverlaySurfaceBytes();
+}
+
+size_t Rasterizer::DestroySpareOverlaySurfaces() {
+  if (!external_view_embedder_) {
+    return 0;
+  }
+  return external_view_embedder_->DestroySpareOverlaySurfaces();
+}
+
 flutter::TextureRegistry* Rasterizer::GetTextureRegistry() {
   return &compositor_context_->texture_registry();
 }
@@ -142,6 +249,102 @@ flutter::LayerTree* Rasterizer::GetLastLayerTree() {
   return last_layer_tree_.get();
 }
 
+void Rasterizer::DamageStatisticsTotals::Add(
+    const DamageStatistics& statistics) {
+  frame_count++;
+  damage_area += statistics.damage_area;
+  frame_area += statistics.frame_area;
+  diffed_layers += statistics.diffed_layers;
+  retained_layers += statistics.retained_layers;
+  compute_damage_time = compute_damage_time + statistics.compute_damage_time;
+  max_compute_damage_time =
+      std::max(max_compute_damage_time, statistics.compute_damage_time);
+}
+
+namespace {
+
+// Sums up the sizes of the resources that a GrContext dumps by their type and
+// category.
+class ResourceBytesDump : public SkTraceMemoryDump {
+ public:
+  void dumpNumericValue(const char* dump_name,
+                        const char* value_name,
+                        const char* units,
+                        uint64_t value) override {
+    if (strcmp(value_name, "size") == 0) {
+      resources_[dump_name].bytes += value;
+    } else if (strcmp(value_name, "purgeable_size") == 0) {
+      resources_[dump_name].purgeable_bytes += value;
+    }
+  }
+
+  void dumpStringValue(const char* dump_name,
+                       const char* value_name,
+                       const char* value) override {
+    if (strcmp(value_name, "type") == 0) {
+      resources_[dump_name].type = value;
+    } else if (strcmp(value_name, "category") == 0) {
+      resources_[dump_name].category = value;
+    }
+  }
+
+  void setMemoryBacking(const char* dump_name,
+                        const char* backing_type,
+                        const char* backing_object_id) override {}
+
+  void setDiscardableMemoryBacking(
+      const char* dump_name,
+      const SkDiscardableMemory& discardable_memory_object) override {}
+
+  LevelOfDetail getRequestedDetails() const override {
+    return SkTraceMemoryDump::kObjectsBreakdowns_LevelOfDetail;
+  }
+
+  bool shouldDumpWrappedObjects() const override { return true; }
+
+  void AddTo(Rasterizer::GpuMemoryUsage& usage) const {
+    for (const auto& [name, resource] : resources_) {
+      usage.skia_bytes_by_type[resource.type] += resource.bytes;
+      usage.skia_bytes_by_category[resource.category] += resource.bytes;
+      usage.skia_total_bytes += resource.bytes;
+      usage.skia_purgeable_bytes += resource.purgeable_bytes;
+    }
+  }
+
+ private:
+  struct Resource {
+    std::string type = "Other";
+    std::string category = "Other";
+    size_t bytes = 0;
+    size_t purgeable_bytes = 0;
+  };
+
+  std::map<std::string, Resource> resources_;
+};
+
+}  // namespace
+
+Rasterizer::GpuMemoryUsage Rasterizer::GetGpuMemoryUsage() const {
+  FML_DCHECK(delegate_.GetTaskRunners()
+                 .GetRasterTaskRunner()
+                 ->RunsTasksOnCurrentThread());
+  GpuMemoryUsage usage;
+  usage.raster_cache_entries =
+      compositor_context_->raster_cache().GetEntryInfos();
+  if (surface_ && surface_->GetContext()) {
+    ResourceBytesDump dump;
+    surface_->GetContext()->dumpMemoryStatistics(&dump);
+    dump.AddTo(usage);
+  }
+  usage.external_texture_bytes =
+      compositor_context_->texture_registry().GetMemoryBytes();
+  if (external_view_embedder_) {
+    usage.overlay_surface_bytes =
+        external_view_embedder_->GetOverlaySurfaceBytes();
+  }
+  return usage;
+}
+
 void Rasterizer::DrawLastLayerTree(
     std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
   if (!last_layer_tree_ || !surface_) {
@@ -177,6 +380,9 @@ RasterStatus Rasterizer::Draw(
       frame_timings_recorder->CloneUntil(
           FrameTimingsRecorder::State::kBuildEnd);
 
+  last_pipeline_statistics_ = {pipeline->GetDepth(),
+                               pipeline->GetInflightCount()};
+
   RasterStatus raster_status = RasterStatus::kFailed;
   Pipeline<flutter::LayerTree>::Consumer consumer =
       [&](std::unique_ptr<LayerTree> layer_tree) {
@@ -214,7 +420,7 @@ RasterStatus Rasterizer::Draw(
   // between successive tries.
   switch (consume_result) {
     case PipelineConsumeResult::MoreAvailable: {
-      delegate_.GetTaskRunners().GetRasterTaskRunner()->PostTask(
+      delegate_.GetTaskRunners().GetRasterTaskRunner()->PostTaskWithPriority(
           fml::MakeCopyable(
               [weak_this = weak_factory_.GetWeakPtr(), pipeline,
                resubmit_recorder = std::move(resubmit_recorder),
@@ -223,7 +429,8 @@ RasterStatus Rasterizer::Draw(
                   weak_this->Draw(std::move(resubmit_recorder), pipeline,
                                   std::move(discard_callback));
                 }
-              }));
+              }),
+          fml::TaskPriority::kFrame);
       break;
     }
     default:
@@ -268,6 +475,38 @@ sk_sp<SkImage> DrawSnapshot(
 
   return nullptr;
 }
+
+// Makes a GPU render target for a snapshot, scaled down to the maximum render
+// target size of |context| if necessary, with its canvas scaled to match.
+sk_sp<SkSurface> MakeSnapshotRenderTarget(GrRecordingContext* context,
+                                          SkImageInfo image_info) {
+  auto max_size = context->maxRenderTargetSize();
+  double scale_factor = std::min(
+      1.0, static_cast<double>(max_size) /
+               static_cast<double>(
+                   std::max(image_info.width(), image_info.height())));
+
+  // Scale down the render target size to the max supported by the GPU if
+  // necessary. Exceeding the max would otherwise cause a null result.
+  if (scale_factor < 1.0) {
+    image_info = image_info.makeWH(
+        static_cast<double>(image_info.width()) * scale_factor,
+        static_cast<double>(image_info.height()) * scale_factor);
+  }
+
+  sk_sp<SkSurface> sk_surface =
+      SkSurface::MakeRenderTarget(context,          // context
+                                  SkBudgeted::kNo,  // budgeted
+                                  image_info        // image info
+      );
+  if (!sk_surface) {
+    FML_LOG(ERROR) << "DoMakeRasterSnapshot can not create GPU render target";
+    return nullptr;
+  }
+
+  sk_surface->getCanvas()->scale(scale_factor, scale_factor);
+  return sk_surface;
+}
 }  // namespace
 
 sk_sp<SkImage> Rasterizer::DoMakeRasterSnapshot(
@@ -309,36 +548,14 @@ sk_sp<SkImage> Rasterizer::DoMakeRasterSnapshot(
                 return;
               }
 
-              GrRecordingContext* context = snapshot_surface->GetContext();
-              auto max_size = context->maxRenderTargetSize();
-              double scale_factor = std::min(
-                  1.0, static_cast<double>(max_size) /
-                           static_cast<double>(std::max(image_info.width(),
-                                                        image_info.height())));
-
-              // Scale down the render target size to the max supported by the
-              // GPU if necessary. Exceeding the max would otherwise cause a
-              // null result.
-              if (scale_factor < 1.0) {
-                image_info = image_info.makeWH(
-                    static_cast<double>(image_info.width()) * scale_factor,
-                    static_cast<double>(image_info.height()) * scale_factor);
-              }
-
               // When there is an on screen surface, we need a render target
               // SkSurface because we want to access texture backed images.
-              sk_sp<SkSurface> sk_surface =
-                  SkSurface::MakeRenderTarget(context,          // context
-                                              SkBudgeted::kNo,  // budgeted
-                                              image_info        // image info
-                  );
+              sk_sp<SkSurface> sk_surface = MakeSnapshotRenderTarget(
+                  snapshot_surface->GetContext(), image_info);
               if (!sk_surface) {
-                FML_LOG(ERROR)
-                    << "DoMakeRasterSnapshot can not create GPU render target";
                 return;
               }
 
-              sk_surface->getCanvas()->scale(scale_factor, scale_factor);
               result = DrawSnapshot(sk_surface, draw_callback);
             }));
   }
@@ -396,11 +613,18 @@ RasterStatus Rasterizer::DoDraw(
     return RasterStatus::kFailed;
   }
 
+  if (MergeThreadsAheadOfFrame(*layer_tree)) {
+    resubmitted_layer_tree_ = std::move(layer_tree);
+    return RasterStatus::kSkipAndRetry;
+  }
+
   PersistentCache* persistent_cache = PersistentCache::GetCacheForProcess();
   persistent_cache->ResetStoredNewShaders();
 
   RasterStatus raster_status =
-      DrawToSurface(*frame_timings_recorder, *layer_tree);
+      SkipUnchangedFrame(*frame_timings_recorder, *layer_tree)
+          ? RasterStatus::kSuccess
+          : DrawToSurface(*frame_timings_recorder, *layer_tree);
   if (raster_status == RasterStatus::kSuccess) {
     last_layer_tree_ = std::move(layer_tree);
   } else if (ShouldResubmitFrame(raster_status)) {
@@ -417,6 +641,17 @@ RasterStatus Rasterizer::DoDraw(
     persistent_cache->DumpSkp(*screenshot.data);
   }
 
+  // Skia only hands the Vulkan pipeline cache to the persistent cache when
+  // asked to, so ask whenever the frame compiled new pipelines. The data is
+  // written to disk on a worker task runner and reloaded on the next launch.
+  if (persistent_cache->StoredNewShaders()) {
+    GrDirectContext* context = surface_->GetContext();
+    if (context && context->backend() == GrBackendApi::kVulkan) {
+      TRACE_EVENT0("flutter", "Rasterizer::StoreVkPipelineCacheData");
+      context->storeVkPipelineCacheData();
+    }
+  }
+
   // TODO(liyuqian): in Fuchsia, the rasterization doesn't finish when
   // Rasterizer::DoDraw finishes. Future work is needed to adapt the timestamp
   // for Fuchsia to capture SceneUpdateContext::ExecutePaintTasks.
@@ -482,6 +717,50 @@ RasterStatus Rasterizer::DoDraw(
   return raster_status;
 }
 
+bool Rasterizer::MergeThreadsAheadOfFrame(
+    const flutter::LayerTree& layer_tree) {
+  if (!layer_tree.has_platform_view() || !raster_thread_merger_ ||
+      raster_thread_merger_->IsMerged()) {
+    return false;
+  }
+  TRACE_EVENT0("flutter", "Rasterizer::MergeThreadsAheadOfFrame");
+  // The external view embedder extends the lease once it prerolls the tree
+  // on the platform thread.
+  raster_thread_merger_->MergeWithLease(1);
+  return raster_thread_merger_->IsMerged();
+}
+
+bool Rasterizer::SkipUnchangedFrame(
+    FrameTimingsRecorder& frame_timings_recorder,
+    flutter::LayerTree& layer_tree) {
+  // The external view embedder composites the platform views on every frame,
+  // so the frames with platform views are always drawn.
+  if (!last_layer_tree_ || !surface_->AllowsSkippingUnchangedFrames() ||
+      layer_tree.has_platform_view() || last_layer_tree_->has_platform_view() ||
+      layer_tree.frame_size() != last_layer_tree_->frame_size() ||
+      layer_tree.device_pixel_ratio() !=
+          last_layer_tree_->device_pixel_ratio()) {
+    return false;
+  }
+  TRACE_EVENT0("flutter", "Rasterizer::SkipUnchangedFrame");
+
+  // The texture layers always damage their bounds, as their content may
+  // change without the tree changing.
+  FrameDamage damage;
+  damage.SetPreviousLayerTree(last_layer_tree_.get());
+  damage.ComputeClipRect(layer_tree);
+  std::optional<SkIRect> frame_damage = damage.GetFrameDamage();
+  if (!frame_damage || !frame_damage->isEmpty()) {
+    return false;
+  }
+
+  frame_timings_recorder.RecordRasterStart(fml::TimePoint::Now());
+  frame_timings_recorder.RecordRasterSkipped();
+  frame_timings_recorder.RecordRasterEnd(&compositor_context_->raster_cache());
+  FireNextFrameCallbackIfPresent();
+  return true;
+}
+
 RasterStatus Rasterizer::DrawToSurface(
     FrameTimingsRecorder& frame_timings_recorder,
     flutter::LayerTree& layer_tree) {
@@ -556,21 +835,30 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
     compositor_context_->raster_cache().PrepareNewFrame();
     frame_timings_recorder.RecordRasterStart(fml::TimePoint::Now());
 
+    // Disable partial repaint if external_view_embedder_ SubmitFrame is
+    // involved - ExternalViewEmbedder unconditionally clears the entire
+    // surface and also partial repaint with platform view present is
+    // something that still need to be figured out.
+    bool force_full_repaint =
+        external_view_embedder_ &&
+        (!raster_thread_merger_ || raster_thread_merger_->IsMerged());
+
     std::unique_ptr<FrameDamage> damage;
     if (frame->framebuffer_info().supports_partial_repaint) {
-      // Disable partial repaint if external_view_embedder_ SubmitFrame is
-      // involved - ExternalViewEmbedder unconditionally clears the entire
-      // surface and also partial repaint with platform view present is
-      // something that still need to be figured out.
-      bool force_full_repaint =
-          external_view_embedder_ &&
-          (!raster_thread_merger_ || raster_thread_merger_->IsMerged());
-
       damage = std::make_unique<FrameDamage>();
       if (frame->framebuffer_info().existing_damage && !force_full_repaint) {
         damage->SetPreviousLayerTree(last_layer_tree_.get());
         damage->AddAdditonalDamage(*frame->framebuffer_info().existing_damage);
       }
+    } else if ((force_full_repaint &&
+                external_view_embedder_->UsesFrameDamage()) ||
+               surface_->AllowsSkippingUnchangedFrames()) {
+      // The whole frame is still repainted, but its damage is computed for the
+      // external view embedder, and the paint regions of the tree are
+      // computed so that the next frame can be diffed against it.
+      damage = std::make_unique<FrameDamage>();
+      damage->SetPreviousLayerTree(last_layer_tree_.get());
+      damage->AddAdditonalDamage(SkIRect::MakeSize(layer_tree.frame_size()));
     }
 
     RasterStatus raster_status =
@@ -584,6 +872,11 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
     if (damage) {
       submit_info.frame_damage = damage->GetFrameDamage();
       submit_info.buffer_damage = damage->GetBufferDamage();
+      std::optional<DamageStatistics> statistics = damage->GetStatistics();
+      if (statistics && frame->framebuffer_info().supports_partial_repaint) {
+        frame_timings_recorder.RecordDamageStatistics(*statistics);
+        damage_statistics_totals_.Add(*statistics);
+      }
     }
 
     frame->set_submit_info(submit_info);
@@ -613,24 +906,20 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
   return RasterStatus::kFailed;
 }
 
-static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
+static sk_sp<SkPicture> FlattenLayerTreeForScreenshot(
     flutter::LayerTree* tree,
-    flutter::CompositorContext& compositor_context) {
+    flutter::DisplayListPictureCache& picture_cache,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& task_runner) {
   FML_DCHECK(tree != nullptr);
-  SkPictureRecorder recorder;
-  recorder.beginRecording(
-      SkRect::MakeWH(tree->frame_size().width(), tree->frame_size().height()));
-
-  SkMatrix root_surface_transformation;
-  root_surface_transformation.reset();
 
   // TODO(amirh): figure out how to take a screenshot with embedded UIView.
   // https://github.com/flutter/flutter/issues/23435
-  auto frame = compositor_context.AcquireFrame(
-      nullptr, recorder.getRecordingCanvas(), nullptr,
-      root_surface_transformation, false, true, nullptr);
-  frame->Raster(*tree, true, nullptr);
+  return tree->Flatten(
+      SkRect::MakeWH(tree->frame_size().width(), tree->frame_size().height()),
+      &picture_cache, task_runner);
+}
 
+static sk_sp<SkData> SerializeScreenshotPicture(const SkPicture& picture) {
 #if defined(OS_FUCHSIA)
   SkSerialProcs procs = {0};
   procs.fImageProc = SerializeImageWithoutData;
@@ -640,7 +929,26 @@ static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
   procs.fTypefaceProc = SerializeTypefaceWithData;
 #endif
 
-  return recorder.finishRecordingAsPicture()->serialize(&procs);
+  return picture.serialize(&procs);
+}
+
+static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
+    flutter::LayerTree* tree,
+    flutter::DisplayListPictureCache& picture_cache,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& task_runner) {
+  sk_sp<SkPicture> picture =
+      FlattenLayerTreeForScreenshot(tree, picture_cache, task_runner);
+  if (!picture) {
+    return nullptr;
+  }
+  return SerializeScreenshotPicture(*picture);
+}
+
+static sk_sp<SkData> Base64EncodeScreenshot(const SkData& data) {
+  size_t b64_size = SkBase64::Encode(data.data(), data.size(), nullptr);
+  auto b64_data = SkData::MakeUninitialized(b64_size);
+  SkBase64::Encode(data.data(), data.size(), b64_data->writable_data());
+  return b64_data;
 }
 
 static sk_sp<SkSurface> CreateSnapshotSurface(GrDirectContext* surface_context,
@@ -661,11 +969,10 @@ static sk_sp<SkSurface> CreateSnapshotSurface(GrDirectContext* surface_context,
   return SkSurface::MakeRaster(image_info);
 }
 
-sk_sp<SkData> Rasterizer::ScreenshotLayerTreeAsImage(
+sk_sp<SkSurface> Rasterizer::DrawLayerTreeToSnapshotSurface(
     flutter::LayerTree* tree,
     flutter::CompositorContext& compositor_context,
-    GrDirectContext* surface_context,
-    bool compressed) {
+    GrDirectContext* surface_context) {
   // Attempt to create a snapshot surface depending on whether we have access to
   // a valid GPU rendering context.
   auto snapshot_surface =
@@ -683,6 +990,20 @@ sk_sp<SkData> Rasterizer::ScreenshotLayerTreeAsImage(
   SkMatrix root_surface_transformation;
   root_surface_transformation.reset();
 
+  auto frame = compositor_context.AcquireFrame(surface_context, canvas, nullptr,
+                                               root_surface_transformation,
+                                               false, true, nullptr);
+  canvas->clear(SK_ColorTRANSPARENT);
+  frame->Raster(*tree, true, nullptr);
+  canvas->flush();
+  return snapshot_surface;
+}
+
+sk_sp<SkData> Rasterizer::ScreenshotLayerTreeAsImage(
+    flutter::LayerTree* tree,
+    flutter::CompositorContext& compositor_context,
+    GrDirectContext* surface_context,
+    bool compressed) {
   // snapshot_surface->makeImageSnapshot needs the GL context to be set if the
   // render context is GL. frame->Raster() pops the gl context in platforms that
   // gl context switching are used. (For example, older iOS that uses GL) We
@@ -693,12 +1014,11 @@ sk_sp<SkData> Rasterizer::ScreenshotLayerTreeAsImage(
     return nullptr;
   }
 
-  auto frame = compositor_context.AcquireFrame(surface_context, canvas, nullptr,
-                                               root_surface_transformation,
-                                               false, true, nullptr);
-  canvas->clear(SK_ColorTRANSPARENT);
-  frame->Raster(*tree, true, nullptr);
-  canvas->flush();
+  auto snapshot_surface =
+      DrawLayerTreeToSnapshotSurface(tree, compositor_context, surface_context);
+  if (snapshot_surface == nullptr) {
+    return nullptr;
+  }
 
   // Prepare an image from the surface, this image may potentially be on th GPU.
   auto potentially_gpu_snapshot = snapshot_surface->makeImageSnapshot();
@@ -745,7 +1065,9 @@ Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
 
   switch (type) {
     case ScreenshotType::SkiaPicture:
-      data = ScreenshotLayerTreeAsPicture(layer_tree, *compositor_context_);
+      data = ScreenshotLayerTreeAsPicture(
+          layer_tree, display_list_picture_cache_,
+          delegate_.GetConcurrentWorkerTaskRunner());
       break;
     case ScreenshotType::UncompressedImage:
       data = ScreenshotLayerTreeAsImage(layer_tree, *compositor_context_,
@@ -763,15 +1085,284 @@ Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
   }
 
   if (base64_encode) {
-    size_t b64_size = SkBase64::Encode(data->data(), data->size(), nullptr);
-    auto b64_data = SkData::MakeUninitialized(b64_size);
-    SkBase64::Encode(data->data(), data->size(), b64_data->writable_data());
-    return Rasterizer::Screenshot{b64_data, layer_tree->frame_size()};
+    return Rasterizer::Screenshot{Base64EncodeScreenshot(*data),
+                                  layer_tree->frame_size()};
   }
 
   return Rasterizer::Screenshot{data, layer_tree->frame_size()};
 }
 
+namespace {
+
+// The state of an asynchronous screenshot readback, owned by the readback
+// callback.
+struct ScreenshotReadback {
+  // Called on the raster thread when the readback completes.
+  fml::closure on_complete;
+  std::shared_ptr<fml::ConcurrentTaskRunner> worker;
+  SkImageInfo image_info;
+  bool compressed;
+  bool base64_encode;
+  Rasterizer::ScreenshotCallback callback;
+};
+
+// The state of an asynchronous snapshot readback, owned by the readback
+// callback.
+struct SnapshotReadback {
+  // Called on the raster thread when the readback completes.
+  fml::closure on_complete;
+  SkImageInfo image_info;
+  SnapshotDelegate::RasterSnapshotCallback callback;
+};
+
+// How often the raster thread checks whether the GPU has finished the
+// pending screenshot and snapshot readbacks.
+constexpr fml::TimeDelta kScreenshotReadbackPollInterval =
+    fml::TimeDelta::FromMilliseconds(4);
+
+}  // namespace
+
+static void EncodeScreenshotAsync(
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker,
+    SkISize frame_size,
+    bool base64_encode,
+    std::function<sk_sp<SkData>()> encode,
+    Rasterizer::ScreenshotCallback callback) {
+  auto task = [frame_size, base64_encode, encode = std::move(encode),
+               callback = std::move(callback)]() {
+    TRACE_EVENT0("flutter", "Rasterizer::EncodeScreenshot");
+    sk_sp<SkData> data = encode();
+    if (data == nullptr) {
+      FML_LOG(ERROR) << "Screenshot data was null.";
+      callback({});
+      return;
+    }
+    if (base64_encode) {
+      data = Base64EncodeScreenshot(*data);
+    }
+    callback(Rasterizer::Screenshot{data, frame_size});
+  };
+  if (worker) {
+    worker->PostTask(std::move(task));
+  } else {
+    task();
+  }
+}
+
+// Copies the pixels of a readback into tightly packed rows.
+//
+// The result may map a GPU transfer buffer, which must be released on the
+// raster thread, so the pixels are copied out before they are used elsewhere.
+static sk_sp<SkData> CopyReadbackPixels(
+    const SkImageInfo& info,
+    const SkSurface::AsyncReadResult& result) {
+  const size_t row_bytes = info.minRowBytes();
+  sk_sp<SkData> pixels = SkData::MakeUninitialized(info.computeMinByteSize());
+  const auto* src = static_cast<const uint8_t*>(result.data(0));
+  auto* dst = static_cast<uint8_t*>(pixels->writable_data());
+  for (int y = 0; y < info.height(); y++) {
+    memcpy(dst + y * row_bytes, src + y * result.rowBytes(0), row_bytes);
+  }
+  return pixels;
+}
+
+// Runs on the raster thread once the pixels of the snapshot surface have
+// been read back, or the readback has failed.
+static void OnScreenshotReadback(
+    SkSurface::ReadPixelsContext context,
+    std::unique_ptr<const SkSurface::AsyncReadResult> result) {
+  std::unique_ptr<ScreenshotReadback> readback(
+      static_cast<ScreenshotReadback*>(context));
+  readback->on_complete();
+  if (!result || result->count() != 1) {
+    FML_LOG(ERROR) << "Screenshot: unable to read back the pixels";
+    readback->callback({});
+    return;
+  }
+
+  // Only the copy of the pixels is encoded on the worker.
+  const SkImageInfo& info = readback->image_info;
+  sk_sp<SkData> pixels = CopyReadbackPixels(info, *result);
+
+  std::function<sk_sp<SkData>()> encode;
+  if (readback->compressed) {
+    encode = [info, pixels]() -> sk_sp<SkData> {
+      sk_sp<SkImage> image =
+          SkImage::MakeRasterData(info, pixels, info.minRowBytes());
+      return image ? image->encodeToData() : nullptr;
+    };
+  } else {
+    encode = [pixels]() { return pixels; };
+  }
+  EncodeScreenshotAsync(std::move(readback->worker), info.dimensions(),
+                        readback->base64_encode, std::move(encode),
+                        std::move(readback->callback));
+}
+
+void Rasterizer::ScreenshotLastLayerTreeAsync(ScreenshotType type,
+                                              bool base64_encode,
+                                              ScreenshotCallback callback) {
+  TRACE_EVENT0("flutter", "Rasterizer::ScreenshotLastLayerTreeAsync");
+  auto* layer_tree = GetLastLayerTree();
+  if (layer_tree == nullptr) {
+    FML_LOG(ERROR) << "Last layer tree was null when screenshotting.";
+    callback({});
+    return;
+  }
+  auto worker = delegate_.GetConcurrentWorkerTaskRunner();
+
+  if (type == ScreenshotType::SkiaPicture) {
+    // The picture only records the layer tree, and it is serialized on the
+    // worker.
+    sk_sp<SkPicture> picture = FlattenLayerTreeForScreenshot(
+        layer_tree, display_list_picture_cache_, worker);
+    if (!picture) {
+      FML_LOG(ERROR) << "Screenshot data was null.";
+      callback({});
+      return;
+    }
+    EncodeScreenshotAsync(
+        worker, layer_tree->frame_size(), base64_encode,
+        [picture]() { return SerializeScreenshotPicture(*picture); },
+        std::move(callback));
+    return;
+  }
+
+  if (!surface_) {
+    FML_LOG(ERROR) << "Screenshot: unable to make image screenshot";
+    callback({});
+    return;
+  }
+  auto context_switch = surface_->MakeRenderContextCurrent();
+  if (!context_switch->GetResult()) {
+    FML_LOG(ERROR) << "Screenshot: unable to make image screenshot";
+    callback({});
+    return;
+  }
+  GrDirectContext* surface_context = surface_->GetContext();
+  auto snapshot_surface = DrawLayerTreeToSnapshotSurface(
+      layer_tree, *compositor_context_, surface_context);
+  if (snapshot_surface == nullptr) {
+    callback({});
+    return;
+  }
+
+  const SkImageInfo& image_info = snapshot_surface->imageInfo();
+  auto on_complete = [rasterizer = weak_factory_.GetWeakPtr()]() {
+    if (rasterizer) {
+      rasterizer->pending_screenshot_readbacks_--;
+    }
+  };
+  auto readback = std::make_unique<ScreenshotReadback>(ScreenshotReadback{
+      std::move(on_complete), std::move(worker), image_info,
+      type == ScreenshotType::CompressedImage, base64_encode,
+      std::move(callback)});
+  pending_screenshot_readbacks_++;
+  // On raster surfaces, the callback runs before this returns.
+  snapshot_surface->asyncRescaleAndReadPixels(
+      image_info, SkIRect::MakeSize(image_info.dimensions()),
+      SkSurface::RescaleGamma::kSrc, SkImage::RescaleMode::kNearest,
+      OnScreenshotReadback, readback.release());
+  if (surface_context) {
+    surface_context->submit();
+  }
+  PollScreenshotReadbacks();
+}
+
+// Runs on the raster thread once the pixels of a raster snapshot have been
+// read back, or the readback has failed.
+static void OnSnapshotReadback(
+    SkSurface::ReadPixelsContext context,
+    std::unique_ptr<const SkSurface::AsyncReadResult> result) {
+  std::unique_ptr<SnapshotReadback> readback(
+      static_cast<SnapshotReadback*>(context));
+  readback->on_complete();
+  if (!result || result->count() != 1) {
+    FML_LOG(ERROR) << "Snapshot: unable to read back the pixels";
+    readback->callback(nullptr);
+    return;
+  }
+
+  const SkImageInfo& info = readback->image_info;
+  readback->callback(SkImage::MakeRasterData(
+      info, CopyReadbackPixels(info, *result), info.minRowBytes()));
+}
+
+void Rasterizer::MakeRasterSnapshotAsync(
+    std::function<void(SkCanvas*)> draw_callback,
+    SkISize picture_size,
+    RasterSnapshotCallback callback) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+
+  // Only snapshots drawn with the context of the on screen surface are read
+  // back asynchronously, as that context is polled for the completion of the
+  // readbacks. The others are made synchronously.
+  bool started = false;
+  if (surface_ && surface_->GetContext()) {
+    delegate_.GetIsGpuDisabledSyncSwitch()->Execute(
+        fml::SyncSwitch::Handlers().SetIfFalse([&] {
+          auto context_switch = surface_->MakeRenderContextCurrent();
+          if (!context_switch->GetResult()) {
+            return;
+          }
+          GrDirectContext* context = surface_->GetContext();
+          sk_sp<SkSurface> sk_surface = MakeSnapshotRenderTarget(
+              context,
+              SkImageInfo::MakeN32Premul(picture_size.width(),
+                                         picture_size.height(),
+                                         SkColorSpace::MakeSRGB()));
+          if (!sk_surface) {
+            return;
+          }
+          draw_callback(sk_surface->getCanvas());
+
+          const SkImageInfo& image_info = sk_surface->imageInfo();
+          auto on_complete = [rasterizer = weak_factory_.GetWeakPtr()]() {
+            if (rasterizer) {
+              rasterizer->pending_screenshot_readbacks_--;
+            }
+          };
+          auto readback = std::make_unique<SnapshotReadback>(SnapshotReadback{
+              std::move(on_complete), image_info, std::move(callback)});
+          pending_screenshot_readbacks_++;
+          sk_surface->asyncRescaleAndReadPixels(
+              image_info, SkIRect::MakeSize(image_info.dimensions()),
+              SkSurface::RescaleGamma::kSrc, SkImage::RescaleMode::kNearest,
+              OnSnapshotReadback, readback.release());
+          context->submit();
+          started = true;
+        }));
+  }
+
+  if (!started) {
+    callback(DoMakeRasterSnapshot(picture_size, std::move(draw_callback)));
+    return;
+  }
+  PollScreenshotReadbacks();
+}
+
+void Rasterizer::PollScreenshotReadbacks() {
+  if (pending_screenshot_readbacks_ == 0 || !surface_) {
+    return;
+  }
+  {
+    auto context_switch = surface_->MakeRenderContextCurrent();
+    if (context_switch->GetResult() && surface_->GetContext()) {
+      surface_->GetContext()->checkAsyncWorkCompletion();
+    }
+  }
+  if (pending_screenshot_readbacks_ == 0) {
+    return;
+  }
+  delegate_.GetTaskRunners().GetRasterTaskRunner()->PostDelayedTask(
+      [rasterizer = weak_factory_.GetWeakPtr()]() {
+        if (rasterizer) {
+          rasterizer->PollScreenshotReadbacks();
+        }
+      },
+      kScreenshotReadbackPollInterval);
+}
+
 void Rasterizer::SetNextFrameCallback(const fml::closure& callback) {
   next_frame_callback_ = callback;
 }
@@ -840,6 +1431,19 @@ std::optional<size_t> Rasterizer::GetResourceCacheMaxBytes() const {
   return std::nullopt;
 }
 
+std::optional<size_t> Rasterizer::GetResourceCacheUsageBytes() const {
+  if (!surface_) {
+    return std::nullopt;
+  }
+  GrDirectContext* context = surface_->GetContext();
+  if (context) {
+    size_t bytes;
+    context->getResourceCacheUsage(nullptr, &bytes);
+    return bytes;
+  }
+  return std::nullopt;
+}
+
 Rasterizer::Screenshot::Screenshot() {}
 
 Rasterizer::Screenshot::Screenshot(sk_sp<SkData> p_data, SkISize p_size)
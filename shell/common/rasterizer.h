@@ -5,8 +5,11 @@
 #ifndef SHELL_COMMON_RASTERIZER_H_
 #define SHELL_COMMON_RASTERIZER_H_
 
+#include <map>
 #include <memory>
 #include <optional>
+#include <string>
+#include <vector>
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
@@ -16,6 +19,7 @@
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/closure.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/raster_thread_merger.h"
 #include "flutter/fml/synchronization/sync_switch.h"
@@ -25,6 +29,7 @@
 #include "flutter/lib/ui/snapshot_delegate.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/snapshot_surface_producer.h"
+#include "third_party/skia/include/core/SkPicture.h"
 
 namespace flutter {
 
@@ -96,6 +101,13 @@ class Rasterizer final : public SnapshotDelegate,
     /// is critical that GPU operations are not processed.
     virtual std::shared_ptr<const fml::SyncSwitch> GetIsGpuDisabledSyncSwitch()
         const = 0;
+
+    /// The task runner of the VM's worker pool, used to convert the display
+    /// lists of a layer tree into pictures concurrently for screenshots.
+    /// May be null, in which case the conversion happens on the raster
+    /// thread.
+    virtual std::shared_ptr<fml::ConcurrentTaskRunner>
+    GetConcurrentWorkerTaskRunner() const = 0;
   };
 
   //----------------------------------------------------------------------------
@@ -156,6 +168,37 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   void NotifyLowMemoryWarning() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The estimated memory of the surfaces that the external view
+  ///             embedder keeps for the overlays of platform views.
+  ///
+  size_t GetOverlaySurfaceBytes() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Destroys the overlay surfaces that the last frame didn't
+  ///             use, under memory pressure.
+  ///
+  /// @return     The estimated memory of the destroyed surfaces.
+  ///
+  size_t DestroySpareOverlaySurfaces();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Precompiles the SkSLs that the persistent cache left pending
+  ///             for the context of the surface, for a quarter of the frame
+  ///             budget, and posts another task to go on until none is left.
+  ///
+  void PrecompilePendingSkSLs();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Draws the pictures of text offscreen with the context of the
+  ///             surface, so that their glyphs are already in the glyph atlas
+  ///             of the context when the frames draw them. If there is no
+  ///             surface yet, they are drawn once the surface is set up.
+  ///
+  /// @param[in]  pictures  The pictures of the text to warm up the glyphs of.
+  ///
+  void WarmUpGlyphs(std::vector<sk_sp<SkPicture>> pictures);
+
   //----------------------------------------------------------------------------
   /// @brief      Gets a weak pointer to the rasterizer. The rasterizer may only
   ///             be accessed on the raster task runner.
@@ -337,6 +380,33 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   Screenshot ScreenshotLastLayerTree(ScreenshotType type, bool base64_encode);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Called with the screenshot captured by
+  ///             `ScreenshotLastLayerTreeAsync`.
+  ///
+  using ScreenshotCallback = std::function<void(Screenshot)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Screenshots the last layer tree like
+  ///             `ScreenshotLastLayerTree`, without blocking the raster thread
+  ///             on the readback of the pixels or on the encoding.
+  ///
+  ///             The raster thread only draws the last layer tree and starts
+  ///             an asynchronous readback of its pixels, which the GPU
+  ///             backends perform through a transfer buffer. The pixels are
+  ///             then encoded on the concurrent worker task runner.
+  ///
+  /// @param[in]  type           The type of the screenshot to gather.
+  /// @param[in]  base64_encode  Whether Base 64 encoding must be applied to the
+  ///                            data after a screenshot has been captured.
+  /// @param[in]  callback       Called on the concurrent worker task runner
+  ///                            with the screenshot, or with an empty one if
+  ///                            it could not be captured.
+  ///
+  void ScreenshotLastLayerTreeAsync(ScreenshotType type,
+                                    bool base64_encode,
+                                    ScreenshotCallback callback);
+
   //----------------------------------------------------------------------------
   /// @brief      Sets a callback that will be executed when the next layer tree
   ///             in rendered to the on-screen surface. This is used by
@@ -384,6 +454,75 @@ class Rasterizer final : public SnapshotDelegate,
     return compositor_context_.get();
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      The damage statistics of the frames rasterized with partial
+  ///             repaint since the rasterizer was created, summed up.
+  ///
+  struct DamageStatisticsTotals {
+    size_t frame_count = 0;
+    int64_t damage_area = 0;
+    int64_t frame_area = 0;
+    int64_t diffed_layers = 0;
+    int64_t retained_layers = 0;
+    fml::TimeDelta compute_damage_time;
+    fml::TimeDelta max_compute_damage_time;
+
+    void Add(const DamageStatistics& statistics);
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the damage statistics of the frames rasterized so far.
+  ///             Only frames rasterized with partial repaint are counted.
+  ///
+  const DamageStatisticsTotals& GetDamageStatisticsTotals() const {
+    return damage_statistics_totals_;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      A breakdown of the GPU memory held on behalf of the frames
+  ///             that this rasterizer draws.
+  ///
+  struct GpuMemoryUsage {
+    // The entries of the raster cache that hold an image, largest first.
+    std::vector<RasterCache::EntryInfo> raster_cache_entries;
+    // The bytes of the resources in the resource cache of the GrContext, by
+    // the type and by the category that Skia reports them with, such as
+    // "Texture" and "Scratch". Empty when rendering in software.
+    std::map<std::string, size_t> skia_bytes_by_type;
+    std::map<std::string, size_t> skia_bytes_by_category;
+    size_t skia_total_bytes = 0;
+    // The part of |skia_total_bytes| that Skia could free under pressure.
+    size_t skia_purgeable_bytes = 0;
+    // The bytes of the images held by the external textures that know their
+    // size.
+    size_t external_texture_bytes = 0;
+    // The bytes of the overlay surfaces of the external view embedder.
+    size_t overlay_surface_bytes = 0;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the GPU memory held by the raster cache, the Skia
+  ///             resource cache, the external textures and the overlay
+  ///             surfaces. Must be called on the raster task runner.
+  ///
+  GpuMemoryUsage GetGpuMemoryUsage() const;
+
+  struct PipelineStatistics {
+    // The depth limit of the layer tree pipeline.
+    uint32_t depth = 0;
+    // The number of layer trees that were in the pipeline, including the one
+    // drawn.
+    int frames_in_flight = 0;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the state of the layer tree pipeline when the last
+  ///             frame was drawn from it.
+  ///
+  const PipelineStatistics& GetLastPipelineStatistics() const {
+    return last_pipeline_statistics_;
+  }
+
   //----------------------------------------------------------------------------
   /// @brief      Returns the raster thread merger used by this rasterizer.
   ///             This may be `nullptr`.
@@ -431,6 +570,16 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   std::optional<size_t> GetResourceCacheMaxBytes() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The bytes of the GPU resources that Skia holds in its
+  ///             resource cache, if a surface is present.
+  ///
+  /// @see        `GetResourceCacheMaxBytes`
+  ///
+  /// @return     The bytes used by Skia's resource cache, if available.
+  ///
+  std::optional<size_t> GetResourceCacheUsageBytes() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Enables the thread merger if the external view embedder
   ///             supports dynamic thread merging.
@@ -468,6 +617,11 @@ class Rasterizer final : public SnapshotDelegate,
   // |SnapshotDelegate|
   sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) override;
 
+  // |SnapshotDelegate|
+  void MakeRasterSnapshotAsync(std::function<void(SkCanvas*)> draw_callback,
+                               SkISize picture_size,
+                               RasterSnapshotCallback callback) override;
+
   // |Stopwatch::Delegate|
   /// Time limit for a smooth frame.
   ///
@@ -480,6 +634,21 @@ class Rasterizer final : public SnapshotDelegate,
       GrDirectContext* surface_context,
       bool compressed);
 
+  // Draws |tree| into a new snapshot surface. The render context of
+  // |surface_| must be current.
+  sk_sp<SkSurface> DrawLayerTreeToSnapshotSurface(
+      flutter::LayerTree* tree,
+      flutter::CompositorContext& compositor_context,
+      GrDirectContext* surface_context);
+
+  // Checks whether the GPU has finished the pending screenshot and snapshot
+  // readbacks, which runs their callbacks, and polls again later while some
+  // remain.
+  void PollScreenshotReadbacks();
+
+  // Draws the pending pictures of |WarmUpGlyphs| if there is a context.
+  void DrawPendingGlyphWarmUps();
+
   sk_sp<SkImage> DoMakeRasterSnapshot(
       SkISize size,
       std::function<void(SkCanvas*)> draw_callback);
@@ -496,6 +665,24 @@ class Rasterizer final : public SnapshotDelegate,
 
   void FireNextFrameCallbackIfPresent();
 
+  // Merges the raster and platform threads before the given tree is
+  // prerolled if the scene builder added a platform view to it, so that the
+  // frame is retried on the platform thread without first acquiring a
+  // surface frame and prerolling the tree only for the external view
+  // embedder to cancel it.
+  //
+  // Returns whether the threads were merged by this call.
+  bool MergeThreadsAheadOfFrame(const flutter::LayerTree& layer_tree);
+
+  // Diffs the given tree against the last drawn tree, and records the frame
+  // as skipped if it has no damage and the surface can keep showing the last
+  // frame. A skipped frame is neither prerolled, painted nor presented, but
+  // becomes the last layer tree as if it had been drawn.
+  //
+  // Returns whether the frame was skipped.
+  bool SkipUnchangedFrame(FrameTimingsRecorder& frame_timings_recorder,
+                          flutter::LayerTree& layer_tree);
+
   static bool NoDiscard(const flutter::LayerTree& layer_tree) { return false; }
   static bool ShouldResubmitFrame(const RasterStatus& raster_status);
 
@@ -514,6 +701,17 @@ class Rasterizer final : public SnapshotDelegate,
   std::optional<size_t> max_cache_bytes_;
   fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
   std::shared_ptr<ExternalViewEmbedder> external_view_embedder_;
+  // The pictures of the DisplayLists in the last layer tree that was taken
+  // as an SkPicture screenshot, so that consecutive screenshots of a mostly
+  // unchanged tree only convert the lists that have changed.
+  DisplayListPictureCache display_list_picture_cache_;
+  DamageStatisticsTotals damage_statistics_totals_;
+  PipelineStatistics last_pipeline_statistics_;
+  // The asynchronous screenshot and snapshot readbacks that have not
+  // completed yet.
+  size_t pending_screenshot_readbacks_ = 0;
+  // The pictures of text to warm up the glyphs of once there is a context.
+  std::vector<sk_sp<SkPicture>> pending_glyph_warm_ups_;
 
   // WeakPtrFactory must be the last member.
   fml::TaskRunnerAffineWeakPtrFactory<Rasterizer> weak_factory_;
@@ -9,11 +9,13 @@
 #include <memory>
 
 #include "flutter/flow/frame_timings.h"
+#include "flutter/flow/layers/container_layer.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/testing.h"
 
 #include "gmock/gmock.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 using testing::_;
 using testing::ByMove;
@@ -32,6 +34,8 @@ class MockDelegate : public Rasterizer::Delegate {
                      const fml::RefPtr<fml::RasterThreadMerger>());
   MOCK_CONST_METHOD0(GetIsGpuDisabledSyncSwitch,
                      std::shared_ptr<const fml::SyncSwitch>());
+  MOCK_CONST_METHOD0(GetConcurrentWorkerTaskRunner,
+                     std::shared_ptr<fml::ConcurrentTaskRunner>());
   MOCK_METHOD0(CreateSnapshotSurface, std::unique_ptr<Surface>());
 };
 
@@ -46,6 +50,7 @@ class MockSurface : public Surface {
   MOCK_METHOD0(MakeRenderContextCurrent, std::unique_ptr<GLContextResult>());
   MOCK_METHOD0(ClearRenderContext, bool());
   MOCK_CONST_METHOD0(AllowsDrawingWhenGpuDisabled, bool());
+  MOCK_CONST_METHOD0(AllowsSkippingUnchangedFrames, bool());
 };
 
 class MockExternalViewEmbedder : public ExternalViewEmbedder {
@@ -616,4 +621,149 @@ TEST(
   latch.Wait();
 }
 
+TEST(RasterizerTest,
+     drawWithPlatformViewMergesThreadsBeforeExternalViewEmbedderBeginFrame) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  MockDelegate delegate;
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto surface = std::make_unique<MockSurface>();
+  std::shared_ptr<MockExternalViewEmbedder> external_view_embedder =
+      std::make_shared<MockExternalViewEmbedder>();
+  rasterizer->SetExternalViewEmbedder(external_view_embedder);
+  EXPECT_CALL(*external_view_embedder, SupportsDynamicThreadMerging)
+      .WillRepeatedly(Return(true));
+  EXPECT_CALL(*surface, AcquireFrame(SkISize())).Times(0);
+  EXPECT_CALL(*surface, MakeRenderContextCurrent())
+      .WillOnce(Return(ByMove(std::make_unique<GLContextDefaultResult>(true))));
+
+  // The tree is not prerolled on the raster thread, and the frame is retried
+  // on the platform thread.
+  EXPECT_CALL(*external_view_embedder, BeginFrame).Times(0);
+  EXPECT_CALL(*external_view_embedder, EndFrame(/*should_resubmit_frame=*/true,
+                                                /*raster_thread_merger=*/_))
+      .Times(1);
+  EXPECT_CALL(*external_view_embedder, EndFrame(/*should_resubmit_frame=*/false,
+                                                /*raster_thread_merger=*/_))
+      .Times(1);
+
+  rasterizer->Setup(std::move(surface));
+  fml::AutoResetWaitableEvent latch;
+  int draw_count = 0;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    auto pipeline = std::make_shared<Pipeline<LayerTree>>(/*depth=*/10);
+    auto layer_tree = std::make_unique<LayerTree>(/*frame_size=*/SkISize(),
+                                                  /*device_pixel_ratio=*/2.0f);
+    layer_tree->set_has_platform_view(true);
+    bool result = pipeline->Produce().Complete(std::move(layer_tree));
+    EXPECT_TRUE(result);
+    // Discards the retried frame once it runs on the platform thread.
+    auto discard_retry = [&](LayerTree&) {
+      if (draw_count++ == 0) {
+        return false;
+      }
+      EXPECT_TRUE(task_runners.GetPlatformTaskRunner()
+                      ->RunsTasksOnCurrentThread());
+      task_runners.GetPlatformTaskRunner()->PostTask(
+          [&latch]() { latch.Signal(); });
+      return true;
+    };
+    RasterStatus status = rasterizer->Draw(CreateFinishedBuildRecorder(),
+                                           pipeline, discard_retry);
+    EXPECT_EQ(status, RasterStatus::kSkipAndRetry);
+    EXPECT_TRUE(rasterizer->GetRasterThreadMerger()->IsMerged());
+  });
+  latch.Wait();
+  rasterizer->GetRasterThreadMerger()->DecrementLease();
+  EXPECT_FALSE(rasterizer->GetRasterThreadMerger()->IsMerged());
+}
+
+static void DrawTwoIdenticalFrames(bool allows_skipping_unchanged_frames,
+                                   std::vector<FrameTiming>& timings) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  MockDelegate delegate;
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  EXPECT_CALL(delegate, OnFrameRasterized(_))
+      .Times(2)
+      .WillRepeatedly(
+          [&timings](const FrameTiming& timing) { timings.push_back(timing); });
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto surface = std::make_unique<MockSurface>();
+  const SkISize frame_size = SkISize::Make(100, 100);
+
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.supports_readback = true;
+
+  EXPECT_CALL(*surface, AllowsDrawingWhenGpuDisabled())
+      .WillRepeatedly(Return(true));
+  EXPECT_CALL(*surface, AllowsSkippingUnchangedFrames())
+      .WillRepeatedly(Return(allows_skipping_unchanged_frames));
+  EXPECT_CALL(*surface, AcquireFrame(frame_size))
+      .Times(allows_skipping_unchanged_frames ? 1 : 2)
+      .WillRepeatedly([&framebuffer_info](const SkISize& size) {
+        return std::make_unique<SurfaceFrame>(
+            /*surface=*/SkSurface::MakeRasterN32Premul(size.width(),
+                                                       size.height()),
+            /*framebuffer_info=*/framebuffer_info,
+            /*submit_callback=*/
+            [](const SurfaceFrame&, SkCanvas*) { return true; });
+      });
+  EXPECT_CALL(*surface, MakeRenderContextCurrent())
+      .WillOnce(Return(ByMove(std::make_unique<GLContextDefaultResult>(true))));
+
+  rasterizer->Setup(std::move(surface));
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    auto no_discard = [](LayerTree&) { return false; };
+    for (int i = 0; i < 2; i++) {
+      auto pipeline = std::make_shared<Pipeline<LayerTree>>(/*depth=*/10);
+      auto layer_tree = std::make_unique<LayerTree>(
+          /*frame_size=*/frame_size, /*device_pixel_ratio=*/2.0f);
+      layer_tree->set_root_layer(std::make_shared<ContainerLayer>());
+      bool result = pipeline->Produce().Complete(std::move(layer_tree));
+      EXPECT_TRUE(result);
+      RasterStatus status =
+          rasterizer->Draw(CreateFinishedBuildRecorder(), pipeline, no_discard);
+      EXPECT_EQ(status, RasterStatus::kSuccess);
+    }
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+TEST(RasterizerTest, drawUnchangedFrameSkipsAcquiringAndSubmittingFrame) {
+  std::vector<FrameTiming> timings;
+  DrawTwoIdenticalFrames(/*allows_skipping_unchanged_frames=*/true, timings);
+  ASSERT_EQ(timings.size(), 2u);
+  EXPECT_FALSE(timings[0].IsSkipped());
+  EXPECT_TRUE(timings[1].IsSkipped());
+}
+
+TEST(RasterizerTest,
+     drawUnchangedFrameAcquiresFrameWhenSurfaceDisallowsSkippingFrames) {
+  std::vector<FrameTiming> timings;
+  DrawTwoIdenticalFrames(/*allows_skipping_unchanged_frames=*/false, timings);
+  ASSERT_EQ(timings.size(), 2u);
+  EXPECT_FALSE(timings[0].IsSkipped());
+  EXPECT_FALSE(timings[1].IsSkipped());
+}
+
 }  // namespace flutter
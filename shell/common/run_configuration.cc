@@ -7,6 +7,7 @@
 #include <sstream>
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/assets/packed_asset_bundle.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/unique_fd.h"
@@ -24,10 +25,20 @@ RunConfiguration RunConfiguration::InferFromSettings(
         fml::Duplicate(settings.assets_dir), true));
   }
 
-  asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
-      fml::OpenDirectory(settings.assets_path.c_str(), false,
-                         fml::FilePermission::kRead),
-      true));
+  fml::UniqueFD assets_path = fml::OpenDirectory(
+      settings.assets_path.c_str(), false, fml::FilePermission::kRead);
+
+  // The assets in an archive are found without looking each up in the file
+  // system, and the directory serves the ones that were not packed.
+  auto asset_archive = fml::FileMapping::CreateReadOnly(
+      assets_path, PackedAssetBundle::kArchiveName);
+  if (asset_archive) {
+    asset_manager->PushBack(
+        std::make_unique<PackedAssetBundle>(std::move(asset_archive), true));
+  }
+
+  asset_manager->PushBack(
+      std::make_unique<DirectoryAssetBundle>(std::move(assets_path), true));
 
   return {IsolateConfiguration::InferFromSettings(settings, asset_manager,
                                                   io_worker),
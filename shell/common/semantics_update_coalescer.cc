@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/semantics_update_coalescer.h"
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace flutter {
+
+SemanticsUpdateCoalescer::SemanticsUpdateCoalescer() = default;
+
+SemanticsUpdateCoalescer::~SemanticsUpdateCoalescer() = default;
+
+bool SemanticsUpdateCoalescer::Add(SemanticsNodeUpdates nodes,
+                                   CustomAccessibilityActionUpdates actions) {
+  std::scoped_lock lock(mutex_);
+  bool was_empty = !has_pending_update_;
+  has_pending_update_ = true;
+
+  for (auto& [id, node] : nodes) {
+    auto pending = pending_update_.nodes.find(id);
+    if (pending == pending_update_.nodes.end()) {
+      pending_update_.nodes.emplace(id, std::move(node));
+      continue;
+    }
+    const std::vector<int32_t>& old_children =
+        pending->second.childrenInTraversalOrder;
+    if (old_children != node.childrenInTraversalOrder) {
+      std::unordered_set<int32_t> new_children(
+          node.childrenInTraversalOrder.begin(),
+          node.childrenInTraversalOrder.end());
+      for (int32_t child : old_children) {
+        if (new_children.find(child) == new_children.end()) {
+          detached_nodes_.insert(child);
+        }
+      }
+    }
+    pending->second = std::move(node);
+  }
+
+  for (auto& [id, action] : actions) {
+    pending_update_.actions.insert_or_assign(id, std::move(action));
+  }
+
+  return was_empty;
+}
+
+SemanticsUpdateCoalescer::Update SemanticsUpdateCoalescer::Take() {
+  std::scoped_lock lock(mutex_);
+
+  // Drop the nodes that were detached and not attached anywhere else, along
+  // with the descendants that were only reachable through them. A node that
+  // is not pending is left to the platform view, which removes it when it
+  // becomes unreachable.
+  if (!detached_nodes_.empty()) {
+    std::unordered_map<int32_t, size_t> parent_counts;
+    for (const auto& [id, node] : pending_update_.nodes) {
+      for (int32_t child : node.childrenInTraversalOrder) {
+        parent_counts[child]++;
+      }
+    }
+    std::vector<int32_t> candidates(detached_nodes_.begin(),
+                                    detached_nodes_.end());
+    while (!candidates.empty()) {
+      int32_t id = candidates.back();
+      candidates.pop_back();
+      if (parent_counts[id] > 0) {
+        continue;
+      }
+      auto node = pending_update_.nodes.find(id);
+      if (node == pending_update_.nodes.end()) {
+        continue;
+      }
+      for (int32_t child : node->second.childrenInTraversalOrder) {
+        if (--parent_counts[child] == 0) {
+          candidates.push_back(child);
+        }
+      }
+      pending_update_.nodes.erase(node);
+    }
+    detached_nodes_.clear();
+  }
+
+  has_pending_update_ = false;
+  return std::exchange(pending_update_, {});
+}
+
+}  // namespace flutter
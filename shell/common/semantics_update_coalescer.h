@@ -0,0 +1,69 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_SEMANTICS_UPDATE_COALESCER_H_
+#define FLUTTER_SHELL_COMMON_SEMANTICS_UPDATE_COALESCER_H_
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_set>
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/semantics/custom_accessibility_action.h"
+#include "flutter/lib/ui/semantics/semantics_node.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Merges the semantics updates that the UI thread produces while
+///             the platform thread has yet to deliver the previous one, so
+///             that the platform view receives at most one update per
+///             platform task however fast the framework produces them.
+///
+///             Updates are merged by node and action ID, with the newest
+///             state of each winning. Nodes that were added by a merged
+///             update and removed from their parent by a later one are
+///             dropped, as the platform view never saw them.
+///
+///             Updates may be added on one thread and taken on another.
+///
+class SemanticsUpdateCoalescer {
+ public:
+  /// A merged update.
+  struct Update {
+    SemanticsNodeUpdates nodes;
+    CustomAccessibilityActionUpdates actions;
+  };
+
+  SemanticsUpdateCoalescer();
+
+  ~SemanticsUpdateCoalescer();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Merges an update into the pending one.
+  ///
+  /// @return     Whether there was no pending update, in which case the
+  ///             caller schedules a call to |Take|.
+  ///
+  bool Add(SemanticsNodeUpdates nodes,
+           CustomAccessibilityActionUpdates actions);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the pending update, leaving none pending.
+  ///
+  Update Take();
+
+ private:
+  std::mutex mutex_;
+  bool has_pending_update_ = false;
+  Update pending_update_;
+  // The IDs of the nodes that a merged update removed from their parent.
+  std::unordered_set<int32_t> detached_nodes_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SemanticsUpdateCoalescer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_SEMANTICS_UPDATE_COALESCER_H_
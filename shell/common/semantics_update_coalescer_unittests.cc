@@ -0,0 +1,82 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/semantics_update_coalescer.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+SemanticsNode CreateNode(int32_t id,
+                         std::string label,
+                         std::vector<int32_t> children = {}) {
+  SemanticsNode node;
+  node.id = id;
+  node.label = std::move(label);
+  node.childrenInTraversalOrder = children;
+  node.childrenInHitTestOrder = std::move(children);
+  return node;
+}
+
+}  // namespace
+
+TEST(SemanticsUpdateCoalescerTest, MergesUpdatesByNode) {
+  SemanticsUpdateCoalescer coalescer;
+  EXPECT_TRUE(coalescer.Add({{0, CreateNode(0, "root", {1})},
+                             {1, CreateNode(1, "first")}},
+                            {}));
+  EXPECT_FALSE(coalescer.Add({{1, CreateNode(1, "second")}}, {}));
+
+  SemanticsUpdateCoalescer::Update update = coalescer.Take();
+  ASSERT_EQ(update.nodes.size(), 2u);
+  EXPECT_EQ(update.nodes[0].label, "root");
+  EXPECT_EQ(update.nodes[1].label, "second");
+
+  // Nothing is pending after the update is taken.
+  EXPECT_TRUE(coalescer.Take().nodes.empty());
+  EXPECT_TRUE(coalescer.Add({{1, CreateNode(1, "third")}}, {}));
+}
+
+TEST(SemanticsUpdateCoalescerTest, MergesActionsById) {
+  SemanticsUpdateCoalescer coalescer;
+  CustomAccessibilityAction first;
+  first.id = 1;
+  first.label = "first";
+  CustomAccessibilityAction second = first;
+  second.label = "second";
+  coalescer.Add({}, {{1, first}});
+  coalescer.Add({}, {{1, second}});
+
+  SemanticsUpdateCoalescer::Update update = coalescer.Take();
+  ASSERT_EQ(update.actions.size(), 1u);
+  EXPECT_EQ(update.actions[1].label, "second");
+}
+
+TEST(SemanticsUpdateCoalescerTest, DropsNodesRemovedByALaterUpdate) {
+  SemanticsUpdateCoalescer coalescer;
+  coalescer.Add({{0, CreateNode(0, "root", {1, 2})},
+                 {1, CreateNode(1, "added", {3})},
+                 {2, CreateNode(2, "moved")},
+                 {3, CreateNode(3, "grandchild")}},
+                {});
+  // Node 1 is removed along with its child, and node 2 moves under node 4.
+  coalescer.Add({{0, CreateNode(0, "root", {4})},
+                 {4, CreateNode(4, "parent", {2})}},
+                {});
+
+  SemanticsUpdateCoalescer::Update update = coalescer.Take();
+  EXPECT_EQ(update.nodes.size(), 3u);
+  EXPECT_EQ(update.nodes.count(0), 1u);
+  EXPECT_EQ(update.nodes.count(2), 1u);
+  EXPECT_EQ(update.nodes.count(4), 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
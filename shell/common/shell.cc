@@ -5,32 +5,41 @@
 #define RAPIDJSON_HAS_STDSTRING 1
 #include "flutter/shell/common/shell.h"
 
+#include <map>
 #include <memory>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/flow/persistent_raster_cache.h"
 #include "flutter/fml/base32.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/icu_util.h"
 #include "flutter/fml/log_settings.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/malloc_buffer_pool.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_ring_buffer.h"
+#include "flutter/runtime/dart_service_isolate.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/engine.h"
 #include "flutter/shell/common/skia_event_tracer_impl.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/common/vsync_waiter.h"
+#include "flutter/shell/common/vsync_waiter_immediate.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
+#include "third_party/skia/include/core/SkFontMgr.h"
 #include "third_party/skia/include/core/SkGraphics.h"
 #include "third_party/skia/include/utils/SkBase64.h"
 #include "third_party/tonic/common/log.h"
+#include "txt/font_collection.h"
 
 namespace flutter {
 
@@ -68,6 +77,47 @@ std::unique_ptr<Engine> CreateEngine(
                                   volatile_path_tracker);
 }
 
+// Initializes ICU the first time it is called in the process. The callers on
+// other threads wait for the first call to be done.
+void InitializeICUOnce(const Settings& settings) {
+  static std::once_flag gICUInitialization = {};
+  std::call_once(gICUInitialization, [&settings] {
+    if (!settings.icu_initialization_required) {
+      return;
+    }
+    TRACE_EVENT0("flutter", "InitializeICU");
+    if (settings.icu_data_path.size() != 0) {
+      fml::icu::InitializeICU(settings.icu_data_path);
+    } else if (settings.icu_mapper) {
+      fml::icu::InitializeICUFromMapping(settings.icu_mapper());
+    } else {
+      FML_DLOG(WARNING) << "Skipping ICU initialization in the shell.";
+    }
+  });
+}
+
+// Starts the startup steps that do not depend on the VM on the IO and raster
+// threads, which have nothing else to do until the shell is set up, so that
+// they run while the platform thread creates the VM. Each step records a
+// trace event of its own.
+void StartConcurrentStartupTasks(const Settings& settings,
+                                 const TaskRunners& task_runners) {
+  TRACE_EVENT0("flutter", "StartConcurrentStartupTasks");
+  // The shell waits for ICU in |CreateWithSnapshot|, before any of the
+  // subsystems can use it.
+  auto io_task = [settings]() {
+    InitializeICUOnce(settings);
+    PersistentCache::GetCacheForProcess()->PrefetchSkSLs();
+  };
+  fml::TaskRunner::RunNowOrPostTask(task_runners.GetIOTaskRunner(), io_task);
+  // The default font manager of Skia is created once for the process, so
+  // the engine finds it ready when it sets up its font collection.
+  fml::TaskRunner::RunNowOrPostTask(task_runners.GetRasterTaskRunner(), []() {
+    TRACE_EVENT0("flutter", "WarmUpDefaultFontManager");
+    SkFontMgr::RefDefault();
+  });
+}
+
 // Though there can be multiple shells, some settings apply to all components in
 // the process. These have to be set up before the shell or any of its
 // sub-components can be initialized. In a perfect world, this would be empty.
@@ -82,6 +132,11 @@ void PerformInitializationTasks(Settings& settings) {
     fml::SetLogSettings(log_settings);
   }
 
+  // Unlike the other tracing settings, this may be turned on by any shell.
+  if (settings.enable_trace_ring_buffer) {
+    fml::tracing::TraceRingBufferSetEnabled(true);
+  }
+
   static std::once_flag gShellSettingsInitialization = {};
   std::call_once(gShellSettingsInitialization, [&settings] {
     if (settings.engine_start_timestamp.count() == 0) {
@@ -106,18 +161,16 @@ void PerformInitializationTasks(Settings& settings) {
       FML_DLOG(INFO) << "Skia deterministic rendering is enabled.";
     }
 
-    if (settings.icu_initialization_required) {
-      if (settings.icu_data_path.size() != 0) {
-        fml::icu::InitializeICU(settings.icu_data_path);
-      } else if (settings.icu_mapper) {
-        fml::icu::InitializeICUFromMapping(settings.icu_mapper());
-      } else {
-        FML_DLOG(WARNING) << "Skipping ICU initialization in the shell.";
-      }
+    // The concurrent startup initializes ICU on the IO thread instead.
+    if (!settings.enable_concurrent_startup) {
+      InitializeICUOnce(settings);
     }
   });
 
   PersistentCache::SetCacheSkSL(settings.cache_sksl);
+  PersistentCache::SetPrioritizeSkSLPrecompilation(
+      settings.enable_prioritized_sksl_precompilation);
+  PersistentCache::SetUsePackFiles(settings.enable_persistent_cache_pack_files);
 }
 
 }  // namespace
@@ -134,6 +187,10 @@ std::unique_ptr<Shell> Shell::Create(
 
   TRACE_EVENT0("flutter", "Shell::Create");
 
+  if (settings.enable_concurrent_startup && task_runners.IsValid()) {
+    StartConcurrentStartupTasks(settings, task_runners);
+  }
+
   // Always use the `vm_snapshot` and `isolate_snapshot` provided by the
   // settings to launch the VM.  If the VM is already running, the snapshot
   // arguments are ignored.
@@ -147,15 +204,16 @@ std::unique_ptr<Shell> Shell::Create(
   if (!isolate_snapshot) {
     isolate_snapshot = vm->GetVMData()->GetIsolateSnapshot();
   }
-  return CreateWithSnapshot(std::move(platform_data),            //
-                            std::move(task_runners),             //
-                            /*parent_merger=*/nullptr,           //
-                            /*parent_io_manager=*/nullptr,       //
-                            std::move(settings),                 //
-                            std::move(vm),                       //
-                            std::move(isolate_snapshot),         //
-                            std::move(on_create_platform_view),  //
-                            std::move(on_create_rasterizer),     //
+  return CreateWithSnapshot(std::move(platform_data),                //
+                            std::move(task_runners),                 //
+                            /*parent_merger=*/nullptr,               //
+                            /*parent_io_manager=*/nullptr,           //
+                            /*parent_raster_cache_budget=*/nullptr,  //
+                            std::move(settings),                     //
+                            std::move(vm),                           //
+                            std::move(isolate_snapshot),             //
+                            std::move(on_create_platform_view),      //
+                            std::move(on_create_rasterizer),         //
                             CreateEngine, is_gpu_disabled);
 }
 
@@ -163,6 +221,7 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
     DartVMRef vm,
     fml::RefPtr<fml::RasterThreadMerger> parent_merger,
     std::shared_ptr<ShellIOManager> parent_io_manager,
+    std::shared_ptr<RasterCacheBudget> parent_raster_cache_budget,
     TaskRunners task_runners,
     const PlatformData& platform_data,
     Settings settings,
@@ -180,7 +239,8 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
       new Shell(std::move(vm), task_runners, parent_merger, settings,
                 std::make_shared<VolatilePathTracker>(
                     task_runners.GetUITaskRunner(),
-                    !settings.skia_deterministic_rendering_on_cpu),
+                    !settings.skia_deterministic_rendering_on_cpu,
+                    settings.enable_path_deduplication),
                 is_gpu_disabled));
 
   // Create the rasterizer on the raster thread.
@@ -191,11 +251,31 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   fml::TaskRunner::RunNowOrPostTask(
       task_runners.GetRasterTaskRunner(), [&rasterizer_promise,  //
                                            &snapshot_delegate_promise,
-                                           on_create_rasterizer,  //
-                                           shell = shell.get()    //
+                                           on_create_rasterizer,        //
+                                           parent_raster_cache_budget,  //
+                                           shell = shell.get()          //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupGPUSubsystem");
         std::unique_ptr<Rasterizer> rasterizer(on_create_rasterizer(*shell));
+        shell->raster_cache_budget_ =
+            parent_raster_cache_budget
+                ? parent_raster_cache_budget
+                : std::make_shared<RasterCacheBudget>(
+                      shell->GetSettings().raster_cache_max_bytes);
+        rasterizer->compositor_context()->raster_cache().SetSharedBudget(
+            shell->raster_cache_budget_);
+        if (shell->GetSettings().enable_concurrent_preroll) {
+          rasterizer->compositor_context()->SetConcurrentPrerollTaskRunner(
+              shell->GetConcurrentWorkerTaskRunner());
+        }
+        rasterizer->compositor_context()->set_batch_text_draws(
+            shell->GetSettings().enable_text_draw_batching);
+        if (shell->GetSettings().enable_concurrent_raster_cache_recording) {
+          rasterizer->compositor_context()
+              ->raster_cache()
+              .SetConcurrentRecordingTaskRunner(
+                  shell->GetConcurrentWorkerTaskRunner());
+        }
         snapshot_delegate_promise.set_value(rasterizer->GetSnapshotDelegate());
         rasterizer_promise.set_value(std::move(rasterizer));
       });
@@ -206,9 +286,12 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
     return nullptr;
   }
 
-  // Ask the platform view for the vsync waiter. This will be used by the engine
-  // to create the animator.
-  auto vsync_waiter = platform_view->CreateVSyncWaiter();
+  // Ask the platform view for the vsync waiter, unless frames are rendered
+  // without one. This will be used by the engine to create the animator.
+  std::unique_ptr<VsyncWaiter> vsync_waiter =
+      shell->GetSettings().render_without_vsync
+          ? std::make_unique<VsyncWaiterImmediate>(task_runners)
+          : platform_view->CreateVSyncWaiter();
   if (!vsync_waiter) {
     return nullptr;
   }
@@ -223,6 +306,8 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   auto weak_io_manager_future = weak_io_manager_promise.get_future();
   std::promise<fml::RefPtr<SkiaUnrefQueue>> unref_queue_promise;
   auto unref_queue_future = unref_queue_promise.get_future();
+  std::promise<std::shared_ptr<DecodedImageCache>> decoded_image_cache_promise;
+  auto decoded_image_cache_future = decoded_image_cache_promise.get_future();
   auto io_task_runner = shell->GetTaskRunners().GetIOTaskRunner();
 
   // The platform_view will be stored into shell's platform_view_ in
@@ -230,31 +315,47 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   PlatformView* platform_view_ptr = platform_view.get();
   fml::TaskRunner::RunNowOrPostTask(
       io_task_runner,
-      [&io_manager_promise,                                               //
-       &weak_io_manager_promise,                                          //
-       &parent_io_manager,                                                //
-       &unref_queue_promise,                                              //
-       platform_view_ptr,                                                 //
-       io_task_runner,                                                    //
-       is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch()  //
+      [&io_manager_promise,                                                  //
+       &weak_io_manager_promise,                                             //
+       &parent_io_manager,                                                   //
+       &unref_queue_promise,                                                 //
+       &decoded_image_cache_promise,                                         //
+       platform_view_ptr,                                                    //
+       io_task_runner,                                                       //
+       is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch(),    //
+       cache_max_bytes = shell->GetSettings().decoded_image_cache_max_bytes  //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupIOSubsystem");
         std::shared_ptr<ShellIOManager> io_manager;
         if (parent_io_manager) {
+          // Spawned shells share the decoded images of their parent too.
           io_manager = parent_io_manager;
         } else {
           io_manager = std::make_shared<ShellIOManager>(
               platform_view_ptr->CreateResourceContext(),
               is_backgrounded_sync_switch, io_task_runner);
+          if (cache_max_bytes > 0) {
+            io_manager->SetDecodedImageCache(
+                std::make_shared<DecodedImageCache>(cache_max_bytes));
+          }
         }
         weak_io_manager_promise.set_value(io_manager->GetWeakPtr());
         unref_queue_promise.set_value(io_manager->GetSkiaUnrefQueue());
+        decoded_image_cache_promise.set_value(
+            io_manager->GetDecodedImageCache());
         io_manager_promise.set_value(io_manager);
       });
 
   // Send dispatcher_maker to the engine constructor because shell won't have
   // platform_view set until Shell::Setup is called later.
-  auto dispatcher_maker = platform_view->GetDispatcherMaker();
+  PointerDataDispatcherMaker dispatcher_maker;
+  if (shell->GetSettings().enable_pointer_coalescing) {
+    dispatcher_maker = [](PointerDataDispatcher::Delegate& delegate) {
+      return std::make_unique<CoalescingPointerDataDispatcher>(delegate);
+    };
+  } else {
+    dispatcher_maker = platform_view->GetDispatcherMaker();
+  }
 
   // Create the engine on the UI thread.
   std::promise<std::unique_ptr<Engine>> engine_promise;
@@ -270,6 +371,7 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                          &weak_io_manager_future,                         //
                          &snapshot_delegate_future,                       //
                          &unref_queue_future,                             //
+                         &decoded_image_cache_future,                     //
                          &on_create_engine]() mutable {
         TRACE_EVENT0("flutter", "ShellSetupUISubsystem");
         const auto& task_runners = shell->GetTaskRunners();
@@ -278,8 +380,16 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
         // from the platform.
         auto animator = std::make_unique<Animator>(*shell, task_runners,
                                                    std::move(vsync_waiter));
+        if (shell->GetSettings().render_without_vsync) {
+          animator->UseDeepestPipelineDepth();
+        } else if (shell->GetSettings().enable_adaptive_pipeline_depth) {
+          animator->EnableAdaptivePipelineDepth();
+        }
+        if (shell->GetSettings().enable_predictive_frame_scheduling) {
+          animator->EnablePredictiveFrameScheduling();
+        }
 
-        engine_promise.set_value(
+        auto engine =
             on_create_engine(*shell,                          //
                              dispatcher_maker,                //
                              *shell->GetDartVM(),             //
@@ -291,7 +401,20 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                              weak_io_manager_future.get(),    //
                              unref_queue_future.get(),        //
                              snapshot_delegate_future.get(),  //
-                             shell->volatile_path_tracker_));
+                             shell->volatile_path_tracker_);
+        if (engine) {
+          engine->GetIdleTaskScheduler().AddTask(
+              "VolatilePathTracker::OnFrame",
+              [tracker = shell->volatile_path_tracker_](fml::TimePoint) {
+                tracker->OnFrame();
+              });
+        }
+        auto decoded_image_cache = decoded_image_cache_future.get();
+        if (engine && decoded_image_cache) {
+          engine->GetImageDecoderWeakPtr()->SetDecodedImageCache(
+              std::move(decoded_image_cache));
+        }
+        engine_promise.set_value(std::move(engine));
       }));
 
   if (!shell->Setup(std::move(platform_view),  //
@@ -310,6 +433,7 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
     TaskRunners task_runners,
     fml::RefPtr<fml::RasterThreadMerger> parent_thread_merger,
     std::shared_ptr<ShellIOManager> parent_io_manager,
+    std::shared_ptr<RasterCacheBudget> parent_raster_cache_budget,
     Settings settings,
     DartVMRef vm,
     fml::RefPtr<const DartSnapshot> isolate_snapshot,
@@ -322,6 +446,11 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
 
   TRACE_EVENT0("flutter", "Shell::CreateWithSnapshot");
 
+  if (settings.enable_concurrent_startup) {
+    // Waits for the IO thread if it is initializing ICU.
+    InitializeICUOnce(settings);
+  }
+
   const bool callbacks_valid =
       on_create_platform_view && on_create_rasterizer && on_create_engine;
   if (!task_runners.IsValid() || !callbacks_valid) {
@@ -337,6 +466,7 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
            &shell,                                                        //
            parent_thread_merger,                                          //
            parent_io_manager,                                             //
+           parent_raster_cache_budget,                                    //
            task_runners = std::move(task_runners),                        //
            platform_data = std::move(platform_data),                      //
            settings = std::move(settings),                                //
@@ -350,6 +480,7 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
                 std::move(vm),                       //
                 parent_thread_merger,                //
                 parent_io_manager,                   //
+                parent_raster_cache_budget,          //
                 std::move(task_runners),             //
                 std::move(platform_data),            //
                 std::move(settings),                 //
@@ -430,6 +561,26 @@ Shell::Shell(DartVMRef vm,
           task_runners_.GetRasterTaskRunner(),
           std::bind(&Shell::OnServiceProtocolEstimateRasterCacheMemory, this,
                     std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetPartialRepaintStatisticsExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetPartialRepaintStatistics, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetFrameTimingPercentilesExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetFrameTimingPercentiles, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetTraceRingBufferExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetTraceRingBuffer, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetGpuMemoryUsageExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetGpuMemoryUsage, this,
+                    std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
@@ -499,7 +650,8 @@ std::unique_ptr<Shell> Shell::Spawn(
           .SetIfTrue([&is_gpu_disabled] { is_gpu_disabled = true; }));
   std::unique_ptr<Shell> result = CreateWithSnapshot(
       PlatformData{}, task_runners_, rasterizer_->GetRasterThreadMerger(),
-      io_manager_, GetSettings(), vm_, vm_->GetVMData()->GetIsolateSnapshot(),
+      io_manager_, raster_cache_budget_, GetSettings(), vm_,
+      vm_->GetVMData()->GetIsolateSnapshot(),
       on_create_platform_view, on_create_rasterizer,
       [engine = this->engine_.get(), initial_route](
           Engine::Delegate& delegate,
@@ -525,25 +677,105 @@ std::unique_ptr<Shell> Shell::Spawn(
 }
 
 void Shell::NotifyLowMemoryWarning() const {
+  NotifyMemoryPressure(MemoryPressureLevel::kCritical);
+}
+
+void Shell::NotifyMemoryPressure(MemoryPressureLevel level,
+                                 MemoryPressureCallback callback) const {
   auto trace_id = fml::tracing::TraceNonce();
-  TRACE_EVENT_ASYNC_BEGIN0("flutter", "Shell::NotifyLowMemoryWarning",
-                           trace_id);
-  // This does not require a current isolate but does require a running VM.
-  // Since a valid shell will not be returned to the embedder without a valid
-  // DartVMRef, we can be certain that this is a safe spot to assume a VM is
-  // running.
-  ::Dart_NotifyLowMemory();
+  TRACE_EVENT_ASYNC_BEGIN1(
+      "flutter", "Shell::NotifyMemoryPressure", trace_id, "level",
+      level == MemoryPressureLevel::kCritical ? "critical" : "moderate");
+  if (level == MemoryPressureLevel::kCritical) {
+    // This does not require a current isolate but does require a running VM.
+    // Since a valid shell will not be returned to the embedder without a
+    // valid DartVMRef, we can be certain that this is a safe spot to assume a
+    // VM is running.
+    ::Dart_NotifyLowMemory();
+    fml::MallocBufferPool::GetInstance().Purge();
+  }
 
+  // The IO Manager uses resource cache limits of 0, so it is not necessary
+  // to purge them. The caches are trimmed on the raster thread, which owns the
+  // raster cache and the overlay surfaces.
   task_runners_.GetRasterTaskRunner()->PostTask(
-      [rasterizer = rasterizer_->GetWeakPtr(), trace_id = trace_id]() {
+      [rasterizer = rasterizer_->GetWeakPtr(),
+       decoded_image_cache = io_manager_->GetDecodedImageCache(),
+       target_bytes = settings_.memory_pressure_target_bytes, level,
+       callback = std::move(callback), trace_id]() {
+        // The caches are trimmed from the cheapest to refill to the most
+        // expensive one.
+        MemoryPressureController controller(target_bytes);
+        if (rasterizer) {
+          RasterCache& raster_cache =
+              rasterizer->compositor_context()->raster_cache();
+          controller.AddCache({
+              &MemoryPressureReport::raster_cache_bytes,
+              [&raster_cache]() {
+                return raster_cache.EstimatePictureCacheByteSize() +
+                       raster_cache.EstimateLayerCacheByteSize();
+              },
+              [&raster_cache](size_t max_bytes) {
+                return raster_cache.Trim(max_bytes);
+              },
+          });
+        }
+        if (decoded_image_cache) {
+          controller.AddCache({
+              &MemoryPressureReport::decoded_image_cache_bytes,
+              [&decoded_image_cache]() {
+                return decoded_image_cache->GetByteSize();
+              },
+              [&decoded_image_cache](size_t max_bytes) {
+                return decoded_image_cache->Trim(max_bytes);
+              },
+          });
+        }
+        controller.AddCache({
+            &MemoryPressureReport::text_layout_cache_bytes,
+            &txt::FontCollection::GetLayoutCacheBytes,
+            &txt::FontCollection::TrimLayoutCache,
+        });
+        controller.AddCache({
+            &MemoryPressureReport::pending_sksl_bytes,
+            []() {
+              return PersistentCache::GetCacheForProcess()
+                  ->GetPendingSkSLBytes();
+            },
+            [](size_t max_bytes) -> size_t {
+              // The pending SkSLs can only be released all at once.
+              if (max_bytes > 0) {
+                return 0;
+              }
+              return PersistentCache::GetCacheForProcess()
+                  ->ReleasePendingSkSLs();
+            },
+        });
         if (rasterizer) {
+          controller.AddCache({
+              &MemoryPressureReport::overlay_surface_bytes,
+              [&rasterizer]() { return rasterizer->GetOverlaySurfaceBytes(); },
+              [&rasterizer](size_t max_bytes) -> size_t {
+                // The overlay surfaces that the last frame used are kept.
+                if (max_bytes > 0) {
+                  return 0;
+                }
+                return rasterizer->DestroySpareOverlaySurfaces();
+              },
+          });
+        }
+
+        MemoryPressureReport report = controller.Relieve(level);
+        if (rasterizer && level == MemoryPressureLevel::kCritical) {
           rasterizer->NotifyLowMemoryWarning();
         }
-        TRACE_EVENT_ASYNC_END0("flutter", "Shell::NotifyLowMemoryWarning",
-                               trace_id);
+        TRACE_EVENT_ASYNC_END1(
+            "flutter", "Shell::NotifyMemoryPressure", trace_id, "freed_bytes",
+            std::to_string(report.GetTotalBytes()).c_str());
+        if (callback) {
+          callback(report);
+        }
       });
-  // The IO Manager uses resource cache limits of 0, so it is not necessary
-  // to purge them.
 }
 
 void Shell::RunEngine(RunConfiguration run_configuration) {
@@ -649,14 +881,65 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   rasterizer_->SetSnapshotSurfaceProducer(
       platform_view_->CreateSnapshotSurfaceProducer());
 
+  if (settings_.enable_async_raster_cache) {
+    rasterizer_->compositor_context()
+        ->raster_cache()
+        .SetResourceContextTaskRunner(
+            [io_task_runner = task_runners_.GetIOTaskRunner(),
+             io_manager = io_manager_->GetWeakPtr()](
+                RasterCache::ResourceContextTask task) {
+              io_task_runner->PostTask([io_manager, task = std::move(task)]() {
+                if (!io_manager) {
+                  task(nullptr);
+                  return;
+                }
+                io_manager->GetIsGpuDisabledSyncSwitch()->Execute(
+                    fml::SyncSwitch::Handlers()
+                        .SetIfTrue([&task] { task(nullptr); })
+                        .SetIfFalse([&task, &io_manager] {
+                          task(io_manager->GetResourceContext().get());
+                        }));
+              });
+            },
+            io_manager_->GetSkiaUnrefQueue());
+  }
+
+  if (settings_.enable_persistent_raster_cache) {
+    auto persistent_raster_cache = std::make_shared<PersistentRasterCache>(
+        PersistentCache::GetCacheForProcess());
+    rasterizer_->compositor_context()->raster_cache().SetPersistentRasterCache(
+        persistent_raster_cache);
+    task_runners_.GetIOTaskRunner()->PostTask(
+        [persistent_raster_cache, io_manager = io_manager_->GetWeakPtr()]() {
+          std::vector<PersistentCache::SkSLCache> stored =
+              PersistentCache::GetCacheForProcess()->LoadRasterCacheImages();
+          if (!io_manager) {
+            persistent_raster_cache->Load(stored, nullptr, nullptr);
+            return;
+          }
+          io_manager->GetIsGpuDisabledSyncSwitch()->Execute(
+              fml::SyncSwitch::Handlers()
+                  .SetIfTrue([&] {
+                    persistent_raster_cache->Load(stored, nullptr, nullptr);
+                  })
+                  .SetIfFalse([&] {
+                    persistent_raster_cache->Load(
+                        stored, io_manager->GetResourceContext().get(),
+                        io_manager->GetSkiaUnrefQueue());
+                  }));
+        });
+  }
+
   // The weak ptr must be generated in the platform thread which owns the unique
   // ptr.
   weak_engine_ = engine_->GetWeakPtr();
   weak_rasterizer_ = rasterizer_->GetWeakPtr();
   weak_platform_view_ = platform_view_->GetWeakPtr();
 
-  // Setup the time-consuming default font manager right after engine created.
-  if (!settings_.prefetched_default_font_manager) {
+  // Setup the time-consuming default font manager right after engine created,
+  // unless it is shared with the engine that this one was spawned from.
+  if (!settings_.prefetched_default_font_manager &&
+      !engine_->SharesFontCollection()) {
     fml::TaskRunner::RunNowOrPostTask(task_runners_.GetUITaskRunner(),
                                       [engine = weak_engine_] {
                                         if (engine) {
@@ -876,11 +1159,7 @@ void Shell::OnPlatformViewDestroyed() {
   rasterizer_->TeardownExternalViewEmbedder();
 }
 
-// |PlatformView::Delegate|
-void Shell::OnPlatformViewSetViewportMetrics(const ViewportMetrics& metrics) {
-  FML_DCHECK(is_setup_);
-  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
-
+bool Shell::PrepareViewportMetrics(const ViewportMetrics& metrics) {
   if (metrics.device_pixel_ratio <= 0 || metrics.physical_width <= 0 ||
       metrics.physical_height <= 0) {
     FML_DLOG(ERROR)
@@ -888,7 +1167,7 @@ void Shell::OnPlatformViewSetViewportMetrics(const ViewportMetrics& metrics) {
         << "\nphysical_width: " << metrics.physical_width
         << "\nphysical_height: " << metrics.physical_height
         << "\ndevice_pixel_ratio: " << metrics.device_pixel_ratio;
-    return;
+    return false;
   }
 
   // This is the formula Android uses.
@@ -901,18 +1180,29 @@ void Shell::OnPlatformViewSetViewportMetrics(const ViewportMetrics& metrics) {
         }
       });
 
+  {
+    std::scoped_lock<std::mutex> lock(resize_mutex_);
+    expected_frame_size_ =
+        SkISize::Make(metrics.physical_width, metrics.physical_height);
+  }
+  return true;
+}
+
+// |PlatformView::Delegate|
+void Shell::OnPlatformViewSetViewportMetrics(const ViewportMetrics& metrics) {
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+
+  if (!PrepareViewportMetrics(metrics)) {
+    return;
+  }
+
   task_runners_.GetUITaskRunner()->PostTask(
       [engine = engine_->GetWeakPtr(), metrics]() {
         if (engine) {
           engine->SetViewportMetrics(metrics);
         }
       });
-
-  {
-    std::scoped_lock<std::mutex> lock(resize_mutex_);
-    expected_frame_size_ =
-        SkISize::Make(metrics.physical_width, metrics.physical_height);
-  }
 }
 
 // |PlatformView::Delegate|
@@ -921,12 +1211,38 @@ void Shell::OnPlatformViewDispatchPlatformMessage(
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
-  task_runners_.GetUITaskRunner()->PostTask(fml::MakeCopyable(
+  if (settings_.enable_platform_message_batching) {
+    // Only the first message of a batch posts the task that dispatches all of
+    // the messages sent until it runs.
+    bool is_first_message = false;
+    {
+      std::scoped_lock lock(pending_platform_messages_->mutex);
+      is_first_message = pending_platform_messages_->messages.empty();
+      pending_platform_messages_->messages.push_back(std::move(message));
+    }
+    if (is_first_message) {
+      task_runners_.GetUITaskRunner()->PostTask(
+          [engine = engine_->GetWeakPtr(),
+           pending = pending_platform_messages_]() {
+            std::vector<std::unique_ptr<PlatformMessage>> messages;
+            {
+              std::scoped_lock lock(pending->mutex);
+              messages.swap(pending->messages);
+            }
+            if (engine) {
+              engine->DispatchPlatformMessages(std::move(messages));
+            }
+          });
+    }
+    return;
+  }
+
+  task_runners_.GetUITaskRunner()->PostTask(
       [engine = engine_->GetWeakPtr(), message = std::move(message)]() mutable {
         if (engine) {
           engine->DispatchPlatformMessage(std::move(message));
         }
-      }));
+      });
 }
 
 // |PlatformView::Delegate|
@@ -936,16 +1252,71 @@ void Shell::OnPlatformViewDispatchPointerDataPacket(
   TRACE_FLOW_BEGIN("flutter", "PointerEvent", next_pointer_flow_id_);
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
-  task_runners_.GetUITaskRunner()->PostTask(
-      fml::MakeCopyable([engine = weak_engine_, packet = std::move(packet),
-                         flow_id = next_pointer_flow_id_]() mutable {
+  task_runners_.GetUITaskRunner()->PostTaskWithPriority(
+      [engine = weak_engine_, packet = std::move(packet),
+       flow_id = next_pointer_flow_id_]() mutable {
         if (engine) {
           engine->DispatchPointerDataPacket(std::move(packet), flow_id);
         }
-      }));
+      },
+      fml::TaskPriority::kInput);
   next_pointer_flow_id_++;
 }
 
+// |PlatformView::Delegate|
+void Shell::OnPlatformViewDispatchPlatformEvents(
+    std::vector<PlatformEvent> events) {
+  TRACE_EVENT1("flutter", "Shell::OnPlatformViewDispatchPlatformEvents",
+               "count", std::to_string(events.size()).c_str());
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+
+  const uint64_t first_pointer_flow_id = next_pointer_flow_id_;
+  for (auto& event : events) {
+    if (event.viewport_metrics &&
+        !PrepareViewportMetrics(*event.viewport_metrics)) {
+      event.viewport_metrics = std::nullopt;
+    }
+    if (event.pointer_data_packet) {
+      TRACE_FLOW_BEGIN("flutter", "PointerEvent", next_pointer_flow_id_);
+      next_pointer_flow_id_++;
+    }
+  }
+
+  auto task = fml::MakeCopyable(
+      [engine = weak_engine_, events = std::move(events),
+       flow_id = first_pointer_flow_id]() mutable {
+        if (!engine) {
+          return;
+        }
+        std::vector<std::unique_ptr<PlatformMessage>> messages;
+        for (auto& event : events) {
+          if (event.platform_message) {
+            messages.push_back(std::move(event.platform_message));
+            continue;
+          }
+          // The messages are dispatched before the events that follow them.
+          if (!messages.empty()) {
+            engine->DispatchPlatformMessages(std::move(messages));
+            messages.clear();
+          }
+          if (event.viewport_metrics) {
+            engine->SetViewportMetrics(*event.viewport_metrics);
+          }
+          if (event.pointer_data_packet) {
+            engine->DispatchPointerDataPacket(
+                std::move(event.pointer_data_packet), flow_id++);
+          }
+        }
+        if (!messages.empty()) {
+          engine->DispatchPlatformMessages(std::move(messages));
+        }
+      });
+
+  task_runners_.GetUITaskRunner()->PostTaskWithPriority(
+      std::move(task), fml::TaskPriority::kInput);
+}
+
 // |PlatformView::Delegate|
 void Shell::OnPlatformViewDispatchSemanticsAction(int32_t id,
                                                   SemanticsAction action,
@@ -953,13 +1324,14 @@ void Shell::OnPlatformViewDispatchSemanticsAction(int32_t id,
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
-  task_runners_.GetUITaskRunner()->PostTask(
-      fml::MakeCopyable([engine = engine_->GetWeakPtr(), id, action,
-                         args = std::move(args)]() mutable {
+  task_runners_.GetUITaskRunner()->PostTaskWithPriority(
+      [engine = engine_->GetWeakPtr(), id, action,
+       args = std::move(args)]() mutable {
         if (engine) {
           engine->DispatchSemanticsAction(id, action, std::move(args));
         }
-      }));
+      },
+      fml::TaskPriority::kInput);
 }
 
 // |PlatformView::Delegate|
@@ -1074,6 +1446,11 @@ void Shell::OnAnimatorBeginFrame(fml::TimePoint frame_target_time,
     std::scoped_lock time_recorder_lock(time_recorder_mutex_);
     latest_frame_target_time_.emplace(frame_target_time);
   }
+  if (settings_.prefer_performance_cores_when_animating &&
+      !prefers_performance_cores_) {
+    prefers_performance_cores_ = true;
+    SetAnimatingThreadsAffinity(fml::CpuAffinity::kPerformance);
+  }
   if (engine_) {
     engine_->BeginFrame(frame_target_time, frame_number);
   }
@@ -1086,7 +1463,27 @@ void Shell::OnAnimatorNotifyIdle(fml::TimePoint deadline) {
 
   if (engine_) {
     engine_->NotifyIdle(deadline);
-    volatile_path_tracker_->OnFrame();
+  }
+}
+
+// |Animator::Delegate|
+void Shell::OnAnimatorIdle() {
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+
+  if (prefers_performance_cores_) {
+    prefers_performance_cores_ = false;
+    SetAnimatingThreadsAffinity(fml::CpuAffinity::kAny);
+  }
+}
+
+void Shell::SetAnimatingThreadsAffinity(fml::CpuAffinity affinity) {
+  TRACE_EVENT0("flutter", "Shell::SetAnimatingThreadsAffinity");
+  fml::RequestAffinity(affinity);
+  auto raster_task_runner = task_runners_.GetRasterTaskRunner();
+  if (!raster_task_runner->RunsTasksOnCurrentThread()) {
+    raster_task_runner->PostTask(
+        [affinity]() { fml::RequestAffinity(affinity); });
   }
 }
 
@@ -1114,7 +1511,7 @@ void Shell::OnAnimatorDraw(
            tree.frame_size() != expected_frame_size_;
   };
 
-  task_runners_.GetRasterTaskRunner()->PostTask(fml::MakeCopyable(
+  task_runners_.GetRasterTaskRunner()->PostTaskWithPriority(
       [&waiting_for_first_frame = waiting_for_first_frame_,
        &waiting_for_first_frame_condition = waiting_for_first_frame_condition_,
        rasterizer = rasterizer_->GetWeakPtr(),
@@ -1133,7 +1530,8 @@ void Shell::OnAnimatorDraw(
             waiting_for_first_frame_condition.notify_all();
           }
         }
-      }));
+      },
+      fml::TaskPriority::kFrame);
 }
 
 // |Animator::Delegate|
@@ -1149,7 +1547,8 @@ void Shell::OnAnimatorDrawLastLayerTree(
         }
       });
 
-  task_runners_.GetRasterTaskRunner()->PostTask(task);
+  task_runners_.GetRasterTaskRunner()->PostTaskWithPriority(
+      std::move(task), fml::TaskPriority::kFrame);
 }
 
 // |Engine::Delegate|
@@ -1158,11 +1557,20 @@ void Shell::OnEngineUpdateSemantics(SemanticsNodeUpdates update,
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
 
+  // Updates that arrive before the platform thread has delivered the pending
+  // one are merged into it, so that a platform thread that falls behind
+  // delivers the latest state once rather than every intermediate one.
+  if (!semantics_update_coalescer_->Add(std::move(update),
+                                        std::move(actions))) {
+    return;
+  }
   task_runners_.GetPlatformTaskRunner()->PostTask(
-      [view = platform_view_->GetWeakPtr(), update = std::move(update),
-       actions = std::move(actions)] {
+      [view = platform_view_->GetWeakPtr(),
+       coalescer = semantics_update_coalescer_]() {
+        SemanticsUpdateCoalescer::Update pending = coalescer->Take();
         if (view) {
-          view->UpdateSemantics(std::move(update), std::move(actions));
+          view->UpdateSemantics(std::move(pending.nodes),
+                                std::move(pending.actions));
         }
       });
 }
@@ -1372,6 +1780,25 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  frame_timing_histograms_.Record(timing);
+  RecordFrameStats(timing);
+
+  if (settings_.defer_service_isolate_launch &&
+      !released_deferred_service_isolate_launch_) {
+    released_deferred_service_isolate_launch_ = true;
+    DartServiceIsolate::ReleaseDeferredLaunch();
+  }
+
+  if (settings_.enable_adaptive_pipeline_depth ||
+      settings_.enable_predictive_frame_scheduling) {
+    task_runners_.GetUITaskRunner()->PostTask(
+        [engine = weak_engine_, timing]() {
+          if (engine) {
+            engine->OnFrameRasterized(timing);
+          }
+        });
+  }
+
   if (!needs_report_timings_) {
     return;
   }
@@ -1416,7 +1843,7 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     // second. Otherwise, the timings of last few frames of an animation may
     // never be reported until the next animation starts.
     frame_timings_report_scheduled_ = true;
-    task_runners_.GetRasterTaskRunner()->PostDelayedTask(
+    task_runners_.GetRasterTaskRunner()->PostDelayedTaskWithPriority(
         [self = weak_factory_gpu_->GetWeakPtr()]() {
           if (!self) {
             return;
@@ -1426,8 +1853,115 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
             self->ReportTimings();
           }
         },
-        fml::TimeDelta::FromMilliseconds(kBatchTimeInMilliseconds));
+        fml::TimeDelta::FromMilliseconds(kBatchTimeInMilliseconds),
+        fml::TaskPriority::kIdle);
+  }
+}
+
+void Shell::RecordFrameStats(const FrameTiming& timing) {
+  const Rasterizer::DamageStatisticsTotals& totals =
+      rasterizer_->GetDamageStatisticsTotals();
+  const Rasterizer::DamageStatisticsTotals last_totals =
+      last_damage_statistics_totals_;
+  last_damage_statistics_totals_ = totals;
+  if (!ServiceProtocol::IsFrameStatsStreamListened()) {
+    return;
+  }
+
+  if (!unsent_frame_stats_.IsArray()) {
+    unsent_frame_stats_.SetArray();
+  }
+  auto& allocator = unsent_frame_stats_.GetAllocator();
+  rapidjson::Value record(rapidjson::kObjectType);
+  record.AddMember<uint64_t>("frameNumber", timing.GetFrameNumber(),
+                             allocator);
+  constexpr std::pair<FrameTiming::Phase, const char*> kPhases[] = {
+      {FrameTiming::kVsyncStart, "vsyncStart"},
+      {FrameTiming::kBuildStart, "buildStart"},
+      {FrameTiming::kBuildFinish, "buildFinish"},
+      {FrameTiming::kRasterStart, "rasterStart"},
+      {FrameTiming::kRasterFinish, "rasterFinish"},
+  };
+  for (const auto& [phase, name] : kPhases) {
+    record.AddMember<int64_t>(
+        rapidjson::StringRef(name),
+        timing.Get(phase).ToEpochDelta().ToMicroseconds(), allocator);
   }
+
+  record.AddMember<bool>("skipped", timing.IsSkipped(), allocator);
+  record.AddMember<uint64_t>("layerCacheCount", timing.GetLayerCacheCount(),
+                             allocator);
+  record.AddMember<uint64_t>("layerCacheBytes", timing.GetLayerCacheBytes(),
+                             allocator);
+  record.AddMember<uint64_t>("pictureCacheCount",
+                             timing.GetPictureCacheCount(), allocator);
+  record.AddMember<uint64_t>("pictureCacheBytes",
+                             timing.GetPictureCacheBytes(), allocator);
+  record.AddMember<uint64_t>(
+      "gpuResourceBytes",
+      rasterizer_->GetResourceCacheUsageBytes().value_or(0), allocator);
+
+  // The totals only change for the frames rasterized with partial repaint.
+  if (totals.frame_count > last_totals.frame_count) {
+    record.AddMember<int64_t>("damagedPixels",
+                              totals.damage_area - last_totals.damage_area,
+                              allocator);
+    record.AddMember<int64_t>("framePixels",
+                              totals.frame_area - last_totals.frame_area,
+                              allocator);
+    record.AddMember<int64_t>("diffedLayers",
+                              totals.diffed_layers - last_totals.diffed_layers,
+                              allocator);
+    record.AddMember<int64_t>(
+        "retainedLayers", totals.retained_layers - last_totals.retained_layers,
+        allocator);
+    record.AddMember<int64_t>(
+        "computeDamageMicros",
+        (totals.compute_damage_time - last_totals.compute_damage_time)
+            .ToMicroseconds(),
+        allocator);
+  }
+
+  const Rasterizer::PipelineStatistics& pipeline =
+      rasterizer_->GetLastPipelineStatistics();
+  record.AddMember<uint64_t>("pipelineDepth", pipeline.depth, allocator);
+  record.AddMember<int64_t>("framesInFlight", pipeline.frames_in_flight,
+                            allocator);
+  unsent_frame_stats_.PushBack(record, allocator);
+
+  if (frame_stats_send_scheduled_) {
+    return;
+  }
+  // Sends the records in batches, as often as the timings are reported to the
+  // tools in the profile and debug modes.
+  constexpr int kFrameStatsBatchTimeInMilliseconds = 100;
+  frame_stats_send_scheduled_ = true;
+  task_runners_.GetRasterTaskRunner()->PostDelayedTaskWithPriority(
+      [self = weak_factory_gpu_->GetWeakPtr()]() {
+        if (!self) {
+          return;
+        }
+        self->frame_stats_send_scheduled_ = false;
+        self->SendFrameStats();
+      },
+      fml::TimeDelta::FromMilliseconds(kFrameStatsBatchTimeInMilliseconds),
+      fml::TaskPriority::kIdle);
+}
+
+void Shell::SendFrameStats() {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  rapidjson::Document frames;
+  frames.Swap(unsent_frame_stats_);
+  if (!frames.IsArray() || frames.Empty()) {
+    return;
+  }
+
+  rapidjson::Document event;
+  auto& allocator = event.GetAllocator();
+  event.SetObject();
+  event.AddMember("type", "FrameStats", allocator);
+  event.AddMember("frames", rapidjson::Value(frames, allocator), allocator);
+  ServiceProtocol::SendFrameStatsEvent(event);
 }
 
 fml::Milliseconds Shell::GetFrameBudget() {
@@ -1715,6 +2249,169 @@ bool Shell::OnServiceProtocolEstimateRasterCacheMemory(
   return true;
 }
 
+bool Shell::OnServiceProtocolGetFrameTimingPercentiles(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "FrameTimingPercentiles", allocator);
+  response->AddMember<uint64_t>(
+      "frameCount", frame_timing_histograms_.GetFrameCount(), allocator);
+  constexpr std::pair<FrameTimingHistograms::Phase, const char*> kPhases[] = {
+      {FrameTimingHistograms::kBuild, "buildDuration"},
+      {FrameTimingHistograms::kRaster, "rasterDuration"},
+      {FrameTimingHistograms::kVsyncOverhead, "vsyncOverhead"},
+      {FrameTimingHistograms::kTotalSpan, "totalSpan"},
+  };
+  for (const auto& [phase, name] : kPhases) {
+    rapidjson::Value micros;
+    micros.SetObject();
+    micros.AddMember<int64_t>(
+        "p50",
+        frame_timing_histograms_.GetPercentile(phase, 50).ToMicroseconds(),
+        allocator);
+    micros.AddMember<int64_t>(
+        "p90",
+        frame_timing_histograms_.GetPercentile(phase, 90).ToMicroseconds(),
+        allocator);
+    micros.AddMember<int64_t>(
+        "p99",
+        frame_timing_histograms_.GetPercentile(phase, 99).ToMicroseconds(),
+        allocator);
+    micros.AddMember<int64_t>(
+        "max", frame_timing_histograms_.GetMax(phase).ToMicroseconds(),
+        allocator);
+    response->AddMember(rapidjson::StringRef(name), micros, allocator);
+  }
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetTraceRingBuffer(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  const std::string json = fml::tracing::TraceRingBufferToChromeTraceJson();
+  rapidjson::Document trace;
+  trace.Parse(json.c_str(), json.size());
+  FML_DCHECK(!trace.HasParseError());
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "TraceRingBuffer", allocator);
+  response->AddMember("enabled", fml::tracing::TraceRingBufferIsEnabled(),
+                      allocator);
+  rapidjson::Value events(trace["traceEvents"], allocator);
+  response->AddMember("traceEvents", events, allocator);
+  return true;
+}
+
+static const char* RasterCacheEntryTypeName(RasterCache::EntryInfo::Type type) {
+  switch (type) {
+    case RasterCache::EntryInfo::Type::kPicture:
+      return "Picture";
+    case RasterCache::EntryInfo::Type::kDisplayList:
+      return "DisplayList";
+    case RasterCache::EntryInfo::Type::kLayer:
+      return "Layer";
+    case RasterCache::EntryInfo::Type::kShadow:
+      return "Shadow";
+  }
+  return "Unknown";
+}
+
+static rapidjson::Value BytesByNameToJson(
+    const std::map<std::string, size_t>& bytes_by_name,
+    rapidjson::Document::AllocatorType& allocator) {
+  rapidjson::Value json(rapidjson::kObjectType);
+  for (const auto& [name, bytes] : bytes_by_name) {
+    json.AddMember(rapidjson::Value(name, allocator),
+                   rapidjson::Value(static_cast<uint64_t>(bytes)), allocator);
+  }
+  return json;
+}
+
+bool Shell::OnServiceProtocolGetGpuMemoryUsage(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  const Rasterizer::GpuMemoryUsage usage = rasterizer_->GetGpuMemoryUsage();
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "GpuMemoryUsage", allocator);
+
+  rapidjson::Value entries(rapidjson::kArrayType);
+  uint64_t raster_cache_bytes = 0;
+  for (const auto& info : usage.raster_cache_entries) {
+    rapidjson::Value entry(rapidjson::kObjectType);
+    entry.AddMember("type",
+                    rapidjson::StringRef(RasterCacheEntryTypeName(info.type)),
+                    allocator);
+    // The ids are 64-bit, which JSON numbers cannot represent exactly.
+    entry.AddMember("id", rapidjson::Value(std::to_string(info.id), allocator),
+                    allocator);
+    entry.AddMember("width", info.image_dimensions.width(), allocator);
+    entry.AddMember("height", info.image_dimensions.height(), allocator);
+    entry.AddMember<uint64_t>("bytes", info.image_bytes, allocator);
+    entry.AddMember<uint64_t>("accessCount", info.access_count, allocator);
+    entries.PushBack(entry, allocator);
+    raster_cache_bytes += info.image_bytes;
+  }
+  rapidjson::Value raster_cache(rapidjson::kObjectType);
+  raster_cache.AddMember("totalBytes", raster_cache_bytes, allocator);
+  raster_cache.AddMember("entries", entries, allocator);
+  response->AddMember("rasterCache", raster_cache, allocator);
+
+  rapidjson::Value skia(rapidjson::kObjectType);
+  skia.AddMember<uint64_t>("totalBytes", usage.skia_total_bytes, allocator);
+  skia.AddMember<uint64_t>("purgeableBytes", usage.skia_purgeable_bytes,
+                           allocator);
+  skia.AddMember("bytesByType",
+                 BytesByNameToJson(usage.skia_bytes_by_type, allocator),
+                 allocator);
+  skia.AddMember("bytesByCategory",
+                 BytesByNameToJson(usage.skia_bytes_by_category, allocator),
+                 allocator);
+  response->AddMember("skiaResourceCache", skia, allocator);
+
+  response->AddMember<uint64_t>("externalTextureBytes",
+                                usage.external_texture_bytes, allocator);
+  response->AddMember<uint64_t>("overlaySurfaceBytes",
+                                usage.overlay_surface_bytes, allocator);
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetPartialRepaintStatistics(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  const Rasterizer::DamageStatisticsTotals& totals =
+      rasterizer_->GetDamageStatisticsTotals();
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "PartialRepaintStatistics", allocator);
+  response->AddMember<uint64_t>("frameCount", totals.frame_count, allocator);
+  response->AddMember<int64_t>("damagedPixels", totals.damage_area, allocator);
+  response->AddMember<int64_t>("framePixels", totals.frame_area, allocator);
+  double repainted_fraction =
+      totals.frame_area > 0
+          ? static_cast<double>(totals.damage_area) / totals.frame_area
+          : 0.0;
+  response->AddMember("repaintedFraction", repainted_fraction, allocator);
+  response->AddMember<int64_t>("diffedLayers", totals.diffed_layers, allocator);
+  response->AddMember<int64_t>("retainedLayers", totals.retained_layers,
+                               allocator);
+  int64_t average_compute_damage_micros =
+      totals.frame_count > 0
+          ? totals.compute_damage_time.ToMicroseconds() / totals.frame_count
+          : 0;
+  response->AddMember<int64_t>("averageComputeDamageMicros",
+                               average_compute_damage_micros, allocator);
+  response->AddMember<int64_t>("maxComputeDamageMicros",
+                               totals.max_compute_damage_time.ToMicroseconds(),
+                               allocator);
+  return true;
+}
+
 // Service protocol handler
 bool Shell::OnServiceProtocolSetAssetBundlePath(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
@@ -1788,6 +2485,71 @@ Rasterizer::Screenshot Shell::Screenshot(
   return screenshot;
 }
 
+Shell::Statistics Shell::GetStatistics() {
+  TRACE_EVENT0("flutter", "Shell::GetStatistics");
+  Statistics statistics;
+  // Counted before the tasks below are posted.
+  statistics.platform_pending_tasks =
+      task_runners_.GetPlatformTaskRunner()->GetNumPendingTasks();
+  statistics.ui_pending_tasks =
+      task_runners_.GetUITaskRunner()->GetNumPendingTasks();
+  statistics.raster_pending_tasks =
+      task_runners_.GetRasterTaskRunner()->GetNumPendingTasks();
+  statistics.io_pending_tasks =
+      task_runners_.GetIOTaskRunner()->GetNumPendingTasks();
+
+  fml::AutoResetWaitableEvent latch;
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetRasterTaskRunner(),
+      [&latch, &statistics, rasterizer = GetRasterizer()]() {
+        if (rasterizer) {
+          const auto& raster_cache =
+              rasterizer->compositor_context()->raster_cache();
+          statistics.raster_cache_layer_metrics = raster_cache.layer_metrics();
+          statistics.raster_cache_picture_metrics =
+              raster_cache.picture_metrics();
+          statistics.resource_cache_max_bytes =
+              rasterizer->GetResourceCacheMaxBytes();
+          statistics.resource_cache_usage_bytes =
+              rasterizer->GetResourceCacheUsageBytes();
+        }
+        latch.Signal();
+      });
+  latch.Wait();
+
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetUITaskRunner(),
+      [&latch, &statistics, engine = weak_engine_]() {
+        if (engine) {
+          const Animator& animator = engine->GetAnimator();
+          statistics.layer_tree_pipeline_depth =
+              animator.GetLayerTreePipelineDepth();
+          statistics.layer_tree_pipeline_inflight_count =
+              animator.GetLayerTreePipelineInflightCount();
+        }
+        latch.Signal();
+      });
+  latch.Wait();
+  return statistics;
+}
+
+void Shell::ScreenshotAsync(Rasterizer::ScreenshotType screenshot_type,
+                            bool base64_encode,
+                            Rasterizer::ScreenshotCallback callback) {
+  TRACE_EVENT0("flutter", "Shell::ScreenshotAsync");
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetRasterTaskRunner(),
+      [rasterizer = GetRasterizer(), screenshot_type, base64_encode,
+       callback = std::move(callback)]() {
+        if (!rasterizer) {
+          callback({});
+          return;
+        }
+        rasterizer->ScreenshotLastLayerTreeAsync(screenshot_type, base64_encode,
+                                                 std::move(callback));
+      });
+}
+
 fml::Status Shell::WaitForFirstFrame(fml::TimeDelta timeout) {
   FML_DCHECK(is_setup_);
   if (task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread() ||
@@ -1852,6 +2614,11 @@ std::shared_ptr<const fml::SyncSwitch> Shell::GetIsGpuDisabledSyncSwitch()
   return is_gpu_disabled_sync_switch_;
 }
 
+std::shared_ptr<fml::ConcurrentTaskRunner>
+Shell::GetConcurrentWorkerTaskRunner() const {
+  return vm_ ? vm_->GetConcurrentWorkerTaskRunner() : nullptr;
+}
+
 void Shell::SetGpuAvailability(GpuAvailability availability) {
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
   switch (availability) {
@@ -1886,6 +2653,20 @@ fml::TimePoint Shell::GetCurrentTimePoint() {
   return fml::TimePoint::Now();
 }
 
+// |Engine::Delegate|
+void Shell::OnEngineWarmUpGlyphs(std::vector<sk_sp<SkPicture>> pictures) {
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+
+  task_runners_.GetRasterTaskRunner()->PostTask(
+      [rasterizer = rasterizer_->GetWeakPtr(),
+       pictures = std::move(pictures)]() mutable {
+        if (rasterizer) {
+          rasterizer->WarmUpGlyphs(std::move(pictures));
+        }
+      }));
+}
+
 const std::shared_ptr<PlatformMessageHandler>&
 Shell::GetPlatformMessageHandler() const {
   return platform_message_handler_;
@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <mutex>
+#include <optional>
 #include <string_view>
 #include <unordered_map>
 
@@ -14,8 +15,10 @@
 #include "flutter/common/graphics/texture.h"
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/flow/frame_timing_histograms.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/closure.h"
+#include "flutter/fml/cpu_affinity.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/fml/memory/thread_checker.h"
@@ -36,8 +39,10 @@
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/display_manager.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/memory_pressure_controller.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
+#include "flutter/shell/common/semantics_update_coalescer.h"
 #include "flutter/shell/common/shell_io_manager.h"
 
 namespace flutter {
@@ -279,10 +284,29 @@ class Shell final : public PlatformView::Delegate,
 
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to notify that there is a low memory
-  ///             warning. The shell will attempt to purge caches. Current, only
-  ///             the rasterizer cache is purged.
+  ///             warning. The shell empties its caches, as for critical
+  ///             memory pressure.
   void NotifyLowMemoryWarning() const;
 
+  using MemoryPressureCallback =
+      std::function<void(const MemoryPressureReport& report)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Used by embedders to notify that the system is under memory
+  ///             pressure. Under moderate pressure, the caches are trimmed
+  ///             down to `Settings::memory_pressure_target_bytes`, from the
+  ///             raster cache to the overlay surfaces of platform views.
+  ///             Under critical pressure, they are emptied, and the Dart VM
+  ///             and the Skia context of the rasterizer are asked to free
+  ///             memory too.
+  ///
+  /// @param[in]  level     How much memory to give back.
+  /// @param[in]  callback  Called on the raster thread with the memory freed
+  ///                       from each cache, once they are trimmed.
+  ///
+  void NotifyMemoryPressure(MemoryPressureLevel level,
+                            MemoryPressureCallback callback = nullptr) const;
+
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to check if all shell subcomponents are
   ///             initialized. It is the embedder's responsibility to make this
@@ -309,6 +333,59 @@ class Shell final : public PlatformView::Delegate,
   Rasterizer::Screenshot Screenshot(Rasterizer::ScreenshotType type,
                                     bool base64_encode);
 
+  //----------------------------------------------------------------------------
+  /// @brief      A snapshot of the state of the shell that its performance
+  ///             depends on, as gathered by `GetStatistics`.
+  ///
+  struct Statistics {
+    /// The layers cached by the raster cache during the last frame.
+    RasterCacheMetrics raster_cache_layer_metrics;
+    /// The pictures and display lists cached by the raster cache during the
+    /// last frame.
+    RasterCacheMetrics raster_cache_picture_metrics;
+    /// The limit of Skia's resource cache, if a surface is present.
+    std::optional<size_t> resource_cache_max_bytes;
+    /// The bytes used by Skia's resource cache, if a surface is present.
+    std::optional<size_t> resource_cache_usage_bytes;
+    /// The pending tasks of each task runner, see
+    /// `fml::TaskRunner::GetNumPendingTasks`.
+    size_t platform_pending_tasks = 0;
+    size_t ui_pending_tasks = 0;
+    size_t raster_pending_tasks = 0;
+    size_t io_pending_tasks = 0;
+    /// See `Animator::GetLayerTreePipelineDepth`.
+    uint32_t layer_tree_pipeline_depth = 0;
+    /// See `Animator::GetLayerTreePipelineInflightCount`.
+    int layer_tree_pipeline_inflight_count = 0;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Gathers the statistics of the shell on the raster and the UI
+  ///             threads, blocking the calling thread until they are. The
+  ///             durations of the frames are kept by the histograms of
+  ///             `GetFrameTimingHistograms` instead.
+  ///
+  /// @return     The statistics of the shell.
+  ///
+  Statistics GetStatistics();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Captures a screenshot like `Screenshot`, without blocking the
+  ///             calling thread, and without blocking the raster thread on
+  ///             the readback or the encoding of the screenshot.
+  ///
+  /// @param[in]  type           The type of screenshot to capture.
+  /// @param[in]  base64_encode  If the screenshot data should be base64
+  ///                            encoded.
+  /// @param[in]  callback       Called on the concurrent worker task runner
+  ///                            with the screenshot result.
+  ///
+  /// @see        `Rasterizer::ScreenshotLastLayerTreeAsync`
+  ///
+  void ScreenshotAsync(Rasterizer::ScreenshotType type,
+                       bool base64_encode,
+                       Rasterizer::ScreenshotCallback callback);
+
   //----------------------------------------------------------------------------
   /// @brief      Pauses the calling thread until the first frame is presented.
   ///
@@ -357,6 +434,10 @@ class Shell final : public PlatformView::Delegate,
   std::shared_ptr<const fml::SyncSwitch> GetIsGpuDisabledSyncSwitch()
       const override;
 
+  // |Rasterizer::Delegate|
+  std::shared_ptr<fml::ConcurrentTaskRunner> GetConcurrentWorkerTaskRunner()
+      const override;
+
   //----------------------------------------------------------------------------
   /// @brief     Marks the GPU as available or unavailable.
   void SetGpuAvailability(GpuAvailability availability);
@@ -380,6 +461,15 @@ class Shell final : public PlatformView::Delegate,
   ///
   double GetMainDisplayRefreshRate();
 
+  //----------------------------------------------------------------------------
+  /// @brief      The histograms of the durations of the phases of every frame
+  ///             rasterized by this shell. They may be queried from any
+  ///             thread.
+  ///
+  const FrameTimingHistograms& GetFrameTimingHistograms() const {
+    return frame_timing_histograms_;
+  }
+
   //----------------------------------------------------------------------------
   /// @brief      Install a new factory that can match against and decode image
   ///             data.
@@ -440,6 +530,7 @@ class Shell final : public PlatformView::Delegate,
   uint64_t next_pointer_flow_id_ = 0;
 
   bool first_frame_rasterized_ = false;
+  bool released_deferred_service_isolate_launch_ = false;
   std::atomic<bool> waiting_for_first_frame_ = true;
   std::mutex waiting_for_first_frame_mutex_;
   std::condition_variable waiting_for_first_frame_condition_;
@@ -452,11 +543,27 @@ class Shell final : public PlatformView::Delegate,
   // ui.Window.onReportTimings.
   bool frame_timings_report_scheduled_ = false;
 
+  // Whether the UI and raster threads have been moved to the performance
+  // cores for the frames being produced. Only used on the UI thread.
+  bool prefers_performance_cores_ = false;
+
   // Vector of FrameTiming::kCount * n timestamps for n frames whose timings
   // have not been reported yet. Vector of ints instead of FrameTiming is stored
   // here for easier conversions to Dart objects.
   std::vector<int64_t> unreported_timings_;
 
+  // Unlike the timings reported to Dart, these are recorded for every frame.
+  FrameTimingHistograms frame_timing_histograms_;
+
+  // The records of the rasterized frames that have not been sent to the
+  // service protocol stream of frame stats yet. Only used on the raster
+  // thread.
+  rapidjson::Document unsent_frame_stats_;
+  bool frame_stats_send_scheduled_ = false;
+  // The damage statistics totals when the last frame was rasterized, which
+  // the totals are compared to for the damage of each frame.
+  Rasterizer::DamageStatisticsTotals last_damage_statistics_totals_;
+
   /// Manages the displays. This class is thread safe, can be accessed from any
   /// of the threads.
   std::unique_ptr<DisplayManager> display_manager_;
@@ -473,6 +580,23 @@ class Shell final : public PlatformView::Delegate,
 
   sk_sp<GrDirectContext> shared_resource_context_;
 
+  // The budget of the raster cache, which is shared with the shells spawned
+  // from this one and with the shell that this one was spawned from.
+  std::shared_ptr<RasterCacheBudget> raster_cache_budget_;
+
+  // The platform messages waiting for the UI task that dispatches them as a
+  // batch. See |Settings::enable_platform_message_batching|.
+  struct PendingPlatformMessages {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<PlatformMessage>> messages;
+  };
+  std::shared_ptr<PendingPlatformMessages> pending_platform_messages_ =
+      std::make_shared<PendingPlatformMessages>();
+
+  // The semantics updates waiting for the platform task that delivers them.
+  std::shared_ptr<SemanticsUpdateCoalescer> semantics_update_coalescer_ =
+      std::make_shared<SemanticsUpdateCoalescer>();
+
   Shell(DartVMRef vm,
         TaskRunners task_runners,
         fml::RefPtr<fml::RasterThreadMerger> parent_merger,
@@ -484,6 +608,7 @@ class Shell final : public PlatformView::Delegate,
       DartVMRef vm,
       fml::RefPtr<fml::RasterThreadMerger> parent_merger,
       std::shared_ptr<ShellIOManager> parent_io_manager,
+      std::shared_ptr<RasterCacheBudget> parent_raster_cache_budget,
       TaskRunners task_runners,
       const PlatformData& platform_data,
       Settings settings,
@@ -497,6 +622,7 @@ class Shell final : public PlatformView::Delegate,
       TaskRunners task_runners,
       fml::RefPtr<fml::RasterThreadMerger> parent_thread_merger,
       std::shared_ptr<ShellIOManager> parent_io_manager,
+      std::shared_ptr<RasterCacheBudget> parent_raster_cache_budget,
       Settings settings,
       DartVMRef vm,
       fml::RefPtr<const DartSnapshot> isolate_snapshot,
@@ -512,6 +638,17 @@ class Shell final : public PlatformView::Delegate,
 
   void ReportTimings();
 
+  // Records the stats of the rasterized frame for the service protocol stream
+  // of frame stats, if a client listens to it, and schedules them to be sent.
+  void RecordFrameStats(const FrameTiming& timing);
+
+  void SendFrameStats();
+
+  // Validates the viewport metrics sent by the platform and prepares the
+  // rasterizer for the frames of their size. Returns false if the metrics are
+  // invalid and must be ignored.
+  bool PrepareViewportMetrics(const ViewportMetrics& metrics);
+
   // |PlatformView::Delegate|
   void OnPlatformViewCreated(std::unique_ptr<Surface> surface) override;
 
@@ -530,6 +667,10 @@ class Shell final : public PlatformView::Delegate,
   void OnPlatformViewDispatchPointerDataPacket(
       std::unique_ptr<PointerDataPacket> packet) override;
 
+  // |PlatformView::Delegate|
+  void OnPlatformViewDispatchPlatformEvents(
+      std::vector<PlatformEvent> events) override;
+
   // |PlatformView::Delegate|
   void OnPlatformViewDispatchSemanticsAction(int32_t id,
                                              SemanticsAction action,
@@ -576,6 +717,9 @@ class Shell final : public PlatformView::Delegate,
   // |Animator::Delegate|
   void OnAnimatorNotifyIdle(fml::TimePoint deadline) override;
 
+  // |Animator::Delegate|
+  void OnAnimatorIdle() override;
+
   // |Animator::Delegate|
   void OnAnimatorDraw(
       std::shared_ptr<Pipeline<flutter::LayerTree>> pipeline,
@@ -585,6 +729,9 @@ class Shell final : public PlatformView::Delegate,
   void OnAnimatorDrawLastLayerTree(
       std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) override;
 
+  // Moves the UI and raster threads to the cores of the given kind.
+  void SetAnimatingThreadsAffinity(fml::CpuAffinity affinity);
+
   // |Engine::Delegate|
   void OnEngineUpdateSemantics(
       SemanticsNodeUpdates update,
@@ -619,6 +766,9 @@ class Shell final : public PlatformView::Delegate,
   // |Engine::Delegate|
   fml::TimePoint GetCurrentTimePoint() override;
 
+  // |Engine::Delegate|
+  void OnEngineWarmUpGlyphs(std::vector<sk_sp<SkPicture>> pictures) override;
+
   // |Rasterizer::Delegate|
   void OnFrameRasterized(const FrameTiming&) override;
 
@@ -684,6 +834,39 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Aggregates the damage statistics of the frames rasterized with partial
+  // repaint so far.
+  bool OnServiceProtocolGetPartialRepaintStatistics(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the 50th, 90th and 99th percentiles and the maximum of the
+  // durations of the phases of the frames rasterized so far.
+  bool OnServiceProtocolGetFrameTimingPercentiles(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the trace events recorded into the trace ring buffers, as Chrome
+  // trace events.
+  bool OnServiceProtocolGetTraceRingBuffer(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the GPU memory held by the raster cache, by entry, by the Skia
+  // resource cache, by category, and by the external textures and overlay
+  // surfaces.
+  bool OnServiceProtocolGetGpuMemoryUsage(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Creates an asset bundle from the original settings asset path or
   // directory.
   std::unique_ptr<DirectoryAssetBundle> RestoreOriginalAssetResolver();
@@ -0,0 +1,195 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/shell/common/shell_test.h"
+#include "flutter/shell/common/shell_test_platform_view.h"
+#include "flutter/shell/common/thread_host.h"
+#include "flutter/shell/common/vsync_waiters_test.h"
+#include "flutter/testing/dart_fixture.h"
+
+namespace flutter::testing {
+
+namespace {
+
+using BackendType = ShellTestPlatformView::BackendType;
+
+// The number of frames rendered by each iteration.
+constexpr size_t kFrameCount = 120;
+
+// The times of the frames rendered by all the iterations, in milliseconds.
+struct FrameTimes {
+  std::vector<double> build;
+  std::vector<double> raster;
+  // From the start of the build to the end of the rasterization.
+  std::vector<double> total;
+  size_t max_raster_cache_bytes = 0;
+};
+
+double ToMilliseconds(fml::TimeDelta delta) {
+  return delta.ToMicroseconds() / 1000.0;
+}
+
+double Percentile(std::vector<double> times, double percentile) {
+  if (times.empty()) {
+    return 0;
+  }
+  size_t index = std::min(times.size() - 1,
+                          static_cast<size_t>(percentile * times.size()));
+  std::nth_element(times.begin(), times.begin() + index, times.end());
+  return times[index];
+}
+
+void ReportPercentiles(benchmark::State& state,
+                       const std::string& name,
+                       const std::vector<double>& times) {
+  state.counters[name + "_p50_ms"] = Percentile(times, 0.5);
+  state.counters[name + "_p90_ms"] = Percentile(times, 0.9);
+  state.counters[name + "_p99_ms"] = Percentile(times, 0.99);
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+/// Runs the given entrypoint of the shell test fixtures on a shell that
+/// renders with the given backend, until |kFrameCount| frames are rasterized,
+/// and reports the percentiles of the build, raster and total times of the
+/// frames as counters.
+///
+/// The vsync waiter fires as soon as a frame is requested, so the time of
+/// each iteration is the time it takes to render the frames back to back.
+///
+static void BM_ShellFrames(benchmark::State& state,
+                           const char* entrypoint,
+                           BackendType backend) {
+  DartFixture fixture;
+  FrameTimes times;
+
+  while (state.KeepRunning()) {
+    std::unique_ptr<ThreadHost> thread_host;
+    std::unique_ptr<Shell> shell;
+    fml::AutoResetWaitableEvent frames_rasterized;
+    size_t frame_count = 0;
+
+    {
+      benchmarking::ScopedPauseTiming pause(state);
+      thread_host = std::make_unique<ThreadHost>(ThreadHost::ThreadHostConfig(
+          "io.flutter.bench.", ThreadHost::Type::Platform |
+                                   ThreadHost::Type::RASTER |
+                                   ThreadHost::Type::IO | ThreadHost::Type::UI));
+      TaskRunners task_runners("test",
+                               thread_host->platform_thread->GetTaskRunner(),
+                               thread_host->raster_thread->GetTaskRunner(),
+                               thread_host->ui_thread->GetTaskRunner(),
+                               thread_host->io_thread->GetTaskRunner());
+
+      Settings settings = fixture.CreateSettingsForFixture();
+      settings.frame_rasterized_callback = [&](const FrameTiming& timing) {
+        if (frame_count == kFrameCount) {
+          return;
+        }
+        fml::TimePoint build_start = timing.Get(FrameTiming::kBuildStart);
+        fml::TimePoint raster_start = timing.Get(FrameTiming::kRasterStart);
+        fml::TimePoint raster_finish = timing.Get(FrameTiming::kRasterFinish);
+        times.build.push_back(ToMilliseconds(
+            timing.Get(FrameTiming::kBuildFinish) - build_start));
+        times.raster.push_back(ToMilliseconds(raster_finish - raster_start));
+        times.total.push_back(ToMilliseconds(raster_finish - build_start));
+        times.max_raster_cache_bytes = std::max<size_t>(
+            times.max_raster_cache_bytes,
+            timing.GetLayerCacheBytes() + timing.GetPictureCacheBytes());
+        if (++frame_count == kFrameCount) {
+          frames_rasterized.Signal();
+        }
+      };
+
+      shell = Shell::Create(
+          flutter::PlatformData(), task_runners, settings,
+          [backend](Shell& shell) {
+            const TaskRunners& task_runners = shell.GetTaskRunners();
+            return ShellTestPlatformView::Create(
+                shell, task_runners, std::make_shared<ShellTestVsyncClock>(),
+                [task_runners]() {
+                  return static_cast<std::unique_ptr<VsyncWaiter>>(
+                      std::make_unique<ConstantFiringVsyncWaiter>(
+                          task_runners));
+                },
+                backend, nullptr);
+          },
+          [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+      FML_CHECK(shell);
+
+      ShellTest::PlatformViewNotifyCreated(shell.get());
+      fml::AutoResetWaitableEvent latch;
+      fml::TaskRunner::RunNowOrPostTask(
+          task_runners.GetPlatformTaskRunner(), [&shell, &latch]() {
+            ViewportMetrics metrics;
+            metrics.device_pixel_ratio = 1;
+            metrics.physical_width = 800;
+            metrics.physical_height = 600;
+            shell->GetPlatformView()->SetViewportMetrics(metrics);
+            latch.Signal();
+          });
+      latch.Wait();
+
+      auto configuration = RunConfiguration::InferFromSettings(settings);
+      configuration.SetEntrypoint(entrypoint);
+      ShellTest::RunEngine(shell.get(), std::move(configuration));
+    }
+
+    frames_rasterized.Wait();
+
+    {
+      benchmarking::ScopedPauseTiming pause(state);
+      fml::AutoResetWaitableEvent latch;
+      fml::TaskRunner::RunNowOrPostTask(
+          thread_host->platform_thread->GetTaskRunner(),
+          [&shell, &latch]() mutable {
+            shell.reset();
+            latch.Signal();
+          });
+      latch.Wait();
+      thread_host.reset();
+    }
+  }
+
+  ReportPercentiles(state, "build", times.build);
+  ReportPercentiles(state, "raster", times.raster);
+  ReportPercentiles(state, "total", times.total);
+  state.counters["raster_cache_bytes"] =
+      static_cast<double>(times.max_raster_cache_bytes);
+}
+
+#define SHELL_FRAME_BENCHMARKS(backend_name, backend)                      \
+  BENCHMARK_CAPTURE(BM_ShellFrames, ScrollingList##backend_name,           \
+                    "benchmarkScrollingList", backend)                     \
+      ->Unit(benchmark::kMillisecond);                                     \
+  BENCHMARK_CAPTURE(BM_ShellFrames, Animation##backend_name,               \
+                    "benchmarkAnimation", backend)                         \
+      ->Unit(benchmark::kMillisecond);                                     \
+  BENCHMARK_CAPTURE(BM_ShellFrames, TextPage##backend_name,                \
+                    "benchmarkTextPage", backend)                          \
+      ->Unit(benchmark::kMillisecond);
+
+#ifdef SHELL_ENABLE_SOFTWARE
+SHELL_FRAME_BENCHMARKS(Software, BackendType::kSoftwareBackend)
+#endif  // SHELL_ENABLE_SOFTWARE
+
+#ifdef SHELL_ENABLE_GL
+SHELL_FRAME_BENCHMARKS(GL, BackendType::kGLBackend)
+#endif  // SHELL_ENABLE_GL
+
+#ifdef SHELL_ENABLE_METAL
+SHELL_FRAME_BENCHMARKS(Metal, BackendType::kMetalBackend)
+#endif  // SHELL_ENABLE_METAL
+
+#ifdef SHELL_ENABLE_VULKAN
+SHELL_FRAME_BENCHMARKS(Vulkan, BackendType::kVulkanBackend)
+#endif  // SHELL_ENABLE_VULKAN
+
+}  // namespace flutter::testing
@@ -110,4 +110,14 @@ ShellIOManager::GetIsGpuDisabledSyncSwitch() {
   return is_gpu_disabled_sync_switch_;
 }
 
+void ShellIOManager::SetDecodedImageCache(
+    std::shared_ptr<DecodedImageCache> cache) {
+  decoded_image_cache_ = std::move(cache);
+}
+
+std::shared_ptr<DecodedImageCache> ShellIOManager::GetDecodedImageCache()
+    const {
+  return decoded_image_cache_;
+}
+
 }  // namespace flutter
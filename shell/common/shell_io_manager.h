@@ -11,6 +11,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/lib/ui/io_manager.h"
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
 namespace flutter {
@@ -60,6 +61,12 @@ class ShellIOManager final : public IOManager {
     return resource_context_;
   };
 
+  // The cache of the images decoded by all of the engines that share this IO
+  // manager, or null if the cache is off.
+  void SetDecodedImageCache(std::shared_ptr<DecodedImageCache> cache);
+
+  std::shared_ptr<DecodedImageCache> GetDecodedImageCache() const;
+
  private:
   // Resource context management.
   sk_sp<GrDirectContext> resource_context_;
@@ -71,6 +78,8 @@ class ShellIOManager final : public IOManager {
 
   std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch_;
 
+  std::shared_ptr<DecodedImageCache> decoded_image_cache_;
+
   fml::WeakPtrFactory<ShellIOManager> weak_factory_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ShellIOManager);
@@ -0,0 +1,293 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/trace_ring_buffer.h"
+#include "flutter/runtime/dart_vm_lifecycle.h"
+#include "flutter/shell/common/shell_test.h"
+#include "flutter/shell/common/shell_test_platform_view.h"
+#include "flutter/shell/common/thread_host.h"
+#include "flutter/shell/common/vsync_waiters_test.h"
+#include "flutter/testing/dart_fixture.h"
+
+namespace flutter::testing {
+
+namespace {
+
+constexpr char kEntrypoint[] = "benchmarkFirstFrame";
+
+// A phase of the startup, which is the total time spent in the scoped trace
+// events with the given names.
+struct StartupPhase {
+  const char* counter;
+  std::vector<std::string> trace_events;
+};
+
+const std::vector<StartupPhase>& GetStartupPhases() {
+  static const std::vector<StartupPhase> phases = {
+      {"vm_ms", {"DartVMInitializer"}},
+      {"isolate_ms",
+       {"DartIsolate::CreateRootIsolate", "DartIsolate::RunFromLibrary"}},
+      {"fonts_ms",
+       {"WarmUpDefaultFontManager", "Engine::SetupDefaultFontManager"}},
+      {"preroll_ms", {"LayerTree::Preroll"}},
+      {"paint_ms", {"LayerTree::Paint"}},
+      {"sksl_precompile_ms", {"Rasterizer::PrecompilePendingSkSLs"}},
+  };
+  return phases;
+}
+
+// Adds the time spent in each of the scoped trace events that were recorded
+// so far to the given durations, in milliseconds. Events that have not ended
+// yet are not counted.
+void AddTraceEventDurations(std::map<std::string, double>& durations) {
+  // The begin events that have not ended yet on each thread.
+  std::map<int64_t, std::vector<const fml::tracing::TraceRingBufferEvent*>>
+      open_events;
+  const auto events = fml::tracing::TraceRingBufferGetEvents();
+  for (const auto& event : events) {
+    auto& open = open_events[event.thread_id];
+    if (event.type == Dart_Timeline_Event_Begin) {
+      open.push_back(&event);
+    } else if (event.type == Dart_Timeline_Event_End && !open.empty()) {
+      const auto* begin = open.back();
+      open.pop_back();
+      durations[begin->name] +=
+          (event.timestamp_micros - begin->timestamp_micros) / 1000.0;
+    }
+  }
+}
+
+class StartupBenchmark {
+ public:
+  explicit StartupBenchmark(benchmark::State& state) : state_(state) {
+    settings_ = fixture_.CreateSettingsForFixture();
+    settings_.frame_rasterized_callback = [this](const FrameTiming&) {
+      first_frame_rasterized_.Signal();
+    };
+    fml::tracing::TraceRingBufferSetEnabled(true);
+  }
+
+  ~StartupBenchmark() {
+    fml::tracing::TraceRingBufferSetEnabled(false);
+    fml::tracing::TraceRingBufferClear();
+    for (const auto& phase : GetStartupPhases()) {
+      double total = 0;
+      for (const auto& trace_event : phase.trace_events) {
+        total += durations_[trace_event];
+      }
+      state_.counters[phase.counter] =
+          benchmark::Counter(total, benchmark::Counter::kAvgIterations);
+    }
+  }
+
+  const Settings& GetSettings() const { return settings_; }
+
+  void StartThreads() {
+    thread_host_ = std::make_unique<ThreadHost>(ThreadHost::ThreadHostConfig(
+        "io.flutter.bench.", ThreadHost::Type::Platform |
+                                 ThreadHost::Type::RASTER |
+                                 ThreadHost::Type::IO | ThreadHost::Type::UI));
+  }
+
+  TaskRunners GetTaskRunners() const {
+    return TaskRunners("test", thread_host_->platform_thread->GetTaskRunner(),
+                       thread_host_->raster_thread->GetTaskRunner(),
+                       thread_host_->ui_thread->GetTaskRunner(),
+                       thread_host_->io_thread->GetTaskRunner());
+  }
+
+  // Starts recording the trace events of a new iteration.
+  void BeginIteration() { fml::tracing::TraceRingBufferClear(); }
+
+  // Adds the trace events of the iteration to the phases.
+  void EndIteration() { AddTraceEventDurations(durations_); }
+
+  std::unique_ptr<Shell> CreateShell() {
+    return Shell::Create(flutter::PlatformData(), GetTaskRunners(), settings_,
+                         CreatePlatformView, CreateRasterizer);
+  }
+
+  // Runs the fixture on a shell created by |CreateShell|, and waits for its
+  // first frame to be rasterized.
+  void RunToFirstFrame(Shell* shell) {
+    ShowView(shell);
+    auto configuration = RunConfiguration::InferFromSettings(settings_);
+    configuration.SetEntrypoint(kEntrypoint);
+    ShellTest::RunEngine(shell, std::move(configuration));
+    first_frame_rasterized_.Wait();
+  }
+
+  // Spawns a shell from the given one that runs the fixture, and waits for
+  // its first frame to be rasterized.
+  std::unique_ptr<Shell> SpawnToFirstFrame(Shell* spawner) {
+    std::unique_ptr<Shell> spawn;
+    fml::AutoResetWaitableEvent latch;
+    fml::TaskRunner::RunNowOrPostTask(
+        spawner->GetTaskRunners().GetPlatformTaskRunner(), [&]() {
+          auto configuration = RunConfiguration::InferFromSettings(settings_);
+          configuration.SetEntrypoint(kEntrypoint);
+          spawn = spawner->Spawn(std::move(configuration), "/",
+                                 CreatePlatformView, CreateRasterizer);
+          latch.Signal();
+        });
+    latch.Wait();
+    FML_CHECK(spawn);
+    ShowView(spawn.get());
+    first_frame_rasterized_.Wait();
+    return spawn;
+  }
+
+  void DestroyShell(std::unique_ptr<Shell> shell) {
+    fml::AutoResetWaitableEvent latch;
+    fml::TaskRunner::RunNowOrPostTask(
+        shell->GetTaskRunners().GetPlatformTaskRunner(),
+        [&shell, &latch]() mutable {
+          shell.reset();
+          latch.Signal();
+        });
+    latch.Wait();
+  }
+
+  void StopThreads() { thread_host_.reset(); }
+
+ private:
+  benchmark::State& state_;
+  DartFixture fixture_;
+  Settings settings_;
+  std::unique_ptr<ThreadHost> thread_host_;
+  fml::AutoResetWaitableEvent first_frame_rasterized_;
+  std::map<std::string, double> durations_;
+
+  static std::unique_ptr<PlatformView> CreatePlatformView(Shell& shell) {
+    const TaskRunners& task_runners = shell.GetTaskRunners();
+    return ShellTestPlatformView::Create(
+        shell, task_runners, std::make_shared<ShellTestVsyncClock>(),
+        [task_runners]() {
+          return static_cast<std::unique_ptr<VsyncWaiter>>(
+              std::make_unique<ConstantFiringVsyncWaiter>(task_runners));
+        },
+        ShellTestPlatformView::BackendType::kDefaultBackend, nullptr);
+  }
+
+  static std::unique_ptr<Rasterizer> CreateRasterizer(Shell& shell) {
+    return std::make_unique<Rasterizer>(shell);
+  }
+
+  static void ShowView(Shell* shell) {
+    ShellTest::PlatformViewNotifyCreated(shell);
+    fml::AutoResetWaitableEvent latch;
+    fml::TaskRunner::RunNowOrPostTask(
+        shell->GetTaskRunners().GetPlatformTaskRunner(), [shell, &latch]() {
+          ViewportMetrics metrics;
+          metrics.device_pixel_ratio = 1;
+          metrics.physical_width = 800;
+          metrics.physical_height = 600;
+          shell->GetPlatformView()->SetViewportMetrics(metrics);
+          latch.Signal();
+        });
+    latch.Wait();
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(StartupBenchmark);
+};
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+/// The time from creating a shell to its first rasterized frame, including
+/// the creation of the Dart VM.
+///
+/// Besides the time, the benchmarks of the startup report the average time of
+/// each phase of the startup in the trace events as counters. The trace events
+/// are only recorded in builds with the timeline, so the phases are zero in
+/// release builds.
+///
+static void BM_ShellStartupCold(benchmark::State& state) {
+  StartupBenchmark startup(state);
+  while (state.KeepRunning()) {
+    std::unique_ptr<Shell> shell;
+    {
+      benchmarking::ScopedPauseTiming pause(state);
+      FML_CHECK(!DartVMRef::IsInstanceRunning());
+      startup.StartThreads();
+      startup.BeginIteration();
+    }
+    shell = startup.CreateShell();
+    FML_CHECK(shell);
+    startup.RunToFirstFrame(shell.get());
+    {
+      benchmarking::ScopedPauseTiming pause(state);
+      startup.EndIteration();
+      startup.DestroyShell(std::move(shell));
+      startup.StopThreads();
+    }
+  }
+}
+
+BENCHMARK(BM_ShellStartupCold)->Unit(benchmark::kMillisecond);
+
+//------------------------------------------------------------------------------
+/// The time from creating a shell to its first rasterized frame while the
+/// Dart VM is already running.
+///
+static void BM_ShellStartupWarm(benchmark::State& state) {
+  StartupBenchmark startup(state);
+  auto vm_ref = DartVMRef::Create(startup.GetSettings());
+  FML_CHECK(vm_ref);
+  while (state.KeepRunning()) {
+    std::unique_ptr<Shell> shell;
+    {
+      benchmarking::ScopedPauseTiming pause(state);
+      startup.StartThreads();
+      startup.BeginIteration();
+    }
+    shell = startup.CreateShell();
+    FML_CHECK(shell);
+    startup.RunToFirstFrame(shell.get());
+    {
+      benchmarking::ScopedPauseTiming pause(state);
+      startup.EndIteration();
+      startup.DestroyShell(std::move(shell));
+      startup.StopThreads();
+    }
+  }
+}
+
+BENCHMARK(BM_ShellStartupWarm)->Unit(benchmark::kMillisecond);
+
+//------------------------------------------------------------------------------
+/// The time from spawning a shell from a running one to its first rasterized
+/// frame.
+///
+static void BM_ShellStartupSpawn(benchmark::State& state) {
+  StartupBenchmark startup(state);
+  startup.StartThreads();
+  auto spawner = startup.CreateShell();
+  FML_CHECK(spawner);
+  startup.RunToFirstFrame(spawner.get());
+  while (state.KeepRunning()) {
+    {
+      benchmarking::ScopedPauseTiming pause(state);
+      startup.BeginIteration();
+    }
+    auto spawn = startup.SpawnToFirstFrame(spawner.get());
+    {
+      benchmarking::ScopedPauseTiming pause(state);
+      startup.EndIteration();
+      startup.DestroyShell(std::move(spawn));
+    }
+  }
+  startup.DestroyShell(std::move(spawner));
+  startup.StopThreads();
+}
+
+BENCHMARK(BM_ShellStartupSpawn)->Unit(benchmark::kMillisecond);
+
+}  // namespace flutter::testing
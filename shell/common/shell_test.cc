@@ -249,6 +249,10 @@ void ShellTest::StorePersistentCache(PersistentCache* cache,
   cache->store(key, value);
 }
 
+uint32_t ShellTest::GetLayerTreePipelineDepth(Animator* animator) {
+  return animator->layer_tree_pipeline_->GetDepth();
+}
+
 void ShellTest::OnServiceProtocol(
     Shell* shell,
     ServiceProtocolEnum some_protocol,
@@ -265,6 +269,19 @@ void ShellTest::OnServiceProtocol(
           case ServiceProtocolEnum::kEstimateRasterCacheMemory:
             shell->OnServiceProtocolEstimateRasterCacheMemory(params, response);
             break;
+          case ServiceProtocolEnum::kGetPartialRepaintStatistics:
+            shell->OnServiceProtocolGetPartialRepaintStatistics(params,
+                                                               response);
+            break;
+          case ServiceProtocolEnum::kGetFrameTimingPercentiles:
+            shell->OnServiceProtocolGetFrameTimingPercentiles(params, response);
+            break;
+          case ServiceProtocolEnum::kGetTraceRingBuffer:
+            shell->OnServiceProtocolGetTraceRingBuffer(params, response);
+            break;
+          case ServiceProtocolEnum::kGetGpuMemoryUsage:
+            shell->OnServiceProtocolGetGpuMemoryUsage(params, response);
+            break;
           case ServiceProtocolEnum::kSetAssetBundlePath:
             shell->OnServiceProtocolSetAssetBundlePath(params, response);
             break;
@@ -101,9 +101,15 @@ class ShellTest : public FixtureTest {
 
   static bool IsAnimatorRunning(Shell* shell);
 
+  static uint32_t GetLayerTreePipelineDepth(Animator* animator);
+
   enum ServiceProtocolEnum {
     kGetSkSLs,
     kEstimateRasterCacheMemory,
+    kGetPartialRepaintStatistics,
+    kGetFrameTimingPercentiles,
+    kGetTraceRingBuffer,
+    kGetGpuMemoryUsage,
     kSetAssetBundlePath,
     kRunInView,
   };
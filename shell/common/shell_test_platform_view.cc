@@ -13,6 +13,9 @@
 #ifdef SHELL_ENABLE_METAL
 #include "flutter/shell/common/shell_test_platform_view_metal.h"
 #endif  // SHELL_ENABLE_METAL
+#ifdef SHELL_ENABLE_SOFTWARE
+#include "flutter/shell/common/shell_test_platform_view_software.h"
+#endif  // SHELL_ENABLE_SOFTWARE
 
 namespace flutter {
 namespace testing {
@@ -47,6 +50,12 @@ std::unique_ptr<ShellTestPlatformView> ShellTestPlatformView::Create(
           delegate, task_runners, vsync_clock, create_vsync_waiter,
           shell_test_external_view_embedder);
 #endif  // SHELL_ENABLE_METAL
+#ifdef SHELL_ENABLE_SOFTWARE
+    case BackendType::kSoftwareBackend:
+      return std::make_unique<ShellTestPlatformViewSoftware>(
+          delegate, task_runners, vsync_clock, create_vsync_waiter,
+          shell_test_external_view_embedder);
+#endif  // SHELL_ENABLE_SOFTWARE
 
     default:
       FML_LOG(FATAL) << "No backends supported for ShellTestPlatformView";
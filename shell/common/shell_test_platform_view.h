@@ -18,6 +18,7 @@ class ShellTestPlatformView : public PlatformView {
     kGLBackend,
     kVulkanBackend,
     kMetalBackend,
+    kSoftwareBackend,
     kDefaultBackend,
   };
 
@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/shell_test_platform_view_software.h"
+
+#include "flutter/shell/gpu/gpu_surface_software.h"
+
+namespace flutter {
+namespace testing {
+
+ShellTestPlatformViewSoftware::ShellTestPlatformViewSoftware(
+    PlatformView::Delegate& delegate,
+    TaskRunners task_runners,
+    std::shared_ptr<ShellTestVsyncClock> vsync_clock,
+    CreateVsyncWaiter create_vsync_waiter,
+    std::shared_ptr<ShellTestExternalViewEmbedder>
+        shell_test_external_view_embedder)
+    : ShellTestPlatformView(delegate, std::move(task_runners)),
+      create_vsync_waiter_(std::move(create_vsync_waiter)),
+      vsync_clock_(vsync_clock),
+      shell_test_external_view_embedder_(shell_test_external_view_embedder) {}
+
+ShellTestPlatformViewSoftware::~ShellTestPlatformViewSoftware() = default;
+
+std::unique_ptr<VsyncWaiter>
+ShellTestPlatformViewSoftware::CreateVSyncWaiter() {
+  return create_vsync_waiter_();
+}
+
+// |ShellTestPlatformView|
+void ShellTestPlatformViewSoftware::SimulateVSync() {
+  vsync_clock_->SimulateVSync();
+}
+
+// |PlatformView|
+std::unique_ptr<Surface>
+ShellTestPlatformViewSoftware::CreateRenderingSurface() {
+  return std::make_unique<GPUSurfaceSoftware>(this, true);
+}
+
+// |PlatformView|
+std::shared_ptr<ExternalViewEmbedder>
+ShellTestPlatformViewSoftware::CreateExternalViewEmbedder() {
+  return shell_test_external_view_embedder_;
+}
+
+// |PlatformView|
+PointerDataDispatcherMaker ShellTestPlatformViewSoftware::GetDispatcherMaker() {
+  return [](DefaultPointerDataDispatcher::Delegate& delegate) {
+    return std::make_unique<SmoothPointerDataDispatcher>(delegate);
+  };
+}
+
+// |GPUSurfaceSoftwareDelegate|
+sk_sp<SkSurface> ShellTestPlatformViewSoftware::AcquireBackingStore(
+    const SkISize& size) {
+  if (backing_store_ && backing_store_->width() == size.width() &&
+      backing_store_->height() == size.height()) {
+    return backing_store_;
+  }
+  backing_store_ = SkSurface::MakeRasterN32Premul(size.width(), size.height());
+  return backing_store_;
+}
+
+// |GPUSurfaceSoftwareDelegate|
+bool ShellTestPlatformViewSoftware::PresentBackingStore(
+    sk_sp<SkSurface> backing_store) {
+  return true;
+}
+
+}  // namespace testing
+}  // namespace flutter
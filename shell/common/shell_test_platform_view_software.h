@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_SHELL_TEST_PLATFORM_VIEW_SOFTWARE_H_
+#define FLUTTER_SHELL_COMMON_SHELL_TEST_PLATFORM_VIEW_SOFTWARE_H_
+
+#include "flutter/shell/common/shell_test_external_view_embedder.h"
+#include "flutter/shell/common/shell_test_platform_view.h"
+#include "flutter/shell/gpu/gpu_surface_software_delegate.h"
+
+namespace flutter {
+namespace testing {
+
+class ShellTestPlatformViewSoftware : public ShellTestPlatformView,
+                                      public GPUSurfaceSoftwareDelegate {
+ public:
+  ShellTestPlatformViewSoftware(
+      PlatformView::Delegate& delegate,
+      TaskRunners task_runners,
+      std::shared_ptr<ShellTestVsyncClock> vsync_clock,
+      CreateVsyncWaiter create_vsync_waiter,
+      std::shared_ptr<ShellTestExternalViewEmbedder>
+          shell_test_external_view_embedder);
+
+  // |ShellTestPlatformView|
+  ~ShellTestPlatformViewSoftware() override;
+
+  // |ShellTestPlatformView|
+  void SimulateVSync() override;
+
+ private:
+  sk_sp<SkSurface> backing_store_;
+
+  CreateVsyncWaiter create_vsync_waiter_;
+
+  std::shared_ptr<ShellTestVsyncClock> vsync_clock_;
+
+  std::shared_ptr<ShellTestExternalViewEmbedder>
+      shell_test_external_view_embedder_;
+
+  // |PlatformView|
+  std::unique_ptr<Surface> CreateRenderingSurface() override;
+
+  // |PlatformView|
+  std::shared_ptr<ExternalViewEmbedder> CreateExternalViewEmbedder() override;
+
+  // |PlatformView|
+  std::unique_ptr<VsyncWaiter> CreateVSyncWaiter() override;
+
+  // |PlatformView|
+  PointerDataDispatcherMaker GetDispatcherMaker() override;
+
+  // |GPUSurfaceSoftwareDelegate|
+  sk_sp<SkSurface> AcquireBackingStore(const SkISize& size) override;
+
+  // |GPUSurfaceSoftwareDelegate|
+  bool PresentBackingStore(sk_sp<SkSurface> backing_store) override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ShellTestPlatformViewSoftware);
+};
+
+}  // namespace testing
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_SHELL_TEST_PLATFORM_VIEW_SOFTWARE_H_
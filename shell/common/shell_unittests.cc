@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "assets/directory_asset_bundle.h"
+#include "assets/packed_asset_bundle.h"
 #include "common/graphics/persistent_cache.h"
 #include "flutter/flow/layers/picture_layer.h"
 #include "flutter/flow/layers/transform_layer.h"
@@ -20,6 +21,7 @@
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/trace_ring_buffer.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
@@ -171,6 +173,37 @@ class TestAssetResolver : public AssetResolver {
   AssetResolver::AssetResolverType type_;
 };
 
+// Has the assets with the given names, and counts the lookups.
+class CountingAssetResolver : public AssetResolver {
+ public:
+  explicit CountingAssetResolver(std::vector<std::string> asset_names)
+      : asset_names_(std::move(asset_names)) {}
+
+  bool IsValid() const override { return true; }
+
+  bool IsValidAfterAssetManagerChange() const override { return true; }
+
+  AssetResolver::AssetResolverType GetType() const override {
+    return AssetResolver::AssetResolverType::kDirectoryAssetBundle;
+  }
+
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override {
+    lookup_count_++;
+    if (std::find(asset_names_.begin(), asset_names_.end(), asset_name) ==
+        asset_names_.end()) {
+      return nullptr;
+    }
+    return std::make_unique<fml::DataMapping>(asset_name);
+  }
+
+  size_t GetLookupCount() const { return lookup_count_; }
+
+ private:
+  std::vector<std::string> asset_names_;
+  mutable size_t lookup_count_ = 0;
+};
+
 static bool ValidateShell(Shell* shell) {
   if (!shell) {
     return false;
@@ -284,6 +317,25 @@ TEST_F(ShellTest, InitializeWithDifferentThreads) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, InitializeWithConcurrentStartup) {
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+  Settings settings = CreateSettingsForFixture();
+  settings.enable_concurrent_startup = true;
+  std::string name_prefix = "io.flutter.test." + GetCurrentTestName() + ".";
+  ThreadHost thread_host(ThreadHost::ThreadHostConfig(
+      name_prefix, ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                       ThreadHost::Type::IO | ThreadHost::Type::UI));
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  auto shell = CreateShell(std::move(settings), task_runners);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+  ASSERT_TRUE(DartVMRef::IsInstanceRunning());
+  DestroyShell(std::move(shell), std::move(task_runners));
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+}
+
 TEST_F(ShellTest, InitializeWithSingleThread) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
   Settings settings = CreateSettingsForFixture();
@@ -2193,6 +2245,44 @@ TEST_F(ShellTest, RasterizerScreenshot) {
   DestroyShell(std::move(shell), std::move(task_runners));
 }
 
+TEST_F(ShellTest, RasterizerScreenshotAsync) {
+  Settings settings = CreateSettingsForFixture();
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  auto task_runner = CreateNewThread();
+  TaskRunners task_runners("test", task_runner, task_runner, task_runner,
+                           task_runner);
+  std::unique_ptr<Shell> shell =
+      CreateShell(std::move(settings), std::move(task_runners));
+
+  ASSERT_TRUE(ValidateShell(shell.get()));
+  PlatformViewNotifyCreated(shell.get());
+
+  RunEngine(shell.get(), std::move(configuration));
+
+  PumpOneFrame(shell.get());
+
+  for (auto type : {Rasterizer::ScreenshotType::CompressedImage,
+                    Rasterizer::ScreenshotType::UncompressedImage,
+                    Rasterizer::ScreenshotType::SkiaPicture}) {
+    fml::AutoResetWaitableEvent latch;
+    Rasterizer::Screenshot screenshot;
+    shell->ScreenshotAsync(
+        type, false, [&latch, &screenshot](Rasterizer::Screenshot result) {
+          screenshot = result;
+          latch.Signal();
+        });
+    latch.Wait();
+    ASSERT_NE(screenshot.data, nullptr);
+    EXPECT_FALSE(screenshot.frame_size.isEmpty());
+    if (type == Rasterizer::ScreenshotType::UncompressedImage) {
+      EXPECT_EQ(screenshot.data->size(),
+                static_cast<size_t>(screenshot.frame_size.area()) * 4);
+    }
+  }
+
+  DestroyShell(std::move(shell), std::move(task_runners));
+}
+
 TEST_F(ShellTest, RasterizerMakeRasterSnapshot) {
   Settings settings = CreateSettingsForFixture();
   auto configuration = RunConfiguration::InferFromSettings(settings);
@@ -2225,6 +2315,45 @@ TEST_F(ShellTest, RasterizerMakeRasterSnapshot) {
   DestroyShell(std::move(shell), std::move(task_runners));
 }
 
+TEST_F(ShellTest, RasterizerMakeRasterSnapshotAsync) {
+  Settings settings = CreateSettingsForFixture();
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  auto task_runner = CreateNewThread();
+  TaskRunners task_runners("test", task_runner, task_runner, task_runner,
+                           task_runner);
+  std::unique_ptr<Shell> shell =
+      CreateShell(std::move(settings), std::move(task_runners));
+
+  ASSERT_TRUE(ValidateShell(shell.get()));
+  PlatformViewNotifyCreated(shell.get());
+
+  RunEngine(shell.get(), std::move(configuration));
+
+  auto latch = std::make_shared<fml::AutoResetWaitableEvent>();
+
+  PumpOneFrame(shell.get());
+
+  fml::TaskRunner::RunNowOrPostTask(
+      shell->GetTaskRunners().GetRasterTaskRunner(), [&shell, latch]() {
+        SnapshotDelegate* delegate =
+            reinterpret_cast<Rasterizer*>(shell->GetRasterizer().get());
+        delegate->MakeRasterSnapshotAsync(
+            [](SkCanvas* canvas) { canvas->drawColor(SK_ColorRED); },
+            SkISize::Make(50, 50), [latch](sk_sp<SkImage> image) {
+              EXPECT_NE(image, nullptr);
+              if (image) {
+                EXPECT_EQ(image->dimensions(), SkISize::Make(50, 50));
+                // The image is backed by pixels in memory.
+                SkPixmap pixmap;
+                EXPECT_TRUE(image->peekPixels(&pixmap));
+              }
+              latch->Signal();
+            });
+      });
+  latch->Wait();
+  DestroyShell(std::move(shell), std::move(task_runners));
+}
+
 static sk_sp<SkPicture> MakeSizedPicture(int width, int height) {
   SkPictureRecorder recorder;
   SkCanvas* recording_canvas =
@@ -2310,6 +2439,137 @@ TEST_F(ShellTest, OnServiceProtocolEstimateRasterCacheMemoryWorks) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, OnServiceProtocolGetGpuMemoryUsageWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(
+      shell.get(), ServiceProtocolEnum::kGetGpuMemoryUsage,
+      shell->GetTaskRunners().GetRasterTaskRunner(), empty_params, &document);
+
+  ASSERT_TRUE(document.IsObject());
+  EXPECT_STREQ(document["type"].GetString(), "GpuMemoryUsage");
+  ASSERT_TRUE(document["rasterCache"].IsObject());
+  EXPECT_EQ(document["rasterCache"]["totalBytes"].GetUint64(), 0u);
+  EXPECT_TRUE(document["rasterCache"]["entries"].IsArray());
+  EXPECT_EQ(document["rasterCache"]["entries"].Size(), 0u);
+  ASSERT_TRUE(document["skiaResourceCache"].IsObject());
+  EXPECT_TRUE(document["skiaResourceCache"]["bytesByType"].IsObject());
+  EXPECT_TRUE(document["skiaResourceCache"]["bytesByCategory"].IsObject());
+  EXPECT_LE(document["skiaResourceCache"]["purgeableBytes"].GetUint64(),
+            document["skiaResourceCache"]["totalBytes"].GetUint64());
+  EXPECT_EQ(document["externalTextureBytes"].GetUint64(), 0u);
+  EXPECT_EQ(document["overlaySurfaceBytes"].GetUint64(), 0u);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, NotifyMemoryPressureReportsOnTheRasterThread) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  for (auto level :
+       {MemoryPressureLevel::kModerate, MemoryPressureLevel::kCritical}) {
+    fml::AutoResetWaitableEvent latch;
+    shell->NotifyMemoryPressure(
+        level, [&shell, &latch, level](const MemoryPressureReport& report) {
+          EXPECT_TRUE(shell->GetTaskRunners()
+                          .GetRasterTaskRunner()
+                          ->RunsTasksOnCurrentThread());
+          EXPECT_EQ(report.level, level);
+          EXPECT_EQ(report.raster_cache_bytes, 0u);
+          EXPECT_EQ(report.overlay_surface_bytes, 0u);
+          latch.Signal();
+        });
+    latch.Wait();
+  }
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetPartialRepaintStatisticsWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(
+      shell.get(), ServiceProtocolEnum::kGetPartialRepaintStatistics,
+      shell->GetTaskRunners().GetRasterTaskRunner(), empty_params, &document);
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+  std::string expected_json =
+      "{\"type\":\"PartialRepaintStatistics\",\"frameCount\":0,"
+      "\"damagedPixels\":0,\"framePixels\":0,\"repaintedFraction\":0.0,"
+      "\"diffedLayers\":0,\"retainedLayers\":0,"
+      "\"averageComputeDamageMicros\":0,\"maxComputeDamageMicros\":0}";
+  std::string actual_json = buffer.GetString();
+  ASSERT_EQ(actual_json, expected_json);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetFrameTimingPercentilesWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(
+      shell.get(), ServiceProtocolEnum::kGetFrameTimingPercentiles,
+      shell->GetTaskRunners().GetRasterTaskRunner(), empty_params, &document);
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+  std::string no_durations = "{\"p50\":0,\"p90\":0,\"p99\":0,\"max\":0}";
+  std::string expected_json =
+      "{\"type\":\"FrameTimingPercentiles\",\"frameCount\":0,"
+      "\"buildDuration\":" +
+      no_durations + ",\"rasterDuration\":" + no_durations +
+      ",\"vsyncOverhead\":" + no_durations + ",\"totalSpan\":" +
+      no_durations + "}";
+  std::string actual_json = buffer.GetString();
+  ASSERT_EQ(actual_json, expected_json);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetTraceRingBufferWorks) {
+  Settings settings = CreateSettingsForFixture();
+  settings.enable_trace_ring_buffer = true;
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  ASSERT_TRUE(fml::tracing::TraceRingBufferIsEnabled());
+
+  fml::tracing::TraceRingBufferRecord("ShellRingBufferEvent", 1, 0,
+                                      Dart_Timeline_Event_Instant);
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetTraceRingBuffer,
+                    shell->GetTaskRunners().GetIOTaskRunner(), empty_params,
+                    &document);
+  fml::tracing::TraceRingBufferSetEnabled(false);
+  fml::tracing::TraceRingBufferClear();
+
+  ASSERT_TRUE(document.IsObject());
+  EXPECT_STREQ(document["type"].GetString(), "TraceRingBuffer");
+  EXPECT_TRUE(document["enabled"].GetBool());
+  ASSERT_TRUE(document["traceEvents"].IsArray());
+  size_t event_count = 0;
+  for (const auto& event : document["traceEvents"].GetArray()) {
+    if (std::string(event["name"].GetString()) == "ShellRingBufferEvent") {
+      EXPECT_STREQ(event["ph"].GetString(), "i");
+      EXPECT_EQ(event["ts"].GetInt64(), 1);
+      event_count++;
+    }
+  }
+  EXPECT_EQ(event_count, 1u);
+
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, DiscardLayerTreeOnResize) {
   auto settings = CreateSettingsForFixture();
 
@@ -2678,6 +2938,145 @@ TEST_F(ShellTest,
   }
 }
 
+TEST_F(ShellTest, PackedAssetBundleFindsEveryAsset) {
+  std::vector<PackedAssetBundle::Asset> assets;
+  for (size_t i = 0; i < 100; i++) {
+    std::string name = "dir" + std::to_string(i % 3) + "/asset" +
+                       std::to_string(i);
+    std::string content(i * 10, 'a' + i % 26);
+    assets.push_back({name, std::vector<uint8_t>(content.begin(),
+                                                 content.end()),
+                      i % 2 == 0});
+  }
+  std::vector<uint8_t> archive = PackedAssetBundle::Pack(assets);
+  ASSERT_FALSE(archive.empty());
+
+  AssetManager asset_manager;
+  asset_manager.PushBack(std::make_unique<PackedAssetBundle>(
+      std::make_unique<fml::DataMapping>(std::move(archive)), false));
+
+  for (const auto& asset : assets) {
+    auto mapping = asset_manager.GetAsMapping(asset.name);
+    ASSERT_TRUE(mapping != nullptr) << asset.name;
+    ASSERT_EQ(mapping->GetSize(), asset.data.size());
+    EXPECT_TRUE(std::equal(asset.data.begin(), asset.data.end(),
+                           mapping->GetMapping()))
+        << asset.name;
+  }
+  EXPECT_EQ(asset_manager.GetAsMapping("dir0/missing"), nullptr);
+}
+
+TEST_F(ShellTest, PackedAssetBundleStoresUncompressedAssetsPageAligned) {
+  std::string content(5000, 'a');
+  std::vector<uint8_t> archive = PackedAssetBundle::Pack({
+      {"compressed", std::vector<uint8_t>(content.begin(), content.end()),
+       true},
+      {"first", std::vector<uint8_t>(content.begin(), content.end())},
+      {"second", std::vector<uint8_t>(content.begin(), content.end())},
+  });
+  // The compressed asset fits in the first page along with the index, and
+  // the others start on pages of their own.
+  ASSERT_EQ(archive.size(), 3 * 4096 + content.size());
+
+  auto archive_mapping = std::make_unique<fml::DataMapping>(archive);
+  const uint8_t* archive_data = archive_mapping->GetMapping();
+  AssetManager asset_manager;
+  asset_manager.PushBack(std::make_unique<PackedAssetBundle>(
+      std::move(archive_mapping), false));
+
+  for (const char* name : {"first", "second"}) {
+    auto mapping = asset_manager.GetAsMapping(name);
+    ASSERT_TRUE(mapping != nullptr);
+    EXPECT_EQ((mapping->GetMapping() - archive_data) % 4096, 0);
+  }
+  auto mapping = asset_manager.GetAsMapping("compressed");
+  ASSERT_TRUE(mapping != nullptr);
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                        mapping->GetSize()),
+            content);
+}
+
+TEST_F(ShellTest, PackedAssetBundleMatchesFileNames) {
+  std::vector<PackedAssetBundle::Asset> assets;
+  for (std::string name : {"good0", "bad0", "subdir/good1", "subdir/bad1",
+                           "subdir/nested/good2"}) {
+    assets.push_back({name, std::vector<uint8_t>(name.begin(), name.end())});
+  }
+  AssetManager asset_manager;
+  asset_manager.PushBack(std::make_unique<PackedAssetBundle>(
+      std::make_unique<fml::DataMapping>(PackedAssetBundle::Pack(assets)),
+      false));
+
+  EXPECT_EQ(asset_manager.GetAsMappings("(.*)", std::nullopt).size(), 5u);
+  EXPECT_EQ(asset_manager.GetAsMappings("good(.*)", std::nullopt).size(), 3u);
+
+  auto mappings = asset_manager.GetAsMappings("good(.*)", "subdir");
+  ASSERT_EQ(mappings.size(), 1u);
+  std::string result(reinterpret_cast<const char*>(mappings[0]->GetMapping()),
+                     mappings[0]->GetSize());
+  EXPECT_EQ(result, "subdir/good1");
+}
+
+TEST_F(ShellTest, PackedAssetBundleRejectsCorruptArchives) {
+  std::string content = "content";
+  std::vector<uint8_t> archive = PackedAssetBundle::Pack(
+      {{"asset", std::vector<uint8_t>(content.begin(), content.end())}});
+  archive.resize(archive.size() - 1);
+
+  AssetManager asset_manager;
+  asset_manager.PushBack(std::make_unique<PackedAssetBundle>(
+      std::make_unique<fml::DataMapping>(std::move(archive)), false));
+  EXPECT_EQ(asset_manager.GetAsMapping("asset"), nullptr);
+
+  EXPECT_TRUE(PackedAssetBundle::Pack({{"asset", {}}, {"asset", {}}}).empty());
+}
+
+TEST_F(ShellTest, AssetManagerCachesLookups) {
+  auto first = std::make_unique<CountingAssetResolver>(
+      std::vector<std::string>{"first"});
+  auto second = std::make_unique<CountingAssetResolver>(
+      std::vector<std::string>{"second"});
+  const CountingAssetResolver* first_resolver = first.get();
+  const CountingAssetResolver* second_resolver = second.get();
+  AssetManager asset_manager;
+  asset_manager.PushBack(std::move(first));
+  asset_manager.PushBack(std::move(second));
+
+  for (int i = 0; i < 3; i++) {
+    EXPECT_NE(asset_manager.GetAsMapping("second"), nullptr);
+    EXPECT_EQ(asset_manager.GetAsMapping("missing"), nullptr);
+  }
+  // The first lookup of each asset probes both resolvers, and the later ones
+  // go straight to the resolver that has the asset, if any.
+  EXPECT_EQ(first_resolver->GetLookupCount(), 2u);
+  EXPECT_EQ(second_resolver->GetLookupCount(), 4u);
+
+  // A new resolver may have the missing asset.
+  asset_manager.PushFront(std::make_unique<CountingAssetResolver>(
+      std::vector<std::string>{"missing"}));
+  EXPECT_NE(asset_manager.GetAsMapping("missing"), nullptr);
+  EXPECT_EQ(first_resolver->GetLookupCount(), 2u);
+}
+
+TEST_F(ShellTest, AssetManagerRecordsFoundAssets) {
+  AssetManager asset_manager;
+  asset_manager.PushBack(std::make_unique<CountingAssetResolver>(
+      std::vector<std::string>{"first", "second"}));
+
+  asset_manager.GetAsMapping("first");
+  asset_manager.StartRecordingAssets();
+  asset_manager.GetAsMapping("second");
+  asset_manager.GetAsMapping("missing");
+  asset_manager.GetAsMapping("first");
+  asset_manager.GetAsMapping("second");
+
+  std::vector<std::string> expected = {"second", "first"};
+  EXPECT_EQ(asset_manager.StopRecordingAssets(), expected);
+
+  asset_manager.GetAsMapping("first");
+  EXPECT_TRUE(asset_manager.StopRecordingAssets().empty());
+}
+
 #if defined(OS_FUCHSIA)
 TEST_F(ShellTest, AssetManagerMultiSubdir) {
   std::string subdir_path = "subdir";
@@ -2974,6 +3373,51 @@ TEST_F(ShellTest, IOManagerIsSharedBetweenParentAndSpawnedShell) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, RasterCacheBudgetIsSharedBetweenParentAndSpawnedShell) {
+  auto settings = CreateSettingsForFixture();
+  settings.raster_cache_max_bytes = 1 << 20;
+  auto shell = CreateShell(settings);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+
+  PostSync(shell->GetTaskRunners().GetPlatformTaskRunner(), [this,
+                                                             &spawner = shell,
+                                                             &settings] {
+    auto second_configuration = RunConfiguration::InferFromSettings(settings);
+    ASSERT_TRUE(second_configuration.IsValid());
+    second_configuration.SetEntrypoint("emptyMain");
+    MockPlatformViewDelegate platform_view_delegate;
+    auto spawn = spawner->Spawn(
+        std::move(second_configuration), "",
+        [&platform_view_delegate](Shell& shell) {
+          auto result = std::make_unique<MockPlatformView>(
+              platform_view_delegate, shell.GetTaskRunners());
+          ON_CALL(*result, CreateRenderingSurface())
+              .WillByDefault(::testing::Invoke(
+                  [] { return std::make_unique<MockSurface>(); }));
+          return result;
+        },
+        [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+    ASSERT_TRUE(ValidateShell(spawn.get()));
+
+    PostSync(spawner->GetTaskRunners().GetRasterTaskRunner(),
+             [&spawner, &spawn] {
+               const auto& budget = spawner->GetRasterizer()
+                                        ->compositor_context()
+                                        ->raster_cache()
+                                        .shared_budget();
+               ASSERT_NE(budget, nullptr);
+               EXPECT_EQ(budget->max_bytes(), 1u << 20);
+               EXPECT_EQ(budget, spawn->GetRasterizer()
+                                     ->compositor_context()
+                                     ->raster_cache()
+                                     .shared_budget());
+             });
+
+    DestroyShell(std::move(spawn));
+  });
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, IOManagerInSpawnedShellIsNotNullAfterParentShellDestroyed) {
   auto settings = CreateSettingsForFixture();
   auto shell = CreateShell(settings);
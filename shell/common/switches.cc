@@ -9,6 +9,7 @@
 #include <sstream>
 #include <string>
 
+#include "flutter/common/constants.h"
 #include "flutter/fml/native_library.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/size.h"
@@ -278,6 +279,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_service_port_fallback =
       command_line.HasOption(FlagForSwitch(Switch::EnableServicePortFallback));
 
+  settings.defer_service_isolate_launch =
+      command_line.HasOption(FlagForSwitch(Switch::DeferServiceIsolateLaunch));
+
   // Checked mode overrides.
   settings.disable_dart_asserts =
       command_line.HasOption(FlagForSwitch(Switch::DisableDartAsserts));
@@ -293,6 +297,12 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
 
   settings.enable_software_rendering =
       command_line.HasOption(FlagForSwitch(Switch::EnableSoftwareRendering));
+  settings.enable_vulkan_rendering =
+      command_line.HasOption(FlagForSwitch(Switch::EnableVulkanRendering));
+  settings.drop_stale_texture_frames =
+      command_line.HasOption(FlagForSwitch(Switch::DropStaleTextureFrames));
+  settings.unmerged_platform_views =
+      command_line.HasOption(FlagForSwitch(Switch::UnmergedPlatformViews));
 
   settings.endless_trace_buffer =
       command_line.HasOption(FlagForSwitch(Switch::EndlessTraceBuffer));
@@ -329,6 +339,18 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.trace_systrace =
       command_line.HasOption(FlagForSwitch(Switch::TraceSystrace));
 
+  settings.enable_trace_ring_buffer =
+      command_line.HasOption(FlagForSwitch(Switch::EnableTraceRingBuffer));
+
+  settings.prefer_performance_cores_when_animating = command_line.HasOption(
+      FlagForSwitch(Switch::PreferPerformanceCoresWhenAnimating));
+
+  settings.decode_images_to_yuv_planes =
+      command_line.HasOption(FlagForSwitch(Switch::DecodeImagesToYUVPlanes));
+
+  settings.resize_images_on_gpu =
+      command_line.HasOption(FlagForSwitch(Switch::ResizeImagesOnGPU));
+
   settings.skia_deterministic_rendering_on_cpu =
       command_line.HasOption(FlagForSwitch(Switch::SkiaDeterministicRendering));
 
@@ -418,6 +440,57 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
       FlagForSwitch(Switch::EnableSkParagraph), "");
   settings.enable_skparagraph = enable_skparagraph != "false";
 
+  settings.enable_display_list_prewarm =
+      command_line.HasOption(FlagForSwitch(Switch::EnableDisplayListPrewarm));
+
+  settings.enable_async_raster_cache =
+      command_line.HasOption(FlagForSwitch(Switch::EnableAsyncRasterCache));
+
+  settings.enable_persistent_raster_cache = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePersistentRasterCache));
+
+  settings.enable_concurrent_preroll = command_line.HasOption(
+      FlagForSwitch(Switch::EnableConcurrentPreroll));
+
+  settings.enable_text_draw_batching = command_line.HasOption(
+      FlagForSwitch(Switch::EnableTextDrawBatching));
+
+  settings.enable_concurrent_raster_cache_recording = command_line.HasOption(
+      FlagForSwitch(Switch::EnableConcurrentRasterCacheRecording));
+
+  settings.enable_adaptive_pipeline_depth = command_line.HasOption(
+      FlagForSwitch(Switch::EnableAdaptivePipelineDepth));
+
+  settings.enable_predictive_frame_scheduling = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePredictiveFrameScheduling));
+
+  settings.render_without_vsync =
+      command_line.HasOption(FlagForSwitch(Switch::RenderWithoutVsync));
+
+  settings.enable_pointer_coalescing = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePointerCoalescing));
+
+  settings.enable_prioritized_sksl_precompilation = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePrioritizedSkSLPrecompilation));
+
+  settings.enable_persistent_cache_pack_files = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePersistentCachePackFiles));
+
+  settings.enable_path_deduplication = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePathDeduplication));
+
+  settings.enable_platform_message_batching = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePlatformMessageBatching));
+
+  settings.enable_persistent_font_fallback_cache = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePersistentFontFallbackCache));
+
+  settings.enable_concurrent_startup =
+      command_line.HasOption(FlagForSwitch(Switch::EnableConcurrentStartup));
+
+  settings.enable_startup_asset_prefetch = command_line.HasOption(
+      FlagForSwitch(Switch::EnableStartupAssetPrefetch));
+
   settings.prefetched_default_font_manager = command_line.HasOption(
       FlagForSwitch(Switch::PrefetchedDefaultFontManager));
 
@@ -463,6 +536,60 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
                                 &old_gen_heap_size);
     settings.old_gen_heap_size = std::stoi(old_gen_heap_size);
   }
+
+  if (command_line.HasOption(FlagForSwitch(Switch::RasterCacheMaxMBytes))) {
+    std::string raster_cache_max_mbytes;
+    command_line.GetOptionValue(FlagForSwitch(Switch::RasterCacheMaxMBytes),
+                                &raster_cache_max_mbytes);
+    settings.raster_cache_max_bytes = static_cast<size_t>(
+        std::stoul(raster_cache_max_mbytes) * kMegaByteSizeInBytes);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::DecodedImageCacheMaxMBytes))) {
+    std::string decoded_image_cache_max_mbytes;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::DecodedImageCacheMaxMBytes),
+        &decoded_image_cache_max_mbytes);
+    settings.decoded_image_cache_max_bytes = static_cast<size_t>(
+        std::stoul(decoded_image_cache_max_mbytes) * kMegaByteSizeInBytes);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::MemoryPressureTargetMBytes))) {
+    std::string memory_pressure_target_mbytes;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::MemoryPressureTargetMBytes),
+        &memory_pressure_target_mbytes);
+    settings.memory_pressure_target_bytes = static_cast<size_t>(
+        std::stoul(memory_pressure_target_mbytes) * kMegaByteSizeInBytes);
+  }
+
+  GetSwitchValue(command_line, Switch::AnimatedImagePrefetchFrameCount,
+                 &settings.animated_image_prefetch_frame_count);
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::AnimatedImageFrameCacheMaxMBytes))) {
+    std::string animated_image_frame_cache_max_mbytes;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::AnimatedImageFrameCacheMaxMBytes),
+        &animated_image_frame_cache_max_mbytes);
+    settings.animated_image_frame_cache_max_bytes =
+        static_cast<size_t>(std::stoul(animated_image_frame_cache_max_mbytes) *
+                            kMegaByteSizeInBytes);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::TextLayoutCacheMaxMBytes))) {
+    std::string text_layout_cache_max_mbytes;
+    command_line.GetOptionValue(FlagForSwitch(Switch::TextLayoutCacheMaxMBytes),
+                                &text_layout_cache_max_mbytes);
+    settings.text_layout_cache_max_bytes = static_cast<size_t>(
+        std::stoul(text_layout_cache_max_mbytes) * kMegaByteSizeInBytes);
+  }
+
+  GetSwitchValue(command_line, Switch::SkiaExecutorMaxConcurrency,
+                 &settings.skia_executor_max_concurrency);
   return settings;
 }
 
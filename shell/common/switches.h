@@ -105,6 +105,20 @@ DEF_SWITCH(EnableSoftwareRendering,
            "Enable rendering using the Skia software backend. This is useful "
            "when testing Flutter on emulators. By default, Flutter will "
            "attempt to either use OpenGL, Metal, or Vulkan.")
+DEF_SWITCH(EnableVulkanRendering,
+           "enable-vulkan-rendering",
+           "Render with Vulkan instead of OpenGL ES on Android, when the device "
+           "supports it. Other devices fall back to OpenGL ES.")
+DEF_SWITCH(DropStaleTextureFrames,
+           "drop-stale-texture-frames",
+           "Draw only the newest frame of the external textures on Android, "
+           "dropping the frames their producers queued since the last draw.")
+DEF_SWITCH(UnmergedPlatformViews,
+           "unmerged-platform-views",
+           "Composite the Android platform views without merging the raster "
+           "thread into the platform thread. The platform thread only "
+           "positions the views and overlays, which may lag the Flutter UI by "
+           "a frame while they move.")
 DEF_SWITCH(SkiaDeterministicRendering,
            "skia-deterministic-rendering",
            "Skips the call to SkGraphics::Init(), thus avoiding swapping out "
@@ -123,6 +137,10 @@ DEF_SWITCH(EnableServicePortFallback,
            "enable-service-port-fallback",
            "Allow the VM service to fallback to automatic port selection if"
            " binding to a specified port fails.")
+DEF_SWITCH(DeferServiceIsolateLaunch,
+           "defer-service-isolate-launch",
+           "Launch the VM service isolate after the first frame is rasterized"
+           " instead of during the initialization of the VM.")
 DEF_SWITCH(StartPaused,
            "start-paused",
            "Start the application paused in the Dart debugger.")
@@ -166,6 +184,26 @@ DEF_SWITCH(
     "Trace to the system tracer (instead of the timeline) on platforms where "
     "such a tracer is available. Currently only supported on Android and "
     "Fuchsia.")
+DEF_SWITCH(EnableTraceRingBuffer,
+           "enable-trace-ring-buffer",
+           "Record the most recent trace events of every thread into an "
+           "in-process ring buffer that can be dumped for post-mortem "
+           "analysis, even when no tracing session is running.")
+DEF_SWITCH(PreferPerformanceCoresWhenAnimating,
+           "prefer-performance-cores-when-animating",
+           "Move the UI and raster threads to the performance cores of the "
+           "device while frames are being produced, and let them run on any "
+           "core again once no frames have been produced for a while.")
+DEF_SWITCH(DecodeImagesToYUVPlanes,
+           "decode-images-to-yuv-planes",
+           "Decode the JPEG images that are not resized into YUV planes, "
+           "which the GPU converts to RGBA when the images are first drawn, "
+           "instead of uploading RGBA images from the IO thread.")
+DEF_SWITCH(ResizeImagesOnGPU,
+           "resize-images-on-gpu",
+           "Resize the large images that their codecs cannot decode at the "
+           "requested size on the GPU from the IO thread, by drawing them "
+           "into a texture of that size, instead of on the CPU.")
 DEF_SWITCH(UseTestFonts,
            "use-test-fonts",
            "Running tests that layout and measure text will not yield "
@@ -217,10 +255,139 @@ DEF_SWITCH(
 DEF_SWITCH(OldGenHeapSize,
            "old-gen-heap-size",
            "The size limit in megabytes for the Dart VM old gen heap space.")
+DEF_SWITCH(RasterCacheMaxMBytes,
+           "raster-cache-max-mbytes",
+           "The size limit in megabytes for the images of the raster cache. "
+           "The least recently used images are evicted to stay within it.")
+DEF_SWITCH(DecodedImageCacheMaxMBytes,
+           "decoded-image-cache-max-mbytes",
+           "The size limit in megabytes for the cache of the decoded images, "
+           "which gives back the image of the same encoded bytes decoded at "
+           "the same size again. The cache is off unless this is set.")
+DEF_SWITCH(MemoryPressureTargetMBytes,
+           "memory-pressure-target-mbytes",
+           "The memory in megabytes that the caches of the engine may keep "
+           "when the platform reports moderate memory pressure. By default, "
+           "half of what they hold is freed.")
+DEF_SWITCH(AnimatedImagePrefetchFrameCount,
+           "animated-image-prefetch-frame-count",
+           "The number of frames of animated images to decode on the worker "
+           "threads ahead of the frame that is shown. By default, each frame "
+           "is decoded on the IO thread when it is shown.")
+DEF_SWITCH(AnimatedImageFrameCacheMaxMBytes,
+           "animated-image-frame-cache-max-mbytes",
+           "The size limit in megabytes for all of the frames of an animated "
+           "image to be kept after its first loop instead of being decoded "
+           "again.")
+DEF_SWITCH(TextLayoutCacheMaxMBytes,
+           "text-layout-cache-max-mbytes",
+           "The size limit in megabytes for the cache of the shaped words of "
+           "the laid out text. The least recently used words are evicted to "
+           "stay within it, instead of keeping a fixed number of words.")
+DEF_SWITCH(SkiaExecutorMaxConcurrency,
+           "skia-executor-max-concurrency",
+           "The most tasks of the Skia background work that run at once on "
+           "the worker threads. By default, half of the worker threads may "
+           "run them.")
 DEF_SWITCH(EnableSkParagraph,
            "enable-skparagraph",
            "Selects the SkParagraph implementation of the text layout engine.")
 
+DEF_SWITCH(EnableDisplayListPrewarm,
+           "enable-display-list-prewarm",
+           "Prepare the paths and images used by the display lists of each "
+           "frame on the concurrent worker threads before the frame reaches "
+           "the raster thread.")
+
+DEF_SWITCH(EnableAsyncRasterCache,
+           "enable-async-raster-cache",
+           "Rasterize the raster cache images of pictures and display lists "
+           "on the IO thread, drawing them uncached until they are ready.")
+
+DEF_SWITCH(EnablePersistentRasterCache,
+           "enable-persistent-raster-cache",
+           "Store the raster cache images of the display lists drawn during "
+           "the first frames on disk and reuse them in later launches.")
+
+DEF_SWITCH(EnableConcurrentPreroll,
+           "enable-concurrent-preroll",
+           "Preroll the independent subtrees of wide container layers on the "
+           "concurrent worker threads.")
+DEF_SWITCH(EnableTextDrawBatching,
+           "enable-text-draw-batching",
+           "Defer the text drawn by the layers past the draws that do not "
+           "overlap it, so that the text of neighbouring layers is batched "
+           "into fewer GPU draws.")
+DEF_SWITCH(EnableConcurrentRasterCacheRecording,
+           "enable-concurrent-raster-cache-recording",
+           "Record the new raster cache images of pictures and display lists "
+           "on the concurrent worker threads, and draw the recordings on the "
+           "raster thread.")
+
+DEF_SWITCH(EnableAdaptivePipelineDepth,
+           "enable-adaptive-pipeline-depth",
+           "Let up to three frames be in flight between the UI and the raster "
+           "threads while the frames take longer than a vsync interval to "
+           "rasterize, and a single one while both threads are mostly idle.")
+
+DEF_SWITCH(EnablePredictiveFrameScheduling,
+           "enable-predictive-frame-scheduling",
+           "Start building each frame as late after its vsync as the timings "
+           "of the last frames predict that it can still be rasterized in "
+           "time, to reduce the latency of the input events.")
+
+DEF_SWITCH(RenderWithoutVsync,
+           "render-without-vsync",
+           "Begin each frame as soon as it is requested instead of at the next "
+           "vsync, and let up to three frames be in flight between the UI and "
+           "the raster threads. Meant for headless rendering.")
+
+DEF_SWITCH(EnablePointerCoalescing,
+           "enable-pointer-coalescing",
+           "Dispatch the moves and hovers of each pointer received during a "
+           "frame as a single event, with its position predicted at the "
+           "vsync.")
+
+DEF_SWITCH(EnablePrioritizedSkSLPrecompilation,
+           "enable-prioritized-sksl-precompilation",
+           "Precompile only the SkSLs that were most often needed by the "
+           "frames of previous runs before the first frame, and the other "
+           "SkSLs on the raster thread in between the next frames.")
+
+DEF_SWITCH(EnablePersistentCachePackFiles,
+           "enable-persistent-cache-pack-files",
+           "Store the shaders of the persistent cache in a single pack file "
+           "instead of in one file per shader, so that they are loaded at "
+           "startup without opening thousands of files.")
+
+DEF_SWITCH(EnablePathDeduplication,
+           "enable-path-deduplication",
+           "Draw the paths that are rebuilt with the same commands in "
+           "consecutive frames as a single path, so that they reuse the GPU "
+           "masks and tessellations that Skia cached for it.")
+
+DEF_SWITCH(EnablePlatformMessageBatching,
+           "enable-platform-message-batching",
+           "Deliver the platform messages that are sent before the UI thread "
+           "gets to them to the isolate in a single call, instead of with one "
+           "task and one call into Dart per message.")
+
+DEF_SWITCH(EnablePersistentFontFallbackCache,
+           "enable-persistent-font-fallback-cache",
+           "Remember the fallback fonts that the platform font manager matched "
+           "for the characters in the persistent cache, and reuse them on the "
+           "next launches while the system fonts stay the same.")
+DEF_SWITCH(EnableConcurrentStartup,
+           "enable-concurrent-startup",
+           "Initialize ICU, the default font manager and the reads of the "
+           "cached SkSLs on the IO and raster threads while the Dart VM is "
+           "created, instead of one after the other.")
+DEF_SWITCH(EnableStartupAssetPrefetch,
+           "enable-startup-asset-prefetch",
+           "Remember the assets that are read before the first frame in the "
+           "persistent cache, and read them ahead on the next launches while "
+           "the root isolate starts.")
+
 DEF_SWITCH(LeakVM,
            "leak-vm",
            "When the last shell shuts down, the shared VM is leaked by default "
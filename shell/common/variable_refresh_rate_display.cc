@@ -9,17 +9,23 @@ namespace flutter {
 
 VariableRefreshRateDisplay::VariableRefreshRateDisplay(
     DisplayId display_id,
-    const VariableRefreshRateReporter& refresh_rate_reporter)
-    : Display(display_id, refresh_rate_reporter.GetRefreshRate()),
+    const VariableRefreshRateReporter& refresh_rate_reporter,
+    double fallback_refresh_rate)
+    : Display(display_id, fallback_refresh_rate),
       refresh_rate_reporter_(refresh_rate_reporter) {}
 
 VariableRefreshRateDisplay::VariableRefreshRateDisplay(
-    const VariableRefreshRateReporter& refresh_rate_reporter)
-    : Display(refresh_rate_reporter.GetRefreshRate()),
+    const VariableRefreshRateReporter& refresh_rate_reporter,
+    double fallback_refresh_rate)
+    : Display(fallback_refresh_rate),
       refresh_rate_reporter_(refresh_rate_reporter) {}
 
 double VariableRefreshRateDisplay::GetRefreshRate() const {
-  return refresh_rate_reporter_.GetRefreshRate();
+  double refresh_rate = refresh_rate_reporter_.GetRefreshRate();
+  if (refresh_rate == kUnknownDisplayRefreshRate) {
+    return Display::GetRefreshRate();
+  }
+  return refresh_rate;
 }
 
 }  // namespace flutter
@@ -14,13 +14,18 @@
 namespace flutter {
 
 /// A Display where the refresh rate can change over time.
+///
+/// While the reporter does not know the refresh rate, the display reports
+/// `fallback_refresh_rate` instead.
 class VariableRefreshRateDisplay : public Display {
  public:
   explicit VariableRefreshRateDisplay(
       DisplayId display_id,
-      const VariableRefreshRateReporter& refresh_rate_reporter);
+      const VariableRefreshRateReporter& refresh_rate_reporter,
+      double fallback_refresh_rate = kUnknownDisplayRefreshRate);
   explicit VariableRefreshRateDisplay(
-      const VariableRefreshRateReporter& refresh_rate_reporter);
+      const VariableRefreshRateReporter& refresh_rate_reporter,
+      double fallback_refresh_rate = kUnknownDisplayRefreshRate);
   ~VariableRefreshRateDisplay() = default;
 
   // |Display|
@@ -25,5 +25,15 @@ TEST(VariableRefreshRateDisplayTest, ReportCorrectRefreshRateWhenUpdated) {
   ASSERT_EQ(display.GetRefreshRate(), 30);
 }
 
+TEST(VariableRefreshRateDisplayTest, ReportFallbackRefreshRateWhenUnknown) {
+  auto refresh_rate_reporter = std::make_unique<TestRefreshRateReporter>(
+      kUnknownDisplayRefreshRate);
+  auto display =
+      flutter::VariableRefreshRateDisplay(*refresh_rate_reporter.get(), 60);
+  ASSERT_EQ(display.GetRefreshRate(), 60);
+  refresh_rate_reporter->UpdateRefreshRate(120);
+  ASSERT_EQ(display.GetRefreshRate(), 120);
+}
+
 }  // namespace testing
 }  // namespace flutter
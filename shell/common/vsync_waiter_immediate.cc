@@ -0,0 +1,41 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/vsync_waiter_immediate.h"
+
+#include <memory>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+namespace {
+
+// The frames still get the target time of a 60Hz display, which is the
+// deadline that the framework and the idle notifications are given.
+constexpr fml::TimeDelta kSingleFrameInterval =
+    fml::TimeDelta::FromSecondsF(1.0 / 60.0);
+
+}  // namespace
+
+VsyncWaiterImmediate::VsyncWaiterImmediate(TaskRunners task_runners)
+    : VsyncWaiter(std::move(task_runners)) {}
+
+VsyncWaiterImmediate::~VsyncWaiterImmediate() = default;
+
+// |VsyncWaiter|
+void VsyncWaiterImmediate::AwaitVSync() {
+  TRACE_EVENT0("flutter", "VSYNC");
+
+  std::weak_ptr<VsyncWaiter> weak_this = shared_from_this();
+
+  task_runners_.GetUITaskRunner()->PostTask([weak_this]() {
+    if (auto vsync_waiter = weak_this.lock()) {
+      auto frame_start_time = fml::TimePoint::Now();
+      vsync_waiter->FireCallback(frame_start_time,
+                                 frame_start_time + kSingleFrameInterval);
+    }
+  });
+}
+
+}  // namespace flutter
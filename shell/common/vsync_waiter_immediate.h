@@ -0,0 +1,31 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_VSYNC_WAITER_IMMEDIATE_H_
+#define FLUTTER_SHELL_COMMON_VSYNC_WAITER_IMMEDIATE_H_
+
+#include "flutter/fml/macros.h"
+#include "flutter/shell/common/vsync_waiter.h"
+
+namespace flutter {
+
+/// A |VsyncWaiter| that fires as soon as it is awaited, so that frames are
+/// produced as fast as the UI and the raster threads allow instead of at the
+/// pace of a display.
+class VsyncWaiterImmediate final : public VsyncWaiter {
+ public:
+  explicit VsyncWaiterImmediate(TaskRunners task_runners);
+
+  ~VsyncWaiterImmediate() override;
+
+ private:
+  // |VsyncWaiter|
+  void AwaitVSync() override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(VsyncWaiterImmediate);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_VSYNC_WAITER_IMMEDIATE_H_
@@ -22,6 +22,9 @@
 #define GPU_GL_RGBA8 0x8058
 #define GPU_GL_RGBA4 0x8056
 #define GPU_GL_RGB565 0x8D62
+#define GPU_GL_TIMESTAMP 0x8E28
+#define GPU_GL_QUERY_RESULT 0x8866
+#define GPU_GL_QUERY_RESULT_AVAILABLE 0x8867
 
 namespace flutter {
 
@@ -35,6 +38,10 @@ static const int kGrCacheMaxCount = 8192;
 // system channel.
 static const size_t kGrCacheMaxByteSize = 24 * (1 << 20);
 
+// The number of frames whose GPU time may be pending. The queries of older
+// frames are dropped, which only happens if the GPU is far behind.
+static const size_t kMaxPendingGpuTimeQueries = 8;
+
 sk_sp<GrDirectContext> GPUSurfaceGL::MakeGLContext(
     GPUSurfaceGLDelegate* delegate) {
   auto context_switch = delegate->GLContextMakeCurrent();
@@ -75,14 +82,14 @@ GPUSurfaceGL::GPUSurfaceGL(sk_sp<GrDirectContext> gr_context,
       context_owner_(false),
       render_to_surface_(render_to_surface),
       weak_factory_(this) {
-  auto context_switch = delegate_->GLContextMakeCurrent();
+  auto context_switch = MakeContextCurrent();
   if (!context_switch->GetResult()) {
     FML_LOG(ERROR)
         << "Could not make the context current to set up the Gr context.";
     return;
   }
 
-  delegate_->GLContextClearCurrent();
+  ClearContextCurrent(false);
 
   valid_ = gr_context != nullptr;
 }
@@ -91,13 +98,14 @@ GPUSurfaceGL::~GPUSurfaceGL() {
   if (!valid_) {
     return;
   }
-  auto context_switch = delegate_->GLContextMakeCurrent();
+  auto context_switch = MakeContextCurrent();
   if (!context_switch->GetResult()) {
     FML_LOG(ERROR) << "Could not make the context current to destroy the "
                       "GrDirectContext resources.";
     return;
   }
 
+  DeleteGpuTimeQueries();
   onscreen_surface_ = nullptr;
   fbo_id_ = 0;
   if (context_owner_) {
@@ -105,7 +113,7 @@ GPUSurfaceGL::~GPUSurfaceGL() {
   }
   context_ = nullptr;
 
-  delegate_->GLContextClearCurrent();
+  ClearContextCurrent(true);
 }
 
 // |Surface|
@@ -209,7 +217,7 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGL::AcquireFrame(const SkISize& size) {
   if (delegate_ == nullptr) {
     return nullptr;
   }
-  auto context_switch = delegate_->GLContextMakeCurrent();
+  auto context_switch = MakeContextCurrent();
   if (!context_switch->GetResult()) {
     FML_LOG(ERROR)
         << "Could not make the context current to acquire the frame.";
@@ -239,6 +247,7 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGL::AcquireFrame(const SkISize& size) {
   }
 
   surface->getCanvas()->setMatrix(root_surface_transformation);
+  BeginGpuTiming();
   SurfaceFrame::SubmitCallback submit_callback =
       [weak = weak_factory_.GetWeakPtr()](const SurfaceFrame& surface_frame,
                                           SkCanvas* canvas) {
@@ -263,6 +272,8 @@ bool GPUSurfaceGL::PresentSurface(const SurfaceFrame& frame, SkCanvas* canvas) {
     onscreen_surface_->getCanvas()->flush();
   }
 
+  EndGpuTiming();
+
   if (!delegate_->GLContextPresent(fbo_id_, frame.submit_info().frame_damage)) {
     return false;
   }
@@ -317,11 +328,119 @@ GrDirectContext* GPUSurfaceGL::GetContext() {
 
 // |Surface|
 std::unique_ptr<GLContextResult> GPUSurfaceGL::MakeRenderContextCurrent() {
-  return delegate_->GLContextMakeCurrent();
+  return MakeContextCurrent();
 }
 
 // |Surface|
 bool GPUSurfaceGL::ClearRenderContext() {
+  // This is called when the thread the surface is used on changes, so even an
+  // exclusive context has to be cleared.
+  return ClearContextCurrent(true);
+}
+
+// |Surface|
+bool GPUSurfaceGL::EnableGpuTiming(GpuTimeCallback callback) {
+  auto context_switch = MakeContextCurrent();
+  if (!context_switch->GetResult()) {
+    return false;
+  }
+  // The timestamp queries are core in OpenGL 3.3, and available on OpenGL ES
+  // through GL_EXT_disjoint_timer_query, in which case Skia resolves them.
+  sk_sp<const GrGLInterface> interface = delegate_->GetGLInterface();
+  if (!interface) {
+    return false;
+  }
+  const GrGLInterface::Functions& gl = interface->fFunctions;
+  if (!gl.fGenQueries || !gl.fDeleteQueries || !gl.fQueryCounter ||
+      !gl.fGetQueryObjectuiv || !gl.fGetQueryObjectui64v) {
+    return false;
+  }
+  gpu_timing_interface_ = std::move(interface);
+  gpu_time_callback_ = std::move(callback);
+  return true;
+}
+
+void GPUSurfaceGL::BeginGpuTiming() {
+  if (!gpu_timing_interface_) {
+    return;
+  }
+  const GrGLInterface::Functions& gl = gpu_timing_interface_->fFunctions;
+  // The query of a frame that was not submitted is reused.
+  if (gpu_time_start_query_ == 0) {
+    gl.fGenQueries(1, &gpu_time_start_query_);
+  }
+  gl.fQueryCounter(gpu_time_start_query_, GPU_GL_TIMESTAMP);
+}
+
+void GPUSurfaceGL::EndGpuTiming() {
+  if (!gpu_timing_interface_ || gpu_time_start_query_ == 0) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "GPUSurfaceGL::EndGpuTiming");
+  const GrGLInterface::Functions& gl = gpu_timing_interface_->fFunctions;
+  GrGLuint end_query = 0;
+  gl.fGenQueries(1, &end_query);
+  gl.fQueryCounter(end_query, GPU_GL_TIMESTAMP);
+  pending_gpu_time_queries_.emplace_back(gpu_time_start_query_, end_query);
+  gpu_time_start_query_ = 0;
+
+  // The queries complete in order, so the first one that is not available
+  // ends the frames that can be reported.
+  while (!pending_gpu_time_queries_.empty()) {
+    auto [start, end] = pending_gpu_time_queries_.front();
+    bool dropped = pending_gpu_time_queries_.size() > kMaxPendingGpuTimeQueries;
+    if (!dropped) {
+      GrGLuint available = 0;
+      gl.fGetQueryObjectuiv(end, GPU_GL_QUERY_RESULT_AVAILABLE, &available);
+      if (!available) {
+        break;
+      }
+      GrGLuint64 start_ns = 0;
+      GrGLuint64 end_ns = 0;
+      gl.fGetQueryObjectui64v(start, GPU_GL_QUERY_RESULT, &start_ns);
+      gl.fGetQueryObjectui64v(end, GPU_GL_QUERY_RESULT, &end_ns);
+      if (end_ns >= start_ns) {
+        gpu_time_callback_(fml::TimeDelta::FromNanoseconds(end_ns - start_ns));
+      }
+    }
+    GrGLuint queries[] = {start, end};
+    gl.fDeleteQueries(2, queries);
+    pending_gpu_time_queries_.pop_front();
+  }
+}
+
+void GPUSurfaceGL::DeleteGpuTimeQueries() {
+  if (!gpu_timing_interface_) {
+    return;
+  }
+  const GrGLInterface::Functions& gl = gpu_timing_interface_->fFunctions;
+  if (gpu_time_start_query_ != 0) {
+    gl.fDeleteQueries(1, &gpu_time_start_query_);
+    gpu_time_start_query_ = 0;
+  }
+  for (const auto& [start, end] : pending_gpu_time_queries_) {
+    GrGLuint queries[] = {start, end};
+    gl.fDeleteQueries(2, queries);
+  }
+  pending_gpu_time_queries_.clear();
+}
+
+std::unique_ptr<GLContextResult> GPUSurfaceGL::MakeContextCurrent() {
+  if (exclusive_context_thread_ == std::this_thread::get_id()) {
+    return std::make_unique<GLContextDefaultResult>(true);
+  }
+  auto context_switch = delegate_->GLContextMakeCurrent();
+  if (context_switch->GetResult() && delegate_->GLContextIsExclusive()) {
+    exclusive_context_thread_ = std::this_thread::get_id();
+  }
+  return context_switch;
+}
+
+bool GPUSurfaceGL::ClearContextCurrent(bool force) {
+  if (delegate_->GLContextIsExclusive() && !force) {
+    return true;
+  }
+  exclusive_context_thread_ = std::thread::id();
   return delegate_->GLContextClearCurrent();
 }
 
@@ -330,4 +449,10 @@ bool GPUSurfaceGL::AllowsDrawingWhenGpuDisabled() const {
   return delegate_->AllowsDrawingWhenGpuDisabled();
 }
 
+// |Surface|
+bool GPUSurfaceGL::AllowsSkippingUnchangedFrames() const {
+  // The framebuffer is only presented by swapping it.
+  return true;
+}
+
 }  // namespace flutter
@@ -5,8 +5,11 @@
 #ifndef SHELL_GPU_GPU_SURFACE_GL_H_
 #define SHELL_GPU_GPU_SURFACE_GL_H_
 
+#include <deque>
 #include <functional>
 #include <memory>
+#include <thread>
+#include <utility>
 
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/flow/embedded_views.h"
@@ -15,6 +18,7 @@
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/shell/gpu/gpu_surface_gl_delegate.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/gl/GrGLInterface.h"
 
 namespace flutter {
 
@@ -53,6 +57,12 @@ class GPUSurfaceGL : public Surface {
   // |Surface|
   bool AllowsDrawingWhenGpuDisabled() const override;
 
+  // |Surface|
+  bool AllowsSkippingUnchangedFrames() const override;
+
+  // |Surface|
+  bool EnableGpuTiming(GpuTimeCallback callback) override;
+
  private:
   bool CreateOrUpdateSurfaces(const SkISize& size);
 
@@ -62,6 +72,25 @@ class GPUSurfaceGL : public Surface {
 
   bool PresentSurface(const SurfaceFrame& frame, SkCanvas* canvas);
 
+  // Makes the context of the delegate current, unless it is exclusive and
+  // already current on this thread.
+  std::unique_ptr<GLContextResult> MakeContextCurrent();
+
+  // Clears the context of the delegate, unless it is exclusive and |force| is
+  // false.
+  bool ClearContextCurrent(bool force);
+
+  // Writes a GPU timestamp before the commands of the frame, if GPU timing is
+  // enabled.
+  void BeginGpuTiming();
+
+  // Writes a GPU timestamp after the commands of the frame, and reports the
+  // time of the frames the GPU has finished.
+  void EndGpuTiming();
+
+  // Deletes the timestamp queries that have not been reported.
+  void DeleteGpuTimeQueries();
+
   GPUSurfaceGLDelegate* delegate_;
   sk_sp<GrDirectContext> context_;
   sk_sp<SkSurface> onscreen_surface_;
@@ -74,6 +103,17 @@ class GPUSurfaceGL : public Surface {
   // external view embedder is present.
   const bool render_to_surface_ = true;
   bool valid_ = false;
+  // The thread the exclusive context of the delegate was left current on, if
+  // any.
+  std::thread::id exclusive_context_thread_;
+  // The GL functions used to measure the GPU time of frames, if enabled.
+  sk_sp<const GrGLInterface> gpu_timing_interface_;
+  GpuTimeCallback gpu_time_callback_;
+  // The timestamp query written before the commands of the current frame.
+  GrGLuint gpu_time_start_query_ = 0;
+  // The start and end timestamp queries of the submitted frames whose time has
+  // not been reported yet, oldest first.
+  std::deque<std::pair<GrGLuint, GrGLuint>> pending_gpu_time_queries_;
 
   // WeakPtrFactory must be the last member.
   fml::TaskRunnerAffineWeakPtrFactory<GPUSurfaceGL> weak_factory_;
@@ -16,6 +16,10 @@ bool GPUSurfaceGLDelegate::GLContextFBOResetAfterPresent() const {
   return false;
 }
 
+bool GPUSurfaceGLDelegate::GLContextIsExclusive() const {
+  return false;
+}
+
 SurfaceFrame::FramebufferInfo GPUSurfaceGLDelegate::GLContextFramebufferInfo()
     const {
   SurfaceFrame::FramebufferInfo res;
@@ -55,6 +55,12 @@ class GPUSurfaceGLDelegate {
   // rendering subsequent frames.
   virtual bool GLContextFBOResetAfterPresent() const;
 
+  // Whether the main GL context is only used by the engine on the thread it
+  // renders on. If so, the context is made current once and left current,
+  // rather than made current again each time the engine uses it. It is only
+  // cleared when the surface is destroyed or moves to another thread.
+  virtual bool GLContextIsExclusive() const;
+
   // Returns framebuffer info for current backbuffer
   virtual SurfaceFrame::FramebufferInfo GLContextFramebufferInfo() const;
 
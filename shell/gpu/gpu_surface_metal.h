@@ -40,6 +40,10 @@ class SK_API_AVAILABLE_CA_METAL_LAYER GPUSurfaceMetal : public Surface {
   // MTLTexture for each drawable
   std::map<uintptr_t, SkIRect> damage_;
 
+  // The size of the drawables the damage is tracked for. The drawables of the
+  // layer are replaced when it's resized.
+  SkISize drawable_size_ = SkISize::MakeEmpty();
+
   // |Surface|
   std::unique_ptr<SurfaceFrame> AcquireFrame(const SkISize& size) override;
 
@@ -55,6 +59,9 @@ class SK_API_AVAILABLE_CA_METAL_LAYER GPUSurfaceMetal : public Surface {
   // |Surface|
   bool AllowsDrawingWhenGpuDisabled() const override;
 
+  // |Surface|
+  bool AllowsSkippingUnchangedFrames() const override;
+
   std::unique_ptr<SurfaceFrame> AcquireFrameFromCAMetalLayer(
       const SkISize& frame_info);
 
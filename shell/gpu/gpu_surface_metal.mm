@@ -112,6 +112,15 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetal::AcquireFrameFromCAMetalLayer(
     return nullptr;
   }
 
+  // The textures of the old drawables may be reused for the new ones after a
+  // resize, so the damage tracked for them no longer applies.
+  const SkISize drawable_size =
+      SkISize::Make(drawable.get().texture.width, drawable.get().texture.height);
+  if (drawable_size != drawable_size_) {
+    damage_.clear();
+    drawable_size_ = drawable_size;
+  }
+
   auto surface = CreateSurfaceFromMetalTexture(context_.get(), drawable.get().texture,
                                                kTopLeft_GrSurfaceOrigin,  // origin
                                                1,                         // sample count
@@ -125,8 +134,9 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetal::AcquireFrameFromCAMetalLayer(
     return nullptr;
   }
 
-  auto submit_callback = [this, drawable](const SurfaceFrame& surface_frame,
-                                          SkCanvas* canvas) -> bool {
+  const NSUInteger maximum_drawable_count = mtl_layer.maximumDrawableCount;
+  auto submit_callback = [this, drawable, maximum_drawable_count](
+                             const SurfaceFrame& surface_frame, SkCanvas* canvas) -> bool {
     TRACE_EVENT0("flutter", "GPUSurfaceMetal::Submit");
     if (canvas == nullptr) {
       FML_DLOG(ERROR) << "Canvas not available.";
@@ -139,14 +149,21 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetal::AcquireFrameFromCAMetalLayer(
     }
 
     uintptr_t texture = reinterpret_cast<uintptr_t>(drawable.get().texture);
+    // A frame without damage was repainted entirely.
+    const SkIRect frame_damage = surface_frame.submit_info().frame_damage.value_or(
+        SkIRect::MakeSize(drawable_size_));
     for (auto& entry : damage_) {
       if (entry.first != texture) {
         // Accumulate damage for other framebuffers
-        if (surface_frame.submit_info().frame_damage) {
-          entry.second.join(*surface_frame.submit_info().frame_damage);
-        }
+        entry.second.join(frame_damage);
       }
     }
+    // Drawables are only ever cycled through a ring of the layer's maximum
+    // drawable count, so more textures than that means the older ones were
+    // released. Their contents are unknown if they come back.
+    if (damage_.size() >= maximum_drawable_count && damage_.find(texture) == damage_.end()) {
+      damage_.clear();
+    }
     // Reset accumulated damage for current framebuffer
     damage_[texture] = SkIRect::MakeEmpty();
 
@@ -235,4 +252,9 @@ bool GPUSurfaceMetal::AllowsDrawingWhenGpuDisabled() const {
   return delegate_->AllowsDrawingWhenGpuDisabled();
 }
 
+bool GPUSurfaceMetal::AllowsSkippingUnchangedFrames() const {
+  // The layer keeps showing its last presented drawable.
+  return true;
+}
+
 }  // namespace flutter
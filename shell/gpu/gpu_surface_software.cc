@@ -4,11 +4,90 @@
 
 #include "flutter/shell/gpu/gpu_surface_software.h"
 
+#include <algorithm>
 #include <memory>
+#include <thread>
+
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/utils/SkNWayCanvas.h"
+#include "third_party/skia/include/utils/SkNoDrawCanvas.h"
 
 namespace flutter {
 
+namespace {
+
+// The fewest rows of the backing store that are worth rasterizing on a worker
+// of their own.
+constexpr int kMinBandHeight = 64;
+
+// Notes whether the frame reads back from the backing store, in which case its
+// bands cannot be rasterized independently of each other.
+class BackdropSpyCanvas final : public SkNoDrawCanvas {
+ public:
+  BackdropSpyCanvas(int width, int height) : SkNoDrawCanvas(width, height) {}
+
+  bool HasBackdrops() const { return has_backdrops_; }
+
+ private:
+  bool has_backdrops_ = false;
+
+  // |SkNoDrawCanvas|
+  SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec& rec) override {
+    if (rec.fBackdrop != nullptr) {
+      has_backdrops_ = true;
+    }
+    return kNoLayer_SaveLayerStrategy;
+  }
+};
+
+// The recording of a frame that is rasterized when it is submitted.
+struct FrameRecording {
+  explicit FrameRecording(const SkISize& size)
+      : spy(size.width(), size.height()),
+        canvas(size.width(), size.height()) {
+    canvas.addCanvas(recorder.beginRecording(SkRect::Make(size)));
+    canvas.addCanvas(&spy);
+  }
+
+  SkPictureRecorder recorder;
+  BackdropSpyCanvas spy;
+  SkNWayCanvas canvas;
+};
+
+// Plays the picture back into the region of the pixels in bands of rows, all
+// but the first of which are rasterized on the workers of the task runner.
+void DrawPictureInBands(
+    const sk_sp<SkPicture>& picture,
+    const SkPixmap& pixmap,
+    const SkIRect& region,
+    int band_count,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& task_runner) {
+  auto draw_band = [&picture, &pixmap, &region, band_count](int band) {
+    const SkIRect band_rect = SkIRect::MakeLTRB(
+        region.left(), region.top() + region.height() * band / band_count,
+        region.right(),
+        region.top() + region.height() * (band + 1) / band_count);
+    auto canvas = SkCanvas::MakeRasterDirect(
+        pixmap.info(), pixmap.writable_addr(), pixmap.rowBytes());
+    canvas->clipRect(SkRect::Make(band_rect));
+    canvas->drawPicture(picture);
+  };
+
+  fml::CountDownLatch latch(band_count - 1);
+  for (int band = 1; band < band_count; band++) {
+    task_runner->PostTask([&draw_band, &latch, band]() {
+      draw_band(band);
+      latch.CountDown();
+    });
+  }
+  draw_band(0);
+  latch.Wait();
+}
+
+}  // namespace
+
 GPUSurfaceSoftware::GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
                                        bool render_to_surface)
     : delegate_(delegate),
@@ -60,6 +139,13 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
   SkCanvas* canvas = backing_store->getCanvas();
   canvas->resetMatrix();
 
+  std::shared_ptr<fml::ConcurrentTaskRunner> tile_task_runner =
+      delegate_->GetTileTaskRunner();
+  if (tile_task_runner) {
+    return AcquireRecordedFrame(std::move(backing_store),
+                                std::move(tile_task_runner));
+  }
+
   SurfaceFrame::SubmitCallback on_submit =
       [self = weak_factory_.GetWeakPtr()](const SurfaceFrame& surface_frame,
                                           SkCanvas* canvas) -> bool {
@@ -70,13 +156,69 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
 
     canvas->flush();
 
+    self->delegate_->SetFrameDamage(surface_frame.submit_info().buffer_damage);
     return self->delegate_->PresentBackingStore(surface_frame.SkiaSurface());
   };
 
+  framebuffer_info = delegate_->GetFramebufferInfo();
   return std::make_unique<SurfaceFrame>(backing_store,
                                         std::move(framebuffer_info), on_submit);
 }
 
+std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireRecordedFrame(
+    sk_sp<SkSurface> backing_store,
+    std::shared_ptr<fml::ConcurrentTaskRunner> tile_task_runner) {
+  auto recording = std::make_shared<FrameRecording>(
+      SkISize::Make(backing_store->width(), backing_store->height()));
+
+  SurfaceFrame::SubmitCallback on_submit =
+      [self = weak_factory_.GetWeakPtr(), recording, tile_task_runner](
+          const SurfaceFrame& surface_frame, SkCanvas* canvas) -> bool {
+    // If the surface itself went away, there is nothing more to do.
+    if (!self || !self->IsValid() || canvas == nullptr) {
+      return false;
+    }
+
+    sk_sp<SkPicture> picture = recording->recorder.finishRecordingAsPicture();
+    sk_sp<SkSurface> backing_store = surface_frame.SkiaSurface();
+    const std::optional<SkIRect>& damage =
+        surface_frame.submit_info().buffer_damage;
+
+    // Only the damaged rows are split into bands, the picture is clipped to
+    // the damage already.
+    SkIRect region =
+        SkIRect::MakeWH(backing_store->width(), backing_store->height());
+    if (!damage || region.intersect(*damage)) {
+      const int band_count =
+          std::min(static_cast<int>(std::thread::hardware_concurrency()),
+                   region.height() / kMinBandHeight);
+      bool in_bands = band_count > 1 && !recording->spy.HasBackdrops();
+      SkPixmap pixmap;
+      if (in_bands) {
+        // The pixels are written directly, so the snapshots of the surface
+        // must stop sharing them first.
+        backing_store->notifyContentWillChange(
+            SkSurface::kRetain_ContentChangeMode);
+        in_bands = backing_store->peekPixels(&pixmap);
+      }
+      if (in_bands) {
+        DrawPictureInBands(picture, pixmap, region, band_count,
+                           tile_task_runner);
+      } else {
+        backing_store->getCanvas()->drawPicture(picture);
+      }
+    }
+
+    self->delegate_->SetFrameDamage(damage);
+    return self->delegate_->PresentBackingStore(backing_store);
+  };
+
+  SkCanvas* canvas = &recording->canvas;
+  return std::make_unique<SurfaceFrame>(std::move(backing_store), canvas,
+                                        delegate_->GetFramebufferInfo(),
+                                        on_submit);
+}
+
 // |Surface|
 SkMatrix GPUSurfaceSoftware::GetRootTransformation() const {
   // This backend does not currently support root surface transformations. Just
@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 
 #include "flutter/flow/surface.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/shell/gpu/gpu_surface_software_delegate.h"
@@ -39,6 +40,13 @@ class GPUSurfaceSoftware : public Surface {
   // external view embedder is present.
   const bool render_to_surface_;
   fml::TaskRunnerAffineWeakPtrFactory<GPUSurfaceSoftware> weak_factory_;
+
+  // Acquires a frame that is recorded, then rasterized into the backing store
+  // in bands of rows on the workers of the task runner when it is submitted.
+  std::unique_ptr<SurfaceFrame> AcquireRecordedFrame(
+      sk_sp<SkSurface> backing_store,
+      std::shared_ptr<fml::ConcurrentTaskRunner> tile_task_runner);
+
   FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceSoftware);
 };
 
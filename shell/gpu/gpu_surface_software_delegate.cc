@@ -8,4 +8,16 @@ namespace flutter {
 
 GPUSurfaceSoftwareDelegate::~GPUSurfaceSoftwareDelegate() = default;
 
+SurfaceFrame::FramebufferInfo GPUSurfaceSoftwareDelegate::GetFramebufferInfo()
+    const {
+  SurfaceFrame::FramebufferInfo info;
+  info.supports_readback = true;
+  return info;
+}
+
+std::shared_ptr<fml::ConcurrentTaskRunner>
+GPUSurfaceSoftwareDelegate::GetTileTaskRunner() const {
+  return nullptr;
+}
+
 }  // namespace flutter
@@ -5,7 +5,11 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_DELEGATE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_DELEGATE_H_
 
+#include <optional>
+
 #include "flutter/flow/embedded_views.h"
+#include "flutter/flow/surface_frame.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
@@ -38,6 +42,35 @@ class GPUSurfaceSoftwareDelegate {
   ///
   virtual sk_sp<SkSurface> AcquireBackingStore(const SkISize& size) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The framebuffer info of the backing store acquired last. By
+  ///             default, the backing store supports readback but not the
+  ///             partial repaint of the frames.
+  ///
+  /// @return     The framebuffer info of the frame rendered into the backing
+  ///             store.
+  ///
+  virtual SurfaceFrame::FramebufferInfo GetFramebufferInfo() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called with the damage of the frame rendered into the backing
+  ///             store before it is presented.
+  ///
+  /// @param[in]  damage  The region of the backing store that changed since
+  ///                     it was last presented, or null if all of it did.
+  ///
+  virtual void SetFrameDamage(const std::optional<SkIRect>& damage) {}
+
+  //----------------------------------------------------------------------------
+  /// @brief      The task runner of the workers that the frames are rasterized
+  ///             on, in bands of rows of the backing store. By default, there
+  ///             is none and the frames are rasterized on the raster thread.
+  ///
+  /// @return     The task runner to rasterize the frames on, or null.
+  ///
+  virtual std::shared_ptr<fml::ConcurrentTaskRunner> GetTileTaskRunner()
+      const;
+
   //----------------------------------------------------------------------------
   /// @brief      Called by the platform when a frame has been rendered into the
   ///             backing store and the platform must display it on-screen.
@@ -19,9 +19,21 @@ GPUSurfaceVulkan::GPUSurfaceVulkan(GPUSurfaceVulkanDelegate* delegate,
       render_to_surface_(render_to_surface),
       weak_factory_(this) {}
 
+GPUSurfaceVulkan::GPUSurfaceVulkan(
+    std::unique_ptr<vulkan::VulkanWindow> window,
+    bool render_to_surface)
+    : delegate_(nullptr),
+      window_(std::move(window)),
+      skia_context_(sk_ref_sp(window_->GetSkiaGrContext())),
+      render_to_surface_(render_to_surface),
+      weak_factory_(this) {}
+
 GPUSurfaceVulkan::~GPUSurfaceVulkan() = default;
 
 bool GPUSurfaceVulkan::IsValid() {
+  if (window_ && !window_->IsValid()) {
+    return false;
+  }
   return skia_context_ != nullptr;
 }
 
@@ -45,6 +57,10 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkan::AcquireFrame(
         });
   }
 
+  if (window_) {
+    return AcquireWindowFrame();
+  }
+
   FlutterVulkanImage image = delegate_->AcquireImage(frame_size);
   if (!image.image) {
     FML_LOG(ERROR) << "Invalid VkImage given by the embedder.";
@@ -80,6 +96,34 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkan::AcquireFrame(
       std::move(surface), std::move(framebuffer_info), std::move(callback));
 }
 
+std::unique_ptr<SurfaceFrame> GPUSurfaceVulkan::AcquireWindowFrame() {
+  // The swapchain is recreated by the window when the size of the native
+  // surface changes.
+  sk_sp<SkSurface> surface = window_->AcquireSurface();
+  if (!surface) {
+    FML_LOG(ERROR) << "Could not acquire a surface from the Vulkan window.";
+    return nullptr;
+  }
+
+  SurfaceFrame::SubmitCallback callback =
+      [weak_this = weak_factory_.GetWeakPtr()](const SurfaceFrame&,
+                                               SkCanvas* canvas) -> bool {
+    TRACE_EVENT0("flutter", "GPUSurfaceVulkan::SwapBuffers");
+    if (!weak_this || canvas == nullptr) {
+      return false;
+    }
+
+    canvas->flush();
+
+    return weak_this->window_->SwapBuffers();
+  };
+
+  SurfaceFrame::FramebufferInfo framebuffer_info{.supports_readback = true};
+
+  return std::make_unique<SurfaceFrame>(
+      std::move(surface), std::move(framebuffer_info), std::move(callback));
+}
+
 SkMatrix GPUSurfaceVulkan::GetRootTransformation() const {
   // This backend does not support delegating to the underlying platform to
   // query for root surface transformations. Just return identity.
@@ -92,6 +136,11 @@ GrDirectContext* GPUSurfaceVulkan::GetContext() {
   return skia_context_.get();
 }
 
+bool GPUSurfaceVulkan::AllowsSkippingUnchangedFrames() const {
+  // The swapchain keeps showing its last presented image.
+  return true;
+}
+
 sk_sp<SkSurface> GPUSurfaceVulkan::CreateSurfaceFromVulkanImage(
     const VkImage image,
     const VkFormat format,
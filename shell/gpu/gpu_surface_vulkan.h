@@ -20,7 +20,7 @@ namespace flutter {
 
 //------------------------------------------------------------------------------
 /// @brief  A GPU surface backed by VkImages provided by a
-///         GPUSurfaceVulkanDelegate.
+///         GPUSurfaceVulkanDelegate, or by the swapchain of a VulkanWindow.
 ///
 class GPUSurfaceVulkan : public Surface {
  public:
@@ -32,6 +32,13 @@ class GPUSurfaceVulkan : public Surface {
                    const sk_sp<GrDirectContext>& context,
                    bool render_to_surface);
 
+  //------------------------------------------------------------------------------
+  /// @brief      Create a GPUSurfaceVulkan that renders to the swapchain of the
+  ///             window, using the GrDirectContext of the window.
+  ///
+  GPUSurfaceVulkan(std::unique_ptr<vulkan::VulkanWindow> window,
+                   bool render_to_surface);
+
   ~GPUSurfaceVulkan() override;
 
   // |Surface|
@@ -46,15 +53,21 @@ class GPUSurfaceVulkan : public Surface {
   // |Surface|
   GrDirectContext* GetContext() override;
 
+  // |Surface|
+  bool AllowsSkippingUnchangedFrames() const override;
+
   static SkColorType ColorTypeFromFormat(const VkFormat format);
 
  private:
   GPUSurfaceVulkanDelegate* delegate_;
+  std::unique_ptr<vulkan::VulkanWindow> window_;
   sk_sp<GrDirectContext> skia_context_;
   bool render_to_surface_;
 
   fml::WeakPtrFactory<GPUSurfaceVulkan> weak_factory_;
 
+  std::unique_ptr<SurfaceFrame> AcquireWindowFrame();
+
   sk_sp<SkSurface> CreateSurfaceFromVulkanImage(const VkImage image,
                                                 const VkFormat format,
                                                 const SkISize& size);
@@ -6,24 +6,115 @@
 
 #include <GLES/glext.h>
 
+#include "flutter/fml/native_library.h"
+#include "flutter/fml/platform/android/jni_util.h"
 #include "third_party/skia/include/gpu/GrBackendSurface.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
 namespace flutter {
 
+namespace {
+
+// The functions of the NDK surface texture. They are only available on API
+// 28+, so they are looked up at runtime.
+struct SurfaceTextureProcs {
+  fml::RefPtr<fml::NativeLibrary> libandroid;
+  ASurfaceTexture* (*FromSurfaceTexture)(JNIEnv* env,
+                                         jobject surface_texture) = nullptr;
+  void (*Release)(ASurfaceTexture* surface_texture) = nullptr;
+  int (*AttachToGLContext)(ASurfaceTexture* surface_texture,
+                           uint32_t texture_name) = nullptr;
+  int (*DetachFromGLContext)(ASurfaceTexture* surface_texture) = nullptr;
+  int (*UpdateTexImage)(ASurfaceTexture* surface_texture) = nullptr;
+  void (*GetTransformMatrix)(ASurfaceTexture* surface_texture,
+                             float matrix[16]) = nullptr;
+
+  bool IsAvailable() const {
+    return FromSurfaceTexture != nullptr && Release != nullptr &&
+           AttachToGLContext != nullptr && DetachFromGLContext != nullptr &&
+           UpdateTexImage != nullptr && GetTransformMatrix != nullptr;
+  }
+};
+
+const SurfaceTextureProcs& GetSurfaceTextureProcs() {
+  static const SurfaceTextureProcs procs = [] {
+    SurfaceTextureProcs procs;
+    procs.libandroid = fml::NativeLibrary::Create("libandroid.so");
+    if (!procs.libandroid) {
+      return procs;
+    }
+    procs.FromSurfaceTexture =
+        procs.libandroid
+            ->ResolveFunction<decltype(procs.FromSurfaceTexture)>(
+                "ASurfaceTexture_fromSurfaceTexture")
+            .value_or(nullptr);
+    procs.Release = procs.libandroid
+                        ->ResolveFunction<decltype(procs.Release)>(
+                            "ASurfaceTexture_release")
+                        .value_or(nullptr);
+    procs.AttachToGLContext =
+        procs.libandroid
+            ->ResolveFunction<decltype(procs.AttachToGLContext)>(
+                "ASurfaceTexture_attachToGLContext")
+            .value_or(nullptr);
+    procs.DetachFromGLContext =
+        procs.libandroid
+            ->ResolveFunction<decltype(procs.DetachFromGLContext)>(
+                "ASurfaceTexture_detachFromGLContext")
+            .value_or(nullptr);
+    procs.UpdateTexImage =
+        procs.libandroid
+            ->ResolveFunction<decltype(procs.UpdateTexImage)>(
+                "ASurfaceTexture_updateTexImage")
+            .value_or(nullptr);
+    procs.GetTransformMatrix =
+        procs.libandroid
+            ->ResolveFunction<decltype(procs.GetTransformMatrix)>(
+                "ASurfaceTexture_getTransformMatrix")
+            .value_or(nullptr);
+    return procs;
+  }();
+  return procs;
+}
+
+// Returns the surface texture the weak reference refers to, if it's still
+// alive.
+fml::jni::ScopedJavaLocalRef<jobject> GetSurfaceTexture(
+    JNIEnv* env,
+    const fml::jni::ScopedJavaGlobalRef<jobject>& weak_reference) {
+  static jmethodID get_method = [env] {
+    fml::jni::ScopedJavaLocalRef<jclass> weak_reference_class(
+        env, env->FindClass("java/lang/ref/WeakReference"));
+    FML_CHECK(!weak_reference_class.is_null());
+    return env->GetMethodID(weak_reference_class.obj(), "get",
+                            "()Ljava/lang/Object;");
+  }();
+  fml::jni::ScopedJavaLocalRef<jobject> surface_texture(
+      env, env->CallObjectMethod(weak_reference.obj(), get_method));
+  FML_CHECK(fml::jni::CheckException(env));
+  return surface_texture;
+}
+
+}  // namespace
+
 AndroidExternalTextureGL::AndroidExternalTextureGL(
     int64_t id,
     const fml::jni::ScopedJavaGlobalRef<jobject>& surface_texture,
-    std::shared_ptr<PlatformViewAndroidJNI> jni_facade)
+    std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
+    bool drop_stale_frames)
     : Texture(id),
       jni_facade_(jni_facade),
       surface_texture_(surface_texture),
+      drop_stale_frames_(drop_stale_frames),
       transform(SkMatrix::I()) {}
 
 AndroidExternalTextureGL::~AndroidExternalTextureGL() {
   if (state_ == AttachmentState::attached) {
     glDeleteTextures(1, &texture_name_);
   }
+  if (native_surface_texture_) {
+    GetSurfaceTextureProcs().Release(native_surface_texture_);
+  }
 }
 
 void AndroidExternalTextureGL::OnGrContextCreated() {
@@ -31,7 +122,7 @@ void AndroidExternalTextureGL::OnGrContextCreated() {
 }
 
 void AndroidExternalTextureGL::MarkNewFrameAvailable() {
-  new_frame_ready_ = true;
+  pending_frames_.fetch_add(1, std::memory_order_relaxed);
 }
 
 void AndroidExternalTextureGL::Paint(SkCanvas& canvas,
@@ -48,9 +139,8 @@ void AndroidExternalTextureGL::Paint(SkCanvas& canvas,
     Attach(static_cast<jint>(texture_name_));
     state_ = AttachmentState::attached;
   }
-  if (!freeze && new_frame_ready_) {
+  if (!freeze) {
     Update();
-    new_frame_ready_ = false;
   }
   GrGLTextureInfo textureInfo = {GL_TEXTURE_EXTERNAL_OES, texture_name_,
                                  GL_RGBA8_OES};
@@ -75,6 +165,13 @@ void AndroidExternalTextureGL::Paint(SkCanvas& canvas,
 }
 
 void AndroidExternalTextureGL::UpdateTransform() {
+  if (native_surface_texture_) {
+    float matrix[16];
+    GetSurfaceTextureProcs().GetTransformMatrix(native_surface_texture_,
+                                                matrix);
+    transform = SurfaceTextureTransformToSkMatrix(matrix);
+    return;
+  }
   jni_facade_->SurfaceTextureGetTransformMatrix(
       fml::jni::ScopedJavaLocalRef<jobject>(surface_texture_), transform);
 }
@@ -88,17 +185,57 @@ void AndroidExternalTextureGL::OnGrContextDestroyed() {
 }
 
 void AndroidExternalTextureGL::Attach(jint textureName) {
+  const SurfaceTextureProcs& procs = GetSurfaceTextureProcs();
+  if (!native_surface_texture_ && procs.IsAvailable()) {
+    JNIEnv* env = fml::jni::AttachCurrentThread();
+    fml::jni::ScopedJavaLocalRef<jobject> surface_texture =
+        GetSurfaceTexture(env, surface_texture_);
+    if (!surface_texture.is_null()) {
+      native_surface_texture_ =
+          procs.FromSurfaceTexture(env, surface_texture.obj());
+    }
+  }
+  if (native_surface_texture_) {
+    procs.AttachToGLContext(native_surface_texture_, textureName);
+    return;
+  }
   jni_facade_->SurfaceTextureAttachToGLContext(
       fml::jni::ScopedJavaLocalRef<jobject>(surface_texture_), textureName);
 }
 
 void AndroidExternalTextureGL::Update() {
+  int frames = pending_frames_.exchange(0, std::memory_order_relaxed);
+  if (frames == 0) {
+    return;
+  }
+  // Without frame dropping only the oldest frame is latched, and the rest stay
+  // pending for the following paints.
+  if (!drop_stale_frames_ && frames > 1) {
+    pending_frames_.fetch_add(frames - 1, std::memory_order_relaxed);
+    frames = 1;
+  }
+  // Each update releases the previous buffer to the producer and latches the
+  // next queued one, so the stale frames are dropped by updating past them.
+  for (int i = 0; i < frames; i++) {
+    UpdateTexImage();
+  }
+  UpdateTransform();
+}
+
+void AndroidExternalTextureGL::UpdateTexImage() {
+  if (native_surface_texture_) {
+    GetSurfaceTextureProcs().UpdateTexImage(native_surface_texture_);
+    return;
+  }
   jni_facade_->SurfaceTextureUpdateTexImage(
       fml::jni::ScopedJavaLocalRef<jobject>(surface_texture_));
-  UpdateTransform();
 }
 
 void AndroidExternalTextureGL::Detach() {
+  if (native_surface_texture_) {
+    GetSurfaceTextureProcs().DetachFromGLContext(native_surface_texture_);
+    return;
+  }
   jni_facade_->SurfaceTextureDetachFromGLContext(
       fml::jni::ScopedJavaLocalRef<jobject>(surface_texture_));
 }
@@ -7,9 +7,13 @@
 
 #include <GLES/gl.h>
 
+#include <atomic>
+
 #include "flutter/common/graphics/texture.h"
 #include "flutter/shell/platform/android/platform_view_android_jni_impl.h"
 
+struct ASurfaceTexture;
+
 namespace flutter {
 
 class AndroidExternalTextureGL : public flutter::Texture {
@@ -17,7 +21,8 @@ class AndroidExternalTextureGL : public flutter::Texture {
   AndroidExternalTextureGL(
       int64_t id,
       const fml::jni::ScopedJavaGlobalRef<jobject>& surface_texture,
-      std::shared_ptr<PlatformViewAndroidJNI> jni_facade);
+      std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
+      bool drop_stale_frames = false);
 
   ~AndroidExternalTextureGL() override;
 
@@ -41,6 +46,8 @@ class AndroidExternalTextureGL : public flutter::Texture {
 
   void Update();
 
+  void UpdateTexImage();
+
   void Detach();
 
   void UpdateTransform();
@@ -53,7 +60,18 @@ class AndroidExternalTextureGL : public flutter::Texture {
 
   AttachmentState state_ = AttachmentState::uninitialized;
 
-  bool new_frame_ready_ = false;
+  // When set, a paint latches the newest frame of the surface texture and
+  // drops the frames that arrived since the last paint. Otherwise the frames
+  // are shown one per paint.
+  const bool drop_stale_frames_;
+
+  // The frames that were made available since they were last latched. Counted
+  // on the platform thread and consumed on the raster thread.
+  std::atomic<int> pending_frames_ = 0;
+
+  // The NDK handle of the surface texture, which avoids the JNI calls on API
+  // 28+. Null when the NDK functions aren't available.
+  ASurfaceTexture* native_surface_texture_ = nullptr;
 
   GLuint texture_name_ = 0;
 
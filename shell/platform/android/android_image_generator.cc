@@ -66,15 +66,32 @@ bool AndroidImageGenerator::GetPixels(const SkImageInfo& info,
       return false;
   }
 
-  // TODO(bdero): Override `GetImage()` to use `SkImage::FromAHardwareBuffer` on
-  // API level 30+ once it's updated to do symbol lookups and not get
-  // preprocessed out in Skia. This will allow for avoiding this copy in
-  // cases where the result image doesn't need to be resized.
+  if (!software_decoded_data_) {
+    return false;
+  }
+
   memcpy(pixels, software_decoded_data_->data(),
          software_decoded_data_->size());
   return true;
 }
 
+sk_sp<SkImage> AndroidImageGenerator::GetImage() {
+  fully_decoded_latch_.Wait();
+
+  if (!software_decoded_data_) {
+    return nullptr;
+  }
+
+  // The image shares the locked pixels of the decoded bitmap, which the image
+  // decoder uploads to the GPU directly, instead of copying them first.
+  // TODO(bdero): Use `SkImage::FromAHardwareBuffer` on API level 30+ once it's
+  // updated to do symbol lookups and not get preprocessed out in Skia. This
+  // will also avoid the upload.
+  const SkImageInfo& info = GetInfo();
+  return SkImage::MakeRasterData(info, software_decoded_data_,
+                                 info.minRowBytes());
+}
+
 void AndroidImageGenerator::DecodeImage() {
   DoDecodeImage();
 
@@ -127,6 +144,7 @@ void AndroidImageGenerator::DoDecodeImage() {
         reinterpret_cast<fml::jni::ScopedJavaGlobalRef<jobject>*>(context);
     auto env = fml::jni::AttachCurrentThread();
     AndroidBitmap_unlockPixels(env, bitmap->obj());
+    delete bitmap;
   };
 
   software_decoded_data_ = SkData::MakeWithProc(
@@ -44,6 +44,9 @@ class AndroidImageGenerator : public ImageGenerator {
                  unsigned int frame_index,
                  std::optional<unsigned int> prior_frame) override;
 
+  // |ImageGenerator|
+  sk_sp<SkImage> GetImage() override;
+
   void DecodeImage();
 
   static bool Register(JNIEnv* env);
@@ -0,0 +1,125 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_performance_hint.h"
+
+#include "flutter/fml/native_library.h"
+
+namespace flutter {
+
+namespace {
+
+struct APerformanceHintManager;
+
+// The functions of the NDK performance hint API. They are only available on
+// API 33+, so they are looked up at runtime.
+struct PerformanceHintProcs {
+  fml::RefPtr<fml::NativeLibrary> libandroid;
+  APerformanceHintManager* (*GetManager)() = nullptr;
+  APerformanceHintSession* (*CreateSession)(
+      APerformanceHintManager* manager,
+      const int32_t* thread_ids,
+      size_t size,
+      int64_t initial_target_work_duration_nanos) = nullptr;
+  int (*UpdateTargetWorkDuration)(APerformanceHintSession* session,
+                                  int64_t target_duration_nanos) = nullptr;
+  int (*ReportActualWorkDuration)(APerformanceHintSession* session,
+                                  int64_t actual_duration_nanos) = nullptr;
+  void (*CloseSession)(APerformanceHintSession* session) = nullptr;
+
+  bool IsAvailable() const {
+    return GetManager != nullptr && CreateSession != nullptr &&
+           UpdateTargetWorkDuration != nullptr &&
+           ReportActualWorkDuration != nullptr && CloseSession != nullptr;
+  }
+};
+
+const PerformanceHintProcs& GetPerformanceHintProcs() {
+  static const PerformanceHintProcs procs = [] {
+    PerformanceHintProcs procs;
+    procs.libandroid = fml::NativeLibrary::Create("libandroid.so");
+    if (!procs.libandroid) {
+      return procs;
+    }
+    procs.GetManager = procs.libandroid
+                           ->ResolveFunction<decltype(procs.GetManager)>(
+                               "APerformanceHint_getManager")
+                           .value_or(nullptr);
+    procs.CreateSession = procs.libandroid
+                              ->ResolveFunction<decltype(procs.CreateSession)>(
+                                  "APerformanceHint_createSession")
+                              .value_or(nullptr);
+    procs.UpdateTargetWorkDuration =
+        procs.libandroid
+            ->ResolveFunction<decltype(procs.UpdateTargetWorkDuration)>(
+                "APerformanceHint_updateTargetWorkDuration")
+            .value_or(nullptr);
+    procs.ReportActualWorkDuration =
+        procs.libandroid
+            ->ResolveFunction<decltype(procs.ReportActualWorkDuration)>(
+                "APerformanceHint_reportActualWorkDuration")
+            .value_or(nullptr);
+    procs.CloseSession = procs.libandroid
+                             ->ResolveFunction<decltype(procs.CloseSession)>(
+                                 "APerformanceHint_closeSession")
+                             .value_or(nullptr);
+    return procs;
+  }();
+  return procs;
+}
+
+}  // namespace
+
+std::unique_ptr<AndroidPerformanceHintSession>
+AndroidPerformanceHintSession::Create(pid_t thread_id,
+                                      fml::TimeDelta target_duration) {
+  const PerformanceHintProcs& procs = GetPerformanceHintProcs();
+  if (!procs.IsAvailable()) {
+    return nullptr;
+  }
+  APerformanceHintManager* manager = procs.GetManager();
+  if (manager == nullptr) {
+    return nullptr;
+  }
+  int32_t thread_ids[] = {thread_id};
+  APerformanceHintSession* session = procs.CreateSession(
+      manager, thread_ids, 1, target_duration.ToNanoseconds());
+  if (session == nullptr) {
+    // The device doesn't support performance hints.
+    return nullptr;
+  }
+  return std::unique_ptr<AndroidPerformanceHintSession>(
+      new AndroidPerformanceHintSession(session, target_duration));
+}
+
+AndroidPerformanceHintSession::AndroidPerformanceHintSession(
+    APerformanceHintSession* session,
+    fml::TimeDelta target_duration)
+    : session_(session), target_duration_(target_duration) {}
+
+AndroidPerformanceHintSession::~AndroidPerformanceHintSession() {
+  GetPerformanceHintProcs().CloseSession(session_);
+}
+
+void AndroidPerformanceHintSession::UpdateTargetDuration(
+    fml::TimeDelta target_duration) {
+  if (target_duration == target_duration_) {
+    return;
+  }
+  target_duration_ = target_duration;
+  GetPerformanceHintProcs().UpdateTargetWorkDuration(
+      session_, target_duration.ToNanoseconds());
+}
+
+void AndroidPerformanceHintSession::ReportActualDuration(
+    fml::TimeDelta actual_duration) {
+  // The duration must be positive.
+  if (actual_duration <= fml::TimeDelta::Zero()) {
+    return;
+  }
+  GetPerformanceHintProcs().ReportActualWorkDuration(
+      session_, actual_duration.ToNanoseconds());
+}
+
+}  // namespace flutter
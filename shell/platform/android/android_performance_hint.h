@@ -0,0 +1,61 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_PERFORMANCE_HINT_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_PERFORMANCE_HINT_H_
+
+#include <sys/types.h>
+
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+struct APerformanceHintSession;
+
+//------------------------------------------------------------------------------
+/// @brief      A performance hint session of the Android NDK, which tells the
+///             CPU governor how long the work of a thread takes compared to
+///             its deadline, so that it can boost the thread before the
+///             deadline is missed.
+///
+class AndroidPerformanceHintSession {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a session for the thread.
+  ///
+  /// @return     The session, or nullptr if the device doesn't support
+  ///             performance hints, which require API 33.
+  ///
+  static std::unique_ptr<AndroidPerformanceHintSession> Create(
+      pid_t thread_id,
+      fml::TimeDelta target_duration);
+
+  ~AndroidPerformanceHintSession();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Updates the duration that the work of each frame should take.
+  ///
+  void UpdateTargetDuration(fml::TimeDelta target_duration);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reports the duration that the work of a frame took.
+  ///
+  void ReportActualDuration(fml::TimeDelta actual_duration);
+
+ private:
+  APerformanceHintSession* session_;
+  fml::TimeDelta target_duration_;
+
+  AndroidPerformanceHintSession(APerformanceHintSession* session,
+                                fml::TimeDelta target_duration);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AndroidPerformanceHintSession);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_PERFORMANCE_HINT_H_
@@ -21,12 +21,14 @@
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/native_library.h"
 #include "flutter/fml/platform/android/jni_util.h"
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/lib/ui/painting/image_generator_registry.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/run_configuration.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/shell/platform/android/android_display.h"
 #include "flutter/shell/platform/android/android_image_generator.h"
+#include "flutter/shell/platform/android/android_performance_hint.h"
 #include "flutter/shell/platform/android/context/android_context.h"
 #include "flutter/shell/platform/android/platform_view_android.h"
 
@@ -71,6 +73,56 @@ static void AndroidPlatformThreadConfigSetter(
       }
   }
 }
+// Creates a performance hint session for the thread of the task runner.
+static std::unique_ptr<AndroidPerformanceHintSession>
+CreatePerformanceHintSession(const fml::RefPtr<fml::TaskRunner>& task_runner,
+                             fml::TimeDelta target_duration) {
+  std::unique_ptr<AndroidPerformanceHintSession> session;
+  fml::AutoResetWaitableEvent latch;
+  task_runner->PostTask([&session, &latch, target_duration]() {
+    session = AndroidPerformanceHintSession::Create(gettid(), target_duration);
+    latch.Signal();
+  });
+  latch.Wait();
+  return session;
+}
+
+// Reports the durations of the work of the UI and raster threads on each frame
+// to their performance hint sessions, so that the CPU governor ramps them up
+// before they miss the frame deadline. Returns |callback| if the device doesn't
+// support performance hints.
+static FrameRasterizedCallback MakePerformanceHintCallback(
+    const TaskRunners& task_runners,
+    double refresh_rate,
+    FrameRasterizedCallback callback) {
+  if (refresh_rate <= 0) {
+    refresh_rate = 60;
+  }
+  // The refresh rate is read once since reading it goes through JNI.
+  const fml::TimeDelta frame_budget =
+      fml::TimeDelta::FromSecondsF(1.0 / refresh_rate);
+  std::shared_ptr<AndroidPerformanceHintSession> ui_session =
+      CreatePerformanceHintSession(task_runners.GetUITaskRunner(),
+                                   frame_budget);
+  std::shared_ptr<AndroidPerformanceHintSession> raster_session =
+      CreatePerformanceHintSession(task_runners.GetRasterTaskRunner(),
+                                   frame_budget);
+  if (!ui_session || !raster_session) {
+    return callback;
+  }
+  return [ui_session, raster_session,
+          callback = std::move(callback)](const FrameTiming& timing) {
+    ui_session->ReportActualDuration(timing.Get(FrameTiming::kBuildFinish) -
+                                     timing.Get(FrameTiming::kBuildStart));
+    raster_session->ReportActualDuration(
+        timing.Get(FrameTiming::kRasterFinish) -
+        timing.Get(FrameTiming::kRasterStart));
+    if (callback) {
+      callback(timing);
+    }
+  };
+}
+
 static PlatformData GetDefaultPlatformData() {
   PlatformData platform_data;
   platform_data.lifecycle_state = "AppLifecycleState.detached";
@@ -113,7 +165,13 @@ AndroidShellHolder::AndroidShellHolder(
             shell.GetTaskRunners(),  // task runners
             jni_facade,              // JNI interop
             shell.GetSettings()
-                .enable_software_rendering  // use software rendering
+                .enable_software_rendering,  // use software rendering
+            shell.GetSettings()
+                .enable_vulkan_rendering,  // use Vulkan rendering
+            shell.GetSettings()
+                .drop_stale_texture_frames,  // drop stale texture frames
+            shell.GetSettings()
+                .unmerged_platform_views  // unmerged platform views
         );
         weak_platform_view = platform_view_android->GetWeakPtr();
         std::vector<std::unique_ptr<Display>> displays;
@@ -146,10 +204,15 @@ AndroidShellHolder::AndroidShellHolder(
                                     io_runner         // io
   );
 
+  Settings shell_settings = settings_;
+  shell_settings.frame_rasterized_callback = MakePerformanceHintCallback(
+      task_runners, jni_facade->GetDisplayRefreshRate(),
+      settings_.frame_rasterized_callback);
+
   shell_ =
       Shell::Create(GetDefaultPlatformData(),  // window data
                     task_runners,              // task runners
-                    settings_,                 // settings
+                    shell_settings,            // settings
                     on_create_platform_view,   // platform view create callback
                     on_create_rasterizer       // rasterizer create callback
       );
@@ -242,7 +305,11 @@ std::unique_ptr<AndroidShellHolder> AndroidShellHolder::Spawn(
             shell,                   // delegate
             shell.GetTaskRunners(),  // task runners
             jni_facade,              // JNI interop
-            android_context          // Android context
+            android_context,         // Android context
+            shell.GetSettings()
+                .drop_stale_texture_frames,  // drop stale texture frames
+            shell.GetSettings()
+                .unmerged_platform_views  // unmerged platform views
         );
         weak_platform_view = platform_view_android->GetWeakPtr();
         std::vector<std::unique_ptr<Display>> displays;
@@ -312,6 +379,11 @@ void AndroidShellHolder::NotifyLowMemoryWarning() {
   shell_->NotifyLowMemoryWarning();
 }
 
+void AndroidShellHolder::NotifyModerateMemoryPressure() {
+  FML_DCHECK(shell_);
+  shell_->NotifyMemoryPressure(MemoryPressureLevel::kModerate);
+}
+
 std::optional<RunConfiguration> AndroidShellHolder::BuildRunConfiguration(
     std::shared_ptr<flutter::AssetManager> asset_manager,
     const std::string& entrypoint,
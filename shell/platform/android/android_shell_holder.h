@@ -99,6 +99,8 @@ class AndroidShellHolder {
 
   void NotifyLowMemoryWarning();
 
+  void NotifyModerateMemoryPressure();
+
   const std::shared_ptr<PlatformMessageHandler>& GetPlatformMessageHandler()
       const {
     return shell_->GetPlatformMessageHandler();
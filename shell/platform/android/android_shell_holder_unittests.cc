@@ -46,6 +46,7 @@ class MockPlatformViewAndroidJNI : public PlatformViewAndroidJNI {
   MOCK_METHOD0(FlutterViewCreateOverlaySurface,
                std::unique_ptr<PlatformViewAndroidJNI::OverlayMetadata>());
   MOCK_METHOD0(FlutterViewDestroyOverlaySurfaces, void());
+  MOCK_METHOD1(FlutterViewDestroyOverlaySurface, void(int surface_id));
   MOCK_METHOD1(FlutterViewComputePlatformResolvedLocale,
                std::unique_ptr<std::vector<std::string>>(
                    std::vector<std::string> supported_locales_data));
@@ -0,0 +1,116 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_surface_vulkan.h"
+
+#include <android/api-level.h>
+
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/vulkan/vulkan_native_surface_android.h"
+#include "flutter/vulkan/vulkan_window.h"
+
+namespace flutter {
+
+namespace {
+// The first API level that requires the devices that report Vulkan support to
+// implement Vulkan 1.1, which the drivers of older devices are too unreliable
+// to replace GL with.
+constexpr int kMinimumVulkanApiLevel = 29;
+}  // anonymous namespace
+
+AndroidSurfaceVulkan::AndroidSurfaceVulkan(
+    const std::shared_ptr<AndroidContext>& android_context,
+    std::shared_ptr<PlatformViewAndroidJNI> jni_facade)
+    : AndroidSurface(android_context),
+      proc_table_(fml::MakeRefCounted<vulkan::VulkanProcTable>()) {}
+
+AndroidSurfaceVulkan::~AndroidSurfaceVulkan() = default;
+
+bool AndroidSurfaceVulkan::IsSupported() {
+  if (android_get_device_api_level() < kMinimumVulkanApiLevel) {
+    return false;
+  }
+  auto proc_table = fml::MakeRefCounted<vulkan::VulkanProcTable>();
+  return proc_table->HasAcquiredMandatoryProcAddresses();
+}
+
+bool AndroidSurfaceVulkan::IsValid() const {
+  return proc_table_->HasAcquiredMandatoryProcAddresses();
+}
+
+void AndroidSurfaceVulkan::TeardownOnScreenContext() {
+  // The swapchain is owned by the GPU surface, which is destroyed along with
+  // the rasterizer's surface.
+  native_window_ = nullptr;
+}
+
+std::unique_ptr<Surface> AndroidSurfaceVulkan::CreateGPUSurface(
+    GrDirectContext* gr_context) {
+  if (!IsValid()) {
+    return nullptr;
+  }
+
+  if (!native_window_ || !native_window_->IsValid()) {
+    return nullptr;
+  }
+
+  auto vulkan_surface_android =
+      std::make_unique<vulkan::VulkanNativeSurfaceAndroid>(
+          native_window_->handle());
+
+  if (!vulkan_surface_android->IsValid()) {
+    return nullptr;
+  }
+
+  sk_sp<GrDirectContext> main_skia_context =
+      gr_context ? sk_ref_sp(gr_context)
+                 : android_context_->GetMainSkiaContext();
+
+  // The first window creates the Skia context that the later ones share.
+  auto vulkan_window = std::make_unique<vulkan::VulkanWindow>(
+      main_skia_context, proc_table_, std::move(vulkan_surface_android));
+  if (!vulkan_window->IsValid()) {
+    FML_LOG(ERROR) << "Could not create the Vulkan window.";
+    return nullptr;
+  }
+  if (!main_skia_context) {
+    android_context_->SetMainSkiaContext(
+        sk_ref_sp(vulkan_window->GetSkiaGrContext()));
+  }
+
+  auto gpu_surface = std::make_unique<GPUSurfaceVulkan>(
+      std::move(vulkan_window), true /* render to surface */);
+
+  if (!gpu_surface->IsValid()) {
+    return nullptr;
+  }
+
+  return gpu_surface;
+}
+
+bool AndroidSurfaceVulkan::OnScreenSurfaceResize(const SkISize& size) {
+  // The swapchain is recreated when the window is resized, when the next
+  // frame is acquired.
+  return true;
+}
+
+bool AndroidSurfaceVulkan::ResourceContextMakeCurrent() {
+  // Vulkan has no current context. Without a resource context, the images are
+  // uploaded on the raster thread.
+  return false;
+}
+
+bool AndroidSurfaceVulkan::ResourceContextClearCurrent() {
+  return false;
+}
+
+bool AndroidSurfaceVulkan::SetNativeWindow(
+    fml::RefPtr<AndroidNativeWindow> window) {
+  native_window_ = std::move(window);
+  return native_window_ && native_window_->IsValid();
+}
+
+}  // namespace flutter
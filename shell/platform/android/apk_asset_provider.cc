@@ -4,12 +4,14 @@
 
 #include "flutter/shell/platform/android/apk_asset_provider.h"
 
+#include <fcntl.h>
 #include <unistd.h>
 
 #include <algorithm>
 #include <sstream>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/unique_fd.h"
 
 namespace flutter {
 
@@ -69,4 +71,26 @@ std::unique_ptr<fml::Mapping> APKAssetProvider::GetAsMapping(
   return std::make_unique<APKAssetMapping>(asset);
 }
 
+bool APKAssetProvider::Prefetch(const std::string& asset_name) const {
+  std::stringstream ss;
+  ss << directory_.c_str() << "/" << asset_name;
+  AAsset* asset = AAssetManager_open(assetManager_, ss.str().c_str(),
+                                     AASSET_MODE_STREAMING);
+  if (!asset) {
+    return false;
+  }
+
+  // Only the assets that are stored uncompressed in the APK have a range of
+  // the APK file that can be read ahead.
+  off64_t start = 0;
+  off64_t length = 0;
+  fml::UniqueFD fd(AAsset_openFileDescriptor64(asset, &start, &length));
+  AAsset_close(asset);
+  if (!fd.is_valid()) {
+    return false;
+  }
+
+  return ::posix_fadvise(fd.get(), start, length, POSIX_FADV_WILLNEED) == 0;
+}
+
 }  // namespace flutter
@@ -39,6 +39,9 @@ class APKAssetProvider final : public AssetResolver {
   std::unique_ptr<fml::Mapping> GetAsMapping(
       const std::string& asset_name) const override;
 
+  // |flutter::AssetResolver|
+  bool Prefetch(const std::string& asset_name) const override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(APKAssetProvider);
 };
 
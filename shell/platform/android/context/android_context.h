@@ -14,6 +14,7 @@ namespace flutter {
 enum class AndroidRenderingAPI {
   kSoftware,
   kOpenGLES,
+  kVulkan,
 };
 
 //------------------------------------------------------------------------------
@@ -4,6 +4,8 @@
 
 #include "flutter/shell/platform/android/external_view_embedder/external_view_embedder.h"
 
+#include <algorithm>
+
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/task_runner.h"
 #include "flutter/fml/trace_event.h"
@@ -15,13 +17,17 @@ AndroidExternalViewEmbedder::AndroidExternalViewEmbedder(
     const AndroidContext& android_context,
     std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
     std::shared_ptr<AndroidSurfaceFactory> surface_factory,
-    TaskRunners task_runners)
+    TaskRunners task_runners,
+    bool merges_threads)
     : ExternalViewEmbedder(),
       android_context_(android_context),
       jni_facade_(jni_facade),
       surface_factory_(surface_factory),
-      surface_pool_(std::make_unique<SurfacePool>()),
-      task_runners_(task_runners) {}
+      task_runners_(task_runners),
+      surface_pool_(std::make_unique<SurfacePool>(
+          task_runners_.GetPlatformTaskRunner())),
+      merges_threads_(merges_threads),
+      pending_commit_(std::make_shared<PendingCommit>()) {}
 
 // |ExternalViewEmbedder|
 void AndroidExternalViewEmbedder::PrerollCompositeEmbeddedView(
@@ -84,6 +90,10 @@ void AndroidExternalViewEmbedder::SubmitFrame(
 
   if (!FrameHasPlatformLayers()) {
     frame->Submit();
+    // The platform thread hides the views of the previous frame.
+    if (!merges_threads_ && previous_frame_view_count_ > 0) {
+      CommitFrame();
+    }
     return;
   }
 
@@ -106,6 +116,7 @@ void AndroidExternalViewEmbedder::SubmitFrame(
 
     sk_sp<RTree> rtree = view_rtrees_.at(view_id);
     SkRect joined_rect = SkRect::MakeEmpty();
+    std::vector<SkRect> intersection_rects;
 
     // Determinate if Flutter UI intersects with any of the previous
     // platform views stacked by z position.
@@ -117,8 +128,8 @@ void AndroidExternalViewEmbedder::SubmitFrame(
       int64_t current_view_id = composition_order_[j];
       SkRect current_view_rect = GetViewRect(current_view_id);
       // Each rect corresponds to a native view that renders Flutter UI.
-      std::list<SkRect> intersection_rects =
-          rtree->searchNonOverlappingDrawnRects(current_view_rect);
+      rtree->searchNonOverlappingDrawnRects(current_view_rect,
+                                            &intersection_rects);
 
       // Limit the number of native views, so it doesn't grow forever.
       //
@@ -153,63 +164,185 @@ void AndroidExternalViewEmbedder::SubmitFrame(
     frame->Submit();
   }
 
+  std::unordered_map<int64_t, OverlayGroup> overlay_groups =
+      MergeOverlayLayers(overlay_layers);
+
+  // Create the overlay layers missing from the pool all at once, rather than
+  // one at a time as the views are displayed.
+  surface_pool_->PreallocateLayers(overlay_groups.size(), context,
+                                   android_context_, jni_facade_,
+                                   surface_factory_);
+
   for (int64_t view_id : composition_order_) {
-    SkRect view_rect = GetViewRect(view_id);
-    const EmbeddedViewParams& params = view_params_.at(view_id);
     // Display the platform view. If it's already displayed, then it's
     // just positioned and sized.
-    jni_facade_->FlutterViewOnDisplayPlatformView(
-        view_id,             //
-        view_rect.x(),       //
-        view_rect.y(),       //
-        view_rect.width(),   //
-        view_rect.height(),  //
-        params.sizePoints().width() * device_pixel_ratio_,
-        params.sizePoints().height() * device_pixel_ratio_,
-        params.mutatorsStack()  //
-    );
-    std::unordered_map<int64_t, SkRect>::const_iterator overlay =
-        overlay_layers.find(view_id);
-    if (overlay == overlay_layers.end()) {
+    DisplayPlatformView(view_id);
+    std::unordered_map<int64_t, OverlayGroup>::const_iterator overlay =
+        overlay_groups.find(view_id);
+    if (overlay == overlay_groups.end()) {
       continue;
     }
     std::unique_ptr<SurfaceFrame> frame =
-        CreateSurfaceIfNeeded(context,               //
-                              view_id,               //
-                              pictures.at(view_id),  //
-                              overlay->second        //
-        );
+        CreateSurfaceIfNeeded(context, overlay->second, pictures);
     if (should_submit_current_frame) {
       frame->Submit();
     }
   }
+  if (!merges_threads_ && should_submit_current_frame) {
+    CommitFrame();
+  }
+  display_calls_.clear();
+}
+
+void AndroidExternalViewEmbedder::DisplayPlatformView(int64_t view_id) {
+  SkRect view_rect = GetViewRect(view_id);
+  const EmbeddedViewParams& params = view_params_.at(view_id);
+  SkSize view_size =
+      SkSize::Make(params.sizePoints().width() * device_pixel_ratio_,
+                   params.sizePoints().height() * device_pixel_ratio_);
+  if (!merges_threads_) {
+    display_calls_.push_back({view_id, /*is_overlay=*/false, view_rect,
+                              view_size, params.mutatorsStack()});
+    return;
+  }
+  jni_facade_->FlutterViewOnDisplayPlatformView(
+      view_id,               //
+      view_rect.x(),         //
+      view_rect.y(),         //
+      view_rect.width(),     //
+      view_rect.height(),    //
+      view_size.width(),     //
+      view_size.height(),    //
+      params.mutatorsStack()  //
+  );
+}
+
+void AndroidExternalViewEmbedder::DisplayOverlaySurface(int overlay_id,
+                                                        const SkRect& rect) {
+  if (!merges_threads_) {
+    display_calls_.push_back({overlay_id, /*is_overlay=*/true, rect,
+                              SkSize::MakeEmpty(), MutatorsStack()});
+    return;
+  }
+  jni_facade_->FlutterViewDisplayOverlaySurface(overlay_id,    //
+                                                rect.x(),      //
+                                                rect.y(),      //
+                                                rect.width(),  //
+                                                rect.height()  //
+  );
+}
+
+void AndroidExternalViewEmbedder::CommitFrame() {
+  TRACE_EVENT0("flutter", "AndroidExternalViewEmbedder::CommitFrame");
+  bool has_pending_task;
+  {
+    std::scoped_lock lock(pending_commit_->mutex);
+    has_pending_task = pending_commit_->calls.has_value();
+    pending_commit_->calls = std::move(display_calls_);
+  }
+  display_calls_.clear();
+  // A task that hasn't run yet applies the calls of this frame instead.
+  if (has_pending_task) {
+    return;
+  }
+  task_runners_.GetPlatformTaskRunner()->PostTask(
+      [commit = pending_commit_, jni_facade = jni_facade_]() {
+        ApplyPendingCommit(commit, *jni_facade);
+      });
+}
+
+void AndroidExternalViewEmbedder::ApplyPendingCommit(
+    const std::shared_ptr<PendingCommit>& commit,
+    PlatformViewAndroidJNI& jni_facade) {
+  std::vector<DisplayCall> calls;
+  {
+    std::scoped_lock lock(commit->mutex);
+    if (!commit->calls.has_value()) {
+      return;
+    }
+    calls = std::move(*commit->calls);
+    commit->calls.reset();
+  }
+  TRACE_EVENT0("flutter", "AndroidExternalViewEmbedder::ApplyPendingCommit");
+  jni_facade.FlutterViewBeginFrame();
+  for (const DisplayCall& call : calls) {
+    if (call.is_overlay) {
+      jni_facade.FlutterViewDisplayOverlaySurface(
+          call.id, call.rect.x(), call.rect.y(), call.rect.width(),
+          call.rect.height());
+    } else {
+      jni_facade.FlutterViewOnDisplayPlatformView(
+          call.id, call.rect.x(), call.rect.y(), call.rect.width(),
+          call.rect.height(), call.view_size.width(), call.view_size.height(),
+          call.mutators);
+    }
+  }
+  jni_facade.FlutterViewEndFrame();
+}
+
+std::unordered_map<int64_t, AndroidExternalViewEmbedder::OverlayGroup>
+AndroidExternalViewEmbedder::MergeOverlayLayers(
+    const std::unordered_map<int64_t, SkRect>& overlay_layers) const {
+  std::unordered_map<int64_t, OverlayGroup> overlay_groups;
+  OverlayGroup group;
+  int64_t previous_view_id = 0;
+  for (int64_t view_id : composition_order_) {
+    if (!group.entries.empty()) {
+      // The group can't be displayed above this view if it covers it, so it's
+      // displayed above the previous view instead.
+      SkRect view_rect = GetViewRect(view_id);
+      bool covers_view = std::any_of(
+          group.entries.begin(), group.entries.end(),
+          [&view_rect](const std::pair<int64_t, SkRect>& entry) {
+            return entry.second.intersects(view_rect);
+          });
+      if (covers_view) {
+        overlay_groups[previous_view_id] = std::move(group);
+        group = OverlayGroup();
+      }
+    }
+    std::unordered_map<int64_t, SkRect>::const_iterator overlay =
+        overlay_layers.find(view_id);
+    if (overlay != overlay_layers.end()) {
+      group.bounds.join(overlay->second);
+      group.entries.emplace_back(view_id, overlay->second);
+    }
+    previous_view_id = view_id;
+  }
+  if (!group.entries.empty()) {
+    overlay_groups[previous_view_id] = std::move(group);
+  }
+  return overlay_groups;
 }
 
 // |ExternalViewEmbedder|
 std::unique_ptr<SurfaceFrame>
-AndroidExternalViewEmbedder::CreateSurfaceIfNeeded(GrDirectContext* context,
-                                                   int64_t view_id,
-                                                   sk_sp<SkPicture> picture,
-                                                   const SkRect& rect) {
+AndroidExternalViewEmbedder::CreateSurfaceIfNeeded(
+    GrDirectContext* context,
+    const OverlayGroup& group,
+    const std::unordered_map<int64_t, sk_sp<SkPicture>>& pictures) {
+  const SkRect& rect = group.bounds;
   std::shared_ptr<OverlayLayer> layer = surface_pool_->GetLayer(
       context, android_context_, jni_facade_, surface_factory_);
 
+  // The layer may be larger than the frame when it was created for a larger
+  // frame, so its frame covers the whole surface.
   std::unique_ptr<SurfaceFrame> frame =
-      layer->surface->AcquireFrame(frame_size_);
+      layer->surface->AcquireFrame(layer->frame_size);
   // Display the overlay surface. If it's already displayed, then it's
   // just positioned and sized.
-  jni_facade_->FlutterViewDisplayOverlaySurface(layer->id,     //
-                                                rect.x(),      //
-                                                rect.y(),      //
-                                                rect.width(),  //
-                                                rect.height()  //
-  );
+  DisplayOverlaySurface(layer->id, rect);
   SkCanvas* overlay_canvas = frame->SkiaCanvas();
   overlay_canvas->clear(SK_ColorTRANSPARENT);
   // Offset the picture since its absolute position on the scene is determined
   // by the position of the overlay view.
   overlay_canvas->translate(-rect.x(), -rect.y());
-  overlay_canvas->drawPicture(picture);
+  for (const auto& [view_id, picture_rect] : group.entries) {
+    // The rest of the picture is drawn on the background canvas.
+    SkAutoCanvasRestore save(overlay_canvas, /*doSave=*/true);
+    overlay_canvas->clipRect(picture_rect);
+    overlay_canvas->drawPicture(pictures.at(view_id));
+  }
   return frame;
 }
 
@@ -219,6 +352,13 @@ PostPrerollResult AndroidExternalViewEmbedder::PostPrerollAction(
   if (!FrameHasPlatformLayers()) {
     return PostPrerollResult::kSuccess;
   }
+  if (!merges_threads_) {
+    // Surface switch requires to resubmit the frame.
+    if (previous_frame_view_count_ == 0) {
+      return PostPrerollResult::kResubmitFrame;
+    }
+    return PostPrerollResult::kSuccess;
+  }
   if (!raster_thread_merger->IsMerged()) {
     // The raster thread merger may be disabled if the rasterizer is being
     // created or teared down.
@@ -229,10 +369,13 @@ PostPrerollResult AndroidExternalViewEmbedder::PostPrerollAction(
     // Eventually, the frame is submitted once this method returns `kSuccess`.
     // At that point, the raster tasks are handled on the platform thread.
     CancelFrame();
-    raster_thread_merger->MergeWithLease(kDefaultMergedLeaseDuration);
+    raster_thread_merger->MergeWithLease(
+        raster_thread_merger->GetAdaptiveLeaseTerm(
+            kDefaultMergedLeaseDuration));
     return PostPrerollResult::kSkipAndRetryFrame;
   }
-  raster_thread_merger->ExtendLeaseTo(kDefaultMergedLeaseDuration);
+  raster_thread_merger->ExtendLeaseTo(
+      raster_thread_merger->GetAdaptiveLeaseTerm(kDefaultMergedLeaseDuration));
   // Surface switch requires to resubmit the frame.
   // TODO(egarciad): https://github.com/flutter/flutter/issues/65652
   if (previous_frame_view_count_ == 0) {
@@ -266,14 +409,15 @@ void AndroidExternalViewEmbedder::BeginFrame(
     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger) {
   Reset();
 
-  // The surface size changed. Therefore, destroy existing surfaces as
-  // the existing surfaces in the pool can't be recycled.
-  if (frame_size_ != frame_size) {
+  // The frame grew. Therefore, destroy existing surfaces as the existing
+  // surfaces in the pool are too small to be recycled.
+  if (!surface_pool_->CanReuseLayers(frame_size)) {
     DestroySurfaces();
   }
   surface_pool_->SetFrameSize(frame_size);
-  // JNI method must be called on the platform thread.
-  if (raster_thread_merger->IsOnPlatformThread()) {
+  // JNI method must be called on the platform thread. Without a thread
+  // merger, the platform thread begins the frame when it applies it.
+  if (raster_thread_merger && raster_thread_merger->IsOnPlatformThread()) {
     jni_facade_->FlutterViewBeginFrame();
   }
 
@@ -291,15 +435,37 @@ void AndroidExternalViewEmbedder::EndFrame(
     bool should_resubmit_frame,
     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger) {
   surface_pool_->RecycleLayers();
+  if (!merges_threads_) {
+    // The pool destroys the overlays on the platform thread.
+    surface_pool_->TrimLayers(jni_facade_);
+    return;
+  }
   // JNI method must be called on the platform thread.
-  if (raster_thread_merger->IsOnPlatformThread()) {
+  if (raster_thread_merger && raster_thread_merger->IsOnPlatformThread()) {
+    surface_pool_->TrimLayers(jni_facade_);
     jni_facade_->FlutterViewEndFrame();
   }
 }
 
 // |ExternalViewEmbedder|
 bool AndroidExternalViewEmbedder::SupportsDynamicThreadMerging() {
-  return true;
+  return merges_threads_;
+}
+
+// |ExternalViewEmbedder|
+size_t AndroidExternalViewEmbedder::GetOverlaySurfaceBytes() const {
+  return surface_pool_->GetLayerBytes();
+}
+
+// |ExternalViewEmbedder|
+size_t AndroidExternalViewEmbedder::DestroySpareOverlaySurfaces() {
+  // When the threads are merged for the frames with platform views, the JNI
+  // methods may only be called while the threads are merged.
+  if (merges_threads_ &&
+      !task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread()) {
+    return 0;
+  }
+  return surface_pool_->DestroySpareLayers(jni_facade_);
 }
 
 // |ExternalViewEmbedder|
@@ -310,11 +476,16 @@ void AndroidExternalViewEmbedder::Teardown() {
 // |ExternalViewEmbedder|
 void AndroidExternalViewEmbedder::DestroySurfaces() {
   fml::AutoResetWaitableEvent latch;
-  fml::TaskRunner::RunNowOrPostTask(task_runners_.GetPlatformTaskRunner(),
-                                    [&]() {
-                                      surface_pool_->DestroyLayers(jni_facade_);
-                                      latch.Signal();
-                                    });
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetPlatformTaskRunner(), [&]() {
+        // The pending display calls may refer to the overlays destroyed here.
+        {
+          std::scoped_lock lock(pending_commit_->mutex);
+          pending_commit_->calls.reset();
+        }
+        surface_pool_->DestroyLayers(jni_facade_);
+        latch.Signal();
+      });
   latch.Wait();
 }
 
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_PLATFORM_ANDROID_EXTERNAL_VIEW_EMBEDDER_H_
 #define FLUTTER_SHELL_PLATFORM_ANDROID_EXTERNAL_VIEW_EMBEDDER_H_
 
+#include <mutex>
+#include <optional>
 #include <unordered_map>
 
 #include "flutter/common/task_runners.h"
@@ -28,13 +30,22 @@ namespace flutter {
 /// that render above (by Z order) the Android view corresponding to
 /// |flutter::PlatformViewLayer|.
 ///
+/// By default, the raster and platform threads are merged while platform
+/// views are displayed, so that the Android views are positioned in the same
+/// task that draws the Flutter UI around them. If |merges_threads| is false,
+/// the raster thread keeps drawing the frames, including the overlay
+/// surfaces, and records where the Android views and overlays go. The
+/// platform thread then only applies the geometry of the latest frame. The
+/// views may lag the Flutter UI by a frame while they move.
+///
 class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
  public:
   AndroidExternalViewEmbedder(
       const AndroidContext& android_context,
       std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
       std::shared_ptr<AndroidSurfaceFactory> surface_factory,
-      TaskRunners task_runners);
+      TaskRunners task_runners,
+      bool merges_threads = true);
 
   // |ExternalViewEmbedder|
   void PrerollCompositeEmbeddedView(
@@ -75,6 +86,12 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
 
   bool SupportsDynamicThreadMerging() override;
 
+  // |ExternalViewEmbedder|
+  size_t GetOverlaySurfaceBytes() const override;
+
+  // |ExternalViewEmbedder|
+  size_t DestroySpareOverlaySurfaces() override;
+
   void Teardown() override;
 
   // Gets the rect based on the device pixel ratio of a platform view displayed
@@ -82,11 +99,33 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
   SkRect GetViewRect(int view_id) const;
 
  private:
+  // A call to display a platform view or an overlay surface, as recorded by
+  // the raster thread when the threads aren't merged.
+  struct DisplayCall {
+    // The id of the platform view, or of the overlay surface.
+    int64_t id;
+    bool is_overlay;
+    SkRect rect;
+    // The size of the platform view in physical pixels.
+    SkSize view_size;
+    MutatorsStack mutators;
+  };
+
+  // The display calls of the latest frame that the platform thread hasn't
+  // applied yet. Shared with the tasks that apply them.
+  struct PendingCommit {
+    std::mutex mutex;
+    std::optional<std::vector<DisplayCall>> calls;
+  };
+
   // The number of frames the rasterizer task runner will continue
   // to run on the platform thread after no platform view is rendered.
   //
   // Note: this is an arbitrary number that attempts to account for cases
   // where the platform view might be momentarily off the screen.
+  //
+  // The lease is scaled by |RasterThreadMerger::GetAdaptiveLeaseTerm| when
+  // platform views come and go often.
   static const int kDefaultMergedLeaseDuration = 10;
 
   // Provides metadata to the Android surfaces.
@@ -98,11 +137,20 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
   // Allows to create surfaces.
   const std::shared_ptr<AndroidSurfaceFactory> surface_factory_;
 
+  // The task runners.
+  const TaskRunners task_runners_;
+
   // Holds surfaces. Allows to recycle surfaces or allocate new ones.
   const std::unique_ptr<SurfacePool> surface_pool_;
 
-  // The task runners.
-  const TaskRunners task_runners_;
+  // Whether the raster and platform threads are merged while platform views
+  // are displayed.
+  const bool merges_threads_;
+
+  // The display calls of the current frame, when the threads aren't merged.
+  std::vector<DisplayCall> display_calls_;
+
+  const std::shared_ptr<PendingCommit> pending_commit_;
 
   // The size of the root canvas.
   SkISize frame_size_;
@@ -142,12 +190,49 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
   // Whether the layer tree in the current frame has platform layers.
   bool FrameHasPlatformLayers();
 
+  // Displays a platform view, or records the call to display it if the
+  // threads aren't merged.
+  void DisplayPlatformView(int64_t view_id);
+
+  // Displays an overlay surface, or records the call to display it if the
+  // threads aren't merged.
+  void DisplayOverlaySurface(int overlay_id, const SkRect& rect);
+
+  // Hands the display calls of the current frame to the platform thread,
+  // replacing the calls of a previous frame it hasn't applied yet.
+  void CommitFrame();
+
+  // Applies the pending display calls on the platform thread, between the
+  // calls that begin and end a frame.
+  static void ApplyPendingCommit(const std::shared_ptr<PendingCommit>& commit,
+                                 PlatformViewAndroidJNI& jni_facade);
+
+  // The Flutter UI drawn on a single overlay surface.
+  struct OverlayGroup {
+    // The bounds of the overlay surface, which is the union of the rects of
+    // the entries.
+    SkRect bounds = SkRect::MakeEmpty();
+
+    // The platform views whose pictures are drawn on the overlay surface, in
+    // composition order, along with the rect each picture is clipped to.
+    std::vector<std::pair<int64_t, SkRect>> entries;
+  };
+
+  // Merges the overlay layers of consecutive platform views into as few
+  // overlay surfaces as possible.
+  //
+  // The overlay of a view can be displayed above a later view as long as none
+  // of the Flutter UI it contains intersects the views in between. The groups
+  // are keyed off the id of the view they are displayed above.
+  std::unordered_map<int64_t, OverlayGroup> MergeOverlayLayers(
+      const std::unordered_map<int64_t, SkRect>& overlay_layers) const;
+
   // Creates a Surface when needed or recycles an existing one.
-  // Finally, draws the picture on the frame's canvas.
-  std::unique_ptr<SurfaceFrame> CreateSurfaceIfNeeded(GrDirectContext* context,
-                                                      int64_t view_id,
-                                                      sk_sp<SkPicture> picture,
-                                                      const SkRect& rect);
+  // Finally, draws the pictures of the group on the frame's canvas.
+  std::unique_ptr<SurfaceFrame> CreateSurfaceIfNeeded(
+      GrDirectContext* context,
+      const OverlayGroup& group,
+      const std::unordered_map<int64_t, sk_sp<SkPicture>>& pictures);
 };
 
 }  // namespace flutter
@@ -604,6 +604,104 @@ TEST(AndroidExternalViewEmbedder, SubmitFrameOverlayComposition) {
   embedder->EndFrame(/*should_resubmit_frame=*/false, raster_thread_merger);
 }
 
+TEST(AndroidExternalViewEmbedder, SubmitFrameMergesOverlays) {
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto android_context =
+      std::make_shared<AndroidContext>(AndroidRenderingAPI::kSoftware);
+
+  auto window = fml::MakeRefCounted<AndroidNativeWindow>(nullptr);
+  auto gr_context = GrDirectContext::MakeMock(nullptr);
+  auto frame_size = SkISize::Make(1000, 1000);
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  auto surface_factory = std::make_shared<TestAndroidSurfaceFactory>(
+      [&android_context, gr_context, window, frame_size, framebuffer_info]() {
+        auto surface_frame_1 = std::make_unique<SurfaceFrame>(
+            SkSurface::MakeNull(1000, 1000), framebuffer_info,
+            [](const SurfaceFrame& surface_frame, SkCanvas* canvas) {
+              return true;
+            });
+
+        auto surface_mock = std::make_unique<SurfaceMock>();
+        EXPECT_CALL(*surface_mock, AcquireFrame(frame_size))
+            .Times(1 /* frames */)
+            .WillOnce(Return(ByMove(std::move(surface_frame_1))));
+
+        auto android_surface_mock =
+            std::make_unique<AndroidSurfaceMock>(android_context);
+        EXPECT_CALL(*android_surface_mock, IsValid()).WillOnce(Return(true));
+
+        EXPECT_CALL(*android_surface_mock, CreateGPUSurface(gr_context.get()))
+            .WillOnce(Return(ByMove(std::move(surface_mock))));
+
+        EXPECT_CALL(*android_surface_mock, SetNativeWindow(window));
+        return android_surface_mock;
+      });
+  auto embedder = std::make_unique<AndroidExternalViewEmbedder>(
+      *android_context, jni_mock, surface_factory, GetTaskRunnersForFixture());
+
+  auto raster_thread_merger = GetThreadMergerFromPlatformThread();
+
+  EXPECT_CALL(*jni_mock, FlutterViewBeginFrame());
+  embedder->BeginFrame(frame_size, nullptr, 1.5, raster_thread_merger);
+
+  {
+    // Add first Android view.
+    SkMatrix matrix;
+    MutatorsStack stack;
+
+    embedder->PrerollCompositeEmbeddedView(
+        0, std::make_unique<EmbeddedViewParams>(matrix, SkSize::Make(100, 100),
+                                                stack));
+    EXPECT_CALL(*jni_mock, FlutterViewOnDisplayPlatformView(0, 0, 0, 100, 100,
+                                                            150, 150, stack));
+  }
+
+  auto rect_paint = SkPaint();
+  rect_paint.setColor(SkColors::kCyan);
+  rect_paint.setStyle(SkPaint::Style::kFill_Style);
+
+  // This simulates Flutter UI that intersects with the first Android view
+  // only.
+  embedder->CompositeEmbeddedView(0)->drawRect(SkRect::MakeXYWH(25, 25, 50, 50),
+                                               rect_paint);
+
+  {
+    // Add second Android view, next to the first one.
+    SkMatrix matrix = SkMatrix::Translate(300, 0);
+    MutatorsStack stack;
+    stack.PushTransform(SkMatrix::Translate(300, 0));
+
+    embedder->PrerollCompositeEmbeddedView(
+        1, std::make_unique<EmbeddedViewParams>(matrix, SkSize::Make(100, 100),
+                                                stack));
+    EXPECT_CALL(*jni_mock, FlutterViewOnDisplayPlatformView(1, 300, 0, 100, 100,
+                                                            150, 150, stack));
+  }
+  // This simulates Flutter UI that intersects with the second Android view
+  // only.
+  embedder->CompositeEmbeddedView(1)->drawRect(
+      SkRect::MakeXYWH(325, 25, 50, 50), rect_paint);
+
+  // Both overlays are merged into a single surface above the second view.
+  EXPECT_CALL(*jni_mock, FlutterViewCreateOverlaySurface())
+      .WillOnce(Return(
+          ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
+              0, window))));
+  EXPECT_CALL(*jni_mock, FlutterViewDisplayOverlaySurface(0, 25, 25, 350, 50))
+      .Times(1);
+
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      SkSurface::MakeNull(1000, 1000), framebuffer_info,
+      [](const SurfaceFrame& surface_frame, SkCanvas* canvas) mutable {
+        return true;
+      });
+
+  embedder->SubmitFrame(gr_context.get(), std::move(surface_frame));
+
+  EXPECT_CALL(*jni_mock, FlutterViewEndFrame());
+  embedder->EndFrame(/*should_resubmit_frame=*/false, raster_thread_merger);
+}
+
 TEST(AndroidExternalViewEmbedder, SubmitFramePlatformViewWithoutAnyOverlay) {
   auto jni_mock = std::make_shared<JNIMock>();
   auto android_context =
@@ -773,8 +871,8 @@ TEST(AndroidExternalViewEmbedder, DestroyOverlayLayersOnSizeChange) {
 
   EXPECT_CALL(*jni_mock, FlutterViewDestroyOverlaySurfaces());
   EXPECT_CALL(*jni_mock, FlutterViewBeginFrame());
-  // Change the frame size.
-  embedder->BeginFrame(SkISize::Make(30, 40), nullptr, 1.0,
+  // Grow the frame, so the overlay layers are too small to be reused.
+  embedder->BeginFrame(SkISize::Make(2000, 2000), nullptr, 1.0,
                        raster_thread_merger);
 }
 
@@ -861,7 +959,7 @@ TEST(AndroidExternalViewEmbedder, DoesNotDestroyOverlayLayersOnSizeChange) {
   EXPECT_CALL(*jni_mock, FlutterViewBeginFrame()).Times(0);
 
   fml::Thread platform_thread("platform");
-  embedder->BeginFrame(SkISize::Make(30, 40), nullptr, 1.0,
+  embedder->BeginFrame(SkISize::Make(2000, 2000), nullptr, 1.0,
                        GetThreadMergerFromRasterThread(&platform_thread));
 }
 
@@ -903,6 +1001,58 @@ TEST(AndroidExternalViewEmbedder, DisableThreadMerger) {
   ASSERT_FALSE(raster_thread_merger->IsMerged());
 }
 
+TEST(AndroidExternalViewEmbedder, UnmergedThreadsCommitFrameOnPlatformThread) {
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto android_context = AndroidContext(AndroidRenderingAPI::kSoftware);
+  auto embedder = std::make_unique<AndroidExternalViewEmbedder>(
+      android_context, jni_mock, nullptr, GetTaskRunnersForFixture(),
+      /*merges_threads=*/false);
+  ASSERT_FALSE(embedder->SupportsDynamicThreadMerging());
+
+  auto frame_size = SkISize::Make(1000, 1000);
+  MutatorsStack stack;
+  stack.PushTransform(SkMatrix::Translate(0, 0));
+
+  // The JNI methods are only called by the task that applies the frame.
+  EXPECT_CALL(*jni_mock, FlutterViewBeginFrame()).Times(0);
+  EXPECT_CALL(*jni_mock, FlutterViewOnDisplayPlatformView).Times(0);
+  EXPECT_CALL(*jni_mock, FlutterViewEndFrame()).Times(0);
+
+  // The first frame with a platform view switches surfaces, and is
+  // resubmitted.
+  embedder->BeginFrame(frame_size, nullptr, 1.5, nullptr);
+  embedder->PrerollCompositeEmbeddedView(
+      0, std::make_unique<EmbeddedViewParams>(SkMatrix(),
+                                              SkSize::Make(200, 200), stack));
+  ASSERT_EQ(PostPrerollResult::kResubmitFrame,
+            embedder->PostPrerollAction(nullptr));
+  embedder->EndFrame(/*should_resubmit_frame=*/true, nullptr);
+
+  embedder->BeginFrame(frame_size, nullptr, 1.5, nullptr);
+  embedder->PrerollCompositeEmbeddedView(
+      0, std::make_unique<EmbeddedViewParams>(SkMatrix(),
+                                              SkSize::Make(200, 200), stack));
+  ASSERT_EQ(PostPrerollResult::kSuccess, embedder->PostPrerollAction(nullptr));
+
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      SkSurface::MakeNull(1000, 1000), framebuffer_info,
+      [](const SurfaceFrame& surface_frame, SkCanvas* canvas) {
+        return true;
+      });
+  embedder->SubmitFrame(nullptr, std::move(surface_frame));
+  embedder->EndFrame(/*should_resubmit_frame=*/false, nullptr);
+
+  {
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*jni_mock, FlutterViewBeginFrame());
+    EXPECT_CALL(*jni_mock, FlutterViewOnDisplayPlatformView(
+                               0, 0, 0, 200, 200, 300, 300, stack));
+    EXPECT_CALL(*jni_mock, FlutterViewEndFrame());
+  }
+  fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
+}
+
 TEST(AndroidExternalViewEmbedder, Teardown) {
   auto jni_mock = std::make_shared<JNIMock>();
   auto android_context =
@@ -4,6 +4,11 @@
 
 #include "flutter/shell/platform/android/external_view_embedder/surface_pool.h"
 
+#include <algorithm>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/trace_event.h"
+
 namespace flutter {
 
 OverlayLayer::OverlayLayer(int id,
@@ -15,7 +20,8 @@ OverlayLayer::OverlayLayer(int id,
 
 OverlayLayer::~OverlayLayer() = default;
 
-SurfacePool::SurfacePool() = default;
+SurfacePool::SurfacePool(fml::RefPtr<fml::TaskRunner> platform_task_runner)
+    : platform_task_runner_(std::move(platform_task_runner)) {}
 
 SurfacePool::~SurfacePool() = default;
 
@@ -24,37 +30,15 @@ std::shared_ptr<OverlayLayer> SurfacePool::GetLayer(
     const AndroidContext& android_context,
     std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
     std::shared_ptr<AndroidSurfaceFactory> surface_factory) {
-  // Destroy current layers in the pool if the frame size has changed.
-  if (requested_frame_size_ != current_frame_size_) {
+  // Destroy current layers in the pool if they are too small for the frame.
+  if (!CanReuseLayers(requested_frame_size_)) {
     DestroyLayers(jni_facade);
   }
 
   intptr_t gr_context_key = reinterpret_cast<intptr_t>(gr_context);
   // Allocate a new surface if there isn't one available.
   if (available_layer_index_ >= layers_.size()) {
-    std::unique_ptr<AndroidSurface> android_surface =
-        surface_factory->CreateSurface();
-
-    FML_CHECK(android_surface && android_surface->IsValid())
-        << "Could not create an OpenGL, Vulkan or Software surface to set up "
-           "rendering.";
-
-    std::unique_ptr<PlatformViewAndroidJNI::OverlayMetadata> java_metadata =
-        jni_facade->FlutterViewCreateOverlaySurface();
-
-    FML_CHECK(java_metadata->window);
-    android_surface->SetNativeWindow(java_metadata->window);
-
-    std::unique_ptr<Surface> surface =
-        android_surface->CreateGPUSurface(gr_context);
-
-    std::shared_ptr<OverlayLayer> layer =
-        std::make_shared<OverlayLayer>(java_metadata->id,           //
-                                       std::move(android_surface),  //
-                                       std::move(surface)           //
-        );
-    layer->gr_context_key = gr_context_key;
-    layers_.push_back(layer);
+    CreateLayer(gr_context, jni_facade, surface_factory);
   }
   std::shared_ptr<OverlayLayer> layer = layers_[available_layer_index_];
   // Since the surfaces are recycled, it's possible that the GrContext is
@@ -68,21 +52,139 @@ std::shared_ptr<OverlayLayer> SurfacePool::GetLayer(
     layer->surface = std::move(surface);
   }
   available_layer_index_++;
-  current_frame_size_ = requested_frame_size_;
   return layer;
 }
 
+void SurfacePool::PreallocateLayers(
+    size_t count,
+    GrDirectContext* gr_context,
+    const AndroidContext& android_context,
+    std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
+    std::shared_ptr<AndroidSurfaceFactory> surface_factory) {
+  if (!CanReuseLayers(requested_frame_size_)) {
+    DestroyLayers(jni_facade);
+  }
+  while (layers_.size() < available_layer_index_ + count) {
+    CreateLayer(gr_context, jni_facade, surface_factory);
+  }
+}
+
+void SurfacePool::CreateLayer(
+    GrDirectContext* gr_context,
+    std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
+    std::shared_ptr<AndroidSurfaceFactory> surface_factory) {
+  TRACE_EVENT0("flutter", "SurfacePool::CreateLayer");
+  std::unique_ptr<AndroidSurface> android_surface =
+      surface_factory->CreateSurface();
+
+  FML_CHECK(android_surface && android_surface->IsValid())
+      << "Could not create an OpenGL, Vulkan or Software surface to set up "
+         "rendering.";
+
+  std::unique_ptr<PlatformViewAndroidJNI::OverlayMetadata> java_metadata;
+  RunOnPlatformThread([&]() {
+    java_metadata = jni_facade->FlutterViewCreateOverlaySurface();
+  });
+
+  FML_CHECK(java_metadata->window);
+  android_surface->SetNativeWindow(java_metadata->window);
+
+  std::unique_ptr<Surface> surface =
+      android_surface->CreateGPUSurface(gr_context);
+
+  std::shared_ptr<OverlayLayer> layer =
+      std::make_shared<OverlayLayer>(java_metadata->id,           //
+                                     std::move(android_surface),  //
+                                     std::move(surface)           //
+      );
+  layer->gr_context_key = reinterpret_cast<intptr_t>(gr_context);
+  // The layers in the pool all have the size of the frame the first of them
+  // was created for.
+  if (layers_.empty()) {
+    current_frame_size_ = requested_frame_size_;
+  }
+  layer->frame_size = current_frame_size_;
+  layers_.push_back(layer);
+  FML_TRACE_COUNTER("flutter", "SurfacePool", reinterpret_cast<int64_t>(this),
+                    "Layers", layers_.size());
+}
+
 void SurfacePool::RecycleLayers() {
+  last_used_layer_count_ = available_layer_index_;
+  max_used_layer_count_ =
+      std::max(max_used_layer_count_, available_layer_index_);
+  if (layers_.size() > max_used_layer_count_ + kMaxSpareLayers) {
+    frames_with_unneeded_layers_++;
+  } else {
+    frames_with_unneeded_layers_ = 0;
+    max_used_layer_count_ = 0;
+  }
   available_layer_index_ = 0;
 }
 
+void SurfacePool::TrimLayers(
+    std::shared_ptr<PlatformViewAndroidJNI> jni_facade) {
+  if (frames_with_unneeded_layers_ < kTrimLayersFrameCount) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "SurfacePool::TrimLayers");
+  // The layers in use are at the beginning of the pool.
+  FML_DCHECK(available_layer_index_ == 0);
+  const size_t kept_layer_count = max_used_layer_count_ + kMaxSpareLayers;
+  RunOnPlatformThread([&]() {
+    for (size_t i = kept_layer_count; i < layers_.size(); i++) {
+      jni_facade->FlutterViewDestroyOverlaySurface(layers_[i]->id);
+    }
+  });
+  layers_.resize(kept_layer_count);
+  frames_with_unneeded_layers_ = 0;
+  max_used_layer_count_ = 0;
+  FML_TRACE_COUNTER("flutter", "SurfacePool", reinterpret_cast<int64_t>(this),
+                    "Layers", layers_.size());
+}
+
+size_t SurfacePool::DestroySpareLayers(
+    std::shared_ptr<PlatformViewAndroidJNI> jni_facade) {
+  // The layers in use are at the beginning of the pool.
+  FML_DCHECK(available_layer_index_ == 0);
+  if (layers_.size() <= last_used_layer_count_) {
+    return 0;
+  }
+  TRACE_EVENT0("flutter", "SurfacePool::DestroySpareLayers");
+  const size_t bytes = GetLayerBytes();
+  RunOnPlatformThread([&]() {
+    for (size_t i = last_used_layer_count_; i < layers_.size(); i++) {
+      jni_facade->FlutterViewDestroyOverlaySurface(layers_[i]->id);
+    }
+  });
+  layers_.resize(last_used_layer_count_);
+  frames_with_unneeded_layers_ = 0;
+  max_used_layer_count_ = 0;
+  FML_TRACE_COUNTER("flutter", "SurfacePool", reinterpret_cast<int64_t>(this),
+                    "Layers", layers_.size());
+  return bytes - GetLayerBytes();
+}
+
 void SurfacePool::DestroyLayers(
     std::shared_ptr<PlatformViewAndroidJNI> jni_facade) {
   if (layers_.size() > 0) {
-    jni_facade->FlutterViewDestroyOverlaySurfaces();
+    TRACE_EVENT0("flutter", "SurfacePool::DestroyLayers");
+    RunOnPlatformThread(
+        [&jni_facade]() { jni_facade->FlutterViewDestroyOverlaySurfaces(); });
+    FML_TRACE_COUNTER("flutter", "SurfacePool",
+                      reinterpret_cast<int64_t>(this), "Layers", 0);
   }
   layers_.clear();
   available_layer_index_ = 0;
+  last_used_layer_count_ = 0;
+  frames_with_unneeded_layers_ = 0;
+  max_used_layer_count_ = 0;
+}
+
+bool SurfacePool::CanReuseLayers(SkISize frame_size) const {
+  return layers_.empty() ||
+         (frame_size.width() <= current_frame_size_.width() &&
+          frame_size.height() <= current_frame_size_.height());
 }
 
 std::vector<std::shared_ptr<OverlayLayer>> SurfacePool::GetUnusedLayers() {
@@ -97,4 +199,27 @@ void SurfacePool::SetFrameSize(SkISize frame_size) {
   requested_frame_size_ = frame_size;
 }
 
+void SurfacePool::RunOnPlatformThread(const fml::closure& closure) const {
+  if (!platform_task_runner_ ||
+      platform_task_runner_->RunsTasksOnCurrentThread()) {
+    closure();
+    return;
+  }
+  fml::AutoResetWaitableEvent latch;
+  platform_task_runner_->PostTask([&closure, &latch]() {
+    closure();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+size_t SurfacePool::GetLayerBytes() const {
+  size_t bytes = 0;
+  for (const auto& layer : layers_) {
+    bytes += static_cast<size_t>(layer->frame_size.width()) *
+             layer->frame_size.height() * 4;
+  }
+  return bytes;
+}
+
 }  // namespace flutter
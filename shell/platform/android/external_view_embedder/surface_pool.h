@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_PLATFORM_ANDROID_EXTERNAL_VIEW_EMBEDDER_SURFACE_POOL_H_
 
 #include "flutter/flow/surface.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/shell/platform/android/context/android_context.h"
 #include "flutter/shell/platform/android/surface/android_surface.h"
 
@@ -39,12 +40,31 @@ struct OverlayLayer {
   //
   // This may change when the overlay is recycled.
   intptr_t gr_context_key;
+
+  // The size of the surface, which is the frame size when the overlay was
+  // created. The overlay is reused for smaller frames.
+  SkISize frame_size;
 };
 
 // This class isn't thread safe.
+//
+// The Java calls that create and destroy the overlays are made on the
+// platform thread. If the pool is used on another thread, then it waits for
+// the calls to run on |platform_task_runner|.
 class SurfacePool {
  public:
-  SurfacePool();
+  // The number of layers that the pool keeps beyond the most layers used by a
+  // frame recently.
+  static constexpr size_t kMaxSpareLayers = 2;
+
+  // The number of frames in a row that must use fewer layers than the pool
+  // keeps before the pool destroys the layers it doesn't need. Scrolling the
+  // platform views in and out of the screen doesn't keep creating and
+  // destroying their overlays.
+  static constexpr int kTrimLayersFrameCount = 120;
+
+  explicit SurfacePool(
+      fml::RefPtr<fml::TaskRunner> platform_task_runner = nullptr);
 
   ~SurfacePool();
 
@@ -57,6 +77,16 @@ class SurfacePool {
       std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
       std::shared_ptr<AndroidSurfaceFactory> surface_factory);
 
+  // Allocates the layers that are missing for the next |count| calls to
+  // |GetLayer|, so that the overlays of a frame are created at once, before
+  // any of them is drawn.
+  void PreallocateLayers(
+      size_t count,
+      GrDirectContext* gr_context,
+      const AndroidContext& android_context,
+      std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
+      std::shared_ptr<AndroidSurfaceFactory> surface_factory);
+
   // Gets the layers in the pool that aren't currently used.
   // This method doesn't mark the layers as unused.
   std::vector<std::shared_ptr<OverlayLayer>> GetUnusedLayers();
@@ -64,14 +94,32 @@ class SurfacePool {
   // Marks the layers in the pool as available for reuse.
   void RecycleLayers();
 
+  // Destroys the layers that the last |kTrimLayersFrameCount| frames didn't
+  // need, except for |kMaxSpareLayers| of them.
+  void TrimLayers(std::shared_ptr<PlatformViewAndroidJNI> jni_facade);
+
+  // Destroys the layers that the last frame didn't use, including the spare
+  // ones, for example under memory pressure. Returns the estimated memory of
+  // their surfaces.
+  size_t DestroySpareLayers(
+      std::shared_ptr<PlatformViewAndroidJNI> jni_facade);
+
   // Destroys all the layers in the pool.
   void DestroyLayers(std::shared_ptr<PlatformViewAndroidJNI> jni_facade);
 
+  // Whether the layers in the pool can be used by frames of |frame_size|,
+  // which is the case if they are at least as large.
+  bool CanReuseLayers(SkISize frame_size) const;
+
   // Sets the frame size used by the layers in the pool.
-  // If the current layers in the pool have a different frame size,
+  // If the current layers in the pool are smaller than the frame size,
   // then they are deallocated as soon as |GetLayer| is called.
   void SetFrameSize(SkISize frame_size);
 
+  // The estimated memory of the surfaces of all of the layers in the pool,
+  // used or not, at 4 bytes per pixel.
+  size_t GetLayerBytes() const;
+
  private:
   // The index of the entry in the layers_ vector that determines the beginning
   // of the unused layers. For example, consider the following vector:
@@ -90,11 +138,32 @@ class SurfacePool {
   // The layers in the pool.
   std::vector<std::shared_ptr<OverlayLayer>> layers_;
 
+  // The most layers used by a frame since the pool last had just enough.
+  size_t max_used_layer_count_ = 0;
+
+  // The number of layers used by the last frame.
+  size_t last_used_layer_count_ = 0;
+
+  // The number of frames in a row that used fewer layers than the pool keeps.
+  int frames_with_unneeded_layers_ = 0;
+
   // The frame size of the layers in the pool.
   SkISize current_frame_size_;
 
   // The frame size to be used by future layers.
   SkISize requested_frame_size_;
+
+  // The task runner of the platform thread, or null if the pool is only used
+  // on the platform thread.
+  const fml::RefPtr<fml::TaskRunner> platform_task_runner_;
+
+  // Runs |closure| on the platform thread, and waits for it to complete.
+  void RunOnPlatformThread(const fml::closure& closure) const;
+
+  // Creates a layer, and adds it to the end of the pool.
+  void CreateLayer(GrDirectContext* gr_context,
+                   std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
+                   std::shared_ptr<AndroidSurfaceFactory> surface_factory);
 };
 
 }  // namespace flutter
@@ -260,5 +260,201 @@ TEST(SurfacePool, DestroyLayersFrameSizeChanged) {
   ASSERT_TRUE(pool->GetUnusedLayers().empty());
 }
 
+TEST(SurfacePool, DoesNotDestroyLayersWhenFrameShrinks) {
+  auto pool = std::make_unique<SurfacePool>();
+  auto jni_mock = std::make_shared<JNIMock>();
+
+  auto gr_context = GrDirectContext::MakeMock(nullptr);
+  auto android_context =
+      std::make_shared<AndroidContext>(AndroidRenderingAPI::kSoftware);
+
+  auto window = fml::MakeRefCounted<AndroidNativeWindow>(nullptr);
+
+  auto surface_factory = std::make_shared<TestAndroidSurfaceFactory>(
+      [&android_context, gr_context, window]() {
+        auto android_surface_mock =
+            std::make_unique<AndroidSurfaceMock>(android_context);
+        EXPECT_CALL(*android_surface_mock, CreateGPUSurface(gr_context.get()));
+        EXPECT_CALL(*android_surface_mock, SetNativeWindow(window));
+        EXPECT_CALL(*android_surface_mock, IsValid()).WillOnce(Return(true));
+        return android_surface_mock;
+      });
+  pool->SetFrameSize(SkISize::Make(20, 20));
+  EXPECT_CALL(*jni_mock, FlutterViewDestroyOverlaySurfaces()).Times(0);
+  EXPECT_CALL(*jni_mock, FlutterViewCreateOverlaySurface())
+      .Times(1)
+      .WillOnce(Return(
+          ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
+              0, window))));
+
+  auto layer_1 = pool->GetLayer(gr_context.get(), *android_context, jni_mock,
+                                surface_factory);
+  pool->RecycleLayers();
+
+  pool->SetFrameSize(SkISize::Make(10, 15));
+  ASSERT_TRUE(pool->CanReuseLayers(SkISize::Make(10, 15)));
+  auto layer_2 = pool->GetLayer(gr_context.get(), *android_context, jni_mock,
+                                surface_factory);
+
+  ASSERT_EQ(layer_1, layer_2);
+  ASSERT_EQ(SkISize::Make(20, 20), layer_2->frame_size);
+  ASSERT_EQ(pool->GetLayerBytes(), 20u * 20u * 4u);
+}
+
+TEST(SurfacePool, PreallocateLayers) {
+  auto pool = std::make_unique<SurfacePool>();
+  auto jni_mock = std::make_shared<JNIMock>();
+
+  auto gr_context = GrDirectContext::MakeMock(nullptr);
+  auto android_context =
+      std::make_shared<AndroidContext>(AndroidRenderingAPI::kSoftware);
+
+  auto window = fml::MakeRefCounted<AndroidNativeWindow>(nullptr);
+
+  auto surface_factory = std::make_shared<TestAndroidSurfaceFactory>(
+      [&android_context, gr_context, window]() {
+        auto android_surface_mock =
+            std::make_unique<AndroidSurfaceMock>(android_context);
+        EXPECT_CALL(*android_surface_mock, CreateGPUSurface(gr_context.get()));
+        EXPECT_CALL(*android_surface_mock, SetNativeWindow(window));
+        EXPECT_CALL(*android_surface_mock, IsValid()).WillOnce(Return(true));
+        return android_surface_mock;
+      });
+  EXPECT_CALL(*jni_mock, FlutterViewCreateOverlaySurface())
+      .Times(2)
+      .WillOnce(Return(
+          ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
+              0, window))))
+      .WillOnce(Return(
+          ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
+              1, window))));
+
+  pool->PreallocateLayers(2, gr_context.get(), *android_context, jni_mock,
+                          surface_factory);
+  // The layers are already allocated.
+  pool->PreallocateLayers(2, gr_context.get(), *android_context, jni_mock,
+                          surface_factory);
+
+  auto layer_1 = pool->GetLayer(gr_context.get(), *android_context, jni_mock,
+                                surface_factory);
+  auto layer_2 = pool->GetLayer(gr_context.get(), *android_context, jni_mock,
+                                surface_factory);
+  ASSERT_EQ(0, layer_1->id);
+  ASSERT_EQ(1, layer_2->id);
+}
+
+TEST(SurfacePool, TrimLayersUnusedForManyFrames) {
+  auto pool = std::make_unique<SurfacePool>();
+  auto jni_mock = std::make_shared<JNIMock>();
+
+  auto gr_context = GrDirectContext::MakeMock(nullptr);
+  auto android_context =
+      std::make_shared<AndroidContext>(AndroidRenderingAPI::kSoftware);
+
+  auto window = fml::MakeRefCounted<AndroidNativeWindow>(nullptr);
+
+  auto surface_factory = std::make_shared<TestAndroidSurfaceFactory>(
+      [&android_context, gr_context, window]() {
+        auto android_surface_mock =
+            std::make_unique<AndroidSurfaceMock>(android_context);
+        EXPECT_CALL(*android_surface_mock, CreateGPUSurface(gr_context.get()));
+        EXPECT_CALL(*android_surface_mock, SetNativeWindow(window));
+        EXPECT_CALL(*android_surface_mock, IsValid()).WillOnce(Return(true));
+        return android_surface_mock;
+      });
+  EXPECT_CALL(*jni_mock, FlutterViewCreateOverlaySurface())
+      .Times(4)
+      .WillOnce(Return(
+          ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
+              0, window))))
+      .WillOnce(Return(
+          ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
+              1, window))))
+      .WillOnce(Return(
+          ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
+              2, window))))
+      .WillOnce(Return(
+          ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
+              3, window))));
+
+  // A frame uses four layers.
+  pool->PreallocateLayers(4, gr_context.get(), *android_context, jni_mock,
+                          surface_factory);
+  for (int i = 0; i < 4; i++) {
+    pool->GetLayer(gr_context.get(), *android_context, jni_mock,
+                   surface_factory);
+  }
+  pool->RecycleLayers();
+  pool->TrimLayers(jni_mock);
+
+  // The following frames use a single layer, so one layer beyond the spare
+  // ones isn't needed anymore.
+  EXPECT_CALL(*jni_mock, FlutterViewDestroyOverlaySurface(::testing::_))
+      .Times(0);
+  for (int frame = 1; frame < SurfacePool::kTrimLayersFrameCount; frame++) {
+    pool->GetLayer(gr_context.get(), *android_context, jni_mock,
+                   surface_factory);
+    pool->RecycleLayers();
+    pool->TrimLayers(jni_mock);
+  }
+  ::testing::Mock::VerifyAndClearExpectations(jni_mock.get());
+
+  EXPECT_CALL(*jni_mock, FlutterViewDestroyOverlaySurface(3));
+  pool->GetLayer(gr_context.get(), *android_context, jni_mock,
+                 surface_factory);
+  pool->RecycleLayers();
+  pool->TrimLayers(jni_mock);
+
+  // The used layer and the spare ones are kept.
+  ASSERT_EQ(1 + SurfacePool::kMaxSpareLayers, pool->GetUnusedLayers().size());
+}
+
+TEST(SurfacePool, DestroySpareLayersKeepsTheLayersOfTheLastFrame) {
+  auto pool = std::make_unique<SurfacePool>();
+  auto jni_mock = std::make_shared<JNIMock>();
+
+  auto gr_context = GrDirectContext::MakeMock(nullptr);
+  auto android_context =
+      std::make_shared<AndroidContext>(AndroidRenderingAPI::kSoftware);
+
+  auto window = fml::MakeRefCounted<AndroidNativeWindow>(nullptr);
+
+  auto surface_factory = std::make_shared<TestAndroidSurfaceFactory>(
+      [&android_context, gr_context, window]() {
+        auto android_surface_mock =
+            std::make_unique<AndroidSurfaceMock>(android_context);
+        EXPECT_CALL(*android_surface_mock, CreateGPUSurface(gr_context.get()));
+        EXPECT_CALL(*android_surface_mock, SetNativeWindow(window));
+        EXPECT_CALL(*android_surface_mock, IsValid()).WillOnce(Return(true));
+        return android_surface_mock;
+      });
+  EXPECT_CALL(*jni_mock, FlutterViewCreateOverlaySurface())
+      .Times(2)
+      .WillOnce(Return(
+          ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
+              0, window))))
+      .WillOnce(Return(
+          ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
+              1, window))));
+
+  // A frame uses two layers, and the next one uses a single layer.
+  for (int i = 0; i < 2; i++) {
+    pool->GetLayer(gr_context.get(), *android_context, jni_mock,
+                   surface_factory);
+  }
+  pool->RecycleLayers();
+  pool->GetLayer(gr_context.get(), *android_context, jni_mock,
+                 surface_factory);
+  pool->RecycleLayers();
+
+  EXPECT_CALL(*jni_mock, FlutterViewDestroyOverlaySurface(1));
+  pool->DestroySpareLayers(jni_mock);
+  ASSERT_EQ(1u, pool->GetUnusedLayers().size());
+
+  EXPECT_CALL(*jni_mock, FlutterViewDestroyOverlaySurface(::testing::_))
+      .Times(0);
+  pool->DestroySpareLayers(jni_mock);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -830,7 +830,14 @@ import java.util.Arrays;
       // an overly aggressive GC.
       boolean trim = isFirstFrameRendered && level >= TRIM_MEMORY_RUNNING_LOW;
       if (trim) {
-        flutterEngine.getDartExecutor().notifyLowMemoryWarning();
+        // Only trim the caches of the engine down to its memory target while the
+        // application is still running with little memory left, so that the next
+        // frames have little to rebuild.
+        if (level >= TRIM_MEMORY_RUNNING_CRITICAL) {
+          flutterEngine.getDartExecutor().notifyLowMemoryWarning();
+        } else {
+          flutterEngine.getDartExecutor().notifyModerateMemoryPressure();
+        }
         flutterEngine.getSystemChannel().sendMemoryPressureWarning();
       }
     }
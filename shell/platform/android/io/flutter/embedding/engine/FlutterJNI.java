@@ -1092,6 +1092,96 @@ public class FlutterJNI {
   // Send a data-carrying response to a platform message received from Dart.
   private native void nativeInvokePlatformMessageResponseCallback(
       long nativeShellHolderId, int responseId, @Nullable ByteBuffer message, int position);
+
+  /**
+   * Allocates a direct {@link ByteBuffer} in native memory, which {@link
+   * #dispatchPlatformMessageBuffer(String, ByteBuffer, int, int)} and {@link
+   * #invokePlatformMessageResponseCallbackBuffer(int, ByteBuffer, int)} hand over to Flutter
+   * without copying it.
+   *
+   * <p>The buffer must be passed to one of these methods, or released with {@link
+   * #releaseMessageBuffer(ByteBuffer)}, exactly once. It must not be accessed afterwards.
+   *
+   * <p>This can be called on any thread.
+   *
+   * @return the buffer, or null if the memory couldn't be allocated.
+   */
+  @Nullable
+  public ByteBuffer allocateMessageBuffer(int capacity) {
+    // This doesn't rely on being attached like other methods.
+    return nativeAllocateMessageBuffer(capacity);
+  }
+
+  private native ByteBuffer nativeAllocateMessageBuffer(int capacity);
+
+  /**
+   * Releases a buffer allocated by {@link #allocateMessageBuffer(int)} that wasn't handed over to
+   * Flutter.
+   *
+   * <p>This can be called on any thread.
+   */
+  public void releaseMessageBuffer(@NonNull ByteBuffer buffer) {
+    // This doesn't rely on being attached like other methods.
+    nativeReleaseMessageBuffer(buffer);
+  }
+
+  private native void nativeReleaseMessageBuffer(@NonNull ByteBuffer buffer);
+
+  /**
+   * Sends a {@code message} allocated by {@link #allocateMessageBuffer(int)} from Android to
+   * Flutter over the given {@code channel}. Flutter takes ownership of the buffer.
+   */
+  @UiThread
+  public void dispatchPlatformMessageBuffer(
+      @NonNull String channel, @NonNull ByteBuffer message, int position, int responseId) {
+    ensureRunningOnMainThread();
+    if (isAttached()) {
+      nativeDispatchPlatformMessageBuffer(
+          nativeShellHolderId, channel, message, position, responseId);
+    } else {
+      nativeReleaseMessageBuffer(message);
+      Log.w(
+          TAG,
+          "Tried to send a platform message to Flutter, but FlutterJNI was detached from native C++. Could not send. Channel: "
+              + channel
+              + ". Response ID: "
+              + responseId);
+    }
+  }
+
+  private native void nativeDispatchPlatformMessageBuffer(
+      long nativeShellHolderId,
+      @NonNull String channel,
+      @NonNull ByteBuffer message,
+      int position,
+      int responseId);
+
+  /**
+   * Responds with a {@code message} allocated by {@link #allocateMessageBuffer(int)} to a platform
+   * message received from Dart. Flutter takes ownership of the buffer.
+   */
+  public void invokePlatformMessageResponseCallbackBuffer(
+      int responseId, @NonNull ByteBuffer message, int position) {
+    // Called on any thread.
+    shellHolderLock.readLock().lock();
+    try {
+      if (isAttached()) {
+        nativeInvokePlatformMessageResponseCallbackBuffer(
+            nativeShellHolderId, responseId, message, position);
+      } else {
+        nativeReleaseMessageBuffer(message);
+        Log.w(
+            TAG,
+            "Tried to send a platform message response, but FlutterJNI was detached from native C++. Could not send. Response ID: "
+                + responseId);
+      }
+    } finally {
+      shellHolderLock.readLock().unlock();
+    }
+  }
+
+  private native void nativeInvokePlatformMessageResponseCallbackBuffer(
+      long nativeShellHolderId, int responseId, @NonNull ByteBuffer message, int position);
   // ------- End Platform Message Support ----
 
   // ----- Start Engine Lifecycle Support ----
@@ -1178,6 +1268,17 @@ public class FlutterJNI {
     }
     platformViewsController.destroyOverlaySurfaces();
   }
+
+  @SuppressWarnings("unused")
+  @UiThread
+  public void destroyOverlaySurface(int id) {
+    ensureRunningOnMainThread();
+    if (platformViewsController == null) {
+      throw new RuntimeException(
+          "platformViewsController must be set before attempting to destroy an overlay surface");
+    }
+    platformViewsController.destroyOverlaySurface(id);
+  }
   // ----- End Engine Lifecycle Support ----
 
   // ----- Start Localization Support ----
@@ -1398,6 +1499,19 @@ public class FlutterJNI {
 
   private native void nativeNotifyLowMemoryWarning(long nativeShellHolderId);
 
+  /**
+   * Notifies the engine that the system is running low on memory while the application is still
+   * running. The engine trims its caches down to its memory target.
+   */
+  @UiThread
+  public void notifyModerateMemoryPressure() {
+    ensureRunningOnMainThread();
+    ensureAttachedToNative();
+    nativeNotifyModerateMemoryPressure(nativeShellHolderId);
+  }
+
+  private native void nativeNotifyModerateMemoryPressure(long nativeShellHolderId);
+
   private void ensureRunningOnMainThread() {
     if (Looper.myLooper() != mainLooper) {
       throw new RuntimeException(
@@ -34,6 +34,12 @@ public class FlutterShellArgs {
   public static final String ARG_ENABLE_DART_PROFILING = "--enable-dart-profiling";
   public static final String ARG_KEY_ENABLE_SOFTWARE_RENDERING = "enable-software-rendering";
   public static final String ARG_ENABLE_SOFTWARE_RENDERING = "--enable-software-rendering";
+  public static final String ARG_KEY_ENABLE_VULKAN_RENDERING = "enable-vulkan-rendering";
+  public static final String ARG_ENABLE_VULKAN_RENDERING = "--enable-vulkan-rendering";
+  public static final String ARG_KEY_DROP_STALE_TEXTURE_FRAMES = "drop-stale-texture-frames";
+  public static final String ARG_DROP_STALE_TEXTURE_FRAMES = "--drop-stale-texture-frames";
+  public static final String ARG_KEY_UNMERGED_PLATFORM_VIEWS = "unmerged-platform-views";
+  public static final String ARG_UNMERGED_PLATFORM_VIEWS = "--unmerged-platform-views";
   public static final String ARG_KEY_SKIA_DETERMINISTIC_RENDERING = "skia-deterministic-rendering";
   public static final String ARG_SKIA_DETERMINISTIC_RENDERING = "--skia-deterministic-rendering";
   public static final String ARG_KEY_TRACE_SKIA = "trace-skia";
@@ -91,6 +97,15 @@ public class FlutterShellArgs {
     if (intent.getBooleanExtra(ARG_KEY_ENABLE_SOFTWARE_RENDERING, false)) {
       args.add(ARG_ENABLE_SOFTWARE_RENDERING);
     }
+    if (intent.getBooleanExtra(ARG_KEY_ENABLE_VULKAN_RENDERING, false)) {
+      args.add(ARG_ENABLE_VULKAN_RENDERING);
+    }
+    if (intent.getBooleanExtra(ARG_KEY_DROP_STALE_TEXTURE_FRAMES, false)) {
+      args.add(ARG_DROP_STALE_TEXTURE_FRAMES);
+    }
+    if (intent.getBooleanExtra(ARG_KEY_UNMERGED_PLATFORM_VIEWS, false)) {
+      args.add(ARG_UNMERGED_PLATFORM_VIEWS);
+    }
     if (intent.getBooleanExtra(ARG_KEY_SKIA_DETERMINISTIC_RENDERING, false)) {
       args.add(ARG_SKIA_DETERMINISTIC_RENDERING);
     }
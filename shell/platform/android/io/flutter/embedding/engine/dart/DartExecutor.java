@@ -320,6 +320,18 @@ public class DartExecutor implements BinaryMessenger {
     }
   }
 
+  /**
+   * Notify the engine that the system is running low on memory while the application is still
+   * running, so that it trims its caches down to its memory target instead of emptying them.
+   *
+   * <p>Unlike {@link #notifyLowMemoryWarning()}, this does not ask the Dart VM to collect garbage.
+   */
+  public void notifyModerateMemoryPressure() {
+    if (flutterJNI.isAttached()) {
+      flutterJNI.notifyModerateMemoryPressure();
+    }
+  }
+
   /**
    * Configuration options that specify which Dart entrypoint function is executed and where to find
    * that entrypoint and other assets required for Dart execution.
@@ -984,6 +984,24 @@ public class PlatformViewsController implements PlatformViewsAccessibilityDelega
     }
   }
 
+  /**
+   * Destroys the overlay surface with the given id and removes it from the view hierarchy.
+   *
+   * <p>This method is used only internally by {@code FlutterJNI}.
+   */
+  public void destroyOverlaySurface(int id) {
+    final FlutterImageView overlayView = overlayLayerViews.get(id);
+    if (overlayView == null) {
+      return;
+    }
+    overlayView.detachFromRenderer();
+    overlayView.closeImageReader();
+    if (flutterView != null) {
+      flutterView.removeView(overlayView);
+    }
+    overlayLayerViews.remove(id);
+  }
+
   private void removeOverlaySurfaces() {
     if (flutterView == null) {
       Log.e(TAG, "removeOverlaySurfaces called while flutter view is null");
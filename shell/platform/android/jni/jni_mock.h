@@ -92,6 +92,11 @@ class JNIMock final : public PlatformViewAndroidJNI {
 
   MOCK_METHOD(void, FlutterViewDestroyOverlaySurfaces, (), (override));
 
+  MOCK_METHOD(void,
+              FlutterViewDestroyOverlaySurface,
+              (int surface_id),
+              (override));
+
   MOCK_METHOD(std::unique_ptr<std::vector<std::string>>,
               FlutterViewComputePlatformResolvedLocale,
               (std::vector<std::string> supported_locales_data),
@@ -186,6 +186,14 @@ class PlatformViewAndroidJNI {
   ///
   virtual void FlutterViewDestroyOverlaySurfaces() = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Destroys the overlay surface with the given id and removes it
+  ///             from the view hierarchy.
+  ///
+  /// @note       Must be called from the platform thread.
+  ///
+  virtual void FlutterViewDestroyOverlaySurface(int surface_id) = 0;
+
   //----------------------------------------------------------------------------
   /// @brief      Computes the locale Android would select.
   ///
@@ -14,6 +14,7 @@
 #include "flutter/shell/platform/android/android_external_texture_gl.h"
 #include "flutter/shell/platform/android/android_surface_gl.h"
 #include "flutter/shell/platform/android/android_surface_software.h"
+#include "flutter/shell/platform/android/android_surface_vulkan.h"
 #include "flutter/shell/platform/android/context/android_context.h"
 #include "flutter/shell/platform/android/external_view_embedder/external_view_embedder.h"
 #include "flutter/shell/platform/android/jni/platform_view_android_jni.h"
@@ -38,6 +39,9 @@ std::unique_ptr<AndroidSurface> AndroidSurfaceFactoryImpl::CreateSurface() {
                                                       jni_facade_);
     case AndroidRenderingAPI::kOpenGLES:
       return std::make_unique<AndroidSurfaceGL>(android_context_, jni_facade_);
+    case AndroidRenderingAPI::kVulkan:
+      return std::make_unique<AndroidSurfaceVulkan>(android_context_,
+                                                    jni_facade_);
     default:
       FML_DCHECK(false);
       return nullptr;
@@ -46,10 +50,18 @@ std::unique_ptr<AndroidSurface> AndroidSurfaceFactoryImpl::CreateSurface() {
 
 static std::shared_ptr<flutter::AndroidContext> CreateAndroidContext(
     bool use_software_rendering,
+    bool use_vulkan_rendering,
     const flutter::TaskRunners task_runners) {
   if (use_software_rendering) {
     return std::make_shared<AndroidContext>(AndroidRenderingAPI::kSoftware);
   }
+  if (use_vulkan_rendering) {
+    if (AndroidSurfaceVulkan::IsSupported()) {
+      return std::make_shared<AndroidContext>(AndroidRenderingAPI::kVulkan);
+    }
+    FML_LOG(INFO) << "Vulkan isn't supported by this device. Falling back to "
+                     "OpenGL ES.";
+  }
   return std::make_unique<AndroidContextGL>(
       AndroidRenderingAPI::kOpenGLES,
       fml::MakeRefCounted<AndroidEnvironmentGL>(), task_runners);
@@ -59,21 +71,31 @@ PlatformViewAndroid::PlatformViewAndroid(
     PlatformView::Delegate& delegate,
     flutter::TaskRunners task_runners,
     std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
-    bool use_software_rendering)
-    : PlatformViewAndroid(
-          delegate,
-          std::move(task_runners),
-          std::move(jni_facade),
-          CreateAndroidContext(use_software_rendering, task_runners)) {}
+    bool use_software_rendering,
+    bool use_vulkan_rendering,
+    bool drop_stale_texture_frames,
+    bool unmerged_platform_views)
+    : PlatformViewAndroid(delegate,
+                          std::move(task_runners),
+                          std::move(jni_facade),
+                          CreateAndroidContext(use_software_rendering,
+                                               use_vulkan_rendering,
+                                               task_runners),
+                          drop_stale_texture_frames,
+                          unmerged_platform_views) {}
 
 PlatformViewAndroid::PlatformViewAndroid(
     PlatformView::Delegate& delegate,
     flutter::TaskRunners task_runners,
     const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade,
-    const std::shared_ptr<flutter::AndroidContext>& android_context)
+    const std::shared_ptr<flutter::AndroidContext>& android_context,
+    bool drop_stale_texture_frames,
+    bool unmerged_platform_views)
     : PlatformView(delegate, std::move(task_runners)),
       jni_facade_(jni_facade),
       android_context_(std::move(android_context)),
+      drop_stale_texture_frames_(drop_stale_texture_frames),
+      unmerged_platform_views_(unmerged_platform_views),
       platform_view_android_delegate_(jni_facade),
       platform_message_handler_(new PlatformMessageHandlerAndroid(jni_facade)) {
   if (android_context_) {
@@ -162,9 +184,15 @@ void PlatformViewAndroid::DispatchPlatformMessage(JNIEnv* env,
                                                   jint response_id) {
   uint8_t* message_data =
       static_cast<uint8_t*>(env->GetDirectBufferAddress(java_message_data));
-  fml::MallocMapping message =
-      fml::MallocMapping::Copy(message_data, java_message_position);
+  DispatchPlatformMessage(
+      std::move(name),
+      fml::MallocMapping::CopyPooled(message_data, java_message_position),
+      response_id);
+}
 
+void PlatformViewAndroid::DispatchPlatformMessage(std::string name,
+                                                  fml::MallocMapping message,
+                                                  jint response_id) {
   fml::RefPtr<flutter::PlatformMessageResponse> response;
   if (response_id) {
     response = fml::MakeRefCounted<PlatformMessageResponseAndroid>(
@@ -232,8 +260,14 @@ void PlatformViewAndroid::UpdateSemantics(
 void PlatformViewAndroid::RegisterExternalTexture(
     int64_t texture_id,
     const fml::jni::ScopedJavaGlobalRef<jobject>& surface_texture) {
+  if (android_context_->RenderingApi() != AndroidRenderingAPI::kOpenGLES) {
+    // The surface textures are attached to a GL context when they are drawn.
+    FML_LOG(ERROR) << "External textures require OpenGL ES rendering.";
+    return;
+  }
   RegisterTexture(std::make_shared<AndroidExternalTextureGL>(
-      texture_id, surface_texture, std::move(jni_facade_)));
+      texture_id, surface_texture, std::move(jni_facade_),
+      drop_stale_texture_frames_));
 }
 
 // |PlatformView|
@@ -254,7 +288,8 @@ std::unique_ptr<Surface> PlatformViewAndroid::CreateRenderingSurface() {
 std::shared_ptr<ExternalViewEmbedder>
 PlatformViewAndroid::CreateExternalViewEmbedder() {
   return std::make_shared<AndroidExternalViewEmbedder>(
-      *android_context_, jni_facade_, surface_factory_, task_runners_);
+      *android_context_, jni_facade_, surface_factory_, task_runners_,
+      /*merges_threads=*/!unmerged_platform_views_);
 }
 
 // |PlatformView|
@@ -45,7 +45,10 @@ class PlatformViewAndroid final : public PlatformView {
   PlatformViewAndroid(PlatformView::Delegate& delegate,
                       flutter::TaskRunners task_runners,
                       std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
-                      bool use_software_rendering);
+                      bool use_software_rendering,
+                      bool use_vulkan_rendering,
+                      bool drop_stale_texture_frames = false,
+                      bool unmerged_platform_views = false);
 
   //----------------------------------------------------------------------------
   /// @brief      Creates a new PlatformViewAndroid but using an existing
@@ -56,7 +59,9 @@ class PlatformViewAndroid final : public PlatformView {
       PlatformView::Delegate& delegate,
       flutter::TaskRunners task_runners,
       const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade,
-      const std::shared_ptr<flutter::AndroidContext>& android_context);
+      const std::shared_ptr<flutter::AndroidContext>& android_context,
+      bool drop_stale_texture_frames = false,
+      bool unmerged_platform_views = false);
 
   ~PlatformViewAndroid() override;
 
@@ -76,6 +81,11 @@ class PlatformViewAndroid final : public PlatformView {
                                jint message_position,
                                jint response_id);
 
+  // Dispatches a message whose data is adopted rather than copied.
+  void DispatchPlatformMessage(std::string name,
+                               fml::MallocMapping message,
+                               jint response_id);
+
   void DispatchEmptyPlatformMessage(JNIEnv* env,
                                     std::string name,
                                     jint response_id);
@@ -117,6 +127,8 @@ class PlatformViewAndroid final : public PlatformView {
  private:
   const std::shared_ptr<PlatformViewAndroidJNI> jni_facade_;
   std::shared_ptr<AndroidContext> android_context_;
+  const bool drop_stale_texture_frames_;
+  const bool unmerged_platform_views_;
   std::shared_ptr<AndroidSurfaceFactoryImpl> surface_factory_;
 
   PlatformViewAndroidDelegate platform_view_android_delegate_;
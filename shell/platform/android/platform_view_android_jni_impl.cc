@@ -86,6 +86,8 @@ static jmethodID g_create_overlay_surface_method = nullptr;
 
 static jmethodID g_destroy_overlay_surfaces_method = nullptr;
 
+static jmethodID g_destroy_overlay_surface_method = nullptr;
+
 static jmethodID g_on_begin_frame_method = nullptr;
 
 static jmethodID g_on_end_frame_method = nullptr;
@@ -422,6 +424,43 @@ static void DispatchPlatformMessage(JNIEnv* env,
   );
 }
 
+static jobject AllocateMessageBuffer(JNIEnv* env,
+                                     jobject jcaller,
+                                     jint capacity) {
+  // Called from any thread.
+  void* data = malloc(capacity);
+  if (data == nullptr) {
+    return nullptr;
+  }
+  return env->NewDirectByteBuffer(data, capacity);
+}
+
+static void ReleaseMessageBuffer(JNIEnv* env,
+                                 jobject jcaller,
+                                 jobject message) {
+  // Called from any thread.
+  free(env->GetDirectBufferAddress(message));
+}
+
+static void DispatchPlatformMessageBuffer(JNIEnv* env,
+                                          jobject jcaller,
+                                          jlong shell_holder,
+                                          jstring channel,
+                                          jobject message,
+                                          jint position,
+                                          jint responseId) {
+  uint8_t* message_data =
+      static_cast<uint8_t*>(env->GetDirectBufferAddress(message));
+  FML_DCHECK(message_data != nullptr);
+  // The buffer was allocated by AllocateMessageBuffer, the message takes
+  // ownership of it.
+  ANDROID_SHELL_HOLDER->GetPlatformView()->DispatchPlatformMessage(
+      fml::jni::JavaStringToString(env, channel),  //
+      fml::MallocMapping(message_data, position),  //
+      responseId                                   //
+  );
+}
+
 static void DispatchEmptyPlatformMessage(JNIEnv* env,
                                          jobject jcaller,
                                          jlong shell_holder,
@@ -523,7 +562,23 @@ static void InvokePlatformMessageResponseCallback(JNIEnv* env,
       static_cast<uint8_t*>(env->GetDirectBufferAddress(message));
   FML_DCHECK(response_data != nullptr);
   auto mapping = std::make_unique<fml::MallocMapping>(
-      fml::MallocMapping::Copy(response_data, response_data + position));
+      fml::MallocMapping::CopyPooled(response_data, position));
+  ANDROID_SHELL_HOLDER->GetPlatformMessageHandler()
+      ->InvokePlatformMessageResponseCallback(responseId, std::move(mapping));
+}
+
+static void InvokePlatformMessageResponseCallbackBuffer(JNIEnv* env,
+                                                        jobject jcaller,
+                                                        jlong shell_holder,
+                                                        jint responseId,
+                                                        jobject message,
+                                                        jint position) {
+  uint8_t* response_data =
+      static_cast<uint8_t*>(env->GetDirectBufferAddress(message));
+  FML_DCHECK(response_data != nullptr);
+  // The buffer was allocated by AllocateMessageBuffer, the response takes
+  // ownership of it.
+  auto mapping = std::make_unique<fml::MallocMapping>(response_data, position);
   ANDROID_SHELL_HOLDER->GetPlatformMessageHandler()
       ->InvokePlatformMessageResponseCallback(responseId, std::move(mapping));
 }
@@ -542,6 +597,12 @@ static void NotifyLowMemoryWarning(JNIEnv* env,
   ANDROID_SHELL_HOLDER->NotifyLowMemoryWarning();
 }
 
+static void NotifyModerateMemoryPressure(JNIEnv* env,
+                                         jobject obj,
+                                         jlong shell_holder) {
+  ANDROID_SHELL_HOLDER->NotifyModerateMemoryPressure();
+}
+
 static jboolean FlutterTextUtilsIsEmoji(JNIEnv* env,
                                         jobject obj,
                                         jint codePoint) {
@@ -690,6 +751,27 @@ bool RegisterApi(JNIEnv* env) {
           .fnPtr =
               reinterpret_cast<void*>(&InvokePlatformMessageResponseCallback),
       },
+      {
+          .name = "nativeAllocateMessageBuffer",
+          .signature = "(I)Ljava/nio/ByteBuffer;",
+          .fnPtr = reinterpret_cast<void*>(&AllocateMessageBuffer),
+      },
+      {
+          .name = "nativeReleaseMessageBuffer",
+          .signature = "(Ljava/nio/ByteBuffer;)V",
+          .fnPtr = reinterpret_cast<void*>(&ReleaseMessageBuffer),
+      },
+      {
+          .name = "nativeDispatchPlatformMessageBuffer",
+          .signature = "(JLjava/lang/String;Ljava/nio/ByteBuffer;II)V",
+          .fnPtr = reinterpret_cast<void*>(&DispatchPlatformMessageBuffer),
+      },
+      {
+          .name = "nativeInvokePlatformMessageResponseCallbackBuffer",
+          .signature = "(JILjava/nio/ByteBuffer;I)V",
+          .fnPtr = reinterpret_cast<void*>(
+              &InvokePlatformMessageResponseCallbackBuffer),
+      },
       {
           .name = "nativeInvokePlatformMessageEmptyResponseCallback",
           .signature = "(JI)V",
@@ -701,6 +783,11 @@ bool RegisterApi(JNIEnv* env) {
           .signature = "(J)V",
           .fnPtr = reinterpret_cast<void*>(&NotifyLowMemoryWarning),
       },
+      {
+          .name = "nativeNotifyModerateMemoryPressure",
+          .signature = "(J)V",
+          .fnPtr = reinterpret_cast<void*>(&NotifyModerateMemoryPressure),
+      },
 
       // Start of methods from FlutterView
       {
@@ -928,6 +1015,14 @@ bool RegisterApi(JNIEnv* env) {
     return false;
   }
 
+  g_destroy_overlay_surface_method = env->GetMethodID(
+      g_flutter_jni_class->obj(), "destroyOverlaySurface", "(I)V");
+
+  if (g_destroy_overlay_surface_method == nullptr) {
+    FML_LOG(ERROR) << "Could not locate destroyOverlaySurface method";
+    return false;
+  }
+
   fml::jni::ScopedJavaLocalRef<jclass> overlay_surface_class(
       env, env->FindClass("io/flutter/embedding/engine/FlutterOverlaySurface"));
   if (overlay_surface_class.is_null()) {
@@ -1334,6 +1429,18 @@ SkSize ScaleToFill(float scaleX, float scaleY) {
   return SkSize::Make(scaleX * rescale, scaleY * rescale);
 }
 
+SkMatrix SurfaceTextureTransformToSkMatrix(const float* m) {
+  const SkSize scaled = ScaleToFill(m[0], m[5]);
+  SkScalar matrix3[] = {
+      scaled.fWidth, m[1],           m[2],   //
+      m[4],          scaled.fHeight, m[6],   //
+      m[8],          m[9],           m[10],  //
+  };
+  SkMatrix transform;
+  transform.set9(matrix3);
+  return transform;
+}
+
 void PlatformViewAndroidJNIImpl::SurfaceTextureGetTransformMatrix(
     JavaLocalRef surface_texture,
     SkMatrix& transform) {
@@ -1358,15 +1465,8 @@ void PlatformViewAndroidJNIImpl::SurfaceTextureGetTransformMatrix(
   FML_CHECK(fml::jni::CheckException(env));
 
   float* m = env->GetFloatArrayElements(transformMatrix.obj(), nullptr);
-  float scaleX = m[0], scaleY = m[5];
-  const SkSize scaled = ScaleToFill(scaleX, scaleY);
-  SkScalar matrix3[] = {
-      scaled.fWidth, m[1],           m[2],   //
-      m[4],          scaled.fHeight, m[6],   //
-      m[8],          m[9],           m[10],  //
-  };
+  transform = SurfaceTextureTransformToSkMatrix(m);
   env->ReleaseFloatArrayElements(transformMatrix.obj(), m, JNI_ABORT);
-  transform.set9(matrix3);
 }
 
 void PlatformViewAndroidJNIImpl::SurfaceTextureDetachFromGLContext(
@@ -1559,6 +1659,21 @@ void PlatformViewAndroidJNIImpl::FlutterViewDestroyOverlaySurfaces() {
   FML_CHECK(fml::jni::CheckException(env));
 }
 
+void PlatformViewAndroidJNIImpl::FlutterViewDestroyOverlaySurface(
+    int surface_id) {
+  JNIEnv* env = fml::jni::AttachCurrentThread();
+
+  auto java_object = java_object_.get(env);
+  if (java_object.is_null()) {
+    return;
+  }
+
+  env->CallVoidMethod(java_object.obj(), g_destroy_overlay_surface_method,
+                      surface_id);
+
+  FML_CHECK(fml::jni::CheckException(env));
+}
+
 std::unique_ptr<std::vector<std::string>>
 PlatformViewAndroidJNIImpl::FlutterViewComputePlatformResolvedLocale(
     std::vector<std::string> supported_locales_data) {
@@ -76,6 +76,8 @@ class PlatformViewAndroidJNIImpl final : public PlatformViewAndroidJNI {
 
   void FlutterViewDestroyOverlaySurfaces() override;
 
+  void FlutterViewDestroyOverlaySurface(int surface_id) override;
+
   std::unique_ptr<std::vector<std::string>>
   FlutterViewComputePlatformResolvedLocale(
       std::vector<std::string> supported_locales_data) override;
@@ -91,6 +93,13 @@ class PlatformViewAndroidJNIImpl final : public PlatformViewAndroidJNI {
   FML_DISALLOW_COPY_AND_ASSIGN(PlatformViewAndroidJNIImpl);
 };
 
+//------------------------------------------------------------------------------
+/// @brief      Converts the column-major 4x4 transform matrix of a
+///             `SurfaceTexture` to the matrix its image is drawn with, scaled
+///             to fill the bounds of the texture.
+///
+SkMatrix SurfaceTextureTransformToSkMatrix(const float* m);
+
 }  // namespace flutter
 
 #endif  // FLUTTER_SHELL_PLATFORM_ANDROID_PLATFORM_VIEW_ANDROID_JNI_IMPL_H_
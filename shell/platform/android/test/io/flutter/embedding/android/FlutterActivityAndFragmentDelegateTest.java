@@ -777,6 +777,7 @@ public class FlutterActivityAndFragmentDelegateTest {
     delegate.onTrimMemory(TRIM_MEMORY_MODERATE);
     delegate.onTrimMemory(TRIM_MEMORY_UI_HIDDEN);
     verify(mockFlutterEngine.getDartExecutor(), times(0)).notifyLowMemoryWarning();
+    verify(mockFlutterEngine.getDartExecutor(), times(0)).notifyModerateMemoryPressure();
     verify(mockFlutterEngine.getSystemChannel(), times(0)).sendMemoryPressureWarning();
 
     verify(mockHost, times(0)).onFlutterUiDisplayed();
@@ -801,7 +802,8 @@ public class FlutterActivityAndFragmentDelegateTest {
     delegate.onTrimMemory(TRIM_MEMORY_COMPLETE);
     delegate.onTrimMemory(TRIM_MEMORY_MODERATE);
     delegate.onTrimMemory(TRIM_MEMORY_UI_HIDDEN);
-    verify(mockFlutterEngine.getDartExecutor(), times(6)).notifyLowMemoryWarning();
+    verify(mockFlutterEngine.getDartExecutor(), times(1)).notifyModerateMemoryPressure();
+    verify(mockFlutterEngine.getDartExecutor(), times(5)).notifyLowMemoryWarning();
     verify(mockFlutterEngine.getSystemChannel(), times(6)).sendMemoryPressureWarning();
   }
 
@@ -65,6 +65,17 @@ public class DartExecutorTest {
     verify(mockFlutterJNI, times(1)).notifyLowMemoryWarning();
   }
 
+  @Test
+  public void itNotifiesModerateMemoryPressure() {
+    FlutterJNI mockFlutterJNI = mock(FlutterJNI.class);
+    when(mockFlutterJNI.isAttached()).thenReturn(true);
+
+    DartExecutor dartExecutor = new DartExecutor(mockFlutterJNI, mock(AssetManager.class));
+    dartExecutor.notifyModerateMemoryPressure();
+    verify(mockFlutterJNI, times(1)).notifyModerateMemoryPressure();
+    verify(mockFlutterJNI, times(0)).notifyLowMemoryWarning();
+  }
+
   @Test
   public void itThrowsWhenCreatingADefaultDartEntrypointWithAnUninitializedFlutterLoader() {
     assertThrows(
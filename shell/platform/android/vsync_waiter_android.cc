@@ -4,11 +4,14 @@
 
 #include "flutter/shell/platform/android/vsync_waiter_android.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <utility>
 
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/native_library.h"
 #include "flutter/fml/platform/android/jni_util.h"
 #include "flutter/fml/platform/android/scoped_java_ref.h"
 #include "flutter/fml/size.h"
@@ -19,6 +22,72 @@ namespace flutter {
 static fml::jni::ScopedJavaGlobalRef<jclass>* g_vsync_waiter_class = nullptr;
 static jmethodID g_async_wait_for_vsync_method_ = nullptr;
 
+namespace {
+
+struct AChoreographer;
+using AChoreographerFrameCallback64 = void (*)(int64_t frame_time_nanos,
+                                               void* data);
+using AChoreographerRefreshRateCallback = void (*)(int64_t vsync_period_nanos,
+                                                   void* data);
+
+// The functions of the NDK choreographer. They are only available on API 29+,
+// and the refresh rate callbacks on API 30+, so they are looked up at runtime.
+struct ChoreographerProcs {
+  fml::RefPtr<fml::NativeLibrary> libandroid;
+  AChoreographer* (*GetInstance)() = nullptr;
+  void (*PostFrameCallback64)(AChoreographer* choreographer,
+                              AChoreographerFrameCallback64 callback,
+                              void* data) = nullptr;
+  void (*RegisterRefreshRateCallback)(
+      AChoreographer* choreographer,
+      AChoreographerRefreshRateCallback callback,
+      void* data) = nullptr;
+
+  bool IsAvailable() const {
+    return GetInstance != nullptr && PostFrameCallback64 != nullptr;
+  }
+};
+
+const ChoreographerProcs& GetChoreographerProcs() {
+  static const ChoreographerProcs procs = [] {
+    ChoreographerProcs procs;
+    procs.libandroid = fml::NativeLibrary::Create("libandroid.so");
+    if (!procs.libandroid) {
+      return procs;
+    }
+    procs.GetInstance =
+        procs.libandroid
+            ->ResolveFunction<decltype(procs.GetInstance)>(
+                "AChoreographer_getInstance")
+            .value_or(nullptr);
+    procs.PostFrameCallback64 =
+        procs.libandroid
+            ->ResolveFunction<decltype(procs.PostFrameCallback64)>(
+                "AChoreographer_postFrameCallback64")
+            .value_or(nullptr);
+    procs.RegisterRefreshRateCallback =
+        procs.libandroid
+            ->ResolveFunction<decltype(procs.RegisterRefreshRateCallback)>(
+                "AChoreographer_registerRefreshRateCallback")
+            .value_or(nullptr);
+    return procs;
+  }();
+  return procs;
+}
+
+// The vsync period of the display, which is that of 60Hz until the
+// choreographer reports it.
+std::atomic<int64_t> g_vsync_period_nanos = 1000000000 / 60;
+
+// Whether the choreographer of this thread reports the vsync period.
+thread_local bool tl_refresh_rate_callback_registered = false;
+
+void OnChoreographerRefreshRate(int64_t vsync_period_nanos, void* data) {
+  g_vsync_period_nanos = vsync_period_nanos;
+}
+
+}  // namespace
+
 VsyncWaiterAndroid::VsyncWaiterAndroid(flutter::TaskRunners task_runners)
     : VsyncWaiter(std::move(task_runners)) {}
 
@@ -29,6 +98,28 @@ void VsyncWaiterAndroid::AwaitVSync() {
   auto* weak_this = new std::weak_ptr<VsyncWaiter>(shared_from_this());
   jlong java_baton = reinterpret_cast<jlong>(weak_this);
 
+  // The choreographer of the UI thread, which runs on the looper of the
+  // thread, calls back on it directly, without going through Java or the
+  // platform thread.
+  if (GetChoreographerProcs().IsAvailable()) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetUITaskRunner(), [java_baton]() {
+          const ChoreographerProcs& procs = GetChoreographerProcs();
+          AChoreographer* choreographer = procs.GetInstance();
+          FML_CHECK(choreographer != nullptr)
+              << "The UI thread must run on a looper.";
+          if (!tl_refresh_rate_callback_registered &&
+              procs.RegisterRefreshRateCallback != nullptr) {
+            procs.RegisterRefreshRateCallback(
+                choreographer, &OnChoreographerRefreshRate, nullptr);
+            tl_refresh_rate_callback_registered = true;
+          }
+          procs.PostFrameCallback64(choreographer, &OnChoreographerFrame,
+                                    reinterpret_cast<void*>(java_baton));
+        });
+    return;
+  }
+
   task_runners_.GetPlatformTaskRunner()->PostTask([java_baton]() {
     JNIEnv* env = fml::jni::AttachCurrentThread();
     env->CallStaticVoidMethod(g_vsync_waiter_class->obj(),     //
@@ -54,6 +145,24 @@ void VsyncWaiterAndroid::OnNativeVsync(JNIEnv* env,
   ConsumePendingCallback(java_baton, frame_time, target_time);
 }
 
+// static
+void VsyncWaiterAndroid::OnChoreographerFrame(int64_t frame_time_nanos,
+                                              void* data) {
+  TRACE_EVENT0("flutter", "VSYNC");
+
+  // The frame time is on the monotonic clock, like the time points. It is
+  // the time of the vsync, so it is never in the future.
+  auto frame_time =
+      std::min(fml::TimePoint::FromEpochDelta(
+                   fml::TimeDelta::FromNanoseconds(frame_time_nanos)),
+               fml::TimePoint::Now());
+  auto target_time =
+      frame_time + fml::TimeDelta::FromNanoseconds(g_vsync_period_nanos);
+
+  ConsumePendingCallback(reinterpret_cast<jlong>(data), frame_time,
+                         target_time);
+}
+
 // static
 void VsyncWaiterAndroid::ConsumePendingCallback(
     jlong java_baton,
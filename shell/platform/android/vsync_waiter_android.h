@@ -32,6 +32,8 @@ class VsyncWaiterAndroid final : public VsyncWaiter {
                             jlong refreshPeriodNanos,
                             jlong java_baton);
 
+  static void OnChoreographerFrame(int64_t frame_time_nanos, void* data);
+
   static void ConsumePendingCallback(jlong java_baton,
                                      fml::TimePoint frame_start_time,
                                      fml::TimePoint frame_target_time);
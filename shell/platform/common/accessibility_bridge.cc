@@ -4,6 +4,7 @@
 
 #include "accessibility_bridge.h"
 
+#include <algorithm>
 #include <functional>
 #include <utility>
 
@@ -44,32 +45,54 @@ void AccessibilityBridge::AddFlutterSemanticsCustomActionUpdate(
 
 void AccessibilityBridge::CommitUpdates() {
   ui::AXTreeUpdate update{.tree_data = tree_.data()};
-  // Figure out update order, ui::AXTree only accepts update in tree order,
-  // where parent node must come before the child node in
-  // ui::AXTreeUpdate.nodes. We start with picking a random node and turn the
-  // entire subtree into a list. We pick another node from the remaining update,
-  // and keep doing so until the update map is empty. We then concatenate the
-  // lists in the reversed order, this guarantees parent updates always come
-  // before child updates.
-  std::vector<std::vector<SemanticsNode>> results;
-  while (!pending_semantics_node_updates_.empty()) {
-    auto begin = pending_semantics_node_updates_.begin();
-    SemanticsNode target = begin->second;
-    std::vector<SemanticsNode> sub_tree_list;
-    GetSubTreeList(target, sub_tree_list);
-    results.push_back(sub_tree_list);
-    pending_semantics_node_updates_.erase(begin);
-  }
-
-  for (size_t i = results.size(); i > 0; i--) {
-    for (SemanticsNode node : results[i - 1]) {
+  if (!HasStructuralChanges()) {
+    // Updates that only change the properties of existing nodes can be in any
+    // order, and the nodes they leave as they are can be dropped, so that
+    // neither ui::AXTree nor the event generator spends time on them. This is
+    // the common case of scrolling, where the framework resends nodes whose
+    // geometry didn't change along with the ones whose did.
+    for (const auto& [id, node] : pending_semantics_node_updates_) {
       ConvertFluterUpdate(node, update);
     }
-  }
+    update.nodes.erase(
+        std::remove_if(update.nodes.begin(), update.nodes.end(),
+                       [this](const ui::AXNodeData& node_data) {
+                         return IsSameNodeData(
+                             tree_.GetFromId(node_data.id)->data(), node_data);
+                       }),
+        update.nodes.end());
+  } else {
+    // Figure out update order, ui::AXTree only accepts update in tree order,
+    // where parent node must come before the child node in
+    // ui::AXTreeUpdate.nodes. We start with picking a random node and turn the
+    // entire subtree into a list. We pick another node from the remaining
+    // update, and keep doing so until the update map is empty. We then
+    // concatenate the lists in the reversed order, this guarantees parent
+    // updates always come before child updates.
+    std::vector<std::vector<SemanticsNode>> results;
+    while (!pending_semantics_node_updates_.empty()) {
+      auto begin = pending_semantics_node_updates_.begin();
+      SemanticsNode target = std::move(begin->second);
+      pending_semantics_node_updates_.erase(begin);
+      std::vector<SemanticsNode> sub_tree_list;
+      GetSubTreeList(std::move(target), sub_tree_list);
+      results.push_back(std::move(sub_tree_list));
+    }
 
-  tree_.Unserialize(update);
+    for (size_t i = results.size(); i > 0; i--) {
+      for (const SemanticsNode& node : results[i - 1]) {
+        ConvertFluterUpdate(node, update);
+      }
+    }
+  }
   pending_semantics_node_updates_.clear();
   pending_semantics_custom_action_updates_.clear();
+  if (update.nodes.empty() &&
+      (!update.has_tree_data || update.tree_data == tree_.data())) {
+    return;
+  }
+
+  tree_.Unserialize(update);
 
   std::string error = tree_.error();
   if (!error.empty()) {
@@ -178,6 +201,36 @@ void AccessibilityBridge::OnAtomicUpdateFinished(
 }
 
 // Private method.
+bool AccessibilityBridge::HasStructuralChanges() const {
+  for (const auto& [id, node] : pending_semantics_node_updates_) {
+    ui::AXNode* ax_node = tree_.GetFromId(id);
+    if (!ax_node ||
+        ax_node->children().size() != node.children_in_traversal_order.size()) {
+      return true;
+    }
+    for (size_t i = 0; i < ax_node->children().size(); i++) {
+      if (ax_node->children()[i]->id() !=
+          node.children_in_traversal_order[i]) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool AccessibilityBridge::IsSameNodeData(const ui::AXNodeData& a,
+                                         const ui::AXNodeData& b) {
+  return a.role == b.role && a.state == b.state && a.actions == b.actions &&
+         a.string_attributes == b.string_attributes &&
+         a.int_attributes == b.int_attributes &&
+         a.float_attributes == b.float_attributes &&
+         a.bool_attributes == b.bool_attributes &&
+         a.intlist_attributes == b.intlist_attributes &&
+         a.stringlist_attributes == b.stringlist_attributes &&
+         a.html_attributes == b.html_attributes && a.child_ids == b.child_ids &&
+         a.relative_bounds == b.relative_bounds;
+}
+
 void AccessibilityBridge::GetSubTreeList(SemanticsNode target,
                                          std::vector<SemanticsNode>& result) {
   result.push_back(target);
@@ -222,6 +222,11 @@ class AccessibilityBridge
   std::unique_ptr<AccessibilityBridgeDelegate> delegate_;
 
   void InitAXTree(const ui::AXTreeUpdate& initial_state);
+  // Returns whether the pending updates create, remove or reorder nodes, as
+  // opposed to only changing the properties of existing ones.
+  bool HasStructuralChanges() const;
+  // Returns whether |a| and |b| hold the same node data.
+  static bool IsSameNodeData(const ui::AXNodeData& a, const ui::AXNodeData& b);
   void GetSubTreeList(SemanticsNode target, std::vector<SemanticsNode>& result);
   void ConvertFluterUpdate(const SemanticsNode& node,
                            ui::AXTreeUpdate& tree_update);
@@ -158,6 +158,74 @@ TEST(AccessibilityBridgeTest, canFireChildrenChangedCorrectly) {
               Contains(ui::AXEventGenerator::Event::SUBTREE_CREATED));
 }
 
+TEST(AccessibilityBridgeTest, canCommitPropertyOnlyUpdates) {
+  TestAccessibilityBridgeDelegate* delegate =
+      new TestAccessibilityBridgeDelegate();
+  std::unique_ptr<TestAccessibilityBridgeDelegate> ptr(delegate);
+  std::shared_ptr<AccessibilityBridge> bridge =
+      std::make_shared<AccessibilityBridge>(std::move(ptr));
+  FlutterSemanticsNode root;
+  root.id = 0;
+  root.flags = static_cast<FlutterSemanticsFlag>(0);
+  root.actions = static_cast<FlutterSemanticsAction>(0);
+  root.text_selection_base = -1;
+  root.text_selection_extent = -1;
+  root.label = "root";
+  root.hint = "";
+  root.value = "";
+  root.increased_value = "";
+  root.decreased_value = "";
+  root.child_count = 1;
+  int32_t children[] = {1};
+  root.children_in_traversal_order = children;
+  root.custom_accessibility_actions_count = 0;
+  bridge->AddFlutterSemanticsNodeUpdate(&root);
+
+  FlutterSemanticsNode child1;
+  child1.id = 1;
+  child1.flags = static_cast<FlutterSemanticsFlag>(0);
+  child1.actions = static_cast<FlutterSemanticsAction>(0);
+  child1.text_selection_base = -1;
+  child1.text_selection_extent = -1;
+  child1.label = "child 1";
+  child1.hint = "";
+  child1.value = "";
+  child1.increased_value = "";
+  child1.decreased_value = "";
+  child1.child_count = 0;
+  child1.custom_accessibility_actions_count = 0;
+  bridge->AddFlutterSemanticsNodeUpdate(&child1);
+
+  bridge->CommitUpdates();
+  delegate->accessibility_events.clear();
+
+  // Resend the root as it is, and rename the child.
+  bridge->AddFlutterSemanticsNodeUpdate(&root);
+  child1.label = "renamed child 1";
+  bridge->AddFlutterSemanticsNodeUpdate(&child1);
+
+  bridge->CommitUpdates();
+
+  auto root_node = bridge->GetFlutterPlatformNodeDelegateFromID(0).lock();
+  auto child1_node = bridge->GetFlutterPlatformNodeDelegateFromID(1).lock();
+  EXPECT_EQ(root_node->GetChildCount(), 1);
+  EXPECT_EQ(root_node->GetName(), "root");
+  EXPECT_EQ(child1_node->GetName(), "renamed child 1");
+  ASSERT_EQ(delegate->accessibility_events.size(), size_t{1});
+  EXPECT_EQ(delegate->accessibility_events[0],
+            ui::AXEventGenerator::Event::NAME_CHANGED);
+  delegate->accessibility_events.clear();
+
+  // Resending unchanged nodes fires no events.
+  bridge->AddFlutterSemanticsNodeUpdate(&root);
+  bridge->AddFlutterSemanticsNodeUpdate(&child1);
+
+  bridge->CommitUpdates();
+
+  EXPECT_EQ(child1_node->GetName(), "renamed child 1");
+  EXPECT_TRUE(delegate->accessibility_events.empty());
+}
+
 TEST(AccessibilityBridgeTest, canUpdateDelegate) {
   std::shared_ptr<AccessibilityBridge> bridge =
       std::make_shared<AccessibilityBridge>(
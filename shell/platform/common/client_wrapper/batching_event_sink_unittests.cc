@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/batching_event_sink.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/encodable_value.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+namespace {
+
+// An EventSink that records the events it consumes.
+class TestEventSink : public EventSink<> {
+ public:
+  TestEventSink(std::vector<EncodableValue>* events,
+                std::vector<std::string>* errors)
+      : events_(events), errors_(errors) {}
+
+ protected:
+  void SuccessInternal(const EncodableValue* event = nullptr) override {
+    events_->push_back(event ? *event : EncodableValue());
+  }
+
+  void ErrorInternal(const std::string& error_code,
+                     const std::string& error_message,
+                     const EncodableValue* error_details) override {
+    errors_->push_back(error_code);
+  }
+
+  void EndOfStreamInternal() override { errors_->push_back("end"); }
+
+ private:
+  std::vector<EncodableValue>* events_;
+  std::vector<std::string>* errors_;
+};
+
+EncodableValue Batch(std::vector<int32_t> values) {
+  EncodableList list;
+  for (int32_t value : values) {
+    list.push_back(EncodableValue(value));
+  }
+  return EncodableValue(list);
+}
+
+}  // namespace
+
+// Tests that events are sent in full batches, and partial ones on Flush.
+TEST(BatchingEventSinkTest, SendsFullBatches) {
+  std::vector<EncodableValue> events;
+  std::vector<std::string> errors;
+  BatchingEventSink<> sink(std::make_unique<TestEventSink>(&events, &errors),
+                           2, 10);
+
+  for (int32_t i = 0; i < 5; i++) {
+    sink.Success(EncodableValue(i));
+  }
+  EXPECT_EQ(events,
+            std::vector<EncodableValue>({Batch({0, 1}), Batch({2, 3})}));
+  EXPECT_EQ(sink.buffered_events(), 1u);
+
+  sink.Flush();
+  EXPECT_EQ(events.size(), 3u);
+  EXPECT_EQ(events.back(), Batch({4}));
+  EXPECT_EQ(sink.buffered_events(), 0u);
+}
+
+// Tests that only requested batches are sent, and that the buffer drops the
+// oldest events when it overflows.
+TEST(BatchingEventSinkTest, SendsRequestedBatches) {
+  std::vector<EncodableValue> events;
+  std::vector<std::string> errors;
+  BatchingEventSink<> sink(std::make_unique<TestEventSink>(&events, &errors),
+                           2, 4);
+  sink.RequestBatches(1);
+
+  for (int32_t i = 0; i < 8; i++) {
+    sink.Success(EncodableValue(i));
+  }
+  EXPECT_EQ(events, std::vector<EncodableValue>({Batch({0, 1})}));
+  EXPECT_EQ(sink.buffered_events(), 4u);
+  EXPECT_EQ(sink.dropped_events(), 2u);
+
+  sink.RequestBatches(5);
+  EXPECT_EQ(events, std::vector<EncodableValue>(
+                        {Batch({0, 1}), Batch({4, 5}), Batch({6, 7})}));
+}
+
+// Tests that the newest events are dropped with kDropNewest.
+TEST(BatchingEventSinkTest, DropsNewestEvents) {
+  std::vector<EncodableValue> events;
+  std::vector<std::string> errors;
+  BatchingEventSink<> sink(
+      std::make_unique<TestEventSink>(&events, &errors), 2, 2,
+      BatchingEventSink<>::OverflowPolicy::kDropNewest);
+  sink.RequestBatches(0);
+
+  for (int32_t i = 0; i < 4; i++) {
+    sink.Success(EncodableValue(i));
+  }
+  EXPECT_EQ(sink.dropped_events(), 2u);
+
+  sink.RequestBatches(1);
+  EXPECT_EQ(events, std::vector<EncodableValue>({Batch({0, 1})}));
+}
+
+// Tests that buffered events are sent before errors and the end of the
+// stream, and that nothing is sent after the end.
+TEST(BatchingEventSinkTest, SendsEventsBeforeErrors) {
+  std::vector<EncodableValue> events;
+  std::vector<std::string> errors;
+  BatchingEventSink<> sink(std::make_unique<TestEventSink>(&events, &errors),
+                           4, 4);
+  sink.RequestBatches(0);
+
+  sink.Success(EncodableValue(1));
+  sink.Error("code");
+  EXPECT_EQ(events, std::vector<EncodableValue>({Batch({1})}));
+  sink.Success(EncodableValue(2));
+  sink.EndOfStream();
+  sink.Success(EncodableValue(3));
+  sink.EndOfStream();
+
+  EXPECT_EQ(events, std::vector<EncodableValue>({Batch({1}), Batch({2})}));
+  EXPECT_EQ(errors, std::vector<std::string>({"code", "end"}));
+}
+
+}  // namespace flutter
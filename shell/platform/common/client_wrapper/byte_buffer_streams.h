@@ -86,9 +86,7 @@ class ByteBufferStreamWriter : public ByteStreamWriter {
   void WriteAlignment(uint8_t alignment) {
     uint8_t mod = bytes_->size() % alignment;
     if (mod) {
-      for (int i = 0; i < alignment - mod; ++i) {
-        WriteByte(0);
-      }
+      bytes_->insert(bytes_->end(), alignment - mod, 0);
     }
   }
 
@@ -97,6 +95,36 @@ class ByteBufferStreamWriter : public ByteStreamWriter {
   std::vector<uint8_t>* bytes_;
 };
 
+// Implementation of ByteStreamWriter that only counts the bytes written, to
+// size a buffer for them ahead of writing them.
+class ByteCountingStreamWriter : public ByteStreamWriter {
+ public:
+  ByteCountingStreamWriter() = default;
+
+  virtual ~ByteCountingStreamWriter() = default;
+
+  // Returns the number of bytes written so far.
+  size_t size() const { return size_; }
+
+  // |ByteStreamWriter|
+  void WriteByte(uint8_t byte) { size_++; }
+
+  // |ByteStreamWriter|
+  void WriteBytes(const uint8_t* bytes, size_t length) { size_ += length; }
+
+  // |ByteStreamWriter|
+  void WriteAlignment(uint8_t alignment) {
+    uint8_t mod = size_ % alignment;
+    if (mod) {
+      size_ += alignment - mod;
+    }
+  }
+
+ private:
+  // The number of bytes written.
+  size_t size_ = 0;
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_BYTE_BUFFER_STREAMS_H_
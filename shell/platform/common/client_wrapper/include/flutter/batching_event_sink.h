@@ -0,0 +1,169 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_BATCHING_EVENT_SINK_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_BATCHING_EVENT_SINK_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "event_sink.h"
+
+namespace flutter {
+
+class EncodableValue;
+
+// An EventSink that sends the successful events it consumes to another sink
+// in batches, so that a fast producer sends one platform message per batch
+// rather than one per event. Each batch is sent as a single event holding the
+// list of batched events, so the Dart side of the channel receives lists.
+//
+// The events waiting to be sent are held in a bounded buffer. The consumer
+// can limit how many batches are sent with RequestBatches, and events that
+// arrive while the buffer is full are dropped according to |OverflowPolicy|.
+//
+// |T| must be constructible from a std::vector<T>, as EncodableValue is from
+// an EncodableList. Like any EventSink, this must only be used on the
+// platform thread.
+template <typename T = EncodableValue>
+class BatchingEventSink : public EventSink<T> {
+ public:
+  // Which events are dropped when the buffer is full.
+  enum class OverflowPolicy {
+    // The oldest buffered event is dropped to make room for the new one.
+    kDropOldest,
+    // The new event is dropped.
+    kDropNewest,
+  };
+
+  // The number of batches that is never used up by sending batches.
+  static constexpr size_t kUnlimitedBatches =
+      std::numeric_limits<size_t>::max();
+
+  // Creates a sink that sends batches of up to |max_batch_size| events to
+  // |sink|, buffering at most |max_buffered_events| events. Batches are sent
+  // as soon as they are full, and partial batches are sent by Flush.
+  //
+  // Until RequestBatches is called, any number of batches may be sent.
+  BatchingEventSink(std::unique_ptr<EventSink<T>> sink,
+                    size_t max_batch_size,
+                    size_t max_buffered_events,
+                    OverflowPolicy overflow_policy =
+                        OverflowPolicy::kDropOldest)
+      : sink_(std::move(sink)),
+        max_batch_size_(std::max<size_t>(max_batch_size, 1)),
+        max_buffered_events_(
+            std::max<size_t>(max_buffered_events, max_batch_size_)),
+        overflow_policy_(overflow_policy) {}
+
+  virtual ~BatchingEventSink() = default;
+
+  // Prevent copying.
+  BatchingEventSink(BatchingEventSink const&) = delete;
+  BatchingEventSink& operator=(BatchingEventSink const&) = delete;
+
+  // Allows |count| more batches to be sent, typically in response to a demand
+  // signal from the Dart side. The first call switches the sink from sending
+  // any number of batches to sending only the requested ones.
+  void RequestBatches(size_t count) {
+    if (requested_batches_ == kUnlimitedBatches) {
+      requested_batches_ = 0;
+    }
+    size_t headroom = kUnlimitedBatches - 1 - requested_batches_;
+    requested_batches_ += std::min(count, headroom);
+    SendBatches(/* include_partial = */ false);
+  }
+
+  // Sends the buffered events, including a final partial batch, as far as the
+  // requested batches allow. Producers that need events delivered within a
+  // time bound call this from a timer.
+  void Flush() { SendBatches(/* include_partial = */ true); }
+
+  // Returns the number of events waiting to be sent.
+  size_t buffered_events() const { return buffer_.size(); }
+
+  // Returns the number of events dropped because the buffer was full.
+  size_t dropped_events() const { return dropped_events_; }
+
+ protected:
+  // |flutter::EventSink|
+  void SuccessInternal(const T* event = nullptr) override {
+    if (ended_) {
+      return;
+    }
+    if (buffer_.size() >= max_buffered_events_) {
+      dropped_events_++;
+      if (overflow_policy_ == OverflowPolicy::kDropNewest) {
+        return;
+      }
+      buffer_.pop_front();
+    }
+    buffer_.push_back(event ? *event : T());
+    SendBatches(/* include_partial = */ false);
+  }
+
+  // |flutter::EventSink|
+  void ErrorInternal(const std::string& error_code,
+                     const std::string& error_message,
+                     const T* error_details) override {
+    if (ended_) {
+      return;
+    }
+    // Errors are not batched, so the events before them are sent first to
+    // keep the stream in order, regardless of the requested batches.
+    SendBatches(/* include_partial = */ true, /* ignore_requests = */ true);
+    if (error_details) {
+      sink_->Error(error_code, error_message, *error_details);
+    } else {
+      sink_->Error(error_code, error_message);
+    }
+  }
+
+  // |flutter::EventSink|
+  void EndOfStreamInternal() override {
+    if (ended_) {
+      return;
+    }
+    SendBatches(/* include_partial = */ true, /* ignore_requests = */ true);
+    ended_ = true;
+    sink_->EndOfStream();
+  }
+
+ private:
+  // Sends batches while they are requested and full, or non-empty if
+  // |include_partial| is true.
+  void SendBatches(bool include_partial, bool ignore_requests = false) {
+    while (!buffer_.empty() && (ignore_requests || requested_batches_ > 0) &&
+           (include_partial || buffer_.size() >= max_batch_size_)) {
+      size_t count = std::min(buffer_.size(), max_batch_size_);
+      auto end = buffer_.begin() + count;
+      std::vector<T> batch(std::make_move_iterator(buffer_.begin()),
+                           std::make_move_iterator(end));
+      buffer_.erase(buffer_.begin(), end);
+      if (requested_batches_ != kUnlimitedBatches && requested_batches_ > 0) {
+        requested_batches_--;
+      }
+      sink_->Success(T(std::move(batch)));
+    }
+  }
+
+  std::unique_ptr<EventSink<T>> sink_;
+  const size_t max_batch_size_;
+  const size_t max_buffered_events_;
+  const OverflowPolicy overflow_policy_;
+  std::deque<T> buffer_;
+  size_t requested_batches_ = kUnlimitedBatches;
+  size_t dropped_events_ = 0;
+  bool ended_ = false;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_BATCHING_EVENT_SINK_H_
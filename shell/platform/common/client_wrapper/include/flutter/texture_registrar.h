@@ -42,10 +42,44 @@ class PixelBufferTexture {
   const CopyBufferCallback copy_buffer_callback_;
 };
 
+// A GPU surface-based texture.
+class GpuSurfaceTexture {
+ public:
+  // A callback used for retrieving surface descriptors.
+  typedef std::function<
+      const FlutterDesktopGpuSurfaceDescriptor*(size_t width, size_t height)>
+      ObtainDescriptorCallback;
+
+  // Creates a GPU surface texture of type |surface_type| that uses the
+  // provided |obtain_descriptor_callback| to retrieve the surface
+  // descriptors.
+  // As the callback is usually invoked from the render thread, the callee must
+  // take care of proper synchronization.
+  GpuSurfaceTexture(FlutterDesktopGpuSurfaceType surface_type,
+                    ObtainDescriptorCallback obtain_descriptor_callback)
+      : surface_type_(surface_type),
+        obtain_descriptor_callback_(obtain_descriptor_callback) {}
+
+  // Returns the callback-provided FlutterDesktopGpuSurfaceDescriptor that
+  // contains the surface handle. The intended surface size is specified by
+  // |width| and |height|.
+  const FlutterDesktopGpuSurfaceDescriptor* ObtainDescriptor(
+      size_t width,
+      size_t height) const {
+    return obtain_descriptor_callback_(width, height);
+  }
+
+  // Gets the surface type.
+  FlutterDesktopGpuSurfaceType surface_type() const { return surface_type_; }
+
+ private:
+  const FlutterDesktopGpuSurfaceType surface_type_;
+  const ObtainDescriptorCallback obtain_descriptor_callback_;
+};
+
 // The available texture variants.
-// Only PixelBufferTexture is currently implemented.
-// Other variants are expected to be added in the future.
-typedef std::variant<PixelBufferTexture> TextureVariant;
+// GPU surface textures are currently only supported on Windows.
+typedef std::variant<PixelBufferTexture, GpuSurfaceTexture> TextureVariant;
 
 // An object keeping track of external textures.
 //
@@ -61,8 +95,9 @@ class TextureRegistrar {
   // Notifies the flutter engine that the texture object corresponding
   // to |texure_id| needs to render a new frame.
   //
-  // For PixelBufferTextures, this will effectively make the engine invoke
-  // the callback that was provided upon creating the texture.
+  // For PixelBufferTextures and GpuSurfaceTextures, this will effectively
+  // make the engine invoke the callback that was provided upon creating the
+  // texture.
   virtual bool MarkTextureFrameAvailable(int64_t texture_id) = 0;
 
   // Unregisters an existing Texture object.
@@ -12,6 +12,7 @@
 #include <iostream>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "byte_buffer_streams.h"
@@ -78,6 +79,21 @@ EncodedType EncodedTypeForValue(const EncodableValue& value) {
   return EncodedType::kNull;
 }
 
+// Returns the bytes written by |write|, into a buffer allocated once at the
+// exact size of the encoding, as measured by a first pass of |write|.
+template <typename WriteFunction>
+std::unique_ptr<std::vector<uint8_t>> EncodeWithExactSize(
+    WriteFunction write) {
+  ByteCountingStreamWriter counter;
+  write(&counter);
+
+  auto encoded = std::make_unique<std::vector<uint8_t>>();
+  encoded->reserve(counter.size());
+  ByteBufferStreamWriter stream(encoded.get());
+  write(&stream);
+  return encoded;
+}
+
 }  // namespace
 
 StandardCodecSerializer::StandardCodecSerializer() = default;
@@ -188,7 +204,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
       std::string string_value;
       string_value.resize(size);
       stream->ReadBytes(reinterpret_cast<uint8_t*>(&string_value[0]), size);
-      return EncodableValue(string_value);
+      return EncodableValue(std::move(string_value));
     }
     case EncodedType::kUInt8List:
       return ReadVector<uint8_t>(stream);
@@ -205,7 +221,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
       for (size_t i = 0; i < length; ++i) {
         list_value.push_back(ReadValue(stream));
       }
-      return EncodableValue(list_value);
+      return EncodableValue(std::move(list_value));
     }
     case EncodedType::kMap: {
       size_t length = ReadSize(stream);
@@ -215,7 +231,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
         EncodableValue value = ReadValue(stream);
         map_value.emplace(std::move(key), std::move(value));
       }
-      return EncodableValue(map_value);
+      return EncodableValue(std::move(map_value));
     }
     case EncodedType::kFloat32List: {
       return ReadVector<float>(stream);
@@ -268,11 +284,11 @@ EncodableValue StandardCodecSerializer::ReadVector(
   }
   stream->ReadBytes(reinterpret_cast<uint8_t*>(vector.data()),
                     count * type_size);
-  return EncodableValue(vector);
+  return EncodableValue(std::move(vector));
 }
 
 template <typename T>
-void StandardCodecSerializer::WriteVector(const std::vector<T> vector,
+void StandardCodecSerializer::WriteVector(const std::vector<T>& vector,
                                           ByteStreamWriter* stream) const {
   size_t count = vector.size();
   WriteSize(count, stream);
@@ -328,10 +344,9 @@ std::unique_ptr<EncodableValue> StandardMessageCodec::DecodeMessageInternal(
 std::unique_ptr<std::vector<uint8_t>>
 StandardMessageCodec::EncodeMessageInternal(
     const EncodableValue& message) const {
-  auto encoded = std::make_unique<std::vector<uint8_t>>();
-  ByteBufferStreamWriter stream(encoded.get());
-  serializer_->WriteValue(message, &stream);
-  return encoded;
+  return EncodeWithExactSize([this, &message](ByteStreamWriter* stream) {
+    serializer_->WriteValue(message, stream);
+  });
 }
 
 // ===== standard_method_codec.h =====
@@ -382,29 +397,29 @@ StandardMethodCodec::DecodeMethodCallInternal(const uint8_t* message,
 std::unique_ptr<std::vector<uint8_t>>
 StandardMethodCodec::EncodeMethodCallInternal(
     const MethodCall<EncodableValue>& method_call) const {
-  auto encoded = std::make_unique<std::vector<uint8_t>>();
-  ByteBufferStreamWriter stream(encoded.get());
-  serializer_->WriteValue(EncodableValue(method_call.method_name()), &stream);
-  if (method_call.arguments()) {
-    serializer_->WriteValue(*method_call.arguments(), &stream);
-  } else {
-    serializer_->WriteValue(EncodableValue(), &stream);
-  }
-  return encoded;
+  const EncodableValue method_name(method_call.method_name());
+  return EncodeWithExactSize(
+      [this, &method_name, &method_call](ByteStreamWriter* stream) {
+        serializer_->WriteValue(method_name, stream);
+        if (method_call.arguments()) {
+          serializer_->WriteValue(*method_call.arguments(), stream);
+        } else {
+          serializer_->WriteValue(EncodableValue(), stream);
+        }
+      });
 }
 
 std::unique_ptr<std::vector<uint8_t>>
 StandardMethodCodec::EncodeSuccessEnvelopeInternal(
     const EncodableValue* result) const {
-  auto encoded = std::make_unique<std::vector<uint8_t>>();
-  ByteBufferStreamWriter stream(encoded.get());
-  stream.WriteByte(0);
-  if (result) {
-    serializer_->WriteValue(*result, &stream);
-  } else {
-    serializer_->WriteValue(EncodableValue(), &stream);
-  }
-  return encoded;
+  return EncodeWithExactSize([this, result](ByteStreamWriter* stream) {
+    stream->WriteByte(0);
+    if (result) {
+      serializer_->WriteValue(*result, stream);
+    } else {
+      serializer_->WriteValue(EncodableValue(), stream);
+    }
+  });
 }
 
 std::unique_ptr<std::vector<uint8_t>>
@@ -412,21 +427,20 @@ StandardMethodCodec::EncodeErrorEnvelopeInternal(
     const std::string& error_code,
     const std::string& error_message,
     const EncodableValue* error_details) const {
-  auto encoded = std::make_unique<std::vector<uint8_t>>();
-  ByteBufferStreamWriter stream(encoded.get());
-  stream.WriteByte(1);
-  serializer_->WriteValue(EncodableValue(error_code), &stream);
-  if (error_message.empty()) {
-    serializer_->WriteValue(EncodableValue(), &stream);
-  } else {
-    serializer_->WriteValue(EncodableValue(error_message), &stream);
-  }
-  if (error_details) {
-    serializer_->WriteValue(*error_details, &stream);
-  } else {
-    serializer_->WriteValue(EncodableValue(), &stream);
-  }
-  return encoded;
+  const EncodableValue code(error_code);
+  const EncodableValue message =
+      error_message.empty() ? EncodableValue() : EncodableValue(error_message);
+  return EncodeWithExactSize(
+      [this, &code, &message, error_details](ByteStreamWriter* stream) {
+        stream->WriteByte(1);
+        serializer_->WriteValue(code, stream);
+        serializer_->WriteValue(message, stream);
+        if (error_details) {
+          serializer_->WriteValue(*error_details, stream);
+        } else {
+          serializer_->WriteValue(EncodableValue(), stream);
+        }
+      });
 }
 
 bool StandardMethodCodec::DecodeAndProcessResponseEnvelopeInternal(
@@ -42,6 +42,8 @@ static void CheckEncodeDecode(
   auto encoded = codec.EncodeMessage(value);
   ASSERT_TRUE(encoded);
   EXPECT_EQ(*encoded, expected_encoding);
+  // The encoding is measured before it is written, so its buffer never grows.
+  EXPECT_EQ(encoded->capacity(), encoded->size());
 
   auto decoded = codec.DecodeMessage(*encoded);
   if (custom_comparator) {
@@ -93,6 +93,17 @@ void FlutterDesktopMessengerSetCallback(FlutterDesktopMessengerRef messenger,
   }
 }
 
+void FlutterDesktopMessengerSetBackgroundCallback(
+    FlutterDesktopMessengerRef messenger,
+    const char* channel,
+    FlutterDesktopMessageCallback callback,
+    void* user_data) {
+  if (s_stub_implementation) {
+    s_stub_implementation->MessengerSetBackgroundCallback(channel, callback,
+                                                          user_data);
+  }
+}
+
 FlutterDesktopTextureRegistrarRef FlutterDesktopRegistrarGetTextureRegistrar(
     FlutterDesktopPluginRegistrarRef registrar) {
   return reinterpret_cast<FlutterDesktopTextureRegistrarRef>(1);
@@ -65,6 +65,12 @@ class StubFlutterApi {
                                     FlutterDesktopMessageCallback callback,
                                     void* user_data) {}
 
+  // Called for FlutterDesktopMessengerSetBackgroundCallback.
+  virtual void MessengerSetBackgroundCallback(
+      const char* channel,
+      FlutterDesktopMessageCallback callback,
+      void* user_data) {}
+
   // Called for FlutterDesktopRegisterExternalTexture.
   virtual int64_t TextureRegistrarRegisterExternalTexture(
       const FlutterDesktopTextureInfo* info) {
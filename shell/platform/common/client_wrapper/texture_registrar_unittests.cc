@@ -22,7 +22,9 @@ class TestApi : public testing::StubFlutterApi {
   struct FakePixelBufferTexture {
     int64_t texture_id;
     int32_t mark_count;
+    FlutterDesktopTextureType type;
     FlutterDesktopPixelBufferTextureCallback texture_callback;
+    FlutterDesktopGpuSurfaceTextureCallback gpu_surface_callback;
     void* user_data;
   };
 
@@ -32,8 +34,14 @@ class TestApi : public testing::StubFlutterApi {
     last_texture_id_++;
 
     auto texture = std::make_unique<FakePixelBufferTexture>();
-    texture->texture_callback = info->pixel_buffer_config.callback;
-    texture->user_data = info->pixel_buffer_config.user_data;
+    texture->type = info->type;
+    if (info->type == kFlutterDesktopGpuSurfaceTexture) {
+      texture->gpu_surface_callback = info->gpu_surface_config.callback;
+      texture->user_data = info->gpu_surface_config.user_data;
+    } else {
+      texture->texture_callback = info->pixel_buffer_config.callback;
+      texture->user_data = info->pixel_buffer_config.user_data;
+    }
     texture->mark_count = 0;
     texture->texture_id = last_texture_id_;
 
@@ -118,6 +126,35 @@ TEST(TextureRegistrarTest, RegisterUnregisterTexture) {
   EXPECT_EQ(test_api->textures_size(), static_cast<size_t>(0));
 }
 
+// Tests that GPU surface textures are registered with their descriptor
+// callback.
+TEST(TextureRegistrarTest, RegisterGpuSurfaceTexture) {
+  testing::ScopedStubFlutterApi scoped_api_stub(std::make_unique<TestApi>());
+  auto test_api = static_cast<TestApi*>(scoped_api_stub.stub());
+
+  auto dummy_registrar_handle =
+      reinterpret_cast<FlutterDesktopPluginRegistrarRef>(1);
+  PluginRegistrar registrar(dummy_registrar_handle);
+  TextureRegistrar* textures = registrar.texture_registrar();
+  ASSERT_NE(textures, nullptr);
+
+  FlutterDesktopGpuSurfaceDescriptor descriptor = {};
+  auto gpu_surface_texture = std::make_unique<TextureVariant>(
+      GpuSurfaceTexture(kFlutterDesktopGpuSurfaceTypeDxgiSharedHandle,
+                        [&descriptor](size_t width, size_t height) {
+                          return &descriptor;
+                        }));
+  int64_t texture_id = textures->RegisterTexture(gpu_surface_texture.get());
+  EXPECT_EQ(test_api->last_texture_id(), texture_id);
+
+  auto texture = test_api->GetFakeTexture(texture_id);
+  EXPECT_EQ(texture->type, kFlutterDesktopGpuSurfaceTexture);
+  EXPECT_EQ(texture->gpu_surface_callback(1, 1, texture->user_data),
+            &descriptor);
+
+  EXPECT_TRUE(textures->UnregisterTexture(texture_id));
+}
+
 // Tests that unregistering a texture with an unknown id returns false.
 TEST(TextureRegistrarTest, UnregisterInvalidTexture) {
   auto dummy_registrar_handle =
@@ -4,8 +4,99 @@
 
 #include "flutter/shell/platform/common/incoming_message_dispatcher.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace flutter {
 
+class IncomingMessageDispatcher::BackgroundHandler {
+ public:
+  BackgroundHandler(FlutterDesktopMessengerRef messenger,
+                    FlutterDesktopMessageCallback callback,
+                    void* user_data)
+      : messenger_(messenger),
+        callback_(callback),
+        user_data_(user_data),
+        thread_([this] { Run(); }) {}
+
+  // Waits for the message being handled, if any, and responds to the queued
+  // ones with empty responses.
+  ~BackgroundHandler() {
+    {
+      std::scoped_lock lock(mutex_);
+      stopping_ = true;
+    }
+    condition_.notify_one();
+    thread_.join();
+    for (const PendingMessage& message : queue_) {
+      FlutterDesktopMessengerSendResponse(messenger_, message.response_handle,
+                                          nullptr, 0);
+    }
+  }
+
+  // Prevent copying.
+  BackgroundHandler(BackgroundHandler const&) = delete;
+  BackgroundHandler& operator=(BackgroundHandler const&) = delete;
+
+  // Queues |message| for the callback. The message is copied, since it is only
+  // valid for the duration of the call.
+  void Post(const FlutterDesktopMessage& message) {
+    {
+      std::scoped_lock lock(mutex_);
+      queue_.push_back({message.channel,
+                        std::vector<uint8_t>(
+                            message.message,
+                            message.message + message.message_size),
+                        message.response_handle});
+    }
+    condition_.notify_one();
+  }
+
+ private:
+  struct PendingMessage {
+    std::string channel;
+    std::vector<uint8_t> data;
+    const FlutterDesktopMessageResponseHandle* response_handle;
+  };
+
+  void Run() {
+    std::unique_lock lock(mutex_);
+    while (true) {
+      condition_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+      if (stopping_) {
+        return;
+      }
+      PendingMessage pending = std::move(queue_.front());
+      queue_.pop_front();
+      lock.unlock();
+
+      FlutterDesktopMessage message = {
+          sizeof(FlutterDesktopMessage), pending.channel.c_str(),
+          pending.data.data(),           pending.data.size(),
+          pending.response_handle,
+      };
+      callback_(messenger_, &message, user_data_);
+
+      lock.lock();
+    }
+  }
+
+  FlutterDesktopMessengerRef messenger_;
+  FlutterDesktopMessageCallback callback_;
+  void* user_data_;
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<PendingMessage> queue_;
+  bool stopping_ = false;
+
+  // Started last, since it uses all of the above.
+  std::thread thread_;
+};
+
 IncomingMessageDispatcher::IncomingMessageDispatcher(
     FlutterDesktopMessengerRef messenger)
     : messenger_(messenger) {}
@@ -19,6 +110,12 @@ void IncomingMessageDispatcher::HandleMessage(
     const std::function<void(void)>& input_unblock_cb) {
   std::string channel(message.channel);
 
+  auto background_handler = background_handlers_.find(channel);
+  if (background_handler != background_handlers_.end()) {
+    background_handler->second->Post(message);
+    return;
+  }
+
   // Find the handler for the channel; if there isn't one, report the failure.
   if (callbacks_.find(channel) == callbacks_.end()) {
     FlutterDesktopMessengerSendResponse(messenger_, message.response_handle,
@@ -43,6 +140,7 @@ void IncomingMessageDispatcher::SetMessageCallback(
     const std::string& channel,
     FlutterDesktopMessageCallback callback,
     void* user_data) {
+  background_handlers_.erase(channel);
   if (!callback) {
     callbacks_.erase(channel);
     return;
@@ -50,6 +148,19 @@ void IncomingMessageDispatcher::SetMessageCallback(
   callbacks_[channel] = std::make_pair(callback, user_data);
 }
 
+void IncomingMessageDispatcher::SetBackgroundMessageCallback(
+    const std::string& channel,
+    FlutterDesktopMessageCallback callback,
+    void* user_data) {
+  callbacks_.erase(channel);
+  background_handlers_.erase(channel);
+  if (!callback) {
+    return;
+  }
+  background_handlers_[channel] =
+      std::make_unique<BackgroundHandler>(messenger_, callback, user_data);
+}
+
 void IncomingMessageDispatcher::EnableInputBlockingForChannel(
     const std::string& channel) {
   input_blocking_channels_.insert(channel);
@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <utility>
@@ -52,6 +53,20 @@ class IncomingMessageDispatcher {
                           FlutterDesktopMessageCallback callback,
                           void* user_data);
 
+  // Registers a message callback like SetMessageCallback, except that
+  // |callback| is called on a background thread dedicated to |channel| rather
+  // than from HandleMessage, so that slow handlers don't stall the platform
+  // thread. Messages on the channel are handled one at a time, in order, and
+  // must be responded to from the background thread or any other thread.
+  // Input blocking doesn't apply to these channels.
+  //
+  // Replacing or unregistering the callback waits for a call to it that is in
+  // progress, and responds to the messages that are still queued for it with
+  // empty responses.
+  void SetBackgroundMessageCallback(const std::string& channel,
+                                    FlutterDesktopMessageCallback callback,
+                                    void* user_data);
+
   // Enables input blocking on the given channel name.
   //
   // If set, then the parent window should disable input callbacks
@@ -59,6 +74,9 @@ class IncomingMessageDispatcher {
   void EnableInputBlockingForChannel(const std::string& channel);
 
  private:
+  // Calls a channel's callback for its messages on a dedicated thread.
+  class BackgroundHandler;
+
   // Handle for interacting with the C messaging API.
   FlutterDesktopMessengerRef messenger_;
 
@@ -68,6 +86,11 @@ class IncomingMessageDispatcher {
   std::map<std::string, std::pair<FlutterDesktopMessageCallback, void*>>
       callbacks_;
 
+  // The handlers of the channels registered with
+  // SetBackgroundMessageCallback.
+  std::map<std::string, std::unique_ptr<BackgroundHandler>>
+      background_handlers_;
+
   // Channel names for which input blocking should be enabled during the call to
   // that channel's handler.
   std::set<std::string> input_blocking_channels_;
@@ -0,0 +1,129 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/incoming_message_dispatcher.h"
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "flutter/shell/platform/common/client_wrapper/testing/stub_flutter_api.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// A stub that records the handles of the messages that were responded to.
+class TestApi : public StubFlutterApi {
+ public:
+  void MessengerSendResponse(const FlutterDesktopMessageResponseHandle* handle,
+                             const uint8_t* data,
+                             size_t data_length) override {
+    std::scoped_lock lock(mutex_);
+    responded_handles_.push_back(handle);
+  }
+
+  std::vector<const FlutterDesktopMessageResponseHandle*> responded_handles() {
+    std::scoped_lock lock(mutex_);
+    return responded_handles_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<const FlutterDesktopMessageResponseHandle*> responded_handles_;
+};
+
+// What a background callback saw, and when its first call may return.
+struct CallbackState {
+  std::promise<std::pair<std::thread::id, std::string>> first_call;
+  std::promise<void> first_call_can_return;
+  std::atomic<int> calls = 0;
+};
+
+void RecordingCallback(FlutterDesktopMessengerRef messenger,
+                       const FlutterDesktopMessage* message,
+                       void* user_data) {
+  auto* state = static_cast<CallbackState*>(user_data);
+  if (state->calls++ > 0) {
+    return;
+  }
+  state->first_call.set_value(
+      {std::this_thread::get_id(),
+       std::string(message->message,
+                   message->message + message->message_size)});
+  state->first_call_can_return.get_future().wait();
+}
+
+FlutterDesktopMessage CreateMessage(const std::string& data, uintptr_t id) {
+  return {
+      sizeof(FlutterDesktopMessage),
+      "channel",
+      reinterpret_cast<const uint8_t*>(data.data()),
+      data.size(),
+      reinterpret_cast<const FlutterDesktopMessageResponseHandle*>(id),
+  };
+}
+
+}  // namespace
+
+// Tests that background callbacks are called with a copy of the message on
+// another thread, without blocking HandleMessage.
+TEST(IncomingMessageDispatcherTest, CallsBackgroundCallbackOnAnotherThread) {
+  ScopedStubFlutterApi scoped_api(std::make_unique<TestApi>());
+  IncomingMessageDispatcher dispatcher(
+      reinterpret_cast<FlutterDesktopMessengerRef>(1));
+  CallbackState state;
+  dispatcher.SetBackgroundMessageCallback("channel", RecordingCallback,
+                                          &state);
+
+  {
+    std::string data("hello");
+    dispatcher.HandleMessage(CreateMessage(data, 1));
+    data.assign("XXXXX");
+  }
+
+  auto [thread_id, data] = state.first_call.get_future().get();
+  EXPECT_NE(thread_id, std::this_thread::get_id());
+  EXPECT_EQ(data, "hello");
+  state.first_call_can_return.set_value();
+}
+
+// Tests that unregistering a background callback waits for the call in
+// progress, and responds to the messages still queued for it.
+TEST(IncomingMessageDispatcherTest, RespondsToQueuedMessagesOnUnregister) {
+  ScopedStubFlutterApi scoped_api(std::make_unique<TestApi>());
+  auto* api = static_cast<TestApi*>(scoped_api.stub());
+  IncomingMessageDispatcher dispatcher(
+      reinterpret_cast<FlutterDesktopMessengerRef>(1));
+  CallbackState state;
+  dispatcher.SetBackgroundMessageCallback("channel", RecordingCallback,
+                                          &state);
+
+  dispatcher.HandleMessage(CreateMessage("first", 1));
+  dispatcher.HandleMessage(CreateMessage("second", 2));
+  state.first_call.get_future().wait();
+
+  std::thread unblock([&state] { state.first_call_can_return.set_value(); });
+  dispatcher.SetBackgroundMessageCallback("channel", nullptr, nullptr);
+  unblock.join();
+
+  // The second message is either handled before the callback is unregistered
+  // or responded to after, but not both.
+  EXPECT_EQ(state.calls + api->responded_handles().size(), 2u);
+
+  // Messages to the unregistered channel are answered right away.
+  int calls = state.calls;
+  dispatcher.HandleMessage(CreateMessage("third", 3));
+  EXPECT_EQ(state.calls + api->responded_handles().size(), 3u);
+  EXPECT_EQ(state.calls, calls);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,15 +4,36 @@
 
 #include "flutter/shell/platform/common/json_message_codec.h"
 
+#include <cstring>
 #include <iostream>
 #include <string>
 
 #include "rapidjson/error/en.h"
-#include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 
 namespace flutter {
 
+namespace {
+
+// A RapidJSON output stream that writes to a byte vector, so that encoded
+// messages are written in place instead of being copied out of a buffer.
+class ByteVectorOutputStream {
+ public:
+  typedef char Ch;
+
+  explicit ByteVectorOutputStream(std::vector<uint8_t>* bytes)
+      : bytes_(bytes) {}
+
+  void Put(Ch c) { bytes_->push_back(static_cast<uint8_t>(c)); }
+
+  void Flush() {}
+
+ private:
+  std::vector<uint8_t>* bytes_;
+};
+
+}  // namespace
+
 // static
 const JsonMessageCodec& JsonMessageCodec::GetInstance() {
   static JsonMessageCodec sInstance;
@@ -21,24 +42,28 @@ const JsonMessageCodec& JsonMessageCodec::GetInstance() {
 
 std::unique_ptr<std::vector<uint8_t>> JsonMessageCodec::EncodeMessageInternal(
     const rapidjson::Document& message) const {
-  rapidjson::StringBuffer buffer;
-  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  auto encoded = std::make_unique<std::vector<uint8_t>>();
+  ByteVectorOutputStream stream(encoded.get());
+  rapidjson::Writer<ByteVectorOutputStream> writer(stream);
   // clang-tidy has trouble reasoning about some of the complicated array and
   // pointer-arithmetic code in rapidjson.
   // NOLINTNEXTLINE(clang-analyzer-core.*)
   message.Accept(writer);
-  const char* buffer_start = buffer.GetString();
-  return std::make_unique<std::vector<uint8_t>>(
-      buffer_start, buffer_start + buffer.GetSize());
+  return encoded;
 }
 
 std::unique_ptr<rapidjson::Document> JsonMessageCodec::DecodeMessageInternal(
     const uint8_t* binary_message,
     const size_t message_size) const {
-  auto raw_message = reinterpret_cast<const char*>(binary_message);
   auto json_message = std::make_unique<rapidjson::Document>();
-  rapidjson::ParseResult result =
-      json_message->Parse(raw_message, message_size);
+  // Parse a null-terminated copy of the message in situ, so that its strings
+  // are decoded in place rather than copied. The copy is allocated from the
+  // document's own pool, which keeps it alive as long as the document.
+  char* raw_message =
+      static_cast<char*>(json_message->GetAllocator().Malloc(message_size + 1));
+  std::memcpy(raw_message, binary_message, message_size);
+  raw_message[message_size] = '\0';
+  rapidjson::ParseResult result = json_message->ParseInsitu(raw_message);
   if (result.IsError()) {
     std::cerr << "Unable to parse JSON message:" << std::endl
               << rapidjson::GetParseError_En(result.Code()) << std::endl;
@@ -0,0 +1,55 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/json_message_codec.h"
+
+#include <string>
+
+#include "flutter/benchmarking/benchmarking.h"
+
+namespace flutter {
+
+// Builds an editing state like the ones the text input plugins send, with a
+// text of |size| characters.
+static rapidjson::Document MakeEditingState(int64_t size) {
+  rapidjson::Document document(rapidjson::kArrayType);
+  auto& allocator = document.GetAllocator();
+  document.PushBack(1, allocator);
+  rapidjson::Value state(rapidjson::kObjectType);
+  state.AddMember("selectionBase", 0, allocator);
+  state.AddMember("selectionExtent", 0, allocator);
+  state.AddMember("selectionAffinity", "TextAffinity.downstream", allocator);
+  state.AddMember("selectionIsDirectional", false, allocator);
+  state.AddMember("composingBase", -1, allocator);
+  state.AddMember("composingExtent", -1, allocator);
+  state.AddMember("text",
+                  rapidjson::Value(std::string(size, 'a'), allocator).Move(),
+                  allocator);
+  document.PushBack(state, allocator);
+  return document;
+}
+
+static void BM_EncodeEditingState(benchmark::State& state) {  // NOLINT
+  const JsonMessageCodec& codec = JsonMessageCodec::GetInstance();
+  rapidjson::Document value = MakeEditingState(state.range(0));
+  while (state.KeepRunning()) {
+    auto message = codec.EncodeMessage(value);
+    benchmark::DoNotOptimize(message);
+  }
+}
+
+static void BM_DecodeEditingState(benchmark::State& state) {  // NOLINT
+  const JsonMessageCodec& codec = JsonMessageCodec::GetInstance();
+  auto message = codec.EncodeMessage(MakeEditingState(state.range(0)));
+  while (state.KeepRunning()) {
+    auto decoded = codec.DecodeMessage(*message);
+    benchmark::DoNotOptimize(decoded);
+  }
+  state.SetBytesProcessed(state.iterations() * message->size());
+}
+
+BENCHMARK(BM_EncodeEditingState)->Range(64, 1 << 17);
+BENCHMARK(BM_DecodeEditingState)->Range(64, 1 << 17);
+
+}  // namespace flutter
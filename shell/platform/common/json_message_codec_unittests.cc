@@ -6,6 +6,8 @@
 
 #include <limits>
 #include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -44,4 +46,19 @@ TEST(JsonMessageCodec, EncodeDecode) {
   CheckEncodeDecode(array);
 }
 
+// Tests that decoded strings outlive the message they were decoded from, which
+// need not be null-terminated.
+TEST(JsonMessageCodec, DecodedStringsOutliveMessage) {
+  const JsonMessageCodec& codec = JsonMessageCodec::GetInstance();
+  auto message = std::make_unique<std::string>(
+      "{\"text\":\"caf\\u00e9 \\\"quoted\\\"\"}trailing");
+  size_t message_size = message->find('}') + 1;
+  auto decoded = codec.DecodeMessage(
+      reinterpret_cast<const uint8_t*>(message->data()), message_size);
+  message.reset();
+
+  ASSERT_TRUE(decoded);
+  EXPECT_STREQ((*decoded)["text"].GetString(), "caf\u00e9 \"quoted\"");
+}
+
 }  // namespace flutter
@@ -87,6 +87,23 @@ FLUTTER_EXPORT void FlutterDesktopMessengerSetCallback(
     FlutterDesktopMessageCallback callback,
     void* user_data);
 
+// Registers a callback function for incoming binary messages from the Flutter
+// side on the specified channel, to be called on a background thread
+// dedicated to that channel instead of the platform thread.
+//
+// Messages on the channel are handled one at a time, in the order they arrive.
+// Responses may be sent from the background thread.
+//
+// Replaces any existing callback, waiting for a call to it that is in
+// progress. Provide a null handler to unregister the existing callback.
+//
+// If |user_data| is provided, it will be passed in |callback| calls.
+FLUTTER_EXPORT void FlutterDesktopMessengerSetBackgroundCallback(
+    FlutterDesktopMessengerRef messenger,
+    const char* channel,
+    FlutterDesktopMessageCallback callback,
+    void* user_data);
+
 #if defined(__cplusplus)
 }  // extern "C"
 #endif
@@ -23,9 +23,24 @@ typedef struct FlutterDesktopTextureRegistrar*
 // Additional types may be added in the future.
 typedef enum {
   // A Pixel buffer-based texture.
-  kFlutterDesktopPixelBufferTexture
+  kFlutterDesktopPixelBufferTexture,
+  // A platform-specific GPU surface-backed texture.
+  kFlutterDesktopGpuSurfaceTexture
 } FlutterDesktopTextureType;
 
+// Supported GPU surface types.
+typedef enum {
+  // Uninitialized.
+  kFlutterDesktopGpuSurfaceTypeNone,
+  // A DXGI shared texture handle (Windows only), as returned by
+  // IDXGIResource::GetSharedHandle. See
+  // https://docs.microsoft.com/en-us/windows/win32/api/dxgi/nf-dxgi-idxgiresource-getsharedhandle
+  kFlutterDesktopGpuSurfaceTypeDxgiSharedHandle,
+  // A |ID3D11Texture2D| (Windows only) created with the
+  // D3D11_RESOURCE_MISC_SHARED or D3D11_RESOURCE_MISC_SHARED_KEYEDMUTEX flag.
+  kFlutterDesktopGpuSurfaceTypeD3d11Texture2D
+} FlutterDesktopGpuSurfaceType;
+
 // An image buffer object.
 typedef struct {
   // The pixel data buffer.
@@ -62,10 +77,69 @@ typedef struct {
   void* user_data;
 } FlutterDesktopPixelBufferTextureConfig;
 
+// A GPU surface descriptor.
+typedef struct {
+  // The size of this struct. Must be
+  // sizeof(FlutterDesktopGpuSurfaceDescriptor).
+  size_t struct_size;
+  // The surface handle. The expected type depends on the
+  // |FlutterDesktopGpuSurfaceType|.
+  //
+  // Provide a |ID3D11Texture2D*| when using
+  // |kFlutterDesktopGpuSurfaceTypeD3d11Texture2D| or a |HANDLE| when using
+  // |kFlutterDesktopGpuSurfaceTypeDxgiSharedHandle|.
+  //
+  // The surface must be in BGRA or RGBA format. It is sampled where it is,
+  // without being copied through the CPU, and must remain valid until the
+  // next frame is requested or the texture is unregistered.
+  //
+  // If the surface has a keyed mutex (D3D11_RESOURCE_MISC_SHARED_KEYEDMUTEX),
+  // Flutter acquires it with key 0 while copying the surface on the GPU and
+  // releases it with key 0 right after, so the producer can write the next
+  // frame while the current one is displayed. Otherwise, the producer must
+  // not write to the surface until the next frame is requested, and must
+  // flush its writes before marking the frame available.
+  void* handle;
+  // The physical width.
+  size_t width;
+  // The physical height.
+  size_t height;
+  // An optional callback that gets invoked when the |handle| has been
+  // consumed for the current frame.
+  void (*release_callback)(void* release_context);
+  // Opaque data passed to |release_callback|.
+  void* release_context;
+} FlutterDesktopGpuSurfaceDescriptor;
+
+// The callback provided to the GPU surface texture config. It is invoked with
+// the intended surface size specified by |width| and |height| and the
+// |user_data| held by FlutterDesktopGpuSurfaceTextureConfig.
+//
+// As this is usually called from the render thread, the callee must take
+// care of proper synchronization.
+typedef const FlutterDesktopGpuSurfaceDescriptor* (
+    *FlutterDesktopGpuSurfaceTextureCallback)(size_t width,
+                                              size_t height,
+                                              void* user_data);
+
+// An object used to configure GPU-surface textures.
+typedef struct {
+  // The size of this struct. Must be
+  // sizeof(FlutterDesktopGpuSurfaceTextureConfig).
+  size_t struct_size;
+  // The type of the GPU surface.
+  FlutterDesktopGpuSurfaceType type;
+  // The callback used by the engine to obtain the surface descriptor.
+  FlutterDesktopGpuSurfaceTextureCallback callback;
+  // Opaque data that will get passed to the provided |callback|.
+  void* user_data;
+} FlutterDesktopGpuSurfaceTextureConfig;
+
 typedef struct {
   FlutterDesktopTextureType type;
   union {
     FlutterDesktopPixelBufferTextureConfig pixel_buffer_config;
+    FlutterDesktopGpuSurfaceTextureConfig gpu_surface_config;
   };
 } FlutterDesktopTextureInfo;
 
@@ -0,0 +1,69 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_STATIC_KEY_MAP_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_STATIC_KEY_MAP_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace flutter {
+
+// A read-only map between key codes, such as from platform scan codes to
+// Flutter physical keys.
+//
+// The entries are an array sorted by key, so that the map is constant
+// initialized instead of being built at startup, and looked up with a binary
+// search that doesn't allocate.
+class StaticKeyMap {
+ public:
+  struct Entry {
+    uint64_t key;
+    uint64_t value;
+  };
+
+  template <size_t N>
+  constexpr StaticKeyMap(const Entry (&entries)[N])
+      : entries_(entries), size_(N) {}
+
+  // Returns whether the keys of the entries are strictly increasing, which
+  // |Find| relies on. Meant to be checked with a static_assert.
+  constexpr bool IsSorted() const {
+    for (size_t i = 1; i < size_; i++) {
+      if (entries_[i - 1].key >= entries_[i].key) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Returns the value mapped to |key| in |value| if there is one.
+  constexpr bool Find(uint64_t key, uint64_t* value) const {
+    size_t begin = 0;
+    size_t end = size_;
+    while (begin < end) {
+      size_t middle = begin + (end - begin) / 2;
+      if (entries_[middle].key < key) {
+        begin = middle + 1;
+      } else {
+        end = middle;
+      }
+    }
+    if (begin == size_ || entries_[begin].key != key) {
+      return false;
+    }
+    *value = entries_[begin].value;
+    return true;
+  }
+
+  constexpr size_t size() const { return size_; }
+
+ private:
+  const Entry* entries_;
+  size_t size_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_STATIC_KEY_MAP_H_
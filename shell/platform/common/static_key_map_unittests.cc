@@ -0,0 +1,54 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/static_key_map.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+namespace {
+constexpr StaticKeyMap::Entry kEntries[] = {
+    {0x00000001, 0x00070029},
+    {0x00000010, 0x00070014},
+    {0x0000e01d, 0x000700e4},
+    {0x1008ff8b, 0x0010000050d},
+};
+constexpr StaticKeyMap kMap(kEntries);
+static_assert(kMap.IsSorted());
+}  // namespace
+
+TEST(StaticKeyMap, FindsEveryEntry) {
+  for (const auto& entry : kEntries) {
+    uint64_t value = 0;
+    EXPECT_TRUE(kMap.Find(entry.key, &value));
+    EXPECT_EQ(value, entry.value);
+  }
+}
+
+TEST(StaticKeyMap, MissingKeys) {
+  uint64_t value = 0x42;
+  EXPECT_FALSE(kMap.Find(0x00000000, &value));
+  EXPECT_FALSE(kMap.Find(0x00000002, &value));
+  EXPECT_FALSE(kMap.Find(0xffffffff, &value));
+  EXPECT_EQ(value, 0x42u);
+}
+
+TEST(StaticKeyMap, LooksUpAtCompileTime) {
+  constexpr uint64_t value = []() {
+    uint64_t value = 0;
+    kMap.Find(0x0000e01d, &value);
+    return value;
+  }();
+  EXPECT_EQ(value, 0x000700e4u);
+}
+
+TEST(StaticKeyMap, DetectsUnsortedEntries) {
+  constexpr StaticKeyMap::Entry unsorted[] = {{2, 0}, {1, 0}};
+  constexpr StaticKeyMap::Entry duplicated[] = {{1, 0}, {1, 0}};
+  EXPECT_FALSE(StaticKeyMap(unsorted).IsSorted());
+  EXPECT_FALSE(StaticKeyMap(duplicated).IsSorted());
+}
+
+}  // namespace flutter
@@ -28,7 +28,7 @@ class NSDataMapping : public fml::Mapping {
 
 fml::MallocMapping CopyNSDataToMapping(NSData* data) {
   const uint8_t* bytes = static_cast<const uint8_t*>(data.bytes);
-  return fml::MallocMapping::Copy(bytes, data.length);
+  return fml::MallocMapping::CopyPooled(bytes, data.length);
 }
 
 NSData* ConvertMappingToNSData(fml::MallocMapping buffer) {
@@ -50,6 +50,14 @@ FLUTTER_DARWIN_EXPORT
 @optional
 - (NSObject<FlutterTaskQueue>*)makeBackgroundTaskQueue;
 
+/**
+ * Creates a task queue whose handlers run on background threads concurrently with each other.
+ *
+ * Messages on a channel that uses this queue may be handled in parallel and complete out of
+ * order, so it is only suited to stateless handlers. Only implemented on macOS.
+ */
+- (NSObject<FlutterTaskQueue>*)makeBackgroundConcurrentTaskQueue;
+
 - (FlutterBinaryMessengerConnection)
     setMessageHandlerOnChannel:(NSString*)channel
           binaryMessageHandler:(FlutterBinaryMessageHandler _Nullable)handler
@@ -17,11 +17,31 @@
                             width:(size_t)width
                            height:(size_t)height;
 
+// Like |wrapYUVATexture:UVTex:grContext:width:height:|, but the release proc is called with the
+// release context once the GPU is done with the textures, or right away if the image could not be
+// created.
++ (sk_sp<SkImage>)wrapYUVATexture:(nonnull id<MTLTexture>)yTex
+                            UVTex:(nonnull id<MTLTexture>)uvTex
+                        grContext:(nonnull GrDirectContext*)grContext
+                            width:(size_t)width
+                           height:(size_t)height
+                      releaseProc:(nullable SkImage::TextureReleaseProc)releaseProc
+                   releaseContext:(nullable SkImage::ReleaseContext)releaseContext;
+
 + (sk_sp<SkImage>)wrapRGBATexture:(nonnull id<MTLTexture>)rgbaTex
                         grContext:(nonnull GrDirectContext*)grContext
                             width:(size_t)width
                            height:(size_t)height;
 
+// Like |wrapRGBATexture:grContext:width:height:|, but the release proc is called with the release
+// context once the GPU is done with the texture, or right away if the image could not be created.
++ (sk_sp<SkImage>)wrapRGBATexture:(nonnull id<MTLTexture>)rgbaTex
+                        grContext:(nonnull GrDirectContext*)grContext
+                            width:(size_t)width
+                           height:(size_t)height
+                      releaseProc:(nullable SkImage::TextureReleaseProc)releaseProc
+                   releaseContext:(nullable SkImage::ReleaseContext)releaseContext;
+
 @end
 
 @interface FlutterDarwinExternalTextureMetal : NSObject
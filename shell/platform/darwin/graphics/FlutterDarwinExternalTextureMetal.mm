@@ -4,6 +4,9 @@
 
 #import "flutter/shell/platform/darwin/graphics/FlutterDarwinExternalTextureMetal.h"
 
+#include <initializer_list>
+#include <vector>
+
 #include "flutter/fml/logging.h"
 #import "flutter/shell/platform/darwin/common/framework/Headers/FlutterMacros.h"
 #include "third_party/skia/include/core/SkYUVAInfo.h"
@@ -14,6 +17,24 @@
 
 FLUTTER_ASSERT_ARC
 
+namespace {
+
+// Releases the Core Video objects backing the textures of an image. The cache only reuses the
+// storage of a texture once its CVMetalTextureRef is released, which must not happen while the GPU
+// may still read from it.
+void ReleaseCVBuffers(SkImage::ReleaseContext context) {
+  CFRelease(static_cast<CFArrayRef>(context));
+}
+
+// Retains the buffers until |ReleaseCVBuffers| is called with the result.
+SkImage::ReleaseContext RetainCVBuffers(std::initializer_list<CVBufferRef> buffers) {
+  std::vector<const void*> values(buffers.begin(), buffers.end());
+  return const_cast<void*>(static_cast<const void*>(CFArrayCreate(
+      kCFAllocatorDefault, values.data(), values.size(), &kCFTypeArrayCallBacks)));
+}
+
+}  // namespace
+
 @implementation FlutterDarwinExternalTextureMetal {
   CVMetalTextureCacheRef _textureCache;
   NSObject<FlutterTexture>* _externalTexture;
@@ -174,21 +195,28 @@ FLUTTER_ASSERT_ARC
 
     if (cvReturn != kCVReturnSuccess) {
       FML_DLOG(ERROR) << "Could not create Metal texture from pixel buffer: CVReturn " << cvReturn;
+      CVBufferRelease(yMetalTexture);
       return nullptr;
     }
   }
 
   id<MTLTexture> yTex = CVMetalTextureGetTexture(yMetalTexture);
-  CVBufferRelease(yMetalTexture);
-
   id<MTLTexture> uvTex = CVMetalTextureGetTexture(uvMetalTexture);
+
+  // The textures stay in use by the frames in flight after the image is replaced, so they are
+  // only released back to the cache once the GPU completed the last of them.
+  SkImage::ReleaseContext releaseContext =
+      RetainCVBuffers({yMetalTexture, uvMetalTexture, pixelBuffer});
+  CVBufferRelease(yMetalTexture);
   CVBufferRelease(uvMetalTexture);
 
   return [FlutterDarwinExternalTextureSkImageWrapper wrapYUVATexture:yTex
                                                                UVTex:uvTex
                                                            grContext:grContext
                                                                width:textureSize.width()
-                                                              height:textureSize.height()];
+                                                              height:textureSize.height()
+                                                         releaseProc:ReleaseCVBuffers
+                                                      releaseContext:releaseContext];
 }
 
 - (sk_sp<SkImage>)wrapRGBAExternalPixelBuffer:(CVPixelBufferRef)pixelBuffer
@@ -213,12 +241,16 @@ FLUTTER_ASSERT_ARC
   }
 
   id<MTLTexture> rgbaTex = CVMetalTextureGetTexture(metalTexture);
+
+  SkImage::ReleaseContext releaseContext = RetainCVBuffers({metalTexture, pixelBuffer});
   CVBufferRelease(metalTexture);
 
   return [FlutterDarwinExternalTextureSkImageWrapper wrapRGBATexture:rgbaTex
                                                            grContext:grContext
                                                                width:textureSize.width()
-                                                              height:textureSize.height()];
+                                                              height:textureSize.height()
+                                                         releaseProc:ReleaseCVBuffers
+                                                      releaseContext:releaseContext];
 }
 
 @end
@@ -230,6 +262,22 @@ FLUTTER_ASSERT_ARC
                         grContext:(nonnull GrDirectContext*)grContext
                             width:(size_t)width
                            height:(size_t)height {
+  return [self wrapYUVATexture:yTex
+                         UVTex:uvTex
+                     grContext:grContext
+                         width:width
+                        height:height
+                   releaseProc:nullptr
+                releaseContext:nullptr];
+}
+
++ (sk_sp<SkImage>)wrapYUVATexture:(id<MTLTexture>)yTex
+                            UVTex:(id<MTLTexture>)uvTex
+                        grContext:(nonnull GrDirectContext*)grContext
+                            width:(size_t)width
+                           height:(size_t)height
+                      releaseProc:(nullable SkImage::TextureReleaseProc)releaseProc
+                   releaseContext:(nullable SkImage::ReleaseContext)releaseContext {
   GrMtlTextureInfo ySkiaTextureInfo;
   ySkiaTextureInfo.fTexture = sk_cfp<const void*>{(__bridge_retained const void*)yTex};
 
@@ -252,13 +300,27 @@ FLUTTER_ASSERT_ARC
                                             kTopLeft_GrSurfaceOrigin);
 
   return SkImage::MakeFromYUVATextures(grContext, yuvaBackendTextures, /*imageColorSpace=*/nullptr,
-                                       /*releaseProc*/ nullptr, /*releaseContext*/ nullptr);
+                                       releaseProc, releaseContext);
 }
 
 + (sk_sp<SkImage>)wrapRGBATexture:(id<MTLTexture>)rgbaTex
                         grContext:(nonnull GrDirectContext*)grContext
                             width:(size_t)width
                            height:(size_t)height {
+  return [self wrapRGBATexture:rgbaTex
+                     grContext:grContext
+                         width:width
+                        height:height
+                   releaseProc:nullptr
+                releaseContext:nullptr];
+}
+
++ (sk_sp<SkImage>)wrapRGBATexture:(id<MTLTexture>)rgbaTex
+                        grContext:(nonnull GrDirectContext*)grContext
+                            width:(size_t)width
+                           height:(size_t)height
+                      releaseProc:(nullable SkImage::TextureReleaseProc)releaseProc
+                   releaseContext:(nullable SkImage::ReleaseContext)releaseContext {
   GrMtlTextureInfo skiaTextureInfo;
   skiaTextureInfo.fTexture = sk_cfp<const void*>{(__bridge_retained const void*)rgbaTex};
 
@@ -269,7 +331,6 @@ FLUTTER_ASSERT_ARC
 
   return SkImage::MakeFromTexture(grContext, skiaBackendTexture, kTopLeft_GrSurfaceOrigin,
                                   kBGRA_8888_SkColorType, kPremul_SkAlphaType,
-                                  /*imageColorSpace=*/nullptr, /*releaseProc*/ nullptr,
-                                  /*releaseContext*/ nullptr);
+                                  /*imageColorSpace=*/nullptr, releaseProc, releaseContext);
 }
 @end
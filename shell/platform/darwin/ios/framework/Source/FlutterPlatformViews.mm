@@ -4,10 +4,10 @@
 
 #import <UIKit/UIGestureRecognizerSubclass.h>
 
-#include <list>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/flow/rtree.h"
@@ -18,9 +18,39 @@
 #import "flutter/shell/platform/darwin/ios/framework/Source/FlutterViewController_Internal.h"
 #import "flutter/shell/platform/darwin/ios/ios_surface.h"
 #import "flutter/shell/platform/darwin/ios/ios_surface_gl.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkSerialProcs.h"
+#include "third_party/skia/include/core/SkTypeface.h"
 
 namespace flutter {
 
+namespace {
+
+// Serializes the picture to compare it with the picture of another frame. The images and the
+// typefaces are identified by their ids instead of their contents, like in `PictureLayer`.
+sk_sp<SkData> SerializePicture(const sk_sp<SkPicture>& picture) {
+  SkSerialProcs procs = {
+      nullptr,
+      nullptr,
+      [](SkImage* image, void* ctx) {
+        auto id = image->uniqueID();
+        return SkData::MakeWithCopy(&id, sizeof(id));
+      },
+      nullptr,
+      [](SkTypeface* typeface, void* ctx) {
+        auto id = typeface->uniqueID();
+        return SkData::MakeWithCopy(&id, sizeof(id));
+      },
+      nullptr,
+  };
+  return picture->serialize(&procs);
+}
+
+}  // namespace
+
+FlutterPlatformViewLayerPool::FlutterPlatformViewLayerPool(size_t max_idle_frames)
+    : max_idle_frames_(max_idle_frames) {}
+
 std::shared_ptr<FlutterPlatformViewLayer> FlutterPlatformViewLayerPool::GetLayer(
     GrDirectContext* gr_context,
     std::shared_ptr<IOSContext> ios_context) {
@@ -80,12 +110,24 @@ std::shared_ptr<FlutterPlatformViewLayer> FlutterPlatformViewLayerPool::GetLayer
     IOSSurface* ios_surface = layer->ios_surface.get();
     std::unique_ptr<Surface> surface = ios_surface->CreateGPUSurface(gr_context);
     layer->surface = std::move(surface);
+    // The new surface has no contents yet.
+    layer->picture_data = nullptr;
   }
+  layer->idle_frames = 0;
   available_layer_index_++;
   return layer;
 }
 
 void FlutterPlatformViewLayerPool::RecycleLayers() {
+  for (size_t i = available_layer_index_; i < layers_.size(); i++) {
+    layers_[i]->idle_frames++;
+  }
+  // The layers are handed out in order, so the ones that were idle the longest are at the end.
+  while (!layers_.empty() && layers_.size() > available_layer_index_ &&
+         layers_.back()->idle_frames > max_idle_frames_) {
+    [layers_.back()->overlay_view_wrapper removeFromSuperview];
+    layers_.pop_back();
+  }
   available_layer_index_ = 0;
 }
 
@@ -277,7 +319,8 @@ PostPrerollResult FlutterPlatformViewsController::PostPrerollAction(
     // Eventually, the frame is submitted once this method returns `kSuccess`.
     // At that point, the raster tasks are handled on the platform thread.
     CancelFrame();
-    raster_thread_merger->MergeWithLease(kDefaultMergedLeaseDuration);
+    raster_thread_merger->MergeWithLease(
+        raster_thread_merger->GetAdaptiveLeaseTerm(kDefaultMergedLeaseDuration));
     return PostPrerollResult::kSkipAndRetryFrame;
   }
   // If the post preroll action is successful, we will display platform views in the current frame.
@@ -285,7 +328,8 @@ PostPrerollResult FlutterPlatformViewsController::PostPrerollAction(
   // We need to begin an explicit CATransaction. This transaction needs to be submitted
   // after the current frame is submitted.
   BeginCATransaction();
-  raster_thread_merger->ExtendLeaseTo(kDefaultMergedLeaseDuration);
+  raster_thread_merger->ExtendLeaseTo(
+      raster_thread_merger->GetAdaptiveLeaseTerm(kDefaultMergedLeaseDuration));
   return PostPrerollResult::kSuccess;
 }
 
@@ -489,14 +533,16 @@ bool FlutterPlatformViewsController::SubmitFrame(GrDirectContext* gr_context,
     int64_t platform_view_id = composition_order_[i];
     sk_sp<RTree> rtree = platform_view_rtrees_[platform_view_id];
     sk_sp<SkPicture> picture = picture_recorders_[platform_view_id]->finishRecordingAsPicture();
+    // Serialized on demand, only if the picture is drawn on overlays.
+    sk_sp<SkData> picture_data;
+    std::vector<SkRect> intersection_rects;
 
     // Check if the current picture contains overlays that intersect with the
     // current platform view or any of the previous platform views.
     for (size_t j = i + 1; j > 0; j--) {
       int64_t current_platform_view_id = composition_order_[j - 1];
       SkRect platform_view_rect = GetPlatformViewRect(current_platform_view_id);
-      std::list<SkRect> intersection_rects =
-          rtree->searchNonOverlappingDrawnRects(platform_view_rect);
+      rtree->searchNonOverlappingDrawnRects(platform_view_rect, &intersection_rects);
       auto allocation_size = intersection_rects.size();
 
       // For testing purposes, the overlay id is used to find the overlay view.
@@ -530,10 +576,14 @@ bool FlutterPlatformViewsController::SubmitFrame(GrDirectContext* gr_context,
         // Clip the background canvas, so it doesn't contain any of the pixels drawn
         // on the overlay layer.
         background_canvas->clipRect(joined_rect, SkClipOp::kDifference);
+        if (!picture_data) {
+          picture_data = SerializePicture(picture);
+        }
         // Get a new host layer.
         std::shared_ptr<FlutterPlatformViewLayer> layer = GetLayer(gr_context,                //
                                                                    ios_context,               //
                                                                    picture,                   //
+                                                                   picture_data,              //
                                                                    joined_rect,               //
                                                                    current_platform_view_id,  //
                                                                    overlay_id                 //
@@ -597,6 +647,7 @@ std::shared_ptr<FlutterPlatformViewLayer> FlutterPlatformViewsController::GetLay
     GrDirectContext* gr_context,
     std::shared_ptr<IOSContext> ios_context,
     sk_sp<SkPicture> picture,
+    sk_sp<SkData> picture_data,
     SkRect rect,
     int64_t view_id,
     int64_t overlay_id) {
@@ -618,6 +669,13 @@ std::shared_ptr<FlutterPlatformViewLayer> FlutterPlatformViewsController::GetLay
   // This size is equal to the device screen size.
   overlay_view.frame = flutter_view_.get().bounds;
 
+  // The overlay still shows the same pixels, so presenting them again would only cost GPU time.
+  if (layer->did_submit_last_frame && layer->frame_size == frame_size_ &&
+      layer->picture_rect == rect && layer->picture_data && picture_data &&
+      layer->picture_data->equals(picture_data.get())) {
+    return layer;
+  }
+
   std::unique_ptr<SurfaceFrame> frame = layer->surface->AcquireFrame(frame_size_);
   // If frame is null, AcquireFrame already printed out an error message.
   if (!frame) {
@@ -631,6 +689,9 @@ std::shared_ptr<FlutterPlatformViewLayer> FlutterPlatformViewsController::GetLay
   overlay_canvas->drawPicture(picture);
 
   layer->did_submit_last_frame = frame->Submit();
+  layer->picture_data = std::move(picture_data);
+  layer->picture_rect = rect;
+  layer->frame_size = frame_size_;
   return layer;
 }
 
@@ -14,6 +14,7 @@
 #import "flutter/shell/platform/darwin/ios/framework/Headers/FlutterPlatformViews.h"
 #import "flutter/shell/platform/darwin/ios/framework/Headers/FlutterPlugin.h"
 #import "flutter/shell/platform/darwin/ios/ios_context.h"
+#include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
 
 @class FlutterTouchInterceptingView;
@@ -78,6 +79,15 @@ struct FlutterPlatformViewLayer {
   // Whether a frame for this layer was submitted.
   bool did_submit_last_frame;
 
+  // The serialized picture, the rect and the frame size the contents of the overlay were last
+  // rendered with. The overlay isn't rendered again while they are unchanged.
+  sk_sp<SkData> picture_data;
+  SkRect picture_rect = SkRect::MakeEmpty();
+  SkISize frame_size = SkISize::MakeEmpty();
+
+  // The number of consecutive frames the layer wasn't used in.
+  size_t idle_frames = 0;
+
   // The GrContext that is currently used by the overlay surfaces.
   // We track this to know when the GrContext for the Flutter app has changed
   // so we can update the overlay with the new context.
@@ -87,7 +97,10 @@ struct FlutterPlatformViewLayer {
 // This class isn't thread safe.
 class FlutterPlatformViewLayerPool {
  public:
-  FlutterPlatformViewLayerPool() = default;
+  // The number of frames a layer is kept for after it was last used by default.
+  static const size_t kDefaultMaxIdleFrames = 60;
+
+  explicit FlutterPlatformViewLayerPool(size_t max_idle_frames = kDefaultMaxIdleFrames);
 
   ~FlutterPlatformViewLayerPool() = default;
 
@@ -101,6 +114,8 @@ class FlutterPlatformViewLayerPool {
   std::vector<std::shared_ptr<FlutterPlatformViewLayer>> GetUnusedLayers();
 
   // Marks the layers in the pool as available for reuse.
+  //
+  // The layers that weren't used for more than `max_idle_frames` frames in a row are released.
   void RecycleLayers();
 
  private:
@@ -118,6 +133,7 @@ class FlutterPlatformViewLayerPool {
   /// cannot be reused.
   size_t available_layer_index_ = 0;
   std::vector<std::shared_ptr<FlutterPlatformViewLayer>> layers_;
+  const size_t max_idle_frames_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(FlutterPlatformViewLayerPool);
 };
@@ -218,9 +234,13 @@ class FlutterPlatformViewsController {
 
   // Allocates a new FlutterPlatformViewLayer if needed, draws the pixels within the rect from
   // the picture on the layer's canvas.
+  //
+  // The pixels aren't drawn again if the layer already shows them, which is the case when the
+  // serialized picture and the rect are the same as when the layer was last drawn.
   std::shared_ptr<FlutterPlatformViewLayer> GetLayer(GrDirectContext* gr_context,
                                                      std::shared_ptr<IOSContext> ios_context,
                                                      sk_sp<SkPicture> picture,
+                                                     sk_sp<SkData> picture_data,
                                                      SkRect rect,
                                                      int64_t view_id,
                                                      int64_t overlay_id);
@@ -278,6 +298,9 @@ class FlutterPlatformViewsController {
   //
   // Note: this is an arbitrary number that attempts to account for cases
   // where the platform view might be momentarily off the screen.
+  //
+  // The lease is scaled by |RasterThreadMerger::GetAdaptiveLeaseTerm| when
+  // platform views come and go often.
   static const int kDefaultMergedLeaseDuration = 10;
 
   // Method channel `OnDispose` calls adds the views to be disposed to this set to be disposed on
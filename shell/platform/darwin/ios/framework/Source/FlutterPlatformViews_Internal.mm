@@ -19,7 +19,8 @@ FlutterPlatformViewLayer::FlutterPlatformViewLayer(
     : overlay_view(std::move(overlay_view)),
       overlay_view_wrapper(std::move(overlay_view_wrapper)),
       ios_surface(std::move(ios_surface)),
-      surface(std::move(surface)){};
+      surface(std::move(surface)),
+      did_submit_last_frame(false){};
 
 FlutterPlatformViewLayer::~FlutterPlatformViewLayer() = default;
 
@@ -77,9 +77,14 @@ class FlutterCompositor {
 
   // Creates a CALayer object which is backed by the supplied IOSurface, and
   // adds it to the root CALayer for this FlutterViewController's view.
+  //
+  // `contents_rect` is the portion of the IOSurface, in unit coordinates, that
+  // holds the content. It is smaller than the unit rectangle when the IOSurface
+  // was allocated larger than the layer it backs.
   void InsertCALayerForIOSurface(
       const IOSurfaceRef& io_surface,
-      CATransform3D transform = CATransform3DIdentity);
+      CATransform3D transform = CATransform3DIdentity,
+      CGRect contents_rect = CGRectMake(0, 0, 1, 1));
 
  private:
   // A list of the active CALayer objects for the frame that need to be removed.
@@ -44,11 +44,13 @@ FlutterCompositor::FrameStatus FlutterCompositor::GetFrameStatus() {
 }
 
 void FlutterCompositor::InsertCALayerForIOSurface(const IOSurfaceRef& io_surface,
-                                                  CATransform3D transform) {
+                                                  CATransform3D transform,
+                                                  CGRect contents_rect) {
   // FlutterCompositor manages the lifecycle of CALayers.
   CALayer* content_layer = [[CALayer alloc] init];
   content_layer.transform = transform;
   content_layer.frame = view_controller_.flutterView.layer.bounds;
+  content_layer.contentsRect = contents_rect;
   [content_layer setContents:(__bridge id)io_surface];
   [view_controller_.flutterView.layer addSublayer:content_layer];
 
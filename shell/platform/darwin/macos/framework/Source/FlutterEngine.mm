@@ -17,6 +17,7 @@
 #import "flutter/shell/platform/darwin/macos/framework/Source/FlutterOpenGLRenderer.h"
 #import "flutter/shell/platform/darwin/macos/framework/Source/FlutterPlatformViewController.h"
 #import "flutter/shell/platform/darwin/macos/framework/Source/FlutterRenderingBackend.h"
+#import "flutter/shell/platform/darwin/macos/framework/Source/FlutterVSyncWaiter.h"
 #import "flutter/shell/platform/darwin/macos/framework/Source/FlutterViewController_Internal.h"
 #include "flutter/shell/platform/embedder/embedder.h"
 
@@ -36,25 +37,61 @@ static FlutterLocale FlutterLocaleFromNSLocale(NSLocale* locale) {
 
 #pragma mark -
 
+@protocol FlutterTaskQueue <NSObject>
+- (void)dispatch:(dispatch_block_t)block;
+@end
+
+// A task queue that runs the message handlers set with it on a dispatch queue.
+@interface FlutterDispatchTaskQueue : NSObject <FlutterTaskQueue>
+
+- (instancetype)initWithQueue:(dispatch_queue_t)queue;
+
+@end
+
+@implementation FlutterDispatchTaskQueue {
+  dispatch_queue_t _queue;
+}
+
+- (instancetype)initWithQueue:(dispatch_queue_t)queue {
+  self = [super init];
+  if (self) {
+    _queue = queue;
+  }
+  return self;
+}
+
+- (void)dispatch:(dispatch_block_t)block {
+  dispatch_async(_queue, block);
+}
+
+@end
+
+#pragma mark -
+
 // Records an active handler of the messenger (FlutterEngine) that listens to
 // platform messages on a given channel.
 @interface FlutterEngineHandlerInfo : NSObject
 
 - (instancetype)initWithConnection:(NSNumber*)connection
-                           handler:(FlutterBinaryMessageHandler)handler;
+                           handler:(FlutterBinaryMessageHandler)handler
+                         taskQueue:(NSObject<FlutterTaskQueue>*)taskQueue;
 
 @property(nonatomic, readonly) FlutterBinaryMessageHandler handler;
 @property(nonatomic, readonly) NSNumber* connection;
+// The queue the handler runs on, or nil to run it on the main thread.
+@property(nonatomic, readonly) NSObject<FlutterTaskQueue>* taskQueue;
 
 @end
 
 @implementation FlutterEngineHandlerInfo
 - (instancetype)initWithConnection:(NSNumber*)connection
-                           handler:(FlutterBinaryMessageHandler)handler {
+                           handler:(FlutterBinaryMessageHandler)handler
+                         taskQueue:(NSObject<FlutterTaskQueue>*)taskQueue {
   self = [super init];
   NSAssert(self, @"Super init cannot be nil");
   _connection = connection;
   _handler = handler;
+  _taskQueue = taskQueue;
   return self;
 }
 @end
@@ -101,6 +138,24 @@ static FlutterLocale FlutterLocaleFromNSLocale(NSLocale* locale) {
  */
 - (void)setUpPlatformViewChannel;
 
+/**
+ * Returns the display that the window of the view controller is on, or the main display if there
+ * is no such window.
+ */
+- (CGDirectDisplayID)currentDisplayID;
+
+/**
+ * Makes the vsync waiter follow the display of the view controller's window.
+ */
+- (void)updateVSyncDisplay;
+
+/**
+ * Forwards a vsync from the vsync waiter to the engine. Called on the display link thread.
+ */
+- (void)onVSync:(intptr_t)baton
+         targetDelayNanos:(uint64_t)targetDelayNanos
+       refreshPeriodNanos:(uint64_t)refreshPeriodNanos;
+
 @end
 
 #pragma mark -
@@ -205,6 +260,9 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
   // Used to support creation and deletion of platform views and registering platform view
   // factories. Lifecycle is tied to the engine.
   FlutterPlatformViewController* _platformViewController;
+
+  // Delivers the vsyncs of the display the view controller's window is on to the engine.
+  FlutterVSyncWaiter* _vsyncWaiter;
 }
 
 - (instancetype)initWithName:(NSString*)labelPrefix project:(FlutterDartProject*)project {
@@ -237,6 +295,10 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
                          selector:@selector(sendUserLocales)
                              name:NSCurrentLocaleDidChangeNotification
                            object:nil];
+  [notificationCenter addObserver:self
+                         selector:@selector(windowDidChangeScreen:)
+                             name:NSWindowDidChangeScreenNotification
+                           object:nil];
 
   _platformViewController = [[FlutterPlatformViewController alloc] init];
   [self setUpPlatformViewChannel];
@@ -331,6 +393,21 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
     [engine engineCallbackOnPreEngineRestart];
   };
 
+  __weak FlutterEngine* weakSelf = self;
+  _vsyncWaiter = [[FlutterVSyncWaiter alloc]
+      initWithCallback:^(intptr_t baton, uint64_t targetDelayNanos, uint64_t refreshPeriodNanos) {
+        [weakSelf onVSync:baton
+              targetDelayNanos:targetDelayNanos
+            refreshPeriodNanos:refreshPeriodNanos];
+      }];
+  if (_vsyncWaiter) {
+    [self updateVSyncDisplay];
+    flutterArguments.vsync_callback = [](void* user_data, intptr_t baton) {
+      FlutterEngine* engine = (__bridge FlutterEngine*)user_data;
+      [engine->_vsyncWaiter waitForVSync:baton];
+    };
+  }
+
   FlutterRendererConfig rendererConfig = [_renderer createRendererConfig];
   FlutterEngineResult result = _embedderAPI.Initialize(
       FLUTTER_ENGINE_VERSION, &rendererConfig, &flutterArguments, (__bridge void*)(self), &_engine);
@@ -381,6 +458,7 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
   if (_viewController != controller) {
     _viewController = controller;
     [_renderer setFlutterView:controller.flutterView];
+    [self updateVSyncDisplay];
 
     if (_semanticsEnabled && _bridge) {
       _bridge->UpdateDelegate(
@@ -481,16 +559,18 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
     return;
   }
 
+  // The refresh rate reported here only lasts until the first vsync, after which the engine
+  // follows the refresh period of the display the window is on.
   CVDisplayLinkRef displayLinkRef;
-  CGDirectDisplayID mainDisplayID = CGMainDisplayID();
-  CVDisplayLinkCreateWithCGDisplay(mainDisplayID, &displayLinkRef);
+  CGDirectDisplayID displayID = [self currentDisplayID];
+  CVDisplayLinkCreateWithCGDisplay(displayID, &displayLinkRef);
   CVTime nominal = CVDisplayLinkGetNominalOutputVideoRefreshPeriod(displayLinkRef);
   if (!(nominal.flags & kCVTimeIsIndefinite)) {
     double refreshRate = static_cast<double>(nominal.timeScale) / nominal.timeValue;
 
-    FlutterEngineDisplay display;
+    FlutterEngineDisplay display = {};
     display.struct_size = sizeof(display);
-    display.display_id = mainDisplayID;
+    display.display_id = displayID;
     display.refresh_rate = round(refreshRate);
 
     std::vector<FlutterEngineDisplay> displays = {display};
@@ -501,6 +581,34 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
   CVDisplayLinkRelease(displayLinkRef);
 }
 
+- (CGDirectDisplayID)currentDisplayID {
+  NSScreen* screen = _viewController.flutterView.window.screen;
+  if (!screen) {
+    return CGMainDisplayID();
+  }
+  return [screen.deviceDescription[@"NSScreenNumber"] unsignedIntValue];
+}
+
+- (void)updateVSyncDisplay {
+  [_vsyncWaiter setDisplayID:[self currentDisplayID]];
+}
+
+- (void)windowDidChangeScreen:(NSNotification*)notification {
+  if (notification.object == _viewController.flutterView.window) {
+    [self updateVSyncDisplay];
+  }
+}
+
+- (void)onVSync:(intptr_t)baton
+         targetDelayNanos:(uint64_t)targetDelayNanos
+       refreshPeriodNanos:(uint64_t)refreshPeriodNanos {
+  // The display link clock is not the engine clock, only the delay until the frame is displayed
+  // carries over.
+  uint64_t targetTime = _embedderAPI.GetCurrentTime() + targetDelayNanos;
+  uint64_t startTime = targetTime > refreshPeriodNanos ? targetTime - refreshPeriodNanos : 0;
+  _embedderAPI.OnVsync(_engine, baton, startTime, targetTime);
+}
+
 - (FlutterEngineProcTable&)embedderAPI {
   return _embedderAPI;
 }
@@ -593,13 +701,21 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
 }
 
 - (void)engineCallbackOnPlatformMessage:(const FlutterPlatformMessage*)message {
+  NSString* channel = @(message->channel);
+  FlutterEngineHandlerInfo* handlerInfo = _messengerHandlers[channel];
+
+  // The message is only valid for the duration of this call, handlers that run on a task queue
+  // get a copy.
   NSData* messageData = nil;
   if (message->message_size > 0) {
-    messageData = [NSData dataWithBytesNoCopy:(void*)message->message
-                                       length:message->message_size
-                                 freeWhenDone:NO];
+    if (handlerInfo.taskQueue) {
+      messageData = [NSData dataWithBytes:message->message length:message->message_size];
+    } else {
+      messageData = [NSData dataWithBytesNoCopy:(void*)message->message
+                                         length:message->message_size
+                                   freeWhenDone:NO];
+    }
   }
-  NSString* channel = @(message->channel);
   __block const FlutterPlatformMessageResponseHandle* responseHandle = message->response_handle;
 
   FlutterBinaryReply binaryResponseHandler = ^(NSData* response) {
@@ -615,8 +731,12 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
     }
   };
 
-  FlutterEngineHandlerInfo* handlerInfo = _messengerHandlers[channel];
-  if (handlerInfo) {
+  if (handlerInfo.taskQueue) {
+    FlutterBinaryMessageHandler handler = handlerInfo.handler;
+    [handlerInfo.taskQueue dispatch:^{
+      handler(messageData, binaryResponseHandler);
+    }];
+  } else if (handlerInfo) {
     handlerInfo.handler(messageData, binaryResponseHandler);
   } else {
     binaryResponseHandler(nil);
@@ -641,6 +761,9 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
     [_viewController.flutterView shutdown];
   }
 
+  // No vsync may reach the engine once it starts shutting down.
+  [_vsyncWaiter invalidate];
+
   FlutterEngineResult result = _embedderAPI.Deinitialize(_engine);
   if (result != kSuccess) {
     NSLog(@"Could not de-initialize the Flutter engine: error %d", result);
@@ -729,13 +852,33 @@ static void OnPlatformMessage(const FlutterPlatformMessage* message, FlutterEngi
 - (FlutterBinaryMessengerConnection)setMessageHandlerOnChannel:(nonnull NSString*)channel
                                           binaryMessageHandler:
                                               (nullable FlutterBinaryMessageHandler)handler {
+  return [self setMessageHandlerOnChannel:channel binaryMessageHandler:handler taskQueue:nil];
+}
+
+- (FlutterBinaryMessengerConnection)
+    setMessageHandlerOnChannel:(nonnull NSString*)channel
+          binaryMessageHandler:(nullable FlutterBinaryMessageHandler)handler
+                     taskQueue:(nullable NSObject<FlutterTaskQueue>*)taskQueue {
   _currentMessengerConnection += 1;
   _messengerHandlers[channel] =
       [[FlutterEngineHandlerInfo alloc] initWithConnection:@(_currentMessengerConnection)
-                                                   handler:[handler copy]];
+                                                   handler:[handler copy]
+                                                 taskQueue:taskQueue];
   return _currentMessengerConnection;
 }
 
+- (NSObject<FlutterTaskQueue>*)makeBackgroundTaskQueue {
+  return [[FlutterDispatchTaskQueue alloc]
+      initWithQueue:dispatch_queue_create("io.flutter.background_task_queue",
+                                          DISPATCH_QUEUE_SERIAL)];
+}
+
+- (NSObject<FlutterTaskQueue>*)makeBackgroundConcurrentTaskQueue {
+  return [[FlutterDispatchTaskQueue alloc]
+      initWithQueue:dispatch_queue_create("io.flutter.background_concurrent_task_queue",
+                                          DISPATCH_QUEUE_CONCURRENT)];
+}
+
 - (void)cleanUpConnection:(FlutterBinaryMessengerConnection)connection {
   // Find the _messengerHandlers that has the required connection, and record its
   // channel.
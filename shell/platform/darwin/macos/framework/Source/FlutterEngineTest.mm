@@ -477,6 +477,54 @@ TEST_F(FlutterEngineTest, MessengerCleanupConnectionWorks) {
   EXPECT_EQ(record, 21);
 }
 
+TEST_F(FlutterEngineTest, MessengerRunsHandlersOnBackgroundTaskQueue) {
+  FlutterEngine* engine = GetFlutterEngine();
+  EXPECT_TRUE([engine runWithEntrypoint:@"main"]);
+
+  NSString* channel = @"_test_";
+  NSData* channel_data = [channel dataUsingEncoding:NSUTF8StringEncoding];
+
+  // Mock SendPlatformMessage so that if a message is sent to
+  // "test/send_message", act as if the framework has sent a message to the
+  // channel marked by the `sendOnChannel:message:` call's message.
+  engine.embedderAPI.SendPlatformMessage = MOCK_ENGINE_PROC(
+      SendPlatformMessage, ([](auto engine_, auto message_) {
+        if (strcmp(message_->channel, "test/send_message") == 0) {
+          std::string message = R"|({"method": "a"})|";
+          std::string channel(reinterpret_cast<const char*>(message_->message),
+                              message_->message_size);
+          reinterpret_cast<EmbedderEngine*>(engine_)
+              ->GetShell()
+              .GetPlatformView()
+              ->HandlePlatformMessage(std::make_unique<PlatformMessage>(
+                  channel.c_str(), fml::MallocMapping::Copy(message.c_str(), message.length()),
+                  fml::RefPtr<PlatformMessageResponse>()));
+        }
+        return kSuccess;
+      }));
+
+  __block BOOL handledOnMainThread = YES;
+  __block NSString* method = nil;
+  dispatch_semaphore_t handled = dispatch_semaphore_create(0);
+
+  FlutterMethodChannel* methodChannel = [[FlutterMethodChannel alloc]
+         initWithName:channel
+      binaryMessenger:engine.binaryMessenger
+                codec:[FlutterJSONMethodCodec sharedInstance]
+            taskQueue:[engine.binaryMessenger makeBackgroundTaskQueue]];
+  [methodChannel setMethodCallHandler:^(FlutterMethodCall* call, FlutterResult result) {
+    handledOnMainThread = [NSThread isMainThread];
+    method = call.method;
+    dispatch_semaphore_signal(handled);
+  }];
+
+  [engine.binaryMessenger sendOnChannel:@"test/send_message" message:channel_data];
+  EXPECT_EQ(dispatch_semaphore_wait(handled, dispatch_time(DISPATCH_TIME_NOW, 10 * NSEC_PER_SEC)),
+            0);
+  EXPECT_FALSE(handledOnMainThread);
+  EXPECT_TRUE([method isEqualToString:@"a"]);
+}
+
 }  // namespace flutter::testing
 
 // NOLINTEND(clang-analyzer-core.StackAddressEscape)
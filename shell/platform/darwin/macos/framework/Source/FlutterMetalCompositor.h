@@ -5,8 +5,11 @@
 #ifndef FLUTTER_METAL_COMPOSITOR_H_
 #define FLUTTER_METAL_COMPOSITOR_H_
 
+#include <vector>
+
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/darwin/macos/framework/Source/FlutterCompositor.h"
+#import "flutter/shell/platform/darwin/macos/framework/Source/FlutterIOSurfaceHolder.h"
 #import "flutter/shell/platform/darwin/macos/framework/Source/FlutterPlatformViewController.h"
 
 namespace flutter {
@@ -38,6 +41,9 @@ class FlutterMetalCompositor : public FlutterCompositor {
 
   // Releases and deallocates any and all resources that were allocated
   // for this FlutterBackingStore object in CreateBackingStore.
+  //
+  // The IOSurface of the backing store is kept in a pool and reused by later
+  // backing stores of a similar size.
   bool CollectBackingStore(const FlutterBackingStore* backing_store) override;
 
   // Composites the provided FlutterLayer objects and presents the composited
@@ -49,9 +55,30 @@ class FlutterMetalCompositor : public FlutterCompositor {
   // used to position the layer in the z-axis.
   void PresentPlatformView(const FlutterLayer* layer, size_t layer_index);
 
+  // An IOSurface and the MTLTexture that renders into it.
+  struct PooledSurface {
+    FlutterIOSurfaceHolder* io_surface_holder = nil;
+    id<MTLTexture> texture = nil;
+    // The number of frames presented since the surface was returned to the
+    // pool.
+    size_t idle_frames = 0;
+  };
+
+  // Takes the smallest pooled surface that can hold `size` without wasting too
+  // much memory and that the window server is done with, or allocates a new
+  // surface when there is none.
+  PooledSurface AcquireSurface(CGSize size);
+
+  // Ages the pooled surfaces and releases the ones that have not been reused
+  // for a while.
+  void TrimSurfacePool();
+
   const id<MTLDevice> mtl_device_;
   const FlutterPlatformViewController* platform_views_controller_;
 
+  // The surfaces of the collected backing stores.
+  std::vector<PooledSurface> surface_pool_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(FlutterMetalCompositor);
 };
 
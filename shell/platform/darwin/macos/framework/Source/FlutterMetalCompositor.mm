@@ -4,12 +4,34 @@
 
 #import "flutter/shell/platform/darwin/macos/framework/Source/FlutterMetalCompositor.h"
 
-#import "flutter/shell/platform/darwin/macos/framework/Source/FlutterIOSurfaceHolder.h"
+#include <cmath>
 
 #include "flutter/fml/logging.h"
 
 namespace flutter {
 
+namespace {
+
+// New surfaces are allocated with their dimensions rounded up to a multiple of
+// this many pixels, so that a window that is resized a little at a time keeps
+// reusing the same surfaces.
+constexpr size_t kSurfaceSizeGranularity = 64;
+
+// A pooled surface is only reused for a backing store that covers at least
+// this fraction of its area.
+constexpr double kMinPooledSurfaceUsage = 0.5;
+
+// Pooled surfaces that are not reused for this many frames are released.
+constexpr size_t kMaxPooledSurfaceIdleFrames = 30;
+
+CGFloat RoundUpToGranularity(CGFloat dimension) {
+  size_t pixels = static_cast<size_t>(std::ceil(dimension));
+  return ((pixels + kSurfaceSizeGranularity - 1) / kSurfaceSizeGranularity) *
+         kSurfaceSizeGranularity;
+}
+
+}  // namespace
+
 FlutterMetalCompositor::FlutterMetalCompositor(
     FlutterViewController* view_controller,
     FlutterPlatformViewController* platform_views_controller,
@@ -39,22 +61,13 @@ bool FlutterMetalCompositor::CreateBackingStore(const FlutterBackingStoreConfig*
     backing_store_out->metal.texture.texture =
         (__bridge FlutterMetalTextureHandle)backingStore.texture;
   } else {
-    FlutterIOSurfaceHolder* io_surface_holder = [[FlutterIOSurfaceHolder alloc] init];
-    [io_surface_holder recreateIOSurfaceWithSize:size];
-    auto texture_descriptor =
-        [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:MTLPixelFormatBGRA8Unorm
-                                                           width:size.width
-                                                          height:size.height
-                                                       mipmapped:NO];
-    texture_descriptor.usage =
-        MTLTextureUsageShaderRead | MTLTextureUsageRenderTarget | MTLTextureUsageShaderWrite;
-
-    backing_store_out->metal.texture.texture = (__bridge_retained FlutterMetalTextureHandle)
-        [mtl_device_ newTextureWithDescriptor:texture_descriptor
-                                    iosurface:[io_surface_holder ioSurface]
-                                        plane:0];
-
-    backing_store_out->metal.texture.user_data = (__bridge_retained void*)io_surface_holder;
+    // The surface may be larger than the backing store, the embedder only
+    // renders into its top left corner.
+    PooledSurface surface = AcquireSurface(size);
+    backing_store_out->metal.texture.texture =
+        (__bridge_retained FlutterMetalTextureHandle)surface.texture;
+    backing_store_out->metal.texture.user_data =
+        (__bridge_retained void*)surface.io_surface_holder;
   }
 
   backing_store_out->type = kFlutterBackingStoreTypeMetal;
@@ -69,14 +82,75 @@ bool FlutterMetalCompositor::CreateBackingStore(const FlutterBackingStoreConfig*
 
 bool FlutterMetalCompositor::CollectBackingStore(const FlutterBackingStore* backing_store) {
   // If we allocated this MTLTexture ourselves, user_data is not null, and we will need
-  // to release it manually.
+  // to release it manually. The surface goes back to the pool first, which keeps
+  // its own references. The reference to the holder in user_data is released by
+  // the destruction callback.
   if (backing_store->metal.texture.user_data != nullptr &&
       backing_store->metal.texture.texture != nullptr) {
+    PooledSurface surface;
+    surface.io_surface_holder =
+        (__bridge FlutterIOSurfaceHolder*)backing_store->metal.texture.user_data;
+    surface.texture = (__bridge id<MTLTexture>)backing_store->metal.texture.texture;
+    surface_pool_.push_back(surface);
     CFRelease(backing_store->metal.texture.texture);
   }
   return true;
 }
 
+FlutterMetalCompositor::PooledSurface FlutterMetalCompositor::AcquireSurface(CGSize size) {
+  const double area = size.width * size.height;
+  auto best = surface_pool_.end();
+  for (auto it = surface_pool_.begin(); it != surface_pool_.end(); ++it) {
+    const double width = it->texture.width;
+    const double height = it->texture.height;
+    if (width < size.width || height < size.height ||
+        area < width * height * kMinPooledSurfaceUsage) {
+      continue;
+    }
+    // A surface that is still being displayed cannot be rendered into.
+    if (IOSurfaceIsInUse([it->io_surface_holder ioSurface])) {
+      continue;
+    }
+    if (best == surface_pool_.end() ||
+        width * height < best->texture.width * best->texture.height) {
+      best = it;
+    }
+  }
+  if (best != surface_pool_.end()) {
+    PooledSurface surface = *best;
+    surface_pool_.erase(best);
+    surface.idle_frames = 0;
+    return surface;
+  }
+
+  CGSize surface_size =
+      CGSizeMake(RoundUpToGranularity(size.width), RoundUpToGranularity(size.height));
+  PooledSurface surface;
+  surface.io_surface_holder = [[FlutterIOSurfaceHolder alloc] init];
+  [surface.io_surface_holder recreateIOSurfaceWithSize:surface_size];
+  auto texture_descriptor =
+      [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:MTLPixelFormatBGRA8Unorm
+                                                         width:surface_size.width
+                                                        height:surface_size.height
+                                                     mipmapped:NO];
+  texture_descriptor.usage =
+      MTLTextureUsageShaderRead | MTLTextureUsageRenderTarget | MTLTextureUsageShaderWrite;
+  surface.texture = [mtl_device_ newTextureWithDescriptor:texture_descriptor
+                                                iosurface:[surface.io_surface_holder ioSurface]
+                                                    plane:0];
+  return surface;
+}
+
+void FlutterMetalCompositor::TrimSurfacePool() {
+  for (auto it = surface_pool_.begin(); it != surface_pool_.end();) {
+    if (++it->idle_frames > kMaxPooledSurfaceIdleFrames) {
+      it = surface_pool_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 bool FlutterMetalCompositor::Present(const FlutterLayer** layers, size_t layers_count) {
   SetFrameStatus(FrameStatus::kPresenting);
 
@@ -91,7 +165,10 @@ bool FlutterMetalCompositor::Present(const FlutterLayer** layers, size_t layers_
           FlutterIOSurfaceHolder* io_surface_holder =
               (__bridge FlutterIOSurfaceHolder*)backing_store->metal.texture.user_data;
           IOSurfaceRef io_surface = [io_surface_holder ioSurface];
-          InsertCALayerForIOSurface(io_surface);
+          CGRect contents_rect =
+              CGRectMake(0, 0, layer->size.width / IOSurfaceGetWidth(io_surface),
+                         layer->size.height / IOSurfaceGetHeight(io_surface));
+          InsertCALayerForIOSurface(io_surface, CATransform3DIdentity, contents_rect);
         }
         has_flutter_content = true;
         break;
@@ -102,6 +179,7 @@ bool FlutterMetalCompositor::Present(const FlutterLayer** layers, size_t layers_
     };
   }
 
+  TrimSurfacePool();
   return EndFrame(has_flutter_content);
 }
 
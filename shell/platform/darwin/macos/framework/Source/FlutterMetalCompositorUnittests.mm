@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #import <Foundation/Foundation.h>
+#import <Metal/Metal.h>
 
 #import "flutter/shell/platform/darwin/macos/framework/Source/FlutterMetalCompositor.h"
 #import "flutter/shell/platform/darwin/macos/framework/Source/FlutterViewControllerTestUtils.h"
@@ -71,4 +72,46 @@ TEST(FlutterMetalCompositorTest, TestCompositing) {
   ASSERT_EQ(texture.height, 600u);
 }
 
+TEST(FlutterMetalCompositorTest, TestReusesCollectedSurfaces) {
+  id mockViewController = CreateMockViewController(nil);
+  [mockViewController loadView];
+
+  std::unique_ptr<flutter::FlutterMetalCompositor> macos_compositor =
+      std::make_unique<FlutterMetalCompositor>(mockViewController,
+                                               /*platform_view_controller*/ nullptr,
+                                               MTLCreateSystemDefaultDevice());
+
+  FlutterBackingStoreConfig config;
+  config.struct_size = sizeof(FlutterBackingStoreConfig);
+  config.size.width = 800;
+  config.size.height = 600;
+
+  // The first backing store of the frame belongs to the FlutterView.
+  FlutterBackingStore root_backing_store;
+  macos_compositor->CreateBackingStore(&config, &root_backing_store);
+
+  FlutterBackingStore backing_store;
+  config.size.width = 500;
+  config.size.height = 300;
+  macos_compositor->CreateBackingStore(&config, &backing_store);
+  id<MTLTexture> texture = (__bridge id<MTLTexture>)backing_store.metal.texture.texture;
+  ASSERT_NE(texture, nil);
+  // The surface is rounded up so that small resizes can reuse it.
+  ASSERT_EQ(texture.width, 512u);
+  ASSERT_EQ(texture.height, 320u);
+
+  macos_compositor->CollectBackingStore(&backing_store);
+  backing_store.metal.texture.destruction_callback(backing_store.metal.texture.user_data);
+
+  FlutterBackingStore resized_backing_store;
+  config.size.width = 490;
+  config.size.height = 310;
+  macos_compositor->CreateBackingStore(&config, &resized_backing_store);
+  ASSERT_EQ((__bridge id<MTLTexture>)resized_backing_store.metal.texture.texture, texture);
+
+  macos_compositor->CollectBackingStore(&resized_backing_store);
+  resized_backing_store.metal.texture.destruction_callback(
+      resized_backing_store.metal.texture.user_data);
+}
+
 }  // namespace flutter::testing
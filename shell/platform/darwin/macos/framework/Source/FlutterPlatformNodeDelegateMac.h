@@ -24,8 +24,6 @@ class FlutterPlatformNodeDelegateMac : public FlutterPlatformNodeDelegate {
       __weak FlutterViewController* view_controller);
   virtual ~FlutterPlatformNodeDelegateMac();
 
-  void Init(std::weak_ptr<OwnerBridge> bridge, ui::AXNode* node) override;
-
   //---------------------------------------------------------------------------
   /// @brief      Gets the live region text of this node in UTF-8 format. This
   ///             is useful to determine the changes in between semantics
@@ -48,7 +46,8 @@ class FlutterPlatformNodeDelegateMac : public FlutterPlatformNodeDelegate {
       ui::AXOffscreenResult* offscreen_result) const override;
 
  private:
-  ui::AXPlatformNode* ax_platform_node_;
+  // Created by the first call to GetNativeViewAccessible.
+  ui::AXPlatformNode* ax_platform_node_ = nullptr;
   __weak FlutterEngine* engine_;
   __weak FlutterViewController* view_controller_;
 
@@ -25,23 +25,24 @@ FlutterPlatformNodeDelegateMac::FlutterPlatformNodeDelegateMac(
     __weak FlutterViewController* view_controller)
     : engine_(engine), view_controller_(view_controller) {}
 
-void FlutterPlatformNodeDelegateMac::Init(std::weak_ptr<OwnerBridge> bridge, ui::AXNode* node) {
-  FlutterPlatformNodeDelegate::Init(bridge, node);
-  if (GetData().IsTextField()) {
-    ax_platform_node_ = new FlutterTextPlatformNode(this, view_controller_);
-  } else {
-    ax_platform_node_ = ui::AXPlatformNode::Create(this);
-  }
-  NSCAssert(ax_platform_node_, @"Failed to create platform node.");
-}
-
 FlutterPlatformNodeDelegateMac::~FlutterPlatformNodeDelegateMac() {
-  // Destroy() also calls delete on itself.
-  ax_platform_node_->Destroy();
+  if (ax_platform_node_) {
+    // Destroy() also calls delete on itself.
+    ax_platform_node_->Destroy();
+  }
 }
 
 gfx::NativeViewAccessible FlutterPlatformNodeDelegateMac::GetNativeViewAccessible() {
-  NSCAssert(ax_platform_node_, @"Platform node does not exist.");
+  // Platform nodes are created when assistive technologies first reach this
+  // node, rather than for every node in the tree.
+  if (!ax_platform_node_) {
+    if (GetData().IsTextField()) {
+      ax_platform_node_ = new FlutterTextPlatformNode(this, view_controller_);
+    } else {
+      ax_platform_node_ = ui::AXPlatformNode::Create(this);
+    }
+    NSCAssert(ax_platform_node_, @"Failed to create platform node.");
+  }
   return ax_platform_node_->GetNativeViewAccessible();
 }
 
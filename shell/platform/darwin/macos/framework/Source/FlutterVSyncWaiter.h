@@ -0,0 +1,44 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import <Cocoa/Cocoa.h>
+
+/**
+ * Invoked on the display link thread when the vsync that a baton waited for occurs.
+ * `targetDelayNanos` is the time until the frame is displayed and `refreshPeriodNanos` is the
+ * current refresh period of the display.
+ */
+typedef void (^FlutterVSyncWaiterCallback)(intptr_t baton,
+                                           uint64_t targetDelayNanos,
+                                           uint64_t refreshPeriodNanos);
+
+/**
+ * Waits for the vsyncs of a display using a CVDisplayLink.
+ *
+ * The callback is invoked directly on the display link thread, so the vsync reaches the engine
+ * without a hop through the platform thread. The display link only runs while there is a baton
+ * waiting for a vsync, it is stopped after a few idle refreshes.
+ */
+@interface FlutterVSyncWaiter : NSObject
+
+- (nullable instancetype)initWithCallback:(nonnull FlutterVSyncWaiterCallback)callback;
+
+/**
+ * Requests a callback with `baton` at the next vsync. Called on the UI thread.
+ */
+- (void)waitForVSync:(intptr_t)baton;
+
+/**
+ * Makes the waiter follow the vsyncs of the display with the given ID, e.g. after the window
+ * moved to another screen. Called on the platform thread.
+ */
+- (void)setDisplayID:(CGDirectDisplayID)displayID;
+
+/**
+ * Stops the display link. No callbacks are invoked once this returns, and later
+ * waitForVSync: calls are ignored.
+ */
+- (void)invalidate;
+
+@end
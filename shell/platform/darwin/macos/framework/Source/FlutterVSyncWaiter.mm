@@ -0,0 +1,171 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "flutter/shell/platform/darwin/macos/framework/Source/FlutterVSyncWaiter.h"
+
+#import <CoreVideo/CoreVideo.h>
+
+#include <mutex>
+
+// The number of refreshes without a waiting baton after which the display link is stopped.
+static const int kMaxIdleRefreshes = 10;
+
+@interface FlutterVSyncWaiter () {
+  FlutterVSyncWaiterCallback _callback;
+
+  CVDisplayLinkRef _displayLink;
+
+  // Guards the fields below, it is taken by the display link callback.
+  std::mutex _mutex;
+
+  // The baton waiting for the next vsync, or 0.
+  intptr_t _pendingBaton;
+
+  // Whether the display link was started and not yet stopped.
+  BOOL _running;
+
+  // The number of refreshes since the last baton was delivered.
+  int _idleRefreshes;
+
+  // If YES, no more batons are accepted and the display link stays stopped.
+  BOOL _invalidated;
+
+  // Serializes starting, stopping and retargeting the display link. It is never taken by the
+  // display link callback, since stopping the display link waits for the callback to return.
+  std::mutex _displayLinkMutex;
+}
+
+/**
+ * Delivers the pending baton, if any, for the refresh that will be displayed at `outputTime`.
+ * Called on the display link thread.
+ */
+- (void)onDisplayLinkWithOutputTime:(const CVTimeStamp*)outputTime;
+
+/**
+ * Stops the display link unless a baton arrived since it went idle.
+ */
+- (void)stopIfIdle;
+
+@end
+
+static CVReturn OnDisplayLink(CVDisplayLinkRef displayLink,
+                              const CVTimeStamp* now,
+                              const CVTimeStamp* outputTime,
+                              CVOptionFlags flagsIn,
+                              CVOptionFlags* flagsOut,
+                              void* context) {
+  [(__bridge FlutterVSyncWaiter*)context onDisplayLinkWithOutputTime:outputTime];
+  return kCVReturnSuccess;
+}
+
+@implementation FlutterVSyncWaiter
+
+- (instancetype)initWithCallback:(FlutterVSyncWaiterCallback)callback {
+  self = [super init];
+  if (self) {
+    _callback = callback;
+    if (CVDisplayLinkCreateWithCGDisplay(CGMainDisplayID(), &_displayLink) != kCVReturnSuccess) {
+      return nil;
+    }
+    CVDisplayLinkSetOutputCallback(_displayLink, &OnDisplayLink, (__bridge void*)self);
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [self invalidate];
+  CVDisplayLinkRelease(_displayLink);
+}
+
+- (void)waitForVSync:(intptr_t)baton {
+  bool start = false;
+  {
+    std::scoped_lock lock(_mutex);
+    if (_invalidated) {
+      return;
+    }
+    _pendingBaton = baton;
+    _idleRefreshes = 0;
+    start = !_running;
+    _running = YES;
+  }
+  if (start) {
+    std::scoped_lock displayLinkLock(_displayLinkMutex);
+    // The waiter may have been invalidated in the meantime.
+    std::scoped_lock lock(_mutex);
+    if (_running) {
+      CVDisplayLinkStart(_displayLink);
+    }
+  }
+}
+
+- (void)setDisplayID:(CGDirectDisplayID)displayID {
+  std::scoped_lock lock(_displayLinkMutex);
+  if (CVDisplayLinkGetCurrentCGDisplay(_displayLink) != displayID) {
+    CVDisplayLinkSetCurrentCGDisplay(_displayLink, displayID);
+  }
+}
+
+- (void)invalidate {
+  std::scoped_lock displayLinkLock(_displayLinkMutex);
+  {
+    std::scoped_lock lock(_mutex);
+    _invalidated = YES;
+    _running = NO;
+    _pendingBaton = 0;
+  }
+  CVDisplayLinkStop(_displayLink);
+}
+
+- (void)onDisplayLinkWithOutputTime:(const CVTimeStamp*)outputTime {
+  intptr_t baton = 0;
+  bool idle = false;
+  {
+    std::scoped_lock lock(_mutex);
+    baton = _pendingBaton;
+    _pendingBaton = 0;
+    if (baton == 0 && _running) {
+      idle = ++_idleRefreshes == kMaxIdleRefreshes;
+    }
+  }
+
+  if (baton != 0) {
+    const double hostClockFrequency = CVGetHostClockFrequency();
+    const uint64_t nowHostTime = CVGetCurrentHostTime();
+    uint64_t targetDelayNanos = 0;
+    if (outputTime->hostTime > nowHostTime) {
+      targetDelayNanos = (outputTime->hostTime - nowHostTime) / hostClockFrequency * NSEC_PER_SEC;
+    }
+    // The actual refresh period follows variable refresh rate displays, it is 0 until the
+    // display link measured it.
+    double refreshPeriod = CVDisplayLinkGetActualOutputVideoRefreshPeriod(_displayLink);
+    if (refreshPeriod <= 0 && outputTime->videoTimeScale > 0) {
+      refreshPeriod = static_cast<double>(outputTime->videoRefreshPeriod) /
+                      outputTime->videoTimeScale;
+    }
+    _callback(baton, targetDelayNanos, refreshPeriod * NSEC_PER_SEC);
+  }
+
+  if (idle) {
+    // The display link cannot be stopped from its own thread.
+    __weak FlutterVSyncWaiter* weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+      [weakSelf stopIfIdle];
+    });
+  }
+}
+
+- (void)stopIfIdle {
+  std::scoped_lock displayLinkLock(_displayLinkMutex);
+  {
+    std::scoped_lock lock(_mutex);
+    if (!_running || _pendingBaton != 0 || _idleRefreshes < kMaxIdleRefreshes) {
+      return;
+    }
+    _running = NO;
+  }
+  CVDisplayLinkStop(_displayLink);
+}
+
+@end
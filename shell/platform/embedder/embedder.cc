@@ -44,8 +44,10 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_ring_buffer.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/switches.h"
+#include "flutter/shell/common/variable_refresh_rate_display.h"
 #include "flutter/shell/platform/embedder/embedder.h"
 #include "flutter/shell/platform/embedder/embedder_engine.h"
 #include "flutter/shell/platform/embedder/embedder_external_texture_resolver.h"
@@ -55,6 +57,7 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/shell/platform/embedder/embedder_task_runner.h"
 #include "flutter/shell/platform/embedder/embedder_thread_host.h"
 #include "flutter/shell/platform/embedder/platform_view_embedder.h"
+#include "flutter/shell/platform/embedder/vsync_waiter_embedder.h"
 #include "rapidjson/rapidjson.h"
 #include "rapidjson/writer.h"
 
@@ -138,8 +141,8 @@ static bool IsSoftwareRendererConfigValid(const FlutterRendererConfig* config) {
 
   const FlutterSoftwareRendererConfig* software_config = &config->software;
 
-  if (SAFE_ACCESS(software_config, surface_present_callback, nullptr) ==
-      nullptr) {
+  if (!SAFE_EXISTS(software_config, surface_present_callback) &&
+      !SAFE_EXISTS(software_config, surface_present_with_damage_callback)) {
     return false;
   }
 
@@ -218,6 +221,38 @@ static void* DefaultGLProcResolver(const char* name) {
 }
 #endif  // FML_OS_LINUX || FML_OS_WIN
 
+// Wraps the damage computed by the engine, which is null if the whole surface
+// is damaged, in the rectangle it is returned in.
+static FlutterDamage ToFlutterDamage(const std::optional<SkIRect>& damage,
+                                     FlutterRect* rect) {
+  FlutterDamage flutter_damage = {};
+  flutter_damage.struct_size = sizeof(FlutterDamage);
+  if (damage) {
+    *rect = {static_cast<double>(damage->left()),
+             static_cast<double>(damage->top()),
+             static_cast<double>(damage->right()),
+             static_cast<double>(damage->bottom())};
+    flutter_damage.num_rects = 1;
+    flutter_damage.damage = rect;
+  }
+  return flutter_damage;
+}
+
+// Returns the bounds of the damage specified by the embedder, or null if the
+// whole surface is damaged.
+static std::optional<SkIRect> FromFlutterDamage(const FlutterDamage& damage) {
+  if (damage.damage == nullptr) {
+    return std::nullopt;
+  }
+  SkIRect bounds = SkIRect::MakeEmpty();
+  for (size_t i = 0; i < damage.num_rects; i++) {
+    const FlutterRect& rect = damage.damage[i];
+    bounds.join(SkRect::MakeLTRB(rect.left, rect.top, rect.right, rect.bottom)
+                    .roundOut());
+  }
+  return bounds;
+}
+
 static flutter::Shell::CreateCallback<flutter::PlatformView>
 InferOpenGLPlatformViewCreationCallback(
     const FlutterRendererConfig* config,
@@ -237,15 +272,24 @@ InferOpenGLPlatformViewCreationCallback(
   auto gl_clear_current = [ptr = config->open_gl.clear_current,
                            user_data]() -> bool { return ptr(user_data); };
 
-  auto gl_present = [present = config->open_gl.present,
-                     present_with_info = config->open_gl.present_with_info,
-                     user_data](uint32_t fbo_id) -> bool {
+  auto gl_present =
+      [present = config->open_gl.present,
+       present_with_info = config->open_gl.present_with_info,
+       user_data](flutter::EmbedderSurfaceGL::GLPresentInfo gl_present_info)
+      -> bool {
     if (present) {
       return present(user_data);
     } else {
+      // The damage computed by the engine is always a single rectangle.
+      FlutterRect frame_damage_rect = {};
+      FlutterRect buffer_damage_rect = {};
       FlutterPresentInfo present_info = {};
       present_info.struct_size = sizeof(FlutterPresentInfo);
-      present_info.fbo_id = fbo_id;
+      present_info.fbo_id = gl_present_info.fbo_id;
+      present_info.frame_damage =
+          ToFlutterDamage(gl_present_info.frame_damage, &frame_damage_rect);
+      present_info.buffer_damage =
+          ToFlutterDamage(gl_present_info.buffer_damage, &buffer_damage_rect);
       return present_with_info(user_data, &present_info);
     }
   };
@@ -311,9 +355,26 @@ InferOpenGLPlatformViewCreationCallback(
 #endif
   }
 
+  std::function<std::optional<SkIRect>(intptr_t)>
+      gl_populate_existing_damage = nullptr;
+  if (SAFE_ACCESS(open_gl_config, populate_existing_damage, nullptr) !=
+      nullptr) {
+    gl_populate_existing_damage =
+        [ptr = config->open_gl.populate_existing_damage,
+         user_data](intptr_t fbo_id) -> std::optional<SkIRect> {
+      FlutterDamage existing_damage = {};
+      existing_damage.struct_size = sizeof(FlutterDamage);
+      ptr(user_data, fbo_id, &existing_damage);
+      return FromFlutterDamage(existing_damage);
+    };
+  }
+
   bool fbo_reset_after_present =
       SAFE_ACCESS(open_gl_config, fbo_reset_after_present, false);
 
+  bool exclusive_context =
+      SAFE_ACCESS(open_gl_config, exclusive_context, false);
+
   flutter::EmbedderSurfaceGL::GLDispatchTable gl_dispatch_table = {
       gl_make_current,                     // gl_make_current_callback
       gl_clear_current,                    // gl_clear_current_callback
@@ -322,10 +383,12 @@ InferOpenGLPlatformViewCreationCallback(
       gl_make_resource_current_callback,   // gl_make_resource_current_callback
       gl_surface_transformation_callback,  // gl_surface_transformation_callback
       gl_proc_resolver,                    // gl_proc_resolver
+      gl_populate_existing_damage,         // gl_populate_existing_damage
   };
 
   return fml::MakeCopyable(
-      [gl_dispatch_table, fbo_reset_after_present, platform_dispatch_table,
+      [gl_dispatch_table, fbo_reset_after_present, exclusive_context,
+       platform_dispatch_table,
        external_view_embedder =
            std::move(external_view_embedder)](flutter::Shell& shell) mutable {
         return std::make_unique<flutter::PlatformViewEmbedder>(
@@ -333,6 +396,7 @@ InferOpenGLPlatformViewCreationCallback(
             shell.GetTaskRunners(),   // task runners
             gl_dispatch_table,        // embedder GL dispatch table
             fbo_reset_after_present,  // fbo reset after present
+            exclusive_context,        // exclusive context
             platform_dispatch_table,  // embedder platform dispatch table
             std::move(external_view_embedder)  // external view embedder
         );
@@ -505,25 +569,51 @@ InferSoftwarePlatformViewCreationCallback(
     return nullptr;
   }
 
-  auto software_present_backing_store =
-      [ptr = config->software.surface_present_callback, user_data](
-          const void* allocation, size_t row_bytes, size_t height) -> bool {
-    return ptr(user_data, allocation, row_bytes, height);
-  };
+  const FlutterSoftwareRendererConfig* software_config = &config->software;
+  std::function<bool(const void*, size_t, size_t)>
+      software_present_backing_store = nullptr;
+  std::function<bool(const void*, size_t, size_t,
+                     const std::optional<SkIRect>&)>
+      software_present_backing_store_with_damage = nullptr;
+  if (SAFE_EXISTS(software_config, surface_present_with_damage_callback)) {
+    software_present_backing_store_with_damage =
+        [ptr = software_config->surface_present_with_damage_callback,
+         user_data](const void* allocation, size_t row_bytes, size_t height,
+                    const std::optional<SkIRect>& damage) -> bool {
+      FlutterRect damage_rect = {};
+      FlutterDamage flutter_damage = ToFlutterDamage(damage, &damage_rect);
+      return ptr(user_data, allocation, row_bytes, height, &flutter_damage);
+    };
+  } else {
+    software_present_backing_store =
+        [ptr = software_config->surface_present_callback, user_data](
+            const void* allocation, size_t row_bytes, size_t height) -> bool {
+      return ptr(user_data, allocation, row_bytes, height);
+    };
+  }
 
   flutter::EmbedderSurfaceSoftware::SoftwareDispatchTable
       software_dispatch_table = {
-          software_present_backing_store,  // required
+          software_present_backing_store,
+          software_present_backing_store_with_damage,
       };
 
+  bool rasterize_on_worker_threads =
+      SAFE_ACCESS(software_config, rasterize_on_worker_threads, false);
+
   return fml::MakeCopyable(
-      [software_dispatch_table, platform_dispatch_table,
+      [software_dispatch_table, rasterize_on_worker_threads,
+       platform_dispatch_table,
        external_view_embedder =
            std::move(external_view_embedder)](flutter::Shell& shell) mutable {
+        std::shared_ptr<fml::ConcurrentTaskRunner> tile_task_runner =
+            rasterize_on_worker_threads ? shell.GetConcurrentWorkerTaskRunner()
+                                        : nullptr;
         return std::make_unique<flutter::PlatformViewEmbedder>(
             shell,                             // delegate
             shell.GetTaskRunners(),            // task runners
             software_dispatch_table,           // software dispatch table
+            std::move(tile_task_runner),       // tile task runner
             platform_dispatch_table,           // platform dispatch table
             std::move(external_view_embedder)  // external view embedder
         );
@@ -883,6 +973,10 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor) {
       SAFE_ACCESS(compositor, present_layers_callback, nullptr);
   bool avoid_backing_store_cache =
       SAFE_ACCESS(compositor, avoid_backing_store_cache, false);
+  size_t backing_store_cache_max_unused_frames =
+      SAFE_ACCESS(compositor, backing_store_cache_max_unused_frames, 0);
+  size_t backing_store_cache_max_bytes =
+      SAFE_ACCESS(compositor, backing_store_cache_max_bytes, 0);
 
   // Make sure the required callbacks are present
   if (!c_create_callback || !c_collect_callback || !c_present_callback) {
@@ -909,7 +1003,8 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor) {
       };
 
   return {std::make_unique<flutter::EmbedderExternalViewEmbedder>(
-              avoid_backing_store_cache, create_render_target_callback,
+              avoid_backing_store_cache, backing_store_cache_max_unused_frames,
+              backing_store_cache_max_bytes, create_render_target_callback,
               present_callback),
           false};
 }
@@ -1058,149 +1153,10 @@ void PopulateSnapshotMappingCallbacks(
         // FLUTTER_RUNTIME_MODE_DEBUG)
 }
 
-FlutterEngineResult FlutterEngineRun(size_t version,
-                                     const FlutterRendererConfig* config,
-                                     const FlutterProjectArgs* args,
-                                     void* user_data,
-                                     FLUTTER_API_SYMBOL(FlutterEngine) *
-                                         engine_out) {
-  auto result =
-      FlutterEngineInitialize(version, config, args, user_data, engine_out);
-
-  if (result != kSuccess) {
-    return result;
-  }
-
-  return FlutterEngineRunInitialized(*engine_out);
-}
-
-FlutterEngineResult FlutterEngineInitialize(size_t version,
-                                            const FlutterRendererConfig* config,
-                                            const FlutterProjectArgs* args,
-                                            void* user_data,
-                                            FLUTTER_API_SYMBOL(FlutterEngine) *
-                                                engine_out) {
-  // Step 0: Figure out arguments for shell creation.
-  if (version != FLUTTER_ENGINE_VERSION) {
-    return LOG_EMBEDDER_ERROR(
-        kInvalidLibraryVersion,
-        "Flutter embedder version mismatch. There has been a breaking change. "
-        "Please consult the changelog and update the embedder.");
-  }
-
-  if (engine_out == nullptr) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments,
-                              "The engine out parameter was missing.");
-  }
-
-  if (args == nullptr) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments,
-                              "The Flutter project arguments were missing.");
-  }
-
-  if (SAFE_ACCESS(args, assets_path, nullptr) == nullptr) {
-    return LOG_EMBEDDER_ERROR(
-        kInvalidArguments,
-        "The assets path in the Flutter project arguments was missing.");
-  }
-
-  if (SAFE_ACCESS(args, main_path__unused__, nullptr) != nullptr) {
-    FML_LOG(WARNING)
-        << "FlutterProjectArgs.main_path is deprecated and should be set null.";
-  }
-
-  if (SAFE_ACCESS(args, packages_path__unused__, nullptr) != nullptr) {
-    FML_LOG(WARNING) << "FlutterProjectArgs.packages_path is deprecated and "
-                        "should be set null.";
-  }
-
-  if (!IsRendererValid(config)) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments,
-                              "The renderer configuration was invalid.");
-  }
-
-  std::string icu_data_path;
-  if (SAFE_ACCESS(args, icu_data_path, nullptr) != nullptr) {
-    icu_data_path = SAFE_ACCESS(args, icu_data_path, nullptr);
-  }
-
-  if (SAFE_ACCESS(args, persistent_cache_path, nullptr) != nullptr) {
-    std::string persistent_cache_path =
-        SAFE_ACCESS(args, persistent_cache_path, nullptr);
-    flutter::PersistentCache::SetCacheDirectoryPath(persistent_cache_path);
-  }
-
-  if (SAFE_ACCESS(args, is_persistent_cache_read_only, false)) {
-    flutter::PersistentCache::gIsReadOnly = true;
-  }
-
-  fml::CommandLine command_line;
-  if (SAFE_ACCESS(args, command_line_argc, 0) != 0 &&
-      SAFE_ACCESS(args, command_line_argv, nullptr) != nullptr) {
-    command_line = fml::CommandLineFromArgcArgv(
-        SAFE_ACCESS(args, command_line_argc, 0),
-        SAFE_ACCESS(args, command_line_argv, nullptr));
-  }
-
-  flutter::Settings settings = flutter::SettingsFromCommandLine(command_line);
-
-  if (SAFE_ACCESS(args, aot_data, nullptr)) {
-    if (SAFE_ACCESS(args, vm_snapshot_data, nullptr) ||
-        SAFE_ACCESS(args, vm_snapshot_instructions, nullptr) ||
-        SAFE_ACCESS(args, isolate_snapshot_data, nullptr) ||
-        SAFE_ACCESS(args, isolate_snapshot_instructions, nullptr)) {
-      return LOG_EMBEDDER_ERROR(
-          kInvalidArguments,
-          "Multiple AOT sources specified. Embedders should provide either "
-          "*_snapshot_* buffers or aot_data, not both.");
-    }
-  }
-
-  PopulateSnapshotMappingCallbacks(args, settings);
-
-  settings.icu_data_path = icu_data_path;
-  settings.assets_path = args->assets_path;
-  settings.leak_vm = !SAFE_ACCESS(args, shutdown_dart_vm_when_done, false);
-  settings.old_gen_heap_size = SAFE_ACCESS(args, dart_old_gen_heap_size, -1);
-
-  if (!flutter::DartVM::IsRunningPrecompiledCode()) {
-    // Verify the assets path contains Dart 2 kernel assets.
-    const std::string kApplicationKernelSnapshotFileName = "kernel_blob.bin";
-    std::string application_kernel_path = fml::paths::JoinPaths(
-        {settings.assets_path, kApplicationKernelSnapshotFileName});
-    if (!fml::IsFile(application_kernel_path)) {
-      return LOG_EMBEDDER_ERROR(
-          kInvalidArguments,
-          "Not running in AOT mode but could not resolve the kernel binary.");
-    }
-    settings.application_kernel_asset = kApplicationKernelSnapshotFileName;
-  }
-
-  settings.task_observer_add = [](intptr_t key, fml::closure callback) {
-    fml::MessageLoop::GetCurrent().AddTaskObserver(key, std::move(callback));
-  };
-  settings.task_observer_remove = [](intptr_t key) {
-    fml::MessageLoop::GetCurrent().RemoveTaskObserver(key);
-  };
-  if (SAFE_ACCESS(args, root_isolate_create_callback, nullptr) != nullptr) {
-    VoidCallback callback =
-        SAFE_ACCESS(args, root_isolate_create_callback, nullptr);
-    settings.root_isolate_create_callback =
-        [callback, user_data](const auto& isolate) { callback(user_data); };
-  }
-  if (SAFE_ACCESS(args, log_message_callback, nullptr) != nullptr) {
-    FlutterLogMessageCallback callback =
-        SAFE_ACCESS(args, log_message_callback, nullptr);
-    settings.log_message_callback = [callback, user_data](
-                                        const std::string& tag,
-                                        const std::string& message) {
-      callback(tag.c_str(), message.c_str(), user_data);
-    };
-  }
-  if (SAFE_ACCESS(args, log_tag, nullptr) != nullptr) {
-    settings.log_tag = SAFE_ACCESS(args, log_tag, nullptr);
-  }
-
+// Creates the callbacks of the platform view from the project arguments of
+// the embedder.
+static flutter::PlatformViewEmbedder::PlatformDispatchTable
+CreatePlatformDispatchTable(const FlutterProjectArgs* args, void* user_data) {
   flutter::PlatformViewEmbedder::UpdateSemanticsNodesCallback
       update_semantics_nodes_callback = nullptr;
   if (SAFE_ACCESS(args, update_semantics_node_callback, nullptr) != nullptr) {
@@ -1368,38 +1324,21 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
                                       user_data]() { return ptr(user_data); };
   }
 
-  auto external_view_embedder_result =
-      InferExternalViewEmbedderFromArgs(SAFE_ACCESS(args, compositor, nullptr));
-  if (external_view_embedder_result.second) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments,
-                              "Compositor arguments were invalid.");
-  }
-
-  flutter::PlatformViewEmbedder::PlatformDispatchTable platform_dispatch_table =
-      {
-          update_semantics_nodes_callback,            //
-          update_semantics_custom_actions_callback,   //
-          platform_message_response_callback,         //
-          vsync_callback,                             //
-          compute_platform_resolved_locale_callback,  //
-          on_pre_engine_restart_callback,             //
-      };
-
-  auto on_create_platform_view = InferPlatformViewCreationCallback(
-      config, user_data, platform_dispatch_table,
-      std::move(external_view_embedder_result.first));
-
-  if (!on_create_platform_view) {
-    return LOG_EMBEDDER_ERROR(
-        kInternalInconsistency,
-        "Could not infer platform view creation callback.");
-  }
-
-  flutter::Shell::CreateCallback<flutter::Rasterizer> on_create_rasterizer =
-      [](flutter::Shell& shell) {
-        return std::make_unique<flutter::Rasterizer>(shell);
-      };
+  return {
+      update_semantics_nodes_callback,            //
+      update_semantics_custom_actions_callback,   //
+      platform_message_response_callback,         //
+      vsync_callback,                             //
+      compute_platform_resolved_locale_callback,  //
+      on_pre_engine_restart_callback,             //
+  };
+}
 
+// Creates the resolver of the external textures from the renderer
+// configuration of the embedder.
+static std::unique_ptr<flutter::EmbedderExternalTextureResolver>
+CreateExternalTextureResolver(const FlutterRendererConfig* config,
+                              void* user_data) {
   using ExternalTextureResolver = flutter::EmbedderExternalTextureResolver;
   std::unique_ptr<ExternalTextureResolver> external_texture_resolver;
   external_texture_resolver = std::make_unique<ExternalTextureResolver>();
@@ -1450,31 +1389,18 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
     }
   }
 #endif
+  return external_texture_resolver;
+}
 
-  auto thread_host =
-      flutter::EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
-          SAFE_ACCESS(args, custom_task_runners, nullptr));
-
-  if (!thread_host || !thread_host->IsValid()) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments,
-                              "Could not set up or infer thread configuration "
-                              "to run the Flutter engine on.");
-  }
-
-  auto task_runners = thread_host->GetTaskRunners();
-
-  if (!task_runners.IsValid()) {
-    return LOG_EMBEDDER_ERROR(kInternalInconsistency,
-                              "Task runner configuration was invalid.");
-  }
-
-  auto run_configuration =
-      flutter::RunConfiguration::InferFromSettings(settings);
-
+// Sets the Dart entrypoint and its arguments from the project arguments of
+// the embedder, if they specify any.
+static FlutterEngineResult SetDartEntrypoint(
+    const FlutterProjectArgs* args,
+    flutter::RunConfiguration* run_configuration) {
   if (SAFE_ACCESS(args, custom_dart_entrypoint, nullptr) != nullptr) {
     auto dart_entrypoint = std::string{args->custom_dart_entrypoint};
     if (dart_entrypoint.size() != 0) {
-      run_configuration.SetEntrypoint(std::move(dart_entrypoint));
+      run_configuration->SetEntrypoint(std::move(dart_entrypoint));
     }
   }
 
@@ -1489,49 +1415,248 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
     for (int i = 0; i < args->dart_entrypoint_argc; ++i) {
       arguments[i] = std::string{args->dart_entrypoint_argv[i]};
     }
-    run_configuration.SetEntrypointArgs(std::move(arguments));
-  }
-
-  if (!run_configuration.IsValid()) {
-    return LOG_EMBEDDER_ERROR(
-        kInvalidArguments,
-        "Could not infer the Flutter project to run from given arguments.");
+    run_configuration->SetEntrypointArgs(std::move(arguments));
   }
-
-  // Create the engine but don't launch the shell or run the root isolate.
-  auto embedder_engine = std::make_unique<flutter::EmbedderEngine>(
-      std::move(thread_host),               //
-      std::move(task_runners),              //
-      std::move(settings),                  //
-      std::move(run_configuration),         //
-      on_create_platform_view,              //
-      on_create_rasterizer,                 //
-      std::move(external_texture_resolver)  //
-  );
-
-  // Release the ownership of the embedder engine to the caller.
-  *engine_out = reinterpret_cast<FLUTTER_API_SYMBOL(FlutterEngine)>(
-      embedder_engine.release());
   return kSuccess;
 }
 
-FlutterEngineResult FlutterEngineRunInitialized(
-    FLUTTER_API_SYMBOL(FlutterEngine) engine) {
-  if (!engine) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
-  }
-
-  auto embedder_engine = reinterpret_cast<flutter::EmbedderEngine*>(engine);
+FlutterEngineResult FlutterEngineRun(size_t version,
+                                     const FlutterRendererConfig* config,
+                                     const FlutterProjectArgs* args,
+                                     void* user_data,
+                                     FLUTTER_API_SYMBOL(FlutterEngine) *
+                                         engine_out) {
+  auto result =
+      FlutterEngineInitialize(version, config, args, user_data, engine_out);
 
-  // The engine must not already be running. Initialize may only be called
-  // once on an engine instance.
-  if (embedder_engine->IsValid()) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  if (result != kSuccess) {
+    return result;
   }
 
-  // Step 1: Launch the shell.
-  if (!embedder_engine->LaunchShell()) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+  return FlutterEngineRunInitialized(*engine_out);
+}
+
+FlutterEngineResult FlutterEngineInitialize(size_t version,
+                                            const FlutterRendererConfig* config,
+                                            const FlutterProjectArgs* args,
+                                            void* user_data,
+                                            FLUTTER_API_SYMBOL(FlutterEngine) *
+                                                engine_out) {
+  // Step 0: Figure out arguments for shell creation.
+  if (version != FLUTTER_ENGINE_VERSION) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidLibraryVersion,
+        "Flutter embedder version mismatch. There has been a breaking change. "
+        "Please consult the changelog and update the embedder.");
+  }
+
+  if (engine_out == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The engine out parameter was missing.");
+  }
+
+  if (args == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The Flutter project arguments were missing.");
+  }
+
+  if (SAFE_ACCESS(args, assets_path, nullptr) == nullptr) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "The assets path in the Flutter project arguments was missing.");
+  }
+
+  if (SAFE_ACCESS(args, main_path__unused__, nullptr) != nullptr) {
+    FML_LOG(WARNING)
+        << "FlutterProjectArgs.main_path is deprecated and should be set null.";
+  }
+
+  if (SAFE_ACCESS(args, packages_path__unused__, nullptr) != nullptr) {
+    FML_LOG(WARNING) << "FlutterProjectArgs.packages_path is deprecated and "
+                        "should be set null.";
+  }
+
+  if (!IsRendererValid(config)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The renderer configuration was invalid.");
+  }
+
+  std::string icu_data_path;
+  if (SAFE_ACCESS(args, icu_data_path, nullptr) != nullptr) {
+    icu_data_path = SAFE_ACCESS(args, icu_data_path, nullptr);
+  }
+
+  if (SAFE_ACCESS(args, persistent_cache_path, nullptr) != nullptr) {
+    std::string persistent_cache_path =
+        SAFE_ACCESS(args, persistent_cache_path, nullptr);
+    flutter::PersistentCache::SetCacheDirectoryPath(persistent_cache_path);
+  }
+
+  if (SAFE_ACCESS(args, is_persistent_cache_read_only, false)) {
+    flutter::PersistentCache::gIsReadOnly = true;
+  }
+
+  fml::CommandLine command_line;
+  if (SAFE_ACCESS(args, command_line_argc, 0) != 0 &&
+      SAFE_ACCESS(args, command_line_argv, nullptr) != nullptr) {
+    command_line = fml::CommandLineFromArgcArgv(
+        SAFE_ACCESS(args, command_line_argc, 0),
+        SAFE_ACCESS(args, command_line_argv, nullptr));
+  }
+
+  flutter::Settings settings = flutter::SettingsFromCommandLine(command_line);
+
+  if (SAFE_ACCESS(args, aot_data, nullptr)) {
+    if (SAFE_ACCESS(args, vm_snapshot_data, nullptr) ||
+        SAFE_ACCESS(args, vm_snapshot_instructions, nullptr) ||
+        SAFE_ACCESS(args, isolate_snapshot_data, nullptr) ||
+        SAFE_ACCESS(args, isolate_snapshot_instructions, nullptr)) {
+      return LOG_EMBEDDER_ERROR(
+          kInvalidArguments,
+          "Multiple AOT sources specified. Embedders should provide either "
+          "*_snapshot_* buffers or aot_data, not both.");
+    }
+  }
+
+  PopulateSnapshotMappingCallbacks(args, settings);
+
+  settings.icu_data_path = icu_data_path;
+  settings.assets_path = args->assets_path;
+  settings.leak_vm = !SAFE_ACCESS(args, shutdown_dart_vm_when_done, false);
+  settings.old_gen_heap_size = SAFE_ACCESS(args, dart_old_gen_heap_size, -1);
+
+  if (!flutter::DartVM::IsRunningPrecompiledCode()) {
+    // Verify the assets path contains Dart 2 kernel assets.
+    const std::string kApplicationKernelSnapshotFileName = "kernel_blob.bin";
+    std::string application_kernel_path = fml::paths::JoinPaths(
+        {settings.assets_path, kApplicationKernelSnapshotFileName});
+    if (!fml::IsFile(application_kernel_path)) {
+      return LOG_EMBEDDER_ERROR(
+          kInvalidArguments,
+          "Not running in AOT mode but could not resolve the kernel binary.");
+    }
+    settings.application_kernel_asset = kApplicationKernelSnapshotFileName;
+  }
+
+  settings.task_observer_add = [](intptr_t key, fml::closure callback) {
+    fml::MessageLoop::GetCurrent().AddTaskObserver(key, std::move(callback));
+  };
+  settings.task_observer_remove = [](intptr_t key) {
+    fml::MessageLoop::GetCurrent().RemoveTaskObserver(key);
+  };
+  if (SAFE_ACCESS(args, root_isolate_create_callback, nullptr) != nullptr) {
+    VoidCallback callback =
+        SAFE_ACCESS(args, root_isolate_create_callback, nullptr);
+    settings.root_isolate_create_callback =
+        [callback, user_data](const auto& isolate) { callback(user_data); };
+  }
+  if (SAFE_ACCESS(args, log_message_callback, nullptr) != nullptr) {
+    FlutterLogMessageCallback callback =
+        SAFE_ACCESS(args, log_message_callback, nullptr);
+    settings.log_message_callback = [callback, user_data](
+                                        const std::string& tag,
+                                        const std::string& message) {
+      callback(tag.c_str(), message.c_str(), user_data);
+    };
+  }
+  if (SAFE_ACCESS(args, log_tag, nullptr) != nullptr) {
+    settings.log_tag = SAFE_ACCESS(args, log_tag, nullptr);
+  }
+
+  auto external_view_embedder_result =
+      InferExternalViewEmbedderFromArgs(SAFE_ACCESS(args, compositor, nullptr));
+  if (external_view_embedder_result.second) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Compositor arguments were invalid.");
+  }
+
+  flutter::PlatformViewEmbedder::PlatformDispatchTable platform_dispatch_table =
+      CreatePlatformDispatchTable(args, user_data);
+
+  auto on_create_platform_view = InferPlatformViewCreationCallback(
+      config, user_data, platform_dispatch_table,
+      std::move(external_view_embedder_result.first));
+
+  if (!on_create_platform_view) {
+    return LOG_EMBEDDER_ERROR(
+        kInternalInconsistency,
+        "Could not infer platform view creation callback.");
+  }
+
+  flutter::Shell::CreateCallback<flutter::Rasterizer> on_create_rasterizer =
+      [](flutter::Shell& shell) {
+        return std::make_unique<flutter::Rasterizer>(shell);
+      };
+
+  auto external_texture_resolver =
+      CreateExternalTextureResolver(config, user_data);
+
+  auto thread_host =
+      flutter::EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
+          SAFE_ACCESS(args, custom_task_runners, nullptr));
+
+  if (!thread_host || !thread_host->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Could not set up or infer thread configuration "
+                              "to run the Flutter engine on.");
+  }
+
+  auto task_runners = thread_host->GetTaskRunners();
+
+  if (!task_runners.IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                              "Task runner configuration was invalid.");
+  }
+
+  auto run_configuration =
+      flutter::RunConfiguration::InferFromSettings(settings);
+
+  FlutterEngineResult entrypoint_result =
+      SetDartEntrypoint(args, &run_configuration);
+  if (entrypoint_result != kSuccess) {
+    return entrypoint_result;
+  }
+
+  if (!run_configuration.IsValid()) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "Could not infer the Flutter project to run from given arguments.");
+  }
+
+  // Create the engine but don't launch the shell or run the root isolate.
+  auto embedder_engine = std::make_unique<flutter::EmbedderEngine>(
+      std::move(thread_host),               //
+      std::move(task_runners),              //
+      std::move(settings),                  //
+      std::move(run_configuration),         //
+      on_create_platform_view,              //
+      on_create_rasterizer,                 //
+      std::move(external_texture_resolver)  //
+  );
+
+  // Release the ownership of the embedder engine to the caller.
+  *engine_out = reinterpret_cast<FLUTTER_API_SYMBOL(FlutterEngine)>(
+      embedder_engine.release());
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineRunInitialized(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine) {
+  if (!engine) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  auto embedder_engine = reinterpret_cast<flutter::EmbedderEngine*>(engine);
+
+  // The engine must not already be running. Initialize may only be called
+  // once on an engine instance.
+  if (embedder_engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  // Step 1: Launch the shell.
+  if (!embedder_engine->LaunchShell()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
                               "Could not launch the engine using supplied "
                               "initialization arguments.");
   }
@@ -1553,6 +1678,99 @@ FlutterEngineResult FlutterEngineRunInitialized(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEngineSpawn(size_t version,
+                                       FLUTTER_API_SYMBOL(FlutterEngine)
+                                           spawner,
+                                       const FlutterRendererConfig* config,
+                                       const FlutterProjectArgs* args,
+                                       void* user_data,
+                                       FLUTTER_API_SYMBOL(FlutterEngine) *
+                                           engine_out) {
+  if (version != FLUTTER_ENGINE_VERSION) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidLibraryVersion,
+        "Flutter embedder version mismatch. There has been a breaking change. "
+        "Please consult the changelog and update the embedder.");
+  }
+
+  if (engine_out == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The engine out parameter was missing.");
+  }
+
+  auto spawner_engine = reinterpret_cast<flutter::EmbedderEngine*>(spawner);
+  if (spawner_engine == nullptr || !spawner_engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The engine to spawn from was not running.");
+  }
+
+  if (args == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The Flutter project arguments were missing.");
+  }
+
+  if (!IsRendererValid(config)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The renderer configuration was invalid.");
+  }
+
+  auto external_view_embedder_result =
+      InferExternalViewEmbedderFromArgs(SAFE_ACCESS(args, compositor, nullptr));
+  if (external_view_embedder_result.second) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Compositor arguments were invalid.");
+  }
+
+  auto on_create_platform_view = InferPlatformViewCreationCallback(
+      config, user_data, CreatePlatformDispatchTable(args, user_data),
+      std::move(external_view_embedder_result.first));
+
+  if (!on_create_platform_view) {
+    return LOG_EMBEDDER_ERROR(
+        kInternalInconsistency,
+        "Could not infer platform view creation callback.");
+  }
+
+  flutter::Shell::CreateCallback<flutter::Rasterizer> on_create_rasterizer =
+      [](flutter::Shell& shell) {
+        return std::make_unique<flutter::Rasterizer>(shell);
+      };
+
+  auto run_configuration = flutter::RunConfiguration::InferFromSettings(
+      spawner_engine->GetShell().GetSettings());
+
+  FlutterEngineResult entrypoint_result =
+      SetDartEntrypoint(args, &run_configuration);
+  if (entrypoint_result != kSuccess) {
+    return entrypoint_result;
+  }
+
+  if (!run_configuration.IsValid()) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "Could not infer the Flutter project to run from given arguments.");
+  }
+
+  auto embedder_engine = spawner_engine->Spawn(
+      std::move(run_configuration), on_create_platform_view,
+      on_create_rasterizer, CreateExternalTextureResolver(config, user_data));
+
+  if (!embedder_engine) {
+    return LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                              "Could not spawn the engine.");
+  }
+
+  if (!embedder_engine->NotifyCreated()) {
+    return LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                              "Could not create platform view components.");
+  }
+
+  // Release the ownership of the embedder engine to the caller.
+  *engine_out = reinterpret_cast<FLUTTER_API_SYMBOL(FlutterEngine)>(
+      embedder_engine.release());
+  return kSuccess;
+}
+
 FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineDeinitialize(FLUTTER_API_SYMBOL(FlutterEngine)
                                                   engine) {
@@ -1577,14 +1795,12 @@ FlutterEngineResult FlutterEngineShutdown(FLUTTER_API_SYMBOL(FlutterEngine)
   return kSuccess;
 }
 
-FlutterEngineResult FlutterEngineSendWindowMetricsEvent(
-    FLUTTER_API_SYMBOL(FlutterEngine) engine,
-    const FlutterWindowMetricsEvent* flutter_metrics) {
-  if (engine == nullptr || flutter_metrics == nullptr) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
-  }
-
-  flutter::ViewportMetrics metrics;
+// Converts the window metrics specified by the embedder, which must not be
+// null.
+static FlutterEngineResult ToViewportMetrics(
+    const FlutterWindowMetricsEvent* flutter_metrics,
+    flutter::ViewportMetrics* metrics_out) {
+  flutter::ViewportMetrics& metrics = *metrics_out;
 
   metrics.physical_width = SAFE_ACCESS(flutter_metrics, width, 0.0);
   metrics.physical_height = SAFE_ACCESS(flutter_metrics, height, 0.0);
@@ -1622,6 +1838,22 @@ FlutterEngineResult FlutterEngineSendWindowMetricsEvent(
                               "be greater than physical height or width.");
   }
 
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineSendWindowMetricsEvent(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterWindowMetricsEvent* flutter_metrics) {
+  if (engine == nullptr || flutter_metrics == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  flutter::ViewportMetrics metrics;
+  FlutterEngineResult result = ToViewportMetrics(flutter_metrics, &metrics);
+  if (result != kSuccess) {
+    return result;
+  }
+
   return reinterpret_cast<flutter::EmbedderEngine*>(engine)->SetViewportMetrics(
              std::move(metrics))
              ? kSuccess
@@ -1710,18 +1942,11 @@ inline int64_t PointerDataButtonsForLegacyEvent(
   return 0;
 }
 
-FlutterEngineResult FlutterEngineSendPointerEvent(
-    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+// Converts the pointer events specified by the embedder, of which there must
+// be at least one.
+static std::unique_ptr<flutter::PointerDataPacket> ToPointerDataPacket(
     const FlutterPointerEvent* pointers,
     size_t events_count) {
-  if (engine == nullptr) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
-  }
-
-  if (pointers == nullptr || events_count == 0) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid pointer events.");
-  }
-
   auto packet = std::make_unique<flutter::PointerDataPacket>(events_count);
 
   const FlutterPointerEvent* current = pointers;
@@ -1781,9 +2006,24 @@ FlutterEngineResult FlutterEngineSendPointerEvent(
     current = reinterpret_cast<const FlutterPointerEvent*>(
         reinterpret_cast<const uint8_t*>(current) + current->struct_size);
   }
+  return packet;
+}
+
+FlutterEngineResult FlutterEngineSendPointerEvent(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPointerEvent* pointers,
+    size_t events_count) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  if (pointers == nullptr || events_count == 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid pointer events.");
+  }
 
   return reinterpret_cast<flutter::EmbedderEngine*>(engine)
-                 ->DispatchPointerDataPacket(std::move(packet))
+                 ->DispatchPointerDataPacket(
+                     ToPointerDataPacket(pointers, events_count))
              ? kSuccess
              : LOG_EMBEDDER_ERROR(kInternalInconsistency,
                                   "Could not dispatch pointer events to the "
@@ -1803,58 +2043,13 @@ static inline flutter::KeyEventType MapKeyEventType(
   return flutter::KeyEventType::kUp;
 }
 
-// Send a platform message to the framework.
-//
-// The `data_callback` will be invoked with `user_data`, and must not be empty.
-static FlutterEngineResult InternalSendPlatformMessage(
+// Converts the key event specified by the embedder, which must not be null,
+// to the message that sends it to the framework.
+static std::unique_ptr<flutter::PlatformMessage> ToKeyDataMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
-    const char* channel,
-    const uint8_t* data,
-    size_t size,
-    FlutterDataCallback data_callback,
+    const FlutterKeyEvent* event,
+    FlutterKeyEventCallback callback,
     void* user_data) {
-  FlutterEngineResult result;
-
-  FlutterPlatformMessageResponseHandle* response_handle;
-  result = FlutterPlatformMessageCreateResponseHandle(
-      engine, data_callback, user_data, &response_handle);
-  if (result != kSuccess) {
-    return result;
-  }
-
-  const FlutterPlatformMessage message = {
-      sizeof(FlutterPlatformMessage),  // struct_size
-      channel,                         // channel
-      data,                            // message
-      size,                            // message_size
-      response_handle,                 // response_handle
-  };
-
-  result = FlutterEngineSendPlatformMessage(engine, &message);
-  // Whether `SendPlatformMessage` succeeds or not, the response handle must be
-  // released.
-  FlutterEngineResult release_result =
-      FlutterPlatformMessageReleaseResponseHandle(engine, response_handle);
-  if (result != kSuccess) {
-    return result;
-  }
-
-  return release_result;
-}
-
-FlutterEngineResult FlutterEngineSendKeyEvent(FLUTTER_API_SYMBOL(FlutterEngine)
-                                                  engine,
-                                              const FlutterKeyEvent* event,
-                                              FlutterKeyEventCallback callback,
-                                              void* user_data) {
-  if (engine == nullptr) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
-  }
-
-  if (event == nullptr) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid key event.");
-  }
-
   const char* character = SAFE_ACCESS(event, character, nullptr);
 
   flutter::KeyData key_data;
@@ -1868,43 +2063,59 @@ FlutterEngineResult FlutterEngineSendKeyEvent(FLUTTER_API_SYMBOL(FlutterEngine)
 
   auto packet = std::make_unique<flutter::KeyDataPacket>(key_data, character);
 
-  struct MessageData {
-    FlutterKeyEventCallback callback;
-    void* user_data;
-  };
-
-  MessageData* message_data =
-      new MessageData{.callback = callback, .user_data = user_data};
-
-  return InternalSendPlatformMessage(
-      engine, kFlutterKeyDataChannel, packet->data().data(),
-      packet->data().size(),
-      [](const uint8_t* data, size_t size, void* user_data) {
-        auto message_data = std::unique_ptr<MessageData>(
-            reinterpret_cast<MessageData*>(user_data));
-        if (message_data->callback == nullptr) {
+  auto platform_task_runner = reinterpret_cast<flutter::EmbedderEngine*>(engine)
+                                  ->GetTaskRunners()
+                                  .GetPlatformTaskRunner();
+  auto response = fml::MakeRefCounted<flutter::EmbedderPlatformMessageResponse>(
+      std::move(platform_task_runner),
+      [callback, user_data](const uint8_t* data, size_t size) {
+        if (callback == nullptr) {
           return;
         }
         bool handled = false;
         if (size == 1) {
           handled = *data != 0;
         }
-        message_data->callback(handled, message_data->user_data);
-      },
-      message_data);
+        callback(handled, user_data);
+      });
+
+  return std::make_unique<flutter::PlatformMessage>(
+      kFlutterKeyDataChannel,
+      fml::MallocMapping::CopyPooled(packet->data().data(),
+                                     packet->data().size()),
+      std::move(response));
 }
 
-FlutterEngineResult FlutterEngineSendPlatformMessage(
-    FLUTTER_API_SYMBOL(FlutterEngine) engine,
-    const FlutterPlatformMessage* flutter_message) {
+FlutterEngineResult FlutterEngineSendKeyEvent(FLUTTER_API_SYMBOL(FlutterEngine)
+                                                  engine,
+                                              const FlutterKeyEvent* event,
+                                              FlutterKeyEventCallback callback,
+                                              void* user_data) {
   if (engine == nullptr) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
   }
 
-  if (flutter_message == nullptr) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid message argument.");
+  if (event == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid key event.");
   }
 
+  return reinterpret_cast<flutter::EmbedderEngine*>(engine)
+                 ->SendPlatformMessage(
+                     ToKeyDataMessage(engine, event, callback, user_data))
+             ? kSuccess
+             : LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                                  "Could not send a key event to the running "
+                                  "Flutter application.");
+}
+
+// Converts the platform message specified by the embedder, which must not be
+// null. The buffer of the message is copied, unless a release callback lends
+// it to the engine.
+static FlutterEngineResult ToPlatformMessage(
+    const FlutterPlatformMessage* flutter_message,
+    std::unique_ptr<flutter::PlatformMessage>* message_out,
+    FlutterPlatformMessageReleaseCallback release_callback = nullptr,
+    void* release_user_data = nullptr) {
   if (SAFE_ACCESS(flutter_message, channel, nullptr) == nullptr) {
     return LOG_EMBEDDER_ERROR(
         kInvalidArguments, "Message argument did not specify a valid channel.");
@@ -1927,16 +2138,81 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
     response = response_handle->message->response();
   }
 
-  std::unique_ptr<flutter::PlatformMessage> message;
   if (message_size == 0) {
-    message = std::make_unique<flutter::PlatformMessage>(
+    *message_out = std::make_unique<flutter::PlatformMessage>(
         flutter_message->channel, response);
+    if (release_callback) {
+      release_callback(message_data, message_size, release_user_data);
+    }
+  } else if (release_callback) {
+    *message_out = std::make_unique<flutter::PlatformMessage>(
+        flutter_message->channel,
+        fml::MallocMapping(
+            const_cast<uint8_t*>(message_data), message_size,
+            [release_callback, release_user_data](const uint8_t* data,
+                                                  size_t size) {
+              release_callback(data, size, release_user_data);
+            }),
+        response);
   } else {
-    message = std::make_unique<flutter::PlatformMessage>(
+    *message_out = std::make_unique<flutter::PlatformMessage>(
         flutter_message->channel,
-        fml::MallocMapping::Copy(message_data, message_size), response);
+        fml::MallocMapping::CopyPooled(message_data, message_size), response);
+  }
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineSendPlatformMessage(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* flutter_message) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (flutter_message == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid message argument.");
+  }
+
+  std::unique_ptr<flutter::PlatformMessage> message;
+  FlutterEngineResult result = ToPlatformMessage(flutter_message, &message);
+  if (result != kSuccess) {
+    return result;
+  }
+
+  return reinterpret_cast<flutter::EmbedderEngine*>(engine)
+                 ->SendPlatformMessage(std::move(message))
+             ? kSuccess
+             : LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                                  "Could not send a message to the running "
+                                  "Flutter application.");
+}
+
+FlutterEngineResult FlutterEngineSendPlatformMessageNoCopy(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* flutter_message,
+    FlutterPlatformMessageReleaseCallback release_callback,
+    void* release_user_data) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (flutter_message == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid message argument.");
+  }
+
+  if (release_callback == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid release callback argument.");
+  }
+
+  std::unique_ptr<flutter::PlatformMessage> message;
+  FlutterEngineResult result = ToPlatformMessage(
+      flutter_message, &message, release_callback, release_user_data);
+  if (result != kSuccess) {
+    return result;
   }
 
+  // The buffer is handed back when the message is dropped, also on failure.
   return reinterpret_cast<flutter::EmbedderEngine*>(engine)
                  ->SendPlatformMessage(std::move(message))
              ? kSuccess
@@ -1945,6 +2221,89 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
                                   "Flutter application.");
 }
 
+FlutterEngineResult FlutterEngineSendEvents(FLUTTER_API_SYMBOL(FlutterEngine)
+                                                engine,
+                                            const FlutterEngineEvent* events,
+                                            size_t events_count) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  if (events == nullptr || events_count == 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid events.");
+  }
+
+  std::vector<flutter::PlatformEvent> platform_events(events_count);
+  const FlutterEngineEvent* current = events;
+  for (size_t i = 0; i < events_count; ++i) {
+    flutter::PlatformEvent& platform_event = platform_events[i];
+    switch (SAFE_ACCESS(current, type, kFlutterEngineEventTypeWindowMetrics)) {
+      case kFlutterEngineEventTypeWindowMetrics: {
+        auto window_metrics = SAFE_ACCESS(current, window_metrics, nullptr);
+        if (window_metrics == nullptr) {
+          return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                    "Invalid window metrics event.");
+        }
+        flutter::ViewportMetrics metrics;
+        FlutterEngineResult result =
+            ToViewportMetrics(window_metrics, &metrics);
+        if (result != kSuccess) {
+          return result;
+        }
+        platform_event.viewport_metrics = metrics;
+        break;
+      }
+      case kFlutterEngineEventTypePointer: {
+        auto pointer_events = SAFE_ACCESS(current, pointer_events, nullptr);
+        size_t pointer_events_count =
+            SAFE_ACCESS(current, pointer_events_count, 0);
+        if (pointer_events == nullptr || pointer_events_count == 0) {
+          return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                    "Invalid pointer events.");
+        }
+        platform_event.pointer_data_packet =
+            ToPointerDataPacket(pointer_events, pointer_events_count);
+        break;
+      }
+      case kFlutterEngineEventTypeKey: {
+        auto key_event = SAFE_ACCESS(current, key_event, nullptr);
+        if (key_event == nullptr) {
+          return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid key event.");
+        }
+        auto callback = SAFE_ACCESS(current, key_event_callback, nullptr);
+        auto user_data = SAFE_ACCESS(current, key_event_user_data, nullptr);
+        platform_event.platform_message =
+            ToKeyDataMessage(engine, key_event, callback, user_data);
+        break;
+      }
+      case kFlutterEngineEventTypePlatformMessage: {
+        auto platform_message = SAFE_ACCESS(current, platform_message, nullptr);
+        if (platform_message == nullptr) {
+          return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                    "Invalid message argument.");
+        }
+        FlutterEngineResult result = ToPlatformMessage(
+            platform_message, &platform_event.platform_message);
+        if (result != kSuccess) {
+          return result;
+        }
+        break;
+      }
+      default:
+        return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid event type.");
+    }
+    current = reinterpret_cast<const FlutterEngineEvent*>(
+        reinterpret_cast<const uint8_t*>(current) + current->struct_size);
+  }
+
+  return reinterpret_cast<flutter::EmbedderEngine*>(engine)
+                 ->DispatchPlatformEvents(std::move(platform_events))
+             ? kSuccess
+             : LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                                  "Could not send the events to the running "
+                                  "Flutter application.");
+}
+
 FlutterEngineResult FlutterPlatformMessageCreateResponseHandle(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     FlutterDataCallback data_callback,
@@ -2011,8 +2370,8 @@ FlutterEngineResult FlutterEngineSendPlatformMessageResponse(
     if (data_length == 0) {
       response->CompleteEmpty();
     } else {
-      response->Complete(std::make_unique<fml::DataMapping>(
-          std::vector<uint8_t>({data, data + data_length})));
+      response->Complete(std::make_unique<fml::MallocMapping>(
+          fml::MallocMapping::CopyPooled(data, data_length)));
     }
   }
 
@@ -2084,6 +2443,77 @@ FlutterEngineResult FlutterEngineMarkExternalTextureFrameAvailable(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEngineRegisterBufferedExternalTexture(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  if (texture_identifier == 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Texture identifier was invalid.");
+  }
+
+#ifdef SHELL_ENABLE_GL
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)
+           ->RegisterBufferedTexture(texture_identifier)) {
+    return LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                              "Could not register the specified texture.");
+  }
+  return kSuccess;
+#else
+  return LOG_EMBEDDER_ERROR(
+      kInvalidArguments,
+      "Buffered external textures are not supported by this engine build.");
+#endif
+}
+
+FlutterEngineResult FlutterEnginePushExternalTextureFrame(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier,
+    const FlutterOpenGLTextureFrame* frame) {
+  if (frame == nullptr ||
+      frame->struct_size < sizeof(FlutterOpenGLTextureFrame)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid FlutterOpenGLTextureFrame specified.");
+  }
+
+#ifdef SHELL_ENABLE_GL
+  // Releases the texture of the frame on every failure below.
+  auto texture_frame =
+      std::make_unique<flutter::EmbedderExternalTextureGLFrame>(*frame);
+
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (texture_identifier == 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid texture identifier.");
+  }
+
+  if (frame->texture.width == 0 || frame->texture.height == 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The size of the frame texture was not set.");
+  }
+
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)->PushTextureFrame(
+          texture_identifier, std::move(texture_frame))) {
+    return LOG_EMBEDDER_ERROR(
+        kInternalInconsistency,
+        "Could not push the frame onto the specified buffered texture.");
+  }
+  return kSuccess;
+#else
+  if (frame->texture.destruction_callback) {
+    frame->texture.destruction_callback(frame->texture.user_data);
+  }
+  return LOG_EMBEDDER_ERROR(
+      kInvalidArguments,
+      "Buffered external textures are not supported by this engine build.");
+#endif
+}
+
 FlutterEngineResult FlutterEngineUpdateSemanticsEnabled(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     bool enabled) {
@@ -2528,9 +2958,30 @@ FlutterEngineResult FlutterEngineNotifyDisplayUpdate(
 
   switch (update_type) {
     case kFlutterEngineDisplaysUpdateTypeStartup: {
+      // When the embedder reports the vsync events, the refresh rate of the
+      // main display follows them.
+      auto platform_view = engine->GetShell().GetPlatformView();
+      const bool has_vsync_callback =
+          platform_view &&
+          static_cast<flutter::PlatformViewEmbedder*>(platform_view.get())
+              ->HasVsyncCallback();
       std::vector<std::unique_ptr<flutter::Display>> displays;
       for (size_t i = 0; i < display_count; i++) {
-        if (embedder_displays[i].single_display) {
+        if (i == 0 && has_vsync_callback) {
+          const auto& vsync_waiter =
+              static_cast<const flutter::VsyncWaiterEmbedder&>(
+                  engine->GetShell().GetVsyncWaiter());
+          if (embedder_displays[i].single_display) {
+            displays.push_back(
+                std::make_unique<flutter::VariableRefreshRateDisplay>(
+                    vsync_waiter, embedder_displays[i].refresh_rate));
+          } else {
+            displays.push_back(
+                std::make_unique<flutter::VariableRefreshRateDisplay>(
+                    embedder_displays[i].display_id, vsync_waiter,
+                    embedder_displays[i].refresh_rate));
+          }
+        } else if (embedder_displays[i].single_display) {
           displays.push_back(std::make_unique<flutter::Display>(
               embedder_displays[i].refresh_rate));
         } else {
@@ -2550,6 +3001,124 @@ FlutterEngineResult FlutterEngineNotifyDisplayUpdate(
   }
 }
 
+FlutterEngineResult FlutterEngineGetFrameTimingPercentile(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameTimingPercentile* percentile) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (percentile == nullptr ||
+      percentile->struct_size < sizeof(FlutterFrameTimingPercentile)) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments, "Invalid FlutterFrameTimingPercentile specified.");
+  }
+
+  if (!(percentile->percentile >= 0 && percentile->percentile <= 100)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The percentile must be between 0 and 100.");
+  }
+
+  const flutter::FrameTimingHistograms& histograms =
+      reinterpret_cast<flutter::EmbedderEngine*>(engine)
+          ->GetShell()
+          .GetFrameTimingHistograms();
+  auto get = [&](flutter::FrameTimingHistograms::Phase phase) {
+    return histograms.GetPercentile(phase, percentile->percentile)
+        .ToMicroseconds();
+  };
+  percentile->frame_count = histograms.GetFrameCount();
+  percentile->build_duration_us = get(flutter::FrameTimingHistograms::kBuild);
+  percentile->raster_duration_us = get(flutter::FrameTimingHistograms::kRaster);
+  percentile->vsync_overhead_us =
+      get(flutter::FrameTimingHistograms::kVsyncOverhead);
+  percentile->total_span_us = get(flutter::FrameTimingHistograms::kTotalSpan);
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineGetStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineStatistics* statistics) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (statistics == nullptr ||
+      statistics->struct_size < sizeof(FlutterEngineStatistics)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid FlutterEngineStatistics specified.");
+  }
+
+  auto embedder_engine = reinterpret_cast<flutter::EmbedderEngine*>(engine);
+  if (!embedder_engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was not running.");
+  }
+  flutter::Shell& shell = embedder_engine->GetShell();
+
+  const flutter::FrameTimingHistograms& histograms =
+      shell.GetFrameTimingHistograms();
+  auto get = [&](flutter::FrameTimingHistograms::Phase phase,
+                 double percentile) {
+    return histograms.GetPercentile(phase, percentile).ToMicroseconds();
+  };
+  statistics->frame_count = histograms.GetFrameCount();
+  statistics->build_duration_p50_us =
+      get(flutter::FrameTimingHistograms::kBuild, 50);
+  statistics->build_duration_p90_us =
+      get(flutter::FrameTimingHistograms::kBuild, 90);
+  statistics->build_duration_p99_us =
+      get(flutter::FrameTimingHistograms::kBuild, 99);
+  statistics->raster_duration_p50_us =
+      get(flutter::FrameTimingHistograms::kRaster, 50);
+  statistics->raster_duration_p90_us =
+      get(flutter::FrameTimingHistograms::kRaster, 90);
+  statistics->raster_duration_p99_us =
+      get(flutter::FrameTimingHistograms::kRaster, 99);
+
+  const flutter::Shell::Statistics shell_statistics = shell.GetStatistics();
+  statistics->raster_cache_layer_count =
+      shell_statistics.raster_cache_layer_metrics.total_count();
+  statistics->raster_cache_layer_bytes =
+      shell_statistics.raster_cache_layer_metrics.total_bytes();
+  statistics->raster_cache_picture_count =
+      shell_statistics.raster_cache_picture_metrics.total_count();
+  statistics->raster_cache_picture_bytes =
+      shell_statistics.raster_cache_picture_metrics.total_bytes();
+  statistics->resource_cache_max_bytes =
+      shell_statistics.resource_cache_max_bytes.value_or(0);
+  statistics->resource_cache_usage_bytes =
+      shell_statistics.resource_cache_usage_bytes.value_or(0);
+  statistics->platform_task_runner_pending_tasks =
+      shell_statistics.platform_pending_tasks;
+  statistics->ui_task_runner_pending_tasks = shell_statistics.ui_pending_tasks;
+  statistics->raster_task_runner_pending_tasks =
+      shell_statistics.raster_pending_tasks;
+  statistics->io_task_runner_pending_tasks = shell_statistics.io_pending_tasks;
+  statistics->pipeline_depth = shell_statistics.layer_tree_pipeline_depth;
+  statistics->pipeline_frames_in_flight =
+      shell_statistics.layer_tree_pipeline_inflight_count;
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineGetTraceRingBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterDataCallback callback,
+    void* user_data) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (callback == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The callback must not be null.");
+  }
+
+  const std::string json = fml::tracing::TraceRingBufferToChromeTraceJson();
+  callback(reinterpret_cast<const uint8_t*>(json.data()), json.size(),
+           user_data);
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineGetProcAddresses(
     FlutterEngineProcTable* table) {
   if (!table) {
@@ -2600,6 +3169,15 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(PostCallbackOnAllNativeThreads,
            FlutterEnginePostCallbackOnAllNativeThreads);
   SET_PROC(NotifyDisplayUpdate, FlutterEngineNotifyDisplayUpdate);
+  SET_PROC(GetFrameTimingPercentile, FlutterEngineGetFrameTimingPercentile);
+  SET_PROC(RegisterBufferedExternalTexture,
+           FlutterEngineRegisterBufferedExternalTexture);
+  SET_PROC(PushExternalTextureFrame, FlutterEnginePushExternalTextureFrame);
+  SET_PROC(GetTraceRingBuffer, FlutterEngineGetTraceRingBuffer);
+  SET_PROC(SendEvents, FlutterEngineSendEvents);
+  SET_PROC(SendPlatformMessageNoCopy, FlutterEngineSendPlatformMessageNoCopy);
+  SET_PROC(GetStatistics, FlutterEngineGetStatistics);
+  SET_PROC(Spawn, FlutterEngineSpawn);
 #undef SET_PROC
 
   return kSuccess;
@@ -283,6 +283,24 @@ typedef struct {
   size_t height;
 } FlutterOpenGLTexture;
 
+/// A frame pushed onto a buffered external texture with
+/// `FlutterEnginePushExternalTextureFrame`.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterOpenGLTextureFrame).
+  size_t struct_size;
+  /// The texture holding the frame, which the engine samples in place. Its
+  /// width and height must be set. Its destruction callback may be invoked on
+  /// any thread, once the GPU no longer samples the texture or once the frame
+  /// has been dropped without ever being painted.
+  FlutterOpenGLTexture texture;
+  /// An optional `GLsync` fence inserted by the producer after its last write
+  /// to the texture. The engine makes the GPU, rather than the raster thread,
+  /// wait for the fence before sampling the texture. The fence is not deleted
+  /// by the engine and must outlive the texture. May be null if the texture
+  /// is complete when the frame is pushed.
+  void* fence;
+} FlutterOpenGLTextureFrame;
+
 typedef struct {
   /// The target of the color attachment of the frame-buffer. For example,
   /// GL_TEXTURE_2D or GL_RENDERBUFFER. In case of ambiguity when dealing with
@@ -353,6 +371,18 @@ typedef struct {
   FlutterSize lower_left_corner_radius;
 } FlutterRoundedRect;
 
+/// A structure to represent a damaged region of a surface, in the coordinates
+/// of its pixels.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterDamage).
+  size_t struct_size;
+  /// The number of rectangles in `damage`.
+  size_t num_rects;
+  /// The rectangles whose union is the damaged region. A region with no
+  /// rectangles is empty. If this is null, the whole surface is damaged.
+  FlutterRect* damage;
+} FlutterDamage;
+
 /// This information is passed to the embedder when requesting a frame buffer
 /// object.
 ///
@@ -377,6 +407,21 @@ typedef struct {
   size_t struct_size;
   /// Id of the fbo backing the surface that was presented.
   uint32_t fbo_id;
+  /// The region of the frame that changed since the last frame presented,
+  /// for example to be passed to `eglSwapBuffersWithDamageKHR`.
+  ///
+  /// The damage is only computed when the `populate_existing_damage` callback
+  /// of the `FlutterOpenGLRendererConfig` is specified. Otherwise, it is null
+  /// and the whole surface must be assumed damaged. The rectangles are only
+  /// valid for the duration of the call.
+  FlutterDamage frame_damage;
+  /// The region of the fbo that was repainted since it was last presented,
+  /// which is the frame damage and the existing damage of the fbo, for example
+  /// to be passed to `eglSetDamageRegionKHR`.
+  ///
+  /// Like `frame_damage`, it is null unless `populate_existing_damage` is
+  /// specified.
+  FlutterDamage buffer_damage;
 } FlutterPresentInfo;
 
 /// Callback for when a surface is presented.
@@ -384,6 +429,13 @@ typedef bool (*BoolPresentInfoCallback)(
     void* /* user data */,
     const FlutterPresentInfo* /* present info */);
 
+/// Callback for when the engine needs the existing damage of a frame buffer
+/// object before rendering a frame into it.
+typedef void (*FlutterFrameBufferWithDamageCallback)(
+    void* /* user data */,
+    const intptr_t /* fbo id */,
+    FlutterDamage* /* existing damage */);
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterOpenGLRendererConfig).
   size_t struct_size;
@@ -442,6 +494,31 @@ typedef struct {
   /// `FlutterPresentInfo` struct that the embedder can use to release any
   /// resources. The return value indicates success of the present call.
   BoolPresentInfoCallback present_with_info;
+  /// Specifying this callback enables the partial repaint of the frames, and
+  /// the damage of each frame is passed to `present_with_info`.
+  ///
+  /// The engine calls it before rendering each frame with the id of the fbo
+  /// the frame is rendered into. The embedder must set the existing damage of
+  /// the fbo, which is the region where its contents differ from those of the
+  /// last frame presented, for example from the age of the buffer queried with
+  /// `EGL_BUFFER_AGE_EXT` and the damage of the frames presented since. Only
+  /// that region and the damage of the new frame are repainted. The embedder
+  /// owns the rectangles, which must stay valid until the callback returns.
+  /// Leaving the damage null repaints the whole frame.
+  ///
+  /// This callback is optional.
+  FlutterFrameBufferWithDamageCallback populate_existing_damage;
+  /// Whether the engine is the only user of the context that `make_current`
+  /// makes current on the raster thread. If so, the engine calls
+  /// `make_current` once and leaves the context current, instead of calling
+  /// it each time it uses the context, which is several times per frame. It
+  /// calls `clear_current` when the rendering surface is destroyed, for
+  /// example when the engine shuts down. The embedder must not make other
+  /// contexts current on the raster thread while the engine is running. The
+  /// resource context made current by `make_resource_current` is unaffected.
+  ///
+  /// This is optional and defaults to false.
+  bool exclusive_context;
 } FlutterOpenGLRendererConfig;
 
 /// Alias for id<MTLDevice>.
@@ -640,6 +717,15 @@ typedef struct {
 
 } FlutterVulkanRendererConfig;
 
+/// Callback for when the buffer of a software surface is presented along with
+/// the region of the buffer that changed since it was last presented.
+typedef bool (*SoftwareSurfacePresentWithDamageCallback)(
+    void* /* user data */,
+    const void* /* allocation */,
+    size_t /* row bytes */,
+    size_t /* height */,
+    const FlutterDamage* /* damage */);
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterSoftwareRendererConfig).
   size_t struct_size;
@@ -647,7 +733,24 @@ typedef struct {
   /// to the user. The pixel format of the buffer is the native 32-bit RGBA
   /// format. The buffer is owned by the Flutter engine and must be copied in
   /// this callback if needed.
+  ///
+  /// Specifying one of `surface_present_callback` or
+  /// `surface_present_with_damage_callback` is required. If both are
+  /// specified, only `surface_present_with_damage_callback` is used.
   SoftwareSurfacePresentCallback surface_present_callback;
+  /// Like `surface_present_callback`, but also passes the region of the buffer
+  /// that changed since it was last presented, so that the embedder only needs
+  /// to copy that region. Since the engine keeps the contents of the buffer
+  /// across frames, specifying this callback also enables the partial repaint
+  /// of the frames. The damage is null if the whole buffer changed. The
+  /// rectangles are only valid for the duration of the call.
+  SoftwareSurfacePresentWithDamageCallback surface_present_with_damage_callback;
+  /// By default, the frames are rasterized on the raster thread. If this
+  /// argument is true, the damaged region of each frame is split into bands of
+  /// rows that are rasterized in parallel on the worker threads of the engine.
+  /// This speeds up the rasterization of large frames on devices without a GPU
+  /// but with several CPU cores.
+  bool rasterize_on_worker_threads;
 } FlutterSoftwareRendererConfig;
 
 typedef struct {
@@ -886,10 +989,57 @@ typedef void (*FlutterPlatformMessageCallback)(
     const FlutterPlatformMessage* /* message*/,
     void* /* user data */);
 
+/// The data passed to the callback is not copied for the embedder. It is only
+/// valid until the callback returns.
 typedef void (*FlutterDataCallback)(const uint8_t* /* data */,
                                     size_t /* size */,
                                     void* /* user data */);
 
+/// The callback invoked by the engine, on any thread, to hand back the buffer
+/// of a message sent with `FlutterEngineSendPlatformMessageNoCopy`.
+typedef void (*FlutterPlatformMessageReleaseCallback)(
+    const uint8_t* /* message */,
+    size_t /* message size */,
+    void* /* user data */);
+
+typedef enum {
+  kFlutterEngineEventTypeWindowMetrics,
+  kFlutterEngineEventTypePointer,
+  kFlutterEngineEventTypeKey,
+  kFlutterEngineEventTypePlatformMessage,
+} FlutterEngineEventType;
+
+/// An event sent to the engine along with others via
+/// `FlutterEngineSendEvents`.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterEngineEvent).
+  size_t struct_size;
+  /// The type of the event, which determines which member of the union is
+  /// used.
+  FlutterEngineEventType type;
+  union {
+    /// The event of type `kFlutterEngineEventTypeWindowMetrics`, as sent with
+    /// `FlutterEngineSendWindowMetricsEvent`.
+    const FlutterWindowMetricsEvent* window_metrics;
+    /// The events of type `kFlutterEngineEventTypePointer`, as sent with
+    /// `FlutterEngineSendPointerEvent`.
+    const FlutterPointerEvent* pointer_events;
+    /// The event of type `kFlutterEngineEventTypeKey`, as sent with
+    /// `FlutterEngineSendKeyEvent`.
+    const FlutterKeyEvent* key_event;
+    /// The event of type `kFlutterEngineEventTypePlatformMessage`, as sent
+    /// with `FlutterEngineSendPlatformMessage`.
+    const FlutterPlatformMessage* platform_message;
+  };
+  /// The number of `pointer_events`.
+  size_t pointer_events_count;
+  /// The callback invoked once the Flutter application has decided whether it
+  /// handles the `key_event`. Accepts nullptr.
+  FlutterKeyEventCallback key_event_callback;
+  /// The context associated with the `key_event_callback`. Accepts nullptr.
+  void* key_event_user_data;
+} FlutterEngineEvent;
+
 /// The identifier of the platform view. This identifier is specified by the
 /// application when a platform view is added to the scene via the
 /// `SceneBuilder.addPlatformView` call.
@@ -1019,6 +1169,27 @@ typedef void (*FlutterTaskRunnerPostTaskCallback)(
     uint64_t /* target time nanos */,
     void* /* user data */);
 
+/// How urgently a task posted to a custom task runner has to run. Embedders
+/// that service the tasks of the engine on an event loop shared with other
+/// work may use it to run the tasks that produce frames ahead of the rest.
+typedef enum {
+  /// The task has no particular urgency.
+  kFlutterTaskPriorityNormal,
+  /// The task produces the frame for the next vsync and delaying it past its
+  /// target time may drop the frame.
+  kFlutterTaskPriorityFrame,
+  /// The task services an input event.
+  kFlutterTaskPriorityInput,
+  /// The task may be deferred until the event loop has nothing else to do.
+  kFlutterTaskPriorityIdle,
+} FlutterTaskPriority;
+
+typedef void (*FlutterTaskRunnerPostTaskWithPriorityCallback)(
+    FlutterTask /* task */,
+    uint64_t /* target time nanos */,
+    FlutterTaskPriority /* priority */,
+    void* /* user data */);
+
 /// An interface used by the Flutter engine to execute tasks at the target time
 /// on a specified thread. There should be a 1-1 relationship between a thread
 /// and a task runner. It is undefined behavior to run a task on a thread that
@@ -1046,8 +1217,25 @@ typedef struct {
   /// A unique identifier for the task runner. If multiple task runners service
   /// tasks on the same thread, their identifiers must match.
   size_t identifier;
+  /// May be called from any thread. When specified, the engine posts its
+  /// tasks with this callback instead of the `post_task_callback`. It has the
+  /// same contract as the `post_task_callback`, with a hint of how urgently
+  /// the task has to run. The task must still be run at or after its target
+  /// time.
+  FlutterTaskRunnerPostTaskWithPriorityCallback
+      post_task_with_priority_callback;
 } FlutterTaskRunnerDescription;
 
+/// The kind of CPU cores a thread created by the engine prefers to run on.
+typedef enum {
+  /// Any core, as decided by the scheduler.
+  kFlutterThreadAffinityAny,
+  /// The fastest cores of the device.
+  kFlutterThreadAffinityPerformance,
+  /// The slowest, most power efficient cores of the device.
+  kFlutterThreadAffinityEfficiency,
+} FlutterThreadAffinity;
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterCustomTaskRunners).
   size_t struct_size;
@@ -1061,6 +1249,16 @@ typedef struct {
   /// and platform task runners. This makes the Flutter engine use the same
   /// thread for both task runners.
   const FlutterTaskRunnerDescription* render_task_runner;
+  /// The kind of cores the UI thread, which the engine always creates, prefers
+  /// to run on.
+  FlutterThreadAffinity ui_thread_affinity;
+  /// The kind of cores the render thread prefers to run on. This is only used
+  /// when the engine creates the render thread, that is when no
+  /// `render_task_runner` is specified.
+  FlutterThreadAffinity render_thread_affinity;
+  /// The kind of cores the IO thread, which the engine always creates, prefers
+  /// to run on.
+  FlutterThreadAffinity io_thread_affinity;
 } FlutterCustomTaskRunners;
 
 typedef struct {
@@ -1244,6 +1442,17 @@ typedef struct {
   FlutterPoint offset;
   /// The size of the layer (in physical pixels).
   FlutterSize size;
+  /// The bounds (in physical pixels, relative to the top left of the root
+  /// surface used by the engine) of the part of the layer whose contents
+  /// changed since the layer at the same position in the list of layers was
+  /// last presented. May be null, in which case all of the layer must be
+  /// assumed to have changed. Always null for the layers of platform views.
+  const FlutterRect* damage;
+  /// Whether the contents of the layer are the same as those of the layer at
+  /// the same position in the list of layers when it was last presented, so
+  /// that the embedder may skip recomposing it. Only true when `damage` is
+  /// empty.
+  bool unchanged_since_last_present;
 } FlutterLayer;
 
 typedef bool (*FlutterBackingStoreCreateCallback)(
@@ -1283,6 +1492,15 @@ typedef struct {
   FlutterLayersPresentCallback present_layers_callback;
   /// Avoid caching backing stores provided by this compositor.
   bool avoid_backing_store_cache;
+  /// The number of frames a backing store that the frames no longer use is
+  /// kept for before it is collected, in case views that come and go across
+  /// frames need it again. With 0, the backing stores that a frame does not
+  /// use are collected right away.
+  size_t backing_store_cache_max_unused_frames;
+  /// The budget in bytes of the backing stores that are kept unused, of which
+  /// the least recently used are collected first. 0 means that there is no
+  /// budget.
+  size_t backing_store_cache_max_bytes;
 } FlutterCompositor;
 
 typedef struct {
@@ -1340,6 +1558,11 @@ typedef struct {
 
   /// This represents the refresh period in frames per second. This value may be
   /// zero if the device is not running or unavailable or unknown.
+  ///
+  /// If the engine was configured with a `vsync_callback`, the refresh rate of
+  /// the first display reported at startup follows the interval between the
+  /// frame start and target times passed to `FlutterEngineOnVsync` once the
+  /// first vsync event arrives.
   double refresh_rate;
 } FlutterEngineDisplay;
 
@@ -1355,6 +1578,75 @@ typedef enum {
   kFlutterEngineDisplaysUpdateTypeCount,
 } FlutterEngineDisplaysUpdateType;
 
+/// The durations of the phases of the frames rasterized by an engine instance
+/// at a percentile, as returned by `FlutterEngineGetFrameTimingPercentile`.
+/// The durations are exact up to about 1.6%.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameTimingPercentile).
+  size_t struct_size;
+  /// The percentile of the durations, between 0 and 100. Set by the embedder.
+  double percentile;
+  /// The number of frames rasterized so far. None of the durations are
+  /// meaningful if this is zero.
+  uint64_t frame_count;
+  /// The time between the start and the end of the build of the frame, in
+  /// microseconds.
+  int64_t build_duration_us;
+  /// The time between the start and the end of the rasterization of the frame,
+  /// in microseconds.
+  int64_t raster_duration_us;
+  /// The time between the vsync and the start of the build of the frame, in
+  /// microseconds.
+  int64_t vsync_overhead_us;
+  /// The time between the vsync and the end of the rasterization of the frame,
+  /// in microseconds.
+  int64_t total_span_us;
+} FlutterFrameTimingPercentile;
+
+/// The state of an engine instance that its performance depends on, as
+/// returned by `FlutterEngineGetStatistics`.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterEngineStatistics).
+  size_t struct_size;
+  /// The number of frames rasterized so far, from which the percentiles of
+  /// the durations are computed. None of the durations are meaningful if this
+  /// is zero.
+  uint64_t frame_count;
+  /// The 50th, 90th and 99th percentiles of the times between the start and
+  /// the end of the builds of the frames, in microseconds.
+  int64_t build_duration_p50_us;
+  int64_t build_duration_p90_us;
+  int64_t build_duration_p99_us;
+  /// The 50th, 90th and 99th percentiles of the times between the start and
+  /// the end of the rasterizations of the frames, in microseconds.
+  int64_t raster_duration_p50_us;
+  int64_t raster_duration_p90_us;
+  int64_t raster_duration_p99_us;
+  /// The number and the size of the layers cached by the raster cache during
+  /// the last frame.
+  size_t raster_cache_layer_count;
+  size_t raster_cache_layer_bytes;
+  /// The number and the size of the pictures cached by the raster cache
+  /// during the last frame.
+  size_t raster_cache_picture_count;
+  size_t raster_cache_picture_bytes;
+  /// The limit and the usage of Skia's cache of GPU resources. Both are zero
+  /// if the engine renders without a GPU context.
+  size_t resource_cache_max_bytes;
+  size_t resource_cache_usage_bytes;
+  /// The number of the tasks posted to each task runner of the engine that
+  /// have not run yet. The tasks of a task runner that runs on the thread of
+  /// another are counted by that other task runner.
+  size_t platform_task_runner_pending_tasks;
+  size_t ui_task_runner_pending_tasks;
+  size_t raster_task_runner_pending_tasks;
+  size_t io_task_runner_pending_tasks;
+  /// The number of frames that may be built ahead of their rasterization,
+  /// and the number of frames built but not rasterized yet.
+  uint32_t pipeline_depth;
+  uint32_t pipeline_frames_in_flight;
+} FlutterEngineStatistics;
+
 typedef int64_t FlutterEngineDartPort;
 
 typedef enum {
@@ -1872,6 +2164,45 @@ FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineRunInitialized(
     FLUTTER_API_SYMBOL(FlutterEngine) engine);
 
+//------------------------------------------------------------------------------
+/// @brief      Creates and runs an engine instance spawned from a running one,
+///             to drive another surface, such as another display, from the
+///             same process at a fraction of the cost of another engine.
+///
+///             The spawned engine shares the Dart VM, the isolate group, the
+///             font collection, the IO manager, the budget of the raster cache
+///             and the threads of the engine that it is spawned from. It has
+///             its own root isolate, window metrics, layer trees, surface and
+///             callbacks, which are set up by `config` and `args` as if they
+///             were passed to `FlutterEngineInitialize`.
+///
+///             Only the callbacks, the compositor, the Dart entrypoint and its
+///             arguments are taken from `args`. The snapshots, the assets, the
+///             command line arguments and the custom task runners are the ones
+///             of the engine that the new engine is spawned from. Either
+///             engine may be shut down first.
+///
+/// @param[in]  version    The Flutter embedder API version. Must be
+///                        FLUTTER_ENGINE_VERSION.
+/// @param[in]  spawner    The running engine instance to spawn from.
+/// @param[in]  config     The renderer configuration of the spawned engine.
+/// @param[in]  args       The Flutter project arguments of the spawned engine.
+/// @param      user_data  A user data baton passed back to embedders in the
+///                        callbacks of the spawned engine.
+/// @param[out] engine_out The engine handle on successful engine creation.
+///
+/// @return     The result of the call to spawn the Flutter engine.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSpawn(size_t version,
+                                       FLUTTER_API_SYMBOL(FlutterEngine)
+                                           spawner,
+                                       const FlutterRendererConfig* config,
+                                       const FlutterProjectArgs* args,
+                                       void* user_data,
+                                       FLUTTER_API_SYMBOL(FlutterEngine) *
+                                           engine_out);
+
 FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineSendWindowMetricsEvent(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
@@ -1914,6 +2245,59 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPlatformMessage* message);
 
+//------------------------------------------------------------------------------
+/// @brief      Sends a platform message to the engine like
+///             `FlutterEngineSendPlatformMessage`, but lends the buffer of the
+///             message to the engine instead of having it copied. This is
+///             meant for embedders that send large messages at high rates.
+///
+///             Unless the call returns `kInvalidArguments`, the engine takes
+///             the buffer and hands it back exactly once, by invoking the
+///             release callback on any thread, once neither the engine nor the
+///             Flutter application use it anymore. Until then, the embedder
+///             must neither modify nor free the buffer. Large messages may be
+///             handed to the Flutter application as is, which may write to
+///             them, so the buffer must be writable.
+///
+/// @param[in]  engine             A running engine instance.
+/// @param[in]  message            The message to send. Only the buffer of the
+///                                message is used after the call returns.
+/// @param[in]  release_callback   The callback that hands back the buffer.
+/// @param[in]  release_user_data  The user data passed to the callback.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSendPlatformMessageNoCopy(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* message,
+    FlutterPlatformMessageReleaseCallback release_callback,
+    void* release_user_data);
+
+//------------------------------------------------------------------------------
+/// @brief      Sends a batch of window metrics, pointer, key and platform
+///             message events to the engine. The events are handled in their
+///             order, as if each had been sent with its own call, but the
+///             whole batch only wakes up the UI thread once. This is meant for
+///             embedders that send events at high rates, for example to replay
+///             a stream of input.
+///
+///             If any of the events is invalid, none of them is sent and the
+///             callbacks of the key events are not invoked.
+///
+/// @param[in]  engine        A running engine instance.
+/// @param[in]  events        The events to send. This function will no longer
+///                           access `events` after returning.
+/// @param[in]  events_count  The number of the events.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSendEvents(FLUTTER_API_SYMBOL(FlutterEngine)
+                                                engine,
+                                            const FlutterEngineEvent* events,
+                                            size_t events_count);
+
 //------------------------------------------------------------------------------
 /// @brief     Creates a platform message response handle that allows the
 ///            embedder to set a native callback for a response to a message.
@@ -2062,6 +2446,51 @@ FlutterEngineResult FlutterEngineMarkExternalTextureFrameAvailable(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     int64_t texture_identifier);
 
+//------------------------------------------------------------------------------
+/// @brief      Register a buffered external texture with a unique (per engine)
+///             identifier. Unlike the textures registered with
+///             `FlutterEngineRegisterExternalTexture`, the engine does not ask
+///             the embedder for the frames of a buffered texture on the raster
+///             thread. Instead, the embedder pushes each frame, from any
+///             thread, with `FlutterEnginePushExternalTextureFrame`, and up to
+///             three frames may wait to be painted. Only the OpenGL rendering
+///             backend supports buffered external textures.
+///
+/// @see        FlutterEngineUnregisterExternalTexture()
+/// @see        FlutterEnginePushExternalTextureFrame()
+///
+/// @param[in]  engine              A running engine instance.
+/// @param[in]  texture_identifier  The identifier of the texture to register
+///                                 with the engine.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineRegisterBufferedExternalTexture(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier);
+
+//------------------------------------------------------------------------------
+/// @brief      Push a new frame onto a buffered external texture. This may be
+///             called on any thread. The next frame of the engine paints the
+///             newest pushed frame, and drops the older frames that were not
+///             painted yet.
+///
+/// @see        FlutterEngineRegisterBufferedExternalTexture()
+///
+/// @param[in]  engine              A running engine instance.
+/// @param[in]  texture_identifier  The identifier of the buffered texture.
+/// @param[in]  frame               The new frame. The engine takes ownership
+///                                 of its texture, even if the call fails.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEnginePushExternalTextureFrame(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier,
+    const FlutterOpenGLTextureFrame* frame);
+
 //------------------------------------------------------------------------------
 /// @brief      Enable or disable accessibility semantics.
 ///
@@ -2389,6 +2818,62 @@ FlutterEngineResult FlutterEngineNotifyDisplayUpdate(
     const FlutterEngineDisplay* displays,
     size_t display_count);
 
+//------------------------------------------------------------------------------
+/// @brief      Gets the durations of the phases of the frames rasterized so
+///             far by a running engine instance at a percentile. This may be
+///             called on any thread.
+///
+/// @param[in]     engine      A running engine instance.
+/// @param[in,out] percentile  The percentile to get, with its `percentile`
+///                            and `struct_size` set by the embedder. The
+///                            other fields are set by the engine.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetFrameTimingPercentile(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameTimingPercentile* percentile);
+
+//------------------------------------------------------------------------------
+/// @brief      Gets the statistics of a running engine instance, without the
+///             VM service. This may be called on any thread but the UI and
+///             raster threads of the engine, and blocks until both of them
+///             have reported their state.
+///
+/// @param[in]     engine      A running engine instance.
+/// @param[in,out] statistics  The statistics, with their `struct_size` set by
+///                            the embedder. The other fields are set by the
+///                            engine.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineStatistics* statistics);
+
+//------------------------------------------------------------------------------
+/// @brief      Dumps the trace events recorded so far into the trace ring
+///             buffers of the process as a Chrome trace event JSON object.
+///             The ring buffers are enabled by passing the
+///             `--enable-trace-ring-buffer` switch in the command line
+///             arguments of the project. This may be called on any thread.
+///
+/// @param[in]  engine     A running engine instance.
+/// @param[in]  callback   Called before this call returns with the UTF-8
+///                        encoded JSON, which is only valid for the duration
+///                        of the callback.
+/// @param[in]  user_data  The user data passed to the callback.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetTraceRingBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterDataCallback callback,
+    void* user_data);
+
 #endif  // !FLUTTER_ENGINE_NO_PROTOTYPES
 
 // Typedefs for the function pointers in FlutterEngineProcTable.
@@ -2415,6 +2900,13 @@ typedef FlutterEngineResult (*FlutterEngineDeinitializeFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine);
 typedef FlutterEngineResult (*FlutterEngineRunInitializedFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine);
+typedef FlutterEngineResult (*FlutterEngineSpawnFnPtr)(
+    size_t version,
+    FLUTTER_API_SYMBOL(FlutterEngine) spawner,
+    const FlutterRendererConfig* config,
+    const FlutterProjectArgs* args,
+    void* user_data,
+    FLUTTER_API_SYMBOL(FlutterEngine) * engine_out);
 typedef FlutterEngineResult (*FlutterEngineSendWindowMetricsEventFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterWindowMetricsEvent* event);
@@ -2430,6 +2922,15 @@ typedef FlutterEngineResult (*FlutterEngineSendKeyEventFnPtr)(
 typedef FlutterEngineResult (*FlutterEngineSendPlatformMessageFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPlatformMessage* message);
+typedef FlutterEngineResult (*FlutterEngineSendEventsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterEngineEvent* events,
+    size_t events_count);
+typedef FlutterEngineResult (*FlutterEngineSendPlatformMessageNoCopyFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* message,
+    FlutterPlatformMessageReleaseCallback release_callback,
+    void* release_user_data);
 typedef FlutterEngineResult (
     *FlutterEnginePlatformMessageCreateResponseHandleFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
@@ -2505,6 +3006,24 @@ typedef FlutterEngineResult (*FlutterEngineNotifyDisplayUpdateFnPtr)(
     FlutterEngineDisplaysUpdateType update_type,
     const FlutterEngineDisplay* displays,
     size_t display_count);
+typedef FlutterEngineResult (*FlutterEngineGetFrameTimingPercentileFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameTimingPercentile* percentile);
+typedef FlutterEngineResult (*FlutterEngineGetStatisticsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineStatistics* statistics);
+typedef FlutterEngineResult (
+    *FlutterEngineRegisterBufferedExternalTextureFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier);
+typedef FlutterEngineResult (*FlutterEnginePushExternalTextureFrameFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier,
+    const FlutterOpenGLTextureFrame* frame);
+typedef FlutterEngineResult (*FlutterEngineGetTraceRingBufferFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterDataCallback callback,
+    void* user_data);
 
 /// Function-pointer-based versions of the APIs above.
 typedef struct {
@@ -2549,6 +3068,15 @@ typedef struct {
   FlutterEnginePostCallbackOnAllNativeThreadsFnPtr
       PostCallbackOnAllNativeThreads;
   FlutterEngineNotifyDisplayUpdateFnPtr NotifyDisplayUpdate;
+  FlutterEngineGetFrameTimingPercentileFnPtr GetFrameTimingPercentile;
+  FlutterEngineRegisterBufferedExternalTextureFnPtr
+      RegisterBufferedExternalTexture;
+  FlutterEnginePushExternalTextureFrameFnPtr PushExternalTextureFrame;
+  FlutterEngineGetTraceRingBufferFnPtr GetTraceRingBuffer;
+  FlutterEngineSendEventsFnPtr SendEvents;
+  FlutterEngineSendPlatformMessageNoCopyFnPtr SendPlatformMessageNoCopy;
+  FlutterEngineGetStatisticsFnPtr GetStatistics;
+  FlutterEngineSpawnFnPtr Spawn;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
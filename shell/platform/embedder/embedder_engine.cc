@@ -22,7 +22,7 @@ struct ShellArgs {
 };
 
 EmbedderEngine::EmbedderEngine(
-    std::unique_ptr<EmbedderThreadHost> thread_host,
+    std::shared_ptr<EmbedderThreadHost> thread_host,
     flutter::TaskRunners task_runners,
     flutter::Settings settings,
     RunConfiguration run_configuration,
@@ -60,6 +60,33 @@ bool EmbedderEngine::LaunchShell() {
   return IsValid();
 }
 
+std::unique_ptr<EmbedderEngine> EmbedderEngine::Spawn(
+    RunConfiguration run_configuration,
+    Shell::CreateCallback<PlatformView> on_create_platform_view,
+    Shell::CreateCallback<Rasterizer> on_create_rasterizer,
+    std::unique_ptr<EmbedderExternalTextureResolver> external_texture_resolver)
+    const {
+  if (!IsValid()) {
+    return nullptr;
+  }
+
+  auto spawned_engine = std::make_unique<EmbedderEngine>(
+      thread_host_, task_runners_, shell_->GetSettings(),
+      std::move(run_configuration), on_create_platform_view,
+      on_create_rasterizer, std::move(external_texture_resolver));
+
+  // The spawned shell runs its root isolate right away.
+  spawned_engine->shell_ = shell_->Spawn(
+      std::move(spawned_engine->run_configuration_), /*initial_route=*/"",
+      on_create_platform_view, on_create_rasterizer);
+  spawned_engine->shell_args_.reset();
+
+  if (!spawned_engine->IsValid()) {
+    return nullptr;
+  }
+  return spawned_engine;
+}
+
 bool EmbedderEngine::CollectShell() {
   shell_.reset();
   return IsValid();
@@ -142,6 +169,20 @@ bool EmbedderEngine::SendPlatformMessage(
   return true;
 }
 
+bool EmbedderEngine::DispatchPlatformEvents(std::vector<PlatformEvent> events) {
+  if (!IsValid()) {
+    return false;
+  }
+
+  auto platform_view = shell_->GetPlatformView();
+  if (!platform_view) {
+    return false;
+  }
+
+  platform_view->DispatchPlatformEvents(std::move(events));
+  return true;
+}
+
 bool EmbedderEngine::RegisterTexture(int64_t texture) {
   if (!IsValid()) {
     return false;
@@ -155,6 +196,10 @@ bool EmbedderEngine::UnregisterTexture(int64_t texture) {
   if (!IsValid()) {
     return false;
   }
+  {
+    std::scoped_lock lock(buffered_textures_mutex_);
+    buffered_textures_.erase(texture);
+  }
   shell_->GetPlatformView()->UnregisterTexture(texture);
   return true;
 }
@@ -167,6 +212,43 @@ bool EmbedderEngine::MarkTextureFrameAvailable(int64_t texture) {
   return true;
 }
 
+bool EmbedderEngine::RegisterBufferedTexture(int64_t texture) {
+  if (!IsValid()) {
+    return false;
+  }
+  auto buffered_texture = std::make_shared<BufferedTexture>(texture);
+  {
+    std::scoped_lock lock(buffered_textures_mutex_);
+    buffered_textures_[texture] = buffered_texture;
+  }
+  shell_->GetPlatformView()->RegisterTexture(std::move(buffered_texture));
+  return true;
+}
+
+bool EmbedderEngine::PushTextureFrame(
+    int64_t texture,
+    std::unique_ptr<BufferedTextureFrame> frame) {
+  if (!IsValid()) {
+    return false;
+  }
+  {
+    std::scoped_lock lock(buffered_textures_mutex_);
+    auto found = buffered_textures_.find(texture);
+    if (found == buffered_textures_.end()) {
+      return false;
+    }
+    found->second->PushFrame(std::move(frame));
+  }
+  // Marking the texture schedules the frame that paints the pushed frame.
+  task_runners_.GetPlatformTaskRunner()->PostTask(
+      [platform_view = shell_->GetPlatformView(), texture]() {
+        if (platform_view) {
+          platform_view->MarkTextureFrameAvailable(texture);
+        }
+      });
+  return true;
+}
+
 bool EmbedderEngine::SetSemanticsEnabled(bool enabled) {
   if (!IsValid()) {
     return false;
@@ -6,7 +6,9 @@
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_ENGINE_H_
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/shell/common/shell.h"
@@ -22,7 +24,7 @@ struct ShellArgs;
 // instance of the Flutter engine.
 class EmbedderEngine {
  public:
-  EmbedderEngine(std::unique_ptr<EmbedderThreadHost> thread_host,
+  EmbedderEngine(std::shared_ptr<EmbedderThreadHost> thread_host,
                  TaskRunners task_runners,
                  Settings settings,
                  RunConfiguration run_configuration,
@@ -35,6 +37,21 @@ class EmbedderEngine {
 
   bool LaunchShell();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates an engine whose shell is spawned from the running
+  ///             shell of this engine, with its own platform view and
+  ///             rasterizer. The engines share their threads, and the spawned
+  ///             engine is running once created.
+  ///
+  /// @see        `Shell::Spawn`
+  ///
+  std::unique_ptr<EmbedderEngine> Spawn(
+      RunConfiguration run_configuration,
+      Shell::CreateCallback<PlatformView> on_create_platform_view,
+      Shell::CreateCallback<Rasterizer> on_create_rasterizer,
+      std::unique_ptr<EmbedderExternalTextureResolver>
+          external_texture_resolver) const;
+
   bool CollectShell();
 
   const TaskRunners& GetTaskRunners() const;
@@ -54,12 +71,20 @@ class EmbedderEngine {
 
   bool SendPlatformMessage(std::unique_ptr<PlatformMessage> message);
 
+  bool DispatchPlatformEvents(std::vector<PlatformEvent> events);
+
   bool RegisterTexture(int64_t texture);
 
   bool UnregisterTexture(int64_t texture);
 
   bool MarkTextureFrameAvailable(int64_t texture);
 
+  bool RegisterBufferedTexture(int64_t texture);
+
+  // May be called on any thread.
+  bool PushTextureFrame(int64_t texture,
+                        std::unique_ptr<BufferedTextureFrame> frame);
+
   bool SetSemanticsEnabled(bool enabled);
 
   bool SetAccessibilityFeatures(int32_t flags);
@@ -84,12 +109,19 @@ class EmbedderEngine {
   Shell& GetShell();
 
  private:
-  const std::unique_ptr<EmbedderThreadHost> thread_host_;
+  // Shared with the engines spawned from this one, or that this one was
+  // spawned from.
+  const std::shared_ptr<EmbedderThreadHost> thread_host_;
   TaskRunners task_runners_;
   RunConfiguration run_configuration_;
   std::unique_ptr<ShellArgs> shell_args_;
   std::unique_ptr<Shell> shell_;
   std::unique_ptr<EmbedderExternalTextureResolver> external_texture_resolver_;
+  std::mutex buffered_textures_mutex_;
+  // The buffered textures by their identifiers, for the frames pushed from
+  // other threads than the platform thread.
+  std::unordered_map<int64_t, std::shared_ptr<BufferedTexture>>
+      buffered_textures_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderEngine);
 };
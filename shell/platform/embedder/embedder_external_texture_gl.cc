@@ -7,6 +7,7 @@
 #include "flutter/fml/logging.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkSize.h"
+#include "third_party/skia/include/gpu/GrBackendSemaphore.h"
 #include "third_party/skia/include/gpu/GrBackendSurface.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
@@ -110,4 +111,56 @@ void EmbedderExternalTextureGL::MarkNewFrameAvailable() {
 // |flutter::Texture|
 void EmbedderExternalTextureGL::OnTextureUnregistered() {}
 
+EmbedderExternalTextureGLFrame::EmbedderExternalTextureGLFrame(
+    const FlutterOpenGLTextureFrame& frame)
+    : texture_(frame.texture), fence_(frame.fence) {}
+
+EmbedderExternalTextureGLFrame::~EmbedderExternalTextureGLFrame() {
+  if (owns_texture_ && texture_.destruction_callback) {
+    texture_.destruction_callback(texture_.user_data);
+  }
+}
+
+sk_sp<SkImage> EmbedderExternalTextureGLFrame::MakeImage(
+    GrDirectContext* context) {
+  if (!context) {
+    return nullptr;
+  }
+
+  if (fence_) {
+    // Only the GPU waits for the producer, so painting the frame never blocks
+    // the raster thread. The fence still belongs to the embedder.
+    GrBackendSemaphore semaphore;
+    semaphore.initGL(static_cast<GrGLsync>(fence_));
+    if (!context->wait(1, &semaphore, /*deleteSemaphoresAfterWait=*/false)) {
+      FML_LOG(ERROR) << "Could not wait for the fence of an external texture "
+                        "frame. Fences are not supported by this context.";
+      return nullptr;
+    }
+  }
+
+  GrGLTextureInfo gr_texture_info = {texture_.target, texture_.name,
+                                     texture_.format};
+  GrBackendTexture gr_backend_texture(texture_.width, texture_.height,
+                                      GrMipMapped::kNo, gr_texture_info);
+  auto image = SkImage::MakeFromTexture(
+      context,                        // context
+      gr_backend_texture,             // texture handle
+      kTopLeft_GrSurfaceOrigin,       // origin
+      kRGBA_8888_SkColorType,         // color type
+      kPremul_SkAlphaType,            // alpha type
+      nullptr,                        // colorspace
+      texture_.destruction_callback,  // texture release proc
+      texture_.user_data              // texture release context
+  );
+
+  if (!image) {
+    FML_LOG(ERROR) << "Could not create external texture frame.";
+    return nullptr;
+  }
+
+  owns_texture_ = false;
+  return image;
+}
+
 }  // namespace flutter
@@ -54,6 +54,30 @@ class EmbedderExternalTextureGL : public flutter::Texture {
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderExternalTextureGL);
 };
 
+// A frame pushed with |FlutterEnginePushExternalTextureFrame| onto a
+// |BufferedTexture|. The texture of the frame is sampled in place once the
+// GPU has waited for the fence of the frame, if it has one.
+class EmbedderExternalTextureGLFrame : public BufferedTextureFrame {
+ public:
+  explicit EmbedderExternalTextureGLFrame(
+      const FlutterOpenGLTextureFrame& frame);
+
+  // |BufferedTextureFrame|
+  ~EmbedderExternalTextureGLFrame() override;
+
+  // |BufferedTextureFrame|
+  sk_sp<SkImage> MakeImage(GrDirectContext* context) override;
+
+ private:
+  FlutterOpenGLTexture texture_;
+  void* fence_;
+  // Whether the texture still has to be released by this frame rather than
+  // by the image that wraps it.
+  bool owns_texture_ = true;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbedderExternalTextureGLFrame);
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_EXTERNAL_TEXTURE_GL_H_
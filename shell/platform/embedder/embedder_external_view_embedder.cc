@@ -6,6 +6,7 @@
 
 #include <algorithm>
 
+#include "flutter/fml/trace_event.h"
 #include "flutter/shell/platform/embedder/embedder_layers.h"
 #include "flutter/shell/platform/embedder/embedder_render_target.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
@@ -14,11 +15,15 @@ namespace flutter {
 
 EmbedderExternalViewEmbedder::EmbedderExternalViewEmbedder(
     bool avoid_backing_store_cache,
+    size_t backing_store_cache_max_unused_frames,
+    size_t backing_store_cache_max_bytes,
     const CreateRenderTargetCallback& create_render_target_callback,
     const PresentCallback& present_callback)
     : avoid_backing_store_cache_(avoid_backing_store_cache),
       create_render_target_callback_(create_render_target_callback),
-      present_callback_(present_callback) {
+      present_callback_(present_callback),
+      render_target_cache_(backing_store_cache_max_unused_frames,
+                           backing_store_cache_max_bytes) {
   FML_DCHECK(create_render_target_callback_);
   FML_DCHECK(present_callback_);
 }
@@ -122,6 +127,23 @@ SkCanvas* EmbedderExternalViewEmbedder::CompositeEmbeddedView(int view_id) {
   return found->second->GetCanvas();
 }
 
+// |ExternalViewEmbedder|
+bool EmbedderExternalViewEmbedder::UsesFrameDamage() const {
+  return true;
+}
+
+std::optional<SkIRect> EmbedderExternalViewEmbedder::GetLayerDamage(
+    const SurfaceFrame& frame) const {
+  if (last_surface_transformation_ != pending_surface_transformation_ ||
+      !std::equal(composition_order_.begin(), composition_order_.end(),
+                  last_composition_order_.begin(),
+                  last_composition_order_.end(),
+                  EmbedderExternalView::ViewIdentifier::Equal{})) {
+    return std::nullopt;
+  }
+  return frame.submit_info().frame_damage;
+}
+
 static FlutterBackingStoreConfig MakeBackingStoreConfig(
     const SkISize& backing_store_size) {
   FlutterBackingStoreConfig config = {};
@@ -146,7 +168,7 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   // OpenGL context.
   //
   // For optimum performance, we should tell the render target cache to clear
-  // its unused entries before allocating new ones. This collection step before
+  // its expired entries before allocating new ones. This collection step before
   // allocating new render targets ameliorates peak memory usage within the
   // frame. But, this causes an issue in a known internal embedder. To work
   // around this issue while that embedder migrates, collection of render
@@ -154,7 +176,7 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   //
   // @warning: Embedder may trample on our OpenGL context here.
   auto deferred_cleanup_render_targets =
-      render_target_cache_.ClearAllRenderTargetsInCache();
+      render_target_cache_.CollectExpiredRenderTargets();
 
   for (const auto& pending_key : pending_keys) {
     const auto& external_view = pending_views_.at(pending_key);
@@ -192,8 +214,16 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
       return;
     }
     matched_render_targets[pending_key] = std::move(render_target);
+    created_render_targets_count_++;
   }
 
+  FML_TRACE_COUNTER("flutter", "EmbedderRenderTargets",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "Created", created_render_targets_count_, "Reused",
+                    render_target_cache_.GetReusedTargetsCount(),
+                    "CachedBytes",
+                    render_target_cache_.GetCachedTargetsBytes());
+
   // The OpenGL context could have been trampled by the embedder at this point
   // as it attempted to collect old render targets and create new ones. Tell
   // Skia to not rely on existing bindings.
@@ -228,6 +258,9 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
     EmbedderLayers presented_layers(pending_frame_size_,
                                     pending_device_pixel_ratio_,
                                     pending_surface_transformation_);
+    // The damage is computed for the whole frame, so it is the same for all of
+    // the layers of backing stores.
+    const std::optional<SkIRect> layer_damage = GetLayerDamage(*frame);
     // In composition order, submit backing stores and platform views to the
     // embedder.
     for (const auto& view_id : composition_order_) {
@@ -248,7 +281,7 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
       if (external_view->HasEngineRenderedContents()) {
         const auto& exteral_render_target = matched_render_targets.at(view_id);
         presented_layers.PushBackingStoreLayer(
-            exteral_render_target->GetBackingStore());
+            exteral_render_target->GetBackingStore(), layer_damage);
       }
     }
 
@@ -256,6 +289,8 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
     //
     // @warning: Embedder may trample on our OpenGL context here.
     presented_layers.InvokePresentCallback(present_callback_);
+    last_composition_order_ = composition_order_;
+    last_surface_transformation_ = pending_surface_transformation_;
   }
 
   // See why this is necessary in the comment where this collection in realized.
@@ -263,8 +298,8 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   // @warning: Embedder may trample on our OpenGL context here.
   deferred_cleanup_render_targets.clear();
 
-  // Hold all rendered layers in the render target cache for one frame to
-  // see if they may be reused next frame.
+  // Hold all rendered layers in the render target cache to see if they may be
+  // reused in the next frames.
   for (auto& render_target : matched_render_targets) {
     if (!avoid_backing_store_cache_) {
       render_target_cache_.CacheRenderTarget(render_target.first,
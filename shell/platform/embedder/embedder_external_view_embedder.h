@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_EXTERNAL_VIEW_EMBEDDER_H_
 
 #include <map>
+#include <optional>
 #include <unordered_map>
 
 #include "flutter/flow/embedded_views.h"
@@ -44,7 +45,12 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   ///                                      will beinvoked every frame for every
   ///                                      engine composited layer. The result
   ///                                      will not cached.
-  ///
+  /// @param[in]  backing_store_cache_max_unused_frames
+  ///                                     The number of frames a render target
+  ///                                     may go unused before it is collected.
+  /// @param[in]  backing_store_cache_max_bytes
+  ///                                     The budget of the render targets
+  ///                                     kept unused, or 0 for no budget.
   /// @param[in]  create_render_target_callback
   ///                                     The render target callback used to
   ///                                     request the render target for a layer.
@@ -55,6 +61,8 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   ///
   EmbedderExternalViewEmbedder(
       bool avoid_backing_store_cache,
+      size_t backing_store_cache_max_unused_frames,
+      size_t backing_store_cache_max_bytes,
       const CreateRenderTargetCallback& create_render_target_callback,
       const PresentCallback& present_callback);
 
@@ -103,6 +111,9 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   // |ExternalViewEmbedder|
   SkCanvas* GetRootCanvas() override;
 
+  // |ExternalViewEmbedder|
+  bool UsesFrameDamage() const override;
+
  private:
   const bool avoid_backing_store_cache_;
   const CreateRenderTargetCallback create_render_target_callback_;
@@ -114,9 +125,18 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   EmbedderExternalView::PendingViews pending_views_;
   std::vector<EmbedderExternalView::ViewIdentifier> composition_order_;
   EmbedderRenderTargetCache render_target_cache_;
+  size_t created_render_targets_count_ = 0;
+  // How the layers of the last presented frame were composed, which the
+  // damage of the next frame only applies to if it is composed the same way.
+  std::vector<EmbedderExternalView::ViewIdentifier> last_composition_order_;
+  std::optional<SkMatrix> last_surface_transformation_;
 
   void Reset();
 
+  // The damage of the frame to present, relative to the last presented frame,
+  // if it applies to the layers of both frames.
+  std::optional<SkIRect> GetLayerDamage(const SurfaceFrame& frame) const;
+
   SkMatrix GetSurfaceTransformation() const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderExternalViewEmbedder);
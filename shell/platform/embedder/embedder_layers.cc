@@ -17,7 +17,9 @@ EmbedderLayers::EmbedderLayers(SkISize frame_size,
 
 EmbedderLayers::~EmbedderLayers() = default;
 
-void EmbedderLayers::PushBackingStoreLayer(const FlutterBackingStore* store) {
+void EmbedderLayers::PushBackingStoreLayer(
+    const FlutterBackingStore* store,
+    const std::optional<SkIRect>& damage) {
   FlutterLayer layer = {};
 
   layer.struct_size = sizeof(FlutterLayer);
@@ -35,6 +37,22 @@ void EmbedderLayers::PushBackingStoreLayer(const FlutterBackingStore* store) {
   layer.size.width = transformed_layer_bounds.width();
   layer.size.height = transformed_layer_bounds.height();
 
+  if (damage) {
+    const auto transformed_damage =
+        damage->isEmpty()
+            ? SkRect::MakeEmpty()
+            : root_surface_transformation_.mapRect(SkRect::Make(*damage));
+    FlutterRect rect = {};
+    rect.left = transformed_damage.left();
+    rect.top = transformed_damage.top();
+    rect.right = transformed_damage.right();
+    rect.bottom = transformed_damage.bottom();
+    layer.damage =
+        damage_referenced_.emplace_back(std::make_unique<FlutterRect>(rect))
+            .get();
+    layer.unchanged_since_last_present = damage->isEmpty();
+  }
+
   presented_layers_.push_back(layer);
 }
 
@@ -4,9 +4,14 @@
 
 #include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace flutter {
 
-EmbedderRenderTargetCache::EmbedderRenderTargetCache() = default;
+EmbedderRenderTargetCache::EmbedderRenderTargetCache(size_t max_unused_frames,
+                                                     size_t max_bytes)
+    : max_unused_frames_(max_unused_frames), max_bytes_(max_bytes) {}
 
 EmbedderRenderTargetCache::~EmbedderRenderTargetCache() = default;
 
@@ -17,39 +22,79 @@ EmbedderRenderTargetCache::GetExistingTargetsInCache(
   RenderTargets resolved_render_targets;
   EmbedderExternalView::ViewIdentifierSet unmatched_identifiers;
 
+  // The views first get the render targets they used last, so that the views
+  // that are new to the frame do not take them.
+  std::vector<const EmbedderExternalView*> unmatched_views;
   for (const auto& view : pending_views) {
     const auto& external_view = view.second;
     if (!external_view->HasEngineRenderedContents()) {
       continue;
     }
-    auto& compatible_targets =
-        cached_render_targets_[external_view->CreateRenderTargetDescriptor()];
-    if (compatible_targets.size() == 0) {
-      unmatched_identifiers.insert(view.first);
+    const auto descriptor = external_view->CreateRenderTargetDescriptor();
+    auto cached = std::find_if(
+        cached_render_targets_.begin(), cached_render_targets_.end(),
+        [&descriptor](const CachedRenderTarget& cached) {
+          return EmbedderExternalView::RenderTargetDescriptor::Equal{}(
+              cached.descriptor, descriptor);
+        });
+    if (cached == cached_render_targets_.end()) {
+      unmatched_views.push_back(external_view.get());
+    } else {
+      resolved_render_targets[view.first] = TakeRenderTarget(cached);
+    }
+  }
+
+  // Render targets are cleared before a view renders into them, so any render
+  // target of the right size will do for the others.
+  for (const auto* external_view : unmatched_views) {
+    const auto size = external_view->GetRenderSurfaceSize();
+    auto cached = std::find_if(cached_render_targets_.begin(),
+                               cached_render_targets_.end(),
+                               [&size](const CachedRenderTarget& cached) {
+                                 return cached.descriptor.surface_size == size;
+                               });
+    if (cached == cached_render_targets_.end()) {
+      unmatched_identifiers.insert(external_view->GetViewIdentifier());
     } else {
-      std::unique_ptr<EmbedderRenderTarget> target =
-          std::move(compatible_targets.top());
-      compatible_targets.pop();
-      resolved_render_targets[view.first] = std::move(target);
+      resolved_render_targets[external_view->GetViewIdentifier()] =
+          TakeRenderTarget(cached);
     }
   }
+  reused_targets_count_ += resolved_render_targets.size();
   return {std::move(resolved_render_targets), std::move(unmatched_identifiers)};
 }
 
 std::set<std::unique_ptr<EmbedderRenderTarget>>
 EmbedderRenderTargetCache::ClearAllRenderTargetsInCache() {
   std::set<std::unique_ptr<EmbedderRenderTarget>> cleared_targets;
-  for (auto& targets : cached_render_targets_) {
-    auto& targets_stack = targets.second;
-    while (!targets_stack.empty()) {
-      cleared_targets.emplace(std::move(targets_stack.top()));
-      targets_stack.pop();
-    }
+  for (auto& cached : cached_render_targets_) {
+    cleared_targets.emplace(std::move(cached.target));
   }
   cached_render_targets_.clear();
+  cached_bytes_ = 0;
   return cleared_targets;
 }
 
+std::set<std::unique_ptr<EmbedderRenderTarget>>
+EmbedderRenderTargetCache::CollectExpiredRenderTargets() {
+  frame_++;
+  std::set<std::unique_ptr<EmbedderRenderTarget>> expired_targets;
+  // The least recently used render targets are the last, so that they are
+  // the first to leave the budget.
+  while (!cached_render_targets_.empty()) {
+    auto& least_recently_used = cached_render_targets_.back();
+    const bool expired =
+        frame_ - least_recently_used.frame > max_unused_frames_;
+    const bool over_budget = max_bytes_ > 0 && cached_bytes_ > max_bytes_;
+    if (!expired && !over_budget) {
+      break;
+    }
+    expired_targets.emplace(
+        TakeRenderTarget(std::prev(cached_render_targets_.end())));
+  }
+  return expired_targets;
+}
+
 void EmbedderRenderTargetCache::CacheRenderTarget(
     EmbedderExternalView::ViewIdentifier view_identifier,
     std::unique_ptr<EmbedderRenderTarget> target) {
@@ -59,15 +104,30 @@ void EmbedderRenderTargetCache::CacheRenderTarget(
   auto surface = target->GetRenderSurface();
   auto desc = EmbedderExternalView::RenderTargetDescriptor{
       view_identifier, SkISize::Make(surface->width(), surface->height())};
-  cached_render_targets_[desc].push(std::move(target));
+  const size_t bytes = surface->imageInfo().computeMinByteSize();
+  cached_render_targets_.push_front({desc, std::move(target), bytes, frame_});
+  cached_bytes_ += bytes;
 }
 
 size_t EmbedderRenderTargetCache::GetCachedTargetsCount() const {
-  size_t count = 0;
-  for (const auto& targets : cached_render_targets_) {
-    count += targets.second.size();
-  }
-  return count;
+  return cached_render_targets_.size();
+}
+
+size_t EmbedderRenderTargetCache::GetCachedTargetsBytes() const {
+  return cached_bytes_;
+}
+
+size_t EmbedderRenderTargetCache::GetReusedTargetsCount() const {
+  return reused_targets_count_;
+}
+
+std::unique_ptr<EmbedderRenderTarget>
+EmbedderRenderTargetCache::TakeRenderTarget(
+    std::list<CachedRenderTarget>::iterator cached) {
+  auto target = std::move(cached->target);
+  cached_bytes_ -= cached->bytes;
+  cached_render_targets_.erase(cached);
+  return target;
 }
 
 }  // namespace flutter
@@ -5,8 +5,8 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
 
+#include <list>
 #include <set>
-#include <stack>
 #include <tuple>
 #include <unordered_map>
 
@@ -19,9 +19,27 @@ namespace flutter {
 /// @brief      A cache used to reference render targets that are owned by the
 ///             embedder but needed by th engine to render a frame.
 ///
+///             The render targets that a frame does not use are kept for a
+///             number of frames, and within a budget of bytes, so that views
+///             that come and go across frames do not make the embedder
+///             create and collect render targets over and over.
+///
 class EmbedderRenderTargetCache {
  public:
-  EmbedderRenderTargetCache();
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a cache of render targets.
+  ///
+  /// @param[in]  max_unused_frames  The number of frames a render target may
+  ///                                go unused before it is collected. With
+  ///                                0, the render targets that a frame does
+  ///                                not use are collected right away.
+  /// @param[in]  max_bytes          The budget of the render targets that are
+  ///                                kept unused, of which the least recently
+  ///                                used are collected first. 0 means that
+  ///                                there is no budget.
+  ///
+  explicit EmbedderRenderTargetCache(size_t max_unused_frames = 0,
+                                     size_t max_bytes = 0);
 
   ~EmbedderRenderTargetCache();
 
@@ -31,6 +49,15 @@ class EmbedderRenderTargetCache {
                          EmbedderExternalView::ViewIdentifier::Hash,
                          EmbedderExternalView::ViewIdentifier::Equal>;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Takes the render targets of the pending views out of the
+  ///             cache. A view gets the render target it used last if it is
+  ///             still cached, or else the most recently used render target
+  ///             of the same size.
+  ///
+  /// @return     The render targets of the views, and the views for which no
+  ///             render target was found.
+  ///
   std::pair<RenderTargets, EmbedderExternalView::ViewIdentifierSet>
   GetExistingTargetsInCache(
       const EmbedderExternalView::PendingViews& pending_views);
@@ -38,19 +65,48 @@ class EmbedderRenderTargetCache {
   std::set<std::unique_ptr<EmbedderRenderTarget>>
   ClearAllRenderTargetsInCache();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Starts a new frame and takes the render targets that went
+  ///             unused for too many frames, or that do not fit the budget,
+  ///             out of the cache.
+  ///
+  /// @return     The render targets to collect.
+  ///
+  std::set<std::unique_ptr<EmbedderRenderTarget>>
+  CollectExpiredRenderTargets();
+
   void CacheRenderTarget(EmbedderExternalView::ViewIdentifier view_identifier,
                          std::unique_ptr<EmbedderRenderTarget> target);
 
   size_t GetCachedTargetsCount() const;
 
- private:
-  using CachedRenderTargets =
-      std::unordered_map<EmbedderExternalView::RenderTargetDescriptor,
-                         std::stack<std::unique_ptr<EmbedderRenderTarget>>,
-                         EmbedderExternalView::RenderTargetDescriptor::Hash,
-                         EmbedderExternalView::RenderTargetDescriptor::Equal>;
+  size_t GetCachedTargetsBytes() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of render targets the pending views got from the
+  ///             cache since it was created.
+  ///
+  size_t GetReusedTargetsCount() const;
 
-  CachedRenderTargets cached_render_targets_;
+ private:
+  struct CachedRenderTarget {
+    EmbedderExternalView::RenderTargetDescriptor descriptor;
+    std::unique_ptr<EmbedderRenderTarget> target;
+    size_t bytes;
+    // The frame the render target was last used in.
+    size_t frame;
+  };
+
+  const size_t max_unused_frames_;
+  const size_t max_bytes_;
+  size_t frame_ = 0;
+  size_t cached_bytes_ = 0;
+  size_t reused_targets_count_ = 0;
+  // The most recently used render target is the first.
+  std::list<CachedRenderTarget> cached_render_targets_;
+
+  std::unique_ptr<EmbedderRenderTarget> TakeRenderTarget(
+      std::list<CachedRenderTarget>::iterator cached);
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRenderTargetCache);
 };
@@ -11,9 +11,11 @@ namespace flutter {
 EmbedderSurfaceGL::EmbedderSurfaceGL(
     GLDispatchTable gl_dispatch_table,
     bool fbo_reset_after_present,
+    bool exclusive_context,
     std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
     : gl_dispatch_table_(gl_dispatch_table),
       fbo_reset_after_present_(fbo_reset_after_present),
+      exclusive_context_(exclusive_context),
       external_view_embedder_(external_view_embedder) {
   // Make sure all required members of the dispatch table are checked.
   if (!gl_dispatch_table_.gl_make_current_callback ||
@@ -44,15 +46,37 @@ bool EmbedderSurfaceGL::GLContextClearCurrent() {
   return gl_dispatch_table_.gl_clear_current_callback();
 }
 
+// |GPUSurfaceGLDelegate|
+void EmbedderSurfaceGL::GLContextSetDamageRegion(
+    const std::optional<SkIRect>& region) {
+  buffer_damage_ = region;
+}
+
 // |GPUSurfaceGLDelegate|
 bool EmbedderSurfaceGL::GLContextPresent(uint32_t fbo_id,
                                          const std::optional<SkIRect>& damage) {
-  return gl_dispatch_table_.gl_present_callback(fbo_id);
+  GLPresentInfo present_info = {fbo_id, damage, buffer_damage_};
+  buffer_damage_ = std::nullopt;
+  return gl_dispatch_table_.gl_present_callback(present_info);
 }
 
 // |GPUSurfaceGLDelegate|
 intptr_t EmbedderSurfaceGL::GLContextFBO(GLFrameInfo frame_info) const {
-  return gl_dispatch_table_.gl_fbo_callback(frame_info);
+  fbo_id_ = gl_dispatch_table_.gl_fbo_callback(frame_info);
+  return fbo_id_;
+}
+
+// |GPUSurfaceGLDelegate|
+SurfaceFrame::FramebufferInfo EmbedderSurfaceGL::GLContextFramebufferInfo()
+    const {
+  SurfaceFrame::FramebufferInfo info;
+  info.supports_readback = true;
+  auto callback = gl_dispatch_table_.gl_populate_existing_damage;
+  if (callback) {
+    info.supports_partial_repaint = true;
+    info.existing_damage = callback(fbo_id_);
+  }
+  return info;
 }
 
 // |GPUSurfaceGLDelegate|
@@ -60,6 +84,11 @@ bool EmbedderSurfaceGL::GLContextFBOResetAfterPresent() const {
   return fbo_reset_after_present_;
 }
 
+// |GPUSurfaceGLDelegate|
+bool EmbedderSurfaceGL::GLContextIsExclusive() const {
+  return exclusive_context_;
+}
+
 // |GPUSurfaceGLDelegate|
 SkMatrix EmbedderSurfaceGL::GLContextSurfaceTransformation() const {
   auto callback = gl_dispatch_table_.gl_surface_transformation_callback;
@@ -15,20 +15,29 @@ namespace flutter {
 class EmbedderSurfaceGL final : public EmbedderSurface,
                                 public GPUSurfaceGLDelegate {
  public:
+  struct GLPresentInfo {
+    uint32_t fbo_id;
+    std::optional<SkIRect> frame_damage;
+    std::optional<SkIRect> buffer_damage;
+  };
+
   struct GLDispatchTable {
     std::function<bool(void)> gl_make_current_callback;           // required
     std::function<bool(void)> gl_clear_current_callback;          // required
-    std::function<bool(uint32_t)> gl_present_callback;            // required
+    std::function<bool(GLPresentInfo)> gl_present_callback;       // required
     std::function<intptr_t(GLFrameInfo)> gl_fbo_callback;         // required
     std::function<bool(void)> gl_make_resource_current_callback;  // optional
     std::function<SkMatrix(void)>
         gl_surface_transformation_callback;              // optional
     std::function<void*(const char*)> gl_proc_resolver;  // optional
+    std::function<std::optional<SkIRect>(intptr_t)>
+        gl_populate_existing_damage;  // optional
   };
 
   EmbedderSurfaceGL(
       GLDispatchTable gl_dispatch_table,
       bool fbo_reset_after_present,
+      bool exclusive_context,
       std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
 
   ~EmbedderSurfaceGL() override;
@@ -37,6 +46,10 @@ class EmbedderSurfaceGL final : public EmbedderSurface,
   bool valid_ = false;
   GLDispatchTable gl_dispatch_table_;
   bool fbo_reset_after_present_;
+  bool exclusive_context_;
+  // The fbo last returned by the embedder, which frames are rendered into.
+  mutable intptr_t fbo_id_ = 0;
+  std::optional<SkIRect> buffer_damage_;
 
   std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
 
@@ -55,6 +68,9 @@ class EmbedderSurfaceGL final : public EmbedderSurface,
   // |GPUSurfaceGLDelegate|
   bool GLContextClearCurrent() override;
 
+  // |GPUSurfaceGLDelegate|
+  void GLContextSetDamageRegion(const std::optional<SkIRect>& region) override;
+
   // |GPUSurfaceGLDelegate|
   bool GLContextPresent(uint32_t fbo_id,
                         const std::optional<SkIRect>& damage) override;
@@ -65,6 +81,12 @@ class EmbedderSurfaceGL final : public EmbedderSurface,
   // |GPUSurfaceGLDelegate|
   bool GLContextFBOResetAfterPresent() const override;
 
+  // |GPUSurfaceGLDelegate|
+  bool GLContextIsExclusive() const override;
+
+  // |GPUSurfaceGLDelegate|
+  SurfaceFrame::FramebufferInfo GLContextFramebufferInfo() const override;
+
   // |GPUSurfaceGLDelegate|
   SkMatrix GLContextSurfaceTransformation() const override;
 
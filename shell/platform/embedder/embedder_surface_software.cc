@@ -11,10 +11,13 @@ namespace flutter {
 
 EmbedderSurfaceSoftware::EmbedderSurfaceSoftware(
     SoftwareDispatchTable software_dispatch_table,
+    std::shared_ptr<fml::ConcurrentTaskRunner> tile_task_runner,
     std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
     : software_dispatch_table_(software_dispatch_table),
+      tile_task_runner_(std::move(tile_task_runner)),
       external_view_embedder_(external_view_embedder) {
-  if (!software_dispatch_table_.software_present_backing_store) {
+  if (!software_dispatch_table_.software_present_backing_store &&
+      !software_dispatch_table_.software_present_backing_store_with_damage) {
     return;
   }
   valid_ = true;
@@ -59,10 +62,18 @@ sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireBackingStore(
 
   if (sk_surface_ != nullptr &&
       SkISize::Make(sk_surface_->width(), sk_surface_->height()) == size) {
-    // The old and new surface sizes are the same. Nothing to do here.
+    // The old and new surface sizes are the same. Only the damage of the new
+    // frame needs to be repainted if the surface holds the last frame.
+    existing_damage_ = last_frame_presented_
+                           ? std::make_optional(SkIRect::MakeEmpty())
+                           : std::nullopt;
+    last_frame_presented_ = false;
     return sk_surface_;
   }
 
+  existing_damage_ = std::nullopt;
+  last_frame_presented_ = false;
+
   SkImageInfo info = SkImageInfo::MakeN32(
       size.fWidth, size.fHeight, kPremul_SkAlphaType, SkColorSpace::MakeSRGB());
   sk_surface_ = SkSurface::MakeRaster(info, nullptr);
@@ -75,6 +86,31 @@ sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireBackingStore(
   return sk_surface_;
 }
 
+// |GPUSurfaceSoftwareDelegate|
+SurfaceFrame::FramebufferInfo EmbedderSurfaceSoftware::GetFramebufferInfo()
+    const {
+  SurfaceFrame::FramebufferInfo info;
+  info.supports_readback = true;
+  // The embedder is only told what to copy when it presents with damage.
+  if (software_dispatch_table_.software_present_backing_store_with_damage) {
+    info.supports_partial_repaint = true;
+    info.existing_damage = existing_damage_;
+  }
+  return info;
+}
+
+// |GPUSurfaceSoftwareDelegate|
+void EmbedderSurfaceSoftware::SetFrameDamage(
+    const std::optional<SkIRect>& damage) {
+  frame_damage_ = damage;
+}
+
+// |GPUSurfaceSoftwareDelegate|
+std::shared_ptr<fml::ConcurrentTaskRunner>
+EmbedderSurfaceSoftware::GetTileTaskRunner() const {
+  return tile_task_runner_;
+}
+
 // |GPUSurfaceSoftwareDelegate|
 bool EmbedderSurfaceSoftware::PresentBackingStore(
     sk_sp<SkSurface> backing_store) {
@@ -99,11 +135,27 @@ bool EmbedderSurfaceSoftware::PresentBackingStore(
     return false;
   }
 
-  return software_dispatch_table_.software_present_backing_store(
-      pixmap.addr(),      //
-      pixmap.rowBytes(),  //
-      pixmap.height()     //
-  );
+  std::optional<SkIRect> damage = frame_damage_;
+  frame_damage_ = std::nullopt;
+
+  bool presented;
+  if (software_dispatch_table_.software_present_backing_store_with_damage) {
+    presented =
+        software_dispatch_table_.software_present_backing_store_with_damage(
+            pixmap.addr(),      //
+            pixmap.rowBytes(),  //
+            pixmap.height(),    //
+            damage              //
+        );
+  } else {
+    presented = software_dispatch_table_.software_present_backing_store(
+        pixmap.addr(),      //
+        pixmap.rowBytes(),  //
+        pixmap.height()     //
+    );
+  }
+  last_frame_presented_ = presented && backing_store == sk_surface_;
+  return presented;
 }
 
 }  // namespace flutter
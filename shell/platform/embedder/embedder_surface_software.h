@@ -17,11 +17,17 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
  public:
   struct SoftwareDispatchTable {
     std::function<bool(const void* allocation, size_t row_bytes, size_t height)>
-        software_present_backing_store;  // required
+        software_present_backing_store;  // required unless with damage is set
+    std::function<bool(const void* allocation,
+                       size_t row_bytes,
+                       size_t height,
+                       const std::optional<SkIRect>& damage)>
+        software_present_backing_store_with_damage;  // optional
   };
 
   EmbedderSurfaceSoftware(
       SoftwareDispatchTable software_dispatch_table,
+      std::shared_ptr<fml::ConcurrentTaskRunner> tile_task_runner,
       std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
 
   ~EmbedderSurfaceSoftware() override;
@@ -30,6 +36,12 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   bool valid_ = false;
   SoftwareDispatchTable software_dispatch_table_;
   sk_sp<SkSurface> sk_surface_;
+  // Whether the last frame acquired from |sk_surface_| was presented, in which
+  // case the surface still holds it.
+  bool last_frame_presented_ = false;
+  std::optional<SkIRect> existing_damage_;
+  std::optional<SkIRect> frame_damage_;
+  std::shared_ptr<fml::ConcurrentTaskRunner> tile_task_runner_;
   std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
 
   // |EmbedderSurface|
@@ -44,6 +56,15 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   // |GPUSurfaceSoftwareDelegate|
   sk_sp<SkSurface> AcquireBackingStore(const SkISize& size) override;
 
+  // |GPUSurfaceSoftwareDelegate|
+  SurfaceFrame::FramebufferInfo GetFramebufferInfo() const override;
+
+  // |GPUSurfaceSoftwareDelegate|
+  void SetFrameDamage(const std::optional<SkIRect>& damage) override;
+
+  // |GPUSurfaceSoftwareDelegate|
+  std::shared_ptr<fml::ConcurrentTaskRunner> GetTileTaskRunner() const override;
+
   // |GPUSurfaceSoftwareDelegate|
   bool PresentBackingStore(sk_sp<SkSurface> backing_store) override;
 
@@ -27,11 +27,13 @@ class EmbedderTaskRunner final : public fml::TaskRunner {
     /// Delegates responsibility of deferred task execution to the embedder.
     /// Once the embedder gets the task, it must call
     /// `EmbedderTaskRunner::PostTask` with the supplied `task_baton` on the
-    /// correct thread after the tasks `target_time` point expires.
+    /// correct thread after the tasks `target_time` point expires. The
+    /// `priority` is a hint of how urgently the task has to run.
     ///
     std::function<void(EmbedderTaskRunner* task_runner,
                        uint64_t task_baton,
-                       fml::TimePoint target_time)>
+                       fml::TimePoint target_time,
+                       fml::TaskPriority priority)>
         post_task_callback;
     //--------------------------------------------------------------------------
     /// Asks the embedder if tasks posted to it on this task task runner via the
@@ -76,18 +78,23 @@ class EmbedderTaskRunner final : public fml::TaskRunner {
   DispatchTable dispatch_table_;
   std::mutex tasks_mutex_;
   uint64_t last_baton_;
-  std::unordered_map<uint64_t, fml::closure> pending_tasks_;
+  std::unordered_map<uint64_t, fml::UniqueClosure> pending_tasks_;
   fml::TaskQueueId placeholder_id_;
 
   // |fml::TaskRunner|
-  void PostTask(const fml::closure& task) override;
+  void PostTask(fml::UniqueClosure task) override;
 
   // |fml::TaskRunner|
-  void PostTaskForTime(const fml::closure& task,
+  void PostTaskForTime(fml::UniqueClosure task,
                        fml::TimePoint target_time) override;
 
   // |fml::TaskRunner|
-  void PostDelayedTask(const fml::closure& task, fml::TimeDelta delay) override;
+  void PostDelayedTask(fml::UniqueClosure task, fml::TimeDelta delay) override;
+
+  // |fml::TaskRunner|
+  void PostTaskForTimeWithPriority(fml::UniqueClosure task,
+                                   fml::TimePoint target_time,
+                                   fml::TaskPriority priority) override;
 
   // |fml::TaskRunner|
   bool RunsTasksOnCurrentThread() override;
@@ -95,6 +102,9 @@ class EmbedderTaskRunner final : public fml::TaskRunner {
   // |fml::TaskRunner|
   fml::TaskQueueId GetTaskQueueId() override;
 
+  // |fml::TaskRunner|
+  size_t GetNumPendingTasks() override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderTaskRunner);
 };
 
@@ -13,6 +13,20 @@
 
 namespace flutter {
 
+static FlutterTaskPriority ToFlutterTaskPriority(fml::TaskPriority priority) {
+  switch (priority) {
+    case fml::TaskPriority::kNormal:
+      return kFlutterTaskPriorityNormal;
+    case fml::TaskPriority::kFrame:
+      return kFlutterTaskPriorityFrame;
+    case fml::TaskPriority::kInput:
+      return kFlutterTaskPriorityInput;
+    case fml::TaskPriority::kIdle:
+      return kFlutterTaskPriorityIdle;
+  }
+  return kFlutterTaskPriorityNormal;
+}
+
 //------------------------------------------------------------------------------
 /// @brief      Attempts to create a task runner from an embedder task runner
 ///             description. The first boolean in the pair indicate whether the
@@ -52,22 +66,30 @@ CreateEmbedderTaskRunner(const FlutterTaskRunnerDescription* description) {
 
   // ABI safety checks have been completed.
   auto post_task_callback_c = description->post_task_callback;
+  auto post_task_with_priority_callback_c =
+      SAFE_ACCESS(description, post_task_with_priority_callback, nullptr);
   auto runs_task_on_current_thread_callback_c =
       description->runs_task_on_current_thread_callback;
 
   EmbedderTaskRunner::DispatchTable task_runner_dispatch_table = {
       // .post_task_callback
-      [post_task_callback_c, user_data](EmbedderTaskRunner* task_runner,
-                                        uint64_t task_baton,
-                                        fml::TimePoint target_time) -> void {
+      [post_task_callback_c, post_task_with_priority_callback_c, user_data](
+          EmbedderTaskRunner* task_runner, uint64_t task_baton,
+          fml::TimePoint target_time, fml::TaskPriority priority) -> void {
         FlutterTask task = {
             // runner
             reinterpret_cast<FlutterTaskRunner>(task_runner),
             // task
             task_baton,
         };
-        post_task_callback_c(task, target_time.ToEpochDelta().ToNanoseconds(),
-                             user_data);
+        auto target_time_nanos = target_time.ToEpochDelta().ToNanoseconds();
+        if (post_task_with_priority_callback_c) {
+          post_task_with_priority_callback_c(task, target_time_nanos,
+                                             ToFlutterTaskPriority(priority),
+                                             user_data);
+          return;
+        }
+        post_task_callback_c(task, target_time_nanos, user_data);
       },
       // runs_task_on_current_thread_callback
       [runs_task_on_current_thread_callback_c, user_data]() -> bool {
@@ -110,6 +132,26 @@ static fml::RefPtr<fml::TaskRunner> GetCurrentThreadTaskRunner() {
 
 constexpr const char* kFlutterThreadName = "io.flutter";
 
+static fml::CpuAffinity ToCpuAffinity(FlutterThreadAffinity affinity) {
+  switch (affinity) {
+    case kFlutterThreadAffinityPerformance:
+      return fml::CpuAffinity::kPerformance;
+    case kFlutterThreadAffinityEfficiency:
+      return fml::CpuAffinity::kEfficiency;
+    case kFlutterThreadAffinityAny:
+    default:
+      return fml::CpuAffinity::kAny;
+  }
+}
+
+static ThreadConfig CreateThreadConfig(ThreadHost::Type type,
+                                       FlutterThreadAffinity affinity) {
+  ThreadConfig config(
+      ThreadHost::ThreadHostConfig::MakeThreadName(type, kFlutterThreadName));
+  config.affinity = ToCpuAffinity(affinity);
+  return config;
+}
+
 // static
 std::unique_ptr<EmbedderThreadHost>
 EmbedderThreadHost::CreateEmbedderManagedThreadHost(
@@ -154,8 +196,20 @@ EmbedderThreadHost::CreateEmbedderManagedThreadHost(
 
   // Create a thread host with just the threads that need to be managed by the
   // engine. The embedder has provided the rest.
-  ThreadHost thread_host(ThreadHost::ThreadHostConfig(kFlutterThreadName,
-                                                      engine_thread_host_mask));
+  ThreadHost::ThreadHostConfig host_config(kFlutterThreadName,
+                                          engine_thread_host_mask);
+  host_config.ui_config = CreateThreadConfig(
+      ThreadHost::Type::UI,
+      SAFE_ACCESS(custom_task_runners, ui_thread_affinity,
+                  kFlutterThreadAffinityAny));
+  host_config.raster_config = CreateThreadConfig(
+      ThreadHost::Type::RASTER,
+      SAFE_ACCESS(custom_task_runners, render_thread_affinity,
+                  kFlutterThreadAffinityAny));
+  host_config.io_config = CreateThreadConfig(
+      ThreadHost::Type::IO, SAFE_ACCESS(custom_task_runners, io_thread_affinity,
+                                        kFlutterThreadAffinityAny));
+  ThreadHost thread_host(host_config);
 
   // If the embedder has supplied a platform task runner, use that. If not, use
   // the current thread task runner.
@@ -991,3 +991,8 @@ void invalid_backingstore() {
   };
   PlatformDispatcher.instance.scheduleFrame();
 }
+
+@pragma('vm:entry-point')
+void signal_from_ui_thread() {
+  signalNativeTest();
+}
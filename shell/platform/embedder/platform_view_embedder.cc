@@ -10,13 +10,15 @@ PlatformViewEmbedder::PlatformViewEmbedder(
     PlatformView::Delegate& delegate,
     flutter::TaskRunners task_runners,
     EmbedderSurfaceSoftware::SoftwareDispatchTable software_dispatch_table,
+    std::shared_ptr<fml::ConcurrentTaskRunner> tile_task_runner,
     PlatformDispatchTable platform_dispatch_table,
     std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
     : PlatformView(delegate, std::move(task_runners)),
       external_view_embedder_(external_view_embedder),
-      embedder_surface_(
-          std::make_unique<EmbedderSurfaceSoftware>(software_dispatch_table,
-                                                    external_view_embedder_)),
+      embedder_surface_(std::make_unique<EmbedderSurfaceSoftware>(
+          software_dispatch_table,
+          std::move(tile_task_runner),
+          external_view_embedder_)),
       platform_dispatch_table_(platform_dispatch_table) {}
 
 #ifdef SHELL_ENABLE_GL
@@ -25,6 +27,7 @@ PlatformViewEmbedder::PlatformViewEmbedder(
     flutter::TaskRunners task_runners,
     EmbedderSurfaceGL::GLDispatchTable gl_dispatch_table,
     bool fbo_reset_after_present,
+    bool exclusive_context,
     PlatformDispatchTable platform_dispatch_table,
     std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
     : PlatformView(delegate, std::move(task_runners)),
@@ -32,6 +35,7 @@ PlatformViewEmbedder::PlatformViewEmbedder(
       embedder_surface_(
           std::make_unique<EmbedderSurfaceGL>(gl_dispatch_table,
                                               fbo_reset_after_present,
+                                              exclusive_context,
                                               external_view_embedder_)),
       platform_dispatch_table_(platform_dispatch_table) {}
 #endif
@@ -118,6 +122,10 @@ sk_sp<GrDirectContext> PlatformViewEmbedder::CreateResourceContext() const {
   return embedder_surface_->CreateResourceContext();
 }
 
+bool PlatformViewEmbedder::HasVsyncCallback() const {
+  return static_cast<bool>(platform_dispatch_table_.vsync_callback);
+}
+
 // |PlatformView|
 std::unique_ptr<VsyncWaiter> PlatformViewEmbedder::CreateVSyncWaiter() {
   if (!platform_dispatch_table_.vsync_callback) {
@@ -59,6 +59,7 @@ class PlatformViewEmbedder final : public PlatformView {
       PlatformView::Delegate& delegate,
       flutter::TaskRunners task_runners,
       EmbedderSurfaceSoftware::SoftwareDispatchTable software_dispatch_table,
+      std::shared_ptr<fml::ConcurrentTaskRunner> tile_task_runner,
       PlatformDispatchTable platform_dispatch_table,
       std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
 
@@ -69,6 +70,7 @@ class PlatformViewEmbedder final : public PlatformView {
       flutter::TaskRunners task_runners,
       EmbedderSurfaceGL::GLDispatchTable gl_dispatch_table,
       bool fbo_reset_after_present,
+      bool exclusive_context,
       PlatformDispatchTable platform_dispatch_table,
       std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
 #endif
@@ -103,6 +105,10 @@ class PlatformViewEmbedder final : public PlatformView {
   // |PlatformView|
   void HandlePlatformMessage(std::unique_ptr<PlatformMessage> message) override;
 
+  // Whether the embedder reports the vsync events, in which case the vsync
+  // waiter of the shell is a |VsyncWaiterEmbedder|.
+  bool HasVsyncCallback() const;
+
  private:
   std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
   std::unique_ptr<EmbedderSurface> embedder_surface_;
@@ -137,6 +137,11 @@ void EmbedderConfigBuilder::SetSoftwareRendererConfig(SkISize surface_size) {
   context_.SetupSurface(surface_size);
 }
 
+void EmbedderConfigBuilder::SetSoftwareRasterizeOnWorkerThreads() {
+  FML_CHECK(renderer_config_.type == FlutterRendererType::kSoftware);
+  renderer_config_.software.rasterize_on_worker_threads = true;
+}
+
 void EmbedderConfigBuilder::SetOpenGLFBOCallBack() {
 #ifdef SHELL_ENABLE_GL
   // SetOpenGLRendererConfig must be called before this.
@@ -165,6 +170,14 @@ void EmbedderConfigBuilder::SetOpenGLPresentCallBack() {
 #endif
 }
 
+void EmbedderConfigBuilder::SetOpenGLExclusiveContext(bool exclusive_context) {
+#ifdef SHELL_ENABLE_GL
+  // SetOpenGLRendererConfig must be called before this.
+  FML_CHECK(renderer_config_.type == FlutterRendererType::kOpenGL);
+  renderer_config_.open_gl.exclusive_context = exclusive_context;
+#endif
+}
+
 void EmbedderConfigBuilder::SetRendererConfig(EmbedderTestContextType type,
                                               SkISize surface_size) {
   switch (type) {
@@ -315,6 +328,12 @@ void EmbedderConfigBuilder::SetRenderTaskRunner(
   project_args_.custom_task_runners = &custom_task_runners_;
 }
 
+void EmbedderConfigBuilder::SetUIThreadAffinity(
+    FlutterThreadAffinity affinity) {
+  custom_task_runners_.ui_thread_affinity = affinity;
+  project_args_.custom_task_runners = &custom_task_runners_;
+}
+
 void EmbedderConfigBuilder::SetPlatformMessageCallback(
     const std::function<void(const FlutterPlatformMessage*)>& callback) {
   context_.SetPlatformMessageCallback(callback);
@@ -49,6 +49,10 @@ class EmbedderConfigBuilder {
 
   void SetSoftwareRendererConfig(SkISize surface_size = SkISize::Make(1, 1));
 
+  // Rasterizes the frames of the software renderer on the worker threads. Must
+  // be called after `SetSoftwareRendererConfig`.
+  void SetSoftwareRasterizeOnWorkerThreads();
+
   void SetOpenGLRendererConfig(SkISize surface_size);
 
   void SetMetalRendererConfig(SkISize surface_size);
@@ -67,6 +71,10 @@ class EmbedderConfigBuilder {
   // test this behavior.
   void SetOpenGLPresentCallBack();
 
+  // Sets `open_gl.exclusive_context`. SetOpenGLRendererConfig must be called
+  // before this.
+  void SetOpenGLExclusiveContext(bool exclusive_context);
+
   void SetAssetsPath();
 
   void SetSnapshots();
@@ -95,6 +103,8 @@ class EmbedderConfigBuilder {
 
   void SetRenderTaskRunner(const FlutterTaskRunnerDescription* runner);
 
+  void SetUIThreadAffinity(FlutterThreadAffinity affinity);
+
   void SetPlatformMessageCallback(
       const std::function<void(const FlutterPlatformMessage*)>& callback);
 
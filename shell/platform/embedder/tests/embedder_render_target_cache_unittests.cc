@@ -0,0 +1,130 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+
+#include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+using ViewIdentifier = EmbedderExternalView::ViewIdentifier;
+
+const SkISize kFrameSize = SkISize::Make(100, 50);
+
+// A render target of the size of the frame that counts its releases.
+std::unique_ptr<EmbedderRenderTarget> MakeRenderTarget(size_t* released) {
+  return std::make_unique<EmbedderRenderTarget>(
+      FlutterBackingStore{},
+      SkSurface::MakeRasterN32Premul(kFrameSize.width(), kFrameSize.height()),
+      [released]() { (*released)++; });
+}
+
+// Adds a view with engine rendered contents to the pending views.
+void AddPendingView(EmbedderExternalView::PendingViews& pending_views,
+                    int64_t platform_view_id) {
+  auto view = std::make_unique<EmbedderExternalView>(
+      kFrameSize, SkMatrix{}, ViewIdentifier{platform_view_id},
+      std::make_unique<EmbeddedViewParams>());
+  view->GetCanvas()->drawColor(SK_ColorRED);
+  pending_views[ViewIdentifier{platform_view_id}] = std::move(view);
+}
+
+}  // namespace
+
+TEST(EmbedderRenderTargetCacheTest, CollectsUnusedTargetsRightAwayByDefault) {
+  EmbedderRenderTargetCache cache;
+  size_t released = 0;
+  cache.CollectExpiredRenderTargets();
+  cache.CacheRenderTarget(ViewIdentifier{1}, MakeRenderTarget(&released));
+  ASSERT_EQ(cache.GetCachedTargetsCount(), 1u);
+
+  cache.CollectExpiredRenderTargets();
+  EXPECT_EQ(cache.GetCachedTargetsCount(), 0u);
+  EXPECT_EQ(cache.GetCachedTargetsBytes(), 0u);
+  EXPECT_EQ(released, 1u);
+}
+
+TEST(EmbedderRenderTargetCacheTest, KeepsUnusedTargetsForTheGivenFrames) {
+  EmbedderRenderTargetCache cache(2);
+  size_t released = 0;
+  cache.CollectExpiredRenderTargets();
+  cache.CacheRenderTarget(ViewIdentifier{1}, MakeRenderTarget(&released));
+
+  cache.CollectExpiredRenderTargets();
+  cache.CollectExpiredRenderTargets();
+  EXPECT_EQ(cache.GetCachedTargetsCount(), 1u);
+  EXPECT_EQ(released, 0u);
+
+  cache.CollectExpiredRenderTargets();
+  EXPECT_EQ(cache.GetCachedTargetsCount(), 0u);
+  EXPECT_EQ(released, 1u);
+}
+
+TEST(EmbedderRenderTargetCacheTest, CollectsTheLeastRecentlyUsedOverBudget) {
+  const size_t target_bytes = kFrameSize.width() * kFrameSize.height() * 4;
+  EmbedderRenderTargetCache cache(10, target_bytes);
+  size_t first_released = 0;
+  size_t second_released = 0;
+  cache.CollectExpiredRenderTargets();
+  cache.CacheRenderTarget(ViewIdentifier{1}, MakeRenderTarget(&first_released));
+  cache.CacheRenderTarget(ViewIdentifier{2},
+                          MakeRenderTarget(&second_released));
+  EXPECT_EQ(cache.GetCachedTargetsBytes(), 2 * target_bytes);
+
+  auto collected = cache.CollectExpiredRenderTargets();
+  EXPECT_EQ(collected.size(), 1u);
+  collected.clear();
+  EXPECT_EQ(first_released, 1u);
+  EXPECT_EQ(second_released, 0u);
+  EXPECT_EQ(cache.GetCachedTargetsBytes(), target_bytes);
+}
+
+TEST(EmbedderRenderTargetCacheTest, ViewsPreferTheTargetsTheyUsedLast) {
+  EmbedderRenderTargetCache cache(1);
+  size_t released = 0;
+  cache.CollectExpiredRenderTargets();
+  auto first = MakeRenderTarget(&released);
+  auto second = MakeRenderTarget(&released);
+  auto* first_target = first.get();
+  auto* second_target = second.get();
+  cache.CacheRenderTarget(ViewIdentifier{1}, std::move(first));
+  cache.CacheRenderTarget(ViewIdentifier{2}, std::move(second));
+
+  EmbedderExternalView::PendingViews pending_views;
+  AddPendingView(pending_views, 1);
+  AddPendingView(pending_views, 2);
+  auto [targets, unmatched] = cache.GetExistingTargetsInCache(pending_views);
+
+  EXPECT_TRUE(unmatched.empty());
+  EXPECT_EQ(targets[ViewIdentifier{1}].get(), first_target);
+  EXPECT_EQ(targets[ViewIdentifier{2}].get(), second_target);
+  EXPECT_EQ(cache.GetReusedTargetsCount(), 2u);
+}
+
+TEST(EmbedderRenderTargetCacheTest, NewViewsReuseTargetsOfTheSameSize) {
+  EmbedderRenderTargetCache cache(1);
+  size_t released = 0;
+  cache.CollectExpiredRenderTargets();
+  cache.CacheRenderTarget(ViewIdentifier{1}, MakeRenderTarget(&released));
+
+  // The view that used the target went away.
+  EmbedderExternalView::PendingViews pending_views;
+  AddPendingView(pending_views, 2);
+  AddPendingView(pending_views, 3);
+  auto [targets, unmatched] = cache.GetExistingTargetsInCache(pending_views);
+
+  EXPECT_EQ(targets.size(), 1u);
+  EXPECT_EQ(unmatched.size(), 1u);
+  EXPECT_EQ(cache.GetCachedTargetsCount(), 0u);
+  EXPECT_EQ(cache.GetReusedTargetsCount(), 1u);
+  EXPECT_EQ(released, 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
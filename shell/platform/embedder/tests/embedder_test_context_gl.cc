@@ -31,6 +31,7 @@ void EmbedderTestContextGL::SetupSurface(SkISize surface_size) {
 
 bool EmbedderTestContextGL::GLMakeCurrent() {
   FML_CHECK(gl_surface_) << "GL surface must be initialized.";
+  gl_make_current_count_++;
   return gl_surface_->MakeCurrent();
 }
 
@@ -100,6 +101,10 @@ size_t EmbedderTestContextGL::GetSurfacePresentCount() const {
   return gl_surface_present_count_;
 }
 
+size_t EmbedderTestContextGL::GetMakeCurrentCount() const {
+  return gl_make_current_count_;
+}
+
 EmbedderTestContextType EmbedderTestContextGL::GetContextType() const {
   return EmbedderTestContextType::kOpenGLContext;
 }
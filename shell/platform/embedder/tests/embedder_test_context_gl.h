@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_TESTS_EMBEDDER_CONTEXT_GL_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_TESTS_EMBEDDER_CONTEXT_GL_H_
 
+#include <atomic>
+
 #include "flutter/shell/platform/embedder/tests/embedder_test_context.h"
 #include "flutter/testing/test_gl_surface.h"
 
@@ -22,6 +24,9 @@ class EmbedderTestContextGL : public EmbedderTestContext {
 
   size_t GetSurfacePresentCount() const override;
 
+  // The number of times the engine has made the rendering context current.
+  size_t GetMakeCurrentCount() const;
+
   // |EmbedderTestContext|
   EmbedderTestContextType GetContextType() const override;
 
@@ -62,6 +67,7 @@ class EmbedderTestContextGL : public EmbedderTestContext {
 
   std::unique_ptr<TestGLSurface> gl_surface_;
   size_t gl_surface_present_count_ = 0;
+  std::atomic<size_t> gl_make_current_count_ = 0;
   std::mutex gl_callback_mutex_;
   GLGetFBOCallback gl_get_fbo_callback_;
   GLPresentCallback gl_present_callback_;
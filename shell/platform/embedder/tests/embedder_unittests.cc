@@ -10,6 +10,7 @@
 #include "embedder.h"
 #include "embedder_engine.h"
 #include "flutter/flow/raster_cache.h"
+#include "flutter/fml/cpu_affinity.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/mapping.h"
@@ -21,7 +22,9 @@
 #include "flutter/fml/thread.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_ring_buffer.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/platform/embedder/embedder_task_runner.h"
 #include "flutter/shell/platform/embedder/tests/embedder_assertions.h"
 #include "flutter/shell/platform/embedder/tests/embedder_config_builder.h"
 #include "flutter/shell/platform/embedder/tests/embedder_test.h"
@@ -31,6 +34,10 @@
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/tonic/converter/dart_converter.h"
 
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+#include <sched.h>
+#endif
+
 // CREATE_NATIVE_ENTRY is leaky by design
 // NOLINTBEGIN(clang-analyzer-core.StackAddressEscape)
 
@@ -221,6 +228,31 @@ TEST(EmbedderTestNoFixture, CanGetCurrentTimeInNanoseconds) {
   ASSERT_LT((point2 - point1), fml::TimeDelta::FromMilliseconds(1));
 }
 
+TEST(EmbedderTestNoFixture, TaskRunnersHandThePriorityOfTasksToTheEmbedder) {
+  std::vector<fml::TaskPriority> priorities;
+  EmbedderTaskRunner::DispatchTable table = {
+      // .post_task_callback
+      [&priorities](EmbedderTaskRunner* task_runner, uint64_t task_baton,
+                    fml::TimePoint target_time, fml::TaskPriority priority) {
+        priorities.push_back(priority);
+      },
+      // .runs_task_on_current_thread_callback
+      []() { return true; }};
+  fml::RefPtr<fml::TaskRunner> task_runner =
+      fml::MakeRefCounted<EmbedderTaskRunner>(table, 0u);
+
+  task_runner->PostTask([]() {});
+  task_runner->PostTaskWithPriority([]() {}, fml::TaskPriority::kFrame);
+  task_runner->PostTaskWithPriority([]() {}, fml::TaskPriority::kInput);
+  task_runner->PostDelayedTaskWithPriority(
+      []() {}, fml::TimeDelta::FromMilliseconds(1), fml::TaskPriority::kIdle);
+
+  std::vector<fml::TaskPriority> expected = {
+      fml::TaskPriority::kNormal, fml::TaskPriority::kFrame,
+      fml::TaskPriority::kInput, fml::TaskPriority::kIdle};
+  EXPECT_EQ(priorities, expected);
+}
+
 TEST_F(EmbedderTest, CanReloadSystemFonts) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
   EmbedderConfigBuilder builder(context);
@@ -232,6 +264,121 @@ TEST_F(EmbedderTest, CanReloadSystemFonts) {
   ASSERT_EQ(result, kSuccess);
 }
 
+TEST_F(EmbedderTest, CanGetFrameTimingPercentile) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterFrameTimingPercentile percentile = {};
+  percentile.struct_size = sizeof(FlutterFrameTimingPercentile);
+  percentile.percentile = 90;
+  ASSERT_EQ(FlutterEngineGetFrameTimingPercentile(engine.get(), &percentile),
+            kSuccess);
+  ASSERT_EQ(percentile.frame_count, 0u);
+  ASSERT_EQ(percentile.total_span_us, 0);
+
+  percentile.percentile = 101;
+  ASSERT_EQ(FlutterEngineGetFrameTimingPercentile(engine.get(), &percentile),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineGetFrameTimingPercentile(engine.get(), nullptr),
+            kInvalidArguments);
+}
+
+TEST_F(EmbedderTest, CanGetStatistics) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterEngineStatistics statistics = {};
+  statistics.struct_size = sizeof(FlutterEngineStatistics);
+  ASSERT_EQ(FlutterEngineGetStatistics(engine.get(), &statistics), kSuccess);
+  ASSERT_EQ(statistics.frame_count, 0u);
+  ASSERT_EQ(statistics.raster_duration_p99_us, 0);
+  // The software renderer has no GPU context.
+  ASSERT_EQ(statistics.resource_cache_max_bytes, 0u);
+  ASSERT_GE(statistics.pipeline_depth, 1u);
+  ASSERT_EQ(statistics.pipeline_frames_in_flight, 0u);
+
+  statistics.struct_size = sizeof(FlutterEngineStatistics) - 1;
+  ASSERT_EQ(FlutterEngineGetStatistics(engine.get(), &statistics),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineGetStatistics(engine.get(), nullptr),
+            kInvalidArguments);
+}
+
+TEST_F(EmbedderTest, CanSpawnEnginesWithTheirOwnSurfaces) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterRendererConfig config = {};
+  config.type = FlutterRendererType::kSoftware;
+  config.software.struct_size = sizeof(FlutterSoftwareRendererConfig);
+  config.software.surface_present_callback =
+      [](void* user_data, const void* allocation, size_t row_bytes,
+         size_t height) { return true; };
+  FlutterProjectArgs args = {};
+  args.struct_size = sizeof(FlutterProjectArgs);
+
+  FLUTTER_API_SYMBOL(FlutterEngine) spawned_engine = nullptr;
+  ASSERT_EQ(FlutterEngineSpawn(FLUTTER_ENGINE_VERSION, engine.get(), &config,
+                               &args, nullptr, &spawned_engine),
+            kSuccess);
+  ASSERT_NE(spawned_engine, nullptr);
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(spawned_engine, &event),
+            kSuccess);
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  // The spawned engine keeps the threads that it shares alive.
+  engine.reset();
+  ASSERT_EQ(FlutterEngineShutdown(spawned_engine), kSuccess);
+
+  ASSERT_EQ(FlutterEngineSpawn(FLUTTER_ENGINE_VERSION, nullptr, &config, &args,
+                               nullptr, &spawned_engine),
+            kInvalidArguments);
+}
+
+TEST_F(EmbedderTest, CanGetTraceRingBuffer) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.AddCommandLineArgument("--enable-trace-ring-buffer");
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  fml::tracing::TraceRingBufferRecord("EmbedderRingBufferEvent", 1, 0,
+                                      Dart_Timeline_Event_Instant);
+  std::string json;
+  ASSERT_EQ(FlutterEngineGetTraceRingBuffer(
+                engine.get(),
+                [](const uint8_t* data, size_t size, void* user_data) {
+                  reinterpret_cast<std::string*>(user_data)->assign(
+                      reinterpret_cast<const char*>(data), size);
+                },
+                &json),
+            kSuccess);
+  fml::tracing::TraceRingBufferSetEnabled(false);
+  fml::tracing::TraceRingBufferClear();
+
+  EXPECT_EQ(json.find("{\"displayTimeUnit\""), 0u);
+  EXPECT_NE(json.find("\"EmbedderRingBufferEvent\""), std::string::npos);
+  ASSERT_EQ(FlutterEngineGetTraceRingBuffer(engine.get(), nullptr, nullptr),
+            kInvalidArguments);
+}
+
 TEST_F(EmbedderTest, IsolateServiceIdSent) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
   fml::AutoResetWaitableEvent latch;
@@ -412,6 +559,69 @@ TEST_F(EmbedderTest, PlatformMessagesCanBeSentWithoutResponseHandles) {
   message.Wait();
 }
 
+//------------------------------------------------------------------------------
+/// Tests that the buffer of a platform message sent without a copy is handed
+/// back to the embedder once the message has been handled.
+///
+TEST_F(EmbedderTest, PlatformMessagesCanBeSentWithoutCopies) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("platform_messages_no_response");
+
+  std::string message_data = "Hello but don't call me back.";
+
+  fml::AutoResetWaitableEvent ready, message, released;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+  context.AddNativeCallback(
+      "SignalNativeMessage",
+      CREATE_NATIVE_ENTRY(
+          ([&message, &message_data](Dart_NativeArguments args) {
+            auto received_message = tonic::DartConverter<std::string>::FromDart(
+                Dart_GetNativeArgument(args, 0));
+            ASSERT_EQ(received_message, message_data);
+            message.Signal();
+          })));
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+  ready.Wait();
+
+  FlutterPlatformMessage platform_message = {};
+  platform_message.struct_size = sizeof(FlutterPlatformMessage);
+  platform_message.channel = "test_channel";
+  platform_message.message =
+      reinterpret_cast<const uint8_t*>(message_data.data());
+  platform_message.message_size = message_data.size();
+  platform_message.response_handle = nullptr;  // No response needed.
+
+  struct Captures {
+    const std::string& message_data;
+    fml::AutoResetWaitableEvent& released;
+  } captures{message_data, released};
+  auto result = FlutterEngineSendPlatformMessageNoCopy(
+      engine.get(), &platform_message,
+      [](const uint8_t* data, size_t size, void* user_data) {
+        auto captures = reinterpret_cast<Captures*>(user_data);
+        ASSERT_EQ(data, reinterpret_cast<const uint8_t*>(
+                            captures->message_data.data()));
+        ASSERT_EQ(size, captures->message_data.size());
+        captures->released.Signal();
+      },
+      &captures);
+  ASSERT_EQ(result, kSuccess);
+  message.Wait();
+  released.Wait();
+
+  ASSERT_EQ(FlutterEngineSendPlatformMessageNoCopy(
+                engine.get(), &platform_message, nullptr, nullptr),
+            kInvalidArguments);
+}
+
 //------------------------------------------------------------------------------
 /// Tests that a null platform message can be sent.
 ///
@@ -477,6 +687,42 @@ TEST_F(EmbedderTest, InvalidPlatformMessages) {
   ASSERT_EQ(result, kInvalidArguments);
 }
 
+//------------------------------------------------------------------------------
+/// Tests that a batch of events is not sent if any of its events is invalid.
+///
+TEST_F(EmbedderTest, InvalidEventBatches) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+
+  ASSERT_EQ(FlutterEngineSendEvents(engine.get(), nullptr, 1),
+            kInvalidArguments);
+
+  FlutterWindowMetricsEvent metrics = {};
+  metrics.struct_size = sizeof(FlutterWindowMetricsEvent);
+  metrics.width = 800;
+  metrics.height = 600;
+  metrics.pixel_ratio = 1.0;
+
+  FlutterEngineEvent events[2] = {};
+  events[0].struct_size = sizeof(FlutterEngineEvent);
+  events[0].type = kFlutterEngineEventTypeWindowMetrics;
+  events[0].window_metrics = &metrics;
+  events[1].struct_size = sizeof(FlutterEngineEvent);
+  events[1].type = kFlutterEngineEventTypePointer;
+  events[1].pointer_events = nullptr;
+  events[1].pointer_events_count = 1;
+
+  ASSERT_EQ(FlutterEngineSendEvents(engine.get(), events, 0),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineSendEvents(engine.get(), events, 2),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineSendEvents(engine.get(), events, 1), kSuccess);
+}
+
 //------------------------------------------------------------------------------
 /// Tests that setting a custom log callback works as expected and defaults to
 /// using tag "flutter".
@@ -1038,6 +1284,43 @@ TEST_F(EmbedderTest, VerifyB143464703WithSoftwareBackend) {
       ImageMatchesFixture("verifyb143464703_soft_noxform.png", rendered_scene));
 }
 
+TEST_F(EmbedderTest, SoftwareFramesRasterizedOnWorkerThreadsMatch) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+
+  sk_sp<SkImage> images[2];
+  for (size_t i = 0; i < 2; i++) {
+    EmbedderConfigBuilder builder(context);
+    builder.SetDartEntrypoint("can_render_scene_without_custom_compositor");
+    builder.SetSoftwareRendererConfig(SkISize::Make(800, 600));
+    if (i == 1) {
+      builder.SetSoftwareRasterizeOnWorkerThreads();
+    }
+
+    auto rendered_scene = context.GetNextSceneImage();
+
+    auto engine = builder.LaunchEngine();
+    ASSERT_TRUE(engine.is_valid());
+
+    // Send a window metrics events so frames may be scheduled.
+    ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+              kSuccess);
+
+    // The image wraps the backing store, which goes away with the engine.
+    SkPixmap pixmap;
+    ASSERT_TRUE(rendered_scene.get()->peekPixels(&pixmap));
+    images[i] = SkImage::MakeRasterCopy(pixmap);
+    ASSERT_TRUE(images[i]);
+  }
+
+  ASSERT_TRUE(RasterImagesAreSame(images[0], images[1]));
+}
+
 TEST_F(EmbedderTest, CanSendLowMemoryNotification) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
 
@@ -1744,6 +2027,36 @@ TEST_F(EmbedderTest, VsyncCallbackPostedIntoFuture) {
   shutdown_latch.Wait();
 }
 
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+TEST_F(EmbedderTest, UIThreadRunsOnTheRequestedKindOfCores) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  fml::AutoResetWaitableEvent latch;
+  bool pinned = false;
+  context.AddNativeCallback(
+      "SignalNativeTest", CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+        const uint64_t mask = fml::GetCpuMask(fml::CpuAffinity::kPerformance);
+        cpu_set_t set;
+        pinned = sched_getaffinity(0, sizeof(set), &set) == 0;
+        for (int cpu = 0; cpu < 64; cpu++) {
+          pinned &= (CPU_ISSET(cpu, &set) != 0) ==
+                    ((mask & (uint64_t{1} << cpu)) != 0);
+        }
+        latch.Signal();
+      }));
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetUIThreadAffinity(kFlutterThreadAffinityPerformance);
+  builder.SetDartEntrypoint("signal_from_ui_thread");
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  latch.Wait();
+  ASSERT_TRUE(pinned);
+}
+#endif  // defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -3149,6 +3149,43 @@ TEST_F(EmbedderTest, PresentInfoContainsValidFBOId) {
   frame_latch.Wait();
 }
 
+TEST_F(EmbedderTest, ExclusiveContextIsMadeCurrentOnce) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetOpenGLRendererConfig(SkISize::Make(800, 600));
+  builder.SetOpenGLExclusiveContext(true);
+  builder.SetDartEntrypoint("push_frames_over_and_over");
+
+  auto engine = builder.LaunchEngine();
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  ASSERT_TRUE(engine.is_valid());
+
+  fml::CountDownLatch frame_latch(10);
+
+  context.AddNativeCallback("SignalNativeTest",
+                            CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+                              /* Nothing to do. */
+                            }));
+
+  auto& gl_context = static_cast<EmbedderTestContextGL&>(context);
+  gl_context.SetGLPresentCallback(
+      [&frame_latch](uint32_t fbo_id) { frame_latch.CountDown(); });
+
+  frame_latch.Wait();
+
+  // Once when the GrDirectContext is created, and once by the surface.
+  EXPECT_LE(gl_context.GetMakeCurrentCount(), 2u);
+}
+
 TEST_F(EmbedderTest, SetSingleDisplayConfigurationWithDisplayId) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
 
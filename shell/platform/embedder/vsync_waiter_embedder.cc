@@ -4,11 +4,15 @@
 
 #include "flutter/shell/platform/embedder/vsync_waiter_embedder.h"
 
+#include "flutter/shell/common/display.h"
+
 namespace flutter {
 
 VsyncWaiterEmbedder::VsyncWaiterEmbedder(const VsyncCallback& vsync_callback,
                                          flutter::TaskRunners task_runners)
-    : VsyncWaiter(std::move(task_runners)), vsync_callback_(vsync_callback) {
+    : VsyncWaiter(std::move(task_runners)),
+      vsync_callback_(vsync_callback),
+      refresh_rate_(kUnknownDisplayRefreshRate) {
   FML_DCHECK(vsync_callback_);
 }
 
@@ -41,6 +45,13 @@ bool VsyncWaiterEmbedder::OnEmbedderVsync(
         auto vsync_waiter = weak_waiter->lock();
         delete weak_waiter;
         if (vsync_waiter) {
+          // Batons are only ever handed out by |VsyncWaiterEmbedder|.
+          const fml::TimeDelta frame_interval =
+              frame_target_time - frame_start_time;
+          if (frame_interval > fml::TimeDelta::Zero()) {
+            static_cast<VsyncWaiterEmbedder*>(vsync_waiter.get())
+                ->refresh_rate_ = 1.0 / frame_interval.ToSecondsF();
+          }
           vsync_waiter->FireCallback(frame_start_time, frame_target_time);
         }
       },
@@ -49,4 +60,9 @@ bool VsyncWaiterEmbedder::OnEmbedderVsync(
   return true;
 }
 
+// |VariableRefreshRateReporter|
+double VsyncWaiterEmbedder::GetRefreshRate() const {
+  return refresh_rate_;
+}
+
 }  // namespace flutter
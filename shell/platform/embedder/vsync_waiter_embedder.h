@@ -5,12 +5,16 @@
 #ifndef SHELL_PLATFORM_EMBEDDER_VSYNC_WAITER_EMBEDDER_H_
 #define SHELL_PLATFORM_EMBEDDER_VSYNC_WAITER_EMBEDDER_H_
 
+#include <atomic>
+
 #include "flutter/fml/macros.h"
+#include "flutter/shell/common/variable_refresh_rate_reporter.h"
 #include "flutter/shell/common/vsync_waiter.h"
 
 namespace flutter {
 
-class VsyncWaiterEmbedder final : public VsyncWaiter {
+class VsyncWaiterEmbedder final : public VsyncWaiter,
+                                  public VariableRefreshRateReporter {
  public:
   using VsyncCallback = std::function<void(intptr_t)>;
 
@@ -24,8 +28,16 @@ class VsyncWaiterEmbedder final : public VsyncWaiter {
                               fml::TimePoint frame_start_time,
                               fml::TimePoint frame_target_time);
 
+  // |VariableRefreshRateReporter|
+  //
+  // The refresh rate implied by the interval between the frame start and
+  // target times of the last vsync event reported by the embedder, or
+  // `kUnknownDisplayRefreshRate` before the first one.
+  double GetRefreshRate() const override;
+
  private:
   const VsyncCallback vsync_callback_;
+  std::atomic<double> refresh_rate_;
 
   // |VsyncWaiter|
   void AwaitVSync() override;
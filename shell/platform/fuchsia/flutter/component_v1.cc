@@ -38,6 +38,7 @@
 #include "runtime/dart/utils/mapped_resource.h"
 #include "runtime/dart/utils/tempfs.h"
 #include "runtime/dart/utils/vmo.h"
+#include "warm_thread_pool.h"
 
 namespace flutter_runner {
 namespace {
@@ -98,7 +99,7 @@ ActiveComponentV1 ComponentV1::Create(
     fuchsia::sys::StartupInfo startup_info,
     std::shared_ptr<sys::ServiceDirectory> runner_incoming_services,
     fidl::InterfaceRequest<fuchsia::sys::ComponentController> controller) {
-  auto thread = std::make_unique<fml::Thread>();
+  auto thread = WarmThreadPool::GetInstance().TakePlatformThread();
   std::unique_ptr<ComponentV1> component;
 
   fml::AutoResetWaitableEvent latch;
@@ -327,39 +328,39 @@ ComponentV1::ComponentV1(
     } else {
       const int namespace_fd = component_data_directory_.get();
       settings_.vm_snapshot_data = [namespace_fd]() {
-        return LoadFile(namespace_fd, "vm_snapshot_data.bin",
-                        false /* executable */);
+        return LoadSharedFile(namespace_fd, "vm_snapshot_data.bin",
+                              false /* executable */);
       };
       settings_.vm_snapshot_instr = [namespace_fd]() {
-        return LoadFile(namespace_fd, "vm_snapshot_instructions.bin",
-                        true /* executable */);
+        return LoadSharedFile(namespace_fd, "vm_snapshot_instructions.bin",
+                              true /* executable */);
       };
       settings_.isolate_snapshot_data = [namespace_fd]() {
-        return LoadFile(namespace_fd, "isolate_snapshot_data.bin",
-                        false /* executable */);
+        return LoadSharedFile(namespace_fd, "isolate_snapshot_data.bin",
+                              false /* executable */);
       };
       settings_.isolate_snapshot_instr = [namespace_fd]() {
-        return LoadFile(namespace_fd, "isolate_snapshot_instructions.bin",
-                        true /* executable */);
+        return LoadSharedFile(namespace_fd, "isolate_snapshot_instructions.bin",
+                              true /* executable */);
       };
     }
   } else {
     settings_.vm_snapshot_data = []() {
-      return MakeFileMapping("/pkg/data/vm_snapshot_data.bin",
-                             false /* executable */);
+      return LoadSharedFile("/pkg/data/vm_snapshot_data.bin",
+                            false /* executable */);
     };
     settings_.vm_snapshot_instr = []() {
-      return MakeFileMapping("/pkg/data/vm_snapshot_instructions.bin",
-                             true /* executable */);
+      return LoadSharedFile("/pkg/data/vm_snapshot_instructions.bin",
+                            true /* executable */);
     };
 
     settings_.isolate_snapshot_data = []() {
-      return MakeFileMapping("/pkg/data/isolate_core_snapshot_data.bin",
-                             false /* executable */);
+      return LoadSharedFile("/pkg/data/isolate_core_snapshot_data.bin",
+                            false /* executable */);
     };
     settings_.isolate_snapshot_instr = [] {
-      return MakeFileMapping("/pkg/data/isolate_core_snapshot_instructions.bin",
-                             true /* executable */);
+      return LoadSharedFile("/pkg/data/isolate_core_snapshot_instructions.bin",
+                            true /* executable */);
     };
   }
 
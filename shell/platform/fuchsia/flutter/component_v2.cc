@@ -39,6 +39,7 @@
 #include "runtime/dart/utils/mapped_resource.h"
 #include "runtime/dart/utils/tempfs.h"
 #include "runtime/dart/utils/vmo.h"
+#include "warm_thread_pool.h"
 
 namespace flutter_runner {
 namespace {
@@ -133,7 +134,7 @@ ActiveComponentV2 ComponentV2::Create(
     std::shared_ptr<sys::ServiceDirectory> runner_incoming_services,
     fidl::InterfaceRequest<fuchsia::component::runner::ComponentController>
         controller) {
-  auto thread = std::make_unique<fml::Thread>();
+  auto thread = WarmThreadPool::GetInstance().TakePlatformThread();
   std::unique_ptr<ComponentV2> component;
 
   fml::AutoResetWaitableEvent latch;
@@ -391,39 +392,39 @@ ComponentV2::ComponentV2(
     } else {
       const int namespace_fd = component_data_directory_.get();
       settings_.vm_snapshot_data = [namespace_fd]() {
-        return LoadFile(namespace_fd, "vm_snapshot_data.bin",
-                        false /* executable */);
+        return LoadSharedFile(namespace_fd, "vm_snapshot_data.bin",
+                              false /* executable */);
       };
       settings_.vm_snapshot_instr = [namespace_fd]() {
-        return LoadFile(namespace_fd, "vm_snapshot_instructions.bin",
-                        true /* executable */);
+        return LoadSharedFile(namespace_fd, "vm_snapshot_instructions.bin",
+                              true /* executable */);
       };
       settings_.isolate_snapshot_data = [namespace_fd]() {
-        return LoadFile(namespace_fd, "isolate_snapshot_data.bin",
-                        false /* executable */);
+        return LoadSharedFile(namespace_fd, "isolate_snapshot_data.bin",
+                              false /* executable */);
       };
       settings_.isolate_snapshot_instr = [namespace_fd]() {
-        return LoadFile(namespace_fd, "isolate_snapshot_instructions.bin",
-                        true /* executable */);
+        return LoadSharedFile(namespace_fd, "isolate_snapshot_instructions.bin",
+                              true /* executable */);
       };
     }
   } else {
     settings_.vm_snapshot_data = []() {
-      return MakeFileMapping("/pkg/data/vm_snapshot_data.bin",
-                             false /* executable */);
+      return LoadSharedFile("/pkg/data/vm_snapshot_data.bin",
+                            false /* executable */);
     };
     settings_.vm_snapshot_instr = []() {
-      return MakeFileMapping("/pkg/data/vm_snapshot_instructions.bin",
-                             true /* executable */);
+      return LoadSharedFile("/pkg/data/vm_snapshot_instructions.bin",
+                            true /* executable */);
     };
 
     settings_.isolate_snapshot_data = []() {
-      return MakeFileMapping("/pkg/data/isolate_core_snapshot_data.bin",
-                             false /* executable */);
+      return LoadSharedFile("/pkg/data/isolate_core_snapshot_data.bin",
+                            false /* executable */);
     };
     settings_.isolate_snapshot_instr = [] {
-      return MakeFileMapping("/pkg/data/isolate_core_snapshot_instructions.bin",
-                             true /* executable */);
+      return LoadSharedFile("/pkg/data/isolate_core_snapshot_instructions.bin",
+                            true /* executable */);
     };
   }
 
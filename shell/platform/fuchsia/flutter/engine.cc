@@ -35,6 +35,7 @@
 #include "surface.h"
 #include "vsync_waiter.h"
 #include "vulkan_surface_producer.h"
+#include "warm_thread_pool.h"
 
 namespace flutter_runner {
 namespace {
@@ -59,9 +60,7 @@ std::unique_ptr<flutter::PlatformMessage> MakeLocalizationPlatformMessage(
 flutter::ThreadHost Engine::CreateThreadHost(const std::string& name_prefix) {
   fml::Thread::SetCurrentThreadName(
       fml::Thread::ThreadConfig(name_prefix + ".platform"));
-  return flutter::ThreadHost(name_prefix, flutter::ThreadHost::Type::RASTER |
-                                              flutter::ThreadHost::Type::UI |
-                                              flutter::ThreadHost::Type::IO);
+  return WarmThreadPool::GetInstance().TakeThreadHost(name_prefix);
 }
 
 Engine::Engine(Delegate& delegate,
@@ -5,8 +5,16 @@
 #include "file_in_namespace_buffer.h"
 
 #include <lib/fdio/directory.h>
+#include <lib/fdio/io.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <zircon/status.h>
 
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <tuple>
+
 #include "flutter/fml/trace_event.h"
 #include "runtime/dart/utils/files.h"
 #include "runtime/dart/utils/handle_exception.h"
@@ -25,6 +33,108 @@ constexpr uint32_t OPEN_RIGHT_READABLE = 1u;
 // Connection can map target object executable.
 constexpr uint32_t OPEN_RIGHT_EXECUTABLE = 8u;
 
+// Maps the first |size| bytes of |vmo| into the root VMAR, or aborts.
+void* MapVmo(const zx::vmo& vmo,
+             size_t size,
+             bool executable,
+             const char* name) {
+  uint32_t flags = ZX_VM_PERM_READ;
+  if (executable) {
+    flags |= ZX_VM_PERM_EXECUTE;
+  }
+
+  uintptr_t addr;
+  const zx_status_t status =
+      zx::vmar::root_self()->map(flags, 0, vmo, 0, size, &addr);
+  if (status != ZX_OK) {
+    FML_LOG(FATAL) << "Failed to map " << name << ": "
+                   << zx_status_get_string(status);
+  }
+  return reinterpret_cast<void*>(addr);
+}
+
+// Gets the VMO backing the file open at |fd|, without making a private copy
+// of it, along with the size of the file.
+bool GetFileVmo(int fd, bool executable, zx::vmo* vmo, size_t* size) {
+  struct stat stat_struct;
+  if (fstat(fd, &stat_struct) == -1) {
+    return false;
+  }
+
+  zx_handle_t handle = ZX_HANDLE_INVALID;
+  const zx_status_t status = executable ? fdio_get_vmo_exec(fd, &handle)
+                                        : fdio_get_vmo_clone(fd, &handle);
+  if (status != ZX_OK) {
+    FML_LOG(ERROR) << "Failed to get the VMO of a file: "
+                   << zx_status_get_string(status);
+    return false;
+  }
+
+  *vmo = zx::vmo(handle);
+  *size = stat_struct.st_size;
+  return true;
+}
+
+// The mappings of the files loaded with |LoadSharedFile|, for as long as any
+// of them is in use.
+//
+// Files are identified by the VMO that the VMO of each open file is a child
+// of, which is the same for every open of a given file, or blob of a package.
+struct SharedFileKey {
+  zx_koid_t koid;
+  bool executable;
+
+  bool operator<(const SharedFileKey& other) const {
+    return std::tie(koid, executable) < std::tie(other.koid, other.executable);
+  }
+};
+
+std::mutex shared_files_mutex;
+std::map<SharedFileKey, std::weak_ptr<FileInNamespaceBuffer>> shared_files;
+
+std::unique_ptr<fml::Mapping> LoadSharedFileFromFd(int fd, bool executable) {
+  zx::vmo vmo;
+  size_t size = 0;
+  const bool got_vmo = GetFileVmo(fd, executable, &vmo, &size);
+  close(fd);
+  if (!got_vmo || size == 0) {
+    return nullptr;
+  }
+
+  zx_info_vmo_t info;
+  if (vmo.get_info(ZX_INFO_VMO, &info, sizeof(info), nullptr, nullptr) !=
+      ZX_OK) {
+    return nullptr;
+  }
+  const SharedFileKey key = {
+      .koid = info.parent_koid != ZX_KOID_INVALID ? info.parent_koid
+                                                  : info.koid,
+      .executable = executable,
+  };
+
+  std::shared_ptr<FileInNamespaceBuffer> buffer;
+  {
+    std::scoped_lock lock(shared_files_mutex);
+    auto found = shared_files.find(key);
+    if (found != shared_files.end()) {
+      buffer = found->second.lock();
+    }
+    if (!buffer || buffer->GetSize() != size) {
+      buffer = std::make_shared<FileInNamespaceBuffer>(vmo, size, executable);
+      shared_files[key] = buffer;
+    }
+
+    // Forget the files that were unmapped since.
+    for (auto it = shared_files.begin(); it != shared_files.end();) {
+      it = it->second.expired() ? shared_files.erase(it) : std::next(it);
+    }
+  }
+
+  return std::make_unique<fml::NonOwnedMapping>(
+      buffer->GetMapping(), buffer->GetSize(),
+      [buffer](const uint8_t*, size_t) {}, true /* dontneed_safe */);
+}
+
 }  // namespace
 
 FileInNamespaceBuffer::FileInNamespaceBuffer(int namespace_fd,
@@ -37,23 +147,15 @@ FileInNamespaceBuffer::FileInNamespaceBuffer(int namespace_fd,
     return;
   }
 
-  uint32_t flags = ZX_VM_PERM_READ;
-  if (executable) {
-    flags |= ZX_VM_PERM_EXECUTE;
-  }
-
-  uintptr_t addr;
-  const zx_status_t status =
-      zx::vmar::root_self()->map(flags, 0, buffer.vmo, 0, buffer.size, &addr);
-  if (status != ZX_OK) {
-    FML_LOG(FATAL) << "Failed to map " << path << ": "
-                   << zx_status_get_string(status);
-  }
-
-  address_ = reinterpret_cast<void*>(addr);
+  address_ = MapVmo(buffer.vmo, buffer.size, executable, path);
   size_ = buffer.size;
 }
 
+FileInNamespaceBuffer::FileInNamespaceBuffer(const zx::vmo& vmo,
+                                             size_t size,
+                                             bool executable)
+    : address_(MapVmo(vmo, size, executable, "file")), size_(size) {}
+
 FileInNamespaceBuffer::~FileInNamespaceBuffer() {
   if (address_ != nullptr) {
     zx::vmar::root_self()->unmap(reinterpret_cast<uintptr_t>(address_), size_);
@@ -82,6 +184,39 @@ std::unique_ptr<fml::Mapping> LoadFile(int namespace_fd,
                                                  executable);
 }
 
+std::unique_ptr<fml::Mapping> LoadSharedFile(int namespace_fd,
+                                             const char* path,
+                                             bool executable) {
+  FML_TRACE_EVENT("flutter", "LoadSharedFile", "path", path);
+  uint32_t flags = OPEN_RIGHT_READABLE;
+  if (executable) {
+    flags |= OPEN_RIGHT_EXECUTABLE;
+  }
+
+  int fd;
+  if (fdio_open_fd_at(namespace_fd, path, flags, &fd) != ZX_OK) {
+    return nullptr;
+  }
+  return LoadSharedFileFromFd(fd, executable);
+}
+
+std::unique_ptr<fml::Mapping> LoadSharedFile(const char* path,
+                                             bool executable) {
+  FML_TRACE_EVENT("flutter", "LoadSharedFile", "path", path);
+  uint32_t flags = OPEN_RIGHT_READABLE;
+  if (executable) {
+    flags |= OPEN_RIGHT_EXECUTABLE;
+  }
+
+  // fdio_open_fd_at does not handle AT_FDCWD, so absolute paths are opened
+  // with fdio_open_fd.
+  int fd;
+  if (fdio_open_fd(path, flags, &fd) != ZX_OK) {
+    return nullptr;
+  }
+  return LoadSharedFileFromFd(fd, executable);
+}
+
 std::unique_ptr<fml::FileMapping> MakeFileMapping(const char* path,
                                                   bool executable) {
   uint32_t flags = OPEN_RIGHT_READABLE;
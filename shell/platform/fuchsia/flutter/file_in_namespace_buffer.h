@@ -4,6 +4,8 @@
 #ifndef FLUTTER_SHELL_PLATFORM_FUCHSIA_FILE_IN_NAMESPACE_BUFFER_H_
 #define FLUTTER_SHELL_PLATFORM_FUCHSIA_FILE_IN_NAMESPACE_BUFFER_H_
 
+#include <lib/zx/vmo.h>
+
 #include "flutter/fml/mapping.h"
 
 namespace flutter_runner {
@@ -17,6 +19,10 @@ class FileInNamespaceBuffer final : public fml::Mapping {
   /// The file will be loaded with the readable permission. If |executable| is
   /// true, the file will also be loaded with the executable permission.
   FileInNamespaceBuffer(int namespace_fd, const char* path, bool executable);
+
+  /// Maps the first |size| bytes of |vmo|, read-only and also executable if
+  /// |executable| is true.
+  FileInNamespaceBuffer(const zx::vmo& vmo, size_t size, bool executable);
   ~FileInNamespaceBuffer();
 
   // |fml::Mapping|
@@ -47,6 +53,21 @@ std::unique_ptr<fml::Mapping> LoadFile(int namespace_fd,
                                        const char* path,
                                        bool executable);
 
+/// Loads the file at |path| in the namespace |namespace_fd| like |LoadFile|,
+/// but maps the VMO of the file itself instead of a private copy of it, and
+/// shares the mapping with every other load of the same file while that
+/// mapping is alive.
+///
+/// Components launched by the same runner live in one process, so they share
+/// the mappings of identical snapshots instead of each mapping their own.
+std::unique_ptr<fml::Mapping> LoadSharedFile(int namespace_fd,
+                                             const char* path,
+                                             bool executable);
+
+/// Like |LoadSharedFile|, for the file at the absolute |path|.
+std::unique_ptr<fml::Mapping> LoadSharedFile(const char* path,
+                                             bool executable);
+
 /// Opens the file at |path| and creates a file mapping for the file.
 ///
 /// The file will be opened with the readable permission. If |executable| is
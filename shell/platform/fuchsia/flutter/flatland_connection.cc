@@ -6,10 +6,33 @@
 
 #include <zircon/status.h>
 
+#include <algorithm>
+
 #include "flutter/fml/logging.h"
 
 namespace flutter_runner {
 
+namespace {
+
+fml::TimePoint ToTimePoint(int64_t nanoseconds) {
+  return fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromNanoseconds(nanoseconds));
+}
+
+// Returns the first vsync strictly after |time|, given the time of any one
+// vsync and the vsync interval.
+fml::TimePoint NextVsyncAfter(fml::TimePoint time,
+                              fml::TimePoint vsync,
+                              fml::TimeDelta interval) {
+  fml::TimeDelta phase = (time - vsync) % interval;
+  if (phase < fml::TimeDelta::Zero()) {
+    phase = phase + interval;
+  }
+  return time + (interval - phase);
+}
+
+}  // namespace
+
 FlatlandConnection::FlatlandConnection(
     std::string debug_label,
     fuchsia::ui::composition::FlatlandHandle flatland,
@@ -19,7 +42,9 @@ FlatlandConnection::FlatlandConnection(
     fml::TimeDelta vsync_offset)
     : flatland_(flatland.Bind()),
       error_callback_(error_callback),
-      on_frame_presented_callback_(std::move(on_frame_presented_callback)) {
+      on_frame_presented_callback_(std::move(on_frame_presented_callback)),
+      max_frames_in_flight_(std::max<uint64_t>(max_frames_in_flight, 1)),
+      vsync_offset_(vsync_offset) {
   flatland_.set_error_handler([callback = error_callback_](zx_status_t status) {
     FML_LOG(ERROR) << "Flatland disconnected: " << zx_status_get_string(status);
     callback();
@@ -37,21 +62,28 @@ FlatlandConnection::~FlatlandConnection() = default;
 
 // This method is called from the raster thread.
 void FlatlandConnection::Present() {
-  if (!threadsafe_state_.first_present_called_) {
-    std::scoped_lock<std::mutex> lock(threadsafe_state_.mutex_);
-    threadsafe_state_.first_present_called_ = true;
+  std::scoped_lock<std::mutex> lock(threadsafe_state_.mutex_);
+  threadsafe_state_.first_present_called_ = true;
+  if (threadsafe_state_.frames_in_flight_ > 0) {
+    --threadsafe_state_.frames_in_flight_;
   }
-  if (present_credits_ > 0) {
+  if (threadsafe_state_.present_credits_ > 0) {
     DoPresent();
   } else {
     present_pending_ = true;
   }
+
+  // This frame leaving the pipeline may make room for the next one.
+  if (threadsafe_state_.fire_callback_ && CanPipelineFrame()) {
+    FireCallback(threadsafe_state_.fire_callback_);
+    threadsafe_state_.fire_callback_ = nullptr;
+  }
 }
 
 // This method is called from the raster thread.
 void FlatlandConnection::DoPresent() {
-  FML_CHECK(present_credits_ > 0);
-  --present_credits_;
+  FML_CHECK(threadsafe_state_.present_credits_ > 0);
+  --threadsafe_state_.present_credits_;
 
   fuchsia::ui::composition::PresentArgs present_args;
   // TODO(fxbug.dev/64201): compute a better presentation time;
@@ -82,16 +114,19 @@ void FlatlandConnection::AwaitVsync(FireCallbackCallback callback) {
     return;
   }
 
-  threadsafe_state_.fire_callback_ = callback;
-
   if (threadsafe_state_.fire_callback_pending_) {
-    fml::TimePoint now = fml::TimePoint::Now();
-    // TODO(fxbug.dev/64201): Calculate correct frame times.
-    threadsafe_state_.fire_callback_(
-        now, now + kDefaultFlatlandPresentationInterval);
-    threadsafe_state_.fire_callback_ = nullptr;
     threadsafe_state_.fire_callback_pending_ = false;
+    FireCallback(callback);
+    return;
+  }
+
+  // Pipeline the next frame behind the ones in flight.
+  if (CanPipelineFrame()) {
+    FireCallback(callback);
+    return;
   }
+
+  threadsafe_state_.fire_callback_ = callback;
 }
 
 // This method is called from the UI thread.
@@ -110,20 +145,25 @@ void FlatlandConnection::OnError(
 // This method is called from the raster thread.
 void FlatlandConnection::OnNextFrameBegin(
     fuchsia::ui::composition::OnNextFrameBeginValues values) {
-  present_credits_ += values.additional_present_credits();
+  std::scoped_lock<std::mutex> lock(threadsafe_state_.mutex_);
+  threadsafe_state_.present_credits_ += values.additional_present_credits();
+  if (values.has_future_presentation_infos()) {
+    UpdateFuturePresentationInfos(values.future_presentation_infos());
+  }
 
-  if (present_pending_ && present_credits_ > 0) {
+  if (present_pending_ && threadsafe_state_.present_credits_ > 0) {
     DoPresent();
     present_pending_ = false;
   }
 
-  if (present_credits_ > 0) {
-    std::scoped_lock<std::mutex> lock(threadsafe_state_.mutex_);
+  // A frame that never presents must not stall pipelining for good, so the
+  // frames carried over from before this OnNextFrameBegin stay within bounds.
+  threadsafe_state_.frames_in_flight_ =
+      std::min(threadsafe_state_.frames_in_flight_, max_frames_in_flight_);
+
+  if (threadsafe_state_.present_credits_ > 0) {
     if (threadsafe_state_.fire_callback_) {
-      fml::TimePoint now = fml::TimePoint::Now();
-      // TODO(fxbug.dev/64201): Calculate correct frame times.
-      threadsafe_state_.fire_callback_(
-          now, now + kDefaultFlatlandPresentationInterval);
+      FireCallback(threadsafe_state_.fire_callback_);
       threadsafe_state_.fire_callback_ = nullptr;
     } else {
       threadsafe_state_.fire_callback_pending_ = true;
@@ -134,9 +174,87 @@ void FlatlandConnection::OnNextFrameBegin(
 // This method is called from the raster thread.
 void FlatlandConnection::OnFramePresented(
     fuchsia::scenic::scheduling::FramePresentedInfo info) {
+  if (info.actual_presentation_time > 0) {
+    std::scoped_lock<std::mutex> lock(threadsafe_state_.mutex_);
+    fml::TimePoint presentation_time =
+        ToTimePoint(info.actual_presentation_time);
+    threadsafe_state_.last_presentation_time_ = presentation_time;
+
+    // The latency of the most recent present that made it to the display,
+    // from Scenic receiving it to it being shown.
+    for (const auto& present : info.presentation_infos) {
+      if (present.has_present_received_time()) {
+        threadsafe_state_.present_latency_ =
+            presentation_time - ToTimePoint(present.present_received_time());
+      }
+    }
+    threadsafe_state_.present_latency_ = std::clamp(
+        threadsafe_state_.present_latency_, fml::TimeDelta::Zero(),
+        threadsafe_state_.presentation_interval_ *
+            static_cast<int64_t>(max_frames_in_flight_));
+  }
   on_frame_presented_callback_(std::move(info));
 }
 
+bool FlatlandConnection::CanPipelineFrame() const {
+  return threadsafe_state_.frames_in_flight_ < max_frames_in_flight_ &&
+         threadsafe_state_.present_credits_ >
+             threadsafe_state_.frames_in_flight_;
+}
+
+void FlatlandConnection::FireCallback(const FireCallbackCallback& callback) {
+  auto [frame_start, frame_target] = GetTargetTimes(fml::TimePoint::Now());
+  threadsafe_state_.last_targeted_vsync_ = frame_target;
+  ++threadsafe_state_.frames_in_flight_;
+  callback(frame_start, frame_target);
+}
+
+std::pair<fml::TimePoint, fml::TimePoint> FlatlandConnection::GetTargetTimes(
+    fml::TimePoint now) {
+  const fml::TimeDelta interval = threadsafe_state_.presentation_interval_;
+  if (interval <= fml::TimeDelta::Zero()) {
+    return {now, now + kDefaultFlatlandPresentationInterval};
+  }
+
+  // A frame started now is shown no earlier than one present latency later,
+  // and successive frames target distinct vsyncs.
+  fml::TimePoint frame_target =
+      NextVsyncAfter(now + threadsafe_state_.present_latency_,
+                     threadsafe_state_.last_presentation_time_, interval);
+  while (frame_target <
+         threadsafe_state_.last_targeted_vsync_ + interval / 2) {
+    frame_target = frame_target + interval;
+  }
+
+  // As with Gfx, the frame starts |vsync_offset_| before the vsync it targets,
+  // or a whole interval before it by default.
+  fml::TimeDelta offset =
+      (vsync_offset_ > fml::TimeDelta::Zero() && vsync_offset_ < interval)
+          ? vsync_offset_
+          : interval;
+  return {std::max(now, frame_target - offset), frame_target};
+}
+
+void FlatlandConnection::UpdateFuturePresentationInfos(
+    const std::vector<fuchsia::scenic::scheduling::PresentationInfo>& infos) {
+  bool has_previous = false;
+  fml::TimePoint previous;
+  for (const auto& info : infos) {
+    if (!info.has_presentation_time()) {
+      continue;
+    }
+    fml::TimePoint presentation_time = ToTimePoint(info.presentation_time());
+    if (!has_previous) {
+      threadsafe_state_.last_presentation_time_ = presentation_time;
+    } else if (presentation_time > previous) {
+      threadsafe_state_.presentation_interval_ = presentation_time - previous;
+      return;
+    }
+    previous = presentation_time;
+    has_previous = true;
+  }
+}
+
 // This method is called from the raster thread.
 void FlatlandConnection::EnqueueAcquireFence(zx::event fence) {
   acquire_fences_.push_back(std::move(fence));
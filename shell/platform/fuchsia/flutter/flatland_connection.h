@@ -10,12 +10,15 @@
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
 
 #include "vsync_waiter.h"
 
 #include <cstdint>
 #include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace flutter_runner {
 
@@ -66,8 +69,32 @@ class FlatlandConnection final {
   void OnNextFrameBegin(
       fuchsia::ui::composition::OnNextFrameBeginValues values);
   void OnFramePresented(fuchsia::scenic::scheduling::FramePresentedInfo info);
+
+  // Precondition: |threadsafe_state_.mutex_| is held.
   void DoPresent();
 
+  // Returns whether another frame can start before the ones in flight have
+  // presented, which needs a present credit left over for it.
+  // Precondition: |threadsafe_state_.mutex_| is held.
+  bool CanPipelineFrame() const;
+
+  // Fires |callback| with the predicted times of the next frame, and counts
+  // that frame as being in flight until its Present.
+  // Precondition: |threadsafe_state_.mutex_| is held.
+  void FireCallback(const FireCallbackCallback& callback);
+
+  // Returns the start and target times of the next frame, aimed at the first
+  // vsync that a frame started now can reach given the measured presentation
+  // latency. Falls back to now until Scenic has reported its vsync interval.
+  // Precondition: |threadsafe_state_.mutex_| is held.
+  std::pair<fml::TimePoint, fml::TimePoint> GetTargetTimes(fml::TimePoint now);
+
+  // Records the vsync phase and interval from the upcoming presentations
+  // reported in |OnNextFrameBegin|.
+  // Precondition: |threadsafe_state_.mutex_| is held.
+  void UpdateFuturePresentationInfos(
+      const std::vector<fuchsia::scenic::scheduling::PresentationInfo>& infos);
+
   fuchsia::ui::composition::FlatlandPtr flatland_;
 
   fml::closure error_callback_;
@@ -76,9 +103,11 @@ class FlatlandConnection final {
   uint64_t next_content_id_ = 0;
 
   on_frame_presented_event on_frame_presented_callback_;
-  uint32_t present_credits_ = 1;
   bool present_pending_ = false;
 
+  const uint64_t max_frames_in_flight_;
+  const fml::TimeDelta vsync_offset_;
+
   // This struct contains state that is accessed from both from the UI thread
   // (in AwaitVsync) and the raster thread (in OnNextFrameBegin and Present).
   // You should always lock mutex_ before touching anything in this struct
@@ -87,6 +116,20 @@ class FlatlandConnection final {
     FireCallbackCallback fire_callback_;
     bool fire_callback_pending_ = false;
     bool first_present_called_ = false;
+
+    uint32_t present_credits_ = 1;
+
+    // Frames handed to the UI thread whose Present has not arrived yet. While
+    // this is below |max_frames_in_flight_| and unused present credits remain,
+    // AwaitVsync starts the next frame without waiting for OnNextFrameBegin.
+    uint64_t frames_in_flight_ = 0;
+
+    // Vsync prediction, from the presentation times reported by Scenic. The
+    // interval stays zero until Scenic has reported two upcoming vsyncs.
+    fml::TimePoint last_presentation_time_;
+    fml::TimeDelta presentation_interval_;
+    fml::TimeDelta present_latency_;
+    fml::TimePoint last_targeted_vsync_;
   } threadsafe_state_;
 
   std::vector<zx::event> acquire_fences_;
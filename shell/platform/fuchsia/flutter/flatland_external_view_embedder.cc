@@ -138,7 +138,7 @@ void FlatlandExternalViewEmbedder::SubmitFrame(
       // resource.
       if (surface->GetImageId() == 0) {
         auto image_id = flatland_->NextContentId().value;
-        const auto& size = surface->GetSize();
+        const auto& size = surface->GetImageSize();
         fuchsia::ui::composition::ImageProperties image_properties;
         image_properties.set_size({static_cast<uint32_t>(size.width()),
                                    static_cast<uint32_t>(size.height())});
@@ -162,10 +162,13 @@ void FlatlandExternalViewEmbedder::SubmitFrame(
     }
   }
 
-  // Submit layers and platform views to Scenic in composition order.
+  // Submit layers and platform views to Scenic in composition order. The
+  // scene graph is retained across frames, so only what changed since the
+  // previous frame is sent.
   {
     TRACE_EVENT0("flutter", "SubmitLayers");
 
+    std::vector<fuchsia::ui::composition::TransformId> child_transforms;
     size_t flatland_layer_index = 0;
     for (const auto& layer_id : frame_composition_order_) {
       const auto& layer = frame_layers_.find(layer_id);
@@ -216,9 +219,7 @@ void FlatlandExternalViewEmbedder::SubmitFrame(
         }
 
         // Attach the FlatlandView to the main scene graph.
-        flatland_->flatland()->AddChild(root_transform_id_,
-                                        viewport.transform_id);
-        child_transforms_.emplace_back(viewport.transform_id);
+        child_transforms.emplace_back(viewport.transform_id);
       }
 
       // Acquire the surface associated with the layer.
@@ -246,45 +247,62 @@ void FlatlandExternalViewEmbedder::SubmitFrame(
         if (flatland_layer_index == flatland_layers_.size()) {
           FlatlandLayer new_layer{.transform_id = flatland_->NextTransformId()};
           flatland_->flatland()->CreateTransform(new_layer.transform_id);
+
+          // Attach full-screen hit testing shield.
+          flatland_->flatland()->SetHitRegions(
+              new_layer.transform_id,
+              {{{0, 0, std::numeric_limits<float>::max(),
+                 std::numeric_limits<float>::max()},
+                fuchsia::ui::composition::HitTestInteraction::
+                    SEMANTICALLY_INVISIBLE}});
           flatland_layers_.emplace_back(std::move(new_layer));
         }
-
-        // Update the image content and set size.
-        flatland_->flatland()->SetContent(
-            flatland_layers_[flatland_layer_index].transform_id,
-            {surface_for_layer->GetImageId()});
-        flatland_->flatland()->SetImageDestinationSize(
-            {surface_for_layer->GetImageId()},
-            {static_cast<uint32_t>(surface_for_layer->GetSize().width()),
-             static_cast<uint32_t>(surface_for_layer->GetSize().height())});
-
-        // Flutter Embedder lacks an API to detect if a layer has alpha or not.
-        // For now, we assume any layer beyond the first has alpha.
-        flatland_->flatland()->SetImageBlendingFunction(
-            {surface_for_layer->GetImageId()},
-            flatland_layer_index == 0
-                ? fuchsia::ui::composition::BlendMode::SRC
-                : fuchsia::ui::composition::BlendMode::SRC_OVER);
+        auto& flatland_layer = flatland_layers_[flatland_layer_index];
+
+        // Update the image content and set size, if either changed.
+        const fuchsia::ui::composition::ContentId image_id = {
+            surface_for_layer->GetImageId()};
+        const auto& surface_size = surface_for_layer->GetSize();
+        if (image_id.value != flatland_layer.image_id.value ||
+            surface_size != flatland_layer.image_size) {
+          flatland_->flatland()->SetContent(flatland_layer.transform_id,
+                                            image_id);
+          // Surfaces may be larger than the layer, in which case the layer is
+          // drawn into their top-left region.
+          flatland_->flatland()->SetImageSampleRegion(
+              image_id, {0.f, 0.f, static_cast<float>(surface_size.width()),
+                         static_cast<float>(surface_size.height())});
+          flatland_->flatland()->SetImageDestinationSize(
+              image_id, {static_cast<uint32_t>(surface_size.width()),
+                         static_cast<uint32_t>(surface_size.height())});
+
+          // Flutter Embedder lacks an API to detect if a layer has alpha or
+          // not. For now, we assume any layer beyond the first has alpha.
+          flatland_->flatland()->SetImageBlendingFunction(
+              image_id, flatland_layer_index == 0
+                            ? fuchsia::ui::composition::BlendMode::SRC
+                            : fuchsia::ui::composition::BlendMode::SRC_OVER);
+
+          flatland_layer.image_id = image_id;
+          flatland_layer.image_size = surface_size;
+        }
 
         // Attach the FlatlandLayer to the main scene graph.
-        flatland_->flatland()->AddChild(
-            root_transform_id_,
-            flatland_layers_[flatland_layer_index].transform_id);
-        child_transforms_.emplace_back(
-            flatland_layers_[flatland_layer_index].transform_id);
-
-        // Attach full-screen hit testing shield.
-        flatland_->flatland()->SetHitRegions(
-            flatland_layers_[flatland_layer_index].transform_id,
-            {{{0, 0, std::numeric_limits<float>::max(),
-               std::numeric_limits<float>::max()},
-              fuchsia::ui::composition::HitTestInteraction::
-                  SEMANTICALLY_INVISIBLE}});
+        child_transforms.emplace_back(flatland_layer.transform_id);
+      } else if (flatland_layer_index < flatland_layers_.size()) {
+        ClearLayerContent(flatland_layer_index);
       }
 
       // Reset for the next pass:
       flatland_layer_index++;
     }
+
+    // Clear images on unused layers so they aren't cached unnecessarily.
+    for (size_t i = flatland_layer_index; i < flatland_layers_.size(); i++) {
+      ClearLayerContent(i);
+    }
+
+    UpdateChildTransforms(std::move(child_transforms));
   }
 
   // Present the session to Scenic, along with surface acquire/release fences.
@@ -402,17 +420,41 @@ void FlatlandExternalViewEmbedder::Reset() {
   frame_layers_.clear();
   frame_composition_order_.clear();
   frame_size_ = SkISize::Make(0, 0);
+}
+
+void FlatlandExternalViewEmbedder::ClearLayerContent(size_t index) {
+  FML_CHECK(index < flatland_layers_.size());
+  auto& layer = flatland_layers_[index];
+  if (layer.image_id.value == 0) {
+    return;
+  }
 
-  // Clear all children from root.
-  for (const auto& transform : child_transforms_) {
-    flatland_->flatland()->RemoveChild(root_transform_id_, transform);
+  flatland_->flatland()->SetContent(layer.transform_id, {0});
+  layer.image_id = {0};
+  layer.image_size = SkISize::MakeEmpty();
+}
+
+void FlatlandExternalViewEmbedder::UpdateChildTransforms(
+    std::vector<fuchsia::ui::composition::TransformId> child_transforms) {
+  // Children are drawn in the order they were added, so every child after the
+  // first one that differs is re-added. Views and layers are mostly appended
+  // or removed at the end, and frames often don't change the graph at all.
+  size_t unchanged = 0;
+  while (unchanged < child_transforms_.size() &&
+         unchanged < child_transforms.size() &&
+         child_transforms_[unchanged].value ==
+             child_transforms[unchanged].value) {
+    unchanged++;
   }
-  child_transforms_.clear();
 
-  // Clear images on all layers so they aren't cached unnecessarily.
-  for (const auto& layer : flatland_layers_) {
-    flatland_->flatland()->SetContent(layer.transform_id, {0});
+  for (size_t i = unchanged; i < child_transforms_.size(); i++) {
+    flatland_->flatland()->RemoveChild(root_transform_id_,
+                                       child_transforms_[i]);
+  }
+  for (size_t i = unchanged; i < child_transforms.size(); i++) {
+    flatland_->flatland()->AddChild(root_transform_id_, child_transforms[i]);
   }
+  child_transforms_ = std::move(child_transforms);
 }
 
 FlatlandExternalViewEmbedder::ViewMutators
@@ -166,8 +166,22 @@ class FlatlandExternalViewEmbedder final
   struct FlatlandLayer {
     // Transform on which Images are set.
     fuchsia::ui::composition::TransformId transform_id;
+
+    // The Image last set on the transform, and the size it was drawn at. The
+    // Image's properties are only sent to Flatland again when these change.
+    fuchsia::ui::composition::ContentId image_id = {0};
+    SkISize image_size = SkISize::MakeEmpty();
   };
 
+  // Detaches the layer at |index| from its Image, unless it already is.
+  void ClearLayerContent(size_t index);
+
+  // Updates the children of the root transform to |child_transforms|, in
+  // order, only adding and removing the children that changed since the
+  // previous frame.
+  void UpdateChildTransforms(
+      std::vector<fuchsia::ui::composition::TransformId> child_transforms);
+
   std::shared_ptr<FlatlandConnection> flatland_;
   std::shared_ptr<SurfaceProducer> surface_producer_;
 
@@ -27,6 +27,7 @@
 #include "runtime/dart/utils/vmservice_object.h"
 #include "third_party/icu/source/common/unicode/udata.h"
 #include "third_party/skia/include/core/SkGraphics.h"
+#include "warm_thread_pool.h"
 
 namespace flutter_runner {
 
@@ -202,6 +203,8 @@ Runner::Runner(fml::RefPtr<fml::TaskRunner> task_runner,
                             "");
   }
 #endif  // !defined(DART_PRODUCT)
+
+  WarmThreadPoolWhenIdle();
 }
 
 Runner::~Runner() {
@@ -258,6 +261,8 @@ void Runner::StartComponent(
 
   auto key = active_component.component.get();
   active_components_v1_[key] = std::move(active_component);
+
+  WarmThreadPoolWhenIdle();
 }
 
 void Runner::OnComponentV1Terminate(const ComponentV1* component) {
@@ -332,6 +337,8 @@ void Runner::Start(
 
   auto key = active_component.component.get();
   active_components_v2_[key] = std::move(active_component);
+
+  WarmThreadPoolWhenIdle();
 }
 
 void Runner::OnComponentV2Terminate(const ComponentV2* component) {
@@ -364,6 +371,12 @@ void Runner::OnComponentV2Terminate(const ComponentV2* component) {
   component_thread->Join();
 }
 
+void Runner::WarmThreadPoolWhenIdle() {
+  // Launching a component takes the threads out of the pool, so they are
+  // started again once the runner is done with the launch.
+  task_runner_->PostTask([]() { WarmThreadPool::GetInstance().Warm(); });
+}
+
 void Runner::SetupICU() {
   // Exposes the TZ data setup for testing.  Failing here is not fatal.
   Runner::SetupTZDataInternal();
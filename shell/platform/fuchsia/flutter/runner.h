@@ -78,6 +78,10 @@ class Runner final
   /// terminated.
   void OnComponentV2Terminate(const ComponentV2* component);
 
+  /// Starts the threads of the next component launch once the runner is
+  /// idle.
+  void WarmThreadPoolWhenIdle();
+
   void SetupICU();
 
 #if !defined(DART_PRODUCT)
@@ -107,6 +107,10 @@ SkISize SoftwareSurface::GetSize() const {
   return SkISize::Make(sk_surface_->width(), sk_surface_->height());
 }
 
+SkISize SoftwareSurface::GetImageSize() const {
+  return GetSize();
+}
+
 bool SoftwareSurface::CreateFences() {
   if (zx::event::create(0, &acquire_event_) != ZX_OK) {
     FML_LOG(ERROR) << "Failed to create acquire event.";
@@ -35,6 +35,10 @@ class SurfaceProducerSurface {
 
   virtual SkISize GetSize() const = 0;
 
+  // Returns the size of the image shared with Scenic. Only the top-left
+  // |GetSize()| region of the image holds content when it is larger.
+  virtual SkISize GetImageSize() const = 0;
+
   virtual void SetImageId(uint32_t image_id) = 0;
 
   virtual uint32_t GetImageId() = 0;
@@ -69,6 +69,25 @@ class FlatlandConnectionTest : public ::testing::Test {
         std::move(on_next_frame_begin_values));
   }
 
+  // OnNextFrameBegin reporting the upcoming vsyncs at |presentation_times|.
+  void OnNextFrameBegin(int num_present_credits,
+                        const std::vector<fml::TimePoint>& presentation_times) {
+    fuchsia::ui::composition::OnNextFrameBeginValues on_next_frame_begin_values;
+    on_next_frame_begin_values.set_additional_present_credits(
+        num_present_credits);
+    std::vector<fuchsia::scenic::scheduling::PresentationInfo> infos;
+    for (fml::TimePoint presentation_time : presentation_times) {
+      fuchsia::scenic::scheduling::PresentationInfo info;
+      info.set_latch_point(presentation_time.ToEpochDelta().ToNanoseconds());
+      info.set_presentation_time(
+          presentation_time.ToEpochDelta().ToNanoseconds());
+      infos.push_back(std::move(info));
+    }
+    on_next_frame_begin_values.set_future_presentation_infos(std::move(infos));
+    fake_flatland().FireOnNextFrameBeginEvent(
+        std::move(on_next_frame_begin_values));
+  }
+
  private:
   async::TestLoop loop_;
   std::unique_ptr<async::LoopInterface> session_subloop_;
@@ -456,4 +475,83 @@ TEST_F(FlatlandConnectionTest, PresentCreditExhaustion) {
   EXPECT_EQ(num_release_fences, num_onfb);
 }
 
+TEST_F(FlatlandConnectionTest, PipelinesUpToMaxFramesInFlight) {
+  size_t presents_called = 0u;
+  fake_flatland().SetPresentHandler(
+      [&presents_called](auto present_args) { presents_called++; });
+
+  flutter_runner::FlatlandConnection flatland_connection(
+      GetCurrentTestName(), TakeFlatlandHandle(), []() { FAIL(); },
+      [](auto...) {}, 2, fml::TimeDelta::Zero());
+
+  // The first frame uses up the initial present credit.
+  bool await_vsync_fired = false;
+  AwaitVsyncChecked(flatland_connection, await_vsync_fired,
+                    kDefaultFlatlandPresentationInterval);
+  EXPECT_TRUE(await_vsync_fired);
+  flatland_connection.Present();
+  loop().RunUntilIdle();
+  EXPECT_EQ(presents_called, 1u);
+
+  await_vsync_fired = false;
+  AwaitVsyncChecked(flatland_connection, await_vsync_fired,
+                    kDefaultFlatlandPresentationInterval);
+  EXPECT_FALSE(await_vsync_fired);
+
+  // OnNextFrameBegin starts a frame, and its spare credits let a second one
+  // start right away.
+  OnNextFrameBegin(3);
+  loop().RunUntilIdle();
+  EXPECT_TRUE(await_vsync_fired);
+
+  await_vsync_fired = false;
+  AwaitVsyncChecked(flatland_connection, await_vsync_fired,
+                    kDefaultFlatlandPresentationInterval);
+  EXPECT_TRUE(await_vsync_fired);
+
+  // A third frame would exceed the frames in flight.
+  await_vsync_fired = false;
+  AwaitVsyncChecked(flatland_connection, await_vsync_fired,
+                    kDefaultFlatlandPresentationInterval);
+  EXPECT_FALSE(await_vsync_fired);
+
+  // Until the first of them presents.
+  flatland_connection.Present();
+  loop().RunUntilIdle();
+  EXPECT_EQ(presents_called, 2u);
+  EXPECT_TRUE(await_vsync_fired);
+}
+
+TEST_F(FlatlandConnectionTest, TargetsPredictedVsyncs) {
+  flutter_runner::FlatlandConnection flatland_connection(
+      GetCurrentTestName(), TakeFlatlandHandle(), []() { FAIL(); },
+      [](auto...) {}, 2, fml::TimeDelta::Zero());
+
+  flatland_connection.AwaitVsync([](fml::TimePoint, fml::TimePoint) {});
+  flatland_connection.Present();
+  loop().RunUntilIdle();
+
+  const fml::TimeDelta interval = fml::TimeDelta::FromMilliseconds(16);
+  const fml::TimePoint next_vsync =
+      fml::TimePoint::Now() + fml::TimeDelta::FromMilliseconds(10);
+  std::vector<fml::TimePoint> frame_targets;
+  auto record_frame = [&frame_targets, interval](fml::TimePoint frame_start,
+                                                 fml::TimePoint frame_end) {
+    EXPECT_LE(frame_start, frame_end);
+    EXPECT_LE(frame_end - frame_start, interval);
+    frame_targets.push_back(frame_end);
+  };
+
+  flatland_connection.AwaitVsync(record_frame);
+  OnNextFrameBegin(2, {next_vsync, next_vsync + interval});
+  loop().RunUntilIdle();
+  ASSERT_EQ(frame_targets.size(), 1u);
+  EXPECT_EQ(frame_targets[0], next_vsync);
+
+  // The pipelined frame targets the vsync after.
+  flatland_connection.AwaitVsync(record_frame);
+  ASSERT_EQ(frame_targets.size(), 2u);
+  EXPECT_EQ(frame_targets[1], next_vsync + interval);
+}
+
 }  // namespace flutter_runner::testing
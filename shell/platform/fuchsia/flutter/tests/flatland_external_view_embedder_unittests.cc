@@ -85,6 +85,8 @@ class FakeSurfaceProducerSurface : public SurfaceProducerSurface {
     return SkISize::Make(surface_->width(), surface_->height());
   }
 
+  SkISize GetImageSize() const override { return GetSize(); }
+
   void SetImageId(uint32_t image_id) override { image_id_ = image_id; }
   uint32_t GetImageId() override { return image_id_; }
 
@@ -241,7 +243,10 @@ Matcher<std::shared_ptr<FakeTransform>> IsImageLayer(
       /*content*/
       Pointee(VariantWith<FakeImage>(FieldsAre(
           /*id*/ _, IsImageProperties(layer_size),
-          FakeImage::kDefaultSampleRegion, layer_size,
+          /*sample_region*/
+          fuchsia::math::RectF{0.f, 0.f, static_cast<float>(layer_size.width),
+                               static_cast<float>(layer_size.height)},
+          layer_size,
           FakeImage::kDefaultOpacity, blend_mode,
           /*buffer_import_token*/ _, /*vmo_index*/ 0))),
       num_hit_regions));
@@ -85,6 +85,8 @@ class FakeSurfaceProducerSurface : public SurfaceProducerSurface {
     return SkISize::Make(surface_->width(), surface_->height());
   }
 
+  SkISize GetImageSize() const override { return GetSize(); }
+
   void SetImageId(uint32_t image_id) override { FAIL(); }
   uint32_t GetImageId() override { return image_id_; }
 
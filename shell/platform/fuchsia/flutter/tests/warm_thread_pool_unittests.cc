@@ -0,0 +1,64 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/fuchsia/flutter/warm_thread_pool.h"
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "gtest/gtest.h"
+
+namespace flutter_runner::testing {
+
+namespace {
+
+// Returns whether |thread| is running and runs the tasks posted to it.
+bool RunsTasks(fml::Thread* thread) {
+  if (!thread) {
+    return false;
+  }
+  fml::AutoResetWaitableEvent latch;
+  thread->GetTaskRunner()->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+  return true;
+}
+
+}  // namespace
+
+TEST(WarmThreadPoolTest, StartsThreadsWhenCold) {
+  WarmThreadPool pool;
+
+  EXPECT_TRUE(RunsTasks(pool.TakePlatformThread().get()));
+
+  flutter::ThreadHost thread_host = pool.TakeThreadHost("cold");
+  EXPECT_EQ(thread_host.name_prefix, "cold");
+  EXPECT_TRUE(RunsTasks(thread_host.ui_thread.get()));
+  EXPECT_TRUE(RunsTasks(thread_host.raster_thread.get()));
+  EXPECT_TRUE(RunsTasks(thread_host.io_thread.get()));
+  EXPECT_EQ(thread_host.platform_thread, nullptr);
+}
+
+TEST(WarmThreadPoolTest, HandsOutWarmThreadsOnce) {
+  WarmThreadPool pool;
+  pool.Warm();
+
+  std::unique_ptr<fml::Thread> platform_thread = pool.TakePlatformThread();
+  EXPECT_TRUE(RunsTasks(platform_thread.get()));
+
+  flutter::ThreadHost warm_thread_host = pool.TakeThreadHost("warm");
+  EXPECT_EQ(warm_thread_host.name_prefix, "warm");
+  EXPECT_TRUE(RunsTasks(warm_thread_host.ui_thread.get()));
+  EXPECT_TRUE(RunsTasks(warm_thread_host.raster_thread.get()));
+  EXPECT_TRUE(RunsTasks(warm_thread_host.io_thread.get()));
+
+  // The pool is cold again, and starts new threads.
+  std::unique_ptr<fml::Thread> other_platform_thread =
+      pool.TakePlatformThread();
+  EXPECT_NE(other_platform_thread, platform_thread);
+  EXPECT_TRUE(RunsTasks(other_platform_thread.get()));
+
+  flutter::ThreadHost cold_thread_host = pool.TakeThreadHost("cold");
+  EXPECT_NE(cold_thread_host.ui_thread, warm_thread_host.ui_thread);
+  EXPECT_TRUE(RunsTasks(cold_thread_host.ui_thread.get()));
+}
+
+}  // namespace flutter_runner::testing
@@ -148,7 +148,10 @@ VulkanSurface::VulkanSurface(
     scenic::Session* session,
     const SkISize& size,
     uint32_t buffer_id)
-    : vulkan_provider_(vulkan_provider), session_(session), wait_(this) {
+    : vulkan_provider_(vulkan_provider),
+      session_(session),
+      context_(context),
+      wait_(this) {
   FML_CHECK(session_ || flatland_allocator.is_bound());
   FML_CHECK(context != nullptr);
 
@@ -201,6 +204,44 @@ SkISize VulkanSurface::GetSize() const {
   return SkISize::Make(sk_surface_->width(), sk_surface_->height());
 }
 
+SkISize VulkanSurface::GetImageSize() const {
+  if (!valid_) {
+    return SkISize::Make(0, 0);
+  }
+
+  return image_size_;
+}
+
+bool VulkanSurface::SetSize(const SkISize& size) {
+  FML_CHECK(valid_);
+  FML_CHECK(!size.isEmpty() && size.width() <= image_size_.width() &&
+            size.height() <= image_size_.height());
+  if (size == GetSize()) {
+    return true;
+  }
+
+  TRACE_EVENT2("flutter", "VulkanSurface::SetSize", "width", size.width(),
+               "height", size.height());
+
+  // The new Skia surface wraps the same image, so it starts from the layout
+  // the image was last left in.
+  VkImageCreateInfo image_create_info = vulkan_image_.vk_image_create_info;
+  GrVkImageInfo current_image_info;
+  GrBackendRenderTarget current_render_target =
+      sk_surface_->getBackendRenderTarget(
+          SkSurface::kFlushRead_BackendHandleAccess);
+  if (current_render_target.getVkImageInfo(&current_image_info)) {
+    image_create_info.initialLayout = current_image_info.fImageLayout;
+  }
+
+  if (!SetupSkiaSurface(context_, size, kSkiaColorType, image_create_info,
+                        vulkan_image_.vk_memory_requirements)) {
+    valid_ = false;
+    return false;
+  }
+  return true;
+}
+
 vulkan::VulkanHandle<VkSemaphore> VulkanSurface::SemaphoreFromEvent(
     const zx::event& event) const {
   VkResult result;
@@ -342,6 +383,7 @@ bool VulkanSurface::AllocateDeviceMemory(
                  "VulkanSurface: Failed to create VkImage");
 
   vulkan_image_ = std::move(vulkan_image);
+  image_size_ = size;
   const VkMemoryRequirements& memory_requirements =
       vulkan_image_.vk_memory_requirements;
   VkImageCreateInfo& image_create_info = vulkan_image_.vk_image_create_info;
@@ -355,6 +397,9 @@ bool VulkanSurface::AllocateDeviceMemory(
     return false;
   }
 
+  // The memory is imported from the sysmem buffer collection that is shared
+  // with the compositor, so it cannot be sub-allocated from a larger block.
+  // The pool recycles surfaces to keep these allocations off the frame path.
   VkImportMemoryBufferCollectionFUCHSIA import_memory_info = {
       .sType = VK_STRUCTURE_TYPE_IMPORT_MEMORY_BUFFER_COLLECTION_FUCHSIA,
       .pNext = nullptr,
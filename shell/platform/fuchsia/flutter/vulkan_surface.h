@@ -62,6 +62,14 @@ class VulkanSurface final : public SurfaceProducerSurface {
   // |SurfaceProducerSurface|
   SkISize GetSize() const override;
 
+  // |SurfaceProducerSurface|
+  SkISize GetImageSize() const override;
+
+  // Points the Skia surface at the top-left |size| region of the image, which
+  // must fit in it, so that Skia limits its viewport and scissor to it.
+  // Returns false if the Skia surface could not be recreated.
+  bool SetSize(const SkISize& size);
+
   // Note: It is safe for the caller to collect the surface in the
   // |on_writes_committed| callback.
   void SignalWritesFinished(
@@ -161,7 +169,9 @@ class VulkanSurface final : public SurfaceProducerSurface {
 
   vulkan::VulkanProvider& vulkan_provider_;
   scenic::Session* session_;
+  sk_sp<GrDirectContext> context_;
   VulkanImage vulkan_image_;
+  SkISize image_size_ = SkISize::MakeEmpty();
   vulkan::VulkanHandle<VkDeviceMemory> vk_memory_;
   VkMemoryAllocateInfo vk_memory_info_;
   vulkan::VulkanHandle<VkFence> command_buffer_fence_;
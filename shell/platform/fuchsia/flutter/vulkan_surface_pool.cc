@@ -8,6 +8,7 @@
 #include <lib/zx/process.h>
 
 #include <algorithm>
+#include <iterator>
 #include <string>
 
 #include "flutter/fml/trace_event.h"
@@ -72,26 +73,49 @@ std::unique_ptr<VulkanSurface> VulkanSurfacePool::AcquireSurface(
   return surface;
 }
 
+SkISize VulkanSurfacePool::GetSizeClass(const SkISize& size) const {
+  // Scenic stretches images over their rectangle instead of sampling a
+  // sub-region, so Gfx surfaces are kept to the exact size.
+  if (scenic_session_) {
+    return size;
+  }
+
+  auto round_up = [](int32_t dimension) {
+    return (dimension + kSizeClassGranularity - 1) / kSizeClassGranularity *
+           kSizeClassGranularity;
+  };
+  return SkISize::Make(round_up(size.width()), round_up(size.height()));
+}
+
 std::unique_ptr<VulkanSurface> VulkanSurfacePool::GetCachedOrCreateSurface(
     const SkISize& size) {
   TRACE_EVENT2("flutter", "VulkanSurfacePool::GetCachedOrCreateSurface",
                "width", size.width(), "height", size.height());
-  // First try to find a surface that exactly matches |size|.
+  const SkISize image_size = GetSizeClass(size);
+
+  // First try to find the most recently used surface of the size class.
   {
-    auto exact_match_it =
-        std::find_if(available_surfaces_.begin(), available_surfaces_.end(),
-                     [&size](const auto& surface) {
-                       return surface->IsValid() && surface->GetSize() == size;
-                     });
-    if (exact_match_it != available_surfaces_.end()) {
-      auto acquired_surface = std::move(*exact_match_it);
-      available_surfaces_.erase(exact_match_it);
-      TRACE_EVENT_INSTANT0("flutter", "Exact match found");
-      return acquired_surface;
+    auto match_it = std::find_if(
+        available_surfaces_.rbegin(), available_surfaces_.rend(),
+        [&image_size](const auto& surface) {
+          return surface->IsValid() && surface->GetImageSize() == image_size;
+        });
+    if (match_it != available_surfaces_.rend()) {
+      auto acquired_surface = std::move(*match_it);
+      available_surfaces_.erase(std::next(match_it).base());
+      if (acquired_surface->SetSize(size)) {
+        TRACE_EVENT_INSTANT0("flutter", "Size class match found");
+        trace_surfaces_reused_++;
+        return acquired_surface;
+      }
     }
   }
 
-  return CreateSurface(size);
+  auto surface = CreateSurface(image_size);
+  if (surface != nullptr && !surface->SetSize(size)) {
+    return nullptr;
+  }
+  return surface;
 }
 
 void VulkanSurfacePool::SubmitSurface(
@@ -131,6 +155,7 @@ std::unique_ptr<VulkanSurface> VulkanSurfacePool::CreateSurface(
     return nullptr;
   }
   trace_surfaces_created_++;
+  trace_bytes_created_ += surface->GetAllocationSize();
   return surface;
 }
 
@@ -158,16 +183,33 @@ void VulkanSurfacePool::RecycleSurface(std::unique_ptr<VulkanSurface> surface) {
   }
 
   TRACE_EVENT0("flutter", "VulkanSurfacePool::RecycleSurface");
-  // Recycle the buffer by putting it in the list of available surfaces if we
-  // have not reached the maximum amount of cached surfaces.
-  if (available_surfaces_.size() < kMaxSurfaces) {
-    available_surfaces_.push_back(std::move(surface));
-  } else {
-    TRACE_EVENT_INSTANT0("flutter", "Too many surfaces in pool, dropping");
-  }
+  // Recycle the buffer by putting it at the most recently used end of the
+  // list of available surfaces, making room for it within the budget.
+  available_surfaces_.push_back(std::move(surface));
+  EvictToBudget();
   TraceStats();
 }
 
+void VulkanSurfacePool::EvictToBudget() {
+  size_t cached_bytes = 0;
+  for (const auto& surface : available_surfaces_) {
+    cached_bytes += surface->GetAllocationSize();
+  }
+
+  auto evict_end = available_surfaces_.begin();
+  while (evict_end != available_surfaces_.end() &&
+         (cached_bytes > kMaxCachedBytes ||
+          available_surfaces_.end() - evict_end > kMaxSurfaces)) {
+    cached_bytes -= (*evict_end)->GetAllocationSize();
+    ++evict_end;
+  }
+  if (evict_end != available_surfaces_.begin()) {
+    TRACE_EVENT_INSTANT0("flutter", "Pool over budget, evicting");
+    trace_surfaces_evicted_ += evict_end - available_surfaces_.begin();
+    available_surfaces_.erase(available_surfaces_.begin(), evict_end);
+  }
+}
+
 void VulkanSurfacePool::AgeAndCollectOldBuffers() {
   TRACE_EVENT0("flutter", "VulkanSurfacePool::AgeAndCollectOldBuffers");
 
@@ -194,7 +236,7 @@ void VulkanSurfacePool::AgeAndCollectOldBuffers() {
   // uses a necessary amount of memory.
   if (surface_to_remove_it != available_surfaces_.end()) {
     TRACE_EVENT_INSTANT0("flutter", "replacing surface with smaller one");
-    auto size = (*surface_to_remove_it)->GetSize();
+    auto size = (*surface_to_remove_it)->GetImageSize();
     available_surfaces_.erase(surface_to_remove_it);
     auto new_surface = CreateSurface(size);
     if (new_surface != nullptr) {
@@ -216,7 +258,7 @@ void VulkanSurfacePool::ShrinkToFit() {
   std::vector<SkISize> sizes_to_recreate;
   for (auto& surface : available_surfaces_) {
     if (surface->IsOversized()) {
-      sizes_to_recreate.push_back(surface->GetSize());
+      sizes_to_recreate.push_back(surface->GetImageSize());
       surface.reset();
     }
   }
@@ -254,6 +296,7 @@ void VulkanSurfacePool::TraceStats() {
                 available_surfaces_.size(),                       //
                 "Created", trace_surfaces_created_,               //
                 "Reused", trace_surfaces_reused_,                 //
+                "Evicted", trace_surfaces_evicted_,               //
                 "PendingInCompositor", pending_surfaces_.size(),  //
                 "Retained", 0,                                    //
                 "SkiaCacheResources", skia_resources              //
@@ -261,6 +304,7 @@ void VulkanSurfacePool::TraceStats() {
 
   TRACE_COUNTER("flutter", "SurfacePoolBytes", 0u,          //
                 "CachedBytes", cached_surfaces_bytes,       //
+                "CreatedBytes", trace_bytes_created_,       //
                 "RetainedBytes", 0,                         //
                 "SkiaCacheBytes", skia_bytes,               //
                 "SkiaCachePurgeable", skia_cache_purgeable  //
@@ -269,6 +313,8 @@ void VulkanSurfacePool::TraceStats() {
   // Reset per present/frame stats.
   trace_surfaces_created_ = 0;
   trace_surfaces_reused_ = 0;
+  trace_surfaces_evicted_ = 0;
+  trace_bytes_created_ = 0;
 }
 
 }  // namespace flutter_runner
@@ -21,6 +21,14 @@ class VulkanSurfacePool final {
   static constexpr int kMaxSurfaces = 12;
   // If a surface doesn't get used for 3 or more generations, we discard it.
   static constexpr int kMaxSurfaceAge = 3;
+  // Cached surfaces are evicted, least recently used first, once they hold
+  // more than this many bytes.
+  static constexpr size_t kMaxCachedBytes = 128 * 1024 * 1024;
+  // With Flatland, surfaces are allocated in size classes whose dimensions are
+  // multiples of this many pixels, and layers are drawn into a sub-region of
+  // them.  Layers whose size changes slightly every frame, such as animated
+  // overlays, then keep reusing the same surfaces.
+  static constexpr int kSizeClassGranularity = 64;
 
   VulkanSurfacePool(vulkan::VulkanProvider& vulkan_provider,
                     sk_sp<GrDirectContext> context,
@@ -52,9 +60,18 @@ class VulkanSurfacePool final {
 
   size_t trace_surfaces_created_ = 0;
   size_t trace_surfaces_reused_ = 0;
+  size_t trace_surfaces_evicted_ = 0;
+  size_t trace_bytes_created_ = 0;
+
+  // Returns the size of the images that surfaces of |size| are allocated in.
+  SkISize GetSizeClass(const SkISize& size) const;
 
   std::unique_ptr<VulkanSurface> GetCachedOrCreateSurface(const SkISize& size);
 
+  // Evicts the least recently used surfaces in |available_surfaces_| until
+  // they fit in |kMaxSurfaces| and |kMaxCachedBytes|.
+  void EvictToBudget();
+
   void RecycleSurface(std::unique_ptr<VulkanSurface> surface);
 
   void RecyclePendingSurface(uintptr_t surface_key);
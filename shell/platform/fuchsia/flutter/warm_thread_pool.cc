@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "warm_thread_pool.h"
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter_runner {
+
+namespace {
+
+constexpr uint64_t kEngineThreadTypes = flutter::ThreadHost::Type::RASTER |
+                                        flutter::ThreadHost::Type::UI |
+                                        flutter::ThreadHost::Type::IO;
+
+constexpr char kWarmThreadPrefix[] = "flutter.warm";
+
+// Renames |thread|, which was started before the name it should have was
+// known.
+void RenameThread(fml::Thread* thread,
+                  flutter::ThreadHost::Type type,
+                  const std::string& name_prefix) {
+  if (!thread) {
+    return;
+  }
+  thread->GetTaskRunner()->PostTask(
+      [name = flutter::ThreadHost::ThreadHostConfig::MakeThreadName(
+           type, name_prefix)]() {
+        fml::Thread::SetCurrentThreadName(fml::Thread::ThreadConfig(name));
+      });
+}
+
+}  // namespace
+
+WarmThreadPool& WarmThreadPool::GetInstance() {
+  static WarmThreadPool* pool = new WarmThreadPool();
+  return *pool;
+}
+
+WarmThreadPool::WarmThreadPool() = default;
+
+WarmThreadPool::~WarmThreadPool() = default;
+
+void WarmThreadPool::Warm() {
+  TRACE_EVENT0("flutter", "WarmThreadPool::Warm");
+  std::scoped_lock lock(mutex_);
+  if (!platform_thread_) {
+    platform_thread_ = std::make_unique<fml::Thread>();
+  }
+  if (!thread_host_) {
+    thread_host_.emplace(kWarmThreadPrefix, kEngineThreadTypes);
+  }
+}
+
+std::unique_ptr<fml::Thread> WarmThreadPool::TakePlatformThread() {
+  {
+    std::scoped_lock lock(mutex_);
+    if (platform_thread_) {
+      return std::move(platform_thread_);
+    }
+  }
+  return std::make_unique<fml::Thread>();
+}
+
+flutter::ThreadHost WarmThreadPool::TakeThreadHost(
+    const std::string& name_prefix) {
+  std::optional<flutter::ThreadHost> thread_host;
+  {
+    std::scoped_lock lock(mutex_);
+    thread_host.swap(thread_host_);
+  }
+  if (!thread_host) {
+    return flutter::ThreadHost(name_prefix, kEngineThreadTypes);
+  }
+
+  thread_host->name_prefix = name_prefix;
+  RenameThread(thread_host->ui_thread.get(), flutter::ThreadHost::Type::UI,
+               name_prefix);
+  RenameThread(thread_host->raster_thread.get(),
+               flutter::ThreadHost::Type::RASTER, name_prefix);
+  RenameThread(thread_host->io_thread.get(), flutter::ThreadHost::Type::IO,
+               name_prefix);
+  return std::move(*thread_host);
+}
+
+}  // namespace flutter_runner
@@ -0,0 +1,55 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_FUCHSIA_FLUTTER_WARM_THREAD_POOL_H_
+#define FLUTTER_SHELL_PLATFORM_FUCHSIA_FLUTTER_WARM_THREAD_POOL_H_
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/thread.h"
+#include "flutter/shell/common/thread_host.h"
+
+namespace flutter_runner {
+
+/// The threads of the next component launched by the runner, started ahead
+/// of time so that launching a component doesn't wait for its threads to
+/// start.
+///
+/// The runner warms the pool when it is idle, and components and engines
+/// take their threads from it, falling back to starting new ones when the
+/// pool is cold. This is safe to use from any thread.
+class WarmThreadPool {
+ public:
+  /// Returns the pool shared by the components of this process.
+  static WarmThreadPool& GetInstance();
+
+  WarmThreadPool();
+  ~WarmThreadPool();
+
+  /// Starts the threads for the next component launch, unless they already
+  /// are.
+  void Warm();
+
+  /// Returns the thread a component runs on.
+  std::unique_ptr<fml::Thread> TakePlatformThread();
+
+  /// Returns the UI, raster and IO threads of an engine, named after
+  /// |name_prefix|.
+  flutter::ThreadHost TakeThreadHost(const std::string& name_prefix);
+
+ private:
+  std::mutex mutex_;
+  std::unique_ptr<fml::Thread> platform_thread_;
+  std::optional<flutter::ThreadHost> thread_host_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(WarmThreadPool);
+};
+
+}  // namespace flutter_runner
+
+#endif  // FLUTTER_SHELL_PLATFORM_FUCHSIA_FLUTTER_WARM_THREAD_POOL_H_
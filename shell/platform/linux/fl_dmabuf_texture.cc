@@ -0,0 +1,235 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_dmabuf_texture.h"
+
+#include <epoxy/egl.h>
+#include <epoxy/gl.h>
+#include <gmodule.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+#include "flutter/shell/platform/linux/fl_dmabuf_texture_private.h"
+
+// Same as DRM_FORMAT_MOD_INVALID in drm_fourcc.h.
+static constexpr uint64_t kDrmFormatModInvalid = 0x00ffffffffffffffULL;
+
+static constexpr uint32_t fourcc(char a, char b, char c, char d) {
+  return static_cast<uint32_t>(a) | (static_cast<uint32_t>(b) << 8) |
+         (static_cast<uint32_t>(c) << 16) | (static_cast<uint32_t>(d) << 24);
+}
+
+// Single plane RGB formats that can be sampled as GL_TEXTURE_2D. Everything
+// else is sampled as GL_TEXTURE_EXTERNAL_OES, which converts YUV to RGB.
+static constexpr uint32_t kRgbFormats[] = {
+    fourcc('A', 'R', '2', '4'),  // DRM_FORMAT_ARGB8888
+    fourcc('X', 'R', '2', '4'),  // DRM_FORMAT_XRGB8888
+    fourcc('A', 'B', '2', '4'),  // DRM_FORMAT_ABGR8888
+    fourcc('X', 'B', '2', '4'),  // DRM_FORMAT_XBGR8888
+    fourcc('R', 'A', '2', '4'),  // DRM_FORMAT_RGBA8888
+    fourcc('R', 'X', '2', '4'),  // DRM_FORMAT_RGBX8888
+    fourcc('B', 'A', '2', '4'),  // DRM_FORMAT_BGRA8888
+    fourcc('B', 'X', '2', '4'),  // DRM_FORMAT_BGRX8888
+};
+
+// Attributes describing each plane to EGL_EXT_image_dma_buf_import.
+static constexpr EGLint kPlaneAttributes[FL_DMABUF_MAX_PLANES][5] = {
+    {EGL_DMA_BUF_PLANE0_FD_EXT, EGL_DMA_BUF_PLANE0_OFFSET_EXT,
+     EGL_DMA_BUF_PLANE0_PITCH_EXT, EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT,
+     EGL_DMA_BUF_PLANE0_MODIFIER_HI_EXT},
+    {EGL_DMA_BUF_PLANE1_FD_EXT, EGL_DMA_BUF_PLANE1_OFFSET_EXT,
+     EGL_DMA_BUF_PLANE1_PITCH_EXT, EGL_DMA_BUF_PLANE1_MODIFIER_LO_EXT,
+     EGL_DMA_BUF_PLANE1_MODIFIER_HI_EXT},
+    {EGL_DMA_BUF_PLANE2_FD_EXT, EGL_DMA_BUF_PLANE2_OFFSET_EXT,
+     EGL_DMA_BUF_PLANE2_PITCH_EXT, EGL_DMA_BUF_PLANE2_MODIFIER_LO_EXT,
+     EGL_DMA_BUF_PLANE2_MODIFIER_HI_EXT},
+    {EGL_DMA_BUF_PLANE3_FD_EXT, EGL_DMA_BUF_PLANE3_OFFSET_EXT,
+     EGL_DMA_BUF_PLANE3_PITCH_EXT, EGL_DMA_BUF_PLANE3_MODIFIER_LO_EXT,
+     EGL_DMA_BUF_PLANE3_MODIFIER_HI_EXT},
+};
+
+// A DMA-BUF imported for one frame, released once Flutter is done with it.
+typedef struct {
+  EGLDisplay display;
+  EGLImageKHR image;
+  GLuint texture_id;
+} ImportedTexture;
+
+G_DEFINE_QUARK(fl_dmabuf_texture_error_quark, fl_dmabuf_texture_error)
+
+// Added here to stop the compiler from optimising this function away.
+G_MODULE_EXPORT GType fl_dmabuf_texture_get_type();
+
+static void fl_dmabuf_texture_iface_init(FlTextureInterface* iface) {}
+
+G_DEFINE_TYPE_WITH_CODE(FlDmabufTexture,
+                        fl_dmabuf_texture,
+                        G_TYPE_OBJECT,
+                        G_IMPLEMENT_INTERFACE(fl_texture_get_type(),
+                                              fl_dmabuf_texture_iface_init))
+
+static gboolean is_rgb_format(uint32_t format) {
+  for (uint32_t rgb_format : kRgbFormats) {
+    if (format == rgb_format) {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+static void close_fence(int fence_fd) {
+  if (fence_fd >= 0) {
+    close(fence_fd);
+  }
+}
+
+// Makes the GPU wait for the producer of the buffer to finish writing it.
+// Takes ownership of [fence_fd].
+static void wait_for_fence(EGLDisplay display, int fence_fd) {
+  if (fence_fd < 0) {
+    return;
+  }
+
+  if (epoxy_has_egl_extension(display, "EGL_ANDROID_native_fence_sync") &&
+      epoxy_has_egl_extension(display, "EGL_KHR_wait_sync")) {
+    const EGLint attributes[] = {EGL_SYNC_NATIVE_FENCE_FD_ANDROID, fence_fd,
+                                 EGL_NONE};
+    EGLSyncKHR sync =
+        eglCreateSyncKHR(display, EGL_SYNC_NATIVE_FENCE_ANDROID, attributes);
+    if (sync != EGL_NO_SYNC_KHR) {
+      // The sync now owns the file descriptor.
+      eglWaitSyncKHR(display, sync, 0);
+      eglDestroySyncKHR(display, sync);
+      return;
+    }
+  }
+
+  // Without native fences the render thread waits instead.
+  struct pollfd fence = {fence_fd, POLLIN, 0};
+  while (poll(&fence, 1, -1) < 0 && errno == EINTR) {
+  }
+  close(fence_fd);
+}
+
+static void imported_texture_destroy(void* user_data) {
+  ImportedTexture* imported = static_cast<ImportedTexture*>(user_data);
+  glDeleteTextures(1, &imported->texture_id);
+  eglDestroyImageKHR(imported->display, imported->image);
+  g_free(imported);
+}
+
+gboolean fl_dmabuf_texture_populate(FlDmabufTexture* texture,
+                                    uint32_t width,
+                                    uint32_t height,
+                                    FlutterOpenGLTexture* opengl_texture,
+                                    GError** error) {
+  FlDmabufTexture* self = FL_DMABUF_TEXTURE(texture);
+
+  FlDmabuf dmabuf = {};
+  dmabuf.width = width;
+  dmabuf.height = height;
+  dmabuf.modifier = kDrmFormatModInvalid;
+  dmabuf.fence_fd = -1;
+  if (!FL_DMABUF_TEXTURE_GET_CLASS(self)->get_dmabuf(self, &dmabuf, error)) {
+    return FALSE;
+  }
+
+  EGLDisplay display = eglGetCurrentDisplay();
+  if (display == EGL_NO_DISPLAY ||
+      !epoxy_has_egl_extension(display, "EGL_EXT_image_dma_buf_import")) {
+    close_fence(dmabuf.fence_fd);
+    g_set_error(error, FL_DMABUF_TEXTURE_ERROR,
+                FL_DMABUF_TEXTURE_ERROR_NOT_SUPPORTED,
+                "DMA-BUF textures require EGL_EXT_image_dma_buf_import");
+    return FALSE;
+  }
+
+  GLenum target = dmabuf.n_planes == 1 && is_rgb_format(dmabuf.fourcc)
+                      ? GL_TEXTURE_2D
+                      : GL_TEXTURE_EXTERNAL_OES;
+  if (target == GL_TEXTURE_EXTERNAL_OES &&
+      !epoxy_has_gl_extension("GL_OES_EGL_image_external")) {
+    close_fence(dmabuf.fence_fd);
+    g_set_error(error, FL_DMABUF_TEXTURE_ERROR,
+                FL_DMABUF_TEXTURE_ERROR_NOT_SUPPORTED,
+                "DMA-BUF textures in YUV formats require "
+                "GL_OES_EGL_image_external");
+    return FALSE;
+  }
+
+  gboolean use_modifier =
+      dmabuf.modifier != kDrmFormatModInvalid &&
+      epoxy_has_egl_extension(display,
+                              "EGL_EXT_image_dma_buf_import_modifiers");
+  if (dmabuf.n_planes == 0 || dmabuf.n_planes > FL_DMABUF_MAX_PLANES ||
+      (dmabuf.n_planes == FL_DMABUF_MAX_PLANES && !use_modifier)) {
+    close_fence(dmabuf.fence_fd);
+    g_set_error(error, FL_DMABUF_TEXTURE_ERROR, FL_DMABUF_TEXTURE_ERROR_FAILED,
+                "Unsupported number of DMA-BUF planes %u", dmabuf.n_planes);
+    return FALSE;
+  }
+
+  EGLint attributes[7 + FL_DMABUF_MAX_PLANES * 10 + 1];
+  size_t n = 0;
+  attributes[n++] = EGL_WIDTH;
+  attributes[n++] = dmabuf.width;
+  attributes[n++] = EGL_HEIGHT;
+  attributes[n++] = dmabuf.height;
+  attributes[n++] = EGL_LINUX_DRM_FOURCC_EXT;
+  attributes[n++] = dmabuf.fourcc;
+  for (uint32_t i = 0; i < dmabuf.n_planes; i++) {
+    attributes[n++] = kPlaneAttributes[i][0];
+    attributes[n++] = dmabuf.fds[i];
+    attributes[n++] = kPlaneAttributes[i][1];
+    attributes[n++] = dmabuf.offsets[i];
+    attributes[n++] = kPlaneAttributes[i][2];
+    attributes[n++] = dmabuf.strides[i];
+    if (use_modifier) {
+      attributes[n++] = kPlaneAttributes[i][3];
+      attributes[n++] = static_cast<EGLint>(dmabuf.modifier & 0xffffffff);
+      attributes[n++] = kPlaneAttributes[i][4];
+      attributes[n++] = static_cast<EGLint>(dmabuf.modifier >> 32);
+    }
+  }
+  attributes[n++] = EGL_NONE;
+
+  EGLImageKHR image = eglCreateImageKHR(display, EGL_NO_CONTEXT,
+                                        EGL_LINUX_DMA_BUF_EXT, nullptr,
+                                        attributes);
+  if (image == EGL_NO_IMAGE_KHR) {
+    close_fence(dmabuf.fence_fd);
+    g_set_error(error, FL_DMABUF_TEXTURE_ERROR, FL_DMABUF_TEXTURE_ERROR_FAILED,
+                "Failed to import DMA-BUF: EGL error 0x%x", eglGetError());
+    return FALSE;
+  }
+
+  wait_for_fence(display, dmabuf.fence_fd);
+
+  ImportedTexture* imported = g_new0(ImportedTexture, 1);
+  imported->display = display;
+  imported->image = image;
+  glGenTextures(1, &imported->texture_id);
+  glBindTexture(target, imported->texture_id);
+  glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glEGLImageTargetTexture2DOES(target, image);
+
+  opengl_texture->target = target;
+  opengl_texture->name = imported->texture_id;
+  opengl_texture->format = GL_RGBA8;
+  opengl_texture->destruction_callback = imported_texture_destroy;
+  opengl_texture->user_data = imported;
+  opengl_texture->width = dmabuf.width;
+  opengl_texture->height = dmabuf.height;
+
+  return TRUE;
+}
+
+static void fl_dmabuf_texture_class_init(FlDmabufTextureClass* klass) {}
+
+static void fl_dmabuf_texture_init(FlDmabufTexture* self) {}
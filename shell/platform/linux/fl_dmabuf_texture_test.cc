@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_dmabuf_texture.h"
+#include "flutter/shell/platform/linux/fl_dmabuf_texture_private.h"
+#include "flutter/shell/platform/linux/fl_texture_private.h"
+#include "flutter/shell/platform/linux/testing/fl_test.h"
+#include "gtest/gtest.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+static constexpr uint32_t BUFFER_WIDTH = 4u;
+static constexpr uint32_t BUFFER_HEIGHT = 4u;
+
+G_DECLARE_FINAL_TYPE(FlTestDmabufTexture,
+                     fl_test_dmabuf_texture,
+                     FL,
+                     TEST_DMABUF_TEXTURE,
+                     FlDmabufTexture)
+
+/// A texture that hands out the read end of a pipe as its fence.
+struct _FlTestDmabufTexture {
+  FlDmabufTexture parent_instance;
+
+  int fence_fds[2];
+};
+
+G_DEFINE_TYPE(FlTestDmabufTexture,
+              fl_test_dmabuf_texture,
+              fl_dmabuf_texture_get_type())
+
+static gboolean fl_test_dmabuf_texture_get_dmabuf(FlDmabufTexture* texture,
+                                                  FlDmabuf* dmabuf,
+                                                  GError** error) {
+  FlTestDmabufTexture* self = FL_TEST_DMABUF_TEXTURE(texture);
+
+  EXPECT_EQ(dmabuf->width, BUFFER_WIDTH);
+  EXPECT_EQ(dmabuf->height, BUFFER_HEIGHT);
+  EXPECT_EQ(dmabuf->fence_fd, -1);
+
+  dmabuf->fourcc = 0x3231564e;  // DRM_FORMAT_NV12
+  dmabuf->n_planes = 2;
+  dmabuf->fence_fd = self->fence_fds[0];
+  self->fence_fds[0] = -1;
+
+  return TRUE;
+}
+
+static void fl_test_dmabuf_texture_dispose(GObject* object) {
+  FlTestDmabufTexture* self = FL_TEST_DMABUF_TEXTURE(object);
+
+  for (int i = 0; i < 2; i++) {
+    if (self->fence_fds[i] >= 0) {
+      close(self->fence_fds[i]);
+      self->fence_fds[i] = -1;
+    }
+  }
+
+  G_OBJECT_CLASS(fl_test_dmabuf_texture_parent_class)->dispose(object);
+}
+
+static void fl_test_dmabuf_texture_class_init(
+    FlTestDmabufTextureClass* klass) {
+  G_OBJECT_CLASS(klass)->dispose = fl_test_dmabuf_texture_dispose;
+  FL_DMABUF_TEXTURE_CLASS(klass)->get_dmabuf =
+      fl_test_dmabuf_texture_get_dmabuf;
+}
+
+static void fl_test_dmabuf_texture_init(FlTestDmabufTexture* self) {
+  EXPECT_EQ(pipe(self->fence_fds), 0);
+}
+
+static FlTestDmabufTexture* fl_test_dmabuf_texture_new() {
+  return FL_TEST_DMABUF_TEXTURE(
+      g_object_new(fl_test_dmabuf_texture_get_type(), nullptr));
+}
+
+// Test that getting the texture ID works.
+TEST(FlDmabufTextureTest, TextureID) {
+  g_autoptr(FlTexture) texture = FL_TEXTURE(fl_test_dmabuf_texture_new());
+  EXPECT_EQ(fl_texture_get_texture_id(texture),
+            reinterpret_cast<int64_t>(texture));
+}
+
+// Test that populating fails cleanly when the context cannot import DMA-BUFs.
+TEST(FlDmabufTextureTest, PopulateRequiresEGL) {
+  g_autoptr(FlTestDmabufTexture) texture = fl_test_dmabuf_texture_new();
+  int fence_fd = texture->fence_fds[0];
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_FALSE(fl_dmabuf_texture_populate(FL_DMABUF_TEXTURE(texture),
+                                          BUFFER_WIDTH, BUFFER_HEIGHT,
+                                          &opengl_texture, &error));
+  EXPECT_TRUE(g_error_matches(error, FL_DMABUF_TEXTURE_ERROR,
+                              FL_DMABUF_TEXTURE_ERROR_NOT_SUPPORTED));
+  EXPECT_EQ(opengl_texture.destruction_callback, nullptr);
+
+  // Ownership of the fence was taken even though the import failed.
+  EXPECT_EQ(fcntl(fence_fd, F_GETFD), -1);
+}
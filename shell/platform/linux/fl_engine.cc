@@ -11,6 +11,7 @@
 #include "flutter/shell/platform/embedder/embedder.h"
 #include "flutter/shell/platform/linux/fl_binary_messenger_private.h"
 #include "flutter/shell/platform/linux/fl_dart_project_private.h"
+#include "flutter/shell/platform/linux/fl_dmabuf_texture_private.h"
 #include "flutter/shell/platform/linux/fl_engine_private.h"
 #include "flutter/shell/platform/linux/fl_pixel_buffer_texture_private.h"
 #include "flutter/shell/platform/linux/fl_plugin_registrar_private.h"
@@ -24,6 +25,9 @@
 // Unique number associated with platform tasks.
 static constexpr size_t kPlatformTaskRunnerIdentifier = 1;
 
+// Refresh interval assumed while there is no frame clock to follow.
+static constexpr gint64 kFallbackRefreshInterval = G_USEC_PER_SEC / 60;
+
 struct _FlEngine {
   GObject parent_instance;
 
@@ -54,6 +58,16 @@ struct _FlEngine {
   FlEngineOnPreEngineRestartHandler on_pre_engine_restart_handler;
   gpointer on_pre_engine_restart_handler_data;
   GDestroyNotify on_pre_engine_restart_handler_destroy_notify;
+
+  // Frame clock of the view that vsyncs are delivered from.
+  GdkFrameClock* frame_clock;
+  gulong frame_clock_update_handler;
+
+  // Baton of the engine waiting for the next vsync, or 0.
+  intptr_t vsync_baton;
+
+  // Timer delivering vsyncs while the view has no frame clock.
+  guint vsync_fallback_source;
 };
 
 G_DEFINE_QUARK(fl_engine_error_quark, fl_engine_error)
@@ -248,6 +262,9 @@ static bool fl_engine_gl_external_texture_frame_callback(
     result =
         fl_pixel_buffer_texture_populate(FL_PIXEL_BUFFER_TEXTURE(texture),
                                          width, height, opengl_texture, &error);
+  } else if (FL_IS_DMABUF_TEXTURE(texture)) {
+    result = fl_dmabuf_texture_populate(FL_DMABUF_TEXTURE(texture), width,
+                                        height, opengl_texture, &error);
   } else {
     g_warning("Unsupported texture type %" G_GINT64_FORMAT, texture_id);
     return false;
@@ -276,6 +293,129 @@ static void fl_engine_post_task(FlutterTask task,
   fl_task_runner_post_task(self->task_runner, task, target_time_nanos);
 }
 
+// Delivers the pending vsync for a frame that started at [start_time] and will
+// be displayed at [target_time], both in microseconds of the monotonic clock
+// the engine uses.
+static void fl_engine_deliver_vsync(FlEngine* self,
+                                    gint64 start_time,
+                                    gint64 target_time) {
+  intptr_t baton = self->vsync_baton;
+  self->vsync_baton = 0;
+  if (baton == 0 || self->engine == nullptr) {
+    return;
+  }
+
+  if (self->embedder_api.OnVsync(self->engine, baton, start_time * 1000,
+                                 target_time * 1000) != kSuccess) {
+    g_warning("Failed to deliver vsync to Flutter engine");
+  }
+}
+
+// Called when the frame clock of the view starts a frame.
+static void frame_clock_update_cb(GdkFrameClock* frame_clock,
+                                  gpointer user_data) {
+  FlEngine* self = FL_ENGINE(user_data);
+
+  gint64 frame_time = gdk_frame_clock_get_frame_time(frame_clock);
+  gint64 refresh_interval = 0;
+  gint64 presentation_time = 0;
+  gdk_frame_clock_get_refresh_info(frame_clock, frame_time, &refresh_interval,
+                                   &presentation_time);
+  // The presentation time is only known once the compositor reported the
+  // timings of previous frames.
+  if (presentation_time <= frame_time) {
+    presentation_time = frame_time + refresh_interval;
+  }
+  fl_engine_deliver_vsync(self, frame_time, presentation_time);
+}
+
+static gboolean vsync_fallback_cb(gpointer user_data) {
+  FlEngine* self = FL_ENGINE(user_data);
+  self->vsync_fallback_source = 0;
+
+  gint64 now = g_get_monotonic_time();
+  fl_engine_deliver_vsync(self, now, now + kFallbackRefreshInterval);
+  return G_SOURCE_REMOVE;
+}
+
+// Stops following the frame clock of the view.
+static void fl_engine_clear_frame_clock(FlEngine* self) {
+  if (self->frame_clock != nullptr) {
+    g_signal_handler_disconnect(self->frame_clock,
+                                self->frame_clock_update_handler);
+    self->frame_clock_update_handler = 0;
+  }
+  g_clear_object(&self->frame_clock);
+}
+
+// Requests a vsync from the frame clock of the view, or from a timer if the
+// view is not realized or the engine runs headless.
+static void fl_engine_wait_for_vsync(FlEngine* self, intptr_t baton) {
+  // The engine may have been shut down since the request was made.
+  if (self->engine == nullptr) {
+    return;
+  }
+  self->vsync_baton = baton;
+
+  FlView* view = fl_renderer_get_view(self->renderer);
+  GdkFrameClock* frame_clock =
+      view != nullptr ? gtk_widget_get_frame_clock(GTK_WIDGET(view)) : nullptr;
+  if (frame_clock != self->frame_clock) {
+    fl_engine_clear_frame_clock(self);
+    if (frame_clock != nullptr) {
+      self->frame_clock = GDK_FRAME_CLOCK(g_object_ref(frame_clock));
+      self->frame_clock_update_handler = g_signal_connect(
+          frame_clock, "update", G_CALLBACK(frame_clock_update_cb), self);
+    }
+  }
+
+  if (frame_clock != nullptr) {
+    gdk_frame_clock_request_phase(frame_clock, GDK_FRAME_CLOCK_PHASE_UPDATE);
+    return;
+  }
+
+  if (self->vsync_fallback_source == 0) {
+    // Align with the ticks of a fixed refresh rate display.
+    gint64 now = g_get_monotonic_time();
+    gint64 delay = kFallbackRefreshInterval - now % kFallbackRefreshInterval;
+    self->vsync_fallback_source = g_timeout_add(
+        (delay + 999) / 1000, vsync_fallback_cb, self);
+  }
+}
+
+typedef struct {
+  GWeakRef engine;
+  intptr_t baton;
+} VsyncRequest;
+
+static gboolean vsync_request_cb(gpointer user_data) {
+  VsyncRequest* request = static_cast<VsyncRequest*>(user_data);
+  g_autoptr(FlEngine) self =
+      static_cast<FlEngine*>(g_weak_ref_get(&request->engine));
+  if (self != nullptr) {
+    fl_engine_wait_for_vsync(self, request->baton);
+  }
+  return G_SOURCE_REMOVE;
+}
+
+static void vsync_request_free(gpointer user_data) {
+  VsyncRequest* request = static_cast<VsyncRequest*>(user_data);
+  g_weak_ref_clear(&request->engine);
+  g_free(request);
+}
+
+// Called on the UI thread when the engine waits for the next vsync.
+static void fl_engine_vsync_cb(void* user_data, intptr_t baton) {
+  FlEngine* self = static_cast<FlEngine*>(user_data);
+
+  // The frame clock belongs to the GTK thread.
+  VsyncRequest* request = g_new0(VsyncRequest, 1);
+  g_weak_ref_init(&request->engine, self);
+  request->baton = baton;
+  g_idle_add_full(G_PRIORITY_HIGH, vsync_request_cb, request,
+                  vsync_request_free);
+}
+
 // Called when a platform message is received from the engine.
 static void fl_engine_platform_message_cb(const FlutterPlatformMessage* message,
                                           void* user_data) {
@@ -350,10 +490,19 @@ static void fl_engine_dispose(GObject* object) {
   FlEngine* self = FL_ENGINE(object);
 
   if (self->engine != nullptr) {
+    // All batons have to be returned before the engine is shut down.
+    gint64 now = g_get_monotonic_time();
+    fl_engine_deliver_vsync(self, now, now + kFallbackRefreshInterval);
     self->embedder_api.Shutdown(self->engine);
     self->engine = nullptr;
   }
 
+  fl_engine_clear_frame_clock(self);
+  if (self->vsync_fallback_source != 0) {
+    g_source_remove(self->vsync_fallback_source);
+    self->vsync_fallback_source = 0;
+  }
+
   if (self->aot_data != nullptr) {
     self->embedder_api.CollectAOTData(self->aot_data);
     self->aot_data = nullptr;
@@ -471,6 +620,7 @@ gboolean fl_engine_start(FlEngine* self, GError** error) {
   args.custom_task_runners = &custom_task_runners;
   args.shutdown_dart_vm_when_done = true;
   args.on_pre_engine_restart_callback = fl_engine_on_pre_engine_restart_cb;
+  args.vsync_callback = fl_engine_vsync_cb;
   args.dart_entrypoint_argc =
       dart_entrypoint_args != nullptr ? g_strv_length(dart_entrypoint_args) : 0;
   args.dart_entrypoint_argv =
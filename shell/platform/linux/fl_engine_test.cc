@@ -319,4 +319,43 @@ TEST(FlEngineTest, DartEntrypointArgs) {
   EXPECT_TRUE(called);
 }
 
+TEST(FlEngineTest, Vsync) {
+  g_autoptr(FlEngine) engine = make_mock_engine();
+  FlutterEngineProcTable* embedder_api = fl_engine_get_embedder_api(engine);
+
+  VsyncCallback vsync_callback = nullptr;
+  void* vsync_user_data = nullptr;
+  embedder_api->Initialize = MOCK_ENGINE_PROC(
+      Initialize, ([&vsync_callback, &vsync_user_data](
+                       size_t version, const FlutterRendererConfig* config,
+                       const FlutterProjectArgs* args, void* user_data,
+                       FLUTTER_API_SYMBOL(FlutterEngine) * engine_out) {
+        vsync_callback = args->vsync_callback;
+        vsync_user_data = user_data;
+        return kSuccess;
+      }));
+
+  bool called = false;
+  embedder_api->OnVsync = MOCK_ENGINE_PROC(
+      OnVsync,
+      ([&called](auto engine, intptr_t baton, uint64_t frame_start_time_nanos,
+                 uint64_t frame_target_time_nanos) {
+        called = true;
+        EXPECT_EQ(baton, 42);
+        EXPECT_GT(frame_target_time_nanos, frame_start_time_nanos);
+        return kSuccess;
+      }));
+
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_engine_start(engine, &error));
+  EXPECT_EQ(error, nullptr);
+  ASSERT_NE(vsync_callback, nullptr);
+
+  // Without a view the vsync is delivered from a timer.
+  vsync_callback(vsync_user_data, 42);
+  while (!called) {
+    g_main_context_iteration(nullptr, TRUE);
+  }
+}
+
 // NOLINTEND(clang-analyzer-core.StackAddressEscape)
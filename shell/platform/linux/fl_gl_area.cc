@@ -6,12 +6,24 @@
 
 #include <epoxy/gl.h>
 
+#ifdef GDK_WINDOWING_X11
+#include <epoxy/glx.h>
+#include <gdk/gdkx.h>
+#endif
+
 struct _FlGLArea {
   GtkWidget parent_instance;
 
   GdkGLContext* context;
 
   FlBackingStoreProvider* texture;
+
+  // TRUE if the texture was presented straight into the window of the area.
+  gboolean presented_directly;
+
+  // TRUE if the next draw can be skipped, since the texture was presented
+  // directly after it was queued.
+  gboolean skip_next_draw;
 };
 
 G_DEFINE_TYPE(FlGLArea, fl_gl_area, GTK_TYPE_WIDGET)
@@ -76,10 +88,75 @@ static void fl_gl_area_size_allocate(GtkWidget* widget,
   }
 }
 
+// Presents the texture straight into the native window of the area, instead of
+// having GTK copy it into the frame buffer of the toplevel window. This is only
+// possible when GDK renders with GLX, the GLX context of the renderer is bound
+// to the window of the area for the duration of the blit.
+static gboolean fl_gl_area_present_directly(FlGLArea* self) {
+#ifdef GDK_WINDOWING_X11
+  GdkWindow* window = gtk_widget_get_window(GTK_WIDGET(self));
+  if (self->texture == nullptr || window == nullptr ||
+      !GDK_IS_X11_WINDOW(window) || !gtk_widget_is_drawable(GTK_WIDGET(self))) {
+    return FALSE;
+  }
+
+  gdk_gl_context_make_current(self->context);
+  GLXContext glx_context = glXGetCurrentContext();
+  if (glx_context == nullptr || !gdk_window_ensure_native(window)) {
+    return FALSE;
+  }
+  Display* xdisplay = glXGetCurrentDisplay();
+  Window xid = gdk_x11_window_get_xid(window);
+  if (!glXMakeCurrent(xdisplay, xid, glx_context)) {
+    gdk_gl_context_clear_current();
+    gdk_gl_context_make_current(self->context);
+    return FALSE;
+  }
+
+  // The backing store and the window both have their origin at the bottom left.
+  gint scale = gtk_widget_get_scale_factor(GTK_WIDGET(self));
+  gint window_height = gdk_window_get_height(window) * scale;
+  GdkRectangle geometry = fl_backing_store_provider_get_geometry(self->texture);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER,
+                    fl_backing_store_provider_get_gl_framebuffer_id(
+                        self->texture));
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+  glClearColor(0, 0, 0, 0);
+  glClear(GL_COLOR_BUFFER_BIT);
+  glBlitFramebuffer(0, 0, geometry.width, geometry.height, geometry.x,
+                    window_height - geometry.y - geometry.height,
+                    geometry.x + geometry.width, window_height - geometry.y,
+                    GL_COLOR_BUFFER_BIT, GL_NEAREST);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  glXSwapBuffers(xdisplay, xid);
+
+  // GDK does not know the context was bound to another drawable, so it has to
+  // bind it again itself.
+  gdk_gl_context_clear_current();
+  gdk_gl_context_make_current(self->context);
+  return TRUE;
+#else
+  return FALSE;
+#endif
+}
+
 // Implements GtkWidget::draw.
 static gboolean fl_gl_area_draw(GtkWidget* widget, cairo_t* cr) {
   FlGLArea* self = FL_GL_AREA(widget);
 
+  if (self->presented_directly) {
+    // The frame that queued the texture already presented it, later draws are
+    // exposes of the window.
+    if (self->skip_next_draw) {
+      self->skip_next_draw = FALSE;
+      return TRUE;
+    }
+    if (fl_gl_area_present_directly(self)) {
+      return TRUE;
+    }
+    self->presented_directly = FALSE;
+  }
+
   gdk_gl_context_make_current(self->context);
 
   gint scale = gtk_widget_get_scale_factor(widget);
@@ -129,6 +206,19 @@ void fl_gl_area_queue_render(FlGLArea* self, FlBackingStoreProvider* texture) {
 
   g_clear_object(&self->texture);
   g_set_object(&self->texture, texture);
+  self->presented_directly = FALSE;
+  self->skip_next_draw = FALSE;
 
   gtk_widget_queue_draw(GTK_WIDGET(self));
 }
+
+gboolean fl_gl_area_present(FlGLArea* self) {
+  g_return_val_if_fail(FL_IS_GL_AREA(self), FALSE);
+
+  if (!fl_gl_area_present_directly(self)) {
+    return FALSE;
+  }
+  self->presented_directly = TRUE;
+  self->skip_next_draw = TRUE;
+  return TRUE;
+}
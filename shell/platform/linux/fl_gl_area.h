@@ -38,6 +38,19 @@ GtkWidget* fl_gl_area_new(GdkGLContext* context);
  */
 void fl_gl_area_queue_render(FlGLArea* area, FlBackingStoreProvider* texture);
 
+/**
+ * fl_gl_area_present:
+ * @area: an #FlGLArea.
+ *
+ * Presents the queued texture straight into the window of @area, without GTK
+ * compositing it into the toplevel window first. Later redraws of @area are
+ * presented the same way until another texture is queued. Only possible on
+ * X11 once @area is realized; otherwise the texture is drawn by GTK.
+ *
+ * Returns: %TRUE if the texture was presented.
+ */
+gboolean fl_gl_area_present(FlGLArea* area);
+
 G_END_DECLS
 
 #endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_GL_AREA_H_
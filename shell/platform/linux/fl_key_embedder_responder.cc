@@ -301,18 +301,18 @@ static uint64_t apply_id_plane(uint64_t logical_id, uint64_t plane) {
 }
 
 static uint64_t event_to_physical_key(const FlKeyEvent* event) {
-  auto found = xkb_to_physical_key_map.find(event->keycode);
-  if (found != xkb_to_physical_key_map.end()) {
-    return found->second;
+  uint64_t physical_key;
+  if (xkb_to_physical_key_map.Find(event->keycode, &physical_key)) {
+    return physical_key;
   }
   return apply_id_plane(event->keycode, kGtkPlane);
 }
 
 static uint64_t event_to_logical_key(const FlKeyEvent* event) {
   guint keyval = event->keyval;
-  auto found = gtk_keyval_to_logical_key_map.find(keyval);
-  if (found != gtk_keyval_to_logical_key_map.end()) {
-    return found->second;
+  uint64_t logical_key;
+  if (gtk_keyval_to_logical_key_map.Find(keyval, &logical_key)) {
+    return logical_key;
   }
   // EASCII range
   if (keyval < 256) {
@@ -326,19 +326,15 @@ static uint64_t event_to_timestamp(const FlKeyEvent* event) {
   return kMicrosecondsPerMillisecond * static_cast<double>(event->time);
 }
 
-// Returns a newly accocated UTF-8 string from event->keyval that must be
-// freed later with g_free().
-static char* event_to_character(const FlKeyEvent* event) {
-  gunichar unicodeChar = gdk_keyval_to_unicode(event->keyval);
-  glong items_written;
-  gchar* result = g_ucs4_to_utf8(&unicodeChar, 1, NULL, &items_written, NULL);
-  if (items_written == 0) {
-    if (result != NULL) {
-      g_free(result);
-    }
+// Writes the UTF-8 string of event->keyval into |buffer|, which must hold at
+// least 7 bytes. Returns |buffer|, or nullptr if the keyval has no character.
+static const char* event_to_character(const FlKeyEvent* event, char* buffer) {
+  gunichar unicode_char = gdk_keyval_to_unicode(event->keyval);
+  if (unicode_char == 0) {
     return nullptr;
   }
-  return result;
+  buffer[g_unichar_to_utf8(unicode_char, buffer)] = '\0';
+  return buffer;
 }
 
 // Handles a response from the embedder API to a key event sent to the framework
@@ -748,7 +744,8 @@ static void fl_key_embedder_responder_handle_event_impl(
   out_event.character = nullptr;
   out_event.synthesized = false;
 
-  g_autofree char* character_to_free = nullptr;
+  // Large enough for any character encoded by g_unichar_to_utf8.
+  char character[7];
   if (is_down_event) {
     if (last_logical_record) {
       // A key has been pressed that has the exact physical key as a currently
@@ -759,8 +756,7 @@ static void fl_key_embedder_responder_handle_event_impl(
       return;
     } else {
       out_event.type = kFlutterKeyEventTypeDown;
-      character_to_free = event_to_character(event);  // Might be null
-      out_event.character = character_to_free;
+      out_event.character = event_to_character(event, character);
     }
   } else {  // is_down_event false
     if (!last_logical_record) {
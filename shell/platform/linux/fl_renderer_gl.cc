@@ -100,15 +100,19 @@ static gboolean fl_renderer_gl_present_layers(FlRenderer* renderer,
   }
   fl_view_begin_frame(view);
 
+  FlGLArea* single_area = nullptr;
   for (size_t i = 0; i < layers_count; ++i) {
     const FlutterLayer* layer = layers[i];
     switch (layer->type) {
       case kFlutterLayerContentTypeBackingStore: {
         const FlutterBackingStore* backing_store = layer->backing_store;
         auto framebuffer = &backing_store->open_gl.framebuffer;
-        fl_view_add_gl_area(
+        FlGLArea* area = fl_view_add_gl_area(
             view, context,
             reinterpret_cast<FlBackingStoreProvider*>(framebuffer->user_data));
+        if (layers_count == 1) {
+          single_area = area;
+        }
       } break;
       case kFlutterLayerContentTypePlatformView: {
         // Currently unsupported.
@@ -117,6 +121,12 @@ static gboolean fl_renderer_gl_present_layers(FlRenderer* renderer,
   }
 
   fl_view_end_frame(view);
+
+  // A frame without platform views has nothing for GTK to composite, so it is
+  // presented straight away rather than copied by GTK on its next frame.
+  if (single_area != nullptr) {
+    fl_gl_area_present(single_area);
+  }
   return TRUE;
 }
 
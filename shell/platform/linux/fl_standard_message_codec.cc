@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_standard_message_codec.h"
 #include "flutter/shell/platform/linux/fl_standard_message_codec_private.h"
+#include "flutter/shell/platform/linux/fl_value_private.h"
 
 #include <gmodule.h>
 
@@ -28,6 +29,10 @@ static constexpr int kValueList = 12;
 static constexpr int kValueMap = 13;
 static constexpr int kValueFloat32List = 14;
 
+// Typed lists of at least this many bytes reference the message they were
+// decoded from instead of being copied out of it.
+static constexpr size_t kMinTypedListViewSize = 256;
+
 struct _FlStandardMessageCodec {
   FlMessageCodec parent_instance;
 };
@@ -243,7 +248,10 @@ static FlValue* read_uint8_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(uint8_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_uint8_list(get_data(buffer, offset), length);
+  FlValue* value =
+      length >= kMinTypedListViewSize
+          ? fl_value_new_uint8_list_view(buffer, *offset, length)
+          : fl_value_new_uint8_list(get_data(buffer, offset), length);
   *offset += length;
   return value;
 }
@@ -338,8 +346,12 @@ static FlValue* read_float64_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(double) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_float_list(
-      reinterpret_cast<const double*>(get_data(buffer, offset)), length);
+  FlValue* value =
+      sizeof(double) * length >= kMinTypedListViewSize
+          ? fl_value_new_float_list_view(buffer, *offset, length)
+          : fl_value_new_float_list(
+                reinterpret_cast<const double*>(get_data(buffer, offset)),
+                length);
   *offset += sizeof(double) * length;
   return value;
 }
@@ -357,14 +369,16 @@ static FlValue* read_list_value(FlStandardMessageCodec* self,
     return nullptr;
   }
 
-  g_autoptr(FlValue) list = fl_value_new_list();
+  // The length is only trusted as far as the remaining data could hold it.
+  g_autoptr(FlValue) list = fl_value_new_list_sized(
+      MIN(length, g_bytes_get_size(buffer) - *offset));
   for (size_t i = 0; i < length; i++) {
-    g_autoptr(FlValue) child =
+    FlValue* child =
         fl_standard_message_codec_read_value(self, buffer, offset, error);
     if (child == nullptr) {
       return nullptr;
     }
-    fl_value_append(list, child);
+    fl_value_append_take(list, child);
   }
 
   return fl_value_ref(list);
@@ -383,24 +397,114 @@ static FlValue* read_map_value(FlStandardMessageCodec* self,
     return nullptr;
   }
 
-  g_autoptr(FlValue) map = fl_value_new_map();
+  // Each entry takes at least two bytes.
+  g_autoptr(FlValue) map = fl_value_new_map_sized(
+      MIN(length, (g_bytes_get_size(buffer) - *offset) / 2));
   for (size_t i = 0; i < length; i++) {
     g_autoptr(FlValue) key =
         fl_standard_message_codec_read_value(self, buffer, offset, error);
     if (key == nullptr) {
       return nullptr;
     }
-    g_autoptr(FlValue) value =
+    FlValue* value =
         fl_standard_message_codec_read_value(self, buffer, offset, error);
     if (value == nullptr) {
       return nullptr;
     }
-    fl_value_set(map, key, value);
+    // Maps encoded by Dart have unique keys, so they are not looked up.
+    fl_value_map_append_take(map, static_cast<FlValue*>(g_steal_pointer(&key)),
+                             value);
   }
 
   return fl_value_ref(map);
 }
 
+// Returns the number of bytes a size field takes.
+static size_t get_size_size(size_t size) {
+  if (size < 254) {
+    return sizeof(uint8_t);
+  } else if (size <= 0xffff) {
+    return sizeof(uint8_t) + sizeof(uint16_t);
+  } else {
+    return sizeof(uint8_t) + sizeof(uint32_t);
+  }
+}
+
+// Returns @offset rounded up to a multiple of @align.
+static size_t align_offset(size_t offset, size_t align) {
+  return (offset + align - 1) / align * align;
+}
+
+// Returns the offset after @value is written at @offset, for sizing the
+// buffer before writing. Unsupported types are left for the write to reject.
+static size_t get_encoded_end(FlValue* value, size_t offset) {
+  // Type byte.
+  offset += sizeof(uint8_t);
+  if (value == nullptr) {
+    return offset;
+  }
+
+  switch (fl_value_get_type(value)) {
+    case FL_VALUE_TYPE_NULL:
+    case FL_VALUE_TYPE_BOOL:
+      return offset;
+    case FL_VALUE_TYPE_INT: {
+      int64_t v = fl_value_get_int(value);
+      return offset + (v >= INT32_MIN && v <= INT32_MAX ? sizeof(int32_t)
+                                                        : sizeof(int64_t));
+    }
+    case FL_VALUE_TYPE_FLOAT:
+      return align_offset(offset, 8) + sizeof(double);
+    case FL_VALUE_TYPE_STRING: {
+      size_t length = strlen(fl_value_get_string(value));
+      return offset + get_size_size(length) + length;
+    }
+    case FL_VALUE_TYPE_UINT8_LIST: {
+      size_t length = fl_value_get_length(value);
+      return offset + get_size_size(length) + sizeof(uint8_t) * length;
+    }
+    case FL_VALUE_TYPE_INT32_LIST: {
+      size_t length = fl_value_get_length(value);
+      return align_offset(offset + get_size_size(length), 4) +
+             sizeof(int32_t) * length;
+    }
+    case FL_VALUE_TYPE_INT64_LIST: {
+      size_t length = fl_value_get_length(value);
+      return align_offset(offset + get_size_size(length), 8) +
+             sizeof(int64_t) * length;
+    }
+    case FL_VALUE_TYPE_FLOAT32_LIST: {
+      size_t length = fl_value_get_length(value);
+      return align_offset(offset + get_size_size(length), 4) +
+             sizeof(float) * length;
+    }
+    case FL_VALUE_TYPE_FLOAT_LIST: {
+      size_t length = fl_value_get_length(value);
+      return align_offset(offset + get_size_size(length), 8) +
+             sizeof(double) * length;
+    }
+    case FL_VALUE_TYPE_LIST: {
+      size_t length = fl_value_get_length(value);
+      offset += get_size_size(length);
+      for (size_t i = 0; i < length; i++) {
+        offset = get_encoded_end(fl_value_get_list_value(value, i), offset);
+      }
+      return offset;
+    }
+    case FL_VALUE_TYPE_MAP: {
+      size_t length = fl_value_get_length(value);
+      offset += get_size_size(length);
+      for (size_t i = 0; i < length; i++) {
+        offset = get_encoded_end(fl_value_get_map_key(value, i), offset);
+        offset = get_encoded_end(fl_value_get_map_value(value, i), offset);
+      }
+      return offset;
+    }
+  }
+
+  return offset;
+}
+
 // Implements FlMessageCodec::encode_message.
 static GBytes* fl_standard_message_codec_encode_message(FlMessageCodec* codec,
                                                         FlValue* message,
@@ -408,7 +512,9 @@ static GBytes* fl_standard_message_codec_encode_message(FlMessageCodec* codec,
   FlStandardMessageCodec* self =
       reinterpret_cast<FlStandardMessageCodec*>(codec);
 
-  g_autoptr(GByteArray) buffer = g_byte_array_new();
+  // The message is measured first so it is written without reallocating.
+  g_autoptr(GByteArray) buffer =
+      g_byte_array_sized_new(get_encoded_end(message, 0));
   if (!fl_standard_message_codec_write_value(self, buffer, message, error)) {
     return nullptr;
   }
@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_standard_message_codec.h"
+
+#include "flutter/benchmarking/benchmarking.h"
+
+// Builds a map of [size] entries like the ones plugins send.
+static FlValue* make_map(int64_t size) {
+  FlValue* value = fl_value_new_map();
+  for (int64_t i = 0; i < size; i++) {
+    g_autofree gchar* key = g_strdup_printf("key%" G_GINT64_FORMAT, i);
+    fl_value_set_string_take(value, key, fl_value_new_int(i));
+  }
+  return value;
+}
+
+// Builds a list of [size] mixed values.
+static FlValue* make_list(int64_t size) {
+  FlValue* value = fl_value_new_list();
+  for (int64_t i = 0; i < size; i++) {
+    fl_value_append_take(value, i % 2 == 0 ? fl_value_new_int(i)
+                                           : fl_value_new_string("value"));
+  }
+  return value;
+}
+
+static FlValue* make_uint8_list(int64_t size) {
+  g_autofree uint8_t* data = static_cast<uint8_t*>(g_malloc0(size));
+  return fl_value_new_uint8_list(data, size);
+}
+
+static FlValue* make_float_list(int64_t size) {
+  g_autofree double* data = g_new0(double, size);
+  return fl_value_new_float_list(data, size);
+}
+
+static void encode(benchmark::State& state, FlValue* value) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  while (state.KeepRunning()) {
+    g_autoptr(GBytes) message =
+        fl_message_codec_encode_message(FL_MESSAGE_CODEC(codec), value, nullptr);
+    benchmark::DoNotOptimize(message);
+  }
+}
+
+static void decode(benchmark::State& state, FlValue* value) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(GBytes) message =
+      fl_message_codec_encode_message(FL_MESSAGE_CODEC(codec), value, nullptr);
+  while (state.KeepRunning()) {
+    g_autoptr(FlValue) decoded = fl_message_codec_decode_message(
+        FL_MESSAGE_CODEC(codec), message, nullptr);
+    benchmark::DoNotOptimize(decoded);
+  }
+  state.SetBytesProcessed(state.iterations() * g_bytes_get_size(message));
+}
+
+static void BM_EncodeMap(benchmark::State& state) {  // NOLINT
+  g_autoptr(FlValue) value = make_map(state.range(0));
+  encode(state, value);
+}
+
+static void BM_DecodeMap(benchmark::State& state) {  // NOLINT
+  g_autoptr(FlValue) value = make_map(state.range(0));
+  decode(state, value);
+}
+
+static void BM_EncodeList(benchmark::State& state) {  // NOLINT
+  g_autoptr(FlValue) value = make_list(state.range(0));
+  encode(state, value);
+}
+
+static void BM_DecodeList(benchmark::State& state) {  // NOLINT
+  g_autoptr(FlValue) value = make_list(state.range(0));
+  decode(state, value);
+}
+
+static void BM_EncodeUint8List(benchmark::State& state) {  // NOLINT
+  g_autoptr(FlValue) value = make_uint8_list(state.range(0));
+  encode(state, value);
+}
+
+static void BM_DecodeUint8List(benchmark::State& state) {  // NOLINT
+  g_autoptr(FlValue) value = make_uint8_list(state.range(0));
+  decode(state, value);
+}
+
+static void BM_EncodeFloatList(benchmark::State& state) {  // NOLINT
+  g_autoptr(FlValue) value = make_float_list(state.range(0));
+  encode(state, value);
+}
+
+static void BM_DecodeFloatList(benchmark::State& state) {  // NOLINT
+  g_autoptr(FlValue) value = make_float_list(state.range(0));
+  decode(state, value);
+}
+
+BENCHMARK(BM_EncodeMap)->Range(16, 4096);
+BENCHMARK(BM_DecodeMap)->Range(16, 4096);
+BENCHMARK(BM_EncodeList)->Range(16, 4096);
+BENCHMARK(BM_DecodeList)->Range(16, 4096);
+BENCHMARK(BM_EncodeUint8List)->Range(1024, 1 << 20);
+BENCHMARK(BM_DecodeUint8List)->Range(1024, 1 << 20);
+BENCHMARK(BM_EncodeFloatList)->Range(128, 1 << 17);
+BENCHMARK(BM_DecodeFloatList)->Range(128, 1 << 17);
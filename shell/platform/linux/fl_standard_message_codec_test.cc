@@ -416,6 +416,30 @@ TEST(FlStandardMessageCodecTest, DecodeUint8ListShortData2) {
                      FL_MESSAGE_CODEC_ERROR_OUT_OF_DATA);
 }
 
+TEST(FlStandardMessageCodecTest, EncodeDecodeLargeUint8List) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+
+  uint8_t data[1024];
+  for (size_t i = 0; i < G_N_ELEMENTS(data); i++) {
+    data[i] = i;
+  }
+  g_autoptr(FlValue) value = fl_value_new_uint8_list(data, G_N_ELEMENTS(data));
+
+  g_autoptr(GError) error = nullptr;
+  GBytes* message =
+      fl_message_codec_encode_message(FL_MESSAGE_CODEC(codec), value, &error);
+  EXPECT_NE(message, nullptr);
+  EXPECT_EQ(error, nullptr);
+
+  g_autoptr(FlValue) decoded_value =
+      fl_message_codec_decode_message(FL_MESSAGE_CODEC(codec), message, &error);
+  EXPECT_EQ(error, nullptr);
+
+  // The decoded list stays valid after the message is released.
+  g_bytes_unref(message);
+  ASSERT_TRUE(fl_value_equal(value, decoded_value));
+}
+
 TEST(FlStandardMessageCodecTest, EncodeInt32ListEmpty) {
   g_autoptr(FlValue) value = fl_value_new_int32_list(nullptr, 0);
   g_autofree gchar* hex_string = encode_message(value);
@@ -636,6 +660,30 @@ TEST(FlStandardMessageCodecTest, DecodeFloatListShortData2) {
       FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_OUT_OF_DATA);
 }
 
+TEST(FlStandardMessageCodecTest, EncodeDecodeLargeFloatList) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+
+  double data[1024];
+  for (size_t i = 0; i < G_N_ELEMENTS(data); i++) {
+    data[i] = i * 0.5;
+  }
+  g_autoptr(FlValue) value = fl_value_new_float_list(data, G_N_ELEMENTS(data));
+
+  g_autoptr(GError) error = nullptr;
+  GBytes* message =
+      fl_message_codec_encode_message(FL_MESSAGE_CODEC(codec), value, &error);
+  EXPECT_NE(message, nullptr);
+  EXPECT_EQ(error, nullptr);
+
+  g_autoptr(FlValue) decoded_value =
+      fl_message_codec_decode_message(FL_MESSAGE_CODEC(codec), message, &error);
+  EXPECT_EQ(error, nullptr);
+
+  // The decoded list stays valid after the message is released.
+  g_bytes_unref(message);
+  ASSERT_TRUE(fl_value_equal(value, decoded_value));
+}
+
 TEST(FlStandardMessageCodecTest, EncodeListEmpty) {
   g_autoptr(FlValue) value = fl_value_new_list();
   g_autofree gchar* hex_string = encode_message(value);
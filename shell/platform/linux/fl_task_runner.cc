@@ -6,7 +6,6 @@
 #include "flutter/shell/platform/linux/fl_engine_private.h"
 
 static constexpr int kMicrosecondsPerNanosecond = 1000;
-static constexpr int kMillisecondsPerMicrosecond = 1000;
 
 struct _FlTaskRunner {
   GObject parent_instance;
@@ -16,58 +15,134 @@ struct _FlTaskRunner {
   GMutex mutex;
   GCond cond;
 
-  guint timeout_source_id;
-  GList /*<FlTaskRunnerTask>*/* pending_tasks;
+  // Source dispatching expired tasks on the main loop. Its ready time is the
+  // time of the earliest pending task.
+  GSource* source;
+
+  // Binary min-heap of pending tasks, ordered by time and then by the order
+  // they were posted in.
+  GPtrArray /*<FlTaskRunnerTask>*/* pending_tasks;
+  guint64 next_sequence_number;
+
   gboolean blocking_main_thread;
 };
 
 typedef struct _FlTaskRunnerTask {
   // absolute time of task (based on g_get_monotonic_time)
   gint64 task_time_micros;
+  // order the task was posted in, to run tasks with equal times in order
+  guint64 sequence_number;
   FlutterTask task;
 } FlTaskRunnerTask;
 
 G_DEFINE_TYPE(FlTaskRunner, fl_task_runner, G_TYPE_OBJECT)
 
+static gboolean task_is_before(FlTaskRunnerTask* a, FlTaskRunnerTask* b) {
+  return a->task_time_micros < b->task_time_micros ||
+         (a->task_time_micros == b->task_time_micros &&
+          a->sequence_number < b->sequence_number);
+}
+
+static FlTaskRunnerTask* heap_get(GPtrArray* heap, guint index) {
+  return static_cast<FlTaskRunnerTask*>(g_ptr_array_index(heap, index));
+}
+
+static void heap_swap(GPtrArray* heap, guint a, guint b) {
+  gpointer tmp = heap->pdata[a];
+  heap->pdata[a] = heap->pdata[b];
+  heap->pdata[b] = tmp;
+}
+
+static void heap_push(GPtrArray* heap, FlTaskRunnerTask* task) {
+  g_ptr_array_add(heap, task);
+  guint index = heap->len - 1;
+  while (index > 0) {
+    guint parent = (index - 1) / 2;
+    if (!task_is_before(heap_get(heap, index), heap_get(heap, parent))) {
+      break;
+    }
+    heap_swap(heap, index, parent);
+    index = parent;
+  }
+}
+
+static FlTaskRunnerTask* heap_pop(GPtrArray* heap) {
+  FlTaskRunnerTask* top = heap_get(heap, 0);
+  heap_swap(heap, 0, heap->len - 1);
+  g_ptr_array_set_size(heap, heap->len - 1);
+  guint index = 0;
+  while (true) {
+    guint smallest = index;
+    for (guint child = 2 * index + 1; child <= 2 * index + 2; child++) {
+      if (child < heap->len &&
+          task_is_before(heap_get(heap, child), heap_get(heap, smallest))) {
+        smallest = child;
+      }
+    }
+    if (smallest == index) {
+      break;
+    }
+    heap_swap(heap, index, smallest);
+    index = smallest;
+  }
+  return top;
+}
+
+// Returns the absolute time of next expired task (in microseconds, based on
+// g_get_monotonic_time). If no task is scheduled returns G_MAXINT64.
+static gint64 fl_task_runner_next_task_expiration_time_locked(
+    FlTaskRunner* self) {
+  return self->pending_tasks->len > 0
+             ? heap_get(self->pending_tasks, 0)->task_time_micros
+             : G_MAXINT64;
+}
+
 // Removes expired tasks from the task queue and executes them.
 // The execution is performed with mutex unlocked.
 static void fl_task_runner_process_expired_tasks_locked(FlTaskRunner* self) {
-  GList* expired_tasks = nullptr;
-
   gint64 current_time = g_get_monotonic_time();
 
-  GList* l = self->pending_tasks;
-  while (l != nullptr) {
-    FlTaskRunnerTask* task = static_cast<FlTaskRunnerTask*>(l->data);
-    if (task->task_time_micros <= current_time) {
-      GList* link = l;
-      l = l->next;
-      self->pending_tasks = g_list_remove_link(self->pending_tasks, link);
-      expired_tasks = g_list_concat(expired_tasks, link);
-    } else {
-      l = l->next;
-    }
+  g_autoptr(GPtrArray) expired_tasks = g_ptr_array_new_with_free_func(g_free);
+  while (fl_task_runner_next_task_expiration_time_locked(self) <=
+         current_time) {
+    g_ptr_array_add(expired_tasks, heap_pop(self->pending_tasks));
   }
 
   g_mutex_unlock(&self->mutex);
 
-  l = expired_tasks;
-  while (l != nullptr && self->engine) {
-    FlTaskRunnerTask* task = static_cast<FlTaskRunnerTask*>(l->data);
+  for (guint i = 0; i < expired_tasks->len && self->engine; i++) {
+    FlTaskRunnerTask* task =
+        static_cast<FlTaskRunnerTask*>(g_ptr_array_index(expired_tasks, i));
     fl_engine_execute_task(self->engine, &task->task);
-    l = l->next;
   }
 
-  g_list_free_full(expired_tasks, g_free);
-
   g_mutex_lock(&self->mutex);
 }
 
-static void fl_task_runner_tasks_did_change_locked(FlTaskRunner* self);
+// Arms the source for the earliest pending task.
+static void fl_task_runner_update_ready_time_locked(FlTaskRunner* self) {
+  gint64 min_time = fl_task_runner_next_task_expiration_time_locked(self);
+  g_source_set_ready_time(self->source, min_time == G_MAXINT64 ? -1 : min_time);
+}
+
+// Dispatches all tasks that expired by the time the main loop woke up.
+static gboolean fl_task_runner_source_dispatch(GSource* source,
+                                               GSourceFunc callback,
+                                               gpointer user_data) {
+  g_source_set_ready_time(source, -1);
+  return callback(user_data);
+}
 
-// Invoked from a timeout source. Removes and executes expired tasks
-// and reschedules timeout if needed.
-static gboolean fl_task_runner_on_expired_timeout(gpointer data) {
+static GSourceFuncs fl_task_runner_source_funcs = {
+    nullptr,                         // prepare
+    nullptr,                         // check
+    fl_task_runner_source_dispatch,  // dispatch
+    nullptr,                         // finalize
+    nullptr,                         // closure_callback
+    nullptr,                         // closure_marshal
+};
+
+static gboolean fl_task_runner_on_ready(gpointer data) {
   FlTaskRunner* self = FL_TASK_RUNNER(data);
 
   g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->mutex);
@@ -75,49 +150,14 @@ static gboolean fl_task_runner_on_expired_timeout(gpointer data) {
 
   g_object_ref(self);
 
-  self->timeout_source_id = 0;
-  fl_task_runner_process_expired_tasks_locked(self);
-
-  // reschedule timeout
-  fl_task_runner_tasks_did_change_locked(self);
+  if (!self->blocking_main_thread) {
+    fl_task_runner_process_expired_tasks_locked(self);
+    fl_task_runner_update_ready_time_locked(self);
+  }
 
   g_object_unref(self);
 
-  return FALSE;
-}
-
-// Returns the absolute time of next expired task (in microseconds, based on
-// g_get_monotonic_time). If no task is scheduled returns G_MAXINT64.
-static gint64 fl_task_runner_next_task_expiration_time_locked(
-    FlTaskRunner* self) {
-  gint64 min_time = G_MAXINT64;
-  GList* l = self->pending_tasks;
-  while (l != nullptr) {
-    FlTaskRunnerTask* task = static_cast<FlTaskRunnerTask*>(l->data);
-    min_time = MIN(min_time, task->task_time_micros);
-    l = l->next;
-  }
-  return min_time;
-}
-
-static void fl_task_runner_tasks_did_change_locked(FlTaskRunner* self) {
-  if (self->blocking_main_thread) {
-    // Wake up blocked thread
-    g_cond_signal(&self->cond);
-  } else {
-    // Reschedule timeout
-    if (self->timeout_source_id != 0) {
-      g_source_remove(self->timeout_source_id);
-      self->timeout_source_id = 0;
-    }
-    gint64 min_time = fl_task_runner_next_task_expiration_time_locked(self);
-    if (min_time != G_MAXINT64) {
-      gint64 remaining = MAX(min_time - g_get_monotonic_time(), 0);
-      self->timeout_source_id =
-          g_timeout_add(remaining / kMillisecondsPerMicrosecond + 1,
-                        fl_task_runner_on_expired_timeout, self);
-    }
-  }
+  return G_SOURCE_CONTINUE;
 }
 
 static void engine_weak_notify_cb(gpointer user_data,
@@ -141,9 +181,10 @@ void fl_task_runner_dispose(GObject* object) {
   g_mutex_clear(&self->mutex);
   g_cond_clear(&self->cond);
 
-  g_list_free_full(self->pending_tasks, g_free);
-  if (self->timeout_source_id != 0) {
-    g_source_remove(self->timeout_source_id);
+  g_clear_pointer(&self->pending_tasks, g_ptr_array_unref);
+  if (self->source != nullptr) {
+    g_source_destroy(self->source);
+    g_clear_pointer(&self->source, g_source_unref);
   }
 
   G_OBJECT_CLASS(fl_task_runner_parent_class)->dispose(object);
@@ -156,6 +197,13 @@ static void fl_task_runner_class_init(FlTaskRunnerClass* klass) {
 static void fl_task_runner_init(FlTaskRunner* self) {
   g_mutex_init(&self->mutex);
   g_cond_init(&self->cond);
+  self->pending_tasks = g_ptr_array_new_with_free_func(g_free);
+
+  self->source =
+      g_source_new(&fl_task_runner_source_funcs, sizeof(GSource));
+  g_source_set_name(self->source, "FlTaskRunner");
+  g_source_set_callback(self->source, fl_task_runner_on_ready, self, nullptr);
+  g_source_attach(self->source, nullptr);
 }
 
 FlTaskRunner* fl_task_runner_new(FlEngine* engine) {
@@ -176,9 +224,19 @@ void fl_task_runner_post_task(FlTaskRunner* self,
   runner_task->task = task;
   runner_task->task_time_micros =
       target_time_nanos / kMicrosecondsPerNanosecond;
+  runner_task->sequence_number = self->next_sequence_number++;
 
-  self->pending_tasks = g_list_append(self->pending_tasks, runner_task);
-  fl_task_runner_tasks_did_change_locked(self);
+  heap_push(self->pending_tasks, runner_task);
+
+  // Only a new earliest task changes when the main thread has to wake up.
+  if (heap_get(self->pending_tasks, 0) != runner_task) {
+    return;
+  }
+  if (self->blocking_main_thread) {
+    g_cond_signal(&self->cond);
+  } else {
+    fl_task_runner_update_ready_time_locked(self);
+  }
 }
 
 void fl_task_runner_block_main_thread(FlTaskRunner* self) {
@@ -189,15 +247,20 @@ void fl_task_runner_block_main_thread(FlTaskRunner* self) {
 
   g_object_ref(self);
 
+  // The main thread sleeps until a task is due or the main thread is released,
+  // the source is not dispatched while the main loop is not running.
   self->blocking_main_thread = true;
   while (self->blocking_main_thread) {
-    g_cond_wait_until(&self->cond, &self->mutex,
-                      fl_task_runner_next_task_expiration_time_locked(self));
+    gint64 next_time = fl_task_runner_next_task_expiration_time_locked(self);
+    if (next_time > g_get_monotonic_time()) {
+      g_cond_wait_until(&self->cond, &self->mutex, next_time);
+      continue;
+    }
     fl_task_runner_process_expired_tasks_locked(self);
   }
 
-  // Tasks might have changed in the meanwhile, reschedule timeout
-  fl_task_runner_tasks_did_change_locked(self);
+  // Tasks might have changed in the meanwhile, reschedule the source.
+  fl_task_runner_update_ready_time_locked(self);
 
   g_object_unref(self);
 }
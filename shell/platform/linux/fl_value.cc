@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_value.h"
+#include "flutter/shell/platform/linux/fl_value_private.h"
 
 #include <gmodule.h>
 
@@ -37,6 +38,8 @@ typedef struct {
   FlValue parent;
   uint8_t* values;
   size_t values_length;
+  // Buffer @values points into, or %NULL if @values is owned.
+  GBytes* bytes;
 } FlValueUint8List;
 
 typedef struct {
@@ -61,6 +64,8 @@ typedef struct {
   FlValue parent;
   double* values;
   size_t values_length;
+  // Buffer @values points into, or %NULL if @values is owned.
+  GBytes* bytes;
 } FlValueFloatList;
 
 typedef struct {
@@ -336,9 +341,13 @@ G_MODULE_EXPORT FlValue* fl_value_new_float_list(const double* data,
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_list() {
+  return fl_value_new_list_sized(0);
+}
+
+FlValue* fl_value_new_list_sized(size_t reserved_size) {
   FlValueList* self = reinterpret_cast<FlValueList*>(
       fl_value_new(FL_VALUE_TYPE_LIST, sizeof(FlValueList)));
-  self->values = g_ptr_array_new_with_free_func(fl_value_destroy);
+  self->values = g_ptr_array_new_full(reserved_size, fl_value_destroy);
   return reinterpret_cast<FlValue*>(self);
 }
 
@@ -353,10 +362,51 @@ G_MODULE_EXPORT FlValue* fl_value_new_list_from_strv(
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_map() {
+  return fl_value_new_map_sized(0);
+}
+
+FlValue* fl_value_new_map_sized(size_t reserved_size) {
   FlValueMap* self = reinterpret_cast<FlValueMap*>(
       fl_value_new(FL_VALUE_TYPE_MAP, sizeof(FlValueMap)));
-  self->keys = g_ptr_array_new_with_free_func(fl_value_destroy);
-  self->values = g_ptr_array_new_with_free_func(fl_value_destroy);
+  self->keys = g_ptr_array_new_full(reserved_size, fl_value_destroy);
+  self->values = g_ptr_array_new_full(reserved_size, fl_value_destroy);
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_new_uint8_list_view(GBytes* bytes,
+                                      size_t offset,
+                                      size_t data_length) {
+  g_return_val_if_fail(offset + data_length <= g_bytes_get_size(bytes),
+                       nullptr);
+
+  FlValueUint8List* self = reinterpret_cast<FlValueUint8List*>(
+      fl_value_new(FL_VALUE_TYPE_UINT8_LIST, sizeof(FlValueUint8List)));
+  self->bytes = g_bytes_ref(bytes);
+  self->values = const_cast<uint8_t*>(
+      static_cast<const uint8_t*>(g_bytes_get_data(bytes, nullptr)) + offset);
+  self->values_length = data_length;
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_new_float_list_view(GBytes* bytes,
+                                      size_t offset,
+                                      size_t data_length) {
+  g_return_val_if_fail(
+      offset + sizeof(double) * data_length <= g_bytes_get_size(bytes),
+      nullptr);
+
+  const uint8_t* data =
+      static_cast<const uint8_t*>(g_bytes_get_data(bytes, nullptr)) + offset;
+  if (reinterpret_cast<uintptr_t>(data) % alignof(double) != 0) {
+    return fl_value_new_float_list(reinterpret_cast<const double*>(data),
+                                   data_length);
+  }
+
+  FlValueFloatList* self = reinterpret_cast<FlValueFloatList*>(
+      fl_value_new(FL_VALUE_TYPE_FLOAT_LIST, sizeof(FlValueFloatList)));
+  self->bytes = g_bytes_ref(bytes);
+  self->values = const_cast<double*>(reinterpret_cast<const double*>(data));
+  self->values_length = data_length;
   return reinterpret_cast<FlValue*>(self);
 }
 
@@ -382,7 +432,11 @@ G_MODULE_EXPORT void fl_value_unref(FlValue* self) {
     }
     case FL_VALUE_TYPE_UINT8_LIST: {
       FlValueUint8List* v = reinterpret_cast<FlValueUint8List*>(self);
-      g_free(v->values);
+      if (v->bytes != nullptr) {
+        g_bytes_unref(v->bytes);
+      } else {
+        g_free(v->values);
+      }
       break;
     }
     case FL_VALUE_TYPE_INT32_LIST: {
@@ -402,7 +456,11 @@ G_MODULE_EXPORT void fl_value_unref(FlValue* self) {
     }
     case FL_VALUE_TYPE_FLOAT_LIST: {
       FlValueFloatList* v = reinterpret_cast<FlValueFloatList*>(self);
-      g_free(v->values);
+      if (v->bytes != nullptr) {
+        g_bytes_unref(v->bytes);
+      } else {
+        g_free(v->values);
+      }
       break;
     }
     case FL_VALUE_TYPE_LIST: {
@@ -596,6 +654,17 @@ G_MODULE_EXPORT void fl_value_set_take(FlValue* self,
   }
 }
 
+void fl_value_map_append_take(FlValue* self, FlValue* key, FlValue* value) {
+  g_return_if_fail(self != nullptr);
+  g_return_if_fail(self->type == FL_VALUE_TYPE_MAP);
+  g_return_if_fail(key != nullptr);
+  g_return_if_fail(value != nullptr);
+
+  FlValueMap* v = reinterpret_cast<FlValueMap*>(self);
+  g_ptr_array_add(v->keys, key);
+  g_ptr_array_add(v->values, value);
+}
+
 G_MODULE_EXPORT void fl_value_set_string(FlValue* self,
                                          const gchar* key,
                                          FlValue* value) {
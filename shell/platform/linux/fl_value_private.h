@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_value.h"
+
+G_BEGIN_DECLS
+
+/**
+ * fl_value_new_list_sized:
+ * @reserved_size: number of values to reserve space for.
+ *
+ * Creates an empty ordered list with space for @reserved_size values, so
+ * appending them does not reallocate.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_list_sized(size_t reserved_size);
+
+/**
+ * fl_value_new_map_sized:
+ * @reserved_size: number of entries to reserve space for.
+ *
+ * Creates an empty map with space for @reserved_size entries, so appending
+ * them does not reallocate.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_map_sized(size_t reserved_size);
+
+/**
+ * fl_value_map_append_take:
+ * @value: an #FlValue of type #FL_VALUE_TYPE_MAP.
+ * @key: (transfer full): a key.
+ * @child_value: (transfer full): a value.
+ *
+ * Adds an entry to a map without checking if @key is already in it, which
+ * fl_value_set_take() does in linear time. Only use this if the keys are
+ * known to be unique, e.g. when decoding a map serialized by Dart.
+ */
+void fl_value_map_append_take(FlValue* value,
+                              FlValue* key,
+                              FlValue* child_value);
+
+/**
+ * fl_value_new_uint8_list_view:
+ * @bytes: buffer containing the list.
+ * @offset: offset of the list in @bytes.
+ * @data_length: number of elements in the list.
+ *
+ * Creates an ordered list of #uint8_t that references the data in @bytes
+ * instead of copying it. @bytes is kept alive until the value is freed.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_uint8_list_view(GBytes* bytes,
+                                      size_t offset,
+                                      size_t data_length);
+
+/**
+ * fl_value_new_float_list_view:
+ * @bytes: buffer containing the list.
+ * @offset: offset of the list in @bytes.
+ * @data_length: number of elements in the list.
+ *
+ * Creates an ordered list of doubles that references the data in @bytes
+ * instead of copying it. @bytes is kept alive until the value is freed. The
+ * data is copied if it is not aligned for doubles in memory.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_float_list_view(GBytes* bytes,
+                                      size_t offset,
+                                      size_t data_length);
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
@@ -784,10 +784,10 @@ void fl_view_begin_frame(FlView* view) {
   self->pending_children_list = nullptr;
 }
 
-void fl_view_add_gl_area(FlView* view,
-                         GdkGLContext* context,
-                         FlBackingStoreProvider* texture) {
-  g_return_if_fail(FL_IS_VIEW(view));
+FlGLArea* fl_view_add_gl_area(FlView* view,
+                              GdkGLContext* context,
+                              FlBackingStoreProvider* texture) {
+  g_return_val_if_fail(FL_IS_VIEW(view), nullptr);
 
   FlGLArea* area;
   if (view->used_area_list) {
@@ -801,6 +801,7 @@ void fl_view_add_gl_area(FlView* view,
   gtk_widget_show(GTK_WIDGET(area));
   add_pending_child(view, GTK_WIDGET(area), nullptr);
   fl_gl_area_queue_render(area, texture);
+  return area;
 }
 
 void fl_view_add_widget(FlView* view,
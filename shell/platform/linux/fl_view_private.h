@@ -27,10 +27,12 @@ void fl_view_begin_frame(FlView* view);
  * Append an #FlGLArea at top of stacked children of #FlView.
  * This function must be called after fl_view_begin_frame, and
  * before fl_view_end_frame.
+ *
+ * Returns: (transfer none): the #FlGLArea that renders @texture.
  */
-void fl_view_add_gl_area(FlView* view,
-                         GdkGLContext* context,
-                         FlBackingStoreProvider* texture);
+FlGLArea* fl_view_add_gl_area(FlView* view,
+                              GdkGLContext* context,
+                              FlBackingStoreProvider* texture);
 
 /**
  * fl_view_add_widget:
@@ -5,7 +5,6 @@
 #include "key_mapping.h"
 
 #include <glib.h>
-#include <map>
 
 #include "flutter/shell/platform/linux/fl_key_embedder_responder_private.h"
 
@@ -17,7 +16,7 @@
 // Edit the template dev/tools/gen_keycodes/data/gtk_key_mapping_cc.tmpl
 // instead. See dev/tools/gen_keycodes/README.md for more information.
 
-std::map<uint64_t, uint64_t> xkb_to_physical_key_map = {
+constexpr flutter::StaticKeyMap::Entry kXkbToPhysicalKeyEntries[] = {
     {0x00000009, 0x00070029},  // escape
     {0x0000000a, 0x0007001e},  // digit1
     {0x0000000b, 0x0007001f},  // digit2
@@ -235,8 +234,11 @@ std::map<uint64_t, uint64_t> xkb_to_physical_key_map = {
     {0x00000259, 0x000c0074},  // brightnessMaximum
     {0x00000281, 0x00000017},  // privacyScreenToggle
 };
+static_assert(flutter::StaticKeyMap(kXkbToPhysicalKeyEntries).IsSorted());
 
-std::map<uint64_t, uint64_t> gtk_keyval_to_logical_key_map = {
+const flutter::StaticKeyMap xkb_to_physical_key_map(kXkbToPhysicalKeyEntries);
+
+constexpr flutter::StaticKeyMap::Entry kGtkKeyvalToLogicalKeyEntries[] = {
     {0x000000a5, 0x00200000022},  // yen
     {0x0000fd06, 0x00100000405},  // 3270_EraseEOF
     {0x0000fd0e, 0x00100000503},  // 3270_Attn
@@ -409,6 +411,10 @@ std::map<uint64_t, uint64_t> gtk_keyval_to_logical_key_map = {
     {0x1008ff97, 0x00100000d2c},  // AudioForward
     {0x1008ffa7, 0x00200000000},  // Suspend
 };
+static_assert(flutter::StaticKeyMap(kGtkKeyvalToLogicalKeyEntries).IsSorted());
+
+const flutter::StaticKeyMap gtk_keyval_to_logical_key_map(
+    kGtkKeyvalToLogicalKeyEntries);
 
 void initialize_modifier_bit_to_checked_keys(GHashTable* table) {
   FlKeyEmbedderCheckedKey* data;
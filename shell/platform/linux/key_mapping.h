@@ -7,7 +7,8 @@
 
 #include <gdk/gdk.h>
 #include <cinttypes>
-#include <map>
+
+#include "flutter/shell/platform/common/static_key_map.h"
 
 inline uint64_t gpointer_to_uint64(gpointer pointer) {
   return pointer == nullptr ? 0 : reinterpret_cast<uint64_t>(pointer);
@@ -18,10 +19,10 @@ inline gpointer uint64_to_gpointer(uint64_t number) {
 }
 
 // Maps XKB specific key code values to Flutter's physical key code values.
-extern std::map<uint64_t, uint64_t> xkb_to_physical_key_map;
+extern const flutter::StaticKeyMap xkb_to_physical_key_map;
 
 // Maps GDK keyval values to Flutter's logical key code values.
-extern std::map<uint64_t, uint64_t> gtk_keyval_to_logical_key_map;
+extern const flutter::StaticKeyMap gtk_keyval_to_logical_key_map;
 
 void initialize_modifier_bit_to_checked_keys(GHashTable* table);
 
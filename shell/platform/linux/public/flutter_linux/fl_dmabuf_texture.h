@@ -0,0 +1,161 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_DMABUF_TEXTURE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_DMABUF_TEXTURE_H_
+
+#if !defined(__FLUTTER_LINUX_INSIDE__) && !defined(FLUTTER_LINUX_COMPILATION)
+#error "Only <flutter_linux/flutter_linux.h> can be included directly."
+#endif
+
+#include <glib-object.h>
+#include <stdint.h>
+#include "fl_texture.h"
+
+G_BEGIN_DECLS
+
+/**
+ * FL_DMABUF_TEXTURE_ERROR:
+ *
+ * #GError domain for #FlDmabufTexture.
+ */
+#define FL_DMABUF_TEXTURE_ERROR fl_dmabuf_texture_error_quark()
+
+/**
+ * FlDmabufTextureError:
+ * @FL_DMABUF_TEXTURE_ERROR_NOT_SUPPORTED: The OpenGL context used by Flutter
+ * cannot import DMA-BUFs.
+ * @FL_DMABUF_TEXTURE_ERROR_FAILED: Importing the DMA-BUF failed.
+ *
+ * Errors for #FlDmabufTexture objects to set on failures.
+ */
+typedef enum {
+  FL_DMABUF_TEXTURE_ERROR_NOT_SUPPORTED,
+  FL_DMABUF_TEXTURE_ERROR_FAILED,
+} FlDmabufTextureError;
+
+GQuark fl_dmabuf_texture_error_quark(void) G_GNUC_CONST;
+
+/**
+ * FL_DMABUF_MAX_PLANES:
+ *
+ * The maximum number of planes of an #FlDmabuf.
+ */
+#define FL_DMABUF_MAX_PLANES 4
+
+/**
+ * FlDmabuf:
+ * @width: width of the buffer in pixels.
+ * @height: height of the buffer in pixels.
+ * @fourcc: DRM format of the buffer, e.g. DRM_FORMAT_ARGB8888 or
+ * DRM_FORMAT_NV12.
+ * @modifier: DRM format modifier of the buffer, or DRM_FORMAT_MOD_INVALID if
+ * the layout is implied by the driver.
+ * @n_planes: number of planes of the buffer.
+ * @fds: file descriptors of the planes. They remain owned by the texture.
+ * @offsets: offsets of the planes in bytes.
+ * @strides: strides of the planes in bytes.
+ * @fence_fd: a sync file that is signaled when the producer finished writing
+ * the buffer, or -1 if the buffer is ready. Ownership is transferred to
+ * Flutter.
+ *
+ * A DMA-BUF to be displayed by an #FlDmabufTexture.
+ */
+typedef struct {
+  uint32_t width;
+  uint32_t height;
+  uint32_t fourcc;
+  uint64_t modifier;
+  uint32_t n_planes;
+  int fds[FL_DMABUF_MAX_PLANES];
+  uint32_t offsets[FL_DMABUF_MAX_PLANES];
+  uint32_t strides[FL_DMABUF_MAX_PLANES];
+  int fence_fd;
+} FlDmabuf;
+
+G_DECLARE_DERIVABLE_TYPE(FlDmabufTexture,
+                         fl_dmabuf_texture,
+                         FL,
+                         DMABUF_TEXTURE,
+                         GObject)
+
+/**
+ * FlDmabufTexture:
+ *
+ * #FlDmabufTexture represents a texture imported from a DMA-BUF, such as the
+ * frames produced by a camera or a GStreamer video pipeline. The buffer is
+ * sampled by the GPU where it is, without being copied through the CPU.
+ * Multi-planar YUV formats are converted to RGB by the driver while sampling.
+ *
+ * Importing requires Flutter to render with EGL and the
+ * EGL_EXT_image_dma_buf_import extension, which is the case when running on
+ * Wayland.
+ *
+ * The following example shows how to implement an #FlDmabufTexture.
+ * ![<!-- language="C" -->
+ *   // Type definition, constructor, init, destructor and class_init are
+ *   // omitted.
+ *   struct _VideoDmabufTexture {  // extends FlDmabufTexture
+ *     FlDmabufTexture parent_instance;
+ *
+ *     VideoFrame *frame;  // the latest frame of your pipeline.
+ *   }
+ *
+ *   G_DEFINE_TYPE(VideoDmabufTexture,
+ *                 video_dmabuf_texture,
+ *                 fl_dmabuf_texture_get_type ())
+ *
+ *   static gboolean
+ *   video_dmabuf_texture_get_dmabuf (FlDmabufTexture* texture,
+ *                                    FlDmabuf* dmabuf,
+ *                                    GError** error) {
+ *     // This method is called on the render thread. Be careful with your
+ *     // cross-thread operation.
+ *     VideoDmabufTexture *self = VIDEO_DMABUF_TEXTURE (texture);
+ *
+ *     dmabuf->width = self->frame->width;
+ *     dmabuf->height = self->frame->height;
+ *     dmabuf->fourcc = DRM_FORMAT_NV12;
+ *     dmabuf->modifier = DRM_FORMAT_MOD_INVALID;
+ *     dmabuf->n_planes = 2;
+ *     for (int i = 0; i < 2; i++) {
+ *       dmabuf->fds[i] = self->frame->fds[i];
+ *       dmabuf->offsets[i] = self->frame->offsets[i];
+ *       dmabuf->strides[i] = self->frame->strides[i];
+ *     }
+ *     dmabuf->fence_fd = -1;
+ *
+ *     return TRUE;
+ *   }
+ * ]|
+ */
+
+struct _FlDmabufTextureClass {
+  GObjectClass parent_class;
+
+  /**
+   * FlDmabufTexture::get_dmabuf:
+   * @texture: an #FlDmabufTexture.
+   * @dmabuf: (out): the buffer to display.
+   * @error: (allow-none): #GError location to store the error occurring, or
+   * %NULL to ignore.
+   *
+   * Retrieve the DMA-BUF to display. The default values of @dmabuf are an
+   * unknown modifier and no fence.
+   *
+   * As this method is usually invoked from the render thread, you must
+   * take care of proper synchronization. The buffer must not be written to
+   * until the next call to this method, or until this texture is
+   * unregistered.
+   *
+   * Returns: %TRUE on success.
+   */
+  gboolean (*get_dmabuf)(FlDmabufTexture* texture,
+                         FlDmabuf* dmabuf,
+                         GError** error);
+};
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_DMABUF_TEXTURE_H_
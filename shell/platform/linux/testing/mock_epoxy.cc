@@ -5,6 +5,7 @@
 
 #include <epoxy/egl.h>
 #include <epoxy/gl.h>
+#include <epoxy/glx.h>
 
 typedef struct {
   EGLint config_id;
@@ -254,6 +255,34 @@ EGLBoolean _eglGetConfigAttrib(EGLDisplay dpy,
   }
 }
 
+EGLImageKHR _eglCreateImageKHR(EGLDisplay dpy,
+                               EGLContext ctx,
+                               EGLenum target,
+                               EGLClientBuffer buffer,
+                               const EGLint* attrib_list) {
+  mock_error = EGL_BAD_DISPLAY;
+  return EGL_NO_IMAGE_KHR;
+}
+
+EGLSyncKHR _eglCreateSyncKHR(EGLDisplay dpy,
+                             EGLenum type,
+                             const EGLint* attrib_list) {
+  mock_error = EGL_BAD_DISPLAY;
+  return EGL_NO_SYNC_KHR;
+}
+
+EGLBoolean _eglDestroyImageKHR(EGLDisplay dpy, EGLImageKHR image) {
+  return bool_success();
+}
+
+EGLBoolean _eglDestroySyncKHR(EGLDisplay dpy, EGLSyncKHR sync) {
+  return bool_success();
+}
+
+EGLDisplay _eglGetCurrentDisplay() {
+  return EGL_NO_DISPLAY;
+}
+
 EGLDisplay _eglGetDisplay(EGLNativeDisplayType display_id) {
   return &mock_display;
 }
@@ -326,6 +355,10 @@ EGLBoolean _eglMakeCurrent(EGLDisplay dpy,
   return bool_success();
 }
 
+EGLint _eglWaitSyncKHR(EGLDisplay dpy, EGLSyncKHR sync, EGLint flags) {
+  return bool_success();
+}
+
 EGLBoolean _eglSwapBuffers(EGLDisplay dpy, EGLSurface surface) {
   if (!check_display(dpy) || !check_initialized(dpy)) {
     return EGL_FALSE;
@@ -338,10 +371,31 @@ static void _glBindFramebuffer(GLenum target, GLuint framebuffer) {}
 
 static void _glBindTexture(GLenum target, GLuint texture) {}
 
+static void _glBlitFramebuffer(GLint srcX0,
+                               GLint srcY0,
+                               GLint srcX1,
+                               GLint srcY1,
+                               GLint dstX0,
+                               GLint dstY0,
+                               GLint dstX1,
+                               GLint dstY1,
+                               GLbitfield mask,
+                               GLenum filter) {}
+
+static void _glClear(GLbitfield mask) {}
+
+static void _glClearColor(GLfloat red,
+                          GLfloat green,
+                          GLfloat blue,
+                          GLfloat alpha) {}
+
 void _glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {}
 
 void _glDeleteTextures(GLsizei n, const GLuint* textures) {}
 
+static void _glEGLImageTargetTexture2DOES(GLenum target,
+                                         GLeglImageOES image) {}
+
 static void _glFramebufferTexture2D(GLenum target,
                                     GLenum attachment,
                                     GLenum textarget,
@@ -378,6 +432,26 @@ static GLenum _glGetError() {
   return GL_NO_ERROR;
 }
 
+static GLXContext _glXGetCurrentContext() {
+  return nullptr;
+}
+
+static Display* _glXGetCurrentDisplay() {
+  return nullptr;
+}
+
+static Bool _glXMakeCurrent(Display* dpy,
+                            GLXDrawable drawable,
+                            GLXContext ctx) {
+  return False;
+}
+
+static void _glXSwapBuffers(Display* dpy, GLXDrawable drawable) {}
+
+bool epoxy_has_egl_extension(EGLDisplay dpy, const char* extension) {
+  return false;
+}
+
 bool epoxy_has_gl_extension(const char* extension) {
   return false;
 }
@@ -430,6 +504,17 @@ EGLBoolean (*epoxy_eglGetConfigAttrib)(EGLDisplay dpy,
                                        EGLConfig config,
                                        EGLint attribute,
                                        EGLint* value);
+EGLImageKHR (*epoxy_eglCreateImageKHR)(EGLDisplay dpy,
+                                       EGLContext ctx,
+                                       EGLenum target,
+                                       EGLClientBuffer buffer,
+                                       const EGLint* attrib_list);
+EGLSyncKHR (*epoxy_eglCreateSyncKHR)(EGLDisplay dpy,
+                                     EGLenum type,
+                                     const EGLint* attrib_list);
+EGLBoolean (*epoxy_eglDestroyImageKHR)(EGLDisplay dpy, EGLImageKHR image);
+EGLBoolean (*epoxy_eglDestroySyncKHR)(EGLDisplay dpy, EGLSyncKHR sync);
+EGLDisplay (*epoxy_eglGetCurrentDisplay)();
 EGLDisplay (*epoxy_eglGetDisplay)(EGLNativeDisplayType display_id);
 EGLint (*epoxy_eglGetError)();
 void (*(*epoxy_eglGetProcAddress)(const char* procname))(void);
@@ -439,11 +524,29 @@ EGLBoolean (*epoxy_eglMakeCurrent)(EGLDisplay dpy,
                                    EGLSurface read,
                                    EGLContext ctx);
 EGLBoolean (*epoxy_eglSwapBuffers)(EGLDisplay dpy, EGLSurface surface);
+EGLint (*epoxy_eglWaitSyncKHR)(EGLDisplay dpy, EGLSyncKHR sync, EGLint flags);
 
 void (*epoxy_glBindFramebuffer)(GLenum target, GLuint framebuffer);
 void (*epoxy_glBindTexture)(GLenum target, GLuint texture);
+void (*epoxy_glBlitFramebuffer)(GLint srcX0,
+                                GLint srcY0,
+                                GLint srcX1,
+                                GLint srcY1,
+                                GLint dstX0,
+                                GLint dstY0,
+                                GLint dstX1,
+                                GLint dstY1,
+                                GLbitfield mask,
+                                GLenum filter);
+void (*epoxy_glClear)(GLbitfield mask);
+void (*epoxy_glClearColor)(GLfloat red,
+                           GLfloat green,
+                           GLfloat blue,
+                           GLfloat alpha);
 void (*epoxy_glDeleteFramebuffers)(GLsizei n, const GLuint* framebuffers);
 void (*epoxy_glDeleteTextures)(GLsizei n, const GLuint* textures);
+void (*epoxy_glEGLImageTargetTexture2DOES)(GLenum target,
+                                           GLeglImageOES image);
 void (*epoxy_glFramebufferTexture2D)(GLenum target,
                                      GLenum attachment,
                                      GLenum textarget,
@@ -464,6 +567,13 @@ void (*epoxy_glTexImage2D)(GLenum target,
                            const void* pixels);
 GLenum (*epoxy_glGetError)();
 
+GLXContext (*epoxy_glXGetCurrentContext)();
+Display* (*epoxy_glXGetCurrentDisplay)();
+Bool (*epoxy_glXMakeCurrent)(Display* dpy,
+                             GLXDrawable drawable,
+                             GLXContext ctx);
+void (*epoxy_glXSwapBuffers)(Display* dpy, GLXDrawable drawable);
+
 static void library_init() {
   epoxy_eglBindAPI = _eglBindAPI;
   epoxy_eglChooseConfig = _eglChooseConfig;
@@ -471,17 +581,27 @@ static void library_init() {
   epoxy_eglCreatePbufferSurface = _eglCreatePbufferSurface;
   epoxy_eglCreateWindowSurface = _eglCreateWindowSurface;
   epoxy_eglGetConfigAttrib = _eglGetConfigAttrib;
+  epoxy_eglCreateImageKHR = _eglCreateImageKHR;
+  epoxy_eglCreateSyncKHR = _eglCreateSyncKHR;
+  epoxy_eglDestroyImageKHR = _eglDestroyImageKHR;
+  epoxy_eglDestroySyncKHR = _eglDestroySyncKHR;
+  epoxy_eglGetCurrentDisplay = _eglGetCurrentDisplay;
   epoxy_eglGetDisplay = _eglGetDisplay;
   epoxy_eglGetError = _eglGetError;
   epoxy_eglGetProcAddress = _eglGetProcAddress;
   epoxy_eglInitialize = _eglInitialize;
   epoxy_eglMakeCurrent = _eglMakeCurrent;
   epoxy_eglSwapBuffers = _eglSwapBuffers;
+  epoxy_eglWaitSyncKHR = _eglWaitSyncKHR;
 
   epoxy_glBindFramebuffer = _glBindFramebuffer;
   epoxy_glBindTexture = _glBindTexture;
+  epoxy_glBlitFramebuffer = _glBlitFramebuffer;
+  epoxy_glClear = _glClear;
+  epoxy_glClearColor = _glClearColor;
   epoxy_glDeleteFramebuffers = _glDeleteFramebuffers;
   epoxy_glDeleteTextures = _glDeleteTextures;
+  epoxy_glEGLImageTargetTexture2DOES = _glEGLImageTargetTexture2DOES;
   epoxy_glFramebufferTexture2D = _glFramebufferTexture2D;
   epoxy_glGenFramebuffers = _glGenFramebuffers;
   epoxy_glGenTextures = _glGenTextures;
@@ -489,4 +609,9 @@ static void library_init() {
   epoxy_glTexParameteri = _glTexParameteri;
   epoxy_glTexImage2D = _glTexImage2D;
   epoxy_glGetError = _glGetError;
+
+  epoxy_glXGetCurrentContext = _glXGetCurrentContext;
+  epoxy_glXGetCurrentDisplay = _glXGetCurrentDisplay;
+  epoxy_glXMakeCurrent = _glXMakeCurrent;
+  epoxy_glXSwapBuffers = _glXSwapBuffers;
 }
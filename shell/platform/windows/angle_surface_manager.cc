@@ -4,7 +4,10 @@
 
 #include "flutter/shell/platform/windows/angle_surface_manager.h"
 
+#include <dxgi.h>
+
 #include <iostream>
+#include <string>
 #include <vector>
 
 #ifdef WINUWP
@@ -24,6 +27,16 @@ static void LogEglError(std::string message) {
   std::cerr << "EGL: eglGetError returned " << error << std::endl;
 }
 
+// Returns whether the space separated list of EGL extensions contains name.
+static bool HasExtension(const char* extensions, const char* name) {
+  if (extensions == nullptr) {
+    return false;
+  }
+  std::string padded_extensions = std::string(" ") + extensions + " ";
+  return padded_extensions.find(std::string(" ") + name + " ") !=
+         std::string::npos;
+}
+
 namespace flutter {
 
 int AngleSurfaceManager::instance_count_ = 0;
@@ -168,6 +181,54 @@ bool AngleSurfaceManager::Initialize() {
     return false;
   }
 
+  const char* extensions = eglQueryString(egl_display_, EGL_EXTENSIONS);
+  direct_composition_supported_ =
+      HasExtension(extensions, "EGL_ANGLE_direct_composition");
+  post_sub_buffer_supported_ =
+      HasExtension(extensions, "EGL_NV_post_sub_buffer");
+
+  LimitFrameLatency();
+
+  return true;
+}
+
+void AngleSurfaceManager::LimitFrameLatency() {
+  Microsoft::WRL::ComPtr<ID3D11Device> d3d11_device;
+  if (!GetDevice(&d3d11_device)) {
+    return;
+  }
+
+  // ANGLE does not expose its swapchains, so the latency is set on the device,
+  // which applies it to all of them.
+  Microsoft::WRL::ComPtr<IDXGIDevice1> dxgi_device;
+  if (SUCCEEDED(d3d11_device.As(&dxgi_device))) {
+    dxgi_device->SetMaximumFrameLatency(1);
+  }
+}
+
+bool AngleSurfaceManager::GetDevice(ID3D11Device** device) {
+  PFNEGLQUERYDISPLAYATTRIBEXTPROC egl_query_display_attrib_EXT =
+      reinterpret_cast<PFNEGLQUERYDISPLAYATTRIBEXTPROC>(
+          eglGetProcAddress("eglQueryDisplayAttribEXT"));
+  PFNEGLQUERYDEVICEATTRIBEXTPROC egl_query_device_attrib_EXT =
+      reinterpret_cast<PFNEGLQUERYDEVICEATTRIBEXTPROC>(
+          eglGetProcAddress("eglQueryDeviceAttribEXT"));
+  if (!egl_query_display_attrib_EXT || !egl_query_device_attrib_EXT) {
+    return false;
+  }
+
+  EGLAttrib egl_device = 0;
+  EGLAttrib d3d11_device = 0;
+  if (egl_query_display_attrib_EXT(egl_display_, EGL_DEVICE_EXT,
+                                   &egl_device) != EGL_TRUE ||
+      egl_query_device_attrib_EXT(reinterpret_cast<EGLDeviceEXT>(egl_device),
+                                  EGL_D3D11_DEVICE_ANGLE,
+                                  &d3d11_device) != EGL_TRUE) {
+    return false;
+  }
+
+  *device = reinterpret_cast<ID3D11Device*>(d3d11_device);
+  (*device)->AddRef();
   return true;
 }
 
@@ -213,11 +274,22 @@ bool AngleSurfaceManager::CreateSurface(WindowsRenderTarget* render_target,
   EGLSurface surface = EGL_NO_SURFACE;
 
 #ifdef WINUWP
-  const EGLint surfaceAttributes[] = {EGL_NONE};
+  std::vector<EGLint> surfaceAttributes = {EGL_NONE};
 #else
-  const EGLint surfaceAttributes[] = {
-      EGL_FIXED_SIZE_ANGLE, EGL_TRUE, EGL_WIDTH, width,
-      EGL_HEIGHT,           height,   EGL_NONE};
+  std::vector<EGLint> surfaceAttributes = {
+      EGL_FIXED_SIZE_ANGLE, EGL_TRUE, EGL_WIDTH, width, EGL_HEIGHT, height};
+  if (direct_composition_supported_) {
+    // Present through a DirectComposition visual with a flip model swapchain
+    // rather than copying each frame into the redirection surface of the
+    // window.
+    surfaceAttributes.push_back(EGL_DIRECT_COMPOSITION_ANGLE);
+    surfaceAttributes.push_back(EGL_TRUE);
+  }
+  if (post_sub_buffer_supported_) {
+    surfaceAttributes.push_back(EGL_POST_SUB_BUFFER_SUPPORTED_NV);
+    surfaceAttributes.push_back(EGL_TRUE);
+  }
+  surfaceAttributes.push_back(EGL_NONE);
 #endif
 
 #ifdef WINUWP
@@ -230,17 +302,29 @@ bool AngleSurfaceManager::CreateSurface(WindowsRenderTarget* render_target,
   surface = eglCreateWindowSurface(
       egl_display_, egl_config_,
       static_cast<EGLNativeWindowType>(winrt::get_abi(target)),
-      surfaceAttributes);
+      surfaceAttributes.data());
 #else
   surface = eglCreateWindowSurface(
       egl_display_, egl_config_,
       static_cast<EGLNativeWindowType>(std::get<HWND>(*render_target)),
-      surfaceAttributes);
+      surfaceAttributes.data());
 #endif
   if (surface == EGL_NO_SURFACE) {
     LogEglError("Surface creation failed.");
   }
 
+#ifdef WINUWP
+  surface_contents_preserved_ = false;
+#else
+  // Partial presentation relies on the surface keeping the previous frame, as
+  // only the damaged region of each frame is rendered.
+  surface_contents_preserved_ =
+      surface != EGL_NO_SURFACE && post_sub_buffer_supported_ &&
+      eglSurfaceAttrib(egl_display_, surface, EGL_SWAP_BEHAVIOR,
+                       EGL_BUFFER_PRESERVED) == EGL_TRUE;
+#endif
+  surface_presented_ = false;
+
   surface_width_ = width;
   surface_height_ = height;
   render_surface_ = surface;
@@ -313,7 +397,38 @@ bool AngleSurfaceManager::MakeResourceCurrent() {
 }
 
 EGLBoolean AngleSurfaceManager::SwapBuffers() {
-  return (eglSwapBuffers(egl_display_, render_surface_));
+  EGLBoolean result = eglSwapBuffers(egl_display_, render_surface_);
+  if (result == EGL_TRUE) {
+    surface_presented_ = true;
+  }
+  return result;
+}
+
+EGLBoolean AngleSurfaceManager::SwapBuffers(EGLint x,
+                                            EGLint y,
+                                            EGLint width,
+                                            EGLint height) {
+  if (!SurfaceContentsPreserved() || width <= 0 || height <= 0) {
+    return SwapBuffers();
+  }
+
+  // ANGLE presents the region with IDXGISwapChain1::Present1 and a dirty
+  // rectangle, so the compositor only updates that part of the window.
+  // eglPostSubBufferNV takes the region from the bottom left corner.
+  return eglPostSubBufferNV(egl_display_, render_surface_, x,
+                            surface_height_ - y - height, width, height);
+}
+
+bool AngleSurfaceManager::SurfaceContentsPreserved() const {
+  return surface_contents_preserved_ && surface_presented_;
+}
+
+EGLSurface AngleSurfaceManager::CreateSurfaceFromHandle(
+    EGLenum handle_type,
+    EGLClientBuffer handle,
+    const EGLint* attributes) const {
+  return eglCreatePbufferFromClientBuffer(egl_display_, handle_type, handle,
+                                          egl_config_, attributes);
 }
 
 }  // namespace flutter
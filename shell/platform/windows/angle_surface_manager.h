@@ -13,7 +13,9 @@
 #include <GLES2/gl2ext.h>
 
 // Windows platform specific includes
+#include <d3d11.h>
 #include <windows.h>
+#include <wrl/client.h>
 #include <memory>
 
 #include "window_binding_handler.h"
@@ -69,6 +71,31 @@ class AngleSurfaceManager {
   // not null.
   EGLBoolean SwapBuffers();
 
+  // Swaps the front and back buffers of the DX11 swapchain backing surface if
+  // not null, presenting only the region that changed since the last frame.
+  // The region is given in physical pixels from the top left corner of the
+  // surface. The whole surface is presented if partial presentation is not
+  // supported.
+  EGLBoolean SwapBuffers(EGLint x, EGLint y, EGLint width, EGLint height);
+
+  // Returns whether the surface still holds the last frame presented, in
+  // which case only the damaged region of the next frame needs to be
+  // rendered.
+  bool SurfaceContentsPreserved() const;
+
+  // Creates a pbuffer surface wrapping |handle|, a client buffer of type
+  // |handle_type| such as EGL_D3D_TEXTURE_2D_SHARE_HANDLE_ANGLE. Returns
+  // EGL_NO_SURFACE on failure.
+  EGLSurface CreateSurfaceFromHandle(EGLenum handle_type,
+                                     EGLClientBuffer handle,
+                                     const EGLint* attributes) const;
+
+  // Gets the EGLDisplay.
+  EGLDisplay egl_display() const { return egl_display_; }
+
+  // Gets the D3D11 device used by ANGLE. Returns false if it is unavailable.
+  bool GetDevice(ID3D11Device** device);
+
  private:
   bool Initialize();
   void CleanUp();
@@ -84,6 +111,10 @@ class AngleSurfaceManager {
       const EGLint* config,
       bool should_log);
 
+  // Limits the number of frames queued by the D3D11 device backing ANGLE to
+  // one, which lowers the latency between rendering and displaying a frame.
+  void LimitFrameLatency();
+
   // EGL representation of native display.
   EGLDisplay egl_display_;
 
@@ -104,6 +135,20 @@ class AngleSurfaceManager {
   // Current render_surface that engine will draw into.
   EGLSurface render_surface_ = EGL_NO_SURFACE;
 
+  // Whether ANGLE can present surfaces through DirectComposition with a flip
+  // model swapchain (EGL_ANGLE_direct_composition).
+  bool direct_composition_supported_ = false;
+
+  // Whether ANGLE can present a region of surfaces (EGL_NV_post_sub_buffer).
+  bool post_sub_buffer_supported_ = false;
+
+  // Whether render_surface_ keeps its contents across swaps, which allows
+  // presenting only the damaged region of each frame.
+  bool surface_contents_preserved_ = false;
+
+  // Whether a frame has been presented since render_surface_ was created.
+  bool surface_presented_ = false;
+
   // Requested dimensions for current surface
   EGLint surface_width_ = 0;
   EGLint surface_height_ = 0;
@@ -0,0 +1,211 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/windows/external_texture_d3d.h"
+
+#include <iostream>
+
+namespace flutter {
+
+ExternalTextureD3d::ExternalTextureD3d(
+    FlutterDesktopGpuSurfaceType type,
+    const FlutterDesktopGpuSurfaceTextureCallback texture_callback,
+    void* user_data,
+    AngleSurfaceManager* surface_manager,
+    const GlProcs& gl_procs)
+    : type_(type),
+      texture_callback_(texture_callback),
+      user_data_(user_data),
+      surface_manager_(surface_manager),
+      gl_(gl_procs) {}
+
+ExternalTextureD3d::~ExternalTextureD3d() {
+  ReleaseSurface();
+}
+
+bool ExternalTextureD3d::PopulateTexture(size_t width,
+                                         size_t height,
+                                         FlutterOpenGLTexture* opengl_texture) {
+  const FlutterDesktopGpuSurfaceDescriptor* descriptor =
+      texture_callback_(width, height, user_data_);
+  if (!descriptor) {
+    return false;
+  }
+
+  bool success = CreateOrUpdateTexture(descriptor);
+  if (success && keyed_mutex_) {
+    CopySurface();
+  }
+  if (descriptor->release_callback) {
+    descriptor->release_callback(descriptor->release_context);
+  }
+  if (!success) {
+    return false;
+  }
+
+  // Populate the texture object used by the engine.
+  opengl_texture->target = GL_TEXTURE_2D;
+  opengl_texture->name = keyed_mutex_ ? copy_texture_ : surface_texture_;
+  opengl_texture->format = GL_RGBA8_OES;
+  opengl_texture->destruction_callback = nullptr;
+  opengl_texture->user_data = nullptr;
+  opengl_texture->width = surface_width_;
+  opengl_texture->height = surface_height_;
+
+  return true;
+}
+
+bool ExternalTextureD3d::CreateOrUpdateTexture(
+    const FlutterDesktopGpuSurfaceDescriptor* descriptor) {
+  HANDLE handle = GetSharedHandle(descriptor);
+  if (!handle || descriptor->width == 0 || descriptor->height == 0) {
+    return false;
+  }
+
+  if (egl_surface_ != EGL_NO_SURFACE && handle == last_handle_ &&
+      descriptor->width == surface_width_ &&
+      descriptor->height == surface_height_) {
+    return true;
+  }
+
+  ReleaseSurface();
+
+  const EGLint attributes[] = {EGL_WIDTH,
+                               static_cast<EGLint>(descriptor->width),
+                               EGL_HEIGHT,
+                               static_cast<EGLint>(descriptor->height),
+                               EGL_TEXTURE_TARGET,
+                               EGL_TEXTURE_2D,
+                               EGL_TEXTURE_FORMAT,
+                               EGL_TEXTURE_RGBA,
+                               EGL_NONE};
+  egl_surface_ = surface_manager_->CreateSurfaceFromHandle(
+      EGL_D3D_TEXTURE_2D_SHARE_HANDLE_ANGLE, handle, attributes);
+  if (egl_surface_ == EGL_NO_SURFACE) {
+    std::cerr << "Failed to import the GPU surface of an external texture."
+              << std::endl;
+    return false;
+  }
+  last_handle_ = handle;
+  surface_width_ = descriptor->width;
+  surface_height_ = descriptor->height;
+  keyed_mutex_ = HasKeyedMutex(handle);
+
+  gl_.glGenTextures(1, &surface_texture_);
+  gl_.glBindTexture(GL_TEXTURE_2D, surface_texture_);
+  gl_.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  gl_.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  gl_.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  gl_.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+  if (!keyed_mutex_) {
+    // The surface stays bound, and is sampled where it is for every frame.
+    if (eglBindTexImage(surface_manager_->egl_display(), egl_surface_,
+                        EGL_BACK_BUFFER) != EGL_TRUE) {
+      std::cerr << "Failed to bind the GPU surface of an external texture."
+                << std::endl;
+      ReleaseSurface();
+      return false;
+    }
+    return true;
+  }
+
+  gl_.glGenTextures(1, &copy_texture_);
+  gl_.glBindTexture(GL_TEXTURE_2D, copy_texture_);
+  gl_.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  gl_.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  gl_.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  gl_.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  gl_.glGenFramebuffers(1, &copy_framebuffer_);
+  return true;
+}
+
+HANDLE ExternalTextureD3d::GetSharedHandle(
+    const FlutterDesktopGpuSurfaceDescriptor* descriptor) const {
+  if (!descriptor->handle) {
+    return nullptr;
+  }
+
+  switch (type_) {
+    case kFlutterDesktopGpuSurfaceTypeDxgiSharedHandle:
+      return static_cast<HANDLE>(descriptor->handle);
+    case kFlutterDesktopGpuSurfaceTypeD3d11Texture2D: {
+      auto texture = static_cast<ID3D11Texture2D*>(descriptor->handle);
+      Microsoft::WRL::ComPtr<IDXGIResource> resource;
+      HANDLE handle = nullptr;
+      if (FAILED(texture->QueryInterface(IID_PPV_ARGS(&resource))) ||
+          FAILED(resource->GetSharedHandle(&handle))) {
+        std::cerr << "The D3D11 texture of an external texture is not shared."
+                  << std::endl;
+        return nullptr;
+      }
+      return handle;
+    }
+    default:
+      return nullptr;
+  }
+}
+
+bool ExternalTextureD3d::HasKeyedMutex(HANDLE handle) const {
+  Microsoft::WRL::ComPtr<ID3D11Device> device;
+  Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
+  if (!surface_manager_->GetDevice(&device) ||
+      FAILED(device->OpenSharedResource(handle, IID_PPV_ARGS(&texture)))) {
+    return false;
+  }
+
+  D3D11_TEXTURE2D_DESC desc;
+  texture->GetDesc(&desc);
+  return (desc.MiscFlags & D3D11_RESOURCE_MISC_SHARED_KEYEDMUTEX) != 0;
+}
+
+void ExternalTextureD3d::CopySurface() {
+  EGLDisplay display = surface_manager_->egl_display();
+  GLint previous_framebuffer = 0;
+  gl_.glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous_framebuffer);
+
+  // ANGLE acquires the keyed mutex of the surface with key 0 while it is
+  // bound, so the producer is only blocked for the duration of the copy.
+  gl_.glBindTexture(GL_TEXTURE_2D, surface_texture_);
+  if (eglBindTexImage(display, egl_surface_, EGL_BACK_BUFFER) != EGL_TRUE) {
+    std::cerr << "Failed to bind the GPU surface of an external texture."
+              << std::endl;
+    return;
+  }
+  gl_.glBindFramebuffer(GL_FRAMEBUFFER, copy_framebuffer_);
+  gl_.glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                             GL_TEXTURE_2D, surface_texture_, 0);
+  gl_.glBindTexture(GL_TEXTURE_2D, copy_texture_);
+  gl_.glCopyTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 0, 0,
+                       static_cast<GLsizei>(surface_width_),
+                       static_cast<GLsizei>(surface_height_), 0);
+  gl_.glBindFramebuffer(GL_FRAMEBUFFER, previous_framebuffer);
+  eglReleaseTexImage(display, egl_surface_, EGL_BACK_BUFFER);
+}
+
+void ExternalTextureD3d::ReleaseSurface() {
+  if (egl_surface_ != EGL_NO_SURFACE) {
+    EGLDisplay display = surface_manager_->egl_display();
+    if (!keyed_mutex_) {
+      eglReleaseTexImage(display, egl_surface_, EGL_BACK_BUFFER);
+    }
+    eglDestroySurface(display, egl_surface_);
+    egl_surface_ = EGL_NO_SURFACE;
+  }
+  if (surface_texture_ != 0) {
+    gl_.glDeleteTextures(1, &surface_texture_);
+    surface_texture_ = 0;
+  }
+  if (copy_texture_ != 0) {
+    gl_.glDeleteTextures(1, &copy_texture_);
+    copy_texture_ = 0;
+  }
+  if (copy_framebuffer_ != 0) {
+    gl_.glDeleteFramebuffers(1, &copy_framebuffer_);
+    copy_framebuffer_ = 0;
+  }
+  last_handle_ = nullptr;
+}
+
+}  // namespace flutter
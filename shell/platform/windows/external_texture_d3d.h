@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_WINDOWS_EXTERNAL_TEXTURE_D3D_H_
+#define FLUTTER_SHELL_PLATFORM_WINDOWS_EXTERNAL_TEXTURE_D3D_H_
+
+#include <stdint.h>
+
+#include "flutter/shell/platform/common/public/flutter_texture_registrar.h"
+#include "flutter/shell/platform/windows/angle_surface_manager.h"
+#include "flutter/shell/platform/windows/external_texture.h"
+#include "flutter/shell/platform/windows/external_texture_gl.h"
+
+namespace flutter {
+
+// An external texture backed by a D3D11 texture shared with the D3D11 device
+// of ANGLE, which is sampled without being copied through the CPU.
+class ExternalTextureD3d : public ExternalTexture {
+ public:
+  ExternalTextureD3d(
+      FlutterDesktopGpuSurfaceType type,
+      const FlutterDesktopGpuSurfaceTextureCallback texture_callback,
+      void* user_data,
+      AngleSurfaceManager* surface_manager,
+      const GlProcs& gl_procs);
+  virtual ~ExternalTextureD3d();
+
+  // Prevent copying.
+  ExternalTextureD3d(ExternalTextureD3d const&) = delete;
+  ExternalTextureD3d& operator=(ExternalTextureD3d const&) = delete;
+
+  // Attempts to populate the specified |opengl_texture| with the surface
+  // described by the descriptor returned by |texture_callback_|.
+  // Returns true on success or false if the surface could not be imported.
+  bool PopulateTexture(size_t width,
+                       size_t height,
+                       FlutterOpenGLTexture* opengl_texture) override;
+
+ private:
+  // Wraps the surface described by |descriptor| in an EGL surface and binds
+  // it to a texture, unless it already is. Returns false on failure.
+  bool CreateOrUpdateTexture(
+      const FlutterDesktopGpuSurfaceDescriptor* descriptor);
+
+  // Returns the shared handle of the surface described by |descriptor|, or
+  // nullptr.
+  HANDLE GetSharedHandle(
+      const FlutterDesktopGpuSurfaceDescriptor* descriptor) const;
+
+  // Returns whether the surface with the shared |handle| has a keyed mutex.
+  bool HasKeyedMutex(HANDLE handle) const;
+
+  // Copies the surface into copy_texture_ while ANGLE holds its keyed mutex.
+  void CopySurface();
+
+  // Releases the EGL surface and the textures.
+  void ReleaseSurface();
+
+  FlutterDesktopGpuSurfaceType type_;
+  FlutterDesktopGpuSurfaceTextureCallback texture_callback_;
+  void* user_data_;
+  AngleSurfaceManager* surface_manager_;
+  const GlProcs& gl_;
+
+  // The shared handle of the surface wrapped by egl_surface_.
+  HANDLE last_handle_ = nullptr;
+  size_t surface_width_ = 0;
+  size_t surface_height_ = 0;
+  EGLSurface egl_surface_ = EGL_NO_SURFACE;
+
+  // Texture that egl_surface_ is bound to.
+  GLuint surface_texture_ = 0;
+
+  // Whether the surface has a keyed mutex, in which case it is only bound
+  // while being copied into copy_texture_.
+  bool keyed_mutex_ = false;
+  GLuint copy_texture_ = 0;
+  GLuint copy_framebuffer_ = 0;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_WINDOWS_EXTERNAL_TEXTURE_D3D_H_
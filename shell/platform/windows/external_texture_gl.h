@@ -11,6 +11,7 @@
 
 #include "flutter/shell/platform/common/public/flutter_texture_registrar.h"
 #include "flutter/shell/platform/embedder/embedder.h"
+#include "flutter/shell/platform/windows/external_texture.h"
 
 #include <GLES2/gl2.h>
 #include <GLES2/gl2ext.h>
@@ -32,6 +33,24 @@ typedef void (*glTexImage2DProc)(GLenum target,
                                  GLenum format,
                                  GLenum type,
                                  const void* data);
+typedef void (*glGenFramebuffersProc)(GLsizei n, GLuint* framebuffers);
+typedef void (*glDeleteFramebuffersProc)(GLsizei n,
+                                         const GLuint* framebuffers);
+typedef void (*glBindFramebufferProc)(GLenum target, GLuint framebuffer);
+typedef void (*glFramebufferTexture2DProc)(GLenum target,
+                                           GLenum attachment,
+                                           GLenum textarget,
+                                           GLuint texture,
+                                           GLint level);
+typedef void (*glCopyTexImage2DProc)(GLenum target,
+                                     GLint level,
+                                     GLenum internalformat,
+                                     GLint x,
+                                     GLint y,
+                                     GLsizei width,
+                                     GLsizei height,
+                                     GLint border);
+typedef void (*glGetIntegervProc)(GLenum pname, GLint* data);
 
 // A struct containing pointers to resolved gl* functions.
 struct GlProcs {
@@ -40,11 +59,17 @@ struct GlProcs {
   glBindTextureProc glBindTexture;
   glTexParameteriProc glTexParameteri;
   glTexImage2DProc glTexImage2D;
+  glGenFramebuffersProc glGenFramebuffers;
+  glDeleteFramebuffersProc glDeleteFramebuffers;
+  glBindFramebufferProc glBindFramebuffer;
+  glFramebufferTexture2DProc glFramebufferTexture2D;
+  glCopyTexImage2DProc glCopyTexImage2D;
+  glGetIntegervProc glGetIntegerv;
   bool valid;
 };
 
-// An abstraction of an OpenGL texture.
-class ExternalTextureGL {
+// An abstraction of an OpenGL texture backed by a pixel buffer.
+class ExternalTextureGL : public ExternalTexture {
  public:
   ExternalTextureGL(FlutterDesktopPixelBufferTextureCallback texture_callback,
                     void* user_data,
@@ -52,9 +77,6 @@ class ExternalTextureGL {
 
   virtual ~ExternalTextureGL();
 
-  // Returns the unique id of this texture.
-  int64_t texture_id() { return reinterpret_cast<int64_t>(this); }
-
   void MarkFrameAvailable();
 
   // Attempts to populate the specified |opengl_texture| with texture details
@@ -63,7 +85,7 @@ class ExternalTextureGL {
   // Returns true on success or false if the pixel buffer could not be copied.
   bool PopulateTexture(size_t width,
                        size_t height,
-                       FlutterOpenGLTexture* opengl_texture);
+                       FlutterOpenGLTexture* opengl_texture) override;
 
  private:
   // Attempts to copy the pixel buffer returned by |texture_callback_| to
@@ -24,18 +24,15 @@ FlutterPlatformNodeDelegateWin32::~FlutterPlatformNodeDelegateWin32() {
   }
 }
 
-// |ui::AXPlatformNodeDelegate|
-void FlutterPlatformNodeDelegateWin32::Init(std::weak_ptr<OwnerBridge> bridge,
-                                            ui::AXNode* node) {
-  FlutterPlatformNodeDelegate::Init(bridge, node);
-  ax_platform_node_ = ui::AXPlatformNode::Create(this);
-  assert(ax_platform_node_);
-}
-
 // |ui::AXPlatformNodeDelegate|
 gfx::NativeViewAccessible
 FlutterPlatformNodeDelegateWin32::GetNativeViewAccessible() {
-  assert(ax_platform_node_);
+  // Platform nodes are created when assistive technologies first reach this
+  // node, rather than for every node in the tree.
+  if (!ax_platform_node_) {
+    ax_platform_node_ = ui::AXPlatformNode::Create(this);
+    assert(ax_platform_node_);
+  }
   return ax_platform_node_->GetNativeViewAccessible();
 }
 
@@ -68,7 +65,10 @@ gfx::NativeViewAccessible FlutterPlatformNodeDelegateWin32::HitTestSync(
   }
 
   // If no children contain the point, but this node does, return this node.
-  return ax_platform_node_->GetNativeViewAccessible();
+  // Hit testing is how assistive technologies reach nodes they haven't seen
+  // yet, so the platform node may have to be created here.
+  return const_cast<FlutterPlatformNodeDelegateWin32*>(this)
+      ->GetNativeViewAccessible();
 }
 
 // |FlutterPlatformNodeDelegate|
@@ -96,7 +96,8 @@ void FlutterPlatformNodeDelegateWin32::DispatchWinAccessibilityEvent(
   if (!hwnd) {
     return;
   }
-  assert(ax_platform_node_);
+  // The event refers to the platform node, so it has to exist.
+  GetNativeViewAccessible();
   ::NotifyWinEvent(event_type, hwnd, OBJID_CLIENT,
                    -ax_platform_node_->GetUniqueId());
 }
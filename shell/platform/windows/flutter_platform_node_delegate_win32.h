@@ -23,9 +23,6 @@ class FlutterPlatformNodeDelegateWin32 : public FlutterPlatformNodeDelegate {
   explicit FlutterPlatformNodeDelegateWin32(FlutterWindowsEngine* engine);
   virtual ~FlutterPlatformNodeDelegateWin32();
 
-  // |ui::AXPlatformNodeDelegate|
-  void Init(std::weak_ptr<OwnerBridge> bridge, ui::AXNode* node) override;
-
   // |ui::AXPlatformNodeDelegate|
   gfx::NativeViewAccessible GetNativeViewAccessible() override;
 
@@ -50,7 +47,8 @@ class FlutterPlatformNodeDelegateWin32 : public FlutterPlatformNodeDelegate {
   void SetFocus();
 
  private:
-  ui::AXPlatformNode* ax_platform_node_;
+  // Created by the first call to GetNativeViewAccessible.
+  ui::AXPlatformNode* ax_platform_node_ = nullptr;
   FlutterWindowsEngine* engine_;
 };
 
@@ -23,18 +23,15 @@ FlutterPlatformNodeDelegateWinUWP::~FlutterPlatformNodeDelegateWinUWP() {
   }
 }
 
-// |ui::AXPlatformNodeDelegate|
-void FlutterPlatformNodeDelegateWinUWP::Init(std::weak_ptr<OwnerBridge> bridge,
-                                             ui::AXNode* node) {
-  FlutterPlatformNodeDelegate::Init(bridge, node);
-  ax_platform_node_ = ui::AXPlatformNode::Create(this);
-  assert(ax_platform_node_);
-}
-
 // |ui::AXPlatformNodeDelegate|
 gfx::NativeViewAccessible
 FlutterPlatformNodeDelegateWinUWP::GetNativeViewAccessible() {
-  assert(ax_platform_node_);
+  // Platform nodes are created when assistive technologies first reach this
+  // node, rather than for every node in the tree.
+  if (!ax_platform_node_) {
+    ax_platform_node_ = ui::AXPlatformNode::Create(this);
+    assert(ax_platform_node_);
+  }
   return ax_platform_node_->GetNativeViewAccessible();
 }
 
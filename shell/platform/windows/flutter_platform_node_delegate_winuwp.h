@@ -22,9 +22,6 @@ class FlutterPlatformNodeDelegateWinUWP : public FlutterPlatformNodeDelegate {
   explicit FlutterPlatformNodeDelegateWinUWP(FlutterWindowsEngine* engine);
   virtual ~FlutterPlatformNodeDelegateWinUWP();
 
-  // |ui::AXPlatformNodeDelegate|
-  void Init(std::weak_ptr<OwnerBridge> bridge, ui::AXNode* node) override;
-
   // |ui::AXPlatformNodeDelegate|
   gfx::NativeViewAccessible GetNativeViewAccessible() override;
 
@@ -38,7 +35,8 @@ class FlutterPlatformNodeDelegateWinUWP : public FlutterPlatformNodeDelegate {
       ui::AXOffscreenResult* offscreen_result) const override;
 
  private:
-  ui::AXPlatformNode* ax_platform_node_;
+  // Created by the first call to GetNativeViewAccessible.
+  ui::AXPlatformNode* ax_platform_node_ = nullptr;
   FlutterWindowsEngine* engine_;
 };
 
@@ -50,12 +50,21 @@ FlutterRendererConfig GetOpenGLRendererConfig() {
     }
     return host->view()->ClearContext();
   };
-  config.open_gl.present = [](void* user_data) -> bool {
+  config.open_gl.present_with_info =
+      [](void* user_data, const FlutterPresentInfo* info) -> bool {
     auto host = static_cast<FlutterWindowsEngine*>(user_data);
     if (!host->view()) {
       return false;
     }
-    return host->view()->SwapBuffers();
+    return host->view()->SwapBuffers(info->frame_damage);
+  };
+  config.open_gl.populate_existing_damage =
+      [](void* user_data, const intptr_t fbo_id,
+         FlutterDamage* existing_damage) {
+    auto host = static_cast<FlutterWindowsEngine*>(user_data);
+    if (host->view()) {
+      host->view()->PopulateExistingDamage(existing_damage);
+    }
   };
   config.open_gl.fbo_reset_after_present = true;
   config.open_gl.fbo_with_frame_info_callback =
@@ -177,6 +186,12 @@ FlutterWindowsEngine::FlutterWindowsEngine(const FlutterProjectBundle& project)
 #ifndef WINUWP
   window_proc_delegate_manager_ =
       std::make_unique<WindowProcDelegateManagerWin32>();
+  vsync_waiter_ = std::make_unique<VsyncWaiterWin32>(
+      [this](std::chrono::nanoseconds refresh_period) {
+        // The engine must be handed the baton on the platform thread.
+        task_runner_->PostTask(
+            [this, refresh_period]() { DeliverVsync(refresh_period); });
+      });
 #endif
 
   // Set up internal channels.
@@ -287,6 +302,12 @@ bool FlutterWindowsEngine::RunWithEntrypoint(const char* entrypoint) {
       };
 
   args.custom_task_runners = &custom_task_runners;
+#ifndef WINUWP
+  args.vsync_callback = [](void* user_data, intptr_t baton) {
+    auto host = static_cast<FlutterWindowsEngine*>(user_data);
+    host->OnVsyncRequested(baton);
+  };
+#endif
 
   if (aot_data_) {
     args.aot_data = aot_data_.get();
@@ -308,6 +329,9 @@ bool FlutterWindowsEngine::RunWithEntrypoint(const char* entrypoint) {
   }
 
   SendSystemSettings();
+#ifndef WINUWP
+  SendDisplays();
+#endif
 
   return true;
 }
@@ -317,6 +341,11 @@ bool FlutterWindowsEngine::Stop() {
     if (plugin_registrar_destruction_callback_) {
       plugin_registrar_destruction_callback_(plugin_registrar_.get());
     }
+#ifndef WINUWP
+    // All batons must be returned before shutting down.
+    DeliverVsync(VsyncWaiterWin32::GetRefreshPeriod(
+        MonitorFromPoint({0, 0}, MONITOR_DEFAULTTOPRIMARY)));
+#endif
     FlutterEngineResult result = embedder_api_.Shutdown(engine_);
     engine_ = nullptr;
     return (result == kSuccess);
@@ -326,8 +355,63 @@ bool FlutterWindowsEngine::Stop() {
 
 void FlutterWindowsEngine::SetView(FlutterWindowsView* view) {
   view_ = view;
+#ifndef WINUWP
+  if (vsync_waiter_) {
+    vsync_waiter_->SetWindow(view ? view->GetPlatformWindow() : nullptr);
+  }
+#endif
+}
+
+#ifndef WINUWP
+void FlutterWindowsEngine::OnVsyncRequested(intptr_t baton) {
+  {
+    std::lock_guard<std::mutex> lock(vsync_mutex_);
+    vsync_baton_ = baton;
+  }
+  vsync_waiter_->AwaitVsync();
 }
 
+void FlutterWindowsEngine::DeliverVsync(
+    std::chrono::nanoseconds refresh_period) {
+  intptr_t baton;
+  {
+    std::lock_guard<std::mutex> lock(vsync_mutex_);
+    baton = vsync_baton_;
+    vsync_baton_ = 0;
+  }
+  if (baton == 0 || !engine_) {
+    return;
+  }
+
+  uint64_t frame_start_time_nanos = embedder_api_.GetCurrentTime();
+  uint64_t frame_target_time_nanos =
+      frame_start_time_nanos + refresh_period.count();
+  if (embedder_api_.OnVsync(engine_, baton, frame_start_time_nanos,
+                            frame_target_time_nanos) != kSuccess) {
+    std::cerr << "Failed to deliver vsync to Flutter engine." << std::endl;
+  }
+}
+
+void FlutterWindowsEngine::SendDisplays() {
+  HMONITOR monitor =
+      view_ ? MonitorFromWindow(view_->GetPlatformWindow(),
+                                MONITOR_DEFAULTTOPRIMARY)
+            : MonitorFromPoint({0, 0}, MONITOR_DEFAULTTOPRIMARY);
+  std::chrono::nanoseconds refresh_period =
+      VsyncWaiterWin32::GetRefreshPeriod(monitor);
+
+  // Other monitors are followed through the vsync intervals as the window
+  // moves between them.
+  FlutterEngineDisplay display = {};
+  display.struct_size = sizeof(FlutterEngineDisplay);
+  display.display_id = reinterpret_cast<FlutterEngineDisplayId>(monitor);
+  display.single_display = true;
+  display.refresh_rate = 1e9 / refresh_period.count();
+  embedder_api_.NotifyDisplayUpdate(
+      engine_, kFlutterEngineDisplaysUpdateTypeStartup, &display, 1);
+}
+#endif
+
 // Returns the currently configured Plugin Registrar.
 FlutterDesktopPluginRegistrarRef FlutterWindowsEngine::GetRegistrar() {
   return plugin_registrar_.get();
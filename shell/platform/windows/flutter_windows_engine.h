@@ -5,8 +5,10 @@
 #ifndef FLUTTER_SHELL_PLATFORM_WINDOWS_FLUTTER_WINDOWS_ENGINE_H_
 #define FLUTTER_SHELL_PLATFORM_WINDOWS_FLUTTER_WINDOWS_ENGINE_H_
 
+#include <chrono>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <vector>
 
@@ -24,6 +26,7 @@
 #include "third_party/rapidjson/include/rapidjson/document.h"
 
 #ifndef WINUWP
+#include "flutter/shell/platform/windows/vsync_waiter_win32.h"  // nogncheck
 #include "flutter/shell/platform/windows/window_proc_delegate_manager_win32.h"  // nogncheck
 #endif
 
@@ -167,6 +170,19 @@ class FlutterWindowsEngine {
   // Allows swapping out embedder_api_ calls in tests.
   friend class EngineModifier;
 
+#ifndef WINUWP
+  // Called on an engine thread when the engine waits for the next vsync.
+  void OnVsyncRequested(intptr_t baton);
+
+  // Returns the pending vsync baton to the engine, with a frame interval of
+  // |refresh_period| starting now.
+  void DeliverVsync(std::chrono::nanoseconds refresh_period);
+
+  // Reports the refresh rate of the monitor showing the view, or of the
+  // primary monitor if there is no view.
+  void SendDisplays();
+#endif
+
   // Sends system settings (e.g., locale) to the engine.
   //
   // Should be called just after the engine is run, and after any relevant
@@ -227,6 +243,15 @@ class FlutterWindowsEngine {
 #ifndef WINUWP
   // The manager for WindowProc delegate registration and callbacks.
   std::unique_ptr<WindowProcDelegateManagerWin32> window_proc_delegate_manager_;
+
+  // Waits for the vertical blanks of the monitor showing the view.
+  std::unique_ptr<VsyncWaiterWin32> vsync_waiter_;
+
+  // Protects vsync_baton_, which is set on an engine thread.
+  std::mutex vsync_mutex_;
+
+  // Baton of the engine waiting for the next vsync, or 0.
+  intptr_t vsync_baton_ = 0;
 #endif
 };
 
@@ -53,6 +53,11 @@ TEST(FlutterWindowsEngine, RunDoesExpectedInitialization) {
         EXPECT_NE(config, nullptr);
         // We have an AngleSurfaceManager, so this should be using OpenGL.
         EXPECT_EQ(config->type, kOpenGL);
+        // Vsyncs come from the monitor showing the window.
+        EXPECT_NE(args->vsync_callback, nullptr);
+        // Frames are presented with their damage.
+        EXPECT_NE(config->open_gl.present_with_info, nullptr);
+        EXPECT_NE(config->open_gl.populate_existing_damage, nullptr);
         EXPECT_EQ(user_data, engine_instance);
         // Spot-check arguments.
         EXPECT_STREQ(args->assets_path, "C:\\foo\\flutter_assets");
@@ -93,6 +98,23 @@ TEST(FlutterWindowsEngine, RunDoesExpectedInitialization) {
         return kSuccess;
       }));
 
+  // And it should report the refresh rate of the display.
+  bool display_update_sent = false;
+  modifier.embedder_api().NotifyDisplayUpdate = MOCK_ENGINE_PROC(
+      NotifyDisplayUpdate,
+      ([&display_update_sent](auto engine,
+                              FlutterEngineDisplaysUpdateType update_type,
+                              const FlutterEngineDisplay* displays,
+                              size_t display_count) {
+        display_update_sent = true;
+
+        EXPECT_EQ(update_type, kFlutterEngineDisplaysUpdateTypeStartup);
+        EXPECT_EQ(display_count, 1U);
+        EXPECT_GT(displays[0].refresh_rate, 0);
+
+        return kSuccess;
+      }));
+
   // Set the AngleSurfaceManager to !nullptr to test ANGLE rendering.
   modifier.SetSurfaceManager(reinterpret_cast<AngleSurfaceManager*>(1));
 
@@ -101,6 +123,7 @@ TEST(FlutterWindowsEngine, RunDoesExpectedInitialization) {
   EXPECT_TRUE(run_called);
   EXPECT_TRUE(update_locales_called);
   EXPECT_TRUE(settings_message_sent);
+  EXPECT_TRUE(display_update_sent);
 
   // Ensure that deallocation doesn't call the actual Shutdown with the bogus
   // engine pointer that the overridden Run returned.
@@ -134,6 +157,11 @@ TEST(FlutterWindowsEngine, RunWithoutANGLEUsesSoftware) {
   modifier.embedder_api().SendPlatformMessage =
       MOCK_ENGINE_PROC(SendPlatformMessage,
                        ([](auto engine, auto message) { return kSuccess; }));
+  modifier.embedder_api().NotifyDisplayUpdate = MOCK_ENGINE_PROC(
+      NotifyDisplayUpdate,
+      ([](auto engine, FlutterEngineDisplaysUpdateType update_type,
+          const FlutterEngineDisplay* displays,
+          size_t display_count) { return kSuccess; }));
 
   // Set the AngleSurfaceManager to nullptr to test software fallback path.
   modifier.SetSurfaceManager(nullptr);
@@ -4,6 +4,8 @@
 
 #include "flutter/shell/platform/windows/flutter_windows_texture_registrar.h"
 
+#include "flutter/shell/platform/embedder/embedder_struct_macros.h"
+#include "flutter/shell/platform/windows/external_texture_d3d.h"
 #include "flutter/shell/platform/windows/flutter_windows_engine.h"
 
 #include <iostream>
@@ -22,25 +24,55 @@ int64_t FlutterWindowsTextureRegistrar::RegisterTexture(
     return -1;
   }
 
-  if (texture_info->type != kFlutterDesktopPixelBufferTexture) {
-    std::cerr << "Attempted to register texture of unsupport type."
-              << std::endl;
-    return -1;
-  }
+  if (texture_info->type == kFlutterDesktopPixelBufferTexture) {
+    if (!texture_info->pixel_buffer_config.callback) {
+      std::cerr << "Invalid pixel buffer texture callback." << std::endl;
+      return -1;
+    }
 
-  if (!texture_info->pixel_buffer_config.callback) {
-    std::cerr << "Invalid pixel buffer texture callback." << std::endl;
-    return -1;
+    return EmplaceTexture(std::make_unique<flutter::ExternalTextureGL>(
+        texture_info->pixel_buffer_config.callback,
+        texture_info->pixel_buffer_config.user_data, gl_procs_));
+  } else if (texture_info->type == kFlutterDesktopGpuSurfaceTexture) {
+    const FlutterDesktopGpuSurfaceTextureConfig* gpu_surface_config =
+        &texture_info->gpu_surface_config;
+    auto surface_type = SAFE_ACCESS(gpu_surface_config, type,
+                                    kFlutterDesktopGpuSurfaceTypeNone);
+    if (surface_type != kFlutterDesktopGpuSurfaceTypeDxgiSharedHandle &&
+        surface_type != kFlutterDesktopGpuSurfaceTypeD3d11Texture2D) {
+      std::cerr << "Unsupported GPU surface type." << std::endl;
+      return -1;
+    }
+
+    auto callback = SAFE_ACCESS(gpu_surface_config, callback, nullptr);
+    if (!callback) {
+      std::cerr << "Invalid GPU surface descriptor callback." << std::endl;
+      return -1;
+    }
+
+    // GPU surfaces are imported through ANGLE, which isn't used when
+    // rendering in software.
+    if (!engine_->surface_manager()) {
+      std::cerr << "GPU surface textures require ANGLE." << std::endl;
+      return -1;
+    }
+
+    auto user_data = SAFE_ACCESS(gpu_surface_config, user_data, nullptr);
+    return EmplaceTexture(std::make_unique<flutter::ExternalTextureD3d>(
+        surface_type, callback, user_data, engine_->surface_manager(),
+        gl_procs_));
   }
 
-  auto texture_gl = std::make_unique<flutter::ExternalTextureGL>(
-      texture_info->pixel_buffer_config.callback,
-      texture_info->pixel_buffer_config.user_data, gl_procs_);
-  int64_t texture_id = texture_gl->texture_id();
+  std::cerr << "Attempted to register texture of unsupport type." << std::endl;
+  return -1;
+}
 
+int64_t FlutterWindowsTextureRegistrar::EmplaceTexture(
+    std::unique_ptr<ExternalTexture> texture) {
+  int64_t texture_id = texture->texture_id();
   {
     std::lock_guard<std::mutex> lock(map_mutex_);
-    textures_[texture_id] = std::move(texture_gl);
+    textures_[texture_id] = std::move(texture);
   }
 
   engine_->task_runner()->RunNowOrPostTask([engine = engine_, texture_id]() {
@@ -79,7 +111,7 @@ bool FlutterWindowsTextureRegistrar::PopulateTexture(
     size_t width,
     size_t height,
     FlutterOpenGLTexture* opengl_texture) {
-  flutter::ExternalTextureGL* texture;
+  flutter::ExternalTexture* texture;
   {
     std::lock_guard<std::mutex> lock(map_mutex_);
     auto it = textures_.find(texture_id);
@@ -102,10 +134,25 @@ void FlutterWindowsTextureRegistrar::ResolveGlFunctions(GlProcs& procs) {
       eglGetProcAddress("glTexParameteri"));
   procs.glTexImage2D =
       reinterpret_cast<glTexImage2DProc>(eglGetProcAddress("glTexImage2D"));
+  procs.glGenFramebuffers = reinterpret_cast<glGenFramebuffersProc>(
+      eglGetProcAddress("glGenFramebuffers"));
+  procs.glDeleteFramebuffers = reinterpret_cast<glDeleteFramebuffersProc>(
+      eglGetProcAddress("glDeleteFramebuffers"));
+  procs.glBindFramebuffer = reinterpret_cast<glBindFramebufferProc>(
+      eglGetProcAddress("glBindFramebuffer"));
+  procs.glFramebufferTexture2D = reinterpret_cast<glFramebufferTexture2DProc>(
+      eglGetProcAddress("glFramebufferTexture2D"));
+  procs.glCopyTexImage2D = reinterpret_cast<glCopyTexImage2DProc>(
+      eglGetProcAddress("glCopyTexImage2D"));
+  procs.glGetIntegerv =
+      reinterpret_cast<glGetIntegervProc>(eglGetProcAddress("glGetIntegerv"));
 
   procs.valid = procs.glGenTextures && procs.glDeleteTextures &&
                 procs.glBindTexture && procs.glTexParameteri &&
-                procs.glTexImage2D;
+                procs.glTexImage2D && procs.glGenFramebuffers &&
+                procs.glDeleteFramebuffers && procs.glBindFramebuffer &&
+                procs.glFramebufferTexture2D && procs.glCopyTexImage2D &&
+                procs.glGetIntegerv;
 }
 
 };  // namespace flutter
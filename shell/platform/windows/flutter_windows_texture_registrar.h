@@ -9,6 +9,8 @@
 #include <mutex>
 #include <unordered_map>
 
+#include "flutter/shell/platform/common/public/flutter_texture_registrar.h"
+#include "flutter/shell/platform/windows/external_texture.h"
 #include "flutter/shell/platform/windows/external_texture_gl.h"
 
 namespace flutter {
@@ -46,11 +48,14 @@ class FlutterWindowsTextureRegistrar {
   static void ResolveGlFunctions(GlProcs& gl_procs);
 
  private:
+  // Registers |texture| and returns its id.
+  int64_t EmplaceTexture(std::unique_ptr<ExternalTexture> texture);
+
   FlutterWindowsEngine* engine_ = nullptr;
   const GlProcs& gl_procs_;
 
   // All registered textures, keyed by their IDs.
-  std::unordered_map<int64_t, std::unique_ptr<flutter::ExternalTextureGL>>
+  std::unordered_map<int64_t, std::unique_ptr<flutter::ExternalTexture>>
       textures_;
   std::mutex map_mutex_;
 };
@@ -105,6 +105,33 @@ TEST(FlutterWindowsTextureRegistrarTest, RegisterUnknownTextureType) {
   EXPECT_EQ(texture_id, -1);
 }
 
+TEST(FlutterWindowsTextureRegistrarTest, RegisterInvalidGpuSurfaceTexture) {
+  std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
+  std::unique_ptr<MockGlFunctions> gl = std::make_unique<MockGlFunctions>();
+
+  FlutterWindowsTextureRegistrar registrar(engine.get(), gl->gl_procs());
+
+  FlutterDesktopTextureInfo texture_info = {};
+  texture_info.type = kFlutterDesktopGpuSurfaceTexture;
+  texture_info.gpu_surface_config.struct_size =
+      sizeof(FlutterDesktopGpuSurfaceTextureConfig);
+  texture_info.gpu_surface_config.type =
+      kFlutterDesktopGpuSurfaceTypeDxgiSharedHandle;
+
+  // A descriptor callback is required.
+  EXPECT_EQ(registrar.RegisterTexture(&texture_info), -1);
+
+  texture_info.gpu_surface_config.callback =
+      [](size_t width, size_t height,
+         void* user_data) -> const FlutterDesktopGpuSurfaceDescriptor* {
+    return nullptr;
+  };
+  texture_info.gpu_surface_config.type = kFlutterDesktopGpuSurfaceTypeNone;
+
+  // So is a known surface type.
+  EXPECT_EQ(registrar.RegisterTexture(&texture_info), -1);
+}
+
 TEST(FlutterWindowsTextureRegistrarTest, PopulatePixelBufferTexture) {
   std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
   EngineModifier modifier(engine.get());
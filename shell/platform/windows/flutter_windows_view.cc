@@ -4,7 +4,9 @@
 
 #include "flutter/shell/platform/windows/flutter_windows_view.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 
 #include "flutter/shell/platform/common/accessibility_bridge.h"
 #include "flutter/shell/platform/windows/keyboard_key_channel_handler.h"
@@ -489,7 +491,7 @@ bool FlutterWindowsView::ClearContext() {
   return engine_->surface_manager()->ClearContext();
 }
 
-bool FlutterWindowsView::SwapBuffers() {
+bool FlutterWindowsView::SwapBuffers(const FlutterDamage& frame_damage) {
   // Called on an engine-controlled (non-platform) thread.
   std::unique_lock<std::mutex> lock(resize_mutex_);
 
@@ -507,20 +509,53 @@ bool FlutterWindowsView::SwapBuffers() {
       // SwapBuffers waits for vsync and there's no point doing that for
       // invisible windows.
       if (visible) {
-        swap_buffers_result = engine_->surface_manager()->SwapBuffers();
+        swap_buffers_result = PresentFrame(frame_damage);
       }
       resize_status_ = ResizeState::kDone;
       lock.unlock();
       resize_cv_.notify_all();
       binding_handler_->OnWindowResized();
       if (!visible) {
-        swap_buffers_result = engine_->surface_manager()->SwapBuffers();
+        swap_buffers_result = PresentFrame(frame_damage);
       }
       return swap_buffers_result;
     }
     case ResizeState::kDone:
     default:
-      return engine_->surface_manager()->SwapBuffers();
+      return PresentFrame(frame_damage);
+  }
+}
+
+bool FlutterWindowsView::PresentFrame(const FlutterDamage& frame_damage) {
+  AngleSurfaceManager* surface_manager = engine_->surface_manager();
+  if (frame_damage.damage == nullptr || frame_damage.num_rects == 0) {
+    return surface_manager->SwapBuffers();
+  }
+
+  FlutterRect bounds = frame_damage.damage[0];
+  for (size_t i = 1; i < frame_damage.num_rects; i++) {
+    const FlutterRect& rect = frame_damage.damage[i];
+    bounds.left = std::min(bounds.left, rect.left);
+    bounds.top = std::min(bounds.top, rect.top);
+    bounds.right = std::max(bounds.right, rect.right);
+    bounds.bottom = std::max(bounds.bottom, rect.bottom);
+  }
+  EGLint left = static_cast<EGLint>(std::floor(bounds.left));
+  EGLint top = static_cast<EGLint>(std::floor(bounds.top));
+  EGLint right = static_cast<EGLint>(std::ceil(bounds.right));
+  EGLint bottom = static_cast<EGLint>(std::ceil(bounds.bottom));
+  return surface_manager->SwapBuffers(left, top, right - left, bottom - top);
+}
+
+void FlutterWindowsView::PopulateExistingDamage(
+    FlutterDamage* existing_damage) {
+  // A preserved surface holds the last frame presented, so it has no damage
+  // of its own. Otherwise the damage is left null and the whole frame is
+  // repainted.
+  static FlutterRect no_damage = {};
+  if (engine_->surface_manager()->SurfaceContentsPreserved()) {
+    existing_damage->num_rects = 0;
+    existing_damage->damage = &no_damage;
   }
 }
 
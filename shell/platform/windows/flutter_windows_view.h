@@ -77,7 +77,11 @@ class FlutterWindowsView : public WindowBindingHandlerDelegate,
   bool ClearContext();
   bool MakeCurrent();
   bool MakeResourceCurrent();
-  bool SwapBuffers();
+  bool SwapBuffers(const FlutterDamage& frame_damage);
+
+  // Sets the region of the render surface that differs from the last frame
+  // presented, which the engine repaints along with the damage of the frame.
+  void PopulateExistingDamage(FlutterDamage* existing_damage);
 
   // Callback for presenting a software bitmap.
   bool PresentSoftwareBitmap(const void* allocation,
@@ -311,6 +315,10 @@ class FlutterWindowsView : public WindowBindingHandlerDelegate,
   // Reports platform brightness change to Flutter engine.
   void SendPlatformBrightnessChanged();
 
+  // Presents the frame rendered into the render surface, limited to the
+  // region that changed since the last frame when possible.
+  bool PresentFrame(const FlutterDamage& frame_damage);
+
   // Currently configured WindowsRenderTarget for this view used by
   // surface_manager for creation of render surfaces and bound to the physical
   // os window.
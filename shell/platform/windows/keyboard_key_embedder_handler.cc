@@ -9,6 +9,7 @@
 
 #include <chrono>
 #include <iostream>
+#include <iterator>
 #include <string>
 
 #include "flutter/shell/platform/windows/keyboard_win32_common.h"
@@ -34,35 +35,43 @@ const char* empty_character = "";
 char _GetBit(char32_t ch, size_t start, size_t end) {
   return (ch >> end) & ((1 << (start - end)) - 1);
 }
-}  // namespace
 
-std::string ConvertChar32ToUtf8(char32_t ch) {
-  std::string result;
+// Encodes |ch| in UTF-8 into |out|, which must hold at least 4 bytes, and
+// returns the number of bytes written.
+size_t EncodeUtf8(char32_t ch, char* out) {
   assert(0 <= ch && ch <= 0x10FFFF);
   if (ch <= 0x007F) {
-    result.push_back(ch);
+    out[0] = ch;
+    return 1;
   } else if (ch <= 0x07FF) {
-    result.push_back(0b11000000 + _GetBit(ch, 11, 6));
-    result.push_back(0b10000000 + _GetBit(ch, 6, 0));
+    out[0] = 0b11000000 + _GetBit(ch, 11, 6);
+    out[1] = 0b10000000 + _GetBit(ch, 6, 0);
+    return 2;
   } else if (ch <= 0xFFFF) {
-    result.push_back(0b11100000 + _GetBit(ch, 16, 12));
-    result.push_back(0b10000000 + _GetBit(ch, 12, 6));
-    result.push_back(0b10000000 + _GetBit(ch, 6, 0));
+    out[0] = 0b11100000 + _GetBit(ch, 16, 12);
+    out[1] = 0b10000000 + _GetBit(ch, 12, 6);
+    out[2] = 0b10000000 + _GetBit(ch, 6, 0);
+    return 3;
   } else {
-    result.push_back(0b11110000 + _GetBit(ch, 21, 18));
-    result.push_back(0b10000000 + _GetBit(ch, 18, 12));
-    result.push_back(0b10000000 + _GetBit(ch, 12, 6));
-    result.push_back(0b10000000 + _GetBit(ch, 6, 0));
+    out[0] = 0b11110000 + _GetBit(ch, 21, 18);
+    out[1] = 0b10000000 + _GetBit(ch, 18, 12);
+    out[2] = 0b10000000 + _GetBit(ch, 12, 6);
+    out[3] = 0b10000000 + _GetBit(ch, 6, 0);
+    return 4;
   }
-  return result;
+}
+}  // namespace
+
+std::string ConvertChar32ToUtf8(char32_t ch) {
+  char bytes[4];
+  return std::string(bytes, EncodeUtf8(ch, bytes));
 }
 
 KeyboardKeyEmbedderHandler::KeyboardKeyEmbedderHandler(
     SendEventHandler send_event,
     GetKeyStateHandler get_key_state)
     : perform_send_event_(send_event),
-      get_key_state_(get_key_state),
-      response_id_(1) {
+      get_key_state_(get_key_state) {
   InitCriticalKeys();
 }
 
@@ -115,9 +124,9 @@ uint64_t KeyboardKeyEmbedderHandler::ApplyPlaneToId(uint64_t id,
 uint64_t KeyboardKeyEmbedderHandler::GetPhysicalKey(int scancode,
                                                     bool extended) {
   int chromiumScancode = normalizeScancode(scancode, extended);
-  auto resultIt = windowsToPhysicalMap_.find(chromiumScancode);
-  if (resultIt != windowsToPhysicalMap_.end())
-    return resultIt->second;
+  uint64_t physical_key;
+  if (windowsToPhysicalMap_.Find(chromiumScancode, &physical_key))
+    return physical_key;
   return ApplyPlaneToId(scancode, windowsPlane);
 }
 
@@ -131,15 +140,14 @@ uint64_t KeyboardKeyEmbedderHandler::GetLogicalKey(int key,
   // Normally logical keys should only be derived from key codes, but since some
   // key codes are either 0 or ambiguous (multiple keys using the same key
   // code), these keys are resolved by scan codes.
-  auto numpadIter =
-      scanCodeToLogicalMap_.find(normalizeScancode(scancode, extended));
-  if (numpadIter != scanCodeToLogicalMap_.cend())
-    return numpadIter->second;
+  uint64_t logical_key;
+  if (scanCodeToLogicalMap_.Find(normalizeScancode(scancode, extended),
+                                 &logical_key))
+    return logical_key;
 
   // Check if the keyCode is one we know about and have a mapping for.
-  auto logicalIt = windowsToLogicalMap_.find(key);
-  if (logicalIt != windowsToLogicalMap_.cend())
-    return logicalIt->second;
+  if (windowsToLogicalMap_.Find(key, &logical_key))
+    return logical_key;
 
   // Upper case letters should be normalized into lower case letters.
   if (isEasciiPrintable(key)) {
@@ -272,24 +280,17 @@ void KeyboardKeyEmbedderHandler::KeyboardHookImpl(
       .synthesized = false,
   };
 
-  response_id_ += 1;
-  uint64_t response_id = response_id_;
-  PendingResponse pending{
-      .callback =
-          [this, callback = std::move(callback)](bool handled,
-                                                 uint64_t response_id) {
-            auto found = pending_responses_.find(response_id);
-            if (found != pending_responses_.end()) {
-              pending_responses_.erase(found);
-            }
-            callback(handled);
-          },
-      .response_id = response_id,
-  };
-  auto pending_ptr = std::make_unique<PendingResponse>(std::move(pending));
-  pending_responses_[response_id] = std::move(pending_ptr);
+  if (free_responses_.empty()) {
+    free_responses_.emplace_back();
+  }
+  pending_responses_.splice(pending_responses_.end(), free_responses_,
+                            free_responses_.begin());
+  PendingResponse& pending = pending_responses_.back();
+  pending.handler = this;
+  pending.callback = std::move(callback);
+  pending.position = std::prev(pending_responses_.end());
   SendEvent(key_data, KeyboardKeyEmbedderHandler::HandleResponse,
-            reinterpret_cast<void*>(pending_responses_[response_id].get()));
+            reinterpret_cast<void*>(&pending));
 }
 
 void KeyboardKeyEmbedderHandler::KeyboardHook(
@@ -423,7 +424,10 @@ void KeyboardKeyEmbedderHandler::SynchronizeCritialPressedStates(
 void KeyboardKeyEmbedderHandler::HandleResponse(bool handled, void* user_data) {
   PendingResponse* pending = reinterpret_cast<PendingResponse*>(user_data);
   auto callback = std::move(pending->callback);
-  callback(handled, pending->response_id);
+  KeyboardKeyEmbedderHandler* self = pending->handler;
+  self->free_responses_.splice(self->free_responses_.end(),
+                               self->pending_responses_, pending->position);
+  callback(handled);
 }
 
 void KeyboardKeyEmbedderHandler::InitCriticalKeys() {
@@ -468,12 +472,9 @@ void KeyboardKeyEmbedderHandler::InitCriticalKeys() {
 }
 
 void KeyboardKeyEmbedderHandler::ConvertUtf32ToUtf8_(char* out, char32_t ch) {
-  if (ch == 0) {
-    out[0] = '\0';
-    return;
-  }
-  std::string result = ConvertChar32ToUtf8(ch);
-  strcpy_s(out, kCharacterCacheSize, result.c_str());
+  // Encoded in place, as this runs for every key event.
+  size_t length = ch == 0 ? 0 : EncodeUtf8(ch, out);
+  out[length] = '\0';
 }
 
 FlutterKeyEvent KeyboardKeyEmbedderHandler::SynthesizeSimpleEvent(
@@ -6,10 +6,12 @@
 #define FLUTTER_SHELL_PLATFORM_WINDOWS_KEYBOARD_KEY_EMBEDDER_HANDLER_H_
 
 #include <functional>
+#include <list>
 #include <map>
 #include <memory>
 #include <string>
 
+#include "flutter/shell/platform/common/static_key_map.h"
 #include "flutter/shell/platform/embedder/embedder.h"
 #include "flutter/shell/platform/windows/keyboard_key_handler.h"
 
@@ -65,8 +67,10 @@ class KeyboardKeyEmbedderHandler
 
  private:
   struct PendingResponse {
-    std::function<void(bool, uint64_t)> callback;
-    uint64_t response_id;
+    KeyboardKeyEmbedderHandler* handler;
+    std::function<void(bool)> callback;
+    // The position of this response in |pending_responses_|.
+    std::list<PendingResponse>::iterator position;
   };
 
   // The information for a virtual key that's important enough that its
@@ -126,11 +130,11 @@ class KeyboardKeyEmbedderHandler
   // key.
   std::map<uint64_t, uint64_t> pressingRecords_;
   // Information for key events that have been sent to the framework but yet
-  // to receive the response. Indexed by response IDs.
-  std::map<uint64_t, std::unique_ptr<PendingResponse>> pending_responses_;
-  // A self-incrementing integer, used as the ID for the next entry for
-  // |pending_responses_|.
-  uint64_t response_id_;
+  // to receive the response.
+  std::list<PendingResponse> pending_responses_;
+  // Entries moved out of |pending_responses_| once responded to, whose nodes
+  // are reused so that sending events doesn't allocate.
+  std::list<PendingResponse> free_responses_;
   // Whether any events has been sent with |PerformSendEvent| during a
   // |KeyboardHook|.
   bool sent_any_events;
@@ -152,9 +156,9 @@ class KeyboardKeyEmbedderHandler
                                                const char* character);
   static uint64_t ApplyPlaneToId(uint64_t id, uint64_t plane);
 
-  static std::map<uint64_t, uint64_t> windowsToPhysicalMap_;
-  static std::map<uint64_t, uint64_t> windowsToLogicalMap_;
-  static std::map<uint64_t, uint64_t> scanCodeToLogicalMap_;
+  static const StaticKeyMap windowsToPhysicalMap_;
+  static const StaticKeyMap windowsToLogicalMap_;
+  static const StaticKeyMap scanCodeToLogicalMap_;
 
   // Mask for the 32-bit value portion of the key code.
   static const uint64_t valueMask;
@@ -9,56 +9,71 @@
 
 namespace flutter {
 
+namespace {
+
+// The longest time |ProcessTasks()| keeps running expired tasks for, so that
+// bursts of tasks don't starve input processing for more than half a frame.
+constexpr std::chrono::milliseconds kTaskProcessingBudget(8);
+
+}  // namespace
+
 TaskRunner::TaskRunner(CurrentTimeProc get_current_time,
                        const TaskExpiredCallback& on_task_expired)
     : get_current_time_(get_current_time),
       on_task_expired_(std::move(on_task_expired)) {}
 
+TaskRunner::~TaskRunner() {
+  SubmittedTask* submitted = submitted_tasks_.exchange(nullptr);
+  while (submitted) {
+    SubmittedTask* next = submitted->next;
+    delete submitted;
+    submitted = next;
+  }
+}
+
 std::chrono::nanoseconds TaskRunner::ProcessTasks() {
   const TaskTimePoint now = GetCurrentTimeForTask();
-
-  std::vector<Task> expired_tasks;
-
-  // Process expired tasks.
-  {
-    std::lock_guard<std::mutex> lock(task_queue_mutex_);
-    while (!task_queue_.empty()) {
-      const auto& top = task_queue_.top();
-      // If this task (and all tasks after this) has not yet expired, there is
-      // nothing more to do. Quit iterating.
-      if (top.fire_time > now) {
-        break;
-      }
-
-      // Make a record of the expired task. Do NOT service the task here
-      // because we are still holding onto the task queue mutex. We don't want
-      // other threads to block on posting tasks onto this thread till we are
-      // done processing expired tasks.
-      expired_tasks.push_back(task_queue_.top());
-
-      // Remove the tasks from the delayed tasks queue.
-      task_queue_.pop();
+  const auto budget_end =
+      std::chrono::steady_clock::now() + kTaskProcessingBudget;
+
+  // Tasks posted from now on, including by the tasks run below, are left for
+  // the next call.
+  DrainSubmittedTasks();
+
+  // Process expired tasks. Each task is removed from the queue before it is
+  // run, as a task that spins a nested message loop processes tasks
+  // re-entrantly.
+  while (!task_queue_.empty() && task_queue_.top().fire_time <= now) {
+    Task task = task_queue_.top();
+    task_queue_.pop();
+    if (auto flutter_task = std::get_if<FlutterTask>(&task.variant)) {
+      on_task_expired_(flutter_task);
+    } else if (auto closure = std::get_if<TaskClosure>(&task.variant)) {
+      (*closure)();
     }
-  }
 
-  // Fire expired tasks.
-  {
-    // Flushing tasks here without holing onto the task queue mutex.
-    for (const auto& task : expired_tasks) {
-      if (auto flutter_task = std::get_if<FlutterTask>(&task.variant)) {
-        on_task_expired_(flutter_task);
-      } else if (auto closure = std::get_if<TaskClosure>(&task.variant))
-        (*closure)();
+    if (std::chrono::steady_clock::now() >= budget_end) {
+      break;
     }
   }
 
   // Calculate duration to sleep for on next iteration.
-  {
-    std::lock_guard<std::mutex> lock(task_queue_mutex_);
-    const auto next_wake = task_queue_.empty() ? TaskTimePoint::max()
-                                               : task_queue_.top().fire_time;
+  const auto next_wake = task_queue_.empty() ? TaskTimePoint::max()
+                                             : task_queue_.top().fire_time;
+  if (next_wake <= now) {
+    return std::chrono::nanoseconds::zero();
+  }
+  return std::min(next_wake - now, std::chrono::nanoseconds::max());
+}
 
-    return std::min(next_wake - now, std::chrono::nanoseconds::max());
+void TaskRunner::DrainSubmittedTasks() {
+  SubmittedTask* submitted =
+      submitted_tasks_.exchange(nullptr, std::memory_order_acquire);
+  while (submitted) {
+    SubmittedTask* next = submitted->next;
+    task_queue_.push(std::move(submitted->task));
+    delete submitted;
+    submitted = next;
   }
 }
 
@@ -88,14 +103,14 @@ void TaskRunner::EnqueueTask(Task task) {
   static std::atomic_uint64_t sGlobalTaskOrder(0);
 
   task.order = ++sGlobalTaskOrder;
-  {
-    std::lock_guard<std::mutex> lock(task_queue_mutex_);
-    task_queue_.push(task);
-
-    // Make sure the queue mutex is unlocked before waking up the loop. In case
-    // the wake causes this thread to be descheduled for the primary thread to
-    // process tasks, the acquisition of the lock on that thread while holding
-    // the lock here momentarily till the end of the scope is a pessimization.
+
+  // Tasks are ordered by |order| once drained, so pushing them onto a stack
+  // doesn't reorder them.
+  auto submitted = new SubmittedTask{std::move(task), nullptr};
+  submitted->next = submitted_tasks_.load(std::memory_order_relaxed);
+  while (!submitted_tasks_.compare_exchange_weak(submitted->next, submitted,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed)) {
   }
 
   WakeUp();
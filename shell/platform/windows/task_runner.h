@@ -5,11 +5,11 @@
 #ifndef FLUTTER_SHELL_PLATFORM_WINDOWS_TASK_RUNNER_H_
 #define FLUTTER_SHELL_PLATFORM_WINDOWS_TASK_RUNNER_H_
 
+#include <atomic>
 #include <chrono>
 #include <deque>
 #include <functional>
 #include <memory>
-#include <mutex>
 #include <queue>
 #include <variant>
 
@@ -25,7 +25,7 @@ class TaskRunner {
   using TaskExpiredCallback = std::function<void(const FlutterTask*)>;
   using TaskClosure = std::function<void()>;
 
-  virtual ~TaskRunner() = default;
+  virtual ~TaskRunner();
 
   // Returns `true` if the current thread is this runner's thread.
   virtual bool RunsTasksOnCurrentThread() const = 0;
@@ -60,9 +60,13 @@ class TaskRunner {
   // Schedules timers to call `ProcessTasks()` at the runner's thread.
   virtual void WakeUp() = 0;
 
-  // Executes expired task, and returns the duration until the next task
+  // Executes expired tasks, and returns the duration until the next task
   // deadline if exists, otherwise returns `std::chrono::nanoseconds::max()`.
   //
+  // Stops early once tasks have run for longer than a frame budget, in which
+  // case the remaining expired tasks are left for the next call and zero is
+  // returned, so that the caller gets to process input in between.
+  //
   // Each platform implementations must call this to schedule the tasks.
   std::chrono::nanoseconds ProcessTasks();
 
@@ -92,16 +96,30 @@ class TaskRunner {
     };
   };
 
+  // A task posted from any thread, waiting to be moved to |task_queue_|.
+  struct SubmittedTask {
+    Task task;
+    SubmittedTask* next;
+  };
+
   // Enqueues the given task.
   void EnqueueTask(Task task);
 
+  // Moves the tasks submitted since the last call to |task_queue_|.
+  void DrainSubmittedTasks();
+
   // Returns a TaskTimePoint computed from the given target time from Flutter.
   TaskTimePoint TimePointFromFlutterTime(
       uint64_t flutter_target_time_nanos) const;
 
   CurrentTimeProc get_current_time_;
   TaskExpiredCallback on_task_expired_;
-  std::mutex task_queue_mutex_;
+
+  // Lock-free stack of tasks posted since the last |ProcessTasks()|, most
+  // recent first.
+  std::atomic<SubmittedTask*> submitted_tasks_{nullptr};
+
+  // Tasks waiting to expire. Only accessed by the runner's thread.
   std::priority_queue<Task, std::deque<Task>, Task::Comparer> task_queue_;
 
   TaskRunner(const TaskRunner&) = delete;
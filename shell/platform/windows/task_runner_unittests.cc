@@ -4,6 +4,8 @@
 
 #include "flutter/shell/platform/windows/task_runner.h"
 
+#include <thread>
+
 #include "gtest/gtest.h"
 
 namespace flutter {
@@ -18,7 +20,7 @@ class MockTaskRunner : public TaskRunner {
 
   virtual bool RunsTasksOnCurrentThread() const override { return true; }
 
-  void SimulateTimerAwake() { ProcessTasks(); }
+  std::chrono::nanoseconds SimulateTimerAwake() { return ProcessTasks(); }
 
  protected:
   virtual void WakeUp() override {
@@ -84,5 +86,70 @@ TEST(TaskRunnerTest, MaybeExecuteTaskOnlyExpired) {
   EXPECT_EQ(executed_task, only_task_expired_before_now);
 }
 
+TEST(TaskRunnerTest, TasksPostedWhileProcessingRunOnNextWakeUp) {
+  std::vector<uint64_t> executed_task_order;
+  auto runner = MockTaskRunner(MockGetCurrentTime, [](const FlutterTask*) {});
+
+  runner.PostTask([&runner, &executed_task_order]() {
+    executed_task_order.push_back(1);
+    runner.PostTask(
+        [&executed_task_order]() { executed_task_order.push_back(2); });
+  });
+
+  runner.SimulateTimerAwake();
+  EXPECT_EQ(executed_task_order, std::vector<uint64_t>{1});
+
+  runner.SimulateTimerAwake();
+  std::vector<uint64_t> posted_task_order{1, 2};
+  EXPECT_EQ(executed_task_order, posted_task_order);
+}
+
+TEST(TaskRunnerTest, ProcessingYieldsOnceOverBudget) {
+  std::vector<uint64_t> executed_task_order;
+  auto runner = MockTaskRunner(MockGetCurrentTime, [](const FlutterTask*) {});
+
+  // Each task takes longer than the processing budget of a wake-up.
+  for (uint64_t i = 1; i <= 2; i++) {
+    runner.PostTask([&executed_task_order, i]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      executed_task_order.push_back(i);
+    });
+  }
+
+  EXPECT_EQ(runner.SimulateTimerAwake(), std::chrono::nanoseconds::zero());
+  EXPECT_EQ(executed_task_order, std::vector<uint64_t>{1});
+
+  EXPECT_GT(runner.SimulateTimerAwake(), std::chrono::nanoseconds::zero());
+  std::vector<uint64_t> posted_task_order{1, 2};
+  EXPECT_EQ(executed_task_order, posted_task_order);
+}
+
+TEST(TaskRunnerTest, PostTaskFromManyThreads) {
+  std::set<uint64_t> executed_task;
+  auto runner = MockTaskRunner(
+      MockGetCurrentTime, [&executed_task](const FlutterTask* expired_task) {
+        executed_task.insert(expired_task->task);
+      });
+
+  constexpr uint64_t kThreadCount = 4;
+  constexpr uint64_t kTasksPerThread = 1000;
+  std::vector<std::thread> threads;
+  for (uint64_t i = 0; i < kThreadCount; i++) {
+    threads.emplace_back([&runner, i]() {
+      for (uint64_t j = 0; j < kTasksPerThread; j++) {
+        runner.PostFlutterTask(FlutterTask{nullptr, i * kTasksPerThread + j},
+                               MockGetCurrentTime());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  while (runner.SimulateTimerAwake() == std::chrono::nanoseconds::zero()) {
+  }
+  EXPECT_EQ(executed_task.size(), kThreadCount * kTasksPerThread);
+}
+
 }  // namespace testing
 }  // namespace flutter
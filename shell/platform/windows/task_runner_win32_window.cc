@@ -52,7 +52,13 @@ TaskRunnerWin32Window::GetSharedInstance() {
 }
 
 void TaskRunnerWin32Window::WakeUp() {
+  // Posted messages are retrieved ahead of input, so posting one per task
+  // would let a burst of tasks hold up input processing.
+  if (wake_up_pending_.exchange(true)) {
+    return;
+  }
   if (!PostMessage(window_handle_, WM_NULL, 0, 0)) {
+    wake_up_pending_ = false;
     std::cerr << "Failed to post message to main thread." << std::endl;
   }
 }
@@ -114,8 +120,13 @@ TaskRunnerWin32Window::HandleMessage(UINT const message,
                                      WPARAM const wparam,
                                      LPARAM const lparam) noexcept {
   switch (message) {
-    case WM_TIMER:
     case WM_NULL:
+      // Cleared ahead of processing, so that tasks posted from here on wake
+      // the loop up again.
+      wake_up_pending_ = false;
+      ProcessTasks();
+      return 0;
+    case WM_TIMER:
       ProcessTasks();
       return 0;
   }
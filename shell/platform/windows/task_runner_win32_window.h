@@ -7,6 +7,7 @@
 
 #include <windows.h>
 
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <string>
@@ -24,7 +25,8 @@ class TaskRunnerWin32Window {
 
   static std::shared_ptr<TaskRunnerWin32Window> GetSharedInstance();
 
-  // Triggers processing delegate tasks on main thread
+  // Triggers processing delegate tasks on main thread. Wake-ups requested
+  // before the main thread gets to process tasks are coalesced.
   void WakeUp();
 
   void AddDelegate(Delegate* delegate);
@@ -53,6 +55,8 @@ class TaskRunnerWin32Window {
 
   HWND window_handle_;
   std::wstring window_class_name_;
+  // Whether a wake-up message is posted but not processed yet.
+  std::atomic<bool> wake_up_pending_{false};
   std::vector<Delegate*> delegates_;
 };
 }  // namespace flutter
@@ -19,6 +19,12 @@ class MockGlFunctions {
     gl_procs_.glBindTexture = &glBindTexture;
     gl_procs_.glTexParameteri = &glTexParameteri;
     gl_procs_.glTexImage2D = &glTexImage2D;
+    gl_procs_.glGenFramebuffers = &glGenFramebuffers;
+    gl_procs_.glDeleteFramebuffers = &glDeleteFramebuffers;
+    gl_procs_.glBindFramebuffer = &glBindFramebuffer;
+    gl_procs_.glFramebufferTexture2D = &glFramebufferTexture2D;
+    gl_procs_.glCopyTexImage2D = &glCopyTexImage2D;
+    gl_procs_.glGetIntegerv = &glGetIntegerv;
     gl_procs_.valid = true;
   }
 
@@ -44,6 +50,29 @@ class MockGlFunctions {
                            GLenum type,
                            const void* data) {}
 
+  static void glGenFramebuffers(GLsizei n, GLuint* framebuffers) {
+    for (auto i = 0; i < n; i++) {
+      framebuffers[i] = i + 1;
+    }
+  }
+
+  static void glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {}
+  static void glBindFramebuffer(GLenum target, GLuint framebuffer) {}
+  static void glFramebufferTexture2D(GLenum target,
+                                     GLenum attachment,
+                                     GLenum textarget,
+                                     GLuint texture,
+                                     GLint level) {}
+  static void glCopyTexImage2D(GLenum target,
+                               GLint level,
+                               GLenum internalformat,
+                               GLint x,
+                               GLint y,
+                               GLsizei width,
+                               GLsizei height,
+                               GLint border) {}
+  static void glGetIntegerv(GLenum pname, GLint* data) { *data = 0; }
+
  private:
   GlProcs gl_procs_;
 };
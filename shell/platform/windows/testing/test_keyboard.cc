@@ -188,6 +188,10 @@ void MockEmbedderApiForKeyboard(
       [](auto engine, const FlutterWindowMetricsEvent* event) {
         return kSuccess;
       };
+  modifier.embedder_api().NotifyDisplayUpdate =
+      [](auto engine, FlutterEngineDisplaysUpdateType update_type,
+         const FlutterEngineDisplay* displays,
+         size_t display_count) { return kSuccess; };
   modifier.embedder_api().Shutdown = [](auto engine) { return kSuccess; };
 }
 
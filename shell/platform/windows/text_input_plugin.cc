@@ -8,6 +8,7 @@
 
 #include <cstdint>
 
+#include "flutter/fml/string_conversion.h"
 #include "flutter/shell/platform/common/json_method_codec.h"
 
 static constexpr char kSetEditingStateMethod[] = "TextInput.setEditingState";
@@ -23,9 +24,12 @@ static constexpr char kMultilineInputType[] = "TextInputType.multiline";
 
 static constexpr char kUpdateEditingStateMethod[] =
     "TextInputClient.updateEditingState";
+static constexpr char kUpdateEditingStateWithDeltasMethod[] =
+    "TextInputClient.updateEditingStateWithDeltas";
 static constexpr char kPerformActionMethod[] = "TextInputClient.performAction";
 
 static constexpr char kTextInputAction[] = "inputAction";
+static constexpr char kEnableDeltaModel[] = "enableDeltaModel";
 static constexpr char kTextInputType[] = "inputType";
 static constexpr char kTextInputTypeName[] = "name";
 static constexpr char kComposingBaseKey[] = "composingBase";
@@ -36,6 +40,11 @@ static constexpr char kSelectionBaseKey[] = "selectionBase";
 static constexpr char kSelectionExtentKey[] = "selectionExtent";
 static constexpr char kSelectionIsDirectionalKey[] = "selectionIsDirectional";
 static constexpr char kTextKey[] = "text";
+static constexpr char kDeltasKey[] = "deltas";
+static constexpr char kDeltaOldTextKey[] = "oldText";
+static constexpr char kDeltaTextKey[] = "deltaText";
+static constexpr char kDeltaStartKey[] = "deltaStart";
+static constexpr char kDeltaEndKey[] = "deltaEnd";
 static constexpr char kXKey[] = "x";
 static constexpr char kYKey[] = "y";
 static constexpr char kWidthKey[] = "width";
@@ -54,6 +63,17 @@ void TextInputPlugin::TextHook(const std::u16string& text) {
   if (active_model_ == nullptr) {
     return;
   }
+  if (enable_delta_model_) {
+    std::string text_before_change = active_model_->GetText();
+    TextRange range_before_change = active_model_->composing()
+                                        ? active_model_->composing_range()
+                                        : active_model_->selection();
+    active_model_->AddText(text);
+    SendStateUpdateWithDelta(
+        *active_model_, TextEditingDelta(fml::Utf8ToUtf16(text_before_change),
+                                         range_before_change, text));
+    return;
+  }
   active_model_->AddText(text);
   SendStateUpdate(*active_model_);
 }
@@ -103,6 +123,11 @@ void TextInputPlugin::ComposeBeginHook() {
     return;
   }
   active_model_->BeginComposing();
+  if (enable_delta_model_) {
+    SendStateUpdateWithDelta(*active_model_,
+                             TextEditingDelta(active_model_->GetText()));
+    return;
+  }
   SendStateUpdate(*active_model_);
 }
 
@@ -142,6 +167,11 @@ void TextInputPlugin::ComposeEndHook() {
   }
   active_model_->CommitComposing();
   active_model_->EndComposing();
+  if (enable_delta_model_) {
+    SendStateUpdateWithDelta(*active_model_,
+                             TextEditingDelta(active_model_->GetText()));
+    return;
+  }
   SendStateUpdate(*active_model_);
 }
 
@@ -150,10 +180,21 @@ void TextInputPlugin::ComposeChangeHook(const std::u16string& text,
   if (active_model_ == nullptr) {
     return;
   }
+  std::string text_before_change;
+  TextRange composing_before_change = active_model_->composing_range();
+  if (enable_delta_model_) {
+    text_before_change = active_model_->GetText();
+  }
   active_model_->AddText(text);
   cursor_pos += active_model_->composing_range().base();
   active_model_->UpdateComposingText(text);
   active_model_->SetSelection(TextRange(cursor_pos, cursor_pos));
+  if (enable_delta_model_) {
+    SendStateUpdateWithDelta(
+        *active_model_, TextEditingDelta(fml::Utf8ToUtf16(text_before_change),
+                                         composing_before_change, text));
+    return;
+  }
   SendStateUpdate(*active_model_);
 }
 
@@ -168,7 +209,12 @@ void TextInputPlugin::HandleMethodCall(
     if (active_model_ != nullptr && active_model_->composing()) {
       active_model_->CommitComposing();
       active_model_->EndComposing();
-      SendStateUpdate(*active_model_);
+      if (enable_delta_model_) {
+        SendStateUpdateWithDelta(*active_model_,
+                                 TextEditingDelta(active_model_->GetText()));
+      } else {
+        SendStateUpdate(*active_model_);
+      }
     }
     delegate_->OnResetImeComposing();
     active_model_ = nullptr;
@@ -208,6 +254,12 @@ void TextInputPlugin::HandleMethodCall(
         input_type_ = input_type_json->value.GetString();
       }
     }
+    enable_delta_model_ = false;
+    auto enable_delta_model_json = client_config.FindMember(kEnableDeltaModel);
+    if (enable_delta_model_json != client_config.MemberEnd() &&
+        enable_delta_model_json->value.IsBool()) {
+      enable_delta_model_ = enable_delta_model_json->value.GetBool();
+    }
     active_model_ = std::make_unique<TextInputModel>();
   } else if (method.compare(kSetEditingStateMethod) == 0) {
     if (!method_call.arguments() || method_call.arguments()->IsNull()) {
@@ -356,10 +408,57 @@ void TextInputPlugin::SendStateUpdate(const TextInputModel& model) {
   channel_->InvokeMethod(kUpdateEditingStateMethod, std::move(args));
 }
 
+void TextInputPlugin::SendStateUpdateWithDelta(const TextInputModel& model,
+                                               const TextEditingDelta& delta) {
+  auto args = std::make_unique<rapidjson::Document>(rapidjson::kArrayType);
+  auto& allocator = args->GetAllocator();
+  args->PushBack(client_id_, allocator);
+
+  rapidjson::Value object(rapidjson::kObjectType);
+  object.AddMember(kDeltaOldTextKey,
+                   rapidjson::Value(delta.old_text(), allocator).Move(),
+                   allocator);
+  object.AddMember(kDeltaTextKey,
+                   rapidjson::Value(delta.delta_text(), allocator).Move(),
+                   allocator);
+  object.AddMember(kDeltaStartKey, delta.delta_start(), allocator);
+  object.AddMember(kDeltaEndKey, delta.delta_end(), allocator);
+
+  TextRange selection = model.selection();
+  object.AddMember(kSelectionAffinityKey, kAffinityDownstream, allocator);
+  object.AddMember(kSelectionBaseKey, selection.base(), allocator);
+  object.AddMember(kSelectionExtentKey, selection.extent(), allocator);
+  object.AddMember(kSelectionIsDirectionalKey, false, allocator);
+
+  int composing_base = model.composing() ? model.composing_range().base() : -1;
+  int composing_extent =
+      model.composing() ? model.composing_range().extent() : -1;
+  object.AddMember(kComposingBaseKey, composing_base, allocator);
+  object.AddMember(kComposingExtentKey, composing_extent, allocator);
+
+  rapidjson::Value deltas(rapidjson::kArrayType);
+  deltas.PushBack(object, allocator);
+  rapidjson::Value deltas_value(rapidjson::kObjectType);
+  deltas_value.AddMember(kDeltasKey, deltas, allocator);
+  args->PushBack(deltas_value, allocator);
+
+  channel_->InvokeMethod(kUpdateEditingStateWithDeltasMethod, std::move(args));
+}
+
 void TextInputPlugin::EnterPressed(TextInputModel* model) {
   if (input_type_ == kMultilineInputType) {
-    model->AddText(std::u16string({u'\n'}));
-    SendStateUpdate(*model);
+    std::u16string text({u'\n'});
+    if (enable_delta_model_) {
+      std::string text_before_change = model->GetText();
+      TextRange selection_before_change = model->selection();
+      model->AddText(text);
+      SendStateUpdateWithDelta(
+          *model, TextEditingDelta(fml::Utf8ToUtf16(text_before_change),
+                                   selection_before_change, text));
+    } else {
+      model->AddText(text);
+      SendStateUpdate(*model);
+    }
   }
   auto args = std::make_unique<rapidjson::Document>(rapidjson::kArrayType);
   auto& allocator = args->GetAllocator();
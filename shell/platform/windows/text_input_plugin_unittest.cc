@@ -137,5 +137,52 @@ TEST(TextInputPluginTest, VerifyComposingSendStateUpdate) {
   EXPECT_TRUE(sent_message);
 }
 
+// Verify that text edits are sent as deltas to clients that enable the delta
+// model.
+TEST(TextInputPluginTest, SendsDeltasWhenDeltaModelIsEnabled) {
+  std::unique_ptr<MethodCall<rapidjson::Document>> sent_call;
+  TestBinaryMessenger messenger(
+      [&sent_call](const std::string& channel, const uint8_t* message,
+                   size_t message_size, BinaryReply reply) {
+        sent_call = JsonMethodCodec::GetInstance().DecodeMethodCall(
+            message, message_size);
+      });
+  BinaryReply reply_handler = [](const uint8_t* reply, size_t reply_size) {};
+
+  EmptyTextInputPluginDelegate delegate;
+  TextInputPlugin handler(&messenger, &delegate);
+
+  auto& codec = JsonMethodCodec::GetInstance();
+  auto arguments = std::make_unique<rapidjson::Document>(rapidjson::kArrayType);
+  auto& allocator = arguments->GetAllocator();
+  arguments->PushBack(42, allocator);
+  rapidjson::Value config(rapidjson::kObjectType);
+  config.AddMember("inputAction", "done", allocator);
+  config.AddMember("inputType", "text", allocator);
+  config.AddMember("enableDeltaModel", true, allocator);
+  arguments->PushBack(config, allocator);
+  auto message =
+      codec.EncodeMethodCall({"TextInput.setClient", std::move(arguments)});
+  messenger.SimulateEngineMessage("flutter/textinput", message->data(),
+                                  message->size(), reply_handler);
+
+  handler.TextHook(u"abc");
+  handler.TextHook(u"d");
+
+  ASSERT_TRUE(sent_call);
+  EXPECT_EQ(sent_call->method_name(),
+            "TextInputClient.updateEditingStateWithDeltas");
+  const rapidjson::Document& args = *sent_call->arguments();
+  EXPECT_EQ(args[0].GetInt(), 42);
+  const rapidjson::Value& delta = args[1]["deltas"][0];
+  EXPECT_STREQ(delta["oldText"].GetString(), "abc");
+  EXPECT_STREQ(delta["deltaText"].GetString(), "d");
+  EXPECT_EQ(delta["deltaStart"].GetInt(), 3);
+  EXPECT_EQ(delta["deltaEnd"].GetInt(), 3);
+  EXPECT_EQ(delta["selectionBase"].GetInt(), 4);
+  EXPECT_EQ(delta["selectionExtent"].GetInt(), 4);
+  EXPECT_EQ(delta["composingBase"].GetInt(), -1);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -0,0 +1,132 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/windows/vsync_waiter_win32.h"
+
+#include <dwmapi.h>
+
+namespace flutter {
+
+namespace {
+
+// The refresh period assumed for monitors that don't report their rate.
+constexpr std::chrono::nanoseconds kDefaultRefreshPeriod(1000000000 / 60);
+
+}  // namespace
+
+VsyncWaiterWin32::VsyncWaiterWin32(VsyncCallback callback)
+    : callback_(std::move(callback)),
+      refresh_period_(kDefaultRefreshPeriod) {
+  thread_ = std::thread([this]() { ThreadMain(); });
+}
+
+VsyncWaiterWin32::~VsyncWaiterWin32() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutting_down_ = true;
+  }
+  cv_.notify_one();
+  thread_.join();
+}
+
+void VsyncWaiterWin32::SetWindow(HWND window) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  window_ = window;
+}
+
+void VsyncWaiterWin32::AwaitVsync() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    vsync_requested_ = true;
+  }
+  cv_.notify_one();
+}
+
+// static
+std::chrono::nanoseconds VsyncWaiterWin32::GetRefreshPeriod(HMONITOR monitor) {
+  MONITORINFOEXW monitor_info = {};
+  monitor_info.cbSize = sizeof(monitor_info);
+  if (!GetMonitorInfoW(monitor, &monitor_info)) {
+    return kDefaultRefreshPeriod;
+  }
+
+  DEVMODEW mode = {};
+  mode.dmSize = sizeof(mode);
+  // A frequency of 0 or 1 stands for the default rate of the hardware.
+  if (!EnumDisplaySettingsW(monitor_info.szDevice, ENUM_CURRENT_SETTINGS,
+                            &mode) ||
+      mode.dmDisplayFrequency <= 1) {
+    return kDefaultRefreshPeriod;
+  }
+  return std::chrono::nanoseconds(1000000000 / mode.dmDisplayFrequency);
+}
+
+void VsyncWaiterWin32::ThreadMain() {
+  while (true) {
+    HWND window;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this]() { return vsync_requested_ || shutting_down_; });
+      if (shutting_down_) {
+        return;
+      }
+      vsync_requested_ = false;
+      window = window_;
+    }
+
+    // Windows can move between monitors with different refresh rates, so the
+    // monitor is looked up for every frame.
+    HMONITOR monitor =
+        window ? MonitorFromWindow(window, MONITOR_DEFAULTTOPRIMARY)
+               : MonitorFromPoint({0, 0}, MONITOR_DEFAULTTOPRIMARY);
+    WaitForVBlank(monitor);
+    callback_(refresh_period_);
+  }
+}
+
+void VsyncWaiterWin32::WaitForVBlank(HMONITOR monitor) {
+  if (monitor != monitor_ || !factory_ || !factory_->IsCurrent()) {
+    UpdateOutput(monitor);
+  }
+
+  if (output_ && SUCCEEDED(output_->WaitForVBlank())) {
+    return;
+  }
+
+  // Without an output, wait for the next composition of the desktop window
+  // manager, which is paced by the primary monitor.
+  if (SUCCEEDED(DwmFlush())) {
+    return;
+  }
+  std::this_thread::sleep_for(refresh_period_);
+}
+
+void VsyncWaiterWin32::UpdateOutput(HMONITOR monitor) {
+  monitor_ = monitor;
+  output_.Reset();
+  refresh_period_ = GetRefreshPeriod(monitor);
+
+  if (!factory_ || !factory_->IsCurrent()) {
+    factory_.Reset();
+    if (FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&factory_)))) {
+      return;
+    }
+  }
+
+  Microsoft::WRL::ComPtr<IDXGIAdapter1> adapter;
+  for (UINT i = 0; factory_->EnumAdapters1(i, &adapter) != DXGI_ERROR_NOT_FOUND;
+       i++) {
+    Microsoft::WRL::ComPtr<IDXGIOutput> output;
+    for (UINT j = 0; adapter->EnumOutputs(j, &output) != DXGI_ERROR_NOT_FOUND;
+         j++) {
+      DXGI_OUTPUT_DESC desc;
+      if (SUCCEEDED(output->GetDesc(&desc)) && desc.Monitor == monitor) {
+        output_ = output;
+        return;
+      }
+    }
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_WINDOWS_VSYNC_WAITER_WIN32_H_
+#define FLUTTER_SHELL_PLATFORM_WINDOWS_VSYNC_WAITER_WIN32_H_
+
+#include <dxgi.h>
+#include <windows.h>
+#include <wrl/client.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace flutter {
+
+// Waits for the vertical blanks of the monitor showing a window on a
+// dedicated thread.
+//
+// Each call to AwaitVsync is answered by a single call to the callback, made
+// on the waiter thread right after the next vertical blank of the monitor
+// the window is on, along with the refresh period of that monitor.
+class VsyncWaiterWin32 {
+ public:
+  using VsyncCallback = std::function<void(std::chrono::nanoseconds)>;
+
+  explicit VsyncWaiterWin32(VsyncCallback callback);
+
+  // Stops the waiter thread. A pending request is dropped.
+  ~VsyncWaiterWin32();
+
+  // Prevent copying.
+  VsyncWaiterWin32(VsyncWaiterWin32 const&) = delete;
+  VsyncWaiterWin32& operator=(VsyncWaiterWin32 const&) = delete;
+
+  // Sets the window whose monitor is followed. If null, the primary monitor
+  // is followed.
+  void SetWindow(HWND window);
+
+  // Requests a call to the callback after the next vertical blank.
+  void AwaitVsync();
+
+  // Returns the refresh period of |monitor|, or of a 60Hz monitor if it is
+  // unknown.
+  static std::chrono::nanoseconds GetRefreshPeriod(HMONITOR monitor);
+
+ private:
+  // Runs on the waiter thread.
+  void ThreadMain();
+
+  // Waits for the next vertical blank of |monitor|.
+  void WaitForVBlank(HMONITOR monitor);
+
+  // Finds the DXGI output of |monitor| and caches its refresh period.
+  void UpdateOutput(HMONITOR monitor);
+
+  VsyncCallback callback_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+
+  // Protected by mutex_.
+  HWND window_ = nullptr;
+  bool vsync_requested_ = false;
+  bool shutting_down_ = false;
+
+  // Only accessed on the waiter thread.
+  Microsoft::WRL::ComPtr<IDXGIFactory1> factory_;
+  Microsoft::WRL::ComPtr<IDXGIOutput> output_;
+  HMONITOR monitor_ = nullptr;
+  std::chrono::nanoseconds refresh_period_;
+
+  std::thread thread_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_WINDOWS_VSYNC_WAITER_WIN32_H_
@@ -0,0 +1,47 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/windows/vsync_waiter_win32.h"
+
+#include <condition_variable>
+#include <mutex>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(VsyncWaiterWin32Test, CallsBackOncePerRequest) {
+  std::mutex mutex;
+  std::condition_variable cv;
+  int vsync_count = 0;
+  std::chrono::nanoseconds period;
+  VsyncWaiterWin32 waiter([&](std::chrono::nanoseconds refresh_period) {
+    std::lock_guard<std::mutex> lock(mutex);
+    vsync_count++;
+    period = refresh_period;
+    cv.notify_one();
+  });
+
+  waiter.AwaitVsync();
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(5),
+                            [&]() { return vsync_count == 1; }));
+    EXPECT_GT(period.count(), 0);
+  }
+
+  // No further vsyncs are delivered without a new request.
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  std::lock_guard<std::mutex> lock(mutex);
+  EXPECT_EQ(vsync_count, 1);
+}
+
+TEST(VsyncWaiterWin32Test, PrimaryMonitorHasRefreshPeriod) {
+  HMONITOR monitor = MonitorFromPoint({0, 0}, MONITOR_DEFAULTTOPRIMARY);
+  EXPECT_GT(VsyncWaiterWin32::GetRefreshPeriod(monitor).count(), 0);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -18,11 +18,11 @@ class MockTaskRunner : public fml::TaskRunner {
   inline static RefPtr<MockTaskRunner> Create() {
     return AdoptRef(new MockTaskRunner());
   }
-  MOCK_METHOD1(PostTask, void(const fml::closure& task));
+  MOCK_METHOD1(PostTask, void(fml::UniqueClosure task));
   MOCK_METHOD2(PostTaskForTime,
-               void(const fml::closure& task, fml::TimePoint target_time));
+               void(fml::UniqueClosure task, fml::TimePoint target_time));
   MOCK_METHOD2(PostDelayedTask,
-               void(const fml::closure& task, fml::TimeDelta delay));
+               void(fml::UniqueClosure task, fml::TimeDelta delay));
   MOCK_METHOD0(RunsTasksOnCurrentThread, bool());
   MOCK_METHOD0(GetTaskQueueId, TaskQueueId());
 
@@ -44,9 +44,9 @@ TEST(SamplingProfilerTest, DeleteAfterStart) {
   // Dart.
   EXPECT_CALL(*task_runner, PostDelayedTask(_, _))
       .WillRepeatedly(
-          Invoke([&](const fml::closure& task, fml::TimeDelta delay) {
+          Invoke([&](fml::UniqueClosure task, fml::TimeDelta delay) {
             invoke_count.fetch_add(1);
-            thread->GetTaskRunner()->PostTask(task);
+            thread->GetTaskRunner()->PostTask(std::move(task));
           }));
 
   {
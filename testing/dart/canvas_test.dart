@@ -312,4 +312,37 @@ void main() {
     }
     expect(areEqual, true);
   });
+
+  test('drawBatch draws the same as the individual calls', () async {
+    final Paint paint = Paint()..color = const Color(0xFF00FF00);
+    final Paint strokePaint = Paint()
+      ..color = const Color(0xFF0000FF)
+      ..strokeWidth = 3.0;
+    void draw(Canvas canvas, bool batched) {
+      final CanvasBatch batch = CanvasBatch();
+      for (int i = 0; i < 100; i++) {
+        final double offset = (i % 10) * 10.0;
+        // Changing the paint between the shapes must not change the shapes
+        // that were already added.
+        paint.color = Color(0xFF000000 | (i * 0x020305));
+        if (batched) {
+          batch.addRect(Rect.fromLTWH(offset, offset, 8, 8), paint);
+          batch.addLine(Offset(offset, 0), Offset(0, offset), strokePaint);
+          batch.addCircle(Offset(100 - offset, offset), 4, paint);
+        } else {
+          canvas.drawRect(Rect.fromLTWH(offset, offset, 8, 8), paint);
+          canvas.drawLine(Offset(offset, 0), Offset(0, offset), strokePaint);
+          canvas.drawCircle(Offset(100 - offset, offset), 4, paint);
+        }
+      }
+      if (batched) {
+        expect(batch.length, 300);
+        canvas.drawBatch(batch);
+      }
+    }
+
+    final Image individual = await toImage((Canvas canvas) => draw(canvas, false), 100, 100);
+    final Image batched = await toImage((Canvas canvas) => draw(canvas, true), 100, 100);
+    expect(await fuzzyCompareImages(individual, batched), true);
+  });
 }
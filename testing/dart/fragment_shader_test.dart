@@ -45,6 +45,18 @@ void main() {
     _expectShaderRendersGreen(shader);
   });
 
+  test('warmed up shader renders green', () async {
+    final ByteBuffer spirv = spvFile('general_shaders', 'functions.spv').readAsBytesSync().buffer;
+    final FragmentProgram program = await FragmentProgram.compile(
+      spirv: spirv,
+    );
+    await program.warmUp(floatUniforms: Float32List.fromList(<double>[0]));
+    final Shader shader = program.shader(
+      floatUniforms: Float32List.fromList(<double>[1]),
+    );
+    await _expectShaderRendersGreen(shader);
+  });
+
   test('blue-green image renders green', () async {
     final ByteBuffer spirv = spvFile('general_shaders', 'blue_green_sampler.spv').readAsBytesSync().buffer;
     final FragmentProgram program = await FragmentProgram.compile(
@@ -37,6 +37,43 @@ void main() {
     expect(codec.frameCount, 1);
   });
 
+  test('image descriptor - encoded - source rect', () async {
+    final Uint8List bytes = await readFile('square.png');
+    final ImmutableBuffer buffer = await ImmutableBuffer.fromUint8List(bytes);
+    final ImageDescriptor descriptor = await ImageDescriptor.encoded(buffer);
+
+    final Codec codec = await descriptor.instantiateCodec(
+      sourceRect: const Rect.fromLTWH(2.5, 0, 4, 10),
+    );
+    final FrameInfo frame = await codec.getNextFrame();
+    expect(frame.image.width, 5);
+    expect(frame.image.height, 10);
+  });
+
+  test('image descriptor - encoded - source rect outside of the image', () async {
+    final Uint8List bytes = await readFile('square.png');
+    final ImmutableBuffer buffer = await ImmutableBuffer.fromUint8List(bytes);
+    final ImageDescriptor descriptor = await ImageDescriptor.encoded(buffer);
+
+    Object? error;
+    try {
+      await descriptor.instantiateCodec(sourceRect: const Rect.fromLTWH(20, 20, 4, 4));
+    } catch (e) {
+      error = e;
+    }
+    expect(error is ArgumentError, true);
+  });
+
+  test('immutable buffer - asset - missing', () async {
+    Object? error;
+    try {
+      await ImmutableBuffer.fromAsset('flutter/this/asset/does/not/exist.png');
+    } catch (e) {
+      error = e;
+    }
+    expect(error is Exception, true);
+  });
+
   test('basic image descriptor - encoded - animated', () async {
     final Uint8List bytes = await _getSkiaResource('test640x479.gif').readAsBytes();
     final ImmutableBuffer buffer = await ImmutableBuffer.fromUint8List(bytes);
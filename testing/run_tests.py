@@ -252,6 +252,13 @@ def RunEngineBenchmarks(build_dir, filter):
   if IsLinux():
     RunEngineExecutable(build_dir, 'txt_benchmarks', filter, icu_flags)
 
+    RunEngineExecutable(build_dir, 'common_cpp_benchmarks', filter)
+
+    RunEngineExecutable(build_dir, 'flutter_linux_benchmarks', filter)
+
+  if IsMac():
+    RunEngineExecutable(build_dir, 'accessibility_benchmarks', filter)
+
 
 def RunDartTest(build_dir, test_packages, dart_file, verbose_dart_snapshot, multithreaded,
                 enable_observatory=False, expect_failure=False):
@@ -71,25 +71,52 @@ std::string IntVectorToString(const std::vector<int>& items) {
   return str;
 }
 
-// Predicate that returns true if the first value of a pair is |first|.
+// Predicate that returns true if the first value of |pair| is less than
+// |first|. Attributes are kept sorted by this order, so that they can be found
+// with a binary search.
 template <typename FirstType, typename SecondType>
-struct FirstIs {
-  explicit FirstIs(FirstType first) : first_(first) {}
-  bool operator()(std::pair<FirstType, SecondType> const& p) {
-    return p.first == first_;
-  }
-  FirstType first_;
-};
+bool FirstIsLess(const std::pair<FirstType, SecondType>& pair,
+                 FirstType first) {
+  return pair.first < first;
+}
 
-// Helper function that finds a key in a vector of pairs by matching on the
-// first value, and returns an iterator.
+// Helper function that finds a key in a sorted vector of pairs by matching on
+// the first value, and returns an iterator.
 template <typename FirstType, typename SecondType>
 typename std::vector<std::pair<FirstType, SecondType>>::const_iterator
 FindInVectorOfPairs(
     FirstType first,
     const std::vector<std::pair<FirstType, SecondType>>& vector) {
-  return std::find_if(vector.begin(), vector.end(),
-                      FirstIs<FirstType, SecondType>(first));
+  auto iter = std::lower_bound(vector.begin(), vector.end(), first,
+                               FirstIsLess<FirstType, SecondType>);
+  if (iter != vector.end() && iter->first == first)
+    return iter;
+  return vector.end();
+}
+
+// Helper function that sets the value of a key in a sorted vector of pairs,
+// inserting the key where it keeps the vector sorted if it's missing.
+template <typename FirstType, typename SecondType>
+void AddToVectorOfPairs(FirstType first,
+                        const SecondType& second,
+                        std::vector<std::pair<FirstType, SecondType>>& vector) {
+  auto iter = std::lower_bound(vector.begin(), vector.end(), first,
+                               FirstIsLess<FirstType, SecondType>);
+  if (iter != vector.end() && iter->first == first)
+    iter->second = second;
+  else
+    vector.insert(iter, std::make_pair(first, second));
+}
+
+// Helper function that removes a key from a sorted vector of pairs.
+template <typename FirstType, typename SecondType>
+void RemoveFromVectorOfPairs(
+    FirstType first,
+    std::vector<std::pair<FirstType, SecondType>>& vector) {
+  auto iter = std::lower_bound(vector.begin(), vector.end(), first,
+                               FirstIsLess<FirstType, SecondType>);
+  if (iter != vector.end() && iter->first == first)
+    vector.erase(iter);
 }
 
 }  // namespace
@@ -447,93 +474,68 @@ bool AXNodeData::GetHtmlAttribute(const char* html_attr,
 void AXNodeData::AddStringAttribute(ax::mojom::StringAttribute attribute,
                                     const std::string& value) {
   BASE_DCHECK(attribute != ax::mojom::StringAttribute::kNone);
-  if (HasStringAttribute(attribute))
-    RemoveStringAttribute(attribute);
-  string_attributes.push_back(std::make_pair(attribute, value));
+  AddToVectorOfPairs(attribute, value, string_attributes);
 }
 
 void AXNodeData::AddIntAttribute(ax::mojom::IntAttribute attribute, int value) {
   BASE_DCHECK(attribute != ax::mojom::IntAttribute::kNone);
-  if (HasIntAttribute(attribute))
-    RemoveIntAttribute(attribute);
-  int_attributes.push_back(std::make_pair(attribute, value));
+  AddToVectorOfPairs(attribute, value, int_attributes);
 }
 
 void AXNodeData::AddFloatAttribute(ax::mojom::FloatAttribute attribute,
                                    float value) {
   BASE_DCHECK(attribute != ax::mojom::FloatAttribute::kNone);
-  if (HasFloatAttribute(attribute))
-    RemoveFloatAttribute(attribute);
-  float_attributes.push_back(std::make_pair(attribute, value));
+  AddToVectorOfPairs(attribute, value, float_attributes);
 }
 
 void AXNodeData::AddBoolAttribute(ax::mojom::BoolAttribute attribute,
                                   bool value) {
   BASE_DCHECK(attribute != ax::mojom::BoolAttribute::kNone);
-  if (HasBoolAttribute(attribute))
-    RemoveBoolAttribute(attribute);
-  bool_attributes.push_back(std::make_pair(attribute, value));
+  AddToVectorOfPairs(attribute, value, bool_attributes);
 }
 
 void AXNodeData::AddIntListAttribute(ax::mojom::IntListAttribute attribute,
                                      const std::vector<int32_t>& value) {
   BASE_DCHECK(attribute != ax::mojom::IntListAttribute::kNone);
-  if (HasIntListAttribute(attribute))
-    RemoveIntListAttribute(attribute);
-  intlist_attributes.push_back(std::make_pair(attribute, value));
+  AddToVectorOfPairs(attribute, value, intlist_attributes);
 }
 
 void AXNodeData::AddStringListAttribute(
     ax::mojom::StringListAttribute attribute,
     const std::vector<std::string>& value) {
   BASE_DCHECK(attribute != ax::mojom::StringListAttribute::kNone);
-  if (HasStringListAttribute(attribute))
-    RemoveStringListAttribute(attribute);
-  stringlist_attributes.push_back(std::make_pair(attribute, value));
+  AddToVectorOfPairs(attribute, value, stringlist_attributes);
 }
 
 void AXNodeData::RemoveStringAttribute(ax::mojom::StringAttribute attribute) {
   BASE_DCHECK(attribute != ax::mojom::StringAttribute::kNone);
-  base::EraseIf(string_attributes, [attribute](const auto& string_attribute) {
-    return string_attribute.first == attribute;
-  });
+  RemoveFromVectorOfPairs(attribute, string_attributes);
 }
 
 void AXNodeData::RemoveIntAttribute(ax::mojom::IntAttribute attribute) {
   BASE_DCHECK(attribute != ax::mojom::IntAttribute::kNone);
-  base::EraseIf(int_attributes, [attribute](const auto& int_attribute) {
-    return int_attribute.first == attribute;
-  });
+  RemoveFromVectorOfPairs(attribute, int_attributes);
 }
 
 void AXNodeData::RemoveFloatAttribute(ax::mojom::FloatAttribute attribute) {
   BASE_DCHECK(attribute != ax::mojom::FloatAttribute::kNone);
-  base::EraseIf(float_attributes, [attribute](const auto& float_attribute) {
-    return float_attribute.first == attribute;
-  });
+  RemoveFromVectorOfPairs(attribute, float_attributes);
 }
 
 void AXNodeData::RemoveBoolAttribute(ax::mojom::BoolAttribute attribute) {
   BASE_DCHECK(attribute != ax::mojom::BoolAttribute::kNone);
-  base::EraseIf(bool_attributes, [attribute](const auto& bool_attribute) {
-    return bool_attribute.first == attribute;
-  });
+  RemoveFromVectorOfPairs(attribute, bool_attributes);
 }
 
 void AXNodeData::RemoveIntListAttribute(ax::mojom::IntListAttribute attribute) {
   BASE_DCHECK(attribute != ax::mojom::IntListAttribute::kNone);
-  base::EraseIf(intlist_attributes, [attribute](const auto& intlist_attribute) {
-    return intlist_attribute.first == attribute;
-  });
+  RemoveFromVectorOfPairs(attribute, intlist_attributes);
 }
 
 void AXNodeData::RemoveStringListAttribute(
     ax::mojom::StringListAttribute attribute) {
   BASE_DCHECK(attribute != ax::mojom::StringListAttribute::kNone);
-  base::EraseIf(stringlist_attributes,
-                [attribute](const auto& stringlist_attribute) {
-                  return stringlist_attribute.first == attribute;
-                });
+  RemoveFromVectorOfPairs(attribute, stringlist_attributes);
 }
 
 AXNodeTextStyles AXNodeData::GetTextStyles() const {
@@ -575,18 +577,8 @@ void AXNodeData::SetName(const std::string& name) {
     BASE_UNREACHABLE();
   }
 
-  auto iter = std::find_if(string_attributes.begin(), string_attributes.end(),
-                           [](const auto& string_attribute) {
-                             return string_attribute.first ==
-                                    ax::mojom::StringAttribute::kName;
-                           });
-
-  if (iter == string_attributes.end()) {
-    string_attributes.push_back(
-        std::make_pair(ax::mojom::StringAttribute::kName, name));
-  } else {
-    iter->second = name;
-  }
+  AddToVectorOfPairs(ax::mojom::StringAttribute::kName, name,
+                     string_attributes);
 
   if (HasIntAttribute(ax::mojom::IntAttribute::kNameFrom))
     return;
@@ -273,6 +273,8 @@ struct AX_BASE_EXPORT AXNodeData {
   ax::mojom::Role role;
   uint32_t state;
   uint64_t actions;
+  // The typed attributes are kept sorted by attribute, so that they can be
+  // found with a binary search. Use the Add/Remove methods to change them.
   std::vector<std::pair<ax::mojom::StringAttribute, std::string>>
       string_attributes;
   std::vector<std::pair<ax::mojom::IntAttribute, int32_t>> int_attributes;
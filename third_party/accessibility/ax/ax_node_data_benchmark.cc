@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "ax_node_data.h"
+#include "ax_tree.h"
+#include "ax_tree_update.h"
+
+namespace ui {
+
+namespace {
+
+constexpr int32_t kNodeCount = 10000;
+constexpr int32_t kChildrenPerNode = 10;
+
+// Builds a tree of |kNodeCount| nodes with the attributes the desktop
+// accessibility bridge sets for each semantics node.
+AXTreeUpdate CreateTreeUpdate() {
+  AXTreeUpdate update;
+  update.root_id = 1;
+  update.nodes.resize(kNodeCount);
+  for (int32_t i = 0; i < kNodeCount; i++) {
+    AXNodeData& node = update.nodes[i];
+    node.id = i + 1;
+    node.role = ax::mojom::Role::kStaticText;
+    node.AddBoolAttribute(ax::mojom::BoolAttribute::kSelected, false);
+    node.AddBoolAttribute(ax::mojom::BoolAttribute::kEditableRoot, false);
+    node.AddIntAttribute(ax::mojom::IntAttribute::kTextSelEnd, -1);
+    node.AddIntAttribute(ax::mojom::IntAttribute::kTextSelStart, -1);
+    node.AddIntAttribute(ax::mojom::IntAttribute::kNameFrom,
+                         static_cast<int32_t>(ax::mojom::NameFrom::kContents));
+    node.AddIntListAttribute(ax::mojom::IntListAttribute::kCustomActionIds,
+                             {});
+    node.AddStringListAttribute(
+        ax::mojom::StringListAttribute::kCustomActionDescriptions, {});
+    node.AddStringAttribute(ax::mojom::StringAttribute::kName,
+                            "Node " + std::to_string(i));
+    node.AddStringAttribute(ax::mojom::StringAttribute::kValue, "");
+    for (int32_t child = (i * kChildrenPerNode) + 2;
+         child < (i + 1) * kChildrenPerNode + 2 && child <= kNodeCount;
+         child++) {
+      node.child_ids.push_back(child);
+    }
+  }
+  return update;
+}
+
+}  // namespace
+
+static void BM_AXNodeDataAddAttributes(benchmark::State& state) {  // NOLINT
+  while (state.KeepRunning()) {
+    AXTreeUpdate update = CreateTreeUpdate();
+    benchmark::DoNotOptimize(update);
+  }
+}
+
+static void BM_AXNodeDataGetAttributes(benchmark::State& state) {  // NOLINT
+  AXTreeUpdate update = CreateTreeUpdate();
+  while (state.KeepRunning()) {
+    for (const AXNodeData& node : update.nodes) {
+      benchmark::DoNotOptimize(
+          node.GetIntAttribute(ax::mojom::IntAttribute::kNameFrom));
+      benchmark::DoNotOptimize(
+          node.GetStringAttribute(ax::mojom::StringAttribute::kName));
+      benchmark::DoNotOptimize(
+          node.GetBoolAttribute(ax::mojom::BoolAttribute::kSelected));
+    }
+  }
+}
+
+static void BM_AXTreeUnserialize(benchmark::State& state) {  // NOLINT
+  AXTreeUpdate update = CreateTreeUpdate();
+  while (state.KeepRunning()) {
+    AXTree tree;
+    benchmark::DoNotOptimize(tree.Unserialize(update));
+  }
+}
+
+BENCHMARK(BM_AXNodeDataAddAttributes)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AXNodeDataGetAttributes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_AXTreeUnserialize)->Unit(benchmark::kMillisecond);
+
+}  // namespace ui
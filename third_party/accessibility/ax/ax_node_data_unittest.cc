@@ -4,6 +4,7 @@
 
 #include "ax_node_data.h"
 
+#include <algorithm>
 #include <set>
 #include <unordered_set>
 
@@ -86,6 +87,34 @@ TEST(AXNodeDataTest, TextAttributes) {
   EXPECT_TRUE(moved_styles == node_1.GetTextStyles());
 }
 
+TEST(AXNodeDataTest, AttributesStaySortedByAttribute) {
+  AXNodeData node;
+  node.AddIntAttribute(ax::mojom::IntAttribute::kTextStyle, 1);
+  node.AddIntAttribute(ax::mojom::IntAttribute::kColor, 2);
+  node.AddIntAttribute(ax::mojom::IntAttribute::kBackgroundColor, 3);
+  node.AddIntAttribute(ax::mojom::IntAttribute::kColor, 4);
+
+  ASSERT_EQ(node.int_attributes.size(), 3u);
+  EXPECT_TRUE(std::is_sorted(
+      node.int_attributes.begin(), node.int_attributes.end(),
+      [](const auto& a, const auto& b) { return a.first < b.first; }));
+  EXPECT_EQ(node.GetIntAttribute(ax::mojom::IntAttribute::kTextStyle), 1);
+  EXPECT_EQ(node.GetIntAttribute(ax::mojom::IntAttribute::kColor), 4);
+  EXPECT_EQ(node.GetIntAttribute(ax::mojom::IntAttribute::kBackgroundColor),
+            3);
+
+  node.RemoveIntAttribute(ax::mojom::IntAttribute::kColor);
+  EXPECT_FALSE(node.HasIntAttribute(ax::mojom::IntAttribute::kColor));
+  EXPECT_TRUE(node.HasIntAttribute(ax::mojom::IntAttribute::kTextStyle));
+  EXPECT_TRUE(node.HasIntAttribute(ax::mojom::IntAttribute::kBackgroundColor));
+
+  // Attributes added in a different order compare equal.
+  AXNodeData other;
+  other.AddIntAttribute(ax::mojom::IntAttribute::kBackgroundColor, 3);
+  other.AddIntAttribute(ax::mojom::IntAttribute::kTextStyle, 1);
+  EXPECT_EQ(node.int_attributes, other.int_attributes);
+}
+
 TEST(AXNodeDataTest, IsButtonPressed) {
   // A non-button element with CheckedState::kTrue should not return true for
   // IsButtonPressed.
@@ -1173,10 +1173,10 @@ TEST(AXTreeTest, AttributeChangeCallbacks) {
   const std::vector<std::string>& change_log =
       test_observer.attribute_change_log();
   ASSERT_EQ(9U, change_log.size());
-  EXPECT_EQ("name changed from N1 to N2", change_log[0]);
-  EXPECT_EQ("description changed from D1 to D2", change_log[1]);
-  EXPECT_EQ("liveAtomic changed to false", change_log[2]);
-  EXPECT_EQ("busy changed to true", change_log[3]);
+  EXPECT_EQ("description changed from D1 to D2", change_log[0]);
+  EXPECT_EQ("name changed from N1 to N2", change_log[1]);
+  EXPECT_EQ("busy changed to true", change_log[2]);
+  EXPECT_EQ("liveAtomic changed to false", change_log[3]);
   EXPECT_EQ("minValueForRange changed from 1.0 to 2.0", change_log[4]);
   EXPECT_EQ("maxValueForRange changed from 10.0 to 9.0", change_log[5]);
   EXPECT_EQ("stepValueForRange changed from 3.0 to 0.5", change_log[6]);
@@ -1275,8 +1275,8 @@ TEST(AXTreeTest, IntListChangeCallbacks) {
       test_observer2.attribute_change_log();
   ASSERT_EQ(3U, change_log2.size());
   EXPECT_EQ("controlsIds changed from 2,2 to ", change_log2[0]);
-  EXPECT_EQ("radioGroupIds changed from 3 to 2,2", change_log2[1]);
-  EXPECT_EQ("flowtoIds changed from  to 3", change_log2[2]);
+  EXPECT_EQ("flowtoIds changed from  to 3", change_log2[1]);
+  EXPECT_EQ("radioGroupIds changed from 3 to 2,2", change_log2[2]);
 }
 
 // Create a very simple tree and make sure that we can get the bounds of
@@ -33,6 +33,15 @@
         tonic::IndicesForSignature < decltype(&CLASS::METHOD)> ::count, true \
   }
 
+// Registers a method that Dart calls through an @FfiNative annotated external
+// method, with the symbol "CLASS::METHOD". The receiver is passed as a
+// Pointer<Void> to its native peer.
+#define DART_REGISTER_FFI_NATIVE(CLASS, METHOD)              \
+  {#CLASS "::" #METHOD,                                      \
+   reinterpret_cast<void*>(                                  \
+       tonic::FfiDispatcher<CLASS, decltype(&CLASS::METHOD), \
+                            &CLASS::METHOD>::Call)},
+
 #define DART_BIND_ALL(CLASS, FOR_EACH)                              \
   FOR_EACH(DART_NATIVE_CALLBACK)                                    \
   void CLASS::RegisterNatives(tonic::DartLibraryNatives* natives) { \
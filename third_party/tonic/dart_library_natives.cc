@@ -19,6 +19,12 @@ void DartLibraryNatives::Register(std::initializer_list<Entry> entries) {
   }
 }
 
+void DartLibraryNatives::RegisterFfi(std::initializer_list<FfiEntry> entries) {
+  for (const FfiEntry& entry : entries) {
+    ffi_entries_.emplace(entry.symbol, entry.function);
+  }
+}
+
 Dart_NativeFunction DartLibraryNatives::GetNativeFunction(
     Dart_Handle name,
     int argument_count,
@@ -42,4 +48,11 @@ const uint8_t* DartLibraryNatives::GetSymbol(
   return reinterpret_cast<const uint8_t*>(it->second);
 }
 
+void* DartLibraryNatives::GetFfiNativeFunction(const char* symbol) const {
+  auto it = ffi_entries_.find(symbol);
+  if (it == ffi_entries_.end())
+    return nullptr;
+  return it->second;
+}
+
 }  // namespace tonic
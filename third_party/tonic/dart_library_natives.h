@@ -28,13 +28,25 @@ class DartLibraryNatives {
 
   void Register(std::initializer_list<Entry> entries);
 
+  // A function that is called through an FFI native, with the symbol given to
+  // the @FfiNative annotation.
+  struct FfiEntry {
+    const char* symbol;
+    void* function;
+  };
+
+  void RegisterFfi(std::initializer_list<FfiEntry> entries);
+
   Dart_NativeFunction GetNativeFunction(Dart_Handle name,
                                         int argument_count,
                                         bool* auto_setup_scope);
   const uint8_t* GetSymbol(Dart_NativeFunction native_function);
 
+  void* GetFfiNativeFunction(const char* symbol) const;
+
  private:
   std::unordered_map<std::string, Entry> entries_;
+  std::unordered_map<std::string, void*> ffi_entries_;
   std::unordered_map<Dart_NativeFunction, const char*> symbols_;
 
   TONIC_DISALLOW_COPY_AND_ASSIGN(DartLibraryNatives);
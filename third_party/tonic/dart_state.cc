@@ -7,6 +7,7 @@
 #include "tonic/converter/dart_converter.h"
 #include "tonic/dart_class_library.h"
 #include "tonic/dart_message_handler.h"
+#include "tonic/dart_wrappable.h"
 #include "tonic/file_loader/file_loader.h"
 
 namespace tonic {
@@ -28,9 +29,14 @@ DartState::DartState(int dirfd,
       file_loader_(new FileLoader(dirfd)),
       message_epilogue_(message_epilogue),
       has_set_return_code_(false),
-      is_shutting_down_(false) {}
+      is_shutting_down_(false),
+      defers_wrappable_finalization_(false),
+      finalized_wrappables_(nullptr),
+      finalized_wrappable_count_(0) {}
 
-DartState::~DartState() {}
+DartState::~DartState() {
+  ReleaseFinalizedWrappables();
+}
 
 void DartState::SetIsolate(Dart_Isolate isolate) {
   isolate_ = isolate;
@@ -76,6 +82,46 @@ void DartState::SetReturnCodeCallback(std::function<void(uint32_t)> callback) {
 
 void DartState::DidSetIsolate() {}
 
+bool DartState::QueueFinalizedWrappable(DartWrappable* wrappable) {
+  if (!defers_wrappable_finalization_) {
+    return false;
+  }
+  if (finalized_wrappable_count_.fetch_add(1) >= kMaxFinalizedWrappables) {
+    finalized_wrappable_count_.fetch_sub(1);
+    return false;
+  }
+  // A wrappable that got a new wrapper after its previous one was collected
+  // can be finalized again before the queue is drained. It can only be in the
+  // queue once.
+  if (wrappable->finalization_queued_.exchange(true)) {
+    finalized_wrappable_count_.fetch_sub(1);
+    return false;
+  }
+  DartWrappable* head = finalized_wrappables_.load(std::memory_order_relaxed);
+  do {
+    wrappable->next_finalized_ = head;
+  } while (!finalized_wrappables_.compare_exchange_weak(
+      head, wrappable, std::memory_order_release, std::memory_order_relaxed));
+  return true;
+}
+
+size_t DartState::ReleaseFinalizedWrappables() {
+  DartWrappable* wrappable =
+      finalized_wrappables_.exchange(nullptr, std::memory_order_acquire);
+  size_t count = 0;
+  while (wrappable) {
+    DartWrappable* next = wrappable->next_finalized_;
+    wrappable->next_finalized_ = nullptr;
+    wrappable->finalization_queued_.store(false);
+    finalized_wrappable_count_.fetch_sub(1);
+    // Balanced in CreateDartWrapper and AssociateWithDartWrapper.
+    wrappable->ReleaseDartWrappableReference();
+    wrappable = next;
+    count++;
+  }
+  return count;
+}
+
 Dart_Handle DartState::HandleLibraryTag(Dart_LibraryTag tag,
                                         Dart_Handle library,
                                         Dart_Handle url) {
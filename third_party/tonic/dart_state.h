@@ -18,6 +18,7 @@
 namespace tonic {
 class DartClassLibrary;
 class DartMessageHandler;
+class DartWrappable;
 class FileLoader;
 
 // DartState represents the state associated with a given Dart isolate. The
@@ -75,6 +76,25 @@ class DartState : public std::enable_shared_from_this<DartState> {
 
   virtual void DidSetIsolate();
 
+  // When enabled, the finalizers of the Dart wrappers of DartWrappables queue
+  // the wrappables instead of releasing them, and the owner of the isolate
+  // releases them in batches with |ReleaseFinalizedWrappables|, such as when
+  // the isolate is idle. The queue holds at most |kMaxFinalizedWrappables|
+  // wrappables, after which finalizers release them right away again.
+  void SetDefersWrappableFinalization(bool defers) {
+    defers_wrappable_finalization_ = defers;
+  }
+
+  // Called from the finalizer of the Dart wrapper of the wrappable, possibly
+  // on a thread of the garbage collector. Returns false if the wrappable was
+  // not queued, in which case the caller must release it.
+  bool QueueFinalizedWrappable(DartWrappable* wrappable);
+
+  // Releases the wrappables queued so far and returns how many there were.
+  size_t ReleaseFinalizedWrappables();
+
+  static constexpr size_t kMaxFinalizedWrappables = 1000;
+
   static Dart_Handle HandleLibraryTag(Dart_LibraryTag tag,
                                       Dart_Handle library,
                                       Dart_Handle url);
@@ -92,6 +112,10 @@ class DartState : public std::enable_shared_from_this<DartState> {
   std::function<void(uint32_t)> set_return_code_callback_;
   bool has_set_return_code_;
   std::atomic<bool> is_shutting_down_;
+  std::atomic<bool> defers_wrappable_finalization_;
+  // A lock-free stack linked through DartWrappable::next_finalized_.
+  std::atomic<DartWrappable*> finalized_wrappables_;
+  std::atomic<size_t> finalized_wrappable_count_;
 
  protected:
   TONIC_DISALLOW_COPY_AND_ASSIGN(DartState);
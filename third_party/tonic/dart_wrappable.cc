@@ -74,6 +74,12 @@ void DartWrappable::ClearDartWrapper() {
 void DartWrappable::FinalizeDartWrapper(void* isolate_callback_data,
                                         void* peer) {
   DartWrappable* wrappable = reinterpret_cast<DartWrappable*>(peer);
+  // Releasing the wrappable can run an expensive destructor, so the isolate
+  // may prefer to release it later in a batch.
+  auto dart_state = wrappable->dart_wrapper_.dart_state().lock();
+  if (dart_state && dart_state->QueueFinalizedWrappable(wrappable)) {
+    return;
+  }
   wrappable->ReleaseDartWrappableReference();  // Balanced in CreateDartWrapper.
 }
 
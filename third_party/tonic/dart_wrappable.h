@@ -13,6 +13,7 @@
 #include "tonic/dart_wrapper_info.h"
 #include "tonic/logging/dart_error.h"
 
+#include <atomic>
 #include <type_traits>
 
 namespace tonic {
@@ -26,7 +27,10 @@ class DartWrappable {
     kNumberOfNativeFields,
   };
 
-  DartWrappable() : dart_wrapper_(DartWeakPersistentValue()) {}
+  DartWrappable()
+      : dart_wrapper_(DartWeakPersistentValue()),
+        next_finalized_(nullptr),
+        finalization_queued_(false) {}
 
   // Subclasses that wish to expose a new interface must override this function
   // and provide information about their wrapper. There is no need to call your
@@ -61,9 +65,14 @@ class DartWrappable {
       const tonic::DartWrapperInfo& wrapper_info);
 
  private:
+  friend class DartState;
+
   static void FinalizeDartWrapper(void* isolate_callback_data, void* peer);
 
   DartWeakPersistentValue dart_wrapper_;
+  // The queue of DartState::QueueFinalizedWrappable.
+  DartWrappable* next_finalized_;
+  std::atomic<bool> finalization_queued_;
 
   TONIC_DISALLOW_COPY_AND_ASSIGN(DartWrappable);
 };
@@ -14,6 +14,11 @@ namespace tonic {
 
 class DartByteData {
  public:
+  // The size from which |Create| copies the data into a buffer outside of the
+  // Dart heap. Callers that own a buffer at least this large can hand it to an
+  // external typed data instead, to avoid the copy.
+  static constexpr size_t kExternalSizeThreshold = 1000;
+
   static Dart_Handle Create(const void* data, size_t length);
 
   explicit DartByteData(Dart_Handle list);
@@ -0,0 +1,310 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Benchmarks of the layout and the painting of paragraphs of text in the
+// scripts of the apps, with both the txt and the Skia paragraph backends.
+//
+// For each paragraph of the corpus and each backend:
+//  - "Shape" lays out a paragraph that has never been laid out, with empty
+//    caches, which shapes all of its runs and breaks its lines.
+//  - "LineBreak" lays out the same paragraph at alternating widths, which only
+//    breaks its lines again.
+//  - "Paint" paints the laid out paragraph.
+//
+// The "allocs" counter is the number of allocations with operator new per
+// iteration, and "layout_cache_hit_rate" the hit rate of the cache of the
+// shaped words of the txt backend.
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "flutter/third_party/txt/tests/txt_test_utils.h"
+#include "minikin/Layout.h"
+#include "third_party/benchmark/include/benchmark/benchmark.h"
+#include "third_party/icu/source/common/unicode/unistr.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkColor.h"
+#include "txt/font_collection.h"
+#include "txt/paragraph.h"
+#include "txt/paragraph_builder.h"
+#include "txt/paragraph_style.h"
+#include "txt/shaped_run_cache.h"
+#include "txt/text_style.h"
+
+#if FLUTTER_ENABLE_SKSHAPER
+#include "third_party/skia/modules/skparagraph/include/FontCollection.h"
+#include "third_party/skia/modules/skparagraph/include/ParagraphCache.h"
+#endif  // FLUTTER_ENABLE_SKSHAPER
+
+namespace {
+
+std::atomic<size_t> g_allocation_count = 0;
+
+}  // namespace
+
+// Counts the allocations of the whole benchmark executable.
+void* operator new(std::size_t size) {
+  g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (!ptr) {
+    std::abort();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+namespace txt {
+
+namespace {
+
+constexpr double kParagraphWidth = 300;
+
+enum class Backend {
+  kTxt,
+  kSkia,
+};
+
+struct Corpus {
+  const char* name;
+  const char* text;
+  std::vector<std::string> font_families;
+  TextDirection text_direction;
+  // Whether the style changes with each word, as in rich text.
+  bool mixed_styles;
+};
+
+const std::vector<Corpus>& GetCorpora() {
+  static const std::vector<Corpus> corpora = {
+      {"Latin",
+       "The quick brown fox jumps over the lazy dog, while the five boxing "
+       "wizards jump quickly. Pack my box with five dozen liquor jugs! How "
+       "vexingly quick daft zebras jump; sphinx of black quartz, judge my vow. "
+       "Crème brûlée, façade and naïve coöperation are spelled with accents.",
+       {"Roboto"},
+       TextDirection::ltr,
+       false},
+      {"CJK",
+       "吾輩は猫である。名前はまだ無い。どこで生れたかとんと見当がつかぬ。"
+       "何でも薄暗いじめじめした所でニャーニャー泣いていた事だけは記憶して"
+       "いる。吾輩はここで始めて人間というものを見た。しかもあとで聞くと"
+       "それは書生という人間中で一番獰悪な種族であったそうだ。",
+       {"Noto Sans CJK JP"},
+       TextDirection::ltr,
+       false},
+      {"Arabic",
+       "يولد جميع الناس أحراراً متساوين في الكرامة والحقوق. وقد وهبوا عقلاً "
+       "وضميراً وعليهم أن يعامل بعضهم بعضاً بروح الإخاء. لكل إنسان حق التمتع "
+       "بكافة الحقوق والحريات الواردة في هذا الإعلان، دون أي تمييز.",
+       {"Noto Naskh Arabic"},
+       TextDirection::rtl,
+       false},
+      {"Emoji",
+       "See you at 7 🍕🍺 then the movie 🎬🍿 with the family "
+       "👨‍👩‍👧‍👦 and the dog 🐶🐾!! Happy birthday 🎉🎂🎁 "
+       "😂😂😂 ❤️❤️ 👍🏽👍🏿 🇯🇵🇫🇷🇧🇷 #weekend ✨🌈☀️",
+       {"Roboto", "Noto Color Emoji"},
+       TextDirection::ltr,
+       false},
+      {"MixedStyles",
+       "Tap Settings, then Notifications, then choose which of your apps may "
+       "send you alerts, badges and sounds, and when they may do so. Changes "
+       "apply to all of your devices signed in to the same account.",
+       {"Roboto"},
+       TextDirection::ltr,
+       true},
+  };
+  return corpora;
+}
+
+// The style of the nth word of the paragraphs with mixed styles.
+TextStyle GetMixedTextStyle(const TextStyle& base, size_t index) {
+  TextStyle style = base;
+  switch (index % 4) {
+    case 1:
+      style.font_weight = FontWeight::w700;
+      break;
+    case 2:
+      style.font_style = FontStyle::italic;
+      break;
+    case 3:
+      style.font_size = base.font_size * 1.5;
+      style.color = SK_ColorBLUE;
+      break;
+  }
+  return style;
+}
+
+std::unique_ptr<Paragraph> BuildCorpusParagraph(
+    const Corpus& corpus,
+    Backend backend,
+    const std::shared_ptr<FontCollection>& font_collection) {
+  ParagraphStyle paragraph_style;
+  paragraph_style.text_direction = corpus.text_direction;
+
+  std::unique_ptr<ParagraphBuilder> builder;
+#if FLUTTER_ENABLE_SKSHAPER
+  if (backend == Backend::kSkia) {
+    builder = ParagraphBuilder::CreateSkiaBuilder(paragraph_style,
+                                                  font_collection);
+  }
+#endif  // FLUTTER_ENABLE_SKSHAPER
+  if (!builder) {
+    builder = ParagraphBuilder::CreateTxtBuilder(paragraph_style,
+                                                 font_collection);
+  }
+
+  TextStyle text_style;
+  text_style.font_families = corpus.font_families;
+  text_style.font_size = 14;
+  text_style.color = SK_ColorBLACK;
+
+  auto icu_text = icu::UnicodeString::fromUTF8(corpus.text);
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+  if (!corpus.mixed_styles) {
+    builder->PushStyle(text_style);
+    builder->AddText(u16_text);
+    builder->Pop();
+    return builder->Build();
+  }
+
+  size_t word_start = 0;
+  for (size_t index = 0; word_start < u16_text.size(); index++) {
+    size_t word_end = u16_text.find(u' ', word_start);
+    word_end = word_end == std::u16string::npos ? u16_text.size()
+                                                : word_end + 1;
+    builder->PushStyle(GetMixedTextStyle(text_style, index));
+    builder->AddText(u16_text.substr(word_start, word_end - word_start));
+    builder->Pop();
+    word_start = word_end;
+  }
+  return builder->Build();
+}
+
+// Empties the caches of the shaped text that are shared by the paragraphs.
+void PurgeShapingCaches(
+    Backend backend,
+    const std::shared_ptr<FontCollection>& font_collection) {
+  minikin::Layout::purgeCaches();
+  ShapedRunCache::GetInstance().Clear();
+#if FLUTTER_ENABLE_SKSHAPER
+  if (backend == Backend::kSkia) {
+    font_collection->CreateSktFontCollection()->getParagraphCache()->reset();
+  }
+#endif  // FLUTTER_ENABLE_SKSHAPER
+}
+
+// Reports the counters of the allocations and of the layout cache since the
+// given counts.
+void ReportCounters(benchmark::State& state,
+                    Backend backend,
+                    size_t allocations,
+                    const minikin::LayoutCacheStats& initial_stats) {
+  state.counters["allocs"] =
+      benchmark::Counter(allocations, benchmark::Counter::kAvgIterations);
+  if (backend == Backend::kTxt) {
+    minikin::LayoutCacheStats stats = minikin::Layout::getCacheStats();
+    size_t hits = stats.hits - initial_stats.hits;
+    size_t lookups = hits + stats.misses - initial_stats.misses;
+    state.counters["layout_cache_hit_rate"] =
+        lookups == 0 ? 0 : static_cast<double>(hits) / lookups;
+  }
+}
+
+void BM_CorpusShape(benchmark::State& state,
+                    const Corpus& corpus,
+                    Backend backend) {
+  auto font_collection = GetTestFontCollection();
+  minikin::LayoutCacheStats initial_stats = minikin::Layout::getCacheStats();
+  size_t allocations = 0;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    PurgeShapingCaches(backend, font_collection);
+    auto paragraph = BuildCorpusParagraph(corpus, backend, font_collection);
+    size_t initial_allocations = g_allocation_count.load();
+    state.ResumeTiming();
+
+    paragraph->Layout(kParagraphWidth);
+
+    state.PauseTiming();
+    allocations += g_allocation_count.load() - initial_allocations;
+    paragraph.reset();
+    state.ResumeTiming();
+  }
+  ReportCounters(state, backend, allocations, initial_stats);
+}
+
+void BM_CorpusLineBreak(benchmark::State& state,
+                        const Corpus& corpus,
+                        Backend backend) {
+  auto font_collection = GetTestFontCollection();
+  auto paragraph = BuildCorpusParagraph(corpus, backend, font_collection);
+  paragraph->Layout(kParagraphWidth);
+  minikin::LayoutCacheStats initial_stats = minikin::Layout::getCacheStats();
+  size_t initial_allocations = g_allocation_count.load();
+  bool narrow = true;
+  while (state.KeepRunning()) {
+    paragraph->Layout(narrow ? kParagraphWidth * 0.75 : kParagraphWidth);
+    narrow = !narrow;
+  }
+  ReportCounters(state, backend,
+                 g_allocation_count.load() - initial_allocations,
+                 initial_stats);
+  state.counters["lines"] = paragraph->GetLineMetrics().size();
+}
+
+void BM_CorpusPaint(benchmark::State& state,
+                    const Corpus& corpus,
+                    Backend backend) {
+  auto font_collection = GetTestFontCollection();
+  auto paragraph = BuildCorpusParagraph(corpus, backend, font_collection);
+  paragraph->Layout(kParagraphWidth);
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(1000, 1000);
+  SkCanvas canvas(bitmap);
+  canvas.clear(SK_ColorWHITE);
+  size_t initial_allocations = g_allocation_count.load();
+  while (state.KeepRunning()) {
+    paragraph->Paint(&canvas, 0, 0);
+  }
+  state.counters["allocs"] = benchmark::Counter(
+      g_allocation_count.load() - initial_allocations,
+      benchmark::Counter::kAvgIterations);
+}
+
+bool RegisterCorpusBenchmarks() {
+  std::vector<std::pair<Backend, std::string>> backends = {
+      {Backend::kTxt, "Txt"},
+#if FLUTTER_ENABLE_SKSHAPER
+      {Backend::kSkia, "Skia"},
+#endif  // FLUTTER_ENABLE_SKSHAPER
+  };
+  for (const Corpus& corpus : GetCorpora()) {
+    for (const auto& backend : backends) {
+      std::string suffix = "/" + backend.second + "/" + corpus.name;
+      benchmark::RegisterBenchmark(("CorpusShape" + suffix).c_str(),
+                                   BM_CorpusShape, corpus, backend.first);
+      benchmark::RegisterBenchmark(("CorpusLineBreak" + suffix).c_str(),
+                                   BM_CorpusLineBreak, corpus, backend.first);
+      benchmark::RegisterBenchmark(("CorpusPaint" + suffix).c_str(),
+                                   BM_CorpusPaint, corpus, backend.first);
+    }
+  }
+  return true;
+}
+
+[[maybe_unused]] const bool g_corpus_benchmarks_registered =
+    RegisterCorpusBenchmarks();
+
+}  // namespace
+
+}  // namespace txt
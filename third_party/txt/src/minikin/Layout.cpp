@@ -108,6 +108,15 @@ class LayoutCacheKey {
                         collection);
   }
 
+  // An estimate of the memory of a cache entry, most of which is the copy of
+  // the text and the glyphs of the layout.
+  size_t getByteSize(const Layout& layout) const {
+    return sizeof(LayoutCacheKey) + mNchars * sizeof(uint16_t) +
+           sizeof(Layout) + layout.mGlyphs.capacity() * sizeof(LayoutGlyph) +
+           layout.mAdvances.capacity() * sizeof(float) +
+           layout.mFaces.capacity() * sizeof(FakedFont);
+  }
+
  private:
   const uint16_t* mChars;
   size_t mNchars;
@@ -131,21 +140,45 @@ class LayoutCacheKey {
 
 class LayoutCache : private android::OnEntryRemoved<LayoutCacheKey, Layout*> {
  public:
-  LayoutCache() : mCache(kMaxEntries) {
+  LayoutCache()
+      : mCache(android::LruCache<LayoutCacheKey,
+                                 Layout*>::kUnlimitedCapacity) {
     mCache.setOnEntryRemovedListener(this);
   }
 
   void clear() { mCache.clear(); }
 
+  void setMaxBytes(size_t maxBytes) {
+    mMaxBytes = maxBytes;
+    trim();
+  }
+
+  size_t trimTo(size_t maxBytes) {
+    const size_t byteSize = mByteSize;
+    while (mCache.size() > 0 && mByteSize > maxBytes) {
+      mCache.removeOldest();
+    }
+    return byteSize - mByteSize;
+  }
+
+  LayoutCacheStats getStats() const {
+    return {mHits, mMisses, mCache.size(), mByteSize};
+  }
+
   Layout* get(LayoutCacheKey& key,
               LayoutContext* ctx,
               const std::shared_ptr<FontCollection>& collection) {
     Layout* layout = mCache.get(key);
     if (layout == NULL) {
+      mMisses++;
       key.copyText();
       layout = new Layout();
       key.doLayout(layout, ctx, collection);
+      mByteSize += key.getByteSize(*layout);
       mCache.put(key, layout);
+      trim();
+    } else {
+      mHits++;
     }
     return layout;
   }
@@ -153,17 +186,29 @@ class LayoutCache : private android::OnEntryRemoved<LayoutCacheKey, Layout*> {
  private:
   // callback for OnEntryRemoved
   void operator()(LayoutCacheKey& key, Layout*& value) {
+    mByteSize -= key.getByteSize(*value);
     key.freeText();
     delete value;
   }
 
-  android::LruCache<LayoutCacheKey, Layout*> mCache;
+  // Evicts the least recently used entries that are over the limit, but never
+  // the newest one, which the caller of get may be about to use.
+  void trim() {
+    while (mCache.size() > 1 &&
+           (mMaxBytes == 0 ? mCache.size() > kMaxEntries
+                           : mByteSize > mMaxBytes)) {
+      mCache.removeOldest();
+    }
+  }
 
-  // static const size_t kMaxEntries = LruCache<LayoutCacheKey,
-  // Layout*>::kUnlimitedCapacity;
+  android::LruCache<LayoutCacheKey, Layout*> mCache;
+  size_t mMaxBytes = 0;
+  size_t mByteSize = 0;
+  size_t mHits = 0;
+  size_t mMisses = 0;
 
-  // TODO: eviction based on memory footprint; for now, we just use a constant
-  // number of strings
+  // The limit on the number of entries, unless a limit of the memory has been
+  // set.
   static const size_t kMaxEntries = 5000;
 };
 
@@ -1184,7 +1229,7 @@ float Layout::getAdvance() const {
   return mAdvance;
 }
 
-void Layout::getAdvances(float* advances) {
+void Layout::getAdvances(float* advances) const {
   memcpy(advances, &mAdvances[0], mAdvances.size() * sizeof(float));
 }
 
@@ -1199,4 +1244,19 @@ void Layout::purgeCaches() {
   purgeHbFontCacheLocked();
 }
 
+void Layout::setCacheMaxBytes(size_t maxBytes) {
+  std::scoped_lock _l(gMinikinLock);
+  LayoutEngine::getInstance().layoutCache.setMaxBytes(maxBytes);
+}
+
+size_t Layout::trimCaches(size_t maxBytes) {
+  std::scoped_lock _l(gMinikinLock);
+  return LayoutEngine::getInstance().layoutCache.trimTo(maxBytes);
+}
+
+LayoutCacheStats Layout::getCacheStats() {
+  std::scoped_lock _l(gMinikinLock);
+  return LayoutEngine::getInstance().layoutCache.getStats();
+}
+
 }  // namespace minikin
@@ -57,6 +57,15 @@ enum {
   kBidi_Mask = 0x7
 };
 
+// libtxt extension: the usage of the cache of the layouts of words, which
+// the hits and misses count since the process started.
+struct LayoutCacheStats {
+  size_t hits;
+  size_t misses;
+  size_t entryCount;
+  size_t byteSize;
+};
+
 // Lifecycle and threading assumptions for Layout:
 // The object is assumed to be owned by a single thread; multiple threads
 // may not mutate it at the same time.
@@ -106,7 +115,7 @@ class Layout {
 
   // Get advances, copying into caller-provided buffer. The size of this
   // buffer must match the length of the string (count arg to doLayout).
-  void getAdvances(float* advances);
+  void getAdvances(float* advances) const;
 
   // The i parameter is an offset within the buf relative to start, it is <
   // count, where start and count are the parameters to doLayout
@@ -117,6 +126,19 @@ class Layout {
   // Purge all caches, useful in low memory conditions
   static void purgeCaches();
 
+  // libtxt extension: limits the memory that the cached layouts of words may
+  // use, evicting the least recently used ones, instead of limiting them to
+  // a number of words. A limit of 0 restores the default number of words.
+  static void setCacheMaxBytes(size_t maxBytes);
+
+  // libtxt extension
+  static LayoutCacheStats getCacheStats();
+
+  // libtxt extension: evicts the least recently used layouts of words until
+  // the cache uses at most maxBytes, without limiting it afterwards. Returns
+  // the bytes of the evicted layouts.
+  static size_t trimCaches(size_t maxBytes);
+
  private:
   friend class LayoutCacheKey;
 
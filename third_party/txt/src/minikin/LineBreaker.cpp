@@ -71,6 +71,8 @@ const float LIBTXT_WIDTH_ADJUST = 0.00001;
 void LineBreaker::setLocale() {
   mWordBreaker.setLocale();
   mLocale = icu::Locale();
+  // libtxt: automatic hyphenation is not supported, so no hyphenation patterns
+  // are ever loaded and only the explicit hyphens of the text break words.
   mHyphenator = nullptr;
 }
 
@@ -520,7 +522,10 @@ void LineBreaker::computeBreaksOptimal(bool isRectangle) {
 }
 
 size_t LineBreaker::computeBreaks() {
-  if (mStrategy == kBreakStrategy_Greedy) {
+  // libtxt: the greedy breaker has not broken any line if all of the text fits
+  // in the first one, and neither would the optimal one, so that short labels
+  // skip it.
+  if (mStrategy == kBreakStrategy_Greedy || mBreaks.empty()) {
     computeBreaksGreedy();
   } else {
     computeBreaksOptimal(mLineWidths.isConstant());
@@ -26,6 +26,9 @@
 #include <unicode/uchar.h>
 #include <unicode/utf16.h>
 
+#include <mutex>
+#include <vector>
+
 namespace minikin {
 
 const uint32_t CHAR_SOFT_HYPHEN = 0x00AD;
@@ -37,20 +40,78 @@ const uint32_t CHAR_ZWJ = 0x200D;
 static std::once_flag gLibtxtBreakIteratorInitFlag;
 static icu::BreakIterator* gLibtxtDefaultBreakIterator = nullptr;
 
+// libtxt extension: every paragraph has a WordBreaker, so the clones of the
+// destroyed instances are kept for the next ones rather than cloned again.
+static const size_t kLibtxtBreakIteratorPoolSize = 32;
+static std::mutex gLibtxtBreakIteratorPoolMutex;
+static std::vector<std::unique_ptr<icu::BreakIterator>>&
+libtxtBreakIteratorPool() {
+  // Leaked so that paragraphs can still be destroyed while the process exits.
+  static auto* pool = new std::vector<std::unique_ptr<icu::BreakIterator>>();
+  return *pool;
+}
+
+WordBreaker::~WordBreaker() {
+  finish();
+  if (mBreakIterator) {
+    std::scoped_lock lock(gLibtxtBreakIteratorPoolMutex);
+    auto& pool = libtxtBreakIteratorPool();
+    if (pool.size() < kLibtxtBreakIteratorPoolSize) {
+      pool.push_back(std::move(mBreakIterator));
+    }
+  }
+}
+
 void WordBreaker::setLocale() {
   UErrorCode status = U_ZERO_ERROR;
   std::call_once(gLibtxtBreakIteratorInitFlag, [&status] {
     gLibtxtDefaultBreakIterator =
         icu::BreakIterator::createLineInstance(icu::Locale(), status);
   });
-  mBreakIterator.reset(gLibtxtDefaultBreakIterator->clone());
+  if (!mBreakIterator) {
+    std::scoped_lock lock(gLibtxtBreakIteratorPoolMutex);
+    auto& pool = libtxtBreakIteratorPool();
+    if (!pool.empty()) {
+      mBreakIterator = std::move(pool.back());
+      pool.pop_back();
+    }
+  }
+  if (!mBreakIterator) {
+    mBreakIterator.reset(gLibtxtDefaultBreakIterator->clone());
+  }
   // TODO: handle failure status
-  if (mText != nullptr) {
+  if (mText != nullptr && !mSimpleText) {
     mBreakIterator->setText(&mUText, status);
   }
   mIteratorWasReset = true;
 }
 
+// libtxt extension: letters and digits are never broken apart, and periods and
+// commas are never broken from what precedes them, so that the only breaks of
+// text made of these and of spaces are after the spaces.
+static bool isSimpleWordChar(uint16_t c) {
+  return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') ||
+         ('0' <= c && c <= '9') ||
+         // The Latin-1 letters, without the multiplication and division signs.
+         (0x00C0 <= c && c <= 0x00FF && c != 0x00D7 && c != 0x00F7);
+}
+
+static bool isSimpleText(const uint16_t* data, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    uint16_t c = data[i];
+    if (isSimpleWordChar(c) || c == ' ') {
+      continue;
+    }
+    // Only the periods and commas at the end of words, since their breaks
+    // before a digit or a letter depend on the version of ICU.
+    if ((c == '.' || c == ',') && (i + 1 == size || data[i + 1] == ' ')) {
+      continue;
+    }
+    return false;
+  }
+  return true;
+}
+
 void WordBreaker::setText(const uint16_t* data, size_t size) {
   mText = data;
   mTextSize = size;
@@ -59,6 +120,10 @@ void WordBreaker::setText(const uint16_t* data, size_t size) {
   mCurrent = 0;
   mScanOffset = 0;
   mInEmailOrUrl = false;
+  mSimpleText = isSimpleText(data, size);
+  if (mSimpleText) {
+    return;
+  }
   UErrorCode status = U_ZERO_ERROR;
   utext_openUChars(&mUText, reinterpret_cast<const UChar*>(data), size,
                    &status);
@@ -124,6 +189,10 @@ static bool isBreakValid(const uint16_t* buf, size_t bufEnd, size_t i) {
 // Customized iteratorNext that takes care of both resets and our modifications
 // to ICU's behavior.
 int32_t WordBreaker::iteratorNext() {
+  if (mSimpleText) {
+    mIteratorWasReset = false;
+    return simpleTextNext();
+  }
   int32_t result;
   do {
     if (mIteratorWasReset) {
@@ -138,6 +207,20 @@ int32_t WordBreaker::iteratorNext() {
   return result;
 }
 
+// libtxt extension: the break following the current offset of simple text,
+// which is the same as the one of ICU.
+int32_t WordBreaker::simpleTextNext() const {
+  if ((size_t)mCurrent >= mTextSize) {
+    return icu::BreakIterator::DONE;
+  }
+  for (size_t i = mCurrent + 1; i < mTextSize; i++) {
+    if (mText[i - 1] == ' ' && isSimpleWordChar(mText[i])) {
+      return i;
+    }
+  }
+  return mTextSize;
+}
+
 // Chicago Manual of Style recommends breaking after these characters in URLs
 // and email addresses
 static bool breakAfter(uint16_t c) {
@@ -31,7 +31,9 @@ namespace minikin {
 
 class WordBreaker {
  public:
-  ~WordBreaker() { finish(); }
+  // libtxt extension: gives the ICU break iterator back to the pool that the
+  // next instance takes it from.
+  ~WordBreaker();
 
   // libtxt extension: always use the default locale so that a cached instance
   // of the ICU break iterator can be reused.
@@ -58,6 +60,7 @@ class WordBreaker {
 
  private:
   int32_t iteratorNext();
+  int32_t simpleTextNext() const;
   void detectEmailOrUrl();
   ssize_t findNextBreakInEmailOrUrl();
 
@@ -68,6 +71,10 @@ class WordBreaker {
   ssize_t mLast;
   ssize_t mCurrent;
   bool mIteratorWasReset;
+  // libtxt extension: whether the text only has Latin letters, digits, spaces
+  // and the periods and commas that end words, whose breaks are found without
+  // the ICU break iterator.
+  bool mSimpleText = false;
 
   // state for the email address / url detector
   ssize_t mScanOffset;
@@ -17,17 +17,21 @@
 #include "font_collection.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
 #include "font_skia.h"
 #include "minikin/Layout.h"
+#include "shaped_run_cache.h"
 #include "txt/platform.h"
 #include "txt/text_style.h"
 
@@ -37,6 +41,27 @@ namespace {
 
 const std::shared_ptr<minikin::FontFamily> g_null_family;
 
+constexpr char kFallbackFontMatchesHeader[] = "font-fallbacks-v1";
+
+// Returns the family name of the typeface that the manager matches for the
+// character, or an empty name if it has none.
+std::string MatchFallbackFamilyName(const sk_sp<SkFontMgr>& manager,
+                                    uint32_t ch,
+                                    const std::string& locale) {
+  TRACE_EVENT0("flutter", "FontCollection::MatchFallbackFamilyName");
+  std::vector<const char*> bcp47;
+  if (!locale.empty())
+    bcp47.push_back(locale.c_str());
+  sk_sp<SkTypeface> typeface(manager->matchFamilyStyleCharacter(
+      0, SkFontStyle(), bcp47.data(), bcp47.size(), ch));
+  if (!typeface)
+    return std::string();
+
+  SkString sk_family_name;
+  typeface->getFamilyName(&sk_family_name);
+  return std::string(sk_family_name.c_str());
+}
+
 }  // anonymous namespace
 
 FontCollection::FamilyKey::FamilyKey(const std::vector<std::string>& families,
@@ -85,6 +110,7 @@ FontCollection::FontCollection() : enable_font_fallback_(true) {}
 
 FontCollection::~FontCollection() {
   minikin::Layout::purgeCaches();
+  ShapedRunCache::GetInstance().Clear();
 
 #if FLUTTER_ENABLE_SKSHAPER
   if (skt_collection_) {
@@ -93,6 +119,18 @@ FontCollection::~FontCollection() {
 #endif
 }
 
+void FontCollection::SetLayoutCacheMaxBytes(size_t max_bytes) {
+  minikin::Layout::setCacheMaxBytes(max_bytes);
+}
+
+size_t FontCollection::GetLayoutCacheBytes() {
+  return minikin::Layout::getCacheStats().byteSize;
+}
+
+size_t FontCollection::TrimLayoutCache(size_t max_bytes) {
+  return minikin::Layout::trimCaches(max_bytes);
+}
+
 size_t FontCollection::GetFontManagersCount() const {
   return GetFontManagerOrder().size();
 }
@@ -100,10 +138,14 @@ size_t FontCollection::GetFontManagersCount() const {
 void FontCollection::SetupDefaultFontManager(
     uint32_t font_initialization_data) {
   default_font_manager_ = GetDefaultFontManager(font_initialization_data);
+  default_fallback_matches_.clear();
+  default_font_manager_fingerprint_.clear();
 }
 
 void FontCollection::SetDefaultFontManager(sk_sp<SkFontMgr> font_manager) {
   default_font_manager_ = font_manager;
+  default_fallback_matches_.clear();
+  default_font_manager_fingerprint_.clear();
 
 #if FLUTTER_ENABLE_SKSHAPER
   skt_collection_.reset();
@@ -227,15 +269,19 @@ FontCollection::GetMinikinFontCollectionForFamilies(
 std::shared_ptr<minikin::FontFamily> FontCollection::FindFontFamilyInManagers(
     const std::string& family_name) {
   TRACE_EVENT0("flutter", "FontCollection::FindFontFamilyInManagers");
+  auto cached = font_families_cache_.find(family_name);
+  if (cached != font_families_cache_.end()) {
+    return cached->second;
+  }
   // Search for the font family in each font manager.
+  std::shared_ptr<minikin::FontFamily> minikin_family;
   for (sk_sp<SkFontMgr>& manager : GetFontManagerOrder()) {
-    std::shared_ptr<minikin::FontFamily> minikin_family =
-        CreateMinikinFontFamily(manager, family_name);
-    if (!minikin_family)
-      continue;
-    return minikin_family;
+    minikin_family = CreateMinikinFontFamily(manager, family_name);
+    if (minikin_family)
+      break;
   }
-  return nullptr;
+  font_families_cache_[family_name] = minikin_family;
+  return minikin_family;
 }
 
 void FontCollection::SortSkTypefaces(
@@ -335,18 +381,24 @@ const std::shared_ptr<minikin::FontFamily>& FontCollection::DoMatchFallbackFont(
     uint32_t ch,
     std::string locale) {
   for (const sk_sp<SkFontMgr>& manager : GetFontManagerOrder()) {
-    std::vector<const char*> bcp47;
-    if (!locale.empty())
-      bcp47.push_back(locale.c_str());
-    sk_sp<SkTypeface> typeface(manager->matchFamilyStyleCharacter(
-        0, SkFontStyle(), bcp47.data(), bcp47.size(), ch));
-    if (!typeface)
+    std::string family_name;
+    if (manager == default_font_manager_) {
+      // The matches of the platform fonts may have been loaded from a previous
+      // run, and are remembered to be saved for the next ones.
+      auto key = std::make_pair(locale, ch);
+      auto known = default_fallback_matches_.find(key);
+      if (known != default_fallback_matches_.end()) {
+        family_name = known->second;
+      } else {
+        family_name = MatchFallbackFamilyName(manager, ch, locale);
+        default_fallback_matches_[key] = family_name;
+      }
+    } else {
+      family_name = MatchFallbackFamilyName(manager, ch, locale);
+    }
+    if (family_name.empty())
       continue;
 
-    SkString sk_family_name;
-    typeface->getFamilyName(&sk_family_name);
-    std::string family_name(sk_family_name.c_str());
-
     if (std::find(fallback_fonts_for_locale_[locale].begin(),
                   fallback_fonts_for_locale_[locale].end(),
                   family_name) == fallback_fonts_for_locale_[locale].end())
@@ -383,6 +435,7 @@ FontCollection::GetFallbackFontFamily(const sk_sp<SkFontMgr>& manager,
 
 void FontCollection::ClearFontFamilyCache() {
   font_collections_cache_.clear();
+  font_families_cache_.clear();
 
 #if FLUTTER_ENABLE_SKSHAPER
   if (skt_collection_) {
@@ -391,6 +444,86 @@ void FontCollection::ClearFontFamilyCache() {
 #endif
 }
 
+const std::string& FontCollection::GetDefaultFontManagerFingerprint() {
+  if (default_font_manager_ && default_font_manager_fingerprint_.empty()) {
+    TRACE_EVENT0("flutter", "FontCollection::GetDefaultFontManagerFingerprint");
+    int count = default_font_manager_->countFamilies();
+    size_t hash = fml::HashCombine();
+    for (int i = 0; i < count; i++) {
+      SkString family_name;
+      default_font_manager_->getFamilyName(i, &family_name);
+      fml::HashCombineSeed(hash, std::string(family_name.c_str()));
+    }
+    std::stringstream stream;
+    stream << count << '-' << std::hex << hash;
+    default_font_manager_fingerprint_ = stream.str();
+  }
+  return default_font_manager_fingerprint_;
+}
+
+// The matches are encoded as a header line with the fingerprint of the fonts,
+// followed by a "character<TAB>locale<TAB>family" line for each match.
+std::string FontCollection::EncodeFallbackFontMatches() {
+  TRACE_EVENT0("flutter", "FontCollection::EncodeFallbackFontMatches");
+  const std::string& fingerprint = GetDefaultFontManagerFingerprint();
+  if (fingerprint.empty()) {
+    return std::string();
+  }
+  std::stringstream stream;
+  stream << kFallbackFontMatchesHeader << ' ' << fingerprint << '\n';
+  for (const auto& match : default_fallback_matches_) {
+    const std::string& locale = match.first.first;
+    const std::string& family_name = match.second;
+    if (locale.find_first_of("\t\n") != std::string::npos ||
+        family_name.find_first_of("\t\n") != std::string::npos) {
+      continue;
+    }
+    stream << match.first.second << '\t' << locale << '\t' << family_name
+           << '\n';
+  }
+  return stream.str();
+}
+
+bool FontCollection::DecodeFallbackFontMatches(const std::string& data) {
+  TRACE_EVENT0("flutter", "FontCollection::DecodeFallbackFontMatches");
+  const std::string& fingerprint = GetDefaultFontManagerFingerprint();
+  if (fingerprint.empty()) {
+    return false;
+  }
+  std::istringstream stream(data);
+  std::string line;
+  if (!std::getline(stream, line) ||
+      line != std::string(kFallbackFontMatchesHeader) + ' ' + fingerprint) {
+    return false;
+  }
+  std::map<std::pair<std::string, uint32_t>, std::string> matches;
+  while (std::getline(stream, line)) {
+    size_t locale_start = line.find('\t');
+    if (locale_start == std::string::npos) {
+      return false;
+    }
+    size_t family_start = line.find('\t', locale_start + 1);
+    if (family_start == std::string::npos) {
+      return false;
+    }
+    char* end = nullptr;
+    unsigned long ch = std::strtoul(line.c_str(), &end, 10);
+    if (locale_start == 0 || end != line.c_str() + locale_start) {
+      return false;
+    }
+    matches[std::make_pair(
+        line.substr(locale_start + 1, family_start - locale_start - 1),
+        static_cast<uint32_t>(ch))] = line.substr(family_start + 1);
+  }
+  // The characters already matched in this run keep their fonts.
+  default_fallback_matches_.insert(matches.begin(), matches.end());
+  return true;
+}
+
+size_t FontCollection::GetFallbackFontMatchCount() const {
+  return default_fallback_matches_.size();
+}
+
 #if FLUTTER_ENABLE_SKSHAPER
 
 sk_sp<skia::textlayout::FontCollection>
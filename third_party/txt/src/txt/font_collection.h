@@ -17,10 +17,12 @@
 #ifndef LIB_TXT_SRC_FONT_COLLECTION_H_
 #define LIB_TXT_SRC_FONT_COLLECTION_H_
 
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 #include "flutter/fml/macros.h"
 #include "minikin/FontCollection.h"
@@ -43,6 +45,20 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
 
   ~FontCollection();
 
+  // Limits the memory of the shaped words that are cached for all of the font
+  // collections of the process, or restores the default limit on their number
+  // if max_bytes is zero.
+  static void SetLayoutCacheMaxBytes(size_t max_bytes);
+
+  // The memory of the shaped words that are cached for all of the font
+  // collections of the process.
+  static size_t GetLayoutCacheBytes();
+
+  // Evicts the least recently used shaped words until the cache uses at most
+  // max_bytes, for example under memory pressure, and returns the bytes
+  // evicted. This does not limit the cache afterwards.
+  static size_t TrimLayoutCache(size_t max_bytes);
+
   size_t GetFontManagersCount() const;
 
   void SetupDefaultFontManager(uint32_t font_initialization_data);
@@ -68,9 +84,27 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // Remove all entries in the font family cache.
   void ClearFontFamilyCache();
 
+  // Serializes the fallback fonts that the default font manager matched for
+  // the characters, with a fingerprint of the fonts that it has, so that a
+  // later run with the same fonts can skip the slow queries of the platform.
+  std::string EncodeFallbackFontMatches();
+
+  // Loads the fallback font matches serialized by EncodeFallbackFontMatches.
+  // Returns false, and loads nothing, if the data is malformed or was encoded
+  // with other fonts in the default font manager.
+  bool DecodeFallbackFontMatches(const std::string& data);
+
+  // The number of characters and locales whose fallback font the default font
+  // manager matched, or that were loaded by DecodeFallbackFontMatches.
+  size_t GetFallbackFontMatchCount() const;
+
 #if FLUTTER_ENABLE_SKSHAPER
 
   // Construct a Skia text layout FontCollection based on this collection.
+  //
+  // The Skia collection caches the typefaces it resolves for the paragraphs
+  // without a lock, so the paragraphs that are built with it must all be laid
+  // out on the same thread.
   sk_sp<skia::textlayout::FontCollection> CreateSktFontCollection();
 
 #endif  // FLUTTER_ENABLE_SKSHAPER
@@ -98,6 +132,11 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
                      std::shared_ptr<minikin::FontCollection>,
                      FamilyKey::Hasher>
       font_collections_cache_;
+  // The families found in the font managers by their names, or null for the
+  // names that none of them has, so that each family is created and has its
+  // coverage parsed only once for all of the font collections that use it.
+  std::unordered_map<std::string, std::shared_ptr<minikin::FontFamily>>
+      font_families_cache_;
   // Cache that stores the results of MatchFallbackFont to ensure lag-free emoji
   // font fallback matching.
   std::unordered_map<uint32_t, const std::shared_ptr<minikin::FontFamily>*>
@@ -106,6 +145,12 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
       fallback_fonts_;
   std::unordered_map<std::string, std::vector<std::string>>
       fallback_fonts_for_locale_;
+  // The name of the family that the default font manager matched for each
+  // locale and character, or an empty name if it had no font for it.
+  std::map<std::pair<std::string, uint32_t>, std::string>
+      default_fallback_matches_;
+  // Identifies the fonts of the default font manager, computed on first use.
+  std::string default_font_manager_fingerprint_;
   bool enable_font_fallback_;
 
 #if FLUTTER_ENABLE_SKSHAPER
@@ -119,8 +164,12 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
       uint32_t ch,
       std::string locale);
 
+  FRIEND_TEST(FontCollectionTest,
+              FallbackFontMatchesAreReusedWithTheSameFonts);
   std::vector<sk_sp<SkFontMgr>> GetFontManagerOrder() const;
 
+  const std::string& GetDefaultFontManagerFingerprint();
+
   std::shared_ptr<minikin::FontFamily> FindFontFamilyInManagers(
       const std::string& family_name);
 
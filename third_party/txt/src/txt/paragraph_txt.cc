@@ -24,10 +24,12 @@
 #include <limits>
 #include <map>
 #include <numeric>
+#include <optional>
 #include <utility>
 #include <vector>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
 #include "font_collection.h"
 #include "font_skia.h"
 #include "minikin/FontLanguageListCache.h"
@@ -187,6 +189,18 @@ void FindWords(const std::vector<uint16_t>& text,
     words->emplace_back(word_start, end);
 }
 
+// Shows how well the shaped words are reused across the layouts.
+void TraceLayoutCacheStats() {
+#if !FLUTTER_RELEASE
+  const minikin::LayoutCacheStats stats = minikin::Layout::getCacheStats();
+  FML_TRACE_COUNTER("flutter", "TextLayoutCache", 0,  //
+                    "Hits", stats.hits,               //
+                    "Misses", stats.misses,           //
+                    "Entries", stats.entryCount,      //
+                    "KBytes", stats.byteSize / 1024);
+#endif  // !FLUTTER_RELEASE
+}
+
 }  // namespace
 
 static const float kDoubleDecorationSpacing = 3.0f;
@@ -236,6 +250,7 @@ ParagraphTxt::~ParagraphTxt() = default;
 
 void ParagraphTxt::SetText(std::vector<uint16_t> text, StyledRuns runs) {
   SetDirty(true);
+  shaped_runs_.clear();
   if (text.size() == 0)
     return;
   text_ = std::move(text);
@@ -246,6 +261,7 @@ void ParagraphTxt::SetInlinePlaceholders(
     std::vector<PlaceholderRun> inline_placeholders,
     std::unordered_set<size_t> obj_replacement_char_indexes) {
   needs_layout_ = true;
+  shaped_runs_.clear();
   inline_placeholders_ = std::move(inline_placeholders);
   obj_replacement_char_indexes_ = std::move(obj_replacement_char_indexes);
 }
@@ -675,6 +691,10 @@ void ParagraphTxt::Layout(double width) {
 
   needs_layout_ = false;
 
+  // Only the width may have changed since the runs were shaped.
+  decltype(shaped_runs_) previous_shaped_runs;
+  previous_shaped_runs.swap(shaped_runs_);
+
   records_.clear();
   glyph_lines_.clear();
   code_unit_runs_.clear();
@@ -695,7 +715,7 @@ void ParagraphTxt::Layout(double width) {
   font.setSubpixel(true);
   font.setHinting(SkFontHinting::kSlight);
 
-  minikin::Layout layout;
+  ShapedRunCache& shaped_run_cache = ShapedRunCache::GetInstance();
   SkTextBlobBuilder builder;
   double y_offset = 0;
   double prev_max_descent = 0;
@@ -833,16 +853,16 @@ void ParagraphTxt::Layout(double width) {
           line_run_it == line_runs.end() - 1 &&
           (line_number == line_limit - 1 ||
            paragraph_style_.unlimited_lines())) {
-        float ellipsis_width = layout.measureText(
+        float ellipsis_width = minikin::Layout::measureText(
             reinterpret_cast<const uint16_t*>(ellipsis.data()), 0,
             ellipsis.length(), ellipsis.length(), run.is_rtl(), minikin_font,
             minikin_paint, minikin_font_collection, nullptr);
 
         std::vector<float> text_advances(text_count);
-        float text_width =
-            layout.measureText(text_ptr, text_start, text_count, text_.size(),
-                               run.is_rtl(), minikin_font, minikin_paint,
-                               minikin_font_collection, text_advances.data());
+        float text_width = minikin::Layout::measureText(
+            text_ptr, text_start, text_count, text_.size(), run.is_rtl(),
+            minikin_font, minikin_paint, minikin_font_collection,
+            text_advances.data());
 
         // Truncate characters from the text until the ellipsis fits.
         size_t truncate_count = 0;
@@ -872,8 +892,38 @@ void ParagraphTxt::Layout(double width) {
         }
       }
 
-      layout.doLayout(text_ptr, text_start, text_count, text_size, run.is_rtl(),
-                      minikin_font, minikin_paint, minikin_font_collection);
+      // Reuses the glyphs of the same run in the last layout or in another
+      // paragraph, and its blobs too unless the line is justified.
+      const bool is_paragraph_text = text_ptr == text_.data();
+      const auto shaped_run_range =
+          std::make_tuple(text_start, text_count, run.is_rtl());
+      std::shared_ptr<const ShapedRunCache::Run> cached_run;
+      if (is_paragraph_text) {
+        auto found = previous_shaped_runs.find(shaped_run_range);
+        if (found != previous_shaped_runs.end()) {
+          cached_run = found->second;
+        }
+      }
+      std::optional<ShapedRunCache::Key> shaped_run_key;
+      if (!cached_run && text_size <= ShapedRunCache::kMaxTextLength) {
+        shaped_run_key = ShapedRunCache::MakeKey(
+            text_ptr, text_start, text_count, text_size, run.is_rtl(),
+            minikin_font, minikin_paint, *minikin_font_collection);
+        cached_run = shaped_run_cache.Get(*shaped_run_key);
+      }
+      std::shared_ptr<ShapedRunCache::Run> shaped_run;
+      if (!cached_run) {
+        shaped_run = std::make_shared<ShapedRunCache::Run>();
+        shaped_run->layout.doLayout(text_ptr, text_start, text_count, text_size,
+                                    run.is_rtl(), minikin_font, minikin_paint,
+                                    minikin_font_collection);
+        shaped_run->font_collection = minikin_font_collection;
+      }
+      const minikin::Layout& layout =
+          cached_run ? cached_run->layout : shaped_run->layout;
+      const bool reuse_blobs =
+          cached_run && !justify_line && !cached_run->blobs.empty();
+      const bool keep_blobs = shaped_run && !justify_line;
 
       if (layout.nGlyphs() == 0)
         continue;
@@ -894,16 +944,23 @@ void ParagraphTxt::Layout(double width) {
 
       // Break the layout into blobs that share the same SkPaint parameters.
       std::vector<Range<size_t>> glyph_blobs = GetLayoutTypefaceRuns(layout);
+      if (keep_blobs) {
+        shaped_run->blobs.resize(glyph_blobs.size());
+      }
 
       double word_start_position = std::numeric_limits<double>::quiet_NaN();
 
       // Build a Skia text blob from each group of glyphs.
-      for (const Range<size_t>& glyph_blob : glyph_blobs) {
+      for (size_t glyph_blob_index = 0; glyph_blob_index < glyph_blobs.size();
+           ++glyph_blob_index) {
+        const Range<size_t>& glyph_blob = glyph_blobs[glyph_blob_index];
         std::vector<GlyphPosition> glyph_positions;
 
         GetGlyphTypeface(layout, glyph_blob.start).apply(font);
-        const SkTextBlobBuilder::RunBuffer& blob_buffer =
-            builder.allocRunPos(font, glyph_blob.end - glyph_blob.start);
+        const SkTextBlobBuilder::RunBuffer* blob_buffer =
+            reuse_blobs
+                ? nullptr
+                : &builder.allocRunPos(font, glyph_blob.end - glyph_blob.start);
 
         double justify_x_offset_delta = 0;
         for (size_t glyph_index = glyph_blob.start;
@@ -913,17 +970,19 @@ void ParagraphTxt::Layout(double width) {
           double glyph_x_offset;
           // Add all the glyphs in this cluster to the text blob.
           do {
-            size_t blob_index = glyph_index - glyph_blob.start;
-            blob_buffer.glyphs[blob_index] = layout.getGlyphId(glyph_index);
-
-            size_t pos_index = blob_index * 2;
-            blob_buffer.pos[pos_index] = layout.getX(glyph_index) +
-                                         justify_x_offset +
-                                         justify_x_offset_delta;
-            blob_buffer.pos[pos_index + 1] = layout.getY(glyph_index);
+            const SkScalar glyph_x = layout.getX(glyph_index) +
+                                     justify_x_offset + justify_x_offset_delta;
+            if (blob_buffer) {
+              size_t blob_index = glyph_index - glyph_blob.start;
+              blob_buffer->glyphs[blob_index] = layout.getGlyphId(glyph_index);
+
+              size_t pos_index = blob_index * 2;
+              blob_buffer->pos[pos_index] = glyph_x;
+              blob_buffer->pos[pos_index + 1] = layout.getY(glyph_index);
+            }
 
             if (glyph_index == cluster_start_glyph_index)
-              glyph_x_offset = blob_buffer.pos[pos_index];
+              glyph_x_offset = glyph_x;
 
             glyph_index++;
           } while (glyph_index < glyph_blob.end &&
@@ -1037,8 +1096,13 @@ void ParagraphTxt::Layout(double width) {
         Range<double> record_x_pos(
             glyph_positions.front().x_pos.start - run_x_offset,
             glyph_positions.back().x_pos.end - run_x_offset);
+        sk_sp<SkTextBlob> blob =
+            reuse_blobs ? cached_run->blobs[glyph_blob_index] : builder.make();
+        if (keep_blobs) {
+          shaped_run->blobs[glyph_blob_index] = blob;
+        }
         paint_records.emplace_back(run.style(), SkPoint::Make(run_x_offset, 0),
-                                   builder.make(), *metrics, line_number,
+                                   std::move(blob), *metrics, line_number,
                                    record_x_pos.start, record_x_pos.end,
                                    run.is_ghost(), run.placeholder_run());
 
@@ -1086,6 +1150,15 @@ void ParagraphTxt::Layout(double width) {
           run_x_offset += layout.getAdvance();
         }
       }
+
+      if (shaped_run_key && keep_blobs) {
+        shaped_run_cache.Put(std::move(*shaped_run_key), shaped_run);
+      }
+      if (is_paragraph_text && cached_run) {
+        shaped_runs_[shaped_run_range] = std::move(cached_run);
+      } else if (is_paragraph_text) {
+        shaped_runs_[shaped_run_range] = std::move(shaped_run);
+      }
     }  // for each in line_runs
 
     // Adjust the glyph positions based on the alignment of the line.
@@ -1187,6 +1260,8 @@ void ParagraphTxt::Layout(double width) {
             });
 
   longest_line_ = max_right_ - min_left_;
+
+  TraceLayoutCacheStats();
 }
 
 void ParagraphTxt::UpdateLineMetrics(const SkFontMetrics& metrics,
@@ -1369,12 +1444,14 @@ double ParagraphTxt::GetLongestLine() {
 
 void ParagraphTxt::SetParagraphStyle(const ParagraphStyle& style) {
   needs_layout_ = true;
+  shaped_runs_.clear();
   paragraph_style_ = style;
 }
 
 void ParagraphTxt::SetFontCollection(
     std::shared_ptr<FontCollection> font_collection) {
   font_collection_ = std::move(font_collection);
+  shaped_runs_.clear();
 }
 
 std::shared_ptr<minikin::FontCollection>
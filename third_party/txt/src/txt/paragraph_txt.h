@@ -17,7 +17,10 @@
 #ifndef LIB_TXT_SRC_PARAGRAPH_TXT_H_
 #define LIB_TXT_SRC_PARAGRAPH_TXT_H_
 
+#include <map>
+#include <memory>
 #include <set>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -31,6 +34,7 @@
 #include "paragraph_style.h"
 #include "placeholder_run.h"
 #include "run_metrics.h"
+#include "shaped_run_cache.h"
 #include "styled_runs.h"
 #include "third_party/googletest/googletest/include/gtest/gtest_prod.h"  // nogncheck
 #include "third_party/skia/include/core/SkFontMetrics.h"
@@ -164,6 +168,9 @@ class ParagraphTxt : public Paragraph {
   FRIEND_TEST(ParagraphTest, GetGlyphPositionAtCoordinateSegfault);
   FRIEND_TEST(ParagraphTest, KhmerLineBreaker);
   FRIEND_TEST(ParagraphTest, TextHeightBehaviorRectsParagraph);
+  FRIEND_TEST(ParagraphTest, ParagraphsShareTheBlobsOfTheSameRuns);
+  FRIEND_TEST(ParagraphTest, RelayoutAtAnotherWidthReusesTheShapedRuns);
+  FRIEND_TEST(ParagraphTest, SimpleLatinTextBreaksAfterItsSpaces);
 
   // Starting data to layout.
   std::vector<uint16_t> text_;
@@ -320,6 +327,13 @@ class ParagraphTxt : public Paragraph {
 
   bool needs_layout_ = true;
 
+  // The runs shaped by the last layout by their start, size and direction,
+  // which a layout at another width reuses for the lines that have the same
+  // runs. Dropped whenever the text, its styles or its fonts change.
+  std::map<std::tuple<size_t, size_t, bool>,
+           std::shared_ptr<const ShapedRunCache::Run>>
+      shaped_runs_;
+
   struct WaveCoordinates {
     double x_start;
     double y_start;
@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "shaped_run_cache.h"
+
+#include <functional>
+#include <string_view>
+#include <utility>
+
+#include "flutter/fml/hash_combine.h"
+
+namespace txt {
+
+bool ShapedRunCache::Key::operator==(const Key& other) const {
+  return start == other.start && count == other.count &&
+         is_rtl == other.is_rtl && font_style == other.font_style &&
+         font_size == other.font_size &&
+         letter_spacing == other.letter_spacing &&
+         word_spacing == other.word_spacing &&
+         font_collection_id == other.font_collection_id &&
+         font_feature_settings == other.font_feature_settings &&
+         text == other.text;
+}
+
+size_t ShapedRunCache::KeyHash::operator()(const Key& key) const {
+  return fml::HashCombine(std::hash<std::u16string_view>()(key.text),
+                          key.start, key.count, key.is_rtl,
+                          key.font_style.hash(), key.font_size,
+                          key.letter_spacing, key.word_spacing,
+                          key.font_feature_settings, key.font_collection_id);
+}
+
+ShapedRunCache& ShapedRunCache::GetInstance() {
+  // Leaked so that paragraphs can still be laid out while the process exits.
+  static ShapedRunCache* cache = new ShapedRunCache();
+  return *cache;
+}
+
+ShapedRunCache::Key ShapedRunCache::MakeKey(
+    const uint16_t* text,
+    size_t start,
+    size_t count,
+    size_t text_size,
+    bool is_rtl,
+    const minikin::FontStyle& font_style,
+    const minikin::MinikinPaint& paint,
+    const minikin::FontCollection& font_collection) {
+  return {std::u16string(reinterpret_cast<const char16_t*>(text), text_size),
+          start,
+          count,
+          is_rtl,
+          font_style,
+          paint.size,
+          paint.letterSpacing,
+          paint.wordSpacing,
+          paint.fontFeatureSettings,
+          font_collection.getId()};
+}
+
+ShapedRunCache::ShapedRunCache() = default;
+
+ShapedRunCache::~ShapedRunCache() = default;
+
+std::shared_ptr<const ShapedRunCache::Run> ShapedRunCache::Get(
+    const Key& key) {
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return found->second->run;
+}
+
+void ShapedRunCache::Put(Key key, std::shared_ptr<const Run> run) {
+  std::scoped_lock lock(mutex_);
+  if (index_.count(key) != 0) {
+    return;
+  }
+  if (entries_.size() >= kMaxEntries) {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+  entries_.push_front({std::move(key), std::move(run)});
+  index_[entries_.front().key] = entries_.begin();
+}
+
+void ShapedRunCache::Clear() {
+  std::scoped_lock lock(mutex_);
+  index_.clear();
+  entries_.clear();
+}
+
+size_t ShapedRunCache::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+}  // namespace txt
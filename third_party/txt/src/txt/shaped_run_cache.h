@@ -0,0 +1,112 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TXT_SHAPED_RUN_CACHE_H_
+#define TXT_SHAPED_RUN_CACHE_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "minikin/FontCollection.h"
+#include "minikin/Layout.h"
+#include "minikin/MinikinFont.h"
+#include "third_party/skia/include/core/SkRefCnt.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+
+namespace txt {
+
+// A cache of the shaped runs of text and of the text blobs built from them,
+// shared by all of the paragraphs of the process, so that the same run in
+// another paragraph, such as a label repeated by the items of a list, is
+// neither shaped nor built into blobs again.
+//
+// The shaping of a run depends on the text around it, so the key holds all of
+// the text of the paragraph, and only the runs of short paragraphs are kept.
+// It may be used from any thread.
+class ShapedRunCache {
+ public:
+  static constexpr size_t kMaxEntries = 1024;
+
+  static constexpr size_t kMaxTextLength = 256;
+
+  struct Key {
+    std::u16string text;
+    size_t start;
+    size_t count;
+    bool is_rtl;
+    minikin::FontStyle font_style;
+    float font_size;
+    float letter_spacing;
+    float word_spacing;
+    std::string font_feature_settings;
+    uint32_t font_collection_id;
+
+    bool operator==(const Key& other) const;
+  };
+
+  // A shaped run, which is never changed once it is in the cache.
+  struct Run {
+    minikin::Layout layout;
+    // The blob of each range of glyphs of the layout that share a typeface,
+    // built without any justification.
+    std::vector<sk_sp<SkTextBlob>> blobs;
+    // Keeps the fonts that the layout refers to alive.
+    std::shared_ptr<minikin::FontCollection> font_collection;
+  };
+
+  static ShapedRunCache& GetInstance();
+
+  static Key MakeKey(const uint16_t* text,
+                     size_t start,
+                     size_t count,
+                     size_t text_size,
+                     bool is_rtl,
+                     const minikin::FontStyle& font_style,
+                     const minikin::MinikinPaint& paint,
+                     const minikin::FontCollection& font_collection);
+
+  ShapedRunCache();
+
+  ~ShapedRunCache();
+
+  // Returns the run shaped for the key and marks it as the most recently
+  // used, or null if there is none.
+  std::shared_ptr<const Run> Get(const Key& key);
+
+  // Remembers the run shaped for the key, evicting the least recently used
+  // run if the cache is full.
+  void Put(Key key, std::shared_ptr<const Run> run);
+
+  void Clear();
+
+  size_t GetEntryCount() const;
+
+ private:
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Entry {
+    Key key;
+    std::shared_ptr<const Run> run;
+  };
+
+  using Entries = std::list<Entry>;
+
+  mutable std::mutex mutex_;
+  // The most recently used entry is the first.
+  Entries entries_;
+  std::unordered_map<Key, Entries::iterator, KeyHash> index_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ShapedRunCache);
+};
+
+}  // namespace txt
+
+#endif  // TXT_SHAPED_RUN_CACHE_H_
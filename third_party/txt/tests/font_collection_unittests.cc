@@ -215,4 +215,52 @@ TEST(FontCollection, GetFamilyNames) {
 
 #endif  // 0
 
+TEST(FontCollectionTest, CollectionsShareTheFamiliesOfTheSameNames) {
+  auto font_collection = GetTestFontCollection();
+  auto roboto = font_collection->GetMinikinFontCollectionForFamilies(
+      std::vector<std::string>{"Roboto"}, "en-US");
+  auto roboto_and_ahem = font_collection->GetMinikinFontCollectionForFamilies(
+      std::vector<std::string>{"Roboto", "Ahem"}, "en-US");
+  ASSERT_TRUE(roboto);
+  ASSERT_TRUE(roboto_and_ahem);
+  ASSERT_NE(roboto, roboto_and_ahem);
+
+  EXPECT_EQ(roboto->getFamilyForChar('a', 0, 0, 0),
+            roboto_and_ahem->getFamilyForChar('a', 0, 0, 0));
+}
+
+TEST(FontCollectionTest, FallbackFontMatchesAreReusedWithTheSameFonts) {
+  // The test fonts stand in for the platform fonts, but do not match any
+  // fallback font themselves.
+  auto platform_fonts = GetTestFontCollection();
+  platform_fonts->SetDefaultFontManager(
+      platform_fonts->GetFontManagerOrder().front());
+  platform_fonts->SetAssetFontManager(nullptr);
+  EXPECT_FALSE(platform_fonts->MatchFallbackFont('a', "en-US"));
+  EXPECT_EQ(platform_fonts->GetFallbackFontMatchCount(), 1u);
+
+  std::string data = platform_fonts->EncodeFallbackFontMatches();
+  std::string header = data.substr(0, data.find('\n') + 1);
+  ASSERT_FALSE(header.empty());
+
+  auto next_run = GetTestFontCollection();
+  next_run->SetDefaultFontManager(next_run->GetFontManagerOrder().front());
+  next_run->SetAssetFontManager(nullptr);
+  ASSERT_TRUE(next_run->DecodeFallbackFontMatches(data));
+  EXPECT_EQ(next_run->GetFallbackFontMatchCount(), 1u);
+
+  // A known match is used without asking the font manager.
+  ASSERT_TRUE(
+      next_run->DecodeFallbackFontMatches(header + "98\ten-US\tRoboto\n"));
+  EXPECT_TRUE(next_run->MatchFallbackFont('b', "en-US"));
+  EXPECT_EQ(next_run->GetFallbackFontMatchCount(), 2u);
+
+  // The matches of other fonts are ignored.
+  auto other_fonts = std::make_shared<FontCollection>();
+  other_fonts->SetDefaultFontManager(sk_make_sp<DynamicFontManager>());
+  EXPECT_FALSE(other_fonts->DecodeFallbackFontMatches(data));
+  EXPECT_EQ(other_fonts->GetFallbackFontMatchCount(), 0u);
+  EXPECT_FALSE(next_run->DecodeFallbackFontMatches("98\ten-US\tRoboto\n"));
+}
+
 }  // namespace txt
@@ -16,8 +16,10 @@
 
 #include <cstring>
 #include <iostream>
+#include <string>
 
 #include "flutter/fml/logging.h"
+#include "minikin/Layout.h"
 #include "render_test.h"
 #include "third_party/icu/source/common/unicode/unistr.h"
 #include "third_party/skia/include/core/SkColor.h"
@@ -27,6 +29,7 @@
 #include "txt/paragraph_builder_txt.h"
 #include "txt/paragraph_txt.h"
 #include "txt/placeholder_run.h"
+#include "txt/shaped_run_cache.h"
 #include "txt_test_utils.h"
 
 #define DISABLE_ON_WINDOWS(TEST) DISABLE_TEST_WINDOWS(TEST)
@@ -7111,4 +7114,171 @@ TEST_F(ParagraphTest, MixedTextHeightBehaviorRectsParagraph) {
 
   ASSERT_TRUE(Snapshot());
 }
+
+TEST_F(ParagraphTest, LayoutCacheReusesWordsWithinItsBudget) {
+  auto layout_text = [this](const char* text) {
+    auto icu_text = icu::UnicodeString::fromUTF8(text);
+    std::u16string u16_text(icu_text.getBuffer(),
+                            icu_text.getBuffer() + icu_text.length());
+    txt::ParagraphStyle paragraph_style;
+    txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+    txt::TextStyle text_style;
+    text_style.font_families = std::vector<std::string>(1, "Roboto");
+    builder.PushStyle(text_style);
+    builder.AddText(u16_text);
+    builder.Pop();
+    auto paragraph = BuildParagraph(builder);
+    paragraph->Layout(GetTestCanvasWidth());
+  };
+
+  const auto before = minikin::Layout::getCacheStats();
+  layout_text("Uncached words of a layout cache test");
+  const auto first = minikin::Layout::getCacheStats();
+  EXPECT_GT(first.misses, before.misses);
+  layout_text("Uncached words of a layout cache test");
+  const auto second = minikin::Layout::getCacheStats();
+  EXPECT_EQ(second.misses, first.misses);
+  EXPECT_GT(second.hits, first.hits);
+
+  const size_t max_bytes = 4096;
+  FontCollection::SetLayoutCacheMaxBytes(max_bytes);
+  layout_text("More words to fill the cache with, and then some more words");
+  const auto limited = minikin::Layout::getCacheStats();
+  EXPECT_GT(limited.entryCount, 0u);
+  EXPECT_LE(limited.byteSize, max_bytes);
+  FontCollection::SetLayoutCacheMaxBytes(0);
+}
+
+TEST_F(ParagraphTest, TrimmingLayoutCacheEvictsWordsWithoutLimitingIt) {
+  auto icu_text =
+      icu::UnicodeString::fromUTF8("Words of a layout cache trimming test");
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+  txt::ParagraphStyle paragraph_style;
+  txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  builder.PushStyle(text_style);
+  builder.AddText(u16_text);
+  builder.Pop();
+  auto paragraph = BuildParagraph(builder);
+  paragraph->Layout(GetTestCanvasWidth());
+
+  const size_t bytes = FontCollection::GetLayoutCacheBytes();
+  ASSERT_GT(bytes, 0u);
+  EXPECT_EQ(FontCollection::TrimLayoutCache(bytes), 0u);
+  EXPECT_EQ(FontCollection::TrimLayoutCache(0), bytes);
+  EXPECT_EQ(FontCollection::GetLayoutCacheBytes(), 0u);
+  EXPECT_EQ(minikin::Layout::getCacheStats().entryCount, 0u);
+}
+
+TEST_F(ParagraphTest, ParagraphsShareTheBlobsOfTheSameRuns) {
+  auto build_paragraph = [this](TextAlign align) {
+    auto icu_text = icu::UnicodeString::fromUTF8("Repeated label");
+    std::u16string u16_text(icu_text.getBuffer(),
+                            icu_text.getBuffer() + icu_text.length());
+    txt::ParagraphStyle paragraph_style;
+    paragraph_style.text_align = align;
+    txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+    txt::TextStyle text_style;
+    text_style.font_families = std::vector<std::string>(1, "Roboto");
+    builder.PushStyle(text_style);
+    builder.AddText(u16_text);
+    builder.Pop();
+    auto paragraph = BuildParagraph(builder);
+    paragraph->Layout(GetTestCanvasWidth());
+    return paragraph;
+  };
+
+  auto first = build_paragraph(TextAlign::left);
+  auto second = build_paragraph(TextAlign::left);
+  ASSERT_EQ(first->records_.size(), 1ull);
+  ASSERT_EQ(second->records_.size(), 1ull);
+  EXPECT_GT(ShapedRunCache::GetInstance().GetEntryCount(), 0u);
+  EXPECT_EQ(first->records_[0].text(), second->records_[0].text());
+  EXPECT_EQ(first->GetMaxIntrinsicWidth(), second->GetMaxIntrinsicWidth());
+  EXPECT_EQ(first->glyph_lines_[0].positions.size(),
+            second->glyph_lines_[0].positions.size());
+
+  // Runs in another alignment have the same glyphs, and are placed by the
+  // offset of their records.
+  auto centered = build_paragraph(TextAlign::center);
+  ASSERT_EQ(centered->records_.size(), 1ull);
+  EXPECT_EQ(centered->records_[0].text(), first->records_[0].text());
+  EXPECT_NE(centered->records_[0].offset().x(),
+            first->records_[0].offset().x());
+}
+
+TEST_F(ParagraphTest, RelayoutAtAnotherWidthReusesTheShapedRuns) {
+  // Longer than the paragraphs whose runs are shared with other paragraphs.
+  std::string text;
+  for (size_t i = 0; i < 20; i++) {
+    text += "Line " + std::to_string(i) + " of a long paragraph\n";
+  }
+  ASSERT_GT(text.size(), ShapedRunCache::kMaxTextLength);
+  auto icu_text = icu::UnicodeString::fromUTF8(text);
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+
+  txt::ParagraphStyle paragraph_style;
+  txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  builder.PushStyle(text_style);
+  builder.AddText(u16_text);
+  builder.Pop();
+  auto paragraph = BuildParagraph(builder);
+
+  paragraph->Layout(GetTestCanvasWidth());
+  std::vector<sk_sp<SkTextBlob>> blobs;
+  for (const PaintRecord& record : paragraph->records_) {
+    blobs.push_back(sk_ref_sp(record.text()));
+  }
+  ASSERT_GT(blobs.size(), 1ull);
+
+  paragraph->Layout(GetTestCanvasWidth() - 50);
+  ASSERT_EQ(paragraph->records_.size(), blobs.size());
+  for (size_t i = 0; i < blobs.size(); i++) {
+    EXPECT_EQ(paragraph->records_[i].text(), blobs[i].get());
+  }
+
+  // The runs are shaped again once the style changes.
+  paragraph->SetParagraphStyle(paragraph_style);
+  paragraph->Layout(GetTestCanvasWidth());
+  ASSERT_EQ(paragraph->records_.size(), blobs.size());
+  EXPECT_NE(paragraph->records_[0].text(), blobs[0].get());
+}
+
+TEST_F(ParagraphTest, SimpleLatinTextBreaksAfterItsSpaces) {
+  // Broken without ICU, as its only breaks are after the spaces.
+  auto icu_text = icu::UnicodeString::fromUTF8("Hello, w\u00f6rld. 42 items");
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+
+  txt::ParagraphStyle paragraph_style;
+  paragraph_style.break_strategy = minikin::kBreakStrategy_HighQuality;
+  txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  builder.PushStyle(text_style);
+  builder.AddText(u16_text);
+  builder.Pop();
+  auto paragraph = BuildParagraph(builder);
+
+  paragraph->Layout(GetTestCanvasWidth());
+  ASSERT_EQ(paragraph->line_metrics_.size(), 1ull);
+  double width = paragraph->GetMaxIntrinsicWidth();
+
+  // A label that fits on one line is not broken.
+  paragraph->Layout(width + 1);
+  EXPECT_EQ(paragraph->line_metrics_.size(), 1ull);
+
+  // About eleven characters fit on each line.
+  paragraph->Layout(width / 2);
+  ASSERT_EQ(paragraph->line_metrics_.size(), 3ull);
+  EXPECT_EQ(paragraph->line_metrics_[0].start_index, 0ull);
+  EXPECT_EQ(paragraph->line_metrics_[1].start_index, 7ull);
+  EXPECT_EQ(paragraph->line_metrics_[2].start_index, 17ull);
+}
+
 }  // namespace txt
@@ -4,6 +4,7 @@
 
 #include "vulkan_device.h"
 
+#include <algorithm>
 #include <limits>
 #include <map>
 #include <vector>
@@ -345,8 +346,10 @@ int VulkanDevice::ChooseSurfaceFormat(const VulkanSurface& surface,
   return -1;
 }
 
-bool VulkanDevice::ChoosePresentMode(const VulkanSurface& surface,
-                                     VkPresentModeKHR* present_mode) const {
+bool VulkanDevice::ChoosePresentMode(
+    const VulkanSurface& surface,
+    const std::vector<VkPresentModeKHR>& desired_present_modes,
+    VkPresentModeKHR* present_mode) const {
   if (!surface.IsValid() || present_mode == nullptr) {
     return false;
   }
@@ -357,11 +360,36 @@ bool VulkanDevice::ChoosePresentMode(const VulkanSurface& surface,
   // rate of the screen should not be faced by any Flutter platforms as they are
   // powered by Vsync pulses instead of depending the submit to block.
   // However, for platforms that don't have VSync providers set up, it is better
-  // to fall back to FIFO. For platforms that do have VSync providers, there
-  // should be little difference. In case there is a need for a mode other than
-  // FIFO, availability checks must be performed here before returning the
-  // result. FIFO is always present.
+  // to fall back to FIFO. FIFO is always present, so it is the result unless a
+  // mode other than FIFO is both desired and available.
   *present_mode = VK_PRESENT_MODE_FIFO_KHR;
+#if FML_OS_ANDROID
+  if (desired_present_modes.empty()) {
+    return true;
+  }
+
+  uint32_t mode_count = 0;
+  if (VK_CALL_LOG_ERROR(vk.GetPhysicalDeviceSurfacePresentModesKHR(
+          physical_device_, surface.Handle(), &mode_count, nullptr)) !=
+      VK_SUCCESS) {
+    return true;
+  }
+
+  std::vector<VkPresentModeKHR> modes(mode_count);
+  if (VK_CALL_LOG_ERROR(vk.GetPhysicalDeviceSurfacePresentModesKHR(
+          physical_device_, surface.Handle(), &mode_count, modes.data())) !=
+      VK_SUCCESS) {
+    return true;
+  }
+
+  // Use the first supported mode in the list of desired modes.
+  for (VkPresentModeKHR desired_mode : desired_present_modes) {
+    if (std::find(modes.begin(), modes.end(), desired_mode) != modes.end()) {
+      *present_mode = desired_mode;
+      return true;
+    }
+  }
+#endif  // FML_OS_ANDROID
   return true;
 }
 
@@ -62,8 +62,10 @@ class VulkanDevice {
                                         std::vector<VkFormat> desired_formats,
                                         VkSurfaceFormatKHR* format) const;
 
-  [[nodiscard]] bool ChoosePresentMode(const VulkanSurface& surface,
-                                       VkPresentModeKHR* present_mode) const;
+  [[nodiscard]] bool ChoosePresentMode(
+      const VulkanSurface& surface,
+      const std::vector<VkPresentModeKHR>& desired_present_modes,
+      VkPresentModeKHR* present_mode) const;
 
   [[nodiscard]] bool QueueSubmit(
       std::vector<VkPipelineStageFlags> wait_dest_pipeline_stages,
@@ -4,6 +4,8 @@
 
 #include "vulkan_swapchain.h"
 
+#include <algorithm>
+
 #include "third_party/skia/include/gpu/GrBackendSurface.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/skia/include/gpu/vk/GrVkTypes.h"
@@ -41,7 +43,8 @@ VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
                                  const VulkanSurface& surface,
                                  GrDirectContext* skia_context,
                                  std::unique_ptr<VulkanSwapchain> old_swapchain,
-                                 uint32_t queue_family_index)
+                                 uint32_t queue_family_index,
+                                 const VulkanSwapchainOptions& options)
     : vk(p_vk),
       device_(device),
       capabilities_(),
@@ -79,7 +82,8 @@ VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
   }
 
   VkPresentModeKHR present_mode = VK_PRESENT_MODE_FIFO_KHR;
-  if (!device_.ChoosePresentMode(surface, &present_mode)) {
+  if (!device_.ChoosePresentMode(surface, options.present_modes,
+                                 &present_mode)) {
     FML_DLOG(INFO) << "Could not choose present mode.";
     return;
   }
@@ -113,6 +117,15 @@ VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
 
   VkSurfaceKHR surface_handle = surface.Handle();
 
+  uint32_t image_count = options.image_count > 0
+                             ? options.image_count
+                             : capabilities_.minImageCount + 1;
+  image_count = std::max(image_count, capabilities_.minImageCount);
+  // A maximum of 0 means that there is no limit.
+  if (capabilities_.maxImageCount > 0) {
+    image_count = std::min(image_count, capabilities_.maxImageCount);
+  }
+
   VkImageUsageFlags usage_flags = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
                                   VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
                                   VK_IMAGE_USAGE_TRANSFER_DST_BIT;
@@ -122,7 +135,7 @@ VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
       .pNext = nullptr,
       .flags = 0,
       .surface = surface_handle,
-      .minImageCount = capabilities_.minImageCount,
+      .minImageCount = image_count,
       .imageFormat = surface_format_.format,
       .imageColorSpace = surface_format_.colorSpace,
       .imageExtent = capabilities_.currentExtent,
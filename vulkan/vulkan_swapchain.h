@@ -23,6 +23,22 @@ class VulkanSurface;
 class VulkanBackbuffer;
 class VulkanImage;
 
+/// The preferences for a |VulkanSwapchain|, which are honored as far as the
+/// surface supports them.
+struct VulkanSwapchainOptions {
+  /// The number of swapchain images, or 0 for one more than the minimum of the
+  /// surface. The extra image lets the raster thread acquire and render the
+  /// next frame while the presentation engine holds the others, rather than
+  /// block in the acquire.
+  uint32_t image_count = 0;
+
+  /// The present modes to use in order of preference, such as
+  /// VK_PRESENT_MODE_MAILBOX_KHR to replace queued frames with newer ones, or
+  /// VK_PRESENT_MODE_FIFO_RELAXED_KHR to present late frames immediately.
+  /// VK_PRESENT_MODE_FIFO_KHR is used if none of them is supported.
+  std::vector<VkPresentModeKHR> present_modes;
+};
+
 class VulkanSwapchain {
  public:
   VulkanSwapchain(const VulkanProcTable& vk,
@@ -30,7 +46,8 @@ class VulkanSwapchain {
                   const VulkanSurface& surface,
                   GrDirectContext* skia_context,
                   std::unique_ptr<VulkanSwapchain> old_swapchain,
-                  uint32_t queue_family_index);
+                  uint32_t queue_family_index,
+                  const VulkanSwapchainOptions& options = {});
 
   ~VulkanSwapchain();
 